@@ -695,93 +695,109 @@ Status TaskWorkerPool::_publish_version_in_parallel(void* arg_this, std::unique_
     int64_t transaction_id = publish_version_req.transaction_id;
     Status error_status = Status::OK();
 
-    // each partition
+    struct TabletPublishJob {
+        int64_t partition_id;
+        TVersion version;
+        TabletInfo tablet_info;
+        RowsetSharedPtr rowset;
+        Status status;
+    };
+
+    // the tablets of all the partitions are published at once, rather than waiting for the tablets of each
+    // partition in turn
+    std::vector<TabletPublishJob> jobs;
     for (auto& par_ver_info : publish_version_req.partition_version_infos) {
-        int64_t partition_id = par_ver_info.partition_id;
         // get all partition related tablets and check whether the tablet have the related version
-
         map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
-        StorageEngine::instance()->txn_manager()->get_txn_related_tablets(transaction_id, partition_id,
+        StorageEngine::instance()->txn_manager()->get_txn_related_tablets(transaction_id, par_ver_info.partition_id,
                                                                           &tablet_related_rs);
+        for (auto& [tablet_info, rowset] : tablet_related_rs) {
+            jobs.push_back({par_ver_info.partition_id, par_ver_info.version, tablet_info, rowset, Status::OK()});
+        }
+    }
 
-        TVersion version = par_ver_info.version;
-
-        // vector for tablet_info.
-        std::vector<TabletInfo> tablet_infos;
-        tablet_infos.reserve(tablet_related_rs.size());
-
-        // vector for tablet publishing version status, which collects the execution results of the correspoding tablet.
-        std::vector<Status> statuses(tablet_related_rs.size(), Status::OK());
-
-        size_t idx = 0;
-        // each tablet
-        for (auto& tablet_rs : tablet_related_rs) {
-            tablet_infos.push_back(tablet_rs.first);
-
-            uint32_t retry_time = 0;
-
-            Status st;
-            while (retry_time++ < PUBLISH_VERSION_SUBMIT_MAX_RETRY) {
-                // submit publishing tablet version task to the threadpool.
-                st = threadpool->submit_func([&worker_pool_this, &tablet_rs, &statuses, idx, &version, &transaction_id,
-                                              &partition_id]() {
-                    const TabletInfo& tablet_info = tablet_rs.first;
-                    const RowsetSharedPtr& rowset = tablet_rs.second;
-                    auto& status = statuses[idx];
-                    // if rowset is null, it means this be received write task, but failed during write
-                    // and receive fe's publish version task
-                    // this be must return as an error tablet
-                    if (rowset == nullptr) {
-                        LOG(WARNING) << "Not found rowset of tablet: " << tablet_info.tablet_id << ", txn_id "
-                                     << transaction_id;
-                        status = Status::NotFound(fmt::format("Not found rowset of tablet: {}, txn_id: {}",
-                                                              tablet_info.tablet_id, transaction_id));
-                        return;
-                    }
-                    EnginePublishVersionTask engine_task(transaction_id, partition_id, version, tablet_info, rowset);
-
-                    status = worker_pool_this->_env->storage_engine()->execute_task(&engine_task);
-                    if (!status.ok())
-                        LOG(WARNING) << "failed to publish version for tablet, tablet_id " << tablet_info.tablet_id
-                                     << ", txn_id " << transaction_id << ", err: " << status;
-                });
-
-                if (st.is_service_unavailable()) {
-                    // Status::ServiceUnavailable is returned when all of the threads of the pool are busy.
-                    LOG(WARNING) << "publish version threadpool is busy, retry later. [transaction_id="
-                                 << publish_version_req.transaction_id << ", tablet_id=" << tablet_rs.first.tablet_id;
-                    // In general, publish version is fast. A small sleep is needed here.
-                    SleepFor(MonoDelta::FromMilliseconds(50 * retry_time));
-                    continue;
-                }
-                break;
+    // the tablets are submitted to the pool in turn of their data dirs, so that the tablets on a slow disk
+    // don't occupy all the threads of the pool while the tablets on the other disks are waiting
+    std::map<DataDir*, std::vector<size_t>> dir_jobs;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(jobs[i].tablet_info.tablet_id);
+        dir_jobs[tablet != nullptr ? tablet->data_dir() : nullptr].push_back(i);
+    }
+    std::vector<size_t> job_order;
+    job_order.reserve(jobs.size());
+    for (size_t round = 0; job_order.size() < jobs.size(); round++) {
+        for (auto& [dir, indexes] : dir_jobs) {
+            if (round < indexes.size()) {
+                job_order.push_back(indexes[round]);
             }
+        }
+    }
 
-            // error category:
-            // 1. ServiceUnavailable, which means that the threadpool is busy even in retry.
-            // 2. error that is not ServiceUnavailable.
-            if (!st.ok()) return st;
+    for (size_t pos = 0; pos < job_order.size(); pos++) {
+        size_t idx = job_order[pos];
+        uint32_t retry_time = 0;
+        Status st;
+        while (retry_time++ < PUBLISH_VERSION_SUBMIT_MAX_RETRY) {
+            // submit publishing tablet version task to the threadpool.
+            st = threadpool->submit_func([worker_pool_this, transaction_id, job = &jobs[idx]]() {
+                const TabletInfo& tablet_info = job->tablet_info;
+                // if rowset is null, it means this be received write task, but failed during write
+                // and receive fe's publish version task
+                // this be must return as an error tablet
+                if (job->rowset == nullptr) {
+                    LOG(WARNING) << "Not found rowset of tablet: " << tablet_info.tablet_id << ", txn_id "
+                                 << transaction_id;
+                    job->status = Status::NotFound(fmt::format("Not found rowset of tablet: {}, txn_id: {}",
+                                                               tablet_info.tablet_id, transaction_id));
+                    return;
+                }
+                EnginePublishVersionTask engine_task(transaction_id, job->partition_id, job->version, tablet_info,
+                                                     job->rowset);
+
+                job->status = worker_pool_this->_env->storage_engine()->execute_task(&engine_task);
+                if (!job->status.ok())
+                    LOG(WARNING) << "failed to publish version for tablet, tablet_id " << tablet_info.tablet_id
+                                 << ", txn_id " << transaction_id << ", err: " << job->status;
+            });
+
+            if (st.is_service_unavailable()) {
+                // Status::ServiceUnavailable is returned when all of the threads of the pool are busy.
+                LOG(WARNING) << "publish version threadpool is busy, retry later. [transaction_id="
+                             << publish_version_req.transaction_id
+                             << ", tablet_id=" << jobs[idx].tablet_info.tablet_id;
+                // In general, publish version is fast. A small sleep is needed here.
+                SleepFor(MonoDelta::FromMilliseconds(50 * retry_time));
+                continue;
+            }
+            break;
+        }
 
-            ++idx;
+        // error category:
+        // 1. ServiceUnavailable, which means that the threadpool is busy even in retry.
+        // 2. error that is not ServiceUnavailable.
+        // the tablets not submitted are reported as the error tablets, the submitted ones are still published.
+        if (!st.ok()) {
+            for (; pos < job_order.size(); pos++) {
+                jobs[job_order[pos]].status = st;
+            }
+            break;
         }
+    }
 
-        // wait until that all jobs in threadpool are done.
-        threadpool->wait();
-
-        // check status.
-        for (size_t i = 0; i < tablet_infos.size(); ++i) {
-            const auto& tablet_info = tablet_infos[i];
-            const auto& status = statuses[i];
-            if (!status.ok()) {
-                error_tablet_ids->push_back(tablet_info.tablet_id);
-                // Use the first non-ok status as error_status.
-                if (error_status.ok()) {
-                    error_status = status;
-                }
+    // wait until that all jobs in threadpool are done, the submitted jobs refer to |jobs|.
+    threadpool->wait();
+
+    // check status.
+    for (const auto& job : jobs) {
+        if (!job.status.ok()) {
+            error_tablet_ids->push_back(job.tablet_info.tablet_id);
+            // Use the first non-ok status as error_status.
+            if (error_status.ok()) {
+                error_status = job.status;
             }
         }
-        *tablet_n += tablet_infos.size();
     }
+    *tablet_n += jobs.size();
     return error_status;
 }
 
@@ -793,10 +809,8 @@ void* TaskWorkerPool::_publish_version_worker_thread_callback(void* arg_this) {
             ThreadPoolBuilder("publish_version")
                     .set_min_threads(config::partition_publish_version_worker_count)
                     .set_max_threads(config::partition_publish_version_worker_count)
-                    // The ideal queue size of threadpool should be larger than the maximum number of tablet of a partition.
-                    // But it seems that there's no limit for the number of tablets of a partition.
-                    // Since a large queue size brings a little overhead, a big one is chosen here.
-                    .set_max_queue_size(256)
+                    // All the tablets of a publish task are queued at once, and there's no limit for the number of
+                    // tablets of a transaction, so the queue is unbounded, a queued tablet takes a few bytes only.
                     .build(&threadpool);
 
     while (true) {
@@ -50,11 +50,17 @@ void BinaryColumn::append_selective(const Column& src, const uint32_t* indexes,
     _bytes.resize(cur_byte_size);
 
     auto* dest_bytes = _bytes.data();
-    for (uint32_t i = 0; i < size; i++) {
+    for (uint32_t i = 0; i < size;) {
+        // The rows of consecutive indexes, e.g. the probe rows of a join matching once, are copied together.
         uint32_t row_idx = indexes[from + i];
-        uint32_t str_size = src_offsets[row_idx + 1] - src_offsets[row_idx];
+        uint32_t run = 1;
+        while (i + run < size && indexes[from + i + run] == row_idx + run) {
+            run++;
+        }
+        uint32_t str_size = src_offsets[row_idx + run] - src_offsets[row_idx];
         strings::memcpy_inlined(dest_bytes + _offsets[cur_row_count + i], src_bytes.data() + src_offsets[row_idx],
                                 str_size);
+        i += run;
     }
 
     _slices_cache = false;
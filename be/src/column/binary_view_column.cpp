@@ -0,0 +1,235 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/binary_view_column.h"
+
+#include <algorithm>
+
+#include "column/binary_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
+#include "util/hash_util.hpp"
+#include "util/mysql_row_buffer.h"
+
+namespace starrocks::vectorized {
+
+const char* BinaryViewColumn::_copy_to_tail(const Slice& str) {
+    if (_tail_size + str.size > _tail_capacity) {
+        auto buffer = std::make_shared<StringBuffer>(std::max(kBufferSize, str.size));
+        _tail = buffer->data.get();
+        _tail_size = 0;
+        _tail_capacity = buffer->capacity;
+        _buffer_set.emplace(buffer.get());
+        _buffers.emplace_back(std::move(buffer));
+    }
+    char* dst = _tail + _tail_size;
+    strings::memcpy_inlined(dst, str.data, str.size);
+    _tail_size += str.size;
+    return dst;
+}
+
+void BinaryViewColumn::_share_buffers(const BinaryViewColumn& src) {
+    if (&src == this) {
+        return;
+    }
+    for (const auto& buffer : src._buffers) {
+        if (_buffer_set.emplace(buffer.get()).second) {
+            _buffers.emplace_back(buffer);
+        }
+    }
+}
+
+size_t BinaryViewColumn::_buffer_bytes() const {
+    size_t bytes = 0;
+    for (const auto& buffer : _buffers) {
+        bytes += buffer->capacity;
+    }
+    return bytes;
+}
+
+size_t BinaryViewColumn::byte_size(size_t from, size_t size) const {
+    DCHECK_LE(from + size, this->size()) << "Range error";
+    size_t bytes = size * sizeof(BinaryView);
+    for (size_t i = from; i < from + size; i++) {
+        if (!_views[i].is_inline()) {
+            bytes += _views[i].size();
+        }
+    }
+    return bytes;
+}
+
+void BinaryViewColumn::append(const Slice& str) {
+    if (str.size <= BinaryView::kInlineSize) {
+        _views.emplace_back(str.data, str.size);
+    } else {
+        _views.emplace_back(_copy_to_tail(str), str.size);
+    }
+}
+
+void BinaryViewColumn::append(const Column& src, size_t offset, size_t count) {
+    const auto& src_column = down_cast<const BinaryViewColumn&>(src);
+    _share_buffers(src_column);
+    _views.insert(_views.end(), src_column._views.begin() + offset, src_column._views.begin() + offset + count);
+}
+
+void BinaryViewColumn::append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
+    const auto& src_column = down_cast<const BinaryViewColumn&>(src);
+    _share_buffers(src_column);
+    size_t cur_size = _views.size();
+    _views.resize(cur_size + size);
+    const BinaryView* src_views = src_column._views.data();
+    BinaryView* dst_views = _views.data() + cur_size;
+    for (uint32_t i = 0; i < size; i++) {
+        dst_views[i] = src_views[indexes[from + i]];
+    }
+}
+
+void BinaryViewColumn::append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) {
+    const auto& src_column = down_cast<const BinaryViewColumn&>(src);
+    _share_buffers(src_column);
+    BinaryView view = src_column._views[index];
+    _views.insert(_views.end(), size, view);
+}
+
+void BinaryViewColumn::append_value_multiple_times(const void* value, size_t count) {
+    const Slice* slice = reinterpret_cast<const Slice*>(value);
+    if (count == 0) {
+        return;
+    }
+    append(*slice);
+    BinaryView view = _views.back();
+    _views.insert(_views.end(), count - 1, view);
+}
+
+void BinaryViewColumn::append_binary(const BinaryColumn& src, size_t offset, size_t count) {
+    _views.reserve(_views.size() + count);
+    for (size_t i = offset; i < offset + count; i++) {
+        append(src.get_slice(i));
+    }
+}
+
+void BinaryViewColumn::append_binary(const BinaryColumn& src) {
+    append_binary(src, 0, src.size());
+}
+
+void BinaryViewColumn::to_binary(BinaryColumn* dst) const {
+    size_t bytes = 0;
+    for (const BinaryView& view : _views) {
+        bytes += view.size();
+    }
+    dst->reserve(dst->size() + _views.size(), dst->get_bytes().size() + bytes);
+    for (const BinaryView& view : _views) {
+        dst->append(view.slice());
+    }
+}
+
+Status BinaryViewColumn::update_rows(const Column& src, const uint32_t* indexes) {
+    const auto& src_column = down_cast<const BinaryViewColumn&>(src);
+    _share_buffers(src_column);
+    size_t replace_num = src.size();
+    for (size_t i = 0; i < replace_num; ++i) {
+        DCHECK_LT(indexes[i], _views.size());
+        _views[indexes[i]] = src_column._views[i];
+    }
+    return Status::OK();
+}
+
+size_t BinaryViewColumn::filter_range(const Column::Filter& filter, size_t from, size_t to) {
+    size_t result_offset = from;
+    BinaryView* views = _views.data();
+    for (size_t i = from; i < to; ++i) {
+        views[result_offset] = views[i];
+        result_offset += (filter[i] != 0);
+    }
+    _views.resize(result_offset);
+    return result_offset;
+}
+
+int BinaryViewColumn::compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const {
+    const auto& right_column = down_cast<const BinaryViewColumn&>(rhs);
+    return _views[left].compare(right_column._views[right]);
+}
+
+uint32_t BinaryViewColumn::max_one_element_serialize_size() const {
+    uint32_t max_size = 0;
+    for (const BinaryView& view : _views) {
+        max_size = std::max(max_size, view.size());
+    }
+    return max_size + sizeof(uint32_t);
+}
+
+uint32_t BinaryViewColumn::serialize(size_t idx, uint8_t* pos) {
+    const BinaryView& view = _views[idx];
+    uint32_t binary_size = view.size();
+    strings::memcpy_inlined(pos, &binary_size, sizeof(uint32_t));
+    strings::memcpy_inlined(pos + sizeof(uint32_t), view.data(), binary_size);
+    return sizeof(uint32_t) + binary_size;
+}
+
+uint32_t BinaryViewColumn::serialize_default(uint8_t* pos) {
+    uint32_t binary_size = 0;
+    strings::memcpy_inlined(pos, &binary_size, sizeof(uint32_t));
+    return sizeof(uint32_t);
+}
+
+void BinaryViewColumn::serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                                       uint32_t max_one_row_size) {
+    for (size_t i = 0; i < chunk_size; ++i) {
+        slice_sizes[i] += serialize(i, dst + i * max_one_row_size + slice_sizes[i]);
+    }
+}
+
+const uint8_t* BinaryViewColumn::deserialize_and_append(const uint8_t* pos) {
+    uint32_t string_size{};
+    strings::memcpy_inlined(&string_size, pos, sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+    append(Slice(pos, string_size));
+    return pos + string_size;
+}
+
+void BinaryViewColumn::deserialize_and_append_batch(std::vector<Slice>& srcs, size_t chunk_size) {
+    _views.reserve(_views.size() + chunk_size);
+    for (size_t i = 0; i < chunk_size; ++i) {
+        srcs[i].data = (char*)deserialize_and_append((uint8_t*)srcs[i].data);
+    }
+}
+
+void BinaryViewColumn::fnv_hash(uint32_t* hashes, uint32_t from, uint32_t to) const {
+    for (uint32_t i = from; i < to; ++i) {
+        hashes[i] = HashUtil::fnv_hash(_views[i].data(), _views[i].size(), hashes[i]);
+    }
+}
+
+void BinaryViewColumn::crc32_hash(uint32_t* hashes, uint32_t from, uint32_t to) const {
+    // the crc of an empty string is the seed, the same as BinaryColumn
+    for (uint32_t i = from; i < to; ++i) {
+        hashes[i] = HashUtil::zlib_crc_hash(_views[i].data(), _views[i].size(), hashes[i]);
+    }
+}
+
+void BinaryViewColumn::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const {
+    buf->push_string(_views[idx].data(), _views[idx].size());
+}
+
+void BinaryViewColumn::swap_column(Column& rhs) {
+    auto& r = down_cast<BinaryViewColumn&>(rhs);
+    using std::swap;
+    swap(_delete_state, r._delete_state);
+    swap(_views, r._views);
+    swap(_buffers, r._buffers);
+    swap(_buffer_set, r._buffer_set);
+    swap(_tail, r._tail);
+    swap(_tail_size, r._tail_size);
+    swap(_tail_capacity, r._tail_capacity);
+}
+
+std::string BinaryViewColumn::debug_item(uint32_t idx) const {
+    std::string s;
+    auto slice = get_slice(idx);
+    s.reserve(slice.size + 2);
+    s.push_back('\'');
+    s.append(slice.data, slice.size);
+    s.push_back('\'');
+    return s;
+}
+
+} // namespace starrocks::vectorized
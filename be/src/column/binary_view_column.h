@@ -0,0 +1,301 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+#include "column/column.h"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+class BinaryColumn;
+
+// BinaryView is a 16 bytes reference to a string: its length, its first kPrefixSize bytes and then either the
+// rest of the string if it's no longer than kInlineSize bytes, or the pointer to the whole string.
+// The unused bytes are zeros, so two inlined strings are equal iff their views are.
+class BinaryView {
+public:
+    static constexpr uint32_t kPrefixSize = 4;
+    static constexpr uint32_t kInlineSize = 12;
+
+    BinaryView() = default;
+
+    // |data| must outlive the view if |size| > kInlineSize.
+    BinaryView(const char* data, uint32_t size) : _size(size) {
+        if (size <= kInlineSize) {
+            memcpy(_inline_data(), data, size);
+        } else {
+            memcpy(_prefix, data, kPrefixSize);
+            _value.data = data;
+        }
+    }
+
+    uint32_t size() const { return _size; }
+    bool is_inline() const { return _size <= kInlineSize; }
+    const char* data() const { return is_inline() ? _inline_data() : _value.data; }
+    Slice slice() const { return {data(), _size}; }
+
+    bool operator==(const BinaryView& rhs) const {
+        // the size and the prefix
+        if (memcmp(this, &rhs, sizeof(uint32_t) + kPrefixSize) != 0) {
+            return false;
+        }
+        if (is_inline()) {
+            return memcmp(_value.inlined, rhs._value.inlined, sizeof(_value.inlined)) == 0;
+        }
+        return memcmp(_value.data + kPrefixSize, rhs._value.data + kPrefixSize, _size - kPrefixSize) == 0;
+    }
+
+    bool operator!=(const BinaryView& rhs) const { return !(*this == rhs); }
+
+    int compare(const BinaryView& rhs) const {
+        // a prefix shorter than kPrefixSize is padded by zeros, which never reorders two strings
+        int r = memcmp(_prefix, rhs._prefix, kPrefixSize);
+        if (r != 0) {
+            return r;
+        }
+        return slice().compare(rhs.slice());
+    }
+
+private:
+    const char* _inline_data() const { return reinterpret_cast<const char*>(this) + sizeof(uint32_t); }
+    char* _inline_data() { return reinterpret_cast<char*>(this) + sizeof(uint32_t); }
+
+    uint32_t _size = 0;
+    char _prefix[kPrefixSize] = {};
+    // the bytes after the prefix of an inlined string follow the prefix immediately
+    union {
+        char inlined[kInlineSize - kPrefixSize];
+        const char* data;
+    } _value = {};
+};
+
+static_assert(sizeof(BinaryView) == 16, "BinaryView must be 16 bytes");
+
+// BinaryViewColumn is a string column of BinaryViews. The strings longer than BinaryView::kInlineSize are
+// kept in buffers which are never modified once written, so they are shared instead of copied by the
+// columns the views are filtered, gathered or appended to: only the 16 bytes views are moved around, and
+// most comparisons are decided by the lengths and the prefixes in the views.
+//
+// The buffers are kept alive as long as any column referring to them, even if all the rows referring to
+// a buffer are filtered out.
+//
+// The serialization and the hashes are the same as BinaryColumn's, and the column is converted from and
+// to BinaryColumn by append_binary() and to_binary().
+class BinaryViewColumn final : public ColumnFactory<Column, BinaryViewColumn> {
+    friend class ColumnFactory<Column, BinaryViewColumn>;
+
+public:
+    using ValueType = Slice;
+    using Container = Buffer<BinaryView>;
+
+    // the size of the buffers which the long strings are copied into
+    static constexpr size_t kBufferSize = 64 * 1024;
+
+    BinaryViewColumn() = default;
+
+    // The copy shares the buffers, but it never writes into them.
+    BinaryViewColumn(const BinaryViewColumn& rhs)
+            : _views(rhs._views), _buffers(rhs._buffers), _buffer_set(rhs._buffer_set) {}
+
+    BinaryViewColumn(BinaryViewColumn&& rhs) noexcept
+            : _views(std::move(rhs._views)),
+              _buffers(std::move(rhs._buffers)),
+              _buffer_set(std::move(rhs._buffer_set)),
+              _tail(rhs._tail),
+              _tail_size(rhs._tail_size),
+              _tail_capacity(rhs._tail_capacity) {
+        rhs.reset_column();
+    }
+
+    BinaryViewColumn& operator=(const BinaryViewColumn& rhs) {
+        BinaryViewColumn tmp(rhs);
+        this->swap_column(tmp);
+        return *this;
+    }
+
+    BinaryViewColumn& operator=(BinaryViewColumn&& rhs) noexcept {
+        BinaryViewColumn tmp(std::move(rhs));
+        this->swap_column(tmp);
+        return *this;
+    }
+
+    ~BinaryViewColumn() override = default;
+
+    const uint8_t* raw_data() const override { return reinterpret_cast<const uint8_t*>(_views.data()); }
+
+    uint8_t* mutable_raw_data() override { return reinterpret_cast<uint8_t*>(_views.data()); }
+
+    size_t size() const override { return _views.size(); }
+
+    size_t capacity() const override { return _views.capacity(); }
+
+    size_t type_size() const override { return sizeof(BinaryView); }
+
+    size_t byte_size() const override { return byte_size(0, size()); }
+
+    size_t byte_size(size_t from, size_t size) const override;
+
+    size_t byte_size(size_t idx) const override { return _views[idx].size() + sizeof(uint32_t); }
+
+    Slice get_slice(size_t idx) const { return _views[idx].slice(); }
+
+    void reserve(size_t n) override { _views.reserve(n); }
+
+    void resize(size_t n) override { _views.resize(n); }
+
+    void assign(size_t n, size_t idx) override {
+        BinaryView view = _views[idx];
+        _views.assign(n, view);
+    }
+
+    void remove_first_n_values(size_t count) override {
+        DCHECK_LE(count, _views.size());
+        _views.erase(_views.begin(), _views.begin() + count);
+    }
+
+    void append(const Slice& str);
+
+    void append_datum(const Datum& datum) override { append(datum.get_slice()); }
+
+    void append(const Column& src, size_t offset, size_t count) override;
+
+    void append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) override;
+
+    void append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) override;
+
+    bool append_nulls(size_t count) override { return false; }
+
+    bool append_strings(const std::vector<Slice>& strs) override {
+        for (const auto& s : strs) {
+            append(s);
+        }
+        return true;
+    }
+
+    size_t append_numbers(const void* buff, size_t length) override { return -1; }
+
+    void append_value_multiple_times(const void* value, size_t count) override;
+
+    void append_default() override { _views.emplace_back(); }
+
+    void append_default(size_t count) override { _views.resize(_views.size() + count); }
+
+    // Appends the rows [offset, offset + count) of |src|, copying the long strings into the buffers.
+    void append_binary(const BinaryColumn& src, size_t offset, size_t count);
+    void append_binary(const BinaryColumn& src);
+
+    // Appends all the rows to |dst|.
+    void to_binary(BinaryColumn* dst) const;
+
+    Status update_rows(const Column& src, const uint32_t* indexes) override;
+
+    uint32_t max_one_element_serialize_size() const override;
+
+    uint32_t serialize(size_t idx, uint8_t* pos) override;
+
+    uint32_t serialize_default(uint8_t* pos) override;
+
+    void serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                         uint32_t max_one_row_size) override;
+
+    const uint8_t* deserialize_and_append(const uint8_t* pos) override;
+
+    void deserialize_and_append_batch(std::vector<Slice>& srcs, size_t chunk_size) override;
+
+    uint32_t serialize_size(size_t idx) const override { return sizeof(uint32_t) + _views[idx].size(); }
+
+    MutableColumnPtr clone_empty() const override { return create_mutable(); }
+
+    size_t filter_range(const Column::Filter& filter, size_t from, size_t to) override;
+
+    int compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const override;
+
+    bool equals(size_t left, const BinaryViewColumn& rhs, size_t right) const {
+        return _views[left] == rhs._views[right];
+    }
+
+    void fnv_hash(uint32_t* hashes, uint32_t from, uint32_t to) const override;
+
+    void crc32_hash(uint32_t* hashes, uint32_t from, uint32_t to) const override;
+
+    void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override;
+
+    std::string get_name() const override { return "binary-view"; }
+
+    Container& get_data() { return _views; }
+    const Container& get_data() const { return _views; }
+
+    // The number of the buffers referred to, including the ones shared with other columns.
+    size_t num_buffers() const { return _buffers.size(); }
+
+    Datum get(size_t n) const override { return Datum(get_slice(n)); }
+
+    size_t container_memory_usage() const override {
+        return _views.capacity() * sizeof(BinaryView) + _buffer_bytes();
+    }
+
+    size_t shrink_memory_usage() const override { return _views.size() * sizeof(BinaryView) + _buffer_bytes(); }
+
+    void swap_column(Column& rhs) override;
+
+    void reset_column() override {
+        Column::reset_column();
+        _views.clear();
+        _buffers.clear();
+        _buffer_set.clear();
+        _tail = nullptr;
+        _tail_size = 0;
+        _tail_capacity = 0;
+    }
+
+    std::string debug_item(uint32_t idx) const override;
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "[";
+        for (size_t i = 0; i < size(); ++i) {
+            if (i > 0) {
+                ss << ", ";
+            }
+            ss << debug_item(i);
+        }
+        ss << "]";
+        return ss.str();
+    }
+
+    bool reach_capacity_limit() const override { return _views.size() >= Column::MAX_CAPACITY_LIMIT; }
+
+private:
+    struct StringBuffer {
+        explicit StringBuffer(size_t capacity) : data(new char[capacity]), capacity(capacity) {}
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+    };
+    using StringBufferPtr = std::shared_ptr<const StringBuffer>;
+
+    // Copies |str| into the tail buffer and returns the copy.
+    const char* _copy_to_tail(const Slice& str);
+
+    // Refers to all the buffers of |src|.
+    void _share_buffers(const BinaryViewColumn& src);
+
+    size_t _buffer_bytes() const;
+
+    Container _views;
+    std::vector<StringBufferPtr> _buffers;
+    std::unordered_set<const StringBuffer*> _buffer_set;
+
+    // The buffer the long strings appended are copied into. It's one of |_buffers| allocated by this
+    // column, only its bytes beyond |_tail_size| are ever written.
+    char* _tail = nullptr;
+    size_t _tail_size = 0;
+    size_t _tail_capacity = 0;
+};
+
+} // namespace starrocks::vectorized
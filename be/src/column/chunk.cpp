@@ -9,6 +9,7 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
 #include "util/coding.h"
+#include "util/hash_util.hpp"
 
 namespace starrocks::vectorized {
 
@@ -43,6 +44,7 @@ void Chunk::reset() {
         c->reset_column();
     }
     _delete_state = DEL_NOT_SATISFIED;
+    _hash_caches.clear();
 }
 
 void Chunk::swap_chunk(Chunk& other) {
@@ -52,12 +54,14 @@ void Chunk::swap_chunk(Chunk& other) {
     _slot_id_to_index.swap(other._slot_id_to_index);
     _tuple_id_to_index.swap(other._tuple_id_to_index);
     std::swap(_delete_state, other._delete_state);
+    _hash_caches.swap(other._hash_caches);
 }
 
 void Chunk::set_num_rows(size_t count) {
     for (ColumnPtr& c : _columns) {
         c->resize(count);
     }
+    _hash_caches.clear();
 }
 
 std::string_view Chunk::get_column_name(size_t idx) const {
@@ -81,6 +85,7 @@ void Chunk::append_column(ColumnPtr column, SlotId slot_id) {
 
 void Chunk::update_column(ColumnPtr column, SlotId slot_id) {
     _columns[_slot_id_to_index[slot_id]] = std::move(column);
+    _hash_caches.clear();
     check_or_die();
 }
 
@@ -101,17 +106,31 @@ void Chunk::append_tuple_column(const ColumnPtr& column, TupleId tuple_id) {
 void Chunk::remove_column_by_index(size_t idx) {
     DCHECK_LT(idx, _columns.size());
     _columns.erase(_columns.begin() + idx);
+    _hash_caches.clear();
     if (_schema != nullptr) {
         _schema->remove(idx);
         rebuild_cid_index();
     }
 }
 
+void Chunk::remove_column_by_slot_id(SlotId slot_id) {
+    DCHECK(is_slot_exist(slot_id));
+    size_t idx = _slot_id_to_index[slot_id];
+    _slot_id_to_index.erase(slot_id);
+    for (auto& [id, index] : _slot_id_to_index) {
+        if (index > idx) {
+            index--;
+        }
+    }
+    remove_column_by_index(idx);
+}
+
 void Chunk::remove_columns_by_index(const std::vector<size_t>& indexes) {
     DCHECK(std::is_sorted(indexes.begin(), indexes.end()));
     for (int i = indexes.size(); i > 0; i--) {
         _columns.erase(_columns.begin() + indexes[i - 1]);
     }
+    _hash_caches.clear();
     if (_schema != nullptr && !indexes.empty()) {
         for (int i = indexes.size(); i > 0; i--) {
             _schema->remove(indexes[i - 1]);
@@ -195,9 +214,11 @@ void Chunk::append_selective(const Chunk& src, const uint32_t* indexes, uint32_t
     for (size_t i = 0; i < _columns.size(); ++i) {
         _columns[i]->append_selective(*src.columns()[i].get(), indexes, from, size);
     }
+    _hash_caches.clear();
 }
 
 size_t Chunk::filter(const Buffer<uint8_t>& selection) {
+    filter_hash_caches(selection, 0, selection.size());
     for (auto& column : _columns) {
         column->filter(selection);
     }
@@ -205,12 +226,101 @@ size_t Chunk::filter(const Buffer<uint8_t>& selection) {
 }
 
 size_t Chunk::filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to) {
+    filter_hash_caches(selection, from, to);
     for (auto& column : _columns) {
         column->filter_range(selection, from, to);
     }
     return num_rows();
 }
 
+void Chunk::filter_hash_caches(const Buffer<uint8_t>& selection, size_t from, size_t to) {
+    if (_hash_caches.empty()) {
+        return;
+    }
+    // the stale hashes, see cached_hashes(), may be shorter than the selection
+    const size_t rows = num_rows();
+    _hash_caches.erase(std::remove_if(_hash_caches.begin(), _hash_caches.end(),
+                                      [rows](const HashCache& cache) { return cache.hashes.size() != rows; }),
+                       _hash_caches.end());
+    for (HashCache& cache : _hash_caches) {
+        cache.hashes.resize(ColumnHelper::filter_range<uint32_t>(selection, cache.hashes.data(), from, to));
+    }
+}
+
+void Chunk::hash_columns(const Columns& columns, HashAlgorithm algorithm, std::vector<uint32_t>* hashes) const {
+    if (const auto* cached = cached_hashes(columns, algorithm); cached != nullptr) {
+        hashes->assign(cached->begin(), cached->end());
+        return;
+    }
+    const size_t n = num_rows();
+    if (algorithm == HashAlgorithm::FNV) {
+        hashes->assign(n, HashUtil::FNV_SEED);
+        for (const ColumnPtr& column : columns) {
+            column->fnv_hash(hashes->data(), 0, n);
+        }
+    } else {
+        hashes->assign(n, 0);
+        for (const ColumnPtr& column : columns) {
+            column->crc32_hash(hashes->data(), 0, n);
+        }
+    }
+}
+
+const std::vector<uint32_t>* Chunk::cache_hashes(const Columns& columns, HashAlgorithm algorithm,
+                                                 std::vector<uint32_t>&& hashes) {
+    if (columns.empty() || hashes.size() != num_rows()) {
+        return nullptr;
+    }
+    std::vector<const Column*> keys;
+    keys.reserve(columns.size());
+    for (const ColumnPtr& column : columns) {
+        if (!contains_column(column.get())) {
+            return nullptr;
+        }
+        keys.push_back(column.get());
+    }
+    for (HashCache& cache : _hash_caches) {
+        if (cache.algorithm == algorithm && cache.columns == keys) {
+            cache.hashes = std::move(hashes);
+            return &cache.hashes;
+        }
+    }
+    _hash_caches.push_back({std::move(keys), algorithm, std::move(hashes)});
+    return &_hash_caches.back().hashes;
+}
+
+const std::vector<uint32_t>* Chunk::cached_hashes(const Columns& columns, HashAlgorithm algorithm) const {
+    for (const HashCache& cache : _hash_caches) {
+        if (cache.algorithm != algorithm || cache.columns.size() != columns.size()) {
+            continue;
+        }
+        bool same = true;
+        for (size_t i = 0; i < columns.size() && same; i++) {
+            same = cache.columns[i] == columns[i].get();
+        }
+        // The columns may be changed through columns() or get_column_by_xxx() without dropping the cache, so the
+        // hashes are only trusted if the columns are still here with the same number of rows.
+        if (same && cache.hashes.size() == num_rows()) {
+            for (const Column* column : cache.columns) {
+                if (!contains_column(column)) {
+                    return nullptr;
+                }
+            }
+            return &cache.hashes;
+        }
+    }
+    return nullptr;
+}
+
+bool Chunk::contains_column(const Column* column) const {
+    for (const ColumnPtr& c : _columns) {
+        if (c.get() == column) {
+            return true;
+        }
+    }
+    return false;
+}
+
 DatumTuple Chunk::get(size_t n) const {
     DatumTuple res;
     res.reserve(_columns.size());
@@ -309,6 +419,7 @@ void Chunk::append(const Chunk& src, size_t offset, size_t count) {
         ColumnPtr& c = get_column_by_index(i);
         c->append(*src.get_column_by_index(i), offset, count);
     }
+    _hash_caches.clear();
 }
 
 void Chunk::append_safe(const Chunk& src, size_t offset, size_t count) {
@@ -322,6 +433,7 @@ void Chunk::append_safe(const Chunk& src, size_t offset, size_t count) {
             c->append(*src.get_column_by_index(i), offset, count);
         }
     }
+    _hash_caches.clear();
 }
 
 void Chunk::reserve(size_t cap) {
@@ -26,6 +26,14 @@ public:
     using ColumnIdHashMap = phmap::flat_hash_map<ColumnId, size_t, StdHash<SlotId>>;
     using TupleHashMap = phmap::flat_hash_map<TupleId, size_t, StdHash<TupleId>>;
 
+    // The hash functions of the rows cached by hash_columns(), see cache_hashes().
+    enum class HashAlgorithm {
+        // Column::fnv_hash() from HashUtil::FNV_SEED, the hash of the shuffle of HASH_PARTITIONED
+        FNV,
+        // Column::crc32_hash() from 0, the hash of the shuffle of BUCKET_SHFFULE_HASH_PARTITIONED
+        CRC32,
+    };
+
     Chunk();
     Chunk(Columns columns, SchemaPtr schema);
     Chunk(Columns columns, const SlotHashMap& slot_map);
@@ -79,6 +87,9 @@ public:
 
     void remove_column_by_index(size_t idx);
 
+    // Must ensure the slot_id exist
+    void remove_column_by_slot_id(SlotId slot_id);
+
     // Remove multiple columns by their indexes.
     // For simplicity and better performance, we are assuming |indexes| all all valid
     // and is sorted in ascending order, if it's not, unexpected columns may be removed (silently).
@@ -107,7 +118,10 @@ public:
     bool is_tuple_exist(TupleId id) const { return _tuple_id_to_index.contains(id); }
     void reset_slot_id_to_index() { _slot_id_to_index.clear(); }
 
-    void set_columns(const Columns& columns) { _columns = columns; }
+    void set_columns(const Columns& columns) {
+        _columns = columns;
+        _hash_caches.clear();
+    }
 
     // Create an empty chunk with the same meta and reserve it of size chunk _num_rows
     // not clone tuple column
@@ -200,6 +214,29 @@ public:
 
     bool has_const_column() const;
 
+    // Computes the hashes of the rows over |columns| into |hashes| with |algorithm|, like the shuffle of the
+    // exchange does, or copies them if they are cached for the same columns and algorithm.
+    void hash_columns(const Columns& columns, HashAlgorithm algorithm, std::vector<uint32_t>* hashes) const;
+
+    // Caches the hashes computed by hash_columns(), so that an operator hashing the same key columns later,
+    // e.g. the exchange sink after the partitioned runtime filter of a scan, reuses them instead of hashing
+    // again. Returns the cached hashes, or nullptr if nothing is cached because some of |columns| are not
+    // the columns of this chunk, e.g. the result of an expression.
+    //
+    // The cached hashes are filtered with the rows by filter() and filter_range(), and dropped by the other
+    // methods changing the rows or the columns. An operator changing the data of the columns in place must
+    // call clear_hash_cache().
+    const std::vector<uint32_t>* cache_hashes(const Columns& columns, HashAlgorithm algorithm,
+                                              std::vector<uint32_t>&& hashes);
+
+    // Returns the hashes cached for |columns| with |algorithm|, or nullptr.
+    const std::vector<uint32_t>* cached_hashes(const Columns& columns, HashAlgorithm algorithm) const;
+
+    void clear_hash_cache() { _hash_caches.clear(); }
+
+    // Whether |column| is one of the columns of this chunk.
+    bool contains_column(const Column* column) const;
+
 #ifndef NDEBUG
     // check whether the internal state is consistent, abort the program if check failed.
     void check_or_die();
@@ -230,8 +267,16 @@ public:
     }
 
 private:
+    struct HashCache {
+        std::vector<const Column*> columns;
+        HashAlgorithm algorithm;
+        std::vector<uint32_t> hashes;
+    };
+
     void rebuild_cid_index();
 
+    void filter_hash_caches(const Buffer<uint8_t>& selection, size_t from, size_t to);
+
     Columns _columns;
     std::shared_ptr<Schema> _schema;
     ColumnIdHashMap _cid_to_index;
@@ -239,6 +284,8 @@ private:
     SlotHashMap _slot_id_to_index;
     TupleHashMap _tuple_id_to_index;
     DelCondSatisfied _delete_state = DEL_NOT_SATISFIED;
+    // usually empty, or one entry for the keys of the shuffle
+    std::vector<HashCache> _hash_caches;
 };
 
 inline const ColumnPtr& Chunk::get_column_by_name(const std::string& column_name) const {
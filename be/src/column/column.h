@@ -62,6 +62,9 @@ public:
 
     virtual bool is_constant() const { return false; }
 
+    // If true means this is a RleColumn
+    virtual bool is_rle() const { return false; }
+
     virtual bool is_binary() const { return false; }
 
     virtual bool is_decimal() const { return false; }
@@ -277,6 +277,26 @@ inline uint64_t crc_hash_uint128(uint64_t value0, uint64_t value1, uint64_t seed
     return hash;
 }
 
+// The finalizers of murmur3, which mix every bit of the value into the hash. Unlike CRC32, they only take
+// multiplications, shifts and xors, so the loops hashing a column are vectorized by the compiler.
+inline uint32_t fmix32(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+inline uint64_t fmix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
 // https://github.com/HowardHinnant/hash_append/issues/7
 template <typename T>
 inline void hash_combine(uint64_t& seed, const T& val) {
@@ -14,6 +14,7 @@
 #include "gutil/bits.h"
 #include "gutil/casts.h"
 #include "runtime/primitive_type.h"
+#include "simd/gather.h"
 
 namespace starrocks {
 struct TypeDescriptor;
@@ -242,8 +243,11 @@ public:
     static size_t compute_bytes_size(ColumnsConstIterator const& begin, ColumnsConstIterator const& end);
     template <typename T>
     static size_t filter_range(const Column::Filter& filter, T* data, size_t from, size_t to) {
-        auto start_offset = from;
-        auto result_offset = from;
+        size_t start_offset = from;
+        size_t result_offset = from;
+
+        // the AVX-512 compress of the 32-bit and 64-bit types, if the CPU supports it
+        SIMD::compress_store(filter.data(), data, &start_offset, &result_offset, to);
 
 #ifdef __AVX2__
         const uint8_t* f_data = filter.data();
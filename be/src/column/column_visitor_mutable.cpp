@@ -11,6 +11,9 @@ VISIT_IMPL(vectorized::NullableColumn)
 VISIT_IMPL(vectorized::ConstColumn)
 VISIT_IMPL(vectorized::ArrayColumn)
 VISIT_IMPL(vectorized::BinaryColumn)
+VISIT_IMPL(vectorized::BinaryViewColumn)
+VISIT_IMPL(vectorized::LowCardinalityColumn)
+VISIT_IMPL(vectorized::RleColumn)
 VISIT_IMPL(vectorized::Int8Column)
 VISIT_IMPL(vectorized::UInt8Column)
 VISIT_IMPL(vectorized::Int16Column)
@@ -20,6 +20,9 @@ public:
     virtual Status visit(vectorized::ConstColumn* column);
     virtual Status visit(vectorized::ArrayColumn* column);
     virtual Status visit(vectorized::BinaryColumn* column);
+    virtual Status visit(vectorized::BinaryViewColumn* column);
+    virtual Status visit(vectorized::LowCardinalityColumn* column);
+    virtual Status visit(vectorized::RleColumn* column);
     virtual Status visit(vectorized::Int8Column* column);
     virtual Status visit(vectorized::UInt8Column* column);
     virtual Status visit(vectorized::Int16Column* column);
@@ -6,6 +6,7 @@
 #include "column/fixed_length_column.h"
 #include "gutil/casts.h"
 #include "runtime/large_int_value.h"
+#include "simd/gather.h"
 #include "storage/decimal12.h"
 #include "storage/uint24.h"
 #include "util/coding.h"
@@ -26,9 +27,7 @@ void FixedLengthColumnBase<T>::append_selective(const Column& src, const uint32_
     const T* src_data = reinterpret_cast<const T*>(src.raw_data());
     size_t orig_size = _data.size();
     _data.resize(orig_size + size);
-    for (size_t i = 0; i < size; ++i) {
-        _data[orig_size + i] = src_data[indexes[from + i]];
-    }
+    SIMD::gather(_data.data() + orig_size, src_data, indexes + from, size);
 }
 
 template <typename T>
@@ -207,6 +206,11 @@ void FixedLengthColumnBase<T>::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t
         buf->push_decimal(_data[idx].to_string());
     } else if constexpr (std::is_arithmetic_v<T>) {
         buf->push_number(_data[idx]);
+    } else if constexpr (std::is_same_v<T, DateValue> || std::is_same_v<T, TimestampValue>) {
+        // formatted on the stack, without the temporary string of to_string()
+        char s[T::max_string_length()];
+        int len = _data[idx].to_string(s, sizeof(s));
+        buf->push_string(s, len);
     } else {
         // date/datetime or something else.
         std::string s = _data[idx].to_string();
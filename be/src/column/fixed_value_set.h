@@ -0,0 +1,216 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "column/hash_set.h"
+#include "common/compiler_util.h"
+
+namespace starrocks::vectorized {
+
+// FixedValueSet is the set of the integer values of an IN list, it's inserted while the list is built and then
+// probed by the rows of the columns: by the IN predicates pushed down to the scan, the IN predicates of the
+// expressions and the IN runtime filters of the joins. The lookups use the representation that fits the values:
+// - at most kMaxLinearValues values are compared with a value all at once;
+// - the values within a range of kMaxBitmapRange are tested in a bitmap of the range, which keeps room around
+//   the values for the later ones;
+// - otherwise the values are looked up in a HashSet, a batch of rows at a time with their buckets prefetched
+//   before the probes when the set is large.
+// The HashSet of the values is always kept, for the iteration.
+template <typename T>
+class FixedValueSet {
+    static_assert(std::is_integral_v<T>, "FixedValueSet is only for the integers");
+
+public:
+    using value_type = T;
+    using const_iterator = typename HashSet<T>::const_iterator;
+    using iterator = const_iterator;
+
+    static constexpr size_t kMaxLinearValues = 16;
+    static constexpr uint64_t kMaxBitmapRange = 1 << 16;
+    // the HashSet is expected to miss the cache beyond it
+    static constexpr size_t kMinPrefetchBytes = 256 * 1024;
+    static constexpr size_t kProbeBatchSize = 64;
+
+    enum class Kind { LINEAR, BITMAP, HASH };
+
+    FixedValueSet() = default;
+
+    std::pair<const_iterator, bool> emplace(const T& value) {
+        auto ret = _values.emplace(value);
+        if (ret.second) {
+            _insert(value);
+        }
+        return ret;
+    }
+
+    template <typename Iterator>
+    void insert(Iterator begin, Iterator end) {
+        for (; begin != end; ++begin) {
+            emplace(*begin);
+        }
+    }
+
+    void clear() {
+        _values.clear();
+        _bitmap.clear();
+        _kind = Kind::LINEAR;
+    }
+
+    Kind kind() const { return _kind; }
+    size_t size() const { return _values.size(); }
+    bool empty() const { return _values.empty(); }
+    const_iterator begin() const { return _values.begin(); }
+    const_iterator end() const { return _values.end(); }
+
+    bool contains(const T& value) const {
+        switch (_kind) {
+        case Kind::LINEAR:
+            return _linear_contains(value);
+        case Kind::BITMAP:
+            return _bitmap_contains(value);
+        case Kind::HASH:
+            break;
+        }
+        return _values.contains(value);
+    }
+
+    // Sets `out[i]` to whether `values[i]` is in the set.
+    void contains(const T* values, size_t size, uint8_t* out) const {
+        switch (_kind) {
+        case Kind::LINEAR:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = _linear_contains(values[i]);
+            }
+            return;
+        case Kind::BITMAP:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = _bitmap_contains(values[i]);
+            }
+            return;
+        case Kind::HASH:
+            break;
+        }
+        if (_values.capacity() * sizeof(T) < kMinPrefetchBytes) {
+            for (size_t i = 0; i < size; i++) {
+                out[i] = _values.contains(values[i]);
+            }
+            return;
+        }
+        size_t hashes[kProbeBatchSize];
+        for (size_t start = 0; start < size; start += kProbeBatchSize) {
+            size_t num = std::min(kProbeBatchSize, size - start);
+            for (size_t i = 0; i < num; i++) {
+                hashes[i] = _values.hash_function()(values[start + i]);
+                _values.prefetch_hash(hashes[i]);
+            }
+            for (size_t i = 0; i < num; i++) {
+                out[start + i] = _values.contains(values[start + i], hashes[i]);
+            }
+        }
+    }
+
+private:
+    static constexpr bool can_use_bitmap() { return sizeof(T) <= sizeof(uint64_t) && !std::is_same_v<T, bool>; }
+
+    void _insert(const T& value) {
+        size_t num_values = _values.size();
+        if (_kind == Kind::LINEAR) {
+            if (num_values <= kMaxLinearValues) {
+                // the unused slots repeat the first value, so all the slots are compared without a branch
+                if (num_values == 1) {
+                    std::fill(_linear, _linear + kMaxLinearValues, value);
+                } else {
+                    _linear[num_values - 1] = value;
+                }
+                return;
+            }
+            _rebuild_bitmap_or_hash();
+        } else if (_kind == Kind::BITMAP) {
+            uint64_t offset = _offset(value);
+            if (offset < kMaxBitmapRange) {
+                _bitmap[offset >> 6] |= 1ULL << (offset & 63);
+            } else {
+                _rebuild_bitmap_or_hash();
+            }
+        }
+    }
+
+    void _rebuild_bitmap_or_hash() {
+        _kind = Kind::HASH;
+        _bitmap.clear();
+        if constexpr (can_use_bitmap()) {
+            auto [min, max] = std::minmax_element(_values.begin(), _values.end());
+            uint64_t diff = static_cast<uint64_t>(*max) - static_cast<uint64_t>(*min);
+            if (diff >= kMaxBitmapRange) {
+                return;
+            }
+            // center the values in the bitmap
+            _base = static_cast<uint64_t>(*min) - (kMaxBitmapRange - diff - 1) / 2;
+            _bitmap.assign(kMaxBitmapRange / 64, 0);
+            for (const T& v : _values) {
+                uint64_t offset = _offset(v);
+                _bitmap[offset >> 6] |= 1ULL << (offset & 63);
+            }
+            _kind = Kind::BITMAP;
+        }
+    }
+
+    // The arithmetic of uint64_t is modular, so the difference needs no overflow check.
+    uint64_t _offset(const T& value) const { return static_cast<uint64_t>(value) - _base; }
+
+    bool _bitmap_contains(const T& value) const {
+        uint64_t offset = _offset(value);
+        return offset < kMaxBitmapRange && ((_bitmap[offset >> 6] >> (offset & 63)) & 1);
+    }
+
+    bool _linear_contains(const T& value) const {
+        if (UNLIKELY(_values.empty())) {
+            return false;
+        }
+#ifdef __AVX2__
+        if constexpr (sizeof(T) == 4) {
+            const __m256i key = _mm256_set1_epi32(value);
+            const auto* data = reinterpret_cast<const __m256i*>(_linear);
+            __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi32(key, _mm256_loadu_si256(data)),
+                                         _mm256_cmpeq_epi32(key, _mm256_loadu_si256(data + 1)));
+            return !_mm256_testz_si256(eq, eq);
+        } else if constexpr (sizeof(T) == 8) {
+            const __m256i key = _mm256_set1_epi64x(value);
+            const auto* data = reinterpret_cast<const __m256i*>(_linear);
+            __m256i eq0 = _mm256_or_si256(_mm256_cmpeq_epi64(key, _mm256_loadu_si256(data)),
+                                          _mm256_cmpeq_epi64(key, _mm256_loadu_si256(data + 1)));
+            __m256i eq1 = _mm256_or_si256(_mm256_cmpeq_epi64(key, _mm256_loadu_si256(data + 2)),
+                                          _mm256_cmpeq_epi64(key, _mm256_loadu_si256(data + 3)));
+            __m256i eq = _mm256_or_si256(eq0, eq1);
+            return !_mm256_testz_si256(eq, eq);
+        }
+#endif
+        uint8_t found = 0;
+        for (size_t i = 0; i < kMaxLinearValues; i++) {
+            found |= (_linear[i] == value);
+        }
+        return found;
+    }
+
+    HashSet<T> _values;
+    Kind _kind = Kind::LINEAR;
+
+    // LINEAR only
+    T _linear[kMaxLinearValues];
+
+    // BITMAP only, bit i is for the value _base + i
+    uint64_t _base = 0;
+    std::vector<uint64_t> _bitmap;
+};
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,211 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/low_cardinality_column.h"
+
+#include <algorithm>
+
+#include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
+#include "util/hash_util.hpp"
+#include "util/mysql_row_buffer.h"
+
+namespace starrocks::vectorized {
+
+std::shared_ptr<const LowCardDictionary> LowCardDictionary::create(const std::vector<Slice>& values) {
+    auto dict = std::make_shared<LowCardDictionary>();
+    auto column = BinaryColumn::create();
+    column->append_strings(values);
+    dict->_values = std::move(column);
+    dict->_codes.reserve(values.size());
+    dict->_sorted = true;
+    for (Code code = 0; code < static_cast<Code>(values.size()); code++) {
+        Slice value = dict->get(code);
+        bool inserted = dict->_codes.emplace(value, code).second;
+        DCHECK(inserted) << "duplicated value in the dictionary: " << value.to_string();
+        if (code > 0 && dict->get(code - 1).compare(value) >= 0) {
+            dict->_sorted = false;
+        }
+    }
+    return dict;
+}
+
+LowCardinalityColumn::Ptr LowCardinalityColumn::encode(const LowCardDictionaryPtr& dict, const BinaryColumn& src) {
+    auto column = create(dict);
+    column->_codes.reserve(src.size());
+    for (size_t i = 0; i < src.size(); i++) {
+        if (!column->append(src.get_slice(i))) {
+            return nullptr;
+        }
+    }
+    return column;
+}
+
+void LowCardinalityColumn::decode(BinaryColumn* dst) const {
+    size_t bytes = 0;
+    for (Code code : _codes) {
+        bytes += _dict->get(code).size;
+    }
+    dst->reserve(dst->size() + _codes.size(), dst->get_bytes().size() + bytes);
+    for (Code code : _codes) {
+        dst->append(_dict->get(code));
+    }
+}
+
+BinaryColumn::Ptr LowCardinalityColumn::decode() const {
+    auto column = BinaryColumn::create();
+    decode(column.get());
+    return column;
+}
+
+void LowCardinalityColumn::append(const Column& src, size_t offset, size_t count) {
+    const auto& src_column = down_cast<const LowCardinalityColumn&>(src);
+    DCHECK_EQ(_dict.get(), src_column._dict.get());
+    _codes.insert(_codes.end(), src_column._codes.begin() + offset, src_column._codes.begin() + offset + count);
+}
+
+void LowCardinalityColumn::append_selective(const Column& src, const uint32_t* indexes, uint32_t from,
+                                            uint32_t size) {
+    const auto& src_column = down_cast<const LowCardinalityColumn&>(src);
+    DCHECK_EQ(_dict.get(), src_column._dict.get());
+    size_t cur_size = _codes.size();
+    _codes.resize(cur_size + size);
+    const Code* src_codes = src_column._codes.data();
+    Code* dst_codes = _codes.data() + cur_size;
+    for (uint32_t i = 0; i < size; i++) {
+        dst_codes[i] = src_codes[indexes[from + i]];
+    }
+}
+
+void LowCardinalityColumn::append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) {
+    const auto& src_column = down_cast<const LowCardinalityColumn&>(src);
+    DCHECK_EQ(_dict.get(), src_column._dict.get());
+    _codes.insert(_codes.end(), size, src_column._codes[index]);
+}
+
+bool LowCardinalityColumn::append_strings(const std::vector<Slice>& strs) {
+    size_t old_size = _codes.size();
+    for (const auto& s : strs) {
+        if (!append(s)) {
+            _codes.resize(old_size);
+            return false;
+        }
+    }
+    return true;
+}
+
+void LowCardinalityColumn::append_value_multiple_times(const void* value, size_t count) {
+    const Slice* slice = reinterpret_cast<const Slice*>(value);
+    Code code = _dict->find(*slice);
+    DCHECK_GE(code, 0) << "'" << slice->to_string() << "' is not in the dictionary";
+    _codes.insert(_codes.end(), count, code);
+}
+
+Status LowCardinalityColumn::update_rows(const Column& src, const uint32_t* indexes) {
+    const auto& src_column = down_cast<const LowCardinalityColumn&>(src);
+    DCHECK_EQ(_dict.get(), src_column._dict.get());
+    size_t replace_num = src.size();
+    for (size_t i = 0; i < replace_num; ++i) {
+        DCHECK_LT(indexes[i], _codes.size());
+        _codes[indexes[i]] = src_column._codes[i];
+    }
+    return Status::OK();
+}
+
+size_t LowCardinalityColumn::filter_range(const Column::Filter& filter, size_t from, size_t to) {
+    size_t result_offset = from;
+    Code* codes = _codes.data();
+    for (size_t i = from; i < to; ++i) {
+        codes[result_offset] = codes[i];
+        result_offset += (filter[i] != 0);
+    }
+    _codes.resize(result_offset);
+    return result_offset;
+}
+
+int LowCardinalityColumn::compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const {
+    const auto& right_column = down_cast<const LowCardinalityColumn&>(rhs);
+    Code lhs_code = _codes[left];
+    Code rhs_code = right_column._codes[right];
+    if (_dict == right_column._dict && (lhs_code == rhs_code || _dict->sorted())) {
+        return (lhs_code > rhs_code) - (lhs_code < rhs_code);
+    }
+    return _dict->get(lhs_code).compare(right_column._dict->get(rhs_code));
+}
+
+uint32_t LowCardinalityColumn::max_one_element_serialize_size() const {
+    uint32_t max_size = 0;
+    const auto& offsets = _dict->values().get_offset();
+    for (size_t i = 0; i + 1 < offsets.size(); i++) {
+        max_size = std::max(max_size, offsets[i + 1] - offsets[i]);
+    }
+    return max_size + sizeof(uint32_t);
+}
+
+uint32_t LowCardinalityColumn::serialize(size_t idx, uint8_t* pos) {
+    Slice value = get_slice(idx);
+    uint32_t binary_size = value.size;
+    strings::memcpy_inlined(pos, &binary_size, sizeof(uint32_t));
+    strings::memcpy_inlined(pos + sizeof(uint32_t), value.data, binary_size);
+    return sizeof(uint32_t) + binary_size;
+}
+
+uint32_t LowCardinalityColumn::serialize_default(uint8_t* pos) {
+    uint32_t binary_size = 0;
+    strings::memcpy_inlined(pos, &binary_size, sizeof(uint32_t));
+    return sizeof(uint32_t);
+}
+
+void LowCardinalityColumn::serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                                           uint32_t max_one_row_size) {
+    for (size_t i = 0; i < chunk_size; ++i) {
+        slice_sizes[i] += serialize(i, dst + i * max_one_row_size + slice_sizes[i]);
+    }
+}
+
+const uint8_t* LowCardinalityColumn::deserialize_and_append(const uint8_t* pos) {
+    uint32_t string_size{};
+    strings::memcpy_inlined(&string_size, pos, sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+    Slice value(pos, string_size);
+    bool ok = append(value);
+    DCHECK(ok) << "'" << value.to_string() << "' is not in the dictionary";
+    return pos + string_size;
+}
+
+void LowCardinalityColumn::deserialize_and_append_batch(std::vector<Slice>& srcs, size_t chunk_size) {
+    _codes.reserve(_codes.size() + chunk_size);
+    for (size_t i = 0; i < chunk_size; ++i) {
+        srcs[i].data = (char*)deserialize_and_append((uint8_t*)srcs[i].data);
+    }
+}
+
+void LowCardinalityColumn::fnv_hash(uint32_t* hashes, uint32_t from, uint32_t to) const {
+    for (uint32_t i = from; i < to; ++i) {
+        Slice value = get_slice(i);
+        hashes[i] = HashUtil::fnv_hash(value.data, value.size, hashes[i]);
+    }
+}
+
+void LowCardinalityColumn::crc32_hash(uint32_t* hashes, uint32_t from, uint32_t to) const {
+    for (uint32_t i = from; i < to; ++i) {
+        Slice value = get_slice(i);
+        hashes[i] = HashUtil::zlib_crc_hash(value.data, value.size, hashes[i]);
+    }
+}
+
+void LowCardinalityColumn::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const {
+    Slice value = get_slice(idx);
+    buf->push_string(value.data, value.size);
+}
+
+std::string LowCardinalityColumn::debug_item(uint32_t idx) const {
+    std::string s;
+    auto slice = get_slice(idx);
+    s.reserve(slice.size + 2);
+    s.push_back('\'');
+    s.append(slice.data, slice.size);
+    s.push_back('\'');
+    return s;
+}
+
+} // namespace starrocks::vectorized
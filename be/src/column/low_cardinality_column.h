@@ -0,0 +1,242 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/column.h"
+#include "column/column_hash.h"
+#include "util/phmap/phmap.h"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+// LowCardDictionary is the immutable dictionary of a LowCardinalityColumn, shared by all the columns
+// encoded by it, e.g. the columns of the chunks of a scan, their filtered and gathered copies and the
+// join and group by keys built from them.
+class LowCardDictionary {
+public:
+    using Code = int32_t;
+
+    // |values| must be distinct.
+    static std::shared_ptr<const LowCardDictionary> create(const std::vector<Slice>& values);
+
+    size_t size() const { return _values->size(); }
+
+    Slice get(Code code) const { return _values->get_slice(code); }
+
+    // Returns -1 if |value| isn't in the dictionary.
+    Code find(const Slice& value) const {
+        auto iter = _codes.find(value);
+        return iter == _codes.end() ? -1 : iter->second;
+    }
+
+    // Whether the codes are in the order of the values, so the codes are compared instead of the values.
+    bool sorted() const { return _sorted; }
+
+    const BinaryColumn& values() const { return *_values; }
+
+private:
+    BinaryColumn::Ptr _values;
+    phmap::flat_hash_map<Slice, Code, SliceHash, SliceNormalEqual> _codes;
+    bool _sorted = false;
+};
+
+using LowCardDictionaryPtr = std::shared_ptr<const LowCardDictionary>;
+
+// LowCardinalityColumn is a string column of the codes of its values in a dictionary. The rows are
+// filtered, gathered, compared and hashed as the fixed-width codes, with the dictionary shared with the
+// columns they are copied to, and decoded into a BinaryColumn by decode() only when the strings themselves
+// are needed, e.g. by the result sink.
+//
+// The serialization and the hashes are the same as BinaryColumn's, on the decoded strings, so a row
+// serialized into the keys of a hash table or shuffled by its hash is the same as the decoded one.
+//
+// All the columns appended to each other must share the dictionary.
+class LowCardinalityColumn final : public ColumnFactory<Column, LowCardinalityColumn> {
+    friend class ColumnFactory<Column, LowCardinalityColumn>;
+
+public:
+    using Code = LowCardDictionary::Code;
+    using ValueType = Slice;
+    using Container = Buffer<Code>;
+
+    explicit LowCardinalityColumn(LowCardDictionaryPtr dict) : _dict(std::move(dict)) {}
+
+    LowCardinalityColumn(const LowCardinalityColumn& rhs) = default;
+
+    LowCardinalityColumn(LowCardinalityColumn&& rhs) noexcept = default;
+
+    ~LowCardinalityColumn() override = default;
+
+    // Encodes the rows of |src|, returns nullptr if any row isn't in |dict|.
+    static Ptr encode(const LowCardDictionaryPtr& dict, const BinaryColumn& src);
+
+    // Appends the decoded rows to |dst|.
+    void decode(BinaryColumn* dst) const;
+    BinaryColumn::Ptr decode() const;
+
+    const LowCardDictionaryPtr& dictionary() const { return _dict; }
+
+    bool low_cardinality() const override { return true; }
+
+    const uint8_t* raw_data() const override { return reinterpret_cast<const uint8_t*>(_codes.data()); }
+
+    uint8_t* mutable_raw_data() override { return reinterpret_cast<uint8_t*>(_codes.data()); }
+
+    size_t size() const override { return _codes.size(); }
+
+    size_t capacity() const override { return _codes.capacity(); }
+
+    size_t type_size() const override { return sizeof(Code); }
+
+    size_t byte_size() const override { return _codes.size() * sizeof(Code); }
+
+    size_t byte_size(size_t from, size_t size) const override {
+        DCHECK_LE(from + size, this->size()) << "Range error";
+        return size * sizeof(Code);
+    }
+
+    size_t byte_size(size_t idx) const override { return get_slice(idx).size + sizeof(uint32_t); }
+
+    Slice get_slice(size_t idx) const { return _dict->get(_codes[idx]); }
+
+    Code get_code(size_t idx) const { return _codes[idx]; }
+
+    void reserve(size_t n) override { _codes.reserve(n); }
+
+    // the new rows are the first value of the dictionary
+    void resize(size_t n) override { _codes.resize(n, 0); }
+
+    void assign(size_t n, size_t idx) override {
+        Code code = _codes[idx];
+        _codes.assign(n, code);
+    }
+
+    void remove_first_n_values(size_t count) override {
+        DCHECK_LE(count, _codes.size());
+        _codes.erase(_codes.begin(), _codes.begin() + count);
+    }
+
+    // Returns false if |str| isn't in the dictionary.
+    [[nodiscard]] bool append(const Slice& str) {
+        Code code = _dict->find(str);
+        if (code < 0) {
+            return false;
+        }
+        _codes.emplace_back(code);
+        return true;
+    }
+
+    void append_code(Code code) {
+        DCHECK_LT(code, _dict->size());
+        _codes.emplace_back(code);
+    }
+
+    void append_datum(const Datum& datum) override {
+        bool ok = append(datum.get_slice());
+        DCHECK(ok) << "'" << datum.get_slice().to_string() << "' is not in the dictionary";
+    }
+
+    void append(const Column& src, size_t offset, size_t count) override;
+
+    void append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) override;
+
+    void append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) override;
+
+    bool append_nulls(size_t count) override { return false; }
+
+    // Returns false if any of |strs| isn't in the dictionary, none of them is appended then.
+    bool append_strings(const std::vector<Slice>& strs) override;
+
+    size_t append_numbers(const void* buff, size_t length) override { return -1; }
+
+    void append_value_multiple_times(const void* value, size_t count) override;
+
+    // the default value is the first value of the dictionary, there is no default value in an empty one
+    void append_default() override { append_default(1); }
+
+    void append_default(size_t count) override {
+        DCHECK_GT(_dict->size(), 0);
+        _codes.resize(_codes.size() + count, 0);
+    }
+
+    Status update_rows(const Column& src, const uint32_t* indexes) override;
+
+    uint32_t max_one_element_serialize_size() const override;
+
+    uint32_t serialize(size_t idx, uint8_t* pos) override;
+
+    uint32_t serialize_default(uint8_t* pos) override;
+
+    void serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                         uint32_t max_one_row_size) override;
+
+    const uint8_t* deserialize_and_append(const uint8_t* pos) override;
+
+    void deserialize_and_append_batch(std::vector<Slice>& srcs, size_t chunk_size) override;
+
+    uint32_t serialize_size(size_t idx) const override { return sizeof(uint32_t) + get_slice(idx).size; }
+
+    MutableColumnPtr clone_empty() const override { return create_mutable(_dict); }
+
+    size_t filter_range(const Column::Filter& filter, size_t from, size_t to) override;
+
+    int compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const override;
+
+    void fnv_hash(uint32_t* hashes, uint32_t from, uint32_t to) const override;
+
+    void crc32_hash(uint32_t* hashes, uint32_t from, uint32_t to) const override;
+
+    void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override;
+
+    std::string get_name() const override { return "low-cardinality"; }
+
+    Container& get_data() { return _codes; }
+    const Container& get_data() const { return _codes; }
+
+    Datum get(size_t n) const override { return Datum(get_slice(n)); }
+
+    size_t container_memory_usage() const override { return _codes.capacity() * sizeof(Code); }
+
+    size_t shrink_memory_usage() const override { return _codes.size() * sizeof(Code); }
+
+    void swap_column(Column& rhs) override {
+        auto& r = down_cast<LowCardinalityColumn&>(rhs);
+        using std::swap;
+        swap(_delete_state, r._delete_state);
+        swap(_dict, r._dict);
+        swap(_codes, r._codes);
+    }
+
+    void reset_column() override {
+        Column::reset_column();
+        _codes.clear();
+    }
+
+    std::string debug_item(uint32_t idx) const override;
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "[";
+        for (size_t i = 0; i < size(); ++i) {
+            if (i > 0) {
+                ss << ", ";
+            }
+            ss << debug_item(i);
+        }
+        ss << "]";
+        return ss.str();
+    }
+
+    bool reach_capacity_limit() const override { return _codes.size() >= Column::MAX_CAPACITY_LIMIT; }
+
+private:
+    LowCardDictionaryPtr _dict;
+    Container _codes;
+};
+
+} // namespace starrocks::vectorized
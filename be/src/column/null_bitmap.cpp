@@ -0,0 +1,282 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/null_bitmap.h"
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+
+#include "simd/simd_dispatch.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+constexpr size_t kWordBits = 64;
+
+uint64_t low_bits(size_t n) {
+    return n >= kWordBits ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+}
+
+// Packs the |n| bytes from |p| into the low n bits, n <= 64.
+uint64_t pack_bytes_scalar(const uint8_t* p, size_t n) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < n; i++) {
+        bits |= uint64_t(p[i] != 0) << i;
+    }
+    return bits;
+}
+
+#ifdef SIMD_AVX512_DISPATCH
+SIMD_AVX512BW_TARGET uint64_t pack_bytes_avx512(const uint8_t* p) {
+    __m512i v = _mm512_loadu_si512(p);
+    return _mm512_test_epi8_mask(v, v);
+}
+
+SIMD_AVX512BW_TARGET void unpack_bits_avx512(uint64_t bits, uint8_t* out) {
+    _mm512_storeu_si512(out, _mm512_maskz_mov_epi8(bits, _mm512_set1_epi8(1)));
+}
+
+// Clears the bytes of |filter| whose bits are 1.
+SIMD_AVX512BW_TARGET void mask_bytes_avx512(uint64_t bits, uint8_t* filter) {
+    __m512i f = _mm512_loadu_si512(filter);
+    _mm512_storeu_si512(filter, _mm512_maskz_mov_epi8(~bits, f));
+}
+
+SIMD_BMI2_TARGET uint64_t extract_bits_bmi2(uint64_t bits, uint64_t mask) {
+    return _pext_u64(bits, mask);
+}
+#endif
+
+// Packs the 64 bytes from |p|, the bit of a nonzero byte is 1.
+uint64_t pack_bytes(const uint8_t* p) {
+#ifdef SIMD_AVX512_DISPATCH
+    if (SIMD::cpu_has_avx512bw()) {
+        return pack_bytes_avx512(p);
+    }
+#endif
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    auto lo = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), zero)));
+    auto hi = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), zero)));
+    return ~((uint64_t(hi) << 32) | lo);
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    uint64_t zeros = 0;
+    for (size_t i = 0; i < 4; i++) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+        zeros |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)))) << (i * 16);
+    }
+    return ~zeros;
+#else
+    return pack_bytes_scalar(p, kWordBits);
+#endif
+}
+
+// Unpacks the 64 bits of |bits| into 64 bytes of 0 or 1.
+void unpack_bits(uint64_t bits, uint8_t* out) {
+#ifdef SIMD_AVX512_DISPATCH
+    if (SIMD::cpu_has_avx512bw()) {
+        unpack_bits_avx512(bits, out);
+        return;
+    }
+#endif
+#if defined(__AVX2__)
+    // Every byte picks the byte of the mask holding its bit, then tests the bit.
+    const __m256i shuffle = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2,
+                                             3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i select = _mm256_set1_epi64x(0x8040201008040201);
+    const __m256i one = _mm256_set1_epi8(1);
+    for (size_t i = 0; i < 2; i++) {
+        __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits >> (i * 32))), shuffle);
+        v = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(v, select), select), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 32), v);
+    }
+#else
+    for (size_t i = 0; i < kWordBits; i++) {
+        out[i] = (bits >> i) & 1;
+    }
+#endif
+}
+
+// Returns the bits of |bits| at the 1 bits of |mask|, packed into the low bits.
+uint64_t extract_bits(uint64_t bits, uint64_t mask) {
+#ifdef SIMD_AVX512_DISPATCH
+    if (SIMD::cpu_has_bmi2()) {
+        return extract_bits_bmi2(bits, mask);
+    }
+#endif
+    uint64_t result = 0;
+    for (size_t i = 0; mask != 0; i++) {
+        result |= ((bits >> __builtin_ctzll(mask)) & 1) << i;
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+// Stores the low |n| bits of |bits| at the bit |pos| of |words|, the bits after them in the same word are
+// cleared, n <= 64.
+void store_bits(uint64_t* words, size_t pos, uint64_t bits, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    bits &= low_bits(n);
+    size_t idx = pos / kWordBits;
+    size_t offset = pos % kWordBits;
+    if (offset == 0) {
+        words[idx] = bits;
+        return;
+    }
+    words[idx] = (words[idx] & low_bits(offset)) | (bits << offset);
+    if (offset + n > kWordBits) {
+        words[idx + 1] = bits >> (kWordBits - offset);
+    }
+}
+
+} // namespace
+
+bool NullBitmap::has_null() const {
+    return std::any_of(_words.begin(), _words.end(), [](uint64_t word) { return word != 0; });
+}
+
+size_t NullBitmap::null_count() const {
+    size_t count = 0;
+    for (uint64_t word : _words) {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+void NullBitmap::append(const uint8_t* nulls, size_t size) {
+    size_t i = 0;
+    if (_size % kWordBits != 0) {
+        i = std::min(size, kWordBits - _size % kWordBits);
+        _append_bits(pack_bytes_scalar(nulls, i), i);
+    }
+    _words.reserve((_size + size - i + kWordBits - 1) / kWordBits);
+    for (; i + kWordBits <= size; i += kWordBits) {
+        _words.push_back(pack_bytes(nulls + i));
+        _size += kWordBits;
+    }
+    if (i < size) {
+        _append_bits(pack_bytes_scalar(nulls + i, size - i), size - i);
+    }
+}
+
+void NullBitmap::append(bool is_null, size_t size) {
+    if (!is_null) {
+        resize(_size + size);
+        return;
+    }
+    for (size_t i = 0; i < size; i += kWordBits) {
+        _append_bits(~uint64_t(0), std::min(kWordBits, size - i));
+    }
+}
+
+void NullBitmap::append_selective(const NullBitmap& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
+    for (size_t i = 0; i < size; i += kWordBits) {
+        size_t n = std::min<size_t>(kWordBits, size - i);
+        uint64_t bits = 0;
+        for (size_t j = 0; j < n; j++) {
+            bits |= uint64_t(src.is_null(indexes[from + i + j])) << j;
+        }
+        _append_bits(bits, n);
+    }
+}
+
+void NullBitmap::to_bytes(size_t from, size_t size, uint8_t* nulls) const {
+    DCHECK_LE(from + size, _size);
+    size_t i = 0;
+    for (; i + kWordBits <= size; i += kWordBits) {
+        unpack_bits(_bits_at(from + i), nulls + i);
+    }
+    if (i < size) {
+        uint64_t bits = _bits_at(from + i);
+        for (size_t j = 0; i + j < size; j++) {
+            nulls[i + j] = (bits >> j) & 1;
+        }
+    }
+}
+
+void NullBitmap::mask_filter(uint8_t* filter) const {
+    uint8_t unpacked[kWordBits];
+    for (size_t k = 0; k < _words.size(); k++) {
+        uint64_t bits = _words[k];
+        if (bits == 0) {
+            continue;
+        }
+        uint8_t* f = filter + k * kWordBits;
+        size_t n = std::min(kWordBits, _size - k * kWordBits);
+        if (n < kWordBits) {
+            for (size_t j = 0; j < n; j++) {
+                f[j] &= uint8_t(((bits >> j) & 1) - 1);
+            }
+            continue;
+        }
+#ifdef SIMD_AVX512_DISPATCH
+        if (SIMD::cpu_has_avx512bw()) {
+            mask_bytes_avx512(bits, f);
+            continue;
+        }
+#endif
+        // 0 - 1 keeps the byte of a row not null, 1 - 1 clears the byte of a null row
+        unpack_bits(bits, unpacked);
+        for (size_t j = 0; j < kWordBits; j++) {
+            f[j] &= uint8_t(unpacked[j] - 1);
+        }
+    }
+}
+
+size_t NullBitmap::filter(const Column::Filter& filter) {
+    DCHECK_EQ(filter.size(), _size);
+    // The bits are compacted in place: the kept bits of a word never go after the word itself.
+    size_t result = 0;
+    for (size_t k = 0; k < _words.size(); k++) {
+        size_t n = std::min(kWordBits, _size - k * kWordBits);
+        const uint8_t* f = filter.data() + k * kWordBits;
+        uint64_t mask = n == kWordBits ? pack_bytes(f) : pack_bytes_scalar(f, n);
+        if (mask == 0) {
+            continue;
+        }
+        uint64_t bits = mask == ~uint64_t(0) ? _words[k] : extract_bits(_words[k], mask);
+        size_t count = __builtin_popcountll(mask);
+        store_bits(_words.data(), result, bits, count);
+        result += count;
+    }
+    _words.resize((result + kWordBits - 1) / kWordBits);
+    _size = result;
+    return result;
+}
+
+void NullBitmap::resize(size_t size) {
+    _words.resize((size + kWordBits - 1) / kWordBits, 0);
+    if (size < _size && size % kWordBits != 0) {
+        _words.back() &= low_bits(size % kWordBits);
+    }
+    _size = size;
+}
+
+void NullBitmap::_append_bits(uint64_t bits, size_t n) {
+    _words.resize((_size + n + kWordBits - 1) / kWordBits, 0);
+    store_bits(_words.data(), _size, bits, n);
+    _size += n;
+}
+
+uint64_t NullBitmap::_bits_at(size_t pos) const {
+    size_t idx = pos / kWordBits;
+    size_t offset = pos % kWordBits;
+    if (offset == 0) {
+        return _words[idx];
+    }
+    uint64_t bits = _words[idx] >> offset;
+    if (idx + 1 < _words.size()) {
+        bits |= _words[idx + 1] << (kWordBits - offset);
+    }
+    return bits;
+}
+
+} // namespace starrocks::vectorized
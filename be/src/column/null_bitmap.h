@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "column/column.h"
+#include "common/logging.h"
+
+namespace starrocks::vectorized {
+
+// NullBitmap is the bit-packed form of the null column of a NullableColumn: one bit per row instead of one
+// byte, the bit of a null row is 1. It takes 1/8 of the memory, so it's meant for the nulls of the columns
+// kept for long, e.g. the cached chunks, and for the null checks scanning a lot of rows.
+//
+// The conversions from and to the byte null maps, the filter and the combination with a selection work on
+// 64 rows at once, with the AVX-512 and BMI2 kernels if the CPU supports them.
+class NullBitmap {
+public:
+    NullBitmap() = default;
+
+    // Packs the byte null map |nulls| of |size| rows, a row is null if its byte is nonzero.
+    NullBitmap(const uint8_t* nulls, size_t size) { append(nulls, size); }
+
+    size_t size() const { return _size; }
+
+    bool empty() const { return _size == 0; }
+
+    bool is_null(size_t idx) const {
+        DCHECK_LT(idx, _size);
+        return (_words[idx / 64] >> (idx % 64)) & 1;
+    }
+
+    // The bits after size() are always zero, so it doesn't need to care about the last word.
+    bool has_null() const;
+
+    size_t null_count() const;
+
+    // Appends the byte null map |nulls| of |size| rows.
+    void append(const uint8_t* nulls, size_t size);
+
+    // Appends |size| rows of the same null bit.
+    void append(bool is_null, size_t size);
+
+    // Appends the rows at |indexes[from, from + size)| of |src|, like Column::append_selective().
+    void append_selective(const NullBitmap& src, const uint32_t* indexes, uint32_t from, uint32_t size);
+
+    // Unpacks the rows in [from, from + size) into the byte null map |nulls|, with 1 for the null rows.
+    void to_bytes(size_t from, size_t size, uint8_t* nulls) const;
+
+    // Drops the nulls from |filter| of size() rows, i.e. filter[i] becomes 0 if the row i is null, which
+    // is the selection of the rows both selected and not null.
+    void mask_filter(uint8_t* filter) const;
+
+    // Keeps the rows whose |filter| is nonzero and returns the number of them, like Column::filter().
+    size_t filter(const Column::Filter& filter);
+
+    void resize(size_t size);
+
+    void reset() {
+        _words.clear();
+        _size = 0;
+    }
+
+    void swap(NullBitmap& other) {
+        _words.swap(other._words);
+        std::swap(_size, other._size);
+    }
+
+    const std::vector<uint64_t>& words() const { return _words; }
+
+    size_t memory_usage() const { return _words.capacity() * sizeof(uint64_t); }
+
+private:
+    // Appends the low |n| bits of |bits|, n <= 64.
+    void _append_bits(uint64_t bits, size_t n);
+
+    // The 64 bits from the row |pos|, the rows after size() are zero.
+    uint64_t _bits_at(size_t pos) const;
+
+    std::vector<uint64_t> _words;
+    size_t _size = 0;
+};
+
+} // namespace starrocks::vectorized
@@ -32,6 +32,14 @@ NullableColumn::NullableColumn(ColumnPtr data_column, NullColumnPtr null_column)
             << "nullable column's data must be single column";
 }
 
+void NullableColumn::set_null_bitmap(const NullBitmap& nulls) {
+    DCHECK_EQ(nulls.size(), _data_column->size());
+    NullData& data = _null_column->get_data();
+    data.resize(nulls.size());
+    nulls.to_bytes(0, nulls.size(), data.data());
+    _has_null = nulls.has_null();
+}
+
 size_t NullableColumn::null_count() const {
     if (!_has_null) {
         return 0;
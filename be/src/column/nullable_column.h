@@ -3,6 +3,7 @@
 #pragma once
 
 #include "column/fixed_length_column.h"
+#include "column/null_bitmap.h"
 #include "common/logging.h"
 
 namespace starrocks::vectorized {
@@ -57,6 +58,12 @@ public:
         _has_null = (p != nullptr) && (nullptr != memchr(p, 1, v.size() * sizeof(v[0])));
     }
 
+    // Packs the null column into a bitmap, e.g. to keep the column for long with 1/8 of the memory of the nulls.
+    NullBitmap null_bitmap() const { return NullBitmap(_null_column->get_data().data(), _null_column->size()); }
+
+    // Replaces the null column by the rows unpacked from |nulls|, which must have the rows of the data column.
+    void set_null_bitmap(const NullBitmap& nulls);
+
     bool is_nullable() const override { return true; }
 
     bool is_null(size_t index) const override {
@@ -0,0 +1,221 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/rle_column.h"
+
+#include <limits>
+
+#include "simd/simd.h"
+
+namespace starrocks::vectorized {
+
+// no run of |src| is the last one appended
+static constexpr size_t kNoRun = std::numeric_limits<size_t>::max();
+
+RleColumn::RleColumn(ColumnPtr data) : _data(std::move(data)) {
+    DCHECK(!_data->is_constant());
+    DCHECK(_data->empty());
+}
+
+RleColumn::RleColumn(ColumnPtr data, RunEnds run_ends) : _data(std::move(data)), _run_ends(std::move(run_ends)) {
+    DCHECK(!_data->is_constant());
+    DCHECK_EQ(_data->size(), _run_ends.size());
+}
+
+RleColumn::Ptr RleColumn::encode(const Column& src) {
+    DCHECK(!src.is_constant());
+    auto column = create(src.clone_empty());
+    size_t num_rows = src.size();
+    size_t begin = 0;
+    for (size_t i = 1; i <= num_rows; i++) {
+        if (i == num_rows || src.compare_at(i, begin, src, 1) != 0) {
+            column->_data->append(src, begin, 1);
+            column->_append_run(i - begin);
+            begin = i;
+        }
+    }
+    return column;
+}
+
+ColumnPtr RleColumn::decode() const {
+    auto column = _data->clone_empty();
+    for (size_t i = 0; i < num_runs(); i++) {
+        column->append_value_multiple_times(*_data, i, run_length(i));
+    }
+    return column;
+}
+
+void RleColumn::_append_rows_of_run(const RleColumn& src, size_t run, size_t length, size_t* last_src_run) {
+    if (length == 0) {
+        return;
+    }
+    if (*last_src_run == run) {
+        _run_ends.back() += length;
+        return;
+    }
+    _data->append(*src._data, run, 1);
+    _append_run(length);
+    *last_src_run = run;
+}
+
+void RleColumn::resize(size_t n) {
+    size_t num_rows = size();
+    if (n > num_rows) {
+        append_default(n - num_rows);
+    } else if (n < num_rows) {
+        size_t runs = n == 0 ? 0 : run_of(n - 1) + 1;
+        _data->resize(runs);
+        _run_ends.resize(runs);
+        if (runs > 0) {
+            _run_ends.back() = n;
+        }
+    }
+}
+
+void RleColumn::assign(size_t n, size_t idx) {
+    size_t run = run_of(idx);
+    _data->assign(1, run);
+    _run_ends.assign(1, n);
+    if (n == 0) {
+        _data->resize(0);
+        _run_ends.clear();
+    }
+}
+
+void RleColumn::remove_first_n_values(size_t count) {
+    if (count == 0) {
+        return;
+    }
+    size_t num_rows = size();
+    DCHECK_LE(count, num_rows);
+    if (count == num_rows) {
+        _data->resize(0);
+        _run_ends.clear();
+        return;
+    }
+    size_t first_run = run_of(count);
+    _data->remove_first_n_values(first_run);
+    _run_ends.erase(_run_ends.begin(), _run_ends.begin() + first_run);
+    for (auto& end : _run_ends) {
+        end -= count;
+    }
+}
+
+void RleColumn::append(const Column& src, size_t offset, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    const auto& src_column = down_cast<const RleColumn&>(src);
+    size_t last_src_run = kNoRun;
+    size_t end = offset + count;
+    for (size_t run = src_column.run_of(offset); offset < end; run++) {
+        size_t run_end = std::min<size_t>(src_column._run_ends[run], end);
+        _append_rows_of_run(src_column, run, run_end - offset, &last_src_run);
+        offset = run_end;
+    }
+}
+
+void RleColumn::append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
+    const auto& src_column = down_cast<const RleColumn&>(src);
+    size_t last_src_run = kNoRun;
+    for (uint32_t i = from; i < from + size; i++) {
+        size_t run = last_src_run;
+        // the rows of a run are usually selected together
+        if (run == kNoRun || indexes[i] < src_column.run_begin(run) || indexes[i] >= src_column._run_ends[run]) {
+            run = src_column.run_of(indexes[i]);
+        }
+        _append_rows_of_run(src_column, run, 1, &last_src_run);
+    }
+}
+
+void RleColumn::append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) {
+    const auto& src_column = down_cast<const RleColumn&>(src);
+    size_t last_src_run = kNoRun;
+    _append_rows_of_run(src_column, src_column.run_of(index), size, &last_src_run);
+}
+
+Status RleColumn::update_rows(const Column& src, const uint32_t* indexes) {
+    return Status::NotSupported("RleColumn does not support update");
+}
+
+void RleColumn::serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                                uint32_t max_one_row_size) {
+    size_t row = 0;
+    for (size_t run = 0; run < num_runs() && row < chunk_size; run++) {
+        size_t run_end = std::min<size_t>(_run_ends[run], chunk_size);
+        for (; row < run_end; row++) {
+            slice_sizes[row] += _data->serialize(run, dst + row * max_one_row_size + slice_sizes[row]);
+        }
+    }
+}
+
+size_t RleColumn::filter_range(const Column::Filter& filter, size_t from, size_t to) {
+    DCHECK_LE(to, size());
+    size_t result_rows = from;
+    size_t result_runs = from == 0 ? 0 : run_of(from - 1) + 1;
+    // the runs kept in the data column
+    Buffer<uint32_t> kept_runs(result_runs);
+    for (size_t run = 0; run < result_runs; run++) {
+        kept_runs[run] = run;
+    }
+    RunEnds run_ends(_run_ends.begin(), _run_ends.begin() + result_runs);
+    if (result_runs > 0) {
+        run_ends.back() = from;
+    }
+    for (size_t run = from == to ? num_runs() : run_of(from); run < num_runs(); run++) {
+        size_t begin = std::max<size_t>(run_begin(run), from);
+        size_t end = std::min<size_t>(_run_ends[run], to);
+        if (begin >= end) {
+            break;
+        }
+        size_t count = SIMD::count_nonzero(&filter[begin], end - begin);
+        if (count == 0) {
+            continue;
+        }
+        result_rows += count;
+        if (!kept_runs.empty() && kept_runs.back() == run) {
+            // the part of the run before |from|
+            run_ends.back() = result_rows;
+        } else {
+            kept_runs.emplace_back(run);
+            run_ends.emplace_back(result_rows);
+        }
+    }
+    if (kept_runs.size() != num_runs()) {
+        auto data = _data->clone_empty();
+        data->append_selective(*_data, kept_runs);
+        _data = std::move(data);
+    }
+    _run_ends = std::move(run_ends);
+    return result_rows;
+}
+
+int RleColumn::compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const {
+    const auto& rhs_column = down_cast<const RleColumn&>(rhs);
+    return _data->compare_at(run_of(left), rhs_column.run_of(right), *rhs_column._data, nan_direction_hint);
+}
+
+void RleColumn::fnv_hash(uint32_t* hash, uint32_t from, uint32_t to) const {
+    if (from >= to) {
+        return;
+    }
+    for (size_t run = run_of(from); run < num_runs() && run_begin(run) < to; run++) {
+        uint32_t end = std::min<uint32_t>(_run_ends[run], to);
+        for (uint32_t i = std::max<uint32_t>(run_begin(run), from); i < end; ++i) {
+            _data->fnv_hash(&hash[i] - run, run, run + 1);
+        }
+    }
+}
+
+void RleColumn::crc32_hash(uint32_t* hash, uint32_t from, uint32_t to) const {
+    if (from >= to) {
+        return;
+    }
+    for (size_t run = run_of(from); run < num_runs() && run_begin(run) < to; run++) {
+        uint32_t end = std::min<uint32_t>(_run_ends[run], to);
+        for (uint32_t i = std::max<uint32_t>(run_begin(run), from); i < end; ++i) {
+            _data->crc32_hash(&hash[i] - run, run, run + 1);
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,248 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <sstream>
+
+#include "column/column.h"
+#include "common/logging.h"
+
+namespace starrocks::vectorized {
+
+// RleColumn is a run-length encoded column: the value of each run is a row of the data column and the runs
+// end at the row positions of |_run_ends|, e.g. [1, 1, 1, 2, 2, 3] is kept as the data column [1, 2, 3] and
+// the run ends [3, 5, 6]. It's meant for the columns made of long runs, e.g. the sort keys and the columns
+// read from the RLE pages, so that filter, hash and the aggregations work on the runs instead of the rows.
+//
+// Like ConstColumn, the nulls are in the data column, RleColumn itself is never a NullableColumn.
+class RleColumn final : public ColumnFactory<Column, RleColumn> {
+    friend class ColumnFactory<Column, RleColumn>;
+
+public:
+    using RunEnds = Buffer<uint32_t>;
+
+    explicit RleColumn(ColumnPtr data_column);
+    RleColumn(ColumnPtr data_column, RunEnds run_ends);
+
+    RleColumn(const RleColumn& rhs) : _data(rhs._data->clone_shared()), _run_ends(rhs._run_ends) {}
+
+    RleColumn(RleColumn&& rhs) noexcept : _data(std::move(rhs._data)), _run_ends(std::move(rhs._run_ends)) {}
+
+    RleColumn& operator=(const RleColumn& rhs) {
+        RleColumn tmp(rhs);
+        this->swap_column(tmp);
+        return *this;
+    }
+
+    RleColumn& operator=(RleColumn&& rhs) noexcept {
+        RleColumn tmp(std::move(rhs));
+        this->swap_column(tmp);
+        return *this;
+    }
+
+    ~RleColumn() override = default;
+
+    // Encodes the runs of the equal rows of |src|, which must not be a ConstColumn or a RleColumn.
+    static Ptr encode(const Column& src);
+
+    // Returns the rows decoded into a column of the type of the data column.
+    ColumnPtr decode() const;
+
+    size_t num_runs() const { return _run_ends.size(); }
+
+    // The index of the run of the row |idx|, which is also the row of its value in the data column.
+    size_t run_of(size_t idx) const {
+        DCHECK_LT(idx, size());
+        return std::upper_bound(_run_ends.begin(), _run_ends.end(), idx) - _run_ends.begin();
+    }
+
+    uint32_t run_begin(size_t run) const { return run == 0 ? 0 : _run_ends[run - 1]; }
+
+    uint32_t run_length(size_t run) const { return _run_ends[run] - run_begin(run); }
+
+    const RunEnds& run_ends() const { return _run_ends; }
+
+    bool is_rle() const override { return true; }
+
+    bool is_null(size_t index) const override { return _data->is_null(run_of(index)); }
+
+    bool has_null() const override { return _data->has_null(); }
+
+    const uint8_t* raw_data() const override { return _data->raw_data(); }
+
+    uint8_t* mutable_raw_data() override { return _data->mutable_raw_data(); }
+
+    size_t size() const override { return _run_ends.empty() ? 0 : _run_ends.back(); }
+
+    size_t capacity() const override { return UINT32_MAX; }
+
+    size_t type_size() const override { return _data->type_size(); }
+
+    size_t byte_size() const override { return _data->byte_size() + _run_ends.size() * sizeof(uint32_t); }
+
+    size_t byte_size(size_t idx) const override { return _data->byte_size(run_of(idx)); }
+
+    void reserve(size_t n) override {}
+
+    void resize(size_t n) override;
+
+    void assign(size_t n, size_t idx) override;
+
+    void remove_first_n_values(size_t count) override;
+
+    void append_datum(const Datum& datum) override {
+        _data->append_datum(datum);
+        _append_run(1);
+    }
+
+    void append(const Column& src, size_t offset, size_t count) override;
+
+    void append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) override;
+
+    void append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) override;
+
+    bool append_nulls(size_t count) override {
+        if (count == 0) {
+            return true;
+        }
+        if (!_data->append_nulls(1)) {
+            return false;
+        }
+        _append_run(count);
+        return true;
+    }
+
+    bool append_strings(const std::vector<Slice>& strs) override { return false; }
+
+    size_t append_numbers(const void* buff, size_t length) override { return -1; }
+
+    void append_value_multiple_times(const void* value, size_t count) override {
+        if (count > 0) {
+            _data->append_value_multiple_times(value, 1);
+            _append_run(count);
+        }
+    }
+
+    void append_default() override { append_default(1); }
+
+    void append_default(size_t count) override {
+        if (count > 0) {
+            _data->append_default();
+            _append_run(count);
+        }
+    }
+
+    Status update_rows(const Column& src, const uint32_t* indexes) override;
+
+    uint32_t serialize(size_t idx, uint8_t* pos) override { return _data->serialize(run_of(idx), pos); }
+
+    uint32_t serialize_default(uint8_t* pos) override { return _data->serialize_default(pos); }
+
+    void serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                         uint32_t max_one_row_size) override;
+
+    const uint8_t* deserialize_and_append(const uint8_t* pos) override {
+        pos = _data->deserialize_and_append(pos);
+        _append_run(1);
+        return pos;
+    }
+
+    void deserialize_and_append_batch(std::vector<Slice>& srcs, size_t chunk_size) override {
+        for (size_t i = 0; i < chunk_size; ++i) {
+            srcs[i].data = (char*)deserialize_and_append((uint8_t*)srcs[i].data);
+        }
+    }
+
+    uint32_t max_one_element_serialize_size() const override { return _data->max_one_element_serialize_size(); }
+
+    uint32_t serialize_size(size_t idx) const override { return _data->serialize_size(run_of(idx)); }
+
+    MutableColumnPtr clone_empty() const override { return create_mutable(_data->clone_empty()); }
+
+    size_t filter_range(const Column::Filter& filter, size_t from, size_t to) override;
+
+    int compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const override;
+
+    void fnv_hash(uint32_t* hash, uint32_t from, uint32_t to) const override;
+
+    void crc32_hash(uint32_t* hash, uint32_t from, uint32_t to) const override;
+
+    void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override {
+        _data->put_mysql_row_buffer(buf, run_of(idx));
+    }
+
+    std::string get_name() const override { return "rle-" + _data->get_name(); }
+
+    ColumnPtr* mutable_data_column() { return &_data; }
+
+    const ColumnPtr& data_column() const { return _data; }
+
+    Datum get(size_t n) const override { return _data->get(run_of(n)); }
+
+    size_t memory_usage() const override { return _data->memory_usage() + _run_ends.capacity() * sizeof(uint32_t); }
+
+    size_t shrink_memory_usage() const override {
+        return _data->shrink_memory_usage() + _run_ends.size() * sizeof(uint32_t);
+    }
+
+    size_t container_memory_usage() const override {
+        return _data->container_memory_usage() + _run_ends.capacity() * sizeof(uint32_t);
+    }
+
+    size_t element_memory_usage() const override { return _data->element_memory_usage(); }
+
+    size_t element_memory_usage(size_t from, size_t size) const override {
+        if (size == 0) {
+            return 0;
+        }
+        size_t first = run_of(from);
+        return _data->element_memory_usage(first, run_of(from + size - 1) - first + 1);
+    }
+
+    void swap_column(Column& rhs) override {
+        auto& r = down_cast<RleColumn&>(rhs);
+        std::swap(_delete_state, r._delete_state);
+        std::swap(_data, r._data);
+        std::swap(_run_ends, r._run_ends);
+    }
+
+    void reset_column() override {
+        Column::reset_column();
+        _data->reset_column();
+        _run_ends.clear();
+    }
+
+    std::string debug_item(uint32_t idx) const override { return _data->debug_item(run_of(idx)); }
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "RLE: [";
+        for (size_t i = 0; i < num_runs(); i++) {
+            if (i > 0) {
+                ss << ", ";
+            }
+            ss << _data->debug_item(i) << " x " << run_length(i);
+        }
+        ss << "]";
+        return ss.str();
+    }
+
+    bool reach_capacity_limit() const override { return _data->reach_capacity_limit(); }
+
+private:
+    // Ends a new run of |length| rows, its value must have been appended to the data column.
+    void _append_run(size_t length) {
+        DCHECK_EQ(_data->size(), _run_ends.size() + 1);
+        _run_ends.emplace_back(size() + length);
+    }
+
+    // Appends |length| rows of the value of the run |run| of |src|, merged into the last run if it's the
+    // same run of the same column.
+    void _append_rows_of_run(const RleColumn& src, size_t run, size_t length, size_t* last_src_run);
+
+    ColumnPtr _data;
+    RunEnds _run_ends;
+};
+
+} // namespace starrocks::vectorized
@@ -32,6 +32,9 @@ using Buffer = std::vector<T>;
 
 class ArrayColumn;
 class BinaryColumn;
+class BinaryViewColumn;
+class LowCardinalityColumn;
+class RleColumn;
 class NullableColumn;
 class ConstColumn;
 
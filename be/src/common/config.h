@@ -103,6 +103,10 @@ CONF_Int32(check_consistency_worker_count, "1");
 CONF_Int32(upload_worker_count, "1");
 // the count of thread to download
 CONF_Int32(download_worker_count, "1");
+// the count of tablets an upload or download task transfers at the same time
+CONF_mInt32(snapshot_loader_parallelism, "4");
+// the max bytes per second all the uploads and downloads of a BE transfer, 0 means no limit
+CONF_mInt64(snapshot_loader_max_bytes_per_second, "0");
 // the count of thread to make snapshot
 CONF_Int32(make_snapshot_worker_count, "5");
 // the count of thread to release snapshot
@@ -127,6 +131,9 @@ CONF_mInt32(max_download_speed_kbps, "50000");
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // download low speed time(seconds)
 CONF_mInt32(download_low_speed_time, "300");
+// the number of the files of a clone task downloaded in parallel, each of them is limited by
+// max_download_speed_kbps. 1 downloads them serially.
+CONF_mInt32(clone_download_file_parallelism, "4");
 // curl verbose mode
 // CONF_Int64(curl_verbose_mode, "1");
 // seconds to sleep for each time check table status
@@ -226,10 +233,18 @@ CONF_mInt64(column_dictionary_key_size_threshold, "0");
 //CONF_String(module_output, "");
 // memory_limitation_per_thread_for_schema_change unit GB
 CONF_mInt32(memory_limitation_per_thread_for_schema_change, "2");
+// the number of the rowsets of a tablet converted in parallel by a schema change, each of them may use
+// memory_limitation_per_thread_for_schema_change to sort. 1 converts them serially.
+CONF_mInt32(schema_change_rowset_parallelism, "4");
 
 // CONF_Int64(max_unpacked_row_block_size, "104857600");
 
 CONF_mInt32(update_cache_expire_sec, "360");
+// Max number of the committed versions of a tablet applied before their meta is written in one batch.
+CONF_mInt32(update_apply_batch_max_versions, "8");
+// Max number of consecutive versions of a delete vector saved as the ids added since the previous
+// version, the next version is saved in whole. 0 saves all the versions in whole.
+CONF_mInt32(update_del_vector_max_delta_chain, "8");
 CONF_mInt32(file_descriptor_cache_clean_interval, "3600");
 CONF_mInt32(disk_stat_monitor_interval, "5");
 CONF_mInt32(unused_rowset_monitor_interval, "30");
@@ -253,7 +268,13 @@ CONF_mInt32(trash_file_expire_time_sec, "259200");
 // check row nums for BE/CE and schema change. true is open, false is closed.
 CONF_mBool(row_nums_check, "true");
 //file descriptors cache, by default, cache 16384 descriptors
+// It's bounded by a half of the limit of open files, and 0 means the half of the limit.
 CONF_Int32(file_descriptor_cache_capacity, "16384");
+// The file descriptor cache has 2^file_descriptor_cache_shard_bits shards. -1 means about one shard per core.
+CONF_Int32(file_descriptor_cache_shard_bits, "-1");
+// The ratio of the file descriptor cache kept for the files read again after opened. The periodic
+// clean of the cache closes only the other files, so the hot segments stay open.
+CONF_Double(file_descriptor_cache_protected_ratio, "0.5");
 // minimum file descriptor number
 // modify them upon necessity
 CONF_Int32(min_file_descriptor_number, "60000");
@@ -262,8 +283,88 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 
 // Cache for stoage page size
 CONF_String(storage_page_cache_limit, "0");
+// The storage page cache has 2^storage_page_cache_shard_bits shards, more shards less lock contention.
+CONF_Int32(storage_page_cache_shard_bits, "4");
+// Fraction of the storage page cache kept for the pages hit again after being cached and the index
+// pages, they are evicted only after the pages read once, so that a large scan doesn't flush them.
+// 0 makes the cache strict LRU.
+CONF_Double(storage_page_cache_protected_ratio, "0.8");
+// Fraction of the storage page cache given to the tier keeping the pages compressed, the rest keeps
+// them decompressed. The compressed tier holds more pages in the same memory at the cost of
+// decompressing them on every hit, which is cheap for LZ4. 0 disables the compressed tier.
+CONF_Double(storage_page_cache_compressed_ratio, "0");
+// Min ratio of the decompressed size to the compressed size of a page to be kept in the compressed tier.
+CONF_mDouble(storage_page_cache_compressed_min_ratio, "2");
+// Bytes of the cache of the serialized segment footers, which saves the IO of opening the segments again.
+// 0 disables the cache.
+CONF_Int64(segment_footer_cache_capacity, "268435456");
+// The capacity in bytes of the cache of the output chunks of the scans of the pipeline engine per tablet, keyed
+// by the plan of the scan and the tablet, 0 to disable the cache.
+CONF_Int64(scan_result_cache_capacity, "0");
+// The output of a scan of a tablet larger than it is not cached.
+CONF_mInt64(scan_result_cache_max_entry_bytes, "4194304");
+// Number of the tablets whose segment footers are read into the segment footer cache in background after
+// the BE starts, the tablets with the newest rowsets first. 0 disables the preload.
+CONF_Int32(segment_footer_cache_preload_tablet_num, "0");
+// Local SSD directories caching the blocks of the files of the external tables on HDFS or object
+// storage, separated by ';'. Empty disables the block cache. The cached blocks are kept across restarts.
+CONF_String(block_cache_disk_path, "");
+// Max bytes each block cache directory holds.
+CONF_Int64(block_cache_disk_size, "107374182400");
+// Size of the blocks the files are cached by.
+CONF_Int64(block_cache_block_size, "1048576");
+// Number of the threads writing the blocks to the block cache.
+CONF_Int32(block_cache_write_threads, "2");
+// Max gap in bytes between two ranges of a row group or stripe of the external tables to be read with
+// a single IO request, the bytes in the gap are read and dropped. 0 disables coalescing the reads.
+CONF_mInt64(hdfs_io_coalesce_gap_bytes, "1048576");
+// Max bytes of a single coalesced read of the external tables, the ranges beyond it are read apart.
+CONF_mInt64(hdfs_io_coalesce_max_bytes, "16777216");
+// Max number of the coalesced ranges of a file of the external tables read at the same time when one of them
+// is needed, the others are read ahead by the IO threads. 1 reads the ranges one by one. It only applies to the
+// files read by pread.
+CONF_mInt32(hdfs_io_parallel_ranges, "4");
+// Number of the threads reading the coalesced ranges ahead.
+CONF_Int32(hdfs_io_threads, "32");
+// The capacity in bytes of the cache of the last bytes of the files of the external tables, which hold the
+// footers and the metadata of the Parquet and ORC files. 0 disables the cache.
+CONF_Int64(hdfs_file_tail_cache_capacity, "67108864");
+// The reads ending at the end of a file larger than it are not cached.
+CONF_mInt64(hdfs_file_tail_cache_max_bytes, "1048576");
+// Number of the threads scanning the metadata of the tablets for the meta scans, e.g. the [_META_] queries
+// of max, min, count and dict_merge. The tablets of a meta scan are scanned at the same time.
+CONF_Int32(meta_scan_threads, "16");
+// The row groups of the Parquet files written by SELECT INTO OUTFILE are closed once their buffered bytes
+// reach it.
+CONF_mInt64(parquet_writer_row_group_bytes, "134217728");
+// Size of the data pages of the Parquet files written by SELECT INTO OUTFILE.
+CONF_mInt64(parquet_writer_page_bytes, "1048576");
+// Whether the columns of the Parquet files written by SELECT INTO OUTFILE are dictionary encoded. A column
+// falls back to the plain encoding once its dictionary exceeds a page.
+CONF_mBool(parquet_writer_enable_dictionary, "true");
+// Number of the files an instance of SELECT INTO OUTFILE writes at the same time, the chunks are dispatched
+// to them in turn and each one is written by a thread. The order of the rows, e.g. of an ORDER BY, is kept
+// across the files only if it's 1.
+CONF_mInt32(file_result_writer_parallel_num, "1");
+// Whether the reads of several ranges of a local file are submitted at once by an io_uring of the
+// reading thread. The POSIX reads are used if the kernel doesn't support io_uring.
+CONF_mBool(enable_io_uring, "false");
+// Whether the segment files written by the memtable flushes and the compactions bypass the page
+// cache with O_DIRECT, so that they don't evict the data of the queries.
+CONF_mBool(enable_direct_io_write, "false");
+// Bytes of the aligned buffer each O_DIRECT file coalesces its appends in.
+CONF_mInt64(direct_io_write_buffer_size, "1048576");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "true");
+// Number of the data pages following the current one each column iterator asks the file system to
+// read ahead in background, so that the scan doesn't stall on them. 0 disables it.
+CONF_mInt32(storage_page_readahead_num, "8");
+// Max bytes of the adjacent data pages of a column each column iterator reads with a single IO
+// request and serves from memory afterwards. 0 disables it.
+CONF_mInt64(storage_page_coalesce_read_bytes, "0");
+// Max bytes of the pages the scan doesn't need one coalesced read may cover, the read stops before
+// the page exceeding it.
+CONF_mInt64(storage_page_coalesce_gap_bytes, "65536");
 // whether to disable column pool
 CONF_Bool(disable_column_pool, "false");
 
@@ -285,10 +386,39 @@ CONF_mInt64(cumulative_compaction_budgeted_bytes, "104857600");
 // compacting a version that might be queried (in case the query planning phase took some time).
 // the following config set the window size
 CONF_mInt32(cumulative_compaction_skip_window_seconds, "30");
+// Whether cumulative compaction links the segment files of its inputs to the output rowset instead of
+// rewriting the rows, when the inputs have no delete predicates and no key is shared by two segments.
+CONF_mBool(enable_compaction_link_segments, "true");
+
+// Max number of the base, cumulative and update compaction tasks running on a disk at the same time,
+// -1 means no limit other than the compaction threads of the disk.
+CONF_mInt32(compaction_max_tasks_per_disk, "2");
+// Max number of compaction tasks running at the same time while the queries are busy, -1 means no limit.
+CONF_mInt32(compaction_max_tasks_under_query_load, "1");
+// The queries are considered busy once the pipeline drivers ready to run exceed this times the number of
+// cores.
+CONF_mInt32(compaction_query_load_ready_drivers_per_core, "2");
 
 CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_Int32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
+// Rowsets whose ratio of deleted rows reaches it are picked first by an update compaction, whatever
+// their size.
+CONF_mDouble(update_compaction_del_ratio_threshold, "0.5");
+// Update compaction merges rowsets of similar sizes, from the smallest one: a rowset is picked only if
+// its live bytes are at most this times the live bytes picked before it, which bounds how many times
+// the same data is rewritten.
+CONF_mInt32(update_compaction_size_tier_ratio, "4");
+// Max number of live rows an update compaction rewrites in a round.
+CONF_mInt64(update_compaction_max_rows_per_round, "10000000");
+// Max number of keys kept in the in-memory L0 of a persistent primary index, they are merged into
+// its on-disk L1 when a commit exceeds it.
+CONF_mInt64(persistent_index_l0_max_keys, "1000000");
+// Percent of the update memory limit the cached primary indexes are allowed to use, the least
+// recently used indexes not in use are evicted beyond it.
+CONF_mInt32(update_primary_index_cache_percent, "60");
+// Number of threads reading the segments of a tablet in parallel when its primary index is loaded.
+CONF_Int32(update_primary_index_load_threads, "4");
 
 // if compaction of a tablet failed, this tablet should not be chosen to
 // compaction until this interval passes.
@@ -337,12 +467,23 @@ CONF_Double(dictionary_encoding_ratio, "0.7");
 // The minimum chunk size for dictionary encoding speculation
 CONF_Int32(dictionary_speculate_min_chunk_size, "10000");
 
+// Whether to extract the frequent top-level fields of a JSON column into typed subcolumns, with their own
+// zone maps and dictionaries, when writing the segments. The fields are detected from the first
+// json_flat_sample_rows rows, a field is extracted if it's in at least json_flat_min_frequency of them
+// with one type, up to json_flat_max_fields fields.
+CONF_mBool(enable_json_flat, "true");
+CONF_mInt32(json_flat_sample_rows, "10000");
+CONF_mDouble(json_flat_min_frequency, "0.8");
+CONF_mInt32(json_flat_max_fields, "16");
+
 // The maximum amount of data that can be processed by a stream load
 CONF_mInt64(streaming_load_max_mb, "10240");
 // Some data formats, such as JSON, cannot be streamed.
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_max_batch_size_mb, "100");
+// Number of threads parsing the records of a CSV stream load in parallel, 1 means it's parsed by the scanner thread.
+CONF_Int32(streaming_load_csv_parse_threads, "4");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -357,6 +498,9 @@ CONF_Int32(tablet_writer_open_rpc_timeout_sec, "60");
 // CONF_Int32(tablet_writer_rpc_timeout_sec, "600");
 // OlapTableSink sender's send interval, should be less than the real response time of a tablet writer rpc.
 CONF_mInt32(olap_table_sink_send_interval_ms, "10");
+// OlapTableSink sends only the columns of each rollup to its tablets instead of all the columns of the table.
+// Turn it off while upgrading a cluster, a tablets channel expects the same columns from all the senders.
+CONF_mBool(enable_load_index_projection, "true");
 
 // Fragment thread pool
 CONF_Int32(fragment_pool_thread_num_min, "64");
@@ -400,16 +544,35 @@ CONF_Bool(use_mmap_allocate_chunk, "false");
 // acquire more free memory which can not be used by other modules
 CONF_Int64(chunk_reserved_bytes_limit, "2147483648");
 
+// Whether to allocate the instance mem pool of the fragments from a query arena, whose slabs are
+// mapped in 2MB steps and only returned when the fragment instance is done.
+CONF_Bool(enable_query_arena, "false");
+// Whether to back the slabs of the query arena by the transparent huge pages.
+CONF_Bool(query_arena_use_huge_page, "true");
+
+// The bytes a thread allocates or frees before they are flushed to its mem tracker and all the parents of it.
+// The consumption of the trackers, and so their limit checks, may be behind by this bound per thread, a larger
+// bound saves the atomic updates of the process and the query trackers shared by all the threads.
+CONF_mInt64(thread_mem_tracker_batch_bytes, "2097152");
+
 // The probing algorithm of partitioned hash table.
 // Enable quadratic probing hash table
 CONF_Bool(enable_quadratic_probing, "false");
 
 // for pprof
 CONF_String(pprof_profile_dir, "${STARROCKS_HOME}/log");
+// The samples per second of the CPU time of each pipeline execution thread taken by the query sampling profiler of
+// /pprof/query_profile, 0 to disable it. At 100 it costs well below 1% of the CPU.
+CONF_Int32(query_sampling_profiler_frequency, "0");
+// The number of the latest queries whose samples are kept by the query sampling profiler.
+CONF_Int32(query_sampling_profiler_max_queries, "100");
 
 // for partition
 // CONF_Bool(enable_partitioned_hash_join, "false")
 CONF_Bool(enable_partitioned_aggregation, "true");
+// Once the streaming pre-aggregation hash table is full, the chunks are passed through without probing it
+// if the ratio of the rows hit it is lower than this.
+CONF_mDouble(streaming_preagg_min_hit_ratio, "0.05");
 
 // to forward compatibility, will be removed later
 CONF_mBool(enable_token_check, "true");
@@ -417,7 +580,32 @@ CONF_mBool(enable_token_check, "true");
 // to open/close system metrics
 CONF_Bool(enable_system_metrics, "true");
 
+// Whether to evaluate the subtrees shared by the conjuncts of a select or the projections of a project
+// only once per chunk.
+CONF_mBool(enable_common_expr_elimination, "true");
+// Whether to evaluate the trees of the arithmetic, comparisons and AND/OR over the numeric columns of a select
+// or a project in one pass over the chunk, without a column per node.
+CONF_mBool(enable_expr_fusion, "true");
+// Whether to evaluate the later conjuncts of an operator or a scan only on the rows kept by the earlier ones,
+// and reorder the conjuncts by their measured cost and selectivity.
+CONF_mBool(enable_adaptive_conjuncts_evaluation, "true");
+// Whether to evaluate the string projections over a single column right above an olap scan by the scan,
+// which evaluates them once per word of the dictionaries of the dict-encoded columns.
+CONF_mBool(enable_scan_column_expr_push_down, "true");
+
 CONF_mBool(enable_prefetch, "true");
+// The probe of a join hash table larger than this number of bytes, which misses the cache mostly,
+// prefetches the hash table ahead of the lookups if enable_prefetch is true.
+CONF_mInt64(join_probe_prefetch_min_bytes, "8388608");
+// The build rows of a join hash table are reordered so that the rows of a bucket are contiguous, if the buckets
+// have at least this number of rows on average, i.e. the keys have many duplicates. <= 0 means never.
+CONF_mDouble(join_cluster_build_rows_min_chain_length, "4");
+// The hash of the fixed-size keys of the join hash tables, "crc32" or "murmur3". murmur3 spreads the keys
+// better, e.g. the keys of a table bucketed by their crc32, and its bucketing of a chunk is vectorized.
+CONF_mString(join_hash_mixing, "crc32");
+// The join runtime filters built from more than this number of rows keep only the min and the max of the keys,
+// without the bloom filter, which would be too large to build, send and probe cheaply. <= 0 means no limit.
+CONF_mInt64(runtime_filter_bloom_max_rows, "16777216");
 
 // Number of cores StarRocks will used, this will effect only when it's greater than 0.
 // Otherwise, StarRocks will use all cores returned from "/proc/cpuinfo".
@@ -463,6 +651,10 @@ CONF_mInt64(write_buffer_size, "104857600");
 CONF_Int64(load_process_max_memory_limit_bytes, "107374182400"); // 100GB
 CONF_Int32(load_process_max_memory_limit_percent, "30");         // 30%
 CONF_Bool(enable_new_load_on_memory_limit_exceeded, "false");
+// Once the memory of all the loads reaches this percent of the load memory limit, the largest memtables
+// of all the loads are flushed in background, so that the writers rarely flush their small memtables
+// in foreground at the hard limit.
+CONF_mInt32(load_memtable_flush_soft_limit_percent, "80");
 CONF_Int64(compaction_max_memory_limit, "-1");
 CONF_Int32(compaction_max_memory_limit_percent, "100");
 CONF_Int64(compaction_memory_limit_per_worker, "2147483648"); // 2GB
@@ -514,6 +706,8 @@ CONF_String(es_scroll_keepalive, "5m");
 
 // HTTP connection timeout for es
 CONF_Int32(es_http_timeout_ms, "5000");
+// Number of the sliced scrolls each shard of es is read by in parallel, 1 disables the slicing.
+CONF_mInt32(es_scroll_slices_per_shard, "1");
 
 // the max client cache number per each host
 // There are variety of client cache in BE, but currently we use the
@@ -538,6 +732,26 @@ CONF_mInt32(storage_flood_stage_usage_percent, "95"); // 95%
 CONF_mInt64(storage_flood_stage_left_capacity_bytes, "1073741824"); // 1GB
 // number of thread for flushing memtable per store
 CONF_Int32(flush_thread_num_per_store, "2");
+// number of threads shared by all the segment writers to encode and compress the columns of a segment
+// in parallel, 0 to encode the columns on the flushing thread.
+CONF_Int32(segment_encode_thread_num, "0");
+// a segment writer encodes its columns in parallel only if it writes at least this number of columns.
+CONF_mInt32(segment_parallel_encode_min_columns, "16");
+// number of threads to pre-warm the rowsets newly written by the compactions, the clones and the storage
+// migrations, i.e. load their indexes and read their pages into the page cache, 0 to disable the pre-warming.
+CONF_Int32(rowset_prewarm_thread_num, "0");
+// the max number of the pending pre-warming tasks, a task beyond it is skipped.
+CONF_Int32(rowset_prewarm_max_queue_size, "1024");
+// the max bytes of the pages read by a pre-warming task, the IO budget of it.
+CONF_mInt64(rowset_prewarm_max_bytes, "268435456");
+// a tablet is pre-warmed only if it's scanned at least this many times recently, see the access heat
+// tablet_access_heat_half_life_sec.
+CONF_mDouble(rowset_prewarm_min_access_scans, "1");
+// The pages of a ZSTD compressed CHAR, VARCHAR or JSON column are compressed with a ZSTD dictionary trained
+// from the first pages of the column in a segment, up to this number of bytes. 0 disables the dictionary.
+CONF_mInt64(zstd_dict_compression_sample_bytes, "0");
+// The max size of the ZSTD dictionary of a column.
+CONF_mInt32(zstd_dict_compression_dict_size, "16384");
 
 // config for tablet meta checkpoint
 CONF_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
@@ -568,12 +782,24 @@ CONF_Int32(txn_shard_size, "1024");
 
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_load_tablet_failure, "false");
+// Number of the threads deserializing and registering the tablet and rowset metas of each data dir when the BE
+// starts, the data dirs are loaded in parallel too. 1 loads them serially.
+CONF_Int32(load_tablet_meta_thread_num_per_data_dir, "4");
 
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_rowset_stale_unconsistent_delete, "false");
 
 // The chunk size for vector query engine
 CONF_Int32(vector_chunk_size, "4096");
+// The bytes of the chunks read by a scan of the pipeline engine, estimated by the widths of the columns read.
+// The scans of the wide rows read fewer rows at a time so that a chunk fits in the CPU caches, never more than
+// vector_chunk_size rows. 0 disables it.
+CONF_mInt64(scan_chunk_target_bytes, "2097152");
+// Whether a scan of the pipeline engine merges the small chunks left by the filters, until a chunk has at least
+// half of the rows of a read.
+CONF_mBool(enable_scan_chunk_coalesce, "true");
+// Whether the pipeline engine merges the small chunks output by the hash join probes before the operators after them.
+CONF_mBool(enable_pipeline_chunk_accumulate, "true");
 
 // valid range: [0-1000].
 // `0` will disable late materialization.
@@ -609,8 +835,27 @@ CONF_mInt16(storage_format_version, "2");
 // 1 for LZ4_NULL
 CONF_mInt16(null_encoding, "0");
 
+// IMPORTANT NOTE: enabling this config must require all BEs to be upgraded to new version,
+// which support DELTA_ENCODING and GORILLA_ENCODING.
+// Whether the numeric columns with the default encoding are written with the adaptive encodings: the integers,
+// the dates and the datetimes with DELTA_ENCODING, the floats and the doubles with GORILLA_ENCODING.
+CONF_mBool(enable_adaptive_numeric_encoding, "false");
+
+// IMPORTANT NOTE: enabling this config must require all BEs to be upgraded to new version,
+// which support ADAPTIVE_ENCODING.
+// Whether the numeric columns with the default encoding are written with ADAPTIVE_ENCODING, which encodes a
+// sample of every page with the encodings of the type and picks the one of the lowest cost:
+// encoded size * (1 + adaptive_encoding_decode_cost_weight * the decoding cost relative to PLAIN_ENCODING).
+CONF_mBool(enable_adaptive_page_encoding, "false");
+CONF_mInt32(adaptive_encoding_sample_rows, "1024");
+// 0 for the smallest pages, larger for the faster decoding.
+CONF_mDouble(adaptive_encoding_decode_cost_weight, "0.05");
+
 // do pre-aggregate if effect great than the factor, factor range:[1-100].
 CONF_Int16(pre_aggregate_factor, "80");
+// Whether the pre-aggregated scans of the aggregate key tablets reading a prefix of the keys merge the segments
+// and aggregate the rows by the prefix, so that each group of the prefix leaves a tablet as a single row.
+CONF_mBool(enable_pre_aggregate_by_key_prefix, "true");
 
 #ifdef __x86_64__
 // enable genearate minidump for crash
@@ -634,6 +879,10 @@ CONF_mInt32(sys_minidump_interval, "600");
 // requests will fail.
 CONF_Int16(tablet_max_versions, "1000");
 
+// The half life in seconds of the access heat of the tablets reported to the FE, the scans of the queries
+// older than it weigh half as much.
+CONF_mInt64(tablet_access_heat_half_life_sec, "86400");
+
 // will remove
 CONF_mBool(enable_bitmap_union_disk_format_with_set, "false");
 
@@ -643,20 +892,66 @@ CONF_Int64(pipeline_yield_max_chunks_moved, "100");
 // yield PipelineDriver when maximum time in nano-seconds has spent
 // in current execution round.
 CONF_Int64(pipeline_yield_max_time_spent, "100000000");
+// the time slice in nano-seconds of the PipelineDriver at the first level of the driver queue, it's doubled
+// for each higher level up to pipeline_yield_max_time_spent, so the drivers of the short queries yield sooner.
+// The time slice is always pipeline_yield_max_time_spent if it's not less than that.
+CONF_Int64(pipeline_yield_min_time_spent, "10000000");
 // the number of scan threads pipeline engine.
 CONF_Int64(pipeline_scan_thread_pool_thread_num, "0");
 // queue size of scan thread pool for pipeline engine.
 CONF_Int64(pipeline_scan_thread_pool_queue_size, "102400");
 // the number of execution threads for pipeline engine.
 CONF_Int64(pipeline_exec_thread_pool_thread_num, "0");
+// Whether the execution threads of the pipeline engine are pinned to the NUMA nodes, each with its own local
+// queues of drivers, and the drivers of a fragment instance are preferably run by the threads of one node.
+CONF_Bool(pipeline_numa_aware_scheduling, "false");
 // the buffer size of io task
 CONF_Int64(pipeline_io_buffer_size, "64");
 // the buffer size of SinkBuffer
 CONF_Int64(pipeline_sink_buffer_size, "64");
 // the degree of parallelism of brpc
 CONF_Int64(pipeline_sink_brpc_dop, "8");
+// The requests to the same destination queued in SinkBuffer are coalesced into one RPC of at most
+// this number of attachment bytes. 0 means not to coalesce the requests.
+CONF_mInt64(pipeline_sink_coalesce_max_bytes, "1048576");
+// Whether SinkBuffer keeps the bytes in flight to a destination within the credit granted by the receiver,
+// instead of relying on the receiver delaying the responses once its buffer is full.
+CONF_mBool(pipeline_sink_credit_flow_control, "true");
+// Choose the codec (none, LZ4 or ZSTD) of every chunk transmitted by ExchangeSinkOperator by the measured
+// compression ratio and RPC throughput of the destination, instead of transmission_compression_type.
+CONF_mBool(pipeline_exchange_adaptive_compression, "false");
+// ExchangeSinkOperator samples one of every this number of rows of a hash shuffle to find the hot keys, which
+// take more than a receiver's share of the rows, and reports them in the profile. 0 means not to sample.
+CONF_mInt32(pipeline_exchange_skew_sample_interval, "64");
+// The build operators of a broadcast join build one hash table together and share it, instead of
+// building the same hash table each.
+CONF_mBool(pipeline_share_broadcast_hash_table, "true");
 
 CONF_Int64(pipeline_scan_max_tasks_per_operator, "4");
+// The scan ranges of the tablets are split into morsels of about this number of rows at least, so the large
+// tablets could be scanned by several ScanOperators. The duplicate and primary key tablets are split by rowid
+// ranges, the aggregate and unique key tablets by key ranges. 0 means not to split the tablets.
+CONF_mInt64(pipeline_scan_morsel_min_rows, "1048576");
+// Bytes of the cache of the descriptor tables of the pipeline fragments, keyed by the serialized descriptor
+// table, which saves building the same descriptors for every instance of a query sent again and again.
+// 0 disables the cache.
+CONF_Int64(pipeline_desc_tbl_cache_capacity, "16777216");
+// The profile of a fragment instance running longer than this number of milliseconds is reported to FE at its end,
+// even if the query doesn't enable the profile, so the sporadic slow queries could be diagnosed without profiling
+// all the queries. 0 means not to report them.
+CONF_mInt64(pipeline_slow_query_profile_threshold_ms, "0");
+
+// The max memory bytes a spillable operator could hold before it begins to spill its state
+// to `query_scratch_dirs`. It only takes effect when the session variable enable_spilling is true.
+CONF_mInt64(spill_operator_mem_threshold_bytes, "1073741824");
+// The number of hash partitions the spillable operators split their state into.
+CONF_mInt32(spill_hash_partitions, "16");
+// The ratio of the limit of the query pool the pipeline queries may reserve in total. A query reserves its
+// mem_limit when its first fragment is prepared, and waits if the reservations of the running queries add up
+// to it. 0 disables the admission by memory.
+CONF_mDouble(query_mem_admission_ratio, "0");
+// The max time a query waits for its memory to be admitted, it fails after it.
+CONF_mInt64(query_mem_admission_timeout_ms, "10000");
 
 // bitmap serialize version
 CONF_Int16(bitmap_serialize_version, "1");
@@ -0,0 +1,275 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "env/block_cache.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "env/env.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/hash_util.hpp"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+// Block file := Magic(4), Checksum(4), KeySize(4), DataSize(4), Key, Data
+// Checksum is the crc32c of Key and Data.
+static constexpr uint32_t kBlockMagic = 0x43425253; // "SRBC"
+static constexpr size_t kBlockHeaderSize = 16;
+static const char* const kTmpSuffix = ".tmp";
+
+BlockCache::~BlockCache() {
+    close();
+}
+
+BlockCache* BlockCache::instance() {
+    static BlockCache s_block_cache;
+    return &s_block_cache;
+}
+
+Status BlockCache::init(const std::vector<std::string>& dirs, size_t capacity_per_dir, size_t block_size,
+                        int write_threads) {
+    DCHECK(_dirs.empty());
+    if (dirs.empty() || capacity_per_dir == 0 || block_size == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("block_cache")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(1, write_threads))
+                            .set_max_queue_size(1024)
+                            .build(&_write_pool));
+    std::vector<std::unique_ptr<Dir>> loaded;
+    for (const auto& path : dirs) {
+        auto dir = std::make_unique<Dir>();
+        dir->path = path;
+        dir->capacity = capacity_per_dir;
+        RETURN_IF_ERROR(_load_dir(dir.get()));
+        LOG(INFO) << "Load block cache dir " << path << ", usage=" << dir->usage << ", blocks=" << dir->blocks.size();
+        loaded.emplace_back(std::move(dir));
+    }
+    _block_size = block_size;
+    _dirs = std::move(loaded);
+    return Status::OK();
+}
+
+void BlockCache::close() {
+    if (_write_pool != nullptr) {
+        _write_pool->wait();
+        _write_pool->shutdown();
+        _write_pool.reset();
+    }
+}
+
+// Loads the blocks left by the last run, and removes the blocks it was writing.
+Status BlockCache::_load_dir(Dir* dir) {
+    Env* env = Env::Default();
+    RETURN_IF_ERROR(env->create_dir_if_missing(dir->path));
+    std::vector<std::string> names;
+    RETURN_IF_ERROR(env->get_children(dir->path, &names));
+    for (const auto& name : names) {
+        if (name == "." || name == "..") {
+            continue;
+        }
+        const std::string path = dir->path + "/" + name;
+        if (name.find(kTmpSuffix) != std::string::npos) {
+            WARN_IF_ERROR(env->delete_file(path), "Fail to remove unfinished block " + path);
+            continue;
+        }
+        uint64_t size = 0;
+        if (env->get_file_size(path, &size).ok()) {
+            _add_block(dir, name, size);
+        }
+    }
+    return Status::OK();
+}
+
+std::string BlockCache::_block_name(const std::string& file_key, uint64_t block_index) {
+    uint64_t hash = HashUtil::hash64(file_key.data(), file_key.size(), 0);
+    return fmt::format("{:016x}_{}", hash, block_index);
+}
+
+BlockCache::Dir* BlockCache::_dir_of(const std::string& block_name) const {
+    uint64_t hash = HashUtil::hash64(block_name.data(), block_name.size(), 0);
+    return _dirs[hash % _dirs.size()].get();
+}
+
+void BlockCache::_add_block(Dir* dir, const std::string& block_name, size_t size) {
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard l(dir->mutex);
+        auto it = dir->blocks.find(block_name);
+        if (it != dir->blocks.end()) {
+            dir->usage -= it->second.second;
+            dir->lru.erase(it->second.first);
+            dir->blocks.erase(it);
+        }
+        dir->lru.push_back(block_name);
+        dir->blocks.emplace(block_name, std::make_pair(std::prev(dir->lru.end()), size));
+        dir->usage += size;
+        while (dir->usage > dir->capacity && dir->lru.size() > 1) {
+            auto victim = dir->blocks.find(dir->lru.front());
+            dir->usage -= victim->second.second;
+            dir->blocks.erase(victim);
+            evicted.emplace_back(std::move(dir->lru.front()));
+            dir->lru.pop_front();
+        }
+    }
+    // delete files out of the lock
+    for (const auto& name : evicted) {
+        WARN_IF_ERROR(Env::Default()->delete_file(dir->path + "/" + name), "Fail to remove evicted block " + name);
+    }
+}
+
+void BlockCache::_remove_block(Dir* dir, const std::string& block_name) {
+    {
+        std::lock_guard l(dir->mutex);
+        auto it = dir->blocks.find(block_name);
+        if (it == dir->blocks.end()) {
+            return;
+        }
+        dir->usage -= it->second.second;
+        dir->lru.erase(it->second.first);
+        dir->blocks.erase(it);
+    }
+    WARN_IF_ERROR(Env::Default()->delete_file(dir->path + "/" + block_name), "Fail to remove block " + block_name);
+}
+
+Status BlockCache::read_block(const std::string& file_key, uint64_t block_index, std::string* data) {
+    if (!enabled()) {
+        return Status::NotFound("block cache is disabled");
+    }
+    const std::string name = _block_name(file_key, block_index);
+    Dir* dir = _dir_of(name);
+    {
+        std::lock_guard l(dir->mutex);
+        auto it = dir->blocks.find(name);
+        if (it == dir->blocks.end()) {
+            return Status::NotFound("block not cached");
+        }
+        dir->lru.splice(dir->lru.end(), dir->lru, it->second.first);
+    }
+
+    std::unique_ptr<RandomAccessFile> file;
+    uint64_t size = 0;
+    std::string buf;
+    Status st = Env::Default()->new_random_access_file(dir->path + "/" + name, &file);
+    if (st.ok()) {
+        st = file->size(&size);
+    }
+    if (st.ok() && size < kBlockHeaderSize) {
+        st = Status::Corruption("block file is too small");
+    }
+    if (st.ok()) {
+        buf.resize(size);
+        st = file->read_at(0, Slice(buf));
+    }
+    if (st.ok()) {
+        const auto* header = reinterpret_cast<const uint8_t*>(buf.data());
+        uint32_t magic = decode_fixed32_le(header);
+        uint32_t checksum = decode_fixed32_le(header + 4);
+        uint32_t key_size = decode_fixed32_le(header + 8);
+        uint32_t data_size = decode_fixed32_le(header + 12);
+        if (magic != kBlockMagic || kBlockHeaderSize + key_size + data_size != size) {
+            st = Status::Corruption("bad block file header");
+        } else if (crc32c::Value(buf.data() + kBlockHeaderSize, key_size + data_size) != checksum) {
+            st = Status::Corruption("block checksum mismatch");
+        } else if (Slice(buf.data() + kBlockHeaderSize, key_size) != Slice(file_key)) {
+            // another file of the same hash
+            return Status::NotFound("block not cached");
+        } else {
+            data->assign(buf.data() + kBlockHeaderSize + key_size, data_size);
+            return Status::OK();
+        }
+    }
+    LOG(WARNING) << "Drop bad cached block " << dir->path << "/" << name << ": " << st.to_string();
+    _remove_block(dir, name);
+    return Status::NotFound("block not cached");
+}
+
+Status BlockCache::write_block(const std::string& file_key, uint64_t block_index, const Slice& data) {
+    if (!enabled()) {
+        return Status::OK();
+    }
+    const std::string name = _block_name(file_key, block_index);
+    Dir* dir = _dir_of(name);
+    const std::string path = dir->path + "/" + name;
+    // write to a temporary file and rename it, so a crash never leaves a partial block behind.
+    const std::string tmp_path = fmt::format("{}{}{}", path, kTmpSuffix, _next_tmp_id++);
+
+    uint8_t header[kBlockHeaderSize];
+    uint32_t checksum = crc32c::Extend(crc32c::Value(file_key.data(), file_key.size()), data.data, data.size);
+    encode_fixed32_le(header, kBlockMagic);
+    encode_fixed32_le(header + 4, checksum);
+    encode_fixed32_le(header + 8, file_key.size());
+    encode_fixed32_le(header + 12, data.size);
+    Slice slices[3] = {Slice(header, kBlockHeaderSize), Slice(file_key), data};
+
+    Env* env = Env::Default();
+    std::unique_ptr<WritableFile> file;
+    RETURN_IF_ERROR(env->new_writable_file(tmp_path, &file));
+    Status st = file->appendv(slices, 3);
+    if (st.ok()) {
+        st = file->close();
+    }
+    if (st.ok()) {
+        st = env->rename_file(tmp_path, path);
+    }
+    if (!st.ok()) {
+        WARN_IF_ERROR(env->delete_file(tmp_path), "Fail to remove unfinished block " + tmp_path);
+        return st;
+    }
+    _add_block(dir, name, kBlockHeaderSize + file_key.size() + data.size);
+    return Status::OK();
+}
+
+void BlockCache::write_block_async(const std::string& file_key, uint64_t block_index, std::string data) {
+    if (_write_pool == nullptr) {
+        return;
+    }
+    // the block is dropped when the queue is full
+    (void)_write_pool->submit_func([this, file_key, block_index, data = std::move(data)]() {
+        WARN_IF_ERROR(write_block(file_key, block_index, Slice(data)), "Fail to write block cache");
+    });
+}
+
+Status BlockCache::read(const std::string& file_key, uint64_t file_length, uint64_t offset, const Slice& buf,
+                        const ReadFunc& read_fn, int64_t* hit_bytes) {
+    const uint64_t end = offset + buf.size;
+    if (end > file_length) {
+        return Status::InvalidArgument(
+                fmt::format("read beyond the file end, offset={}, size={}, file_length={}", offset, buf.size,
+                            file_length));
+    }
+    std::string block;
+    char* dst = buf.data;
+    for (uint64_t index = offset / _block_size; index * _block_size < end; index++) {
+        const uint64_t block_begin = index * _block_size;
+        const size_t block_len = std::min<uint64_t>(_block_size, file_length - block_begin);
+        const size_t from = std::max(offset, block_begin) - block_begin;
+        const size_t to = std::min<uint64_t>(end, block_begin + block_len) - block_begin;
+        if (read_block(file_key, index, &block).ok() && block.size() == block_len) {
+            *hit_bytes += to - from;
+        } else {
+            block.resize(block_len);
+            RETURN_IF_ERROR(read_fn(block_begin, Slice(block)));
+            write_block_async(file_key, index, block);
+        }
+        memcpy(dst, block.data() + from, to - from);
+        dst += to - from;
+    }
+    return Status::OK();
+}
+
+size_t BlockCache::usage() const {
+    size_t usage = 0;
+    for (const auto& dir : _dirs) {
+        std::lock_guard l(dir->mutex);
+        usage += dir->usage;
+    }
+    return usage;
+}
+
+} // namespace starrocks
@@ -0,0 +1,93 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+class ThreadPool;
+
+// A persistent cache of the fixed-size blocks of the files on remote storage (HDFS, object storage),
+// kept as files in local SSD directories. A block is identified by the key of its file and its index
+// in the file, the file key must change when the file content changes.
+// - The blocks missing in the cache are written to it by background threads, so the readers never
+//   wait for the cache.
+// - Each cached block carries a crc32c checksum, a corrupted block is dropped when it's read.
+// - Each directory drops its least recently used blocks once it holds more than its capacity.
+// - The blocks left in the directories are loaded again when the BE restarts.
+class BlockCache {
+public:
+    // Reads exactly `buf.size` bytes at `offset` of the file from the storage.
+    using ReadFunc = std::function<Status(uint64_t offset, const Slice& buf)>;
+
+    BlockCache() = default;
+    ~BlockCache();
+
+    static BlockCache* instance();
+
+    // `dirs` keep the blocks, each of them holds at most `capacity_per_dir` bytes.
+    Status init(const std::vector<std::string>& dirs, size_t capacity_per_dir, size_t block_size, int write_threads);
+
+    // Waits for the pending writes and stops caching new blocks.
+    void close();
+
+    bool enabled() const { return !_dirs.empty(); }
+
+    size_t block_size() const { return _block_size; }
+
+    // Reads [offset, offset + buf.size) of the file `file_key` of `file_length` bytes into `buf`, the
+    // blocks not in the cache are read by `read_fn` in whole and then cached asynchronously.
+    // The bytes found in the cache are added to `hit_bytes`.
+    Status read(const std::string& file_key, uint64_t file_length, uint64_t offset, const Slice& buf,
+                const ReadFunc& read_fn, int64_t* hit_bytes);
+
+    // Reads the whole cached block, returns NotFound if it's not cached or it's corrupted.
+    Status read_block(const std::string& file_key, uint64_t block_index, std::string* data);
+
+    // Writes the block to the cache, replacing the one of the same file key and index.
+    Status write_block(const std::string& file_key, uint64_t block_index, const Slice& data);
+
+    // Asks a background thread to write the block, it's dropped if the threads are too busy.
+    void write_block_async(const std::string& file_key, uint64_t block_index, std::string data);
+
+    size_t usage() const;
+
+private:
+    struct Dir {
+        std::string path;
+        size_t capacity = 0;
+
+        std::mutex mutex;
+        size_t usage = 0;
+        // block file names from the least recently used to the most recently used
+        std::list<std::string> lru;
+        // block file name -> its position in `lru` and its size
+        std::unordered_map<std::string, std::pair<std::list<std::string>::iterator, size_t>> blocks;
+    };
+
+    static std::string _block_name(const std::string& file_key, uint64_t block_index);
+
+    Dir* _dir_of(const std::string& block_name) const;
+    Status _load_dir(Dir* dir);
+    // Adds the block to the index of the directory and evicts the blocks beyond the capacity.
+    void _add_block(Dir* dir, const std::string& block_name, size_t size);
+    void _remove_block(Dir* dir, const std::string& block_name);
+
+    size_t _block_size = 0;
+    std::vector<std::unique_ptr<Dir>> _dirs;
+    std::unique_ptr<ThreadPool> _write_pool;
+    std::atomic<uint64_t> _next_tmp_id{0};
+};
+
+} // namespace starrocks
@@ -0,0 +1,128 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "env/coalesced_read_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/countdown_latch.h"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+// The threads reading the merged ranges ahead, shared by all the files. nullptr if it can't be built.
+static ThreadPool* io_thread_pool() {
+    static ThreadPool* s_pool = []() -> ThreadPool* {
+        std::unique_ptr<ThreadPool> pool;
+        Status st = ThreadPoolBuilder("hdfs_io")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(1, config::hdfs_io_threads))
+                            .build(&pool);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to build the hdfs io thread pool, the ranges are read one by one: " << st;
+            return nullptr;
+        }
+        return pool.release();
+    }();
+    return s_pool;
+}
+
+void CoalescedReadBuffer::set_io_ranges(std::vector<IORange> ranges) {
+    _buffers.clear();
+    if (config::hdfs_io_coalesce_gap_bytes <= 0 || config::hdfs_io_coalesce_max_bytes <= 0) {
+        return;
+    }
+    auto gap = static_cast<uint64_t>(config::hdfs_io_coalesce_gap_bytes);
+    auto max_bytes = static_cast<uint64_t>(config::hdfs_io_coalesce_max_bytes);
+    std::sort(ranges.begin(), ranges.end(),
+              [](const IORange& lhs, const IORange& rhs) { return lhs.offset < rhs.offset; });
+    for (const auto& range : ranges) {
+        // a range as large as a whole coalesced read gains nothing from the buffer
+        if (range.size == 0 || range.size >= max_bytes) {
+            continue;
+        }
+        if (!_buffers.empty()) {
+            auto& last = _buffers.back();
+            uint64_t last_end = last.offset + last.size;
+            uint64_t end = std::max(last_end, range.offset + range.size);
+            if (range.offset <= last_end + gap && end - last.offset <= max_bytes) {
+                last.size = end - last.offset;
+                continue;
+            }
+            if (range.offset < last_end) {
+                // overlaps the last merged range, which can't grow any more
+                continue;
+            }
+        }
+        Buffer buffer;
+        buffer.offset = range.offset;
+        buffer.size = range.size;
+        _buffers.emplace_back(std::move(buffer));
+    }
+}
+
+StatusOr<bool> CoalescedReadBuffer::read(uint64_t offset, const Slice& buf) {
+    auto it = std::upper_bound(_buffers.begin(), _buffers.end(), offset,
+                               [](uint64_t offset, const Buffer& buffer) { return offset < buffer.offset; });
+    if (it == _buffers.begin()) {
+        return false;
+    }
+    --it;
+    if (offset + buf.size > it->offset + it->size) {
+        return false;
+    }
+    if (!it->loaded) {
+        RETURN_IF_ERROR(_load(it - _buffers.begin()));
+    }
+    memcpy(buf.data, it->data.data() + (offset - it->offset), buf.size);
+    _served_reads++;
+    return true;
+}
+
+Status CoalescedReadBuffer::_load(size_t index) {
+    // the ranges after it are likely to be read next
+    std::vector<size_t> indexes{index};
+    size_t max_parallel = _parallel ? std::max(config::hdfs_io_parallel_ranges, 1) : 1;
+    for (size_t i = index + 1; i < _buffers.size() && indexes.size() < max_parallel; ++i) {
+        if (!_buffers[i].loaded) {
+            indexes.push_back(i);
+        }
+    }
+    for (size_t i : indexes) {
+        _buffers[i].data.resize(_buffers[i].size);
+    }
+
+    std::vector<Status> statuses(indexes.size());
+    CountDownLatch latch(indexes.size() - 1);
+    ThreadPool* pool = indexes.size() > 1 ? io_thread_pool() : nullptr;
+    for (size_t k = 1; k < indexes.size(); ++k) {
+        Buffer* buffer = &_buffers[indexes[k]];
+        Status* st = &statuses[k];
+        auto task = [this, buffer, st, &latch]() {
+            *st = _read_fn(buffer->offset, Slice(buffer->data));
+            latch.count_down();
+        };
+        if (pool == nullptr || !pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    statuses[0] = _read_fn(_buffers[index].offset, Slice(_buffers[index].data));
+    latch.wait();
+
+    for (size_t k = 0; k < indexes.size(); ++k) {
+        auto& buffer = _buffers[indexes[k]];
+        if (statuses[k].ok()) {
+            buffer.loaded = true;
+            _issued_reads++;
+        } else {
+            // a range read ahead is read again when it's needed
+            std::string().swap(buffer.data);
+        }
+    }
+    return statuses[0];
+}
+
+} // namespace starrocks
@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/statusor.h"
+#include "env/env.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// CoalescedReadBuffer serves the small reads of a row group or stripe of the files on remote storage
+// from memory. The readers plan the byte ranges they are going to read up front, the ranges closer than
+// config::hdfs_io_coalesce_gap_bytes are merged into one of at most config::hdfs_io_coalesce_max_bytes,
+// and each merged range is read with a single IO request the first time one of its ranges is read.
+// If `parallel`, the next config::hdfs_io_parallel_ranges - 1 merged ranges are read ahead by the IO
+// threads at the same time, so that the latencies of the requests to the remote storage overlap.
+// Now this is not thread-safe.
+class CoalescedReadBuffer {
+public:
+    // Reads exactly `buf.size` bytes at `offset` of the file from the storage.
+    // It's called by several threads at once if `parallel`.
+    using ReadFunc = std::function<Status(uint64_t offset, const Slice& buf)>;
+
+    explicit CoalescedReadBuffer(ReadFunc read_fn, bool parallel = false)
+            : _read_fn(std::move(read_fn)), _parallel(parallel) {}
+
+    // Drops the buffers of the previous ranges and plans `ranges`, nothing is read until they are used.
+    void set_io_ranges(std::vector<IORange> ranges);
+
+    void clear() { _buffers.clear(); }
+
+    // Copies [offset, offset + buf.size) into `buf` if it's inside a planned range, reading the merged
+    // range first if it's not buffered yet. Returns false if the range isn't planned.
+    StatusOr<bool> read(uint64_t offset, const Slice& buf);
+
+    // Returns and clears the number of the reads served from the buffers and of the IO requests issued
+    // for them, the difference is the round trips saved.
+    void pop_io_counts(int64_t* served_reads, int64_t* issued_reads) {
+        *served_reads = std::exchange(_served_reads, 0);
+        *issued_reads = std::exchange(_issued_reads, 0);
+    }
+
+private:
+    struct Buffer {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        bool loaded = false;
+        std::string data;
+    };
+
+    // Reads the merged range `index` and the ranges read ahead with it.
+    Status _load(size_t index);
+
+    ReadFunc _read_fn;
+    bool _parallel = false;
+    // merged ranges sorted by the offset, they don't overlap
+    std::vector<Buffer> _buffers;
+    int64_t _served_reads = 0;
+    int64_t _issued_reads = 0;
+};
+
+} // namespace starrocks
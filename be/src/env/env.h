@@ -11,6 +11,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/status.h"
 #include "util/slice.h"
@@ -172,6 +173,9 @@ struct WritableFileOptions {
     bool sync_on_close = false;
     // See OpenMode for details.
     Env::OpenMode mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
+    // Write with O_DIRECT, bypassing the page cache. The appends are buffered and written in aligned
+    // blocks. Ignored if the file system doesn't support it.
+    bool direct_io = false;
 };
 
 // Creation-time options for RWFile
@@ -212,6 +216,12 @@ public:
     virtual const std::string& filename() const = 0;
 };
 
+// A byte range of a file to be read.
+struct IORange {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
 class RandomAccessFile {
 public:
     RandomAccessFile() = default;
@@ -248,6 +258,27 @@ public:
     // Safe for concurrent use by multiple threads.
     virtual Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Read "results[i].size" bytes starting at "offsets[i]" into each of the "n" results.
+    // The implementation may issue all the reads at once instead of one after another.
+    //
+    // If an error was encountered, returns a non-OK status. Short reads are retried like read_at.
+    //
+    // Safe for concurrent use by multiple threads.
+    virtual Status read_ranges_at(const uint64_t* offsets, const Slice* results, size_t n) const {
+        for (size_t i = 0; i < n; ++i) {
+            RETURN_IF_ERROR(read_at(offsets[i], results[i]));
+        }
+        return Status::OK();
+    }
+
+    // Hint that the "size" bytes starting at "offset" will be read soon, the implementation
+    // may start reading them in background. It never waits for the data.
+    virtual Status readahead(uint64_t offset, size_t size) const { return Status::OK(); }
+
+    // Hint that the "ranges" of a row group or stripe will be read next, the implementation may
+    // coalesce them into fewer IO requests. The ranges hinted before are dropped.
+    virtual void set_io_ranges(const std::vector<IORange>& ranges) {}
+
     // Return the size of this file
     virtual Status size(uint64_t* size) const = 0;
 
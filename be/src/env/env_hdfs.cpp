@@ -2,7 +2,13 @@
 
 #include "env/env_hdfs.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "common/config.h"
+#include "env/block_cache.h"
 #include "env/env.h"
+#include "env/file_tail_cache.h"
 #include "fmt/core.h"
 #include "gutil/strings/substitute.h"
 #include "hdfs/hdfs.h"
@@ -11,7 +17,12 @@
 namespace starrocks {
 
 HdfsRandomAccessFile::HdfsRandomAccessFile(hdfsFS fs, std::string filename, bool usePread)
-        : _opened(false), _fs(fs), _file(nullptr), _filename(std::move(filename)), _usePread(usePread) {}
+        : _opened(false),
+          _fs(fs),
+          _file(nullptr),
+          _filename(std::move(filename)),
+          _usePread(usePread),
+          _read_buffer([this](uint64_t offset, const Slice& buf) { return _read_at_fully(offset, buf); }, usePread) {}
 
 HdfsRandomAccessFile::~HdfsRandomAccessFile() noexcept {
     close();
@@ -34,6 +45,7 @@ void HdfsRandomAccessFile::close() noexcept {
         if (_fs && _file) {
             hdfsCloseFile(_fs, _file);
         }
+        _read_buffer.clear();
         _opened = false;
     }
 }
@@ -74,16 +86,71 @@ static Status read_at_internal(hdfsFS fs, hdfsFile file, const std::string& file
     return Status::OK();
 }
 
-Status HdfsRandomAccessFile::read(uint64_t offset, Slice* res) const {
-    DCHECK(_opened);
-    RETURN_IF_ERROR(read_at_internal(_fs, _file, _filename, offset, res, _usePread));
+void HdfsRandomAccessFile::enable_block_cache(uint64_t file_length) {
+    if (BlockCache::instance()->enabled()) {
+        // the files of the external tables are not modified in place, a rewritten file gets another length
+        // most of the time.
+        _block_cache_key = fmt::format("{}:{}", _filename, file_length);
+        _file_length = file_length;
+    }
+}
+
+void HdfsRandomAccessFile::enable_tail_cache(uint64_t file_length) {
+    if (FileTailCache::instance() != nullptr) {
+        // keyed like the block cache
+        _tail_cache_key = fmt::format("{}:{}", _filename, file_length);
+        _file_length = file_length;
+    }
+}
+
+Status HdfsRandomAccessFile::_read_at_internal(uint64_t offset, Slice* res) const {
+    if (!_tail_cache_key.empty() && offset < _file_length && offset + res->size == _file_length &&
+        static_cast<int64_t>(res->size) <= config::hdfs_file_tail_cache_max_bytes) {
+        return _read_tail(offset, res);
+    }
+    return _read_at_storage(offset, res);
+}
+
+Status HdfsRandomAccessFile::_read_tail(uint64_t offset, Slice* res) const {
+    auto* cache = FileTailCache::instance();
+    std::string tail;
+    // a longer tail serves the shorter reads, e.g. the magic number and the footer length
+    if (cache->lookup(_tail_cache_key, &tail) && tail.size() >= res->size) {
+        memcpy(res->data, tail.data() + tail.size() - res->size, res->size);
+        _tail_cache_hit_bytes += res->size;
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_read_at_storage(offset, res));
+    if (offset + res->size == _file_length && res->size > tail.size()) {
+        cache->insert(_tail_cache_key, std::string(res->data, res->size));
+    }
     return Status::OK();
 }
 
-Status HdfsRandomAccessFile::read_at(uint64_t offset, const Slice& res) const {
-    DCHECK(_opened);
+Status HdfsRandomAccessFile::_read_at_storage(uint64_t offset, Slice* res) const {
+    if (_block_cache_key.empty()) {
+        return read_at_internal(_fs, _file, _filename, offset, res, _usePread);
+    }
+    res->size = std::min<uint64_t>(res->size, offset < _file_length ? _file_length - offset : 0);
+    auto read_fn = [this](uint64_t offset, const Slice& buf) {
+        Slice slice = buf;
+        RETURN_IF_ERROR(read_at_internal(_fs, _file, _filename, offset, &slice, _usePread));
+        if (slice.size != buf.size) {
+            return Status::IOError(strings::Substitute("fail to read enough data, file=$0, offset=$1, size=$2, "
+                                                       "expect=$3",
+                                                       _filename, offset, slice.size, buf.size));
+        }
+        return Status::OK();
+    };
+    int64_t hit_bytes = 0;
+    Status st = BlockCache::instance()->read(_block_cache_key, _file_length, offset, *res, read_fn, &hit_bytes);
+    _block_cache_hit_bytes += hit_bytes;
+    return st;
+}
+
+Status HdfsRandomAccessFile::_read_at_fully(uint64_t offset, const Slice& res) const {
     Slice slice = res;
-    RETURN_IF_ERROR(read_at_internal(_fs, _file, _filename, offset, &slice, _usePread));
+    RETURN_IF_ERROR(_read_at_internal(offset, &slice));
     if (slice.size != res.size) {
         return Status::InternalError(
                 strings::Substitute("fail to read enough data, file=$0, offset=$1, size=$2, expect=$3", _filename,
@@ -92,6 +159,28 @@ Status HdfsRandomAccessFile::read_at(uint64_t offset, const Slice& res) const {
     return Status::OK();
 }
 
+Status HdfsRandomAccessFile::read(uint64_t offset, Slice* res) const {
+    DCHECK(_opened);
+    ASSIGN_OR_RETURN(bool buffered, _read_buffer.read(offset, *res));
+    if (!buffered) {
+        RETURN_IF_ERROR(_read_at_internal(offset, res));
+    }
+    return Status::OK();
+}
+
+Status HdfsRandomAccessFile::read_at(uint64_t offset, const Slice& res) const {
+    DCHECK(_opened);
+    ASSIGN_OR_RETURN(bool buffered, _read_buffer.read(offset, res));
+    if (!buffered) {
+        RETURN_IF_ERROR(_read_at_fully(offset, res));
+    }
+    return Status::OK();
+}
+
+void HdfsRandomAccessFile::set_io_ranges(const std::vector<IORange>& ranges) {
+    _read_buffer.set_io_ranges(ranges);
+}
+
 Status HdfsRandomAccessFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
     // TODO: implement
     return Status::InternalError("HdfsRandomAccessFile::readv_at not implement");
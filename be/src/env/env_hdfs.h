@@ -4,6 +4,10 @@
 
 #include <hdfs/hdfs.h>
 
+#include <atomic>
+#include <utility>
+
+#include "env/coalesced_read_buffer.h"
 #include "env/env.h"
 
 namespace starrocks {
@@ -21,17 +25,49 @@ public:
     Status read_at(uint64_t offset, const Slice& res) const override;
     Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
 
+    void set_io_ranges(const std::vector<IORange>& ranges) override;
+
     Status size(uint64_t* size) const override;
     const std::string& file_name() const override { return _filename; }
 
     hdfsFile hdfs_file() const { return _file; }
 
+    // Reads the file through the block cache, `file_length` is a part of the key of the file in the cache.
+    void enable_block_cache(uint64_t file_length);
+    // Serves the reads of the last bytes of the file, e.g. the footers, from the FileTailCache.
+    void enable_tail_cache(uint64_t file_length);
+    // Returns and clears the bytes read from the block cache.
+    int64_t pop_block_cache_hit_bytes() { return _block_cache_hit_bytes.exchange(0); }
+    // Returns and clears the bytes read from the FileTailCache.
+    int64_t pop_tail_cache_hit_bytes() { return _tail_cache_hit_bytes.exchange(0); }
+    // Returns and clears the reads served by the coalesced reads and the IO requests of them.
+    void pop_coalesced_read_counts(int64_t* served_reads, int64_t* issued_reads) {
+        _read_buffer.pop_io_counts(served_reads, issued_reads);
+    }
+
 private:
+    Status _read_at_internal(uint64_t offset, Slice* res) const;
+    Status _read_at_storage(uint64_t offset, Slice* res) const;
+    Status _read_tail(uint64_t offset, Slice* res) const;
+    Status _read_at_fully(uint64_t offset, const Slice& res) const;
+
     bool _opened;
     hdfsFS _fs;
     hdfsFile _file;
     std::string _filename;
     bool _usePread;
+
+    // empty means no block cache
+    std::string _block_cache_key;
+    // empty means no tail cache
+    std::string _tail_cache_key;
+    uint64_t _file_length = 0;
+    // the reads may be issued by the IO threads of _read_buffer
+    mutable std::atomic<int64_t> _block_cache_hit_bytes = 0;
+    mutable std::atomic<int64_t> _tail_cache_hit_bytes = 0;
+
+    // serves the reads of the ranges hinted by set_io_ranges(), read in parallel if pread is used
+    mutable CoalescedReadBuffer _read_buffer;
 };
 
 } // namespace starrocks
@@ -16,10 +16,16 @@
 #include <unistd.h>
 
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <vector>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/io_uring.h"
 #include "gutil/gscoped_ptr.h"
 #include "gutil/macros.h"
 #include "gutil/port.h"
@@ -68,6 +74,21 @@ static Status do_sync(int fd, const string& filename) {
     return Status::OK();
 }
 
+static Status do_pre_allocate(int fd, const string& filename, uint64_t offset, uint64_t size) {
+    int ret;
+    RETRY_ON_EINTR(ret, fallocate(fd, 0, offset, size));
+    if (ret != 0) {
+        if (errno == EOPNOTSUPP) {
+            LOG(WARNING) << "The filesystem does not support fallocate().";
+        } else if (errno == ENOSYS) {
+            LOG(WARNING) << "The kernel does not implement fallocate().";
+        } else {
+            return io_error(filename, errno);
+        }
+    }
+    return Status::OK();
+}
+
 static Status do_open(const string& filename, Env::OpenMode mode, int* fd) {
     int flags = O_RDWR;
     switch (mode) {
@@ -277,6 +298,36 @@ public:
     Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
         return do_readv_at(_fd, _filename, offset, res, res_cnt, nullptr);
     }
+
+    Status read_ranges_at(const uint64_t* offsets, const Slice* results, size_t n) const override {
+        IoUring* ring = (config::enable_io_uring && n > 1) ? IoUring::thread_local_instance() : nullptr;
+        std::vector<int64_t> read_bytes;
+        if (ring != nullptr) {
+            read_bytes.resize(n);
+            if (!ring->read_ranges(_fd, offsets, results, n, read_bytes.data()).ok()) {
+                read_bytes.clear();
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            // The ranges read short or failed by io_uring are finished by pread, which reports the errors.
+            const size_t done = read_bytes.empty() ? 0 : std::max<int64_t>(read_bytes[i], 0);
+            if (done < results[i].size) {
+                Slice rest(results[i].data + done, results[i].size - done);
+                RETURN_IF_ERROR(do_readv_at(_fd, _filename, offsets[i] + done, &rest, 1, nullptr));
+            }
+        }
+        return Status::OK();
+    }
+
+    Status readahead(uint64_t offset, size_t size) const override {
+        // Starts the kernel readahead of the range into the OS page cache, without blocking.
+        int res = posix_fadvise(_fd, offset, size, POSIX_FADV_WILLNEED);
+        if (res != 0) {
+            return io_error(_filename, res);
+        }
+        return Status::OK();
+    }
+
     Status size(uint64_t* size) const override {
         struct stat st;
         auto res = fstat(_fd, &st);
@@ -312,17 +363,7 @@ public:
 
     Status pre_allocate(uint64_t size) override {
         uint64_t offset = std::max(_filesize, _pre_allocated_size);
-        int ret;
-        RETRY_ON_EINTR(ret, fallocate(_fd, 0, offset, size));
-        if (ret != 0) {
-            if (errno == EOPNOTSUPP) {
-                LOG(WARNING) << "The filesystem does not support fallocate().";
-            } else if (errno == ENOSYS) {
-                LOG(WARNING) << "The kernel does not implement fallocate().";
-            } else {
-                return io_error(_filename, errno);
-            }
-        }
+        RETURN_IF_ERROR(do_pre_allocate(_fd, _filename, offset, size));
         _pre_allocated_size = offset + size;
         return Status::OK();
     }
@@ -405,6 +446,200 @@ private:
     uint64_t _pre_allocated_size = 0;
 };
 
+// The offsets, the lengths and the buffers of the O_DIRECT writes are aligned to it.
+static constexpr size_t kDirectIOAlignment = 4096;
+
+// The aligned buffers of the O_DIRECT files. A flush or a compaction writes files one after another,
+// so the buffers are kept for the next files instead of being freed.
+class DirectIOBufferPool {
+public:
+    static DirectIOBufferPool* instance() {
+        static DirectIOBufferPool pool;
+        return &pool;
+    }
+
+    // Returns a buffer of |size| bytes aligned to kDirectIOAlignment, or nullptr if out of memory.
+    char* acquire(size_t size) {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            while (!_buffers.empty()) {
+                auto [buffer, buffer_size] = _buffers.back();
+                _buffers.pop_back();
+                if (buffer_size == size) {
+                    return buffer;
+                }
+                // The size of the buffers is changed by the config.
+                free(buffer);
+            }
+        }
+        void* buffer = nullptr;
+        if (posix_memalign(&buffer, kDirectIOAlignment, size) != 0) {
+            return nullptr;
+        }
+        return static_cast<char*>(buffer);
+    }
+
+    void release(char* buffer, size_t size) {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (_buffers.size() < kMaxFreeBuffers) {
+                _buffers.emplace_back(buffer, size);
+                return;
+            }
+        }
+        free(buffer);
+    }
+
+private:
+    static constexpr size_t kMaxFreeBuffers = 64;
+
+    std::mutex _mutex;
+    std::vector<std::pair<char*, size_t>> _buffers;
+};
+
+// A WritableFile opened with O_DIRECT, so the written data doesn't go through the page cache.
+// The appends are copied into an aligned buffer, which is written when it's full, so the small
+// appends of the pages become large sequential writes. The unaligned tail is written padded with
+// zeros by sync() and close(), and kept in the buffer to be written again with the following
+// appends. close() truncates the padding.
+class PosixDirectWritableFile : public WritableFile {
+public:
+    PosixDirectWritableFile(std::string filename, int fd, uint64_t filesize, bool sync_on_close, char* buffer,
+                            size_t capacity)
+            : _filename(std::move(filename)),
+              _fd(fd),
+              _sync_on_close(sync_on_close),
+              _filesize(filesize),
+              _buffer(buffer),
+              _capacity(capacity),
+              _buffer_offset(filesize),
+              _file_end(filesize) {}
+
+    ~PosixDirectWritableFile() override { WARN_IF_ERROR(close(), "Failed to close file, file=" + _filename); }
+
+    Status append(const Slice& data) override { return appendv(&data, 1); }
+
+    Status appendv(const Slice* data, size_t cnt) override {
+        for (size_t i = 0; i < cnt; i++) {
+            const char* src = data[i].data;
+            size_t rem = data[i].size;
+            while (rem > 0) {
+                size_t n = std::min(rem, _capacity - _buffer_size);
+                memcpy(_buffer + _buffer_size, src, n);
+                _buffer_size += n;
+                src += n;
+                rem -= n;
+                if (_buffer_size == _capacity) {
+                    RETURN_IF_ERROR(_write_buffer(false));
+                }
+            }
+            _filesize += data[i].size;
+        }
+        return Status::OK();
+    }
+
+    Status pre_allocate(uint64_t size) override {
+        uint64_t offset = std::max(_filesize, _pre_allocated_size);
+        RETURN_IF_ERROR(do_pre_allocate(_fd, _filename, offset, size));
+        _pre_allocated_size = offset + size;
+        return Status::OK();
+    }
+
+    Status close() override {
+        if (_closed) {
+            return Status::OK();
+        }
+        Status s = _write_buffer(true);
+
+        // Truncate the padding of the tail and the space allocated more than used.
+        if (s.ok() && std::max(_file_end, _pre_allocated_size) > _filesize) {
+            int ret;
+            RETRY_ON_EINTR(ret, ftruncate(_fd, _filesize));
+            if (ret != 0) {
+                s = io_error(_filename, errno);
+            }
+            _pending_sync = true;
+        }
+
+        if (s.ok() && _sync_on_close) {
+            s = sync();
+            if (!s.ok()) {
+                LOG(ERROR) << "Unable to Sync " << _filename << ": " << s.to_string();
+            }
+        }
+
+        int ret;
+        RETRY_ON_EINTR(ret, ::close(_fd));
+        if (ret < 0) {
+            if (s.ok()) {
+                s = io_error(_filename, errno);
+            }
+        }
+        DirectIOBufferPool::instance()->release(_buffer, _capacity);
+        _buffer = nullptr;
+
+        _closed = true;
+        return s;
+    }
+
+    // The written data is already on the device, only the buffer is left to write.
+    Status flush(FlushMode mode) override { return _write_buffer(mode == FLUSH_SYNC); }
+
+    // The written data needs no sync, but the size of the file does.
+    Status sync() override {
+        RETURN_IF_ERROR(_write_buffer(true));
+        if (_pending_sync) {
+            _pending_sync = false;
+            RETURN_IF_ERROR(do_sync(_fd, _filename));
+        }
+        return Status::OK();
+    }
+
+    uint64_t size() const override { return _filesize; }
+    const string& filename() const override { return _filename; }
+
+private:
+    // Writes the aligned blocks of the buffer, and with |pad_tail| the unaligned tail too.
+    Status _write_buffer(bool pad_tail) {
+        size_t aligned_size = _buffer_size & ~(kDirectIOAlignment - 1);
+        size_t write_size = aligned_size;
+        if (pad_tail && aligned_size < _buffer_size) {
+            write_size = aligned_size + kDirectIOAlignment;
+            memset(_buffer + _buffer_size, 0, write_size - _buffer_size);
+        }
+        if (write_size == 0) {
+            return Status::OK();
+        }
+        Slice data(_buffer, write_size);
+        size_t bytes_written = 0;
+        RETURN_IF_ERROR(do_writev_at(_fd, _filename, _buffer_offset, &data, 1, &bytes_written));
+        _file_end = std::max(_file_end, _buffer_offset + write_size);
+        _pending_sync = true;
+
+        // The tail is written again at the same offset with the following appends.
+        memmove(_buffer, _buffer + aligned_size, _buffer_size - aligned_size);
+        _buffer_offset += aligned_size;
+        _buffer_size -= aligned_size;
+        return Status::OK();
+    }
+
+    std::string _filename;
+    int _fd;
+    const bool _sync_on_close = false;
+    bool _pending_sync = false;
+    bool _closed = false;
+    uint64_t _filesize = 0;
+    uint64_t _pre_allocated_size = 0;
+
+    char* _buffer;
+    const size_t _capacity;
+    size_t _buffer_size = 0;
+    // The offset of the file the buffer starts at, always aligned.
+    uint64_t _buffer_offset;
+    // The end of the data written to the file, including the padding.
+    uint64_t _file_end;
+};
+
 class PosixRandomRWFile : public RandomRWFile {
 public:
     PosixRandomRWFile(string fname, int fd, bool sync_on_close)
@@ -531,6 +766,9 @@ public:
         if (opts.mode == MUST_EXIST) {
             RETURN_IF_ERROR(get_file_size(fname, &file_size));
         }
+        if (opts.direct_io && _new_direct_writable_file(opts, fname, fd, file_size, result)) {
+            return Status::OK();
+        }
         *result = std::make_unique<PosixWritableFile>(fname, fd, file_size, opts.sync_on_close);
         return Status::OK();
     }
@@ -692,6 +930,36 @@ public:
         }
         return Status::OK();
     }
+
+private:
+    // Turns on O_DIRECT of |fd|. Returns false if the file system doesn't support it, or the existing
+    // data of the file isn't aligned, and the file is written through the page cache then.
+    static bool _new_direct_writable_file(const WritableFileOptions& opts, const string& fname, int fd,
+                                          uint64_t file_size, std::unique_ptr<WritableFile>* result) {
+#ifdef O_DIRECT
+        if (file_size % kDirectIOAlignment != 0) {
+            return false;
+        }
+        size_t capacity = std::max<int64_t>(config::direct_io_write_buffer_size, kDirectIOAlignment);
+        capacity = (capacity + kDirectIOAlignment - 1) & ~(kDirectIOAlignment - 1);
+        char* buffer = DirectIOBufferPool::instance()->acquire(capacity);
+        if (buffer == nullptr) {
+            return false;
+        }
+        int flags = fcntl(fd, F_GETFL);
+        if (flags < 0 || fcntl(fd, F_SETFL, flags | O_DIRECT) != 0) {
+            LOG_FIRST_N(INFO, 1) << "O_DIRECT is not supported, write through the page cache, file=" << fname
+                                 << ": " << std::strerror(errno);
+            DirectIOBufferPool::instance()->release(buffer, capacity);
+            return false;
+        }
+        *result = std::make_unique<PosixDirectWritableFile>(fname, fd, file_size, opts.sync_on_close, buffer,
+                                                            capacity);
+        return true;
+#else
+        return false;
+#endif
+    }
 };
 
 // Default Posix Env
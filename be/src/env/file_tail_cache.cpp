@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "env/file_tail_cache.h"
+
+#include "runtime/current_thread.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+FileTailCache* FileTailCache::_s_instance = nullptr;
+
+void FileTailCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr) {
+        _s_instance = new FileTailCache(mem_tracker, capacity);
+    }
+}
+
+void FileTailCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+FileTailCache::FileTailCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+
+bool FileTailCache::lookup(const std::string& file_key, std::string* tail) {
+    auto* handle = _cache->lookup(CacheKey(file_key));
+    if (handle == nullptr) {
+        return false;
+    }
+    *tail = *reinterpret_cast<std::string*>(_cache->value(handle));
+    _cache->release(handle);
+    return true;
+}
+
+void FileTailCache::insert(const std::string& file_key, const std::string& tail) {
+    // the entries are allocated and freed, maybe by the eviction of another insertion, under the tracker of the cache
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+
+    auto* value = new std::string(tail);
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<std::string*>(value); };
+    size_t charge = file_key.size() + value->capacity() + sizeof(std::string);
+    _cache->release(_cache->insert(CacheKey(file_key), value, charge, deleter));
+}
+
+} // namespace starrocks
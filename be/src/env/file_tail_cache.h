@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class MemTracker;
+
+// FileTailCache keeps the last bytes of the files of the external tables read last, which hold the footers
+// and the metadata of the Parquet and ORC files, so that the scans of another query opening the same file
+// don't wait for the round trips to the remote storage to read them again. The key of a file must change
+// when the file content changes.
+class FileTailCache {
+public:
+    // Create the global instance, a cache of |capacity| bytes charged to |mem_tracker|.
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Returns nullptr if the cache isn't created, i.e. it's disabled.
+    static FileTailCache* instance() { return _s_instance; }
+
+    FileTailCache(MemTracker* mem_tracker, size_t capacity);
+
+    // Returns true and sets |tail| to the cached last bytes of the file |file_key| if they're cached.
+    bool lookup(const std::string& file_key, std::string* tail);
+
+    // Caches |tail| as the last bytes of the file |file_key|, replacing the tail cached before.
+    void insert(const std::string& file_key, const std::string& tail);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+private:
+    static FileTailCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks
@@ -0,0 +1,209 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "env/io_uring.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "common/logging.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define STARROCKS_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace starrocks {
+
+#ifdef STARROCKS_HAVE_IO_URING
+
+static constexpr uint32_t kIoUringEntries = 64;
+
+static int io_uring_setup(uint32_t entries, struct io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int ring_fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+template <typename T>
+static T* ring_field(void* ring, uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+IoUring::~IoUring() {
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+        munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        close(_ring_fd);
+    }
+}
+
+IoUring* IoUring::thread_local_instance() {
+    // The failure to set up is kept too, so it's tried once per thread.
+    thread_local std::unique_ptr<IoUring> ring = []() -> std::unique_ptr<IoUring> {
+        std::unique_ptr<IoUring> ring(new IoUring());
+        Status st = ring->_init(kIoUringEntries);
+        if (!st.ok()) {
+            LOG_FIRST_N(INFO, 1) << "io_uring is not available, use the POSIX reads: " << st;
+            return nullptr;
+        }
+        return ring;
+    }();
+    return ring.get();
+}
+
+Status IoUring::_init(uint32_t entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    _ring_fd = io_uring_setup(entries, &params);
+    if (_ring_fd < 0) {
+        return Status::NotSupported(fmt::format("io_uring_setup: {}", std::strerror(errno)));
+    }
+    _sq_entries = params.sq_entries;
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    // The kernels since 5.4 map both rings at once.
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        _sq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+        _cq_ring_size = _sq_ring_size;
+    }
+    _sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                    IORING_OFF_SQ_RING);
+    if (_sq_ring == MAP_FAILED) {
+        _sq_ring = nullptr;
+        return Status::IOError(fmt::format("mmap io_uring sq ring: {}", std::strerror(errno)));
+    }
+    if (single_mmap) {
+        _cq_ring = _sq_ring;
+    } else {
+        _cq_ring = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                        IORING_OFF_CQ_RING);
+        if (_cq_ring == MAP_FAILED) {
+            _cq_ring = nullptr;
+            return Status::IOError(fmt::format("mmap io_uring cq ring: {}", std::strerror(errno)));
+        }
+    }
+    _sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    _sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES);
+    if (_sqes == MAP_FAILED) {
+        _sqes = nullptr;
+        return Status::IOError(fmt::format("mmap io_uring sqes: {}", std::strerror(errno)));
+    }
+
+    _sq_tail = ring_field<uint32_t>(_sq_ring, params.sq_off.tail);
+    _sq_mask = ring_field<uint32_t>(_sq_ring, params.sq_off.ring_mask);
+    _sq_array = ring_field<uint32_t>(_sq_ring, params.sq_off.array);
+    _cq_head = ring_field<uint32_t>(_cq_ring, params.cq_off.head);
+    _cq_tail = ring_field<uint32_t>(_cq_ring, params.cq_off.tail);
+    _cq_mask = ring_field<uint32_t>(_cq_ring, params.cq_off.ring_mask);
+    _cqes = ring_field<void>(_cq_ring, params.cq_off.cqes);
+    return Status::OK();
+}
+
+Status IoUring::read_ranges(int fd, const uint64_t* offsets, const Slice* results, size_t n, int64_t* read_bytes) {
+    if (_broken) {
+        return Status::NotSupported("io_uring failed before");
+    }
+    auto* sqes = static_cast<struct io_uring_sqe*>(_sqes);
+    // At most one ring of reads is in flight, the ranges beyond it go in the next rounds.
+    for (size_t begin = 0; begin < n; begin += _sq_entries) {
+        const size_t num = std::min<size_t>(n - begin, _sq_entries);
+        // This thread is the only producer, the kernel reads the tail after the release store.
+        uint32_t tail = *_sq_tail;
+        const uint32_t mask = *_sq_mask;
+        for (size_t i = begin; i < begin + num; ++i) {
+            const uint32_t index = tail & mask;
+            struct io_uring_sqe* sqe = &sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = fd;
+            sqe->addr = reinterpret_cast<uint64_t>(results[i].data);
+            sqe->len = static_cast<uint32_t>(results[i].size);
+            sqe->off = offsets[i];
+            sqe->user_data = i;
+            _sq_array[index] = index;
+            tail++;
+        }
+        __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+
+        size_t submitted = 0;
+        while (submitted < num) {
+            int ret = io_uring_enter(_ring_fd, num - submitted, 0, 0);
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN) {
+                    continue;
+                }
+                // The entries not submitted are left in the ring, so it's not used any more.
+                _broken = true;
+                return Status::IOError(fmt::format("io_uring_enter: {}", std::strerror(errno)));
+            }
+            submitted += ret;
+        }
+        RETURN_IF_ERROR(_reap(num, read_bytes));
+    }
+    return Status::OK();
+}
+
+Status IoUring::_reap(size_t num_submitted, int64_t* read_bytes) {
+    auto* cqes = static_cast<struct io_uring_cqe*>(_cqes);
+    size_t completed = 0;
+    while (completed < num_submitted) {
+        uint32_t head = *_cq_head;
+        const uint32_t tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            int ret = io_uring_enter(_ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+            if (ret < 0 && errno != EINTR && errno != EAGAIN) {
+                _broken = true;
+                return Status::IOError(fmt::format("io_uring_enter: {}", std::strerror(errno)));
+            }
+            continue;
+        }
+        const uint32_t mask = *_cq_mask;
+        for (; head != tail; ++head, ++completed) {
+            const struct io_uring_cqe& cqe = cqes[head & mask];
+            read_bytes[cqe.user_data] = cqe.res;
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+    }
+    return Status::OK();
+}
+
+#else
+
+IoUring::~IoUring() = default;
+
+IoUring* IoUring::thread_local_instance() {
+    return nullptr;
+}
+
+Status IoUring::read_ranges(int fd, const uint64_t* offsets, const Slice* results, size_t n, int64_t* read_bytes) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+Status IoUring::_init(uint32_t entries) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+Status IoUring::_reap(size_t num_submitted, int64_t* read_bytes) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+#endif
+
+} // namespace starrocks
@@ -0,0 +1,62 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// A minimal io_uring owned by one thread, used to submit a batch of reads with a single system call
+// and wait for all of them, instead of blocking on one pread after another.
+// It is set up with the raw system calls, so it needs no library. The kernels without io_uring, or the
+// sandboxes forbidding it, get no instance, and the callers fall back to the POSIX reads.
+class IoUring {
+public:
+    ~IoUring();
+
+    // Returns the io_uring of the calling thread, created at the first call, or nullptr if io_uring
+    // can't be set up.
+    static IoUring* thread_local_instance();
+
+    // Reads the |n| ranges of |fd| into |results|, results[i].size bytes at offsets[i].
+    // read_bytes[i] is the number of bytes read for the i-th range, or -errno if it failed. A range
+    // may be read short, the caller reads the rest. Returns an error if the ring failed, the caller
+    // reads all the ranges by itself then.
+    Status read_ranges(int fd, const uint64_t* offsets, const Slice* results, size_t n, int64_t* read_bytes);
+
+private:
+    IoUring() = default;
+
+    Status _init(uint32_t entries);
+    // Waits for the completions of all the submitted reads.
+    Status _reap(size_t num_submitted, int64_t* read_bytes);
+
+    int _ring_fd = -1;
+    // Set once a system call on the ring fails, the reads left in the ring make it unusable.
+    bool _broken = false;
+    uint32_t _sq_entries = 0;
+
+    void* _sq_ring = nullptr;
+    size_t _sq_ring_size = 0;
+    void* _cq_ring = nullptr;
+    size_t _cq_ring_size = 0;
+    void* _sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    uint32_t* _sq_tail = nullptr;
+    uint32_t* _sq_mask = nullptr;
+    uint32_t* _sq_array = nullptr;
+    uint32_t* _cq_head = nullptr;
+    uint32_t* _cq_tail = nullptr;
+    uint32_t* _cq_mask = nullptr;
+    void* _cqes = nullptr;
+
+    DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+} // namespace starrocks
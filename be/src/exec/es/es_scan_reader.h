@@ -43,6 +43,9 @@ public:
     static constexpr const char* KEY_BATCH_SIZE = "batch_size";
     static constexpr const char* KEY_TERMINATE_AFTER = "limit";
     static constexpr const char* KEY_DOC_VALUES_MODE = "doc_values_mode";
+    // the slice of the shard read by this reader, in the sliced scroll
+    static constexpr const char* KEY_SLICE_ID = "slice_id";
+    static constexpr const char* KEY_SLICE_MAX = "slice_max";
     ESScanReader(const std::string& target, const std::map<std::string, std::string>& props, bool doc_value_mode);
     ~ESScanReader();
 
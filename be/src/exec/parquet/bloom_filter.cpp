@@ -0,0 +1,132 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/parquet/bloom_filter.h"
+
+#include <algorithm>
+
+#include "env/env.h"
+#include "gen_cpp/parquet_types.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::parquet {
+
+// the header is a few bytes only, it's read in one go with this buffer
+static constexpr uint32_t kHeaderBufSize = 256;
+static constexpr uint32_t kMaxBloomFilterSize = 128 * 1024 * 1024;
+
+static constexpr uint32_t kSalt[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+static constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+    acc += input * kPrime64_2;
+    acc = rotl64(acc, 31);
+    return acc * kPrime64_1;
+}
+
+static inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t val) {
+    acc ^= xxh64_round(0, val);
+    return acc * kPrime64_1 + kPrime64_4;
+}
+
+uint64_t SplitBlockBloomFilter::hash(const void* data, size_t size) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    const uint8_t* end = p + size;
+    uint64_t h64;
+    if (size >= 32) {
+        uint64_t v1 = kPrime64_1 + kPrime64_2;
+        uint64_t v2 = kPrime64_2;
+        uint64_t v3 = 0;
+        uint64_t v4 = -kPrime64_1;
+        do {
+            v1 = xxh64_round(v1, decode_fixed64_le(p));
+            v2 = xxh64_round(v2, decode_fixed64_le(p + 8));
+            v3 = xxh64_round(v3, decode_fixed64_le(p + 16));
+            v4 = xxh64_round(v4, decode_fixed64_le(p + 24));
+            p += 32;
+        } while (p + 32 <= end);
+        h64 = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h64 = xxh64_merge_round(h64, v1);
+        h64 = xxh64_merge_round(h64, v2);
+        h64 = xxh64_merge_round(h64, v3);
+        h64 = xxh64_merge_round(h64, v4);
+    } else {
+        h64 = kPrime64_5;
+    }
+    h64 += size;
+
+    for (; p + 8 <= end; p += 8) {
+        h64 ^= xxh64_round(0, decode_fixed64_le(p));
+        h64 = rotl64(h64, 27) * kPrime64_1 + kPrime64_4;
+    }
+    if (p + 4 <= end) {
+        h64 ^= static_cast<uint64_t>(decode_fixed32_le(p)) * kPrime64_1;
+        h64 = rotl64(h64, 23) * kPrime64_2 + kPrime64_3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h64 ^= static_cast<uint64_t>(*p) * kPrime64_5;
+        h64 = rotl64(h64, 11) * kPrime64_1;
+    }
+
+    h64 ^= h64 >> 33;
+    h64 *= kPrime64_2;
+    h64 ^= h64 >> 29;
+    h64 *= kPrime64_3;
+    h64 ^= h64 >> 32;
+    return h64;
+}
+
+bool SplitBlockBloomFilter::test_hash(uint64_t hash) const {
+    const uint64_t block_index = ((hash >> 32) * _num_blocks()) >> 32;
+    const uint32_t key = static_cast<uint32_t>(hash);
+    const uint32_t* block = &_bitset[block_index * kWordsPerBlock];
+    for (size_t i = 0; i < kWordsPerBlock; i++) {
+        uint32_t mask = 1U << ((key * kSalt[i]) >> 27);
+        if ((block[i] & mask) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status SplitBlockBloomFilter::read(RandomAccessFile* file, uint64_t file_size, int64_t offset,
+                                   std::unique_ptr<SplitBlockBloomFilter>* filter) {
+    if (offset < 0 || static_cast<uint64_t>(offset) >= file_size) {
+        return Status::Corruption(strings::Substitute("Invalid bloom filter offset $0 of $1", offset, file->file_name()));
+    }
+    uint8_t header_buf[kHeaderBufSize];
+    uint32_t header_length = std::min<uint64_t>(kHeaderBufSize, file_size - offset);
+    RETURN_IF_ERROR(file->read_at(offset, Slice(header_buf, header_length)));
+
+    tparquet::BloomFilterHeader header;
+    RETURN_IF_ERROR(deserialize_thrift_msg(header_buf, &header_length, TProtocolType::COMPACT, &header));
+    if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+        !header.compression.__isset.UNCOMPRESSED) {
+        return Status::NotSupported("Unsupported bloom filter of parquet");
+    }
+    if (header.numBytes <= 0 || header.numBytes > kMaxBloomFilterSize || header.numBytes % kBytesPerBlock != 0 ||
+        offset + header_length + header.numBytes > file_size) {
+        return Status::Corruption(
+                strings::Substitute("Invalid bloom filter size $0 of $1", header.numBytes, file->file_name()));
+    }
+
+    std::unique_ptr<SplitBlockBloomFilter> result(new SplitBlockBloomFilter(header.numBytes));
+    RETURN_IF_ERROR(file->read_at(offset + header_length,
+                                  Slice(reinterpret_cast<uint8_t*>(result->_bitset.data()), header.numBytes)));
+    *filter = std::move(result);
+    return Status::OK();
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,40 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/status.h"
+
+namespace starrocks {
+class RandomAccessFile;
+}
+
+namespace starrocks::parquet {
+
+// The split block bloom filter of a column chunk, see BloomFilter.md of the parquet format.
+// The values are hashed by XXH64 with seed 0 over their plain encoding, without the length of BYTE_ARRAY.
+class SplitBlockBloomFilter {
+public:
+    // Reads the bloom filter at |offset|, |file_size| bounds the read of the header.
+    static Status read(RandomAccessFile* file, uint64_t file_size, int64_t offset,
+                       std::unique_ptr<SplitBlockBloomFilter>* filter);
+
+    static uint64_t hash(const void* data, size_t size);
+
+    bool test_hash(uint64_t hash) const;
+
+private:
+    static constexpr size_t kBytesPerBlock = 32;
+    static constexpr size_t kWordsPerBlock = 8;
+
+    explicit SplitBlockBloomFilter(size_t num_bytes) : _bitset(num_bytes / sizeof(uint32_t)) {}
+
+    size_t _num_blocks() const { return _bitset.size() / kWordsPerBlock; }
+
+    std::vector<uint32_t> _bitset;
+};
+
+} // namespace starrocks::parquet
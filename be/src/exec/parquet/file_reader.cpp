@@ -4,9 +4,12 @@
 
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <algorithm>
+
 #include "column/column_helper.h"
 #include "env/env.h"
 #include "exec/exec_node.h"
+#include "exec/parquet/bloom_filter.h"
 #include "exec/parquet/encoding_plain.h"
 #include "exec/parquet/metadata.h"
 #include "exprs/expr.h"
@@ -44,6 +47,8 @@ Status FileReader::init(const starrocks::vectorized::HdfsFileReaderParam& param)
         }
     }
 
+    _init_bloom_filter_preds();
+
     // create and init row group reader
     RETURN_IF_ERROR(_init_group_reader());
 
@@ -194,6 +199,15 @@ void FileReader::_filter_file() {
 }
 
 Status FileReader::_filter_group(const tparquet::RowGroup& row_group, bool* is_filter) {
+    RETURN_IF_ERROR(_filter_group_by_min_max(row_group, is_filter));
+    if (!*is_filter && !_bloom_filter_preds.empty()) {
+        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+        _filter_group_by_bloom_filter(row_group, is_filter);
+    }
+    return Status::OK();
+}
+
+Status FileReader::_filter_group_by_min_max(const tparquet::RowGroup& row_group, bool* is_filter) {
     if (!_param.min_max_conjunct_ctxs.empty()) {
         auto min_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, 0);
         auto max_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, 0);
@@ -223,6 +237,93 @@ Status FileReader::_filter_group(const tparquet::RowGroup& row_group, bool* is_f
     return Status::OK();
 }
 
+void FileReader::_init_bloom_filter_preds() {
+    for (const auto& column : _param.materialized_columns) {
+        auto iter = _param.conjunct_ctxs_by_slot.find(column.slot_id);
+        if (iter == _param.conjunct_ctxs_by_slot.end()) {
+            continue;
+        }
+        // the types hashed by the plain encoding of their values
+        tparquet::Type::type physical_type;
+        PrimitiveType type = column.col_type.type;
+        if (type == TYPE_INT) {
+            physical_type = tparquet::Type::INT32;
+        } else if (type == TYPE_BIGINT) {
+            physical_type = tparquet::Type::INT64;
+        } else if (type == TYPE_VARCHAR) {
+            physical_type = tparquet::Type::BYTE_ARRAY;
+        } else {
+            continue;
+        }
+
+        for (ExprContext* ctx : iter->second) {
+            const Expr* root = ctx->root();
+            bool is_eq = root->node_type() == TExprNodeType::BINARY_PRED && root->op() == TExprOpcode::EQ;
+            bool is_in = root->node_type() == TExprNodeType::IN_PRED && root->op() == TExprOpcode::FILTER_IN;
+            if ((!is_eq && !is_in) || root->get_num_children() < 2 || !root->get_child(0)->is_slotref() ||
+                root->get_child(0)->type().type != type) {
+                continue;
+            }
+
+            BloomFilterPredicate pred{column.col_name, physical_type, {}};
+            bool all_literals = true;
+            for (int i = 1; i < root->get_num_children() && all_literals; i++) {
+                Expr* child = root->get_child(i);
+                if (!child->is_constant() || child->type().type != type) {
+                    all_literals = false;
+                    break;
+                }
+                ColumnPtr value_column = ctx->evaluate(child, nullptr);
+                if (value_column == nullptr || value_column->size() == 0) {
+                    all_literals = false;
+                    break;
+                }
+                auto value = value_column->get(0);
+                if (value.is_null()) {
+                    // null equals nothing
+                    continue;
+                }
+                if (type == TYPE_INT) {
+                    int32_t v = value.get_int32();
+                    pred.hashes.emplace_back(SplitBlockBloomFilter::hash(&v, sizeof(v)));
+                } else if (type == TYPE_BIGINT) {
+                    int64_t v = value.get_int64();
+                    pred.hashes.emplace_back(SplitBlockBloomFilter::hash(&v, sizeof(v)));
+                } else {
+                    const Slice& v = value.get_slice();
+                    pred.hashes.emplace_back(SplitBlockBloomFilter::hash(v.data, v.size));
+                }
+            }
+            if (all_literals && !pred.hashes.empty()) {
+                _bloom_filter_preds.emplace_back(std::move(pred));
+            }
+        }
+    }
+}
+
+void FileReader::_filter_group_by_bloom_filter(const tparquet::RowGroup& row_group, bool* is_filter) {
+    for (const auto& pred : _bloom_filter_preds) {
+        const auto* column_meta = _get_column_meta(row_group, pred.col_name);
+        if (column_meta == nullptr || !column_meta->__isset.bloom_filter_offset ||
+            column_meta->type != pred.physical_type) {
+            continue;
+        }
+        std::unique_ptr<SplitBlockBloomFilter> bloom_filter;
+        Status st = SplitBlockBloomFilter::read(_file, _file_size, column_meta->bloom_filter_offset, &bloom_filter);
+        if (!st.ok()) {
+            // the bloom filter is an optimization only
+            VLOG_FILE << "failed to read bloom filter of column " << pred.col_name << ": " << st.to_string();
+            continue;
+        }
+        bool found = std::any_of(pred.hashes.begin(), pred.hashes.end(),
+                                 [&](uint64_t hash) { return bloom_filter->test_hash(hash); });
+        if (!found) {
+            *is_filter = true;
+            return;
+        }
+    }
+}
+
 Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vectorized::ChunkPtr* min_chunk,
                                        vectorized::ChunkPtr* max_chunk, bool* exist) const {
     for (size_t i = 0; i < _param.min_max_tuple_desc->slots().size(); i++) {
@@ -406,7 +507,7 @@ Status FileReader::_init_group_reader() {
             bool is_filter = false;
             RETURN_IF_ERROR(_filter_group(_file_metadata->t_metadata().row_groups[i], &is_filter));
             if (is_filter) {
-                LOG(INFO) << "row group " << i << " of file has been filtered by min/max conjunct";
+                LOG(INFO) << "row group " << i << " of file has been filtered by min/max conjunct or bloom filter";
                 continue;
             }
 
@@ -429,6 +530,13 @@ Status FileReader::_get_next_internal(vectorized::ChunkPtr* chunk) {
     }
 
     if (_cur_row_group_idx < _row_group_size) {
+        if (_io_ranges_row_group_idx != _cur_row_group_idx) {
+            // the column chunks of the row group are read with as few IO requests as possible
+            std::vector<IORange> ranges;
+            _row_group_readers[_cur_row_group_idx]->collect_io_ranges(&ranges);
+            _file->set_io_ranges(ranges);
+            _io_ranges_row_group_idx = _cur_row_group_idx;
+        }
         size_t row_count = _chunk_size;
         Status status = _row_group_readers[_cur_row_group_idx]->get_next(chunk, &row_count);
         if (status.ok() || status.is_end_of_file()) {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 
 #include "column/chunk.h"
@@ -62,8 +63,21 @@ private:
     // init row group reader
     Status _init_group_reader();
 
-    // filter row group by min/max conjuncts
+    // The hashes of the values of an equality or IN conjunct on a column. A row group is filtered if none of
+    // them is in the bloom filter of the column chunk.
+    struct BloomFilterPredicate {
+        std::string col_name;
+        tparquet::Type::type physical_type;
+        std::vector<uint64_t> hashes;
+    };
+
+    // filter row group by min/max conjuncts and bloom filters
     Status _filter_group(const tparquet::RowGroup& group, bool* is_filter);
+    Status _filter_group_by_min_max(const tparquet::RowGroup& group, bool* is_filter);
+    void _filter_group_by_bloom_filter(const tparquet::RowGroup& group, bool* is_filter);
+
+    // collect the conjuncts that can be evaluated by bloom filters into _bloom_filter_preds
+    void _init_bloom_filter_preds();
 
     // get row group to read
     // if scan range conatain the first byte in the row group, will be read
@@ -119,6 +133,8 @@ private:
     std::shared_ptr<FileMetaData> _file_metadata;
     vector<std::shared_ptr<GroupReader>> _row_group_readers;
     size_t _cur_row_group_idx = 0;
+    // the row group whose column chunks are hinted to the file by set_io_ranges()
+    size_t _io_ranges_row_group_idx = std::numeric_limits<size_t>::max();
     size_t _row_group_size = 0;
     vectorized::Schema _schema;
 
@@ -133,6 +149,8 @@ private:
     bool _is_file_filtered = false;
     // conjuncts that column is not exist in file
     std::vector<ExprContext*> _not_exist_column_conjunct_ctxs;
+
+    std::vector<BloomFilterPredicate> _bloom_filter_preds;
 };
 
 } // namespace starrocks::parquet
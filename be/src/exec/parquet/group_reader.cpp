@@ -3,6 +3,8 @@
 
 #include "exec/parquet/group_reader.h"
 
+#include <algorithm>
+
 #include "column/column_helper.h"
 #include "exec/exec_node.h"
 #include "exprs/expr.h"
@@ -77,6 +79,22 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
     return status;
 }
 
+void GroupReader::collect_io_ranges(std::vector<IORange>* ranges) const {
+    if (_is_group_filtered) {
+        return;
+    }
+    for (const auto& column : _param.read_cols) {
+        const tparquet::ColumnMetaData& column_metadata =
+                _row_group_metadata->columns[column.col_idx_in_parquet].meta_data;
+        int64_t offset = column_metadata.data_page_offset;
+        if (column_metadata.__isset.dictionary_page_offset && column_metadata.dictionary_page_offset > 0) {
+            offset = std::min(offset, column_metadata.dictionary_page_offset);
+        }
+        ranges->emplace_back(IORange{static_cast<uint64_t>(offset),
+                                     static_cast<uint64_t>(column_metadata.total_compressed_size)});
+    }
+}
+
 Status GroupReader::_init_column_readers() {
     for (const auto& column : _param.read_cols) {
         RETURN_IF_ERROR(_create_column_reader(column));
@@ -110,7 +128,11 @@ void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
                 _row_group_metadata->columns[column.col_idx_in_parquet].meta_data;
         if (_can_using_dict_filter(slots[chunk_index], conjunct_ctxs_by_slot, column_metadata)) {
             _dict_filter_columns.emplace_back(column);
+            _dict_code_columns.emplace_back(column);
             _dict_filter_conjunct_ctxs[slot_id] = conjunct_ctxs_by_slot.at(slot_id);
+        } else if (conjunct_ctxs_by_slot.find(slot_id) == conjunct_ctxs_by_slot.end() &&
+                   _can_using_lazy_dict_decode(slots[chunk_index], column_metadata)) {
+            _dict_code_columns.emplace_back(column);
         } else {
             _direct_read_columns.emplace_back(column);
             if (conjunct_ctxs_by_slot.find(slot_id) != conjunct_ctxs_by_slot.end()) {
@@ -155,6 +177,15 @@ bool GroupReader::_can_using_dict_filter(const SlotDescriptor* slot, const SlotI
     return true;
 }
 
+bool GroupReader::_can_using_lazy_dict_decode(const SlotDescriptor* slot,
+                                              const tparquet::ColumnMetaData& column_metadata) {
+    // Without conjuncts every row is returned, decoding the codes later saves nothing.
+    if (_param.conjunct_ctxs_by_slot.empty()) {
+        return false;
+    }
+    return slot->type().is_string_type() && _column_all_pages_dict_encoded(column_metadata);
+}
+
 bool GroupReader::_column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata) {
     // The Parquet spec allows for column chunks to have mixed encodings
     // where some data pages are dictionary-encoded and others are plain
@@ -266,8 +297,8 @@ void GroupReader::_init_read_chunk() {
     _read_chunk = vectorized::ChunkHelper::new_chunk(read_slots, chunk_size);
     raw::stl_vector_resize_uninitialized(&_selection, chunk_size);
 
-    // replace dict filter column
-    for (const auto& column : _dict_filter_columns) {
+    // replace dict code column
+    for (const auto& column : _dict_code_columns) {
         SlotId slot_id = column.slot_id;
         auto dict_code_column = vectorized::ColumnHelper::create_column(
                 TypeDescriptor::from_primtive_type(kDictCodePrimitiveType), true);
@@ -279,7 +310,7 @@ void GroupReader::_init_read_chunk() {
 Status GroupReader::_read(size_t* row_count) {
     size_t count = *row_count;
 
-    for (const auto& column : _dict_filter_columns) {
+    for (const auto& column : _dict_code_columns) {
         SlotId slot_id = column.slot_id;
         count = *row_count;
         Status status = _column_readers[slot_id]->next_batch(&count, ColumnContentType::DICT_CODE,
@@ -333,7 +364,7 @@ void GroupReader::_dict_filter() {
 Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
     const auto& slots = _param.tuple_desc->slots();
 
-    for (const auto& column : _dict_filter_columns) {
+    for (const auto& column : _dict_code_columns) {
         int chunk_index = column.col_idx_in_chunk;
         SlotId slot_id = column.slot_id;
 
@@ -342,6 +373,14 @@ Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
         dict_values->resize(0);
 
         auto* codes_nullable_column = vectorized::ColumnHelper::as_raw_column<vectorized::NullableColumn>(dict_codes);
+        // The codes of the null rows are the defaults, which are not in the dict if the dict is empty.
+        // Only the lazy dict decode columns may have null rows left.
+        if (codes_nullable_column->size() > 0 &&
+            codes_nullable_column->null_count() == codes_nullable_column->size()) {
+            dict_values->append_nulls(codes_nullable_column->size());
+            continue;
+        }
+
         auto* codes_column = vectorized::ColumnHelper::as_raw_column<vectorized::FixedLengthColumn<int32_t>>(
                 codes_nullable_column->data_column());
         RETURN_IF_ERROR(_column_readers[slot_id]->get_dict_values(codes_column->get_data(), dict_values.get()));
@@ -4,6 +4,7 @@
 
 #include "column/chunk.h"
 #include "column/vectorized_fwd.h"
+#include "env/env.h"
 #include "exec/parquet/column_reader.h"
 #include "exec/parquet/metadata.h"
 #include "exec/vectorized/hdfs_scanner.h"
@@ -14,8 +15,6 @@
 #include "util/runtime_profile.h"
 
 namespace starrocks {
-class RandomAccessFile;
-
 namespace vectorized {
 struct HdfsScanStats;
 }
@@ -60,6 +59,9 @@ public:
     Status init(const GroupReaderParam& _param);
     Status get_next(vectorized::ChunkPtr* chunk, size_t* row_count);
 
+    // Appends the byte ranges of the column chunks this row group reads.
+    void collect_io_ranges(std::vector<IORange>* ranges) const;
+
 private:
     using SlotIdExprContextsMap = std::unordered_map<int, std::vector<ExprContext*>>;
 
@@ -69,6 +71,8 @@ private:
     void _pre_process_columns_and_conjunct_ctxs();
     bool _can_using_dict_filter(const SlotDescriptor* slot, const SlotIdExprContextsMap& slot_conjunct_ctxs,
                                 const tparquet::ColumnMetaData& column_metadata);
+    // Returns true if the column is read as dict codes and decoded to values only for the rows left by the conjuncts
+    bool _can_using_lazy_dict_decode(const SlotDescriptor* slot, const tparquet::ColumnMetaData& column_metadata);
     // Returns true if all of the data pages in the column chunk are dict encoded
     bool _column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata);
     Status _rewrite_dict_column_predicates();
@@ -102,6 +106,8 @@ private:
 
     // dict filter column
     std::vector<GroupReaderParam::Column> _dict_filter_columns;
+    // columns read as dict codes, i.e. the dict filter columns and the lazy dict decode columns
+    std::vector<GroupReaderParam::Column> _dict_code_columns;
     // direct read conlumns
     std::vector<GroupReaderParam::Column> _direct_read_columns;
 
@@ -26,15 +26,28 @@
 
 #include <ctime>
 
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "exec/file_writer.h"
+#include "exprs/expr.h"
+#include "exprs/vectorized/column_ref.h"
+#include "formats/csv/converter.h"
+#include "formats/csv/output_stream_string.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/broker_mgr.h"
 #include "runtime/client_cache.h"
+#include "runtime/date_value.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
+#include "runtime/timestamp_value.h"
+#include "runtime/vectorized/time_types.h"
 #include "util/thrift_util.h"
 
 namespace starrocks {
@@ -63,6 +76,10 @@ arrow::Result<int64_t> ParquetOutputStream::Tell() const {
 }
 
 arrow::Status ParquetOutputStream::Close() {
+    // closed by the file writer of parquet first
+    if (_is_closed) {
+        return arrow::Status::OK();
+    }
     Status st = _writable_file->close();
     if (!st.ok()) {
         return arrow::Status::IOError(st.get_error_msg());
@@ -72,24 +89,312 @@ arrow::Status ParquetOutputStream::Close() {
 }
 
 /// ParquetBuilder
+
+// The physical and logical types of the column, or nullptr if the column is written as strings.
+static parquet::schema::NodePtr make_parquet_node(const std::string& name, const TypeDescriptor& type,
+                                                  bool nullable) {
+    using parquet::LogicalType;
+    using parquet::schema::PrimitiveNode;
+    auto repetition = nullable ? parquet::Repetition::OPTIONAL : parquet::Repetition::REQUIRED;
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        return PrimitiveNode::Make(name, repetition, parquet::Type::BOOLEAN);
+    case TYPE_TINYINT:
+        return PrimitiveNode::Make(name, repetition, LogicalType::Int(8, true), parquet::Type::INT32);
+    case TYPE_SMALLINT:
+        return PrimitiveNode::Make(name, repetition, LogicalType::Int(16, true), parquet::Type::INT32);
+    case TYPE_INT:
+        return PrimitiveNode::Make(name, repetition, LogicalType::Int(32, true), parquet::Type::INT32);
+    case TYPE_BIGINT:
+        return PrimitiveNode::Make(name, repetition, LogicalType::Int(64, true), parquet::Type::INT64);
+    case TYPE_FLOAT:
+        return PrimitiveNode::Make(name, repetition, parquet::Type::FLOAT);
+    case TYPE_DOUBLE:
+        return PrimitiveNode::Make(name, repetition, parquet::Type::DOUBLE);
+    case TYPE_DATE:
+        return PrimitiveNode::Make(name, repetition, LogicalType::Date(), parquet::Type::INT32);
+    case TYPE_DATETIME:
+        return PrimitiveNode::Make(name, repetition,
+                                   LogicalType::Timestamp(false, LogicalType::TimeUnit::MICROS), parquet::Type::INT64);
+    case TYPE_DECIMAL32:
+        return PrimitiveNode::Make(name, repetition, LogicalType::Decimal(type.precision, type.scale),
+                                   parquet::Type::INT32);
+    case TYPE_DECIMAL64:
+        return PrimitiveNode::Make(name, repetition, LogicalType::Decimal(type.precision, type.scale),
+                                   parquet::Type::INT64);
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return PrimitiveNode::Make(name, repetition, LogicalType::String(), parquet::Type::BYTE_ARRAY);
+    default:
+        return nullptr;
+    }
+}
+
+template <typename ParquetType>
+static void write_batch(parquet::ColumnWriter* writer, size_t num_rows, const int16_t* def_levels,
+                        const uint8_t* valid_bits, const typename ParquetType::c_type* values) {
+    auto* typed_writer = static_cast<parquet::TypedColumnWriter<ParquetType>*>(writer);
+    if (valid_bits != nullptr) {
+        // the values of the nulls are skipped, so the values are written without being compacted
+        typed_writer->WriteBatchSpaced(num_rows, def_levels, nullptr, valid_bits, 0, values);
+    } else {
+        typed_writer->WriteBatch(num_rows, def_levels, nullptr, values);
+    }
+}
+
 ParquetBuilder::ParquetBuilder(std::unique_ptr<WritableFile> writable_file,
                                const std::vector<ExprContext*>& output_expr_ctxs)
-        : _outstream(new ParquetOutputStream(writable_file.get())),
-          _writable_file(std::move(writable_file)),
-          _output_expr_ctxs(output_expr_ctxs) {
-    // TODO(cmy): implement
-}
+        : _writable_file(std::move(writable_file)),
+          _outstream(std::make_shared<ParquetOutputStream>(_writable_file.get())),
+          _output_expr_ctxs(output_expr_ctxs) {}
 
 ParquetBuilder::~ParquetBuilder() = default;
 
+Status ParquetBuilder::_init() {
+    if (_inited) {
+        return Status::OK();
+    }
+    parquet::schema::NodeVector fields;
+    _nullables.reserve(_output_expr_ctxs.size());
+    _converters.resize(_output_expr_ctxs.size());
+    for (size_t i = 0; i < _output_expr_ctxs.size(); ++i) {
+        const auto& type = _output_expr_ctxs[i]->root()->type();
+        bool nullable = _output_expr_ctxs[i]->root()->is_nullable();
+        std::string name = "col" + std::to_string(i);
+        auto node = make_parquet_node(name, type, nullable);
+        if (node == nullptr) {
+            _converters[i] = vectorized::csv::get_converter(type, false);
+            if (_converters[i] == nullptr) {
+                return Status::InternalError("No Parquet or CSV converter for type " + type.debug_string());
+            }
+            node = parquet::schema::PrimitiveNode::Make(
+                    name, nullable ? parquet::Repetition::OPTIONAL : parquet::Repetition::REQUIRED,
+                    parquet::LogicalType::String(), parquet::Type::BYTE_ARRAY);
+        }
+        fields.emplace_back(std::move(node));
+        _nullables.push_back(nullable);
+    }
+    auto schema = std::static_pointer_cast<parquet::schema::GroupNode>(
+            parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
+
+    parquet::WriterProperties::Builder builder;
+    builder.compression(parquet::Compression::SNAPPY);
+    builder.data_pagesize(std::max<int64_t>(config::parquet_writer_page_bytes, 4096));
+    builder.dictionary_pagesize_limit(std::max<int64_t>(config::parquet_writer_page_bytes, 4096));
+    if (config::parquet_writer_enable_dictionary) {
+        builder.enable_dictionary();
+    } else {
+        builder.disable_dictionary();
+    }
+    builder.enable_statistics();
+    try {
+        _file_writer = parquet::ParquetFileWriter::Open(_outstream, schema, builder.build());
+    } catch (parquet::ParquetException& e) {
+        return Status::InternalError(strings::Substitute("Fail to open parquet file writer: $0", e.what()));
+    }
+    _inited = true;
+    return Status::OK();
+}
+
 Status ParquetBuilder::add_chunk(vectorized::Chunk* chunk) {
-    // TODO(c1oudman): implement
-    return Status::NotSupported("Parquet builder not supported yet");
+    RETURN_IF_ERROR(_init());
+
+    const size_t num_rows = chunk->num_rows();
+    const size_t num_cols = chunk->num_columns();
+    if (num_cols != _output_expr_ctxs.size()) {
+        auto err = strings::Substitute("Unmatched number of columns expected=$0 real=$1", _output_expr_ctxs.size(),
+                                       num_cols);
+        return Status::InternalError(err);
+    }
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    try {
+        if (_row_group_writer == nullptr) {
+            _row_group_writer = _file_writer->AppendBufferedRowGroup();
+        }
+        for (size_t i = 0; i < num_cols; ++i) {
+            auto* root = _output_expr_ctxs[i]->root();
+            if (!root->is_slotref()) {
+                return Status::InternalError("Not slot ref column");
+            }
+            auto* column_ref = down_cast<vectorized::ColumnRef*>(root);
+            vectorized::ColumnPtr column = chunk->get_column_by_slot_id(column_ref->slot_id());
+            if (column->is_constant()) {
+                column = vectorized::ColumnHelper::unpack_and_duplicate_const_column(num_rows, column);
+            }
+            RETURN_IF_ERROR(_write_column(i, column.get(), num_rows));
+        }
+        if (_row_group_writer->total_bytes_written() + _row_group_writer->total_compressed_bytes() >=
+            config::parquet_writer_row_group_bytes) {
+            _row_group_writer->Close();
+            _row_group_writer = nullptr;
+        }
+    } catch (parquet::ParquetException& e) {
+        return Status::InternalError(strings::Substitute("Fail to write parquet file: $0", e.what()));
+    }
+    return Status::OK();
+}
+
+Status ParquetBuilder::_write_column(size_t index, const vectorized::Column* column, size_t num_rows) {
+    // The definition level is 0 for a null and 1 for a value of the OPTIONAL columns.
+    const int16_t* def_levels = nullptr;
+    // nullptr if all the rows are values
+    const uint8_t* valid_bits = nullptr;
+    const vectorized::Column* data_column = column;
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const vectorized::NullableColumn*>(column);
+        data_column = nullable_column->data_column().get();
+        if (nullable_column->has_null()) {
+            if (!_nullables[index]) {
+                return Status::InternalError(strings::Substitute("Null values in not null column $0", index));
+            }
+            const auto& nulls = nullable_column->immutable_null_column_data();
+            _def_levels.resize(num_rows);
+            _valid_bits.assign((num_rows + 7) / 8, 0);
+            for (size_t i = 0; i < num_rows; ++i) {
+                uint8_t valid = !nulls[i];
+                _def_levels[i] = valid;
+                _valid_bits[i >> 3] |= valid << (i & 7);
+            }
+            def_levels = _def_levels.data();
+            valid_bits = _valid_bits.data();
+        }
+    }
+    if (_nullables[index] && def_levels == nullptr) {
+        _def_levels.assign(num_rows, 1);
+        def_levels = _def_levels.data();
+    }
+
+    parquet::ColumnWriter* writer = _row_group_writer->column(index);
+    if (_converters[index] != nullptr) {
+        RETURN_IF_ERROR(_convert_to_strings(index, data_column, valid_bits, num_rows));
+        write_batch<parquet::ByteArrayType>(writer, num_rows, def_levels, valid_bits, _byte_array_buffer.data());
+        return Status::OK();
+    }
+
+    // The fixed length values are written from the column directly if their layout is the same.
+    const uint8_t* raw_data = data_column->raw_data();
+    switch (_output_expr_ctxs[index]->root()->type().type) {
+    case TYPE_BOOLEAN:
+        write_batch<parquet::BooleanType>(writer, num_rows, def_levels, valid_bits,
+                                          reinterpret_cast<const bool*>(raw_data));
+        break;
+    case TYPE_TINYINT:
+        _int32_buffer.assign(reinterpret_cast<const int8_t*>(raw_data),
+                             reinterpret_cast<const int8_t*>(raw_data) + num_rows);
+        write_batch<parquet::Int32Type>(writer, num_rows, def_levels, valid_bits, _int32_buffer.data());
+        break;
+    case TYPE_SMALLINT:
+        _int32_buffer.assign(reinterpret_cast<const int16_t*>(raw_data),
+                             reinterpret_cast<const int16_t*>(raw_data) + num_rows);
+        write_batch<parquet::Int32Type>(writer, num_rows, def_levels, valid_bits, _int32_buffer.data());
+        break;
+    case TYPE_INT:
+    case TYPE_DECIMAL32:
+        write_batch<parquet::Int32Type>(writer, num_rows, def_levels, valid_bits,
+                                        reinterpret_cast<const int32_t*>(raw_data));
+        break;
+    case TYPE_BIGINT:
+    case TYPE_DECIMAL64:
+        write_batch<parquet::Int64Type>(writer, num_rows, def_levels, valid_bits,
+                                        reinterpret_cast<const int64_t*>(raw_data));
+        break;
+    case TYPE_FLOAT:
+        write_batch<parquet::FloatType>(writer, num_rows, def_levels, valid_bits,
+                                        reinterpret_cast<const float*>(raw_data));
+        break;
+    case TYPE_DOUBLE:
+        write_batch<parquet::DoubleType>(writer, num_rows, def_levels, valid_bits,
+                                         reinterpret_cast<const double*>(raw_data));
+        break;
+    case TYPE_DATE: {
+        // days since the unix epoch
+        const auto* dates = reinterpret_cast<const DateValue*>(raw_data);
+        _int32_buffer.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            _int32_buffer[i] = dates[i].julian() - vectorized::date::UNIX_EPOCH_JULIAN;
+        }
+        write_batch<parquet::Int32Type>(writer, num_rows, def_levels, valid_bits, _int32_buffer.data());
+        break;
+    }
+    case TYPE_DATETIME: {
+        // microseconds since the unix epoch
+        const auto* timestamps = reinterpret_cast<const TimestampValue*>(raw_data);
+        _int64_buffer.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            int64_t micros = vectorized::timestamp::to_time(timestamps[i].timestamp()) % vectorized::USECS_PER_SEC;
+            _int64_buffer[i] = timestamps[i].to_unix_second() * vectorized::USECS_PER_SEC + micros;
+        }
+        write_batch<parquet::Int64Type>(writer, num_rows, def_levels, valid_bits, _int64_buffer.data());
+        break;
+    }
+    case TYPE_CHAR:
+    case TYPE_VARCHAR: {
+        const auto* binary_column = down_cast<const vectorized::BinaryColumn*>(data_column);
+        const auto& offsets = binary_column->get_offset();
+        const uint8_t* bytes = binary_column->get_bytes().data();
+        _byte_array_buffer.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            _byte_array_buffer[i] = parquet::ByteArray(offsets[i + 1] - offsets[i], bytes + offsets[i]);
+        }
+        write_batch<parquet::ByteArrayType>(writer, num_rows, def_levels, valid_bits, _byte_array_buffer.data());
+        break;
+    }
+    default:
+        return Status::InternalError(strings::Substitute("Unsupported parquet column $0", index));
+    }
+    return Status::OK();
+}
+
+Status ParquetBuilder::_convert_to_strings(size_t index, const vectorized::Column* data_column,
+                                           const uint8_t* valid_bits, size_t num_rows) {
+    vectorized::csv::OutputStreamString os;
+    vectorized::csv::Converter::Options opts;
+    // the end offset of the string of each row, the strings are pointed to once all of them are written
+    std::vector<size_t> ends(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (valid_bits == nullptr || (valid_bits[i >> 3] >> (i & 7)) & 1) {
+            RETURN_IF_ERROR(_converters[index]->write_string(&os, *data_column, i, opts));
+            RETURN_IF_ERROR(os.finalize());
+        }
+        ends[i] = os.as_string().size();
+    }
+    _string_buffer = os.as_string();
+    _byte_array_buffer.resize(num_rows);
+    size_t begin = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        _byte_array_buffer[i] = parquet::ByteArray(ends[i] - begin,
+                                                   reinterpret_cast<const uint8_t*>(_string_buffer.data()) + begin);
+        begin = ends[i];
+    }
+    return Status::OK();
+}
+
+std::size_t ParquetBuilder::file_size() {
+    int64_t size = _outstream->Tell().ValueOr(0);
+    if (_row_group_writer != nullptr) {
+        size += _row_group_writer->total_bytes_written() + _row_group_writer->total_compressed_bytes();
+    }
+    return size;
 }
 
 Status ParquetBuilder::finish() {
-    // TODO(cmy): implement
-    return Status::NotSupported("Parquet builder not supported yet");
+    RETURN_IF_ERROR(_init());
+    try {
+        if (_row_group_writer != nullptr) {
+            _row_group_writer->Close();
+            _row_group_writer = nullptr;
+        }
+        _file_writer->Close();
+    } catch (parquet::ParquetException& e) {
+        return Status::InternalError(strings::Substitute("Fail to close parquet file: $0", e.what()));
+    }
+    arrow::Status st = _outstream->Close();
+    if (!st.ok()) {
+        return Status::IOError(st.ToString());
+    }
+    return Status::OK();
 }
 
 } // namespace starrocks
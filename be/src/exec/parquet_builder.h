@@ -34,7 +34,9 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "common/status.h"
 #include "exec/file_builder.h"
@@ -44,6 +46,10 @@
 
 namespace starrocks {
 
+namespace vectorized::csv {
+class Converter;
+} // namespace vectorized::csv
+
 class ExprContext;
 class FileWriter;
 
@@ -65,7 +71,14 @@ private:
     bool _is_closed = false;
 };
 
-// a wrapper of parquet output stream
+// Writes the chunks to a Parquet file by the column writers of parquet directly, column by column, without
+// converting them to arrow arrays first. The column i of the file is named "col<i>", it's OPTIONAL if the
+// output expr is nullable.
+// The chunks are buffered in a row group until it reaches config::parquet_writer_row_group_bytes, the pages
+// are of config::parquet_writer_page_bytes, compressed by snappy and dictionary encoded if
+// config::parquet_writer_enable_dictionary. The statistics of the pages and the column chunks are written too.
+// The types without a Parquet counterpart, e.g. LARGEINT, DECIMALV2, DECIMAL128 and ARRAY, are written as
+// strings in the CSV format.
 class ParquetBuilder : public FileBuilder {
 public:
     ParquetBuilder(std::unique_ptr<WritableFile> writable_file, const std::vector<ExprContext*>& output_expr_ctxs);
@@ -73,14 +86,36 @@ public:
 
     Status add_chunk(vectorized::Chunk* chunk) override;
 
-    std::size_t file_size() override { return 0; }
+    // the bytes written plus the bytes buffered in the current row group
+    std::size_t file_size() override;
 
     Status finish() override;
 
 private:
-    ParquetOutputStream* _outstream;
+    Status _init();
+    Status _write_column(size_t index, const vectorized::Column* column, size_t num_rows);
+    // The values of the columns written as strings, |num_rows| ByteArrays pointing to _string_buffer.
+    Status _convert_to_strings(size_t index, const vectorized::Column* data_column, const uint8_t* valid_bits,
+                               size_t num_rows);
+
     std::unique_ptr<WritableFile> _writable_file;
+    std::shared_ptr<ParquetOutputStream> _outstream;
     const std::vector<ExprContext*>& _output_expr_ctxs;
+    std::unique_ptr<parquet::ParquetFileWriter> _file_writer;
+    // the row group being buffered, owned by _file_writer, nullptr if none
+    parquet::RowGroupWriter* _row_group_writer = nullptr;
+    std::vector<bool> _nullables;
+    // only set for the columns written as strings
+    std::vector<std::unique_ptr<vectorized::csv::Converter>> _converters;
+    bool _inited = false;
+
+    // the buffers of the column being written, reused by the columns
+    std::vector<int16_t> _def_levels;
+    std::vector<uint8_t> _valid_bits;
+    std::vector<int32_t> _int32_buffer;
+    std::vector<int64_t> _int64_buffer;
+    std::vector<parquet::ByteArray> _byte_array_buffer;
+    std::string _string_buffer;
 };
 
 } // namespace starrocks
@@ -9,6 +9,9 @@ namespace starrocks::pipeline {
 Status AggregateBlockingSinkOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Operator::prepare(state));
     RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), get_runtime_profile(), _mem_tracker));
+    if (state->enable_spill()) {
+        _aggregator->enable_spill();
+    }
     return _aggregator->open(state);
 }
 
@@ -93,6 +96,9 @@ Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const vect
         } else {
             _aggregator->compute_batch_agg_states(chunk_size);
         }
+        // Spill after the agg states of this chunk have been computed,
+        // because they are referenced by the hash map.
+        TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_aggregator->try_spill_hash_map()));
     }
     _aggregator->update_num_input_rows(chunk_size);
 
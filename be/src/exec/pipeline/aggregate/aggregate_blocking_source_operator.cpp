@@ -7,11 +7,13 @@
 namespace starrocks::pipeline {
 
 bool AggregateBlockingSourceOperator::has_output() const {
-    return _aggregator->is_sink_complete() && !_aggregator->is_ht_eos();
+    return _aggregator->is_sink_complete() &&
+           (!_aggregator->is_ht_eos() || _aggregator->need_restore_spilled_partition());
 }
 
 bool AggregateBlockingSourceOperator::is_finished() const {
-    return _aggregator->is_sink_complete() && _aggregator->is_ht_eos();
+    return _aggregator->is_sink_complete() && _aggregator->is_ht_eos() &&
+           !_aggregator->need_restore_spilled_partition();
 }
 
 void AggregateBlockingSourceOperator::set_finished(RuntimeState* state) {
@@ -30,6 +32,15 @@ StatusOr<vectorized::ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(Runti
     int32_t chunk_size = state->chunk_size();
     vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
 
+    // The spilled partitions are merged back one by one, and each of them is output
+    // entirely before the next one is loaded.
+    if (_aggregator->need_restore_spilled_partition()) {
+        RETURN_IF_ERROR(_aggregator->restore_next_spilled_partition());
+        if (_aggregator->is_ht_eos()) {
+            return chunk;
+        }
+    }
+
     if (_aggregator->is_none_group_by_exprs()) {
         SCOPED_TIMER(_aggregator->get_results_timer());
         _aggregator->convert_to_chunk_no_groupby(&chunk);
@@ -119,6 +119,8 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_si
         TRY_CATCH_BAD_ALLOC(_aggregator->try_convert_to_two_level_map());
 
         COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+    } else if (_aggregator->should_pass_through_preagg()) {
+        return _push_chunk_by_force_streaming();
     } else {
         {
             SCOPED_TIMER(_aggregator->agg_compute_timer());
@@ -138,6 +140,7 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_si
         }
 
         size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
+        _aggregator->update_preagg_hit_rows(chunk_size, zero_count);
         // very poor aggregation
         if (zero_count == 0) {
             SCOPED_TIMER(_aggregator->streaming_timer());
@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/chunk_accumulate_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+void ChunkAccumulator::push(const vectorized::ChunkPtr& chunk) {
+    if (chunk == nullptr || chunk->is_empty()) {
+        return;
+    }
+    if (chunk->num_rows() >= _min_rows) {
+        // the rows pending go first, they are before the chunk
+        if (_pending != nullptr) {
+            _output.emplace_back(std::move(_pending));
+        }
+        _output.emplace_back(chunk);
+        return;
+    }
+    // Both the pending rows and the chunk are fewer than half of the chunk size, so the merged chunk never
+    // exceeds the chunk size.
+    if (_pending == nullptr) {
+        _pending = chunk->clone_empty(_min_rows * 2);
+    } else {
+        _num_merged_chunks++;
+    }
+    _pending->append(*chunk);
+    if (_pending->num_rows() >= _min_rows) {
+        _output.emplace_back(std::move(_pending));
+    }
+}
+
+void ChunkAccumulator::finalize() {
+    if (_pending != nullptr) {
+        _output.emplace_back(std::move(_pending));
+    }
+}
+
+vectorized::ChunkPtr ChunkAccumulator::pull() {
+    if (_output.empty()) {
+        return nullptr;
+    }
+    auto chunk = std::move(_output.front());
+    _output.pop_front();
+    return chunk;
+}
+
+Status ChunkAccumulateOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    _merged_chunks_counter = ADD_COUNTER(_runtime_profile, "MergedChunks", TUnit::UNIT);
+    return Status::OK();
+}
+
+Status ChunkAccumulateOperator::close(RuntimeState* state) {
+    COUNTER_SET(_merged_chunks_counter, static_cast<int64_t>(_acc.num_merged_chunks()));
+    return Operator::close(state);
+}
+
+void ChunkAccumulateOperator::set_finishing(RuntimeState* state) {
+    _is_finished = true;
+    _acc.finalize();
+}
+
+StatusOr<vectorized::ChunkPtr> ChunkAccumulateOperator::pull_chunk(RuntimeState* state) {
+    return _acc.pull();
+}
+
+Status ChunkAccumulateOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    _acc.push(chunk);
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
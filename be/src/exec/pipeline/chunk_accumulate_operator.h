@@ -0,0 +1,84 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+
+#include "column/vectorized_fwd.h"
+#include "exec/pipeline/operator.h"
+
+namespace starrocks::pipeline {
+
+// ChunkAccumulator merges the small chunks into the chunks of at least half of the chunk size.
+// The chunks large enough are passed through as they are, only the small ones are copied, and the
+// order of the rows is kept.
+class ChunkAccumulator {
+public:
+    explicit ChunkAccumulator(size_t chunk_size) : _min_rows(std::max<size_t>(chunk_size / 2, 1)) {}
+
+    void push(const vectorized::ChunkPtr& chunk);
+    // The pending rows are output even if they are fewer than half of the chunk size.
+    void finalize();
+
+    bool has_output() const { return !_output.empty(); }
+    // nullptr if there's no output.
+    vectorized::ChunkPtr pull();
+
+    bool empty() const { return _output.empty() && _pending == nullptr; }
+
+    // The number of the input chunks merged into another one.
+    size_t num_merged_chunks() const { return _num_merged_chunks; }
+
+private:
+    const size_t _min_rows;
+    vectorized::ChunkPtr _pending;
+    std::deque<vectorized::ChunkPtr> _output;
+    size_t _num_merged_chunks = 0;
+};
+
+// ChunkAccumulateOperator is placed after the operators which may output many small chunks, e.g. the probe of
+// a selective hash join, so that each operator after it and the exchange pay their cost per chunk less often.
+class ChunkAccumulateOperator final : public Operator {
+public:
+    ChunkAccumulateOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id, size_t chunk_size)
+            : Operator(factory, id, "chunk_accumulate", plan_node_id), _acc(chunk_size) {}
+
+    ~ChunkAccumulateOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    bool has_output() const override { return _acc.has_output(); }
+    bool need_input() const override { return !_is_finished && !_acc.has_output(); }
+    bool is_finished() const override { return _is_finished && _acc.empty(); }
+
+    void set_finishing(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    ChunkAccumulator _acc;
+    bool _is_finished = false;
+
+    RuntimeProfile::Counter* _merged_chunks_counter = nullptr;
+};
+
+class ChunkAccumulateOperatorFactory final : public OperatorFactory {
+public:
+    ChunkAccumulateOperatorFactory(int32_t id, int32_t plan_node_id, size_t chunk_size)
+            : OperatorFactory(id, "chunk_accumulate", plan_node_id), _chunk_size(chunk_size) {}
+
+    ~ChunkAccumulateOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        return std::make_shared<ChunkAccumulateOperator>(this, _id, _plan_node_id, _chunk_size);
+    }
+
+private:
+    const size_t _chunk_size;
+};
+
+} // namespace starrocks::pipeline
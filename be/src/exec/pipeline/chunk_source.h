@@ -36,6 +36,9 @@ public:
 
     virtual Status buffer_next_batch_chunks_blocking(size_t chunk_size, bool& can_finish) = 0;
 
+    // Total bytes read from the storage so far, used to account the io of the WorkGroup.
+    virtual int64_t bytes_read() const { return 0; }
+
 protected:
     // The morsel will own by pipeline driver
     MorselPtr _morsel;
@@ -4,10 +4,12 @@
 
 #include <algorithm>
 #include <atomic>
+#include <utility>
 
 #include "column/chunk.h"
 #include "column/vectorized_fwd.h"
 #include "exec/pipeline/context_with_dependency.h"
+#include "exec/pipeline/crossjoin/range_join_key.h"
 
 namespace starrocks::pipeline {
 
@@ -31,6 +33,17 @@ public:
         _build_chunks[sinker_id] = build_chunk;
     }
 
+    void set_range_join_key(RangeJoinKey range_join_key) { _range_join_key = std::move(range_join_key); }
+
+    const RangeJoinKey& range_join_key() const { return _range_join_key; }
+
+    // Sort the build chunk of a CrossJoinRightSinkOperator by the range join key, before it is finished.
+    void sort_build_chunk(const int32_t sinker_id) {
+        if (_range_join_key.is_valid() && _build_chunks[sinker_id] != nullptr) {
+            _build_chunks[sinker_id] = _range_join_key.sort_build_chunk(_build_chunks[sinker_id]);
+        }
+    }
+
     void finish_one_right_sinker() { _num_finished_right_sinkers.fetch_add(1, std::memory_order_release); }
 
     bool is_right_finished() const {
@@ -47,6 +60,8 @@ private:
 
     // _build_chunks[i] contains all the rows from i-th CrossJoinRightSinkOperator.
     std::vector<vectorized::ChunkPtr> _build_chunks;
+
+    RangeJoinKey _range_join_key;
 };
 
 } // namespace starrocks::pipeline
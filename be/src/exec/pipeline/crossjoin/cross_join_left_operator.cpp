@@ -2,18 +2,22 @@
 
 #include "exec/pipeline/crossjoin/cross_join_left_operator.h"
 
+#include <algorithm>
+
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
 #include "exec/exec_node.h"
 #include "exprs/expr.h"
+#include "exprs/expr_context.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
 
-void CrossJoinLeftOperator::_init_chunk(vectorized::ChunkPtr* chunk, RuntimeState* state) {
+void CrossJoinLeftOperator::_init_chunk(const vectorized::Chunk* build_chunk, vectorized::ChunkPtr* chunk,
+                                        RuntimeState* state) {
     vectorized::ChunkPtr new_chunk = std::make_shared<vectorized::Chunk>();
 
-    // init columns for the new chunk from _probe_chunk and _curr_build_chunk
+    // init columns for the new chunk from _probe_chunk and build_chunk
     for (size_t i = 0; i < _probe_column_count; ++i) {
         SlotDescriptor* slot = _col_types[i];
         vectorized::ColumnPtr& src_col = _probe_chunk->get_column_by_slot_id(slot->id());
@@ -22,7 +26,7 @@ void CrossJoinLeftOperator::_init_chunk(vectorized::ChunkPtr* chunk, RuntimeStat
     }
     for (size_t i = 0; i < _build_column_count; ++i) {
         SlotDescriptor* slot = _col_types[_probe_column_count + i];
-        vectorized::ColumnPtr& src_col = _curr_build_chunk->get_column_by_slot_id(slot->id());
+        const vectorized::ColumnPtr& src_col = build_chunk->get_column_by_slot_id(slot->id());
         vectorized::ColumnPtr new_col = vectorized::ColumnHelper::create_column(slot->type(), src_col->is_nullable());
         new_chunk->append_column(std::move(new_col), slot->id());
     }
@@ -185,17 +189,192 @@ void CrossJoinLeftOperator::_select_build_chunk(const int32_t unprocessed_build_
         _beyond_threshold_build_rows_index = 0;
         _probe_chunk_index = 0;
         _probe_rows_index = 0;
+        _tile_build_start = 0;
+        _tile_probe_start = 0;
+        const RangeJoinKey& range_join_key = _cross_join_context->range_join_key();
+        if (range_join_key.is_valid()) {
+            range_join_key.probe_ranges(_probe_chunk.get(), _curr_build_chunk, &_probe_range_begins,
+                                        &_probe_range_ends);
+        }
     }
 }
 
+void CrossJoinLeftOperator::_append_rows(vectorized::ColumnPtr& dest_col, const vectorized::ColumnPtr& src_col,
+                                         const uint32_t* indexes, size_t row_count) {
+    if (src_col->is_constant()) {
+        // current can't reach here
+        if (src_col->is_nullable()) {
+            dest_col->append_nulls(row_count);
+        } else {
+            auto* const_col = vectorized::ColumnHelper::as_raw_column<vectorized::ConstColumn>(src_col);
+            _buf_selective.assign(row_count, 0);
+            dest_col->append_selective(*const_col->data_column(), &_buf_selective[0], 0, row_count);
+        }
+    } else {
+        dest_col->append_selective(*src_col, indexes, 0, row_count);
+    }
+}
+
+void CrossJoinLeftOperator::_fill_next_tile(RuntimeState* state) {
+    // A tile has at most chunk_size pairs of rows, a block of the build rows times as many probe rows as it fits,
+    // so the build rows of a block stay in the cache while the probe rows are joined with them.
+    const size_t chunk_size = state->chunk_size();
+    const size_t num_probe_rows = _probe_chunk->num_rows();
+    const size_t num_build_rows = std::min(_curr_total_build_rows - _tile_build_start, chunk_size);
+    const size_t num_tile_probe_rows =
+            std::min(num_probe_rows - _tile_probe_start, std::max<size_t>(1, chunk_size / num_build_rows));
+    const size_t num_tile_rows = num_tile_probe_rows * num_build_rows;
+
+    _match_probe_indexes.resize(num_tile_rows);
+    _match_build_indexes.resize(num_tile_rows);
+    for (size_t i = 0, row = 0; i < num_tile_probe_rows; i++) {
+        for (size_t j = 0; j < num_build_rows; j++, row++) {
+            _match_probe_indexes[row] = _tile_probe_start + i;
+            _match_build_indexes[row] = _tile_build_start + j;
+        }
+    }
+
+    _tile_probe_start += num_tile_probe_rows;
+    if (_tile_probe_start >= num_probe_rows) {
+        _tile_probe_start = 0;
+        _tile_build_start += num_build_rows;
+    }
+}
+
+void CrossJoinLeftOperator::_fill_next_range_tile(RuntimeState* state) {
+    // The candidates of the probe rows one after another, a probe row with more than chunk_size candidates
+    // spans several tiles.
+    const size_t chunk_size = state->chunk_size();
+    const size_t num_probe_rows = _probe_chunk->num_rows();
+    _match_probe_indexes.resize(chunk_size);
+    _match_build_indexes.resize(chunk_size);
+    size_t num_tile_rows = 0;
+    while (num_tile_rows < chunk_size && _tile_probe_start < num_probe_rows) {
+        const size_t begin = std::max<size_t>(_probe_range_begins[_tile_probe_start], _tile_build_start);
+        const size_t end = _probe_range_ends[_tile_probe_start];
+        const size_t row_count = std::min(end - std::min(begin, end), chunk_size - num_tile_rows);
+        for (size_t i = 0; i < row_count; i++, num_tile_rows++) {
+            _match_probe_indexes[num_tile_rows] = _tile_probe_start;
+            _match_build_indexes[num_tile_rows] = begin + i;
+        }
+        if (begin + row_count >= end) {
+            _tile_probe_start++;
+            _tile_build_start = 0;
+        } else {
+            _tile_build_start = begin + row_count;
+        }
+    }
+    _match_probe_indexes.resize(num_tile_rows);
+    _match_build_indexes.resize(num_tile_rows);
+}
+
+void CrossJoinLeftOperator::_eval_next_tile(RuntimeState* state) {
+    bool is_build_chunk_done;
+    if (_cross_join_context->range_join_key().is_valid()) {
+        _fill_next_range_tile(state);
+        is_build_chunk_done = _tile_probe_start >= _probe_chunk->num_rows();
+    } else {
+        _fill_next_tile(state);
+        is_build_chunk_done = _tile_build_start >= _curr_total_build_rows;
+    }
+    const size_t num_tile_rows = _match_probe_indexes.size();
+
+    vectorized::Chunk tile;
+    for (size_t index : _conjunct_column_indexes) {
+        SlotDescriptor* slot = _col_types[index];
+        bool is_probe_column = index < _probe_column_count;
+        const vectorized::ColumnPtr& src_col = is_probe_column ? _probe_chunk->get_column_by_slot_id(slot->id())
+                                                               : _curr_build_chunk->get_column_by_slot_id(slot->id());
+        auto tile_col = vectorized::ColumnHelper::create_column(slot->type(), src_col->is_nullable());
+        const auto& indexes = is_probe_column ? _match_probe_indexes : _match_build_indexes;
+        _append_rows(tile_col, src_col, indexes.data(), num_tile_rows);
+        tile.append_column(std::move(tile_col), slot->id());
+    }
+
+    _tile_filter.assign(num_tile_rows, 1);
+    for (size_t i = 0; i < _conjunct_ctxs.size() && num_tile_rows > 0; i++) {
+        ExprContext* ctx = _conjunct_ctxs[i];
+        vectorized::ColumnPtr column = ctx->evaluate(&tile);
+        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+        if (true_count == column->size()) {
+            continue;
+        }
+        bool all_zero = (true_count == 0);
+        if (!all_zero) {
+            vectorized::ColumnHelper::merge_two_filters(column, &_tile_filter, &all_zero);
+        }
+        if (all_zero) {
+            _tile_filter.assign(num_tile_rows, 0);
+            break;
+        }
+    }
+
+    // keep the matched pairs of rows in place
+    size_t num_matches = 0;
+    for (size_t row = 0; row < num_tile_rows; row++) {
+        _match_probe_indexes[num_matches] = _match_probe_indexes[row];
+        _match_build_indexes[num_matches] = _match_build_indexes[row];
+        num_matches += _tile_filter[row];
+    }
+    _match_probe_indexes.resize(num_matches);
+    _match_build_indexes.resize(num_matches);
+    _match_build_chunk = _curr_build_chunk;
+    _match_offset = 0;
+
+    if (is_build_chunk_done) {
+        _select_build_chunk(_curr_build_index + 1, state);
+    }
+}
+
+StatusOr<vectorized::ChunkPtr> CrossJoinLeftOperator::_pull_tiled_chunk(RuntimeState* state) {
+    vectorized::ChunkPtr chunk = nullptr;
+    _init_chunk(_match_offset < _match_probe_indexes.size() ? _match_build_chunk : _curr_build_chunk, &chunk, state);
+
+    const size_t chunk_size = state->chunk_size();
+    while (chunk->num_rows() < chunk_size) {
+        if (_match_offset >= _match_probe_indexes.size()) {
+            if (_is_curr_probe_chunk_finished()) {
+                break;
+            }
+            RETURN_IF_CANCELLED(state);
+            _eval_next_tile(state);
+            continue;
+        }
+
+        size_t row_count = std::min(chunk_size - chunk->num_rows(), _match_probe_indexes.size() - _match_offset);
+        for (size_t i = 0; i < _probe_column_count; i++) {
+            SlotDescriptor* slot = _col_types[i];
+            vectorized::ColumnPtr& dest_col = chunk->get_column_by_slot_id(slot->id());
+            _append_rows(dest_col, _probe_chunk->get_column_by_slot_id(slot->id()),
+                         _match_probe_indexes.data() + _match_offset, row_count);
+        }
+        for (size_t i = 0; i < _build_column_count; i++) {
+            SlotDescriptor* slot = _col_types[i + _probe_column_count];
+            vectorized::ColumnPtr& dest_col = chunk->get_column_by_slot_id(slot->id());
+            _append_rows(dest_col, _match_build_chunk->get_column_by_slot_id(slot->id()),
+                         _match_build_indexes.data() + _match_offset, row_count);
+        }
+        _match_offset += row_count;
+    }
+
+    // the conjuncts are evaluated by the tiles, only the runtime in filters are left
+    static const std::vector<ExprContext*> no_conjuncts;
+    eval_conjuncts_and_in_filters(no_conjuncts, chunk.get());
+    return chunk;
+}
+
 /*
  * This algorithm is the same as that CrossJoinNode,
  * and pull_chunk, need_input, push_chunk is splited from CrossJoinNode's get_next.
  */
 StatusOr<vectorized::ChunkPtr> CrossJoinLeftOperator::pull_chunk(RuntimeState* state) {
+    if (!_conjunct_column_indexes.empty()) {
+        return _pull_tiled_chunk(state);
+    }
+
     vectorized::ChunkPtr chunk = nullptr;
     // we need a valid probe chunk to initialize the new chunk.
-    _init_chunk(&chunk, state);
+    _init_chunk(_curr_build_chunk, &chunk, state);
 
     for (;;) {
         // need row_count to fill in chunk.
@@ -305,6 +484,9 @@ StatusOr<vectorized::ChunkPtr> CrossJoinLeftOperator::pull_chunk(RuntimeState* s
 
 Status CrossJoinLeftOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
     _probe_chunk = chunk;
+    _match_probe_indexes.clear();
+    _match_build_indexes.clear();
+    _match_offset = 0;
 
     _select_build_chunk(0, state);
 
@@ -330,6 +512,16 @@ Status CrossJoinLeftOperatorFactory::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(OperatorWithDependencyFactory::prepare(state));
 
     _init_row_desc();
+    std::vector<SlotId> conjunct_slot_ids;
+    for (auto* ctx : _conjunct_ctxs) {
+        ctx->root()->get_slot_ids(&conjunct_slot_ids);
+    }
+    for (size_t i = 0; i < _col_types.size(); i++) {
+        if (std::find(conjunct_slot_ids.begin(), conjunct_slot_ids.end(), _col_types[i]->id()) !=
+            conjunct_slot_ids.end()) {
+            _conjunct_column_indexes.emplace_back(i);
+        }
+    }
     RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state));
     RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
 
@@ -18,11 +18,13 @@ public:
     CrossJoinLeftOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id,
                           const std::vector<ExprContext*>& conjunct_ctxs,
                           const vectorized::Buffer<SlotDescriptor*>& col_types, const size_t& probe_column_count,
-                          const size_t& build_column_count, const std::shared_ptr<CrossJoinContext>& cross_join_context)
+                          const size_t& build_column_count, const std::vector<size_t>& conjunct_column_indexes,
+                          const std::shared_ptr<CrossJoinContext>& cross_join_context)
             : OperatorWithDependency(factory, id, "cross_join_left", plan_node_id),
               _col_types(col_types),
               _probe_column_count(probe_column_count),
               _build_column_count(build_column_count),
+              _conjunct_column_indexes(conjunct_column_indexes),
               _conjunct_ctxs(conjunct_ctxs),
               _cross_join_context(cross_join_context) {
         _cross_join_context->ref();
@@ -40,7 +42,7 @@ public:
     bool has_output() const override {
         // The probe chunk has been pushed to this operator,
         // and isn't finished crossing join with build chunks.
-        return _probe_chunk != nullptr && !_is_curr_probe_chunk_finished();
+        return _probe_chunk != nullptr && !_is_curr_probe_chunk_done();
     }
 
     bool need_input() const override {
@@ -54,7 +56,7 @@ public:
             return false;
         }
 
-        return _is_curr_probe_chunk_finished();
+        return _is_curr_probe_chunk_done();
     }
 
     bool is_finished() const override {
@@ -64,7 +66,7 @@ public:
             return true;
         }
 
-        return _is_finished && _is_curr_probe_chunk_finished();
+        return _is_finished && _is_curr_probe_chunk_done();
     }
 
     void set_finishing(RuntimeState* state) override { _is_finished = true; }
@@ -83,9 +85,29 @@ private:
         return _curr_build_index < 0 || _curr_build_index >= _cross_join_context->num_build_chunks();
     }
 
+    // Whether the pushed probe chunk is finished crossing join and all its joined rows are output.
+    bool _is_curr_probe_chunk_done() const {
+        return _is_curr_probe_chunk_finished() && _match_offset >= _match_probe_indexes.size();
+    }
+
     void _select_build_chunk(int32_t build_index, RuntimeState* state);
 
-    void _init_chunk(vectorized::ChunkPtr* chunk, RuntimeState* state);
+    void _init_chunk(const vectorized::Chunk* build_chunk, vectorized::ChunkPtr* chunk, RuntimeState* state);
+
+    // A blocked nested loop join for the cross joins with conjuncts, e.g. the range joins: the conjuncts are
+    // evaluated over the tiles of a block of the probe rows times a block of the build rows, with only the columns
+    // they reference, and only the matched pairs of rows are copied into the output, instead of copying the whole
+    // cartesian product and filtering it.
+    StatusOr<vectorized::ChunkPtr> _pull_tiled_chunk(RuntimeState* state);
+    // Evaluate the conjuncts over the next tile of the current build chunk, keep the matched pairs of rows in
+    // _match_probe_indexes and _match_build_indexes, and move to the next tile.
+    void _eval_next_tile(RuntimeState* state);
+    // Fill _match_probe_indexes and _match_build_indexes with the pairs of rows of the next tile.
+    void _fill_next_tile(RuntimeState* state);
+    // The same for a range join, whose tiles only have the build rows in the ranges of the probe rows.
+    void _fill_next_range_tile(RuntimeState* state);
+    void _append_rows(vectorized::ColumnPtr& dest_col, const vectorized::ColumnPtr& src_col, const uint32_t* indexes,
+                      size_t row_count);
 
     void _copy_joined_rows_with_index_base_build(vectorized::ChunkPtr& chunk, size_t row_count, size_t probe_index,
                                                  size_t build_index);
@@ -105,6 +127,8 @@ private:
     const vectorized::Buffer<SlotDescriptor*>& _col_types;
     const size_t& _probe_column_count;
     const size_t& _build_column_count;
+    // the indexes in _col_types of the columns referenced by _conjunct_ctxs
+    const std::vector<size_t>& _conjunct_column_indexes;
 
     const std::vector<ExprContext*>& _conjunct_ctxs;
 
@@ -140,6 +164,20 @@ private:
 
     std::vector<uint32_t> _buf_selective;
 
+    // used by _pull_tiled_chunk, the first build row and probe row of the next tile.
+    size_t _tile_build_start = 0;
+    size_t _tile_probe_start = 0;
+    vectorized::Column::Filter _tile_filter;
+    // the ranges of the sorted build rows of the current build chunk that the probe rows may join with, if the
+    // conjuncts have a RangeJoinKey.
+    std::vector<uint32_t> _probe_range_begins;
+    std::vector<uint32_t> _probe_range_ends;
+    // the matched pairs of rows of the last tile, they're output from _match_offset.
+    const vectorized::Chunk* _match_build_chunk = nullptr;
+    std::vector<uint32_t> _match_probe_indexes;
+    std::vector<uint32_t> _match_build_indexes;
+    size_t _match_offset = 0;
+
     const std::shared_ptr<CrossJoinContext>& _cross_join_context;
 };
 
@@ -160,7 +198,8 @@ public:
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
         return std::make_shared<CrossJoinLeftOperator>(this, _id, _plan_node_id, _conjunct_ctxs, _col_types,
-                                                       _probe_column_count, _build_column_count, _cross_join_context);
+                                                       _probe_column_count, _build_column_count,
+                                                       _conjunct_column_indexes, _cross_join_context);
     }
 
     Status prepare(RuntimeState* state) override;
@@ -176,6 +215,7 @@ private:
     vectorized::Buffer<SlotDescriptor*> _col_types;
     size_t _probe_column_count = 0;
     size_t _build_column_count = 0;
+    std::vector<size_t> _conjunct_column_indexes;
 
     std::vector<ExprContext*> _conjunct_ctxs;
 
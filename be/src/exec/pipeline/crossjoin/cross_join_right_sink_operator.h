@@ -36,6 +36,8 @@ public:
 
     void set_finishing(RuntimeState* state) override {
         _is_finished = true;
+        // Each sinker sorts its own build chunk, so the build side of a range join is sorted in parallel.
+        _cross_join_context->sort_build_chunk(_driver_sequence);
         // Used to notify cross_join_left_operator.
         _cross_join_context->finish_one_right_sinker();
     }
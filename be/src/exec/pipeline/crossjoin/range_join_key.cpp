@@ -0,0 +1,250 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/crossjoin/range_join_key.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/type_traits.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks::pipeline {
+
+static bool is_range_key_type(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void collect_slot_ids(const RowDescriptor& row_desc, std::unordered_set<SlotId>* slot_ids) {
+    for (auto& tuple_desc : row_desc.tuple_descriptors()) {
+        for (auto& slot : tuple_desc->slots()) {
+            slot_ids->insert(slot->id());
+        }
+    }
+}
+
+static bool get_slot_id(const Expr* expr, SlotId* slot_id) {
+    if (!expr->is_slotref()) {
+        return false;
+    }
+    std::vector<SlotId> slot_ids;
+    expr->get_slot_ids(&slot_ids);
+    if (slot_ids.size() != 1) {
+        return false;
+    }
+    *slot_id = slot_ids[0];
+    return true;
+}
+
+RangeJoinKey RangeJoinKey::create(const std::vector<ExprContext*>& conjunct_ctxs, const RowDescriptor& probe_row_desc,
+                                  const RowDescriptor& build_row_desc) {
+    std::unordered_set<SlotId> probe_slot_ids;
+    std::unordered_set<SlotId> build_slot_ids;
+    collect_slot_ids(probe_row_desc, &probe_slot_ids);
+    collect_slot_ids(build_row_desc, &build_slot_ids);
+
+    std::map<SlotId, RangeJoinKey> keys;
+    for (auto* ctx : conjunct_ctxs) {
+        Expr* expr = ctx->root();
+        if (expr->node_type() != TExprNodeType::BINARY_PRED || expr->get_num_children() != 2) {
+            continue;
+        }
+        SlotId lhs_slot_id;
+        SlotId rhs_slot_id;
+        if (!get_slot_id(expr->get_child(0), &lhs_slot_id) || !get_slot_id(expr->get_child(1), &rhs_slot_id)) {
+            continue;
+        }
+        PrimitiveType type = expr->get_child(0)->type().type;
+        if (type != expr->get_child(1)->type().type || !is_range_key_type(type)) {
+            continue;
+        }
+
+        // as lhs op rhs
+        bool is_lower;
+        bool is_inclusive;
+        switch (expr->op()) {
+        case TExprOpcode::LT:
+            is_lower = false;
+            is_inclusive = false;
+            break;
+        case TExprOpcode::LE:
+            is_lower = false;
+            is_inclusive = true;
+            break;
+        case TExprOpcode::GT:
+            is_lower = true;
+            is_inclusive = false;
+            break;
+        case TExprOpcode::GE:
+            is_lower = true;
+            is_inclusive = true;
+            break;
+        default:
+            continue;
+        }
+
+        SlotId build_slot_id;
+        SlotId probe_slot_id;
+        if (build_slot_ids.count(lhs_slot_id) > 0 && probe_slot_ids.count(rhs_slot_id) > 0) {
+            build_slot_id = lhs_slot_id;
+            probe_slot_id = rhs_slot_id;
+        } else if (probe_slot_ids.count(lhs_slot_id) > 0 && build_slot_ids.count(rhs_slot_id) > 0) {
+            build_slot_id = rhs_slot_id;
+            probe_slot_id = lhs_slot_id;
+            is_lower = !is_lower;
+        } else {
+            continue;
+        }
+
+        RangeJoinKey& key = keys[build_slot_id];
+        key._build_slot_id = build_slot_id;
+        key._type = type;
+        key._bounds.push_back({probe_slot_id, is_lower, is_inclusive});
+    }
+
+    // prefer a key bounded on both sides, whose ranges are the narrowest
+    auto score = [](const RangeJoinKey& key) {
+        bool has_lower = std::any_of(key._bounds.begin(), key._bounds.end(), [](auto& b) { return b.is_lower; });
+        bool has_upper = std::any_of(key._bounds.begin(), key._bounds.end(), [](auto& b) { return !b.is_lower; });
+        return std::make_pair(has_lower && has_upper, key._bounds.size());
+    };
+    RangeJoinKey best;
+    for (auto& [_, key] : keys) {
+        if (!best.is_valid() || score(key) > score(best)) {
+            best = key;
+        }
+    }
+    return best;
+}
+
+template <PrimitiveType Type>
+vectorized::ChunkPtr RangeJoinKey::_sort_build_chunk(const vectorized::ChunkPtr& build_chunk) const {
+    const vectorized::ColumnPtr& key_column = build_chunk->get_column_by_slot_id(_build_slot_id);
+    const auto& keys = down_cast<const vectorized::RunTimeColumnType<Type>*>(
+                               vectorized::ColumnHelper::get_data_column(key_column.get()))
+                               ->get_data();
+
+    std::vector<uint32_t> permutation;
+    permutation.reserve(build_chunk->num_rows());
+    for (uint32_t row = 0; row < build_chunk->num_rows(); row++) {
+        if (!key_column->is_null(row)) {
+            permutation.push_back(row);
+        }
+    }
+    std::stable_sort(permutation.begin(), permutation.end(),
+                     [&keys](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    vectorized::ChunkPtr sorted_chunk = build_chunk->clone_empty_with_slot(permutation.size());
+    sorted_chunk->append_selective(*build_chunk, permutation.data(), 0, permutation.size());
+    return sorted_chunk;
+}
+
+vectorized::ChunkPtr RangeJoinKey::sort_build_chunk(const vectorized::ChunkPtr& build_chunk) const {
+    DCHECK(is_valid());
+    // a constant build column is a single value, which is both the bounds and needs no sort
+    if (build_chunk->get_column_by_slot_id(_build_slot_id)->is_constant()) {
+        return build_chunk;
+    }
+    switch (_type) {
+#define SORT_BUILD_CHUNK(TYPE) \
+    case TYPE:                 \
+        return _sort_build_chunk<TYPE>(build_chunk);
+        SORT_BUILD_CHUNK(TYPE_TINYINT)
+        SORT_BUILD_CHUNK(TYPE_SMALLINT)
+        SORT_BUILD_CHUNK(TYPE_INT)
+        SORT_BUILD_CHUNK(TYPE_BIGINT)
+        SORT_BUILD_CHUNK(TYPE_LARGEINT)
+        SORT_BUILD_CHUNK(TYPE_DATE)
+        SORT_BUILD_CHUNK(TYPE_DATETIME)
+#undef SORT_BUILD_CHUNK
+    default:
+        return build_chunk;
+    }
+}
+
+template <PrimitiveType Type>
+void RangeJoinKey::_probe_ranges(vectorized::Chunk* probe_chunk, vectorized::Chunk* build_chunk,
+                                 std::vector<uint32_t>* begins, std::vector<uint32_t>* ends) const {
+    using CppType = vectorized::RunTimeCppType<Type>;
+    using ColumnType = vectorized::RunTimeColumnType<Type>;
+    const vectorized::ColumnPtr& key_column = build_chunk->get_column_by_slot_id(_build_slot_id);
+    const auto* key_data = down_cast<const ColumnType*>(vectorized::ColumnHelper::get_data_column(key_column.get()));
+    const CppType* keys_begin = key_data->get_data().data();
+    const CppType* keys_end = keys_begin + build_chunk->num_rows();
+
+    const size_t num_probe_rows = probe_chunk->num_rows();
+    begins->assign(num_probe_rows, 0);
+    ends->assign(num_probe_rows, build_chunk->num_rows());
+    for (const auto& bound : _bounds) {
+        const vectorized::ColumnPtr& probe_column = probe_chunk->get_column_by_slot_id(bound.probe_slot_id);
+        const vectorized::Column* data_column = vectorized::ColumnHelper::get_data_column(probe_column.get());
+        // a constant column may be nullable inside
+        data_column = vectorized::ColumnHelper::get_data_column(data_column);
+        const auto& values = down_cast<const ColumnType*>(data_column)->get_data();
+        const bool is_constant = probe_column->is_constant();
+        for (size_t row = 0; row < num_probe_rows; row++) {
+            if (probe_column->is_null(row)) {
+                // no build row is compared true with null
+                (*ends)[row] = (*begins)[row];
+                continue;
+            }
+            const CppType& value = values[is_constant ? 0 : row];
+            if (bound.is_lower) {
+                const CppType* pos = bound.is_inclusive ? std::lower_bound(keys_begin, keys_end, value)
+                                                        : std::upper_bound(keys_begin, keys_end, value);
+                (*begins)[row] = std::max<uint32_t>((*begins)[row], pos - keys_begin);
+            } else {
+                const CppType* pos = bound.is_inclusive ? std::upper_bound(keys_begin, keys_end, value)
+                                                        : std::lower_bound(keys_begin, keys_end, value);
+                (*ends)[row] = std::min<uint32_t>((*ends)[row], pos - keys_begin);
+            }
+        }
+    }
+    for (size_t row = 0; row < num_probe_rows; row++) {
+        (*ends)[row] = std::max((*begins)[row], (*ends)[row]);
+    }
+}
+
+void RangeJoinKey::probe_ranges(vectorized::Chunk* probe_chunk, vectorized::Chunk* build_chunk,
+                                std::vector<uint32_t>* begins, std::vector<uint32_t>* ends) const {
+    DCHECK(is_valid());
+    if (build_chunk->get_column_by_slot_id(_build_slot_id)->is_constant()) {
+        // not sorted, every build row is a candidate
+        begins->assign(probe_chunk->num_rows(), 0);
+        ends->assign(probe_chunk->num_rows(), build_chunk->num_rows());
+        return;
+    }
+    switch (_type) {
+#define PROBE_RANGES(TYPE) \
+    case TYPE:             \
+        return _probe_ranges<TYPE>(probe_chunk, build_chunk, begins, ends);
+        PROBE_RANGES(TYPE_TINYINT)
+        PROBE_RANGES(TYPE_SMALLINT)
+        PROBE_RANGES(TYPE_INT)
+        PROBE_RANGES(TYPE_BIGINT)
+        PROBE_RANGES(TYPE_LARGEINT)
+        PROBE_RANGES(TYPE_DATE)
+        PROBE_RANGES(TYPE_DATETIME)
+#undef PROBE_RANGES
+    default:
+        begins->assign(probe_chunk->num_rows(), 0);
+        ends->assign(probe_chunk->num_rows(), build_chunk->num_rows());
+    }
+}
+
+} // namespace starrocks::pipeline
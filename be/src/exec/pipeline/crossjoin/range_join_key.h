@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/global_types.h"
+#include "runtime/primitive_type.h"
+
+namespace starrocks {
+
+class ExprContext;
+class RowDescriptor;
+
+namespace pipeline {
+
+// RangeJoinKey is a build column that the conjuncts of a cross join compare with the probe columns, e.g. build.ts of
+// `probe.start_ts <= build.ts AND build.ts < probe.end_ts`, or build.start_ts of `probe.ts BETWEEN build.start_ts
+// AND build.end_ts`. With the build rows sorted by it, the build rows that a probe row may join with are a range
+// found by binary search, so a range join costs O((n + m) log m + candidates) instead of O(n * m). The conjuncts are
+// still evaluated over the candidates, the range only skips the rows they can't match.
+class RangeJoinKey {
+public:
+    RangeJoinKey() = default;
+
+    // Pick the build column of the conjuncts bounded by the most probe columns, an invalid key if there is none.
+    // Only the comparisons of two columns of the same integer, date or datetime type are used.
+    static RangeJoinKey create(const std::vector<ExprContext*>& conjunct_ctxs, const RowDescriptor& probe_row_desc,
+                               const RowDescriptor& build_row_desc);
+
+    bool is_valid() const { return _build_slot_id >= 0; }
+
+    SlotId build_slot_id() const { return _build_slot_id; }
+
+    // Sort the rows of |build_chunk| by the key, and drop the rows whose key is null, which match no comparison.
+    vectorized::ChunkPtr sort_build_chunk(const vectorized::ChunkPtr& build_chunk) const;
+
+    // For each row of |probe_chunk|, the range [begins[i], ends[i]) of the rows of the sorted |build_chunk| that
+    // satisfy all the comparisons with the key.
+    void probe_ranges(vectorized::Chunk* probe_chunk, vectorized::Chunk* build_chunk, std::vector<uint32_t>* begins,
+                      std::vector<uint32_t>* ends) const;
+
+private:
+    // build.key > probe.column, build.key >= probe.column and so on.
+    struct Bound {
+        SlotId probe_slot_id;
+        bool is_lower;
+        bool is_inclusive;
+    };
+
+    template <PrimitiveType Type>
+    vectorized::ChunkPtr _sort_build_chunk(const vectorized::ChunkPtr& build_chunk) const;
+
+    template <PrimitiveType Type>
+    void _probe_ranges(vectorized::Chunk* probe_chunk, vectorized::Chunk* build_chunk, std::vector<uint32_t>* begins,
+                       std::vector<uint32_t>* ends) const;
+
+    SlotId _build_slot_id = -1;
+    PrimitiveType _type = INVALID_TYPE;
+    std::vector<Bound> _bounds;
+};
+
+} // namespace pipeline
+} // namespace starrocks
@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/exchange/adaptive_compression.h"
+
+#include "util/block_compression.h"
+
+namespace starrocks::pipeline {
+
+AdaptiveCompression::AdaptiveCompression(CompressionTypePB default_type) {
+    for (size_t i = 0; i < kNumCodecs; ++i) {
+        if (kTypes[i] == default_type) {
+            _default_index = i;
+        }
+    }
+    // No compression costs nothing and keeps the size, no need to sample it.
+    _samples[0].num_samples = 1;
+}
+
+Status AdaptiveCompression::init() {
+    for (size_t i = 0; i < kNumCodecs; ++i) {
+        RETURN_IF_ERROR(get_block_compression_codec(kTypes[i], &_codecs[i]));
+    }
+    return Status::OK();
+}
+
+size_t AdaptiveCompression::choose(double bytes_per_second) {
+    ++_num_chosen;
+    if (bytes_per_second <= 0) {
+        return _default_index;
+    }
+
+    for (size_t i = 0; i < kNumCodecs; ++i) {
+        if (_samples[i].num_samples == 0) {
+            return i;
+        }
+    }
+    if (_num_chosen % kExplorePeriod == 0) {
+        return (_num_chosen / kExplorePeriod) % kNumCodecs;
+    }
+
+    size_t best = 0;
+    for (size_t i = 1; i < kNumCodecs; ++i) {
+        if (estimated_cost(i, bytes_per_second) < estimated_cost(best, bytes_per_second)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void AdaptiveCompression::update(size_t index, size_t uncompressed_bytes, size_t compressed_bytes,
+                                 int64_t compress_ns) {
+    if (uncompressed_bytes == 0) {
+        return;
+    }
+    double ns_per_byte = static_cast<double>(compress_ns) / uncompressed_bytes;
+    double ratio = static_cast<double>(compressed_bytes) / uncompressed_bytes;
+    auto& sample = _samples[index];
+    if (sample.num_samples == 0) {
+        sample.ns_per_byte = ns_per_byte;
+        sample.ratio = ratio;
+    } else {
+        sample.ns_per_byte += kSampleWeight * (ns_per_byte - sample.ns_per_byte);
+        sample.ratio += kSampleWeight * (ratio - sample.ratio);
+    }
+    ++sample.num_samples;
+}
+
+double AdaptiveCompression::estimated_cost(size_t index, double bytes_per_second) const {
+    const auto& sample = _samples[index];
+    return sample.ns_per_byte + sample.ratio * 1e9 / bytes_per_second;
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "common/status.h"
+#include "gen_cpp/types.pb.h"
+
+namespace starrocks {
+
+class BlockCompressionCodec;
+
+namespace pipeline {
+
+// AdaptiveCompression chooses the codec of every chunk to transmit, so that the time to compress and
+// transmit the chunk is minimal.
+//
+// The cost of a codec, in nanoseconds per uncompressed byte, is estimated as
+//     compress_ns_per_byte + compression_ratio * 1e9 / bandwidth
+// where compress_ns_per_byte and compression_ratio (compressed bytes / uncompressed bytes) of each codec
+// are sampled from the chunks it has compressed, and bandwidth is the throughput of the RPCs to the
+// destination, measured by SinkBuffer.
+//
+// Fast links favor no compression or LZ4, and slow links favor ZSTD. Besides the cheapest codec, the
+// others are chosen once every kExplorePeriod chunks to keep their samples up with the data.
+class AdaptiveCompression {
+public:
+    static constexpr size_t kNumCodecs = 3;
+    static constexpr std::array<CompressionTypePB, kNumCodecs> kTypes = {
+            CompressionTypePB::NO_COMPRESSION, CompressionTypePB::LZ4, CompressionTypePB::ZSTD};
+    static constexpr size_t kExplorePeriod = 32;
+
+    // |default_type| is used until the bandwidth of the destination is measured.
+    explicit AdaptiveCompression(CompressionTypePB default_type);
+
+    Status init();
+
+    // Return the index of the codec to compress a chunk sent to the destination with |bytes_per_second|
+    // of bandwidth, 0 means the bandwidth is unknown.
+    size_t choose(double bytes_per_second);
+
+    // Sample the result of compressing |uncompressed_bytes| into |compressed_bytes| in |compress_ns|.
+    void update(size_t index, size_t uncompressed_bytes, size_t compressed_bytes, int64_t compress_ns);
+
+    // Estimated nanoseconds to compress and transmit one uncompressed byte.
+    double estimated_cost(size_t index, double bytes_per_second) const;
+
+    CompressionTypePB type(size_t index) const { return kTypes[index]; }
+    // nullptr for NO_COMPRESSION.
+    const BlockCompressionCodec* codec(size_t index) const { return _codecs[index]; }
+
+private:
+    // Weight of a new sample in the moving averages.
+    static constexpr double kSampleWeight = 0.25;
+
+    struct Sample {
+        double ns_per_byte = 0;
+        double ratio = 1;
+        size_t num_samples = 0;
+    };
+
+    size_t _default_index = 0;
+    std::array<const BlockCompressionCodec*, kNumCodecs> _codecs{};
+    std::array<Sample, kNumCodecs> _samples{};
+    size_t _num_chosen = 0;
+};
+
+} // namespace pipeline
+} // namespace starrocks
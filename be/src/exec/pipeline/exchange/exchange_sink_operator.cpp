@@ -10,11 +10,13 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <random>
 
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exprs/expr.h"
 #include "gen_cpp/Types_types.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/client_cache.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
@@ -29,6 +31,7 @@
 #include "util/compression_utils.h"
 #include "util/debug_util.h"
 #include "util/network_util.h"
+#include "util/stopwatch.hpp"
 #include "util/thrift_client.h"
 #include "util/thrift_util.h"
 
@@ -214,7 +217,8 @@ Status ExchangeSinkOperator::Channel::send_one_chunk(const vectorized::Chunk* ch
                 _chunk_request->add_driver_sequences(driver_sequence);
             }
             auto pchunk = _chunk_request->add_chunks();
-            RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk));
+            RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk, 1,
+                                                     _parent->_buffer->bandwidth(_fragment_instance_id)));
             _current_request_bytes += pchunk->data().size();
         }
     }
@@ -329,6 +333,10 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
         _compress_type = CompressionTypePB::LZ4;
     }
     RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+    if (config::pipeline_exchange_adaptive_compression) {
+        _adaptive_compression = std::make_unique<AdaptiveCompression>(_compress_type);
+        RETURN_IF_ERROR(_adaptive_compression->init());
+    }
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -346,6 +354,16 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
     if (_part_type == TPartitionType::HASH_PARTITIONED ||
         _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) {
         _partitions_columns.resize(_partition_expr_ctxs.size());
+        _skew_sample_interval = std::max<int32_t>(0, config::pipeline_exchange_skew_sample_interval);
+        if (_skew_sample_interval > 0 && _channels.size() > 1) {
+            // a key more frequent than 1/capacity of the rows is kept by the sketch, see SpaceSavingSketch
+            const size_t capacity = std::clamp<size_t>(4 * _channels.size(), 64, 1024);
+            _skew_sketch = std::make_unique<SpaceSavingSketch<uint32_t>>(capacity);
+            _channel_rows.assign(_channels.size(), 0);
+            _hot_keys_counter = ADD_COUNTER(_runtime_profile, "HotKeys", TUnit::UNIT);
+            _max_channel_rows_counter = ADD_COUNTER(_runtime_profile, "MaxChannelRows", TUnit::UNIT);
+            _avg_channel_rows_counter = ADD_COUNTER(_runtime_profile, "AvgChannelRows", TUnit::UNIT);
+        }
     }
 
     // Randomize the order we open/transmit to channels to avoid thundering herd problems.
@@ -361,6 +379,12 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
     _serialize_batch_timer = ADD_TIMER(_runtime_profile, "SerializeBatchTime");
     _shuffle_hash_timer = ADD_TIMER(_runtime_profile, "ShuffleHashTimer");
     _compress_timer = ADD_TIMER(_runtime_profile, "CompressTime");
+    if (_adaptive_compression != nullptr) {
+        for (size_t i = 0; i < AdaptiveCompression::kNumCodecs; ++i) {
+            const auto& name = CompressionTypePB_Name(AdaptiveCompression::kTypes[i]);
+            _adaptive_compress_counters[i] = ADD_COUNTER(_runtime_profile, "ChunksCompressedBy" + name, TUnit::UNIT);
+        }
+    }
     _send_request_timer = ADD_TIMER(_runtime_profile, "SendRequestTime");
     _wait_response_timer = ADD_TIMER(_runtime_profile, "WaitResponseTime");
     _overall_throughput = _runtime_profile->add_derived_counter(
@@ -381,7 +405,8 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
 }
 
 bool ExchangeSinkOperator::is_finished() const {
-    return _is_finished;
+    // The upstream operators stop once all the receivers needn't any more chunks.
+    return _is_finished || _buffer->is_all_receivers_finished();
 }
 
 bool ExchangeSinkOperator::need_input() const {
@@ -428,7 +453,8 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
             // 1. create a new chunk PB to serialize
             ChunkPB* pchunk = _chunk_request->add_chunks();
             // 2. serialize input chunk to pchunk
-            RETURN_IF_ERROR(serialize_chunk(chunk.get(), pchunk, &_is_first_chunk, _channels.size()));
+            RETURN_IF_ERROR(serialize_chunk(chunk.get(), pchunk, &_is_first_chunk, _channels.size(),
+                                            _buffer->min_bandwidth()));
             _current_request_bytes += pchunk->data().size();
             // 3. if request bytes exceede the threshold, send current request
             if (_current_request_bytes > _request_bytes_threshold) {
@@ -465,20 +491,13 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
                 DCHECK(_partitions_columns[i] != nullptr);
             }
 
-            // Compute hash for each partition column
-            if (_part_type == TPartitionType::HASH_PARTITIONED) {
-                _hash_values.assign(num_rows, HashUtil::FNV_SEED);
-                for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                    column->fnv_hash(&_hash_values[0], 0, num_rows);
-                }
-            } else {
-                // The data distribution was calculated using CRC32_HASH,
-                // and bucket shuffle need to use the same hash function when sending data
-                _hash_values.assign(num_rows, 0);
-                for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                    column->crc32_hash(&_hash_values[0], 0, num_rows);
-                }
-            }
+            // Compute hash for each partition column, or reuse the hashes cached by the runtime filters.
+            // The data distribution was calculated using CRC32_HASH,
+            // and bucket shuffle need to use the same hash function when sending data
+            const auto algorithm = _part_type == TPartitionType::HASH_PARTITIONED
+                                           ? vectorized::Chunk::HashAlgorithm::FNV
+                                           : vectorized::Chunk::HashAlgorithm::CRC32;
+            chunk->hash_columns(_partitions_columns, algorithm, &_hash_values);
 
             // Compute row indexes for each channel's each shuffle
             _channel_row_idx_start_points.assign(num_channels * _num_shuffles + 1, 0);
@@ -502,6 +521,17 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
                 _row_indexes[_channel_row_idx_start_points[channel_id * _num_shuffles + driver_sequence] - 1] = i;
                 _channel_row_idx_start_points[channel_id * _num_shuffles + driver_sequence]--;
             }
+
+            if (_skew_sketch != nullptr) {
+                for (; _skew_sample_offset < num_rows; _skew_sample_offset += _skew_sample_interval) {
+                    _skew_sketch->add(_hash_values[_skew_sample_offset]);
+                }
+                _skew_sample_offset -= num_rows;
+                for (size_t i = 0; i < num_channels; ++i) {
+                    _channel_rows[i] += _channel_row_idx_start_points[(i + 1) * _num_shuffles] -
+                                        _channel_row_idx_start_points[i * _num_shuffles];
+                }
+            }
         }
 
         for (int32_t channel_id : _channel_indices) {
@@ -525,8 +555,37 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
     return Status::OK();
 }
 
+void ExchangeSinkOperator::_report_skew() {
+    if (_skew_sketch == nullptr || _skew_sketch->total() == 0) {
+        return;
+    }
+    const size_t num_channels = _channels.size();
+    const int64_t total_rows = std::accumulate(_channel_rows.begin(), _channel_rows.end(), int64_t(0));
+    COUNTER_SET(_max_channel_rows_counter, *std::max_element(_channel_rows.begin(), _channel_rows.end()));
+    COUNTER_SET(_avg_channel_rows_counter, total_rows / static_cast<int64_t>(num_channels));
+
+    // A hot key takes more than a receiver's share of the rows by itself.
+    const int64_t total = _skew_sketch->total();
+    auto hot_keys = _skew_sketch->heavy_hitters(total / num_channels);
+    COUNTER_SET(_hot_keys_counter, static_cast<int64_t>(hot_keys.size()));
+    if (hot_keys.empty()) {
+        return;
+    }
+    static constexpr size_t kMaxReportedHotKeys = 8;
+    std::string hot_key_shares;
+    for (size_t i = 0; i < hot_keys.size() && i < kMaxReportedHotKeys; ++i) {
+        if (!hot_key_shares.empty()) {
+            hot_key_shares += ", ";
+        }
+        hot_key_shares += strings::Substitute("channel $0: $1%", hot_keys[i].key % num_channels,
+                                              hot_keys[i].count * 100 / total);
+    }
+    _runtime_profile->add_info_string("HotKeyShares", hot_key_shares);
+}
+
 void ExchangeSinkOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
+    _report_skew();
 
     if (_chunk_request != nullptr) {
         butil::IOBuf attachment;
@@ -552,7 +611,7 @@ Status ExchangeSinkOperator::close(RuntimeState* state) {
 }
 
 Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst, bool* is_first_chunk,
-                                             int num_receivers) {
+                                             int num_receivers, double bytes_per_second) {
     VLOG_ROW << "[ExchangeSinkOperator] serializing " << src->num_rows() << " rows";
     {
         SCOPED_TIMER(_serialize_batch_timer);
@@ -572,29 +631,45 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
     DCHECK_EQ(dst->uncompressed_size(), dst->data().size());
     const size_t uncompressed_size = dst->uncompressed_size();
 
-    if (_compress_codec != nullptr && _compress_codec->exceed_max_input_size(uncompressed_size)) {
+    CompressionTypePB compress_type = _compress_type;
+    const BlockCompressionCodec* compress_codec = _compress_codec;
+    size_t codec_index = 0;
+    if (_adaptive_compression != nullptr) {
+        codec_index = _adaptive_compression->choose(bytes_per_second);
+        compress_type = _adaptive_compression->type(codec_index);
+        compress_codec = _adaptive_compression->codec(codec_index);
+        COUNTER_UPDATE(_adaptive_compress_counters[codec_index], 1);
+    }
+
+    if (compress_codec != nullptr && compress_codec->exceed_max_input_size(uncompressed_size)) {
         return Status::InternalError("The input size for compression should be less than " +
-                                     _compress_codec->max_input_size());
+                                     compress_codec->max_input_size());
     }
 
     // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    if (compress_codec != nullptr && uncompressed_size > 0) {
         SCOPED_TIMER(_compress_timer);
+        MonotonicStopWatch watch;
+        watch.start();
 
         // Try compressing data to _compression_scratch, swap if compressed data is smaller
-        int max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
+        int max_compressed_size = compress_codec->max_compressed_len(uncompressed_size);
 
         if (_compression_scratch.size() < max_compressed_size) {
             _compression_scratch.resize(max_compressed_size);
         }
 
         Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
-        _compress_codec->compress(dst->data(), &compressed_slice);
+        compress_codec->compress(dst->data(), &compressed_slice);
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
         if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
             _compression_scratch.resize(compressed_slice.size);
             dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
-            dst->set_compress_type(_compress_type);
+            dst->set_compress_type(compress_type);
+        }
+        if (_adaptive_compression != nullptr) {
+            // Sample the bytes really sent, which are uncompressed if the compression ratio is too low.
+            _adaptive_compression->update(codec_index, uncompressed_size, dst->data().size(), watch.elapsed_time());
         }
 
         VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
@@ -9,6 +9,7 @@
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/data_sink.h"
+#include "exec/pipeline/exchange/adaptive_compression.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/operator.h"
@@ -16,6 +17,7 @@
 #include "gen_cpp/internal_service.pb.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
+#include "util/space_saving_sketch.h"
 
 namespace butil {
 class IOBuf;
@@ -61,7 +63,9 @@ public:
 
     // For the first chunk , serialize the chunk data and meta to ChunkPB both.
     // For other chunk, only serialize the chunk data to ChunkPB.
-    Status serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, int num_receivers = 1);
+    // |bytes_per_second| is the measured bandwidth to the receivers, used by the adaptive compression.
+    Status serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, int num_receivers = 1,
+                           double bytes_per_second = 0);
 
     void construct_brpc_attachment(PTransmitChunkParamsPtr _chunk_request, butil::IOBuf& attachment);
 
@@ -70,6 +74,9 @@ private:
 
     static const int32_t DEFAULT_DRIVER_SEQUENCE = 0;
 
+    // Report the hot keys and the rows of the channels in the profile.
+    void _report_skew();
+
     const std::shared_ptr<SinkBuffer>& _buffer;
 
     const TPartitionType::type _part_type;
@@ -114,6 +121,8 @@ private:
 
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
     const BlockCompressionCodec* _compress_codec = nullptr;
+    // Not null if config::pipeline_exchange_adaptive_compression is true.
+    std::unique_ptr<AdaptiveCompression> _adaptive_compression;
 
     // Because we should close all channels even if fail to close some channel.
     // We use a global _close_status to record the error close status.
@@ -123,6 +132,8 @@ private:
     RuntimeProfile::Counter* _serialize_batch_timer = nullptr;
     RuntimeProfile::Counter* _shuffle_hash_timer = nullptr;
     RuntimeProfile::Counter* _compress_timer = nullptr;
+    // Number of chunks compressed by each codec of the adaptive compression.
+    std::array<RuntimeProfile::Counter*, AdaptiveCompression::kNumCodecs> _adaptive_compress_counters{};
     RuntimeProfile::Counter* _bytes_sent_counter = nullptr;
     RuntimeProfile::Counter* _bytes_pass_through_counter = nullptr;
     RuntimeProfile::Counter* _uncompressed_bytes_counter = nullptr;
@@ -153,6 +164,16 @@ private:
     // the last.
     std::vector<uint32_t> _row_indexes;
 
+    // The sampled hashes of the hash shuffle, the hash of a hot key is a hot hash too, which identifies its channel.
+    std::unique_ptr<SpaceSavingSketch<uint32_t>> _skew_sketch;
+    size_t _skew_sample_interval = 0;
+    // The next row to sample in the next chunk.
+    size_t _skew_sample_offset = 0;
+    std::vector<int64_t> _channel_rows;
+    RuntimeProfile::Counter* _hot_keys_counter = nullptr;
+    RuntimeProfile::Counter* _max_channel_rows_counter = nullptr;
+    RuntimeProfile::Counter* _avg_channel_rows_counter = nullptr;
+
     FragmentContext* const _fragment_ctx;
 };
 
@@ -17,20 +17,13 @@ Status PartitionExchanger::Partitioner::partition_chunk(const vectorized::ChunkP
         DCHECK(_partitions_columns[i] != nullptr);
     }
 
-    // Compute hash for each partition column
-    if (_part_type == TPartitionType::HASH_PARTITIONED) {
-        _hash_values.assign(num_rows, HashUtil::FNV_SEED);
-        for (const vectorized::ColumnPtr& column : _partitions_columns) {
-            column->fnv_hash(&_hash_values[0], 0, num_rows);
-        }
-    } else {
-        // The data distribution was calculated using CRC32_HASH,
-        // and bucket shuffle need to use the same hash function when sending data
-        _hash_values.assign(num_rows, 0);
-        for (const vectorized::ColumnPtr& column : _partitions_columns) {
-            column->crc32_hash(&_hash_values[0], 0, num_rows);
-        }
-    }
+    // Compute hash for each partition column, or reuse the hashes cached by the runtime filters.
+    // The data distribution was calculated using CRC32_HASH,
+    // and bucket shuffle need to use the same hash function when sending data
+    const auto algorithm = _part_type == TPartitionType::HASH_PARTITIONED
+                                   ? vectorized::Chunk::HashAlgorithm::FNV
+                                   : vectorized::Chunk::HashAlgorithm::CRC32;
+    chunk->hash_columns(_partitions_columns, algorithm, &_hash_values);
 
     // Compute row indexes for each channel.
     _partition_row_indexes_start_points.assign(num_partitions + 1, 0);
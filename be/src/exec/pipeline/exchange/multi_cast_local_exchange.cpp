@@ -2,6 +2,8 @@
 
 #include "exec/pipeline/exchange/multi_cast_local_exchange.h"
 
+#include "exec/vectorized/spill_file.h"
+#include "runtime/runtime_state.h"
 #include "util/logging.h"
 
 namespace starrocks {
@@ -26,6 +28,10 @@ MultiCastLocalExchanger::MultiCastLocalExchanger(RuntimeState* runtime_state, si
     _runtime_profile = std::make_unique<RuntimeProfile>("MultiCastLocalExchanger");
     _peak_memory_usage_counter = _runtime_profile->AddHighWaterMarkCounter("PeakMemoryUsage", TUnit::BYTES);
     _peak_buffer_row_size_counter = _runtime_profile->AddHighWaterMarkCounter("PeakBufferRowSize", TUnit::UNIT);
+    if (runtime_state->enable_spill()) {
+        _enable_spill = true;
+        _spill_mem_threshold = vectorized::spill_mem_threshold(runtime_state->instance_mem_tracker());
+    }
 }
 
 MultiCastLocalExchanger::~MultiCastLocalExchanger() {
@@ -56,8 +62,12 @@ Status MultiCastLocalExchanger::push_chunk(const vectorized::ChunkPtr& chunk, in
     cell->chunk = chunk;
     cell->memory_usage = chunk->memory_usage();
 
+    std::vector<Cell*> cells_to_spill;
     {
         std::unique_lock l(_mutex);
+        if (_prototype == nullptr) {
+            _prototype = chunk->clone_empty_with_slot();
+        }
 
         int32_t closed_source_number = (_consumer_number - _opened_source_number);
 
@@ -73,11 +83,76 @@ Status MultiCastLocalExchanger::push_chunk(const vectorized::ChunkPtr& chunk, in
         _peak_memory_usage_counter->set(_current_memory_usage);
         _peak_buffer_row_size_counter->set(_current_row_size);
         sink_operator->update_counter(_current_memory_usage, _current_row_size);
+
+        if (_enable_spill && !_is_spilling && vectorized::should_spill(_current_memory_usage, _spill_mem_threshold)) {
+            cells_to_spill = _pick_cells_to_spill();
+            _is_spilling = !cells_to_spill.empty();
+        }
     }
 
+    if (!cells_to_spill.empty()) {
+        return _spill(cells_to_spill);
+    }
     return Status::OK();
 }
 
+std::vector<MultiCastLocalExchanger::Cell*> MultiCastLocalExchanger::_pick_cells_to_spill() {
+    std::vector<Cell*> candidates;
+    for (Cell* cell = _head->next; cell != nullptr && cell->accumulated_row_size < _fast_accumulated_row_size;
+         cell = cell->next) {
+        if (cell->chunk != nullptr && cell->used_count < _consumer_number) {
+            candidates.push_back(cell);
+        }
+    }
+    // Spill until the buffered chunks drop to a half of the threshold.
+    int64_t bytes_to_spill = static_cast<int64_t>(_current_memory_usage) - _spill_mem_threshold / 2;
+    size_t first = candidates.size();
+    while (first > 0 && bytes_to_spill > 0) {
+        --first;
+        bytes_to_spill -= candidates[first]->memory_usage;
+    }
+    std::vector<Cell*> cells(candidates.begin() + first, candidates.end());
+    for (Cell* cell : cells) {
+        cell->spilling = true;
+    }
+    return cells;
+}
+
+Status MultiCastLocalExchanger::_spill(const std::vector<Cell*>& cells) {
+    // The cells marked spilling are neither released nor modified by the others, so the chunks are written out of
+    // the lock.
+    auto st = [&]() -> Status {
+        ASSIGN_OR_RETURN(auto file, vectorized::SpillFile::create("mcast"));
+        std::vector<uint64_t> offsets;
+        offsets.reserve(cells.size());
+        for (Cell* cell : cells) {
+            offsets.push_back(file->append_offset());
+            RETURN_IF_ERROR(file->append(*cell->chunk));
+        }
+        RETURN_IF_ERROR(file->flip_to_read());
+        std::shared_ptr<vectorized::SpillFile> spill_file(std::move(file));
+
+        std::unique_lock l(_mutex);
+        for (size_t i = 0; i < cells.size(); ++i) {
+            Cell* cell = cells[i];
+            cell->spill_file = spill_file;
+            cell->spill_offset = offsets[i];
+            cell->chunk.reset();
+            _current_memory_usage -= cell->memory_usage;
+            cell->memory_usage = 0;
+        }
+        return Status::OK();
+    }();
+
+    std::unique_lock l(_mutex);
+    for (Cell* cell : cells) {
+        cell->spilling = false;
+    }
+    _is_spilling = false;
+    _update_progress();
+    return st;
+}
+
 bool MultiCastLocalExchanger::can_pull_chunk(int32_t mcast_consumer_index) const {
     DCHECK(mcast_consumer_index < _consumer_number);
 
@@ -102,14 +177,22 @@ StatusOr<vectorized::ChunkPtr> MultiCastLocalExchanger::pull_chunk(RuntimeState*
         return Status::OK();
     }
     cell = cell->next;
-    VLOG_FILE << "MultiCastLocalExchanger: return chunk to " << mcast_consumer_index
-              << ", row = " << cell->chunk->debug_row(0) << ", size = " << cell->chunk->num_rows();
 
     _progress[mcast_consumer_index] = cell;
     cell->used_count += 1;
 
+    vectorized::ChunkPtr chunk = cell->chunk;
+    std::shared_ptr<vectorized::SpillFile> spill_file = cell->spill_file;
+    uint64_t spill_offset = cell->spill_offset;
     _update_progress(cell);
-    return cell->chunk;
+    if (chunk != nullptr) {
+        VLOG_FILE << "MultiCastLocalExchanger: return chunk to " << mcast_consumer_index
+                  << ", row = " << chunk->debug_row(0) << ", size = " << chunk->num_rows();
+        return chunk;
+    }
+    // read the spilled chunk out of the lock
+    l.unlock();
+    return spill_file->read_at(spill_offset, *_prototype);
 }
 
 void MultiCastLocalExchanger::open_source_operator(int32_t mcast_consumer_index) {
@@ -160,10 +243,10 @@ void MultiCastLocalExchanger::_update_progress(Cell* fast) {
             _fast_accumulated_row_size = std::max(_fast_accumulated_row_size, c->accumulated_row_size);
         }
     }
-    // release chunk if no one needs it.
-    while (_head && _head->used_count == _consumer_number) {
+    // release chunk if no one needs it. The head is the cell all the consumers have consumed, some of them may still
+    // point to it, so it's released only after all of them have consumed the next one.
+    while (_head->next != nullptr && _head->next->used_count == _consumer_number && !_head->spilling) {
         Cell* t = _head->next;
-        if (t == nullptr) break;
         _current_memory_usage -= _head->memory_usage;
         delete _head;
         _head = t;
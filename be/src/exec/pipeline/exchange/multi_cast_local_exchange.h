@@ -4,6 +4,10 @@
 #include "exec/pipeline/source_operator.h"
 
 namespace starrocks {
+namespace vectorized {
+class SpillFile;
+}
+
 namespace pipeline {
 
 // For uni cast stream sink, we just add a exchange sink operator
@@ -26,6 +30,9 @@ namespace pipeline {
 // 1. can accept chunk or not. we don't want to block any consumer. we can accept chunk only when a any consumer needs chunk.
 // 2. can throw chunk or not. we can only throw any chunk when all consumers have consumed that chunk.
 // 3. can pull chiunk. we maintain the progress of consumers.
+// 4. the chunks are shared by all the consumers without copy. If spilling is enabled, once the chunks buffered
+//    for the slower consumers exceed the spill threshold, the ones the fastest consumer has consumed are spilled,
+//    and read back by each of the slower consumers.
 
 class MultiCastLocalExchangeSinkOperator;
 // ===== exchanger =====
@@ -52,9 +59,18 @@ private:
         size_t accumulated_row_size = 0;
         // how many consumers have used this chunk
         int32_t used_count = 0;
+        // the chunk is in spill_file at spill_offset if it's spilled, and chunk is nullptr then.
+        std::shared_ptr<vectorized::SpillFile> spill_file;
+        uint64_t spill_offset = 0;
+        // the cell is being spilled, it's not released until the spill is done.
+        bool spilling = false;
     };
     void _update_progress(Cell* fast = nullptr);
     void _closer_consumer(int32_t mcast_consumer_index);
+    // The cells to spill, which the fastest consumer has consumed, the latest ones first since they are read last
+    // by the slower consumers.
+    std::vector<Cell*> _pick_cells_to_spill();
+    Status _spill(const std::vector<Cell*>& cells);
     RuntimeState* _runtime_state;
     mutable std::mutex _mutex;
     size_t _consumer_number;
@@ -72,6 +88,12 @@ private:
     std::unique_ptr<RuntimeProfile> _runtime_profile;
     RuntimeProfile::HighWaterMarkCounter* _peak_memory_usage_counter = nullptr;
     RuntimeProfile::HighWaterMarkCounter* _peak_buffer_row_size_counter = nullptr;
+
+    bool _enable_spill = false;
+    int64_t _spill_mem_threshold = 0;
+    bool _is_spilling = false;
+    // the chunks are read back from the spill files by its layout.
+    vectorized::ChunkPtr _prototype;
 };
 
 // ===== source op =====
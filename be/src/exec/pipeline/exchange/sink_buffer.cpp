@@ -2,6 +2,9 @@
 
 #include "exec/pipeline/exchange/sink_buffer.h"
 
+#include "exec/pipeline/pipeline_driver_poller.h"
+#include "util/time.h"
+
 namespace starrocks::pipeline {
 
 SinkBuffer::SinkBuffer(FragmentContext* fragment_ctx, const std::vector<TPlanFragmentDestination>& destinations,
@@ -28,10 +31,14 @@ SinkBuffer::SinkBuffer(FragmentContext* fragment_ctx, const std::vector<TPlanFra
             // request_seq starts from 0, so the max_continuous_acked_seq should be -1
             _max_continuous_acked_seqs[instance_id.lo] = -1;
             _discontinuous_acked_seqs[instance_id.lo] = std::unordered_set<int64_t>();
-            _buffers[instance_id.lo] = std::queue<TransmitChunkInfo, std::list<TransmitChunkInfo>>();
+            _buffers[instance_id.lo] = std::deque<TransmitChunkInfo>();
             _num_finished_rpcs[instance_id.lo] = 0;
             _num_in_flight_rpcs[instance_id.lo] = 0;
             _mutexes[instance_id.lo] = std::make_unique<std::mutex>();
+            _bandwidths[instance_id.lo] = 0;
+            _credits[instance_id.lo] = -1;
+            _in_flight_bytes[instance_id.lo] = 0;
+            _receiver_finished[instance_id.lo] = false;
 
             PUniqueId finst_id;
             finst_id.set_hi(instance_id.hi);
@@ -59,7 +66,7 @@ SinkBuffer::~SinkBuffer() {
             // Once the request is added to SinkBuffer, its ownership will also be transferred,
             // so SinkBuffer needs to be responsible for the release of resources
             request.params->release_finst_id();
-            buffer.pop();
+            buffer.pop_front();
         }
     }
 }
@@ -75,13 +82,13 @@ void SinkBuffer::add_request(const TransmitChunkInfo& request) {
     {
         auto& instance_id = request.fragment_instance_id;
         std::lock_guard<std::mutex> l(*_mutexes[instance_id.lo]);
-        _buffers[instance_id.lo].push(request);
+        _buffers[instance_id.lo].push_back(request);
         _try_to_send_rpc(instance_id);
     }
 }
 
 bool SinkBuffer::is_full() const {
-    // std::queue' read is concurrent safe without mutex
+    // std::deque' read is concurrent safe without mutex
     // Judgement may not that accurate because we do not known in advance which
     // instance the data to be sent corresponds to
     size_t max_buffer_size = config::pipeline_sink_buffer_size * _buffers.size();
@@ -108,6 +115,74 @@ void SinkBuffer::cancel_one_sinker() {
     }
 }
 
+double SinkBuffer::bandwidth(const TUniqueId& instance_id) const {
+    auto it = _bandwidths.find(instance_id.lo);
+    if (it == _bandwidths.end()) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> l(*_mutexes.at(instance_id.lo));
+    return it->second;
+}
+
+double SinkBuffer::min_bandwidth() const {
+    double min_bandwidth = 0;
+    for (const auto& [instance_id_lo, _] : _bandwidths) {
+        std::lock_guard<std::mutex> l(*_mutexes.at(instance_id_lo));
+        double bandwidth = _bandwidths.at(instance_id_lo);
+        if (bandwidth > 0 && (min_bandwidth == 0 || bandwidth < min_bandwidth)) {
+            min_bandwidth = bandwidth;
+        }
+    }
+    return min_bandwidth;
+}
+
+void SinkBuffer::_update_bandwidth(const ClosureContext& ctx) {
+    // The latency of the small requests is dominated by the fixed overhead of RPC rather than the bandwidth.
+    static constexpr size_t kMinSampleBytes = 16 * 1024;
+    static constexpr double kSampleWeight = 0.25;
+    int64_t elapsed_ns = MonotonicNanos() - ctx.send_timestamp;
+    if (ctx.attachment_bytes < kMinSampleBytes || elapsed_ns <= 0) {
+        return;
+    }
+    double sample = ctx.attachment_bytes * 1e9 / elapsed_ns;
+    double& bandwidth = _bandwidths[ctx.instance_id.lo];
+    bandwidth = bandwidth == 0 ? sample : bandwidth + kSampleWeight * (sample - bandwidth);
+}
+
+bool SinkBuffer::_exceeds_credit(const TUniqueId& instance_id, const TransmitChunkInfo& request) {
+    int64_t credit = _credits[instance_id.lo];
+    if (!config::pipeline_sink_credit_flow_control || credit < 0 || _num_in_flight_rpcs[instance_id.lo] == 0) {
+        return false;
+    }
+    return static_cast<int64_t>(request.attachment.size()) > credit;
+}
+
+void SinkBuffer::_update_credit(const ClosureContext& ctx, const PTransmitChunkResult& result) {
+    int64_t& in_flight_bytes = _in_flight_bytes[ctx.instance_id.lo];
+    in_flight_bytes -= ctx.attachment_bytes;
+    if (result.has_credit_bytes()) {
+        // The credit is granted when the request is added, the requests sent after it are not counted yet.
+        _credits[ctx.instance_id.lo] = std::max<int64_t>(0, result.credit_bytes() - in_flight_bytes);
+    }
+}
+
+void SinkBuffer::_drop_requests(const TUniqueId& instance_id) {
+    auto& buffer = _buffers[instance_id.lo];
+    while (!buffer.empty()) {
+        auto& request = buffer.front();
+        if (request.params->eos()) {
+            --_num_sinkers[instance_id.lo];
+            if (--_num_remaining_eos == 0) {
+                _is_finishing = true;
+            }
+        }
+        // Once the request is added to SinkBuffer, its ownership will also be transferred,
+        // so SinkBuffer needs to be responsible for the release of resources
+        request.params->release_finst_id();
+        buffer.pop_front();
+    }
+}
+
 void SinkBuffer::_process_send_window(const TUniqueId& instance_id, const int64_t sequence) {
     // Both sender side and receiver side can tolerate disorder of tranmission
     // if receiver side is not ExchangeMergeSortSourceOperator
@@ -124,6 +199,42 @@ void SinkBuffer::_process_send_window(const TUniqueId& instance_id, const int64_
     }
 }
 
+void SinkBuffer::_coalesce_requests(TransmitChunkInfo* request, std::deque<TransmitChunkInfo>* buffer,
+                                    int64_t max_bytes) {
+    // ExchangeMergeSortSourceOperator keeps the order of the chunks by the sequences of the requests.
+    if (_is_dest_merge || max_bytes <= 0) {
+        return;
+    }
+    auto& params = request->params;
+    const bool is_pipeline_level_shuffle = params->is_pipeline_level_shuffle();
+
+    // The request is a copy of the front one, the followers start from the second one.
+    auto it = buffer->begin() + 1;
+    for (; it != buffer->end(); ++it) {
+        const auto& follower = it->params;
+        // EOS must be handled by _try_to_send_rpc, it's always the last request of a sinker.
+        if (follower->eos()) {
+            break;
+        }
+        if (follower->use_pass_through() != params->use_pass_through() ||
+            follower->is_pipeline_level_shuffle() != is_pipeline_level_shuffle) {
+            break;
+        }
+        if (request->attachment.size() + it->attachment.size() > static_cast<size_t>(max_bytes)) {
+            break;
+        }
+        // The pass through requests carry no chunks, the receiver fetches all the chunks of the sender from
+        // PassThroughChunkBuffer once it receives any of them, so merging them is just dropping the followers.
+        params->mutable_chunks()->MergeFrom(follower->chunks());
+        if (is_pipeline_level_shuffle) {
+            params->mutable_driver_sequences()->MergeFrom(follower->driver_sequences());
+        }
+        // Appending an IOBuf to another one just shares the underlying blocks, without copying the data.
+        request->attachment.append(it->attachment);
+    }
+    buffer->erase(buffer->begin() + 1, it);
+}
+
 void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
     DeferOp decrease_defer([this]() { --_num_sending_rpc; });
     ++_num_sending_rpc;
@@ -133,6 +244,11 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
             return;
         }
 
+        if (_receiver_finished[instance_id.lo]) {
+            _drop_requests(instance_id);
+            return;
+        }
+
         auto& buffer = _buffers[instance_id.lo];
 
         bool too_much_brpc_process = false;
@@ -156,7 +272,7 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
             if (need_wait) {
                 return;
             }
-            buffer.pop();
+            buffer.pop_front();
         });
 
         // The order of data transmiting in IO level may not be strictly the same as
@@ -166,6 +282,10 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
             need_wait = true;
             return;
         }
+        if (_exceeds_credit(instance_id, request)) {
+            need_wait = true;
+            return;
+        }
         if (request.params->eos()) {
             DeferOp eos_defer([this, &instance_id, &need_wait]() {
                 if (need_wait) {
@@ -199,11 +319,21 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
             }
         }
 
+        if (!request.params->eos()) {
+            // The merged request stays within the credit too.
+            int64_t max_bytes = config::pipeline_sink_coalesce_max_bytes;
+            int64_t credit = _credits[instance_id.lo];
+            if (config::pipeline_sink_credit_flow_control && credit >= 0) {
+                max_bytes = std::min(max_bytes, std::max<int64_t>(credit, request.attachment.size()));
+            }
+            _coalesce_requests(&request, &buffer, max_bytes);
+        }
+
         request.params->set_allocated_finst_id(&_instance_id2finst_id[instance_id.lo]);
         request.params->set_sequence(_request_seqs[instance_id.lo]++);
 
-        auto* closure =
-                new DisposableClosure<PTransmitChunkResult, ClosureContext>({instance_id, request.params->sequence()});
+        auto* closure = new DisposableClosure<PTransmitChunkResult, ClosureContext>(
+                {instance_id, request.params->sequence(), MonotonicNanos(), request.attachment.size()});
         closure->addFailedHandler([this](const ClosureContext& ctx) noexcept {
             _is_finishing = true;
             {
@@ -214,6 +344,7 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
             --_total_in_flight_rpc;
             _fragment_ctx->cancel(Status::InternalError("transmit chunk rpc failed"));
             LOG(WARNING) << "transmit chunk rpc failed";
+            notify_blocked_drivers();
         });
         closure->addSuccessHandler([this](const ClosureContext& ctx, const PTransmitChunkResult& result) noexcept {
             Status status(result.status());
@@ -221,6 +352,7 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
                 std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
                 ++_num_finished_rpcs[ctx.instance_id.lo];
                 --_num_in_flight_rpcs[ctx.instance_id.lo];
+                _update_credit(ctx, result);
             }
             if (!status.ok()) {
                 _is_finishing = true;
@@ -228,14 +360,26 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
                 LOG(WARNING) << "transmit chunk rpc failed, " << status.message();
             } else {
                 std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
+                if (result.receiver_finished() && !_receiver_finished[ctx.instance_id.lo]) {
+                    _receiver_finished[ctx.instance_id.lo] = true;
+                    ++_num_finished_receivers;
+                }
+                _update_bandwidth(ctx);
                 _process_send_window(ctx.instance_id, ctx.sequence);
                 _try_to_send_rpc(ctx.instance_id);
             }
             --_total_in_flight_rpc;
+            // The exchange sink operators waiting for the in-flight RPCs may be ready now.
+            notify_blocked_drivers();
         });
 
         ++_total_in_flight_rpc;
         ++_num_in_flight_rpcs[instance_id.lo];
+        _in_flight_bytes[instance_id.lo] += request.attachment.size();
+        int64_t& credit = _credits[instance_id.lo];
+        if (credit >= 0) {
+            credit = std::max<int64_t>(0, credit - request.attachment.size());
+        }
 
         closure->cntl.Reset();
         closure->cntl.set_timeout_ms(_brpc_timeout_ms);
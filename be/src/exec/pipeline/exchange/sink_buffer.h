@@ -3,10 +3,9 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
 #include <future>
-#include <list>
 #include <mutex>
-#include <queue>
 #include <unordered_set>
 
 #include "column/chunk.h"
@@ -36,6 +35,8 @@ struct TransmitChunkInfo {
 struct ClosureContext {
     TUniqueId instance_id;
     int64_t sequence;
+    int64_t send_timestamp;
+    size_t attachment_bytes;
 };
 
 // TODO(hcf) how to export brpc error
@@ -48,11 +49,22 @@ public:
     void add_request(const TransmitChunkInfo& request);
     bool is_full() const;
     bool is_finished() const;
+    // Whether all the receivers are closed before the senders finish, e.g. their limits are reached, so the
+    // sinkers needn't input any more chunks.
+    bool is_all_receivers_finished() const {
+        return !_receiver_finished.empty() && _num_finished_receivers == _receiver_finished.size();
+    }
 
     // When all the ExchangeSinkOperator shared this SinkBuffer are cancelled,
     // the rest chunk request and EOS request needn't be sent anymore.
     void cancel_one_sinker();
 
+    // Moving average of the throughput (bytes per second) of the RPCs to the destination,
+    // 0 if it's not measured yet.
+    double bandwidth(const TUniqueId& instance_id) const;
+    // The minimum bandwidth of all the measured destinations, 0 if none is measured yet.
+    double min_bandwidth() const;
+
 private:
     // Update the discontinuous acked window, here are the invariants:
     // all acks received with sequence from [0, _max_continuous_acked_seqs[x]]
@@ -60,6 +72,21 @@ private:
     // _discontinuous_acked_seqs[x] stored the received discontinuous acks
     void _process_send_window(const TUniqueId& instance_id, const int64_t sequence);
     void _try_to_send_rpc(const TUniqueId& instance_id);
+    // Merge the requests following |request| in |buffer| into |request|, so that the requests piled up
+    // behind the in-flight RPCs of a destination are sent by one RPC instead of one RPC for each.
+    // The merged requests are removed from |buffer|, and the front of |buffer| is still |request|.
+    void _coalesce_requests(TransmitChunkInfo* request, std::deque<TransmitChunkInfo>* buffer, int64_t max_bytes);
+    // Whether the request must wait for the credit of the destination, see PTransmitChunkResult::credit_bytes.
+    // At least one request is always in flight, so that the credit is refreshed by its response.
+    // Must be called with the mutex of the destination held.
+    bool _exceeds_credit(const TUniqueId& instance_id, const TransmitChunkInfo& request);
+    // Must be called with the mutex of the destination held.
+    void _update_credit(const ClosureContext& ctx, const PTransmitChunkResult& result);
+    // Must be called with the mutex of the destination held.
+    void _update_bandwidth(const ClosureContext& ctx);
+    // Drops the requests to the finished receiver of |instance_id|, the eos ones are counted as sent.
+    // Must be called with the mutex of the destination held.
+    void _drop_requests(const TUniqueId& instance_id);
 
     FragmentContext* _fragment_ctx;
     const MemTracker* _mem_tracker;
@@ -88,10 +115,17 @@ private:
     // The request needs the reference to the allocated finst id,
     // so cache finst id for each dest fragment instance.
     phmap::flat_hash_map<int64_t, PUniqueId> _instance_id2finst_id;
-    phmap::flat_hash_map<int64_t, std::queue<TransmitChunkInfo, std::list<TransmitChunkInfo>>> _buffers;
+    phmap::flat_hash_map<int64_t, std::deque<TransmitChunkInfo>> _buffers;
     phmap::flat_hash_map<int64_t, int32_t> _num_finished_rpcs;
     phmap::flat_hash_map<int64_t, int32_t> _num_in_flight_rpcs;
     phmap::flat_hash_map<int64_t, std::unique_ptr<std::mutex>> _mutexes;
+    phmap::flat_hash_map<int64_t, double> _bandwidths;
+    // The bytes still allowed in flight to the destination, -1 if the receiver hasn't granted any credit.
+    phmap::flat_hash_map<int64_t, int64_t> _credits;
+    phmap::flat_hash_map<int64_t, int64_t> _in_flight_bytes;
+    // Whether the receiver is closed, see PTransmitChunkResult::receiver_finished.
+    phmap::flat_hash_map<int64_t, bool> _receiver_finished;
+    std::atomic<size_t> _num_finished_receivers = 0;
 
     // True means that SinkBuffer needn't input chunk and send chunk anymore,
     // but there may be still in-flight RPC running.
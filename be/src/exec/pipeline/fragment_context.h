@@ -4,6 +4,7 @@
 
 #include <unordered_map>
 
+#include "common/config.h"
 #include "exec/exec_node.h"
 #include "exec/pipeline/morsel.h"
 #include "exec/pipeline/pipeline.h"
@@ -19,6 +20,7 @@
 #include "runtime/runtime_filter_worker.h"
 #include "runtime/runtime_state.h"
 #include "util/hash_util.hpp"
+#include "util/stopwatch.hpp"
 namespace starrocks {
 namespace pipeline {
 
@@ -27,7 +29,7 @@ class FragmentContext {
     friend FragmentContextManager;
 
 public:
-    FragmentContext() : _cancel_flag(false) {}
+    FragmentContext() : _cancel_flag(false) { _lifetime_sw.start(); }
     ~FragmentContext() {
         auto runtime_state_ptr = _runtime_state;
         _runtime_filter_hub.close_all_in_filters(runtime_state_ptr.get());
@@ -47,6 +49,13 @@ public:
     const TNetworkAddress& fe_addr() { return _fe_addr; }
     void set_report_profile() { _is_report_profile = true; }
     bool is_report_profile() { return _is_report_profile; }
+    // Whether the fragment has run for pipeline_slow_query_profile_threshold_ms, whose profile is reported
+    // even if the query doesn't ask for it.
+    bool is_slow() const {
+        int64_t threshold_ms = config::pipeline_slow_query_profile_threshold_ms;
+        return threshold_ms > 0 && lifetime_ns() >= threshold_ms * 1000000;
+    }
+    int64_t lifetime_ns() const { return static_cast<int64_t>(_lifetime_sw.elapsed_time()); }
     void set_profile_mode(const TPipelineProfileMode::type& profile_mode) { _profile_mode = profile_mode; }
     const TPipelineProfileMode::type& profile_mode() { return _profile_mode; }
     FragmentFuture finish_future() { return _finish_promise.get_future(); }
@@ -129,6 +138,7 @@ private:
     TNetworkAddress _fe_addr;
 
     bool _is_report_profile = false;
+    MonotonicStopWatch _lifetime_sw;
     // Mode of profile
     TPipelineProfileMode::type _profile_mode;
 
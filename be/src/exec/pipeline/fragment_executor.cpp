@@ -2,6 +2,8 @@
 
 #include "exec/pipeline/fragment_executor.h"
 
+#include <set>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include "exec/exchange_node.h"
@@ -11,6 +13,7 @@
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/morsel.h"
+#include "exec/pipeline/olap_table_sink_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
 #include "exec/pipeline/result_sink_operator.h"
@@ -21,10 +24,14 @@
 #include "gutil/map_util.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/data_stream_sender.h"
+#include "runtime/descriptor_tbl_cache.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/multi_cast_data_stream_sink.h"
 #include "runtime/result_sink.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/vectorized/tablet_reader.h"
 #include "util/pretty_printer.h"
 #include "util/uid_util.h"
 
@@ -46,10 +53,105 @@ static void setup_profile_hierarchy(const PipelinePtr& pipeline, const DriverPtr
     }
 }
 
-Morsels convert_scan_range_to_morsel(const std::vector<TScanRangeParams>& scan_ranges, int node_id) {
+// Capture the rowsets of the tablet to split its scan range, nullptr if it couldn't be split.
+static std::shared_ptr<std::vector<RowsetSharedPtr>> capture_rowsets_to_split(const TScanRangeParams& scan_range,
+                                                                             TabletSharedPtr* tablet_ptr) {
+    if (!scan_range.scan_range.__isset.internal_scan_range) {
+        return nullptr;
+    }
+    const auto& internal_scan_range = scan_range.scan_range.internal_scan_range;
+    std::string err;
+    auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(internal_scan_range.tablet_id, true, &err);
+    // The error is reported by OlapChunkSource.
+    if (tablet == nullptr) {
+        return nullptr;
+    }
+    *tablet_ptr = tablet;
+    int64_t version = strtoul(internal_scan_range.version.c_str(), nullptr, 10);
+    auto rowsets = std::make_shared<std::vector<RowsetSharedPtr>>();
+    std::shared_lock l(tablet->get_header_lock());
+    if (!tablet->capture_consistent_rowsets(Version(0, version), rowsets.get()).ok()) {
+        return nullptr;
+    }
+    return rowsets;
+}
+
+// Split the scan range of a tablet whose rows need merging into about |num_morsels| morsels of key ranges,
+// or a morsel of the whole tablet if no key is sampled.
+static void split_by_keys(int node_id, const TScanRangeParams& scan_range, const Tablet& tablet,
+                          const std::vector<RowsetSharedPtr>& rowsets, int64_t num_morsels, Morsels* morsels) {
+    std::vector<OlapTuple> keys;
+    Status st = vectorized::TabletReader::sample_split_keys(tablet.tablet_schema(), rowsets, num_morsels, &keys);
+    if (!st.ok() || keys.empty()) {
+        LOG_IF(WARNING, !st.ok()) << "Fail to sample the split keys of tablet " << tablet.tablet_id() << ": " << st;
+        morsels->emplace_back(std::make_unique<OlapMorsel>(node_id, scan_range));
+        return;
+    }
+    for (size_t k = 0; k <= keys.size(); ++k) {
+        OlapTuple begin = k == 0 ? OlapTuple() : keys[k - 1];
+        OlapTuple end = k == keys.size() ? OlapTuple() : keys[k];
+        morsels->emplace_back(std::make_unique<OlapMorsel>(node_id, scan_range.scan_range.internal_scan_range,
+                                                           std::move(begin), std::move(end)));
+        if (scan_range.__isset.bucket_sequence) {
+            morsels->back()->set_bucket_sequence(scan_range.bucket_sequence);
+        }
+    }
+}
+
+// Each tablet is a morsel at first, and the large tablets are split into morsels of rowid ranges, so that
+// they could be scanned by several ScanOperators and don't dominate the latency of the scan. The rows of the
+// aggregate and unique key tablets need merging, they are split into morsels of key ranges instead, sampled
+// from the short key indexes, and each morsel merges the rows of its key range.
+// A morsel has about 1/kMorselsPerDriver of the rows a driver scans, but at least
+// pipeline_scan_morsel_min_rows rows.
+Morsels convert_scan_range_to_morsel(const std::vector<TScanRangeParams>& scan_ranges, int node_id,
+                                     size_t degree_of_parallelism, bool enable_split) {
+    static constexpr int64_t kMorselsPerDriver = 4;
+
     Morsels morsels;
-    for (const auto& scan_range : scan_ranges) {
-        morsels.emplace_back(std::make_unique<OlapMorsel>(node_id, scan_range));
+    const int64_t min_morsel_rows = config::pipeline_scan_morsel_min_rows;
+    if (!enable_split || min_morsel_rows <= 0) {
+        for (const auto& scan_range : scan_ranges) {
+            morsels.emplace_back(std::make_unique<OlapMorsel>(node_id, scan_range));
+        }
+        return morsels;
+    }
+
+    std::vector<TabletSharedPtr> tablets(scan_ranges.size());
+    std::vector<std::shared_ptr<std::vector<RowsetSharedPtr>>> tablet_rowsets(scan_ranges.size());
+    std::vector<int64_t> tablet_rows(scan_ranges.size(), 0);
+    int64_t total_rows = 0;
+    for (size_t i = 0; i < scan_ranges.size(); ++i) {
+        tablet_rowsets[i] = capture_rowsets_to_split(scan_ranges[i], &tablets[i]);
+        if (tablet_rowsets[i] != nullptr) {
+            for (const auto& rowset : *tablet_rowsets[i]) {
+                tablet_rows[i] += rowset->num_rows();
+            }
+        }
+        total_rows += tablet_rows[i];
+    }
+
+    const int64_t morsel_rows = std::max<int64_t>(
+            min_morsel_rows, total_rows / (std::max<size_t>(1, degree_of_parallelism) * kMorselsPerDriver));
+    for (size_t i = 0; i < scan_ranges.size(); ++i) {
+        if (tablet_rowsets[i] == nullptr || tablet_rows[i] <= morsel_rows) {
+            morsels.emplace_back(std::make_unique<OlapMorsel>(node_id, scan_ranges[i]));
+            continue;
+        }
+        const int64_t num_morsels = (tablet_rows[i] + morsel_rows - 1) / morsel_rows;
+        if (!vectorized::TabletReader::can_split_by_rowid(tablets[i]->keys_type())) {
+            split_by_keys(node_id, scan_ranges[i], *tablets[i], *tablet_rowsets[i], num_morsels, &morsels);
+            continue;
+        }
+        const int64_t rows_per_morsel = (tablet_rows[i] + num_morsels - 1) / num_morsels;
+        for (int64_t begin = 0; begin < tablet_rows[i]; begin += rows_per_morsel) {
+            int64_t end = std::min(begin + rows_per_morsel, tablet_rows[i]);
+            morsels.emplace_back(std::make_unique<OlapMorsel>(node_id, scan_ranges[i].scan_range.internal_scan_range,
+                                                              tablet_rowsets[i], begin, end));
+            if (scan_ranges[i].__isset.bucket_sequence) {
+                morsels.back()->set_bucket_sequence(scan_ranges[i].bucket_sequence);
+            }
+        }
     }
     return morsels;
 }
@@ -142,8 +244,15 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     // Set up desc tbl
     auto* obj_pool = runtime_state->obj_pool();
     DescriptorTbl* desc_tbl = nullptr;
-    RETURN_IF_ERROR(DescriptorTbl::create(obj_pool, t_desc_tbl, &desc_tbl, runtime_state->chunk_size()));
-    runtime_state->set_desc_tbl(desc_tbl);
+    if (DescriptorTblCache::instance() != nullptr) {
+        std::shared_ptr<ObjectPool> desc_tbl_pool;
+        RETURN_IF_ERROR(DescriptorTblCache::instance()->get_or_create(t_desc_tbl, runtime_state->chunk_size(),
+                                                                      &desc_tbl, &desc_tbl_pool));
+        runtime_state->set_desc_tbl(desc_tbl, std::move(desc_tbl_pool));
+    } else {
+        RETURN_IF_ERROR(DescriptorTbl::create(obj_pool, t_desc_tbl, &desc_tbl, runtime_state->chunk_size()));
+        runtime_state->set_desc_tbl(desc_tbl);
+    }
     // Set up plan
     ExecNode* plan = nullptr;
     RETURN_IF_ERROR(ExecNode::create_tree(runtime_state, obj_pool, fragment.plan, *desc_tbl, &plan));
@@ -176,9 +285,25 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         ScanNode* scan_node = down_cast<ScanNode*>(i);
         const std::vector<TScanRangeParams>& scan_ranges =
                 FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
-        Morsels morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
+        // The scans with limit usually finish after reading a few morsels, splitting the tablets is useless.
+        Morsels morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id(), degree_of_parallelism,
+                                                       scan_node->limit() == -1);
         morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
     }
+    // The buckets of the instance are ranked the same way for all the bucket-aware scans of the fragment, so the
+    // same bucket of the colocated tables is scanned by the same driver of each scan.
+    std::set<int32_t> buckets;
+    for (const auto& [scan_id, morsel_queue] : morsel_queues) {
+        if (morsel_queue->is_bucket_aware()) {
+            for (const auto& scan_range : FindOrDie(params.per_node_scan_ranges, scan_id)) {
+                buckets.insert(scan_range.bucket_sequence);
+            }
+        }
+    }
+    std::unordered_map<int32_t, size_t> bucket_ranks;
+    for (int32_t bucket : buckets) {
+        bucket_ranks.emplace(bucket, bucket_ranks.size());
+    }
 
     PipelineBuilderContext context(_fragment_ctx, degree_of_parallelism);
     PipelineBuilder builder(context);
@@ -193,7 +318,7 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         if (sink_profile != nullptr) {
             runtime_state->runtime_profile()->add_child(sink_profile, true, nullptr);
         }
-        _decompose_data_sink_to_operator(runtime_state, &context, fragment.output_sink, sink.get());
+        _decompose_data_sink_to_operator(runtime_state, &context, fragment.output_sink, sink);
     }
 
     RETURN_IF_ERROR(_fragment_ctx->prepare_all_pipelines());
@@ -216,11 +341,18 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
             auto source_id = pipeline->get_op_factories()[0]->plan_node_id();
             DCHECK(morsel_queues.count(source_id));
             auto& morsel_queue = morsel_queues[source_id];
-            if (morsel_queue->num_morsels() > 0) {
+            const bool bucket_aware = morsel_queue->is_bucket_aware();
+            if (morsel_queue->num_morsels() > 0 && !bucket_aware) {
                 DCHECK(degree_of_parallelism <= morsel_queue->num_morsels());
             }
-            std::vector<MorselQueuePtr> morsel_queue_per_driver = morsel_queue->split_by_size(degree_of_parallelism);
+            std::vector<MorselQueuePtr> morsel_queue_per_driver =
+                    bucket_aware ? morsel_queue->split_by_bucket(degree_of_parallelism, bucket_ranks)
+                                 : morsel_queue->split_by_size(degree_of_parallelism);
             DCHECK(morsel_queue_per_driver.size() == degree_of_parallelism);
+            std::vector<MorselQueue*> all_morsel_queues;
+            for (const auto& queue : morsel_queue_per_driver) {
+                all_morsel_queues.emplace_back(queue.get());
+            }
 
             if (is_root) {
                 num_root_drivers += degree_of_parallelism;
@@ -232,6 +364,12 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
                 driver->set_morsel_queue(std::move(morsel_queue_per_driver[i]));
                 auto* scan_operator = down_cast<ScanOperator*>(driver->source_operator());
                 scan_operator->set_io_threads(exec_env->pipeline_scan_io_thread_pool());
+                // The morsels of a bucket mustn't be stolen by the drivers of the other buckets.
+                std::vector<MorselQueue*> sibling_morsel_queues;
+                for (size_t j = 1; j < degree_of_parallelism && !bucket_aware; ++j) {
+                    sibling_morsel_queues.emplace_back(all_morsel_queues[(i + j) % degree_of_parallelism]);
+                }
+                scan_operator->set_sibling_morsel_queues(std::move(sibling_morsel_queues));
                 setup_profile_hierarchy(pipeline, driver);
                 drivers.emplace_back(std::move(driver));
             }
@@ -254,6 +392,20 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     _fragment_ctx->set_num_root_drivers(num_root_drivers);
     _fragment_ctx->set_drivers(std::move(drivers));
 
+    // The fragment waits for the memory of its query to be admitted before it's executed. The reservation is made
+    // after the fragment is prepared, so that it's held only by the query contexts whose fragments run.
+    if (config::query_mem_admission_ratio > 0 && query_options.__isset.mem_limit) {
+        int64_t capacity = exec_env->query_pool_mem_tracker()->limit() * config::query_mem_admission_ratio;
+        int64_t timeout_ms = config::query_mem_admission_timeout_ms;
+        if (query_options.__isset.query_timeout) {
+            timeout_ms = std::min<int64_t>(timeout_ms, query_options.query_timeout * 1000L);
+        }
+        if (capacity > 0) {
+            RETURN_IF_ERROR(
+                    _query_ctx->reserve_memory(std::min(query_options.mem_limit, capacity), capacity, timeout_ms));
+        }
+    }
+
     _query_ctx->fragment_mgr()->register_ctx(fragment_instance_id, std::move(fragment_ctx));
 
     return Status::OK();
@@ -270,9 +422,10 @@ Status FragmentExecutor::execute(ExecEnv* exec_env) {
 }
 
 void FragmentExecutor::_decompose_data_sink_to_operator(RuntimeState* runtime_state, PipelineBuilderContext* context,
-                                                        const TDataSink& t_datasink, DataSink* datasink) {
+                                                        const TDataSink& t_datasink,
+                                                        std::unique_ptr<DataSink>& datasink) {
     if (typeid(*datasink) == typeid(starrocks::ResultSink)) {
-        starrocks::ResultSink* result_sink = down_cast<starrocks::ResultSink*>(datasink);
+        starrocks::ResultSink* result_sink = down_cast<starrocks::ResultSink*>(datasink.get());
         // Result sink doesn't have plan node id;
         OpFactoryPtr op =
                 std::make_shared<ResultSinkOperatorFactory>(context->next_operator_id(), result_sink->get_sink_type(),
@@ -280,7 +433,7 @@ void FragmentExecutor::_decompose_data_sink_to_operator(RuntimeState* runtime_st
         // Add result sink operator to last pipeline
         _fragment_ctx->pipelines().back()->add_op_factory(op);
     } else if (typeid(*datasink) == typeid(starrocks::DataStreamSender)) {
-        starrocks::DataStreamSender* sender = down_cast<starrocks::DataStreamSender*>(datasink);
+        starrocks::DataStreamSender* sender = down_cast<starrocks::DataStreamSender*>(datasink.get());
         auto dop = _fragment_ctx->pipelines().back()->source_operator_factory()->degree_of_parallelism();
         auto& t_stream_sink = t_datasink.stream_sink;
         bool is_dest_merge = false;
@@ -318,7 +471,7 @@ void FragmentExecutor::_decompose_data_sink_to_operator(RuntimeState* runtime_st
         // and source[B] will pull chunk from exchanger
         // so basically you can think exchanger is a chunk repository.
         // Further workflow explanation is in mcast_local_exchange.h file.
-        starrocks::MultiCastDataStreamSink* mcast_sink = down_cast<starrocks::MultiCastDataStreamSink*>(datasink);
+        starrocks::MultiCastDataStreamSink* mcast_sink = down_cast<starrocks::MultiCastDataStreamSink*>(datasink.get());
         const auto& sinks = mcast_sink->get_sinks();
         auto& t_multi_case_stream_sink = t_datasink.multi_cast_stream_sink;
 
@@ -367,6 +520,26 @@ void FragmentExecutor::_decompose_data_sink_to_operator(RuntimeState* runtime_st
             pp->set_root();
             _fragment_ctx->pipelines().emplace_back(pp);
         }
+    } else if (typeid(*datasink) == typeid(starrocks::stream_load::OlapTableSink)) {
+        // The OlapTableSink owns the channels to the BEs of the destination table, and now it's owned by the
+        // operator factory.
+        std::unique_ptr<stream_load::OlapTableSink> olap_table_sink(
+                down_cast<stream_load::OlapTableSink*>(datasink.release()));
+        OpFactoryPtr sink_op = std::make_shared<OlapTableSinkOperatorFactory>(
+                context->next_operator_id(), std::move(olap_table_sink), _fragment_ctx);
+        auto& pipeline = _fragment_ctx->pipelines().back();
+        if (pipeline->source_operator_factory()->degree_of_parallelism() == 1) {
+            pipeline->add_op_factory(sink_op);
+        } else {
+            // gather the output of all the drivers into the single driver of the sink.
+            OpFactories ops =
+                    context->maybe_interpolate_local_passthrough_exchange(runtime_state, pipeline->get_op_factories());
+            ops.emplace_back(sink_op);
+            pipeline->unset_root();
+            auto pp = std::make_shared<Pipeline>(context->next_pipe_id(), ops);
+            pp->set_root();
+            _fragment_ctx->pipelines().emplace_back(pp);
+        }
     }
 }
 
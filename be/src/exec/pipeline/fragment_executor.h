@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "common/status.h"
 #include "gen_cpp/InternalService_types.h"
 
@@ -23,7 +25,7 @@ public:
 
 private:
     void _decompose_data_sink_to_operator(RuntimeState* state, PipelineBuilderContext* context,
-                                          const TDataSink& t_datasink, DataSink* datasink);
+                                          const TDataSink& t_datasink, std::unique_ptr<DataSink>& datasink);
     QueryContext* _query_ctx = nullptr;
     FragmentContext* _fragment_ctx = nullptr;
 };
@@ -0,0 +1,127 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/hashjoin/broadcast_hash_table_builder.h"
+
+#include <thread>
+
+#include "exec/vectorized/join_hash_map.h"
+
+namespace starrocks::pipeline {
+
+BroadcastHashTableBuilder::BroadcastHashTableBuilder(size_t num_builders)
+        : _num_tasks(num_builders * kTasksPerBuilder), _num_partitions(num_builders * kTasksPerBuilder) {}
+
+Status BroadcastHashTableBuilder::build(RuntimeState* state, HashJoiner* hash_joiner) {
+    State expected = INIT;
+    if (_state.compare_exchange_strong(expected, PREPARING)) {
+        _owner = hash_joiner;
+        auto status = _prepare(state);
+        if (!status.ok()) {
+            _state = FALLBACK;
+            return status;
+        }
+        if (_state == FALLBACK) {
+            return hash_joiner->build_ht(state);
+        }
+
+        _run_bucket_tasks();
+        _wait_tasks(_num_bucket_tasks_done, _num_tasks);
+        _state = LINKING;
+        _run_link_tasks();
+        _wait_tasks(_num_link_tasks_done, _num_partitions);
+        hash_joiner->finish_parallel_build();
+        _state = DONE;
+        return Status::OK();
+    }
+
+    while (true) {
+        switch (_state.load()) {
+        case BUCKETING:
+            _run_bucket_tasks();
+            break;
+        case LINKING:
+            _run_link_tasks();
+            break;
+        case DONE:
+            hash_joiner->share_hash_table(state, *_owner);
+            return Status::OK();
+        case FALLBACK:
+            return hash_joiner->build_ht(state);
+        default:
+            break;
+        }
+        std::this_thread::yield();
+    }
+}
+
+Status BroadcastHashTableBuilder::_prepare(RuntimeState* state) {
+    ASSIGN_OR_RETURN(bool prepared, _owner->prepare_parallel_build(state));
+    if (!prepared) {
+        _state = FALLBACK;
+        return Status::OK();
+    }
+    _row_buckets.resize(_num_tasks);
+    _state = BUCKETING;
+    return Status::OK();
+}
+
+void BroadcastHashTableBuilder::_run_bucket_tasks() {
+    for (size_t task = _next_bucket_task++; task < _num_tasks; task = _next_bucket_task++) {
+        _bucket(task);
+        _num_bucket_tasks_done++;
+    }
+}
+
+void BroadcastHashTableBuilder::_run_link_tasks() {
+    for (size_t partition = _next_link_task++; partition < _num_partitions; partition = _next_link_task++) {
+        _link(partition);
+        _num_link_tasks_done++;
+    }
+}
+
+void BroadcastHashTableBuilder::_bucket(size_t task) {
+    auto& ht = _owner->hash_table();
+    // The rows are [1, row_count], the row 0 is the default row.
+    uint32_t row_count = ht.get_row_count();
+    uint32_t start = 1 + static_cast<uint64_t>(row_count) * task / _num_tasks;
+    uint32_t end = 1 + static_cast<uint64_t>(row_count) * (task + 1) / _num_tasks;
+    uint64_t bucket_size = ht.get_bucket_size();
+
+    std::vector<uint32_t> buckets(end - start);
+    ht.calc_build_buckets(start, end - start, buckets.data());
+
+    // Allocated by the thread runs the task, so they are in the memory local to it.
+    auto& partitions = _row_buckets[task];
+    partitions.resize(_num_partitions);
+    for (auto& partition : partitions) {
+        partition.rows.reserve((end - start) / _num_partitions + 1);
+        partition.buckets.reserve((end - start) / _num_partitions + 1);
+    }
+    for (uint32_t i = 0; i < end - start; i++) {
+        if (buckets[i] == vectorized::JoinHashMapHelper::NULL_BUCKET) {
+            continue;
+        }
+        auto& partition = partitions[buckets[i] * _num_partitions / bucket_size];
+        partition.rows.push_back(start + i);
+        partition.buckets.push_back(buckets[i]);
+    }
+}
+
+void BroadcastHashTableBuilder::_link(size_t partition) {
+    auto& ht = _owner->hash_table();
+    for (size_t task = 0; task < _num_tasks; task++) {
+        auto& row_buckets = _row_buckets[task][partition];
+        ht.link_rows(row_buckets.rows.data(), row_buckets.buckets.data(), row_buckets.rows.size());
+        std::vector<uint32_t>().swap(row_buckets.rows);
+        std::vector<uint32_t>().swap(row_buckets.buckets);
+    }
+}
+
+void BroadcastHashTableBuilder::_wait_tasks(const std::atomic<size_t>& num_done, size_t num_tasks) const {
+    // The claimed tasks are being run by the other threads, which never wait for anything.
+    while (num_done < num_tasks) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,70 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/pipeline/hashjoin/hash_joiner_factory.h"
+
+namespace starrocks {
+
+class RuntimeState;
+
+namespace pipeline {
+
+// BroadcastHashTableBuilder builds the hash table of a broadcast join by all its HashJoinBuildOperators together.
+//
+// Every build operator of a broadcast join receives all the build rows, and used to build the same hash table
+// by itself. Instead, the first finished operator (the owner) prepares its hash table, then the rows are
+// inserted by the operators finished so far in two phases of tasks:
+// 1. Bucketing: the rows are split into ranges, the buckets of each range are computed, and the rows are
+//    scattered into partitions by bucket. The partitions are contiguous ranges of the buckets, so the
+//    rows of a partition are linked into a disjoint part of the hash table, and the lists of a task are
+//    allocated by the thread runs it.
+// 2. Linking: every partition is linked into the hash table by one task, in the order of the rows, so the
+//    hash table is the same as the one built serially.
+// Then all the HashJoiners probe the hash table of the owner.
+//
+// An operator only waits for the tasks run by the operators finished already, never for the unfinished ones.
+class BroadcastHashTableBuilder {
+public:
+    explicit BroadcastHashTableBuilder(size_t num_builders);
+
+    // Called by every HashJoinBuildOperator instead of HashJoiner::build_ht().
+    Status build(RuntimeState* state, HashJoiner* hash_joiner);
+
+private:
+    static constexpr size_t kTasksPerBuilder = 4;
+
+    enum State { INIT, PREPARING, BUCKETING, LINKING, DONE, FALLBACK };
+
+    struct RowBuckets {
+        std::vector<uint32_t> rows;
+        std::vector<uint32_t> buckets;
+    };
+
+    Status _prepare(RuntimeState* state);
+    void _run_bucket_tasks();
+    void _run_link_tasks();
+    void _bucket(size_t task);
+    void _link(size_t partition);
+    void _wait_tasks(const std::atomic<size_t>& num_done, size_t num_tasks) const;
+
+    const size_t _num_tasks;
+    const size_t _num_partitions;
+
+    std::atomic<State> _state{INIT};
+    HashJoiner* _owner = nullptr;
+    // Rows of the task i in the partition j are _row_buckets[i][j].
+    std::vector<std::vector<RowBuckets>> _row_buckets;
+
+    std::atomic<size_t> _next_bucket_task{0};
+    std::atomic<size_t> _num_bucket_tasks_done{0};
+    std::atomic<size_t> _next_link_task{0};
+    std::atomic<size_t> _num_link_tasks_done{0};
+};
+
+} // namespace pipeline
+} // namespace starrocks
@@ -2,6 +2,7 @@
 
 #include "exec/pipeline/hashjoin/hash_join_build_operator.h"
 
+#include "common/config.h"
 #include "runtime/runtime_filter_worker.h"
 
 namespace starrocks {
@@ -11,13 +12,15 @@ HashJoinBuildOperator::HashJoinBuildOperator(OperatorFactory* factory, int32_t i
                                              int32_t plan_node_id, HashJoinerPtr hash_joiner, size_t driver_sequence,
                                              PartialRuntimeFilterMerger* partial_rf_merger,
                                              const TJoinDistributionMode::type distribution_mode,
-                                             std::atomic<bool>& any_broadcast_builder_finished)
+                                             std::atomic<bool>& any_broadcast_builder_finished,
+                                             BroadcastHashTableBuilder* broadcast_ht_builder)
         : Operator(factory, id, name, plan_node_id),
           _hash_joiner(hash_joiner),
           _driver_sequence(driver_sequence),
           _partial_rf_merger(partial_rf_merger),
           _distribution_mode(distribution_mode),
-          _any_broadcast_builder_finished(any_broadcast_builder_finished) {
+          _any_broadcast_builder_finished(any_broadcast_builder_finished),
+          _broadcast_ht_builder(broadcast_ht_builder) {
     _hash_joiner->ref();
 }
 
@@ -27,7 +30,11 @@ Status HashJoinBuildOperator::push_chunk(RuntimeState* state, const vectorized::
 
 Status HashJoinBuildOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Operator::prepare(state));
-    return _hash_joiner->prepare(state);
+    RETURN_IF_ERROR(_hash_joiner->prepare(state));
+    if (state->enable_spill()) {
+        _hash_joiner->enable_spill();
+    }
+    return Status::OK();
 }
 Status HashJoinBuildOperator::close(RuntimeState* state) {
     RETURN_IF_ERROR(_hash_joiner->unref(state));
@@ -42,7 +49,11 @@ StatusOr<vectorized::ChunkPtr> HashJoinBuildOperator::pull_chunk(RuntimeState* s
 
 void HashJoinBuildOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
-    _hash_joiner->build_ht(state);
+    if (_broadcast_ht_builder != nullptr) {
+        _broadcast_ht_builder->build(state, _hash_joiner.get());
+    } else {
+        _hash_joiner->build_ht(state);
+    }
 
     size_t merger_index = _driver_sequence;
     if (_distribution_mode == TJoinDistributionMode::BROADCAST) {
@@ -92,6 +103,14 @@ HashJoinBuildOperatorFactory::HashJoinBuildOperatorFactory(
 
 Status HashJoinBuildOperatorFactory::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    // The joins which mark the build rows matched during probe need a hash table of their own.
+    auto join_type = _hash_joiner_factory->join_type();
+    _share_broadcast_hash_table =
+            config::pipeline_share_broadcast_hash_table && _distribution_mode == TJoinDistributionMode::BROADCAST &&
+            !state->enable_spill() &&
+            (join_type == TJoinOp::INNER_JOIN || join_type == TJoinOp::LEFT_OUTER_JOIN ||
+             join_type == TJoinOp::LEFT_SEMI_JOIN || join_type == TJoinOp::LEFT_ANTI_JOIN ||
+             join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN);
     return _hash_joiner_factory->prepare(state);
 }
 
@@ -101,9 +120,13 @@ void HashJoinBuildOperatorFactory::close(RuntimeState* state) {
 }
 
 OperatorPtr HashJoinBuildOperatorFactory::create(int32_t degree_of_parallelism, int32_t driver_sequence) {
+    if (_share_broadcast_hash_table && degree_of_parallelism > 1 && _broadcast_ht_builder == nullptr) {
+        _broadcast_ht_builder = std::make_unique<BroadcastHashTableBuilder>(degree_of_parallelism);
+    }
     return std::make_shared<HashJoinBuildOperator>(
             this, _id, _name, _plan_node_id, _hash_joiner_factory->create(driver_sequence), driver_sequence,
-            _partial_rf_merger.get(), _distribution_mode, _any_broadcast_builder_finished);
+            _partial_rf_merger.get(), _distribution_mode, _any_broadcast_builder_finished,
+            _broadcast_ht_builder.get());
 }
 } // namespace pipeline
 } // namespace starrocks
@@ -5,6 +5,7 @@
 
 #include <atomic>
 
+#include "exec/pipeline/hashjoin/broadcast_hash_table_builder.h"
 #include "exec/pipeline/hashjoin/hash_joiner_factory.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/pipeline_fwd.h"
@@ -23,7 +24,8 @@ public:
                           HashJoinerPtr hash_joiner, size_t driver_sequence,
                           PartialRuntimeFilterMerger* partial_rf_merger,
                           const TJoinDistributionMode::type distribution_mode,
-                          std::atomic<bool>& any_broadcast_builder_finished);
+                          std::atomic<bool>& any_broadcast_builder_finished,
+                          BroadcastHashTableBuilder* broadcast_ht_builder);
     ~HashJoinBuildOperator() = default;
 
     Status prepare(RuntimeState* state) override;
@@ -53,6 +55,8 @@ private:
 
     const TJoinDistributionMode::type _distribution_mode;
     std::atomic<bool>& _any_broadcast_builder_finished;
+    // Not null if the hash table is built together with the other builders of the broadcast join.
+    BroadcastHashTableBuilder* _broadcast_ht_builder;
 };
 
 class HashJoinBuildOperatorFactory final : public OperatorFactory {
@@ -72,6 +76,8 @@ private:
 
     const TJoinDistributionMode::type _distribution_mode;
     std::atomic<bool> _any_broadcast_builder_finished{false};
+    bool _share_broadcast_hash_table = false;
+    std::unique_ptr<BroadcastHashTableBuilder> _broadcast_ht_builder;
 };
 
 } // namespace pipeline
@@ -26,6 +26,8 @@ public:
         return _hash_joiners[i];
     }
 
+    TJoinOp::type join_type() const { return _param._hash_join_node.join_op; }
+
 private:
     starrocks::vectorized::HashJoinerParam _param;
     HashJoiners _hash_joiners;
@@ -42,6 +42,9 @@ public:
         return std::make_shared<LimitOperator>(this, _id, _plan_node_id, _limit);
     }
 
+    // The number of the rows still to output by all the drivers, 0 once the limit is reached.
+    const std::atomic<int64_t>* remaining_limit() const { return &_limit; }
+
 private:
     std::atomic<int64_t> _limit;
 };
@@ -2,12 +2,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <optional>
+#include <unordered_map>
 
 #include "gen_cpp/InternalService_types.h"
 #include "storage/olap_common.h"
+#include "storage/tuple.h"
 
 namespace starrocks {
+
+class Rowset;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
+
 namespace pipeline {
 class Morsel;
 using MorselPtr = std::unique_ptr<Morsel>;
@@ -22,25 +29,75 @@ public:
     virtual ~Morsel() = default;
     int32_t get_plan_node_id() const { return _plan_node_id; }
 
+    // The bucket of the tablet of the morsel, -1 if the scan range isn't tagged with its bucket,
+    // see TScanRangeParams::bucket_sequence.
+    int32_t bucket_sequence() const { return _bucket_sequence; }
+    void set_bucket_sequence(int32_t bucket_sequence) { _bucket_sequence = bucket_sequence; }
+
 private:
     int32_t _plan_node_id;
+    int32_t _bucket_sequence = -1;
 };
 
 class OlapMorsel final : public Morsel {
 public:
     OlapMorsel(int32_t plan_node_id, const TScanRangeParams& scan_range) : Morsel(plan_node_id) {
         _scan_range = std::make_unique<TInternalScanRange>(scan_range.scan_range.internal_scan_range);
+        if (scan_range.__isset.bucket_sequence) {
+            set_bucket_sequence(scan_range.bucket_sequence);
+        }
     }
 
+    // The morsel only reads the rows in [rowid_range_begin, rowid_range_end) of |rowsets|, which are
+    // captured by the version of |scan_range| and shared by all the morsels split from the same tablet.
+    // See TabletReaderParams::rowid_range_begin.
+    OlapMorsel(int32_t plan_node_id, const TInternalScanRange& scan_range,
+               std::shared_ptr<const std::vector<RowsetSharedPtr>> rowsets, int64_t rowid_range_begin,
+               int64_t rowid_range_end)
+            : Morsel(plan_node_id),
+              _scan_range(std::make_unique<TInternalScanRange>(scan_range)),
+              _rowsets(std::move(rowsets)),
+              _rowid_range_begin(rowid_range_begin),
+              _rowid_range_end(rowid_range_end) {}
+
+    // The morsel only reads the rows whose keys are in [split_begin_key, split_end_key) of the tablet, an empty
+    // tuple means unbounded. See TabletReaderParams::split_begin_key.
+    OlapMorsel(int32_t plan_node_id, const TInternalScanRange& scan_range, OlapTuple split_begin_key,
+               OlapTuple split_end_key)
+            : Morsel(plan_node_id),
+              _scan_range(std::make_unique<TInternalScanRange>(scan_range)),
+              _split_begin_key(std::move(split_begin_key)),
+              _split_end_key(std::move(split_end_key)),
+              _key_split(true) {}
+
     TInternalScanRange* get_scan_range() { return _scan_range.get(); }
 
+    // nullptr means the morsel reads the whole tablet.
+    const std::vector<RowsetSharedPtr>* rowsets() const { return _rowsets.get(); }
+    int64_t rowid_range_begin() const { return _rowid_range_begin; }
+    int64_t rowid_range_end() const { return _rowid_range_end; }
+
+    bool is_key_split() const { return _key_split; }
+    const OlapTuple& split_begin_key() const { return _split_begin_key; }
+    const OlapTuple& split_end_key() const { return _split_end_key; }
+
 private:
     std::unique_ptr<TInternalScanRange> _scan_range;
+    std::shared_ptr<const std::vector<RowsetSharedPtr>> _rowsets;
+    int64_t _rowid_range_begin = 0;
+    int64_t _rowid_range_end = -1;
+    OlapTuple _split_begin_key;
+    OlapTuple _split_end_key;
+    bool _key_split = false;
 };
 
 class MorselQueue {
 public:
-    MorselQueue(Morsels&& morsels) : _morsels(std::move(morsels)), _num_morsels(_morsels.size()), _pop_index(0) {}
+    MorselQueue(Morsels&& morsels) : _morsels(std::move(morsels)), _num_morsels(_morsels.size()), _pop_index(0) {
+        _bucket_aware = !_morsels.empty() && std::all_of(_morsels.begin(), _morsels.end(), [](const auto& morsel) {
+            return morsel->bucket_sequence() >= 0;
+        });
+    }
 
     size_t num_morsels() const { return _num_morsels; }
     std::optional<MorselPtr> try_get() {
@@ -59,6 +116,10 @@ public:
 
     bool empty() const { return _pop_index >= _num_morsels; }
 
+    // Whether all the morsels are tagged with their buckets, the morsels of a bucket must be scanned by one driver
+    // then, see split_by_bucket.
+    bool is_bucket_aware() const { return _bucket_aware; }
+
     // Split the morsel queue into `split_size` morsel queues.
     // For example:
     // morsel queue is: [1, 2, 3, 4, 5, 6, 7]
@@ -88,9 +149,37 @@ public:
         return split_morsel_queues;
     }
 
+    // Split the morsel queue into `split_size` morsel queues by the buckets of the morsels, the morsels of the
+    // bucket b go to the queue bucket_ranks[b] % split_size, so that the drivers of the scans of the colocated
+    // tables scan the same buckets and the colocate join needs no local shuffle.
+    std::vector<MorselQueuePtr> split_by_bucket(size_t split_size,
+                                                const std::unordered_map<int32_t, size_t>& bucket_ranks) {
+        DCHECK(_bucket_aware);
+        DCHECK_GT(split_size, 0);
+
+        std::vector<Morsels> split_morsels_list(split_size);
+        for (int i = 0; i < _num_morsels; ++i) {
+            auto maybe_morsel = try_get();
+            DCHECK(maybe_morsel.has_value());
+            auto& morsel = maybe_morsel.value();
+            auto it = bucket_ranks.find(morsel->bucket_sequence());
+            DCHECK(it != bucket_ranks.end());
+            split_morsels_list[it->second % split_size].emplace_back(std::move(morsel));
+        }
+
+        std::vector<MorselQueuePtr> split_morsel_queues;
+        split_morsel_queues.reserve(split_size);
+        for (auto& split_morsels : split_morsels_list) {
+            split_morsel_queues.emplace_back(std::make_unique<MorselQueue>(std::move(split_morsels)));
+        }
+
+        return split_morsel_queues;
+    }
+
 private:
     Morsels _morsels;
     const size_t _num_morsels;
+    bool _bucket_aware = false;
     std::atomic<size_t> _pop_index;
 };
 
@@ -3,19 +3,28 @@
 #include "exec/pipeline/olap_chunk_source.h"
 
 #include "column/column_helper.h"
+#include "common/config.h"
+#include "exec/pipeline/scan_result_cache.h"
+#include "exec/vectorized/column_access_stats.h"
+#include "exec/vectorized/column_read_profile.h"
 #include "exec/vectorized/olap_scan_prepare.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "exprs/vectorized/runtime_filter.h"
+#include "exprs/vectorized/runtime_filter_bank.h"
+#include "gutil/casts.h"
 #include "gutil/map_util.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/primitive_type.h"
 #include "storage/storage_engine.h"
+#include "storage/types.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/column_predicate_rewriter.h"
+#include "storage/vectorized/column_runtime_filter_predicate.h"
 #include "storage/vectorized/predicate_parser.h"
 #include "storage/vectorized/projection_iterator.h"
+#include "storage/vectorized/type_utils.h"
 
 namespace starrocks::pipeline {
 using namespace vectorized;
@@ -45,6 +54,12 @@ Status OlapChunkSource::prepare(RuntimeState* state) {
         max_scan_key_num = config::doris_max_scan_key_num;
     }
     RETURN_IF_ERROR(cm.parse_conjuncts(true, max_scan_key_num, _enable_column_expr_predicate));
+    if (_is_pruned_by_runtime_filters()) {
+        // the tablet isn't opened at all
+        COUNTER_UPDATE(_tablets_pruned_counter, 1);
+        _status = Status::EndOfFile("pruned by runtime filters");
+        return Status::OK();
+    }
     RETURN_IF_ERROR(_build_scan_range(_runtime_state));
     RETURN_IF_ERROR(_init_olap_reader(_runtime_state));
     return Status::OK();
@@ -66,14 +81,18 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _read_pages_num_counter = ADD_COUNTER(_scan_profile, "ReadPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_scan_profile, "CachedPagesNum", TUnit::UNIT);
     _pushdown_predicates_counter = ADD_COUNTER(_scan_profile, "PushdownPredicates", TUnit::UNIT);
+    _tablets_pruned_counter = ADD_COUNTER(_scan_profile, "TabletsPrunedByRuntimeFilter", TUnit::UNIT);
 
     // SegmentInit
     _seg_init_timer = ADD_TIMER(_scan_profile, "SegmentInit");
     _bi_filter_timer = ADD_CHILD_TIMER(_scan_profile, "BitmapIndexFilter", "SegmentInit");
     _bi_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BitmapIndexFilterRows", TUnit::UNIT, "SegmentInit");
+    _ii_filter_timer = ADD_CHILD_TIMER(_scan_profile, "InvertedIndexFilter", "SegmentInit");
+    _ii_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "InvertedIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _bf_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BloomFilterFilterRows", TUnit::UNIT, "SegmentInit");
     _zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ZoneMapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _sk_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ShortKeyFilterRows", TUnit::UNIT, "SegmentInit");
+    _sorted_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "SortedColumnFilterRows", TUnit::UNIT, "SegmentInit");
 
     // SegmentRead
     _block_load_timer = ADD_TIMER(_scan_profile, "SegmentRead");
@@ -100,6 +119,9 @@ Status OlapChunkSource::_build_scan_range(RuntimeState* state) {
     RETURN_IF_ERROR(_conjuncts_manager.get_key_ranges(&_key_ranges));
     _conjuncts_manager.get_not_push_down_conjuncts(&_not_push_down_conjuncts);
     _dict_optimize_parser.rewrite_conjuncts<false>(&_not_push_down_conjuncts, state);
+    if (config::enable_adaptive_conjuncts_evaluation && !_not_push_down_conjuncts.empty()) {
+        _conjuncts_evaluator = std::make_unique<vectorized::AdaptiveConjunctsEvaluator>(_not_push_down_conjuncts);
+    }
 
     // FixMe(kks): Ensure this logic is right.
     int scanners_per_tablet = 64;
@@ -161,12 +183,23 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
         _predicate_free_pool.emplace_back(std::move(p));
     }
 
+    _init_runtime_filter_predicates(parser);
+    _init_column_exprs();
+
     {
         vectorized::ConjunctivePredicatesRewriter not_pushdown_predicate_rewriter(_not_push_down_predicates,
                                                                                   *_params.global_dictmaps);
         not_pushdown_predicate_rewriter.rewrite_predicate(&_obj_pool);
     }
 
+    // Rowid range of the split morsel
+    auto* olap_morsel = down_cast<OlapMorsel*>(_morsel.get());
+    _params.rowid_range_begin = olap_morsel->rowid_range_begin();
+    _params.rowid_range_end = olap_morsel->rowid_range_end();
+    // Key range of the morsel split from a tablet whose rows need merging
+    _params.split_begin_key = olap_morsel->split_begin_key();
+    _params.split_end_key = olap_morsel->split_end_key();
+
     // Range
     for (auto key_range : key_ranges) {
         if (key_range->begin_scan_range.size() == 1 && key_range->begin_scan_range.get_value(0) == NEGATIVE_INFINITY) {
@@ -196,9 +229,216 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
     // Actually only the key columns need to be sorted by id, here we check all
     // for simplicity.
     DCHECK(std::is_sorted(reader_columns.begin(), reader_columns.end()));
+
+    if (config::scan_chunk_target_bytes > 0) {
+        size_t row_bytes = std::max<size_t>(1, _estimate_row_bytes(_tablet->tablet_schema(), reader_columns));
+        size_t num_rows = std::max<size_t>(config::scan_chunk_target_bytes / row_bytes, kMinScanChunkRows);
+        _params.chunk_size = std::min<int>(_params.chunk_size, num_rows);
+    }
     return Status::OK();
 }
 
+size_t OlapChunkSource::_estimate_row_bytes(const TabletSchema& schema, const std::vector<uint32_t>& column_ids) {
+    size_t row_bytes = 0;
+    for (auto cid : column_ids) {
+        const TabletColumn& column = schema.column(cid);
+        if (is_string_type(column.type())) {
+            // The declared length of the strings is usually far larger than the values.
+            row_bytes += std::min<size_t>(column.length(), kEstimatedMaxStringBytes) + sizeof(uint32_t);
+        } else if (column.type() == OLAP_FIELD_TYPE_ARRAY || column.type() == OLAP_FIELD_TYPE_HLL ||
+                   column.type() == OLAP_FIELD_TYPE_OBJECT || column.type() == OLAP_FIELD_TYPE_PERCENTILE ||
+                   column.type() == OLAP_FIELD_TYPE_JSON) {
+            row_bytes += kEstimatedMaxStringBytes + sizeof(uint32_t);
+        } else {
+            row_bytes += get_type_info(column)->size();
+        }
+        row_bytes += column.is_nullable() ? sizeof(uint8_t) : 0;
+    }
+    return row_bytes;
+}
+
+// Only the types whose storage columns are the same as the columns in computation layer. The string types are
+// excluded, because SegmentIterator may rewrite the predicates on strings to the predicates on dict codes.
+static bool can_push_down_runtime_filter(PrimitiveType type) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DECIMALV2:
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Returns the column of |slot_id| which a runtime filter can be pushed down to, or -1 if there's no such one.
+int32_t OlapChunkSource::_runtime_filter_column_index(SlotId slot_id, TypeInfoPtr* type_info) const {
+    const SlotDescriptor* slot = nullptr;
+    for (const SlotDescriptor* s : *_slots) {
+        if (s->id() == slot_id) {
+            slot = s;
+            break;
+        }
+    }
+    if (slot == nullptr || !can_push_down_runtime_filter(slot->type().type)) {
+        return -1;
+    }
+    int32_t index = _tablet->field_index(slot->col_name());
+    if (index < 0) {
+        return -1;
+    }
+    const TabletColumn& column = _tablet->tablet_schema().column(index);
+    FieldType field_type = TypeUtils::to_storage_format_v2(column.type());
+    if (scalar_field_type_to_primitive_type(field_type) != slot->type().type) {
+        return -1;
+    }
+    *type_info = get_type_info(field_type, column.precision(), column.scale());
+    return index;
+}
+
+void OlapChunkSource::_init_runtime_filter_predicates(const PredicateParser& parser) {
+    // The runtime filters are evaluated while reading the segments, so the other columns are not materialized
+    // for the filtered rows. The runtime filters not arrived yet are pushed down too, once one arrives,
+    // SegmentIterator prunes the pages left to read by its min/max, and evaluates it from the next chunk on.
+    // They are still evaluated by the scan operator, which is cheap since most rows have been filtered.
+    for (const auto& it : _runtime_bloom_filters.descriptors()) {
+        const RuntimeFilterProbeDescriptor* desc = it.second;
+        SlotId slot_id;
+        if (!desc->is_probe_slot_ref(&slot_id)) {
+            continue;
+        }
+        TypeInfoPtr type_info;
+        int32_t index = _runtime_filter_column_index(slot_id, &type_info);
+        if (index < 0) {
+            continue;
+        }
+        PredicatePtr pred = std::make_unique<ColumnRuntimeFilterPredicate>(type_info, index, desc);
+        if (parser.can_pushdown(pred.get())) {
+            _params.predicates.push_back(pred.get());
+            _predicate_free_pool.emplace_back(std::move(pred));
+        }
+    }
+
+    // The threshold of the TopN above, whose rows are only evaluated by the storage layer.
+    if (_runtime_topn_threshold != nullptr) {
+        TypeInfoPtr type_info;
+        int32_t index = _runtime_filter_column_index(_runtime_topn_threshold->slot_id(), &type_info);
+        if (index < 0) {
+            return;
+        }
+        PredicatePtr pred = std::make_unique<ColumnRuntimeTopnPredicate>(type_info, index, _runtime_topn_threshold);
+        if (parser.can_pushdown(pred.get())) {
+            _params.predicates.push_back(pred.get());
+            _predicate_free_pool.emplace_back(std::move(pred));
+        }
+    }
+}
+
+// Whether no value of [begin, end] passes |rf|. A runtime filter with a null may match the nulls of the tablet.
+template <PrimitiveType PT>
+static bool runtime_filter_excludes_range(const JoinRuntimeFilter* rf, int64_t begin, int64_t end) {
+    if (rf->has_null()) {
+        return false;
+    }
+    const auto* bf = down_cast<const RuntimeBloomFilter<PT>*>(rf);
+    if (!bf->has_min_max()) {
+        // the build side is empty.
+        return true;
+    }
+    return static_cast<int64_t>(bf->max_value()) < begin || static_cast<int64_t>(bf->min_value()) > end;
+}
+
+// Whether the partition of the tablet can't have a row passing the runtime filters arrived before the scan, by the
+// range of its integer partition column sent by the FE, in which case the tablet is not read at all. The operator
+// waits for the runtime filters, within their timeout, before the chunk sources are prepared.
+bool OlapChunkSource::_is_pruned_by_runtime_filters() const {
+    if (!_scan_range->__isset.partition_column_ranges) {
+        return false;
+    }
+    for (const TKeyRange& range : _scan_range->partition_column_ranges) {
+        for (const auto& it : _runtime_bloom_filters.descriptors()) {
+            const RuntimeFilterProbeDescriptor* desc = it.second;
+            const JoinRuntimeFilter* rf = desc->runtime_filter();
+            SlotId slot_id;
+            if (rf == nullptr || !desc->is_probe_slot_ref(&slot_id)) {
+                continue;
+            }
+            const SlotDescriptor* slot = nullptr;
+            for (const SlotDescriptor* s : *_slots) {
+                if (s->id() == slot_id) {
+                    slot = s;
+                    break;
+                }
+            }
+            if (slot == nullptr || slot->col_name() != range.column_name) {
+                continue;
+            }
+            bool excluded = false;
+            switch (slot->type().type) {
+            case TYPE_TINYINT:
+                excluded = runtime_filter_excludes_range<TYPE_TINYINT>(rf, range.begin_key, range.end_key);
+                break;
+            case TYPE_SMALLINT:
+                excluded = runtime_filter_excludes_range<TYPE_SMALLINT>(rf, range.begin_key, range.end_key);
+                break;
+            case TYPE_INT:
+                excluded = runtime_filter_excludes_range<TYPE_INT>(rf, range.begin_key, range.end_key);
+                break;
+            case TYPE_BIGINT:
+                excluded = runtime_filter_excludes_range<TYPE_BIGINT>(rf, range.begin_key, range.end_key);
+                break;
+            default:
+                break;
+            }
+            if (excluded) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void OlapChunkSource::_init_column_exprs() {
+    if (_column_expr_ctxs == nullptr) {
+        return;
+    }
+    for (const auto& [slot_id, expr_ctx] : *_column_expr_ctxs) {
+        const SlotDescriptor* slot = nullptr;
+        for (const SlotDescriptor* s : *_slots) {
+            if (s->id() == slot_id) {
+                slot = s;
+                break;
+            }
+        }
+        DCHECK(slot != nullptr);
+        if (slot == nullptr) {
+            continue;
+        }
+        // The values of the other tablets are aggregated by the storage after they are read, and the global
+        // dicts encode the original values.
+        int32_t index = _tablet->field_index(slot->col_name());
+        const TabletColumn& column = _tablet->tablet_schema().column(index);
+        if (_tablet->keys_type() == DUP_KEYS && !column.is_key() && column.is_nullable() &&
+            column.type() == OLAP_FIELD_TYPE_VARCHAR && _params.global_dictmaps->count(index) == 0) {
+            _column_exprs.emplace_back(
+                    std::make_unique<vectorized::ColumnExpr>(index, _runtime_state, expr_ctx, slot));
+            _params.column_exprs.push_back(_column_exprs.back().get());
+        } else {
+            _not_push_down_column_exprs.emplace_back(slot, expr_ctx);
+        }
+    }
+}
+
 Status OlapChunkSource::_init_scanner_columns(std::vector<uint32_t>& scanner_columns) {
     for (auto slot : *_slots) {
         DCHECK(slot->is_materialized());
@@ -245,6 +485,28 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     std::vector<uint32_t> reader_columns;
 
     RETURN_IF_ERROR(_get_tablet(_scan_range));
+
+    // Only the new versions are read if the result of an older version is cached.
+    Version read_version(0, _version);
+    std::vector<RowsetSharedPtr> incremental_rowsets;
+    _init_scan_cache_key();
+    ScanResultCache::Result cached;
+    if (!_scan_cache_key.empty() && ScanResultCache::instance()->lookup(_scan_cache_key, &cached)) {
+        if (cached.version == _version) {
+            _cached_chunks = std::move(cached.chunks);
+            return Status::OK();
+        }
+        if (cached.version < _version && _capture_incremental_rowsets(cached.version, &incremental_rowsets)) {
+            StarRocksMetrics::instance()->scan_result_cache_incremental_hit_total.increment(1);
+            read_version = Version(cached.version + 1, _version);
+            for (const auto& chunk : cached.chunks) {
+                _cached_chunks.emplace_back(ScanResultCache::copy_chunk(*chunk));
+                _bytes_to_cache += chunk->memory_usage();
+            }
+            _chunks_to_cache = std::move(cached.chunks);
+        }
+    }
+
     RETURN_IF_ERROR(_init_global_dicts(&_params));
     RETURN_IF_ERROR(_init_unused_output_columns(*_unused_output_columns));
     RETURN_IF_ERROR(_init_scanner_columns(scanner_columns));
@@ -252,7 +514,7 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
     starrocks::vectorized::Schema child_schema =
             ChunkHelper::convert_schema_to_format_v2(tablet_schema, reader_columns);
-    _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema));
+    _reader = std::make_shared<TabletReader>(_tablet, read_version, std::move(child_schema));
     if (reader_columns.size() == scanner_columns.size()) {
         _prj_iter = _reader;
     } else {
@@ -269,11 +531,62 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     RETURN_IF_ERROR(_prj_iter->init_encoded_schema(*_params.global_dictmaps));
     RETURN_IF_ERROR(_prj_iter->init_output_schema(*_params.unused_output_column_ids));
 
-    RETURN_IF_ERROR(_reader->prepare());
+    auto* olap_morsel = down_cast<OlapMorsel*>(_morsel.get());
+    if (read_version.first > 0) {
+        RETURN_IF_ERROR(_reader->prepare(std::move(incremental_rowsets)));
+    } else if (olap_morsel->rowsets() != nullptr) {
+        RETURN_IF_ERROR(_reader->prepare(*olap_morsel->rowsets()));
+    } else {
+        RETURN_IF_ERROR(_reader->prepare());
+    }
     RETURN_IF_ERROR(_reader->open(_params));
     return Status::OK();
 }
 
+void OlapChunkSource::_init_scan_cache_key() {
+    // The morsels split from a tablet, and the chunks encoded by the global dicts of a query, aren't cached.
+    auto* olap_morsel = down_cast<OlapMorsel*>(_morsel.get());
+    if (_scan_cache_digest == nullptr || ScanResultCache::instance() == nullptr || olap_morsel->rowsets() != nullptr ||
+        olap_morsel->is_key_split() || !_runtime_state->get_query_global_dict_map().empty()) {
+        return;
+    }
+    std::stringstream key;
+    key << *_scan_cache_digest << '|' << _scan_range->tablet_id << '|' << _scan_range->schema_hash;
+    for (const SlotDescriptor* slot : *_slots) {
+        key << '|' << slot->id() << ':' << slot->col_name() << ':' << slot->type().debug_string();
+    }
+    _scan_cache_key = key.str();
+}
+
+// The new rowsets can be read alone and appended to the cached result of |cached_version|, only if the rows of
+// the cached result are not deleted or replaced by the new versions.
+bool OlapChunkSource::_capture_incremental_rowsets(int64_t cached_version, std::vector<RowsetSharedPtr>* rowsets) {
+    if (_tablet->keys_type() != DUP_KEYS || _tablet->updates() != nullptr) {
+        return false;
+    }
+    std::shared_lock header_lock(_tablet->get_header_lock());
+    for (const DeletePredicatePB& pred : _tablet->delete_predicates()) {
+        if (pred.version() > cached_version && pred.version() <= _version) {
+            return false;
+        }
+    }
+    // fails if the versions are compacted across |cached_version|
+    return _tablet->capture_consistent_rowsets(Version(cached_version + 1, _version), rowsets).ok();
+}
+
+void OlapChunkSource::_add_chunk_to_cache(const vectorized::Chunk& chunk) {
+    if (_scan_cache_key.empty() || chunk.num_rows() == 0) {
+        return;
+    }
+    _bytes_to_cache += chunk.memory_usage();
+    if (_bytes_to_cache > config::scan_result_cache_max_entry_bytes) {
+        _scan_cache_key.clear();
+        _chunks_to_cache.clear();
+        return;
+    }
+    _chunks_to_cache.emplace_back(ScanResultCache::copy_chunk(chunk));
+}
+
 bool OlapChunkSource::has_next_chunk() const {
     // If we need and could get next chunk from storage engine,
     // the _status must be ok.
@@ -300,17 +613,52 @@ Status OlapChunkSource::buffer_next_batch_chunks_blocking(size_t batch_size, boo
     }
     using namespace vectorized;
 
-    for (size_t i = 0; i < batch_size && !can_finish; ++i) {
+    size_t i = 0;
+    for (; i < batch_size && !can_finish && _next_cached_chunk < _cached_chunks.size(); ++i) {
+        _chunk_buffer.put(std::move(_cached_chunks[_next_cached_chunk++]));
+    }
+    if (_reader == nullptr) {
+        if (_next_cached_chunk == _cached_chunks.size()) {
+            _status = Status::EndOfFile("the cached result is read out");
+        }
+        return _status;
+    }
+
+    for (; i < batch_size && !can_finish; ++i) {
         ChunkUniquePtr chunk(
                 ChunkHelper::new_chunk_pooled(_prj_iter->encoded_schema(), _runtime_state->chunk_size(), true));
         _status = _read_chunk_from_storage(_runtime_state, chunk.get());
+        // The selective filters leave small chunks, which cost the operators above as much as the full ones.
+        // The chunks read next are appended until it has half of the rows of a read, but never more than
+        // the chunk size of the runtime, which the operators size their buffers by.
+        const size_t min_rows = config::enable_scan_chunk_coalesce ? _params.chunk_size / 2 : 0;
+        while (_status.ok() && chunk->num_rows() < min_rows) {
+            ChunkUniquePtr next(
+                    ChunkHelper::new_chunk_pooled(_prj_iter->encoded_schema(), _runtime_state->chunk_size(), true));
+            _status = _read_chunk_from_storage(_runtime_state, next.get());
+            if (!_status.ok() && !_status.is_end_of_file()) {
+                break;
+            }
+            if (chunk->num_rows() + next->num_rows() <= _runtime_state->chunk_size()) {
+                chunk->append(*next);
+            } else {
+                _add_chunk_to_cache(*chunk);
+                _chunk_buffer.put(std::move(chunk));
+                chunk = std::move(next);
+            }
+        }
         if (!_status.ok()) {
             // end of file is normal case, need process chunk
             if (_status.is_end_of_file()) {
+                _add_chunk_to_cache(*chunk);
+                if (!_scan_cache_key.empty()) {
+                    ScanResultCache::instance()->insert(_scan_cache_key, {_version, std::move(_chunks_to_cache)});
+                }
                 _chunk_buffer.put(std::move(chunk));
             }
             break;
         }
+        _add_chunk_to_cache(*chunk);
         _chunk_buffer.put(std::move(chunk));
     }
     return _status;
@@ -364,10 +712,19 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
         }
         if (!_not_push_down_conjuncts.empty()) {
             SCOPED_TIMER(_expr_filter_timer);
-            ExecNode::eval_conjuncts(_not_push_down_conjuncts, chunk);
+            if (_conjuncts_evaluator != nullptr) {
+                _conjuncts_evaluator->evaluate(chunk);
+            } else {
+                ExecNode::eval_conjuncts(_not_push_down_conjuncts, chunk);
+            }
             DCHECK_CHUNK(chunk);
         }
     } while (chunk->num_rows() == 0);
+    for (const auto& [slot, expr_ctx] : _not_push_down_column_exprs) {
+        ColumnPtr column = expr_ctx->evaluate(chunk);
+        chunk->update_column(ColumnHelper::move_column(slot->type(), slot->is_nullable(), column, chunk->num_rows()),
+                             slot->id());
+    }
     _update_realtime_counter(chunk);
     // Improve for select * from table limit x, x is small
     if (_limit != -1 && _num_rows_read >= _limit) {
@@ -378,9 +735,21 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
 
 Status OlapChunkSource::close(RuntimeState* state) {
     _update_counter();
-    _prj_iter->close();
+    if (_tablet != nullptr) {
+        _tablet->record_scan(_compressed_bytes_read);
+        std::vector<const vectorized::ColumnPredicate*> predicates;
+        for (const auto& pred : _predicate_free_pool) {
+            predicates.push_back(pred.get());
+        }
+        _tablet->record_column_access(
+                vectorized::collect_column_access(_tablet->tablet_schema(), *_slots, predicates, state));
+    }
+    if (_prj_iter != nullptr) {
+        _prj_iter->close();
+    }
     _reader.reset();
     _predicate_free_pool.clear();
+    _column_exprs.clear();
     _dict_optimize_parser.close(state);
     return Status::OK();
 }
@@ -397,6 +766,9 @@ void OlapChunkSource::_update_realtime_counter(vectorized::Chunk* chunk) {
 }
 
 void OlapChunkSource::_update_counter() {
+    if (_reader == nullptr) {
+        return;
+    }
     COUNTER_UPDATE(_create_seg_iter_timer, _reader->stats().create_segment_iter_ns);
     COUNTER_UPDATE(_rows_read_counter, _num_rows_read);
 
@@ -425,6 +797,7 @@ void OlapChunkSource::_update_counter() {
     COUNTER_UPDATE(_zm_filtered_counter, _reader->stats().rows_stats_filtered);
     COUNTER_UPDATE(_bf_filtered_counter, _reader->stats().rows_bf_filtered);
     COUNTER_UPDATE(_sk_filtered_counter, _reader->stats().rows_key_range_filtered);
+    COUNTER_UPDATE(_sorted_filtered_counter, _reader->stats().rows_sorted_range_filtered);
     COUNTER_UPDATE(_index_load_timer, _reader->stats().index_load_ns);
 
     COUNTER_UPDATE(_read_pages_num_counter, _reader->stats().total_pages_num);
@@ -432,10 +805,13 @@ void OlapChunkSource::_update_counter() {
 
     COUNTER_UPDATE(_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
+    COUNTER_UPDATE(_ii_filtered_counter, _reader->stats().rows_inverted_index_filtered);
+    COUNTER_UPDATE(_ii_filter_timer, _reader->stats().inverted_index_filter_timer);
     COUNTER_UPDATE(_block_seek_counter, _reader->stats().block_seek_num);
 
     COUNTER_UPDATE(_rowsets_read_count, _reader->stats().rowsets_read_count);
     COUNTER_UPDATE(_segments_read_count, _reader->stats().segments_read_count);
+    vectorized::update_column_read_profile(_tablet->tablet_schema(), _reader->stats(), _scan_profile);
     COUNTER_UPDATE(_total_columns_data_page_count, _reader->stats().total_columns_data_page_count);
 
     COUNTER_SET(_pushdown_predicates_counter, (int64_t)_params.predicates.size());
@@ -443,6 +819,18 @@ void OlapChunkSource::_update_counter() {
     StarRocksMetrics::instance()->query_scan_bytes.increment(_compressed_bytes_read);
     StarRocksMetrics::instance()->query_scan_rows.increment(_raw_rows_read);
 
+    if (_reader->stats().compressed_cached_pages_num > 0) {
+        RuntimeProfile::Counter* c = ADD_COUNTER(_scan_profile, "CompressedCachedPagesNum", TUnit::UNIT);
+        COUNTER_UPDATE(c, _reader->stats().compressed_cached_pages_num);
+    }
+    if (_reader->stats().coalesced_read_num > 0) {
+        RuntimeProfile::Counter* c1 = ADD_COUNTER(_scan_profile, "CoalescedReadNum", TUnit::UNIT);
+        RuntimeProfile::Counter* c2 = ADD_COUNTER(_scan_profile, "CoalescedBytesRead", TUnit::BYTES);
+        RuntimeProfile::Counter* c3 = ADD_COUNTER(_scan_profile, "CoalescedBytesUsed", TUnit::BYTES);
+        COUNTER_UPDATE(c1, _reader->stats().coalesced_read_num);
+        COUNTER_UPDATE(c2, _reader->stats().coalesced_bytes_read);
+        COUNTER_UPDATE(c3, _reader->stats().coalesced_bytes_used);
+    }
     if (_reader->stats().decode_dict_ns > 0) {
         RuntimeProfile::Counter* c = ADD_TIMER(_scan_profile, "DictDecode");
         COUNTER_UPDATE(c, _reader->stats().decode_dict_ns);
@@ -7,20 +7,24 @@
 #include "exec/olap_common.h"
 #include "exec/olap_utils.h"
 #include "exec/pipeline/chunk_source.h"
+#include "exec/vectorized/conjuncts_evaluator.h"
 #include "exec/vectorized/olap_scan_prepare.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/runtime_state.h"
 #include "storage/tablet.h"
+#include "storage/vectorized/column_expr.h"
 #include "storage/vectorized/conjunctive_predicates.h"
 #include "storage/vectorized/tablet_reader.h"
 
 namespace starrocks {
 class SlotDescriptor;
 namespace vectorized {
+class PredicateParser;
 class RuntimeFilterProbeCollector;
-}
+class RuntimeTopnThreshold;
+} // namespace vectorized
 namespace pipeline {
 
 class OlapChunkSource final : public ChunkSource {
@@ -28,8 +32,10 @@ public:
     OlapChunkSource(MorselPtr&& morsel, int32_t tuple_id, int64_t limit, bool enable_column_expr_predicate,
                     std::vector<ExprContext*> conjunct_ctxs, std::vector<ExprContext*>& runtime_in_filters,
                     vectorized::RuntimeFilterProbeCollector* runtime_bloom_filters,
+                    const vectorized::RuntimeTopnThreshold* runtime_topn_threshold,
                     std::vector<std::string> key_column_names, bool skip_aggregation,
-                    std::vector<std::string>* unused_output_columns, RuntimeProfile* runtime_profile)
+                    std::vector<std::string>* unused_output_columns, const std::string* scan_cache_digest,
+                    RuntimeProfile* runtime_profile)
             : ChunkSource(std::move(morsel)),
               _tuple_id(tuple_id),
               _limit(limit),
@@ -37,9 +43,11 @@ public:
               _conjunct_ctxs(std::move(conjunct_ctxs)),
               _runtime_in_filters(runtime_in_filters),
               _runtime_bloom_filters(*runtime_bloom_filters),
+              _runtime_topn_threshold(runtime_topn_threshold),
               _key_column_names(std::move(key_column_names)),
               _skip_aggregation(skip_aggregation),
               _unused_output_columns(unused_output_columns),
+              _scan_cache_digest(scan_cache_digest),
               _runtime_profile(runtime_profile) {
         _conjunct_ctxs.insert(_conjunct_ctxs.end(), _runtime_in_filters.begin(), _runtime_in_filters.end());
         OlapMorsel* olap_morsel = (OlapMorsel*)_morsel.get();
@@ -62,19 +70,41 @@ public:
 
     Status buffer_next_batch_chunks_blocking(size_t chunk_size, bool& can_finish) override;
 
+    int64_t bytes_read() const override { return _compressed_bytes_read; }
+
+    // The slots output as the results of the expressions over them, see ScanOperatorFactory::push_down_column_expr.
+    // Must be called before `prepare`.
+    void set_column_expr_ctxs(const std::vector<std::pair<SlotId, ExprContext*>>* column_expr_ctxs) {
+        _column_expr_ctxs = column_expr_ctxs;
+    }
+
 private:
     Status _get_tablet(const TInternalScanRange* scan_range);
     Status _init_reader_params(const std::vector<OlapScanRange*>& key_ranges,
                                const std::vector<uint32_t>& scanner_columns, std::vector<uint32_t>& reader_columns);
     Status _init_scanner_columns(std::vector<uint32_t>& scanner_columns);
+    int32_t _runtime_filter_column_index(SlotId slot_id, TypeInfoPtr* type_info) const;
+    void _init_runtime_filter_predicates(const vectorized::PredicateParser& parser);
+    bool _is_pruned_by_runtime_filters() const;
     Status _init_unused_output_columns(const std::vector<std::string>& unused_output_columns);
     Status _init_olap_reader(RuntimeState* state);
     void _init_counter(RuntimeState* state);
     Status _init_global_dicts(vectorized::TabletReaderParams* params);
+    void _init_column_exprs();
     Status _build_scan_range(RuntimeState* state);
     Status _read_chunk_from_storage([[maybe_unused]] RuntimeState* state, vectorized::Chunk* chunk);
     void _update_counter();
     void _update_realtime_counter(vectorized::Chunk* chunk);
+    void _init_scan_cache_key();
+    bool _capture_incremental_rowsets(int64_t cached_version, std::vector<RowsetSharedPtr>* rowsets);
+    void _add_chunk_to_cache(const vectorized::Chunk& chunk);
+    // The estimated bytes of a row of the columns, the variable-length ones counted by a bounded average.
+    static size_t _estimate_row_bytes(const TabletSchema& schema, const std::vector<uint32_t>& column_ids);
+
+    // The chunks of the scans of the widest rows still have as many rows as this, so that the cost per
+    // chunk of the operators doesn't dominate.
+    static constexpr size_t kMinScanChunkRows = 512;
+    static constexpr size_t kEstimatedMaxStringBytes = 32;
 
     vectorized::TabletReaderParams _params = {};
 
@@ -84,6 +114,8 @@ private:
     std::vector<ExprContext*> _conjunct_ctxs;
     const std::vector<ExprContext*>& _runtime_in_filters;
     const vectorized::RuntimeFilterProbeCollector& _runtime_bloom_filters;
+    // nullptr if there's no TopN above this scan in the same pipeline.
+    const vectorized::RuntimeTopnThreshold* _runtime_topn_threshold;
     std::vector<std::string> _key_column_names;
     bool _skip_aggregation;
     TInternalScanRange* _scan_range;
@@ -92,6 +124,7 @@ private:
     UnboundedBlockingQueue<vectorized::ChunkPtr> _chunk_buffer;
     // The conjuncts couldn't push down to storage engine
     std::vector<ExprContext*> _not_push_down_conjuncts;
+    std::unique_ptr<vectorized::AdaptiveConjunctsEvaluator> _conjuncts_evaluator;
     vectorized::ConjunctivePredicates _not_push_down_predicates;
     std::vector<uint8_t> _selection;
 
@@ -112,10 +145,29 @@ private:
 
     const std::vector<std::string>* _unused_output_columns = nullptr;
     std::unordered_set<uint32_t> _unused_output_column_ids;
+
+    // nullptr if the results of this scan aren't cached, see ScanResultCache.
+    const std::string* _scan_cache_digest = nullptr;
+    // The key of the result of the tablet, empty if it isn't cached.
+    std::string _scan_cache_key;
+    // The cached chunks to output before the ones read from |_reader|, and |_reader| is nullptr if the cached
+    // result is at |_version|.
+    std::vector<vectorized::ChunkPtr> _cached_chunks;
+    size_t _next_cached_chunk = 0;
+    // The chunks of the result at |_version| to cache once the tablet is read to the end, and they are dropped
+    // once they are more than config::scan_result_cache_max_entry_bytes.
+    std::vector<vectorized::ChunkPtr> _chunks_to_cache;
+    int64_t _bytes_to_cache = 0;
     // For release memory.
     using PredicatePtr = std::unique_ptr<vectorized::ColumnPredicate>;
     std::vector<PredicatePtr> _predicate_free_pool;
 
+    const std::vector<std::pair<SlotId, ExprContext*>>* _column_expr_ctxs = nullptr;
+    // The expressions evaluated by the storage, referred by |_params|.
+    std::vector<std::unique_ptr<vectorized::ColumnExpr>> _column_exprs;
+    // The expressions evaluated on the chunks read from the storage.
+    std::vector<std::pair<const SlotDescriptor*, ExprContext*>> _not_push_down_column_exprs;
+
     // slot descriptors for each one of |output_columns|.
     std::vector<SlotDescriptor*> _query_slots;
 
@@ -147,6 +199,7 @@ private:
     RuntimeProfile::Counter* _zm_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bf_filtered_counter = nullptr;
     RuntimeProfile::Counter* _sk_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _sorted_filtered_counter = nullptr;
     RuntimeProfile::Counter* _block_seek_timer = nullptr;
     RuntimeProfile::Counter* _block_seek_counter = nullptr;
     RuntimeProfile::Counter* _block_load_timer = nullptr;
@@ -157,7 +210,10 @@ private:
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
+    RuntimeProfile::Counter* _ii_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _ii_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
+    RuntimeProfile::Counter* _tablets_pruned_counter = nullptr;
     RuntimeProfile::Counter* _rowsets_read_count = nullptr;
     RuntimeProfile::Counter* _segments_read_count = nullptr;
     RuntimeProfile::Counter* _total_columns_data_page_count = nullptr;
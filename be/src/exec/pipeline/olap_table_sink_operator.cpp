@@ -0,0 +1,61 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/olap_table_sink_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status OlapTableSinkOperator::close(RuntimeState* state) {
+    Status final_status = _fragment_ctx->final_status();
+    // the fragment is cancelled before this operator has seen all the input.
+    if (final_status.ok() && !_is_finished) {
+        final_status = Status::Cancelled("olap table sink is closed before finishing");
+    }
+    Status st = down_cast<OlapTableSinkOperatorFactory*>(_factory)->close_sink(state, final_status);
+    Operator::close(state);
+    return st;
+}
+
+bool OlapTableSinkOperator::need_input() const {
+    return !_is_finished && !_sink->is_full();
+}
+
+StatusOr<vectorized::ChunkPtr> OlapTableSinkOperator::pull_chunk(RuntimeState* state) {
+    CHECK(false) << "Shouldn't pull chunk from olap table sink operator";
+}
+
+Status OlapTableSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    return _sink->send_chunk(state, chunk.get());
+}
+
+Status OlapTableSinkOperatorFactory::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    RETURN_IF_ERROR(_sink->prepare(state));
+    state->runtime_profile()->add_child(_sink->profile(), true, nullptr);
+    // the open of the tablet writers waits for the rpc of every BE, do it here rather than in a driver.
+    _sink_opened = true;
+    return _sink->open(state);
+}
+
+void OlapTableSinkOperatorFactory::close(RuntimeState* state) {
+    // the drivers are never created or run if the fragment fails to prepare.
+    if (_sink_opened) {
+        close_sink(state, Status::Cancelled("olap table sink is not closed by the operator"));
+    }
+    OperatorFactory::close(state);
+}
+
+Status OlapTableSinkOperatorFactory::close_sink(RuntimeState* state, const Status& close_status) {
+    if (_sink_closed) {
+        return Status::OK();
+    }
+    _sink_closed = true;
+    return _sink->close(state, close_status);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <utility>
+
+#include "exec/pipeline/fragment_context.h"
+#include "exec/pipeline/operator.h"
+#include "exec/tablet_sink.h"
+
+namespace starrocks::pipeline {
+
+// OlapTableSinkOperator writes the chunks into an OLAP table through the OlapTableSink of the fragment instance.
+// Instead of sleeping in OlapTableSink::send_chunk() while the NodeChannels have too many pending chunks,
+// it stops asking for input, so the driver is parked by the poller and the CPU is left to the other drivers.
+class OlapTableSinkOperator final : public Operator {
+public:
+    OlapTableSinkOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id,
+                          stream_load::OlapTableSink* sink, FragmentContext* const fragment_ctx)
+            : Operator(factory, id, "olap_table_sink", plan_node_id), _sink(sink), _fragment_ctx(fragment_ctx) {}
+
+    ~OlapTableSinkOperator() override = default;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() const override { return false; }
+
+    bool need_input() const override;
+
+    bool is_finished() const override { return _is_finished; }
+
+    void set_finishing(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    stream_load::OlapTableSink* _sink;
+    bool _is_finished = false;
+
+    FragmentContext* const _fragment_ctx;
+};
+
+class OlapTableSinkOperatorFactory final : public OperatorFactory {
+public:
+    OlapTableSinkOperatorFactory(int32_t id, std::unique_ptr<stream_load::OlapTableSink> sink,
+                                 FragmentContext* const fragment_ctx)
+            : OperatorFactory(id, "olap_table_sink", Operator::s_pseudo_plan_node_id_for_olap_table_sink),
+              _sink(std::move(sink)),
+              _fragment_ctx(fragment_ctx) {}
+
+    ~OlapTableSinkOperatorFactory() override = default;
+
+    // OlapTableSink isn't thread-safe, the drivers of the pipeline are gathered into one before this operator.
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        DCHECK_EQ(1, degree_of_parallelism);
+        return std::make_shared<OlapTableSinkOperator>(this, _id, _plan_node_id, _sink.get(), _fragment_ctx);
+    }
+
+    Status prepare(RuntimeState* state) override;
+
+    void close(RuntimeState* state) override;
+
+    // Closes the sink once with |close_status|, the sink is cancelled if it is closed with an error.
+    Status close_sink(RuntimeState* state, const Status& close_status);
+
+private:
+    std::unique_ptr<stream_load::OlapTableSink> _sink;
+    bool _sink_opened = false;
+    bool _sink_closed = false;
+
+    FragmentContext* const _fragment_ctx;
+};
+
+} // namespace starrocks::pipeline
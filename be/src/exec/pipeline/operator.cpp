@@ -4,6 +4,7 @@
 
 #include <algorithm>
 
+#include "common/config.h"
 #include "exec/exec_node.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_state.h"
@@ -12,6 +13,7 @@
 namespace starrocks::pipeline {
 
 const int32_t Operator::s_pseudo_plan_node_id_for_result_sink = -99;
+const int32_t Operator::s_pseudo_plan_node_id_for_olap_table_sink = -98;
 const int32_t Operator::s_pseudo_plan_node_id_upper_bound = -100;
 
 Operator::Operator(OperatorFactory* factory, int32_t id, const std::string& name, int32_t plan_node_id)
@@ -43,6 +45,9 @@ Status Operator::prepare(RuntimeState* state) {
     _push_row_num_counter = ADD_COUNTER(_runtime_profile, "PushRowNum", TUnit::UNIT);
     _pull_chunk_num_counter = ADD_COUNTER(_runtime_profile, "PullChunkNum", TUnit::UNIT);
     _pull_row_num_counter = ADD_COUNTER(_runtime_profile, "PullRowNum", TUnit::UNIT);
+    _allocated_bytes_counter = ADD_COUNTER(_runtime_profile, "AllocatedBytes", TUnit::BYTES);
+    _peak_memory_usage_counter = _runtime_profile->AddHighWaterMarkCounter("OperatorPeakMemoryUsage", TUnit::BYTES);
+    _cpu_timer = ADD_TIMER(_runtime_profile, "OperatorCpuTime");
     return Status::OK();
 }
 
@@ -88,6 +93,10 @@ void Operator::eval_conjuncts_and_in_filters(const std::vector<ExprContext*>& co
         _cached_conjuncts_and_in_filters.insert(_cached_conjuncts_and_in_filters.end(), in_filters.begin(),
                                                 in_filters.end());
         _conjuncts_and_in_filters_is_cached = true;
+        if (config::enable_adaptive_conjuncts_evaluation) {
+            _conjuncts_evaluator =
+                    std::make_unique<vectorized::AdaptiveConjunctsEvaluator>(_cached_conjuncts_and_in_filters);
+        }
     }
     if (chunk == nullptr || chunk->is_empty()) {
         return;
@@ -97,7 +106,11 @@ void Operator::eval_conjuncts_and_in_filters(const std::vector<ExprContext*>& co
         SCOPED_TIMER(_conjuncts_timer);
         auto before = chunk->num_rows();
         _conjuncts_input_counter->update(before);
-        starrocks::ExecNode::eval_conjuncts(_cached_conjuncts_and_in_filters, chunk);
+        if (_conjuncts_evaluator != nullptr) {
+            _conjuncts_evaluator->evaluate(chunk);
+        } else {
+            starrocks::ExecNode::eval_conjuncts(_cached_conjuncts_and_in_filters, chunk);
+        }
         auto after = chunk->num_rows();
         _conjuncts_output_counter->update(after);
         _conjuncts_eval_counter->update(before - after);
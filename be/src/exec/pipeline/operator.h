@@ -5,6 +5,7 @@
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
 #include "exec/pipeline/runtime_filter_types.h"
+#include "exec/vectorized/conjuncts_evaluator.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/casts.h"
 #include "gutil/strings/substitute.h"
@@ -130,8 +131,9 @@ public:
     // 1. (-∞, s_pseudo_plan_node_id_upper_bound] is for operator which is not in the query's plan
     // for example, LocalExchangeSinkOperator, LocalExchangeSourceOperator
     // 2. (s_pseudo_plan_node_id_upper_bound, -1] is for operator which is in the query's plan
-    // for example, ResultSink
+    // for example, ResultSink, OlapTableSink
     static const int32_t s_pseudo_plan_node_id_for_result_sink;
+    static const int32_t s_pseudo_plan_node_id_for_olap_table_sink;
     static const int32_t s_pseudo_plan_node_id_upper_bound;
 
 protected:
@@ -144,6 +146,8 @@ protected:
     MemTracker* _mem_tracker = nullptr;
     bool _conjuncts_and_in_filters_is_cached = false;
     std::vector<ExprContext*> _cached_conjuncts_and_in_filters;
+    // evaluates _cached_conjuncts_and_in_filters if config::enable_adaptive_conjuncts_evaluation is on
+    std::unique_ptr<vectorized::AdaptiveConjunctsEvaluator> _conjuncts_evaluator;
 
     vectorized::RuntimeBloomFilterEvalContext _bloom_filter_eval_context;
 
@@ -159,6 +163,14 @@ protected:
     RuntimeProfile::Counter* _push_row_num_counter = nullptr;
     RuntimeProfile::Counter* _pull_chunk_num_counter = nullptr;
     RuntimeProfile::Counter* _pull_row_num_counter = nullptr;
+    // the bytes allocated by push_chunk() and pull_chunk(), the released ones are not subtracted
+    RuntimeProfile::Counter* _allocated_bytes_counter = nullptr;
+    // the peak of the bytes allocated minus the bytes freed by push_chunk() and pull_chunk(), the memory the operator
+    // frees on the other threads or outside of them is not subtracted
+    RuntimeProfile::HighWaterMarkCounter* _peak_memory_usage_counter = nullptr;
+    // the on-CPU time of push_chunk() and pull_chunk(), the rest of PushTotalTime and PullTotalTime
+    // is the time the thread is blocked or descheduled
+    RuntimeProfile::Counter* _cpu_timer = nullptr;
     RuntimeProfile::Counter* _runtime_in_filter_num_counter = nullptr;
     RuntimeProfile::Counter* _runtime_bloom_filter_num_counter = nullptr;
     RuntimeProfile::Counter* _conjuncts_timer = nullptr;
@@ -3,9 +3,24 @@
 #include "exec/pipeline/pipeline_builder.h"
 
 #include "exec/exec_node.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/scan_operator.h"
 
 namespace starrocks::pipeline {
 
+void PipelineBuilderContext::_connect_limit_to_scan(const OpFactories& operators) {
+    auto* scan = operators.empty() ? nullptr : dynamic_cast<ScanOperatorFactory*>(operators[0].get());
+    if (scan == nullptr) {
+        return;
+    }
+    for (size_t i = 1; i < operators.size(); i++) {
+        if (auto* limit = dynamic_cast<LimitOperatorFactory*>(operators[i].get()); limit != nullptr) {
+            scan->set_remaining_limit(limit->remaining_limit());
+            return;
+        }
+    }
+}
+
 OpFactories PipelineBuilderContext::maybe_interpolate_local_broadcast_exchange(RuntimeState* state,
                                                                                OpFactories& pred_operators,
                                                                                int num_receivers) {
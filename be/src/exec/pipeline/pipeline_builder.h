@@ -18,6 +18,7 @@ public:
             : _fragment_context(fragment_context), _degree_of_parallelism(degree_of_parallelism) {}
 
     void add_pipeline(const OpFactories& operators) {
+        _connect_limit_to_scan(operators);
         _pipelines.emplace_back(std::make_unique<Pipeline>(next_pipe_id(), operators));
     }
 
@@ -59,6 +60,10 @@ public:
     FragmentContext* fragment_context() { return _fragment_context; }
 
 private:
+    // The scan at the head of a pipeline stops reading once the first limit of the pipeline is reached, none of
+    // the operators between them needs more rows then.
+    static void _connect_limit_to_scan(const OpFactories& operators);
+
     FragmentContext* _fragment_context;
     Pipelines _pipelines;
     uint32_t _next_pipeline_id = 0;
@@ -7,10 +7,13 @@
 
 #include "column/chunk.h"
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
+#include "exec/pipeline/scan_operator.h"
 #include "exec/pipeline/source_operator.h"
 #include "exec/workgroup/work_group.h"
+#include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "util/defer_op.h"
 
 namespace starrocks::pipeline {
 Status PipelineDriver::prepare(RuntimeState* runtime_state) {
@@ -19,6 +22,7 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
     // TotalTime is reserved name
     _total_timer = ADD_TIMER(_runtime_profile, "DriverTotalTime");
     _active_timer = ADD_TIMER(_runtime_profile, "ActiveTime");
+    _active_cpu_timer = ADD_CHILD_TIMER(_runtime_profile, "ActiveCpuTime", "ActiveTime");
     _overhead_timer = ADD_TIMER(_runtime_profile, "OverheadTime");
     _schedule_timer = ADD_TIMER(_runtime_profile, "ScheduleTime");
     _pending_timer = ADD_TIMER(_runtime_profile, "PendingTime");
@@ -33,6 +37,7 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
     _schedule_effective_counter = ADD_COUNTER(_runtime_profile, "ScheduleEffectiveCounter", TUnit::UNIT);
     _schedule_rows_per_chunk = ADD_COUNTER(_runtime_profile, "ScheduleAccumulatedRowsPerChunk", TUnit::UNIT);
     _schedule_accumulated_chunk_moved = ADD_COUNTER(_runtime_profile, "ScheduleAccumulatedChunkMoved", TUnit::UNIT);
+    _schedule_level_counter = ADD_COUNTER(_runtime_profile, "ScheduleQueueLevel", TUnit::UNIT);
 
     DCHECK(_state == DriverState::NOT_READY);
     // fill OperatorWithDependency instances into _dependencies from _operators.
@@ -90,10 +95,18 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
 
 StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
     SCOPED_TIMER(_active_timer);
+    ThreadCpuStopWatch cpu_sw;
+    cpu_sw.start();
+    DeferOp update_cpu_time([&] {
+        int64_t cpu_time_spent = cpu_sw.elapsed_time();
+        driver_acct().update_accumulated_cpu_time_spent(cpu_time_spent);
+        COUNTER_UPDATE(_active_cpu_timer, cpu_time_spent);
+    });
     set_driver_state(DriverState::RUNNING);
     size_t total_chunks_moved = 0;
     size_t total_rows_moved = 0;
     int64_t time_spent = 0;
+    const int64_t time_slice = _yield_time_slice();
     while (true) {
         RETURN_IF_LIMIT_EXCEEDED(runtime_state, "Pipeline");
 
@@ -132,6 +145,10 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
                 StatusOr<vectorized::ChunkPtr> maybe_chunk;
                 {
                     SCOPED_TIMER(curr_op->_pull_timer);
+                    SCOPED_THREAD_LOCAL_PLAN_NODE_SETTER(curr_op->get_plan_node_id());
+                    SCOPED_THREAD_CPU_TIMER(curr_op->_cpu_timer);
+                    SCOPED_THREAD_LOCAL_ALLOCATION_AND_PEAK_COUNTER(curr_op->_allocated_bytes_counter,
+                                                                    curr_op->_peak_memory_usage_counter);
                     maybe_chunk = curr_op->pull_chunk(runtime_state);
                 }
                 auto status = maybe_chunk.status();
@@ -151,6 +168,10 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
                         total_rows_moved += row_num;
                         {
                             SCOPED_TIMER(next_op->_push_timer);
+                            SCOPED_THREAD_LOCAL_PLAN_NODE_SETTER(next_op->get_plan_node_id());
+                            SCOPED_THREAD_CPU_TIMER(next_op->_cpu_timer);
+                            SCOPED_THREAD_LOCAL_ALLOCATION_AND_PEAK_COUNTER(next_op->_allocated_bytes_counter,
+                                                                            next_op->_peak_memory_usage_counter);
                             status = next_op->push_chunk(runtime_state, maybe_chunk.value());
                         }
 
@@ -180,7 +201,7 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
             }
             // yield when total chunks moved or time spent on-core for evaluation
             // exceed the designated thresholds.
-            if (total_chunks_moved >= _yield_max_chunks_moved || time_spent >= _yield_max_time_spent) {
+            if (total_chunks_moved >= _yield_max_chunks_moved || time_spent >= time_slice) {
                 should_yield = true;
                 break;
             }
@@ -206,6 +227,9 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
             driver_acct().update_last_chunks_moved(total_chunks_moved);
             driver_acct().update_accumulated_rows_moved(total_rows_moved);
             driver_acct().update_last_time_spent(time_spent);
+            if (_workgroup != nullptr) {
+                _workgroup->incr_cpu_runtime_ns(time_spent);
+            }
             if (is_precondition_block()) {
                 set_driver_state(DriverState::PRECONDITION_BLOCK);
             } else if (!sink_operator()->is_finished() && !sink_operator()->need_input()) {
@@ -295,6 +319,8 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
     COUNTER_UPDATE(_schedule_effective_counter, driver_acct().get_schedule_effective_times());
     COUNTER_UPDATE(_schedule_rows_per_chunk, driver_acct().get_rows_per_chunk());
     COUNTER_UPDATE(_schedule_accumulated_chunk_moved, driver_acct().get_accumulated_chunk_moved());
+    // the level of the queues the driver is put back to at last, the drivers of more time go to the higher levels
+    COUNTER_SET(_schedule_level_counter, static_cast<int64_t>(driver_acct().get_level()));
     _update_overhead_timer();
 
     // last root driver cancel the all drivers' execution and notify FE the
@@ -355,6 +381,9 @@ starrocks::workgroup::WorkGroup* PipelineDriver::workgroup() {
 
 void PipelineDriver::set_workgroup(starrocks::workgroup::WorkGroup* wg) {
     this->_workgroup = wg;
+    if (auto* scan_operator = dynamic_cast<ScanOperator*>(source_operator()); scan_operator != nullptr) {
+        scan_operator->set_workgroup(wg);
+    }
 }
 
 bool PipelineDriver::_check_fragment_is_canceled(RuntimeState* runtime_state) {
@@ -374,6 +403,21 @@ bool PipelineDriver::_check_fragment_is_canceled(RuntimeState* runtime_state) {
     return false;
 }
 
+int64_t PipelineDriver::_yield_time_slice() {
+    if (_yield_min_time_spent <= 0 || _yield_min_time_spent >= _yield_max_time_spent) {
+        return _yield_max_time_spent;
+    }
+    // The drivers at the lower levels have run for less time, most of them belong to the short queries,
+    // and they yield sooner to let the other short ones run. The ones of the long queries reach the higher
+    // levels soon, and yield less often there.
+    int level = driver_acct().get_level();
+    int64_t slice = _yield_min_time_spent;
+    for (int i = 0; i < level && slice < _yield_max_time_spent; ++i) {
+        slice *= 2;
+    }
+    return std::min(slice, _yield_max_time_spent);
+}
+
 void PipelineDriver::_mark_operator_finishing(OperatorPtr& op, RuntimeState* state) {
     auto& op_state = _operator_stages[op->get_id()];
     if (op_state >= OperatorStage::FINISHING) {
@@ -95,7 +95,14 @@ public:
         this->schedule_effective_times += (chunks_moved > 0) ? 1 : 0;
     }
     void update_accumulated_rows_moved(int64_t rows_moved) { this->accumulated_rows_moved += rows_moved; }
+    // the on-CPU part of time_spent, the rest is the time the thread is blocked or descheduled in process()
+    void update_accumulated_cpu_time_spent(int64_t cpu_time_spent) {
+        this->accumulated_cpu_time_spent += cpu_time_spent;
+    }
     void increment_schedule_times() { this->schedule_times += 1; }
+    // the time the driver is put back into the ready queue, to measure how long it waits there to be run
+    void update_last_ready_time(int64_t ready_time) { this->last_ready_time = ready_time; }
+    int64_t get_last_ready_time() { return last_ready_time; }
 
     int64_t get_schedule_times() { return schedule_times; }
 
@@ -111,6 +118,8 @@ public:
 
     int64_t get_accumulated_chunk_moved() { return accumulated_chunk_moved; }
 
+    int64_t get_accumulated_cpu_time_spent() { return accumulated_cpu_time_spent; }
+
 private:
     int64_t schedule_times{0};
     int64_t schedule_effective_times{0};
@@ -119,6 +128,8 @@ private:
     int64_t accumulated_time_spent{0};
     int64_t accumulated_chunk_moved{0};
     int64_t accumulated_rows_moved{0};
+    int64_t accumulated_cpu_time_spent{0};
+    int64_t last_ready_time{0};
 };
 
 // OperatorExecState is used to guarantee that some hooks of operator
@@ -149,7 +160,8 @@ public:
               _is_root(is_root),
               _state(DriverState::NOT_READY),
               _yield_max_chunks_moved(config::pipeline_yield_max_chunks_moved),
-              _yield_max_time_spent(config::pipeline_yield_max_time_spent) {
+              _yield_max_time_spent(config::pipeline_yield_max_time_spent),
+              _yield_min_time_spent(config::pipeline_yield_min_time_spent) {
         _runtime_profile = std::make_shared<RuntimeProfile>(strings::Substitute("PipelineDriver (id=$0)", _driver_id));
         for (auto& op : _operators) {
             _operator_stages[op->get_id()] = OperatorStage::INIT;
@@ -345,6 +357,8 @@ public:
 private:
     // check whether fragment is cancelled. It is used before pull_chunk and push_chunk.
     bool _check_fragment_is_canceled(RuntimeState* runtime_state);
+    // The time slice of the current execution round, which grows with the level of the driver.
+    int64_t _yield_time_slice();
     void _mark_operator_finishing(OperatorPtr& op, RuntimeState* runtime_state);
     void _mark_operator_finished(OperatorPtr& op, RuntimeState* runtime_state);
     void _mark_operator_cancelled(OperatorPtr& op, RuntimeState* runtime_state);
@@ -382,6 +396,7 @@ private:
     std::shared_ptr<RuntimeProfile> _runtime_profile = nullptr;
     const size_t _yield_max_chunks_moved;
     const int64_t _yield_max_time_spent;
+    const int64_t _yield_min_time_spent;
 
     phmap::flat_hash_map<int32_t, OperatorStage> _operator_stages;
 
@@ -390,6 +405,7 @@ private:
     // metrics
     RuntimeProfile::Counter* _total_timer = nullptr;
     RuntimeProfile::Counter* _active_timer = nullptr;
+    RuntimeProfile::Counter* _active_cpu_timer = nullptr;
     RuntimeProfile::Counter* _overhead_timer = nullptr;
     RuntimeProfile::Counter* _schedule_timer = nullptr;
     RuntimeProfile::Counter* _pending_timer = nullptr;
@@ -404,6 +420,7 @@ private:
     RuntimeProfile::Counter* _schedule_effective_counter = nullptr;
     RuntimeProfile::Counter* _schedule_rows_per_chunk = nullptr;
     RuntimeProfile::Counter* _schedule_accumulated_chunk_moved = nullptr;
+    RuntimeProfile::Counter* _schedule_level_counter = nullptr;
 
     MonotonicStopWatch* _total_timer_sw = nullptr;
     MonotonicStopWatch* _pending_timer_sw = nullptr;
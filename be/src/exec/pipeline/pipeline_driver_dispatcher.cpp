@@ -2,13 +2,59 @@
 
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "runtime/sampling_profiler.h"
 #include "util/defer_op.h"
+#include "util/pretty_printer.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
+
+// The counters of the drivers and of their operators that are aggregated across the drivers of a pipeline.
+static const std::vector<std::string> kAggregatedDriverCounters{
+        "ActiveTime",     "ActiveCpuTime",         "PendingTime",  "InputEmptyTime",
+        "OutputFullTime", "PreconditionBlockTime", "ScheduleTime", "ScheduleQueueLevel"};
+static const std::vector<std::string> kAggregatedOperatorCounters{"PushTotalTime", "PullTotalTime", "OperatorCpuTime",
+                                                                  "OperatorPeakMemoryUsage", "PushRowNum"};
+
+// Add the info string "<prefix>.<name>: min=..., max=..., skew=..." of the counter |name| of |profiles| to
+// |pipeline_profile|, where the skew is the max divided by the average.
+static void add_counter_skew(RuntimeProfile* pipeline_profile, const std::vector<RuntimeProfile*>& profiles,
+                             const std::string& prefix, const std::string& name) {
+    int64_t min_value = std::numeric_limits<int64_t>::max();
+    int64_t max_value = 0;
+    int64_t sum = 0;
+    size_t num_counters = 0;
+    TUnit::type unit = TUnit::UNIT;
+    for (auto* profile : profiles) {
+        auto* counter = profile->get_counter(name);
+        if (counter == nullptr) {
+            continue;
+        }
+        min_value = std::min(min_value, counter->value());
+        max_value = std::max(max_value, counter->value());
+        sum += counter->value();
+        unit = counter->type();
+        num_counters++;
+    }
+    if (num_counters <= 1 || sum == 0) {
+        return;
+    }
+    double skew = static_cast<double>(max_value) * num_counters / sum;
+    pipeline_profile->add_info_string(strings::Substitute("$0.$1", prefix, name),
+                                      strings::Substitute("min=$0, max=$1, skew=$2",
+                                                          PrettyPrinter::print(min_value, unit),
+                                                          PrettyPrinter::print(max_value, unit),
+                                                          PrettyPrinter::print(skew, TUnit::DOUBLE_VALUE)));
+}
 GlobalDriverDispatcher::GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool)
-        : _driver_queue(new QuerySharedDriverQueue()),
+        // One local queue per dispatcher thread, _driver_queue is initialized before _thread_pool.
+        : _driver_queue(new WorkStealingDriverQueue(thread_pool->max_threads())),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
           _exec_state_reporter(new ExecStateReporter()) {}
@@ -46,6 +92,8 @@ void GlobalDriverDispatcher::finalize_driver(DriverRawPtr driver, RuntimeState*
 }
 
 void GlobalDriverDispatcher::run() {
+    SamplingProfiler::instance()->register_current_thread();
+    DeferOp unregister_thread([] { SamplingProfiler::instance()->unregister_current_thread(); });
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
@@ -58,6 +106,8 @@ void GlobalDriverDispatcher::run() {
         }
         auto driver = maybe_driver.value();
         DCHECK(driver != nullptr);
+        StarRocksMetrics::instance()->pipeline_driver_schedule_delay_us.observe(
+                (MonotonicNanos() - driver->driver_acct().get_last_ready_time()) / 1000);
 
         auto* query_ctx = driver->query_ctx();
         auto* fragment_ctx = driver->fragment_ctx();
@@ -67,6 +117,7 @@ void GlobalDriverDispatcher::run() {
         auto* runtime_state = runtime_state_ptr.get();
         {
             SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(runtime_state->instance_mem_tracker());
+            SCOPED_THREAD_LOCAL_EXEC_CONTEXT_SETTER(fragment_ctx->query_id(), fragment_ctx->fragment_instance_id());
 
             if (fragment_ctx->is_canceled()) {
                 driver->cancel_operators(runtime_state);
@@ -88,6 +139,8 @@ void GlobalDriverDispatcher::run() {
             query_ctx->extend_lifetime();
             auto status = driver->process(runtime_state);
             this->_driver_queue->get_sub_queue(queue_index)->update_accu_time(driver);
+            // The driver may have produced chunks or finished, which unblocks the other drivers.
+            _blocked_driver_poller->notify_event();
 
             if (!status.ok()) {
                 LOG(WARNING) << "[Driver] Process error, query_id=" << print_id(driver->query_ctx()->query_id())
@@ -150,6 +203,17 @@ void GlobalDriverDispatcher::dispatch(DriverRawPtr driver) {
 
 void GlobalDriverDispatcher::report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done) {
     if (done) {
+        // The operators always collect their counters, so the profile of a slow fragment is reported as if the
+        // query had asked for it.
+        if (!fragment_ctx->is_report_profile() && fragment_ctx->is_slow()) {
+            fragment_ctx->set_report_profile();
+            auto* profile = fragment_ctx->runtime_state()->runtime_profile();
+            profile->add_info_string("SlowQueryProfile", "true");
+            LOG(INFO) << "[Driver] Report the profile of the slow fragment instance, query_id="
+                      << print_id(fragment_ctx->query_id())
+                      << ", fragment_instance_id=" << print_id(fragment_ctx->fragment_instance_id())
+                      << ", lifetime=" << PrettyPrinter::print(fragment_ctx->lifetime_ns(), TUnit::TIME_NS);
+        }
         update_profile_by_mode(fragment_ctx, done);
     }
     auto params = ExecStateReporter::create_report_exec_status_params(fragment_ctx, status, done);
@@ -175,11 +239,47 @@ void GlobalDriverDispatcher::report_exec_state(FragmentContext* fragment_ctx, co
     this->_exec_state_reporter->submit(std::move(report_task));
 }
 
+void GlobalDriverDispatcher::aggregate_driver_profiles(FragmentContext* fragment_ctx) {
+    auto* profile = fragment_ctx->runtime_state()->runtime_profile();
+
+    std::vector<RuntimeProfile*> pipeline_profiles;
+    profile->get_children(&pipeline_profiles);
+    for (auto* pipeline_profile : pipeline_profiles) {
+        std::vector<RuntimeProfile*> pipeline_driver_profiles;
+        pipeline_profile->get_children(&pipeline_driver_profiles);
+        if (pipeline_driver_profiles.size() <= 1) {
+            continue;
+        }
+        for (const auto& name : kAggregatedDriverCounters) {
+            add_counter_skew(pipeline_profile, pipeline_driver_profiles, "Driver", name);
+        }
+
+        // The drivers of a pipeline have the same operators in the same order.
+        std::vector<std::vector<RuntimeProfile*>> operator_profiles(pipeline_driver_profiles.size());
+        for (size_t i = 0; i < pipeline_driver_profiles.size(); i++) {
+            pipeline_driver_profiles[i]->get_children(&operator_profiles[i]);
+        }
+        for (size_t op_idx = 0; op_idx < operator_profiles[0].size(); op_idx++) {
+            std::vector<RuntimeProfile*> profiles_of_op;
+            for (auto& profiles : operator_profiles) {
+                if (op_idx < profiles.size()) {
+                    profiles_of_op.push_back(profiles[op_idx]);
+                }
+            }
+            for (const auto& name : kAggregatedOperatorCounters) {
+                add_counter_skew(pipeline_profile, profiles_of_op, operator_profiles[0][op_idx]->name(), name);
+            }
+        }
+    }
+}
+
 void GlobalDriverDispatcher::update_profile_by_mode(FragmentContext* fragment_ctx, bool done) {
     if (!done) {
         return;
     }
 
+    aggregate_driver_profiles(fragment_ctx);
+
     if (fragment_ctx->profile_mode() != TPipelineProfileMode::type::BRIEF) {
         return;
     }
@@ -28,6 +28,8 @@ public:
     virtual void initialize(int32_t num_threads) {}
     virtual void change_num_threads(int32_t num_threads) {}
     virtual void dispatch(DriverRawPtr driver){};
+    // Something the blocked drivers may wait for has changed, re-check them.
+    virtual void notify_blocked_drivers() {}
 
     // When all the root drivers (the drivers have no successors in the same fragment) have finished,
     // just notify FE timely the completeness of fragment via invocation of report_exec_state, but
@@ -44,11 +46,15 @@ public:
     void initialize(int32_t num_threads) override;
     void change_num_threads(int32_t num_threads) override;
     void dispatch(DriverRawPtr driver) override;
+    void notify_blocked_drivers() override { _blocked_driver_poller->notify_event(); }
     void report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done) override;
 
 private:
     void run();
     void finalize_driver(DriverRawPtr driver, RuntimeState* runtime_state, DriverState state);
+    // Add the min, the max and the skew of the counters of the drivers and the operators of each pipeline to the
+    // pipeline profile, so they are kept when the profile of only one driver is reported.
+    void aggregate_driver_profiles(FragmentContext* fragment_ctx);
     void update_profile_by_mode(FragmentContext* fragment_ctx, bool done);
 
 private:
@@ -3,8 +3,19 @@
 #include "pipeline_driver_poller.h"
 
 #include <chrono>
+
+#include "exec/pipeline/pipeline_driver_dispatcher.h"
+#include "runtime/exec_env.h"
+
 namespace starrocks::pipeline {
 
+void notify_blocked_drivers() {
+    auto* dispatcher = ExecEnv::GetInstance()->driver_dispatcher();
+    if (dispatcher != nullptr) {
+        dispatcher->notify_blocked_drivers();
+    }
+}
+
 void PipelineDriverPoller::start() {
     DCHECK(this->_polling_thread.get() == nullptr);
     auto status = Thread::create(
@@ -28,7 +39,6 @@ void PipelineDriverPoller::shutdown() {
 void PipelineDriverPoller::run_internal() {
     this->_is_polling_thread_initialized.store(true, std::memory_order_release);
     typeof(this->_blocked_drivers) local_blocked_drivers;
-    int spin_count = 0;
     std::vector<DriverRawPtr> ready_drivers;
     while (!_is_shutdown.load(std::memory_order_acquire)) {
         {
@@ -49,6 +59,8 @@ void PipelineDriverPoller::run_internal() {
             }
         }
 
+        // Events happening after this point are not missed, because they change _event_version.
+        uint64_t event_version = _event_version.load();
         auto driver_it = local_blocked_drivers.begin();
         while (driver_it != local_blocked_drivers.end()) {
             auto* driver = *driver_it;
@@ -110,27 +122,22 @@ void PipelineDriverPoller::run_internal() {
             }
         }
 
-        if (ready_drivers.empty()) {
-            spin_count += 1;
-        } else {
-            spin_count = 0;
-
+        if (!ready_drivers.empty()) {
             _dispatch_queue->put_back(ready_drivers);
             ready_drivers.clear();
+            continue;
         }
 
-        if (spin_count != 0 && spin_count % 64 == 0) {
-#ifdef __x86_64__
-            _mm_pause();
-#else
-            // TODO: Maybe there's a better intrinsic like _mm_pause on non-x86_64 architecture.
-            sched_yield();
-#endif
-        }
-        if (spin_count == 640) {
-            spin_count = 0;
-            sched_yield();
-        }
+        // None of the blocked drivers is ready, wait until an event happens or a new blocked driver comes.
+        // The timeout is only a fallback for the conditions depending on time (e.g. the wait timeout of runtime
+        // filters, the expiration of queries) or changed without notify_event().
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        _is_waiting_for_event.store(true);
+        _cond.wait_for(lock, std::chrono::milliseconds(10), [this, event_version]() {
+            return _is_shutdown.load(std::memory_order_acquire) || !_blocked_drivers.empty() ||
+                   _event_version.load() != event_version;
+        });
+        _is_waiting_for_event.store(false);
     }
 }
 
@@ -141,6 +148,16 @@ void PipelineDriverPoller::add_blocked_driver(const DriverRawPtr driver) {
     this->_cond.notify_one();
 }
 
+void PipelineDriverPoller::notify_event() {
+    // _event_version is increased before checking _is_waiting_for_event, and the poller sets
+    // _is_waiting_for_event before checking _event_version, so an event is never missed.
+    _event_version.fetch_add(1);
+    if (_is_waiting_for_event.load()) {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        _cond.notify_one();
+    }
+}
+
 void PipelineDriverPoller::remove_blocked_driver(DriverList& local_blocked_drivers, DriverList::iterator& driver_it) {
     auto& driver = *driver_it;
     driver->_pending_timer->update(driver->_pending_timer_sw->elapsed_time());
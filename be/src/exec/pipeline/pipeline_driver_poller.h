@@ -15,6 +15,10 @@ namespace starrocks {
 namespace pipeline {
 class PipelineDriverPoller;
 using PipelineDriverPollerPtr = std::unique_ptr<PipelineDriverPoller>;
+
+// Notify the poller of the process-wide DriverDispatcher, see PipelineDriverPoller::notify_event().
+void notify_blocked_drivers();
+
 class PipelineDriverPoller {
 public:
     explicit PipelineDriverPoller(DriverQueue* dispatch_queue)
@@ -33,6 +37,10 @@ public:
     void add_blocked_driver(const DriverRawPtr driver);
     // remove blocked driver from poller
     void remove_blocked_driver(DriverList& local_blocked_drivers, DriverList::iterator& driver_it);
+    // Wake up the poller to re-check the blocked drivers. It should be called whenever something a blocked
+    // driver may wait for has changed, e.g. chunks arrive at an exchange source or an RPC of an exchange sink
+    // finishes. It's cheap when the poller is busy, since the mutex is only acquired if the poller is waiting.
+    void notify_event();
 
 private:
     void run_internal();
@@ -47,6 +55,10 @@ private:
     scoped_refptr<Thread> _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
     std::atomic<bool> _is_shutdown;
+
+    // Increased by every notify_event(), the poller waits only if no event happens during a round of checking.
+    std::atomic<uint64_t> _event_version = 0;
+    std::atomic<bool> _is_waiting_for_event = false;
 };
 } // namespace pipeline
 } // namespace starrocks
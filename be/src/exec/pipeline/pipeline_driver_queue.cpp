@@ -2,7 +2,18 @@
 
 #include "exec/pipeline/pipeline_driver_queue.h"
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "exec/pipeline/fragment_context.h"
 #include "gutil/strings/substitute.h"
+#include "util/cpu_info.h"
+#include "util/time.h"
 namespace starrocks::pipeline {
 void QuerySharedDriverQueue::close() {
     std::lock_guard<std::mutex> lock(_global_mutex);
@@ -12,6 +23,7 @@ void QuerySharedDriverQueue::close() {
 
 void QuerySharedDriverQueue::put_back(const DriverRawPtr driver) {
     int level = driver->driver_acct().get_level();
+    driver->driver_acct().update_last_ready_time(MonotonicNanos());
     {
         std::lock_guard<std::mutex> lock(_global_mutex);
         _queues[level % QUEUE_SIZE].queue.emplace(driver);
@@ -21,8 +33,10 @@ void QuerySharedDriverQueue::put_back(const DriverRawPtr driver) {
 
 void QuerySharedDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
     std::vector<int> levels(drivers.size());
+    int64_t now = MonotonicNanos();
     for (int i = 0; i < drivers.size(); i++) {
         levels[i] = drivers[i]->driver_acct().get_level();
+        drivers[i]->driver_acct().update_last_ready_time(now);
     }
 
     std::lock_guard<std::mutex> lock(_global_mutex);
@@ -78,4 +92,205 @@ SubQuerySharedDriverQueue* QuerySharedDriverQueue::get_sub_queue(size_t index) {
     return _queues + index;
 }
 
+size_t QuerySharedDriverQueue::size() const {
+    std::lock_guard<std::mutex> lock(_global_mutex);
+    size_t size = 0;
+    for (const auto& sub_queue : _queues) {
+        size += sub_queue.queue.size();
+    }
+    return size;
+}
+
+namespace {
+// The local queue which the current worker thread is bound to.
+struct LocalQueueBinding {
+    const WorkStealingDriverQueue* queue = nullptr;
+    size_t index = 0;
+};
+thread_local LocalQueueBinding tls_local_queue_binding;
+
+// Pins the current thread to the cores of the NUMA node.
+void bind_current_thread_to_numa_node(int node) {
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int core : CpuInfo::get_cores_of_numa_node(node)) {
+        CPU_SET(core, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+        LOG(WARNING) << "Fail to pin the pipeline execution thread to the NUMA node " << node << ", errno=" << ret;
+    }
+#endif
+}
+} // namespace
+
+WorkStealingDriverQueue::WorkStealingDriverQueue(size_t num_local_queues)
+        : _num_local_queues(std::max<size_t>(num_local_queues, 1)),
+          _local_queues(new LocalQueue[_num_local_queues]) {
+    if (config::pipeline_numa_aware_scheduling) {
+        _num_numa_nodes = std::clamp<size_t>(CpuInfo::get_max_num_numa_nodes(), 1, _num_local_queues);
+    }
+    double factor = 1;
+    for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
+        _levels[i].factor_for_normal = factor;
+        factor *= QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE;
+    }
+}
+
+void WorkStealingDriverQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(_idle_mutex);
+        _is_closed = true;
+    }
+    _idle_cv.notify_all();
+}
+
+size_t WorkStealingDriverQueue::_bind_local_queue() {
+    auto& binding = tls_local_queue_binding;
+    if (binding.queue != this) {
+        binding.queue = this;
+        binding.index = _next_worker_index.fetch_add(1, std::memory_order_relaxed) % _num_local_queues;
+        if (_num_numa_nodes > 1) {
+            bind_current_thread_to_numa_node(_numa_node_of_local_queue(binding.index));
+        }
+    }
+    return binding.index;
+}
+
+size_t WorkStealingDriverQueue::_numa_node_of(const DriverRawPtr driver) const {
+    // The instances of a query have consecutive ids, so they are spread over the nodes.
+    return driver->fragment_ctx()->fragment_instance_id().lo % _num_numa_nodes;
+}
+
+size_t WorkStealingDriverQueue::_local_queue_to_put(const DriverRawPtr driver) {
+    const auto& binding = tls_local_queue_binding;
+    const size_t next = _next_put_index.fetch_add(1, std::memory_order_relaxed);
+    if (_num_numa_nodes == 1) {
+        return binding.queue == this ? binding.index : next % _num_local_queues;
+    }
+    const size_t node = _numa_node_of(driver);
+    if (binding.queue == this && _numa_node_of_local_queue(binding.index) == node) {
+        return binding.index;
+    }
+    // The local queues of the node are node, node + num_numa_nodes, node + 2 * num_numa_nodes, ...
+    const size_t num_node_queues = (_num_local_queues - node + _num_numa_nodes - 1) / _num_numa_nodes;
+    return node + (next % num_node_queues) * _num_numa_nodes;
+}
+
+void WorkStealingDriverQueue::put_back(const DriverRawPtr driver) {
+    int level = driver->driver_acct().get_level();
+    driver->driver_acct().update_last_ready_time(MonotonicNanos());
+    auto& local_queue = _local_queues[_local_queue_to_put(driver)];
+    // Count the driver before it is visible to takers, so that _num_drivers never underflows.
+    _num_drivers.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(local_queue.mutex);
+        local_queue.queues[level % QUEUE_SIZE].emplace_back(driver);
+        local_queue.num_drivers.fetch_add(1, std::memory_order_release);
+    }
+    if (_num_idle_workers.load() > 0) {
+        std::lock_guard<std::mutex> lock(_idle_mutex);
+        _idle_cv.notify_one();
+    }
+}
+
+void WorkStealingDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
+    if (drivers.empty()) {
+        return;
+    }
+    _num_drivers.fetch_add(drivers.size());
+    int64_t now = MonotonicNanos();
+    for (const auto& driver : drivers) {
+        int level = driver->driver_acct().get_level();
+        driver->driver_acct().update_last_ready_time(now);
+        auto& local_queue = _local_queues[_local_queue_to_put(driver)];
+        std::lock_guard<std::mutex> lock(local_queue.mutex);
+        local_queue.queues[level % QUEUE_SIZE].emplace_back(driver);
+        local_queue.num_drivers.fetch_add(1, std::memory_order_release);
+    }
+    if (_num_idle_workers.load() > 0) {
+        std::lock_guard<std::mutex> lock(_idle_mutex);
+        if (drivers.size() > 1) {
+            _idle_cv.notify_all();
+        } else {
+            _idle_cv.notify_one();
+        }
+    }
+}
+
+bool WorkStealingDriverQueue::_try_take(size_t local_index, DriverRawPtr* driver, size_t* queue_index) {
+    auto& local_queue = _local_queues[local_index];
+    // Skip the empty local queue without acquiring its lock.
+    if (local_queue.num_drivers.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(local_queue.mutex);
+    // -1 means no candidates; else has candidate.
+    int queue_idx = -1;
+    double target_accu_time = 0;
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        if (!local_queue.queues[i].empty()) {
+            double local_target_time = _levels[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
+            }
+        }
+    }
+    if (queue_idx < 0) {
+        return false;
+    }
+
+    *queue_index = queue_idx;
+    *driver = local_queue.queues[queue_idx].front();
+    local_queue.queues[queue_idx].pop_front();
+    local_queue.num_drivers.fetch_sub(1, std::memory_order_relaxed);
+    _num_drivers.fetch_sub(1);
+    return true;
+}
+
+StatusOr<DriverRawPtr> WorkStealingDriverQueue::take(size_t* queue_index) {
+    const size_t local_index = _bind_local_queue();
+    DriverRawPtr driver = nullptr;
+    while (true) {
+        if (_is_closed.load(std::memory_order_acquire)) {
+            return Status::Cancelled("Shutdown");
+        }
+
+        if (_try_take(local_index, &driver, queue_index)) {
+            return driver;
+        }
+        // Own local queue is empty, steal from the others, the ones of the same NUMA node first.
+        const size_t local_node = _numa_node_of_local_queue(local_index);
+        for (int remote = 0; remote < (_num_numa_nodes > 1 ? 2 : 1); ++remote) {
+            for (size_t i = 1; i < _num_local_queues; ++i) {
+                size_t index = (local_index + i) % _num_local_queues;
+                if (_num_numa_nodes > 1 && (_numa_node_of_local_queue(index) != local_node) != remote) {
+                    continue;
+                }
+                if (_try_take(index, &driver, queue_index)) {
+                    _num_steals.fetch_add(1, std::memory_order_relaxed);
+                    return driver;
+                }
+            }
+        }
+
+        // All the local queues are empty, park until a driver is put back.
+        // _num_idle_workers is increased before checking _num_drivers, and put_back() increases
+        // _num_drivers before checking _num_idle_workers, so a wake-up is never missed.
+        std::unique_lock<std::mutex> lock(_idle_mutex);
+        _num_idle_workers.fetch_add(1);
+        while (_num_drivers.load() == 0 && !_is_closed) {
+            _idle_cv.wait(lock);
+        }
+        _num_idle_workers.fetch_sub(1);
+    }
+}
+
+SubQuerySharedDriverQueue* WorkStealingDriverQueue::get_sub_queue(size_t index) {
+    return _levels + index;
+}
+
 } // namespace starrocks::pipeline
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <deque>
 #include <queue>
 
 #include "exec/pipeline/pipeline_driver.h"
@@ -35,6 +36,8 @@ public:
     virtual ~DriverQueue() = default;
     virtual void close() = 0;
     virtual SubQuerySharedDriverQueue* get_sub_queue(size_t) = 0;
+    // Number of the drivers ready to run in the queue.
+    virtual size_t size() const = 0;
 };
 
 class QuerySharedDriverQueue : public FactoryMethod<DriverQueue, QuerySharedDriverQueue> {
@@ -62,13 +65,84 @@ public:
     // return nullptr if queue is closed;
     StatusOr<DriverRawPtr> take(size_t* queue_index) override;
     SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
+    size_t size() const override;
 
 private:
     SubQuerySharedDriverQueue _queues[QUEUE_SIZE];
-    std::mutex _global_mutex;
+    mutable std::mutex _global_mutex;
     std::condition_variable _cv;
     bool _is_closed;
 };
 
+// WorkStealingDriverQueue keeps the same multi-level feedback priority as QuerySharedDriverQueue,
+// but splits the drivers into several local queues, each with its own lock, to avoid the contention
+// on a single mutex when many threads reschedule short drivers.
+//
+// A worker thread is bound to a local queue on its first take(). It puts its drivers back to and
+// takes drivers from its own local queue, and steals from the other local queues when its own is empty.
+// Drivers put back by the other threads (e.g. the poller) are spread over the local queues round-robin.
+//
+// If config::pipeline_numa_aware_scheduling and the machine has several NUMA nodes, the local queue i
+// belongs to the node i % num_numa_nodes, and the worker thread bound to it is pinned to the cores of that
+// node, so the memory it touches first is allocated on that node. The drivers of a fragment instance are
+// always put back to the local queues of one node, and a worker steals from the local queues of its own
+// node before the remote ones.
+//
+// The accumulated execution time of each level is still global, so all the local queues choose the
+// level in the same way as QuerySharedDriverQueue.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    explicit WorkStealingDriverQueue(size_t num_local_queues);
+    ~WorkStealingDriverQueue() override = default;
+    void close() override;
+
+    static const size_t QUEUE_SIZE = QuerySharedDriverQueue::QUEUE_SIZE;
+    void put_back(const DriverRawPtr driver) override;
+    void put_back(const std::vector<DriverRawPtr>& drivers) override;
+    // return Status::Cancelled if queue is closed;
+    StatusOr<DriverRawPtr> take(size_t* queue_index) override;
+    SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
+    size_t size() const override { return _num_drivers.load(std::memory_order_relaxed); }
+
+    size_t num_steals() const { return _num_steals.load(std::memory_order_relaxed); }
+
+private:
+    struct LocalQueue {
+        std::mutex mutex;
+        std::deque<DriverRawPtr> queues[QUEUE_SIZE];
+        std::atomic<size_t> num_drivers = 0;
+    };
+
+    // The local queue of the current thread, the thread is bound to a local queue if it isn't yet.
+    size_t _bind_local_queue();
+    // The local queue to put back a driver, it's the local queue of the current thread if it's a worker
+    // on the node of the driver.
+    size_t _local_queue_to_put(const DriverRawPtr driver);
+    // The NUMA node preferred by the drivers of the fragment instance of the driver.
+    size_t _numa_node_of(const DriverRawPtr driver) const;
+    size_t _numa_node_of_local_queue(size_t local_index) const { return local_index % _num_numa_nodes; }
+    bool _try_take(size_t local_index, DriverRawPtr* driver, size_t* queue_index);
+
+    const size_t _num_local_queues;
+    std::unique_ptr<LocalQueue[]> _local_queues;
+    // 1 if the scheduling isn't NUMA-aware.
+    size_t _num_numa_nodes = 1;
+    // Only used to account the execution time of each level, drivers are held by _local_queues.
+    SubQuerySharedDriverQueue _levels[QUEUE_SIZE];
+
+    std::atomic<size_t> _next_worker_index = 0;
+    std::atomic<size_t> _next_put_index = 0;
+    std::atomic<size_t> _num_steals = 0;
+
+    // Total number of drivers in all the local queues, used to park and wake up idle workers.
+    std::atomic<size_t> _num_drivers = 0;
+    std::atomic<size_t> _num_idle_workers = 0;
+    std::mutex _idle_mutex;
+    std::condition_variable _idle_cv;
+    std::atomic<bool> _is_closed = false;
+};
+
 } // namespace pipeline
 } // namespace starrocks
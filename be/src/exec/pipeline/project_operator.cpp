@@ -2,16 +2,23 @@
 
 #include "exec/pipeline/project_operator.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/common_expr_eliminator.h"
+#include "exprs/vectorized/fused_expr.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
 Status ProjectOperator::prepare(RuntimeState* state) {
-    return Operator::prepare(state);
+    RETURN_IF_ERROR(Operator::prepare(state));
+    _common_expr_saved_evals_counter = ADD_COUNTER(_runtime_profile, "CommonExprSavedEvaluations", TUnit::UNIT);
+    return Status::OK();
 }
 
 Status ProjectOperator::close(RuntimeState* state) {
@@ -26,6 +33,7 @@ Status ProjectOperator::push_chunk(RuntimeState* state, const vectorized::ChunkP
     for (size_t i = 0; i < _common_sub_column_ids.size(); ++i) {
         chunk->append_column(_common_sub_expr_ctxs[i]->evaluate(chunk.get()), _common_sub_column_ids[i]);
     }
+    COUNTER_UPDATE(_common_expr_saved_evals_counter, _common_expr_saved_evals);
 
     using namespace vectorized;
     vectorized::Columns result_columns(_column_ids.size());
@@ -65,6 +73,24 @@ Status ProjectOperator::push_chunk(RuntimeState* state, const vectorized::ChunkP
 
 Status ProjectOperatorFactory::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    // the exprs over the global dict codes are rewritten as a whole later, their subtrees must be kept
+    if (config::enable_common_expr_elimination && state->get_query_global_dict_map().empty()) {
+        // the common subtrees left in the projections, e.g. those over the common sub exprs, are evaluated
+        // after the common sub exprs
+        SlotId max_slot_id = state->desc_tbl().max_slot_id();
+        for (SlotId slot_id : _column_ids) {
+            max_slot_id = std::max(max_slot_id, slot_id);
+        }
+        for (SlotId slot_id : _common_sub_column_ids) {
+            max_slot_id = std::max(max_slot_id, slot_id);
+        }
+        _common_expr_saved_evals = vectorized::CommonExprEliminator::eliminate(
+                state->obj_pool(), _expr_ctxs, max_slot_id + 1, &_common_sub_expr_ctxs, &_common_sub_column_ids);
+    }
+    if (config::enable_expr_fusion && state->get_query_global_dict_map().empty()) {
+        vectorized::FusedExpr::fuse(state->obj_pool(), &_common_sub_expr_ctxs);
+        vectorized::FusedExpr::fuse(state->obj_pool(), &_expr_ctxs);
+    }
     RETURN_IF_ERROR(Expr::prepare(_expr_ctxs, state));
     RETURN_IF_ERROR(Expr::prepare(_common_sub_expr_ctxs, state));
 
@@ -13,13 +13,14 @@ public:
     ProjectOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id, std::vector<int32_t>& column_ids,
                     const std::vector<ExprContext*>& expr_ctxs, const std::vector<bool>& type_is_nullable,
                     const std::vector<int32_t>& common_sub_column_ids,
-                    const std::vector<ExprContext*>& common_sub_expr_ctxs)
+                    const std::vector<ExprContext*>& common_sub_expr_ctxs, int common_expr_saved_evals)
             : Operator(factory, id, "project", plan_node_id),
               _column_ids(column_ids),
               _expr_ctxs(expr_ctxs),
               _type_is_nullable(type_is_nullable),
               _common_sub_column_ids(common_sub_column_ids),
-              _common_sub_expr_ctxs(common_sub_expr_ctxs) {}
+              _common_sub_expr_ctxs(common_sub_expr_ctxs),
+              _common_expr_saved_evals(common_expr_saved_evals) {}
 
     ~ProjectOperator() override = default;
 
@@ -46,6 +47,10 @@ private:
 
     const std::vector<int32_t>& _common_sub_column_ids;
     const std::vector<ExprContext*>& _common_sub_expr_ctxs;
+    // the evaluations of the common subtrees found by CommonExprEliminator saved per chunk
+    const int _common_expr_saved_evals;
+
+    RuntimeProfile::Counter* _common_expr_saved_evals_counter = nullptr;
 
     bool _is_finished = false;
     vectorized::ChunkPtr _cur_chunk = nullptr;
@@ -68,7 +73,8 @@ public:
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
         return std::make_shared<ProjectOperator>(this, _id, _plan_node_id, _column_ids, _expr_ctxs, _type_is_nullable,
-                                                 _common_sub_column_ids, _common_sub_expr_ctxs);
+                                                 _common_sub_column_ids, _common_sub_expr_ctxs,
+                                                 _common_expr_saved_evals);
     }
 
     Status prepare(RuntimeState* state) override;
@@ -81,6 +87,7 @@ private:
 
     std::vector<int32_t> _common_sub_column_ids;
     std::vector<ExprContext*> _common_sub_expr_ctxs;
+    int _common_expr_saved_evals = 0;
     vectorized::DictOptimizeParser _dict_optimize_parser;
 };
 
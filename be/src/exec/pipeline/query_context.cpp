@@ -4,6 +4,7 @@
 #include "exec/pipeline/fragment_context.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/exec_env.h"
+#include "runtime/mem_arbitrator.h"
 
 namespace starrocks::pipeline {
 QueryContext::QueryContext()
@@ -19,6 +20,9 @@ QueryContext::~QueryContext() {
             _exec_env->runtime_filter_worker()->close_query(_query_id);
         }
     }
+    if (_reserved_mem_bytes > 0) {
+        MemArbitrator::instance()->release(_reserved_mem_bytes);
+    }
 }
 FragmentContextManager* QueryContext::fragment_mgr() {
     return _fragment_mgr.get();
@@ -28,6 +32,17 @@ void QueryContext::cancel(const Status& status) {
     _fragment_mgr->cancel(status);
 }
 
+Status QueryContext::reserve_memory(int64_t bytes, int64_t capacity, int64_t timeout_ms) {
+    // The other fragments of the query wait for the first one to be admitted.
+    std::lock_guard<std::mutex> l(_reserve_lock);
+    if (_reserved_mem_bytes > 0 || bytes <= 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(MemArbitrator::instance()->admit(bytes, capacity, timeout_ms));
+    _reserved_mem_bytes = bytes;
+    return Status::OK();
+}
+
 QueryContextManager::QueryContextManager() = default;
 QueryContextManager::~QueryContextManager() = default;
 QueryContext* QueryContextManager::get_or_register(const TUniqueId& query_id) {
@@ -59,6 +59,10 @@ public:
 
     void set_is_runtime_filter_coordinator(bool flag) { _is_runtime_filter_coordinator = flag; }
 
+    // Reserves |bytes| from MemArbitrator for the query, once for all its fragments, see MemArbitrator::admit.
+    // It's released when the query context is destroyed.
+    Status reserve_memory(int64_t bytes, int64_t capacity, int64_t timeout_ms);
+
 private:
     ExecEnv* _exec_env = nullptr;
     TUniqueId _query_id;
@@ -69,6 +73,9 @@ private:
     int64_t _deadline;
     seconds _expire_seconds;
     bool _is_runtime_filter_coordinator = false;
+
+    std::mutex _reserve_lock;
+    int64_t _reserved_mem_bytes = 0;
 };
 
 class QueryContextManager {
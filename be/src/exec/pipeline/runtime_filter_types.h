@@ -313,7 +313,13 @@ public:
             while (param_it != params.end()) {
                 auto& desc = *(desc_it++);
                 auto& param = *(param_it++);
-                if (desc->runtime_filter() == nullptr || param.column == nullptr) {
+                if (desc->runtime_filter() == nullptr) {
+                    continue;
+                }
+                if (param.column == nullptr) {
+                    // The partial filter is missing (e.g. the build side has been spilled to disk),
+                    // so the total filter would be incomplete.
+                    desc->set_runtime_filter(nullptr);
                     continue;
                 }
                 auto status = vectorized::RuntimeFilterHelper::fill_runtime_bloom_filter(
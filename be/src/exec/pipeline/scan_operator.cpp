@@ -2,8 +2,13 @@
 
 #include "exec/pipeline/scan_operator.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "exec/pipeline/olap_chunk_source.h"
+#include "exec/pipeline/pipeline_driver_poller.h"
+#include "exec/workgroup/work_group.h"
+#include "gutil/casts.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
@@ -26,6 +31,8 @@ Status ScanOperator::prepare(RuntimeState* state) {
                                     _io_threads->get_queue_capacity()));
     }
 
+    _stolen_morsels_counter = ADD_COUNTER(_runtime_profile, "StolenMorsels", TUnit::UNIT);
+
     // init filtered_ouput_columns
     for (const auto& col_name : _olap_scan_node.unused_output_column_name) {
         _unused_output_columns.emplace_back(col_name);
@@ -49,7 +56,7 @@ Status ScanOperator::close(RuntimeState* state) {
 }
 
 bool ScanOperator::has_output() const {
-    if (_is_finished) {
+    if (_is_finished || _is_limit_reached()) {
         return false;
     }
 
@@ -63,11 +70,16 @@ bool ScanOperator::has_output() const {
         return false;
     }
 
+    // No more io task could be committed until the next period of the io limit.
+    if (_workgroup != nullptr && _workgroup->is_io_throttled()) {
+        return false;
+    }
+
     // Because committing i/o task is trigger ONLY in pull_chunk,
     // return true if more i/o tasks can be committed.
 
     // Can pick up more morsels.
-    if (!_morsel_queue->empty()) {
+    if (_has_morsels()) {
         return true;
     }
 
@@ -89,12 +101,13 @@ bool ScanOperator::pending_finish() const {
 }
 
 bool ScanOperator::is_finished() const {
-    if (_is_finished) {
+    // The chunks read but not output yet are dropped, the driver sets it finishing and stops the io tasks.
+    if (_is_finished || _is_limit_reached()) {
         return true;
     }
 
     // Any io task is running or needs to run.
-    if (_num_running_io_tasks > 0 || !_morsel_queue->empty()) {
+    if (_num_running_io_tasks > 0 || _has_morsels()) {
         return false;
     }
 
@@ -132,6 +145,9 @@ Status ScanOperator::_try_to_trigger_next_scan(RuntimeState* state) {
     if (_num_running_io_tasks >= _max_io_tasks_per_op) {
         return Status::OK();
     }
+    if (_workgroup != nullptr && _workgroup->is_io_throttled()) {
+        return Status::OK();
+    }
 
     // Firstly, find the picked-up morsel, whose can commit an io task.
     for (int i = 0; i < _max_io_tasks_per_op; ++i) {
@@ -141,7 +157,7 @@ Status ScanOperator::_try_to_trigger_next_scan(RuntimeState* state) {
     }
 
     // Secondly, find the unused position of _chunk_sources to pick up a new morsel.
-    if (!_morsel_queue->empty()) {
+    if (_has_morsels()) {
         for (int i = 0; i < _max_io_tasks_per_op; ++i) {
             if (_chunk_sources[i] == nullptr || (!_is_io_task_running[i] && !_chunk_sources[i]->has_output())) {
                 return _pickup_morsel(state, i);
@@ -158,20 +174,36 @@ Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_in
 
     PriorityThreadPool::Task task;
     task.work_function = [this, state, chunk_source_index]() {
+        if (_workgroup != nullptr) {
+            _workgroup->incr_num_pending_io_tasks(-1);
+        }
         {
             SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
-            _chunk_sources[chunk_source_index]->buffer_next_batch_chunks_blocking(_buffer_size, _is_finished);
+            auto& chunk_source = _chunk_sources[chunk_source_index];
+            int64_t prev_bytes_read = chunk_source->bytes_read();
+            chunk_source->buffer_next_batch_chunks_blocking(_buffer_size, _is_finished);
+            if (_workgroup != nullptr) {
+                _workgroup->incr_io_bytes(chunk_source->bytes_read() - prev_bytes_read);
+            }
         }
 
         _num_running_io_tasks--;
         _is_io_task_running[chunk_source_index] = false;
+        // The buffered chunks make the scan driver ready.
+        notify_blocked_drivers();
     };
     // TODO(by satanson): set a proper priority
     task.priority = 20;
 
+    if (_workgroup != nullptr) {
+        _workgroup->incr_num_pending_io_tasks(1);
+    }
     if (_io_threads->try_offer(task)) {
         _io_task_retry_cnt = 0;
     } else {
+        if (_workgroup != nullptr) {
+            _workgroup->incr_num_pending_io_tasks(-1);
+        }
         _num_running_io_tasks--;
         _is_io_task_running[chunk_source_index] = false;
         // TODO(hcf) set a proper retry times
@@ -192,7 +224,7 @@ Status ScanOperator::_pickup_morsel(RuntimeState* state, int chunk_source_index)
         _chunk_sources[chunk_source_index] = nullptr;
     }
 
-    auto maybe_morsel = _morsel_queue->try_get();
+    auto maybe_morsel = _try_get_morsel();
     if (maybe_morsel.has_value()) {
         auto morsel = std::move(maybe_morsel.value());
         DCHECK(morsel);
@@ -202,10 +234,23 @@ Status ScanOperator::_pickup_morsel(RuntimeState* state, int chunk_source_index)
             enable_column_expr_predicate = _olap_scan_node.enable_column_expr_predicate;
         }
 
+        // The results depending on the runtime filters, the threshold of a TopN or a limit are not cached.
+        const std::string* scan_cache_digest = nullptr;
+        if (_scan_cache_digest != nullptr && !_scan_cache_digest->empty() && _limit == -1 &&
+            _runtime_topn_threshold == nullptr && rf_waiting_set().empty() && runtime_in_filters().empty() &&
+            (runtime_bloom_filters() == nullptr || runtime_bloom_filters()->size() == 0)) {
+            scan_cache_digest = _scan_cache_digest;
+        }
+
         _chunk_sources[chunk_source_index] = std::make_shared<OlapChunkSource>(
                 std::move(morsel), _olap_scan_node.tuple_id, _limit, enable_column_expr_predicate, _conjunct_ctxs,
-                runtime_in_filters(), runtime_bloom_filters(), _olap_scan_node.key_column_name,
-                _olap_scan_node.is_preaggregation, &_unused_output_columns, _runtime_profile.get());
+                runtime_in_filters(), runtime_bloom_filters(), _runtime_topn_threshold,
+                _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation, &_unused_output_columns,
+                scan_cache_digest, _runtime_profile.get());
+        if (_column_expr_ctxs != nullptr && !_column_expr_ctxs->empty()) {
+            down_cast<OlapChunkSource*>(_chunk_sources[chunk_source_index].get())
+                    ->set_column_expr_ctxs(_column_expr_ctxs);
+        }
         auto status = _chunk_sources[chunk_source_index]->prepare(state);
         if (!status.ok()) {
             _chunk_sources[chunk_source_index] = nullptr;
@@ -219,10 +264,71 @@ Status ScanOperator::_pickup_morsel(RuntimeState* state, int chunk_source_index)
     return Status::OK();
 }
 
+bool ScanOperator::_has_morsels() const {
+    if (!_morsel_queue->empty()) {
+        return true;
+    }
+    return std::any_of(_sibling_morsel_queues.begin(), _sibling_morsel_queues.end(),
+                       [](const MorselQueue* queue) { return !queue->empty(); });
+}
+
+std::optional<MorselPtr> ScanOperator::_try_get_morsel() {
+    auto maybe_morsel = _morsel_queue->try_get();
+    if (maybe_morsel.has_value()) {
+        return maybe_morsel;
+    }
+
+    // Start from the last victim, it's likely to have more morsels than the others.
+    const size_t num_siblings = _sibling_morsel_queues.size();
+    for (size_t i = 0; i < num_siblings; ++i) {
+        size_t victim = (_next_victim + i) % num_siblings;
+        maybe_morsel = _sibling_morsel_queues[victim]->try_get();
+        if (maybe_morsel.has_value()) {
+            _next_victim = victim;
+            COUNTER_UPDATE(_stolen_morsels_counter, 1);
+            return maybe_morsel;
+        }
+    }
+    return {};
+}
+
+bool ScanOperatorFactory::push_down_column_expr(SlotId slot_id, ExprContext* expr_ctx) {
+    if (!_scan_cache_digest.empty() || !rf_waiting_set().empty() || has_column_expr(slot_id)) {
+        return false;
+    }
+    auto* runtime_bloom_filters = get_runtime_bloom_filters();
+    if (runtime_bloom_filters != nullptr && runtime_bloom_filters->size() > 0) {
+        return false;
+    }
+    const auto& filter_null_value_columns = get_filter_null_value_columns();
+    if (std::find(filter_null_value_columns.begin(), filter_null_value_columns.end(), slot_id) !=
+        filter_null_value_columns.end()) {
+        return false;
+    }
+    for (ExprContext* ctx : _conjunct_ctxs) {
+        std::vector<SlotId> slot_ids;
+        ctx->root()->get_slot_ids(&slot_ids);
+        if (std::find(slot_ids.begin(), slot_ids.end(), slot_id) != slot_ids.end()) {
+            return false;
+        }
+    }
+    _column_expr_ctxs.emplace_back(slot_id, expr_ctx);
+    return true;
+}
+
+bool ScanOperatorFactory::has_column_expr(SlotId slot_id) const {
+    return std::any_of(_column_expr_ctxs.begin(), _column_expr_ctxs.end(),
+                       [slot_id](const auto& column_expr) { return column_expr.first == slot_id; });
+}
+
 Status ScanOperatorFactory::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(OperatorFactory::prepare(state));
     RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state));
     RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
+    for (auto& [slot_id, expr_ctx] : _column_expr_ctxs) {
+        RETURN_IF_ERROR(expr_ctx->prepare(state));
+        RETURN_IF_ERROR(expr_ctx->open(state));
+    }
 
     auto tuple_desc = state->desc_tbl().get_tuple_descriptor(_olap_scan_node.tuple_id);
     vectorized::DictOptimizeParser::rewrite_descriptor(state, _conjunct_ctxs, _olap_scan_node.dict_string_id_to_int_ids,
@@ -232,6 +338,9 @@ Status ScanOperatorFactory::prepare(RuntimeState* state) {
 
 void ScanOperatorFactory::close(RuntimeState* state) {
     Expr::close(_conjunct_ctxs, state);
+    for (auto& [slot_id, expr_ctx] : _column_expr_ctxs) {
+        expr_ctx->close(state);
+    }
     OperatorFactory::close(state);
 }
 
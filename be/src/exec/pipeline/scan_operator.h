@@ -6,6 +6,7 @@
 
 #include "exec/pipeline/source_operator.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
+#include "exprs/vectorized/runtime_topn_threshold.h"
 #include "runtime/global_dicts.h"
 #include "util/blocking_queue.hpp"
 #include "util/priority_thread_pool.hpp"
@@ -14,6 +15,9 @@ namespace starrocks {
 namespace vectorized {
 class RuntimeFilterProbeCollector;
 }
+namespace workgroup {
+class WorkGroup;
+}
 namespace pipeline {
 
 class ScanOperator final : public SourceOperator {
@@ -43,6 +47,24 @@ public:
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
     void set_io_threads(PriorityThreadPool* io_threads) { _io_threads = io_threads; }
+    // The io of this operator is accounted to and throttled by |wg|.
+    void set_workgroup(workgroup::WorkGroup* wg) { _workgroup = wg; }
+    // The MorselQueues of the other ScanOperators of the same pipeline, this operator steals morsels from
+    // them once its own MorselQueue is drained, so that the skewed tablets don't keep a single driver busy
+    // while the others are idle.
+    void set_sibling_morsel_queues(std::vector<MorselQueue*> queues) { _sibling_morsel_queues = std::move(queues); }
+    // The threshold published by the TopN above this operator, with which the rows are filtered while reading.
+    void set_runtime_topn_threshold(const vectorized::RuntimeTopnThreshold* threshold) {
+        _runtime_topn_threshold = threshold;
+    }
+    // The digest of the scan by which the results of the tablets are cached, see ScanResultCache.
+    void set_scan_cache_digest(const std::string* digest) { _scan_cache_digest = digest; }
+    // The rows still to output by the limit in the same pipeline, nothing is read any more once it's 0.
+    void set_remaining_limit(const std::atomic<int64_t>* remaining_limit) { _remaining_limit = remaining_limit; }
+    // The slots output as the results of the expressions over them, see ScanOperatorFactory::push_down_column_expr.
+    void set_column_expr_ctxs(const std::vector<std::pair<SlotId, ExprContext*>>* column_expr_ctxs) {
+        _column_expr_ctxs = column_expr_ctxs;
+    }
 
 private:
     const size_t _buffer_size = config::pipeline_io_buffer_size;
@@ -53,6 +75,12 @@ private:
     Status _pickup_morsel(RuntimeState* state, int chunk_source_index);
     Status _trigger_next_scan(RuntimeState* state, int chunk_source_index);
     Status _try_to_trigger_next_scan(RuntimeState* state);
+    // Whether any morsel could be picked up from its own or sibling MorselQueues.
+    bool _has_morsels() const;
+    std::optional<MorselPtr> _try_get_morsel();
+    bool _is_limit_reached() const {
+        return _remaining_limit != nullptr && _remaining_limit->load(std::memory_order_relaxed) == 0;
+    }
 
     // TODO(hcf) ugly, remove this later
     RuntimeState* _state = nullptr;
@@ -63,6 +91,7 @@ private:
     const TOlapScanNode& _olap_scan_node;
     const std::vector<ExprContext*>& _conjunct_ctxs;
     PriorityThreadPool* _io_threads = nullptr;
+    workgroup::WorkGroup* _workgroup = nullptr;
     std::vector<std::string> _unused_output_columns;
     // Pass limit info to scan operator in order to improve sql:
     // select * from table limit x;
@@ -71,6 +100,15 @@ private:
     std::atomic<int> _num_running_io_tasks = 0;
     std::vector<std::atomic<bool>> _is_io_task_running;
     std::vector<ChunkSourcePtr> _chunk_sources;
+
+    std::vector<MorselQueue*> _sibling_morsel_queues;
+    size_t _next_victim = 0;
+    const vectorized::RuntimeTopnThreshold* _runtime_topn_threshold = nullptr;
+    // nullptr or empty if the results of this scan aren't cached.
+    const std::string* _scan_cache_digest = nullptr;
+    const std::vector<std::pair<SlotId, ExprContext*>>* _column_expr_ctxs = nullptr;
+    const std::atomic<int64_t>* _remaining_limit = nullptr;
+    RuntimeProfile::Counter* _stolen_morsels_counter = nullptr;
 };
 
 class ScanOperatorFactory final : public SourceOperatorFactory {
@@ -85,9 +123,35 @@ public:
     ~ScanOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        return std::make_shared<ScanOperator>(this, _id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _limit);
+        auto op = std::make_shared<ScanOperator>(this, _id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _limit);
+        op->set_runtime_topn_threshold(_runtime_topn_threshold.get());
+        op->set_scan_cache_digest(&_scan_cache_digest);
+        op->set_column_expr_ctxs(&_column_expr_ctxs);
+        op->set_remaining_limit(_remaining_limit);
+        return op;
     }
 
+    TupleId tuple_id() const { return _olap_scan_node.tuple_id; }
+    int64_t limit() const { return _limit; }
+    void set_runtime_topn_threshold(std::shared_ptr<vectorized::RuntimeTopnThreshold> threshold) {
+        _runtime_topn_threshold = std::move(threshold);
+    }
+    void set_scan_cache_digest(std::string digest) { _scan_cache_digest = std::move(digest); }
+
+    // Outputs |slot_id| as the results of |expr_ctx|, an expression over the slot only, which is evaluated
+    // by the storage on the dictionary words if it can, see ColumnExpr. Returns false if the original values
+    // of the slot are needed by this scan, i.e. by its conjuncts, runtime filters or cached results.
+    bool push_down_column_expr(SlotId slot_id, ExprContext* expr_ctx);
+    bool has_column_expr(SlotId slot_id) const;
+
+    // See LimitOperatorFactory::remaining_limit.
+    void set_remaining_limit(const std::atomic<int64_t>* remaining_limit) { _remaining_limit = remaining_limit; }
+
+    // Whether the driver i scans the i-th buckets of the fragment instance, see MorselQueue::split_by_bucket,
+    // i.e. the output chunks are already partitioned by the buckets for the colocate joins.
+    bool bucket_aware() const { return _bucket_aware; }
+    void set_bucket_aware(bool bucket_aware) { _bucket_aware = bucket_aware; }
+
     // ScanOperator needs to attach MorselQueue.
     bool with_morsels() const override { return true; }
 
@@ -100,6 +164,11 @@ private:
     // Pass limit info to scan operator in order to improve sql:
     // select * from table limit x;
     int64_t _limit; // -1: no limit
+    std::shared_ptr<vectorized::RuntimeTopnThreshold> _runtime_topn_threshold;
+    std::string _scan_cache_digest;
+    bool _bucket_aware = false;
+    std::vector<std::pair<SlotId, ExprContext*>> _column_expr_ctxs;
+    const std::atomic<int64_t>* _remaining_limit = nullptr;
 };
 
 } // namespace pipeline
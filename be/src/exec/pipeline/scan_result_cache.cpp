@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/scan_result_cache.h"
+
+#include "column/chunk.h"
+#include "column/column.h"
+#include "runtime/current_thread.h"
+#include "runtime/mem_tracker.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::pipeline {
+
+ScanResultCache* ScanResultCache::_s_instance = nullptr;
+
+void ScanResultCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr) {
+        _s_instance = new ScanResultCache(mem_tracker, capacity);
+    }
+}
+
+void ScanResultCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+ScanResultCache::ScanResultCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _capacity(capacity), _cache(new_lru_cache(capacity)) {}
+
+vectorized::ChunkPtr ScanResultCache::copy_chunk(const vectorized::Chunk& chunk) {
+    vectorized::Columns columns;
+    columns.reserve(chunk.num_columns());
+    for (const auto& column : chunk.columns()) {
+        columns.emplace_back(column->clone_shared());
+    }
+    if (chunk.schema() == nullptr) {
+        return std::make_shared<vectorized::Chunk>(std::move(columns), chunk.get_slot_id_to_index_map());
+    }
+    auto copy = std::make_shared<vectorized::Chunk>(std::move(columns), chunk.schema());
+    for (const auto& [slot_id, index] : chunk.get_slot_id_to_index_map()) {
+        copy->set_slot_id_to_index(slot_id, index);
+    }
+    return copy;
+}
+
+bool ScanResultCache::lookup(const std::string& key, Result* result) {
+    StarRocksMetrics::instance()->scan_result_cache_lookup_total.increment(1);
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return false;
+    }
+    const auto* cached = reinterpret_cast<const Result*>(_cache->value(handle));
+    result->version = cached->version;
+    result->chunks.clear();
+    result->chunks.reserve(cached->chunks.size());
+    for (const auto& chunk : cached->chunks) {
+        result->chunks.emplace_back(copy_chunk(*chunk));
+    }
+    _cache->release(handle);
+    StarRocksMetrics::instance()->scan_result_cache_hit_total.increment(1);
+    return true;
+}
+
+void ScanResultCache::insert(const std::string& key, const Result& result) {
+    // the entries are allocated and freed, maybe by the eviction of another insertion, under the tracker of the cache
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+
+    auto* value = new Result();
+    value->version = result.version;
+    value->chunks.reserve(result.chunks.size());
+    size_t charge = key.size() + sizeof(Result);
+    for (const auto& chunk : result.chunks) {
+        value->chunks.emplace_back(copy_chunk(*chunk));
+        charge += value->chunks.back()->memory_usage();
+    }
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<Result*>(value); };
+    _cache->release(_cache->insert(CacheKey(key), value, charge, deleter));
+}
+
+} // namespace starrocks::pipeline
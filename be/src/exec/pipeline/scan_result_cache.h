@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class MemTracker;
+
+namespace pipeline {
+
+// ScanResultCache keeps the output chunks of the OlapChunkSources of the queries sent again and again, e.g. by the
+// dashboards, so that a query scanning a tablet at the same version as the last one doesn't read the tablet again.
+// A result is keyed by the digest of the scan, i.e. its plan node and its output slots, and the tablet, and is
+// tagged with the version of the tablet it's read at. A query scanning a newer version of a duplicate key tablet
+// reads only the new versions and appends them to the cached chunks, see OlapChunkSource.
+class ScanResultCache {
+public:
+    struct Result {
+        int64_t version = 0;
+        std::vector<vectorized::ChunkPtr> chunks;
+    };
+
+    // Create the global instance, a cache of |capacity| bytes charged to |mem_tracker|.
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Returns nullptr if the cache isn't created, i.e. it's disabled.
+    static ScanResultCache* instance() { return _s_instance; }
+
+    ScanResultCache(MemTracker* mem_tracker, size_t capacity);
+
+    // Returns true and sets |result| to a copy of the result of |key| if it's cached, the chunks of the copy are
+    // owned by the caller.
+    bool lookup(const std::string& key, Result* result);
+
+    // Cache a copy of |result|, replacing the old result of |key|.
+    void insert(const std::string& key, const Result& result);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+    size_t capacity() const { return _capacity; }
+
+    // A deep copy of |chunk|, with its schema and its slots.
+    static vectorized::ChunkPtr copy_chunk(const vectorized::Chunk& chunk);
+
+private:
+    static ScanResultCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    size_t _capacity = 0;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace pipeline
+} // namespace starrocks
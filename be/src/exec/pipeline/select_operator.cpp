@@ -4,12 +4,17 @@
 
 #include "column/chunk.h"
 #include "exec/exec_node.h"
+#include "common/config.h"
 #include "exprs/expr.h"
+#include "exprs/vectorized/common_expr_eliminator.h"
+#include "exprs/vectorized/fused_expr.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
 Status SelectOperator::prepare(RuntimeState* state) {
-    return Operator::prepare(state);
+    RETURN_IF_ERROR(Operator::prepare(state));
+    _common_expr_saved_evals_counter = ADD_COUNTER(_runtime_profile, "CommonExprSavedEvaluations", TUnit::UNIT);
+    return Status::OK();
 }
 
 Status SelectOperator::close(RuntimeState* state) {
@@ -72,19 +77,53 @@ bool SelectOperator::need_input() const {
 }
 
 Status SelectOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    bool has_common_exprs = !_common_expr_ctxs.empty() && !chunk->is_empty();
+    if (has_common_exprs) {
+        for (size_t i = 0; i < _common_expr_ctxs.size(); ++i) {
+            ColumnPtr column = _common_expr_ctxs[i]->evaluate(chunk.get());
+            // the chunk is filtered column by column, a column must not be in it twice
+            for (const auto& other : chunk->columns()) {
+                if (other.get() == column.get()) {
+                    column = column->clone_shared();
+                    break;
+                }
+            }
+            chunk->append_column(std::move(column), _common_expr_slot_ids[i]);
+        }
+        COUNTER_UPDATE(_common_expr_saved_evals_counter, _common_expr_saved_evals);
+    }
     eval_conjuncts_and_in_filters(_conjunct_ctxs, chunk.get());
+    if (has_common_exprs) {
+        // the columns of the common subtrees are not a part of the output
+        for (SlotId slot_id : _common_expr_slot_ids) {
+            chunk->remove_column_by_slot_id(slot_id);
+        }
+    }
     _curr_chunk = chunk;
     return Status::OK();
 }
 
 Status SelectOperatorFactory::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    // the conjuncts over the global dict codes are rewritten as a whole, their subtrees must be kept
+    if (config::enable_common_expr_elimination && state->get_query_global_dict_map().empty()) {
+        _common_expr_saved_evals = vectorized::CommonExprEliminator::eliminate(
+                state->obj_pool(), _conjunct_ctxs, state->desc_tbl().max_slot_id() + 1, &_common_expr_ctxs,
+                &_common_expr_slot_ids);
+    }
+    if (config::enable_expr_fusion && state->get_query_global_dict_map().empty()) {
+        vectorized::FusedExpr::fuse(state->obj_pool(), &_common_expr_ctxs);
+        vectorized::FusedExpr::fuse(state->obj_pool(), &_conjunct_ctxs);
+    }
+    RETURN_IF_ERROR(Expr::prepare(_common_expr_ctxs, state));
     RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_common_expr_ctxs, state));
     RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
     return Status::OK();
 }
 
 void SelectOperatorFactory::close(RuntimeState* state) {
+    Expr::close(_common_expr_ctxs, state);
     Expr::close(_conjunct_ctxs, state);
     OperatorFactory::close(state);
 }
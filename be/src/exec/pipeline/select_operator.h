@@ -13,8 +13,13 @@ namespace pipeline {
 class SelectOperator final : public Operator {
 public:
     SelectOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id,
-                   const std::vector<ExprContext*>& conjunct_ctxs)
-            : Operator(factory, id, "select", plan_node_id), _conjunct_ctxs(conjunct_ctxs) {}
+                   const std::vector<ExprContext*>& conjunct_ctxs, const std::vector<SlotId>& common_expr_slot_ids,
+                   const std::vector<ExprContext*>& common_expr_ctxs, int common_expr_saved_evals)
+            : Operator(factory, id, "select", plan_node_id),
+              _conjunct_ctxs(conjunct_ctxs),
+              _common_expr_slot_ids(common_expr_slot_ids),
+              _common_expr_ctxs(common_expr_ctxs),
+              _common_expr_saved_evals(common_expr_saved_evals) {}
 
     ~SelectOperator() override = default;
     Status prepare(RuntimeState* state) override;
@@ -36,6 +41,12 @@ private:
     vectorized::ChunkPtr _pre_output_chunk = nullptr;
 
     const std::vector<ExprContext*>& _conjunct_ctxs;
+    // the subtrees shared by the conjuncts, evaluated into the columns of the slots before the conjuncts
+    const std::vector<SlotId>& _common_expr_slot_ids;
+    const std::vector<ExprContext*>& _common_expr_ctxs;
+    const int _common_expr_saved_evals;
+
+    RuntimeProfile::Counter* _common_expr_saved_evals_counter = nullptr;
 
     bool _is_finished = false;
 };
@@ -48,7 +59,8 @@ public:
     ~SelectOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        return std::make_shared<SelectOperator>(this, _id, _plan_node_id, _conjunct_ctxs);
+        return std::make_shared<SelectOperator>(this, _id, _plan_node_id, _conjunct_ctxs, _common_expr_slot_ids,
+                                                _common_expr_ctxs, _common_expr_saved_evals);
     }
 
     Status prepare(RuntimeState* state) override;
@@ -56,6 +68,9 @@ public:
 
 private:
     std::vector<ExprContext*> _conjunct_ctxs;
+    std::vector<SlotId> _common_expr_slot_ids;
+    std::vector<ExprContext*> _common_expr_ctxs;
+    int _common_expr_saved_evals = 0;
 };
 
 } // namespace pipeline
@@ -2,6 +2,7 @@
 
 #include "exec/pipeline/set/except_context.h"
 
+#include "common/config.h"
 #include "runtime/current_thread.h"
 
 namespace starrocks::pipeline {
@@ -17,6 +18,11 @@ Status ExceptContext::prepare(RuntimeState* state, const std::vector<ExprContext
         _dst_nullables.emplace_back(build_expr->root()->is_nullable());
     }
 
+    if (state->enable_spill()) {
+        _enable_spill = true;
+        _spill_mem_threshold = vectorized::spill_mem_threshold(state->instance_mem_tracker());
+    }
+
     return Status::OK();
 }
 
@@ -30,16 +36,30 @@ Status ExceptContext::close(RuntimeState* state) {
 
 Status ExceptContext::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk,
                                          const std::vector<ExprContext*>& dst_exprs) {
+    if (has_spilled()) {
+        return _spill_chunk(_build_spiller.get(), chunk, dst_exprs);
+    }
     TRY_CATCH_BAD_ALLOC(_hash_set->build_set(state, chunk, dst_exprs, _build_pool.get()));
-    return Status::OK();
+    return _try_spill_hash_set(state);
 }
 
 Status ExceptContext::erase_chunk_from_ht(RuntimeState* state, const ChunkPtr& chunk,
                                           const std::vector<ExprContext*>& dst_exprs) {
+    if (has_spilled()) {
+        if (_probe_spiller == nullptr) {
+            _probe_spiller = std::make_unique<vectorized::PartitionedSpiller>(
+                    "except_probe", _build_spiller->num_partitions(), state->chunk_size());
+        }
+        return _spill_chunk(_probe_spiller.get(), chunk, dst_exprs);
+    }
     return _hash_set->erase_duplicate_row(state, chunk, dst_exprs);
 }
 
 StatusOr<vectorized::ChunkPtr> ExceptContext::pull_chunk(RuntimeState* state) {
+    if (has_spilled() && _next_processed_iter == _hash_set->end()) {
+        RETURN_IF_ERROR(_restore_next_spilled_partition(state));
+    }
+
     // 1. Get at most *state->chunk_size()* remained keys from ht.
     size_t num_remained_keys = 0;
     _remained_keys.resize(state->chunk_size());
@@ -72,4 +92,110 @@ StatusOr<vectorized::ChunkPtr> ExceptContext::pull_chunk(RuntimeState* state) {
     return std::move(dst_chunk);
 }
 
+Status ExceptContext::_try_spill_hash_set(RuntimeState* state) {
+    if (!_enable_spill || !vectorized::should_spill(_hash_set->mem_usage() + _build_pool->total_reserved_bytes(),
+                                                    _spill_mem_threshold)) {
+        return Status::OK();
+    }
+
+    _build_spiller = std::make_unique<vectorized::PartitionedSpiller>("except_build", config::spill_hash_partitions,
+                                                                      state->chunk_size());
+    // Move all the keys of the hash set to the spilled partitions, and the later BUILD rows follow them.
+    auto iter = _hash_set->begin();
+    while (iter != _hash_set->end()) {
+        size_t num_keys = 0;
+        _remained_keys.resize(state->chunk_size());
+        for (; iter != _hash_set->end() && num_keys < state->chunk_size(); ++iter) {
+            _remained_keys[num_keys++] = iter->slice;
+        }
+
+        auto spill_chunk = _create_spill_prototype();
+        _hash_set->deserialize_to_columns(_remained_keys, spill_chunk->columns(), num_keys);
+        RETURN_IF_ERROR(_build_spiller->append(spill_chunk, spill_chunk->columns()));
+    }
+    RETURN_IF_ERROR(_build_spiller->flush());
+
+    _hash_set = std::make_unique<vectorized::ExceptHashSerializeSet>();
+    RETURN_IF_ERROR(_hash_set->init(state));
+    _build_pool->free_all();
+    return Status::OK();
+}
+
+Status ExceptContext::_spill_chunk(vectorized::PartitionedSpiller* spiller, const ChunkPtr& chunk,
+                                   const std::vector<ExprContext*>& exprs) {
+    auto spill_chunk = std::make_shared<vectorized::Chunk>();
+    for (size_t i = 0; i < exprs.size(); ++i) {
+        const auto* slot = _dst_tuple_desc->slots()[i];
+        vectorized::ColumnPtr key_column = exprs[i]->evaluate(chunk.get());
+        spill_chunk->append_column(
+                vectorized::ColumnHelper::move_column(slot->type(), true, key_column, chunk->num_rows()), slot->id());
+    }
+    return spiller->append(spill_chunk, spill_chunk->columns());
+}
+
+Status ExceptContext::_restore_next_spilled_partition(RuntimeState* state) {
+    if (!_is_spill_finished) {
+        RETURN_IF_ERROR(_build_spiller->flip_to_read());
+        if (_probe_spiller != nullptr) {
+            RETURN_IF_ERROR(_probe_spiller->flip_to_read());
+        }
+        _is_spill_finished = true;
+    }
+
+    auto prototype = _create_spill_prototype();
+    while (_next_restore_partition < _build_spiller->num_partitions()) {
+        size_t partition = _next_restore_partition++;
+        _hash_set = std::make_unique<vectorized::ExceptHashSerializeSet>();
+        RETURN_IF_ERROR(_hash_set->init(state));
+        _build_pool->clear();
+
+        vectorized::SpillFile* build_file = _build_spiller->partition(partition);
+        if (build_file == nullptr) {
+            continue;
+        }
+        while (true) {
+            auto res = build_file->read_next(*prototype);
+            if (res.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(res.status());
+            const auto& spilled_chunk = res.value();
+            TRY_CATCH_BAD_ALLOC(_hash_set->build_set(state, spilled_chunk->columns(), spilled_chunk->num_rows(),
+                                                     _build_pool.get()));
+        }
+        _build_spiller->release_partition(partition);
+
+        vectorized::SpillFile* probe_file = _probe_spiller != nullptr ? _probe_spiller->partition(partition) : nullptr;
+        while (probe_file != nullptr) {
+            auto res = probe_file->read_next(*prototype);
+            if (res.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(res.status());
+            const auto& spilled_chunk = res.value();
+            RETURN_IF_ERROR(
+                    _hash_set->erase_duplicate_row(state, spilled_chunk->columns(), spilled_chunk->num_rows()));
+        }
+        if (_probe_spiller != nullptr) {
+            _probe_spiller->release_partition(partition);
+        }
+
+        if (!_hash_set->empty()) {
+            break;
+        }
+    }
+
+    _next_processed_iter = _hash_set->begin();
+    return Status::OK();
+}
+
+ChunkPtr ExceptContext::_create_spill_prototype() const {
+    auto chunk = std::make_shared<vectorized::Chunk>();
+    for (size_t i = 0; i < _dst_nullables.size(); ++i) {
+        const auto* slot = _dst_tuple_desc->slots()[i];
+        chunk->append_column(vectorized::ColumnHelper::create_column(slot->type(), true), slot->id());
+    }
+    return chunk;
+}
+
 } // namespace starrocks::pipeline
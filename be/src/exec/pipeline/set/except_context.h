@@ -9,6 +9,7 @@
 #include "exec/olap_common.h"
 #include "exec/pipeline/context_with_dependency.h"
 #include "exec/vectorized/except_hash_set.h"
+#include "exec/vectorized/spill_file.h"
 #include "exprs/expr_context.h"
 #include "gutil/casts.h"
 #include "runtime/mem_pool.h"
@@ -29,7 +30,7 @@ class ExceptContext final : public ContextWithDependency {
 public:
     explicit ExceptContext(const int dst_tuple_id) : _dst_tuple_id(dst_tuple_id) {}
 
-    bool is_ht_empty() const { return _hash_set->empty(); }
+    bool is_ht_empty() const { return !has_spilled() && _hash_set->empty(); }
 
     void finish_build_ht() {
         _next_processed_iter = _hash_set->begin();
@@ -42,7 +43,13 @@ public:
         return _finished_dependency_index.load(std::memory_order_acquire) == dependency_index;
     }
 
-    bool is_output_finished() const { return _next_processed_iter == _hash_set->end(); }
+    bool is_output_finished() const {
+        return _next_processed_iter == _hash_set->end() &&
+               (!has_spilled() || _next_restore_partition >= _build_spiller->num_partitions());
+    }
+
+    // Whether the hash set has been spilled, and then all the BUILD and PROBE rows go to the spilled partitions.
+    bool has_spilled() const { return _build_spiller != nullptr; }
 
     // Called in the preparation phase of ExceptBuildSinkOperator.
     Status prepare(RuntimeState* state, const std::vector<ExprContext*>& build_exprs);
@@ -58,6 +65,16 @@ public:
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state);
 
 private:
+    // Spill the keys of the hash set into hash partitions if its memory exceeds the threshold.
+    Status _try_spill_hash_set(RuntimeState* state);
+    // The spilled chunks have the nullable dest columns, whichever the nullability of the BUILD and PROBE exprs is,
+    // so that the same keys are always in the same partition.
+    Status _spill_chunk(vectorized::PartitionedSpiller* spiller, const ChunkPtr& chunk,
+                        const std::vector<ExprContext*>& exprs);
+    // Rebuild the hash set from the next non-empty spilled partition, and erase the PROBE rows of it.
+    Status _restore_next_spilled_partition(RuntimeState* state);
+    ChunkPtr _create_spill_prototype() const;
+
     std::unique_ptr<vectorized::ExceptHashSerializeSet> _hash_set =
             std::make_unique<vectorized::ExceptHashSerializeSet>();
 
@@ -84,6 +101,15 @@ private:
     // The i-th PROBE must wait for _finished_dependency_index becoming i-1,
     // and OUTPUT must wait for _finished_dependency_index becoming n.
     std::atomic<int32_t> _finished_dependency_index{-1};
+
+    // Only used when spilling is enabled.
+    // The rows of all the PROBEs share a spiller, since erasing the keys doesn't depend on the order of PROBEs.
+    bool _enable_spill = false;
+    int64_t _spill_mem_threshold = 0;
+    std::unique_ptr<vectorized::PartitionedSpiller> _build_spiller;
+    std::unique_ptr<vectorized::PartitionedSpiller> _probe_spiller;
+    bool _is_spill_finished = false;
+    size_t _next_restore_partition = 0;
 };
 
 // The input chunks of BUILD and PROBE are shuffled by the local shuffle operator.
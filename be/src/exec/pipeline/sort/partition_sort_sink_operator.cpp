@@ -22,6 +22,9 @@ using namespace starrocks::vectorized;
 namespace starrocks::pipeline {
 Status PartitionSortSinkOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Operator::prepare(state));
+    if (state->enable_spill()) {
+        _chunks_sorter->enable_spill(get_runtime_profile());
+    }
     return Status::OK();
 }
 
@@ -79,6 +82,7 @@ OperatorPtr PartitionSortSinkOperatorFactory::create(int32_t degree_of_paralleli
                 runtime_state(), &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first,
                 SIZE_OF_CHUNK_FOR_FULL_SORT);
     }
+    chunks_sorter->set_runtime_topn_threshold(_runtime_topn_threshold.get());
     auto sort_context = _sort_context_factory->create(driver_sequence);
 
     sort_context->add_partition_chunks_sorter(chunks_sorter);
@@ -112,6 +112,11 @@ public:
     Status prepare(RuntimeState* state) override;
     void close(RuntimeState* state) override;
 
+    // The sorters publish the threshold of the first order-by column to the scan of the same pipeline.
+    void set_runtime_topn_threshold(std::shared_ptr<RuntimeTopnThreshold> threshold) {
+        _runtime_topn_threshold = std::move(threshold);
+    }
+
 private:
     std::shared_ptr<SortContextFactory> _sort_context_factory;
     // _sort_exec_exprs contains the ordering expressions
@@ -129,6 +134,7 @@ private:
     const RowDescriptor& _parent_node_row_desc;
     const RowDescriptor& _parent_node_child_row_desc;
     std::vector<ExprContext*> _analytic_partition_exprs;
+    std::shared_ptr<RuntimeTopnThreshold> _runtime_topn_threshold;
 };
 
 } // namespace pipeline
@@ -4,6 +4,59 @@
 
 namespace starrocks {
 namespace pipeline {
+SortContext::~SortContext() = default;
+
+StatusOr<ChunkPtr> SortContext::_pull_merged_chunk() {
+    if (_merger == nullptr) {
+        ChunkSuppliers chunk_suppliers;
+        ChunkProbeSuppliers chunk_probe_suppliers;
+        ChunkHasSuppliers chunk_has_suppliers;
+        for (auto& chunks_sorter : _chunks_sorter_partions) {
+            for (size_t run = 0; run < chunks_sorter->num_sorted_runs(); ++run) {
+                chunk_suppliers.emplace_back([this, sorter = chunks_sorter.get(), run](Chunk** chunk) -> Status {
+                    *chunk = nullptr;
+                    ChunkPtr next;
+                    Status st = sorter->get_next_from_sorted_run(run, &next);
+                    if (!st.ok()) {
+                        if (_merge_status.ok()) {
+                            _merge_status = st;
+                        }
+                        return st;
+                    }
+                    if (next != nullptr) {
+                        // The chunk is owned by the cursor, so move the columns out of the shared one.
+                        *chunk = new Chunk(std::move(*next));
+                    }
+                    return Status::OK();
+                });
+                chunk_probe_suppliers.emplace_back([](Chunk** chunk) -> bool { return false; });
+                chunk_has_suppliers.emplace_back([]() -> bool { return true; });
+            }
+        }
+        _merger = std::make_unique<SortedChunksMerger>(_state, false);
+        RETURN_IF_ERROR(_merger->init(chunk_suppliers, chunk_probe_suppliers, chunk_has_suppliers,
+                                      _chunks_sorter_partions[0]->sort_exprs(), &_is_asc_order, &_is_null_first));
+        RETURN_IF_ERROR(_merge_status);
+    }
+
+    ChunkPtr chunk;
+    bool eos = false;
+    RETURN_IF_ERROR(_merger->get_next(&chunk, &eos));
+    RETURN_IF_ERROR(_merge_status);
+    if (eos || chunk == nullptr) {
+        _next_output_row = _require_rows;
+        return std::make_shared<vectorized::Chunk>();
+    }
+
+    // Full sort never has a limit, but keep the same semantic as the heap merging.
+    size_t needed_rows = _require_rows - _next_output_row;
+    if (chunk->num_rows() > needed_rows) {
+        chunk->set_num_rows(needed_rows);
+    }
+    _next_output_row += chunk->num_rows();
+    return chunk;
+}
+
 SortContextFactory::SortContextFactory(RuntimeState* state, bool is_merging, int64_t limit, int32_t num_right_sinkers,
                                        const std::vector<bool>& is_asc_order, const std::vector<bool>& is_null_first)
         : _state(state),
@@ -12,6 +12,7 @@
 #include "exec/vectorized/chunks_sorter.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -30,11 +31,15 @@ public:
             : _state(state),
               _limit(limit),
               _num_partition_sinkers(num_right_sinkers),
+              _is_asc_order(is_asc_order),
+              _is_null_first(is_null_first),
               _comparer(limit, is_asc_order, is_null_first) {
         _chunks_sorter_partions.reserve(num_right_sinkers);
         _data_segment_heaps.reserve(num_right_sinkers);
     }
 
+    ~SortContext() override;
+
     Status close(RuntimeState* state) override { return Status::OK(); }
 
     void finish_partition(uint64_t partition_rows) {
@@ -63,7 +68,10 @@ public:
 
     // Dispatch logic for full sort and topn,
     // provide different index parrterns through lambda expression.
-    ChunkPtr pull_chunk() {
+    StatusOr<ChunkPtr> pull_chunk() {
+        if (_is_merging_sorted_runs) {
+            return _pull_merged_chunk();
+        }
         if (_limit < 0) {
             return pull_chunk([](DataSegment* min_heap_entry) -> uint32_t {
                 return (*min_heap_entry->_sorted_permutation)[min_heap_entry->_next_output_row++].index_in_chunk;
@@ -152,6 +160,9 @@ private:
     const int32_t _num_partition_sinkers;
     std::atomic<int32_t> _num_partition_finished = 0;
 
+    const std::vector<bool> _is_asc_order;
+    const std::vector<bool> _is_null_first;
+
     // Is used to gather all partition sorted chunks,
     // partition per ChunksSorter.
     std::vector<std::shared_ptr<ChunksSorter>> _chunks_sorter_partions;
@@ -202,6 +213,13 @@ private:
     // DataSegment per ChunksSorter.
     void _heapify_chunks_sorter() const {
         auto num_chunks_sorter = _num_partition_sinkers;
+        for (int i = 0; i < num_chunks_sorter; ++i) {
+            if (_chunks_sorter_partions[i]->has_spilled()) {
+                // The sorted runs of the spilled sorters are merged by _merger in _pull_merged_chunk().
+                _is_merging_sorted_runs = true;
+                return;
+            }
+        }
         for (int i = 0; i < num_chunks_sorter; ++i) {
             auto data_segment = _chunks_sorter_partions[i]->get_result_data_segment();
             if (data_segment != nullptr) {
@@ -238,7 +256,15 @@ private:
         }
     }
 
+    // Merge the sorted runs of all the ChunksSorters, used when any of them has spilled.
+    StatusOr<ChunkPtr> _pull_merged_chunk();
+
     size_t _next_output_row = 0;
+
+    mutable bool _is_merging_sorted_runs = false;
+    std::unique_ptr<SortedChunksMerger> _merger;
+    // The first error of reading sorted runs, ChunkCursor drops the status returned by suppliers.
+    Status _merge_status;
 };
 class SortContextFactory;
 using SortContextFactoryPtr = std::shared_ptr<SortContextFactory>;
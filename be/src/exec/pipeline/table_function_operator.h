@@ -61,6 +61,8 @@ private:
     bool _table_function_result_eos;
     //table function param and return offset
     vectorized::TableFunctionState* _table_function_state;
+    //The index of the outer row of every output row
+    std::vector<uint32_t> _outer_row_indexes;
 
     //Profile
     RuntimeProfile::Counter* _table_function_exec_timer = nullptr;
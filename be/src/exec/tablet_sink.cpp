@@ -38,7 +38,9 @@
 #include "service/brpc.h"
 #include "simd/simd.h"
 #include "storage/hll.h"
+#include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
+#include "util/compression_utils.h"
 #include "util/defer_op.h"
 #include "util/monotime.h"
 #include "util/thread.h"
@@ -101,6 +103,12 @@ Status NodeChannel::init(RuntimeState* state) {
 
     _rpc_timeout_ms = state->query_options().query_timeout * 1000;
 
+    if (state->query_options().__isset.load_transmission_compression_type) {
+        _compress_type =
+                CompressionUtils::to_compression_pb(state->query_options().load_transmission_compression_type);
+    }
+    RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+
     // for get global_dict
     _runtime_state = state;
 
@@ -229,8 +237,7 @@ Status NodeChannel::add_chunk(vectorized::Chunk* chunk, const int64_t* tablet_id
     // But there is still some unfinished things, we do mem limit here temporarily.
     // _cancelled may be set by rpc callback, and it's possible that _cancelled might be set in any of the steps below.
     // It's fine to do a fake add_row() and return OK, because we will check _cancelled in next add_row() or mark_close().
-    while (!_cancelled && ((_mem_tracker->any_limit_exceeded() && _pending_batches_num > 0) ||
-                           _pending_batches_num >= _max_pending_batches_num)) {
+    while (is_full()) {
         SCOPED_RAW_TIMER(&_mem_exceeded_block_ns);
         SleepFor(MonoDelta::FromMilliseconds(10));
     }
@@ -258,6 +265,29 @@ Status NodeChannel::add_chunk(vectorized::Chunk* chunk, const int64_t* tablet_id
     return Status::OK();
 }
 
+// The chunk is sent as it is if compressing doesn't save enough, TabletsChannel tells it by the compress_type.
+void NodeChannel::_try_compress_chunk(ChunkPB* pchunk) {
+    size_t uncompressed_size = pchunk->uncompressed_size();
+    if (_compress_codec == nullptr || uncompressed_size == 0 ||
+        _compress_codec->exceed_max_input_size(uncompressed_size)) {
+        return;
+    }
+    size_t max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
+    if (_compression_scratch.size() < max_compressed_size) {
+        _compression_scratch.resize(max_compressed_size);
+    }
+    Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
+    if (!_compress_codec->compress(pchunk->data(), &compressed_slice).ok()) {
+        return;
+    }
+    double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
+    if (compress_ratio > config::rpc_compress_ratio_threshold) {
+        _compression_scratch.resize(compressed_slice.size);
+        pchunk->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
+        pchunk->set_compress_type(_compress_type);
+    }
+}
+
 Status NodeChannel::mark_close() {
     auto st = none_of({_cancelled, _eos_is_produced});
     if (!st.ok()) {
@@ -354,6 +384,7 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
             StatusOr<ChunkPB> chunk_pb = serde::ProtobufChunkSerde::serialize(*chunk);
             CHECK(chunk_pb.ok()) << chunk_pb.status(); // FIXME
             request.mutable_chunk()->Swap(&chunk_pb.value());
+            _try_compress_chunk(request.mutable_chunk());
         }
 
         _add_batch_closure->reset();
@@ -621,6 +652,17 @@ Status OlapTableSink::open(RuntimeState* state) {
     return Status::OK();
 }
 
+bool OlapTableSink::is_full() const {
+    for (const auto& index_channel : _channels) {
+        for (const auto& [node_id, ch] : index_channel->_node_channels) {
+            if (ch->is_full()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 Status OlapTableSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk) {
     SCOPED_TIMER(_profile->total_time_counter());
     DCHECK(chunk->num_rows() > 0);
@@ -716,7 +758,8 @@ Status OlapTableSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk)
                 uint16_t selection = _validate_select_idx[j];
                 _tablet_ids[selection] = _partitions[selection]->indexes[i].tablets[_tablet_indexes[selection]];
             }
-            RETURN_IF_ERROR(_send_chunk_by_node(chunk, _channels[i].get(), _validate_select_idx));
+            RETURN_IF_ERROR(
+                    _send_chunk_by_node(_project_chunk_for_index(chunk, i), _channels[i].get(), _validate_select_idx));
         }
     } else { // Improve for all rows are selected
         for (size_t i = 0; i < num_rows; ++i) {
@@ -728,12 +771,32 @@ Status OlapTableSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk)
             for (size_t j = 0; j < num_rows; ++j) {
                 _tablet_ids[j] = _partitions[j]->indexes[i].tablets[_tablet_indexes[j]];
             }
-            RETURN_IF_ERROR(_send_chunk_by_node(chunk, _channels[i].get(), _validate_select_idx));
+            RETURN_IF_ERROR(
+                    _send_chunk_by_node(_project_chunk_for_index(chunk, i), _channels[i].get(), _validate_select_idx));
         }
     }
     return Status::OK();
 }
 
+// A rollup is made of a part of the columns of the base table, and its TabletsChannel builds the memtables
+// from the columns of its own slots only. So the other columns are not serialized and sent to it, which is
+// most of the cost of a load paid once more per rollup. The receiver reads the columns by the slot ids sent
+// with the chunk.
+vectorized::Chunk* OlapTableSink::_project_chunk_for_index(vectorized::Chunk* chunk, size_t index) {
+    const auto& slots = _schema->indexes()[index]->slots;
+    if (!config::enable_load_index_projection || slots.size() >= chunk->num_columns()) {
+        return chunk;
+    }
+    _index_chunk = std::make_unique<vectorized::Chunk>();
+    for (const auto* slot : slots) {
+        if (!chunk->is_slot_exist(slot->id())) {
+            return chunk;
+        }
+        _index_chunk->append_column(chunk->get_column_by_slot_id(slot->id()), slot->id());
+    }
+    return _index_chunk.get();
+}
+
 Status OlapTableSink::_send_chunk_by_node(vectorized::Chunk* chunk, IndexChannel* channel,
                                           std::vector<uint16_t>& selection_idx) {
     Status err_st = Status::OK();
@@ -39,11 +39,13 @@
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/global_dicts.h"
 #include "util/bitmap.h"
+#include "util/raw_container.h"
 #include "util/ref_count_closure.h"
 
 namespace starrocks {
 
 class Bitmap;
+class BlockCompressionCodec;
 class MemTracker;
 class RuntimeProfile;
 class RowDescriptor;
@@ -169,6 +171,12 @@ public:
 
     int try_send_chunk_and_fetch_status();
 
+    // add_chunk() blocks until the channel is not full, a cancelled channel fails add_chunk() at once.
+    bool is_full() const {
+        return !_cancelled && ((_mem_tracker->any_limit_exceeded() && _pending_batches_num > 0) ||
+                               _pending_batches_num >= _max_pending_batches_num);
+    }
+
     void time_report(std::unordered_map<int64_t, AddBatchCounter>* add_batch_counter_map, int64_t* serialize_batch_ns,
                      int64_t* mem_exceeded_block_ns, int64_t* queue_push_lock_ns, int64_t* actual_consume_ns) {
         (*add_batch_counter_map)[_node_id] += _add_batch_counter;
@@ -188,6 +196,8 @@ public:
     void clear_all_batches();
 
 private:
+    void _try_compress_chunk(ChunkPB* pchunk);
+
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
 
     OlapTableSink* _parent = nullptr;
@@ -231,6 +241,10 @@ private:
     AddBatchCounter _add_batch_counter;
     int64_t _serialize_batch_ns = 0;
 
+    CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
+    const BlockCompressionCodec* _compress_codec = nullptr;
+    raw::RawString _compression_scratch;
+
     std::unique_ptr<vectorized::Chunk> _cur_chunk;
     using AddChunkReq = std::pair<std::unique_ptr<vectorized::Chunk>, PTabletWriterAddChunkRequest>;
     std::queue<AddChunkReq> _pending_chunks;
@@ -301,6 +315,10 @@ public:
     // Returns the runtime profile for the sink.
     RuntimeProfile* profile() override { return _profile; }
 
+    // Returns true if send_chunk() would block on a full NodeChannel, which the pipeline engine
+    // checks before sending the next chunk instead of blocking the driver.
+    bool is_full() const;
+
 private:
     template <PrimitiveType PT>
     void _validate_decimal(RuntimeState* state, vectorized::Column* column, const SlotDescriptor* desc,
@@ -324,6 +342,9 @@ private:
     // send chunk data to specific BE channel
     Status _send_chunk_by_node(vectorized::Chunk* chunk, IndexChannel* channel, std::vector<uint16_t>& _selection_idx);
 
+    // Returns the columns of |chunk| read by the index |index|, sharing the columns with |chunk|.
+    vectorized::Chunk* _project_chunk_for_index(vectorized::Chunk* chunk, size_t index);
+
     friend class NodeChannel;
     friend class IndexChannel;
 
@@ -378,6 +399,8 @@ private:
     // one chunk selection for BE node
     std::vector<uint32_t> _node_select_idx;
     std::vector<int64_t> _tablet_ids;
+    // the columns of the chunk sent to the current rollup
+    std::unique_ptr<vectorized::Chunk> _index_chunk;
     vectorized::OlapTablePartitionParam* _vectorized_partition;
     // Store the output expr comput result column
     std::unique_ptr<vectorized::Chunk> _output_chunk;
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <array>
 #include <type_traits>
+#include <utility>
 
 #include "column/column.h"
 #include "column/column_hash.h"
@@ -20,10 +22,113 @@ namespace starrocks::vectorized {
 
 using AggDataPtr = uint8_t*;
 
+// SmallFixedSizeAggHashMap holds a slot for every value of a one byte key in a dense array, so a lookup
+// is an array index instead of hashing and probing. It provides the part of the interface of
+// phmap::flat_hash_map used by the agg hash maps, and its iteration is in the order of the keys.
+template <typename Key>
+class SmallFixedSizeAggHashMap {
+    static_assert(sizeof(Key) == 1, "only one byte key has a dense array of all the values");
+
+public:
+    using key_type = Key;
+    using mapped_type = AggDataPtr;
+    using value_type = std::pair<Key, AggDataPtr>;
+
+    static constexpr size_t NUM_SLOTS = 256;
+
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(value_type* slot, value_type* end) : _slot(slot), _end(end) { _skip_empty(); }
+
+        value_type& operator*() const { return *_slot; }
+        value_type* operator->() const { return _slot; }
+        iterator& operator++() {
+            ++_slot;
+            _skip_empty();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+        bool operator==(const iterator& other) const { return _slot == other._slot; }
+        bool operator!=(const iterator& other) const { return _slot != other._slot; }
+
+    private:
+        void _skip_empty() {
+            while (_slot != _end && _slot->second == nullptr) {
+                ++_slot;
+            }
+        }
+
+        value_type* _slot = nullptr;
+        value_type* _end = nullptr;
+    };
+
+    struct hasher {
+        size_t operator()(Key key) const { return static_cast<uint8_t>(key); }
+    };
+
+    SmallFixedSizeAggHashMap() {
+        for (size_t i = 0; i < NUM_SLOTS; i++) {
+            _slots[i] = {static_cast<Key>(i), nullptr};
+        }
+    }
+
+    iterator begin() { return {_slots.data(), _slots.data() + NUM_SLOTS}; }
+    iterator end() { return {_slots.data() + NUM_SLOTS, _slots.data() + NUM_SLOTS}; }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return NUM_SLOTS; }
+    size_t dump_bound() const { return sizeof(_slots); }
+    void reserve(size_t) {}
+
+    hasher hash_function() const { return {}; }
+    void prefetch_hash(size_t) const {}
+
+    iterator find(Key key) {
+        value_type* slot = &_slots[static_cast<uint8_t>(key)];
+        return slot->second != nullptr ? iterator(slot, _slots.data() + NUM_SLOTS) : end();
+    }
+
+    template <typename Func>
+    iterator lazy_emplace(Key key, Func&& f) {
+        value_type* slot = &_slots[static_cast<uint8_t>(key)];
+        if (slot->second == nullptr) {
+            f([&](Key, AggDataPtr value) {
+                slot->second = value;
+                _size++;
+            });
+        }
+        return {slot, _slots.data() + NUM_SLOTS};
+    }
+
+    template <typename Func>
+    iterator lazy_emplace_with_hash(Key key, size_t, Func&& f) {
+        return lazy_emplace(key, std::forward<Func>(f));
+    }
+
+    void erase(Key key) {
+        value_type* slot = &_slots[static_cast<uint8_t>(key)];
+        if (slot->second != nullptr) {
+            slot->second = nullptr;
+            _size--;
+        }
+    }
+    void erase_with_hash(Key key, size_t) { erase(key); }
+
+private:
+    std::array<value_type, NUM_SLOTS> _slots;
+    size_t _size = 0;
+};
+
 // =====================
 // one level agg hash map
+// The seed is meaningless for the dense array, kept for the same template as the other maps.
 template <PhmapSeed seed>
-using Int8AggHashMap = phmap::flat_hash_map<int8_t, AggDataPtr, StdHashWithSeed<int8_t, seed>>;
+using Int8AggHashMap = SmallFixedSizeAggHashMap<int8_t>;
 template <PhmapSeed seed>
 using Int16AggHashMap = phmap::flat_hash_map<int16_t, AggDataPtr, StdHashWithSeed<int16_t, seed>>;
 template <PhmapSeed seed>
@@ -53,6 +158,8 @@ using FixedSize16SliceAggHashMap =
 // two level agg hash map
 template <PhmapSeed seed>
 using Int32AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
+template <PhmapSeed seed>
+using Int64AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int64_t, AggDataPtr, StdHashWithSeed<int64_t, seed>>;
 
 // The SliceAggTwoLevelHashMap will have 2 ^ 4 = 16 sub map,
 // The 16 is same as PartitionedAggregationNode::PARTITION_FANOUT
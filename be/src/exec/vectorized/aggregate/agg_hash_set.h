@@ -47,6 +47,8 @@ using FixedSize16SliceAggHashSet = phmap::flat_hash_set<SliceKey16, FixedSizeSli
 // two level agg hash set
 template <PhmapSeed seed>
 using Int32AggTwoLevelHashSet = phmap::parallel_flat_hash_set<int32_t, StdHashWithSeed<int32_t, seed>>;
+template <PhmapSeed seed>
+using Int64AggTwoLevelHashSet = phmap::parallel_flat_hash_set<int64_t, StdHashWithSeed<int64_t, seed>>;
 
 template <PhmapSeed seed>
 using SliceAggTwoLevelHashSet =
@@ -27,6 +27,7 @@ namespace starrocks::vectorized {
     M(phase1_slice)                   \
     M(phase1_slice_two_level)         \
     M(phase1_int32_two_level)         \
+    M(phase1_int64_two_level)         \
     M(phase2_uint8)                   \
     M(phase2_int8)                    \
     M(phase2_int16)                   \
@@ -42,6 +43,7 @@ namespace starrocks::vectorized {
     M(phase2_slice)                   \
     M(phase2_slice_two_level)         \
     M(phase2_int32_two_level)         \
+    M(phase2_int64_two_level)         \
     M(phase1_slice_fx4)               \
     M(phase1_slice_fx8)               \
     M(phase1_slice_fx16)              \
@@ -103,6 +105,7 @@ namespace starrocks::vectorized {
     M(phase1_null_string)        \
     M(phase1_slice_two_level)    \
     M(phase1_int32_two_level)    \
+    M(phase1_int64_two_level)    \
     M(phase2_uint8)              \
     M(phase2_int8)               \
     M(phase2_int16)              \
@@ -130,6 +133,7 @@ namespace starrocks::vectorized {
     M(phase2_null_string)        \
     M(phase2_slice_two_level)    \
     M(phase2_int32_two_level)    \
+    M(phase2_int64_two_level)    \
     M(phase1_slice_fx4)          \
     M(phase1_slice_fx8)          \
     M(phase1_slice_fx16)         \
@@ -201,6 +205,8 @@ template <PhmapSeed seed>
 using SerializedKeyTwoLevelAggHashMap = AggHashMapWithSerializedKey<SliceAggTwoLevelHashMap<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<TYPE_INT, Int32AggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using Int64TwoLevelAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<TYPE_BIGINT, Int64AggTwoLevelHashMap<seed>>;
 
 // fixed slice key type.
 template <PhmapSeed seed>
@@ -251,6 +257,7 @@ struct HashMapVariant {
         phase1_slice,
         phase1_slice_two_level,
         phase1_int32_two_level,
+        phase1_int64_two_level,
 
         phase1_slice_fx4,
         phase1_slice_fx8,
@@ -283,6 +290,7 @@ struct HashMapVariant {
         phase2_slice,
         phase2_slice_two_level,
         phase2_int32_two_level,
+        phase2_int64_two_level,
 
         phase2_slice_fx4,
         phase2_slice_fx8,
@@ -321,6 +329,7 @@ struct HashMapVariant {
     std::unique_ptr<SerializedKeyAggHashMap<PhmapSeed1>> phase1_slice;
     std::unique_ptr<SerializedKeyTwoLevelAggHashMap<PhmapSeed1>> phase1_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_int32_two_level;
+    std::unique_ptr<Int64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_int64_two_level;
 
     std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed1>> phase1_slice_fx4;
     std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed1>> phase1_slice_fx8;
@@ -357,6 +366,7 @@ struct HashMapVariant {
     std::unique_ptr<SerializedKeyAggHashMap<PhmapSeed2>> phase2_slice;
     std::unique_ptr<SerializedKeyTwoLevelAggHashMap<PhmapSeed2>> phase2_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int32_two_level;
+    std::unique_ptr<Int64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int64_two_level;
 
     std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed2>> phase2_slice_fx4;
     std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed2>> phase2_slice_fx8;
@@ -476,6 +486,8 @@ template <PhmapSeed seed>
 using SerializedTwoLevelKeyAggHashSet = AggHashSetOfSerializedKey<SliceAggTwoLevelHashSet<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashSetOfOneNumberKey = AggHashSetOfOneNumberKey<TYPE_INT, Int32AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using Int64TwoLevelAggHashSetOfOneNumberKey = AggHashSetOfOneNumberKey<TYPE_BIGINT, Int64AggTwoLevelHashSet<seed>>;
 
 // For fixed slice type.
 template <PhmapSeed seed>
@@ -524,6 +536,7 @@ struct HashSetVariant {
         phase1_slice,
         phase1_slice_two_level,
         phase1_int32_two_level,
+        phase1_int64_two_level,
         phase2_uint8,
         phase2_int8,
         phase2_int16,
@@ -551,6 +564,7 @@ struct HashSetVariant {
         phase2_slice,
         phase2_slice_two_level,
         phase2_int32_two_level,
+        phase2_int64_two_level,
 
         phase1_slice_fx4,
         phase1_slice_fx8,
@@ -594,6 +608,7 @@ struct HashSetVariant {
     std::unique_ptr<SerializedKeyAggHashSet<PhmapSeed1>> phase1_slice;
     std::unique_ptr<SerializedTwoLevelKeyAggHashSet<PhmapSeed1>> phase1_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_int32_two_level;
+    std::unique_ptr<Int64TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_int64_two_level;
 
     std::unique_ptr<UInt8AggHashSetOfOneNumberKey<PhmapSeed2>> phase2_uint8;
     std::unique_ptr<Int8AggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int8;
@@ -628,6 +643,7 @@ struct HashSetVariant {
     std::unique_ptr<SerializedKeyAggHashSet<PhmapSeed2>> phase2_slice;
     std::unique_ptr<SerializedTwoLevelKeyAggHashSet<PhmapSeed2>> phase2_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int32_two_level;
+    std::unique_ptr<Int64TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int64_two_level;
 
     std::unique_ptr<SerializedKeyAggHashSetFixedSize4<PhmapSeed1>> phase1_slice_fx4;
     std::unique_ptr<SerializedKeyAggHashSetFixedSize8<PhmapSeed1>> phase1_slice_fx8;
@@ -141,6 +141,10 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
                     COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
 
                     continue;
+                } else if (_aggregator->should_pass_through_preagg()) {
+                    SCOPED_TIMER(_aggregator->streaming_timer());
+                    _aggregator->output_chunk_by_streaming(chunk);
+                    break;
                 } else {
                     // TODO: direct call the function may affect the performance of some aggregated cases
                     {
@@ -161,6 +165,7 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
                     }
 
                     size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
+                    _aggregator->update_preagg_hit_rows(input_chunk_size, zero_count);
                     if (zero_count == 0) {
                         SCOPED_TIMER(_aggregator->streaming_timer());
                         _aggregator->output_chunk_by_streaming(chunk);
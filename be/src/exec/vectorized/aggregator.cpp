@@ -2,8 +2,11 @@
 
 #include "aggregator.h"
 
+#include <algorithm>
+
 #include "common/status.h"
 #include "exprs/anyval_util.h"
+#include "common/config.h"
 #include "runtime/current_thread.h"
 
 namespace starrocks {
@@ -152,6 +155,10 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile
             if (fn.name.function_name == "intersect_count") {
                 arg_type = TypeDescriptor::from_thrift(fn.arg_types[1]);
             }
+            // window_funnel's first argument is the window, its second one is the time.
+            if (fn.name.function_name == "window_funnel") {
+                arg_type = TypeDescriptor::from_thrift(fn.arg_types[1]);
+            }
 
             bool is_input_nullable = has_outer_join_child || desc.nodes[0].has_nullable_child;
             auto* func = vectorized::get_aggregate_function(fn.name.function_name, arg_type.type, return_type.type,
@@ -217,6 +224,12 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile
     DCHECK_EQ(_intermediate_tuple_desc->slots().size(), _output_tuple_desc->slots().size());
 
     RETURN_IF_ERROR(Expr::prepare(_group_by_expr_ctxs, state));
+    // the scans of the fragment instance record the columns of these slots as grouped
+    std::vector<SlotId> grouping_slot_ids;
+    for (auto* ctx : _group_by_expr_ctxs) {
+        ctx->root()->get_slot_ids(&grouping_slot_ids);
+    }
+    state->add_grouping_slots(grouping_slot_ids);
 
     for (const auto& ctx : _agg_expr_ctxs) {
         RETURN_IF_ERROR(Expr::prepare(ctx, state));
@@ -340,6 +353,38 @@ bool Aggregator::should_expand_preagg_hash_tables(size_t prev_row_returned, size
     return current_reduction > min_reduction;
 }
 
+bool Aggregator::should_pass_through_preagg() {
+    if (_num_pass_through_chunks == 0) {
+        return false;
+    }
+    _num_pass_through_chunks--;
+    return true;
+}
+
+void Aggregator::update_preagg_hit_rows(size_t num_rows, size_t num_hit_rows) {
+    if (num_rows == 0) {
+        return;
+    }
+    double hit_ratio = static_cast<double>(num_hit_rows) / num_rows;
+    if (hit_ratio < config::streaming_preagg_min_hit_ratio) {
+        // Still poor after passing through for a while, pass through for longer.
+        if (_pass_through_interval > 0) {
+            _pass_through_interval = std::min(_pass_through_interval * 2, max_pass_through_interval);
+            _num_pass_through_chunks = _pass_through_interval;
+        } else if (++_num_poor_hit_chunks >= poor_hit_chunks_to_pass_through) {
+            _pass_through_interval = min_pass_through_interval;
+            _num_pass_through_chunks = _pass_through_interval;
+            _num_poor_hit_chunks = 0;
+        }
+    } else {
+        _num_poor_hit_chunks = 0;
+        // The hits between the two thresholds keep the interval, so that the mode does not flap.
+        if (hit_ratio >= 2 * config::streaming_preagg_min_hit_ratio) {
+            _pass_through_interval = 0;
+        }
+    }
+}
+
 void Aggregator::compute_single_agg_state(size_t chunk_size) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         if (!_is_merge_funcs[i]) {
@@ -522,6 +567,10 @@ void Aggregator::try_convert_to_two_level_map() {
     if (_mem_tracker->consumption() > two_level_memory_threshold) {
         CONVERT_TO_TWO_LEVEL_MAP(phase1_slice_two_level, phase1_slice);
         CONVERT_TO_TWO_LEVEL_MAP(phase2_slice_two_level, phase2_slice);
+        CONVERT_TO_TWO_LEVEL_MAP(phase1_int32_two_level, phase1_int32);
+        CONVERT_TO_TWO_LEVEL_MAP(phase2_int32_two_level, phase2_int32);
+        CONVERT_TO_TWO_LEVEL_MAP(phase1_int64_two_level, phase1_int64);
+        CONVERT_TO_TWO_LEVEL_MAP(phase2_int64_two_level, phase2_int64);
     }
 }
 
@@ -529,33 +578,200 @@ void Aggregator::try_convert_to_two_level_set() {
     if (_mem_tracker->consumption() > two_level_memory_threshold) {
         CONVERT_TO_TWO_LEVEL_SET(phase1_slice_two_level, phase1_slice);
         CONVERT_TO_TWO_LEVEL_SET(phase2_slice_two_level, phase2_slice);
+        CONVERT_TO_TWO_LEVEL_SET(phase1_int32_two_level, phase1_int32);
+        CONVERT_TO_TWO_LEVEL_SET(phase2_int32_two_level, phase2_int32);
+        CONVERT_TO_TWO_LEVEL_SET(phase1_int64_two_level, phase1_int64);
+        CONVERT_TO_TWO_LEVEL_SET(phase2_int64_two_level, phase2_int64);
     }
 }
 
 #undef CONVERT_TO_TWO_LEVEL
 
+void Aggregator::enable_spill() {
+    // The hash set of distinct aggregation and the limited group by, which stops inserting
+    // new keys once the limit is reached, are not spillable.
+    if (_group_by_expr_ctxs.empty() || _is_only_group_by_columns || (_limit != -1 && _conjunct_ctxs.empty())) {
+        return;
+    }
+    _spiller = std::make_unique<vectorized::PartitionedSpiller>("agg", config::spill_hash_partitions,
+                                                                _state->chunk_size());
+    _spill_mem_threshold = vectorized::spill_mem_threshold(_mem_tracker);
+    _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+    _restore_timer = ADD_TIMER(_runtime_profile, "RestoreTime");
+    _spilled_rows_counter = ADD_COUNTER(_runtime_profile, "SpilledRows", TUnit::UNIT);
+    _spilled_bytes_counter = ADD_COUNTER(_runtime_profile, "SpilledBytes", TUnit::BYTES);
+}
+
+Status Aggregator::try_spill_hash_map() {
+    if (_spiller == nullptr || !vectorized::should_spill(_mem_tracker->consumption(), _spill_mem_threshold)) {
+        return Status::OK();
+    }
+    return _spill_hash_map();
+}
+
+Status Aggregator::_spill_hash_map() {
+    DCHECK(!_is_spill_finished);
+    SCOPED_TIMER(_spill_timer);
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                        \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) {                     \
+        RETURN_IF_ERROR(_spill_hash_map_with_key<decltype(_hash_map_variant.NAME)::element_type>(    \
+                *_hash_map_variant.NAME));                                                           \
+    }
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    RETURN_IF_ERROR(_spiller->flush());
+    _reset_hash_map();
+
+    COUNTER_SET(_spilled_rows_counter, (int64_t)_spiller->spilled_rows());
+    COUNTER_SET(_spilled_bytes_counter, (int64_t)_spiller->spilled_bytes());
+    return Status::OK();
+}
+
+Status Aggregator::_finish_spill() {
+    // The keys in the hash map may also exist in the spilled partitions,
+    // so spill the remaining ones too, and merge all of them partition by partition.
+    if (_hash_map_variant.size() > 0) {
+        RETURN_IF_ERROR(_spill_hash_map());
+    }
+    RETURN_IF_ERROR(_spiller->flip_to_read());
+    _is_spill_finished = true;
+    _is_ht_eos = true;
+    return Status::OK();
+}
+
+Status Aggregator::restore_next_spilled_partition() {
+    if (!_is_spill_finished) {
+        RETURN_IF_ERROR(_finish_spill());
+    }
+    SCOPED_TIMER(_restore_timer);
+    _reset_hash_map();
+
+    auto prototype = _create_spill_prototype();
+    while (_next_restore_partition < _spiller->num_partitions()) {
+        size_t partition = _next_restore_partition++;
+        vectorized::SpillFile* file = _spiller->partition(partition);
+        if (file == nullptr) {
+            continue;
+        }
+        while (true) {
+            auto res = file->read_next(*prototype);
+            if (res.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(res.status());
+            TRY_CATCH_BAD_ALLOC(_merge_spilled_chunk(res.value()));
+        }
+        _spiller->release_partition(partition);
+        _mem_tracker->set(_hash_map_variant.memory_usage() + _mem_pool->total_reserved_bytes());
+        if (_hash_map_variant.size() > 0) {
+            break;
+        }
+    }
+
+    _is_ht_eos = (_hash_map_variant.size() == 0);
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                  \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) \
+            _it_hash = _hash_map_variant.NAME->hash_map.begin();
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    return Status::OK();
+}
+
+vectorized::ChunkPtr Aggregator::_create_spill_prototype() {
+    auto chunk = std::make_shared<vectorized::Chunk>();
+    SlotId slot_id = 0;
+    for (auto& column : _create_group_by_columns()) {
+        chunk->append_column(std::move(column), slot_id++);
+    }
+    for (auto& column : _create_agg_intermediate_columns()) {
+        chunk->append_column(std::move(column), slot_id++);
+    }
+    return chunk;
+}
+
+Status Aggregator::_spill_partial_states(const vectorized::Columns& group_by_columns,
+                                         const vectorized::Columns& agg_columns) {
+    auto chunk = std::make_shared<vectorized::Chunk>();
+    SlotId slot_id = 0;
+    for (const auto& column : group_by_columns) {
+        chunk->append_column(column, slot_id++);
+    }
+    for (const auto& column : agg_columns) {
+        chunk->append_column(column, slot_id++);
+    }
+    return _spiller->append(chunk, group_by_columns);
+}
+
+void Aggregator::_merge_spilled_chunk(const vectorized::ChunkPtr& chunk) {
+    const size_t chunk_size = chunk->num_rows();
+    const size_t group_by_size = _group_by_columns.size();
+    for (size_t i = 0; i < group_by_size; i++) {
+        _group_by_columns[i] = chunk->get_column_by_index(i);
+    }
+
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                                \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) {                             \
+        build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, chunk_size); \
+    }
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+
+    // The spilled columns are always partial states, so merge them whatever the phase is.
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
+                                       chunk->get_column_by_index(group_by_size + i).get(), _tmp_agg_states.data());
+    }
+}
+
+void Aggregator::_reset_hash_map() {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                                       \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) {                                    \
+        _release_agg_memory<decltype(_hash_map_variant.NAME)::element_type>(_hash_map_variant.NAME.get());          \
+        _release_null_key_agg_memory<decltype(_hash_map_variant.NAME)::element_type>(_hash_map_variant.NAME.get()); \
+    }
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+
+    _mem_pool->free_all();
+    _init_agg_hash_variant(_hash_map_variant);
+    _mem_tracker->set(_hash_map_variant.memory_usage() + _mem_pool->total_reserved_bytes());
+}
+
 // When need finalize, create column by result type
 // otherwise, create column by serde type
 vectorized::Columns Aggregator::_create_agg_result_columns() {
+    if (!_needs_finalize) {
+        return _create_agg_intermediate_columns();
+    }
     vectorized::Columns agg_result_columns(_agg_fn_types.size());
-    if (_needs_finalize) {
-        for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
-            // For count, count distinct, bitmap_union_int such as never return null function,
-            // we need to create a not-nullable column.
-            agg_result_columns[i] = vectorized::ColumnHelper::create_column(
-                    _agg_fn_types[i].result_type, _agg_fn_types[i].has_nullable_child & _agg_fn_types[i].is_nullable);
-            agg_result_columns[i]->reserve(_state->chunk_size());
-        }
-    } else {
-        for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
-            agg_result_columns[i] = vectorized::ColumnHelper::create_column(_agg_fn_types[i].serde_type,
-                                                                            _agg_fn_types[i].has_nullable_child);
-            agg_result_columns[i]->reserve(_state->chunk_size());
-        }
+    for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
+        // For count, count distinct, bitmap_union_int such as never return null function,
+        // we need to create a not-nullable column.
+        agg_result_columns[i] = vectorized::ColumnHelper::create_column(
+                _agg_fn_types[i].result_type, _agg_fn_types[i].has_nullable_child & _agg_fn_types[i].is_nullable);
+        agg_result_columns[i]->reserve(_state->chunk_size());
     }
     return agg_result_columns;
 }
 
+vectorized::Columns Aggregator::_create_agg_intermediate_columns() {
+    vectorized::Columns agg_columns(_agg_fn_types.size());
+    for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
+        agg_columns[i] = vectorized::ColumnHelper::create_column(_agg_fn_types[i].serde_type,
+                                                                 _agg_fn_types[i].has_nullable_child);
+        agg_columns[i]->reserve(_state->chunk_size());
+    }
+    return agg_columns;
+}
+
 vectorized::Columns Aggregator::_create_group_by_columns() {
     vectorized::Columns group_by_columns(_group_by_types.size());
     for (size_t i = 0; i < _group_by_types.size(); ++i) {
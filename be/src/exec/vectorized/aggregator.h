@@ -12,6 +12,7 @@
 #include "column/vectorized_fwd.h"
 #include "exec/pipeline/context_with_dependency.h"
 #include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/spill_file.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/expr.h"
 #include "gutil/strings/substitute.h"
@@ -111,6 +112,14 @@ public:
     bool should_expand_preagg_hash_tables(size_t prev_row_returned, size_t input_chunk_size, int64_t ht_mem,
                                           int64_t ht_rows) const;
 
+    // Once the pre-aggregation hash table is full, each chunk only probes the hash table for existing groups
+    // and passes through the other rows. If few rows hit for several chunks, the probing costs for nothing,
+    // so the chunks are passed through without probing for a while, and then one chunk is probed again to
+    // re-measure. The interval doubles while the hits stay poor, and resets once they become good enough.
+    bool should_pass_through_preagg();
+    // Feed back the number of rows of the probed chunk, and the number of them hit the hash table.
+    void update_preagg_hit_rows(size_t num_rows, size_t num_hit_rows);
+
     // For aggregate without group by
     void compute_single_agg_state(size_t chunk_size);
     // For aggregate with group by
@@ -139,13 +148,34 @@ public:
     void try_convert_to_two_level_map();
     void try_convert_to_two_level_set();
 
+    // Spill is only supported by the blocking aggregation with group by columns and
+    // aggregate functions. When it's enabled, the hash map will be hash partitioned and
+    // written to disk as serialized partial states once its memory exceeds the threshold,
+    // and merged back partition by partition after all the input has been consumed.
+    void enable_spill();
+    bool has_spilled() const { return _spiller != nullptr && _spiller->spilled_rows() > 0; }
+    // Spill the hash map if its memory exceeds the threshold.
+    Status try_spill_hash_map();
+    // Whether the hash map must be (re)loaded from the spilled partitions before output.
+    bool need_restore_spilled_partition() const {
+        return has_spilled() &&
+               (!_is_spill_finished || (_is_ht_eos && _next_restore_partition < _spiller->num_partitions()));
+    }
+    // Load the next non-empty spilled partition into the hash map, and set the iterator
+    // of hash map to its beginning.
+    Status restore_next_spilled_partition();
+
 #ifdef NDEBUG
     static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
     static constexpr size_t streaming_hash_table_size_threshold = 10000000;
+    static constexpr size_t poor_hit_chunks_to_pass_through = 3;
 #else
     static constexpr size_t two_level_memory_threshold = 64;
     static constexpr size_t streaming_hash_table_size_threshold = 4;
+    static constexpr size_t poor_hit_chunks_to_pass_through = 1;
 #endif
+    static constexpr size_t min_pass_through_interval = 4;
+    static constexpr size_t max_pass_through_interval = 256;
 
 private:
     bool _is_closed = false;
@@ -184,6 +214,11 @@ private:
     bool _has_nullable_key = false;
     int64_t _num_input_rows = 0;
     int64_t _num_pass_through_rows = 0;
+    // Consecutive probed chunks with poor hits, the current interval to pass through the chunks without probing,
+    // and the chunks left to pass through in it.
+    size_t _num_poor_hit_chunks = 0;
+    size_t _pass_through_interval = 0;
+    size_t _num_pass_through_chunks = 0;
 
     TStreamingPreaggregationMode::type _streaming_preaggregation_mode;
 
@@ -250,6 +285,16 @@ private:
     RuntimeProfile::Counter* _expr_compute_timer{};
     RuntimeProfile::Counter* _expr_release_timer{};
 
+    // only used by spillable blocking aggregation
+    std::unique_ptr<vectorized::PartitionedSpiller> _spiller;
+    int64_t _spill_mem_threshold = 0;
+    bool _is_spill_finished = false;
+    size_t _next_restore_partition = 0;
+    RuntimeProfile::Counter* _spill_timer{};
+    RuntimeProfile::Counter* _restore_timer{};
+    RuntimeProfile::Counter* _spilled_rows_counter{};
+    RuntimeProfile::Counter* _spilled_bytes_counter{};
+
 public:
     template <typename HashMapWithKey>
     void build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size, bool agg_group_by_with_limit = false) {
@@ -462,6 +507,7 @@ private:
 
     // Create new aggregate function result column by type
     vectorized::Columns _create_agg_result_columns();
+    vectorized::Columns _create_agg_intermediate_columns();
     vectorized::Columns _create_group_by_columns();
 
     void _serialize_to_chunk(vectorized::ConstAggDataPtr __restrict state,
@@ -476,6 +522,68 @@ private:
     template <typename HashVariantType>
     void _init_agg_hash_variant(HashVariantType& hash_variant);
 
+    // The layout of a spilled chunk: group by columns followed by the serialized agg states.
+    vectorized::ChunkPtr _create_spill_prototype();
+    Status _spill_partial_states(const vectorized::Columns& group_by_columns, const vectorized::Columns& agg_columns);
+    Status _spill_hash_map();
+    Status _finish_spill();
+    void _merge_spilled_chunk(const vectorized::ChunkPtr& chunk);
+    // Destroy all the agg states and make the hash map empty.
+    void _reset_hash_map();
+
+    template <typename HashMapWithKey>
+    Status _spill_hash_map_with_key(HashMapWithKey& hash_map_with_key) {
+        using Iterator = typename HashMapWithKey::Iterator;
+        Iterator it = hash_map_with_key.hash_map.begin();
+        Iterator end = hash_map_with_key.hash_map.end();
+        const int32_t chunk_size = _state->chunk_size();
+
+        while (it != end) {
+            vectorized::Columns group_by_columns = _create_group_by_columns();
+            vectorized::Columns agg_columns = _create_agg_intermediate_columns();
+            int32_t read_index = 0;
+            hash_map_with_key.results.resize(chunk_size);
+            while ((it != end) & (read_index < chunk_size)) {
+                hash_map_with_key.results[read_index] = it->first;
+                _tmp_agg_states[read_index] = it->second;
+                ++read_index;
+                ++it;
+            }
+            hash_map_with_key.insert_keys_to_columns(hash_map_with_key.results, group_by_columns, read_index);
+            for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                _agg_functions[i]->batch_serialize(_agg_fn_ctxs[i], read_index, _tmp_agg_states,
+                                                   _agg_states_offsets[i], agg_columns[i].get());
+            }
+            RETURN_IF_ERROR(_spill_partial_states(group_by_columns, agg_columns));
+        }
+
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (hash_map_with_key.null_key_data != nullptr) {
+                vectorized::Columns group_by_columns = _create_group_by_columns();
+                vectorized::Columns agg_columns = _create_agg_intermediate_columns();
+                DCHECK(group_by_columns.size() == 1);
+                DCHECK(group_by_columns[0]->is_nullable());
+                group_by_columns[0]->append_default();
+                _serialize_to_chunk(hash_map_with_key.null_key_data, agg_columns);
+                RETURN_IF_ERROR(_spill_partial_states(group_by_columns, agg_columns));
+            }
+        }
+        return Status::OK();
+    }
+
+    template <typename HashMapWithKey>
+    void _release_null_key_agg_memory(HashMapWithKey* hash_map_with_key) {
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (hash_map_with_key != nullptr && hash_map_with_key->null_key_data != nullptr) {
+                for (int i = 0; i < _agg_functions.size(); i++) {
+                    _agg_functions[i]->destroy(_agg_fn_ctxs[i],
+                                               hash_map_with_key->null_key_data + _agg_states_offsets[i]);
+                }
+                hash_map_with_key->null_key_data = nullptr;
+            }
+        }
+    }
+
     template <typename HashMapWithKey>
     void _release_agg_memory(HashMapWithKey* hash_map_with_key) {
         if (hash_map_with_key != nullptr) {
@@ -76,6 +76,7 @@ Analytor::Analytor(const TPlanNode& tnode, const RowDescriptor& child_row_desc,
         } else {
             frame_type = FrameType::Sliding;
             _is_range_with_start = window.__isset.window_start;
+            _is_sliding_frame = true;
         }
     }
 
@@ -184,6 +185,11 @@ Status Analytor::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile*
         }
     }
 
+    _is_sliding_frame_removable =
+            _is_sliding_frame && !_has_lead_lag_function &&
+            std::all_of(_agg_functions.begin(), _agg_functions.end(), [](auto* func) { return func->is_removable(); });
+    _sliding_frame_non_null_rows.resize(agg_size);
+
     // compute agg state total size and offsets
     for (int i = 0; i < agg_size; ++i) {
         _agg_states_offsets[i] = _agg_states_total_size;
@@ -340,6 +346,65 @@ void Analytor::update_window_batch(int64_t peer_group_start, int64_t peer_group_
     }
 }
 
+void Analytor::update_window_batch_for_sliding_frame() {
+    FrameRange range = get_sliding_frame_range();
+    if (!_is_sliding_frame_removable) {
+        reset_window_state();
+        update_window_batch(_partition_start, _partition_end, range.start, range.end);
+        return;
+    }
+
+    int64_t frame_start = std::max<int64_t>(range.start, _partition_start);
+    int64_t frame_end = std::max<int64_t>(std::min<int64_t>(range.end, _partition_end), frame_start);
+    int64_t last_start = _last_sliding_frame.start - _removed_from_buffer_rows;
+    int64_t last_end = _last_sliding_frame.end - _removed_from_buffer_rows;
+    // The frames only move forward in a partition, and the partition end may grow as more input arrives.
+    bool is_incremental = _last_sliding_partition_start == get_total_position(_partition_start) &&
+                          last_start <= frame_start && frame_start <= last_end && last_end <= frame_end;
+    if (!is_incremental) {
+        reset_window_state();
+        last_start = frame_start;
+        last_end = frame_start;
+        std::fill(_sliding_frame_non_null_rows.begin(), _sliding_frame_non_null_rows.end(), 0);
+    }
+
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        const vectorized::Column* agg_column = _agg_intput_columns[i][0].get();
+        vectorized::AggDataPtr state = _managed_fn_states[0]->mutable_data() + _agg_states_offsets[i];
+        if (last_end < frame_end) {
+            _agg_functions[i]->update_batch_single_state(_agg_fn_ctxs[i], state, &agg_column, _partition_start,
+                                                         _partition_end, last_end, frame_end);
+            _sliding_frame_non_null_rows[i] += _count_non_null_rows(agg_column, last_end, frame_end);
+        }
+        if (last_start < frame_start) {
+            _agg_functions[i]->remove_batch_single_state(_agg_fn_ctxs[i], state, &agg_column, last_start,
+                                                         frame_start);
+            _sliding_frame_non_null_rows[i] -= _count_non_null_rows(agg_column, last_start, frame_start);
+        }
+        // Same as the state only updated by null rows.
+        if (_sliding_frame_non_null_rows[i] == 0) {
+            _agg_functions[i]->reset(_agg_fn_ctxs[i], _agg_intput_columns[i], state);
+        }
+    }
+
+    _last_sliding_partition_start = get_total_position(_partition_start);
+    _last_sliding_frame = {get_total_position(frame_start), get_total_position(frame_end)};
+}
+
+int64_t Analytor::_count_non_null_rows(const vectorized::Column* column, int64_t start, int64_t end) {
+    // The input column of count(*) is null.
+    if (column == nullptr || !column->has_null()) {
+        return end - start;
+    }
+    const auto* nullable_column = down_cast<const vectorized::NullableColumn*>(column);
+    const uint8_t* null_data = nullable_column->immutable_null_column_data().data();
+    int64_t count = 0;
+    for (int64_t i = start; i < end; i++) {
+        count += !null_data[i];
+    }
+    return count;
+}
+
 void Analytor::reset_window_state() {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         _agg_functions[i]->reset(_agg_fn_ctxs[i], _agg_intput_columns[i],
@@ -98,6 +98,10 @@ public:
     FrameRange get_sliding_frame_range();
 
     void update_window_batch(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start, int64_t frame_end);
+    // Update the window state to the sliding frame of the current row. If all the window functions are removable,
+    // the state of the last frame in the same partition is reused: the rows entering the frame are updated and the
+    // rows leaving it are removed, instead of updating the whole frame again.
+    void update_window_batch_for_sliding_frame();
     void reset_window_state();
     void get_window_function_result(int32_t start, int32_t end);
 
@@ -147,6 +151,13 @@ private:
     int64_t _limit; // -1: no limit
     bool _has_lead_lag_function = false;
     bool _is_range_with_start = false;
+    bool _is_sliding_frame = false;
+    bool _is_sliding_frame_removable = false;
+    // The last sliding frame updated into the window state and the start of its partition, in total positions.
+    int64_t _last_sliding_partition_start = -1;
+    FrameRange _last_sliding_frame{0, 0};
+    // The non-null input rows in the last sliding frame of each window function.
+    std::vector<int64_t> _sliding_frame_non_null_rows;
 
     vectorized::Columns _result_window_columns;
     std::vector<vectorized::ChunkPtr> _input_chunks;
@@ -204,6 +215,7 @@ private:
                                        int64_t frame_end);
 
     int64_t _find_first_not_equal(vectorized::Column* column, int64_t start, int64_t end);
+    static int64_t _count_non_null_rows(const vectorized::Column* column, int64_t start, int64_t end);
 };
 
 // Helper class that properly invokes destructor when state goes out of scope.
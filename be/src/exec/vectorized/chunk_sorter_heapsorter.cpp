@@ -94,6 +94,11 @@ Status HeapChunkSorter::update(RuntimeState* state, const ChunkPtr& chunk) {
             }
         }
     }
+    if (_runtime_topn_threshold != nullptr && _sort_heap->size() == _number_of_rows_to_sort()) {
+        // The top of the heap is the k-th row so far.
+        const auto& top = _sort_heap->top();
+        _runtime_topn_threshold->update(top.data_segment()->order_by_columns[0]->get(top.row_id()));
+    }
     // TODO: merge chunk if necessary
     return Status::OK();
 }
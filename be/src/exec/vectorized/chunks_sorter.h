@@ -5,6 +5,7 @@
 #include "column/vectorized_fwd.h"
 #include "exec/sort_exec_exprs.h"
 #include "exprs/expr_context.h"
+#include "exprs/vectorized/runtime_topn_threshold.h"
 #include "runtime/descriptors.h"
 #include "util/runtime_profile.h"
 
@@ -312,6 +313,26 @@ public:
 
     virtual int64_t mem_usage() const = 0;
 
+    // Allow the sorter to spill sorted runs to disk when it runs out of the memory budget,
+    // |profile| is used to record the spill counters. Sorters not supporting spill ignore it.
+    virtual void enable_spill(RuntimeProfile* profile) {}
+
+    virtual bool has_spilled() const { return false; }
+
+    // After done(), a spilled sorter holds several sorted runs, which should be merged by the caller.
+    // Only valid when has_spilled() is true.
+    virtual size_t num_sorted_runs() const { return 0; }
+    // Get the next chunk of the |run|-th sorted run, nullptr means the run is exhausted.
+    virtual Status get_next_from_sorted_run(size_t run, ChunkPtr* chunk) {
+        return Status::NotSupported("sorted runs are not supported by this sorter");
+    }
+
+    const std::vector<ExprContext*>* sort_exprs() const { return _sort_exprs; }
+
+    // Let a TopN sorter publish the k-th value of the first order-by column to |threshold| while consuming the
+    // input. The other sorters ignore it.
+    void set_runtime_topn_threshold(RuntimeTopnThreshold* threshold) { _runtime_topn_threshold = threshold; }
+
 protected:
     inline size_t _get_number_of_order_by_columns() const { return _sort_exprs->size(); }
 
@@ -332,6 +353,8 @@ protected:
     RuntimeProfile::Counter* _output_timer = nullptr;
 
     std::atomic<bool> _is_sink_complete = false;
+
+    RuntimeTopnThreshold* _runtime_topn_threshold = nullptr;
 };
 
 } // namespace starrocks::vectorized
@@ -8,6 +8,7 @@
 #include "runtime/primitive_type_infra.h"
 #include "runtime/runtime_state.h"
 #include "util/orlp/pdqsort.h"
+#include "util/radix_sort.h"
 #include "util/stopwatch.hpp"
 
 namespace starrocks::vectorized {
@@ -188,6 +189,69 @@ private:
         return Status::OK();
     }
 
+    // The integers, dates and datetimes are sorted by radix, their keys are mapped to unsigned integers
+    // of the same order.
+    template <typename CppTypeName>
+    static constexpr bool support_radix_sort =
+            (std::is_integral_v<CppTypeName> && !std::is_same_v<CppTypeName, bool> && sizeof(CppTypeName) <= 8) ||
+            std::is_same_v<CppTypeName, DateValue> || std::is_same_v<CppTypeName, TimestampValue>;
+
+    // The radix sort does not pay off for the small ranges.
+    static constexpr size_t RADIX_SORT_MIN_ROWS = 256;
+
+    template <typename UIntKey>
+    struct RadixSortItem {
+        UIntKey key;
+        uint32_t index_in_chunk;
+    };
+
+    template <typename UIntKey>
+    struct RadixSortItemTraits {
+        using Element = RadixSortItem<UIntKey>;
+        using Key = UIntKey;
+        using CountType = uint32_t;
+        using KeyBits = UIntKey;
+        static constexpr size_t PART_SIZE_BITS = 8;
+        using Transform = RadixSortIdentityTransform<KeyBits>;
+        using Allocator = RadixSortMallocAllocator;
+        static Key& extractKey(Element& elem) { return elem.key; }
+    };
+
+    template <typename CppTypeName>
+    static auto radix_sort_key(const CppTypeName& value) {
+        if constexpr (std::is_same_v<CppTypeName, DateValue>) {
+            return radix_sort_key(value.julian());
+        } else if constexpr (std::is_same_v<CppTypeName, TimestampValue>) {
+            return radix_sort_key(value.timestamp());
+        } else if constexpr (std::is_signed_v<CppTypeName>) {
+            using KeyBits = std::make_unsigned_t<CppTypeName>;
+            return static_cast<KeyBits>(static_cast<KeyBits>(value) ^ (KeyBits(1) << (sizeof(KeyBits) * 8 - 1)));
+        } else {
+            return value;
+        }
+    }
+
+    // LSD radix sort is stable, so the equal values keep the order of the permutation, as the stable
+    // comparator sort does. The descending order sorts by the complement of the keys.
+    template <typename CppTypeName>
+    static Status radix_sort_on_not_null_fixed_size_column(RuntimeState* state, const CppTypeName* data,
+                                                           bool is_asc_order, Permutation& perm, size_t offset,
+                                                           size_t row_num) {
+        using KeyBits = decltype(radix_sort_key(std::declval<CppTypeName>()));
+        std::vector<RadixSortItem<KeyBits>> sort_items(row_num);
+        const KeyBits key_mask = is_asc_order ? KeyBits(0) : static_cast<KeyBits>(~KeyBits(0));
+        for (size_t i = 0; i < row_num; ++i) {
+            uint32_t index_in_chunk = perm[i + offset].index_in_chunk;
+            sort_items[i] = {static_cast<KeyBits>(radix_sort_key(data[index_in_chunk]) ^ key_mask), index_in_chunk};
+        }
+        RadixSort<RadixSortItemTraits<KeyBits>>::executeLSD(sort_items.data(), row_num);
+        RETURN_IF_CANCELLED(state);
+        for (size_t i = 0; i < row_num; ++i) {
+            perm[i + offset].index_in_chunk = sort_items[i].index_in_chunk;
+        }
+        return Status::OK();
+    }
+
     // Sort on some numeric column which has no NULL value in sorting range.
     // Only supports: integers, floats. Not Slice, DecimalV2Value.
     template <typename CppTypeName, bool stable>
@@ -196,6 +260,11 @@ private:
         // column->size() == perm.size()
         const size_t row_num = (count == 0 || offset + count > perm.size()) ? (perm.size() - offset) : count;
         const CppTypeName* data = static_cast<CppTypeName*>((void*)column->mutable_raw_data());
+        if constexpr (support_radix_sort<CppTypeName>) {
+            if (row_num >= RADIX_SORT_MIN_ROWS) {
+                return radix_sort_on_not_null_fixed_size_column(state, data, is_asc_order, perm, offset, row_num);
+            }
+        }
         std::vector<SortItem<CppTypeName>> sort_items(row_num);
         for (uint32_t i = 0; i < row_num; ++i) {
             sort_items[i] = {data[perm[i + offset].index_in_chunk], perm[i + offset].index_in_chunk, i};
@@ -259,6 +328,9 @@ Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk)
     _big_chunk->append(*chunk);
 
     DCHECK(!_big_chunk->has_const_column());
+    if (_spill_mem_threshold > 0 && should_spill(_big_chunk->memory_usage(), _spill_mem_threshold)) {
+        RETURN_IF_ERROR(_spill_sorted_run(state));
+    }
     return Status::OK();
 }
 
@@ -290,7 +362,7 @@ DataSegment* ChunksSorterFullSort::get_result_data_segment() {
 }
 
 uint64_t ChunksSorterFullSort::get_partition_rows() const {
-    return _sorted_permutation.size();
+    return _sorted_permutation.size() + _spilled_rows;
 }
 
 // Is used to index sorted datas.
@@ -334,6 +406,71 @@ int64_t ChunksSorterFullSort::mem_usage() const {
     return usage;
 }
 
+void ChunksSorterFullSort::enable_spill(RuntimeProfile* profile) {
+    _spill_mem_threshold = spill_mem_threshold(_state->instance_mem_tracker());
+    _spill_timer = ADD_TIMER(profile, "SpillTime");
+    _spilled_rows_counter = ADD_COUNTER(profile, "SpilledRows", TUnit::UNIT);
+    _spilled_bytes_counter = ADD_COUNTER(profile, "SpilledBytes", TUnit::BYTES);
+    _spilled_runs_counter = ADD_COUNTER(profile, "SpilledSortedRuns", TUnit::UNIT);
+}
+
+Status ChunksSorterFullSort::get_next_from_sorted_run(size_t run, ChunkPtr* chunk) {
+    DCHECK_LT(run, num_sorted_runs());
+    // The last run is the one left in memory.
+    if (run == _spilled_runs.size()) {
+        bool eos = false;
+        get_next(chunk, &eos);
+        return Status::OK();
+    }
+
+    auto& file = _spilled_runs[run];
+    if (file == nullptr) {
+        *chunk = nullptr;
+        return Status::OK();
+    }
+    auto res = file->read_next(*_spill_prototype);
+    if (res.status().is_end_of_file()) {
+        // Release the disk space as soon as the run is exhausted.
+        file.reset();
+        *chunk = nullptr;
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(res.status());
+    *chunk = std::move(res).value();
+    return Status::OK();
+}
+
+Status ChunksSorterFullSort::_spill_sorted_run(RuntimeState* state) {
+    RETURN_IF_ERROR(_sort_chunks(state));
+
+    SCOPED_TIMER(_spill_timer);
+    ASSIGN_OR_RETURN(auto file, SpillFile::create("sort"));
+    Chunk* sorted_chunk = _sorted_segment->chunk.get();
+    const size_t total_rows = _sorted_permutation.size();
+    const size_t chunk_size = state->chunk_size();
+    for (size_t offset = 0; offset < total_rows; offset += chunk_size) {
+        size_t count = std::min(chunk_size, total_rows - offset);
+        ChunkUniquePtr chunk = sorted_chunk->clone_empty(count);
+        _append_rows_to_chunk(chunk.get(), sorted_chunk, _sorted_permutation, offset, count);
+        RETURN_IF_ERROR(file->append(*chunk));
+    }
+    RETURN_IF_ERROR(file->flip_to_read());
+
+    if (_spill_prototype == nullptr) {
+        _spill_prototype = sorted_chunk->clone_empty(0);
+    }
+    _spilled_rows += total_rows;
+    COUNTER_UPDATE(_spilled_rows_counter, total_rows);
+    COUNTER_UPDATE(_spilled_bytes_counter, file->num_bytes());
+    COUNTER_UPDATE(_spilled_runs_counter, 1);
+    _spilled_runs.emplace_back(std::move(file));
+
+    // The next update() starts a new run.
+    _sorted_segment.reset();
+    Permutation().swap(_sorted_permutation);
+    return Status::OK();
+}
+
 Status ChunksSorterFullSort::_sort_chunks(RuntimeState* state) {
     // Step1: construct permutation
     RETURN_IF_ERROR(_build_sorting_data(state));
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "exec/vectorized/chunks_sorter.h"
+#include "exec/vectorized/spill_file.h"
 
 namespace starrocks {
 class ExprContext;
@@ -35,6 +36,13 @@ public:
 
     int64_t mem_usage() const override;
 
+    // When spill is enabled and the unsorted rows exceed the memory budget, they are sorted
+    // and written to disk as a sorted run. The rows left in memory at done() form the last run.
+    void enable_spill(RuntimeProfile* profile) override;
+    bool has_spilled() const override { return !_spilled_runs.empty(); }
+    size_t num_sorted_runs() const override { return _spilled_runs.size() + 1; }
+    Status get_next_from_sorted_run(size_t run, ChunkPtr* chunk) override;
+
     friend class SortHelper;
 
 private:
@@ -46,10 +54,25 @@ private:
 
     void _append_rows_to_chunk(Chunk* dest, Chunk* src, const Permutation& permutation, size_t offset, size_t count);
 
+    // Sort the rows in _big_chunk and write them to a new spill file.
+    Status _spill_sorted_run(RuntimeState* state);
+
     ChunkUniquePtr _big_chunk;
     std::unique_ptr<DataSegment> _sorted_segment;
     mutable Permutation _sorted_permutation;
     std::vector<uint32_t> _selective_values; // for appending selective values to sorted rows
+
+    // 0 means spill is disabled.
+    int64_t _spill_mem_threshold = 0;
+    std::vector<std::unique_ptr<SpillFile>> _spilled_runs;
+    // Used to build the chunks read from _spilled_runs.
+    ChunkPtr _spill_prototype;
+    uint64_t _spilled_rows = 0;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_rows_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_runs_counter = nullptr;
 };
 
 } // namespace vectorized
@@ -50,6 +50,11 @@ Status ChunksSorterTopn::update(RuntimeState* state, const ChunkPtr& chunk) {
 
     if (_limit > 0 && (chunk_number >= _limit || chunk_number >= _size_of_chunk_batch)) {
         RETURN_IF_ERROR(_sort_chunks(state));
+        const size_t rows_to_sort = _get_number_of_rows_to_sort();
+        if (_runtime_topn_threshold != nullptr && _merged_segment.chunk->num_rows() >= rows_to_sort) {
+            // |_merged_segment| is sorted, its k-th row is the k-th row so far.
+            _runtime_topn_threshold->update(_merged_segment.order_by_columns[0]->get(rows_to_sort - 1));
+        }
     }
 
     return Status::OK();
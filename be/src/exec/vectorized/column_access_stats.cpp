@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/column_access_stats.h"
+
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "storage/tablet_schema.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+static const char* predicate_form(PredicateType type) {
+    switch (type) {
+    case PredicateType::kEQ:
+        return "eq";
+    case PredicateType::kNE:
+        return "ne";
+    case PredicateType::kGT:
+    case PredicateType::kGE:
+    case PredicateType::kLT:
+    case PredicateType::kLE:
+        return "range";
+    case PredicateType::kInList:
+        return "in";
+    case PredicateType::kNotInList:
+        return "not_in";
+    case PredicateType::kIsNull:
+        return "is_null";
+    case PredicateType::kNotNull:
+        return "not_null";
+    case PredicateType::kExpr:
+        return "expr";
+    case PredicateType::kRuntimeFilter:
+        return "runtime_filter";
+    case PredicateType::kRuntimeTopn:
+        return "runtime_topn";
+    default:
+        return "other";
+    }
+}
+
+std::map<std::string, ColumnAccessStats> collect_column_access(const TabletSchema& schema,
+                                                               const std::vector<SlotDescriptor*>& slots,
+                                                               const std::vector<const ColumnPredicate*>& predicates,
+                                                               RuntimeState* state) {
+    std::map<std::string, ColumnAccessStats> accesses;
+    for (const auto* slot : slots) {
+        auto& stats = accesses[slot->col_name()];
+        stats.reads = 1;
+        if (state->is_grouping_slot(slot->id())) {
+            stats.groups = 1;
+        }
+    }
+    for (const auto* predicate : predicates) {
+        if (predicate->column_id() >= schema.num_columns()) {
+            continue;
+        }
+        auto& stats = accesses[schema.column(predicate->column_id()).name()];
+        stats.filters = 1;
+        stats.predicate_forms[predicate_form(predicate->type())]++;
+    }
+    return accesses;
+}
+
+} // namespace starrocks::vectorized
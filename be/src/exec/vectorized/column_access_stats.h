@@ -0,0 +1,30 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "storage/tablet.h"
+
+namespace starrocks {
+
+class RuntimeState;
+class SlotDescriptor;
+class TabletSchema;
+
+namespace vectorized {
+
+class ColumnPredicate;
+
+// The accesses of a scan to the columns of |schema| by the column names: the columns of |slots| are read, and
+// grouped if the aggregations of |state| group by their slots, the columns of |predicates| are filtered, including
+// by the runtime filters of the joins.
+std::map<std::string, ColumnAccessStats> collect_column_access(const TabletSchema& schema,
+                                                               const std::vector<SlotDescriptor*>& slots,
+                                                               const std::vector<const ColumnPredicate*>& predicates,
+                                                               RuntimeState* state);
+
+} // namespace vectorized
+} // namespace starrocks
@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/column_read_profile.h"
+
+#include "gen_cpp/segment.pb.h"
+#include "storage/tablet_schema.h"
+
+namespace starrocks::vectorized {
+
+void update_column_read_profile(const TabletSchema& schema, const OlapReaderStatistics& stats,
+                                RuntimeProfile* scan_profile) {
+    if (stats.column_stats.empty()) {
+        return;
+    }
+    RuntimeProfile* io_profile = scan_profile->create_child("ColumnIO");
+    for (const auto& [cid, column_stats] : stats.column_stats) {
+        if (cid >= schema.num_columns()) {
+            continue;
+        }
+        RuntimeProfile* profile = io_profile->create_child(schema.column(cid).name());
+
+        COUNTER_UPDATE(ADD_COUNTER(profile, "CompressedBytesRead", TUnit::BYTES), column_stats.compressed_bytes_read);
+        for (size_t i = 0; i < ColumnReadStatistics::kMaxEncodings; i++) {
+            int64_t bytes = column_stats.compressed_bytes_read_by_encoding[i];
+            if (bytes > 0 && EncodingTypePB_IsValid(i)) {
+                const std::string& encoding = EncodingTypePB_Name(static_cast<EncodingTypePB>(i));
+                COUNTER_UPDATE(ADD_CHILD_COUNTER(profile, encoding, TUnit::BYTES, "CompressedBytesRead"), bytes);
+            }
+        }
+        COUNTER_UPDATE(ADD_COUNTER(profile, "UncompressedBytesRead", TUnit::BYTES),
+                       column_stats.uncompressed_bytes_read);
+
+        COUNTER_UPDATE(ADD_COUNTER(profile, "ReadPagesNum", TUnit::UNIT), column_stats.total_pages_num);
+        COUNTER_UPDATE(ADD_CHILD_COUNTER(profile, "CachedPagesNum", TUnit::UNIT, "ReadPagesNum"),
+                       column_stats.cached_pages_num);
+        COUNTER_UPDATE(ADD_CHILD_COUNTER(profile, "CompressedCachedPagesNum", TUnit::UNIT, "ReadPagesNum"),
+                       column_stats.compressed_cached_pages_num);
+
+        COUNTER_UPDATE(ADD_TIMER(profile, "IOTime"), column_stats.io_ns);
+        COUNTER_UPDATE(ADD_TIMER(profile, "DecompressTime"), column_stats.decompress_ns);
+        COUNTER_UPDATE(ADD_TIMER(profile, "DecodeTime"), column_stats.decode_ns);
+
+        COUNTER_UPDATE(ADD_COUNTER(profile, "ZoneMapIndexFilterRows", TUnit::UNIT), column_stats.rows_stats_filtered);
+        COUNTER_UPDATE(ADD_COUNTER(profile, "BloomFilterFilterRows", TUnit::UNIT), column_stats.rows_bf_filtered);
+        COUNTER_UPDATE(ADD_COUNTER(profile, "BitmapIndexFilterRows", TUnit::UNIT),
+                       column_stats.rows_bitmap_index_filtered);
+    }
+}
+
+} // namespace starrocks::vectorized
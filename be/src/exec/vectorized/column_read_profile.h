@@ -0,0 +1,21 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "storage/olap_common.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+class TabletSchema;
+
+namespace vectorized {
+
+// Add the per column statistics of |stats| to the counters of |scan_profile|, in a child profile of "ColumnIO" per
+// column, so that the profile tells which columns, encodings, cache tiers and indexes the IO and the filtered rows of
+// the scan come from.
+void update_column_read_profile(const TabletSchema& schema, const OlapReaderStatistics& stats,
+                                RuntimeProfile* scan_profile);
+
+} // namespace vectorized
+} // namespace starrocks
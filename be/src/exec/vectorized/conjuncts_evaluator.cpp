@@ -0,0 +1,164 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/conjuncts_evaluator.h"
+
+#include <algorithm>
+#include <set>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "simd/simd.h"
+#include "util/time.h"
+
+namespace starrocks::vectorized {
+
+// the remaining conjuncts are evaluated on the kept rows only when no more than half of the rows are kept,
+// otherwise compacting them costs more than it saves.
+static constexpr double kCompactRatio = 0.5;
+
+AdaptiveConjunctsEvaluator::AdaptiveConjunctsEvaluator(const std::vector<ExprContext*>& ctxs) {
+    _conjuncts.reserve(ctxs.size());
+    for (ExprContext* ctx : ctxs) {
+        Conjunct conjunct;
+        conjunct.ctx = ctx;
+        ctx->root()->get_slot_ids(&conjunct.slot_ids);
+        _conjuncts.emplace_back(std::move(conjunct));
+    }
+}
+
+std::vector<ExprContext*> AdaptiveConjunctsEvaluator::order() const {
+    std::vector<ExprContext*> ctxs;
+    ctxs.reserve(_conjuncts.size());
+    for (const auto& conjunct : _conjuncts) {
+        ctxs.emplace_back(conjunct.ctx);
+    }
+    return ctxs;
+}
+
+void AdaptiveConjunctsEvaluator::_reorder() {
+    auto rank = [](const Conjunct& conjunct) {
+        // the ones never evaluated go first to be measured
+        if (conjunct.evaluated_rows == 0) {
+            return -1.0;
+        }
+        double cost_per_row = conjunct.cost_ns / conjunct.evaluated_rows;
+        double rejected = conjunct.input_rows > 0 ? 1 - conjunct.output_rows / conjunct.input_rows : 0;
+        return cost_per_row / std::max(rejected, 1e-6);
+    };
+    std::vector<double> ranks;
+    std::vector<size_t> indexes(_conjuncts.size());
+    for (size_t i = 0; i < _conjuncts.size(); i++) {
+        ranks.emplace_back(rank(_conjuncts[i]));
+        indexes[i] = i;
+    }
+    std::stable_sort(indexes.begin(), indexes.end(), [&](size_t lhs, size_t rhs) { return ranks[lhs] < ranks[rhs]; });
+
+    std::vector<Conjunct> conjuncts;
+    conjuncts.reserve(_conjuncts.size());
+    for (size_t i : indexes) {
+        auto& conjunct = _conjuncts[i];
+        // the recent chunks weigh more
+        conjunct.evaluated_rows /= 2;
+        conjunct.input_rows /= 2;
+        conjunct.output_rows /= 2;
+        conjunct.cost_ns /= 2;
+        conjuncts.emplace_back(std::move(conjunct));
+    }
+    _conjuncts = std::move(conjuncts);
+}
+
+void AdaptiveConjunctsEvaluator::evaluate(Chunk* chunk) {
+    DCHECK(chunk != nullptr);
+    if (chunk->num_rows() == 0 || _conjuncts.empty()) {
+        return;
+    }
+    if (++_num_chunks % kReorderInterval == 0) {
+        _reorder();
+    }
+
+    Column::Filter filter(chunk->num_rows(), 1);
+    size_t selected = chunk->num_rows();
+    // once compacted, the conjuncts are evaluated on `narrow`, `positions` are the rows of `chunk` in it
+    ChunkPtr narrow;
+    std::vector<uint32_t> positions;
+    Chunk* current = chunk;
+
+    for (size_t i = 0; i < _conjuncts.size(); i++) {
+        auto& conjunct = _conjuncts[i];
+        int64_t start_ns = MonotonicNanos();
+        ColumnPtr column = conjunct.ctx->evaluate(current);
+        size_t true_count = ColumnHelper::count_true_with_notnull(column);
+        size_t kept = selected;
+        if (true_count == 0) {
+            kept = 0;
+        } else if (true_count != column->size()) {
+            ColumnHelper::merge_two_filters(column, &filter, nullptr);
+            kept = SIMD::count_nonzero(filter.data(), filter.size());
+        }
+        conjunct.cost_ns += MonotonicNanos() - start_ns;
+        conjunct.evaluated_rows += current->num_rows();
+        conjunct.input_rows += selected;
+        conjunct.output_rows += kept;
+
+        if (kept == 0) {
+            chunk->set_num_rows(0);
+            return;
+        }
+        selected = kept;
+        if (i + 1 == _conjuncts.size() || selected > current->num_rows() * kCompactRatio) {
+            continue;
+        }
+
+        std::set<SlotId> slot_ids;
+        for (size_t j = i + 1; j < _conjuncts.size(); j++) {
+            for (SlotId slot_id : _conjuncts[j].slot_ids) {
+                if (chunk->is_slot_exist(slot_id)) {
+                    slot_ids.insert(slot_id);
+                }
+            }
+        }
+        if (current != chunk) {
+            current->filter(filter);
+            size_t pos = 0;
+            for (size_t j = 0; j < positions.size(); j++) {
+                positions[pos] = positions[j];
+                pos += filter[j];
+            }
+            positions.resize(pos);
+        } else if (slot_ids.empty() || slot_ids.size() >= chunk->num_columns()) {
+            // no column to save from the copy
+            chunk->filter(filter);
+        } else {
+            for (uint32_t j = 0; j < filter.size(); j++) {
+                if (filter[j]) {
+                    positions.emplace_back(j);
+                }
+            }
+            narrow = std::make_shared<Chunk>();
+            for (SlotId slot_id : slot_ids) {
+                const ColumnPtr& src = chunk->get_column_by_slot_id(slot_id);
+                ColumnPtr dst = src->clone_empty();
+                dst->append_selective(*src, positions);
+                narrow->append_column(std::move(dst), slot_id);
+            }
+            current = narrow.get();
+        }
+        filter.assign(selected, 1);
+    }
+
+    if (current == chunk) {
+        if (selected < chunk->num_rows()) {
+            chunk->filter(filter);
+        }
+        return;
+    }
+    Column::Filter chunk_filter(chunk->num_rows(), 0);
+    for (size_t j = 0; j < positions.size(); j++) {
+        chunk_filter[positions[j]] = filter[j];
+    }
+    chunk->filter(chunk_filter);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,55 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/global_types.h"
+
+namespace starrocks {
+
+class ExprContext;
+
+namespace vectorized {
+
+// AdaptiveConjunctsEvaluator filters the chunks by a list of conjuncts like ExecNode::eval_conjuncts(),
+// but a conjunct evaluated after others only sees the rows they kept:
+// - once the rows kept so far are few enough, the columns the remaining conjuncts refer to are compacted
+//   into a narrow chunk of the kept rows, and the remaining conjuncts are evaluated on it.
+// - the cost per row and the selectivity of each conjunct are measured, and every kReorderInterval chunks
+//   the conjuncts are reordered by cost / (1 - selectivity), so that the cheap conjuncts rejecting many
+//   rows run first.
+//
+// It keeps per-instance statistics, so it must not be shared by the threads.
+class AdaptiveConjunctsEvaluator {
+public:
+    static constexpr size_t kReorderInterval = 16;
+
+    explicit AdaptiveConjunctsEvaluator(const std::vector<ExprContext*>& ctxs);
+
+    void evaluate(Chunk* chunk);
+
+    // The conjuncts in the order they are evaluated now.
+    std::vector<ExprContext*> order() const;
+
+private:
+    struct Conjunct {
+        ExprContext* ctx;
+        std::vector<SlotId> slot_ids;
+        // the rows it's evaluated on, the rows kept before and after it and the time spent, decayed on
+        // every reordering
+        double evaluated_rows = 0;
+        double input_rows = 0;
+        double output_rows = 0;
+        double cost_ns = 0;
+    };
+
+    void _reorder();
+
+    std::vector<Conjunct> _conjuncts;
+    size_t _num_chunks = 0;
+};
+
+} // namespace vectorized
+} // namespace starrocks
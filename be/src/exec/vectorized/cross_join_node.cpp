@@ -552,6 +552,8 @@ pipeline::OpFactories CrossJoinNode::decompose_to_pipeline(pipeline::PipelineBui
     // communication with CrossJoinLeft through shared_datas.
     auto* right_source = down_cast<SourceOperatorFactory*>(right_ops[0].get());
     auto cross_join_context = std::make_shared<pipeline::CrossJoinContext>(right_source->degree_of_parallelism());
+    cross_join_context->set_range_join_key(
+            pipeline::RangeJoinKey::create(_conjunct_ctxs, child(0)->row_desc(), child(1)->row_desc()));
 
     // cross_join_right as sink operator
     auto right_factory =
@@ -2,15 +2,24 @@
 
 #include "exec/vectorized/csv_scanner.h"
 
+#include <algorithm>
+
 #include "column/column_helper.h"
 #include "column/hash_set.h"
+#include "common/config.h"
 #include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_state.h"
+#include "util/threadpool.h"
 #include "util/utf8_check.h"
 
 namespace starrocks::vectorized {
 
+// Only the first few filtered rows are reported to the error log.
+static constexpr int64_t kMaxErrorRows = 50;
+// Smaller batches are not worth the scheduling.
+static constexpr size_t kMinRecordsPerBatch = 512;
+
 Status CSVScanner::ScannerCSVReader::_fill_buffer() {
     SCOPED_RAW_TIMER(&_counter->file_read_ns);
 
@@ -50,6 +59,8 @@ CSVScanner::CSVScanner(RuntimeState* state, RuntimeProfile* profile, const TBrok
     }
 }
 
+CSVScanner::~CSVScanner() = default;
+
 Status CSVScanner::open() {
     RETURN_IF_ERROR(FileScanner::open());
 
@@ -103,6 +114,17 @@ Status CSVScanner::open() {
         _converters.emplace_back(std::move(conv));
     }
 
+    // The broker loads are split into many ranges and scanned in parallel already, while a stream load is
+    // a single file read by a single scanner.
+    bool is_stream = std::any_of(_scan_range.ranges.begin(), _scan_range.ranges.end(),
+                                 [](const TBrokerRangeDesc& rng) { return rng.file_type == TFileType::FILE_STREAM; });
+    if (is_stream && config::streaming_load_csv_parse_threads > 1) {
+        RETURN_IF_ERROR(ThreadPoolBuilder("csv_parse")
+                                .set_min_threads(0)
+                                .set_max_threads(config::streaming_load_csv_parse_threads)
+                                .build(&_parse_pool));
+    }
+
     return Status::OK();
 }
 
@@ -142,7 +164,7 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
         }
 
         src_chunk->set_num_rows(0);
-        Status status = _parse_csv(src_chunk.get());
+        Status status = _parse_pool != nullptr ? _parse_csv_parallel(src_chunk.get()) : _parse_csv(src_chunk.get());
         if (status.is_end_of_file()) {
             _curr_reader = nullptr;
             DCHECK_EQ(0, src_chunk->num_rows());
@@ -163,6 +185,7 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
     Status status;
     CSVReader::Record record;
     CSVReader::Fields fields;
+    std::string error_msg;
 
     int num_columns = chunk->num_columns();
     _column_raw_ptrs.resize(num_columns);
@@ -170,8 +193,6 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
         _column_raw_ptrs[i] = chunk->get_column_by_index(i).get();
     }
 
-    csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
-
     for (size_t num_rows = chunk->num_rows(); num_rows < capacity; /**/) {
         status = _curr_reader->next_record(&record);
         if (status.is_end_of_file()) {
@@ -183,52 +204,165 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
             continue;
         }
 
-        fields.clear();
-        _curr_reader->split_record(record, &fields);
+        std::string* error = _counter->num_rows_filtered < kMaxErrorRows ? &error_msg : nullptr;
+        bool ok = false;
+        {
+            SCOPED_RAW_TIMER(&_counter->fill_ns);
+            ok = _parse_record(record, chunk, num_rows, _column_raw_ptrs, &fields, error);
+        }
+        if (ok) {
+            num_rows++;
+        } else if (_counter->num_rows_filtered++ < kMaxErrorRows) {
+            _report_error(record.to_string(), error_msg);
+        }
+    }
+    return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
+}
 
-        if (fields.size() != _num_fields_in_csv) {
-            if (_counter->num_rows_filtered++ < 50) {
-                std::stringstream error_msg;
-                error_msg << "Value count does not match column count. "
-                          << "Expect " << _num_fields_in_csv << ", but got " << fields.size();
-                _report_error(record.to_string(), error_msg.str());
+Status CSVScanner::_parse_csv_parallel(Chunk* chunk) {
+    const size_t capacity = _state->chunk_size();
+    DCHECK_EQ(0, chunk->num_rows());
+
+    bool eof = false;
+    // All the records read may be filtered out, keep reading until some row is parsed.
+    while (!eof && chunk->num_rows() == 0) {
+        // next_record() reuses the buffer of the reader, copy the records out before parsing them.
+        _records_data.clear();
+        _record_ends.clear();
+        CSVReader::Record record;
+        while (_record_ends.size() < capacity) {
+            Status status = _curr_reader->next_record(&record);
+            if (status.is_end_of_file()) {
+                eof = true;
+                break;
+            } else if (!status.ok()) {
+                return status;
+            } else if (record.empty()) {
+                // always skip blank lines.
+                continue;
             }
-            continue;
+            _records_data.append(record.data, record.size);
+            _record_ends.push_back(_records_data.size());
         }
-        if (!validate_utf8(record.data, record.size)) {
-            if (_counter->num_rows_filtered++ < 50) {
-                _report_error(record.to_string(), "Invalid UTF-8 row");
-            }
-            continue;
+        if (_record_ends.empty()) {
+            break;
         }
 
         SCOPED_RAW_TIMER(&_counter->fill_ns);
-        bool has_error = false;
-        for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
-            auto slot = _src_slot_descriptors[j];
-            if (slot == nullptr) {
-                continue;
+        const size_t num_records = _record_ends.size();
+        const size_t num_batches = std::min<size_t>(config::streaming_load_csv_parse_threads,
+                                                    std::max<size_t>(1, num_records / kMinRecordsPerBatch));
+        const size_t batch_size = (num_records + num_batches - 1) / num_batches;
+        _parse_batches.resize(num_batches);
+        for (size_t i = 0; i < num_batches; i++) {
+            auto& batch = _parse_batches[i];
+            if (batch.chunk == nullptr) {
+                batch.chunk = _create_chunk(_src_slot_descriptors);
+                batch.columns.resize(batch.chunk->num_columns());
+                for (size_t j = 0; j < batch.columns.size(); j++) {
+                    batch.columns[j] = batch.chunk->get_column_by_index(j).get();
+                }
+            }
+            batch.chunk->set_num_rows(0);
+            batch.begin = std::min(num_records, i * batch_size);
+            batch.end = std::min(num_records, batch.begin + batch_size);
+            batch.num_rows_filtered = 0;
+            batch.errors.clear();
+        }
+        // The first batch is parsed by the scanner thread itself.
+        for (size_t i = 1; i < num_batches; i++) {
+            auto* batch = &_parse_batches[i];
+            Status st = _parse_pool->submit_func([this, batch] { _parse_batch(batch); });
+            if (!st.ok()) {
+                _parse_batch(batch);
             }
-            const Slice& field = fields[j];
-            options.type_desc = &(slot->type());
-            if (!_converters[k]->read_string(_column_raw_ptrs[k], field, options)) {
-                chunk->set_num_rows(num_rows);
-                if (_counter->num_rows_filtered++ < 50) {
-                    std::stringstream error_msg;
-                    error_msg << "Value '" << field.to_string() << "' is out of range. "
-                              << "The type of '" << slot->col_name() << "' is " << slot->type().debug_string();
-                    _report_error(record.to_string(), error_msg.str());
+        }
+        _parse_batch(&_parse_batches[0]);
+        _parse_pool->wait();
+
+        // Keep the order of the records and of the reported errors.
+        for (size_t i = 0; i < num_batches; i++) {
+            auto& batch = _parse_batches[i];
+            chunk->append(*batch.chunk);
+            for (const auto& [index, error] : batch.errors) {
+                if (_counter->num_rows_filtered++ < kMaxErrorRows) {
+                    _report_error(_record(index).to_string(), error);
                 }
-                has_error = true;
-                break;
             }
-            k++;
+            _counter->num_rows_filtered += batch.num_rows_filtered - static_cast<int64_t>(batch.errors.size());
         }
-        num_rows += !has_error;
     }
     return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
 }
 
+void CSVScanner::_parse_batch(ParseBatch* batch) const {
+    CSVReader::Fields fields;
+    std::string error_msg;
+    size_t num_rows = 0;
+    for (size_t i = batch->begin; i < batch->end; i++) {
+        bool want_error = batch->errors.size() < kMaxErrorRows;
+        if (_parse_record(_record(i), batch->chunk.get(), num_rows, batch->columns, &fields,
+                          want_error ? &error_msg : nullptr)) {
+            num_rows++;
+            continue;
+        }
+        batch->num_rows_filtered++;
+        if (want_error) {
+            batch->errors.emplace_back(i, std::move(error_msg));
+        }
+    }
+}
+
+bool CSVScanner::_parse_record(const CSVReader::Record& record, Chunk* chunk, size_t num_rows,
+                               const std::vector<Column*>& columns, CSVReader::Fields* fields,
+                               std::string* error) const {
+    fields->clear();
+    _curr_reader->split_record(record, fields);
+
+    if (fields->size() != _num_fields_in_csv) {
+        if (error != nullptr) {
+            std::stringstream error_msg;
+            error_msg << "Value count does not match column count. "
+                      << "Expect " << _num_fields_in_csv << ", but got " << fields->size();
+            *error = error_msg.str();
+        }
+        return false;
+    }
+    if (!validate_utf8(record.data, record.size)) {
+        if (error != nullptr) {
+            *error = "Invalid UTF-8 row";
+        }
+        return false;
+    }
+
+    csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
+    for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
+        auto slot = _src_slot_descriptors[j];
+        if (slot == nullptr) {
+            continue;
+        }
+        const Slice& field = (*fields)[j];
+        options.type_desc = &(slot->type());
+        if (!_converters[k]->read_string(columns[k], field, options)) {
+            chunk->set_num_rows(num_rows);
+            if (error != nullptr) {
+                std::stringstream error_msg;
+                error_msg << "Value '" << field.to_string() << "' is out of range. "
+                          << "The type of '" << slot->col_name() << "' is " << slot->type().debug_string();
+                *error = error_msg.str();
+            }
+            return false;
+        }
+        k++;
+    }
+    return true;
+}
+
+CSVReader::Record CSVScanner::_record(size_t index) const {
+    size_t begin = index == 0 ? 0 : _record_ends[index - 1];
+    return {_records_data.data() + begin, _record_ends[index] - begin};
+}
+
 ChunkPtr CSVScanner::_create_chunk(const std::vector<SlotDescriptor*>& slots) {
     SCOPED_RAW_TIMER(&_counter->init_chunk_ns);
 
@@ -14,6 +14,7 @@
 
 namespace starrocks {
 class SequentialFile;
+class ThreadPool;
 }
 
 namespace starrocks::vectorized {
@@ -22,6 +23,7 @@ class CSVScanner final : public FileScanner {
 public:
     CSVScanner(RuntimeState* state, RuntimeProfile* profile, const TBrokerScanRange& scan_range,
                ScannerCounter* counter);
+    ~CSVScanner() override;
 
     Status open() override;
 
@@ -48,7 +50,26 @@ private:
 
     ChunkPtr _create_chunk(const std::vector<SlotDescriptor*>& slots);
 
+    // The records of a chunk parsed by the same task of _parse_pool.
+    struct ParseBatch {
+        ChunkPtr chunk;
+        std::vector<Column*> columns;
+        // [begin, end) of the records in _records_data
+        size_t begin = 0;
+        size_t end = 0;
+        int64_t num_rows_filtered = 0;
+        // the index of the filtered record and the error
+        std::vector<std::pair<size_t, std::string>> errors;
+    };
+
     Status _parse_csv(Chunk* chunk);
+    Status _parse_csv_parallel(Chunk* chunk);
+    void _parse_batch(ParseBatch* batch) const;
+    // Appends |record| to the |num_rows| rows of |chunk|. Returns false if the record is filtered out, and sets
+    // |error| if it's not null.
+    bool _parse_record(const CSVReader::Record& record, Chunk* chunk, size_t num_rows,
+                       const std::vector<Column*>& columns, CSVReader::Fields* fields, std::string* error) const;
+    CSVReader::Record _record(size_t index) const;
     ChunkPtr _materialize(ChunkPtr& src_chunk);
     void _report_error(const std::string& line, const std::string& err_msg);
 
@@ -63,6 +84,13 @@ private:
     int _curr_file_index = -1;
     CSVReaderPtr _curr_reader;
     std::vector<ConverterPtr> _converters;
+
+    // Only created for the stream loads, whose single file would be parsed by one thread otherwise.
+    std::unique_ptr<ThreadPool> _parse_pool;
+    // the records read by _parse_csv_parallel(), copied out of the reader's buffer
+    std::string _records_data;
+    std::vector<size_t> _record_ends;
+    std::vector<ParseBatch> _parse_batches;
 };
 
 } // namespace starrocks::vectorized
@@ -141,9 +141,10 @@ Status ScrollParser::parse(const std::string& scroll_result, bool exactly_once)
     if (!inner_hits_node.IsArray()) {
         return Status::OK();
     }
-    _inner_hits_node.CopyFrom(inner_hits_node, _document_node.GetAllocator());
+    // points into the document, which is kept until the next parse
+    _inner_hits_node = &inner_hits_node;
     // how many documents contains in this batch
-    _size = _inner_hits_node.Size();
+    _size = _inner_hits_node->Size();
 
     return Status::OK();
 }
@@ -156,93 +157,91 @@ Status ScrollParser::fill_chunk(RuntimeState* state, ChunkPtr* chunk, bool* line
     *line_eos = false;
 
     *chunk = std::make_shared<Chunk>();
-    std::vector<SlotDescriptor*> slot_descs = _tuple_desc->slots();
+    size_t left_sz = _size - _cur_line;
+    size_t fill_sz = std::min(left_sz, (size_t)state->chunk_size());
 
-    // init column information
-    for (auto& slot_desc : slot_descs) {
+    // fill the chunk column by column, so the name of a column is resolved once for all the rows
+    for (auto* slot_desc : _tuple_desc->slots()) {
         ColumnPtr column = ColumnHelper::create_column(slot_desc->type(), slot_desc->is_nullable());
+        column->reserve(fill_sz);
+        // because the fe planner filter the non_materialize column
+        if (slot_desc->is_materialized()) {
+            RETURN_IF_ERROR(_fill_column(slot_desc, column.get(), fill_sz));
+        }
         (*chunk)->append_column(std::move(column), slot_desc->id());
     }
+    _cur_line += fill_sz;
+    return Status::OK();
+}
 
-    size_t left_sz = _size - _cur_line;
-    size_t fill_sz = std::min(left_sz, (size_t)state->chunk_size());
-
-    auto slots = _tuple_desc->slots();
+Status ScrollParser::_fill_column(const SlotDescriptor* slot_desc, Column* column, size_t fill_sz) {
+    const rapidjson::Value& hits = *_inner_hits_node;
+
+    // _id field must exists in every document, this is guaranteed by ES
+    // if _id was found in tuple, we would get `_id` value from inner-hit node
+    // json-format response would like below:
+    //    "hits": {
+    //            "hits": [
+    //                {
+    //                    "_id": "UhHNc3IB8XwmcbhBk1ES",
+    //                    "_source": {
+    //                          "k": 201,
+    //                    }
+    //                }
+    //            ]
+    //        }
+    if (slot_desc->col_name() == FIELD_ID) {
+        DCHECK(slot_desc->type().type == TYPE_CHAR || slot_desc->type().type == TYPE_VARCHAR);
+        for (size_t i = 0; i < fill_sz; ++i) {
+            const rapidjson::Value& obj = hits[_cur_line + i];
+            // actually this branch will not be reached, this is guaranteed by Doris FE.
+            if (_pure_doc_value(obj)) {
+                return Status::RuntimeError("obtain `_id` is not supported in doc_values mode");
+            }
+            const auto& _id = obj[FIELD_ID];
+            Slice slice(_id.GetString(), _id.GetStringLength());
+            _append_data<TYPE_VARCHAR>(column, slice);
+        }
+        return Status::OK();
+    }
 
-    // TODO: we could fill chunk by column rather than row
+    // if pure_doc_value enabled, docvalue_context must contains the key
+    const std::string& source_name = slot_desc->col_name();
+    const std::string* doc_value_name = &source_name;
+    if (_docvalue_context != nullptr) {
+        if (auto iter = _docvalue_context->find(source_name); iter != _docvalue_context->end()) {
+            doc_value_name = &iter->second;
+        }
+    }
+    const PrimitiveType type = slot_desc->type().type;
     for (size_t i = 0; i < fill_sz; ++i) {
-        const rapidjson::Value& obj = _inner_hits_node[_cur_line + i];
+        const rapidjson::Value& obj = hits[_cur_line + i];
         bool pure_doc_value = _pure_doc_value(obj);
         const rapidjson::Value& line = obj.HasMember(FIELD_SOURCE) ? obj[FIELD_SOURCE] : obj["fields"];
+        const std::string& col_name = pure_doc_value ? *doc_value_name : source_name;
 
-        for (size_t col_idx = 0; col_idx < slots.size(); ++col_idx) {
-            SlotDescriptor* slot_desc = slot_descs[col_idx];
-            ColumnPtr& column = (*chunk)->get_column_by_slot_id(slot_desc->id());
-
-            // because the fe planner filter the non_materialize column
-            if (!slot_desc->is_materialized()) {
-                continue;
-            }
-
-            // _id field must exists in every document, this is guaranteed by ES
-            // if _id was found in tuple, we would get `_id` value from inner-hit node
-            // json-format response would like below:
-            //    "hits": {
-            //            "hits": [
-            //                {
-            //                    "_id": "UhHNc3IB8XwmcbhBk1ES",
-            //                    "_source": {
-            //                          "k": 201,
-            //                    }
-            //                }
-            //            ]
-            //        }
-            if (slot_desc->col_name() == FIELD_ID) {
-                // actually this branch will not be reached, this is guaranteed by Doris FE.
-                if (pure_doc_value) {
-                    return Status::RuntimeError("obtain `_id` is not supported in doc_values mode");
-                }
-                PrimitiveType type = slot_desc->type().type;
-                DCHECK(type == TYPE_CHAR || type == TYPE_VARCHAR);
-
-                const auto& _id = obj[FIELD_ID];
-                Slice slice(_id.GetString(), _id.GetStringLength());
-                _append_data<TYPE_VARCHAR>(column.get(), slice);
-
-                continue;
-            }
-
-            // if pure_doc_value enabled, docvalue_context must contains the key
-            // todo: need move all `pure_docvalue` for every tuple outside fill_tuple
-            //  should check pure_docvalue for one table scan not every tuple
-            const char* col_name = pure_doc_value ? _docvalue_context->at(slot_desc->col_name()).c_str()
-                                                  : slot_desc->col_name().c_str();
-
-            auto has_col = line.HasMember(col_name);
-            if (has_col) {
-                const rapidjson::Value& col = line[col_name];
-                // doc value
-                bool is_null = (pure_doc_value && col.IsArray() && col[0].IsNull()) || col.IsNull();
-                if (!is_null) {
-                    // append value from ES to column
-                    RETURN_IF_ERROR(
-                            _append_value_from_json_val(column.get(), slot_desc->type().type, col, pure_doc_value));
-                    continue;
-                }
-                // handle null col
-                if (slot_desc->is_nullable()) {
-                    _append_null(column.get());
-                } else {
-                    return Status::DataQualityError(
-                            fmt::format("col `{}` is not null, but value from ES is null", slot_desc->col_name()));
-                }
-            } else {
-                // if don't has col in ES , append a default value
-                _append_null(column.get());
-            }
+        auto member = line.FindMember(col_name.c_str());
+        if (member == line.MemberEnd()) {
+            // if don't has col in ES , append a default value
+            _append_null(column);
+            continue;
+        }
+        const rapidjson::Value& col = member->value;
+        // doc value
+        bool is_null = (pure_doc_value && col.IsArray() && col[0].IsNull()) || col.IsNull();
+        if (!is_null) {
+            // append value from ES to column
+            RETURN_IF_ERROR(_append_value_from_json_val(column, type, col, pure_doc_value));
+            continue;
+        }
+        // handle null col
+        if (slot_desc->is_nullable()) {
+            _append_null(column);
+        } else {
+            return Status::DataQualityError(
+                    fmt::format("col `{}` is not null, but value from ES is null", slot_desc->col_name()));
         }
     }
-    _cur_line += fill_sz;
     return Status::OK();
 }
 
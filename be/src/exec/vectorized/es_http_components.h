@@ -35,6 +35,9 @@ public:
 private:
     static bool _pure_doc_value(const rapidjson::Value& obj);
 
+    // Appends the values of the column of |slot_desc| of the next |fill_sz| documents.
+    Status _fill_column(const SlotDescriptor* slot_desc, Column* column, size_t fill_sz);
+
     template <PrimitiveType type, class CppType = RunTimeCppType<type>>
     static void _append_data(Column* column, CppType& value);
 
@@ -64,7 +67,7 @@ private:
     size_t _size;
     rapidjson::SizeType _cur_line;
     rapidjson::Document _document_node;
-    rapidjson::Value _inner_hits_node;
+    const rapidjson::Value* _inner_hits_node = nullptr;
     bool _doc_value_mode;
 
     rapidjson::StringBuffer _scratch_buffer;
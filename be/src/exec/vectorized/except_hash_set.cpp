@@ -8,13 +8,27 @@
 
 namespace starrocks::vectorized {
 
+static Columns evaluate_key_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs) {
+    Columns key_columns;
+    key_columns.reserve(exprs.size());
+    for (auto* expr : exprs) {
+        key_columns.emplace_back(expr->evaluate(chunk.get()));
+    }
+    return key_columns;
+}
+
 template <typename HashSet>
 void ExceptHashSet<HashSet>::build_set(RuntimeState* state, const ChunkPtr& chunk,
                                        const std::vector<ExprContext*>& exprs, MemPool* pool) {
-    size_t chunk_size = chunk->num_rows();
+    build_set(state, evaluate_key_columns(chunk, exprs), chunk->num_rows(), pool);
+}
+
+template <typename HashSet>
+void ExceptHashSet<HashSet>::build_set(RuntimeState* state, const Columns& key_columns, size_t chunk_size,
+                                       MemPool* pool) {
     _slice_sizes.assign(state->chunk_size(), 0);
 
-    size_t cur_max_one_row_size = _get_max_serialize_size(chunk, exprs);
+    size_t cur_max_one_row_size = _get_max_serialize_size(key_columns);
     if (UNLIKELY(cur_max_one_row_size > _max_one_row_size)) {
         _max_one_row_size = cur_max_one_row_size;
         _mem_pool->clear();
@@ -22,7 +36,7 @@ void ExceptHashSet<HashSet>::build_set(RuntimeState* state, const ChunkPtr& chun
         THROW_BAD_ALLOC_IF_NULL(_buffer);
     }
 
-    _serialize_columns(chunk, exprs, chunk_size);
+    _serialize_columns(key_columns, chunk_size);
 
     for (size_t i = 0; i < chunk_size; ++i) {
         ExceptSliceFlag key(_buffer + i * _max_one_row_size, _slice_sizes[i]);
@@ -47,10 +61,15 @@ Status ExceptHashSet<HashSet>::init(RuntimeState* state) {
 template <typename HashSet>
 Status ExceptHashSet<HashSet>::erase_duplicate_row(RuntimeState* state, const ChunkPtr& chunk,
                                                    const std::vector<ExprContext*>& exprs) {
-    size_t chunk_size = chunk->num_rows();
+    return erase_duplicate_row(state, evaluate_key_columns(chunk, exprs), chunk->num_rows());
+}
+
+template <typename HashSet>
+Status ExceptHashSet<HashSet>::erase_duplicate_row(RuntimeState* state, const Columns& key_columns,
+                                                   size_t chunk_size) {
     _slice_sizes.assign(state->chunk_size(), 0);
 
-    size_t cur_max_one_row_size = _get_max_serialize_size(chunk, exprs);
+    size_t cur_max_one_row_size = _get_max_serialize_size(key_columns);
     if (UNLIKELY(cur_max_one_row_size > _max_one_row_size)) {
         _max_one_row_size = cur_max_one_row_size;
         _mem_pool->clear();
@@ -61,7 +80,7 @@ Status ExceptHashSet<HashSet>::erase_duplicate_row(RuntimeState* state, const Ch
         RETURN_IF_LIMIT_EXCEEDED(state, "Except, while probe hash table.");
     }
 
-    _serialize_columns(chunk, exprs, chunk_size);
+    _serialize_columns(key_columns, chunk_size);
 
     for (size_t i = 0; i < chunk_size; ++i) {
         ExceptSliceFlag key(_buffer + i * _max_one_row_size, _slice_sizes[i]);
@@ -91,10 +110,9 @@ void ExceptHashSet<HashSet>::deserialize_to_columns(KeyVector& keys, const Colum
 }
 
 template <typename HashSet>
-size_t ExceptHashSet<HashSet>::_get_max_serialize_size(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs) {
+size_t ExceptHashSet<HashSet>::_get_max_serialize_size(const Columns& key_columns) {
     size_t max_size = 0;
-    for (auto expr : exprs) {
-        ColumnPtr key_column = expr->evaluate(chunk.get());
+    for (const auto& key_column : key_columns) {
         max_size += key_column->max_one_element_serialize_size();
         if (!key_column->is_nullable()) {
             max_size += sizeof(bool);
@@ -104,11 +122,8 @@ size_t ExceptHashSet<HashSet>::_get_max_serialize_size(const ChunkPtr& chunk, co
 }
 
 template <typename HashSet>
-void ExceptHashSet<HashSet>::_serialize_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs,
-                                                size_t chunk_size) {
-    for (auto expr : exprs) {
-        ColumnPtr key_column = expr->evaluate(chunk.get());
-
+void ExceptHashSet<HashSet>::_serialize_columns(const Columns& key_columns, size_t chunk_size) {
+    for (const auto& key_column : key_columns) {
         // The serialized buffer is always nullable.
         if (key_column->is_nullable()) {
             key_column->serialize_batch(_buffer, _slice_sizes, chunk_size, _max_one_row_size);
@@ -60,14 +60,19 @@ public:
 
     Status erase_duplicate_row(RuntimeState* state, const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs);
 
+    // The same as above with the evaluated key columns of |num_rows| rows, e.g. the ones of a spilled partition.
+    void build_set(RuntimeState* state, const Columns& key_columns, size_t num_rows, MemPool* pool);
+
+    Status erase_duplicate_row(RuntimeState* state, const Columns& key_columns, size_t num_rows);
+
     void deserialize_to_columns(KeyVector& keys, const Columns& key_columns, size_t chunk_size);
 
     int64_t mem_usage() { return _hash_set->dump_bound() + _mem_pool->total_reserved_bytes(); }
 
 private:
-    size_t _get_max_serialize_size(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs);
+    size_t _get_max_serialize_size(const Columns& key_columns);
 
-    void _serialize_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs, size_t chunk_size);
+    void _serialize_columns(const Columns& key_columns, size_t chunk_size);
 
     size_t _max_one_row_size = 8;
     Buffer<uint32_t> _slice_sizes;
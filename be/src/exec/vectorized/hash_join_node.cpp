@@ -9,12 +9,15 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
+#include "exec/pipeline/chunk_accumulate_operator.h"
 #include "exec/pipeline/exchange/exchange_source_operator.h"
 #include "exec/pipeline/hashjoin/hash_join_build_operator.h"
 #include "exec/pipeline/hashjoin/hash_join_probe_operator.h"
 #include "exec/pipeline/hashjoin/hash_joiner_factory.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/scan_operator.h"
 #include "exec/vectorized/hash_joiner.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
@@ -22,6 +25,7 @@
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "runtime/global_dicts.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
 #include "util/runtime_profile.h"
@@ -137,6 +141,7 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state));
     RETURN_IF_ERROR(Expr::prepare(_probe_expr_ctxs, state));
     RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state));
+    RETURN_IF_ERROR(check_join_keys_global_dicts(state, _build_expr_ctxs, _probe_expr_ctxs));
 
     HashTableParam param;
     _init_hash_table_param(&param);
@@ -381,6 +386,11 @@ Status HashJoinNode::close(RuntimeState* state) {
     return ExecNode::close(state);
 }
 
+bool HashJoinNode::_is_bucket_aware_source(const pipeline::OpFactories& operators) {
+    auto* scan_op = dynamic_cast<pipeline::ScanOperatorFactory*>(operators[0].get());
+    return scan_op != nullptr && scan_op->bucket_aware();
+}
+
 pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     auto rhs_operators = child(1)->decompose_to_pipeline(context);
     auto lhs_operators = child(0)->decompose_to_pipeline(context);
@@ -402,6 +412,11 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
 
             rhs_operators = context->maybe_interpolate_local_passthrough_exchange(runtime_state(), rhs_operators);
             lhs_operators = context->maybe_interpolate_local_passthrough_exchange(runtime_state(), lhs_operators);
+        } else if (_distribution_mode == TJoinDistributionMode::COLOCATE && _is_bucket_aware_source(rhs_operators) &&
+                   _is_bucket_aware_source(lhs_operators)) {
+            // The driver i of both sides scans the same buckets of the colocated tables, so the rows of the same
+            // join keys are already in the same partition.
+            num_partitions = context->degree_of_parallelism();
         } else {
             num_partitions = context->degree_of_parallelism();
 
@@ -500,6 +515,11 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
     context->add_pipeline(rhs_operators);
 
     lhs_operators.emplace_back(std::move(probe_op));
+    // The selective joins output many small chunks.
+    if (config::enable_pipeline_chunk_accumulate) {
+        lhs_operators.emplace_back(std::make_shared<pipeline::ChunkAccumulateOperatorFactory>(
+                context->next_operator_id(), id(), runtime_state()->chunk_size()));
+    }
 
     if (limit() != -1) {
         lhs_operators.emplace_back(
@@ -39,6 +39,8 @@ public:
 
 private:
     static bool _has_null(const ColumnPtr& column);
+    // Whether the chunks of |operators| come from a bucket-aware scan, see ScanOperatorFactory::bucket_aware.
+    static bool _is_bucket_aware_source(const pipeline::OpFactories& operators);
 
     void _init_hash_table_param(HashTableParam* param);
     // local join includes: broadcast join and colocate join.
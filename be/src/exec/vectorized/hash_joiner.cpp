@@ -7,13 +7,16 @@
 #include <memory>
 
 #include "column/column_helper.h"
+#include "column/const_column.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/global_dicts.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
 #include "util/debug_util.h"
@@ -90,6 +93,8 @@ Status HashJoiner::prepare(RuntimeState* state) {
     _avg_output_chunk_size = ADD_COUNTER(_runtime_profile, "AvgOutputChunkSize", TUnit::UNIT);
     _runtime_profile->add_info_string("JoinType", _get_join_type_str(_join_type));
 
+    RETURN_IF_ERROR(check_join_keys_global_dicts(state, _build_expr_ctxs, _probe_expr_ctxs));
+
     HashTableParam param;
     _init_hash_table_param(&param);
     _ht.create(param);
@@ -100,6 +105,20 @@ Status HashJoiner::prepare(RuntimeState* state) {
     return Status::OK();
 }
 
+void HashJoiner::enable_spill() {
+    if (_join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN) {
+        return;
+    }
+    _enable_spill = true;
+    _spill_mem_threshold = spill_mem_threshold(_runtime_state->instance_mem_tracker());
+    _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+    _restore_timer = ADD_TIMER(_runtime_profile, "RestoreTime");
+    _spilled_build_rows_counter = ADD_COUNTER(_runtime_profile, "SpilledBuildRows", TUnit::UNIT);
+    _spilled_probe_rows_counter = ADD_COUNTER(_runtime_profile, "SpilledProbeRows", TUnit::UNIT);
+    _spilled_bytes_counter = ADD_COUNTER(_runtime_profile, "SpilledBytes", TUnit::BYTES);
+    _spilled_partitions_counter = ADD_COUNTER(_runtime_profile, "SpilledPartitions", TUnit::UNIT);
+}
+
 void HashJoiner::_init_hash_table_param(HashTableParam* param) {
     // Pipeline query engine always needn't create tuple columns
     param->need_create_tuple_columns = false;
@@ -138,6 +157,10 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
     if (!chunk || chunk->is_empty()) {
         return Status::OK();
     }
+    if (_has_spilled) {
+        SCOPED_TIMER(_spill_timer);
+        return _spill_build_rows(*chunk, 0, chunk->num_rows());
+    }
     if (UNLIKELY(_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX)) {
         return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
     }
@@ -146,11 +169,18 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
         SCOPED_TIMER(_copy_right_table_chunk_timer);
         RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
     }
+    if (_enable_spill && should_spill(_ht.mem_usage(), _spill_mem_threshold)) {
+        RETURN_IF_ERROR(_start_spill(state));
+    }
     return Status::OK();
 }
 
 Status HashJoiner::build_ht(RuntimeState* state) {
     if (_phase == HashJoinPhase::BUILD) {
+        if (_has_spilled) {
+            _spill_status = _finish_build_spill(state);
+            RETURN_IF_ERROR(_spill_status);
+        }
         RETURN_IF_ERROR(_build(state));
         COUNTER_SET(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
         COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
@@ -159,6 +189,32 @@ Status HashJoiner::build_ht(RuntimeState* state) {
     return Status::OK();
 }
 
+StatusOr<bool> HashJoiner::prepare_parallel_build(RuntimeState* state) {
+    if (_phase != HashJoinPhase::BUILD || _has_spilled) {
+        return false;
+    }
+    {
+        SCOPED_TIMER(_build_conjunct_evaluate_timer);
+        if (_ht.get_build_chunk()->reach_capacity_limit()) {
+            return Status::InternalError("Total size of single column exceed the limit of hash join");
+        }
+        _prepare_build_key_columns();
+    }
+    SCOPED_TIMER(_build_ht_timer);
+    return _ht.prepare_parallel_build(state);
+}
+
+void HashJoiner::finish_parallel_build() {
+    COUNTER_SET(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
+    COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
+}
+
+void HashJoiner::share_hash_table(RuntimeState* state, const HashJoiner& builder) {
+    DCHECK(_phase == HashJoinPhase::BUILD && !_has_spilled);
+    _ht.share_built_table(state, builder._ht);
+    finish_parallel_build();
+}
+
 bool HashJoiner::need_input() const {
     // when _buffered_chunk accumulates several chunks to form into a large enough chunk, it is moved into
     // _probe_chunk for probe operations.
@@ -183,17 +239,27 @@ bool HashJoiner::has_output() const {
     return false;
 }
 
-void HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
+Status HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
     DCHECK(chunk && !chunk->is_empty());
     DCHECK(!_probe_input_chunk);
+    RETURN_IF_ERROR(_spill_status);
 
     _probe_input_chunk = std::move(chunk);
+    if (_has_spilled && _build_spiller->spilled_rows() > 0) {
+        SCOPED_TIMER(_spill_timer);
+        RETURN_IF_ERROR(_spill_probe_rows());
+        if (_probe_input_chunk == nullptr) {
+            return Status::OK();
+        }
+    }
     _ht_has_remain = true;
     _prepare_probe_key_columns();
+    return Status::OK();
 }
 
 StatusOr<ChunkPtr> HashJoiner::pull_chunk(RuntimeState* state) {
     DCHECK(_phase != HashJoinPhase::BUILD);
+    RETURN_IF_ERROR(_spill_status);
     return _pull_probe_output_chunk(state);
 }
 
@@ -216,18 +282,20 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
     }
 
     if (_phase == HashJoinPhase::POST_PROBE) {
-        if (!_need_post_probe()) {
-            enter_eos_phase();
+        if (_need_post_probe() && !_is_post_probe_eos && _restored_probe_file == nullptr) {
+            _ht_has_remain = false;
+            RETURN_IF_ERROR(_ht.probe_remain(state, &chunk, &_ht_has_remain));
+            _is_post_probe_eos = !_ht_has_remain;
+            _filter_post_probe_output_chunk(chunk);
+        } else if (_has_spilled) {
+            // The joined rows of a spilled partition are output by the following calls.
+            RETURN_IF_ERROR(_restore_spilled_partition(state));
             return chunk;
         }
 
-        RETURN_IF_ERROR(_ht.probe_remain(state, &chunk, &_ht_has_remain));
-        if (!_ht_has_remain) {
+        if (!_has_spilled && (!_need_post_probe() || _is_post_probe_eos)) {
             enter_eos_phase();
         }
-
-        _filter_post_probe_output_chunk(chunk);
-
         return chunk;
     }
 
@@ -236,6 +304,10 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
 
 Status HashJoiner::close(RuntimeState* state) {
     _ht.close();
+    _restored_probe_file.reset();
+    _spilled_partitions.clear();
+    _probe_spiller.reset();
+    _build_spiller.reset();
     return Status::OK();
 }
 
@@ -244,6 +316,15 @@ Status HashJoiner::create_runtime_filters(RuntimeState* state) {
         return Status::OK();
     }
 
+    if (_has_spilled) {
+        // The hash table only has the rows of the partitions kept in memory, runtime filters built from
+        // it would filter out the probe rows matching the spilled partitions.
+        for (size_t i = 0; i < _build_runtime_filters.size(); i++) {
+            _runtime_bloom_filter_build_params.emplace_back(false, nullptr, -1);
+        }
+        return Status::OK();
+    }
+
     uint64_t runtime_join_filter_pushdown_limit = 1024000;
     if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
         runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
@@ -302,6 +383,271 @@ Status HashJoiner::_build(RuntimeState* state) {
     return Status::OK();
 }
 
+// All the chunks of a spill file must have the same layout, so the const columns are unfolded
+// and all the columns are made nullable as |prototype|.
+static ChunkPtr normalize_spill_chunk(const Chunk& prototype, const Chunk& chunk, size_t offset, size_t count) {
+    ChunkPtr result = prototype.clone_empty_with_slot(count);
+    if (count == 0) {
+        return result;
+    }
+    for (const auto& [slot_id, index] : prototype.get_slot_id_to_index_map()) {
+        const ColumnPtr& src = chunk.get_column_by_slot_id(slot_id);
+        ColumnPtr& dst = result->get_column_by_slot_id(slot_id);
+        if (src->is_constant()) {
+            dst->append(*down_cast<const ConstColumn*>(src.get())->data_column(), 0, 1);
+            dst->assign(count, 0);
+        } else {
+            dst->append(*src, offset, count);
+        }
+    }
+    return result;
+}
+
+ChunkPtr HashJoiner::_create_spill_prototype(const RowDescriptor& row_desc) const {
+    auto chunk = std::make_shared<Chunk>();
+    for (const auto& tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            chunk->append_column(ColumnHelper::create_column(slot->type(), true), slot->id());
+        }
+    }
+    return chunk;
+}
+
+void HashJoiner::_reset_hash_table() {
+    _ht.close();
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+}
+
+Status HashJoiner::_start_spill(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    _has_spilled = true;
+    _build_spill_prototype = _create_spill_prototype(_build_row_descriptor);
+    _build_spiller = std::make_unique<PartitionedSpiller>("hash_join_build", config::spill_hash_partitions,
+                                                          state->chunk_size());
+    _build_spiller->keep_in_memory();
+    _spilled_partition_mask.assign(_build_spiller->num_partitions(), 0);
+
+    // Move the rows in the hash table into the partitions, the first row is reserved by the hash table.
+    const ChunkPtr& build_chunk = _ht.get_build_chunk();
+    const size_t num_rows = build_chunk->num_rows();
+    for (size_t offset = 1; offset < num_rows; offset += state->chunk_size()) {
+        size_t count = std::min<size_t>(state->chunk_size(), num_rows - offset);
+        RETURN_IF_ERROR(_spill_build_rows(*build_chunk, offset, count));
+    }
+    _reset_hash_table();
+    return Status::OK();
+}
+
+Status HashJoiner::_spill_build_rows(const Chunk& chunk, size_t offset, size_t count) {
+    ChunkPtr spill_chunk = normalize_spill_chunk(*_build_spill_prototype, chunk, offset, count);
+    Columns key_columns;
+    _prepare_key_columns(key_columns, spill_chunk, _build_expr_ctxs);
+    RETURN_IF_ERROR(_build_spiller->append(spill_chunk, key_columns));
+    return _spill_resident_partitions();
+}
+
+Status HashJoiner::_spill_resident_partitions() {
+    while (true) {
+        size_t total_bytes = 0;
+        size_t largest_bytes = 0;
+        size_t largest = 0;
+        for (size_t i = 0; i < _build_spiller->num_partitions(); i++) {
+            size_t bytes = _build_spiller->resident_bytes(i);
+            total_bytes += bytes;
+            if (bytes > largest_bytes) {
+                largest_bytes = bytes;
+                largest = i;
+            }
+        }
+        if (total_bytes <= _spill_mem_threshold || largest_bytes == 0) {
+            break;
+        }
+        RETURN_IF_ERROR(_build_spiller->spill_partition(largest));
+        _spilled_partition_mask[largest] = 1;
+    }
+    COUNTER_SET(_spilled_build_rows_counter, static_cast<int64_t>(_build_spiller->spilled_rows()));
+    return Status::OK();
+}
+
+Status HashJoiner::_finish_build_spill(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    RETURN_IF_ERROR(_build_spiller->flip_to_read());
+    // The partitions kept in memory are joined as if there was no spill.
+    for (size_t i = 0; i < _build_spiller->num_partitions(); i++) {
+        if (_build_spiller->is_spilled(i)) {
+            continue;
+        }
+        for (auto& chunk : _build_spiller->take_resident_chunks(i)) {
+            RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
+            chunk.reset();
+        }
+    }
+    COUNTER_SET(_spilled_build_rows_counter, static_cast<int64_t>(_build_spiller->spilled_rows()));
+    COUNTER_SET(_spilled_bytes_counter, static_cast<int64_t>(_build_spiller->spilled_bytes()));
+    COUNTER_SET(_spilled_partitions_counter, static_cast<int64_t>(SIMD::count_nonzero(_spilled_partition_mask)));
+    return Status::OK();
+}
+
+Status HashJoiner::_spill_probe_rows() {
+    if (_probe_spiller == nullptr) {
+        _probe_spill_prototype = _create_spill_prototype(_probe_row_descriptor);
+        _probe_spiller = std::make_unique<PartitionedSpiller>("hash_join_probe", _build_spiller->num_partitions(),
+                                                              _runtime_state->chunk_size());
+    }
+    const size_t num_rows = _probe_input_chunk->num_rows();
+    ChunkPtr spill_chunk = normalize_spill_chunk(*_probe_spill_prototype, *_probe_input_chunk, 0, num_rows);
+    Columns key_columns;
+    _prepare_key_columns(key_columns, spill_chunk, _probe_expr_ctxs);
+    RETURN_IF_ERROR(_probe_spiller->append(spill_chunk, key_columns, &_spilled_partition_mask));
+    COUNTER_SET(_spilled_probe_rows_counter, static_cast<int64_t>(_probe_spiller->spilled_rows()));
+
+    // Only the rows of the partitions kept in memory are probed now.
+    const auto& partition_indexes = _probe_spiller->partition_indexes();
+    Column::Filter filter(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        filter[i] = !_spilled_partition_mask[partition_indexes[i]];
+    }
+    size_t num_kept_rows = SIMD::count_nonzero(filter.data(), filter.size());
+    if (num_kept_rows == 0) {
+        _probe_input_chunk = nullptr;
+    } else if (num_kept_rows < num_rows) {
+        _probe_input_chunk->filter(filter);
+    }
+    return Status::OK();
+}
+
+Status HashJoiner::_finish_probe_spill() {
+    if (_probe_spiller != nullptr) {
+        RETURN_IF_ERROR(_probe_spiller->flip_to_read());
+        COUNTER_SET(_spilled_bytes_counter,
+                    static_cast<int64_t>(_build_spiller->spilled_bytes() + _probe_spiller->spilled_bytes()));
+    }
+    for (size_t i = 0; i < _build_spiller->num_partitions(); i++) {
+        if (!_spilled_partition_mask[i]) {
+            continue;
+        }
+        SpilledJoinPartition partition;
+        partition.build = _build_spiller->take_partition(i);
+        if (_probe_spiller != nullptr) {
+            partition.probe = _probe_spiller->take_partition(i);
+        }
+        _add_spilled_partition(std::move(partition));
+    }
+    _is_spill_finished = true;
+    return Status::OK();
+}
+
+void HashJoiner::_add_spilled_partition(SpilledJoinPartition&& partition) {
+    // Skip the partitions which can't output anything.
+    if (partition.probe == nullptr && !_need_post_probe()) {
+        return;
+    }
+    if (partition.build == nullptr && _join_type != TJoinOp::LEFT_OUTER_JOIN &&
+        _join_type != TJoinOp::LEFT_ANTI_JOIN && _join_type != TJoinOp::FULL_OUTER_JOIN) {
+        return;
+    }
+    _spilled_partitions.emplace_back(std::move(partition));
+}
+
+Status HashJoiner::_restore_spilled_partition(RuntimeState* state) {
+    if (!_is_spill_finished) {
+        SCOPED_TIMER(_spill_timer);
+        RETURN_IF_ERROR(_finish_probe_spill());
+    }
+    SCOPED_TIMER(_restore_timer);
+
+    if (_restored_probe_file != nullptr) {
+        auto res = _restored_probe_file->read_next(*_probe_spill_prototype);
+        if (res.status().is_end_of_file()) {
+            // Then the post probe of this partition, if it's needed.
+            _restored_probe_file.reset();
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(res.status());
+        _probe_input_chunk = std::move(res).value();
+        _ht_has_remain = true;
+        _prepare_probe_key_columns();
+        return Status::OK();
+    }
+
+    if (_spilled_partitions.empty()) {
+        enter_eos_phase();
+        return Status::OK();
+    }
+    SpilledJoinPartition partition = std::move(_spilled_partitions.back());
+    _spilled_partitions.pop_back();
+    if (partition.build != nullptr && partition.build->num_bytes() > _spill_mem_threshold &&
+        partition.level < kMaxSpillLevel) {
+        return _repartition_spilled_partition(state, std::move(partition));
+    }
+
+    _reset_hash_table();
+    if (partition.build != nullptr) {
+        while (true) {
+            auto res = partition.build->read_next(*_build_spill_prototype);
+            if (res.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(res.status());
+            if (UNLIKELY(_ht.get_row_count() + res.value()->num_rows() >= UINT32_MAX)) {
+                return Status::NotSupported(
+                        strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
+            }
+            RETURN_IF_ERROR(_ht.append_chunk(state, res.value()));
+        }
+        partition.build.reset();
+    }
+    RETURN_IF_ERROR(_build(state));
+    _restored_probe_file = std::move(partition.probe);
+    _is_post_probe_eos = false;
+    return Status::OK();
+}
+
+Status HashJoiner::_repartition_spilled_partition(RuntimeState* state, SpilledJoinPartition&& partition) {
+    // Use the level as the seed, so the rows of this partition are spread over the new partitions.
+    const uint32_t level = partition.level + 1;
+    const size_t num_partitions = config::spill_hash_partitions;
+    PartitionedSpiller build_spiller("hash_join_build", num_partitions, state->chunk_size(), level);
+    PartitionedSpiller probe_spiller("hash_join_probe", num_partitions, state->chunk_size(), level);
+    RETURN_IF_ERROR(
+            _repartition_spill_file(partition.build.get(), *_build_spill_prototype, _build_expr_ctxs, &build_spiller));
+    partition.build.reset();
+    if (partition.probe != nullptr) {
+        RETURN_IF_ERROR(_repartition_spill_file(partition.probe.get(), *_probe_spill_prototype, _probe_expr_ctxs,
+                                                &probe_spiller));
+        partition.probe.reset();
+    }
+    RETURN_IF_ERROR(build_spiller.flip_to_read());
+    RETURN_IF_ERROR(probe_spiller.flip_to_read());
+
+    for (size_t i = 0; i < num_partitions; i++) {
+        SpilledJoinPartition sub_partition;
+        sub_partition.build = build_spiller.take_partition(i);
+        sub_partition.probe = probe_spiller.take_partition(i);
+        sub_partition.level = level;
+        _add_spilled_partition(std::move(sub_partition));
+    }
+    COUNTER_UPDATE(_spilled_partitions_counter, static_cast<int64_t>(num_partitions));
+    return Status::OK();
+}
+
+Status HashJoiner::_repartition_spill_file(SpillFile* file, const Chunk& prototype,
+                                           const std::vector<ExprContext*>& expr_ctxs, PartitionedSpiller* spiller) {
+    Columns key_columns;
+    while (true) {
+        auto res = file->read_next(prototype);
+        if (res.status().is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(res.status());
+        _prepare_key_columns(key_columns, res.value(), expr_ctxs);
+        RETURN_IF_ERROR(spiller->append(res.value(), key_columns));
+    }
+    return Status::OK();
+}
+
 void HashJoiner::_calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all,
                                                  bool& hit_all) {
     filter_all = false;
@@ -10,6 +10,7 @@
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/join_hash_map.h"
+#include "exec/vectorized/spill_file.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "util/phmap/phmap.h"
 
@@ -34,6 +35,12 @@ class RuntimeFilterBuildDescriptor;
 //   processed.
 // 4.DONE: all input streams have been processed.
 //
+// When spill is enabled and the build side goes over the memory threshold, HashJoiner works as a grace hash join:
+// the build rows are hash partitioned by the join keys, the partitions are kept in memory as long as they fit, and
+// the others are spilled to disk. In PROBE phase, the probe rows of the spilled partitions are spilled too, and
+// every pair of the spilled partitions is joined in POST_PROBE phase, after the in-memory partitions. A pair which
+// still doesn't fit in memory is partitioned again with another hash seed.
+//
 enum HashJoinPhase {
     BUILD = 0,
     PROBE = 1,
@@ -91,6 +98,14 @@ struct HashJoinerParam {
     std::set<SlotId> _output_slots;
 };
 
+// A pair of the build partition and the probe partition spilled by grace hash join, level is the number of
+// times that they have been partitioned.
+struct SpilledJoinPartition {
+    std::unique_ptr<SpillFile> build;
+    std::unique_ptr<SpillFile> probe;
+    uint32_t level = 0;
+};
+
 class HashJoiner final : public pipeline::ContextWithDependency {
 public:
     explicit HashJoiner(const HashJoinerParam& param);
@@ -123,11 +138,22 @@ public:
         }
     }
     void enter_eos_phase() { _phase = HashJoinPhase::EOS; }
+    // Must be called after prepare(), null aware left anti join is never spilled, because it
+    // depends on whether the whole build side has null.
+    void enable_spill();
+    bool has_spilled() const { return _has_spilled; }
     // build phase
     Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
     Status build_ht(RuntimeState* state);
+    // The parallel build of the hash table instead of build_ht(), see JoinHashTable::prepare_parallel_build().
+    // false means the hash table doesn't support it.
+    StatusOr<bool> prepare_parallel_build(RuntimeState* state);
+    JoinHashTable& hash_table() { return _ht; }
+    void finish_parallel_build();
+    // Probe the hash table built by |builder| instead of building its own.
+    void share_hash_table(RuntimeState* state, const HashJoiner& builder);
     // probe phase
-    void push_chunk(RuntimeState* state, ChunkPtr&& chunk);
+    Status push_chunk(RuntimeState* state, ChunkPtr&& chunk);
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state);
 
     std::list<ExprContext*>& get_runtime_in_filters() { return _runtime_in_filters; }
@@ -135,7 +161,8 @@ public:
     std::list<pipeline::RuntimeBloomFilterBuildParam>& get_runtime_bloom_filter_build_params() {
         return _runtime_bloom_filter_build_params;
     }
-    size_t get_ht_row_count() { return _ht.get_row_count(); }
+    // Including the build rows spilled to disk.
+    size_t get_ht_row_count() { return _ht.get_row_count() + (_has_spilled ? _build_spiller->spilled_rows() : 0); }
 
     Status create_runtime_filters(RuntimeState* state);
 
@@ -177,7 +204,7 @@ private:
 
     void _short_circuit_break() {
         // special cases of short-circuit break.
-        if (_ht.get_row_count() == 0 &&
+        if (get_ht_row_count() == 0 &&
             (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN ||
              _join_type == TJoinOp::RIGHT_SEMI_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
              _join_type == TJoinOp::RIGHT_OUTER_JOIN)) {
@@ -214,6 +241,23 @@ private:
     void _process_right_anti_join_with_other_conjunct(ChunkPtr* chunk);
     void _process_other_conjunct(ChunkPtr* chunk);
 
+    // grace hash join
+    ChunkPtr _create_spill_prototype(const RowDescriptor& row_desc) const;
+    Status _start_spill(RuntimeState* state);
+    Status _spill_build_rows(const Chunk& chunk, size_t offset, size_t count);
+    // Spill the largest resident partitions until the others fit in memory.
+    Status _spill_resident_partitions();
+    Status _finish_build_spill(RuntimeState* state);
+    Status _spill_probe_rows();
+    Status _finish_probe_spill();
+    void _add_spilled_partition(SpilledJoinPartition&& partition);
+    // Load the next spilled partition into the hash table, or read the next probe chunk of it.
+    Status _restore_spilled_partition(RuntimeState* state);
+    Status _repartition_spilled_partition(RuntimeState* state, SpilledJoinPartition&& partition);
+    Status _repartition_spill_file(SpillFile* file, const Chunk& prototype, const std::vector<ExprContext*>& expr_ctxs,
+                                   PartitionedSpiller* spiller);
+    void _reset_hash_table();
+
     void _filter_probe_output_chunk(ChunkPtr& chunk) {
         // Probe in JoinHashMap is divided into probe with other_conjuncts and without other_conjuncts.
         // Probe without other_conjuncts directly labels the hash table as hit, while _process_other_conjunct()
@@ -343,6 +387,28 @@ private:
     bool _eos = false;
     // hash table doesn't have reserved data
     bool _ht_has_remain = false;
+    // probe_remain() of the hash table has been done
+    bool _is_post_probe_eos = false;
+
+    // only used by grace hash join
+    static constexpr uint32_t kMaxSpillLevel = 3;
+    bool _enable_spill = false;
+    bool _has_spilled = false;
+    bool _is_spill_finished = false;
+    int64_t _spill_mem_threshold = 0;
+    std::unique_ptr<PartitionedSpiller> _build_spiller;
+    std::unique_ptr<PartitionedSpiller> _probe_spiller;
+    // Non-zero for the partitions of _build_spiller which have been spilled.
+    std::vector<uint8_t> _spilled_partition_mask;
+    // Spilled chunks are unfolded and fully nullable, in the layout of these prototypes.
+    ChunkPtr _build_spill_prototype;
+    ChunkPtr _probe_spill_prototype;
+    // The spilled partitions waiting to be joined, the last one is joined first.
+    std::vector<SpilledJoinPartition> _spilled_partitions;
+    std::unique_ptr<SpillFile> _restored_probe_file;
+    // The error of finishing the build side in HashJoinBuildOperator::set_finishing(),
+    // which can't return it, is reported by the probe side.
+    Status _spill_status;
     // right table have not output data for right outer join/right semi join/right anti join/full outer join
 
     RuntimeProfile::Counter* _build_timer = nullptr;
@@ -365,6 +431,12 @@ private:
     RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _restore_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_build_rows_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_probe_rows_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_partitions_counter = nullptr;
 };
 
 } // namespace vectorized
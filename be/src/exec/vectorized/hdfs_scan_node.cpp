@@ -663,7 +663,10 @@ Status HdfsScanNode::_find_and_insert_hdfs_file(const THdfsScanRange& scan_range
         RETURN_IF_ERROR(HdfsFsCache::instance()->get_connection(namenode, &hdfs, &open_limit));
         auto* hdfs_file_desc = _pool->add(new HdfsFileDesc());
         hdfs_file_desc->hdfs_fs = hdfs;
-        hdfs_file_desc->fs = std::make_shared<HdfsRandomAccessFile>(hdfs, native_file_path, usePread);
+        auto file = std::make_shared<HdfsRandomAccessFile>(hdfs, native_file_path, usePread);
+        file->enable_block_cache(scan_range.file_length);
+        file->enable_tail_cache(scan_range.file_length);
+        hdfs_file_desc->fs = std::move(file);
         hdfs_file_desc->partition_id = scan_range.partition_id;
         hdfs_file_desc->path = scan_range_path;
         hdfs_file_desc->file_length = scan_range.file_length;
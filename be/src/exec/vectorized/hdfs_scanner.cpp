@@ -190,7 +190,8 @@ void HdfsScanner::update_counter() {
     if (_scanner_params.fs == nullptr) return;
 
     HdfsReadStats hdfs_stats;
-    auto hdfs_file = down_cast<HdfsRandomAccessFile*>(_scanner_params.fs.get())->hdfs_file();
+    auto* file = down_cast<HdfsRandomAccessFile*>(_scanner_params.fs.get());
+    auto hdfs_file = file->hdfs_file();
     if (hdfs_file == nullptr) return;
     // Hdfslib only supports obtaining statistics of hdfs file system.
     // For other systems such as s3, calling this function will cause be crash.
@@ -204,6 +205,13 @@ void HdfsScanner::update_counter() {
     COUNTER_UPDATE(root.bytes_read_short_circuit, hdfs_stats.bytes_read_short_circuit);
     COUNTER_UPDATE(root.bytes_read_dn_cache, hdfs_stats.bytes_read_dn_cache);
     COUNTER_UPDATE(root.bytes_read_remote, hdfs_stats.bytes_read_remote);
+    COUNTER_UPDATE(root.bytes_read_block_cache, file->pop_block_cache_hit_bytes());
+    COUNTER_UPDATE(root.bytes_read_tail_cache, file->pop_tail_cache_hit_bytes());
+    int64_t served_reads = 0;
+    int64_t issued_reads = 0;
+    file->pop_coalesced_read_counts(&served_reads, &issued_reads);
+    COUNTER_UPDATE(root.coalesced_io_count, issued_reads);
+    COUNTER_UPDATE(root.saved_io_count, served_reads - issued_reads);
 #endif
 }
 
@@ -306,6 +314,12 @@ void HdfsIOProfile::init(RuntimeProfile* root) {
             ADD_CHILD_COUNTER(root, "BytesReadShortCircuit", TUnit::BYTES, kHdfsIOProfileSectionPrefix);
     bytes_read_dn_cache = ADD_CHILD_COUNTER(root, "BytesReadDataNodeCache", TUnit::BYTES, kHdfsIOProfileSectionPrefix);
     bytes_read_remote = ADD_CHILD_COUNTER(root, "BytesReadRemote", TUnit::BYTES, kHdfsIOProfileSectionPrefix);
+    bytes_read_block_cache =
+            ADD_CHILD_COUNTER(root, "BytesReadBlockCache", TUnit::BYTES, kHdfsIOProfileSectionPrefix);
+    bytes_read_tail_cache =
+            ADD_CHILD_COUNTER(root, "BytesReadTailCache", TUnit::BYTES, kHdfsIOProfileSectionPrefix);
+    coalesced_io_count = ADD_CHILD_COUNTER(root, "CoalescedIOCount", TUnit::UNIT, kHdfsIOProfileSectionPrefix);
+    saved_io_count = ADD_CHILD_COUNTER(root, "SavedIOCount", TUnit::UNIT, kHdfsIOProfileSectionPrefix);
 }
 
 } // namespace starrocks::vectorized
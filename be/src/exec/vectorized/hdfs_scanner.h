@@ -25,6 +25,11 @@ public:
     RuntimeProfile::Counter* bytes_read_short_circuit = nullptr;
     RuntimeProfile::Counter* bytes_read_dn_cache = nullptr;
     RuntimeProfile::Counter* bytes_read_remote = nullptr;
+    RuntimeProfile::Counter* bytes_read_block_cache = nullptr;
+    RuntimeProfile::Counter* bytes_read_tail_cache = nullptr;
+    // IO requests of the coalesced reads, and the round trips saved by them
+    RuntimeProfile::Counter* coalesced_io_count = nullptr;
+    RuntimeProfile::Counter* saved_io_count = nullptr;
 
     void init(RuntimeProfile* root);
 
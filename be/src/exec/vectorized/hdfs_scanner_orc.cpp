@@ -117,6 +117,11 @@ bool OrcRowReaderFilter::filterOnOpeningStripe(uint64_t stripeIndex,
     // range end must > offset
     auto it = _scan_ranges.upper_bound(offset);
     if ((it != _scan_ranges.end()) && (offset >= it->second) && (offset < it->first)) {
+        // the stripe footer tells the streams only after the stripe is opened, so the whole stripe is
+        // hinted to be read with as few IO requests as possible.
+        uint64_t length = stripeInformation->indexlength() + stripeInformation->datalength() +
+                          stripeInformation->footerlength();
+        _scanner_params.fs->set_io_ranges({IORange{offset, length}});
         return false;
     }
     return true;
@@ -2,13 +2,57 @@
 
 #include "exec/vectorized/hdfs_scanner_text.h"
 
+#include "env/compressed_file.h"
+#include "exec/decompressor.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "gen_cpp/Descriptors_types.h"
 #include "gutil/strings/substitute.h"
+#include "gutil/strings/util.h"
 #include "util/utf8_check.h"
 
 namespace starrocks::vectorized {
 
+// Reads a file of the external table from the beginning to the end.
+class HdfsSequentialFile final : public SequentialFile {
+public:
+    HdfsSequentialFile(std::shared_ptr<RandomAccessFile> file, size_t file_length)
+            : _file(std::move(file)), _file_length(file_length) {}
+
+    Status read(Slice* result) override {
+        result->size = std::min<size_t>(result->size, _file_length - std::min(_offset, _file_length));
+        if (result->size > 0) {
+            RETURN_IF_ERROR(_file->read(_offset, result));
+        }
+        _offset += result->size;
+        return Status::OK();
+    }
+
+    Status skip(uint64_t n) override {
+        _offset += n;
+        return Status::OK();
+    }
+
+    const std::string& filename() const override { return _file->file_name(); }
+
+private:
+    std::shared_ptr<RandomAccessFile> _file;
+    size_t _file_length = 0;
+    size_t _offset = 0;
+};
+
+// Hive tells the codec of a text file by the suffix of its name.
+static CompressionTypePB get_compression_type(const std::string& file_name) {
+    // the zlib streams of .deflate are detected by the gzip decompressor
+    if (HasSuffixString(file_name, ".gz") || HasSuffixString(file_name, ".deflate")) {
+        return CompressionTypePB::GZIP;
+    } else if (HasSuffixString(file_name, ".bz2")) {
+        return CompressionTypePB::BZIP2;
+    } else if (HasSuffixString(file_name, ".zst")) {
+        return CompressionTypePB::ZSTD;
+    }
+    return CompressionTypePB::NO_COMPRESSION;
+}
+
 class HdfsScannerCSVReader : public CSVReader {
 public:
     HdfsScannerCSVReader(std::shared_ptr<RandomAccessFile> file, char record_delimiter, string field_delimiter,
@@ -20,6 +64,10 @@ public:
         _file_length = file_length;
     }
 
+    // The compressed file is decompressed in blocks of several megabytes ahead of the parsing, it's read
+    // by the scan range at the beginning of the file, the other ranges are empty.
+    Status init_decompression(CompressionTypePB compression);
+
     void reset(size_t offset, size_t remain_length);
 
     Status next_record(Record* record);
@@ -28,17 +76,29 @@ protected:
     Status _fill_buffer() override;
 
 private:
+    Status _fill_buffer_from_compressed_file();
+
     std::shared_ptr<RandomAccessFile> _file;
+    std::shared_ptr<SequentialFile> _compressed_file;
     size_t _offset = 0;
     int32_t _remain_length = 0;
     size_t _file_length = 0;
     bool _should_stop_scan = false;
 };
 
+Status HdfsScannerCSVReader::init_decompression(CompressionTypePB compression) {
+    std::unique_ptr<Decompressor> decompressor;
+    RETURN_IF_ERROR(Decompressor::create_decompressor(compression, &decompressor));
+    auto file = std::make_shared<HdfsSequentialFile>(_file, _file_length);
+    _compressed_file = std::make_shared<CompressedSequentialFile>(std::move(file), std::move(decompressor));
+    _should_stop_scan = _offset != 0;
+    return Status::OK();
+}
+
 void HdfsScannerCSVReader::reset(size_t offset, size_t remain_length) {
     _offset = offset;
     _remain_length = remain_length;
-    _should_stop_scan = false;
+    _should_stop_scan = _compressed_file != nullptr && offset != 0;
     _buff.skip(_buff.limit() - _buff.position());
 }
 
@@ -49,8 +109,35 @@ Status HdfsScannerCSVReader::next_record(Record* record) {
     return CSVReader::next_record(record);
 }
 
+Status HdfsScannerCSVReader::_fill_buffer_from_compressed_file() {
+    DCHECK(_buff.free_space() > 0);
+    Slice s(_buff.limit(), _buff.free_space());
+    Status st = _compressed_file->read(&s);
+    if (st.is_end_of_file()) {
+        s.size = 0;
+    } else if (!st.ok()) {
+        LOG(WARNING) << "Status is not ok " << st.get_error_msg();
+        return st;
+    }
+    _buff.add_limit(s.size);
+    auto n = _buff.available();
+    if (s.size == 0 && n == 0) {
+        _should_stop_scan = true;
+        return Status::EndOfFile(_file->file_name());
+    } else if (s.size == 0 && _buff.position()[n - 1] != _record_delimiter) {
+        _buff.append(_record_delimiter);
+    }
+    return Status::OK();
+}
+
 Status HdfsScannerCSVReader::_fill_buffer() {
-    if (_should_stop_scan || _offset >= _file_length) {
+    if (_should_stop_scan) {
+        return Status::EndOfFile("HdfsScannerCSVReader");
+    }
+    if (_compressed_file != nullptr) {
+        return _fill_buffer_from_compressed_file();
+    }
+    if (_offset >= _file_length) {
         return Status::EndOfFile("HdfsScannerCSVReader");
     }
 
@@ -102,6 +189,7 @@ Status HdfsTextScanner::do_init(RuntimeState* runtime_state, const HdfsScannerPa
     _field_delimiter = text_file_desc.field_delim;
     // we should cast string to char now since csv reader only support record delimiter by char
     _record_delimiter = text_file_desc.line_delim.front();
+    _compression = get_compression_type(_scanner_params.fs->file_name());
     return Status::OK();
 }
 
@@ -113,7 +201,9 @@ Status HdfsTextScanner::do_open(RuntimeState* runtime_state) {
     for (int i = 0; i < _scanner_params.materialize_slots.size(); i++) {
         auto slot = _scanner_params.materialize_slots[i];
         ConverterPtr conv = csv::get_converter(slot->type(), true);
-        RETURN_IF_ERROR(_get_hive_column_index(slot->col_name()));
+        int field_index = 0;
+        RETURN_IF_ERROR(_get_hive_column_index(slot->col_name(), &field_index));
+        _field_indexes.push_back(field_index);
         if (conv == nullptr) {
             return Status::InternalError(strings::Substitute("Unsupported CSV type $0", slot->type().debug_string()));
         }
@@ -158,9 +248,13 @@ Status HdfsTextScanner::parse_csv(int chunk_size, ChunkPtr* chunk) {
     }
 
     csv::Converter::Options options;
+    auto* reader = down_cast<HdfsScannerCSVReader*>(_reader.get());
+    const int num_materialize_columns = _scanner_params.materialize_slots.size();
+    const size_t num_hive_columns = _scanner_params.hive_column_names->size();
 
-    for (size_t num_rows = chunk->get()->num_rows(); num_rows < chunk_size; /**/) {
-        status = down_cast<HdfsScannerCSVReader*>(_reader.get())->next_record(&record);
+    size_t num_rows = 0;
+    while (num_rows < chunk_size) {
+        status = reader->next_record(&record);
         if (status.is_end_of_file()) {
             if (_current_range_index == _scanner_params.scan_ranges.size() - 1) {
                 break;
@@ -170,6 +264,7 @@ Status HdfsTextScanner::parse_csv(int chunk_size, ChunkPtr* chunk) {
             // 2. should stop scan
             _current_range_index++;
             RETURN_IF_ERROR(_create_or_reinit_reader());
+            reader = down_cast<HdfsScannerCSVReader*>(_reader.get());
             continue;
         } else if (!status.ok()) {
             LOG(WARNING) << "Status is not ok " << status.get_error_msg();
@@ -179,23 +274,22 @@ Status HdfsTextScanner::parse_csv(int chunk_size, ChunkPtr* chunk) {
             continue;
         }
 
-        fields.clear();
-        _reader->split_record(record, &fields);
-
         if (!validate_utf8(record.data, record.size)) {
             continue;
         }
 
-        bool has_error = false;
-        int num_materialize_columns = _scanner_params.materialize_slots.size();
+        fields.clear();
+        reader->split_record(record, &fields);
+
         int field_size = fields.size();
-        if (_scanner_params.hive_column_names->size() != field_size) {
+        if (num_hive_columns != fields.size()) {
             VLOG(7) << strings::Substitute("Size mismatch between hive column $0 names and fields $1!",
-                                           _scanner_params.hive_column_names->size(), fields.size());
+                                           num_hive_columns, fields.size());
         }
+        bool has_error = false;
         for (int j = 0; j < num_materialize_columns; j++) {
             int index = _scanner_params.materialize_index_in_chunk[j];
-            int column_field_index = _columns_index[_scanner_params.materialize_slots[j]->col_name()];
+            int column_field_index = _field_indexes[j];
             Column* column = _column_raw_ptrs[index];
             if (column_field_index < field_size) {
                 const Slice& field = fields[column_field_index];
@@ -203,7 +297,6 @@ Status HdfsTextScanner::parse_csv(int chunk_size, ChunkPtr* chunk) {
                 if (!_converters[j]->read_string(column, field, options)) {
                     LOG(WARNING) << "Converter encountered an error for field " << field.to_string() << ", index "
                                  << index << ", column " << _scanner_params.materialize_slots[j]->debug_string();
-                    chunk->get()->set_num_rows(num_rows);
                     has_error = true;
                     break;
                 }
@@ -216,39 +309,55 @@ Status HdfsTextScanner::parse_csv(int chunk_size, ChunkPtr* chunk) {
                 column->append_nulls(1);
             }
         }
-        num_rows += !has_error;
-        if (!has_error) {
-            // Partition column not stored in text file, we should append these columns
-            // when we select partition column.
-            int num_part_columns = _file_read_param.partition_columns.size();
-            for (int p = 0; p < num_part_columns; ++p) {
-                int index = _scanner_params.partition_index_in_chunk[p];
-                Column* column = _column_raw_ptrs[index];
-                ColumnPtr partition_value = _file_read_param.partition_values[p];
-                DCHECK(partition_value->is_constant());
-                auto* const_column = vectorized::ColumnHelper::as_raw_column<vectorized::ConstColumn>(partition_value);
-                ColumnPtr data_column = const_column->data_column();
-                if (data_column->is_nullable()) {
-                    column->append_nulls(1);
-                } else {
-                    column->append(*data_column, 0, 1);
-                }
+        if (has_error) {
+            // drop the values of the row appended before the error
+            for (int j = 0; j < num_materialize_columns; j++) {
+                _column_raw_ptrs[_scanner_params.materialize_index_in_chunk[j]]->resize(num_rows);
             }
+            continue;
         }
+        num_rows++;
     }
+    // Partition column not stored in text file, we should append these columns
+    // when we select partition column.
+    _fill_partition_columns(num_rows);
     return chunk->get()->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
 }
 
+void HdfsTextScanner::_fill_partition_columns(size_t num_rows) {
+    if (num_rows == 0) {
+        return;
+    }
+    int num_part_columns = _file_read_param.partition_columns.size();
+    for (int p = 0; p < num_part_columns; ++p) {
+        int index = _scanner_params.partition_index_in_chunk[p];
+        Column* column = _column_raw_ptrs[index];
+        ColumnPtr partition_value = _file_read_param.partition_values[p];
+        DCHECK(partition_value->is_constant());
+        auto* const_column = vectorized::ColumnHelper::as_raw_column<vectorized::ConstColumn>(partition_value);
+        ColumnPtr data_column = const_column->data_column();
+        if (data_column->is_nullable()) {
+            column->append_nulls(num_rows);
+        } else {
+            column->append_value_multiple_times(*data_column, 0, num_rows);
+        }
+    }
+}
+
 Status HdfsTextScanner::_create_or_reinit_reader() {
     const THdfsScanRange* scan_range = _scanner_params.scan_ranges[_current_range_index];
     if (_current_range_index == 0) {
-        _reader =
+        auto reader =
                 std::make_unique<HdfsScannerCSVReader>(_scanner_params.fs, _record_delimiter, _field_delimiter,
                                                        scan_range->offset, scan_range->length, scan_range->file_length);
+        if (_compression != CompressionTypePB::NO_COMPRESSION) {
+            RETURN_IF_ERROR(reader->init_decompression(_compression));
+        }
+        _reader = std::move(reader);
     } else {
         down_cast<HdfsScannerCSVReader*>(_reader.get())->reset(scan_range->offset, scan_range->length);
     }
-    if (scan_range->offset != 0) {
+    if (scan_range->offset != 0 && _compression == CompressionTypePB::NO_COMPRESSION) {
         // Always skip first record of scan range with non-zero offset.
         // Notice that the first record will read by previous scan range.
         CSVReader::Record dummy;
@@ -257,11 +366,11 @@ Status HdfsTextScanner::_create_or_reinit_reader() {
     return Status::OK();
 }
 
-Status HdfsTextScanner::_get_hive_column_index(const std::string& column_name) {
+Status HdfsTextScanner::_get_hive_column_index(const std::string& column_name, int* index) {
     for (int i = 0; i < _scanner_params.hive_column_names->size(); i++) {
         const std::string& name = _scanner_params.hive_column_names->at(i);
         if (name == column_name) {
-            _columns_index[name] = i;
+            *index = i;
             return Status::OK();
         }
     }
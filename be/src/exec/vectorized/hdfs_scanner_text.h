@@ -5,6 +5,7 @@
 #include "exec/vectorized/hdfs_scanner.h"
 #include "formats/csv/converter.h"
 #include "formats/csv/csv_reader.h"
+#include "gen_cpp/types.pb.h"
 
 namespace starrocks::vectorized {
 
@@ -22,7 +23,9 @@ public:
 private:
     // create a reader or re init reader
     Status _create_or_reinit_reader();
-    Status _get_hive_column_index(const std::string& column_name);
+    Status _get_hive_column_index(const std::string& column_name, int* index);
+    // Appends the values of the partition columns to the |num_rows| rows parsed.
+    void _fill_partition_columns(size_t num_rows);
 
     using ConverterPtr = std::unique_ptr<csv::Converter>;
     char _record_delimiter;
@@ -31,6 +34,9 @@ private:
     std::vector<ConverterPtr> _converters;
     std::shared_ptr<CSVReader> _reader = nullptr;
     size_t _current_range_index = 0;
-    std::unordered_map<std::string, int> _columns_index;
+    // the index of the field of each materialized slot in the records
+    std::vector<int> _field_indexes;
+    // the compressed files are read as a whole from the beginning, so they're not split
+    CompressionTypePB _compression = CompressionTypePB::NO_COMPRESSION;
 };
 } // namespace starrocks::vectorized
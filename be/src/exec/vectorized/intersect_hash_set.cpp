@@ -7,6 +7,16 @@
 #include "util/phmap/phmap_dump.h"
 
 namespace starrocks::vectorized {
+
+static Columns evaluate_key_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs) {
+    Columns key_columns;
+    key_columns.reserve(exprs.size());
+    for (auto* expr : exprs) {
+        key_columns.emplace_back(expr->evaluate(chunk.get()));
+    }
+    return key_columns;
+}
+
 template <typename HashSet>
 Status IntersectHashSet<HashSet>::init(RuntimeState* state) {
     _hash_set = std::make_unique<HashSet>();
@@ -19,10 +29,14 @@ Status IntersectHashSet<HashSet>::init(RuntimeState* state) {
 template <typename HashSet>
 void IntersectHashSet<HashSet>::build_set(RuntimeState* state, const ChunkPtr& chunkPtr,
                                           const std::vector<ExprContext*>& exprs, MemPool* pool) {
-    size_t chunk_size = chunkPtr->num_rows();
+    build_set(state, evaluate_key_columns(chunkPtr, exprs), chunkPtr->num_rows(), pool);
+}
 
+template <typename HashSet>
+void IntersectHashSet<HashSet>::build_set(RuntimeState* state, const Columns& key_columns, size_t chunk_size,
+                                          MemPool* pool) {
     _slice_sizes.assign(state->chunk_size(), 0);
-    size_t cur_max_one_row_size = _get_max_serialize_size(chunkPtr, exprs);
+    size_t cur_max_one_row_size = _get_max_serialize_size(key_columns);
     if (UNLIKELY(cur_max_one_row_size > _max_one_row_size)) {
         _max_one_row_size = cur_max_one_row_size;
         _mem_pool->clear();
@@ -30,7 +44,7 @@ void IntersectHashSet<HashSet>::build_set(RuntimeState* state, const ChunkPtr& c
         THROW_BAD_ALLOC_IF_NULL(_buffer);
     }
 
-    _serialize_columns(chunkPtr, exprs, chunk_size);
+    _serialize_columns(key_columns, chunk_size);
 
     for (size_t i = 0; i < chunk_size; ++i) {
         IntersectSliceFlag key(_buffer + i * _max_one_row_size, _slice_sizes[i]);
@@ -47,9 +61,14 @@ void IntersectHashSet<HashSet>::build_set(RuntimeState* state, const ChunkPtr& c
 template <typename HashSet>
 Status IntersectHashSet<HashSet>::refine_intersect_row(RuntimeState* state, const ChunkPtr& chunkPtr,
                                                        const std::vector<ExprContext*>& exprs, const int hit_times) {
-    size_t chunk_size = chunkPtr->num_rows();
+    return refine_intersect_row(state, evaluate_key_columns(chunkPtr, exprs), chunkPtr->num_rows(), hit_times);
+}
+
+template <typename HashSet>
+Status IntersectHashSet<HashSet>::refine_intersect_row(RuntimeState* state, const Columns& key_columns,
+                                                       size_t chunk_size, const int hit_times) {
     _slice_sizes.assign(state->chunk_size(), 0);
-    size_t cur_max_one_row_size = _get_max_serialize_size(chunkPtr, exprs);
+    size_t cur_max_one_row_size = _get_max_serialize_size(key_columns);
     if (UNLIKELY(cur_max_one_row_size > _max_one_row_size)) {
         _max_one_row_size = cur_max_one_row_size;
         _mem_pool->clear();
@@ -60,7 +79,7 @@ Status IntersectHashSet<HashSet>::refine_intersect_row(RuntimeState* state, cons
         RETURN_IF_LIMIT_EXCEEDED(state, "Intersect, while probe hash table.");
     }
 
-    _serialize_columns(chunkPtr, exprs, chunk_size);
+    _serialize_columns(key_columns, chunk_size);
 
     for (size_t i = 0; i < chunk_size; ++i) {
         IntersectSliceFlag key(_buffer + i * _max_one_row_size, _slice_sizes[i]);
@@ -102,11 +121,9 @@ int64_t IntersectHashSet<HashSet>::mem_usage() const {
 }
 
 template <typename HashSet>
-size_t IntersectHashSet<HashSet>::_get_max_serialize_size(const ChunkPtr& chunkPtr,
-                                                          const std::vector<ExprContext*>& exprs) {
+size_t IntersectHashSet<HashSet>::_get_max_serialize_size(const Columns& key_columns) {
     size_t max_size = 0;
-    for (auto* expr : exprs) {
-        ColumnPtr key_column = expr->evaluate(chunkPtr.get());
+    for (const auto& key_column : key_columns) {
         max_size += key_column->max_one_element_serialize_size();
         if (!key_column->is_nullable()) {
             max_size += sizeof(bool);
@@ -116,11 +133,8 @@ size_t IntersectHashSet<HashSet>::_get_max_serialize_size(const ChunkPtr& chunkP
 }
 
 template <typename HashSet>
-void IntersectHashSet<HashSet>::_serialize_columns(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs,
-                                                   size_t chunk_size) {
-    for (auto expr : exprs) {
-        ColumnPtr key_column = expr->evaluate(chunkPtr.get());
-
+void IntersectHashSet<HashSet>::_serialize_columns(const Columns& key_columns, size_t chunk_size) {
+    for (const auto& key_column : key_columns) {
         // The serialized buffer is always nullable.
         if (key_column->is_nullable()) {
             key_column->serialize_batch(_buffer, _slice_sizes, chunk_size, _max_one_row_size);
@@ -58,14 +58,19 @@ public:
     Status refine_intersect_row(RuntimeState* state, const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs,
                                 int hit_times);
 
+    // The same as above with the evaluated key columns of |num_rows| rows, e.g. the ones of a spilled partition.
+    void build_set(RuntimeState* state, const Columns& key_columns, size_t num_rows, MemPool* pool);
+
+    Status refine_intersect_row(RuntimeState* state, const Columns& key_columns, size_t num_rows, int hit_times);
+
     void deserialize_to_columns(KeyVector& keys, const Columns& key_columns, size_t chunk_size);
 
     int64_t mem_usage() const;
 
 private:
-    void _serialize_columns(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs, size_t chunk_size);
+    void _serialize_columns(const Columns& key_columns, size_t chunk_size);
 
-    size_t _get_max_serialize_size(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs);
+    size_t _get_max_serialize_size(const Columns& key_columns);
 
     std::unique_ptr<HashSet> _hash_set;
 
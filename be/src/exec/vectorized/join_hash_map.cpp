@@ -6,6 +6,9 @@
 #include <gen_cpp/PlanNodes_types.h>
 #include <runtime/descriptors.h>
 
+#include <unordered_map>
+
+#include "common/config.h"
 #include "exec/vectorized/hash_join_node.h"
 #include "serde/column_array_serde.h"
 #include "simd/simd.h"
@@ -164,9 +167,8 @@ void SerializedJoinProbeFunc::_probe_column(const JoinHashTableItems& table_item
         ptr += probe_state->probe_slice[i].size;
     }
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads<Slice>(table_items, probe_state, table_items.build_slice, nullptr,
+                                                  row_count);
 }
 
 void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
@@ -194,11 +196,10 @@ void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& t
         if (probe_state->is_nulls[i] == 0) {
             probe_state->buckets[i] =
                     JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
         }
     }
+    JoinHashMapHelper::lookup_bucket_heads<Slice>(table_items, probe_state, table_items.build_slice,
+                                                  probe_state->is_nulls.data(), row_count);
 }
 
 JoinHashTable::~JoinHashTable() {}
@@ -210,7 +211,7 @@ void JoinHashTable::close() {
 
 void JoinHashTable::create(const HashTableParam& param) {
     _need_create_tuple_columns = param.need_create_tuple_columns;
-    _table_items = std::make_unique<JoinHashTableItems>();
+    _table_items = std::make_shared<JoinHashTableItems>();
     _probe_state = std::make_unique<HashTableProbeState>();
 
     _table_items->row_count = 0;
@@ -300,6 +301,8 @@ Status JoinHashTable::build(RuntimeState* state) {
     _table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items->row_count + 1);
     _table_items->first.resize(_table_items->bucket_size, 0);
     _table_items->next.resize(_table_items->row_count + 1, 0);
+    _init_probe_prefetch();
+    _init_hash_mixing();
     if (_table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items->join_type == TJoinOp::FULL_OUTER_JOIN ||
         _table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN) {
         _probe_state->build_match_index.resize(_table_items->row_count + 1, 0);
@@ -322,9 +325,176 @@ Status JoinHashTable::build(RuntimeState* state) {
         return Status::InternalError("not supported");
     }
 
+    _cluster_build_rows();
     return Status::OK();
 }
 
+StatusOr<bool> JoinHashTable::prepare_parallel_build(RuntimeState* state) {
+    JoinHashMapType hash_map_type = _choose_join_hash_map();
+    switch (hash_map_type) {
+#define M(NAME)                                                                         \
+    case JoinHashMapType::NAME:                                                         \
+        if (!decltype(_##NAME)::element_type::support_parallel_build()) return false; \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    default:
+        return false;
+    }
+
+    _hash_map_type = hash_map_type;
+    _table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items->row_count + 1);
+    _table_items->first.resize(_table_items->bucket_size, 0);
+    _table_items->next.resize(_table_items->row_count + 1, 0);
+    _init_probe_prefetch();
+    _init_hash_mixing();
+    JoinHashMapHelper::prepare_map_index(_probe_state.get(), state->chunk_size());
+
+    switch (_hash_map_type) {
+#define M(NAME)                                                                                                       \
+    case JoinHashMapType::NAME:                                                                                       \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), _probe_state.get()); \
+        RETURN_IF_ERROR(_##NAME->prepare_parallel_build(state));                                                      \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    default:
+        return Status::InternalError("not supported");
+    }
+    return true;
+}
+
+void JoinHashTable::calc_build_buckets(uint32_t start, uint32_t count, uint32_t* buckets) {
+    switch (_hash_map_type) {
+#define M(NAME)                                              \
+    case JoinHashMapType::NAME:                              \
+        _##NAME->calc_build_buckets(start, count, buckets); \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    default:
+        DCHECK(false) << "prepare_parallel_build() must be called first";
+    }
+}
+
+void JoinHashTable::link_rows(const uint32_t* rows, const uint32_t* buckets, size_t count) {
+    auto& first = _table_items->first;
+    auto& next = _table_items->next;
+    for (size_t i = 0; i < count; i++) {
+        next[rows[i]] = first[buckets[i]];
+        first[buckets[i]] = rows[i];
+    }
+}
+
+void JoinHashTable::share_built_table(RuntimeState* state, const JoinHashTable& other) {
+    DCHECK(_table_items->join_type != TJoinOp::RIGHT_OUTER_JOIN &&
+           _table_items->join_type != TJoinOp::FULL_OUTER_JOIN &&
+           _table_items->join_type != TJoinOp::RIGHT_SEMI_JOIN && _table_items->join_type != TJoinOp::RIGHT_ANTI_JOIN);
+    _table_items = other._table_items;
+    _hash_map_type = other._hash_map_type;
+    _probe_state = std::make_unique<HashTableProbeState>();
+    JoinHashMapHelper::prepare_map_index(_probe_state.get(), state->chunk_size());
+
+    switch (_hash_map_type) {
+    case JoinHashMapType::empty:
+        break;
+#define M(NAME)                                                                                                       \
+    case JoinHashMapType::NAME:                                                                                       \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), _probe_state.get()); \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    default:
+        break;
+    }
+}
+
+void JoinHashTable::_cluster_build_rows() {
+    auto* items = _table_items.get();
+    // Only worth it for the joins which output the build rows.
+    if (_hash_map_type == JoinHashMapType::empty || items->join_type == TJoinOp::LEFT_SEMI_JOIN ||
+        items->join_type == TJoinOp::LEFT_ANTI_JOIN || items->join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
+        config::join_cluster_build_rows_min_chain_length <= 0) {
+        return;
+    }
+    size_t num_chains = 0;
+    for (uint32_t bucket = 0; bucket < items->bucket_size; bucket++) {
+        num_chains += items->first[bucket] != 0;
+    }
+    if (num_chains == 0 || items->row_count < num_chains * config::join_cluster_build_rows_min_chain_length) {
+        return;
+    }
+
+    // order[new row] = old row, the rows of every chain are placed together in the order of the chain,
+    // and the rows not in any chain (null keys) are placed at the end.
+    uint32_t row_count = items->row_count;
+    std::vector<uint32_t> order;
+    order.reserve(row_count + 1);
+    order.push_back(0);
+    Buffer<uint8_t> linked(row_count + 1, 0);
+    Buffer<uint32_t> next(row_count + 1, 0);
+    for (uint32_t bucket = 0; bucket < items->bucket_size; bucket++) {
+        uint32_t index = items->first[bucket];
+        if (index == 0) {
+            continue;
+        }
+        items->first[bucket] = order.size();
+        for (; index != 0; index = items->next[index]) {
+            linked[index] = 1;
+            next[order.size()] = items->next[index] == 0 ? 0 : order.size() + 1;
+            order.push_back(index);
+        }
+    }
+    for (uint32_t i = 1; i <= row_count; i++) {
+        if (linked[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    DCHECK_EQ(order.size(), row_count + 1);
+    items->next.swap(next);
+
+    auto reorder = [&order](const ColumnPtr& column) {
+        ColumnPtr result = column->clone_empty();
+        result->append_selective(*column, order.data(), 0, order.size());
+        return result;
+    };
+    // The key columns may be the columns of build_chunk.
+    std::unordered_map<const Column*, ColumnPtr> reordered;
+    for (auto& column : items->build_chunk->columns()) {
+        ColumnPtr result = reorder(column);
+        reordered.emplace(column.get(), result);
+        column = std::move(result);
+    }
+    for (auto& column : items->key_columns) {
+        auto iter = reordered.find(column.get());
+        column = iter != reordered.end() ? iter->second : reorder(column);
+    }
+    if (items->build_key_column != nullptr) {
+        items->build_key_column = reorder(items->build_key_column);
+    }
+    if (!items->build_slice.empty()) {
+        Buffer<Slice> build_slice(order.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            build_slice[i] = items->build_slice[order[i]];
+        }
+        items->build_slice.swap(build_slice);
+    }
+    items->build_rows_clustered = true;
+}
+
+void JoinHashTable::_init_probe_prefetch() {
+    // The buckets, the chains and the keys are accessed randomly by the probe.
+    int64_t bytes = (_table_items->first.size() + _table_items->next.size()) * sizeof(uint32_t);
+    for (const auto& column : _table_items->key_columns) {
+        bytes += column->memory_usage();
+    }
+    _table_items->enable_probe_prefetch = config::enable_prefetch && bytes >= config::join_probe_prefetch_min_bytes;
+}
+
+void JoinHashTable::_init_hash_mixing() {
+    _table_items->hash_mixing = config::join_hash_mixing == "murmur3" ? JoinHashMixing::MURMUR3 : JoinHashMixing::CRC32;
+}
+
 Status JoinHashTable::probe(RuntimeState* state, const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk,
                             bool* eos) {
     switch (_hash_map_type) {
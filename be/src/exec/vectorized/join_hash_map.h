@@ -74,6 +74,11 @@ struct HashTableSlotDescriptor {
     bool need_output;
 };
 
+// The hash of the fixed-size keys of the join hash table, see config::join_hash_mixing. CRC32 takes one
+// instruction per key, MURMUR3 mixes the keys better and is vectorized over a chunk, the buckets are computed
+// a chunk at a time anyway.
+enum class JoinHashMixing { CRC32, MURMUR3 };
+
 struct JoinHashTableItems {
     //TODO: memory continus problem?
     ChunkPtr build_chunk = nullptr;
@@ -102,6 +107,13 @@ struct JoinHashTableItems {
     bool need_create_tuple_columns = true;
     bool left_to_nullable = false;
     bool right_to_nullable = false;
+    // Whether the probe prefetches the hash table, see JoinHashMapHelper::lookup_bucket_heads().
+    bool enable_probe_prefetch = false;
+    // Whether the rows of every bucket are contiguous in build_chunk, in the order of the chain, i.e.
+    // next[i] is either i + 1 or 0, see JoinHashTable::_cluster_build_rows().
+    bool build_rows_clustered = false;
+    // How the fixed-size keys are hashed into the buckets, chosen when the table is built.
+    JoinHashMixing hash_mixing = JoinHashMixing::CRC32;
 
     TJoinOp::type join_type = TJoinOp::INNER_JOIN;
 
@@ -218,6 +230,8 @@ class JoinHashMapHelper {
 public:
     // maxinum bucket size
     const static uint32_t MAX_BUCKET_SIZE = 1 << 31;
+    // Bucket of the build rows with null keys, which are not linked into the hash table.
+    const static uint32_t NULL_BUCKET = UINT32_MAX;
 
     static uint32_t calc_bucket_size(uint32_t size) {
         size_t expect_bucket_size = static_cast<size_t>(size) + (size - 1) / 7;
@@ -235,11 +249,82 @@ public:
         return HashFunc()(value) & (bucket_size - 1);
     }
 
+    template <typename CppType>
+    static constexpr bool can_mix_hash() {
+        return std::is_integral_v<CppType> && (sizeof(CppType) == 4 || sizeof(CppType) == 8);
+    }
+
+    template <typename CppType>
+    static uint32_t calc_bucket_num(const CppType& value, uint32_t bucket_size, JoinHashMixing mixing) {
+        if constexpr (can_mix_hash<CppType>()) {
+            if (mixing == JoinHashMixing::MURMUR3) {
+                return _murmur_hash(value) & (bucket_size - 1);
+            }
+        }
+        return calc_bucket_num<CppType>(value, bucket_size);
+    }
+
+    // Computes the buckets of data[start, start + count) into buckets[0, count), the mixing is chosen once
+    // for the batch so that the loop is vectorized.
+    template <typename CppType>
+    static void calc_bucket_nums(const CppType* data, uint32_t bucket_size, uint32_t* buckets, uint32_t start,
+                                 uint32_t count, JoinHashMixing mixing = JoinHashMixing::CRC32) {
+        data += start;
+        if constexpr (can_mix_hash<CppType>()) {
+            if (mixing == JoinHashMixing::MURMUR3) {
+                for (uint32_t i = 0; i < count; i++) {
+                    buckets[i] = _murmur_hash(data[i]) & (bucket_size - 1);
+                }
+                return;
+            }
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            buckets[i] = calc_bucket_num<CppType>(data[i], bucket_size);
+        }
+    }
+
     template <typename CppType>
     static void calc_bucket_nums(const Buffer<CppType>& data, uint32_t bucket_size, Buffer<uint32_t>* buckets,
-                                 uint32_t start, uint32_t count) {
-        for (size_t i = 0; i < count; i++) {
-            (*buckets)[i] = calc_bucket_num<CppType>(data[start + i], bucket_size);
+                                 uint32_t start, uint32_t count, JoinHashMixing mixing = JoinHashMixing::CRC32) {
+        calc_bucket_nums<CppType>(data.data(), bucket_size, buckets->data(), start, count, mixing);
+    }
+
+    // Distance in probe rows of prefetching the buckets ahead of the lookups.
+    static constexpr uint32_t PREFETCH_DISTANCE = 16;
+
+    // Look up the heads of the bucket chains of the probe rows into probe_state->next, nothing is found for
+    // the rows whose |is_nulls| is not zero. To hide the cache misses of a large hash table, the buckets of the
+    // rows PREFETCH_DISTANCE ahead are prefetched, and so are the build keys and the next rows of the heads,
+    // which are walked through by the probe of the chunk soon.
+    template <typename CppType>
+    static void lookup_bucket_heads(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                                    const Buffer<CppType>& build_data, const uint8_t* is_nulls, uint32_t row_count) {
+        const auto& first = table_items.first;
+        const auto& buckets = probe_state->buckets;
+        auto& next = probe_state->next;
+        if (!table_items.enable_probe_prefetch) {
+            if (is_nulls == nullptr) {
+                for (uint32_t i = 0; i < row_count; i++) {
+                    next[i] = first[buckets[i]];
+                }
+            } else {
+                for (uint32_t i = 0; i < row_count; i++) {
+                    next[i] = is_nulls[i] == 0 ? first[buckets[i]] : 0;
+                }
+            }
+            return;
+        }
+
+        for (uint32_t i = 0; i < row_count; i++) {
+            if (i + PREFETCH_DISTANCE < row_count) {
+                __builtin_prefetch(&first[buckets[i + PREFETCH_DISTANCE]]);
+            }
+            uint32_t head = (is_nulls == nullptr || is_nulls[i] == 0) ? first[buckets[i]] : 0;
+            next[i] = head;
+            if (head != 0) {
+                __builtin_prefetch(&build_data[head]);
+                __builtin_prefetch(&table_items.next[head]);
+            }
         }
     }
 
@@ -277,6 +362,16 @@ public:
             byte_offset += offset;
         }
     }
+
+private:
+    template <typename CppType>
+    static uint32_t _murmur_hash(CppType value) {
+        if constexpr (sizeof(CppType) == 4) {
+            return fmix32(static_cast<uint32_t>(value));
+        } else {
+            return static_cast<uint32_t>(fmix64(static_cast<uint64_t>(value)));
+        }
+    }
 };
 
 template <PrimitiveType PT>
@@ -293,6 +388,12 @@ public:
     static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items);
     static Status construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
                                        HashTableProbeState* probe_state);
+
+    static constexpr bool support_parallel_build = true;
+    // Calculate the buckets of the build rows [start, start + count) into |buckets|, used by the parallel build.
+    // It's thread-safe for disjoint rows after prepare().
+    static void calc_build_buckets(JoinHashTableItems* table_items, uint32_t start, uint32_t count,
+                                   uint32_t* buckets);
 };
 
 template <PrimitiveType PT>
@@ -309,7 +410,14 @@ public:
     static Status construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
                                        HashTableProbeState* probe_state);
 
+    static constexpr bool support_parallel_build = true;
+    static void calc_build_buckets(JoinHashTableItems* table_items, uint32_t start, uint32_t count,
+                                   uint32_t* buckets);
+
 private:
+    static void _prepare_data_columns(const JoinHashTableItems& table_items, Columns* data_columns,
+                                      NullColumns* null_columns);
+
     static void _build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
                                const Columns& data_columns, uint32_t start, uint32_t count);
 
@@ -325,6 +433,11 @@ public:
     static Status construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
                                        HashTableProbeState* probe_state);
 
+    // The keys are serialized into the MemPool of JoinHashTableItems, which is not thread-safe.
+    static constexpr bool support_parallel_build = false;
+    static void calc_build_buckets(JoinHashTableItems* table_items, uint32_t start, uint32_t count,
+                                   uint32_t* buckets) {}
+
 private:
     static void _build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
                                const Columns& data_columns, uint32_t start, uint32_t count, uint8_t** ptr);
@@ -405,6 +518,12 @@ public:
                  bool* has_remain);
     Status probe_remain(RuntimeState* state, ChunkPtr* chunk, bool* has_remain);
 
+    static constexpr bool support_parallel_build() { return BuildFunc::support_parallel_build; }
+    Status prepare_parallel_build(RuntimeState* state) { return BuildFunc().prepare(state, _table_items, _probe_state); }
+    void calc_build_buckets(uint32_t start, uint32_t count, uint32_t* buckets) {
+        BuildFunc::calc_build_buckets(_table_items, start, count, buckets);
+    }
+
 private:
     Status _probe_output(ChunkPtr* probe_chunk, ChunkPtr* chunk);
     void _probe_tuple_output(ChunkPtr* probe_chunk, ChunkPtr* chunk);
@@ -421,6 +540,7 @@ private:
     void _copy_build_column(const ColumnPtr& src_column, ChunkPtr* chunk, const SlotDescriptor* slot, bool to_nullable);
 
     void _copy_build_nullable_column(const ColumnPtr& src_column, ChunkPtr* chunk, const SlotDescriptor* slot);
+    void _append_build_rows(const Column& src_column, Column* dest_column);
 
     Status _search_ht(RuntimeState* state, ChunkPtr* probe_chunk);
     void _search_ht_remain(RuntimeState* state);
@@ -521,6 +641,18 @@ public:
     Status probe(RuntimeState* state, const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk, bool* eos);
     Status probe_remain(RuntimeState* state, ChunkPtr* chunk, bool* eos);
 
+    // The parallel build is an alternative of build(), which is done in phases by multiple threads:
+    // 1. prepare_parallel_build() by one thread, false means the keys don't support it, and build() must be used.
+    // 2. calc_build_buckets() of the disjoint ranges of the rows [1, get_row_count()] by multiple threads.
+    // 3. link_rows() after all the buckets are calculated, the buckets linked by each thread must be disjoint.
+    StatusOr<bool> prepare_parallel_build(RuntimeState* state);
+    void calc_build_buckets(uint32_t start, uint32_t count, uint32_t* buckets);
+    void link_rows(const uint32_t* rows, const uint32_t* buckets, size_t count);
+
+    // Probe the hash table built by |other| instead of its own, the hash table is read-only from now on.
+    // Not supported for the joins which mark the matched build rows during probe.
+    void share_built_table(RuntimeState* state, const JoinHashTable& other);
+
     Status append_chunk(RuntimeState* state, const ChunkPtr& chunk);
 
     const ChunkPtr& get_build_chunk() const { return _table_items->build_chunk; }
@@ -554,6 +686,12 @@ public:
 
 private:
     JoinHashMapType _choose_join_hash_map();
+    // Must be called after the buckets are allocated.
+    void _init_probe_prefetch();
+    void _init_hash_mixing();
+    // Reorder the build rows by bucket after the hash table is built, so the matched build rows of a probe row
+    // are copied by ranges instead of gathered row by row.
+    void _cluster_build_rows();
     static size_t _get_size_of_fixed_and_contiguous_type(PrimitiveType data_type);
 
     void _remove_duplicate_index_for_left_outer_join(Column::Filter* filter);
@@ -587,7 +725,8 @@ private:
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
     bool _need_create_tuple_columns = true;
 
-    std::unique_ptr<JoinHashTableItems> _table_items;
+    // Shared by the JoinHashTables of the same broadcast join, see share_built_table().
+    std::shared_ptr<JoinHashTableItems> _table_items;
     std::unique_ptr<HashTableProbeState> _probe_state;
 };
 } // namespace starrocks::vectorized
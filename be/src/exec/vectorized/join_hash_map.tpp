@@ -23,14 +23,16 @@ Status JoinBuildFunc<PT>::construct_hash_table(RuntimeState* state, JoinHashTabl
         auto& null_array = nullable_column->null_column()->get_data();
         for (size_t i = 1; i < table_items->row_count + 1; i++) {
             if (null_array[i] == 0) {
-                uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
+                uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size,
+                                                                                  table_items->hash_mixing);
                 table_items->next[i] = table_items->first[bucket_num];
                 table_items->first[bucket_num] = i;
             }
         }
     } else {
         for (size_t i = 1; i < table_items->row_count + 1; i++) {
-            uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
+            uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size,
+                                                                              table_items->hash_mixing);
             table_items->next[i] = table_items->first[bucket_num];
             table_items->first[bucket_num] = i;
         }
@@ -38,6 +40,23 @@ Status JoinBuildFunc<PT>::construct_hash_table(RuntimeState* state, JoinHashTabl
     return Status::OK();
 }
 
+template <PrimitiveType PT>
+void JoinBuildFunc<PT>::calc_build_buckets(JoinHashTableItems* table_items, uint32_t start, uint32_t count,
+                                           uint32_t* buckets) {
+    const auto& data = get_key_data(*table_items);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data.data(), table_items->bucket_size, buckets, start, count,
+                                                 table_items->hash_mixing);
+    if (table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
+        const auto& null_array = nullable_column->null_column()->get_data();
+        for (uint32_t i = 0; i < count; i++) {
+            if (null_array[start + i] != 0) {
+                buckets[i] = JoinHashMapHelper::NULL_BUCKET;
+            }
+        }
+    }
+}
+
 template <PrimitiveType PT>
 Status FixedSizeJoinBuildFunc<PT>::prepare(RuntimeState* state, JoinHashTableItems* table_items,
                                            HashTableProbeState* probe_state) {
@@ -55,19 +74,7 @@ Status FixedSizeJoinBuildFunc<PT>::construct_hash_table(RuntimeState* state, Joi
     // prepare columns
     Columns data_columns;
     NullColumns null_columns;
-    for (size_t i = 0; i < table_items->key_columns.size(); i++) {
-        if (table_items->join_keys[i].is_null_safe_equal) {
-            data_columns.emplace_back(table_items->key_columns[i]);
-        } else if (table_items->key_columns[i]->is_nullable()) {
-            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[i]);
-            data_columns.emplace_back(nullable_column->data_column());
-            if (table_items->key_columns[i]->has_null()) {
-                null_columns.emplace_back(nullable_column->null_column());
-            }
-        } else {
-            data_columns.emplace_back(table_items->key_columns[i]);
-        }
-    }
+    _prepare_data_columns(*table_items, &data_columns, &null_columns);
 
     // serialize and build hash table
     uint32_t quo = row_count / state->chunk_size();
@@ -91,6 +98,47 @@ Status FixedSizeJoinBuildFunc<PT>::construct_hash_table(RuntimeState* state, Joi
     return Status::OK();
 }
 
+template <PrimitiveType PT>
+void FixedSizeJoinBuildFunc<PT>::calc_build_buckets(JoinHashTableItems* table_items, uint32_t start, uint32_t count,
+                                                    uint32_t* buckets) {
+    Columns data_columns;
+    NullColumns null_columns;
+    _prepare_data_columns(*table_items, &data_columns, &null_columns);
+
+    // build_key_column is presized by prepare(), so the disjoint rows could be serialized concurrently.
+    JoinHashMapHelper::serialize_fixed_size_key_column<PT>(data_columns, table_items->build_key_column.get(), start,
+                                                           count);
+    const auto& data = get_key_data(*table_items);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data.data(), table_items->bucket_size, buckets, start, count,
+                                                 table_items->hash_mixing);
+    for (const auto& null_column : null_columns) {
+        const auto& null_array = null_column->get_data();
+        for (uint32_t i = 0; i < count; i++) {
+            if (null_array[start + i] != 0) {
+                buckets[i] = JoinHashMapHelper::NULL_BUCKET;
+            }
+        }
+    }
+}
+
+template <PrimitiveType PT>
+void FixedSizeJoinBuildFunc<PT>::_prepare_data_columns(const JoinHashTableItems& table_items, Columns* data_columns,
+                                                       NullColumns* null_columns) {
+    for (size_t i = 0; i < table_items.key_columns.size(); i++) {
+        if (table_items.join_keys[i].is_null_safe_equal) {
+            data_columns->emplace_back(table_items.key_columns[i]);
+        } else if (table_items.key_columns[i]->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items.key_columns[i]);
+            data_columns->emplace_back(nullable_column->data_column());
+            if (table_items.key_columns[i]->has_null()) {
+                null_columns->emplace_back(nullable_column->null_column());
+            }
+        } else {
+            data_columns->emplace_back(table_items.key_columns[i]);
+        }
+    }
+}
+
 template <PrimitiveType PT>
 void FixedSizeJoinBuildFunc<PT>::_build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
                                                 const Columns& data_columns, uint32_t start, uint32_t count) {
@@ -98,7 +146,8 @@ void FixedSizeJoinBuildFunc<PT>::_build_columns(JoinHashTableItems* table_items,
                                                            count);
 
     const auto& data = get_key_data(*table_items);
-    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count,
+                                                 table_items->hash_mixing);
 
     for (uint32_t i = 0; i < count; i++) {
         table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
@@ -123,7 +172,8 @@ void FixedSizeJoinBuildFunc<PT>::_build_nullable_columns(JoinHashTableItems* tab
     JoinHashMapHelper::serialize_fixed_size_key_column<PT>(data_columns, table_items->build_key_column.get(), start,
                                                            count);
     const auto& data = get_key_data(*table_items);
-    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count,
+                                                 table_items->hash_mixing);
 
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
@@ -137,33 +187,27 @@ template <PrimitiveType PT>
 Status JoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state) {
     size_t probe_row_count = probe_state->probe_row_count;
     auto& data = get_key_data(*probe_state);
-    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, data.size());
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, data.size(),
+                                                 table_items.hash_mixing);
 
+    const auto& build_data = JoinBuildFunc<PT>::get_key_data(table_items);
     if ((*probe_state->key_columns)[0]->is_nullable()) {
         auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
 
         if (nullable_column->has_null()) {
             auto& null_array = nullable_column->null_column()->get_data();
-            for (size_t i = 0; i < probe_row_count; i++) {
-                if (null_array[i] == 0) {
-                    probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-                } else {
-                    probe_state->next[i] = 0;
-                }
-            }
+            JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, probe_state, build_data, null_array.data(),
+                                                            probe_row_count);
             probe_state->null_array = &nullable_column->null_column()->get_data();
         } else {
-            for (size_t i = 0; i < probe_row_count; i++) {
-                probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-            }
+            JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, probe_state, build_data, nullptr,
+                                                            probe_row_count);
             probe_state->null_array = nullptr;
         }
         return Status::OK();
     }
 
-    for (size_t i = 0; i < probe_row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, probe_state, build_data, nullptr, probe_row_count);
     probe_state->null_array = nullptr;
     return Status::OK();
 }
@@ -223,11 +267,11 @@ void FixedSizeJoinProbeFunc<PT>::_probe_column(const JoinHashTableItems& table_i
     JoinHashMapHelper::serialize_fixed_size_key_column<PT>(data_columns, probe_state->probe_key_column.get(), 0,
                                                            row_count);
     const auto& data = get_key_data(*probe_state);
-    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
-
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count,
+                                                 table_items.hash_mixing);
+    JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, probe_state,
+                                                    FixedSizeJoinBuildFunc<PT>::get_key_data(table_items), nullptr,
+                                                    row_count);
 }
 
 template <PrimitiveType PT>
@@ -248,15 +292,11 @@ void FixedSizeJoinProbeFunc<PT>::_probe_nullable_column(const JoinHashTableItems
     JoinHashMapHelper::serialize_fixed_size_key_column<PT>(data_columns, probe_state->probe_key_column.get(), 0,
                                                            row_count);
     const auto& data = get_key_data(*probe_state);
-    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
-
-    for (uint32_t i = 0; i < row_count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
-        }
-    }
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count,
+                                                 table_items.hash_mixing);
+    JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, probe_state,
+                                                    FixedSizeJoinBuildFunc<PT>::get_key_data(table_items),
+                                                    probe_state->is_nulls.data(), row_count);
 }
 
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
@@ -587,7 +627,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_build_column(const ColumnPtr&
     ColumnPtr dest_column = ColumnHelper::create_column(slot->type(), to_nullable);
 
     if (to_nullable) {
-        dest_column->append_selective(*src_column, _probe_state->build_index.data(), 0, _probe_state->count);
+        _append_build_rows(*src_column, dest_column.get());
 
         // When left outer join is executed,
         // build_index[i] Equal to 0 means it is not found in the hash table,
@@ -601,7 +641,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_build_column(const ColumnPtr&
             }
         }
     } else {
-        dest_column->append_selective(*src_column, _probe_state->build_index.data(), 0, _probe_state->count);
+        _append_build_rows(*src_column, dest_column.get());
     }
 
     (*chunk)->append_column(std::move(dest_column), slot->id());
@@ -612,7 +652,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_build_nullable_column(const Co
                                                                         const SlotDescriptor* slot) {
     ColumnPtr dest_column = ColumnHelper::create_column(slot->type(), true);
 
-    dest_column->append_selective(*src_column, _probe_state->build_index.data(), 0, _probe_state->count);
+    _append_build_rows(*src_column, dest_column.get());
 
     // When left outer join is executed,
     // build_index[i] Equal to 0 means it is not found in the hash table,
@@ -629,6 +669,31 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_build_nullable_column(const Co
     (*chunk)->append_column(std::move(dest_column), slot->id());
 }
 
+template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
+void JoinHashMap<PT, BuildFunc, ProbeFunc>::_append_build_rows(const Column& src_column, Column* dest_column) {
+    const auto& build_index = _probe_state->build_index;
+    size_t count = _probe_state->count;
+    if (_table_items->build_rows_clustered && count > 0) {
+        // The matched build rows of a probe row are contiguous, copy them by ranges if they are long enough.
+        static constexpr size_t MIN_RANGE_LENGTH = 4;
+        size_t num_ranges = 1;
+        for (size_t i = 1; i < count; i++) {
+            num_ranges += build_index[i] != build_index[i - 1] + 1;
+        }
+        if (num_ranges * MIN_RANGE_LENGTH <= count) {
+            size_t start = 0;
+            for (size_t i = 1; i <= count; i++) {
+                if (i == count || build_index[i] != build_index[i - 1] + 1) {
+                    dest_column->append(src_column, build_index[start], i - start);
+                    start = i;
+                }
+            }
+            return;
+        }
+    }
+    dest_column->append_selective(src_column, build_index.data(), 0, count);
+}
+
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 Status JoinHashMap<PT, BuildFunc, ProbeFunc>::_search_ht(RuntimeState* state, ChunkPtr* probe_chunk) {
     if (!_probe_state->has_remain) {
@@ -60,6 +60,7 @@ Status JsonScanner::open() {
 
     if (range.__isset.jsonpaths) {
         RETURN_IF_ERROR(_parse_json_paths(range.jsonpaths, &_json_paths));
+        _json_path_trie = JsonPathTrie::build(_json_paths, _src_slot_descriptors);
     }
     if (range.__isset.json_root) {
         JsonFunctions::parse_json_paths(range.json_root, &_root_paths);
@@ -294,6 +295,40 @@ ChunkPtr JsonScanner::_cast_chunk(const starrocks::vectorized::ChunkPtr& src_chu
     return cast_chunk;
 }
 
+std::unique_ptr<JsonPathTrie> JsonPathTrie::build(const std::vector<std::vector<SimpleJsonPath>>& paths,
+                                                  const std::vector<SlotDescriptor*>& slot_descs) {
+    auto trie = std::make_unique<JsonPathTrie>();
+    size_t num_slots = std::min(paths.size(), slot_descs.size());
+    for (size_t i = 0; i < num_slots; i++) {
+        if (slot_descs[i] == nullptr) {
+            continue;
+        }
+        const auto& path = paths[i];
+        // The first element is the $.
+        if (path.size() < 2) {
+            return nullptr;
+        }
+        Node* node = &trie->root;
+        node->num_slots++;
+        for (size_t j = 1; j < path.size(); j++) {
+            if (!path[j].is_valid || path[j].idx != -1 || path[j].key.empty() || node->slot_index >= 0) {
+                return nullptr;
+            }
+            auto& child = node->children[path[j].key];
+            if (child == nullptr) {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+            node->num_slots++;
+        }
+        if (node->slot_index >= 0 || !node->children.empty()) {
+            return nullptr;
+        }
+        node->slot_index = static_cast<int>(i);
+    }
+    return trie;
+}
+
 JsonReader::JsonReader(starrocks::RuntimeState* state, starrocks::vectorized::ScannerCounter* counter,
                        JsonScanner* scanner, std::shared_ptr<SequentialFile> file, bool strict_mode)
         : _state(state),
@@ -525,6 +560,18 @@ Status JsonReader::_construct_row(simdjson::ondemand::object* row, Chunk* chunk,
         // With json path.
 
         size_t slot_size = slot_descs.size();
+        if (_scanner->_json_path_trie != nullptr) {
+            _slot_found.assign(slot_size, 0);
+            size_t num_found = 0;
+            RETURN_IF_ERROR(_project_object(*row, _scanner->_json_path_trie->root, chunk, slot_descs, &num_found));
+            for (size_t i = 0; i < slot_size; i++) {
+                if (slot_descs[i] != nullptr && !_slot_found[i]) {
+                    chunk->get_column_by_slot_id(slot_descs[i]->id())->append_nulls(1);
+                }
+            }
+            return Status::OK();
+        }
+
         size_t jsonpath_size = _scanner->_json_paths.size();
         for (size_t i = 0; i < slot_size; i++) {
             if (slot_descs[i] == nullptr) {
@@ -549,6 +596,48 @@ Status JsonReader::_construct_row(simdjson::ondemand::object* row, Chunk* chunk,
     }
 }
 
+Status JsonReader::_project_object(simdjson::ondemand::object& obj, const JsonPathTrie::Node& node, Chunk* chunk,
+                                   const std::vector<SlotDescriptor*>& slot_descs, size_t* num_found) {
+    size_t found_before = *num_found;
+    for (auto field : obj) {
+        std::string_view key;
+        if (field.unescaped_key().get(key)) {
+            return Status::DataQualityError("Failed to iterate the fields of json object");
+        }
+        auto itr = node.children.find(key);
+        if (itr == node.children.end()) {
+            // The value of the field is skipped by the next iteration.
+            continue;
+        }
+        const auto& child = *itr->second;
+        simdjson::ondemand::value value;
+        if (field.value().get(value)) {
+            return Status::DataQualityError("Failed to iterate the fields of json object");
+        }
+        if (child.slot_index >= 0) {
+            // Only the first one of the duplicated keys is extracted, like find_field_unordered().
+            if (!_slot_found[child.slot_index]) {
+                SlotDescriptor* slot_desc = slot_descs[child.slot_index];
+                auto column = chunk->get_column_by_slot_id(slot_desc->id());
+                RETURN_IF_ERROR(_construct_column(value, column.get(), slot_desc->type(), slot_desc->col_name()));
+                _slot_found[child.slot_index] = 1;
+                (*num_found)++;
+            }
+        } else {
+            simdjson::ondemand::object child_obj;
+            // The value is not an object, the slots under it are null.
+            if (!value.get_object().get(child_obj)) {
+                RETURN_IF_ERROR(_project_object(child_obj, child, chunk, slot_descs, num_found));
+            }
+        }
+        if (*num_found - found_before == node.num_slots) {
+            // The rest of the object is skipped by the parent.
+            break;
+        }
+    }
+    return Status::OK();
+}
+
 // Try to reorder the slot_descs as the key order in json document.
 // Nothing would be done if got any error.
 void JsonReader::_reorder_column(std::vector<SlotDescriptor*>* slot_descs, simdjson::ondemand::object& obj) {
@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string_view>
+
 #include "column/nullable_column.h"
 #include "common/compiler_util.h"
 #include "env/env.h"
@@ -16,6 +20,26 @@
 namespace starrocks::vectorized {
 
 struct SimpleJsonPath;
+
+// The json paths of the slots compiled into a trie, so that a row is projected by iterating its fields once
+// and skipping the subtrees no slot asks for, instead of looking every path up from the root of the row.
+struct JsonPathTrie {
+    struct Node {
+        // index of the slot extracting the value of this node, -1 for the inner nodes
+        int slot_index = -1;
+        // number of the slots in this subtree, the iteration of an object stops once all of them are found
+        size_t num_slots = 0;
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+    };
+
+    // Returns nullptr if the paths can't be projected in a single pass, i.e. some path is the root, has an
+    // array index or is a prefix of another path. |slot_descs[i]| is extracted by |paths[i]|.
+    static std::unique_ptr<JsonPathTrie> build(const std::vector<std::vector<SimpleJsonPath>>& paths,
+                                               const std::vector<SlotDescriptor*>& slot_descs);
+
+    Node root;
+};
+
 class JsonReader;
 class JsonParser;
 class JsonScanner : public FileScanner {
@@ -57,6 +81,8 @@ private:
     ObjectPool _pool;
 
     std::vector<std::vector<SimpleJsonPath>> _json_paths;
+    // nullptr if the rows are projected by looking up each path of _json_paths.
+    std::unique_ptr<JsonPathTrie> _json_path_trie;
     std::vector<SimpleJsonPath> _root_paths;
     bool _strip_outer_array = false;
 };
@@ -87,6 +113,11 @@ private:
 
     Status _filter_row_with_jsonroot(simdjson::ondemand::object* row);
 
+    // Appends the values of the slots under |node| found in |obj|, |num_found| is increased by the number of
+    // the slots appended.
+    Status _project_object(simdjson::ondemand::object& obj, const JsonPathTrie::Node& node, Chunk* chunk,
+                           const std::vector<SlotDescriptor*>& slot_descs, size_t* num_found);
+
     Status _construct_column(simdjson::ondemand::value& value, Column* column, const TypeDescriptor& type_desc,
                              const std::string& col_name);
 
@@ -112,6 +143,8 @@ private:
 
     std::unique_ptr<JsonParser> _parser;
     bool _empty_parser = true;
+    // whether the slot has been appended for the current row, used by _project_object()
+    std::vector<uint8_t> _slot_found;
     // only used in unit test.
     // TODO: The semantics of Streaming Load And Routine Load is non-consistent.
     //       Import a json library supporting streaming parse.
@@ -1,9 +1,32 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
 #include "exec/vectorized/olap_meta_scan_node.h"
 
+#include <algorithm>
+
+#include "common/config.h"
+#include "util/countdown_latch.h"
+#include "util/threadpool.h"
+
 namespace starrocks {
 namespace vectorized {
 
+// The threads scanning the tablets, shared by all the meta scans. nullptr if it can't be built.
+static ThreadPool* meta_scan_thread_pool() {
+    static ThreadPool* s_pool = []() -> ThreadPool* {
+        std::unique_ptr<ThreadPool> pool;
+        Status st = ThreadPoolBuilder("meta_scan")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(1, config::meta_scan_threads))
+                            .build(&pool);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to build the meta scan thread pool, the tablets are scanned one by one: " << st;
+            return nullptr;
+        }
+        return pool.release();
+    }();
+    return s_pool;
+}
+
 OlapMetaScanNode::OlapMetaScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
         : ScanNode(pool, tnode, descs),
           _is_init(false),
@@ -43,6 +66,7 @@ Status OlapMetaScanNode::prepare(RuntimeState* state) {
     }
 
     RETURN_IF_ERROR(ScanNode::prepare(state));
+    _init_counter(state);
     _tablet_counter = ADD_COUNTER(runtime_profile(), "TabletCount ", TUnit::UNIT);
 
     // get desc tuple desc
@@ -60,21 +84,15 @@ Status OlapMetaScanNode::open(RuntimeState* state) {
     if (!_is_init) {
         return Status::InternalError("Open before Init.");
     }
-    for (auto& scan_range : _scan_ranges) {
-        OlapMetaScannerParams scanner_params;
-        scanner_params.scan_range = scan_range.get();
-        OlapMetaScanner* scanner = _obj_pool.add(new OlapMetaScanner(this));
-        RETURN_IF_ERROR(scanner->init(state, scanner_params));
-        _scanners.push_back(scanner);
+    for (size_t i = 0; i < _scan_ranges.size(); i++) {
+        _scanners.push_back(_obj_pool.add(new OlapMetaScanner(this)));
     }
 
     if (_scanners.size() <= 0) {
         return Status::InternalError("Invalid ScanRange.");
     }
 
-    DCHECK_GT(_scanners.size(), 0);
-    RETURN_IF_ERROR(_scanners[_cursor_idx]->open(state));
-
+    RETURN_IF_ERROR(_scan_tablets(state));
     _cursor_idx = 0;
 
     RETURN_IF_CANCELLED(state);
@@ -82,21 +100,58 @@ Status OlapMetaScanNode::open(RuntimeState* state) {
     return Status::OK();
 }
 
+Status OlapMetaScanNode::_scan_tablets(RuntimeState* state) {
+    SCOPED_TIMER(_scan_timer);
+    std::vector<std::vector<ChunkPtr>> chunks(_scanners.size());
+    std::vector<Status> statuses(_scanners.size());
+    CountDownLatch latch(_scanners.size());
+    ThreadPool* pool = _scanners.size() > 1 ? meta_scan_thread_pool() : nullptr;
+    for (size_t i = 0; i < _scanners.size(); i++) {
+        auto task = [this, state, i, &chunks, &statuses, &latch]() {
+            statuses[i] = _scan_tablet(state, i, &chunks[i]);
+            latch.count_down();
+        };
+        if (pool == nullptr || !pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    latch.wait();
+
+    for (size_t i = 0; i < _scanners.size(); i++) {
+        RETURN_IF_ERROR(statuses[i]);
+        for (auto& chunk : chunks[i]) {
+            _chunks.emplace_back(std::move(chunk));
+        }
+    }
+    return Status::OK();
+}
+
+Status OlapMetaScanNode::_scan_tablet(RuntimeState* state, size_t index, std::vector<ChunkPtr>* chunks) {
+    OlapMetaScanner* scanner = _scanners[index];
+    OlapMetaScannerParams scanner_params;
+    scanner_params.scan_range = _scan_ranges[index].get();
+    RETURN_IF_ERROR(scanner->init(state, scanner_params));
+    RETURN_IF_ERROR(scanner->open(state));
+    while (scanner->has_more()) {
+        ChunkPtr chunk;
+        RETURN_IF_ERROR(scanner->get_chunk(state, &chunk));
+        if (chunk->num_rows() > 0) {
+            chunks->emplace_back(std::move(chunk));
+        }
+    }
+    scanner->close(state);
+    return Status::OK();
+}
+
 Status OlapMetaScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     DCHECK(state != nullptr && chunk != nullptr && eos != nullptr);
     RETURN_IF_CANCELLED(state);
 
-    if (!_scanners[_cursor_idx]->has_more()) {
-        _scanners[_cursor_idx]->close(state);
-        _cursor_idx++;
-    }
-    if (_cursor_idx >= _scanners.size()) {
+    if (_cursor_idx >= _chunks.size()) {
         *eos = true;
         return Status::OK();
     }
-
-    RETURN_IF_ERROR(_scanners[_cursor_idx]->open(state));
-    RETURN_IF_ERROR(_scanners[_cursor_idx]->get_chunk(state, chunk));
+    *chunk = std::move(_chunks[_cursor_idx++]);
     return Status::OK();
 }
 
@@ -106,6 +161,9 @@ Status OlapMetaScanNode::close(RuntimeState* state) {
     }
 
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    for (auto* scanner : _scanners) {
+        scanner->close(state);
+    }
     return ScanNode::close(state);
 }
 
@@ -32,12 +32,18 @@ public:
 
 private:
     void _init_counter(RuntimeState* state);
+    // Scans all the tablets by the meta scan threads at the same time, their results are tiny, a row for each
+    // segment, and kept until they are returned.
+    Status _scan_tablets(RuntimeState* state);
+    Status _scan_tablet(RuntimeState* state, size_t index, std::vector<ChunkPtr>* chunks);
     friend class OlapMetaScanner;
 
     // params
     std::vector<std::unique_ptr<TInternalScanRange>> _scan_ranges;
 
     std::vector<OlapMetaScanner*> _scanners;
+    // the chunks of all the tablets
+    std::vector<ChunkPtr> _chunks;
     size_t _cursor_idx = 0;
 
     bool _is_init;
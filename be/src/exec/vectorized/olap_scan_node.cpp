@@ -12,6 +12,7 @@
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/scan_operator.h"
+#include "exec/pipeline/scan_result_cache.h"
 #include "exec/vectorized/olap_scan_prepare.h"
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
@@ -23,6 +24,7 @@
 #include "storage/vectorized/chunk_helper.h"
 #include "util/defer_op.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/thrift_util.h"
 
 namespace starrocks::vectorized {
 
@@ -38,6 +40,16 @@ Status OlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _unused_output_columns.emplace_back(col_name);
     }
 
+    if (pipeline::ScanResultCache::instance() != nullptr) {
+        // The same scan of the same query sent again is serialized to the same plan node, except its id.
+        TPlanNode plan_node = tnode;
+        plan_node.node_id = 0;
+        ThriftSerializer serializer(false, 1024);
+        if (!serializer.serialize(&plan_node, &_scan_cache_digest).ok()) {
+            _scan_cache_digest.clear();
+        }
+    }
+
     return Status::OK();
 }
 
@@ -382,10 +394,13 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _seg_init_timer = ADD_TIMER(_scan_profile, "SegmentInit");
     _bi_filter_timer = ADD_CHILD_TIMER(_scan_profile, "BitmapIndexFilter", "SegmentInit");
     _bi_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BitmapIndexFilterRows", TUnit::UNIT, "SegmentInit");
+    _ii_filter_timer = ADD_CHILD_TIMER(_scan_profile, "InvertedIndexFilter", "SegmentInit");
+    _ii_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "InvertedIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _bf_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BloomFilterFilterRows", TUnit::UNIT, "SegmentInit");
     _seg_zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "SegmentZoneMapFilterRows", TUnit::UNIT, "SegmentInit");
     _zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ZoneMapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _sk_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ShortKeyFilterRows", TUnit::UNIT, "SegmentInit");
+    _sorted_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "SortedColumnFilterRows", TUnit::UNIT, "SegmentInit");
 
     /// SegmentRead
     _block_load_timer = ADD_TIMER(_scan_profile, "SegmentRead");
@@ -557,15 +572,22 @@ pipeline::OpFactories OlapScanNode::decompose_to_pipeline(pipeline::PipelineBuil
                                                                std::move(_conjunct_ctxs), limit());
     // Initialize OperatorFactory's fields involving runtime filters.
     this->init_runtime_filter_for_operator(scan_operator.get(), context, rc_rf_probe_collector);
+    scan_operator->set_scan_cache_digest(_scan_cache_digest);
     auto& morsel_queues = context->fragment_context()->morsel_queues();
     auto source_id = scan_operator->plan_node_id();
     DCHECK(morsel_queues.count(source_id));
     auto& morsel_queue = morsel_queues[source_id];
-    // ScanOperator's degree_of_parallelism is not more than the number of morsels
-    // If table is empty, then morsel size is zero and we still set degree of parallelism to 1
-    const auto degree_of_parallelism =
-            std::min<size_t>(std::max<size_t>(1, morsel_queue->num_morsels()), context->degree_of_parallelism());
-    scan_operator->set_degree_of_parallelism(degree_of_parallelism);
+    if (morsel_queue->is_bucket_aware()) {
+        // The bucket-aware scan has as many drivers as its colocate join, even if some drivers have no bucket to scan
+        scan_operator->set_bucket_aware(true);
+        scan_operator->set_degree_of_parallelism(context->degree_of_parallelism());
+    } else {
+        // ScanOperator's degree_of_parallelism is not more than the number of morsels
+        // If table is empty, then morsel size is zero and we still set degree of parallelism to 1
+        const auto degree_of_parallelism =
+                std::min<size_t>(std::max<size_t>(1, morsel_queue->num_morsels()), context->degree_of_parallelism());
+        scan_operator->set_degree_of_parallelism(degree_of_parallelism);
+    }
     operators.emplace_back(std::move(scan_operator));
     if (limit() != -1) {
         operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
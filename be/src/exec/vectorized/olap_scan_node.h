@@ -136,6 +136,8 @@ private:
     std::atomic<int32_t> _closed_scanners{0};
 
     std::vector<std::string> _unused_output_columns;
+    // The serialized plan node by which the results of the tablets are cached, empty if the cache is disabled.
+    std::string _scan_cache_digest;
 
     // profile
     RuntimeProfile* _scan_profile = nullptr;
@@ -157,6 +159,7 @@ private:
     RuntimeProfile::Counter* _zm_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bf_filtered_counter = nullptr;
     RuntimeProfile::Counter* _sk_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _sorted_filtered_counter = nullptr;
     RuntimeProfile::Counter* _block_seek_timer = nullptr;
     RuntimeProfile::Counter* _block_seek_counter = nullptr;
     RuntimeProfile::Counter* _block_load_timer = nullptr;
@@ -167,6 +170,8 @@ private:
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
+    RuntimeProfile::Counter* _ii_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _ii_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
     RuntimeProfile::Counter* _rowsets_read_count = nullptr;
     RuntimeProfile::Counter* _segments_read_count = nullptr;
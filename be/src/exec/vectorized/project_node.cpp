@@ -6,6 +6,7 @@
 #include <cstring>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "column/binary_column.h"
@@ -14,10 +15,12 @@
 #include "column/column_viewer.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/global_types.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/project_operator.h"
+#include "exec/pipeline/scan_operator.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/column_ref.h"
@@ -289,9 +292,63 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
     }
 }
 
+// Pushes the string projections over a single slot of the scan right below down to the scan, which outputs the
+// slot as the results of the projection, and the projection becomes a reference to the slot. The storage evaluates
+// them once per word of the dictionaries of the dict-encoded columns instead of once per row.
+static void push_down_column_exprs(pipeline::ScanOperatorFactory* scan, RuntimeState* state, ObjectPool* pool,
+                                   std::vector<ExprContext*>* expr_ctxs,
+                                   const std::vector<ExprContext*>& common_sub_expr_ctxs) {
+    // the slots of the expressions, and the number of the expressions referring to each slot
+    std::vector<std::set<SlotId>> expr_slot_ids(expr_ctxs->size());
+    std::unordered_map<SlotId, size_t> num_refs;
+    auto collect_slot_ids = [&num_refs](ExprContext* ctx, std::set<SlotId>* unique_ids) {
+        std::vector<SlotId> slot_ids;
+        ctx->root()->get_slot_ids(&slot_ids);
+        unique_ids->insert(slot_ids.begin(), slot_ids.end());
+        for (SlotId slot_id : *unique_ids) {
+            num_refs[slot_id]++;
+        }
+    };
+    for (size_t i = 0; i < expr_ctxs->size(); i++) {
+        collect_slot_ids((*expr_ctxs)[i], &expr_slot_ids[i]);
+    }
+    for (ExprContext* ctx : common_sub_expr_ctxs) {
+        std::set<SlotId> unique_ids;
+        collect_slot_ids(ctx, &unique_ids);
+    }
+
+    for (size_t i = 0; i < expr_ctxs->size(); i++) {
+        Expr* root = (*expr_ctxs)[i]->root();
+        if (root->is_slotref() || root->type().type != TYPE_VARCHAR || expr_slot_ids[i].size() != 1) {
+            continue;
+        }
+        SlotId slot_id = *expr_slot_ids[i].begin();
+        // the original values of a slot used by the other expressions are still needed
+        if (num_refs[slot_id] != 1) {
+            continue;
+        }
+        SlotDescriptor* slot = state->desc_tbl().get_slot_descriptor(slot_id);
+        if (slot == nullptr || slot->parent() != scan->tuple_id() || slot->type().type != TYPE_VARCHAR ||
+            !slot->is_nullable()) {
+            continue;
+        }
+        if (scan->push_down_column_expr(slot_id, (*expr_ctxs)[i])) {
+            (*expr_ctxs)[i] = pool->add(new ExprContext(pool->add(new ColumnRef(slot))));
+        }
+    }
+}
+
 pipeline::OpFactories ProjectNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators = _children[0]->decompose_to_pipeline(context);
+    RuntimeState* state = context->fragment_context()->runtime_state();
+    if (config::enable_scan_column_expr_push_down && operators.size() == 1 &&
+        state->get_query_global_dict_map().empty()) {
+        auto* scan = dynamic_cast<ScanOperatorFactory*>(operators[0].get());
+        if (scan != nullptr) {
+            push_down_column_exprs(scan, state, _pool, &_expr_ctxs, _common_sub_expr_ctxs);
+        }
+    }
     // Create a shared RefCountedRuntimeFilterCollector
     auto&& rc_rf_probe_collector = std::make_shared<RcRfProbeCollector>(1, std::move(this->runtime_filter_collector()));
 
@@ -0,0 +1,322 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/spill_file.h"
+
+#include <atomic>
+
+#include "column/column.h"
+#include "common/config.h"
+#include "env/env.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_arbitrator.h"
+#include "runtime/mem_tracker.h"
+#include "serde/column_array_serde.h"
+#include "util/coding.h"
+#include "util/hash_util.hpp"
+#include "util/uid_util.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kSpillChunkHeaderSize = sizeof(uint64_t);
+
+static StatusOr<std::string> next_spill_dir() {
+    static std::atomic<uint32_t> s_next_dir{0};
+    std::vector<std::string> dirs = strings::Split(config::query_scratch_dirs, ";", strings::SkipWhitespace());
+    if (dirs.empty()) {
+        return Status::InternalError("query_scratch_dirs is empty");
+    }
+    std::string dir = dirs[s_next_dir.fetch_add(1, std::memory_order_relaxed) % dirs.size()] + "/spill";
+    RETURN_IF_ERROR(Env::Default()->create_dir_if_missing(dir));
+    return dir;
+}
+
+StatusOr<std::unique_ptr<SpillFile>> SpillFile::create(const std::string& label) {
+    ASSIGN_OR_RETURN(auto dir, next_spill_dir());
+    std::string path = strings::Substitute("$0/$1_$2.spill", dir, label, generate_uuid_string());
+    std::unique_ptr<SpillFile> file(new SpillFile(std::move(path)));
+    RETURN_IF_ERROR(Env::Default()->new_writable_file(file->_path, &file->_writer));
+    return std::move(file);
+}
+
+SpillFile::~SpillFile() {
+    _reader.reset();
+    if (_writer != nullptr) {
+        _writer->close();
+        _writer.reset();
+    }
+    auto st = Env::Default()->delete_file(_path);
+    LOG_IF(WARNING, !st.ok()) << "fail to delete spill file " << _path << ": " << st;
+}
+
+Status SpillFile::append(const Chunk& chunk) {
+    if (_writer == nullptr) {
+        return Status::InternalError("spill file is not writable");
+    }
+    if (chunk.is_empty()) {
+        return Status::OK();
+    }
+
+    size_t payload_size = sizeof(uint32_t);
+    for (const auto& column : chunk.columns()) {
+        int64_t size = serde::ColumnArraySerde::max_serialized_size(*column);
+        if (size <= 0) {
+            return Status::NotSupported(
+                    strings::Substitute("spill does not support column $0", column->get_name()));
+        }
+        payload_size += size;
+    }
+
+    _buffer.resize(kSpillChunkHeaderSize + payload_size);
+    uint8_t* buff = _buffer.data() + kSpillChunkHeaderSize;
+    encode_fixed32_le(buff, chunk.num_columns());
+    buff += sizeof(uint32_t);
+    for (const auto& column : chunk.columns()) {
+        buff = serde::ColumnArraySerde::serialize(*column, buff);
+        if (buff == nullptr) {
+            return Status::InternalError("fail to serialize column for spill");
+        }
+    }
+    // The max serialized size is an upper bound, write the real size.
+    payload_size = buff - (_buffer.data() + kSpillChunkHeaderSize);
+    encode_fixed64_le(_buffer.data(), payload_size);
+
+    RETURN_IF_ERROR(_writer->append(Slice(_buffer.data(), kSpillChunkHeaderSize + payload_size)));
+    _num_chunks++;
+    _num_rows += chunk.num_rows();
+    _num_bytes += kSpillChunkHeaderSize + payload_size;
+    return Status::OK();
+}
+
+Status SpillFile::flip_to_read() {
+    if (_writer != nullptr) {
+        RETURN_IF_ERROR(_writer->close());
+        _writer.reset();
+    }
+    if (_reader == nullptr) {
+        RETURN_IF_ERROR(Env::Default()->new_random_access_file(_path, &_reader));
+    }
+    _read_offset = 0;
+    // Release the write buffer, the read buffer will be allocated on demand.
+    std::vector<uint8_t>().swap(_buffer);
+    return Status::OK();
+}
+
+StatusOr<ChunkPtr> SpillFile::read_next(const Chunk& prototype) {
+    if (_reader == nullptr) {
+        return Status::InternalError("spill file is not readable, call flip_to_read() first");
+    }
+    if (_read_offset >= _num_bytes) {
+        return Status::EndOfFile("end of spill file");
+    }
+    return _read_chunk(_read_offset, prototype, &_buffer, &_read_offset);
+}
+
+StatusOr<ChunkPtr> SpillFile::read_at(uint64_t offset, const Chunk& prototype) const {
+    if (offset >= _num_bytes) {
+        return Status::InternalError(strings::Substitute("offset $0 is out of spill file $1", offset, _path));
+    }
+    std::vector<uint8_t> buffer;
+    uint64_t next_offset = 0;
+    return _read_chunk(offset, prototype, &buffer, &next_offset);
+}
+
+StatusOr<ChunkPtr> SpillFile::_read_chunk(uint64_t offset, const Chunk& prototype, std::vector<uint8_t>* buffer,
+                                          uint64_t* next_offset) const {
+    if (_reader == nullptr) {
+        return Status::InternalError("spill file is not readable, call flip_to_read() first");
+    }
+
+    uint8_t header[kSpillChunkHeaderSize];
+    RETURN_IF_ERROR(_reader->read_at(offset, Slice(header, kSpillChunkHeaderSize)));
+    uint64_t payload_size = decode_fixed64_le(header);
+    buffer->resize(payload_size);
+    RETURN_IF_ERROR(_reader->read_at(offset + kSpillChunkHeaderSize, Slice(buffer->data(), payload_size)));
+    *next_offset = offset + kSpillChunkHeaderSize + payload_size;
+
+    const uint8_t* buff = buffer->data();
+    uint32_t num_columns = decode_fixed32_le(buff);
+    buff += sizeof(uint32_t);
+    if (num_columns != prototype.num_columns()) {
+        return Status::Corruption(strings::Substitute("spill file $0 has $1 columns, but $2 are expected", _path,
+                                                      num_columns, prototype.num_columns()));
+    }
+
+    ChunkPtr chunk = prototype.clone_empty_with_slot();
+    for (auto& column : chunk->columns()) {
+        buff = serde::ColumnArraySerde::deserialize(buff, column.get());
+        if (buff == nullptr) {
+            return Status::Corruption(strings::Substitute("fail to deserialize column from spill file $0", _path));
+        }
+    }
+    return chunk;
+}
+
+PartitionedSpiller::PartitionedSpiller(std::string label, size_t num_partitions, size_t chunk_size, uint32_t seed)
+        : _label(std::move(label)),
+          _num_partitions(num_partitions),
+          _chunk_size(chunk_size),
+          _seed(seed),
+          _files(num_partitions),
+          _buffers(num_partitions),
+          _spilled(num_partitions, true),
+          _resident_chunks(num_partitions),
+          _resident_chunk_bytes(num_partitions, 0),
+          _selection(num_partitions) {
+    DCHECK_GT(_num_partitions, 0);
+}
+
+void PartitionedSpiller::keep_in_memory() {
+    DCHECK_EQ(_spilled_rows, 0);
+    _spilled.assign(_num_partitions, false);
+}
+
+uint32_t PartitionedSpiller::partition_of(uint32_t hash, uint32_t seed, size_t num_partitions) {
+    // Data may have been distributed by crc32 of the same columns (e.g. bucket shuffle),
+    // mix the hash value so that the partitions here are independent of the distribution.
+    return HashUtil::fmix32(hash ^ seed) % num_partitions;
+}
+
+Status PartitionedSpiller::append(const ChunkPtr& chunk, const Columns& key_columns,
+                                  const std::vector<uint8_t>* partition_mask) {
+    size_t num_rows = chunk->num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+
+    _hash_values.assign(num_rows, 0);
+    for (const auto& column : key_columns) {
+        DCHECK_EQ(column->size(), num_rows);
+        column->crc32_hash(_hash_values.data(), 0, num_rows);
+    }
+
+    _partition_indexes.resize(num_rows);
+    for (auto& selection : _selection) {
+        selection.clear();
+    }
+    for (size_t i = 0; i < num_rows; ++i) {
+        uint32_t partition = partition_of(_hash_values[i], _seed, _num_partitions);
+        _partition_indexes[i] = partition;
+        if (partition_mask == nullptr || (*partition_mask)[partition]) {
+            _selection[partition].push_back(i);
+        }
+    }
+
+    for (size_t i = 0; i < _num_partitions; ++i) {
+        const auto& selection = _selection[i];
+        uint32_t from = 0;
+        while (from < selection.size()) {
+            if (_buffers[i] == nullptr) {
+                _buffers[i] = chunk->clone_empty_with_slot(_chunk_size);
+            }
+            uint32_t size = std::min<uint32_t>(selection.size() - from, _chunk_size - _buffers[i]->num_rows());
+            _buffers[i]->append_selective(*chunk, selection.data(), from, size);
+            from += size;
+            if (_buffers[i]->num_rows() < _chunk_size) {
+                continue;
+            }
+            if (_spilled[i]) {
+                RETURN_IF_ERROR(_flush_partition(i));
+            } else {
+                _resident_chunk_bytes[i] += _buffers[i]->memory_usage();
+                _resident_chunks[i].emplace_back(std::move(_buffers[i]));
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status PartitionedSpiller::_write_partition(size_t i, const Chunk& chunk) {
+    if (_files[i] == nullptr) {
+        ASSIGN_OR_RETURN(_files[i], SpillFile::create(strings::Substitute("$0_p$1", _label, i)));
+    }
+    size_t old_bytes = _files[i]->num_bytes();
+    RETURN_IF_ERROR(_files[i]->append(chunk));
+    _spilled_rows += chunk.num_rows();
+    _spilled_bytes += _files[i]->num_bytes() - old_bytes;
+    return Status::OK();
+}
+
+Status PartitionedSpiller::_flush_partition(size_t i) {
+    if (_buffers[i] == nullptr || _buffers[i]->is_empty()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_write_partition(i, *_buffers[i]));
+    _buffers[i].reset();
+    return Status::OK();
+}
+
+Status PartitionedSpiller::flush() {
+    for (size_t i = 0; i < _num_partitions; ++i) {
+        if (_spilled[i]) {
+            RETURN_IF_ERROR(_flush_partition(i));
+        }
+    }
+    return Status::OK();
+}
+
+Status PartitionedSpiller::spill_partition(size_t i) {
+    if (_spilled[i]) {
+        return Status::OK();
+    }
+    _spilled[i] = true;
+    for (const auto& chunk : _resident_chunks[i]) {
+        RETURN_IF_ERROR(_write_partition(i, *chunk));
+    }
+    std::vector<ChunkPtr>().swap(_resident_chunks[i]);
+    _resident_chunk_bytes[i] = 0;
+    return _flush_partition(i);
+}
+
+size_t PartitionedSpiller::resident_bytes(size_t i) const {
+    if (_spilled[i]) {
+        return 0;
+    }
+    size_t bytes = _resident_chunk_bytes[i];
+    if (_buffers[i] != nullptr) {
+        bytes += _buffers[i]->memory_usage();
+    }
+    return bytes;
+}
+
+std::vector<ChunkPtr> PartitionedSpiller::take_resident_chunks(size_t i) {
+    DCHECK(!_spilled[i]);
+    std::vector<ChunkPtr> chunks = std::move(_resident_chunks[i]);
+    _resident_chunks[i].clear();
+    _resident_chunk_bytes[i] = 0;
+    if (_buffers[i] != nullptr && !_buffers[i]->is_empty()) {
+        chunks.emplace_back(std::move(_buffers[i]));
+    }
+    _buffers[i].reset();
+    return chunks;
+}
+
+Status PartitionedSpiller::flip_to_read() {
+    RETURN_IF_ERROR(flush());
+    for (auto& file : _files) {
+        if (file != nullptr) {
+            RETURN_IF_ERROR(file->flip_to_read());
+        }
+    }
+    return Status::OK();
+}
+
+int64_t spill_mem_threshold(const MemTracker* mem_tracker) {
+    int64_t threshold = config::spill_operator_mem_threshold_bytes;
+    if (mem_tracker != nullptr) {
+        int64_t limit = mem_tracker->lowest_limit();
+        if (limit > 0) {
+            threshold = std::min(threshold, limit / 2);
+        }
+    }
+    return threshold;
+}
+
+bool should_spill(int64_t bytes, int64_t threshold) {
+    if (bytes > threshold) {
+        return true;
+    }
+    return bytes > threshold / 4 && MemArbitrator::instance()->is_under_pressure();
+}
+
+} // namespace starrocks::vectorized
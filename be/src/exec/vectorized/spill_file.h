@@ -0,0 +1,187 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+
+namespace starrocks {
+
+class MemTracker;
+class RandomAccessFile;
+class WritableFile;
+
+namespace vectorized {
+
+// SpillFile is an append-only temporary file of chunks, used by the operators which
+// could spill their in-memory state to the local disk when running out of memory.
+//
+// All the chunks appended to a SpillFile must have the same layout, and they are read
+// back in the appended order. Every chunk is encoded as:
+//
+//     | payload size(8 bytes) | num columns(4 bytes) | column 0 | column 1 | ... |
+//
+// and columns are encoded by serde::ColumnArraySerde.
+//
+// The file is created under one of the directories of `query_scratch_dirs`, and is
+// removed when the SpillFile is destroyed.
+//
+// Usage Example:
+//     ASSIGN_OR_RETURN(auto file, SpillFile::create("agg"));
+//     RETURN_IF_ERROR(file->append(*chunk1));
+//     RETURN_IF_ERROR(file->append(*chunk2));
+//
+//     RETURN_IF_ERROR(file->flip_to_read());
+//     while (true) {
+//         auto res = file->read_next(*prototype);
+//         if (res.status().is_end_of_file()) break;
+//         ...
+//     }
+//
+class SpillFile {
+public:
+    static StatusOr<std::unique_ptr<SpillFile>> create(const std::string& label);
+
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    Status append(const Chunk& chunk);
+
+    // Close the writer and prepare for read, no more chunk could be appended after this.
+    Status flip_to_read();
+
+    // Read the next chunk. The returned chunk is built from |prototype|, which means
+    // the slot id mapping of |prototype| is kept.
+    // Return Status::EndOfFile if there is no more chunk.
+    StatusOr<ChunkPtr> read_next(const Chunk& prototype);
+
+    // Rewind the reader to the first chunk.
+    void rewind() { _read_offset = 0; }
+
+    // The offset of the chunk appended next, by which it could be read by read_at().
+    uint64_t append_offset() const { return _num_bytes; }
+    // Read the chunk at |offset|, which was returned by append_offset() before the chunk was appended.
+    // Unlike read_next(), it could be called by several threads at the same time after flip_to_read().
+    StatusOr<ChunkPtr> read_at(uint64_t offset, const Chunk& prototype) const;
+
+    const std::string& path() const { return _path; }
+    size_t num_chunks() const { return _num_chunks; }
+    size_t num_rows() const { return _num_rows; }
+    size_t num_bytes() const { return _num_bytes; }
+
+private:
+    explicit SpillFile(std::string path) : _path(std::move(path)) {}
+
+    StatusOr<ChunkPtr> _read_chunk(uint64_t offset, const Chunk& prototype, std::vector<uint8_t>* buffer,
+                                   uint64_t* next_offset) const;
+
+    std::string _path;
+    std::unique_ptr<WritableFile> _writer;
+    std::unique_ptr<RandomAccessFile> _reader;
+    uint64_t _read_offset = 0;
+
+    size_t _num_chunks = 0;
+    size_t _num_rows = 0;
+    size_t _num_bytes = 0;
+
+    std::vector<uint8_t> _buffer;
+};
+
+// PartitionedSpiller hash partitions the rows of the appended chunks into a fixed number
+// of SpillFiles by the given key columns, so that the rows with the same keys always
+// go into the same partition and each partition could be processed independently later.
+//
+// Rows are buffered per partition, and a partition buffer is written out once it reaches
+// |chunk_size| rows, so every chunk in the spilled files has at most |chunk_size| rows.
+//
+// In hybrid mode (see keep_in_memory()), partitions are resident in memory at first, and
+// they are written out only after the caller decides to spill them, e.g. when the total
+// resident bytes exceed the memory budget of the operator.
+class PartitionedSpiller {
+public:
+    // |seed| is mixed into the partition hash, callers partitioning the same data for
+    // several times (e.g. recursive partitioning) should use different seeds.
+    PartitionedSpiller(std::string label, size_t num_partitions, size_t chunk_size, uint32_t seed = 0);
+
+    // Keep the rows of all the partitions in memory until they are spilled by spill_partition().
+    // Must be called before the first append().
+    void keep_in_memory();
+
+    // |key_columns| must have the same number of rows as |chunk|.
+    // If |partition_mask| is not null, only the rows of the partitions whose mask is non-zero are
+    // appended, the others are ignored.
+    Status append(const ChunkPtr& chunk, const Columns& key_columns,
+                  const std::vector<uint8_t>* partition_mask = nullptr);
+
+    // Write out all the buffered rows of the spilled partitions.
+    Status flush();
+
+    bool is_spilled(size_t i) const { return _spilled[i]; }
+    // Write out the resident rows of the i-th partition, and the rows appended to it afterwards.
+    Status spill_partition(size_t i);
+    // Memory bytes of the resident rows of the i-th partition.
+    size_t resident_bytes(size_t i) const;
+    // Take away the resident rows of the i-th partition.
+    std::vector<ChunkPtr> take_resident_chunks(size_t i);
+
+    // Flush and flip all the partitions to read.
+    Status flip_to_read();
+
+    size_t num_partitions() const { return _num_partitions; }
+    // nullptr means nothing has been spilled to this partition.
+    SpillFile* partition(size_t i) { return _files[i].get(); }
+    // Release the disk space of the i-th partition once it has been consumed.
+    void release_partition(size_t i) { _files[i].reset(); }
+    // Take away the file of the i-th partition, nullptr if nothing has been spilled to it.
+    std::unique_ptr<SpillFile> take_partition(size_t i) { return std::move(_files[i]); }
+
+    // Partition index of every row, computed by the last call of append().
+    const std::vector<uint32_t>& partition_indexes() const { return _partition_indexes; }
+
+    size_t spilled_rows() const { return _spilled_rows; }
+    size_t spilled_bytes() const { return _spilled_bytes; }
+
+    static uint32_t partition_of(uint32_t hash, uint32_t seed, size_t num_partitions);
+
+private:
+    Status _flush_partition(size_t i);
+    Status _write_partition(size_t i, const Chunk& chunk);
+
+    const std::string _label;
+    const size_t _num_partitions;
+    const size_t _chunk_size;
+    const uint32_t _seed;
+
+    std::vector<std::unique_ptr<SpillFile>> _files;
+    std::vector<ChunkUniquePtr> _buffers;
+    std::vector<bool> _spilled;
+    // Only used in hybrid mode, the full buffers of the resident partitions.
+    std::vector<std::vector<ChunkPtr>> _resident_chunks;
+    std::vector<size_t> _resident_chunk_bytes;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _partition_indexes;
+    std::vector<std::vector<uint32_t>> _selection;
+
+    size_t _spilled_rows = 0;
+    size_t _spilled_bytes = 0;
+};
+
+// The memory bytes an operator could consume before it begins to spill.
+// It's `spill_operator_mem_threshold_bytes`, bounded by a half of the lowest limit of
+// |mem_tracker| and its ancestors.
+int64_t spill_mem_threshold(const MemTracker* mem_tracker);
+
+// Whether an operator holding |bytes| should spill: beyond |threshold|, or beyond a quarter of it while queries
+// are waiting for memory in MemArbitrator, which takes back the memory of the spillable operators first.
+bool should_spill(int64_t bytes, int64_t threshold);
+
+} // namespace vectorized
+} // namespace starrocks
@@ -11,6 +11,8 @@
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
 #include "common/status.h"
+#include "exec/vectorized/column_access_stats.h"
+#include "exec/vectorized/column_read_profile.h"
 #include "exec/vectorized/olap_scan_node.h"
 #include "storage/storage_engine.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -92,6 +94,15 @@ Status TabletScanner::close(RuntimeState* state) {
     }
     _prj_iter->close();
     update_counter();
+    if (_tablet != nullptr) {
+        _tablet->record_scan(_compressed_bytes_read);
+        std::vector<const ColumnPredicate*> predicates;
+        for (const auto& pred : _predicate_free_pool) {
+            predicates.push_back(pred.get());
+        }
+        _tablet->record_column_access(
+                collect_column_access(_tablet->tablet_schema(), _parent->_tuple_desc->slots(), predicates, state));
+    }
     _reader.reset();
     _predicate_free_pool.clear();
     Expr::close(_conjunct_ctxs, state);
@@ -318,6 +329,7 @@ void TabletScanner::update_counter() {
     COUNTER_UPDATE(_parent->_zm_filtered_counter, _reader->stats().rows_stats_filtered);
     COUNTER_UPDATE(_parent->_bf_filtered_counter, _reader->stats().rows_bf_filtered);
     COUNTER_UPDATE(_parent->_sk_filtered_counter, _reader->stats().rows_key_range_filtered);
+    COUNTER_UPDATE(_parent->_sorted_filtered_counter, _reader->stats().rows_sorted_range_filtered);
     COUNTER_UPDATE(_parent->_index_load_timer, _reader->stats().index_load_ns);
 
     COUNTER_UPDATE(_parent->_read_pages_num_counter, _reader->stats().total_pages_num);
@@ -325,10 +337,13 @@ void TabletScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
+    COUNTER_UPDATE(_parent->_ii_filtered_counter, _reader->stats().rows_inverted_index_filtered);
+    COUNTER_UPDATE(_parent->_ii_filter_timer, _reader->stats().inverted_index_filter_timer);
     COUNTER_UPDATE(_parent->_block_seek_counter, _reader->stats().block_seek_num);
 
     COUNTER_UPDATE(_parent->_rowsets_read_count, _reader->stats().rowsets_read_count);
     COUNTER_UPDATE(_parent->_segments_read_count, _reader->stats().segments_read_count);
+    update_column_read_profile(_tablet->tablet_schema(), _reader->stats(), _parent->_scan_profile);
     COUNTER_UPDATE(_parent->_total_columns_data_page_count, _reader->stats().total_columns_data_page_count);
 
     COUNTER_SET(_parent->_pushdown_predicates_counter, (int64_t)_params.predicates.size());
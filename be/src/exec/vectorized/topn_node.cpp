@@ -7,6 +7,9 @@
 #include "column/column_helper.h"
 #include "exec/pipeline/exchange/local_exchange_source_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/project_operator.h"
+#include "exec/pipeline/scan_operator.h"
+#include "exec/pipeline/select_operator.h"
 #include "exec/pipeline/sort/local_merge_sort_source_operator.h"
 #include "exec/pipeline/sort/partition_sort_sink_operator.h"
 #include "exec/pipeline/sort/sort_context.h"
@@ -14,6 +17,8 @@
 #include "exec/vectorized/chunks_sorter.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/runtime_topn_threshold.h"
 #include "gutil/casts.h"
 #include "runtime/current_thread.h"
 
@@ -183,6 +188,51 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
     return Status::OK();
 }
 
+// The sorters can publish the threshold of the first order-by column to the scan, only if it's a column of the scan,
+// and each row of the scan reaches the sorters as is or is filtered out, i.e. it's only projected or selected.
+static std::shared_ptr<RuntimeTopnThreshold> create_runtime_topn_threshold(const pipeline::OpFactories& operators,
+                                                                           const SortExecExprs& sort_exec_exprs,
+                                                                           const TupleDescriptor* materialized_tuple,
+                                                                           bool is_asc, bool is_null_first) {
+    using namespace pipeline;
+    auto* scan = dynamic_cast<ScanOperatorFactory*>(operators[0].get());
+    if (scan == nullptr || scan->limit() != -1) {
+        return nullptr;
+    }
+    for (size_t i = 1; i < operators.size(); i++) {
+        if (dynamic_cast<ProjectOperatorFactory*>(operators[i].get()) == nullptr &&
+            dynamic_cast<SelectOperatorFactory*>(operators[i].get()) == nullptr) {
+            return nullptr;
+        }
+    }
+
+    Expr* expr = sort_exec_exprs.lhs_ordering_expr_ctxs()[0]->root();
+    if (!expr->is_slotref()) {
+        return nullptr;
+    }
+    // The order-by columns refer to the materialized tuple, whose slots are evaluated from the input.
+    const auto& slots = materialized_tuple->slots();
+    const auto& slot_exprs = sort_exec_exprs.sort_tuple_slot_expr_ctxs();
+    for (size_t i = 0; i < slot_exprs.size() && i < slots.size(); i++) {
+        if (slots[i]->id() == down_cast<ColumnRef*>(expr)->slot_id()) {
+            expr = slot_exprs[i]->root();
+            break;
+        }
+    }
+    if (!expr->is_slotref() || !RuntimeTopnThreshold::support_type(expr->type().type)) {
+        return nullptr;
+    }
+    auto* slot_ref = down_cast<ColumnRef*>(expr);
+    // the slot output as the results of an expression isn't filtered by its original values
+    if (slot_ref->tuple_id() != scan->tuple_id() || scan->has_column_expr(slot_ref->slot_id())) {
+        return nullptr;
+    }
+    auto threshold = std::make_shared<RuntimeTopnThreshold>(slot_ref->slot_id(), expr->type().type, is_asc,
+                                                            is_null_first);
+    scan->set_runtime_topn_threshold(threshold);
+    return threshold;
+}
+
 pipeline::OpFactories TopNNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
 
@@ -208,6 +258,11 @@ pipeline::OpFactories TopNNode::decompose_to_pipeline(pipeline::PipelineBuilderC
             _analytic_partition_exprs);
     // Initialize OperatorFactory's fields involving runtime filters.
     this->init_runtime_filter_for_operator(partition_sort_sink_operator.get(), context, rc_rf_probe_collector);
+    if (is_merging && _limit > 0) {
+        partition_sort_sink_operator->set_runtime_topn_threshold(
+                create_runtime_topn_threshold(operators_sink_with_sort, _sort_exec_exprs, _materialized_tuple_desc,
+                                              _is_asc_order[0], _is_null_first[0]));
+    }
 
     OpFactories operators_source_with_sort;
     auto local_merge_sort_source_operator = std::make_shared<LocalMergeSortSourceOperatorFactory>(
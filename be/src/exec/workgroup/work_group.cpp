@@ -3,6 +3,7 @@
 #include "exec/workgroup/work_group.h"
 
 #include "runtime/exec_env.h"
+#include "util/time.h"
 
 namespace starrocks {
 namespace workgroup {
@@ -16,11 +17,159 @@ WorkGroup::WorkGroup(const std::string& name, int id, size_t cpu_limit, size_t m
           _type(type) {}
 
 void WorkGroup::init() {
-    _mem_tracker = std::make_shared<starrocks::MemTracker>(_memory_limit, _name,
-                                                           ExecEnv::GetInstance()->query_pool_mem_tracker());
+    MemTracker* parent_mem_tracker =
+            _parent != nullptr ? _parent->mem_tracker() : ExecEnv::GetInstance()->query_pool_mem_tracker();
+    _mem_tracker = std::make_shared<starrocks::MemTracker>(_memory_limit, _name, parent_mem_tracker);
     _driver_queue = std::make_unique<starrocks::pipeline::QuerySharedDriverQueue>();
 }
 
+void WorkGroup::incr_cpu_runtime_ns(int64_t runtime_ns) {
+    int64_t now = MonotonicNanos();
+    for (WorkGroup* wg = this; wg != nullptr; wg = wg->parent()) {
+        wg->_cpu_runtime_ns.fetch_add(runtime_ns, std::memory_order_relaxed);
+        wg->_cpu_vruntime_ns.fetch_add(runtime_ns / wg->weight(), std::memory_order_relaxed);
+        wg->_cpu_usage.add(runtime_ns, now);
+    }
+}
+
+void WorkGroup::incr_io_bytes(int64_t bytes) {
+    int64_t now = MonotonicNanos();
+    for (WorkGroup* wg = this; wg != nullptr; wg = wg->parent()) {
+        wg->_io_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        wg->_io_vruntime.fetch_add(bytes / wg->weight(), std::memory_order_relaxed);
+        wg->_io_usage.add(bytes, now);
+    }
+}
+
+bool WorkGroup::is_cpu_throttled() const {
+    int64_t now = MonotonicNanos();
+    for (const WorkGroup* wg = this; wg != nullptr; wg = wg->parent()) {
+        if (wg->_cpu_hard_limit > 0 && wg->_cpu_usage.usage(now) >= wg->_cpu_hard_limit * PeriodicUsage::PERIOD_NS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkGroup::is_io_throttled() const {
+    int64_t now = MonotonicNanos();
+    for (const WorkGroup* wg = this; wg != nullptr; wg = wg->parent()) {
+        if (wg->_io_bytes_limit > 0 &&
+            wg->_io_usage.usage(now) >= wg->_io_bytes_limit * PeriodicUsage::PERIOD_NS / NANOS_PER_SEC) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PeriodicUsage::add(int64_t value, int64_t now_ns) {
+    int64_t period = now_ns / PERIOD_NS;
+    int64_t old_period = _period.load();
+    // The usage is approximate when several threads enter a new period at the same time, it's acceptable
+    // for throttling.
+    if (period != old_period && _period.compare_exchange_strong(old_period, period)) {
+        _usage.store(0);
+    }
+    _usage.fetch_add(value);
+}
+
+int64_t PeriodicUsage::usage(int64_t now_ns) const {
+    return _period.load() == now_ns / PERIOD_NS ? _usage.load() : 0;
+}
+
+void FairWorkGroupQueue::add(const WorkGroupPtr& wg) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _workgroups.emplace_back(wg);
+}
+
+void FairWorkGroupQueue::remove(const WorkGroupPtr& wg) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _workgroups.erase(std::remove(_workgroups.begin(), _workgroups.end(), wg), _workgroups.end());
+}
+
+bool FairWorkGroupQueue::_is_runnable_recursively(const WorkGroup& wg) const {
+    if (is_runnable(wg)) {
+        return true;
+    }
+    for (const auto& child : _workgroups) {
+        if (child->parent() == &wg && _is_runnable_recursively(*child)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+WorkGroupPtr FairWorkGroupQueue::pick_next() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<WorkGroup*> candidates;
+    const WorkGroup* parent = nullptr;
+    while (true) {
+        candidates.clear();
+        WorkGroup* picked = nullptr;
+        int64_t max_vruntime = 0;
+        for (const auto& wg : _workgroups) {
+            if (wg->parent() != parent || is_throttled(*wg) || !_is_runnable_recursively(*wg)) {
+                continue;
+            }
+            candidates.emplace_back(wg.get());
+            max_vruntime = std::max(max_vruntime, vruntime(*wg));
+        }
+        for (auto* wg : candidates) {
+            if (vruntime(*wg) < max_vruntime - MAX_VRUNTIME_LAG) {
+                set_vruntime(wg, max_vruntime - MAX_VRUNTIME_LAG);
+            }
+            if (picked == nullptr || vruntime(*wg) < vruntime(*picked)) {
+                picked = wg;
+            }
+        }
+        if (picked == nullptr) {
+            return nullptr;
+        }
+        // The picked group runs its own work first, otherwise go down to choose among its children.
+        if (is_runnable(*picked)) {
+            for (const auto& wg : _workgroups) {
+                if (wg.get() == picked) {
+                    return wg;
+                }
+            }
+        }
+        parent = picked;
+    }
+}
+
+int64_t CpuWorkGroupQueue::vruntime(const WorkGroup& wg) const {
+    return wg.cpu_vruntime_ns();
+}
+
+void CpuWorkGroupQueue::set_vruntime(WorkGroup* wg, int64_t vruntime) const {
+    wg->set_cpu_vruntime_ns(vruntime);
+}
+
+bool CpuWorkGroupQueue::is_throttled(const WorkGroup& wg) const {
+    return wg.is_cpu_throttled();
+}
+
+bool CpuWorkGroupQueue::is_runnable(const WorkGroup& wg) const {
+    const auto* driver_queue = wg.driver_queue();
+    return driver_queue != nullptr && driver_queue->size() > 0;
+}
+
+int64_t IoWorkGroupQueue::vruntime(const WorkGroup& wg) const {
+    return wg.io_vruntime();
+}
+
+void IoWorkGroupQueue::set_vruntime(WorkGroup* wg, int64_t vruntime) const {
+    wg->set_io_vruntime(vruntime);
+}
+
+bool IoWorkGroupQueue::is_throttled(const WorkGroup& wg) const {
+    return wg.is_io_throttled();
+}
+
+bool IoWorkGroupQueue::is_runnable(const WorkGroup& wg) const {
+    return wg.num_pending_io_tasks() > 0;
+}
+
 WorkGroupManager::WorkGroupManager() {}
 WorkGroupManager::~WorkGroupManager() {}
 
@@ -43,6 +192,17 @@ void WorkGroupManager::remove_workgroup(int wg_id) {
     }
 }
 
+size_t WorkGroupManager::num_ready_drivers() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t num_drivers = 0;
+    for (const auto& [_, wg] : _workgroups) {
+        if (wg->driver_queue() != nullptr) {
+            num_drivers += wg->driver_queue()->size();
+        }
+    }
+    return num_drivers;
+}
+
 WorkGroupPtr WorkGroupManager::pick_next_wg_for_cpu() {
     return _wg_cpu_queue.pick_next();
 }
@@ -1,11 +1,13 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021-present StarRocks Limited.
 
 #pragma once
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "exec/pipeline/pipeline_driver_queue.h"
 #include "runtime/mem_tracker.h"
@@ -26,22 +28,59 @@ public:
     virtual WorkGroupPtr pick_next() = 0;
 };
 
-class CpuWorkGroupQueue final : public WorkGroupQueue {
+// FairWorkGroupQueue picks the next WorkGroup by weighted fair sharing over the hierarchy of WorkGroups.
+// From the root level down, it chooses the runnable and not throttled group with the minimum virtual runtime
+// among the siblings, until it reaches a leaf group, which is returned.
+//
+// The virtual runtime of a group is the resource it has consumed divided by its weight, so groups with
+// the same virtual runtime get the resource in the proportion of their weights.
+class FairWorkGroupQueue : public WorkGroupQueue {
+public:
+    // A group idle for a long time lags behind its siblings in virtual runtime, it's raised to at most
+    // this lag behind the most advanced runnable sibling when it becomes runnable again, so that it
+    // doesn't monopolize the resource to catch up.
+    static constexpr int64_t MAX_VRUNTIME_LAG = 100'000'000;
+
+    void add(const WorkGroupPtr& wg) override;
+    void remove(const WorkGroupPtr& wg) override;
+    WorkGroupPtr pick_next() override;
+
+protected:
+    virtual int64_t vruntime(const WorkGroup& wg) const = 0;
+    virtual void set_vruntime(WorkGroup* wg, int64_t vruntime) const = 0;
+    virtual bool is_throttled(const WorkGroup& wg) const = 0;
+    // Whether the group itself has something to run, regardless of its children.
+    virtual bool is_runnable(const WorkGroup& wg) const = 0;
+
+private:
+    bool _is_runnable_recursively(const WorkGroup& wg) const;
+
+    std::mutex _mutex;
+    std::vector<WorkGroupPtr> _workgroups;
+};
+
+class CpuWorkGroupQueue final : public FairWorkGroupQueue {
 public:
     CpuWorkGroupQueue() = default;
-    ~CpuWorkGroupQueue() = default;
-    void add(const WorkGroupPtr& wg) override {}
-    void remove(const WorkGroupPtr& wg) override {}
-    WorkGroupPtr pick_next() override { return nullptr; }
+    ~CpuWorkGroupQueue() override = default;
+
+protected:
+    int64_t vruntime(const WorkGroup& wg) const override;
+    void set_vruntime(WorkGroup* wg, int64_t vruntime) const override;
+    bool is_throttled(const WorkGroup& wg) const override;
+    bool is_runnable(const WorkGroup& wg) const override;
 };
 
-class IoWorkGroupQueue final : public WorkGroupQueue {
+class IoWorkGroupQueue final : public FairWorkGroupQueue {
 public:
     IoWorkGroupQueue() = default;
-    ~IoWorkGroupQueue() = default;
-    void add(const WorkGroupPtr& wg) override {}
-    void remove(const WorkGroupPtr& wg) override {}
-    WorkGroupPtr pick_next() override { return nullptr; }
+    ~IoWorkGroupQueue() override = default;
+
+protected:
+    int64_t vruntime(const WorkGroup& wg) const override;
+    void set_vruntime(WorkGroup* wg, int64_t vruntime) const override;
+    bool is_throttled(const WorkGroup& wg) const override;
+    bool is_runnable(const WorkGroup& wg) const override;
 };
 
 class WorkGroupManager;
@@ -51,21 +90,59 @@ enum WorkGroupType {
     WG_DEFAULT = 1,  // default work group
     WG_REALTIME = 2, // realtime work group, maybe reserved beforehand
 };
+
+// Usage of a resource in fixed-length periods, used to enforce the hard limit of a WorkGroup.
+class PeriodicUsage {
+public:
+    static constexpr int64_t PERIOD_NS = 100'000'000;
+
+    // Add |value| to the usage of the current period.
+    void add(int64_t value, int64_t now_ns);
+    // Usage of the current period.
+    int64_t usage(int64_t now_ns) const;
+
+private:
+    std::atomic<int64_t> _period{0};
+    std::atomic<int64_t> _usage{0};
+};
+
 // WorkGroup is the unit of resource isolation, it has {CPU, Memory, Concurrency} quotas which limit the
 // resource usage of the queries belonging to the WorkGroup. Each user has be bound to a WorkGroup, when
 // the user issues a query, then the corresponding WorkGroup is chosen to manage the query.
+//
+// WorkGroups form a hierarchy (e.g. tenant -> workload class), the queries are bound to the leaf groups.
+// - CPU and IO are shared among the sibling groups in proportion to |cpu_limit|, see FairWorkGroupQueue.
+// - cpu_hard_limit() and io_bytes_limit() cap the usage of a group and all its descendants, a group is
+//   throttled until the next period once any of its ancestors have exceeded the caps.
+// - The MemTracker of a group is the child of the MemTracker of its parent group, so |memory_limit|
+//   bounds the memory of the group and all its descendants.
 class WorkGroup {
 public:
     WorkGroup(const std::string& name, int id, size_t cpu_limit, size_t memory_limit, size_t concurrency,
               WorkGroupType type);
     ~WorkGroup() = default;
 
+    // Must be called before init().
+    void set_parent(const WorkGroupPtr& parent) { _parent = parent; }
+    // At most |num_cores| cores could be used by this group, 0 means no hard limit.
+    void set_cpu_hard_limit(double num_cores) { _cpu_hard_limit = num_cores; }
+    // At most |bytes_per_second| bytes could be read by the scans of this group, 0 means no limit.
+    void set_io_bytes_limit(int64_t bytes_per_second) { _io_bytes_limit = bytes_per_second; }
+
     void init();
 
     starrocks::MemTracker* mem_tracker() { return _mem_tracker.get(); }
     starrocks::pipeline::DriverQueue* driver_queue() { return _driver_queue.get(); }
+    const starrocks::pipeline::DriverQueue* driver_queue() const { return _driver_queue.get(); }
 
     int id() const { return _id; }
+    const std::string& name() const { return _name; }
+    WorkGroup* parent() const { return _parent.get(); }
+    // Weight of the share among the sibling groups.
+    size_t weight() const { return std::max<size_t>(_cpu_limit, 1); }
+    double cpu_hard_limit() const { return _cpu_hard_limit; }
+    int64_t io_bytes_limit() const { return _io_bytes_limit; }
+
     int get_cpu_priority() {
         // TODO: implement cpu priority computation
         return 0;
@@ -75,6 +152,26 @@ public:
         return 0;
     }
 
+    // Account the cpu time and scanned bytes to this group and all its ancestors.
+    void incr_cpu_runtime_ns(int64_t runtime_ns);
+    void incr_io_bytes(int64_t bytes);
+
+    int64_t cpu_runtime_ns() const { return _cpu_runtime_ns.load(std::memory_order_relaxed); }
+    int64_t io_bytes() const { return _io_bytes.load(std::memory_order_relaxed); }
+
+    // Whether this group or any of its ancestors exceeds its hard limit in the current period.
+    bool is_cpu_throttled() const;
+    bool is_io_throttled() const;
+
+    // Only used by FairWorkGroupQueue.
+    int64_t cpu_vruntime_ns() const { return _cpu_vruntime_ns.load(std::memory_order_relaxed); }
+    void set_cpu_vruntime_ns(int64_t vruntime) { _cpu_vruntime_ns.store(vruntime, std::memory_order_relaxed); }
+    int64_t io_vruntime() const { return _io_vruntime.load(std::memory_order_relaxed); }
+    void set_io_vruntime(int64_t vruntime) { _io_vruntime.store(vruntime, std::memory_order_relaxed); }
+    // Number of the io tasks of this group submitted but not started yet.
+    int64_t num_pending_io_tasks() const { return _num_pending_io_tasks.load(std::memory_order_relaxed); }
+    void incr_num_pending_io_tasks(int64_t delta) { _num_pending_io_tasks.fetch_add(delta); }
+
 private:
     std::string _name;
     int _id;
@@ -82,10 +179,22 @@ private:
     size_t _memory_limit;
     size_t _concurrency;
     WorkGroupType _type;
+    WorkGroupPtr _parent;
+    double _cpu_hard_limit = 0;
+    int64_t _io_bytes_limit = 0;
+
     std::shared_ptr<starrocks::MemTracker> _mem_tracker;
     starrocks::pipeline::DriverQueuePtr _driver_queue;
     // it's proper to define Context as a Thrift or protobuf struct.
     // WorkGroupContext _context;
+
+    std::atomic<int64_t> _cpu_runtime_ns{0};
+    std::atomic<int64_t> _cpu_vruntime_ns{0};
+    PeriodicUsage _cpu_usage;
+    std::atomic<int64_t> _io_bytes{0};
+    std::atomic<int64_t> _io_vruntime{0};
+    PeriodicUsage _io_usage;
+    std::atomic<int64_t> _num_pending_io_tasks{0};
 };
 
 // WorkGroupManager is a singleton used to manage WorkGroup instances in BE, it has an io queue and a cpu queues for
@@ -103,6 +212,9 @@ public:
     // get next workgroup for io
     WorkGroupPtr pick_next_wg_for_io();
 
+    // number of the pipeline drivers of all the workgroups that are ready to run, tells how busy the queries are
+    size_t num_ready_drivers();
+
     WorkGroupQueue& get_cpu_queue();
 
     WorkGroupQueue& get_io_queue();
@@ -115,4 +227,4 @@ private:
 };
 
 } // namespace workgroup
-} // namespace starrocks
\ No newline at end of file
+} // namespace starrocks
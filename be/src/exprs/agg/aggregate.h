@@ -103,6 +103,19 @@ public:
                                            int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                            int64_t frame_end) const {}
 
+    // For window functions with sliding frame
+    // Whether the rows updated by update_batch_single_state could be removed from the state again,
+    // so the state of the next frame is got by only updating the rows entering the frame and
+    // removing the rows leaving it.
+    virtual bool is_removable() const { return false; }
+
+    // For window functions with sliding frame
+    // Remove the non-null rows [frame_start, frame_end) from the state, only called if is_removable().
+    // The caller resets the state instead once no non-null row is left in the frame, so the nullable
+    // functions need not count their non-null rows.
+    virtual void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                           int64_t frame_start, int64_t frame_end) const {}
+
     // For window functions
     // A peer group is all of the rows that are peers within the specified ordering.
     // Rows are peers if they compare equal to each other using the specified ordering expression.
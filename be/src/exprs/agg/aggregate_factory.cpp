@@ -28,6 +28,7 @@
 #include "exprs/agg/sum.h"
 #include "exprs/agg/variance.h"
 #include "exprs/agg/window.h"
+#include "exprs/agg/window_funnel.h"
 #include "percentile_union.h"
 
 namespace starrocks::vectorized {
@@ -145,6 +146,11 @@ AggregateFunctionPtr AggregateFactory::MakeRetentionAggregateFunction() {
     return std::make_shared<RetentionAggregateFunction>();
 }
 
+template <PrimitiveType PT>
+AggregateFunctionPtr AggregateFactory::MakeWindowFunnelAggregateFunction() {
+    return std::make_shared<WindowFunnelAggregateFunction<PT>>();
+}
+
 AggregateFunctionPtr AggregateFactory::MakeHllUnionAggregateFunction() {
     return std::make_shared<HllUnionAggregateFunction>();
 }
@@ -318,12 +324,23 @@ public:
                 auto retentoin = AggregateFactory::MakeRetentionAggregateFunction();
                 return AggregateFactory::MakeNullableAggregateFunctionUnary<RetentionState>(retentoin);
             }
+            if constexpr (arg_type == TYPE_DATETIME || arg_type == TYPE_DATE) {
+                if (name == "window_funnel") {
+                    auto window_funnel = AggregateFactory::MakeWindowFunnelAggregateFunction<arg_type>();
+                    return AggregateFactory::MakeNullableAggregateFunctionVariadic<WindowFunnelState>(window_funnel);
+                }
+            }
         } else {
             if (name == "dict_merge") {
                 return AggregateFactory::MakeDictMergeAggregateFunction();
             } else if (name == "retention") {
                 return AggregateFactory::MakeRetentionAggregateFunction();
             }
+            if constexpr (arg_type == TYPE_DATETIME || arg_type == TYPE_DATE) {
+                if (name == "window_funnel") {
+                    return AggregateFactory::MakeWindowFunnelAggregateFunction<arg_type>();
+                }
+            }
         }
 
         return nullptr;
@@ -828,6 +845,9 @@ AggregateFuncResolver::AggregateFuncResolver() {
 
     add_array_mapping<TYPE_ARRAY, TYPE_VARCHAR>("dict_merge");
     add_array_mapping<TYPE_ARRAY, TYPE_ARRAY>("retention");
+    // window_funnel is resolved by the type of its time argument.
+    add_array_mapping<TYPE_DATETIME, TYPE_INT>("window_funnel");
+    add_array_mapping<TYPE_DATE, TYPE_INT>("window_funnel");
 }
 
 #undef ADD_ALL_TYPE
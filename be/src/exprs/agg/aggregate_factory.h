@@ -69,6 +69,8 @@ public:
 
     static AggregateFunctionPtr MakeDictMergeAggregateFunction();
     static AggregateFunctionPtr MakeRetentionAggregateFunction();
+    template <PrimitiveType PT>
+    static AggregateFunctionPtr MakeWindowFunnelAggregateFunction();
 
     // Hyperloglog functions:
     static AggregateFunctionPtr MakeHllUnionAggregateFunction();
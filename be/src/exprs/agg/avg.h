@@ -87,6 +87,12 @@ public:
         // So, we use integers to perform operations
         [[maybe_unused]] SumResultType local_sum_for_arithmetic{};
 
+        if constexpr (PT == TYPE_DECIMAL128) {
+            this->data(state).sum += sum_int128(column->get_data().data(), chunk_size);
+            this->data(state).count += chunk_size;
+            return;
+        }
+
         for (size_t i = 0; i < chunk_size; ++i) {
             if constexpr (pt_is_datetime<PT>) {
                 this->data(state).sum += column->get_data()[i].to_unix_second();
@@ -23,6 +23,18 @@ public:
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        const BitmapColumn* col = down_cast<const BitmapColumn*>(columns[0]);
+        this->data(state).fast_union(collect_bitmaps(col, chunk_size));
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column* column,
+                                  AggDataPtr __restrict state) const override {
+        const BitmapColumn* col = down_cast<const BitmapColumn*>(column);
+        this->data(state).fast_union(collect_bitmaps(col, chunk_size));
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
         BitmapColumn* col = down_cast<BitmapColumn*>(to);
         auto& value = const_cast<BitmapValue&>(this->data(state));
@@ -39,6 +51,15 @@ public:
     }
 
     std::string get_name() const override { return "bitmap_union_count"; }
+
+private:
+    static std::vector<const BitmapValue*> collect_bitmaps(const BitmapColumn* col, size_t chunk_size) {
+        std::vector<const BitmapValue*> values(chunk_size);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            values[i] = col->get_object(i);
+        }
+        return values;
+    }
 };
 
 } // namespace starrocks::vectorized
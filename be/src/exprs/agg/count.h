@@ -36,6 +36,13 @@ public:
         this->data(state).count += (frame_end - frame_start);
     }
 
+    bool is_removable() const override { return true; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        this->data(state).count -= (frame_end - frame_start);
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
         DCHECK(column->is_numeric());
         const auto* input_column = down_cast<const Int64Column*>(column);
@@ -126,6 +133,23 @@ public:
         }
     }
 
+    bool is_removable() const override { return true; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        if (columns[0]->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(columns[0]);
+            if (nullable_column->has_null()) {
+                const uint8_t* null_data = nullable_column->immutable_null_column_data().data();
+                for (size_t i = frame_start; i < frame_end; ++i) {
+                    this->data(state).count -= !null_data[i];
+                }
+                return;
+            }
+        }
+        this->data(state).count -= (frame_end - frame_start);
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
         DCHECK(column->is_numeric());
         const auto* input_column = down_cast<const Int64Column*>(column);
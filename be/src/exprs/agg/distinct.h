@@ -4,6 +4,8 @@
 
 #include <cstring>
 #include <limits>
+#include <memory>
+#include <roaring/roaring.hh>
 #include <type_traits>
 
 #include "column/array_column.h"
@@ -183,43 +185,84 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
     using MyHashSet = HashSet<T>;
     static constexpr size_t item_size = phmap::item_serialize_size<MyHashSet>::value;
 
+    // The integer keys of at most 32 bits could be held in a bitmap instead of the hash set, which is much
+    // smaller when the keys are dense. Whether it is smaller is checked each time the set doubles from
+    // BITMAP_CHECK_SIZE, and the set is converted to the bitmap if so. The serialized format is the same.
+    static constexpr bool support_bitmap = std::is_integral_v<T> && sizeof(T) <= sizeof(uint32_t);
+    static constexpr size_t BITMAP_CHECK_SIZE = 4096;
+
     size_t update(T key) {
+        if constexpr (support_bitmap) {
+            if (bitmap != nullptr) {
+                return bitmap->addChecked(to_bitmap_key(key)) * sizeof(uint16_t);
+            }
+        }
         auto pair = set.insert(key);
+        if (pair.second) {
+            _maybe_convert_to_bitmap();
+        }
         return pair.second * item_size;
     }
 
     size_t update_with_hash([[maybe_unused]] MemPool* mempool, T key, size_t hash) {
+        if constexpr (support_bitmap) {
+            if (bitmap != nullptr) {
+                return bitmap->addChecked(to_bitmap_key(key)) * sizeof(uint16_t);
+            }
+        }
         auto pair = set.emplace_with_hash(hash, key);
+        if (pair.second) {
+            _maybe_convert_to_bitmap();
+        }
         return pair.second * item_size;
     }
 
     void prefetch(T key) { set.prefetch(key); }
 
-    int64_t disctint_count() const { return set.size(); }
+    int64_t disctint_count() const {
+        if constexpr (support_bitmap) {
+            if (bitmap != nullptr) {
+                return bitmap->cardinality();
+            }
+        }
+        return set.size();
+    }
 
     size_t serialize_size() const {
-        size_t size = set.size() * sizeof(T) + sizeof(size_t);
+        size_t size = disctint_count() * sizeof(T) + sizeof(size_t);
         size = std::max(size, MIN_SIZE_OF_HASH_SET_SERIALIZED_DATA);
         return size;
     }
 
     void serialize(uint8_t* dst) const {
-        size_t size = set.size();
+        size_t size = disctint_count();
         memcpy(dst, &size, sizeof(size));
         dst += sizeof(size);
-        for (auto& key : set) {
+        _for_each_key([&](T key) {
             memcpy(dst, &key, sizeof(key));
             dst += sizeof(T);
-        }
+        });
     }
 
     size_t deserialize_and_merge(const uint8_t* src, size_t len) {
         size_t size = 0;
         memcpy(&size, src, sizeof(size));
+        src += sizeof(size);
+        if constexpr (support_bitmap) {
+            if (bitmap != nullptr) {
+                size_t old_size = bitmap->cardinality();
+                for (size_t i = 0; i < size; i++) {
+                    T key;
+                    memcpy(&key, src, sizeof(T));
+                    bitmap->add(to_bitmap_key(key));
+                    src += sizeof(T);
+                }
+                return (bitmap->cardinality() - old_size) * sizeof(uint16_t);
+            }
+        }
         set.rehash(set.size() + size);
 
         size_t old_size = set.size();
-        src += sizeof(size);
         for (size_t i = 0; i < size; i++) {
             T key;
             memcpy(&key, src, sizeof(T));
@@ -227,6 +270,7 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
             src += sizeof(T);
         }
         size_t new_size = set.size();
+        _maybe_convert_to_bitmap();
         return (new_size - old_size) * item_size;
     }
 
@@ -237,9 +281,7 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
             return sum;
         }
 
-        for (auto& key : set) {
-            sum += key;
-        }
+        _for_each_key([&](T key) { sum += key; });
         return sum;
     }
 
@@ -251,7 +293,51 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
 #endif
     }
 
+    // The signed keys are mapped to the bitmap keys by their bits, so the negative ones are kept too.
+    static uint32_t to_bitmap_key(T key) { return static_cast<std::make_unsigned_t<T>>(key); }
+    static T from_bitmap_key(uint32_t key) { return static_cast<T>(static_cast<std::make_unsigned_t<T>>(key)); }
+
     MyHashSet set;
+    // Not null once the keys are converted to the bitmap, and the set is empty then.
+    std::unique_ptr<roaring::Roaring> bitmap;
+
+private:
+    template <typename Func>
+    void _for_each_key(Func&& func) const {
+        if constexpr (support_bitmap) {
+            if (bitmap != nullptr) {
+                for (uint32_t key : *bitmap) {
+                    func(from_bitmap_key(key));
+                }
+                return;
+            }
+        }
+        for (auto& key : set) {
+            func(key);
+        }
+    }
+
+    void _maybe_convert_to_bitmap() {
+        if constexpr (support_bitmap) {
+            if (set.size() < _next_bitmap_check_size) {
+                return;
+            }
+            auto keys = std::make_unique<roaring::Roaring>();
+            for (auto& key : set) {
+                keys->add(to_bitmap_key(key));
+            }
+            keys->runOptimize();
+            // The bitmap has to be at least half of the set, for its slower insertion.
+            if (keys->getSizeInBytes() * 2 <= set.capacity() * (sizeof(T) + 1)) {
+                bitmap = std::move(keys);
+                MyHashSet().swap(set);
+            } else {
+                _next_bitmap_check_size = set.size() * 2;
+            }
+        }
+    }
+
+    size_t _next_bitmap_check_size = BITMAP_CHECK_SIZE;
 };
 
 template <PrimitiveType PT>
@@ -2,23 +2,117 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 #include "column/column_helper.h"
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
 #include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
+#include "runtime/mem_pool.h"
+#include "udf/udf_internal.h"
 
 namespace starrocks::vectorized {
 template <PrimitiveType PT, typename = guard::Guard>
 inline constexpr PrimitiveType GroupConcatResultPT = TYPE_VARCHAR;
 
-struct GroupConcatAggregateState {
-    // intermediate_string.
-    // concat with sep_length first.
-    std::string intermediate_string{};
+// The intermediate string is concatenated with sep_length first.
+// It is kept in a chain of blocks allocated from the mem pool of the aggregator, so growing it neither
+// reallocates nor copies the bytes already appended, and the groups do not own separate heap allocations.
+// The blocks are kept on reset and reused by the next group of a window function.
+class GroupConcatAggregateState {
+public:
+    static constexpr size_t kMinBlockSize = 64;
+    static constexpr size_t kMaxBlockSize = 64 * 1024;
+
+    void append(MemPool* mem_pool, const char* data, size_t n) {
+        while (n > 0) {
+            if (_tail == nullptr || _tail->size == _tail->capacity) {
+                _next_block(mem_pool, 1);
+            }
+            size_t len = std::min<size_t>(n, _tail->capacity - _tail->size);
+            strings::memcpy_inlined(_tail->data() + _tail->size, data, len);
+            _tail->size += len;
+            _size += len;
+            data += len;
+            n -= len;
+        }
+    }
+
+    // Make room for |n| bytes in the tail block, so the next appends of |n| bytes go to one block.
+    void reserve(MemPool* mem_pool, size_t n) {
+        if (_tail == nullptr || _tail->capacity - _tail->size < n) {
+            _next_block(mem_pool, n);
+        }
+    }
+
+    // Copy the |len| bytes starting at |from| to |dst|.
+    void copy_to(size_t from, size_t len, char* dst) const {
+        for (const Block* block = _head; block != nullptr && len > 0; block = block->next) {
+            if (from >= block->size) {
+                from -= block->size;
+                continue;
+            }
+            size_t n = std::min<size_t>(len, block->size - from);
+            strings::memcpy_inlined(dst, block->data() + from, n);
+            dst += n;
+            len -= n;
+            from = 0;
+        }
+    }
+
+    void clear() {
+        for (Block* block = _head; block != nullptr; block = block->next) {
+            block->size = 0;
+        }
+        _tail = _head;
+        _size = 0;
+        initial = false;
+    }
+
+    size_t size() const { return _size; }
+
     // is initial
     bool initial{};
+
+private:
+    struct Block {
+        Block* next;
+        size_t size;
+        size_t capacity;
+
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+        const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    // Move to the next block with room for |n| bytes, the blocks too small for it are skipped and left empty.
+    void _next_block(MemPool* mem_pool, size_t n) {
+        Block* prev = _tail;
+        Block* block = prev == nullptr ? _head : prev->next;
+        while (block != nullptr && block->capacity - block->size < n) {
+            prev = block;
+            block = block->next;
+        }
+        if (block == nullptr) {
+            size_t capacity = std::max(n, std::min(kMaxBlockSize, std::max(kMinBlockSize, _size)));
+            block = reinterpret_cast<Block*>(mem_pool->allocate(sizeof(Block) + capacity));
+            DCHECK(block != nullptr);
+            block->next = nullptr;
+            block->size = 0;
+            block->capacity = capacity;
+            if (prev == nullptr) {
+                _head = block;
+            } else {
+                prev->next = block;
+            }
+        }
+        _tail = block;
+    }
+
+    Block* _head = nullptr;
+    Block* _tail = nullptr;
+    size_t _size = 0;
 };
 
 template <PrimitiveType PT, typename T = RunTimeCppType<PT>, PrimitiveType ResultPT = GroupConcatResultPT<PT>,
@@ -31,90 +125,59 @@ public:
     using ResultColumnType = InputColumnType;
 
     void reset(FunctionContext* ctx, const Columns& args, AggDataPtr state) const override {
-        this->data(state).intermediate_string = {};
-        this->data(state).initial = false;
+        this->data(state).clear();
     }
 
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr __restrict state,
                 size_t row_num) const override {
         DCHECK(columns[0]->is_binary());
+        const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
+        Slice val = column_val->get_slice(row_num);
+        Slice sep;
         if (ctx->get_num_args() > 1) {
             auto const_column_sep = ctx->get_constant_column(1);
             if (const_column_sep == nullptr) {
-                const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
                 const InputColumnType* column_sep = down_cast<const InputColumnType*>(columns[1]);
-
-                std::string& result = this->data(state).intermediate_string;
-
-                Slice val = column_val->get_slice(row_num);
-                Slice sep = column_sep->get_slice(row_num);
-                if (!this->data(state).initial) {
-                    this->data(state).initial = true;
-
-                    // separator's length;
-                    uint32_t size = sep.get_size();
-                    result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                            .append(sep.get_data(), sep.get_size())
-                            .append(val.get_data(), val.get_size());
-                } else {
-                    result.append(sep.get_data(), sep.get_size()).append(val.get_data(), val.get_size());
-                }
+                sep = column_sep->get_slice(row_num);
             } else {
-                const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-                std::string& result = this->data(state).intermediate_string;
-
-                Slice val = column_val->get_slice(row_num);
-                Slice sep = ColumnHelper::get_const_value<TYPE_VARCHAR>(const_column_sep);
-
-                if (!this->data(state).initial) {
-                    this->data(state).initial = true;
-
-                    // separator's length;
-                    uint32_t size = sep.get_size();
-                    result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                            .append(sep.get_data(), sep.get_size())
-                            .append(val.get_data(), val.get_size());
-                } else {
-                    result.append(sep.get_data(), sep.get_size()).append(val.get_data(), val.get_size());
-                }
+                sep = ColumnHelper::get_const_value<TYPE_VARCHAR>(const_column_sep);
             }
         } else {
-            const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-            std::string& result = this->data(state).intermediate_string;
-
-            Slice val = column_val->get_slice(row_num);
             //DEFAULT sep_length.
-            if (!this->data(state).initial) {
-                this->data(state).initial = true;
-
-                // separator's length;
-                uint32_t size = 2;
-                result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                        .append(", ")
-                        .append(val.get_data(), val.get_size());
-            } else {
-                result.append(", ").append(val.get_data(), val.get_size());
-            }
+            sep = Slice(", ", 2);
+        }
+
+        auto& result = this->data(state);
+        MemPool* mem_pool = ctx->impl()->mem_pool();
+        if (!result.initial) {
+            result.initial = true;
+
+            // separator's length;
+            uint32_t size = sep.get_size();
+            result.append(mem_pool, reinterpret_cast<const char*>(&size), sizeof(uint32_t));
         }
+        result.append(mem_pool, sep.get_data(), sep.get_size());
+        result.append(mem_pool, val.get_data(), val.get_size());
     }
 
     void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
                                    AggDataPtr __restrict state) const override {
+        MemPool* mem_pool = ctx->impl()->mem_pool();
         if (ctx->get_num_args() > 1) {
             const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
             auto const_column_sep = ctx->get_constant_column(1);
             if (const_column_sep == nullptr) {
                 const InputColumnType* column_sep = down_cast<const InputColumnType*>(columns[1]);
-                this->data(state).intermediate_string.reserve(column_val->get_bytes().size() +
-                                                              column_sep->get_bytes().size());
+                this->data(state).reserve(mem_pool, column_val->get_bytes().size() + column_sep->get_bytes().size() +
+                                                            sizeof(uint32_t));
             } else {
                 Slice sep = ColumnHelper::get_const_value<TYPE_VARCHAR>(const_column_sep);
-                this->data(state).intermediate_string.reserve(column_val->get_bytes().size() +
-                                                              sep.get_size() * chunk_size);
+                this->data(state).reserve(mem_pool, column_val->get_bytes().size() + sep.get_size() * chunk_size +
+                                                            sizeof(uint32_t));
             }
         } else {
             const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-            this->data(state).intermediate_string.reserve(column_val->get_bytes().size() + 2 * chunk_size);
+            this->data(state).reserve(mem_pool, column_val->get_bytes().size() + 2 * chunk_size + sizeof(uint32_t));
         }
 
         for (size_t i = 0; i < chunk_size; ++i) {
@@ -136,13 +199,14 @@ public:
         uint32_t size_value = *reinterpret_cast<uint32_t*>(data);
         data += sizeof(uint32_t);
 
+        MemPool* mem_pool = ctx->impl()->mem_pool();
         if (!this->data(state).initial) {
             this->data(state).initial = true;
-            this->data(state).intermediate_string.append(data, size_value);
+            this->data(state).append(mem_pool, data, size_value);
         } else {
             data += sizeof(uint32_t);
 
-            this->data(state).intermediate_string.append(data, size_value - sizeof(uint32_t));
+            this->data(state).append(mem_pool, data, size_value - sizeof(uint32_t));
         }
     }
 
@@ -152,7 +216,7 @@ public:
         auto* column = down_cast<BinaryColumn*>(to);
         Bytes& bytes = column->get_bytes();
 
-        const std::string& value = this->data(state).intermediate_string;
+        const auto& value = this->data(state);
 
         size_t old_size = bytes.size();
         size_t new_size = old_size + sizeof(uint32_t) + value.size();
@@ -160,7 +224,7 @@ public:
 
         uint32_t size_value = value.size();
         memcpy(bytes.data() + old_size, &size_value, sizeof(uint32_t));
-        memcpy(bytes.data() + old_size + sizeof(uint32_t), value.data(), size_value);
+        value.copy_to(0, size_value, reinterpret_cast<char*>(bytes.data() + old_size + sizeof(uint32_t)));
 
         column->get_offset().emplace_back(new_size);
     }
@@ -260,17 +324,21 @@ public:
     }
 
     void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
-        const std::string& value = this->data(state).intermediate_string;
+        const auto& value = this->data(state);
         // Remove first sep_length.
-        const char* data = value.data();
-        uint32_t size = value.size();
-
-        uint32_t sep_size = *reinterpret_cast<const uint32_t*>(data);
+        uint32_t sep_size = 0;
+        value.copy_to(0, sizeof(uint32_t), reinterpret_cast<char*>(&sep_size));
         uint32_t offset = sizeof(uint32_t) + sep_size;
+        uint32_t size = value.size() - offset;
 
-        data = data + offset;
-        size = size - offset;
-        down_cast<ResultColumnType*>(to)->append(Slice(data, size));
+        // Copy the blocks into the result column directly.
+        auto* column = down_cast<ResultColumnType*>(to);
+        Bytes& bytes = column->get_bytes();
+        size_t old_size = bytes.size();
+        bytes.resize(old_size + size);
+        value.copy_to(offset, size, reinterpret_cast<char*>(bytes.data() + old_size));
+        column->get_offset().emplace_back(bytes.size());
+        column->invalidate_slice_cache();
     }
 
     std::string get_name() const override { return "group concat"; }
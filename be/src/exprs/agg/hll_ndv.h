@@ -43,32 +43,19 @@ public:
         }
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        std::vector<uint64_t> hash_values;
+        hash_rows(down_cast<const ColumnType*>(columns[0]), 0, chunk_size, &hash_values);
+        this->data(state).update_batch(hash_values.data(), hash_values.size());
+    }
+
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
-        const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
-
-        if constexpr (pt_is_binary<PT>) {
-            uint64_t value = 0;
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                Slice s = column->get_slice(i);
-                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        } else {
-            uint64_t value = 0;
-            const auto& v = column->get_data();
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                value = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        }
+        std::vector<uint64_t> hash_values;
+        hash_rows(down_cast<const ColumnType*>(columns[0]), frame_start, frame_end, &hash_values);
+        this->data(state).update_batch(hash_values.data(), hash_values.size());
     }
 
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
@@ -143,6 +130,23 @@ public:
     }
 
     std::string get_name() const override { return "ndv"; }
+
+private:
+    // Hash the rows [from, to) of |column|, the hash values are added to the HLL in one batch.
+    static void hash_rows(const ColumnType* column, size_t from, size_t to, std::vector<uint64_t>* hash_values) {
+        hash_values->resize(to - from);
+        if constexpr (pt_is_binary<PT>) {
+            for (size_t i = from; i < to; ++i) {
+                Slice s = column->get_slice(i);
+                (*hash_values)[i - from] = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
+            }
+        } else {
+            const auto& v = column->get_data();
+            for (size_t i = from; i < to; ++i) {
+                (*hash_values)[i - from] = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
+            }
+        }
+    }
 };
 
 } // namespace starrocks::vectorized
@@ -10,6 +10,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/status.h"
+#include "exprs/agg/java_window_function.h"
 #include "fmt/core.h"
 #include "fmt/format.h"
 #include "gutil/casts.h"
@@ -208,6 +209,32 @@ void append_jvalue(MethodTypeDescriptor method_type_desc, Column* col, jvalue va
     }
 }
 
+void batch_update_state(FunctionContext* ctx, int batch_size, const Column** columns, jobject state) {
+    auto& helper = JVMFunctionHelper::getInstance();
+    JNIEnv* env = helper.getEnv();
+    auto* udaf_ctx = ctx->impl()->udaf_ctxs();
+    int num_args = ctx->get_num_args();
+    // the boxed arrays are all released by the local frame
+    env->PushLocalFrame(num_args + 4);
+
+    jobject input_cols[num_args];
+    std::vector<DirectByteBuffer> buffers;
+    ConvertDirectBufferVistor vistor(buffers);
+    for (int i = 0; i < num_args; ++i) {
+        int buffers_idx = buffers.size();
+        columns[i]->accept(&vistor);
+        int buffers_sz = buffers.size() - buffers_idx;
+        input_cols[i] = udaf_ctx->udf_helper->create_boxed_array(udaf_ctx->update->method_desc[i + 2].type, batch_size,
+                                                                 columns[i]->is_nullable(), &buffers[buffers_idx],
+                                                                 buffers_sz);
+    }
+
+    jclass clazz = udaf_ctx->udaf_class.clazz();
+    jobject method = env->ToReflectedMethod(clazz, udaf_ctx->update->get_method_id(clazz), JNI_FALSE);
+    udaf_ctx->udf_helper->batch_update(udaf_ctx->handle, method, state, batch_size, input_cols, num_args);
+    env->PopLocalFrame(nullptr);
+}
+
 const int DEFAULT_UDAF_BUFFER_SIZE = 1024;
 
 const AggregateFunction* getJavaUDAFFunction(bool input_nullable) {
@@ -27,6 +27,8 @@ template <bool handle_null>
 jvalue cast_to_jvalue(MethodTypeDescriptor method_type_desc, const Column* col, int row_num);
 void release_jvalue(MethodTypeDescriptor method_type_desc, jvalue val);
 void append_jvalue(MethodTypeDescriptor method_type_desc, Column* col, jvalue val);
+// update |state| by all the rows of |columns| with a single JNI call, all the update arguments must be boxed
+void batch_update_state(FunctionContext* ctx, int batch_size, const Column** columns, jobject state);
 Status get_java_udaf_function(int fid, const std::string& url, const std::string& checksum, const std::string& symbol,
                               starrocks_udf::FunctionContext* context, AggregateFunction** func);
 // Not Support Nullable
@@ -109,6 +111,18 @@ public:
         DCHECK(false) << "Now Java UDAF Not Support Streaming Mode";
     }
 
+    // The boxed arguments could be passed by arrays boxed in Java from the memory of the columns,
+    // then all the rows update the state by a single JNI call.
+    static bool can_batch_update(FunctionContext* ctx) {
+        const auto& method_desc = ctx->impl()->udaf_ctxs()->update->method_desc;
+        for (int i = 0; i < ctx->get_num_args(); ++i) {
+            if (!method_desc[i + 2].is_box) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // State Data
     static State& data(AggDataPtr __restrict place) { return *reinterpret_cast<State*>(place); }
     static const State& data(ConstAggDataPtr __restrict place) { return *reinterpret_cast<const State*>(place); }
@@ -149,6 +163,10 @@ public:
 
     void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
                                    AggDataPtr __restrict state) const override {
+        if (can_batch_update(ctx)) {
+            batch_update_state(ctx, batch_size, columns, this->data(state).handle);
+            return;
+        }
         for (size_t i = 0; i < batch_size; ++i) {
             this->update(ctx, columns, state, i);
         }
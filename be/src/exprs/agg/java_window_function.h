@@ -71,8 +71,8 @@ public:
             int buffers_idx = buffers.size();
             columns[i]->accept(&vistor);
             int buffers_sz = buffers.size() - buffers_idx;
-            input_cols[i] = ctx->impl()->udaf_ctxs()->udf_helper->create_boxed_array(type, num_rows, columns[i],
-                                                                                     &buffers[buffers_idx], buffers_sz);
+            input_cols[i] = ctx->impl()->udaf_ctxs()->udf_helper->create_boxed_array(
+                    type, num_rows, columns[i]->is_nullable(), &buffers[buffers_idx], buffers_sz);
         }
         ctx->impl()->udaf_ctxs()->_func->window_update_batch(data(state).handle, peer_group_start, peer_group_end,
                                                              frame_start, frame_end, num_args, input_cols);
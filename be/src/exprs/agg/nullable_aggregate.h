@@ -497,6 +497,38 @@ public:
                                                              peer_group_start, peer_group_end, frame_start, frame_end);
         }
     }
+
+    // The null rows are processed by the nested function if not IgnoreNull, which could not be removed.
+    bool is_removable() const override { return IgnoreNull && this->nested_function->is_removable(); }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        if (frame_start >= frame_end) {
+            return;
+        }
+
+        if (columns[0]->is_nullable()) {
+            const auto* column = down_cast<const NullableColumn*>(columns[0]);
+            const Column* data_column = &column->data_column_ref();
+
+            if (!column->has_null()) {
+                this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(),
+                                                                 &data_column, frame_start, frame_end);
+                return;
+            }
+
+            const uint8_t* f_data = column->null_column()->raw_data();
+            for (size_t i = frame_start; i < frame_end; ++i) {
+                if (f_data[i] == 0) {
+                    this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(),
+                                                                     &data_column, i, i + 1);
+                }
+            }
+        } else {
+            this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(), columns,
+                                                             frame_start, frame_end);
+        }
+    }
 };
 
 template <typename State>
@@ -68,6 +68,71 @@ public:
         data(state).is_null = false;
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        const DoubleColumn* input = nullptr;
+        const uint8_t* nulls = nullptr;
+        if (columns[0]->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(columns[0]);
+            input = down_cast<const DoubleColumn*>(nullable_column->data_column().get());
+            if (nullable_column->has_null()) {
+                nulls = nullable_column->immutable_null_column_data().data();
+            }
+        } else {
+            input = down_cast<const DoubleColumn*>(columns[0]);
+        }
+
+        const auto& values = input->get_data();
+        std::vector<float> batch;
+        batch.reserve(chunk_size);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            if (nulls == nullptr || !nulls[i]) {
+                batch.emplace_back(implicit_cast<float>(values[i]));
+            }
+        }
+        if (batch.empty()) {
+            return;
+        }
+
+        DCHECK(!columns[1]->only_null());
+        DCHECK(!columns[1]->is_null(0));
+
+        data(state).percentile->add(batch.data(), batch.size());
+        data(state).targetQuantile = columns[1]->get(0).get_double();
+        data(state).is_null = false;
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column* column,
+                                  AggDataPtr __restrict state) const override {
+        std::vector<PercentileValue> percentiles(chunk_size);
+        std::vector<const PercentileValue*> others;
+        others.reserve(chunk_size);
+        double quantile = 0;
+        for (size_t i = 0; i < chunk_size; ++i) {
+            Slice src;
+            if (column->is_nullable()) {
+                if (column->is_null(i)) {
+                    continue;
+                }
+                const auto* nullable_column = down_cast<const NullableColumn*>(column);
+                src = nullable_column->data_column()->get(i).get_slice();
+            } else {
+                const auto* binary_column = down_cast<const BinaryColumn*>(column);
+                src = binary_column->get_slice(i);
+            }
+            memcpy(&quantile, src.data, sizeof(double));
+            percentiles[i].deserialize((char*)src.data + sizeof(double));
+            others.emplace_back(&percentiles[i]);
+        }
+        if (others.empty()) {
+            return;
+        }
+
+        data(state).percentile->merge(others);
+        data(state).targetQuantile = quantile;
+        data(state).is_null = false;
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
         size_t size = data(state).percentile->serialize_size();
         uint8_t result[size + sizeof(double)];
@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
+#include "column/rle_column.h"
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
 #include "gutil/casts.h"
@@ -25,6 +29,29 @@ inline constexpr PrimitiveType SumResultPT<PT, SumDecimal64PTGuard<PT>> = TYPE_D
 template <PrimitiveType PT>
 inline constexpr PrimitiveType SumResultPT<PT, DateOrDateTimePTGuard<PT>> = TYPE_DATETIME;
 
+// Sums the int128s in three independent 64-bit lanes, the two 32-bit halves of the low words and the high
+// words, which the compiler vectorizes, unlike the add/adc chain of int128. The result wraps around the same
+// as the int128 sum.
+inline int128_t sum_int128(const int128_t* data, size_t n) {
+    unsigned __int128 sum = 0;
+    // the 32-bit halves of 2^32 rows don't overflow 64 bits
+    constexpr size_t kMaxBatch = size_t(1) << 32;
+    for (size_t begin = 0; begin < n; begin += kMaxBatch) {
+        const size_t end = std::min(n, begin + kMaxBatch);
+        uint64_t low = 0;
+        uint64_t mid = 0;
+        uint64_t high = 0;
+        for (size_t i = begin; i < end; ++i) {
+            auto v = static_cast<unsigned __int128>(data[i]);
+            low += static_cast<uint32_t>(v);
+            mid += static_cast<uint32_t>(v >> 32);
+            high += static_cast<uint64_t>(v >> 64);
+        }
+        sum += low + (static_cast<unsigned __int128>(mid) << 32) + (static_cast<unsigned __int128>(high) << 64);
+    }
+    return static_cast<int128_t>(sum);
+}
+
 template <typename T>
 struct SumAggregateState {
     T sum{};
@@ -52,8 +79,16 @@ public:
 
     void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
                                    AggDataPtr __restrict state) const override {
+        if (columns[0]->is_rle()) {
+            _update_runs(down_cast<const RleColumn&>(*columns[0]), state);
+            return;
+        }
         const auto* column = down_cast<const InputColumnType*>(columns[0]);
         const auto* data = column->get_data().data();
+        if constexpr (std::is_same_v<T, int128_t> && std::is_same_v<ResultType, int128_t>) {
+            this->data(state).sum += sum_int128(data, chunk_size);
+            return;
+        }
         for (size_t i = 0; i < chunk_size; ++i) {
             this->data(state).sum += data[i];
         }
@@ -64,11 +99,32 @@ public:
                                    int64_t frame_end) const override {
         const auto* column = down_cast<const InputColumnType*>(columns[0]);
         const auto* data = column->get_data().data();
+        if constexpr (std::is_same_v<T, int128_t> && std::is_same_v<ResultType, int128_t>) {
+            this->data(state).sum += sum_int128(data + frame_start, frame_end - frame_start);
+            return;
+        }
         for (size_t i = frame_start; i < frame_end; ++i) {
             this->data(state).sum += data[i];
         }
     }
 
+    // Only the integer (and decimal) sum is removable, the rounding errors of removing the floating
+    // point values would accumulate.
+    static constexpr bool removable = std::is_integral_v<ResultType> || std::is_same_v<ResultType, int128_t>;
+
+    bool is_removable() const override { return removable; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        if constexpr (removable) {
+            const auto* column = down_cast<const InputColumnType*>(columns[0]);
+            const auto* data = column->get_data().data();
+            for (size_t i = frame_start; i < frame_end; ++i) {
+                this->data(state).sum -= data[i];
+            }
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
         DCHECK(column->is_numeric() || column->is_decimal());
         const auto* input_column = down_cast<const ResultColumnType*>(column);
@@ -117,6 +173,22 @@ public:
     }
 
     std::string get_name() const override { return "sum"; }
+
+private:
+    // The data column of |column| must not be nullable. A run of integers is added at once.
+    void _update_runs(const RleColumn& column, AggDataPtr __restrict state) const {
+        DCHECK(!column.data_column()->is_nullable());
+        const auto* data = down_cast<const InputColumnType*>(column.data_column().get())->get_data().data();
+        for (size_t run = 0; run < column.num_runs(); ++run) {
+            if constexpr (removable) {
+                this->data(state).sum += static_cast<ResultType>(data[run]) * column.run_length(run);
+            } else {
+                for (uint32_t i = 0; i < column.run_length(run); ++i) {
+                    this->data(state).sum += data[run];
+                }
+            }
+        }
+    }
 };
 
 } // namespace starrocks::vectorized
@@ -0,0 +1,238 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "column/array_column.h"
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "column/vectorized_fwd.h"
+#include "exprs/agg/aggregate.h"
+#include "gutil/casts.h"
+#include "runtime/date_value.h"
+#include "runtime/timestamp_value.h"
+
+namespace starrocks::vectorized {
+
+// The funnel supports at most 64 conditions, one bit of the event mask for each.
+inline constexpr size_t kWindowFunnelMaxConditions = 64;
+
+struct WindowFunnelState {
+    // An event is a row with at least one condition satisfied: the time of the row in the unit of
+    // the window (seconds for DATETIME, days for DATE) and the bitset of its satisfied conditions.
+    using Event = std::pair<int64_t, uint64_t>;
+
+    void add_event(int64_t time, uint64_t mask) {
+        if (mask == 0) {
+            return;
+        }
+        sorted = sorted && (events.empty() || events.back() <= Event(time, mask));
+        events.emplace_back(time, mask);
+    }
+
+    void sort() {
+        if (!sorted) {
+            std::sort(events.begin(), events.end());
+            sorted = true;
+        }
+    }
+
+    // The other events are merged in order if both sides are sorted, so the serialized states of the
+    // partial aggregation, which are sorted, never need a full sort again.
+    void merge_events(const Event* other, size_t n, bool other_sorted) {
+        size_t old_size = events.size();
+        events.insert(events.end(), other, other + n);
+        if (sorted && other_sorted) {
+            std::inplace_merge(events.begin(), events.begin() + old_size, events.end());
+        } else {
+            sorted = false;
+        }
+    }
+
+    size_t serialize_size() const { return sizeof(int64_t) + sizeof(uint32_t) + events.size() * sizeof(Event); }
+
+    // |window|, |num_conditions|, then the events sorted by time.
+    void serialize(uint8_t* dst) {
+        sort();
+        memcpy(dst, &window, sizeof(int64_t));
+        dst += sizeof(int64_t);
+        memcpy(dst, &num_conditions, sizeof(uint32_t));
+        dst += sizeof(uint32_t);
+        memcpy(dst, events.data(), events.size() * sizeof(Event));
+    }
+
+    void merge(const Slice& src) {
+        const char* data = src.data;
+        memcpy(&window, data, sizeof(int64_t));
+        data += sizeof(int64_t);
+        uint32_t other_num_conditions = 0;
+        memcpy(&other_num_conditions, data, sizeof(uint32_t));
+        data += sizeof(uint32_t);
+        num_conditions = std::max(num_conditions, other_num_conditions);
+
+        size_t n = (src.size - sizeof(int64_t) - sizeof(uint32_t)) / sizeof(Event);
+        std::vector<Event> other(n);
+        memcpy(other.data(), data, n * sizeof(Event));
+        merge_events(other.data(), n, true);
+    }
+
+    // The max level of the funnel reached within the window.
+    // first_times[k] is the start time of the latest chain that has reached the level k + 1. The
+    // conditions of one event are visited from the last one, so one event never advances a chain by
+    // more than one level.
+    int32_t level() {
+        if (num_conditions == 0) {
+            return 0;
+        }
+        sort();
+        std::vector<int64_t> first_times(num_conditions);
+        std::vector<uint8_t> reached(num_conditions, 0);
+        int32_t max_level = 0;
+        for (const auto& [time, mask] : events) {
+            for (int k = static_cast<int>(num_conditions) - 1; k >= 0; --k) {
+                if ((mask & (uint64_t(1) << k)) == 0) {
+                    continue;
+                }
+                if (k == 0) {
+                    first_times[0] = time;
+                    reached[0] = 1;
+                } else if (reached[k - 1] && time <= first_times[k - 1] + window) {
+                    first_times[k] = first_times[k - 1];
+                    reached[k] = 1;
+                } else {
+                    continue;
+                }
+                max_level = std::max(max_level, k + 1);
+                if (max_level == static_cast<int32_t>(num_conditions)) {
+                    return max_level;
+                }
+            }
+        }
+        return max_level;
+    }
+
+    std::vector<Event> events;
+    int64_t window = 0;
+    uint32_t num_conditions = 0;
+    bool sorted = true;
+};
+
+/*
+ * window_funnel searches the events of one group for chains of the conditions in the funnel and returns
+ * the max number of consecutive conditions of a chain within the window.
+ *
+ *  INT window_funnel(BIGINT window, DATETIME|DATE time, ARRAY<BOOLEAN> [cond1, cond2, ..., condN])
+ *
+ * A chain starts at an event satisfying cond1 at time t, and continues by the events satisfying cond2, ...,
+ * condN in time order, all of them no later than t + window. The window is in seconds for DATETIME and in
+ * days for DATE. For example, the number of users reaching each step of view -> cart -> pay in one hour:
+ *
+ *              select level, count(*) from (select uid, window_funnel(3600, event_time, [event_type = 'view',
+ *              event_type = 'cart', event_type = 'pay']) as level from events group by uid) t group by level;
+ *
+ * The state keeps only the rows satisfying a condition, as pairs of time and condition bitset.
+ */
+template <PrimitiveType PT>
+class WindowFunnelAggregateFunction final
+        : public AggregateFunctionBatchHelper<WindowFunnelState, WindowFunnelAggregateFunction<PT>> {
+public:
+    using TimeColumnType = RunTimeColumnType<PT>;
+
+    void update(FunctionContext* ctx, const Column** columns, AggDataPtr __restrict state,
+                size_t row_num) const override {
+        update_rows(columns, state, row_num, row_num + 1);
+    }
+
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        update_rows(columns, state, 0, chunk_size);
+    }
+
+    void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
+        const auto* binary_column = down_cast<const BinaryColumn*>(column);
+        this->data(state).merge(binary_column->get_slice(row_num));
+    }
+
+    void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
+        auto* column = down_cast<BinaryColumn*>(to);
+        auto& funnel = const_cast<WindowFunnelState&>(this->data(state));
+        Bytes& bytes = column->get_bytes();
+        size_t old_size = bytes.size();
+        bytes.resize(old_size + funnel.serialize_size());
+        funnel.serialize(bytes.data() + old_size);
+        column->get_offset().emplace_back(bytes.size());
+        column->invalidate_slice_cache();
+    }
+
+    void convert_to_serialize_format(const Columns& src, size_t chunk_size, ColumnPtr* dst) const override {
+        auto* column = down_cast<BinaryColumn*>((*dst).get());
+        std::vector<const Column*> columns{src[0].get(), src[1].get(), src[2].get()};
+        for (size_t i = 0; i < chunk_size; ++i) {
+            WindowFunnelState funnel;
+            update_rows(columns.data(), reinterpret_cast<AggDataPtr>(&funnel), i, i + 1);
+            Bytes& bytes = column->get_bytes();
+            size_t old_size = bytes.size();
+            bytes.resize(old_size + funnel.serialize_size());
+            funnel.serialize(bytes.data() + old_size);
+            column->get_offset().emplace_back(bytes.size());
+        }
+        column->invalidate_slice_cache();
+    }
+
+    void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
+        auto& funnel = const_cast<WindowFunnelState&>(this->data(state));
+        down_cast<Int32Column*>(to)->append(funnel.level());
+    }
+
+    std::string get_name() const override { return "window_funnel"; }
+
+private:
+    static int64_t to_window_unit(const RunTimeCppType<PT>& time) {
+        if constexpr (PT == TYPE_DATETIME) {
+            return time.to_unix_second();
+        } else {
+            return time.julian();
+        }
+    }
+
+    // Add the rows [from, to) to the state, reading the columns directly. The window is a constant.
+    static void update_rows(const Column** columns, AggDataPtr __restrict state, size_t from, size_t to) {
+        auto& funnel = WindowFunnelAggregateFunction::data(state);
+        funnel.window = columns[0]->get(0).get_int64();
+
+        const auto& times = down_cast<const TimeColumnType*>(ColumnHelper::get_data_column(columns[1]))->get_data();
+        const auto* conditions = down_cast<const ArrayColumn*>(ColumnHelper::get_data_column(columns[2]));
+        const auto& offsets = conditions->offsets().get_data();
+        const Column* elements = &conditions->elements();
+        const NullData* element_nulls = nullptr;
+        if (elements->is_nullable()) {
+            const auto* nullable_elements = down_cast<const NullableColumn*>(elements);
+            if (nullable_elements->has_null()) {
+                element_nulls = &nullable_elements->immutable_null_column_data();
+            }
+            elements = nullable_elements->data_column().get();
+        }
+        const auto& values = down_cast<const BooleanColumn*>(elements)->get_data();
+
+        for (size_t i = from; i < to; ++i) {
+            size_t offset = offsets[i];
+            size_t num_conditions = std::min<size_t>(offsets[i + 1] - offset, kWindowFunnelMaxConditions);
+            funnel.num_conditions = std::max<uint32_t>(funnel.num_conditions, num_conditions);
+            uint64_t mask = 0;
+            for (size_t k = 0; k < num_conditions; ++k) {
+                bool satisfied = values[offset + k] && (element_nulls == nullptr || !(*element_nulls)[offset + k]);
+                mask |= uint64_t(satisfied) << k;
+            }
+            funnel.add_event(to_window_unit(times[i]), mask);
+        }
+    }
+};
+
+} // namespace starrocks::vectorized
@@ -93,6 +93,7 @@ public:
     int output_scale() const { return _output_scale; }
 
     void add_child(Expr* expr) { _children.push_back(expr); }
+    void set_child(int i, Expr* expr) { _children[i] = expr; }
     Expr* get_child(int i) const { return _children[i]; }
     int get_num_children() const { return _children.size(); }
 
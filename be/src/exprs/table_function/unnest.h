@@ -20,30 +20,40 @@ class Unnest final : public TableFunction {
         auto* col_array = down_cast<ArrayColumn*>(ColumnHelper::get_data_column(arg0));
         Columns result;
         if (arg0->has_null()) {
-            NullableColumn* nullable_array_column = down_cast<NullableColumn*>(arg0);
+            const auto& null_data = down_cast<NullableColumn*>(arg0)->immutable_null_column_data();
+            const auto& offsets = col_array->offsets().get_data();
+            const size_t num_rows = arg0->size();
 
-            auto offset_column = col_array->offsets_column();
-            ColumnPtr compacted_offset_column = offset_column->clone_empty();
-            compacted_offset_column->append_datum(Datum(0));
-
-            ColumnPtr compacted_array_elements = col_array->elements_column()->clone_empty();
-            int compact_offset = 0;
+            // The null arrays usually have no elements, then the elements are returned as they are.
+            bool has_null_elements = false;
+            for (size_t row_idx = 0; row_idx < num_rows && !has_null_elements; ++row_idx) {
+                has_null_elements = null_data[row_idx] && offsets[row_idx + 1] > offsets[row_idx];
+            }
+            if (!has_null_elements) {
+                result.emplace_back(col_array->elements_column());
+                return std::make_pair(result, col_array->offsets_column());
+            }
 
-            for (int row_idx = 0; row_idx < nullable_array_column->size(); ++row_idx) {
-                if (nullable_array_column->is_null(row_idx)) {
-                    compact_offset +=
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32();
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
-                } else {
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
+            // Otherwise drop the elements of the null arrays, and copy each run of the non-null arrays at once.
+            auto compacted_offset_column = UInt32Column::create();
+            auto& compacted_offsets = compacted_offset_column->get_data();
+            compacted_offsets.resize(num_rows + 1);
+            compacted_offsets[0] = 0;
 
-                    compacted_array_elements->append(
-                            *(col_array->elements_column()), offset_column->get(row_idx).get_int32(),
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32());
+            ColumnPtr compacted_array_elements = col_array->elements_column()->clone_empty();
+            const Column& elements = col_array->elements();
+            uint32_t compact_offset = 0;
+            size_t run_start = 0;
+            for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+                if (null_data[row_idx]) {
+                    compacted_array_elements->append(elements, offsets[run_start],
+                                                     offsets[row_idx] - offsets[run_start]);
+                    compact_offset += offsets[row_idx + 1] - offsets[row_idx];
+                    run_start = row_idx + 1;
                 }
+                compacted_offsets[row_idx + 1] = offsets[row_idx + 1] - compact_offset;
             }
+            compacted_array_elements->append(elements, offsets[run_start], offsets[num_rows] - offsets[run_start]);
 
             result.emplace_back(compacted_array_elements);
             return std::make_pair(result, compacted_offset_column);
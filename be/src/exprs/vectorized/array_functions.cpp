@@ -115,6 +115,29 @@ public:
     }
 
 private:
+    // The index of the first element equal to |target| in the |size| elements of |data|, or |size| if there is none.
+    // The elements are compared a batch at a time without a branch per element, so the comparisons are vectorized.
+    template <typename ValueType>
+    static size_t _find_first(const ValueType* data, size_t size, const ValueType& target) {
+        constexpr size_t kBatchSize = 16;
+        size_t i = 0;
+        for (; i + kBatchSize <= size; i += kBatchSize) {
+            uint8_t found = 0;
+            for (size_t j = 0; j < kBatchSize; j++) {
+                found |= (data[i + j] == target);
+            }
+            if (found) {
+                break;
+            }
+        }
+        for (; i < size; i++) {
+            if (data[i] == target) {
+                return i;
+            }
+        }
+        return size;
+    }
+
     template <bool NullableElement, bool NullableTarget, bool ConstTarget, typename ElementColumn,
               typename TargetColumn>
     static ColumnPtr _process(const ElementColumn& elements, const UInt32Column& offsets, const TargetColumn& targets,
@@ -381,6 +404,18 @@ private:
             size_t array_size = offsets_ptr[i + 1] - offsets_ptr[i];
             uint8_t found = 0;
             size_t position = 0;
+            if constexpr (!NullableElement && std::is_arithmetic_v<ValueType> &&
+                          !std::is_same_v<ArrayColumn, ElementColumn>) {
+                // A NULL target is never found in the non-nullable elements.
+                if (!NullableTarget || !is_null(null_map_targets, i)) {
+                    const ValueType& target = ConstTarget ? first_target : targets_ptr[i];
+                    size_t index = _find_first(elements_ptr + offset, array_size, target);
+                    found = index < array_size;
+                    position = found ? index + 1 : 0;
+                }
+                result_ptr[i] = PositionEnabled ? position : found;
+                continue;
+            }
             for (size_t j = 0; j < array_size; j++) {
                 if constexpr (NullableElement && !NullableTarget) {
                     if (is_null(null_map_elements, offset + j)) {
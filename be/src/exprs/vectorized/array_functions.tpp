@@ -34,8 +34,6 @@ private:
         ColumnPtr src_column = ColumnHelper::unpack_and_duplicate_const_column(chunk_size, columns[0]);
         ColumnPtr dest_column = src_column->clone_empty();
 
-        HashSet hash_set;
-
         if (columns[0]->is_nullable()) {
             const auto* src_nullable_column = down_cast<const NullableColumn*>(src_column.get());
             const auto* src_data_column = down_cast<const ArrayColumn*>(src_nullable_column->data_column().get());
@@ -46,62 +44,73 @@ private:
             dest_null_data = src_nullable_column->immutable_null_column_data();
             dest_nullable_column.set_has_null(src_nullable_column->has_null());
 
-            if (src_nullable_column->has_null()) {
-                for (size_t i = 0; i < chunk_size; i++) {
-                    if (!src_nullable_column->is_null(i)) {
-                        _array_distinct_item<HashSet>(*src_data_column, i, &hash_set, &dest_data_column);
-                        hash_set.clear();
-                    } else {
-                        dest_data_column.append_default();
-                    }
-                }
-            } else {
-                for (size_t i = 0; i < chunk_size; i++) {
-                    _array_distinct_item<HashSet>(*src_data_column, i, &hash_set, &dest_data_column);
-                    hash_set.clear();
-                }
-            }
+            const NullColumn::Container* null_arrays =
+                    src_nullable_column->has_null() ? &src_nullable_column->immutable_null_column_data() : nullptr;
+            _array_distinct_column<HashSet>(*src_data_column, null_arrays, &dest_data_column);
         } else {
             const auto* src_data_column = down_cast<const ArrayColumn*>(src_column.get());
             auto* dest_data_column = down_cast<ArrayColumn*>(dest_column.get());
-
-            for (size_t i = 0; i < chunk_size; i++) {
-                _array_distinct_item<HashSet>(*src_data_column, i, &hash_set, dest_data_column);
-                hash_set.clear();
-            }
+            _array_distinct_column<HashSet>(*src_data_column, nullptr, dest_data_column);
         }
         return dest_column;
     }
 
+    // The small arrays are deduplicated by comparing with the kept elements, which is cheaper than a hash set.
+    static constexpr size_t kLinearDistinctSize = 16;
+
+    // Keep the first occurrence of every distinct element of each array, the elements of the NULL arrays are
+    // dropped. The kept elements of all the arrays are appended to |dest_column| by one append_selective, and the
+    // hash set is reused by all the arrays.
     template <typename HashSet>
-    static void _array_distinct_item(const ArrayColumn& column, size_t index, HashSet* hash_set,
-                                     ArrayColumn* dest_column) {
-        bool has_null = false;
-        // TODO: may be has performance problem, optimize later
-        Datum v = column.get(index);
-        const auto& items = v.get<DatumArray>();
-
-        for (const auto& item : items) {
-            if (item.is_null()) {
-                has_null = true;
-            } else {
-                hash_set->emplace(item.get<CppType>());
-            }
+    static void _array_distinct_column(const ArrayColumn& src_column, const NullColumn::Container* null_arrays,
+                                       ArrayColumn* dest_column) {
+        const Column& src_elements = src_column.elements();
+        const auto& src_offsets = src_column.offsets().get_data();
+
+        const Column* src_data_elements = &src_elements;
+        const NullColumn::Container* null_elements = nullptr;
+        if (src_elements.is_nullable()) {
+            const auto& nullable_elements = down_cast<const NullableColumn&>(src_elements);
+            src_data_elements = nullable_elements.data_column().get();
+            null_elements = nullable_elements.has_null() ? &nullable_elements.immutable_null_column_data() : nullptr;
         }
+        const auto& values = down_cast<const RunTimeColumnType<PT>*>(src_data_elements)->get_data();
 
-        auto& dest_data_column = dest_column->elements_column();
+        HashSet hash_set;
+        std::vector<uint32_t> selection;
+        selection.reserve(src_elements.size());
         auto& dest_offsets = dest_column->offsets_column()->get_data();
-
-        if (has_null) {
-            dest_data_column->append_nulls(1);
-        }
-
-        auto iter = hash_set->begin();
-        while (iter != hash_set->end()) {
-            dest_data_column->append_datum(*iter);
-            ++iter;
+        const size_t num_rows = src_column.size();
+        for (size_t i = 0; i < num_rows; i++) {
+            if (null_arrays == nullptr || !(*null_arrays)[i]) {
+                const uint32_t begin = src_offsets[i];
+                const uint32_t end = src_offsets[i + 1];
+                const size_t kept_begin = selection.size();
+                bool has_null = false;
+                for (uint32_t j = begin; j < end; j++) {
+                    if (null_elements != nullptr && (*null_elements)[j]) {
+                        if (!has_null) {
+                            has_null = true;
+                            selection.emplace_back(j);
+                        }
+                    } else if (end - begin <= kLinearDistinctSize) {
+                        bool found = false;
+                        for (size_t k = kept_begin; k < selection.size() && !found; k++) {
+                            uint32_t kept = selection[k];
+                            found = (null_elements == nullptr || !(*null_elements)[kept]) && values[kept] == values[j];
+                        }
+                        if (!found) {
+                            selection.emplace_back(j);
+                        }
+                    } else if (hash_set.emplace(values[j]).second) {
+                        selection.emplace_back(j);
+                    }
+                }
+                hash_set.clear();
+            }
+            dest_offsets.emplace_back(selection.size());
         }
-        dest_offsets.emplace_back(dest_offsets.back() + hash_set->size() + has_null);
+        dest_column->elements_column()->append_selective(src_elements, selection);
     }
 };
 
@@ -180,7 +189,8 @@ private:
             return;
         }
 
-        auto null_first_fn = [src_null_column](size_t i) -> bool { return src_null_column.get_data()[i] == 1; };
+        const auto& null_data = src_null_column.get_data();
+        auto null_first_fn = [&null_data](size_t i) -> bool { return null_data[i] == 1; };
 
         auto begin_of_not_null =
                 std::partition(sort_index->begin() + start, sort_index->begin() + start + count, null_first_fn);
@@ -199,6 +209,12 @@ private:
         dest_offsets_column->get_data() = offsets_column.get_data();
 
         size_t chunk_size = src_array_column.size();
+        if constexpr (pt_is_fixedlength<PT>) {
+            if (!src_elements_column.has_null()) {
+                _sort_fixed_length_elements(dest_elements_column, src_elements_column, offsets_column);
+                return;
+            }
+        }
         _init_sort_index(sort_index, src_elements_column.size());
 
         if (src_elements_column.is_nullable()) {
@@ -224,6 +240,24 @@ private:
         dest_elements_column->append_selective(src_elements_column, *sort_index);
     }
 
+    // Without NULL elements, the fixed-length elements are copied once and sorted in place array by array over the
+    // flattened data, rather than through the sort index and append_selective.
+    static void _sort_fixed_length_elements(Column* dest_elements_column, const Column& src_elements_column,
+                                            const UInt32Column& offsets_column) {
+        dest_elements_column->append(src_elements_column, 0, src_elements_column.size());
+        Column* dest_data_column = dest_elements_column;
+        if (dest_elements_column->is_nullable()) {
+            dest_data_column = down_cast<NullableColumn*>(dest_elements_column)->mutable_data_column();
+        }
+        auto& data = down_cast<ColumnType*>(dest_data_column)->get_data();
+        const auto& offsets = offsets_column.get_data();
+        for (size_t i = 0; i + 1 < offsets.size(); i++) {
+            if (offsets[i + 1] - offsets[i] > 1) {
+                pdqsort(false, data.begin() + offsets[i], data.begin() + offsets[i + 1]);
+            }
+        }
+    }
+
     static void _init_sort_index(std::vector<uint32_t>* sort_index, size_t count) {
         sort_index->resize(count);
         for (size_t i = 0; i < count; i++) {
@@ -7,6 +7,8 @@
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "column/const_column.h"
+#include "column/nullable_column.h"
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
@@ -48,13 +50,28 @@ public:
 
         // children size check
         if ((_has_case_expr ^ _has_else_expr) == 0) {
-            return _children.size() % 2 == 0 ? Status::OK() : Status::InvalidArgument("case when children is error!");
+            if (_children.size() % 2 != 0) {
+                return Status::InvalidArgument("case when children is error!");
+            }
+        } else if (_children.size() % 2 != 1) {
+            return Status::InvalidArgument("case when children is error!");
         }
 
-        return _children.size() % 2 == 1 ? Status::OK() : Status::InvalidArgument("case when children is error!");
+        // the THENs and the ELSE
+        for (int i = _has_case_expr ? 2 : 1; i < _children.size(); i += 2) {
+            _has_costly_branch |= !_children[i]->is_slotref() && !_children[i]->is_constant();
+        }
+        if (_has_else_expr) {
+            Expr* else_expr = _children[_children.size() - 1];
+            _has_costly_branch |= !else_expr->is_slotref() && !else_expr->is_constant();
+        }
+        return Status::OK();
     }
 
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* chunk) override {
+        if (_has_costly_branch && chunk != nullptr && chunk->num_rows() > 0) {
+            return evaluate_masked(context, chunk);
+        }
         if (_has_case_expr) {
             return evaluate_case(context, chunk);
         } else {
@@ -63,6 +80,141 @@ public:
     }
 
 private:
+    // Some of the THENs or the ELSE are not slot refs or constants, so each of them is evaluated only on the
+    // rows it's selected for, the WHENs are evaluated until all the rows are matched.
+    ColumnPtr evaluate_masked(ExprContext* context, vectorized::Chunk* chunk) {
+        size_t size = chunk->num_rows();
+        // the branch of each row, the unmatched rows go to the ELSE, which is the last one
+        static constexpr uint32_t kUnmatched = UINT32_MAX;
+        std::vector<uint32_t> branches(size, kUnmatched);
+        std::vector<Expr*> then_exprs;
+        size_t num_unmatched = size;
+
+        ColumnPtr case_column;
+        if (_has_case_expr) {
+            case_column = _children[0]->evaluate(context, chunk);
+        }
+        int begin = _has_case_expr ? 1 : 0;
+        int loop_end = _children.size() - 1;
+        for (int i = begin; i < loop_end && num_unmatched > 0; i += 2) {
+            ColumnPtr when_column = _children[i]->evaluate(context, chunk);
+            auto branch = static_cast<uint32_t>(then_exprs.size());
+            then_exprs.emplace_back(_children[i + 1]);
+            if (_has_case_expr) {
+                ColumnViewer<WhenType> case_viewer(case_column);
+                ColumnViewer<WhenType> when_viewer(when_column);
+                for (size_t row = 0; row < size; ++row) {
+                    if (branches[row] == kUnmatched && !case_viewer.is_null(row) && !when_viewer.is_null(row) &&
+                        when_viewer.value(row) == case_viewer.value(row)) {
+                        branches[row] = branch;
+                        num_unmatched--;
+                    }
+                }
+            } else {
+                ColumnViewer<TYPE_BOOLEAN> when_viewer(when_column);
+                for (size_t row = 0; row < size; ++row) {
+                    if (branches[row] == kUnmatched && !when_viewer.is_null(row) && when_viewer.value(row)) {
+                        branches[row] = branch;
+                        num_unmatched--;
+                    }
+                }
+            }
+        }
+        auto else_branch = static_cast<uint32_t>(then_exprs.size());
+        then_exprs.emplace_back(_has_else_expr ? _children[_children.size() - 1] : nullptr);
+
+        std::vector<std::vector<uint32_t>> positions(then_exprs.size());
+        for (uint32_t row = 0; row < size; ++row) {
+            if (branches[row] == kUnmatched) {
+                branches[row] = else_branch;
+            }
+            positions[branches[row]].emplace_back(row);
+        }
+
+        std::vector<ColumnViewer<ResultType>> then_viewers;
+        then_viewers.reserve(then_exprs.size());
+        std::vector<uint8_t> on_selected(then_exprs.size(), 0);
+        for (size_t i = 0; i < then_exprs.size(); ++i) {
+            ColumnPtr then_column;
+            if (then_exprs[i] == nullptr || positions[i].empty()) {
+                then_column = ColumnHelper::create_const_null_column(1);
+            } else {
+                bool selected = false;
+                then_column =
+                        FunctionHelper::evaluate_on_selected(context, then_exprs[i], chunk, positions[i], &selected);
+                on_selected[i] = selected;
+            }
+            then_viewers.emplace_back(then_column);
+        }
+
+        ColumnBuilder<ResultType> builder(size, this->type().precision, this->type().scale);
+        std::vector<uint32_t> cursors(then_exprs.size(), 0);
+        for (size_t row = 0; row < size; ++row) {
+            uint32_t branch = branches[row];
+            size_t idx = on_selected[branch] ? cursors[branch]++ : row;
+            if (then_viewers[branch].is_null(idx)) {
+                builder.append_null();
+            } else {
+                builder.append(then_viewers[branch].value(idx));
+            }
+        }
+        return builder.build(false);
+    }
+
+    // Every THEN and the ELSE are constants or NULL, the value of each row is looked up by the WHEN it matches.
+    // The WHENs are applied from the last one, so that the first match wins.
+    ColumnPtr evaluate_const_thens(const Columns& when_columns, const Columns& then_columns, size_t size) {
+        using CppType = RunTimeCppType<ResultType>;
+        auto res = RunTimeColumnType<ResultType>::create();
+        if constexpr (pt_is_decimal<ResultType>) {
+            res->set_scale(this->type().scale);
+            res->set_precision(this->type().precision);
+        }
+        auto null_column = NullColumn::create();
+        auto& data = res->get_data();
+        auto& nulls = null_column->get_data();
+
+        const ColumnPtr& else_column = then_columns.back();
+        bool has_null = else_column->only_null();
+        data.assign(size, has_null ? CppType{} : ColumnHelper::get_const_value<ResultType>(else_column));
+        nulls.assign(size, has_null);
+
+        for (int i = static_cast<int>(when_columns.size()) - 1; i >= 0; --i) {
+            const ColumnPtr& then_column = then_columns[i];
+            const uint8_t then_null = then_column->only_null();
+            const CppType value = then_null ? CppType{} : ColumnHelper::get_const_value<ResultType>(then_column);
+            has_null |= then_null;
+
+            const ColumnPtr& when_column = when_columns[i];
+            if (when_column->is_constant()) {
+                // the WHENs all false or null are skipped, so it's true for all the rows
+                data.assign(size, value);
+                nulls.assign(size, then_null);
+                continue;
+            }
+            const auto* when_data = down_cast<const BooleanColumn*>(ColumnHelper::get_data_column(when_column.get()));
+            const uint8_t* selected = when_data->get_data().data();
+            if (when_column->is_nullable()) {
+                const uint8_t* when_nulls =
+                        down_cast<const NullableColumn*>(when_column.get())->null_column()->get_data().data();
+                for (size_t row = 0; row < size; ++row) {
+                    bool hit = selected[row] & !when_nulls[row];
+                    data[row] = hit ? value : data[row];
+                    nulls[row] = hit ? then_null : nulls[row];
+                }
+            } else {
+                for (size_t row = 0; row < size; ++row) {
+                    data[row] = selected[row] ? value : data[row];
+                    nulls[row] = selected[row] ? then_null : nulls[row];
+                }
+            }
+        }
+        if (has_null) {
+            return NullableColumn::create(std::move(res), std::move(null_column));
+        }
+        return res;
+    }
+
     // CASE 1:
     //   CASE sex
     //       WHEN '1' THEN 'man'
@@ -259,6 +411,17 @@ private:
 
         // optimization for no-nullable Arithmetic Type
         if constexpr (isArithmeticPT<ResultType>) {
+            bool then_columns_all_const = true;
+            for (const auto& column : then_columns) {
+                then_columns_all_const &=
+                        column->only_null() ||
+                        (column->is_constant() &&
+                         !down_cast<const ConstColumn*>(column.get())->data_column()->is_nullable());
+            }
+            if (then_columns_all_const) {
+                return evaluate_const_thens(when_columns, then_columns, size);
+            }
+
             bool then_columns_has_null = false;
             for (const auto& column : then_columns) {
                 then_columns_has_null |= column->has_null();
@@ -344,6 +507,7 @@ private:
 private:
     const bool _has_case_expr;
     const bool _has_else_expr;
+    bool _has_costly_branch = false;
 };
 
 #define CASE_WHEN_RESULT_TYPE(WHEN_TYPE, RESULT_TYPE)                \
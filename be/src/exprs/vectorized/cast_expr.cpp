@@ -919,6 +919,58 @@ DEFINE_INT_CAST_TO_STRING(TYPE_SMALLINT, TYPE_VARCHAR);
 DEFINE_INT_CAST_TO_STRING(TYPE_INT, TYPE_VARCHAR);
 DEFINE_INT_CAST_TO_STRING(TYPE_BIGINT, TYPE_VARCHAR);
 
+// Like DEFINE_INT_CAST_TO_STRING, the values are written straight into the bytes of the result, at most
+// MAX_LEN bytes per value, by WRITER(value, char* buffer) returning the length written.
+#define DEFINE_CAST_TO_STRING_IN_PLACE(IMPL, FROM_TYPE, MAX_LEN, WRITER)                                 \
+    template <>                                                                                          \
+    template <>                                                                                          \
+    inline ColumnPtr StringUnaryFunction<IMPL>::evaluate<FROM_TYPE, TYPE_VARCHAR>(const ColumnPtr& v1) { \
+        auto& r1 = ColumnHelper::cast_to_raw<FROM_TYPE>(v1)->get_data();                                 \
+        auto result = RunTimeColumnType<TYPE_VARCHAR>::create();                                         \
+        auto& offset = result->get_offset();                                                             \
+        offset.resize(v1->size() + 1);                                                                   \
+        auto& bytes = result->get_bytes();                                                               \
+        bytes.resize(MAX_LEN * v1->size());                                                              \
+        size_t pos = 0;                                                                                  \
+        int size = v1->size();                                                                           \
+        for (int i = 0; i < size; ++i) {                                                                 \
+            pos += WRITER(r1[i], (char*)bytes.data() + pos);                                             \
+            offset[i + 1] = pos;                                                                         \
+        }                                                                                                \
+        bytes.resize(pos);                                                                               \
+        return result;                                                                                   \
+    }
+
+static inline size_t write_float(float v, char* buffer) {
+    return f2s_buffered_n(v, buffer);
+}
+
+static inline size_t write_double(double v, char* buffer) {
+    return d2s_buffered_n(v, buffer);
+}
+
+static inline size_t write_largeint(__int128 v, char* buffer) {
+    return fmt::format_to(buffer, "{}", v) - buffer;
+}
+
+static inline size_t write_date(const DateValue& v, char* buffer) {
+    int year, month, day;
+    v.to_date(&year, &month, &day);
+    date::to_string(year, month, day, buffer);
+    return 10;
+}
+
+static inline size_t write_timestamp(const TimestampValue& v, char* buffer) {
+    return v.to_string(buffer, 26);
+}
+
+DEFINE_CAST_TO_STRING_IN_PLACE(FloatCastToString, TYPE_FLOAT, 16, write_float);
+DEFINE_CAST_TO_STRING_IN_PLACE(DoubleCastToString, TYPE_DOUBLE, 32, write_double);
+// the min value of int128 has 40 chars
+DEFINE_CAST_TO_STRING_IN_PLACE(CastToString, TYPE_LARGEINT, 40, write_largeint);
+DEFINE_CAST_TO_STRING_IN_PLACE(CastToString, TYPE_DATE, 10, write_date);
+DEFINE_CAST_TO_STRING_IN_PLACE(CastToString, TYPE_DATETIME, 26, write_timestamp);
+
 // Cast SQL type to JSON
 CUSTOMIZE_FN_CAST(TYPE_NULL, TYPE_JSON, cast_to_json_fn);
 CUSTOMIZE_FN_CAST(TYPE_INT, TYPE_JSON, cast_to_json_fn);
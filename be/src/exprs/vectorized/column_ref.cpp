@@ -9,6 +9,11 @@ ColumnRef::ColumnRef(const TExprNode& node)
 
 ColumnRef::ColumnRef(const SlotDescriptor* desc) : Expr(desc->type(), true), _column_id(desc->id()) {}
 
+ColumnRef::ColumnRef(const TypeDescriptor& type, SlotId slot_id, bool is_nullable)
+        : Expr(type, true), _column_id(slot_id), _is_nullable(is_nullable) {
+    Expr::_is_nullable = is_nullable;
+}
+
 int ColumnRef::get_slot_ids(std::vector<SlotId>* slot_ids) const {
     slot_ids->push_back(_column_id);
     return 1;
@@ -14,6 +14,8 @@ public:
 
     ColumnRef(const SlotDescriptor* desc);
 
+    ColumnRef(const TypeDescriptor& type, SlotId slot_id, bool is_nullable);
+
     SlotId slot_id() const { return _column_id; }
 
     TupleId tuple_id() const { return _tuple_id; }
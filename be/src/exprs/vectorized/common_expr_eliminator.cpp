@@ -0,0 +1,210 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exprs/vectorized/common_expr_eliminator.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "column/column.h"
+#include "common/object_pool.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/function_call_expr.h"
+#include "exprs/vectorized/literal.h"
+#include "gutil/casts.h"
+
+namespace starrocks::vectorized {
+
+static bool is_comparable_node(const Expr* expr) {
+    switch (expr->node_type()) {
+    case TExprNodeType::SLOT_REF:
+    case TExprNodeType::BOOL_LITERAL:
+    case TExprNodeType::INT_LITERAL:
+    case TExprNodeType::LARGE_INT_LITERAL:
+    case TExprNodeType::FLOAT_LITERAL:
+    case TExprNodeType::DECIMAL_LITERAL:
+    case TExprNodeType::DATE_LITERAL:
+    case TExprNodeType::STRING_LITERAL:
+    case TExprNodeType::NULL_LITERAL:
+    case TExprNodeType::CAST_EXPR:
+    case TExprNodeType::ARITHMETIC_EXPR:
+    case TExprNodeType::BINARY_PRED:
+        return true;
+    case TExprNodeType::COMPUTE_FUNCTION_CALL:
+    case TExprNodeType::FUNCTION_CALL:
+        // the java udfs may not be deterministic
+        return expr->fn().binary_type != TFunctionBinaryType::SRJAR &&
+               !VectorizedFunctionCallExpr::is_returning_random_value(expr->fn());
+    default:
+        return false;
+    }
+}
+
+static bool is_literal(const Expr* expr) {
+    switch (expr->node_type()) {
+    case TExprNodeType::BOOL_LITERAL:
+    case TExprNodeType::INT_LITERAL:
+    case TExprNodeType::LARGE_INT_LITERAL:
+    case TExprNodeType::FLOAT_LITERAL:
+    case TExprNodeType::DECIMAL_LITERAL:
+    case TExprNodeType::DATE_LITERAL:
+    case TExprNodeType::STRING_LITERAL:
+    case TExprNodeType::NULL_LITERAL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool CommonExprEliminator::equals(const Expr* lhs, const Expr* rhs) {
+    if (!is_comparable_node(lhs) || !is_comparable_node(rhs)) {
+        return false;
+    }
+    if (lhs->node_type() != rhs->node_type() || lhs->op() != rhs->op() || lhs->type() != rhs->type() ||
+        lhs->get_num_children() != rhs->get_num_children()) {
+        return false;
+    }
+    if (lhs->is_slotref()) {
+        if (down_cast<const ColumnRef*>(lhs)->slot_id() != down_cast<const ColumnRef*>(rhs)->slot_id()) {
+            return false;
+        }
+    } else if (is_literal(lhs)) {
+        const auto& l_value = down_cast<const VectorizedLiteral*>(lhs)->value();
+        const auto& r_value = down_cast<const VectorizedLiteral*>(rhs)->value();
+        if (l_value->only_null() || r_value->only_null()) {
+            return l_value->only_null() && r_value->only_null();
+        }
+        if (l_value->compare_at(0, 0, *r_value, 1) != 0) {
+            return false;
+        }
+    } else if (lhs->node_type() == TExprNodeType::FUNCTION_CALL ||
+               lhs->node_type() == TExprNodeType::COMPUTE_FUNCTION_CALL) {
+        if (lhs->fn().name.function_name != rhs->fn().name.function_name || lhs->fn().fid != rhs->fn().fid) {
+            return false;
+        }
+    }
+    for (int i = 0; i < lhs->get_num_children(); i++) {
+        if (!equals(lhs->get_child(i), rhs->get_child(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace {
+
+struct Occurrence {
+    Expr* expr = nullptr;
+    // nullptr if it's a root, otherwise it's the child `index` of `parent`
+    Expr* parent = nullptr;
+    int index = 0;
+    // number of the nodes of the subtree
+    size_t size = 0;
+    // the subtree can be taken as common
+    bool candidate = false;
+    // it has been taken as common, or it's inside a subtree replaced by a ColumnRef
+    bool done = false;
+};
+
+// Returns the number of the nodes of the subtree, `comparable` and `has_slot` tell if all of its nodes are
+// comparable and if it refers to any column.
+size_t collect_occurrences(Expr* expr, Expr* parent, int index, std::vector<Occurrence>* occurrences,
+                           bool* comparable, bool* has_slot) {
+    size_t pos = occurrences->size();
+    occurrences->emplace_back();
+    size_t size = 1;
+    *comparable = is_comparable_node(expr);
+    *has_slot = expr->is_slotref();
+    for (int i = 0; i < expr->get_num_children(); i++) {
+        bool child_comparable = false;
+        bool child_has_slot = false;
+        size += collect_occurrences(expr->get_child(i), expr, i, occurrences, &child_comparable, &child_has_slot);
+        *comparable &= child_comparable;
+        *has_slot |= child_has_slot;
+    }
+    auto& occurrence = (*occurrences)[pos];
+    occurrence.expr = expr;
+    occurrence.parent = parent;
+    occurrence.index = index;
+    occurrence.size = size;
+    // the roots are never replaced, their results are the outputs
+    occurrence.candidate = *comparable && *has_slot && expr->get_num_children() > 0 && parent != nullptr;
+    return size;
+}
+
+// the occurrences of the subtree rooted at `pos` are stored right after it
+void mark_done(std::vector<Occurrence>* occurrences, size_t pos) {
+    size_t size = (*occurrences)[pos].size;
+    for (size_t i = pos; i < pos + size; i++) {
+        (*occurrences)[i].done = true;
+    }
+}
+
+} // namespace
+
+int CommonExprEliminator::eliminate(ObjectPool* pool, const std::vector<ExprContext*>& ctxs, SlotId next_slot_id,
+                                    std::vector<ExprContext*>* common_ctxs, std::vector<SlotId>* common_slot_ids) {
+    std::vector<Occurrence> occurrences;
+    for (ExprContext* ctx : ctxs) {
+        bool comparable = false;
+        bool has_slot = false;
+        collect_occurrences(ctx->root(), nullptr, 0, &occurrences, &comparable, &has_slot);
+    }
+
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < occurrences.size(); i++) {
+        if (occurrences[i].candidate) {
+            candidates.emplace_back(i);
+        }
+    }
+    // the largest common subtrees are taken first
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [&](size_t lhs, size_t rhs) { return occurrences[lhs].size > occurrences[rhs].size; });
+
+    int saved = 0;
+    std::vector<ExprContext*> new_ctxs;
+    std::vector<SlotId> new_slot_ids;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (occurrences[candidates[i]].done) {
+            continue;
+        }
+        std::vector<size_t> group{candidates[i]};
+        for (size_t j = i + 1; j < candidates.size(); j++) {
+            const auto& other = occurrences[candidates[j]];
+            if (other.size != occurrences[candidates[i]].size) {
+                break;
+            }
+            if (!other.done && equals(occurrences[candidates[i]].expr, other.expr)) {
+                group.emplace_back(candidates[j]);
+            }
+        }
+        if (group.size() < 2) {
+            continue;
+        }
+
+        Expr* common = occurrences[group[0]].expr;
+        SlotId slot_id = next_slot_id++;
+        for (size_t k = 0; k < group.size(); k++) {
+            auto& occurrence = occurrences[group[k]];
+            Expr* ref = pool->add(new ColumnRef(common->type(), slot_id, common->is_nullable()));
+            occurrence.parent->set_child(occurrence.index, ref);
+            if (k == 0) {
+                // the subtrees inside the one kept may still be shared with the others
+                occurrence.done = true;
+            } else {
+                mark_done(&occurrences, group[k]);
+            }
+        }
+        new_ctxs.emplace_back(pool->add(new ExprContext(common)));
+        new_slot_ids.emplace_back(slot_id);
+        saved += static_cast<int>(group.size()) - 1;
+    }
+
+    // a common subtree found later is smaller, it may be inside the ones found before but never contains them
+    common_ctxs->insert(common_ctxs->end(), new_ctxs.rbegin(), new_ctxs.rend());
+    common_slot_ids->insert(common_slot_ids->end(), new_slot_ids.rbegin(), new_slot_ids.rend());
+    return saved;
+}
+
+} // namespace starrocks::vectorized
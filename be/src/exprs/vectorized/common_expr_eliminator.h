@@ -0,0 +1,39 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "common/global_types.h"
+
+namespace starrocks {
+
+class Expr;
+class ExprContext;
+class ObjectPool;
+
+namespace vectorized {
+
+// CommonExprEliminator finds the subtrees shared by a group of expressions evaluated on the same chunks,
+// e.g. the conjuncts of a SelectOperator, so that each of them is evaluated only once per chunk.
+// Each common subtree is moved out into an ExprContext of its own, whose result is to be appended to
+// the chunk as a column of a new slot, and all of its occurrences are replaced by ColumnRefs to that slot.
+// The roots are kept as they are, since their results are the outputs.
+//
+// Only the subtrees built of the deterministic functions, casts, arithmetic and binary predicates over
+// columns and literals are compared, the others are never taken as common.
+class CommonExprEliminator {
+public:
+    // Rewrites the trees of `ctxs`, which must not be prepared yet. The contexts evaluating the common
+    // subtrees are appended to `common_ctxs` in the order they must be evaluated, with the slots of their
+    // results taken from `next_slot_id` upwards and appended to `common_slot_ids`.
+    // Returns the number of the evaluations saved per chunk.
+    static int eliminate(ObjectPool* pool, const std::vector<ExprContext*>& ctxs, SlotId next_slot_id,
+                         std::vector<ExprContext*>* common_ctxs, std::vector<SlotId>* common_slot_ids);
+
+    // Returns true if both trees are comparable and always evaluate to the same column.
+    static bool equals(const Expr* lhs, const Expr* rhs);
+};
+
+} // namespace vectorized
+} // namespace starrocks
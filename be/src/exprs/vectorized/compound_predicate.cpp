@@ -5,6 +5,8 @@
 #include "common/object_pool.h"
 #include "exprs/predicate.h"
 #include "exprs/vectorized/binary_function.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/like_predicate.h"
 #include "exprs/vectorized/unary_function.h"
 
 namespace starrocks::vectorized {
@@ -60,10 +62,27 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(OrImpl, l_value, r_value) {
     return l_value | r_value;
 }
 
+// fids of the LIKE and REGEXP functions
+static constexpr int64_t kLikeFunctionId = 60010;
+static constexpr int64_t kRegexFunctionId = 60020;
+
 class VectorizedOrCompoundPredicate final : public Predicate {
 public:
     DEFINE_COMPOUND_CONSTRUCT(VectorizedOrCompoundPredicate);
+
+    Status open(RuntimeState* state, ExprContext* context, FunctionContext::FunctionStateScope scope) override {
+        RETURN_IF_ERROR(Expr::open(state, context, scope));
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            _init_pattern_matcher(context);
+        }
+        return Status::OK();
+    }
+
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        if (_pattern_matcher != nullptr) {
+            return _pattern_matcher->match(ptr->get_column_by_slot_id(_pattern_slot_id));
+        }
+
         auto l = _children[0]->evaluate(context, ptr);
 
         int l_trues = ColumnHelper::count_true_with_notnull(l);
@@ -76,6 +95,68 @@ public:
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    // Collects the leaves of the OR tree rooted at `expr`.
+    static void _collect_or_leaves(Expr* expr, std::vector<Expr*>* leaves) {
+        if (expr->node_type() == TExprNodeType::COMPOUND_PRED && expr->op() == TExprOpcode::COMPOUND_OR) {
+            _collect_or_leaves(expr->get_child(0), leaves);
+            _collect_or_leaves(expr->get_child(1), leaves);
+        } else {
+            leaves->emplace_back(expr);
+        }
+    }
+
+    // If all the leaves are LIKE or REGEXP of the same column with constant patterns, they are matched
+    // together by one MultiPatternMatcher.
+    void _init_pattern_matcher(ExprContext* context) {
+        std::vector<Expr*> leaves;
+        _collect_or_leaves(this, &leaves);
+        std::vector<std::string> like_patterns;
+        std::vector<std::string> regex_patterns;
+        std::vector<SlotId> slot_ids;
+        for (Expr* leaf : leaves) {
+            if (leaf->node_type() != TExprNodeType::FUNCTION_CALL || !leaf->fn().__isset.fid ||
+                (leaf->fn().fid != kLikeFunctionId && leaf->fn().fid != kRegexFunctionId) ||
+                leaf->get_num_children() != 2) {
+                return;
+            }
+            Expr* value = leaf->get_child(0);
+            Expr* pattern = leaf->get_child(1);
+            if (!value->is_slotref() || !pattern->is_constant()) {
+                return;
+            }
+            SlotId slot_id = value->get_column_ref()->slot_id();
+            if (!slot_ids.empty() && slot_id != slot_ids[0]) {
+                return;
+            }
+            slot_ids.emplace_back(slot_id);
+            ColumnPtr pattern_column = pattern->evaluate_const(context);
+            if (pattern_column == nullptr || pattern_column->only_null() || pattern_column->is_null(0)) {
+                return;
+            }
+            Slice pattern_value = ColumnHelper::get_const_value<TYPE_VARCHAR>(pattern_column);
+            if (leaf->fn().fid == kLikeFunctionId) {
+                like_patterns.emplace_back(pattern_value.to_string());
+            } else {
+                regex_patterns.emplace_back(pattern_value.to_string());
+            }
+        }
+        auto matcher = std::make_shared<MultiPatternMatcher>();
+        Status st = matcher->init(like_patterns, regex_patterns);
+        if (!st.ok()) {
+            // evaluated one by one, which reports the invalid pattern if there is
+            VLOG(2) << "Fail to match the patterns of OR together: " << st;
+            return;
+        }
+        _pattern_slot_id = slot_ids[0];
+        _pattern_matcher = std::move(matcher);
+    }
+
+    // shared by the clones, it's immutable after open()
+    std::shared_ptr<MultiPatternMatcher> _pattern_matcher;
+    // the column all the patterns are matched against
+    SlotId _pattern_slot_id = 0;
 };
 
 DEFINE_UNARY_FN_WITH_IMPL(CompoundPredNot, l) {
@@ -93,6 +93,54 @@ public:
 
         return result.build(ColumnHelper::is_all_const(list));
     }
+
+private:
+    bool has_costly_branch() const {
+        for (int i = 1; i < 3; ++i) {
+            if (!_children[i]->is_slotref() && !_children[i]->is_constant()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Evaluates each branch only on the rows it's selected for.
+    ColumnPtr evaluate_masked(ExprContext* context, vectorized::Chunk* ptr, const ColumnPtr& bhs) {
+        size_t size = bhs->size();
+        ColumnViewer<TYPE_BOOLEAN> bhs_viewer(bhs);
+        std::vector<uint32_t> positions[2];
+        for (uint32_t row = 0; row < size; ++row) {
+            bool is_true = !bhs_viewer.is_null(row) && bhs_viewer.value(row);
+            positions[is_true ? 0 : 1].emplace_back(row);
+        }
+
+        bool lhs_selected = false;
+        bool rhs_selected = false;
+        auto lhs = FunctionHelper::evaluate_on_selected(context, _children[1], ptr, positions[0], &lhs_selected);
+        auto rhs = FunctionHelper::evaluate_on_selected(context, _children[2], ptr, positions[1], &rhs_selected);
+        ColumnViewer<Type> lhs_viewer(lhs);
+        ColumnViewer<Type> rhs_viewer(rhs);
+
+        ColumnBuilder<Type> result(size, this->type().precision, this->type().scale);
+        size_t lhs_cursor = 0;
+        size_t rhs_cursor = 0;
+        for (size_t row = 0; row < size; ++row) {
+            bool is_true = !bhs_viewer.is_null(row) && bhs_viewer.value(row);
+            const auto& viewer = is_true ? lhs_viewer : rhs_viewer;
+            size_t idx = row;
+            if (is_true && lhs_selected) {
+                idx = lhs_cursor++;
+            } else if (!is_true && rhs_selected) {
+                idx = rhs_cursor++;
+            }
+            if (viewer.is_null(idx)) {
+                result.append_null();
+            } else {
+                result.append(viewer.value(idx));
+            }
+        }
+        return result.build(false);
+    }
 };
 
 template <PrimitiveType Type>
@@ -146,6 +194,10 @@ public:
         auto bhs = _children[0]->evaluate(context, ptr);
         int true_count = ColumnHelper::count_true_with_notnull(bhs);
 
+        if (ptr != nullptr && true_count > 0 && true_count < bhs->size() && has_costly_branch()) {
+            return evaluate_masked(context, ptr, bhs);
+        }
+
         auto lhs = _children[1]->evaluate(context, ptr);
         if (true_count == bhs->size()) {
             return lhs->clone();
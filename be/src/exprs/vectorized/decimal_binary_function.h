@@ -8,6 +8,45 @@
 #include "runtime/primitive_type.h"
 
 namespace starrocks::vectorized {
+
+template <typename BinaryOperator>
+struct DecimalBinaryOpOf {};
+
+template <typename Op, PrimitiveType Type, typename OpGuard, typename TypeGuard>
+struct DecimalBinaryOpOf<ArithmeticBinaryOperator<Op, Type, OpGuard, TypeGuard>> {
+    using type = Op;
+};
+
+// Evaluates the int128 add/sub of all the rows with the wrapping arithmetic and ors the overflow flags of
+// the rows without branches, so that the loop is unrolled and vectorized, unlike the add/adc with the
+// overflow flag per row. Returns whether any row overflows.
+template <typename Op, bool lhs_is_const, bool rhs_is_const>
+inline bool batch_int128_add_sub(size_t num_rows, const int128_t* lhs, const int128_t* rhs, int128_t* result) {
+    uint64_t overflow = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        auto l = static_cast<uint128_t>(lhs[lhs_is_const ? 0 : i]);
+        auto r = static_cast<uint128_t>(rhs[rhs_is_const ? 0 : i]);
+        uint128_t c;
+        uint128_t flag;
+        if constexpr (is_add_op<Op>) {
+            // overflows if the operands have the same sign and the sum has the other one
+            c = l + r;
+            flag = (l ^ c) & (r ^ c);
+        } else if constexpr (is_sub_op<Op>) {
+            // overflows if the operands have different signs and the difference has the sign of r
+            c = l - r;
+            flag = (l ^ r) & (l ^ c);
+        } else {
+            static_assert(is_reverse_sub_op<Op>, "Invalid Op");
+            c = r - l;
+            flag = (r ^ l) & (r ^ c);
+        }
+        result[i] = static_cast<int128_t>(c);
+        overflow |= static_cast<uint64_t>(flag >> 64);
+    }
+    return overflow >> 63;
+}
+
 template <bool check_overflow, typename Op>
 struct DecimalBinaryFunction {
     // Adjust the scale of lhs operand, then evaluate binary operation, the rules about operand
@@ -60,6 +99,21 @@ struct DecimalBinaryFunction {
             rhs_datum = rhs_data[0];
         }
 
+        // The overflow-checked add/sub of DECIMAL128 is evaluated in batch, only the batch that overflows is
+        // evaluated again row by row below to set the nulls.
+        if constexpr (check_overflow && std::is_same_v<LhsCppType, int128_t> &&
+                      std::is_same_v<RhsCppType, int128_t> && std::is_same_v<ResultCppType, int128_t> &&
+                      !(adjust_left && !lhs_is_const)) {
+            using BatchOp = typename DecimalBinaryOpOf<BinaryOperator>::type;
+            if constexpr (is_add_op<BatchOp> || is_sub_op<BatchOp> || is_reverse_sub_op<BatchOp>) {
+                const LhsCppType* lhs = lhs_is_const ? &lhs_datum : lhs_data;
+                const RhsCppType* rhs = rhs_is_const ? &rhs_datum : rhs_data;
+                if (!batch_int128_add_sub<BatchOp, lhs_is_const, rhs_is_const>(num_rows, lhs, rhs, result_data)) {
+                    return false;
+                }
+            }
+        }
+
         for (auto i = 0; i < num_rows; ++i) {
             if constexpr (lhs_is_const && rhs_is_const) {
                 overflow = BinaryOperator::template apply<check_overflow, false, LhsCppType, RhsCppType, ResultCppType>(
@@ -5,10 +5,13 @@
 #include "column/binary_column.h"
 #include "column/column_builder.h"
 #include "column/column_helper.h"
+#include "column/column_hash.h"
 #include "column/column_viewer.h"
+#include "exprs/vectorized/binary_column_searcher.h"
 #include "exprs/vectorized/binary_function.h"
 #include "exprs/vectorized/string_functions.h"
 #include "util/memcmp.h"
+#include "util/phmap/phmap.h"
 
 namespace starrocks::vectorized {
 
@@ -44,7 +47,79 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(findInSetImpl, str, strlist) {
     return 0;
 }
 
+// Wraps the result of a vector and a constant with the nulls of the vector.
+static ColumnPtr with_nulls_of(const ColumnPtr& vector, Int32Column::Ptr res) {
+    if (vector->is_nullable()) {
+        const auto& nulls = ColumnHelper::as_raw_column<NullableColumn>(vector)->null_column();
+        return NullableColumn::create(std::move(res), NullColumn::create(*nulls));
+    }
+    return res;
+}
+
+// find_in_set of a column of strings in a constant list, the items of the list are looked up in a hash map.
+static ColumnPtr find_in_const_set(const ColumnPtr& str_column, const Slice& strlist) {
+    // the first index of each item
+    phmap::flat_hash_map<Slice, int32_t, SliceHash> items;
+    int32_t num = 0;
+    for (const char* begin = strlist.data;; ++num) {
+        const char* end = strlist.data + strlist.size;
+        const char* pos = reinterpret_cast<const char*>(memchr(begin, ',', end - begin));
+        const char* item_end = pos == nullptr ? end : pos;
+        items.emplace(Slice(begin, item_end - begin), num + 1);
+        if (pos == nullptr) {
+            break;
+        }
+        begin = pos + 1;
+    }
+
+    const auto* strs = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(str_column.get()));
+    const size_t size = strs->size();
+    auto res = Int32Column::create(size, 0);
+    auto& res_data = res->get_data();
+    for (size_t i = 0; i < size; ++i) {
+        Slice str = strs->get_slice(i);
+        // the strings with ',' can't be an item
+        if (memchr(str.data, ',', str.size) != nullptr) {
+            continue;
+        }
+        if (auto iter = items.find(str); iter != items.end()) {
+            res_data[i] = iter->second;
+        }
+    }
+    return with_nulls_of(str_column, std::move(res));
+}
+
+// find_in_set of a constant string in a column of lists, the string is searched in all the lists at once.
+static ColumnPtr find_const_in_sets(const Slice& str, const ColumnPtr& strlist_column) {
+    const auto* strlists = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(strlist_column.get()));
+    auto res = Int32Column::create(strlists->size(), 0);
+    if (memchr(str.data, ',', str.size) == nullptr) {
+        auto& res_data = res->get_data();
+        search_in_binary_column(*strlists, str, [&](size_t row, size_t pos) {
+            Slice strlist = strlists->get_slice(row);
+            // it's an item only if it's between the commas or the ends of the list
+            if ((pos > 0 && strlist.data[pos - 1] != ',') ||
+                (pos + str.size < strlist.size && strlist.data[pos + str.size] != ',')) {
+                return true;
+            }
+            res_data[row] = 1 + std::count(strlist.data, strlist.data + pos, ',');
+            return false;
+        });
+    }
+    return with_nulls_of(strlist_column, std::move(res));
+}
+
 ColumnPtr StringFunctions::find_in_set(FunctionContext* context, const Columns& columns) {
+    RETURN_IF_COLUMNS_ONLY_NULL(columns);
+    if (!columns[0]->is_constant() && columns[1]->is_constant()) {
+        return find_in_const_set(columns[0], ColumnHelper::get_const_value<TYPE_VARCHAR>(columns[1]));
+    }
+    if (columns[0]->is_constant() && !columns[1]->is_constant()) {
+        Slice str = ColumnHelper::get_const_value<TYPE_VARCHAR>(columns[0]);
+        if (str.size > 0) {
+            return find_const_in_sets(str, columns[1]);
+        }
+    }
     return VectorizedStrictBinaryFunction<findInSetImpl>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0], columns[1]);
 }
 
@@ -44,9 +44,7 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, starr
     //  for varargs in vectorized engine?
     _fn_context_index = context->register_func(state, return_type, args_types, 0);
 
-    _is_returning_random_value = _fn.fid == 10300 /* rand */ || _fn.fid == 10301 /* random */ ||
-                                 _fn.fid == 10302 /* rand */ || _fn.fid == 10303 /* random */ ||
-                                 _fn.fid == 100015 /* uuid */;
+    _is_returning_random_value = is_returning_random_value(_fn);
 
     return Status::OK();
 }
@@ -102,6 +100,11 @@ void VectorizedFunctionCallExpr::close(starrocks::RuntimeState* state, starrocks
     Expr::close(state, context, scope);
 }
 
+bool VectorizedFunctionCallExpr::is_returning_random_value(const TFunction& fn) {
+    return fn.fid == 10300 /* rand */ || fn.fid == 10301 /* random */ || fn.fid == 10302 /* rand */ ||
+           fn.fid == 10303 /* random */ || fn.fid == 100015 /* uuid */;
+}
+
 bool VectorizedFunctionCallExpr::is_constant() const {
     if (_is_returning_random_value) {
         return false;
@@ -28,6 +28,9 @@ protected:
 
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override;
 
+    // Returns true if the function returns another value each time it's called with the same arguments.
+    static bool is_returning_random_value(const TFunction& fn);
+
 private:
     const FunctionDescriptor* _fn_desc;
 
@@ -8,6 +8,9 @@
 
 #include <util/raw_container.h>
 
+#include "column/chunk.h"
+#include "exprs/expr.h"
+
 namespace starrocks::vectorized {
 
 NullColumnPtr FunctionHelper::union_nullable_column(const ColumnPtr& v1, const ColumnPtr& v2) {
@@ -115,4 +118,30 @@ ColumnPtr FunctionHelper::merge_column_and_null_column(ColumnPtr&& column, NullC
     }
 }
 
+ColumnPtr FunctionHelper::evaluate_on_selected(ExprContext* context, Expr* expr, Chunk* chunk,
+                                               const std::vector<uint32_t>& positions, bool* on_selected) {
+    *on_selected = false;
+    if (chunk == nullptr || expr->is_slotref() || expr->is_constant() || positions.size() == chunk->num_rows()) {
+        return expr->evaluate(context, chunk);
+    }
+    std::vector<SlotId> slot_ids;
+    expr->get_slot_ids(&slot_ids);
+    // only the columns `expr` refers to are copied
+    Chunk selected;
+    for (SlotId slot_id : slot_ids) {
+        if (selected.is_slot_exist(slot_id) || !chunk->is_slot_exist(slot_id)) {
+            continue;
+        }
+        const ColumnPtr& src = chunk->get_column_by_slot_id(slot_id);
+        ColumnPtr dst = src->clone_empty();
+        dst->append_selective(*src, positions);
+        selected.append_column(std::move(dst), slot_id);
+    }
+    if (selected.num_columns() == 0) {
+        return expr->evaluate(context, chunk);
+    }
+    *on_selected = true;
+    return expr->evaluate(context, &selected);
+}
+
 } // namespace starrocks::vectorized
@@ -7,6 +7,10 @@
 #include "column/type_traits.h"
 
 namespace starrocks {
+
+class Expr;
+class ExprContext;
+
 namespace vectorized {
 
 class FunctionHelper {
@@ -41,6 +45,13 @@ public:
 
     // merge a column and null_column and generate a column with null values.
     static ColumnPtr merge_column_and_null_column(ColumnPtr&& column, NullColumnPtr&& null_column);
+
+    // Evaluates `expr` only on the rows of `chunk` at `positions`, e.g. the THEN of a CASE WHEN on the rows
+    // it's selected for, then the result has a row per position and `*on_selected` is set.
+    // The slot refs and the constants, which cost nothing to evaluate, and the exprs selected for all the
+    // rows are evaluated on the whole chunk instead.
+    static ColumnPtr evaluate_on_selected(ExprContext* context, Expr* expr, Chunk* chunk,
+                                          const std::vector<uint32_t>& positions, bool* on_selected);
 };
 
 #define DEFINE_VECTORIZED_FN(NAME) static ColumnPtr NAME(FunctionContext* context, const Columns& columns)
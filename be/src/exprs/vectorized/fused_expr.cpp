@@ -0,0 +1,374 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exprs/vectorized/fused_expr.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/const_column.h"
+#include "column/nullable_column.h"
+#include "common/object_pool.h"
+#include "exprs/expr_context.h"
+#include "exprs/vectorized/arithmetic_operation.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/literal.h"
+#include "gutil/casts.h"
+
+namespace starrocks::vectorized {
+
+// the largest type fused is 8 bytes
+static constexpr size_t kRegisterBytes = FusedExpr::kBatchSize * sizeof(int64_t);
+
+static bool is_fused_numeric_type(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+#define FUSED_NUMERIC_DISPATCH_CASE(type) \
+    case type:                            \
+        return fun.template operator()<type>(args...);
+
+template <class Functor, class... Args>
+void fused_numeric_dispatch(PrimitiveType ptype, Functor fun, Args... args) {
+    switch (ptype) {
+        FUSED_NUMERIC_DISPATCH_CASE(TYPE_TINYINT)
+        FUSED_NUMERIC_DISPATCH_CASE(TYPE_SMALLINT)
+        FUSED_NUMERIC_DISPATCH_CASE(TYPE_INT)
+        FUSED_NUMERIC_DISPATCH_CASE(TYPE_BIGINT)
+        FUSED_NUMERIC_DISPATCH_CASE(TYPE_FLOAT)
+        FUSED_NUMERIC_DISPATCH_CASE(TYPE_DOUBLE)
+    default:
+        CHECK(false) << "Unknown type: " << ptype;
+        __builtin_unreachable();
+    }
+}
+
+#undef FUSED_NUMERIC_DISPATCH_CASE
+
+template <typename Op>
+struct FusedArithmetic {
+    template <PrimitiveType Type>
+    void operator()(const uint8_t* lhs, const uint8_t* rhs, uint8_t* dst, size_t n) {
+        using CppType = RunTimeCppType<Type>;
+        const auto* l = reinterpret_cast<const CppType*>(lhs);
+        const auto* r = reinterpret_cast<const CppType*>(rhs);
+        auto* d = reinterpret_cast<CppType*>(dst);
+        for (size_t i = 0; i < n; i++) {
+            d[i] = ArithmeticBinaryOperator<Op, Type>::template apply<CppType, CppType, CppType>(l[i], r[i]);
+        }
+    }
+};
+
+template <template <typename> class Cmp>
+struct FusedCompare {
+    template <PrimitiveType Type>
+    void operator()(const uint8_t* lhs, const uint8_t* rhs, uint8_t* dst, size_t n) {
+        using CppType = RunTimeCppType<Type>;
+        const auto* l = reinterpret_cast<const CppType*>(lhs);
+        const auto* r = reinterpret_cast<const CppType*>(rhs);
+        Cmp<CppType> cmp;
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = cmp(l[i], r[i]);
+        }
+    }
+};
+
+FusedExpr::FusedExpr(Expr* expr) : Expr(expr->type()) {
+    _is_nullable = expr->is_nullable();
+    _children.emplace_back(expr);
+}
+
+int FusedExpr::_compile(const Expr* expr, std::vector<Instruction>* program) {
+    PrimitiveType type = expr->type().type;
+    Instruction ins;
+    ins.type = type;
+    if (expr->is_slotref()) {
+        if (!is_fused_numeric_type(type) && type != TYPE_BOOLEAN) {
+            return -1;
+        }
+        ins.op = Op::COLUMN;
+        ins.slot_id = down_cast<const ColumnRef*>(expr)->slot_id();
+        program->emplace_back(std::move(ins));
+        return static_cast<int>(program->size()) - 1;
+    }
+
+    switch (expr->node_type()) {
+    case TExprNodeType::BOOL_LITERAL:
+    case TExprNodeType::INT_LITERAL:
+    case TExprNodeType::FLOAT_LITERAL: {
+        const ColumnPtr& value = down_cast<const VectorizedLiteral*>(expr)->value();
+        if ((!is_fused_numeric_type(type) && type != TYPE_BOOLEAN) || value->only_null() || !value->is_constant()) {
+            return -1;
+        }
+        const Column* data = down_cast<const ConstColumn*>(value.get())->data_column().get();
+        if (data->is_nullable()) {
+            return -1;
+        }
+        size_t width = data->type_size();
+        ins.op = Op::CONST;
+        ins.value.resize(kBatchSize * width);
+        for (size_t i = 0; i < kBatchSize; i++) {
+            memcpy(ins.value.data() + i * width, data->raw_data(), width);
+        }
+        program->emplace_back(std::move(ins));
+        return static_cast<int>(program->size()) - 1;
+    }
+    case TExprNodeType::ARITHMETIC_EXPR:
+        if (!is_fused_numeric_type(type)) {
+            return -1;
+        }
+        switch (expr->op()) {
+        case TExprOpcode::ADD:
+            ins.op = Op::ADD;
+            break;
+        case TExprOpcode::SUBTRACT:
+            ins.op = Op::SUB;
+            break;
+        case TExprOpcode::MULTIPLY:
+            ins.op = Op::MUL;
+            break;
+        default:
+            return -1;
+        }
+        break;
+    case TExprNodeType::BINARY_PRED:
+        if (type != TYPE_BOOLEAN || expr->get_num_children() != 2) {
+            return -1;
+        }
+        switch (expr->op()) {
+        case TExprOpcode::EQ:
+            ins.op = Op::EQ;
+            break;
+        case TExprOpcode::NE:
+            ins.op = Op::NE;
+            break;
+        case TExprOpcode::LT:
+            ins.op = Op::LT;
+            break;
+        case TExprOpcode::LE:
+            ins.op = Op::LE;
+            break;
+        case TExprOpcode::GT:
+            ins.op = Op::GT;
+            break;
+        case TExprOpcode::GE:
+            ins.op = Op::GE;
+            break;
+        default:
+            return -1;
+        }
+        // the operands are compared, not the results
+        ins.type = expr->get_child(0)->type().type;
+        if (!is_fused_numeric_type(ins.type)) {
+            return -1;
+        }
+        break;
+    case TExprNodeType::COMPOUND_PRED:
+        switch (expr->op()) {
+        case TExprOpcode::COMPOUND_AND:
+            ins.op = Op::AND;
+            break;
+        case TExprOpcode::COMPOUND_OR:
+            ins.op = Op::OR;
+            break;
+        case TExprOpcode::COMPOUND_NOT:
+            ins.op = Op::NOT;
+            break;
+        default:
+            return -1;
+        }
+        break;
+    default:
+        return -1;
+    }
+
+    int num_children = ins.op == Op::NOT ? 1 : 2;
+    if (expr->get_num_children() != num_children) {
+        return -1;
+    }
+    int operands[2] = {-1, -1};
+    for (int i = 0; i < num_children; i++) {
+        const Expr* child = expr->get_child(i);
+        if (child->type().type != ins.type) {
+            return -1;
+        }
+        operands[i] = _compile(child, program);
+        if (operands[i] < 0) {
+            return -1;
+        }
+    }
+    ins.lhs = operands[0];
+    ins.rhs = operands[1];
+    program->emplace_back(std::move(ins));
+    return static_cast<int>(program->size()) - 1;
+}
+
+Expr* FusedExpr::create(ObjectPool* pool, Expr* expr) {
+    std::vector<Instruction> program;
+    if (_compile(expr, &program) < 0) {
+        return nullptr;
+    }
+    size_t num_operators = 0;
+    for (const auto& ins : program) {
+        num_operators += ins.op != Op::COLUMN && ins.op != Op::CONST;
+    }
+    // a single operator has no intermediate result to save
+    if (num_operators < 2) {
+        return nullptr;
+    }
+    auto* fused = pool->add(new FusedExpr(expr));
+    fused->_program = std::move(program);
+    return fused;
+}
+
+static int fuse_children(ObjectPool* pool, Expr* expr) {
+    int num_fused = 0;
+    for (int i = 0; i < expr->get_num_children(); i++) {
+        Expr* fused = FusedExpr::create(pool, expr->get_child(i));
+        if (fused != nullptr) {
+            expr->set_child(i, fused);
+            num_fused++;
+        } else {
+            num_fused += fuse_children(pool, expr->get_child(i));
+        }
+    }
+    return num_fused;
+}
+
+int FusedExpr::fuse(ObjectPool* pool, std::vector<ExprContext*>* ctxs) {
+    int num_fused = 0;
+    for (auto& ctx : *ctxs) {
+        Expr* fused = create(pool, ctx->root());
+        if (fused != nullptr) {
+            ctx = pool->add(new ExprContext(fused));
+            num_fused++;
+        } else {
+            num_fused += fuse_children(pool, ctx->root());
+        }
+    }
+    return num_fused;
+}
+
+ColumnPtr FusedExpr::evaluate(ExprContext* context, vectorized::Chunk* ptr) {
+    size_t num_rows = ptr->num_rows();
+    size_t num_instructions = _program.size();
+    std::vector<uint8_t> registers(num_instructions * kRegisterBytes);
+
+    // the data of the inputs, the constant columns are expanded into their registers
+    std::vector<const uint8_t*> inputs(num_instructions, nullptr);
+    std::vector<size_t> widths(num_instructions, 0);
+    for (size_t i = 0; i < num_instructions; i++) {
+        const auto& ins = _program[i];
+        if (ins.op == Op::CONST) {
+            inputs[i] = ins.value.data();
+        } else if (ins.op == Op::COLUMN) {
+            const Column* column = ptr->get_column_by_slot_id(ins.slot_id).get();
+            bool is_const = column->is_constant();
+            if (is_const) {
+                column = down_cast<const ConstColumn*>(column)->data_column().get();
+            }
+            if (column->is_nullable()) {
+                if (column->has_null()) {
+                    return _children[0]->evaluate(context, ptr);
+                }
+                column = down_cast<const NullableColumn*>(column)->data_column().get();
+            }
+            if (is_const) {
+                uint8_t* reg = registers.data() + i * kRegisterBytes;
+                size_t width = column->type_size();
+                for (size_t j = 0; j < kBatchSize; j++) {
+                    memcpy(reg + j * width, column->raw_data(), width);
+                }
+                inputs[i] = reg;
+            } else {
+                inputs[i] = column->raw_data();
+                widths[i] = column->type_size();
+            }
+        }
+    }
+
+    ColumnPtr result = ColumnHelper::create_column(_type, false);
+    result->resize(num_rows);
+    uint8_t* result_data = result->mutable_raw_data();
+    size_t result_width = result->type_size();
+
+    std::vector<const uint8_t*> operands(num_instructions, nullptr);
+    for (size_t start = 0; start < num_rows; start += kBatchSize) {
+        size_t n = std::min(kBatchSize, num_rows - start);
+        for (size_t i = 0; i < num_instructions; i++) {
+            const auto& ins = _program[i];
+            if (ins.op == Op::COLUMN || ins.op == Op::CONST) {
+                // the width is 0 for the constants
+                operands[i] = inputs[i] + start * widths[i];
+                continue;
+            }
+            // the last instruction is the root, it writes the result directly
+            uint8_t* dst = i + 1 == num_instructions ? result_data + start * result_width
+                                                     : registers.data() + i * kRegisterBytes;
+            const uint8_t* l = operands[ins.lhs];
+            const uint8_t* r = ins.rhs >= 0 ? operands[ins.rhs] : nullptr;
+            switch (ins.op) {
+            case Op::ADD:
+                fused_numeric_dispatch(ins.type, FusedArithmetic<AddOp>(), l, r, dst, n);
+                break;
+            case Op::SUB:
+                fused_numeric_dispatch(ins.type, FusedArithmetic<SubOp>(), l, r, dst, n);
+                break;
+            case Op::MUL:
+                fused_numeric_dispatch(ins.type, FusedArithmetic<MulOp>(), l, r, dst, n);
+                break;
+            case Op::EQ:
+                fused_numeric_dispatch(ins.type, FusedCompare<std::equal_to>(), l, r, dst, n);
+                break;
+            case Op::NE:
+                fused_numeric_dispatch(ins.type, FusedCompare<std::not_equal_to>(), l, r, dst, n);
+                break;
+            case Op::LT:
+                fused_numeric_dispatch(ins.type, FusedCompare<std::less>(), l, r, dst, n);
+                break;
+            case Op::LE:
+                fused_numeric_dispatch(ins.type, FusedCompare<std::less_equal>(), l, r, dst, n);
+                break;
+            case Op::GT:
+                fused_numeric_dispatch(ins.type, FusedCompare<std::greater>(), l, r, dst, n);
+                break;
+            case Op::GE:
+                fused_numeric_dispatch(ins.type, FusedCompare<std::greater_equal>(), l, r, dst, n);
+                break;
+            case Op::AND:
+                for (size_t j = 0; j < n; j++) {
+                    dst[j] = l[j] & r[j];
+                }
+                break;
+            case Op::OR:
+                for (size_t j = 0; j < n; j++) {
+                    dst[j] = l[j] | r[j];
+                }
+                break;
+            case Op::NOT:
+                for (size_t j = 0; j < n; j++) {
+                    dst[j] = !l[j];
+                }
+                break;
+            default:
+                DCHECK(false);
+            }
+            operands[i] = dst;
+        }
+    }
+    return result;
+}
+
+} // namespace starrocks::vectorized
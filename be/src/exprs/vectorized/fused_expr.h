@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "common/global_types.h"
+#include "exprs/expr.h"
+
+namespace starrocks {
+
+class ExprContext;
+class ObjectPool;
+
+namespace vectorized {
+
+// FusedExpr evaluates a tree of the arithmetic (+, -, *), the comparisons and the AND/OR/NOT over the
+// fixed-width numeric and boolean columns in one pass, kBatchSize rows at a time. The intermediate
+// results stay in a few cache-resident buffers instead of a full column per node of the tree.
+//
+// The tree is translated into a program, one instruction per node in post order, when the FusedExpr is
+// created. The original tree is kept as the only child, it's evaluated instead if any input column of a
+// chunk has nulls.
+class FusedExpr final : public Expr {
+public:
+    static constexpr size_t kBatchSize = 256;
+
+    // Returns nullptr if the tree of `expr` can't be fused.
+    static Expr* create(ObjectPool* pool, Expr* expr);
+
+    // Replaces the largest fusable subtrees of the exprs of `ctxs`, which must not be prepared yet.
+    // A context whose root is fused is replaced by a new one.
+    // Returns the number of the subtrees fused.
+    static int fuse(ObjectPool* pool, std::vector<ExprContext*>* ctxs);
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new FusedExpr(*this)); }
+
+    ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override;
+
+private:
+    enum class Op { COLUMN, CONST, ADD, SUB, MUL, EQ, NE, LT, LE, GT, GE, AND, OR, NOT };
+
+    struct Instruction {
+        Op op;
+        // type of the operands
+        PrimitiveType type;
+        // the instructions computing the operands
+        int lhs = -1;
+        int rhs = -1;
+        // COLUMN only
+        SlotId slot_id = -1;
+        // CONST only, kBatchSize copies of the value
+        std::vector<uint8_t> value;
+    };
+
+    explicit FusedExpr(Expr* expr);
+
+    // Appends the instructions of the tree and returns the index of its last one, -1 if it can't be fused.
+    static int _compile(const Expr* expr, std::vector<Instruction>* program);
+
+    std::vector<Instruction> _program;
+};
+
+} // namespace vectorized
+} // namespace starrocks
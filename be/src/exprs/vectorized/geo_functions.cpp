@@ -347,6 +347,9 @@ ColumnPtr GeoFunctions::st_contains(FunctionContext* context, const Columns& col
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_BOOLEAN> result(size);
+    // The points, which are most of the shapes not constant (e.g. the locations tested by a geofence), are
+    // decoded into these without allocating a shape for each row.
+    GeoPoint points[2];
     for (int row = 0; row < size; ++row) {
         if (lhs_viewer.is_null(row) || rhs_viewer.is_null(row)) {
             result.append_null();
@@ -363,6 +366,12 @@ ColumnPtr GeoFunctions::st_contains(FunctionContext* context, const Columns& col
         for (i = 0; i < 2; ++i) {
             if (state != nullptr && state->shapes[i] != nullptr) {
                 shapes[i] = state->shapes[i];
+            } else if (strs[i]->size >= 2 && strs[i]->data[1] == GEO_SHAPE_POINT) {
+                if (!points[i].decode_from(strs[i]->data, strs[i]->size)) {
+                    result.append_null();
+                    break;
+                }
+                shapes[i] = &points[i];
             } else {
                 shapes[i] = local_state.shapes[i] = GeoShape::from_encoded(strs[i]->data, strs[i]->size);
                 if (shapes[i] == nullptr) {
@@ -5,6 +5,7 @@
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "column/fixed_value_set.h"
 #include "column/hash_set.h"
 #include "common/object_pool.h"
 #include "exprs/predicate.h"
@@ -25,6 +26,11 @@ struct PHashSet {
     using PType = HashSet<RunTimeCppType<Type>>;
 };
 
+template <PrimitiveType Type>
+struct PHashSet<Type, std::enable_if_t<std::is_integral_v<RunTimeCppType<Type>>>> {
+    using PType = FixedValueSet<RunTimeCppType<Type>>;
+};
+
 template <PrimitiveType Type>
 struct PHashSet<Type, std::enable_if_t<isSlicePT<Type>>> {
     using PType = SliceHashSet;
@@ -177,8 +183,12 @@ public:
         uint8_t* data3 = result->get_data().data();
 
         if (!lhs->is_constant()) {
-            for (int row = 0; row < size; ++row) {
-                data3[row] = check_value_existence<use_array>(data[row]);
+            if constexpr (!use_array && std::is_integral_v<ValueType>) {
+                _hash_set.contains(data, size, data3);
+            } else {
+                for (int row = 0; row < size; ++row) {
+                    data3[row] = check_value_existence<use_array>(data[row]);
+                }
             }
             if (_is_not_in) {
                 for (int i = 0; i < size; i++) {
@@ -18,6 +18,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/status.h"
+#include "exprs/agg/java_window_function.h"
 #include "exprs/anyval_util.h"
 #include "exprs/vectorized/java_function_call_expr.h"
 #include "fmt/compile.h"
@@ -50,6 +51,7 @@ struct UDFFunctionCallHelper {
     JavaUDFContext* fn_desc;
     JavaMethodDescriptor* call_desc;
     std::vector<std::string> _data_buffer;
+    UDFHelper _udf_helper;
 
     using VariantContainer = std::variant<
 #define M(NAME) RunTimeColumnType<NAME>::Container,
@@ -61,6 +63,10 @@ struct UDFFunctionCallHelper {
     ColumnPtr call(FunctionContext* ctxs, Columns& columns, size_t size) {
         auto& helper = JVMFunctionHelper::getInstance();
 
+        if (can_batch_call(columns)) {
+            return batch_call(ctxs, columns, size);
+        }
+
         size_t num_cols = columns.size();
 
         std::vector<VariantContainer> casts_values;
@@ -106,6 +112,98 @@ struct UDFFunctionCallHelper {
         return res;
     }
 
+    // The boxed arguments and results could be passed by arrays, then the columns are boxed in Java from
+    // the DirectByteBuffers of their memory, and the UDF is called for all the rows by a single JNI call,
+    // instead of boxing every value and calling the UDF through JNI row by row.
+    // The primitive arguments and results are left to the row path, which defines how nulls go to them.
+    bool can_batch_call(const Columns& columns) const {
+        if (!call_desc->method_desc[0].is_box) {
+            return false;
+        }
+        for (int i = 0; i < columns.size(); ++i) {
+            if (!call_desc->method_desc[i + 1].is_box || columns[i]->only_null()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ColumnPtr batch_call(FunctionContext* ctx, Columns& columns, size_t size) {
+        auto& helper = JVMFunctionHelper::getInstance();
+        JNIEnv* env = helper.getEnv();
+        int num_cols = columns.size();
+        // the boxed arrays and the results are all released by the local frame
+        env->PushLocalFrame(num_cols + 4);
+
+        Columns unpacked_columns(num_cols);
+        std::vector<DirectByteBuffer> buffers;
+        ConvertDirectBufferVistor vistor(buffers);
+        jobject input_cols[num_cols];
+        for (int i = 0; i < num_cols; ++i) {
+            unpacked_columns[i] = ColumnHelper::unpack_and_duplicate_const_column(size, columns[i]);
+            int buffers_idx = buffers.size();
+            unpacked_columns[i]->accept(&vistor);
+            int buffers_sz = buffers.size() - buffers_idx;
+            input_cols[i] = _udf_helper.create_boxed_array(call_desc->method_desc[i + 1].type, size,
+                                                           unpacked_columns[i]->is_nullable(),
+                                                           &buffers[buffers_idx], buffers_sz);
+        }
+
+        jmethodID methodID = env->GetMethodID(fn_desc->udf_class.clazz(), fn_desc->evaluate->name.c_str(),
+                                              fn_desc->evaluate->sign.c_str());
+        DCHECK(methodID != nullptr);
+        jobject method = env->ToReflectedMethod(fn_desc->udf_class.clazz(), methodID, JNI_FALSE);
+        jobject results = _udf_helper.batch_call(fn_desc->udf_handle, method, size, input_cols, num_cols);
+
+        ColumnPtr res;
+        if (auto jthr = env->ExceptionOccurred(); jthr != nullptr) {
+            std::string err = fmt::format("execute UDF Function meet Exception:{}", helper.dumpExceptionString(jthr));
+            LOG(WARNING) << err;
+            ctx->set_error(err.c_str());
+            env->ExceptionClear();
+            res = ColumnHelper::create_const_null_column(size);
+        } else {
+            res = get_boxed_array_result((jobjectArray)results, size);
+        }
+        env->PopLocalFrame(nullptr);
+        return res;
+    }
+
+    ColumnPtr get_boxed_array_result(jobjectArray results, int num_rows) {
+        auto& helper = JVMFunctionHelper::getInstance();
+        JNIEnv* env = helper.getEnv();
+        auto type = call_desc->method_desc[0].type;
+        if (type == TYPE_VARCHAR) {
+            std::vector<jobject> result_data(num_rows);
+            for (int i = 0; i < num_rows; ++i) {
+                result_data[i] = env->GetObjectArrayElement(results, i);
+            }
+            VariantContainer container(std::move(result_data));
+            auto res = get_result(container);
+            do_clear(&container);
+            return res;
+        }
+
+        ColumnPtr data_col;
+        switch (type) {
+#define M(NAME)                                               \
+    case NAME: {                                              \
+        data_col = RunTimeColumnType<NAME>::create(num_rows); \
+        break;                                                \
+    }
+            APPLY_FOR_NUMBERIC_TYPE(M)
+#undef M
+        default:
+            DCHECK(false) << "Not support type";
+            return nullptr;
+        }
+        auto null_col = NullColumn::create(num_rows, 0);
+        DirectByteBuffer null_buffer(null_col->get_data().data(), num_rows);
+        DirectByteBuffer data_buffer(data_col->mutable_raw_data(), num_rows * data_col->type_size());
+        _udf_helper.get_result_from_boxed_array(type, results, num_rows, &null_buffer, &data_buffer);
+        return NullableColumn::create(std::move(data_col), std::move(null_col));
+    }
+
     void do_resize(std::vector<VariantContainer>* container, int num_rows) {
         int num_cols = call_desc->method_desc.size();
         container->reserve(num_cols);
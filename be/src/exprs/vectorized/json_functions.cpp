@@ -189,6 +189,17 @@ ColumnPtr JsonFunctions::_iterate_rows(FunctionContext* context, const Columns&
 
     simdjson::ondemand::parser parser;
 
+    // the path compiled in json_path_prepare() if it's constant, otherwise the one of the last row is reused
+    // as long as the path doesn't change
+    auto* prepared_path = reinterpret_cast<std::vector<SimpleJsonPath>*>(
+            context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+    std::vector<SimpleJsonPath> row_path;
+    std::string last_path_string;
+    bool has_row_path = false;
+    // reused for the rows to save the allocations
+    std::string json_string;
+    std::string path_string;
+
     auto size = columns[0]->size();
     ColumnBuilder<primitive_type> result(size);
     for (int row = 0; row < size; ++row) {
@@ -202,17 +213,27 @@ ColumnPtr JsonFunctions::_iterate_rows(FunctionContext* context, const Columns&
             result.append_null();
             continue;
         }
-        std::string json_string(json_value.data, json_value.size);
 
-        auto path_value = path_viewer.value(row);
-        std::string path_string(path_value.data, path_value.size);
-        // Must remove or replace the escape sequence.
-        path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
-        if (path_string.empty()) {
-            result.append_null();
-            continue;
+        const std::vector<SimpleJsonPath>* jsonpath = prepared_path;
+        if (jsonpath == nullptr) {
+            auto path_value = path_viewer.value(row);
+            path_string.assign(path_value.data, path_value.size);
+            // Must remove or replace the escape sequence.
+            path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
+            if (path_string.empty()) {
+                result.append_null();
+                continue;
+            }
+            if (!has_row_path || path_string != last_path_string) {
+                row_path.clear();
+                parse_json_paths(path_string, &row_path);
+                last_path_string = path_string;
+                has_row_path = true;
+            }
+            jsonpath = &row_path;
         }
 
+        json_string.assign(json_value.data, json_value.size);
         // Reserve for simdjson padding.
         json_string.reserve(json_string.size() + simdjson::SIMDJSON_PADDING);
 
@@ -222,9 +243,6 @@ ColumnPtr JsonFunctions::_iterate_rows(FunctionContext* context, const Columns&
             continue;
         }
 
-        std::vector<SimpleJsonPath> jsonpath;
-        parse_json_paths(path_string, &jsonpath);
-
         simdjson::ondemand::json_type tp;
 
         auto err = doc.type().get(tp);
@@ -244,7 +262,7 @@ ColumnPtr JsonFunctions::_iterate_rows(FunctionContext* context, const Columns&
             }
 
             simdjson::ondemand::value value;
-            if (!extract_from_object(obj, jsonpath, value)) {
+            if (!extract_from_object(obj, *jsonpath, value)) {
                 result.append_null();
                 continue;
             }
@@ -283,7 +301,7 @@ ColumnPtr JsonFunctions::_iterate_rows(FunctionContext* context, const Columns&
                 }
 
                 simdjson::ondemand::value value;
-                if (!extract_from_object(obj, jsonpath, value)) {
+                if (!extract_from_object(obj, *jsonpath, value)) {
                     result.append_null();
                     continue;
                 }
@@ -399,14 +417,22 @@ ColumnPtr JsonFunctions::json_string(FunctionContext* context, const Columns& co
 
 //////////////////////////// User visiable functions /////////////////////////////////
 
-static StatusOr<JsonPath*> get_prepared_or_parse(FunctionContext* context, Slice slice, JsonPath* out) {
+// Returns the path compiled in native_json_path_prepare() if it's constant, otherwise parses `slice` into `out`,
+// unless it's the same as `out_string`, the path `out` was parsed from for the last row.
+static StatusOr<JsonPath*> get_prepared_or_parse(FunctionContext* context, Slice slice, JsonPath* out,
+                                                 std::string* out_string) {
     JsonPath* prepared = reinterpret_cast<JsonPath*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
     if (prepared != nullptr) {
         return prepared;
     }
+    if (!out->paths.empty() && Slice(*out_string) == slice) {
+        return out;
+    }
+    out->paths.clear();
     auto res = JsonPath::parse(slice);
     RETURN_IF(!res.ok(), res.status());
     out->reset(std::move(res.value()));
+    out_string->assign(slice.data, slice.size);
     return out;
 }
 
@@ -444,18 +470,20 @@ ColumnPtr JsonFunctions::json_query(FunctionContext* context, const Columns& col
     ColumnBuilder<TYPE_JSON> result(num_rows);
 
     JsonPath stored_path;
+    std::string stored_path_string;
+    vpack::Builder builder;
     for (int row = 0; row < num_rows; ++row) {
         JsonValue* json_value = json_viewer.value(row);
         auto path_value = path_viewer.value(row);
 
-        auto jsonpath = get_prepared_or_parse(context, path_value, &stored_path);
+        auto jsonpath = get_prepared_or_parse(context, path_value, &stored_path, &stored_path_string);
         if (!jsonpath.ok()) {
             VLOG(2) << "parse json path failed: " << path_value;
             result.append_null();
             continue;
         }
 
-        vpack::Builder builder;
+        builder.clear();
         vpack::Slice slice = JsonPath::extract(json_value, *jsonpath.value(), &builder);
         if (slice.isNone()) {
             result.append_null();
@@ -474,6 +502,8 @@ ColumnPtr JsonFunctions::json_exists(FunctionContext* context, const Columns& co
     ColumnBuilder<TYPE_BOOLEAN> result(num_rows);
 
     JsonPath stored_path;
+    std::string stored_path_string;
+    vpack::Builder builder;
     for (int row = 0; row < num_rows; row++) {
         if (json_viewer.is_null(row) || json_viewer.value(row) == nullptr) {
             result.append_null();
@@ -482,7 +512,7 @@ ColumnPtr JsonFunctions::json_exists(FunctionContext* context, const Columns& co
 
         JsonValue* json_value = json_viewer.value(row);
         Slice path_str = path_viewer.value(row);
-        auto jsonpath = get_prepared_or_parse(context, path_str, &stored_path);
+        auto jsonpath = get_prepared_or_parse(context, path_str, &stored_path, &stored_path_string);
 
         if (!jsonpath.ok()) {
             result.append_null();
@@ -490,7 +520,7 @@ ColumnPtr JsonFunctions::json_exists(FunctionContext* context, const Columns& co
             continue;
         }
         VLOG(2) << "json_exists for  " << path_str << " of " << json_value->to_string().value();
-        vpack::Builder builder;
+        builder.clear();
         vpack::Slice slice = JsonPath::extract(json_value, *jsonpath.value(), &builder);
         result.append(!slice.isNone());
     }
@@ -155,7 +155,7 @@ vpack::Slice JsonPathPiece::extract(vpack::Slice root, const std::vector<JsonPat
 
     for (int i = path_index; i < jsonpath.size(); i++) {
         auto& path_item = jsonpath[i];
-        auto item_key = path_item.key;
+        const auto& item_key = path_item.key;
         auto& array_selector = path_item.array_selector;
 
         // iterate the path key
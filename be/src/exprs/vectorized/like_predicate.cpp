@@ -470,10 +470,15 @@ ColumnPtr LikePredicate::regex_match_partial(FunctionContext* context, const sta
 
 template <bool fullMatch>
 std::string LikePredicate::convert_like_pattern(FunctionContext* context, const Slice& pattern) {
+    auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+    return convert_like_pattern<fullMatch>(state->escape_char, pattern);
+}
+
+template <bool fullMatch>
+std::string LikePredicate::convert_like_pattern(char escape_char, const Slice& pattern) {
     std::string re_pattern;
     re_pattern.clear();
 
-    auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
     bool is_escaped = false;
 
     if constexpr (fullMatch) {
@@ -486,7 +491,7 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
         } else if (!is_escaped && pattern.data[i] == '_') {
             re_pattern.append(".");
             // check for escape char before checking for regex special chars, they might overlap
-        } else if (!is_escaped && pattern.data[i] == state->escape_char) {
+        } else if (!is_escaped && pattern.data[i] == escape_char) {
             is_escaped = true;
         } else if (pattern.data[i] == '.' || pattern.data[i] == '[' || pattern.data[i] == ']' ||
                    pattern.data[i] == '{' || pattern.data[i] == '}' || pattern.data[i] == '(' ||
@@ -527,4 +532,85 @@ void LikePredicate::remove_escape_character(std::string* search_string) {
     }
 }
 
+MultiPatternMatcher::~MultiPatternMatcher() {
+    if (_scratch != nullptr) {
+        hs_free_scratch(_scratch);
+    }
+    if (_database != nullptr) {
+        hs_free_database(_database);
+    }
+}
+
+Status MultiPatternMatcher::init(const std::vector<std::string>& like_patterns,
+                                 const std::vector<std::string>& regex_patterns) {
+    std::vector<std::string> patterns;
+    patterns.reserve(like_patterns.size() + regex_patterns.size());
+    for (const auto& pattern : like_patterns) {
+        // the same as the default escape character of LikePredicateState
+        patterns.emplace_back(LikePredicate::convert_like_pattern<true>('\\', Slice(pattern)));
+    }
+    for (const auto& pattern : regex_patterns) {
+        patterns.emplace_back(pattern);
+    }
+
+    std::vector<const char*> expressions;
+    std::vector<unsigned int> flags;
+    std::vector<unsigned int> ids;
+    for (size_t i = 0; i < patterns.size(); i++) {
+        expressions.emplace_back(patterns[i].c_str());
+        flags.emplace_back(HS_FLAG_ALLOWEMPTY | HS_FLAG_DOTALL | HS_FLAG_UTF8 | HS_FLAG_SINGLEMATCH);
+        ids.emplace_back(i);
+    }
+
+    hs_compile_error_t* compile_err = nullptr;
+    if (hs_compile_multi(expressions.data(), flags.data(), ids.data(), expressions.size(), HS_MODE_BLOCK, nullptr,
+                         &_database, &compile_err) != HS_SUCCESS) {
+        std::string msg = strings::Substitute("Invalid regex expression: $0", compile_err->message);
+        hs_free_compile_error(compile_err);
+        return Status::InvalidArgument(msg);
+    }
+    if (hs_alloc_scratch(_database, &_scratch) != HS_SUCCESS) {
+        return Status::InternalError("Unable to allocate scratch space");
+    }
+    return Status::OK();
+}
+
+ColumnPtr MultiPatternMatcher::match(const ColumnPtr& value_column) const {
+    ColumnViewer<TYPE_VARCHAR> value_viewer(value_column);
+    ColumnBuilder<TYPE_BOOLEAN> result(value_viewer.size());
+
+    hs_scratch_t* scratch = nullptr;
+    hs_error_t status;
+    if ((status = hs_clone_scratch(_scratch, &scratch)) != HS_SUCCESS) {
+        CHECK(false) << "ERROR: Unable to clone scratch space."
+                     << " status: " << status;
+    }
+
+    auto on_match = [](unsigned int id, unsigned long long from, unsigned long long to, unsigned int flags,
+                       void* ctx) -> int {
+        *((bool*)ctx) = true;
+        // any pattern matching is enough
+        return 1;
+    };
+    for (int row = 0; row < value_viewer.size(); ++row) {
+        if (value_viewer.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+        bool v = false;
+        Slice value = value_viewer.value(row);
+        // Use a non null pointer for the empty value to avoid crash, as LikePredicate does.
+        status = hs_scan(_database, value.size ? value.data : &LikePredicate::_DUMMY_STRING_FOR_EMPTY_PATTERN,
+                         value.size, 0, scratch, on_match, &v);
+        DCHECK(status == HS_SUCCESS || status == HS_SCAN_TERMINATED) << " status: " << status;
+        result.append(v);
+    }
+
+    if ((status = hs_free_scratch(scratch)) != HS_SUCCESS) {
+        CHECK(false) << "ERROR: free scratch space failure"
+                     << " status: " << status;
+    }
+    return result.build(value_column->is_constant());
+}
+
 } // namespace starrocks::vectorized
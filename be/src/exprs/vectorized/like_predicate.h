@@ -17,6 +17,8 @@
 namespace starrocks {
 namespace vectorized {
 
+class MultiPatternMatcher;
+
 class LikePredicate {
 public:
     // Like method
@@ -139,9 +141,14 @@ private:
     template <bool fullMatch>
     static std::string convert_like_pattern(starrocks_udf::FunctionContext* context, const Slice& pattern);
 
+    template <bool fullMatch>
+    static std::string convert_like_pattern(char escape_char, const Slice& pattern);
+
     static void remove_escape_character(std::string* search_string);
 
 private:
+    friend class MultiPatternMatcher;
+
     static ColumnPtr _predicate_const_regex(FunctionContext* context, ColumnBuilder<TYPE_BOOLEAN>* result,
                                             const ColumnViewer<TYPE_VARCHAR>& value_viewer,
                                             const ColumnPtr& value_column);
@@ -207,5 +214,30 @@ private:
         }
     };
 };
+
+// Matches the values of a string column against a set of constant LIKE and REGEXP patterns together with
+// a single Hyperscan database, a value matches if any of the patterns matches it. It's used to evaluate
+// the predicates like `a LIKE '%x%' OR a REGEXP 'y.*z'` with one scan of each value instead of one per pattern.
+class MultiPatternMatcher {
+public:
+    MultiPatternMatcher() = default;
+    ~MultiPatternMatcher();
+
+    MultiPatternMatcher(const MultiPatternMatcher&) = delete;
+    MultiPatternMatcher& operator=(const MultiPatternMatcher&) = delete;
+
+    // Fails if any of the patterns can't be compiled by Hyperscan, the caller should evaluate them apart then.
+    Status init(const std::vector<std::string>& like_patterns, const std::vector<std::string>& regex_patterns);
+
+    // Returns a BOOLEAN column, which is null where `value_column` is null.
+    // Safe for concurrent use by multiple threads.
+    ColumnPtr match(const ColumnPtr& value_column) const;
+
+private:
+    hs_database_t* _database = nullptr;
+    // the prototype the scratch of each call is cloned from
+    hs_scratch_t* _scratch = nullptr;
+};
+
 } // namespace vectorized
 } // namespace starrocks
@@ -26,7 +26,7 @@ SimdBlockFilter::SimdBlockFilter(SimdBlockFilter&& bf) noexcept {
 }
 
 size_t SimdBlockFilter::max_serialized_size() const {
-    const size_t alloc_size = get_alloc_size();
+    const size_t alloc_size = initialized() ? get_alloc_size() : 0;
     return sizeof(_log_num_buckets) + sizeof(_directory_mask) + // data size + max data size
            sizeof(int32_t) + alloc_size;
 }
@@ -39,11 +39,14 @@ size_t SimdBlockFilter::serialize(uint8_t* data) const {
     SIMD_BF_COPY_FIELD(_log_num_buckets);
     SIMD_BF_COPY_FIELD(_directory_mask);
 
-    const size_t alloc_size = get_alloc_size();
+    // the data size of a filter that isn't initialized is 0
+    const size_t alloc_size = initialized() ? get_alloc_size() : 0;
     int32_t data_size = alloc_size;
     SIMD_BF_COPY_FIELD(data_size);
-    memcpy(data + offset, _directory, data_size);
-    offset += data_size;
+    if (data_size != 0) {
+        memcpy(data + offset, _directory, data_size);
+        offset += data_size;
+    }
     return offset;
 #undef SIMD_BF_COPY_FIELD
 }
@@ -59,6 +62,9 @@ size_t SimdBlockFilter::deserialize(const uint8_t* data) {
     SIMD_BF_COPY_FIELD(_directory_mask);
     SIMD_BF_COPY_FIELD(data_size);
 #undef SIMD_BF_COPY_FIELD
+    if (data_size == 0) {
+        return offset;
+    }
     const size_t alloc_size = get_alloc_size();
     DCHECK(data_size == alloc_size);
     const int malloc_failed = posix_memalign(reinterpret_cast<void**>(&(_directory)), 64, alloc_size);
@@ -69,6 +75,12 @@ size_t SimdBlockFilter::deserialize(const uint8_t* data) {
 }
 
 void SimdBlockFilter::merge(const SimdBlockFilter& bf) {
+    // the merged filter of a filter that isn't initialized can't be initialized either
+    if (!initialized() || !bf.initialized()) {
+        free(_directory);
+        _directory = nullptr;
+        return;
+    }
     DCHECK(_log_num_buckets == bf._log_num_buckets);
     for (int i = 0; i < (1 << _log_num_buckets); i++) {
 #ifdef __AVX2__
@@ -102,6 +114,9 @@ void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
 }
 
 bool SimdBlockFilter::check_equal(const SimdBlockFilter& bf) const {
+    if (!initialized() || !bf.initialized()) {
+        return initialized() == bf.initialized();
+    }
     const size_t alloc_size = get_alloc_size();
     return _log_num_buckets == bf._log_num_buckets && _directory_mask == bf._directory_mask &&
            memcmp(_directory, bf._directory, alloc_size) == 0;
@@ -7,6 +7,7 @@
 #include "column/const_column.h"
 #include "column/nullable_column.h"
 #include "column/type_traits.h"
+#include "common/config.h"
 #include "common/global_types.h"
 #include "common/object_pool.h"
 #include "gen_cpp/PlanNodes_types.h"
@@ -31,6 +32,10 @@ public:
 
     void init(size_t nums);
 
+    // A filter that isn't initialized, e.g. the one of a runtime filter keeping only the min and the max, has no
+    // directory, and the callers must not insert into or test it.
+    bool initialized() const { return _directory != nullptr; }
+
     void insert_hash(const uint64_t hash) noexcept {
         const uint32_t bucket_idx = hash & _directory_mask;
 #ifdef __AVX2__
@@ -130,9 +135,9 @@ private:
 
     // Common:
     // log_num_buckets_ is the log (base 2) of the number of buckets in the directory:
-    int _log_num_buckets;
+    int _log_num_buckets = 0;
     // directory_mask_ is (1 << log_num_buckets_) - 1
-    uint32_t _directory_mask;
+    uint32_t _directory_mask = 0;
     Bucket* _directory = nullptr;
 };
 
@@ -201,6 +206,8 @@ public:
     public:
         Column::Filter selection;
         std::vector<uint32_t> hash_values;
+        // the FNV hashes of the input column if the caller has them, see use_fnv_partition_hash()
+        const std::vector<uint32_t>* fnv_hashes = nullptr;
     };
 
     virtual Column::Filter& evaluate(Column* input_column, RunningContext* ctx) const = 0;
@@ -209,6 +216,12 @@ public:
 
     bool has_null() const { return _has_null; }
 
+    // Whether evaluate() hashes the input column as the shuffle of HASH_PARTITIONED does, in which case the
+    // hashes can be shared with the exchange through RunningContext::fnv_hashes.
+    bool use_fnv_partition_hash() const {
+        return _hash_partition_number != 0 && _join_mode == TRuntimeFilterBuildJoinMode::PARTITIONED;
+    }
+
     virtual std::string debug_string() const = 0;
 
     void set_join_mode(int8_t join_mode) { _join_mode = join_mode; }
@@ -275,9 +288,13 @@ public:
             _max = DecimalV2Value::get_min_decimal();
         }
     }
+    // The filter of a build side with more than runtime_filter_bloom_max_rows rows keeps only the min and the max,
+    // since its bloom filter would be too large to build, send and probe cheaply.
     void init_bloom_filter(size_t hash_table_size) {
         _size = hash_table_size;
-        _bf.init(_size);
+        if (config::runtime_filter_bloom_max_rows <= 0 || _size <= config::runtime_filter_bloom_max_rows) {
+            _bf.init(_size);
+        }
     }
 
     void init(size_t hash_table_size) override {
@@ -299,8 +316,9 @@ public:
             return;
         }
 
-        size_t hash = compute_hash(*value);
-        _bf.insert_hash(hash);
+        if (_bf.initialized()) {
+            _bf.insert_hash(compute_hash(*value));
+        }
 
         _min = std::min(*value, _min);
         _max = std::max(*value, _max);
@@ -319,8 +337,7 @@ public:
                 return false;
             }
         }
-        size_t hash = compute_hash(value);
-        return _bf.test_hash(hash);
+        return !_bf.initialized() || _bf.test_hash(compute_hash(value));
     }
 
     bool test_data_with_hash(CppType value, const uint32_t shuffle_hash) const {
@@ -331,8 +348,8 @@ public:
         }
         // module has been done outside, so actually here is bucket idx.
         const uint32_t bucket_idx = shuffle_hash;
-        size_t hash = compute_hash(value);
-        return _hash_partition_bf[bucket_idx].test_hash(hash);
+        const SimdBlockFilter& bf = _hash_partition_bf[bucket_idx];
+        return !bf.initialized() || bf.test_hash(compute_hash(value));
     }
 
     Column::Filter& evaluate(Column* input_column, RunningContext* ctx) const override {
@@ -366,8 +383,13 @@ public:
                 // since there is only one copy and one rf
                 _hash_values.assign(size, 0);
             } else if (_join_mode == TRuntimeFilterBuildJoinMode::PARTITIONED) {
-                _hash_values.assign(size, HashUtil::FNV_SEED);
-                input_column->fnv_hash(_hash_values.data(), 0, size);
+                if (ctx->fnv_hashes != nullptr) {
+                    DCHECK_EQ(size, ctx->fnv_hashes->size());
+                    _hash_values.assign(ctx->fnv_hashes->begin(), ctx->fnv_hashes->end());
+                } else {
+                    _hash_values.assign(size, HashUtil::FNV_SEED);
+                    input_column->fnv_hash(_hash_values.data(), 0, size);
+                }
                 for (size_t i = 0; i < size; i++) {
                     _hash_values[i] %= _hash_partition_number;
                 }
@@ -475,6 +497,9 @@ public:
         PrimitiveType ptype = Type;
         std::stringstream ss;
         ss << "RuntimeBF(type = " << ptype << ", bfsize = " << _size << ", has_null = " << _has_null;
+        if (_hash_partition_number == 0 && !_bf.initialized()) {
+            ss << ", min_max_only";
+        }
         if constexpr (std::is_integral_v<CppType> || std::is_floating_point_v<CppType>) {
             if constexpr (!std::is_same_v<CppType, __int128>) {
                 ss << ", _min = " << _min << ", _max = " << _max;
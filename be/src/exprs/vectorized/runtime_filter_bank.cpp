@@ -247,6 +247,25 @@ void RuntimeFilterProbeCollector::close(RuntimeState* state) {
     }
 }
 
+// The partitioned runtime filter hashes the probe column with the hash of the shuffle, which is cached in the chunk
+// for the exchange sink shuffling the chunk by the same column later.
+void RuntimeFilterProbeCollector::prepare_partition_hashes(vectorized::Chunk* chunk, const ColumnPtr& column,
+                                                           const JoinRuntimeFilter* filter,
+                                                           JoinRuntimeFilter::RunningContext* ctx) {
+    ctx->fnv_hashes = nullptr;
+    // the result of an expression is hashed by the runtime filter itself, since nobody else could reuse it
+    if (!filter->use_fnv_partition_hash() || !chunk->contains_column(column.get())) {
+        return;
+    }
+    const vectorized::Columns keys{column};
+    ctx->fnv_hashes = chunk->cached_hashes(keys, vectorized::Chunk::HashAlgorithm::FNV);
+    if (ctx->fnv_hashes == nullptr) {
+        std::vector<uint32_t> hashes;
+        chunk->hash_columns(keys, vectorized::Chunk::HashAlgorithm::FNV, &hashes);
+        ctx->fnv_hashes = chunk->cache_hashes(keys, vectorized::Chunk::HashAlgorithm::FNV, std::move(hashes));
+    }
+}
+
 // do_evaluate is reentrant, can be called concurrently by multiple operators that shared the same
 // RuntimeFilterProbeCollector.
 void RuntimeFilterProbeCollector::do_evaluate(vectorized::Chunk* chunk, RuntimeBloomFilterEvalContext& eval_context) {
@@ -260,6 +279,7 @@ void RuntimeFilterProbeCollector::do_evaluate(vectorized::Chunk* chunk, RuntimeB
             const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
             if (filter == nullptr) continue;
             ColumnPtr column = rf_desc->probe_expr_ctx()->evaluate(chunk);
+            prepare_partition_hashes(chunk, column, filter, &eval_context.running_context);
             vectorized::Column::Filter& selection = filter->evaluate(column.get(), &eval_context.running_context);
             eval_context.run_filter_nums += 1;
             size_t true_count = SIMD::count_nonzero(selection);
@@ -317,6 +337,7 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk,
         const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
         if (filter == nullptr) continue;
         ColumnPtr column = rf_desc->probe_expr_ctx()->evaluate(chunk);
+        prepare_partition_hashes(chunk, column, filter, &eval_context.running_context);
         vectorized::Column::Filter& new_selection = filter->evaluate(column.get(), &eval_context.running_context);
         eval_context.run_filter_nums += 1;
         size_t true_count = SIMD::count_nonzero(new_selection);
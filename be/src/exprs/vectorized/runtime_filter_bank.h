@@ -114,7 +114,7 @@ private:
     ExprContext* _probe_expr_ctx = nullptr;
     bool _is_local;
     TPlanNodeId _build_plan_node_id;
-    std::atomic<const JoinRuntimeFilter*> _runtime_filter;
+    std::atomic<const JoinRuntimeFilter*> _runtime_filter{nullptr};
     std::shared_ptr<const JoinRuntimeFilter> _shared_runtime_filter;
     JoinRuntimeFilter::RunningContext _runtime_filter_ctx;
     // we want to measure when this runtime filter is applied since it's opened.
@@ -172,6 +172,8 @@ private:
     void update_selectivity(vectorized::Chunk* chunk, RuntimeBloomFilterEvalContext& eval_context);
     void do_evaluate(vectorized::Chunk* chunk);
     void do_evaluate(vectorized::Chunk* chunk, RuntimeBloomFilterEvalContext& eval_context);
+    static void prepare_partition_hashes(vectorized::Chunk* chunk, const ColumnPtr& column,
+                                         const JoinRuntimeFilter* filter, JoinRuntimeFilter::RunningContext* ctx);
     // mapping from filter id to runtime filter descriptor.
     std::map<int32_t, RuntimeFilterProbeDescriptor*> _descriptors;
     int _wait_timeout_ms = 0;
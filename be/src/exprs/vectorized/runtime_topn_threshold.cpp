@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exprs/vectorized/runtime_topn_threshold.h"
+
+#include "column/type_traits.h"
+#include "glog/logging.h"
+
+namespace starrocks::vectorized {
+
+template <PrimitiveType PT>
+static bool ranks_before(const Datum& lhs, const Datum& rhs, bool is_asc) {
+    using CppType = RunTimeCppType<PT>;
+    const CppType l = lhs.get<CppType>();
+    const CppType r = rhs.get<CppType>();
+    return is_asc ? l < r : r < l;
+}
+
+bool RuntimeTopnThreshold::support_type(PrimitiveType type) {
+    switch (type) {
+#define M(PT) case PT:
+        APPLY_FOR_RUNTIME_TOPN_THRESHOLD_TYPE(M)
+#undef M
+        return true;
+    default:
+        return false;
+    }
+}
+
+void RuntimeTopnThreshold::update(const Datum& value) {
+    if (value.is_null()) {
+        return;
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_has_value.load(std::memory_order_relaxed)) {
+        bool tighter = false;
+        switch (_type) {
+#define M(PT)                                               \
+    case PT:                                                \
+        tighter = ranks_before<PT>(value, _value, _is_asc); \
+        break;
+            APPLY_FOR_RUNTIME_TOPN_THRESHOLD_TYPE(M)
+#undef M
+        default:
+            DCHECK(false) << "unsupported type " << _type;
+        }
+        if (!tighter) {
+            return;
+        }
+    }
+    _value = value;
+    _has_value.store(true, std::memory_order_release);
+}
+
+Datum RuntimeTopnThreshold::value() const {
+    DCHECK(has_value());
+    std::lock_guard<std::mutex> l(_mutex);
+    return _value;
+}
+
+} // namespace starrocks::vectorized
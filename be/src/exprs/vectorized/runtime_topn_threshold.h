@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "column/datum.h"
+#include "common/global_types.h"
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+// The types of the order-by columns whose thresholds can be published, they are compared as CppType.
+#define APPLY_FOR_RUNTIME_TOPN_THRESHOLD_TYPE(M) \
+    M(TYPE_TINYINT)                              \
+    M(TYPE_SMALLINT)                             \
+    M(TYPE_INT)                                  \
+    M(TYPE_BIGINT)                               \
+    M(TYPE_LARGEINT)                             \
+    M(TYPE_FLOAT)                                \
+    M(TYPE_DOUBLE)                               \
+    M(TYPE_DATE)                                 \
+    M(TYPE_DATETIME)                             \
+    M(TYPE_DECIMALV2)                            \
+    M(TYPE_DECIMAL32)                            \
+    M(TYPE_DECIMAL64)                            \
+    M(TYPE_DECIMAL128)
+
+// RuntimeTopnThreshold is the k-th value of the first order-by column of `ORDER BY ... LIMIT k`, published by the
+// sorters while they are consuming the input. A row ranked after it can't be in the result, so the scan feeding the
+// sorters filters out such rows, and skips the pages without any value ranked before or equal to it.
+//
+// Each sorter publishes the k-th value of its own input, which never ranks before the k-th value of the whole
+// input, so the threshold is the best one published so far, and it only gets tighter.
+class RuntimeTopnThreshold {
+public:
+    // |slot_id| is the slot of the scan the first order-by column refers to.
+    RuntimeTopnThreshold(SlotId slot_id, PrimitiveType type, bool is_asc, bool is_null_first)
+            : _slot_id(slot_id), _type(type), _is_asc(is_asc), _is_null_first(is_null_first) {}
+
+    static bool support_type(PrimitiveType type);
+
+    SlotId slot_id() const { return _slot_id; }
+    PrimitiveType type() const { return _type; }
+    bool is_asc() const { return _is_asc; }
+    bool is_null_first() const { return _is_null_first; }
+
+    // Tightens the threshold to |value| if it ranks before the current one. A null value is ignored, which means
+    // there are less than k non-null values, or the nulls come first.
+    void update(const Datum& value);
+
+    bool has_value() const { return _has_value.load(std::memory_order_acquire); }
+
+    // Only valid after has_value() returns true.
+    Datum value() const;
+
+private:
+    const SlotId _slot_id;
+    const PrimitiveType _type;
+    const bool _is_asc;
+    const bool _is_null_first;
+
+    mutable std::mutex _mutex;
+    Datum _value;
+    std::atomic<bool> _has_value{false};
+};
+
+} // namespace starrocks::vectorized
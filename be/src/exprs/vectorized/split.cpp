@@ -8,6 +8,7 @@
 #include "column/binary_column.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "exprs/vectorized/binary_column_searcher.h"
 #include "exprs/vectorized/string_functions.h"
 
 namespace starrocks::vectorized {
@@ -126,6 +127,34 @@ ColumnPtr StringFunctions::split(FunctionContext* context, const starrocks::vect
             array_offsets->append(offset);
 
             array_binary_column->append_continuous_strings(v);
+        } else if (!columns[0]->is_constant()) {
+            //row_nums * 5 is an estimated value, because the true value cannot be obtained for the time being here
+            array_binary_column->reserve(row_nums * 5, haystack_columns->get_bytes().size());
+            // The delimiters of all the strings are searched at once, the parts before them are appended as they
+            // are found, and the last part of a row once the occurrences go past it.
+            size_t row = 0;
+            uint32_t part_begin = 0;
+            auto finish_row = [&]() {
+                Slice haystack = haystack_columns->get_slice(row);
+                array_binary_column->append(Slice(haystack.data + part_begin, haystack.size - part_begin));
+                array_offsets->append(++offset);
+                part_begin = 0;
+                ++row;
+            };
+            array_offsets->append(offset);
+            search_in_binary_column(*haystack_columns, delimiter, [&](size_t match_row, size_t pos) {
+                while (row < match_row) {
+                    finish_row();
+                }
+                Slice haystack = haystack_columns->get_slice(row);
+                array_binary_column->append(Slice(haystack.data + part_begin, pos - part_begin));
+                ++offset;
+                part_begin = pos + delimiter.size;
+                return true;
+            });
+            while (row < row_nums) {
+                finish_row();
+            }
         } else {
             //row_nums * 5 is an estimated value, because the true value cannot be obtained for the time being here
             array_binary_column->reserve(row_nums * 5, haystack_columns->get_bytes().size());
@@ -6,10 +6,49 @@
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "exprs/vectorized/binary_column_searcher.h"
 #include "exprs/vectorized/string_functions.h"
 
 namespace starrocks::vectorized {
 
+// split_part of a column of strings by a constant delimiter and part number, the delimiters of all the strings
+// are searched at once.
+static ColumnPtr split_part_const_delimiter(const ColumnPtr& haystack_column, const Slice& delimiter,
+                                            int32_t part_number) {
+    const auto* haystack = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(haystack_column.get()));
+    const size_t size = haystack->size();
+    // The number of the delimiters found in each row, at most part_number, and the bounds of the part.
+    std::vector<int32_t> num(size, 0);
+    std::vector<uint32_t> part_begin(size, 0);
+    std::vector<uint32_t> part_end(size, 0);
+    search_in_binary_column(*haystack, delimiter, [&](size_t row, size_t pos) {
+        if (++num[row] == part_number) {
+            part_end[row] = pos;
+            return false;
+        }
+        part_begin[row] = pos + delimiter.size;
+        return true;
+    });
+
+    ColumnBuilder<TYPE_VARCHAR> res(size);
+    for (size_t i = 0; i < size; ++i) {
+        if (haystack_column->is_null(i)) {
+            res.append_null();
+            continue;
+        }
+        Slice str = haystack->get_slice(i);
+        if (num[i] == part_number) {
+            res.append(Slice(str.data + part_begin[i], part_end[i] - part_begin[i]));
+        } else if (num[i] > 0 && num[i] + 1 == part_number) {
+            // the last part, after the last delimiter
+            res.append(Slice(str.data + part_begin[i], str.size - part_begin[i]));
+        } else {
+            res.append_null();
+        }
+    }
+    return res.build(false);
+}
+
 /**
  * @param: [haystack, delimiter, part_number]
  * @paramType: [BinaryColumn, BinaryColumn, IntColumn]
@@ -25,6 +64,12 @@ ColumnPtr StringFunctions::split_part(FunctionContext* context, const starrocks:
         if (part_number <= 0) {
             return ColumnHelper::create_const_null_column(columns[0]->size());
         }
+        if (!columns[0]->is_constant() && columns[1]->is_constant()) {
+            Slice delimiter = ColumnHelper::get_const_value<TYPE_VARCHAR>(columns[1]);
+            if (delimiter.size > 0) {
+                return split_part_const_delimiter(columns[0], delimiter, part_number);
+            }
+        }
     }
 
     ColumnViewer haystack_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
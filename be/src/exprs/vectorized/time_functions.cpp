@@ -7,6 +7,7 @@
 #include "exprs/vectorized/unary_function.h"
 #include "runtime/runtime_state.h"
 #include "udf/udf_internal.h"
+#include "util/timezone_utils.h"
 
 namespace starrocks::vectorized {
 // index as day of week(1: Sunday, 2: Monday....), value as distance of this day and first day(Monday) of this week.
@@ -204,34 +205,19 @@ ColumnPtr TimeFunctions::convert_tz_const(FunctionContext* context, const Column
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_DATETIME> result(size);
+    // the rows of a column are mostly in the same interval between two transitions of the time zones,
+    // where the conversion is an addition
+    TimezoneOffsetCache from_cache(from);
+    TimezoneOffsetCache to_cache(to);
     for (int row = 0; row < size; ++row) {
         if (time_viewer.is_null(row)) {
             result.append_null();
             continue;
         }
 
-        auto datetime_value = time_viewer.value(row);
-
-        int year, month, day, hour, minute, second, usec;
-        datetime_value.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
-        DateTimeValue ts_value(TIME_DATETIME, year, month, day, hour, minute, second, usec);
-
-        int64_t timestamp;
-        // TODO find a better approach to replace datetime_value.unix_timestamp
-        if (!ts_value.unix_timestamp(&timestamp, from)) {
-            result.append_null();
-            continue;
-        }
-        DateTimeValue ts_value2;
-        // TODO find a better approach to replace datetime_value.from_unixtime
-        if (!ts_value2.from_unixtime(timestamp, to)) {
-            result.append_null();
-            continue;
-        }
-
+        int64_t timestamp = from_cache.to_utc(time_viewer.value(row).to_unix_second());
         TimestampValue ts;
-        ts.from_timestamp(ts_value2.year(), ts_value2.month(), ts_value2.day(), ts_value2.hour(), ts_value2.minute(),
-                          ts_value2.second(), 0);
+        ts.from_unix_second(to_cache.to_local(timestamp));
         result.append(ts);
     }
 
@@ -621,26 +607,17 @@ ColumnPtr TimeFunctions::to_unix_from_datetime(FunctionContext* context, const C
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_INT> result(size);
+    TimezoneOffsetCache offset_cache(context->impl()->state()->timezone_obj());
     for (int row = 0; row < size; ++row) {
         if (date_viewer.is_null(row)) {
             result.append_null();
             continue;
         }
 
-        auto date = date_viewer.value(row);
-
-        int year, month, day, hour, minute, second, usec;
-        date.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
-        DateTimeValue tv(TIME_DATETIME, year, month, day, hour, minute, second, usec);
-
-        int64_t timestamp;
-        if (!tv.unix_timestamp(&timestamp, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-        } else {
-            timestamp = timestamp < 0 ? 0 : timestamp;
-            timestamp = timestamp > INT_MAX ? 0 : timestamp;
-            result.append(timestamp);
-        }
+        int64_t timestamp = offset_cache.to_utc(date_viewer.value(row).to_unix_second());
+        timestamp = timestamp < 0 ? 0 : timestamp;
+        timestamp = timestamp > INT_MAX ? 0 : timestamp;
+        result.append(timestamp);
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -656,26 +633,18 @@ ColumnPtr TimeFunctions::to_unix_from_date(FunctionContext* context, const Colum
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_INT> result(size);
+    TimezoneOffsetCache offset_cache(context->impl()->state()->timezone_obj());
     for (int row = 0; row < size; ++row) {
         if (date_viewer.is_null(row)) {
             result.append_null();
             continue;
         }
 
-        auto date = date_viewer.value(row);
-
-        int year, month, day;
-        date.to_date(&year, &month, &day);
-        DateTimeValue tv(TIME_DATE, year, month, day, 0, 0, 0, 0);
-
-        int64_t timestamp;
-        if (!tv.unix_timestamp(&timestamp, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-        } else {
-            timestamp = timestamp < 0 ? 0 : timestamp;
-            timestamp = timestamp > INT_MAX ? 0 : timestamp;
-            result.append(timestamp);
-        }
+        TimestampValue date = date_viewer.value(row);
+        int64_t timestamp = offset_cache.to_utc(date.to_unix_second());
+        timestamp = timestamp < 0 ? 0 : timestamp;
+        timestamp = timestamp > INT_MAX ? 0 : timestamp;
+        result.append(timestamp);
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -743,6 +712,7 @@ ColumnPtr TimeFunctions::from_unix_to_datetime(FunctionContext* context, const C
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
+    TimezoneOffsetCache offset_cache(context->impl()->state()->timezone_obj());
     for (int row = 0; row < size; ++row) {
         if (data_column.is_null(row)) {
             result.append_null();
@@ -755,14 +725,11 @@ ColumnPtr TimeFunctions::from_unix_to_datetime(FunctionContext* context, const C
             continue;
         }
 
-        DateTimeValue dtv;
-        if (!dtv.from_unixtime(date, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-            continue;
-        }
+        TimestampValue ts;
+        ts.from_unix_second(offset_cache.to_local(date));
         char buf[64];
-        dtv.to_string(buf);
-        result.append(Slice(buf));
+        int len = ts.to_string(buf, sizeof(buf));
+        result.append(Slice(buf, len));
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -833,6 +800,15 @@ Status TimeFunctions::from_unix_close(starrocks_udf::FunctionContext* context,
     return Status::OK();
 }
 
+// The civil time of the unix seconds in the time zone of `offset_cache`.
+static DateTimeValue from_unix_with_cache(TimezoneOffsetCache* offset_cache, int64_t unix_second) {
+    TimestampValue ts;
+    ts.from_unix_second(offset_cache->to_local(unix_second));
+    int year, month, day, hour, minute, second, usec;
+    ts.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
+    return DateTimeValue(TIME_DATETIME, year, month, day, hour, minute, second, 0);
+}
+
 ColumnPtr TimeFunctions::from_unix_with_format_general(FunctionContext* context, const Columns& columns) {
     DCHECK_EQ(columns.size(), 2);
 
@@ -843,6 +819,7 @@ ColumnPtr TimeFunctions::from_unix_with_format_general(FunctionContext* context,
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
+    TimezoneOffsetCache offset_cache(context->impl()->state()->timezone_obj());
     for (int row = 0; row < size; ++row) {
         if (data_column.is_null(row) || format_column.is_null(row)) {
             result.append_null();
@@ -856,11 +833,7 @@ ColumnPtr TimeFunctions::from_unix_with_format_general(FunctionContext* context,
             continue;
         }
 
-        DateTimeValue dtv;
-        if (!dtv.from_unixtime(date, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-            continue;
-        }
+        DateTimeValue dtv = from_unix_with_cache(&offset_cache, date);
         // use lambda to avoid adding method for TimeFunctions.
         if (format.size > DEFAULT_DATE_FORMAT_LIMIT) {
             result.append_null();
@@ -890,6 +863,7 @@ ColumnPtr TimeFunctions::from_unix_with_format_const(std::string& format_content
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
+    TimezoneOffsetCache offset_cache(context->impl()->state()->timezone_obj());
     for (int row = 0; row < size; ++row) {
         if (data_column.is_null(row) || format_content.empty()) {
             result.append_null();
@@ -902,11 +876,7 @@ ColumnPtr TimeFunctions::from_unix_with_format_const(std::string& format_content
             continue;
         }
 
-        DateTimeValue dtv;
-        if (!dtv.from_unixtime(date, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-            continue;
-        }
+        DateTimeValue dtv = from_unix_with_cache(&offset_cache, date);
 
         char buf[128];
         if (!dtv.to_format_string((const char*)format_content.c_str(), format_content.size(), buf)) {
@@ -2,8 +2,23 @@
 
 #include "formats/csv/csv_reader.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace starrocks::vectorized {
 
+#ifdef __SSE2__
+// Returns the bitmask of the bytes equal to |c| in the 64 bytes starting at |data|.
+static inline uint64_t find_char_mask64(const char* data, const __m128i& c) {
+    auto mask16 = [&](size_t offset) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, c))));
+    };
+    return mask16(0) | (mask16(16) << 16u) | (mask16(32) << 32u) | (mask16(48) << 48u);
+}
+#endif
+
 Status CSVReader::next_record(Record* record) {
     if (_limit > 0 && _parsed_bytes > _limit) {
         return Status::EndOfFile("Reached limit");
@@ -47,8 +62,23 @@ void CSVReader::split_record(const Record& record, Fields* fields) const {
     const size_t size = record.size;
 
     if (_field_delimiter.size() == 1) {
-        for (size_t i = 0; i < size; ++i, ++ptr) {
-            if (*ptr == _field_delimiter[0]) {
+        const char delimiter = _field_delimiter[0];
+        const char* const end = record.data + size;
+#ifdef __SSE2__
+        // Cut the fields at the set bits of the delimiter bitmask of every 64 bytes.
+        const __m128i delimiter16 = _mm_set1_epi8(delimiter);
+        for (; ptr + 64 <= end; ptr += 64) {
+            uint64_t mask = find_char_mask64(ptr, delimiter16);
+            while (mask != 0) {
+                const char* d = ptr + __builtin_ctzll(mask);
+                fields->emplace_back(value, d - value);
+                value = d + 1;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; ptr < end; ++ptr) {
+            if (*ptr == delimiter) {
                 fields->emplace_back(value, ptr - value);
                 value = ptr + 1;
             }
@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "http/action/column_access_action.h"
+
+#include <string>
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "storage/olap_define.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+#include "util/json_util.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+
+Status ColumnAccessAction::_handle_show_column_access(HttpRequest* req, std::string* json_result) {
+    const std::string& req_tablet_id = req->param(TABLET_ID_KEY);
+    if (req_tablet_id.empty()) {
+        return Status::InvalidArgument("Missing parameter tablet_id");
+    }
+
+    uint64_t tablet_id;
+    try {
+        tablet_id = std::stoull(req_tablet_id);
+    } catch (const std::exception& e) {
+        LOG(WARNING) << "invalid argument.tablet_id:" << req_tablet_id;
+        return Status::InvalidArgument(strings::Substitute("convert failed, $0", e.what()));
+    }
+
+    TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id);
+    if (tablet == nullptr) {
+        return Status::NotFound("Tablet not found");
+    }
+
+    tablet->get_column_access_status(json_result);
+    return Status::OK();
+}
+
+void ColumnAccessAction::handle(HttpRequest* req) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    std::string json_result;
+    Status st = _handle_show_column_access(req, &json_result);
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::OK, to_json(st));
+    } else {
+        HttpChannel::send_reply(req, HttpStatus::OK, json_result);
+    }
+}
+
+} // namespace starrocks
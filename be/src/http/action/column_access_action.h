@@ -0,0 +1,24 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "common/status.h"
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// This action shows how the queries access the columns of a tablet: how many scans read each column, filter by it
+// with which forms of predicates and group by it, to choose the sort keys, the indexes and the columns to keep hot.
+// Usage: GET /api/column_access/show?tablet_id=<tablet_id>
+class ColumnAccessAction : public HttpHandler {
+public:
+    ColumnAccessAction() = default;
+    ~ColumnAccessAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    Status _handle_show_column_access(HttpRequest* req, std::string* json_result);
+};
+
+} // namespace starrocks
@@ -0,0 +1,195 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "http/action/memory_stats_action.h"
+
+#include <gperftools/malloc_extension.h>
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gutil/strings/substitute.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/segment_footer_cache.h"
+#include "util/json_util.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string TOPN_KEY = "topn";
+static constexpr size_t kDefaultTopN = 10;
+
+static rapidjson::Value to_json_value(const MemTracker::SimpleItem& item, rapidjson::Document::AllocatorType& alloc) {
+    rapidjson::Value value;
+    value.SetObject();
+    rapidjson::Value label;
+    label.SetString(item.label.c_str(), item.label.length(), alloc);
+    value.AddMember("label", label, alloc);
+    value.AddMember("current_bytes", item.cur_consumption, alloc);
+    value.AddMember("peak_bytes", item.peak_consumption, alloc);
+    value.AddMember("limit", item.limit, alloc);
+    return value;
+}
+
+// The subsystems tracked by |tracker| and their children, e.g. the index cache of the update manager.
+static void add_subsystem(MemTracker* tracker, rapidjson::Value* subsystems,
+                          rapidjson::Document::AllocatorType& alloc) {
+    if (tracker == nullptr) {
+        return;
+    }
+    std::vector<MemTracker::SimpleItem> items;
+    tracker->list_mem_usage(&items, 0, 1);
+    rapidjson::Value value = to_json_value(items[0], alloc);
+    rapidjson::Value children;
+    children.SetArray();
+    // the children of the query pool and the load are the queries and the loads, listed by the top n instead
+    if (tracker != ExecEnv::GetInstance()->query_pool_mem_tracker() &&
+        tracker != ExecEnv::GetInstance()->load_mem_tracker()) {
+        for (size_t i = 1; i < items.size(); i++) {
+            children.PushBack(to_json_value(items[i], alloc), alloc);
+        }
+    }
+    value.AddMember("children", children, alloc);
+    subsystems->PushBack(value, alloc);
+}
+
+// The children of |tracker| that consume the most memory.
+static rapidjson::Value top_consumers(MemTracker* tracker, size_t topn, rapidjson::Document::AllocatorType& alloc) {
+    rapidjson::Value consumers;
+    consumers.SetArray();
+    if (tracker == nullptr) {
+        return consumers;
+    }
+    std::vector<MemTracker::SimpleItem> items;
+    tracker->list_mem_usage(&items, 0, 1);
+    items.erase(items.begin());
+    size_t n = std::min(topn, items.size());
+    std::partial_sort(items.begin(), items.begin() + n, items.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.cur_consumption > rhs.cur_consumption; });
+    for (size_t i = 0; i < n; i++) {
+        consumers.PushBack(to_json_value(items[i], alloc), alloc);
+    }
+    return consumers;
+}
+
+static void add_cache(const char* name, size_t memory_usage, size_t capacity, rapidjson::Value* caches,
+                      rapidjson::Document::AllocatorType& alloc) {
+    rapidjson::Value value;
+    value.SetObject();
+    value.AddMember("name", rapidjson::StringRef(name), alloc);
+    value.AddMember("current_bytes", memory_usage, alloc);
+    value.AddMember("capacity", capacity, alloc);
+    caches->PushBack(value, alloc);
+}
+
+static rapidjson::Value allocator_stats(rapidjson::Document::AllocatorType& alloc) {
+    rapidjson::Value value;
+    value.SetObject();
+#if defined(ADDRESS_SANITIZER) || defined(LEAK_SANITIZER) || defined(THREAD_SANITIZER)
+    value.AddMember("name", "none", alloc);
+#else
+    value.AddMember("name", "tcmalloc", alloc);
+    MallocExtension* ext = MallocExtension::instance();
+    size_t allocated_bytes = 0;
+    size_t heap_size = 0;
+    size_t pageheap_free_bytes = 0;
+    size_t pageheap_unmapped_bytes = 0;
+    size_t thread_cache_bytes = 0;
+    size_t central_cache_free_bytes = 0;
+    size_t transfer_cache_free_bytes = 0;
+    (void)ext->GetNumericProperty("generic.current_allocated_bytes", &allocated_bytes);
+    (void)ext->GetNumericProperty("generic.heap_size", &heap_size);
+    (void)ext->GetNumericProperty("tcmalloc.pageheap_free_bytes", &pageheap_free_bytes);
+    (void)ext->GetNumericProperty("tcmalloc.pageheap_unmapped_bytes", &pageheap_unmapped_bytes);
+    (void)ext->GetNumericProperty("tcmalloc.current_total_thread_cache_bytes", &thread_cache_bytes);
+    (void)ext->GetNumericProperty("tcmalloc.central_cache_free_bytes", &central_cache_free_bytes);
+    (void)ext->GetNumericProperty("tcmalloc.transfer_cache_free_bytes", &transfer_cache_free_bytes);
+    // the memory mapped by the allocator but not allocated by the process, in the free pages and the caches
+    size_t mapped_bytes = heap_size - std::min(heap_size, pageheap_unmapped_bytes);
+    size_t fragmentation_bytes = mapped_bytes - std::min(mapped_bytes, allocated_bytes);
+    value.AddMember("allocated_bytes", allocated_bytes, alloc);
+    value.AddMember("heap_size", heap_size, alloc);
+    value.AddMember("pageheap_free_bytes", pageheap_free_bytes, alloc);
+    value.AddMember("pageheap_unmapped_bytes", pageheap_unmapped_bytes, alloc);
+    value.AddMember("thread_cache_bytes", thread_cache_bytes, alloc);
+    value.AddMember("central_cache_free_bytes", central_cache_free_bytes, alloc);
+    value.AddMember("transfer_cache_free_bytes", transfer_cache_free_bytes, alloc);
+    value.AddMember("fragmentation_bytes", fragmentation_bytes, alloc);
+    value.AddMember("fragmentation_ratio",
+                    mapped_bytes > 0 ? static_cast<double>(fragmentation_bytes) / mapped_bytes : 0.0, alloc);
+#endif
+    return value;
+}
+
+Status MemoryStatsAction::_handle_memory_stats(HttpRequest* req, std::string* json_result) {
+    size_t topn = kDefaultTopN;
+    const std::string& req_topn = req->param(TOPN_KEY);
+    if (!req_topn.empty()) {
+        try {
+            topn = std::stoull(req_topn);
+        } catch (const std::exception& e) {
+            return Status::InvalidArgument(strings::Substitute("Invalid parameter topn $0: $1", req_topn, e.what()));
+        }
+    }
+
+    ExecEnv* env = ExecEnv::GetInstance();
+    rapidjson::Document root;
+    root.SetObject();
+    auto& alloc = root.GetAllocator();
+
+    rapidjson::Value subsystems;
+    subsystems.SetArray();
+    // the tablet meta includes the metadata and the indexes of the opened segments
+    for (MemTracker* tracker :
+         {env->process_mem_tracker(), env->query_pool_mem_tracker(), env->load_mem_tracker(),
+          env->tablet_meta_mem_tracker(), env->compaction_mem_tracker(), env->schema_change_mem_tracker(),
+          env->column_pool_mem_tracker(), env->page_cache_mem_tracker(), env->update_mem_tracker(),
+          env->chunk_allocator_mem_tracker(), env->clone_mem_tracker(), env->consistency_mem_tracker()}) {
+        add_subsystem(tracker, &subsystems, alloc);
+    }
+    root.AddMember("subsystems", subsystems, alloc);
+
+    rapidjson::Value caches;
+    caches.SetArray();
+    if (StoragePageCache::instance() != nullptr) {
+        add_cache("page_cache", StoragePageCache::instance()->memory_usage(), StoragePageCache::instance()->capacity(),
+                  &caches, alloc);
+    }
+    if (SegmentFooterCache::instance() != nullptr) {
+        add_cache("segment_footer_cache", SegmentFooterCache::instance()->memory_usage(),
+                  SegmentFooterCache::instance()->capacity(), &caches, alloc);
+    }
+    root.AddMember("caches", caches, alloc);
+
+    root.AddMember("top_queries", top_consumers(env->query_pool_mem_tracker(), topn, alloc), alloc);
+    root.AddMember("top_loads", top_consumers(env->load_mem_tracker(), topn, alloc), alloc);
+    root.AddMember("allocator", allocator_stats(alloc), alloc);
+
+    rapidjson::StringBuffer strbuf;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
+    root.Accept(writer);
+    *json_result = std::string(strbuf.GetString());
+    return Status::OK();
+}
+
+void MemoryStatsAction::handle(HttpRequest* req) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    std::string json_result;
+    Status st = _handle_memory_stats(req, &json_result);
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::OK, to_json(st));
+    } else {
+        HttpChannel::send_reply(req, HttpStatus::OK, json_result);
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,25 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "common/status.h"
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// This action breaks down the memory of the process: the current and the peak bytes of each subsystem and cache, the
+// queries and the loads that use the most memory, and the memory the allocator holds but the process doesn't use, to
+// size the caches and the limits by data.
+// Usage: GET /api/memory_stats[?topn=<number of the queries and the loads, 10 by default>]
+class MemoryStatsAction : public HttpHandler {
+public:
+    MemoryStatsAction() = default;
+    ~MemoryStatsAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    Status _handle_memory_stats(HttpRequest* req, std::string* json_result);
+};
+
+} // namespace starrocks
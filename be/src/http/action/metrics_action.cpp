@@ -26,6 +26,7 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <array>
 #include <string>
 
 #include "http/http_channel.h"
@@ -45,6 +46,8 @@ public:
 
 private:
     void _visit_simple_metric(const std::string& name, const MetricLabels& labels, Metric* metric);
+    void _visit_histogram_metric(const std::string& name, const MetricLabels& labels, HistogramMetric* metric);
+    void _write_labels(const MetricLabels& labels, const std::string& le = std::string());
 
 private:
     std::stringstream _ss;
@@ -97,6 +100,11 @@ void PrometheusMetricsVisitor::visit(const std::string& prefix, const std::strin
             _visit_simple_metric(metric_name, it.first, (Metric*)it.second);
         }
         break;
+    case MetricType::HISTOGRAM:
+        for (auto& it : collector->metrics()) {
+            _visit_histogram_metric(metric_name, it.first, static_cast<HistogramMetric*>(it.second));
+        }
+        break;
     default:
         break;
     }
@@ -105,19 +113,56 @@ void PrometheusMetricsVisitor::visit(const std::string& prefix, const std::strin
 void PrometheusMetricsVisitor::_visit_simple_metric(const std::string& name, const MetricLabels& labels,
                                                     Metric* metric) {
     _ss << name;
-    // labels
-    if (!labels.empty()) {
-        _ss << "{";
-        int i = 0;
-        for (auto& label : labels.labels) {
-            if (i++ > 0) {
-                _ss << ",";
-            }
-            _ss << label.name << "=\"" << label.value << "\"";
+    _write_labels(labels);
+    _ss << " " << metric->to_string() << "\n";
+}
+
+// eg:
+// starrocks_be_page_read_latency_us_bucket{path="/data",le="1"} 0
+// ...
+// starrocks_be_page_read_latency_us_bucket{path="/data",le="+Inf"} 1024
+// starrocks_be_page_read_latency_us_sum{path="/data"} 204800
+// starrocks_be_page_read_latency_us_count{path="/data"} 1024
+void PrometheusMetricsVisitor::_visit_histogram_metric(const std::string& name, const MetricLabels& labels,
+                                                       HistogramMetric* metric) {
+    std::array<int64_t, HistogramMetric::kNumBuckets> counts;
+    metric->bucket_counts(&counts);
+    // the buckets of prometheus are cumulative
+    int64_t cumulative = 0;
+    for (int i = 0; i < HistogramMetric::kNumBuckets; ++i) {
+        cumulative += counts[i];
+        _ss << name << "_bucket";
+        _write_labels(labels, i + 1 < HistogramMetric::kNumBuckets ? std::to_string(HistogramMetric::bucket_bound(i))
+                                                                   : "+Inf");
+        _ss << " " << cumulative << "\n";
+    }
+    _ss << name << "_sum";
+    _write_labels(labels);
+    _ss << " " << metric->sum() << "\n";
+    _ss << name << "_count";
+    _write_labels(labels);
+    _ss << " " << cumulative << "\n";
+}
+
+void PrometheusMetricsVisitor::_write_labels(const MetricLabels& labels, const std::string& le) {
+    if (labels.empty() && le.empty()) {
+        return;
+    }
+    _ss << "{";
+    int i = 0;
+    for (auto& label : labels.labels) {
+        if (i++ > 0) {
+            _ss << ",";
         }
-        _ss << "}";
+        _ss << label.name << "=\"" << label.value << "\"";
     }
-    _ss << " " << metric->to_string() << "\n";
+    if (!le.empty()) {
+        if (i > 0) {
+            _ss << ",";
+        }
+        _ss << "le=\"" << le << "\"";
+    }
+    _ss << "}";
 }
 
 void SimpleCoreMetricsVisitor::visit(const std::string& prefix, const std::string& name, MetricCollector* collector) {
@@ -168,6 +213,7 @@ void JsonMetricsVisitor::visit(const std::string& prefix, const std::string& nam
     switch (collector->type()) {
     case MetricType::COUNTER:
     case MetricType::GAUGE:
+    case MetricType::HISTOGRAM:
         for (auto& it : collector->metrics()) {
             const MetricLabels& labels = it.first;
             Metric* metric = reinterpret_cast<Metric*>(it.second);
@@ -38,12 +38,14 @@
 #include "http/http_headers.h"
 #include "http/http_request.h"
 #include "http/http_response.h"
+#include "runtime/sampling_profiler.h"
 #include "util/bfd_parser.h"
 
 namespace starrocks {
 
 // pprof default sample time in seconds.
 static const std::string SECOND_KEY = "seconds";
+static const std::string QUERY_ID_KEY = "query_id";
 static const int kPprofDefaultSampleSecs = 30;
 
 // Protect, only one thread can work
@@ -185,4 +187,37 @@ void SymbolAction::handle(HttpRequest* req) {
     }
 }
 
+void QueryProfileAction::handle(HttpRequest* req) {
+    auto* profiler = SamplingProfiler::instance();
+    if (!profiler->is_enabled()) {
+        HttpChannel::send_reply(req, "Query sampling profiler is disabled, see query_sampling_profiler_frequency.");
+        return;
+    }
+
+    const std::string& query_id_str = req->param(QUERY_ID_KEY);
+    if (query_id_str.empty()) {
+        std::string result;
+        for (const auto& query_id : profiler->list_queries()) {
+            result.append(query_id.to_string());
+            result.push_back('\n');
+        }
+        HttpChannel::send_reply(req, result);
+        return;
+    }
+
+    size_t pos = query_id_str.find('-');
+    if (pos == std::string::npos) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, "Invalid query_id, it should be <hi>-<lo>.");
+        return;
+    }
+    UniqueId query_id(query_id_str.substr(0, pos), query_id_str.substr(pos + 1));
+    std::string result;
+    Status st = profiler->dump_folded_stacks(query_id, _parser, &result);
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::NOT_FOUND, st.to_string());
+        return;
+    }
+    HttpChannel::send_reply(req, result);
+}
+
 } // namespace starrocks
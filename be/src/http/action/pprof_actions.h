@@ -84,4 +84,17 @@ private:
     BfdParser* _parser;
 };
 
+// Lists the queries sampled by the SamplingProfiler, or with ?query_id=<hi>-<lo> returns the samples of the query in
+// the folded format of the flame graphs, one "<frames separated by ;> <samples>" line per distinct stack.
+class QueryProfileAction : public HttpHandler {
+public:
+    QueryProfileAction(BfdParser* parser) : _parser(parser) {}
+    ~QueryProfileAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    BfdParser* _parser;
+};
+
 } // namespace starrocks
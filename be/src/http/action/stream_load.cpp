@@ -21,6 +21,7 @@
 
 #include "http/action/stream_load.h"
 
+#include <algorithm>
 #include <deque>
 #include <future>
 #include <sstream>
@@ -287,6 +288,10 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
     return _process_put(http_req, ctx);
 }
 
+// The body received so far is moved into a single buffer of at most this size, rather than one of 4KB per
+// evbuffer_remove, which cuts the allocations and the hand-overs to the pipe.
+static constexpr size_t kMaxBodyBufferSize = 1024 * 1024;
+
 void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     StreamLoadContext* ctx = (StreamLoadContext*)req->handler_ctx();
     if (ctx == nullptr || !ctx->status.ok()) {
@@ -299,8 +304,9 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     auto evbuf = evhttp_request_get_input_buffer(ev_req);
 
     int64_t start_read_data_time = MonotonicNanos();
-    while (evbuffer_get_length(evbuf) > 0) {
-        ByteBufferPtr bb = ByteBuffer::allocate(4096);
+    size_t length;
+    while ((length = evbuffer_get_length(evbuf)) > 0) {
+        ByteBufferPtr bb = ByteBuffer::allocate(std::min(length, kMaxBodyBufferSize));
         int remove_bytes;
         {
             // The memory is applied for in http server thread,
@@ -172,7 +172,7 @@ Status HttpClient::execute(const std::function<bool(const void* data, size_t len
     return Status::OK();
 }
 
-Status HttpClient::download(const std::string& local_path) {
+Status HttpClient::download(const std::string& local_path, uint64_t offset) {
     // set method to GET
     set_method(GET);
 
@@ -182,8 +182,13 @@ Status HttpClient::download(const std::string& local_path) {
     curl_easy_setopt(_curl, CURLOPT_LOW_SPEED_TIME, config::download_low_speed_time);
     curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, config::max_download_speed_kbps * 1024);
 
+    if (offset > 0) {
+        // fails with CURLE_RANGE_ERROR if the server doesn't support the ranges
+        curl_easy_setopt(_curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(offset));
+    }
+
     auto fp_closer = [](FILE* fp) { fclose(fp); };
-    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), "w"), fp_closer);
+    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), offset > 0 ? "a" : "w"), fp_closer);
     if (fp == nullptr) {
         LOG(WARNING) << "open file failed, file=" << local_path;
         return Status::InternalError("open file failed");
@@ -110,8 +110,9 @@ public:
     }
 
     // helper function to download a file, you can call this function to downlaod
-    // a file to local_path
-    Status download(const std::string& local_path);
+    // a file to local_path. if |offset| > 0, the file is downloaded from |offset|, appended to local_path which
+    // must have |offset| bytes, and the server must support the Range header.
+    Status download(const std::string& local_path, uint64_t offset = 0);
 
     Status execute_post_request(const std::string& payload, std::string* response);
 
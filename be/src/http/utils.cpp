@@ -24,6 +24,9 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "common/logging.h"
 #include "common/status.h"
 #include "common/utils.h"
@@ -138,13 +141,24 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
     int64_t file_size = st.st_size;
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
+    // a single range "bytes=<first>-[<last>]" is supported, e.g. to resume a download
+    int64_t offset = 0;
+    int64_t length = file_size;
+    bool ranged = false;
     const std::string& range_header = req->header(HttpHeaders::RANGE);
-    if (!range_header.empty()) {
-        // analyse range header
+    if (!range_header.empty() && req->method() != HttpMethod::HEAD) {
+        if (!parse_byte_range(range_header, file_size, &offset, &length)) {
+            close(fd);
+            LOG(WARNING) << "Unsatisfiable range '" << range_header << "' of file: " << file_path;
+            req->add_output_header(HttpHeaders::CONTENT_RANGE, ("bytes */" + std::to_string(file_size)).c_str());
+            HttpChannel::send_error(req, HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+            return;
+        }
+        ranged = true;
     }
 
     req->add_output_header(HttpHeaders::CONTENT_TYPE, get_content_type(file_path).c_str());
+    req->add_output_header(HttpHeaders::ACCEPT_RANGES, "bytes");
 
     if (req->method() == HttpMethod::HEAD) {
         close(fd);
@@ -153,9 +167,47 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
         return;
     }
 
+    if (ranged) {
+        std::string content_range = "bytes " + std::to_string(offset) + "-" + std::to_string(offset + length - 1) +
+                                    "/" + std::to_string(file_size);
+        req->add_output_header(HttpHeaders::CONTENT_RANGE, content_range.c_str());
+        HttpChannel::send_file(req, fd, offset, length, HttpStatus::PARTIAL_CONTENT);
+        return;
+    }
     HttpChannel::send_file(req, fd, 0, file_size);
 }
 
+bool parse_byte_range(const std::string& range, int64_t file_size, int64_t* offset, int64_t* length) {
+    const std::string prefix = "bytes=";
+    if (range.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    std::string spec = range.substr(prefix.size());
+    size_t dash = spec.find('-');
+    // the suffix ranges "-<n>" and the multiple ranges are not supported
+    if (dash == std::string::npos || dash == 0 || spec.find(',') != std::string::npos) {
+        return false;
+    }
+    char* end = nullptr;
+    std::string first_str = spec.substr(0, dash);
+    int64_t first = strtoll(first_str.c_str(), &end, 10);
+    if (*end != '\0' || first < 0 || first >= file_size) {
+        return false;
+    }
+    int64_t last = file_size - 1;
+    std::string last_str = spec.substr(dash + 1);
+    if (!last_str.empty()) {
+        last = strtoll(last_str.c_str(), &end, 10);
+        if (*end != '\0' || last < first) {
+            return false;
+        }
+        last = std::min(last, file_size - 1);
+    }
+    *offset = first;
+    *length = last - first + 1;
+    return true;
+}
+
 void do_dir_response(const std::string& dir_path, HttpRequest* req) {
     std::vector<std::string> files;
     Status status = FileUtils::list_files(Env::Default(), dir_path, &files);
@@ -41,6 +41,10 @@ bool parse_basic_auth(const HttpRequest& req, AuthInfo* auth);
 
 void do_file_response(const std::string& dir_path, HttpRequest* req);
 
+// Parse the Range header |range| of a file of |file_size| bytes, only a single range "bytes=<first>-[<last>]" is
+// supported. Returns false if the range is malformed or unsatisfiable.
+bool parse_byte_range(const std::string& range, int64_t file_size, int64_t* offset, int64_t* length);
+
 void do_dir_response(const std::string& dir_path, HttpRequest* req);
 
 std::string get_content_type(const std::string& file_name);
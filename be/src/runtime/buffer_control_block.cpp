@@ -23,6 +23,7 @@
 
 #include <utility>
 
+#include "exec/pipeline/pipeline_driver_poller.h"
 #include "gen_cpp/InternalService_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/raw_value.h"
@@ -181,6 +182,8 @@ Status BufferControlBlock::get_batch(TFetchDataResult* result) {
         _batch_queue.pop_front();
         _buffer_rows -= item->result_batch.rows.size();
         _data_removal.notify_one();
+        // The result sink operator blocked by the full buffer may be ready now.
+        pipeline::notify_blocked_drivers();
     }
     swap(*result, *item);
     result->__set_packet_num(_packet_num);
@@ -208,6 +211,7 @@ void BufferControlBlock::get_batch(GetResultBatchCtx* ctx) {
         _batch_queue.pop_front();
         _buffer_rows -= result->result_batch.rows.size();
         _data_removal.notify_one();
+        pipeline::notify_blocked_drivers();
 
         ctx->on_data(result, _packet_num);
         _packet_num++;
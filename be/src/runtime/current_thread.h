@@ -4,6 +4,7 @@
 
 #include <string>
 
+#include "common/config.h"
 #include "gen_cpp/Types_types.h"
 #include "gutil/macros.h"
 #include "runtime/exec_env.h"
@@ -21,6 +22,23 @@
 #define SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(check) \
     auto VARNAME_LINENUM(check_setter) = CurrentThreadCheckMemLimitSetter(check)
 
+// Adds the bytes allocated by the current thread in the scope to the RuntimeProfile::Counter |counter|.
+#define SCOPED_THREAD_LOCAL_ALLOCATION_COUNTER(counter) \
+    auto VARNAME_LINENUM(allocation_counter) = CurrentThreadAllocationCounter(counter)
+
+// Like SCOPED_THREAD_LOCAL_ALLOCATION_COUNTER, and also adds the bytes allocated minus the bytes freed in the scope
+// to the RuntimeProfile::HighWaterMarkCounter |peak_counter|, whose value becomes the peak memory of the code.
+#define SCOPED_THREAD_LOCAL_ALLOCATION_AND_PEAK_COUNTER(counter, peak_counter) \
+    auto VARNAME_LINENUM(allocation_counter) = CurrentThreadAllocationCounter(counter, peak_counter)
+
+// Sets the query and the fragment instance of ThreadExecContext for the scope.
+#define SCOPED_THREAD_LOCAL_EXEC_CONTEXT_SETTER(query_id, fragment_instance_id) \
+    auto VARNAME_LINENUM(exec_context_setter) = CurrentThreadExecContextSetter(query_id, fragment_instance_id)
+
+// Sets the plan node of ThreadExecContext for the scope.
+#define SCOPED_THREAD_LOCAL_PLAN_NODE_SETTER(plan_node_id) \
+    auto VARNAME_LINENUM(plan_node_setter) = CurrentThreadPlanNodeSetter(plan_node_id)
+
 #define CHECK_MEM_LIMIT(err_msg)                                                     \
     do {                                                                             \
         if (tls_thread_status.check_mem_limit()) {                                   \
@@ -36,6 +54,19 @@ inline thread_local MemTracker* tls_mem_tracker = nullptr;
 inline thread_local MemTracker* tls_exceed_mem_tracker = nullptr;
 inline thread_local bool tls_is_thread_status_init = false;
 
+// The query, the fragment instance and the plan node the thread works for, zero if it works for no query. The
+// SamplingProfiler reads it in its signal handler to tag the samples, which is why it's a trivial thread local of its
+// own rather than a part of CurrentThread.
+struct ThreadExecContext {
+    int64_t query_id_hi = 0;
+    int64_t query_id_lo = 0;
+    int64_t fragment_instance_id_hi = 0;
+    int64_t fragment_instance_id_lo = 0;
+    int32_t plan_node_id = -1;
+};
+
+inline thread_local ThreadExecContext tls_exec_context;
+
 class CurrentThread {
 public:
     CurrentThread() { tls_is_thread_status_init = true; }
@@ -89,7 +120,8 @@ public:
     void mem_consume(int64_t size) {
         MemTracker* cur_tracker = mem_tracker();
         _cache_size += size;
-        if (cur_tracker != nullptr && _cache_size >= BATCH_SIZE) {
+        _allocated_bytes += size;
+        if (cur_tracker != nullptr && _cache_size >= batch_size()) {
             cur_tracker->consume(_cache_size);
             _cache_size = 0;
         }
@@ -98,10 +130,11 @@ public:
     bool try_mem_consume(int64_t size) {
         MemTracker* cur_tracker = mem_tracker();
         _cache_size += size;
-        if (cur_tracker != nullptr && _cache_size >= BATCH_SIZE) {
+        if (cur_tracker != nullptr && _cache_size >= batch_size()) {
             MemTracker* limit_tracker = cur_tracker->try_consume(_cache_size);
             if (LIKELY(limit_tracker == nullptr)) {
                 _cache_size = 0;
+                _allocated_bytes += size;
                 return true;
             } else {
                 _cache_size -= size;
@@ -109,6 +142,7 @@ public:
                 return false;
             }
         }
+        _allocated_bytes += size;
         return true;
     }
 
@@ -135,7 +169,8 @@ public:
     void mem_release(int64_t size) {
         MemTracker* cur_tracker = mem_tracker();
         _cache_size -= size;
-        if (cur_tracker != nullptr && _cache_size <= -BATCH_SIZE) {
+        _freed_bytes += size;
+        if (cur_tracker != nullptr && _cache_size <= -batch_size()) {
             cur_tracker->release(-_cache_size);
             _cache_size = 0;
         }
@@ -148,10 +183,19 @@ public:
         }
     }
 
+    // The bytes allocated by the thread since it started, which only grows: the allocations of a piece of code
+    // are the difference of it before and after, see CurrentThreadAllocationCounter.
+    int64_t allocated_bytes() const { return _allocated_bytes; }
+    // The bytes freed by the thread since it started, which only grows as well.
+    int64_t freed_bytes() const { return _freed_bytes; }
+
 private:
-    const static int64_t BATCH_SIZE = 2 * 1024 * 1024;
+    static int64_t batch_size() { return config::thread_mem_tracker_batch_bytes; }
 
+    // the bytes not flushed to the mem tracker yet, negative if more are released than consumed
     int64_t _cache_size = 0;
+    int64_t _allocated_bytes = 0;
+    int64_t _freed_bytes = 0;
     TUniqueId _query_id;
     bool _is_catched = false;
     bool _check = true;
@@ -193,6 +237,78 @@ private:
     bool _prev_check;
 };
 
+class CurrentThreadExecContextSetter {
+public:
+    CurrentThreadExecContextSetter(const TUniqueId& query_id, const TUniqueId& fragment_instance_id)
+            : _prev_context(tls_exec_context) {
+        tls_exec_context.query_id_hi = query_id.hi;
+        tls_exec_context.query_id_lo = query_id.lo;
+        tls_exec_context.fragment_instance_id_hi = fragment_instance_id.hi;
+        tls_exec_context.fragment_instance_id_lo = fragment_instance_id.lo;
+        tls_exec_context.plan_node_id = -1;
+    }
+
+    ~CurrentThreadExecContextSetter() { tls_exec_context = _prev_context; }
+
+    CurrentThreadExecContextSetter(const CurrentThreadExecContextSetter&) = delete;
+    void operator=(const CurrentThreadExecContextSetter&) = delete;
+    CurrentThreadExecContextSetter(CurrentThreadExecContextSetter&&) = delete;
+    void operator=(CurrentThreadExecContextSetter&&) = delete;
+
+private:
+    ThreadExecContext _prev_context;
+};
+
+class CurrentThreadPlanNodeSetter {
+public:
+    explicit CurrentThreadPlanNodeSetter(int32_t plan_node_id) : _prev_plan_node_id(tls_exec_context.plan_node_id) {
+        tls_exec_context.plan_node_id = plan_node_id;
+    }
+
+    ~CurrentThreadPlanNodeSetter() { tls_exec_context.plan_node_id = _prev_plan_node_id; }
+
+    CurrentThreadPlanNodeSetter(const CurrentThreadPlanNodeSetter&) = delete;
+    void operator=(const CurrentThreadPlanNodeSetter&) = delete;
+    CurrentThreadPlanNodeSetter(CurrentThreadPlanNodeSetter&&) = delete;
+    void operator=(CurrentThreadPlanNodeSetter&&) = delete;
+
+private:
+    int32_t _prev_plan_node_id;
+};
+
+// CurrentThreadAllocationCounter is the allocation view of an operator or any other piece of code: it costs a
+// thread local read at each end of the scope instead of a mem tracker of its own.
+class CurrentThreadAllocationCounter {
+public:
+    explicit CurrentThreadAllocationCounter(RuntimeProfile::Counter* counter,
+                                            RuntimeProfile::HighWaterMarkCounter* peak_counter = nullptr)
+            : _counter(counter),
+              _peak_counter(peak_counter),
+              _start(tls_thread_status.allocated_bytes()),
+              _freed_start(tls_thread_status.freed_bytes()) {}
+
+    ~CurrentThreadAllocationCounter() {
+        int64_t allocated = tls_thread_status.allocated_bytes() - _start;
+        if (_counter != nullptr) {
+            _counter->update(allocated);
+        }
+        if (_peak_counter != nullptr) {
+            _peak_counter->add(allocated - (tls_thread_status.freed_bytes() - _freed_start));
+        }
+    }
+
+    CurrentThreadAllocationCounter(const CurrentThreadAllocationCounter&) = delete;
+    void operator=(const CurrentThreadAllocationCounter&) = delete;
+    CurrentThreadAllocationCounter(CurrentThreadAllocationCounter&&) = delete;
+    void operator=(CurrentThreadAllocationCounter&&) = delete;
+
+private:
+    RuntimeProfile::Counter* _counter;
+    RuntimeProfile::HighWaterMarkCounter* _peak_counter;
+    int64_t _start;
+    int64_t _freed_start;
+};
+
 #define TRY_CATCH_BAD_ALLOC(stmt)                                            \
     do {                                                                     \
         try {                                                                \
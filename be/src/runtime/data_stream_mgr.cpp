@@ -131,7 +131,8 @@ Status DataStreamMgr::transmit_data(const PTransmitDataParams* request, ::google
     return Status::OK();
 }
 
-Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
+                                     bool* receiver_finished, int64_t* credit_bytes) {
     const PUniqueId& finst_id = request.finst_id();
     // TODO(zc): Use PUniqueId directly
     // We can use PUniqueId directly, because old version StarRocks has already use
@@ -148,6 +149,11 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
         // in acquiring _lock.
         // TODO: Rethink the lifecycle of DataStreamRecvr to distinguish
         // errors from receiver-initiated teardowns.
+        // The receiver is deregistered once all the senders send eos, or it's closed before, e.g. its limit
+        // is reached, either way the sender needn't send any more.
+        if (receiver_finished != nullptr) {
+            *receiver_finished = true;
+        }
         return Status::OK();
     }
 
@@ -162,6 +168,9 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
     if (request.chunks_size() > 0 || request.use_pass_through()) {
         RETURN_IF_ERROR(recvr->add_chunks(request, eos ? nullptr : done));
     }
+    if (credit_bytes != nullptr) {
+        *credit_bytes = recvr->credit_bytes();
+    }
     if (eos) {
         recvr->remove_sender(request.sender_id(), request.be_number());
     }
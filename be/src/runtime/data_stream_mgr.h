@@ -85,7 +85,10 @@ public:
 
     Status transmit_data(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
 
-    Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // |receiver_finished| is set to true if the receiver is closed, e.g. its limit is reached, so the sender
+    // can stop sending. |credit_bytes| is set to the bytes the sender may have in flight to the receiver.
+    Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
+                          bool* receiver_finished = nullptr, int64_t* credit_bytes = nullptr);
     // Closes all receivers registered for fragment_instance_id immediately.
     void cancel(const TUniqueId& fragment_instance_id);
 
@@ -23,6 +23,7 @@
 
 #include <google/protobuf/stubs/common.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <deque>
 #include <map>
@@ -32,6 +33,7 @@
 #include <utility>
 
 #include "column/chunk.h"
+#include "exec/pipeline/pipeline_driver_poller.h"
 #include "exec/sort_exec_exprs.h"
 #include "gen_cpp/data.pb.h"
 #include "runtime/current_thread.h"
@@ -118,14 +120,23 @@ private:
         int64_t chunk_bytes = 0;
         // Invalid if SenderQueue::_is_pipeline_level_shuffle is false
         int32_t driver_sequence = -1;
+        // nullptr if the chunk is still serialized in pchunk.
         ChunkUniquePtr chunk_ptr;
         // When the memory of the ChunkQueue exceeds the limit,
         // we have to hold closure of the request, so as not to let the sender continue to send data.
         // A Request may have multiple Chunks, so only when the last Chunk of the Request is consumed,
         // the callback is closed- >run() Let the sender continue to send data
         google::protobuf::Closure* closure = nullptr;
+        // The serialized chunk, which is deserialized by the consumer instead of the brpc thread adding it,
+        // so that the brpc threads are not tied up by the receivers of many senders.
+        ChunkPB pchunk;
     };
 
+    // Only the receivers not merging defer the deserialization, the merger probes the chunks without status.
+    bool _defer_deserialization() const { return !_recvr->_is_merging; }
+    // Moves the chunk out of the item, deserializing it first if it's still serialized.
+    Status _take_chunk(ChunkItem* item, vectorized::Chunk** chunk);
+
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
     Status _deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk, faststring* uncompressed_buffer);
 
@@ -148,7 +159,9 @@ private:
     typedef std::list<ChunkItem> ChunkQueue;
     ChunkQueue _chunk_queue;
     bool _is_pipeline_level_shuffle = false;
-    std::vector<bool> _has_chunks_per_driver_sequence;
+    // The number of the chunks in _chunk_queue of each driver sequence, if _is_pipeline_level_shuffle.
+    // It's read without lock as a hint.
+    std::vector<int32_t> _num_chunks_per_driver_sequence;
     serde::ProtobufChunkMeta _chunk_meta;
 
     std::unordered_set<int> _sender_eos_set;          // sender_id
@@ -171,7 +184,7 @@ DataStreamRecvr::SenderQueue::SenderQueue(DataStreamRecvr* parent_recvr, int32_t
         : _recvr(parent_recvr),
           _is_cancelled(false),
           _num_remaining_senders(num_senders),
-          _has_chunks_per_driver_sequence(degree_of_parallelism, false) {}
+          _num_chunks_per_driver_sequence(degree_of_parallelism, 0) {}
 
 void DataStreamRecvr::SenderQueue::short_circuit_for_pipeline(const int32_t driver_sequence) {
     std::lock_guard<std::mutex> l(_lock);
@@ -188,6 +201,9 @@ void DataStreamRecvr::SenderQueue::short_circuit_for_pipeline(const int32_t driv
             ++iter;
         }
     }
+    if (_is_pipeline_level_shuffle) {
+        _num_chunks_per_driver_sequence[driver_sequence] = 0;
+    }
 }
 
 bool DataStreamRecvr::SenderQueue::has_output_for_pipeline(const int32_t driver_sequence) {
@@ -200,7 +216,7 @@ bool DataStreamRecvr::SenderQueue::has_output_for_pipeline(const int32_t driver_
         if (_is_cancelled) {
             return false;
         }
-        if (_is_pipeline_level_shuffle && !_has_chunks_per_driver_sequence[driver_sequence]) {
+        if (_is_pipeline_level_shuffle && _num_chunks_per_driver_sequence[driver_sequence] == 0) {
             return false;
         }
         if (_chunk_queue.empty()) {
@@ -215,24 +231,10 @@ bool DataStreamRecvr::SenderQueue::has_output_for_pipeline(const int32_t driver_
         if (_is_cancelled) {
             return false;
         }
-        if (_is_pipeline_level_shuffle && !_has_chunks_per_driver_sequence[driver_sequence]) {
-            return false;
-        }
-
-        if (_chunk_queue.empty()) {
-            return false;
-        }
-
-        for (auto& item : _chunk_queue) {
-            if (!_is_pipeline_level_shuffle || item.driver_sequence == driver_sequence) {
-                return true;
-            }
-        }
-
         if (_is_pipeline_level_shuffle) {
-            _has_chunks_per_driver_sequence[driver_sequence] = false;
+            return _num_chunks_per_driver_sequence[driver_sequence] > 0;
         }
-        return false;
+        return !_chunk_queue.empty();
     }
 }
 
@@ -265,6 +267,7 @@ bool DataStreamRecvr::SenderQueue::try_get_chunk(vectorized::Chunk** chunk) {
         DCHECK_EQ(_num_remaining_senders, 0);
         return false;
     } else {
+        DCHECK(_chunk_queue.front().chunk_ptr != nullptr);
         *chunk = _chunk_queue.front().chunk_ptr.release();
         _recvr->_num_buffered_bytes -= _chunk_queue.front().chunk_bytes;
         auto* closure = _chunk_queue.front().closure;
@@ -294,14 +297,12 @@ Status DataStreamRecvr::SenderQueue::get_chunk(vectorized::Chunk** chunk) {
         return Status::OK();
     }
 
-    *chunk = _chunk_queue.front().chunk_ptr.release();
-    auto* closure = _chunk_queue.front().closure;
-
-    _recvr->_num_buffered_bytes -= _chunk_queue.front().chunk_bytes;
-    VLOG_ROW << "DataStreamRecvr fetched #rows=" << (*chunk)->num_rows();
+    ChunkItem item = std::move(_chunk_queue.front());
+    _recvr->_num_buffered_bytes -= item.chunk_bytes;
     _chunk_queue.pop_front();
+    l.unlock();
 
-    if (closure != nullptr) {
+    if (item.closure != nullptr) {
         // When the execution thread is blocked and the Chunk queue exceeds the memory limit,
         // the execution thread will hold done and will not return, block brpc from sending packets,
         // and the execution thread will call run() to let brpc continue to send packets,
@@ -311,50 +312,73 @@ Status DataStreamRecvr::SenderQueue::get_chunk(vectorized::Chunk** chunk) {
         DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
 #endif
 
-        closure->Run();
+        item.closure->Run();
     }
 
+    RETURN_IF_ERROR(_take_chunk(&item, chunk));
+    VLOG_ROW << "DataStreamRecvr fetched #rows=" << (*chunk)->num_rows();
     return Status::OK();
 }
 
 Status DataStreamRecvr::SenderQueue::get_chunk_for_pipeline(vectorized::Chunk** chunk, const int32_t driver_sequence) {
-    std::lock_guard<std::mutex> l(_lock);
+    ChunkItem item;
+    {
+        std::lock_guard<std::mutex> l(_lock);
 
-    if (_is_cancelled) {
-        return Status::Cancelled("Cancelled SenderQueue::get_chunk");
-    }
+        if (_is_cancelled) {
+            return Status::Cancelled("Cancelled SenderQueue::get_chunk");
+        }
 
-    if (_chunk_queue.empty()) {
-        return Status::OK();
+        if (_chunk_queue.empty()) {
+            return Status::OK();
+        }
+        if (_is_pipeline_level_shuffle && _num_chunks_per_driver_sequence[driver_sequence] == 0) {
+            return Status::OK();
+        }
+
+        auto iter = _chunk_queue.begin();
+        while (iter != _chunk_queue.end() && _is_pipeline_level_shuffle && iter->driver_sequence != driver_sequence) {
+            ++iter;
+        }
+        if (iter == _chunk_queue.end()) {
+            return Status::OK();
+        }
+        item = std::move(*iter);
+        _recvr->_num_buffered_bytes -= item.chunk_bytes;
+        _chunk_queue.erase(iter);
+        if (_is_pipeline_level_shuffle) {
+            _num_chunks_per_driver_sequence[driver_sequence]--;
+        }
     }
 
-    auto iter = _chunk_queue.begin();
-    while (iter != _chunk_queue.end()) {
-        if (!_is_pipeline_level_shuffle || iter->driver_sequence == driver_sequence) {
-            *chunk = iter->chunk_ptr.release();
-            auto* closure = iter->closure;
-            _recvr->_num_buffered_bytes -= iter->chunk_bytes;
-            VLOG_ROW << "DataStreamRecvr fetched #rows=" << (*chunk)->num_rows();
-            _chunk_queue.erase(iter);
-
-            if (closure != nullptr) {
-                // When the execution thread is blocked and the Chunk queue exceeds the memory limit,
-                // the execution thread will hold done and will not return, block brpc from sending packets,
-                // and the execution thread will call run() to let brpc continue to send packets,
-                // and there will be memory release
+    if (item.closure != nullptr) {
+        // When the execution thread is blocked and the Chunk queue exceeds the memory limit,
+        // the execution thread will hold done and will not return, block brpc from sending packets,
+        // and the execution thread will call run() to let brpc continue to send packets,
+        // and there will be memory release
 #ifndef BE_TEST
-                MemTracker* prev_tracker =
-                        tls_thread_status.set_mem_tracker(ExecEnv::GetInstance()->process_mem_tracker());
-                DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
+        MemTracker* prev_tracker = tls_thread_status.set_mem_tracker(ExecEnv::GetInstance()->process_mem_tracker());
+        DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
 #endif
 
-                closure->Run();
-            }
-            return Status::OK();
-        }
-        ++iter;
+        item.closure->Run();
     }
 
+    // The chunk is deserialized out of the lock, the consumers of the other driver sequences and the senders
+    // don't wait for it.
+    RETURN_IF_ERROR(_take_chunk(&item, chunk));
+    VLOG_ROW << "DataStreamRecvr fetched #rows=" << (*chunk)->num_rows();
+    return Status::OK();
+}
+
+Status DataStreamRecvr::SenderQueue::_take_chunk(ChunkItem* item, vectorized::Chunk** chunk) {
+    if (item->chunk_ptr == nullptr) {
+        faststring uncompressed_buffer;
+        ChunkUniquePtr deserialized = std::make_unique<vectorized::Chunk>();
+        RETURN_IF_ERROR(_deserialize_chunk(item->pchunk, deserialized.get(), &uncompressed_buffer));
+        item->chunk_ptr = std::move(deserialized);
+    }
+    *chunk = item->chunk_ptr.release();
     return Status::OK();
 }
 
@@ -491,9 +515,15 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
             auto& pchunk = request.chunks().Get(i);
             auto driver_sequence = _is_pipeline_level_shuffle ? request.driver_sequences(i) : -1;
             int64_t chunk_bytes = pchunk.data().size();
-            ChunkUniquePtr chunk = std::make_unique<vectorized::Chunk>();
-            RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
-            ChunkItem item{chunk_bytes, driver_sequence, std::move(chunk), nullptr};
+            ChunkItem item{chunk_bytes, driver_sequence, nullptr, nullptr};
+            if (_defer_deserialization()) {
+                // Copied rather than moved out of the request, so that the buffered bytes are charged to the
+                // instance, which releases them.
+                item.pchunk = pchunk;
+            } else {
+                item.chunk_ptr = std::make_unique<vectorized::Chunk>();
+                RETURN_IF_ERROR(_deserialize_chunk(pchunk, item.chunk_ptr.get(), &uncompressed_buffer));
+            }
             chunks.emplace_back(std::move(item));
             total_chunk_bytes += chunk_bytes;
         }
@@ -520,7 +550,7 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
                     _short_circuit_driver_sequences.end()) {
                     continue;
                 }
-                _has_chunks_per_driver_sequence[item.driver_sequence] = true;
+                _num_chunks_per_driver_sequence[item.driver_sequence]++;
             }
             _chunk_queue.emplace_back(std::move(item));
         }
@@ -618,10 +648,15 @@ Status DataStreamRecvr::SenderQueue::add_chunks_and_keep_order(const PTransmitCh
             auto& pchunk = request.chunks().Get(i);
             auto driver_sequence = _is_pipeline_level_shuffle ? request.driver_sequences(i) : -1;
             int64_t chunk_bytes = pchunk.data().size();
-            ChunkUniquePtr chunk = std::make_unique<vectorized::Chunk>();
-            RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
-
-            ChunkItem item{chunk_bytes, driver_sequence, std::move(chunk), nullptr};
+            ChunkItem item{chunk_bytes, driver_sequence, nullptr, nullptr};
+            if (_defer_deserialization()) {
+                // Copied rather than moved out of the request, so that the buffered bytes are charged to the
+                // instance, which releases them.
+                item.pchunk = pchunk;
+            } else {
+                item.chunk_ptr = std::make_unique<vectorized::Chunk>();
+                RETURN_IF_ERROR(_deserialize_chunk(pchunk, item.chunk_ptr.get(), &uncompressed_buffer));
+            }
 
             // TODO(zc): review this chunk_bytes
             local_chunk_queue.emplace_back(std::move(item));
@@ -678,7 +713,7 @@ Status DataStreamRecvr::SenderQueue::add_chunks_and_keep_order(const PTransmitCh
                         }
                         continue;
                     }
-                    _has_chunks_per_driver_sequence[item.driver_sequence] = true;
+                    _num_chunks_per_driver_sequence[item.driver_sequence]++;
                 }
                 _chunk_queue.emplace_back(std::move(item));
             }
@@ -782,6 +817,7 @@ void DataStreamRecvr::SenderQueue::clean_buffer_queues() {
         }
     }
     _chunk_queue.clear();
+    std::fill(_num_chunks_per_driver_sequence.begin(), _num_chunks_per_driver_sequence.end(), 0);
     for (auto& [_, chunk_queues] : _buffered_chunk_queues) {
         for (auto& [_, chunk_queue] : chunk_queues) {
             for (auto& item : chunk_queue) {
@@ -863,6 +899,7 @@ DataStreamRecvr::DataStreamRecvr(DataStreamMgr* stream_mgr, RuntimeState* runtim
           _fragment_instance_id(fragment_instance_id),
           _dest_node_id(dest_node_id),
           _total_buffer_limit(total_buffer_limit),
+          _num_senders(num_senders),
           _row_desc(row_desc),
           _is_merging(is_merging),
           _num_buffered_bytes(0),
@@ -919,6 +956,12 @@ Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google
     int use_sender_id = _is_merging ? request.sender_id() : 0;
     // Add all batches to the same queue if _is_merging is false.
 
+    DeferOp notify_defer([this] {
+        if (_is_pipeline) {
+            // The exchange source operators waiting for chunks may be ready now.
+            pipeline::notify_blocked_drivers();
+        }
+    });
     if (_keep_order) {
         DCHECK(_is_pipeline);
         return _sender_queues[use_sender_id]->add_chunks_and_keep_order(request, done);
@@ -930,6 +973,9 @@ Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
     int use_sender_id = _is_merging ? sender_id : 0;
     _sender_queues[use_sender_id]->decrement_senders(be_number);
+    if (_is_pipeline) {
+        pipeline::notify_blocked_drivers();
+    }
 }
 
 void DataStreamRecvr::cancel_stream() {
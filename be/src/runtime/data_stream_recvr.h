@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
@@ -112,6 +114,12 @@ public:
 
     bool is_data_ready();
 
+    // The bytes each sender may have in flight to this receiver, its even share of the free buffer.
+    int64_t credit_bytes() const {
+        int64_t free_bytes = std::max<int64_t>(0, _total_buffer_limit - _num_buffered_bytes);
+        return free_bytes / std::max(1, _num_senders);
+    }
+
 private:
     friend class DataStreamMgr;
     class SenderQueue;
@@ -148,6 +156,8 @@ private:
     // exceeds this value
     int _total_buffer_limit;
 
+    int _num_senders;
+
     // Row schema, copied from the caller of CreateRecvr().
     RowDescriptor _row_desc;
 
@@ -590,19 +590,13 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
                 DCHECK(_partitions_columns[i] != nullptr);
             }
 
-            if (_part_type == TPartitionType::HASH_PARTITIONED) {
-                _hash_values.assign(num_rows, HashUtil::FNV_SEED);
-                for (const ColumnPtr& column : _partitions_columns) {
-                    column->fnv_hash(&_hash_values[0], 0, num_rows);
-                }
-            } else {
-                // The data distribution was calculated using CRC32_HASH,
-                // and bucket shuffle need to use the same hash function when sending data
-                _hash_values.assign(num_rows, 0);
-                for (const ColumnPtr& column : _partitions_columns) {
-                    column->crc32_hash(&_hash_values[0], 0, num_rows);
-                }
-            }
+            // Compute hash for each partition column, or reuse the hashes cached by the runtime filters.
+            // The data distribution was calculated using CRC32_HASH,
+            // and bucket shuffle need to use the same hash function when sending data
+            const auto algorithm = _part_type == TPartitionType::HASH_PARTITIONED
+                                           ? vectorized::Chunk::HashAlgorithm::FNV
+                                           : vectorized::Chunk::HashAlgorithm::CRC32;
+            chunk->hash_columns(_partitions_columns, algorithm, &_hash_values);
 
             // compute row indexes for each channel
             _channel_row_idx_start_points.assign(num_channels + 1, 0);
@@ -92,6 +92,11 @@ public:
 
     std::string to_string() const;
 
+    // Returns the formatted string length or -1 on error.
+    int to_string(char* s, size_t n) const;
+
+    static constexpr int max_string_length() { return 10; }
+
     JulianDate julian() const { return _julian; }
 
     template <TimeUnit UNIT>
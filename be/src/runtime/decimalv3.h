@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string>
 #include <type_traits>
 
@@ -68,6 +69,18 @@ public:
 
     // check divide-by-zero before calling div and mod
     static inline bool div_round(Type const& a, Type const& b, Type* c) {
+        if constexpr (std::is_same_v<Type, int128_t>) {
+            // The 64-bit division is much cheaper than the 128-bit one in software. INT64_MIN and -1 are excluded
+            // for the abs(b) and the INT64_MIN / -1 of the 64-bit division.
+            if (a == static_cast<int64_t>(a) && b == static_cast<int64_t>(b) && b != -1 &&
+                b != std::numeric_limits<int64_t>::min()) {
+                int64_t c64;
+                DecimalV3Arithmetics<int64_t, check_overflow>::div_round(static_cast<int64_t>(a),
+                                                                         static_cast<int64_t>(b), &c64);
+                *c = c64;
+                return false;
+            }
+        }
         *c = a / b;
         Type r = a % b;
         // case 1: |b| is odd. if [|b|/2] < |r|, then add carry; otherwise add 0.
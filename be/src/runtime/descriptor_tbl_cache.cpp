@@ -0,0 +1,89 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/descriptor_tbl_cache.h"
+
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "runtime/current_thread.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "util/thrift_util.h"
+
+namespace starrocks {
+
+DescriptorTblCache* DescriptorTblCache::_s_instance = nullptr;
+
+void DescriptorTblCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr) {
+        _s_instance = new DescriptorTblCache(mem_tracker, capacity);
+    }
+}
+
+void DescriptorTblCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+DescriptorTblCache::DescriptorTblCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+
+// The descriptors are freed by the last query using them, which is charged to the tracker of the cache too.
+std::shared_ptr<ObjectPool> DescriptorTblCache::_new_pool() const {
+    MemTracker* mem_tracker = _mem_tracker;
+    return std::shared_ptr<ObjectPool>(new ObjectPool(), [mem_tracker](ObjectPool* pool) {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+        delete pool;
+    });
+}
+
+Status DescriptorTblCache::get_or_create(const TDescriptorTable& thrift_tbl, int32_t chunk_size,
+                                         DescriptorTbl** desc_tbl, std::shared_ptr<ObjectPool>* pool) {
+    bool cacheable = true;
+    for (const auto& tdesc : thrift_tbl.tableDescriptors) {
+        if (tdesc.tableType == TTableType::HDFS_TABLE) {
+            cacheable = false;
+            break;
+        }
+    }
+    std::string key;
+    if (cacheable) {
+        ThriftSerializer serializer(false, 4096);
+        // a copy, since serializing the thrift object is not const
+        TDescriptorTable copy = thrift_tbl;
+        cacheable = serializer.serialize(&copy, &key).ok();
+    }
+    if (!cacheable) {
+        *pool = std::make_shared<ObjectPool>();
+        return DescriptorTbl::create(pool->get(), thrift_tbl, desc_tbl, chunk_size);
+    }
+
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle != nullptr) {
+        const auto* entry = reinterpret_cast<const Entry*>(_cache->value(handle));
+        *pool = entry->pool;
+        *desc_tbl = entry->desc_tbl;
+        _cache->release(handle);
+        return Status::OK();
+    }
+
+    // the entries are allocated and freed, maybe by the eviction of another insertion, under the tracker of the cache
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+    auto* entry = new Entry();
+    entry->pool = _new_pool();
+    Status st = DescriptorTbl::create(entry->pool.get(), thrift_tbl, &entry->desc_tbl, chunk_size);
+    if (!st.ok()) {
+        delete entry;
+        return st;
+    }
+    *pool = entry->pool;
+    *desc_tbl = entry->desc_tbl;
+    // the built descriptors are several times larger than the serialized ones
+    size_t charge = key.size() * 4 + sizeof(Entry);
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<Entry*>(value); };
+    _cache->release(_cache->insert(CacheKey(key), entry, charge, deleter));
+    return Status::OK();
+}
+
+} // namespace starrocks
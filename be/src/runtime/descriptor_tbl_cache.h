@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class DescriptorTbl;
+class MemTracker;
+class ObjectPool;
+class TDescriptorTable;
+
+// DescriptorTblCache keeps the DescriptorTbls built for the fragments last prepared, keyed by their serialized
+// TDescriptorTable, so that the fragment instances of the short queries sent again and again share the same
+// descriptors instead of building them each. A DescriptorTbl is immutable once it's built, and it lives in an
+// ObjectPool shared by the cache and the RuntimeStates using it.
+//
+// The descriptor tables of HDFS tables are not cached, since their partition key exprs are prepared and opened
+// by each query.
+class DescriptorTblCache {
+public:
+    // Create the global instance, a cache of |capacity| bytes charged to |mem_tracker|.
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Returns nullptr if the cache isn't created, i.e. it's disabled.
+    static DescriptorTblCache* instance() { return _s_instance; }
+
+    DescriptorTblCache(MemTracker* mem_tracker, size_t capacity);
+
+    // Set |desc_tbl| to the DescriptorTbl of |thrift_tbl|, cached or newly built, which lives in |pool|.
+    Status get_or_create(const TDescriptorTable& thrift_tbl, int32_t chunk_size, DescriptorTbl** desc_tbl,
+                         std::shared_ptr<ObjectPool>* pool);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+private:
+    struct Entry {
+        std::shared_ptr<ObjectPool> pool;
+        DescriptorTbl* desc_tbl = nullptr;
+    };
+
+    static DescriptorTblCache* _s_instance;
+
+    std::shared_ptr<ObjectPool> _new_pool() const;
+
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks
@@ -21,21 +21,27 @@
 
 #include "runtime/exec_env.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "column/column_pool.h"
 #include "common/config.h"
 #include "common/logging.h"
+#include "env/block_cache.h"
+#include "env/file_tail_cache.h"
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/scan_result_cache.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/HeartbeatService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
+#include "gutil/strings/split.h"
 #include "plugin/plugin_mgr.h"
 #include "runtime/broker_mgr.h"
 #include "runtime/client_cache.h"
 #include "runtime/data_stream_mgr.h"
+#include "runtime/descriptor_tbl_cache.h"
 #include "runtime/external_scan_context_mgr.h"
 #include "runtime/fragment_mgr.h"
 #include "runtime/heartbeat_flags.h"
@@ -46,11 +52,13 @@
 #include "runtime/result_queue_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
+#include "runtime/sampling_profiler.h"
 #include "runtime/small_file_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/thread_resource_mgr.h"
 #include "storage/page_cache.h"
+#include "storage/rowset/segment_footer_cache.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_schema_map.h"
 #include "storage/update_manager.h"
@@ -147,6 +155,14 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
         max_thread_num = config::pipeline_exec_thread_pool_thread_num;
     }
     LOG(INFO) << strings::Substitute("[PIPELINE] Exec thread pool: thread_num=$0", max_thread_num);
+    // started before the threads of the dispatcher, which register themselves to it
+    if (config::query_sampling_profiler_frequency > 0) {
+        Status st = SamplingProfiler::instance()->init(config::query_sampling_profiler_frequency,
+                                                       config::query_sampling_profiler_max_queries);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to init the query sampling profiler, it's disabled: " << st.to_string();
+        }
+    }
     RETURN_IF_ERROR(ThreadPoolBuilder("pip_dispatcher") // pipeline dispatcher
                             .set_min_threads(0)
                             .set_max_threads(max_thread_num)
@@ -182,6 +198,15 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _small_file_mgr->init();
     _init_mem_tracker();
 
+    if (!config::block_cache_disk_path.empty()) {
+        std::vector<std::string> dirs = strings::Split(config::block_cache_disk_path, ";", strings::SkipWhitespace());
+        Status st = BlockCache::instance()->init(dirs, config::block_cache_disk_size, config::block_cache_block_size,
+                                                 config::block_cache_write_threads);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to init block cache, it's disabled: " << st.to_string();
+        }
+    }
+
     RETURN_IF_ERROR(_load_channel_mgr->init(_load_mem_tracker));
     _heartbeat_flags = new HeartbeatFlags();
     return Status::OK();
@@ -270,7 +295,23 @@ Status ExecEnv::_init_mem_tracker() {
         LOG(WARNING) << "Config storage_page_cache_limit is greater than memory size, config="
                      << config::storage_page_cache_limit << ", memory=" << MemInfo::physical_mem();
     }
-    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit);
+    int storage_cache_shard_bits = std::clamp(config::storage_page_cache_shard_bits, 0, 16);
+    double storage_cache_protected_ratio = std::clamp(config::storage_page_cache_protected_ratio, 0.0, 1.0);
+    double storage_cache_compressed_ratio = std::clamp(config::storage_page_cache_compressed_ratio, 0.0, 1.0);
+    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit, storage_cache_shard_bits,
+                                          storage_cache_protected_ratio, storage_cache_compressed_ratio);
+    if (config::segment_footer_cache_capacity > 0) {
+        SegmentFooterCache::create_global_cache(_page_cache_mem_tracker, config::segment_footer_cache_capacity);
+    }
+    if (config::hdfs_file_tail_cache_capacity > 0) {
+        FileTailCache::create_global_cache(_page_cache_mem_tracker, config::hdfs_file_tail_cache_capacity);
+    }
+    if (config::scan_result_cache_capacity > 0) {
+        pipeline::ScanResultCache::create_global_cache(_page_cache_mem_tracker, config::scan_result_cache_capacity);
+    }
+    if (config::pipeline_desc_tbl_cache_capacity > 0) {
+        DescriptorTblCache::create_global_cache(_query_pool_mem_tracker, config::pipeline_desc_tbl_cache_capacity);
+    }
 
     // TODO(zc): The current memory usage configuration is a bit confusing,
     // we need to sort out the use of memory
@@ -278,6 +319,7 @@ Status ExecEnv::_init_mem_tracker() {
 }
 
 void ExecEnv::_destroy() {
+    BlockCache::instance()->close();
     if (_runtime_filter_worker) {
         delete _runtime_filter_worker;
         _runtime_filter_worker = nullptr;
@@ -334,6 +376,7 @@ void ExecEnv::_destroy() {
         delete _driver_dispatcher;
         _driver_dispatcher = nullptr;
     }
+    SamplingProfiler::instance()->close();
     if (_fragment_mgr) {
         delete _fragment_mgr;
         _fragment_mgr = nullptr;
@@ -21,13 +21,17 @@
 
 #include "runtime/external_scan_context_mgr.h"
 
+#include <arrow/record_batch.h>
+
 #include <chrono>
 #include <functional>
 #include <memory>
 #include <vector>
 
+#include "gutil/strings/substitute.h"
 #include "runtime/fragment_mgr.h"
 #include "runtime/result_queue_mgr.h"
+#include "util/arrow/row_batch.h"
 #include "util/starrocks_metrics.h"
 #include "util/thread.h"
 #include "util/uid_util.h"
@@ -99,6 +103,36 @@ Status ExternalScanContextMgr::clear_scan_context(const std::string& context_id)
     return Status::OK();
 }
 
+Status ExternalScanContextMgr::get_next_batch(const std::string& context_id, int64_t offset, std::string* rows,
+                                              int64_t* num_rows, bool* eos) {
+    std::shared_ptr<ScanContext> context;
+    RETURN_IF_ERROR(get_scan_context(context_id, &context));
+    *num_rows = 0;
+    if (offset != context->offset) {
+        LOG(ERROR) << "getNext error: context offset [" << context->offset << " ]"
+                   << " ,client offset [ " << offset << " ]";
+        context->last_access_time = time(nullptr);
+        return Status::NotFound(strings::Substitute("context_id=$0, send_offset=$1, context_offset=$2", context_id,
+                                                    offset, context->offset));
+    }
+    // during accessing, should disabled last_access_time
+    context->last_access_time = -1;
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    Status st = _exec_env->result_queue_mgr()->fetch_result(context->fragment_instance_id, &record_batch, eos);
+    if (!st.ok()) {
+        LOG(WARNING) << "fragment_instance_id [" << print_id(context->fragment_instance_id)
+                     << "] fetch result status [" << st.to_string() + "]";
+    } else if (!*eos) {
+        st = serialize_record_batch(*record_batch, rows);
+        if (st.ok()) {
+            *num_rows = record_batch->num_rows();
+            context->offset += *num_rows;
+        }
+    }
+    context->last_access_time = time(nullptr);
+    return st;
+}
+
 void ExternalScanContextMgr::gc_expired_context() {
 #ifndef BE_TEST
     while (true) {
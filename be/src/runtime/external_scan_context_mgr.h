@@ -59,6 +59,13 @@ public:
 
     Status clear_scan_context(const std::string& context_id);
 
+    // Fetch the next record batch of the scan of |context_id| from its result queue, and serialize it into
+    // |rows| as an Arrow IPC stream. |offset| is the number of the rows fetched by the client so far, which
+    // must be the offset of the context, and |num_rows| is set to the number of the rows of the batch.
+    // It blocks until a batch is ready, and sets |eos| if the scan is done.
+    Status get_next_batch(const std::string& context_id, int64_t offset, std::string* rows, int64_t* num_rows,
+                          bool* eos);
+
 private:
     ExecEnv* _exec_env;
     std::map<std::string, std::shared_ptr<ScanContext>> _active_contexts;
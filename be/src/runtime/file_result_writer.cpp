@@ -21,8 +21,10 @@
 
 #include "runtime/file_result_writer.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "common/config.h"
 #include "env/env_broker.h"
 #include "exec/local_file_writer.h"
 #include "exec/parquet_builder.h"
@@ -32,6 +34,7 @@
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/runtime_state.h"
 #include "util/date_func.h"
+#include "util/threadpool.h"
 #include "util/uid_util.h"
 
 namespace starrocks {
@@ -49,14 +52,27 @@ FileResultWriter::FileResultWriter(const ResultFileOptions* file_opts,
 }
 
 FileResultWriter::~FileResultWriter() {
-    _close_file_writer(true);
+    _close_file_writers();
 }
 
 Status FileResultWriter::init(RuntimeState* state) {
     _state = state;
     _init_profile();
 
-    RETURN_IF_ERROR(_create_file_writer());
+    int parallel_num = std::max(config::file_result_writer_parallel_num, 1);
+    _writers.resize(parallel_num);
+    if (parallel_num > 1) {
+        RETURN_IF_ERROR(ThreadPoolBuilder("file_result_writer")
+                                .set_min_threads(0)
+                                .set_max_threads(parallel_num)
+                                .build(&_write_pool));
+        for (auto& writer : _writers) {
+            writer.token = _write_pool->new_token(ThreadPool::ExecutionMode::SERIAL);
+        }
+    }
+    for (auto& writer : _writers) {
+        RETURN_IF_ERROR(_create_file_writer(&writer));
+    }
     return Status::OK();
 }
 
@@ -70,19 +86,19 @@ void FileResultWriter::_init_profile() {
     _written_data_bytes = ADD_COUNTER(profile, "WrittenDataBytes", TUnit::BYTES);
 }
 
-Status FileResultWriter::_create_file_writer() {
+Status FileResultWriter::_create_file_writer(Writer* writer) {
     std::string file_name = _get_next_file_name();
     std::unique_ptr<WritableFile> writable_file;
     RETURN_IF_ERROR(_env->new_writable_file(file_name, &writable_file));
 
     switch (_file_opts->file_format) {
     case TFileFormatType::FORMAT_CSV_PLAIN:
-        _file_builder = std::make_unique<PlainTextBuilder>(
+        writer->file_builder = std::make_unique<PlainTextBuilder>(
                 PlainTextBuilderOptions{_file_opts->column_separator, _file_opts->row_delimiter},
                 std::move(writable_file), _output_expr_ctxs);
         break;
     case TFileFormatType::FORMAT_PARQUET:
-        _file_builder = std::make_unique<ParquetBuilder>(std::move(writable_file), _output_expr_ctxs);
+        writer->file_builder = std::make_unique<ParquetBuilder>(std::move(writable_file), _output_expr_ctxs);
         break;
     default:
         return Status::InternalError(strings::Substitute("unsupported file format: $0", _file_opts->file_format));
@@ -111,41 +127,79 @@ std::string FileResultWriter::_file_format_to_name() {
 }
 
 Status FileResultWriter::append_chunk(vectorized::Chunk* chunk) {
-    assert(_file_builder != nullptr);
-    _file_builder->add_chunk(chunk);
+    SCOPED_TIMER(_append_row_batch_timer);
+    _written_rows += chunk->num_rows();
+    if (_write_pool == nullptr) {
+        return _append_chunk(&_writers[0], chunk);
+    }
+
+    Writer* writer = &_writers[_next_writer];
+    _next_writer = (_next_writer + 1) % _writers.size();
+    // waits for the last chunk of this file, so the chunks in flight are bounded by the number of files
+    writer->token->wait();
+    RETURN_IF_ERROR(writer->status);
+    // the chunk is reused by the caller once this returns
+    std::shared_ptr<vectorized::Chunk> copy = chunk->clone_unique();
+    return writer->token->submit_func([this, writer, copy]() { writer->status = _append_chunk(writer, copy.get()); });
+}
+
+Status FileResultWriter::_append_chunk(Writer* writer, vectorized::Chunk* chunk) {
+    DCHECK(writer->file_builder != nullptr);
+    {
+        SCOPED_TIMER(_file_write_timer);
+        RETURN_IF_ERROR(writer->file_builder->add_chunk(chunk));
+    }
 
     // split file if exceed limit
-    RETURN_IF_ERROR(_create_new_file_if_exceed_size());
+    RETURN_IF_ERROR(_create_new_file_if_exceed_size(writer));
 
     return Status::OK();
 }
 
-Status FileResultWriter::_create_new_file_if_exceed_size() {
-    if (_file_builder->file_size() < _file_opts->max_file_size_bytes) {
+Status FileResultWriter::_create_new_file_if_exceed_size(Writer* writer) {
+    if (writer->file_builder->file_size() < _file_opts->max_file_size_bytes) {
         return Status::OK();
     }
     // current file size exceed the max file size. close this file
     // and create new one
     {
         SCOPED_TIMER(_writer_close_timer);
-        RETURN_IF_ERROR(_close_file_writer(false));
+        RETURN_IF_ERROR(_close_file_writer(writer, false));
     }
     return Status::OK();
 }
 
-Status FileResultWriter::_close_file_writer(bool done) {
-    if (_file_builder != nullptr) {
-        RETURN_IF_ERROR(_file_builder->finish());
-        _file_builder.reset();
+Status FileResultWriter::_close_file_writer(Writer* writer, bool done) {
+    if (writer->file_builder != nullptr) {
+        RETURN_IF_ERROR(writer->file_builder->finish());
+        writer->file_builder.reset();
     }
 
     if (!done) {
         // not finished, create new file writer for next file
-        RETURN_IF_ERROR(_create_file_writer());
+        RETURN_IF_ERROR(_create_file_writer(writer));
     }
     return Status::OK();
 }
 
+Status FileResultWriter::_close_file_writers() {
+    Status status;
+    for (auto& writer : _writers) {
+        if (writer.token != nullptr) {
+            writer.token->wait();
+            if (status.ok()) {
+                status = writer.status;
+            }
+        }
+        // the failed files are closed too
+        Status st = _close_file_writer(&writer, true);
+        if (status.ok()) {
+            status = st;
+        }
+    }
+    return status;
+}
+
 Status FileResultWriter::close() {
     // the following 2 profile "_written_rows_counter" and "_writer_close_timer"
     // must be outside the `_close_file_writer()`.
@@ -154,8 +208,7 @@ Status FileResultWriter::close() {
     // so does the profile in RuntimeState.
     COUNTER_SET(_written_rows_counter, _written_rows);
     SCOPED_TIMER(_writer_close_timer);
-    RETURN_IF_ERROR(_close_file_writer(true));
-    return Status::OK();
+    return _close_file_writers();
 }
 
 } // namespace starrocks
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "env/env.h"
 #include "gen_cpp/DataSinks_types.h"
 #include "runtime/result_writer.h"
@@ -32,6 +34,8 @@ class Env;
 class ExprContext;
 class FileBuilder;
 class RuntimeProfile;
+class ThreadPool;
+class ThreadPoolToken;
 class WritableFile;
 
 struct ResultFileOptions {
@@ -64,6 +68,8 @@ struct ResultFileOptions {
 };
 
 // write result to file
+// If config::file_result_writer_parallel_num > 1, that many files are written at the same time, the chunks are
+// appended to them in turn by the threads of the writer, each file has at most one chunk in flight.
 class FileResultWriter final : public ResultWriter {
 public:
     FileResultWriter(const ResultFileOptions* file_option, const std::vector<ExprContext*>& output_expr_ctxs,
@@ -75,16 +81,28 @@ public:
     Status close() override;
 
 private:
+    // One of the files written at the same time.
+    struct Writer {
+        std::unique_ptr<FileBuilder> file_builder;
+        // appends the chunks in order, nullptr if the files are written by the caller
+        std::unique_ptr<ThreadPoolToken> token;
+        // the first error of the chunks appended by the token
+        Status status;
+    };
+
     void _init_profile();
 
-    Status _create_file_writer();
+    Status _create_file_writer(Writer* writer);
     // get next export file name
     std::string _get_next_file_name();
     std::string _file_format_to_name();
+    Status _append_chunk(Writer* writer, vectorized::Chunk* chunk);
     // close file writer, and if !done, it will create new writer for next file
-    Status _close_file_writer(bool done);
+    Status _close_file_writer(Writer* writer, bool done);
+    // waits for the chunks in flight and closes all the files
+    Status _close_file_writers();
     // create a new file if current file size exceed limit
-    Status _create_new_file_if_exceed_size();
+    Status _create_new_file_if_exceed_size(Writer* writer);
 
     RuntimeState* _state = nullptr; // not owned, set when init
     const ResultFileOptions* _file_opts;
@@ -92,10 +110,14 @@ private:
 
     Env* _env;
     std::unique_ptr<Env> _owned_env;
-    std::unique_ptr<FileBuilder> _file_builder;
+    // nullptr if there is only one file written at a time
+    std::unique_ptr<ThreadPool> _write_pool;
+    std::vector<Writer> _writers;
+    // the writer the next chunk is appended to
+    size_t _next_writer = 0;
 
     // the suffix idx of export file name, start at 0
-    int _file_idx = 0;
+    std::atomic<int> _file_idx{0};
 
     RuntimeProfile* _parent_profile; // profile from result sink, not owned
     // total time cost on append batch opertion
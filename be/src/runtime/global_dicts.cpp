@@ -372,6 +372,50 @@ std::pair<std::shared_ptr<BinaryColumn>, std::vector<int32_t>> extract_column_wi
     return std::make_pair(std::move(binary_column), std::move(codes));
 }
 
+// Returns the global dict of the slot referred by |expr_ctx|, or nullptr if it's not a slot encoded by a dict.
+static const RGlobalDictMap* global_dict_of(const GlobalDictMaps& dict_maps, ExprContext* expr_ctx) {
+    if (!expr_ctx->root()->is_slotref()) {
+        return nullptr;
+    }
+    std::vector<SlotId> slot_ids;
+    expr_ctx->root()->get_slot_ids(&slot_ids);
+    DCHECK_EQ(1, slot_ids.size());
+    auto iter = dict_maps.find(slot_ids[0]);
+    return iter == dict_maps.end() ? nullptr : &iter->second.second;
+}
+
+Status check_join_keys_global_dicts(RuntimeState* state, const std::vector<ExprContext*>& build_expr_ctxs,
+                                    const std::vector<ExprContext*>& probe_expr_ctxs) {
+    const auto& dict_maps = state->get_query_global_dict_map();
+    if (dict_maps.empty()) {
+        return Status::OK();
+    }
+    DCHECK_EQ(build_expr_ctxs.size(), probe_expr_ctxs.size());
+    for (size_t i = 0; i < build_expr_ctxs.size(); ++i) {
+        const RGlobalDictMap* build_dict = global_dict_of(dict_maps, build_expr_ctxs[i]);
+        const RGlobalDictMap* probe_dict = global_dict_of(dict_maps, probe_expr_ctxs[i]);
+        if (build_dict == probe_dict) {
+            continue;
+        }
+        bool same = build_dict != nullptr && probe_dict != nullptr && build_dict->size() == probe_dict->size();
+        if (same) {
+            for (const auto& [code, word] : *build_dict) {
+                auto iter = probe_dict->find(code);
+                if (iter == probe_dict->end() || iter->second != word) {
+                    same = false;
+                    break;
+                }
+            }
+        }
+        if (!same) {
+            return Status::InternalError(
+                    fmt::format("the join keys {} and {} are not encoded by the same global dict",
+                                build_expr_ctxs[i]->root()->debug_string(), probe_expr_ctxs[i]->root()->debug_string()));
+        }
+    }
+    return Status::OK();
+}
+
 void DictOptimizeParser::rewrite_descriptor(RuntimeState* runtime_state, const std::vector<ExprContext*>& conjunct_ctxs,
                                             const std::map<int32_t, int32_t>& dict_slots_mapping,
                                             std::vector<SlotDescriptor*>* slot_descs) {
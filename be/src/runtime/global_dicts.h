@@ -114,6 +114,12 @@ private:
 
 std::pair<std::shared_ptr<BinaryColumn>, std::vector<int32_t>> extract_column_with_codes(const GlobalDictMap& dict_map);
 
+// The join, the shuffle and the runtime filters on the equi-join keys encoded by the global dicts work on the
+// codes directly, which is right only if the keys of both sides are encoded by the same dict, otherwise the same
+// code stands for different strings. Returns an error if a pair of the keys are not encoded in the same way.
+Status check_join_keys_global_dicts(RuntimeState* state, const std::vector<ExprContext*>& build_expr_ctxs,
+                                    const std::vector<ExprContext*>& probe_expr_ctxs);
+
 template <PrimitiveType primitive_type, typename Dict, PrimitiveType result_primitive_type>
 struct DictDecoder {
     using FieldType = RunTimeCppType<primitive_type>;
@@ -124,6 +124,11 @@ inline bool int128_mul_overflow(int128_t a, int128_t b, int128_t* c) {
 
 template <>
 inline bool mul_overflow(int128_t a, int128_t b, int128_t* c) {
+    // Most of the decimals fit in 64 bits, whose product is a single multiply and never overflows.
+    if (a == static_cast<int64_t>(a) && b == static_cast<int64_t>(b)) {
+        *c = static_cast<int128_t>(static_cast<int64_t>(a)) * static_cast<int64_t>(b);
+        return false;
+    }
 #if defined(__x86_64__) && defined(__GNUC__)
     return multi3(a, b, *c);
 #else
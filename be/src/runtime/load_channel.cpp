@@ -92,6 +92,24 @@ void LoadChannel::remove_tablets_channel(int64_t index_id) {
     }
 }
 
+void LoadChannel::collect_memtables(std::vector<LoadMemTable>* memtables) {
+    std::vector<scoped_refptr<TabletsChannel>> channels;
+    {
+        std::lock_guard l(_lock);
+        for (auto& [_, channel] : _tablets_channels) {
+            channels.emplace_back(channel);
+        }
+    }
+    std::vector<std::pair<vectorized::AsyncDeltaWriter*, size_t>> writers;
+    for (auto& channel : channels) {
+        writers.clear();
+        channel->collect_memtables(&writers);
+        for (auto& [writer, bytes] : writers) {
+            memtables->push_back({channel, writer, bytes});
+        }
+    }
+}
+
 scoped_refptr<TabletsChannel> LoadChannel::get_tablets_channel(int64_t index_id) {
     std::lock_guard l(_lock);
     auto it = _tablets_channels.find(index_id);
@@ -25,6 +25,7 @@
 #include <ostream>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/InternalService_types.h"
@@ -45,6 +46,17 @@ class TabletsChannel;
 class LoadChannel;
 class LoadChannelMgr;
 
+namespace vectorized {
+class AsyncDeltaWriter;
+}
+
+// A memtable being written by a load, |channel| keeps |writer| alive.
+struct LoadMemTable {
+    scoped_refptr<TabletsChannel> channel;
+    vectorized::AsyncDeltaWriter* writer = nullptr;
+    size_t bytes = 0;
+};
+
 // A LoadChannel manages tablets channels for all indexes
 // corresponding to a certain load job
 class LoadChannel : public RefCountedThreadSafe<LoadChannel> {
@@ -77,6 +89,8 @@ public:
 
     void remove_tablets_channel(int64_t index_id);
 
+    void collect_memtables(std::vector<LoadMemTable>* memtables);
+
 private:
     friend class RefCountedThreadSafe<LoadChannel>;
     ~LoadChannel() = default;
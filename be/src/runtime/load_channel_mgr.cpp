@@ -21,16 +21,19 @@
 
 #include "runtime/load_channel_mgr.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "common/closure_guard.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/load_channel.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/tablets_channel.h"
 #include "service/backend_options.h"
 #include "util/starrocks_metrics.h"
 #include "util/stopwatch.hpp"
 #include "util/thread.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -111,12 +114,73 @@ void LoadChannelMgr::add_chunk(brpc::Controller* cntl, const PTabletWriterAddChu
     auto channel = _find_load_channel(load_id);
     if (channel != nullptr) {
         channel->add_chunk(cntl, request, response, done_guard.release());
+        // the response has been sent, check the memory without delaying the sender.
+        _flush_largest_memtables_if_needed();
     } else {
         response->mutable_status()->set_status_code(TStatusCode::INTERNAL_ERROR);
         response->mutable_status()->add_error_msgs("no associated load channel");
     }
 }
 
+// The memtables being flushed still hold their memory, so the picks are spaced out to let those flushes
+// finish instead of flushing more and more of the small memtables.
+static constexpr int64_t kFlushPickIntervalMs = 100;
+
+// A DeltaWriter hitting the memory limit flushes its own memtable in foreground however small it is.
+// To avoid that, the largest memtables of all the loads are flushed in background once the consumption
+// goes beyond the soft limit, until the memtables being written use at most half of the soft limit.
+void LoadChannelMgr::_flush_largest_memtables_if_needed() {
+    int64_t limit = _mem_tracker->limit();
+    if (limit <= 0) {
+        return;
+    }
+    int64_t soft_limit = limit * config::load_memtable_flush_soft_limit_percent / 100;
+    if (_mem_tracker->consumption() < soft_limit) {
+        return;
+    }
+    std::unique_lock pick_lock(_flush_pick_lock, std::try_to_lock);
+    if (!pick_lock.owns_lock()) {
+        return;
+    }
+    int64_t now_ms = MonotonicMillis();
+    if (now_ms - _last_flush_pick_ms < kFlushPickIntervalMs) {
+        return;
+    }
+    _last_flush_pick_ms = now_ms;
+
+    std::vector<scoped_refptr<LoadChannel>> channels;
+    {
+        std::lock_guard l(_lock);
+        for (auto& [_, channel] : _load_channels) {
+            channels.emplace_back(channel);
+        }
+    }
+    std::vector<LoadMemTable> memtables;
+    for (auto& channel : channels) {
+        channel->collect_memtables(&memtables);
+    }
+    std::sort(memtables.begin(), memtables.end(),
+              [](const LoadMemTable& l, const LoadMemTable& r) { return l.bytes > r.bytes; });
+    int64_t writing_bytes = 0;
+    for (auto& memtable : memtables) {
+        writing_bytes += memtable.bytes;
+    }
+    int64_t target_bytes = soft_limit / 2;
+    size_t num_flushed = 0;
+    int64_t flushed_bytes = 0;
+    for (auto& memtable : memtables) {
+        if (writing_bytes <= target_bytes) {
+            break;
+        }
+        memtable.writer->flush_memtable_async();
+        writing_bytes -= memtable.bytes;
+        flushed_bytes += memtable.bytes;
+        num_flushed++;
+    }
+    VLOG(1) << "Flush " << num_flushed << " memtables of " << flushed_bytes << " bytes, consumption "
+            << _mem_tracker->consumption() << " soft limit " << soft_limit;
+}
+
 void LoadChannelMgr::cancel(brpc::Controller* cntl, const PTabletWriterCancelRequest& request,
                             PTabletWriterCancelResult* response, google::protobuf::Closure* done) {
     ClosureGuard done_guard(done);
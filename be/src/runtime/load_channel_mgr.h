@@ -70,6 +70,8 @@ private:
 
     scoped_refptr<LoadChannel> _find_load_channel(const UniqueId& load_id);
 
+    void _flush_largest_memtables_if_needed();
+
     // lock protect the load channel map
     std::mutex _lock;
     // load id -> load channel
@@ -78,6 +80,10 @@ private:
     // check the total load mem consumption of this Backend
     MemTracker* _mem_tracker = nullptr;
 
+    // only one add_chunk() picks the memtables to flush at a time
+    std::mutex _flush_pick_lock;
+    int64_t _last_flush_pick_ms = 0;
+
     // thread to clean timeout load channels
     std::thread _load_channels_clean_thread;
     Status _start_load_channels_clean();
@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/mem_arbitrator.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+
+namespace starrocks {
+
+MemArbitrator* MemArbitrator::instance() {
+    static MemArbitrator s_instance;
+    return &s_instance;
+}
+
+Status MemArbitrator::admit(int64_t bytes, int64_t capacity, int64_t timeout_ms) {
+    std::unique_lock<std::mutex> l(_lock);
+    auto can_admit = [&]() { return _reserved_bytes == 0 || _reserved_bytes + bytes <= capacity; };
+    if (!can_admit()) {
+        _num_waiters++;
+        bool admitted = _released_cv.wait_for(l, std::chrono::milliseconds(timeout_ms), can_admit);
+        _num_waiters--;
+        if (!admitted) {
+            return Status::MemoryLimitExceeded(
+                    fmt::format("Timeout waiting for {} bytes of memory, {} of {} bytes are reserved by the running "
+                                "queries",
+                                bytes, _reserved_bytes, capacity));
+        }
+    }
+    _reserved_bytes += bytes;
+    return Status::OK();
+}
+
+void MemArbitrator::release(int64_t bytes) {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _reserved_bytes -= bytes;
+    }
+    _released_cv.notify_all();
+}
+
+} // namespace starrocks
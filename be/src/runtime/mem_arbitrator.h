@@ -0,0 +1,46 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+// MemArbitrator admits the queries of the BE by the memory they reserve, so that the queries are queued when
+// their reservations add up to the capacity, instead of being run together and killed by the hard limit.
+// A query reserves its memory when its first fragment is prepared, and releases it when it's finished.
+// While queries are queued, the spillable operators of the running queries are asked to spill early, which
+// gives back the memory beyond their shares.
+class MemArbitrator {
+public:
+    // The global instance, its capacity is set by the callers of admit().
+    static MemArbitrator* instance();
+
+    // Reserves |bytes| of |capacity|, waiting at most |timeout_ms| for the reservations of the other queries to
+    // be released. A reservation is admitted if no other reservation is held, even if it's larger than the
+    // capacity. Returns MemoryLimitExceeded if it times out.
+    Status admit(int64_t bytes, int64_t capacity, int64_t timeout_ms);
+
+    void release(int64_t bytes);
+
+    // Whether the reservations are waiting for memory, the operators should spill their states if they can.
+    bool is_under_pressure() const { return _num_waiters.load(std::memory_order_relaxed) > 0; }
+
+    int64_t reserved_bytes() const {
+        std::lock_guard<std::mutex> l(_lock);
+        return _reserved_bytes;
+    }
+
+private:
+    mutable std::mutex _lock;
+    std::condition_variable _released_cv;
+    int64_t _reserved_bytes = 0;
+    std::atomic<int32_t> _num_waiters = 0;
+};
+
+} // namespace starrocks
@@ -26,6 +26,7 @@
 #include <sstream>
 
 #include "runtime/memory/chunk_allocator.h"
+#include "runtime/memory/query_arena.h"
 #include "util/bit_util.h"
 #include "util/starrocks_metrics.h"
 
@@ -47,7 +48,9 @@ MemPool::~MemPool() {
     int64_t total_bytes_released = 0;
     for (auto& chunk : chunks_) {
         total_bytes_released += chunk.chunk.size;
-        ChunkAllocator::instance()->free(chunk.chunk);
+        if (arena_ == nullptr) {
+            ChunkAllocator::instance()->free(chunk.chunk);
+        }
     }
     StarRocksMetrics::instance()->memory_pool_bytes_total.increment(-total_bytes_released);
 }
@@ -66,7 +69,9 @@ void MemPool::free_all() {
     int64_t total_bytes_released = 0;
     for (auto& chunk : chunks_) {
         total_bytes_released += chunk.chunk.size;
-        ChunkAllocator::instance()->free(chunk.chunk);
+        if (arena_ == nullptr) {
+            ChunkAllocator::instance()->free(chunk.chunk);
+        }
     }
     chunks_.clear();
     next_chunk_size_ = INITIAL_CHUNK_SIZE;
@@ -118,7 +123,14 @@ bool MemPool::find_chunk(size_t min_size, bool check_limits) {
 
     // Allocate a new chunk. Return early if allocate fails.
     Chunk chunk;
-    if (!ChunkAllocator::instance()->allocate(chunk_size, &chunk)) {
+    if (arena_ != nullptr) {
+        chunk.data = arena_->allocate(chunk_size, alignof(max_align_t));
+        if (chunk.data == nullptr) {
+            return false;
+        }
+        chunk.size = chunk_size;
+        chunk.core_id = -1;
+    } else if (!ChunkAllocator::instance()->allocate(chunk_size, &chunk)) {
         return false;
     }
     ASAN_POISON_MEMORY_REGION(chunk.data, chunk_size);
@@ -140,6 +152,8 @@ bool MemPool::find_chunk(size_t min_size, bool check_limits) {
 
 void MemPool::acquire_data(MemPool* src, bool keep_current) {
     DCHECK(src->check_integrity(false));
+    // the chunks must be returned to where they were allocated from
+    DCHECK_EQ(arena_, src->arena_);
     int num_acquired_chunks;
     if (keep_current) {
         num_acquired_chunks = src->current_chunk_idx_;
@@ -194,6 +208,7 @@ void MemPool::exchange_data(MemPool* other) {
     std::swap(total_reserved_bytes_, other->total_reserved_bytes_);
     std::swap(peak_allocated_bytes_, other->peak_allocated_bytes_);
     std::swap(chunks_, other->chunks_);
+    std::swap(arena_, other->arena_);
 }
 
 std::string MemPool::debug_string() {
@@ -37,6 +37,7 @@
 namespace starrocks {
 
 class MemTracker;
+class QueryArena;
 
 /// A MemPool maintains a list of memory chunks from which it allocates memory in
 /// response to Allocate() calls;
@@ -97,6 +98,10 @@ public:
               total_reserved_bytes_(0),
               peak_allocated_bytes_(0) {}
 
+    /// The chunks are allocated from 'arena' instead of the ChunkAllocator, they are
+    /// only returned with the arena, so the pool must not outlive it.
+    explicit MemPool(QueryArena* arena) : MemPool() { arena_ = arena; }
+
     /// Frees all chunks of memory and subtracts the total allocated bytes
     /// from the registered limits.
     ~MemPool();
@@ -241,6 +246,9 @@ private:
     int64_t peak_allocated_bytes_;
 
     std::vector<ChunkInfo> chunks_;
+
+    /// the arena the chunks are allocated from, nullptr for the ChunkAllocator
+    QueryArena* arena_ = nullptr;
 };
 
 // Stamp out templated implementations here so they're included in IR module
@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/memory/query_arena.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+QueryArena::~QueryArena() {
+    for (const Slab& slab : _slabs) {
+        if (munmap(slab.data, slab.size) != 0) {
+            PLOG(ERROR) << "fail to free the query arena slab via munmap";
+        }
+    }
+    if (_mem_tracker != nullptr && _reserved_bytes > 0) {
+        _mem_tracker->release(_reserved_bytes);
+    }
+}
+
+bool QueryArena::_new_slab(size_t min_size) {
+    size_t size = (std::max(min_size, kSlabSize) + kSlabSize - 1) / kSlabSize * kSlabSize;
+    if (_mem_tracker != nullptr && _mem_tracker->try_consume(size) != nullptr) {
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (data == MAP_FAILED) {
+        PLOG(ERROR) << "fail to allocate the query arena slab via mmap";
+        if (_mem_tracker != nullptr) {
+            _mem_tracker->release(size);
+        }
+        return false;
+    }
+#ifdef MADV_HUGEPAGE
+    if (config::query_arena_use_huge_page && madvise(data, size, MADV_HUGEPAGE) != 0) {
+        VLOG(2) << "fail to back the query arena slab by the huge pages";
+    }
+#endif
+    _slabs.push_back({static_cast<uint8_t*>(data), size});
+    _cur = static_cast<uint8_t*>(data);
+    _end = _cur + size;
+    _reserved_bytes += size;
+    return true;
+}
+
+} // namespace starrocks
@@ -0,0 +1,113 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace starrocks {
+
+class MemTracker;
+
+// QueryArena is a bump allocator for the memory living as long as a fragment instance. The memory is
+// taken from the system in slabs, which are consumed from |mem_tracker| exactly as they are mapped, and
+// all returned at once by the destructor: nothing is freed before.
+//
+// The slabs are backed by the transparent huge pages if config::query_arena_use_huge_page is true, which
+// saves the page faults and the TLB misses of the short queries touching a lot of fresh memory.
+//
+// It's not thread-safe.
+class QueryArena {
+public:
+    // the size of a huge page
+    static constexpr size_t kSlabSize = 2 * 1024 * 1024;
+
+    explicit QueryArena(MemTracker* mem_tracker) : _mem_tracker(mem_tracker) {}
+
+    ~QueryArena();
+
+    QueryArena(const QueryArena&) = delete;
+    QueryArena& operator=(const QueryArena&) = delete;
+
+    // Returns nullptr if a new slab is needed but couldn't be allocated, or if it would exceed the limit of
+    // the mem tracker.
+    uint8_t* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        uintptr_t begin = (reinterpret_cast<uintptr_t>(_cur) + alignment - 1) & ~(alignment - 1);
+        if (_cur == nullptr || begin + size > reinterpret_cast<uintptr_t>(_end)) {
+            if (!_new_slab(size + alignment)) {
+                return nullptr;
+            }
+            begin = (reinterpret_cast<uintptr_t>(_cur) + alignment - 1) & ~(alignment - 1);
+        }
+        _cur = reinterpret_cast<uint8_t*>(begin + size);
+        _allocated_bytes += size;
+        return reinterpret_cast<uint8_t*>(begin);
+    }
+
+    // the bytes returned by allocate()
+    size_t allocated_bytes() const { return _allocated_bytes; }
+
+    // the bytes of the slabs, which are the bytes consumed from the mem tracker
+    size_t reserved_bytes() const { return _reserved_bytes; }
+
+    size_t num_slabs() const { return _slabs.size(); }
+
+private:
+    struct Slab {
+        uint8_t* data;
+        size_t size;
+    };
+
+    // Allocates a slab of at least |min_size| bytes and makes it the current one.
+    bool _new_slab(size_t min_size);
+
+    MemTracker* _mem_tracker;
+    std::vector<Slab> _slabs;
+    // the free range of the current slab
+    uint8_t* _cur = nullptr;
+    uint8_t* _end = nullptr;
+    size_t _allocated_bytes = 0;
+    size_t _reserved_bytes = 0;
+};
+
+// ArenaAllocator is the allocator of the STL containers whose elements are allocated from a QueryArena.
+// The memory is only released with the arena, so the containers must not outlive it.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(QueryArena* arena) : _arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.arena()) {}
+
+    T* allocate(size_t n) {
+        uint8_t* p = _arena->allocate(n * sizeof(T), alignof(T));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return reinterpret_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) {}
+
+    QueryArena* arena() const { return _arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& rhs) const {
+        return _arena == rhs.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& rhs) const {
+        return _arena != rhs.arena();
+    }
+
+private:
+    QueryArena* _arena;
+};
+
+} // namespace starrocks
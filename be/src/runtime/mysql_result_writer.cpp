@@ -25,9 +25,11 @@
 
 #include "column/binary_column.h"
 #include "column/const_column.h"
+#include "column/fixed_length_column.h"
 #include "column/nullable_column.h"
 #include "exprs/expr.h"
 #include "gen_cpp/InternalService_types.h"
+#include "gutil/casts.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/primitive_type.h"
 #include "util/date_func.h"
@@ -37,24 +39,15 @@ namespace starrocks {
 
 MysqlResultWriter::MysqlResultWriter(BufferControlBlock* sinker, const std::vector<ExprContext*>& output_expr_ctxs,
                                      RuntimeProfile* parent_profile)
-        : _sinker(sinker), _output_expr_ctxs(output_expr_ctxs), _row_buffer(nullptr), _parent_profile(parent_profile) {}
+        : _sinker(sinker), _output_expr_ctxs(output_expr_ctxs), _parent_profile(parent_profile) {}
 
-MysqlResultWriter::~MysqlResultWriter() {
-    delete _row_buffer;
-}
+MysqlResultWriter::~MysqlResultWriter() = default;
 
 Status MysqlResultWriter::init(RuntimeState* state) {
     _init_profile();
     if (nullptr == _sinker) {
         return Status::InternalError("sinker is NULL pointer.");
     }
-
-    _row_buffer = new (std::nothrow) MysqlRowBuffer();
-
-    if (nullptr == _row_buffer) {
-        return Status::InternalError("no memory to alloc.");
-    }
-
     return Status::OK();
 }
 
@@ -97,6 +90,103 @@ Status MysqlResultWriter::close() {
     return Status::OK();
 }
 
+template <typename ColumnType>
+static bool put_numbers(const vectorized::Column* data_column, const uint8_t* nulls, MysqlRowBuffer* buffers,
+                        size_t num_rows) {
+    const auto* column = dynamic_cast<const ColumnType*>(data_column);
+    if (column == nullptr) {
+        return false;
+    }
+    const auto& data = column->get_data();
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (nulls != nullptr && nulls[i]) {
+            buffers[i].push_null();
+        } else {
+            buffers[i].push_number(data[i]);
+        }
+    }
+    return true;
+}
+
+static bool put_strings(const vectorized::Column* data_column, const uint8_t* nulls, MysqlRowBuffer* buffers,
+                        size_t num_rows) {
+    const auto* column = dynamic_cast<const vectorized::BinaryColumn*>(data_column);
+    if (column == nullptr) {
+        return false;
+    }
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (nulls != nullptr && nulls[i]) {
+            buffers[i].push_null();
+        } else {
+            buffers[i].push_string(column->get_slice(i));
+        }
+    }
+    return true;
+}
+
+// Append the values of |column| of |type| to the buffers of the rows. The type of the column is dispatched once
+// for all the rows, and the numbers and the strings are formatted without a virtual call for each value.
+static void put_column(const vectorized::Column* column, PrimitiveType type, MysqlRowBuffer* buffers,
+                       size_t num_rows) {
+    if (column->is_constant()) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            column->put_mysql_row_buffer(&buffers[i], i);
+        }
+        return;
+    }
+    const vectorized::Column* data_column = column;
+    const uint8_t* nulls = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable = down_cast<const vectorized::NullableColumn*>(column);
+        data_column = nullable->data_column().get();
+        if (nullable->has_null()) {
+            nulls = nullable->null_column()->get_data().data();
+        }
+    }
+    bool done = false;
+    switch (type) {
+    case TYPE_BOOLEAN:
+        done = put_numbers<vectorized::BooleanColumn>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_TINYINT:
+        done = put_numbers<vectorized::Int8Column>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_SMALLINT:
+        done = put_numbers<vectorized::Int16Column>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_INT:
+        done = put_numbers<vectorized::Int32Column>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_BIGINT:
+        done = put_numbers<vectorized::Int64Column>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_LARGEINT:
+        done = put_numbers<vectorized::Int128Column>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_FLOAT:
+        done = put_numbers<vectorized::FloatColumn>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_DOUBLE:
+        done = put_numbers<vectorized::DoubleColumn>(data_column, nulls, buffers, num_rows);
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        done = put_strings(data_column, nulls, buffers, num_rows);
+        break;
+    default:
+        break;
+    }
+    if (!done) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (nulls != nullptr && nulls[i]) {
+                buffers[i].push_null();
+            } else {
+                data_column->put_mysql_row_buffer(&buffers[i], i);
+            }
+        }
+    }
+}
+
 StatusOr<TFetchDataResultPtr> MysqlResultWriter::process_chunk(vectorized::Chunk* chunk) {
     SCOPED_TIMER(_append_row_batch_timer);
     int num_rows = chunk->num_rows();
@@ -117,18 +207,25 @@ StatusOr<TFetchDataResultPtr> MysqlResultWriter::process_chunk(vectorized::Chunk
         result_columns.emplace_back(std::move(column));
     }
 
-    // Step 2: convert chunk to mysql row format row by row
+    // Step 2: convert chunk to mysql row format a column at a time
     {
-        _row_buffer->reserve(128);
         SCOPED_TIMER(_convert_tuple_timer);
+        _row_buffers.resize(num_rows);
         for (int i = 0; i < num_rows; ++i) {
-            DCHECK_EQ(0, _row_buffer->length());
-            for (auto& result_column : result_columns) {
-                result_column->put_mysql_row_buffer(_row_buffer, i);
-            }
-            size_t len = _row_buffer->length();
-            _row_buffer->move_content(&result_rows[i]);
-            _row_buffer->reserve(len * 1.1);
+            DCHECK_EQ(0, _row_buffers[i].length());
+            _row_buffers[i].reserve(_row_bytes);
+        }
+        for (int i = 0; i < num_columns; ++i) {
+            put_column(result_columns[i].get(), _output_expr_ctxs[i]->root()->type().type, _row_buffers.data(),
+                       num_rows);
+        }
+        size_t total_bytes = 0;
+        for (int i = 0; i < num_rows; ++i) {
+            total_bytes += _row_buffers[i].length();
+            _row_buffers[i].move_content(&result_rows[i]);
+        }
+        if (num_rows > 0) {
+            _row_bytes = total_bytes / num_rows * 1.1 + 1;
         }
     }
     return result;
@@ -21,14 +21,16 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/statusor.h"
 #include "runtime/result_writer.h"
 #include "runtime/runtime_state.h"
+#include "util/mysql_row_buffer.h"
 
 namespace starrocks {
 
 class ExprContext;
-class MysqlRowBuffer;
 class BufferControlBlock;
 class RuntimeProfile;
 using TFetchDataResultPtr = std::unique_ptr<TFetchDataResult>;
@@ -60,7 +62,10 @@ private:
 
     BufferControlBlock* _sinker;
     const std::vector<ExprContext*>& _output_expr_ctxs;
-    MysqlRowBuffer* _row_buffer;
+    // The buffers of the rows of a chunk, which are formatted a column at a time.
+    std::vector<MysqlRowBuffer> _row_buffers;
+    // The average bytes of the rows formatted last, by which the buffers are reserved.
+    size_t _row_bytes = 128;
 
     RuntimeProfile* _parent_profile; // parent profile from result sink. not owned
     // total time cost on append batch opertion
@@ -164,7 +164,7 @@ Status KafkaDataConsumer::assign_topic_partitions(const std::map<int32_t, int64_
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms) {
+Status KafkaDataConsumer::group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms) {
     _last_visit_time = time(nullptr);
     int64_t left_time = max_running_time_ms;
     LOG(INFO) << "start kafka consumer: " << _id << ", grp: " << _grp_id << ", max running time(ms): " << left_time;
@@ -188,39 +188,54 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
         }
 
         bool done = false;
-        // consume 1 message at a time
+        auto batch = std::make_unique<KafkaMessageBatch>();
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        // wait for the first msg only, then take the msgs already fetched without blocking
+        int timeout_ms = 1000;
+        while (!done && batch->size() < kMaxMessagesPerBatch) {
+            std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(timeout_ms));
+            timeout_ms = 0;
+            switch (msg->err()) {
+            case RdKafka::ERR_NO_ERROR:
+                batch->emplace_back(std::move(msg));
+                ++received_rows;
+                continue;
+            case RdKafka::ERR__TIMED_OUT:
+                // leave the status as OK, because this may happend
+                // if there is no data in kafka.
+                if (batch->empty()) {
+                    LOG(INFO) << "kafka consume timeout: " << _id;
+                }
+                break;
+            case RdKafka::ERR_OFFSET_OUT_OF_RANGE: {
+                done = true;
+                std::stringstream ss;
+                ss << msg->errstr() << ", partition " << msg->partition() << " offset " << msg->offset()
+                   << " has no data";
+                LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << ss.str();
+                st = Status::InternalError(ss.str());
+                break;
+            }
+            default:
+                LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << msg->errstr();
+                done = true;
+                st = Status::InternalError(msg->errstr());
+                break;
+            }
+            break;
+        }
         consumer_watch.stop();
-        switch (msg->err()) {
-        case RdKafka::ERR_NO_ERROR:
-            if (!queue->blocking_put(msg.get())) {
+
+        // the msgs consumed before an error are still put, the group commits the offsets of what it receives
+        if (!batch->empty()) {
+            size_t num_msgs = batch->size();
+            if (!queue->blocking_put(batch.get())) {
                 // queue is shutdown
                 done = true;
             } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
+                put_rows += num_msgs;
+                batch.release(); // release the ownership, the batch will be deleted after being processed
             }
-            ++received_rows;
-            break;
-        case RdKafka::ERR__TIMED_OUT:
-            // leave the status as OK, because this may happend
-            // if there is no data in kafka.
-            LOG(INFO) << "kafka consume timeout: " << _id;
-            break;
-        case RdKafka::ERR_OFFSET_OUT_OF_RANGE: {
-            done = true;
-            std::stringstream ss;
-            ss << msg->errstr() << ", partition " << msg->partition() << " offset " << msg->offset() << " has no data";
-            LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << ss.str();
-            st = Status::InternalError(ss.str());
-            break;
-        }
-        default:
-            LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << msg->errstr();
-            done = true;
-            st = Status::InternalError(msg->errstr());
-            break;
         }
 
         left_time = max_running_time_ms - watch.elapsed_time() / 1000 / 1000;
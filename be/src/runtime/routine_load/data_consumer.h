@@ -22,8 +22,10 @@
 #pragma once
 
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -36,6 +38,9 @@ class KafkaConsumerPipe;
 class Status;
 class StreamLoadPipe;
 
+// The messages handed from a consumer to the group at once, in the order they are consumed.
+using KafkaMessageBatch = std::vector<std::unique_ptr<RdKafka::Message>>;
+
 class DataConsumer {
 public:
     DataConsumer(StreamLoadContext* ctx)
@@ -111,6 +116,9 @@ public:
 
 class KafkaDataConsumer : public DataConsumer {
 public:
+    // group_consume() waits for the first msg of a batch only, the rest are the msgs already fetched by librdkafka.
+    static constexpr size_t kMaxMessagesPerBatch = 64;
+
     KafkaDataConsumer(StreamLoadContext* ctx)
             : DataConsumer(ctx), _brokers(ctx->kafka_info->brokers), _topic(ctx->kafka_info->topic) {}
 
@@ -136,8 +144,8 @@ public:
     Status assign_topic_partitions(const std::map<int32_t, int64_t>& begin_partition_offset, const std::string& topic,
                                    StreamLoadContext* ctx);
 
-    // start the consumer and put msgs to queue
-    Status group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    // start the consumer and put the batches of msgs to queue
+    Status group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
@@ -55,10 +55,9 @@ KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
     // clean the msgs left in queue
     _queue.shutdown();
     while (true) {
-        RdKafka::Message* msg;
-        if (_queue.blocking_get(&msg)) {
-            delete msg;
-            msg = nullptr;
+        KafkaMessageBatch* batch;
+        if (_queue.blocking_get(&batch)) {
+            delete batch;
         } else {
             break;
         }
@@ -165,26 +164,32 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             }
         }
 
-        RdKafka::Message* msg;
-        bool res = _queue.blocking_get(&msg);
+        KafkaMessageBatch* batch;
+        bool res = _queue.blocking_get(&batch);
         if (res) {
-            VLOG(3) << "get kafka message"
-                    << ", partition: " << msg->partition() << ", offset: " << msg->offset() << ", len: " << msg->len();
-
-            (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()),
-                                             row_delimiter);
-
-            if (st.ok()) {
+            std::unique_ptr<KafkaMessageBatch> batch_guard(batch);
+            for (const auto& msg : *batch) {
+                VLOG(3) << "get kafka message"
+                        << ", partition: " << msg->partition() << ", offset: " << msg->offset()
+                        << ", len: " << msg->len();
+
+                st = (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()),
+                                                      static_cast<size_t>(msg->len()), row_delimiter);
+                if (!st.ok()) {
+                    // failed to append this msg, we must stop
+                    LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id << ", status: " << st.to_string();
+                    eos = true;
+                    break;
+                }
                 received_rows++;
                 left_bytes -= msg->len();
                 cmt_offset[msg->partition()] = msg->offset();
                 VLOG(3) << "consume partition[" << msg->partition() << " - " << msg->offset() << "]";
-            } else {
-                // failed to append this msg, we must stop
-                LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id;
-                eos = true;
+                if (left_bytes <= 0) {
+                    // the rest msgs of the batch are not committed, they are consumed again by the next task
+                    break;
+                }
             }
-            delete msg;
         } else {
             // queue is empty and shutdown
             eos = true;
@@ -197,7 +202,7 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
 }
 
 void KafkaDataConsumerGroup::actual_consume(const std::shared_ptr<DataConsumer>& consumer,
-                                            TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms,
+                                            TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms,
                                             const ConsumeFinishCallback& cb) {
     Status st = std::static_pointer_cast<KafkaDataConsumer>(consumer)->group_consume(queue, max_running_time_ms);
     cb(st);
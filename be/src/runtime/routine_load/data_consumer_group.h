@@ -67,7 +67,8 @@ protected:
 // for kafka
 class KafkaDataConsumerGroup : public DataConsumerGroup {
 public:
-    KafkaDataConsumerGroup() : _queue(500) {}
+    // Each element of the queue is a batch of at most KafkaDataConsumer::kMaxMessagesPerBatch msgs.
+    KafkaDataConsumerGroup() : _queue(8) {}
 
     ~KafkaDataConsumerGroup() override;
 
@@ -77,12 +78,12 @@ public:
 
 private:
     // start a single consumer
-    void actual_consume(const std::shared_ptr<DataConsumer>& consumer, TimedBlockingQueue<RdKafka::Message*>* queue,
+    void actual_consume(const std::shared_ptr<DataConsumer>& consumer, TimedBlockingQueue<KafkaMessageBatch*>* queue,
                         int64_t max_running_time_ms, const ConsumeFinishCallback& cb);
 
 private:
     // blocking queue to receive msgs from all consumers
-    TimedBlockingQueue<RdKafka::Message*> _queue;
+    TimedBlockingQueue<KafkaMessageBatch*> _queue;
 };
 
 } // end namespace starrocks
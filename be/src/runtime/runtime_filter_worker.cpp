@@ -2,6 +2,9 @@
 
 #include "runtime/runtime_filter_worker.h"
 
+#include <algorithm>
+
+#include "exec/pipeline/pipeline_driver_poller.h"
 #include "exec/pipeline/query_context.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gen_cpp/PlanNodes_types.h"
@@ -12,8 +15,8 @@
 #include "runtime/runtime_state.h"
 #include "service/backend_options.h"
 #include "util/brpc_stub_cache.h"
-#include "util/defer_op.h"
 #include "util/ref_count_closure.h"
+#include "util/starrocks_metrics.h"
 #include "util/thread.h"
 #include "util/time.h"
 
@@ -21,21 +24,24 @@ namespace starrocks {
 
 class RuntimeFilterRpcClosure final : public RefCountClosure<PTransmitRuntimeFilterResult> {
 public:
-    int64_t seq = 0;
+    void Run() override {
+        if (cntl.Failed()) {
+            VLOG_FILE << "transmit runtime filter failed, errmsg=" << cntl.ErrorText();
+        }
+        RefCountClosure<PTransmitRuntimeFilterResult>::Run();
+    }
 };
 
 static const int default_send_rpc_runtime_filter_timeout_ms = 1000;
 
-static void send_rpc_runtime_filter(doris::PBackendService_Stub* stub, RuntimeFilterRpcClosure* rpc_closure,
-                                    int timeout_ms, const PTransmitRuntimeFilterParams& request) {
-    if (rpc_closure->seq != 0) {
-        brpc::Join(rpc_closure->cntl.call_id());
-    }
+// Each rpc has its own closure, which is deleted when the rpc is done, so the rpcs to the different nodes are sent
+// without waiting for the previous ones, and a slow node doesn't delay the rfs of the others.
+static void send_rpc_runtime_filter(doris::PBackendService_Stub* stub, int timeout_ms,
+                                    const PTransmitRuntimeFilterParams& request) {
+    auto* rpc_closure = new RuntimeFilterRpcClosure();
     rpc_closure->ref();
-    rpc_closure->cntl.Reset();
     rpc_closure->cntl.set_timeout_ms(timeout_ms);
     stub->transmit_runtime_filter(&rpc_closure->cntl, &request, &rpc_closure->result, rpc_closure);
-    rpc_closure->seq++;
 }
 
 void RuntimeFilterPort::add_listener(vectorized::RuntimeFilterProbeDescriptor* rf_desc) {
@@ -85,6 +91,7 @@ void RuntimeFilterPort::publish_runtime_filters(std::list<vectorized::RuntimeFil
         finst_id->set_hi(state->fragment_instance_id().hi);
         finst_id->set_lo(state->fragment_instance_id().lo);
         params.set_build_be_number(state->be_number());
+        params.set_build_timestamp(UnixMillis());
 
         // print before setting data, otherwise it's too big.
         VLOG_FILE << "RuntimeFilterPort::publish_runtime_filters. merge_node[0] = " << rf_desc->merge_nodes()[0]
@@ -144,8 +151,7 @@ Status RuntimeFilterMerger::init(const TRuntimeFilterParams& params) {
     return Status::OK();
 }
 
-void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& params,
-                                               RuntimeFilterRpcClosure* rpc_closure) {
+void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& params) {
     DCHECK(params.is_partial());
     int32_t filter_id = params.filter_id();
     int32_t be_number = params.build_be_number();
@@ -202,13 +208,17 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
 
     status->arrives.insert(be_number);
     status->filters.insert(std::make_pair(be_number, rf));
+    if (params.has_build_timestamp() &&
+        (status->build_filter_ts == 0 || params.build_timestamp() < status->build_filter_ts)) {
+        status->build_filter_ts = params.build_timestamp();
+    }
 
     // not ready. still have to wait more filters.
     if (status->filters.size() < status->expect_number) return;
-    _send_total_runtime_filter(filter_id, rpc_closure);
+    _send_total_runtime_filter(filter_id);
 }
 
-void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure) {
+void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id) {
     auto status_it = _statuses.find(filter_id);
     DCHECK(status_it != _statuses.end());
     RuntimeFilterMergerStatus* status = &(status_it->second);
@@ -257,6 +267,9 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
               << ", latency(last-first = " << status->recv_last_filter_ts - status->recv_first_filter_ts
               << ", send-first = " << status->broadcast_filter_ts - status->recv_first_filter_ts << ")";
     request.set_broadcast_timestamp(now);
+    if (status->build_filter_ts != 0) {
+        request.set_build_timestamp(status->build_filter_ts);
+    }
 
     std::map<TNetworkAddress, std::vector<TUniqueId>> nodes_to_frag_insts;
     for (const auto& node : (*target_nodes)) {
@@ -332,7 +345,7 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
         }
 
         index += (1 + half);
-        send_rpc_runtime_filter(stub, rpc_closure, timeout_ms, request);
+        send_rpc_runtime_filter(stub, timeout_ms, request);
     }
 
     // we don't need to hold rf any more.
@@ -451,11 +464,23 @@ static inline Status receive_total_runtime_filter_pipeline(
         }
         fragment_ctx->runtime_filter_port()->receive_shared_runtime_filter(params.filter_id(), shared_rf);
     }
+    // The drivers blocked by this runtime filter may be ready now.
+    starrocks::pipeline::notify_blocked_drivers();
     return Status::OK();
 }
 
-void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterParams& request,
-                                                        RuntimeFilterRpcClosure* rpc_closure) {
+void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterParams& request) {
+    int64_t now = UnixMillis();
+    StarRocksMetrics::instance()->runtime_filter_received_total.increment(1);
+    if (request.has_build_timestamp()) {
+        StarRocksMetrics::instance()->runtime_filter_build_to_arrival_ms_total.increment(
+                std::max<int64_t>(0, now - request.build_timestamp()));
+    }
+    if (request.has_broadcast_timestamp()) {
+        StarRocksMetrics::instance()->runtime_filter_broadcast_to_arrival_ms_total.increment(
+                std::max<int64_t>(0, now - request.broadcast_timestamp()));
+    }
+
     // deserialize once, and all fragment instance shared that runtime filter.
     vectorized::JoinRuntimeFilter* rf = nullptr;
     const std::string& data = request.data();
@@ -509,15 +534,12 @@ void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterPa
         }
 
         index += (1 + half);
-        send_rpc_runtime_filter(stub, rpc_closure, default_send_rpc_runtime_filter_timeout_ms, request);
+        send_rpc_runtime_filter(stub, default_send_rpc_runtime_filter_timeout_ms, request);
     }
 }
 
 void RuntimeFilterWorker::execute() {
     LOG(INFO) << "RuntimeFilterWorker start working.";
-    RuntimeFilterRpcClosure* rpc_closure = new RuntimeFilterRpcClosure();
-    rpc_closure->ref();
-    DeferOp deferop([&] { rpc_closure->Run(); });
 
     for (;;) {
         RuntimeFilterWorkerEvent ev;
@@ -526,7 +548,7 @@ void RuntimeFilterWorker::execute() {
         }
         switch (ev.type) {
         case RECEIVE_TOTAL_RF: {
-            _receive_total_runtime_filter(ev.transmit_rf_request, rpc_closure);
+            _receive_total_runtime_filter(ev.transmit_rf_request);
             break;
         }
 
@@ -561,14 +583,14 @@ void RuntimeFilterWorker::execute() {
                 break;
             }
             RuntimeFilterMerger& merger = it->second;
-            merger.merge_runtime_filter(ev.transmit_rf_request, rpc_closure);
+            merger.merge_runtime_filter(ev.transmit_rf_request);
             break;
         }
 
         case SEND_PART_RF: {
             for (const auto& addr : ev.transmit_addrs) {
                 doris::PBackendService_Stub* stub = _exec_env->brpc_stub_cache()->get_stub(addr);
-                send_rpc_runtime_filter(stub, rpc_closure, ev.transmit_timeout_ms, ev.transmit_rf_request);
+                send_rpc_runtime_filter(stub, ev.transmit_timeout_ms, ev.transmit_rf_request);
             }
             break;
         }
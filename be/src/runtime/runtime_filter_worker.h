@@ -26,7 +26,6 @@ class RuntimeFilterProbeDescriptor;
 class RuntimeFilterBuildDescriptor;
 } // namespace vectorized
 
-class RuntimeFilterRpcClosure;
 // RuntimeFilterPort is bind to a fragment instance
 // and it's to exchange RF(publish/receive) with outside world.
 class RuntimeFilterPort {
@@ -58,7 +57,8 @@ public:
               stop(other.stop),
               recv_first_filter_ts(other.recv_first_filter_ts),
               recv_last_filter_ts(other.recv_last_filter_ts),
-              broadcast_filter_ts(other.broadcast_filter_ts) {}
+              broadcast_filter_ts(other.broadcast_filter_ts),
+              build_filter_ts(other.build_filter_ts) {}
     // which be number send this rf.
     std::unordered_set<int32_t> arrives;
     // how many partitioned rf we expect
@@ -76,6 +76,8 @@ public:
     int64_t recv_first_filter_ts = 0;
     int64_t recv_last_filter_ts = 0;
     int64_t broadcast_filter_ts = 0;
+    // the earliest build timestamp of the partitioned rfs.
+    int64_t build_filter_ts = 0;
 };
 
 // RuntimeFilterMerger is to merge partitioned RF
@@ -84,10 +86,10 @@ class RuntimeFilterMerger {
 public:
     RuntimeFilterMerger(ExecEnv* env, const UniqueId& query_id, const TQueryOptions& query_options, bool is_pipeline);
     Status init(const TRuntimeFilterParams& params);
-    void merge_runtime_filter(PTransmitRuntimeFilterParams& params, RuntimeFilterRpcClosure* rpc_closure);
+    void merge_runtime_filter(PTransmitRuntimeFilterParams& params);
 
 private:
-    void _send_total_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure);
+    void _send_total_runtime_filter(int32_t filter_id);
     // filter_id -> where this filter should send to
     std::map<int32_t, std::vector<TRuntimeFilterProberParams>> _targets;
     std::map<int32_t, RuntimeFilterMergerStatus> _statuses;
@@ -122,7 +124,7 @@ public:
                                   const std::vector<starrocks::TNetworkAddress>& addrs, int timeout_ms);
 
 private:
-    void _receive_total_runtime_filter(PTransmitRuntimeFilterParams& params, RuntimeFilterRpcClosure* rpc_closure);
+    void _receive_total_runtime_filter(PTransmitRuntimeFilterParams& params);
     UnboundedBlockingQueue<RuntimeFilterWorkerEvent> _queue;
     std::unordered_map<TUniqueId, RuntimeFilterMerger> _mergers;
     ExecEnv* _exec_env;
@@ -36,6 +36,7 @@
 #include "runtime/exec_env.h"
 #include "runtime/load_path_mgr.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/memory/query_arena.h"
 #include "runtime/runtime_filter_worker.h"
 #include "util/load_error_hub.h"
 #include "util/pretty_printer.h"
@@ -171,15 +172,26 @@ void RuntimeState::init_mem_trackers(const TUniqueId& query_id) {
                                                       _exec_env->query_pool_mem_tracker());
     _instance_mem_tracker =
             std::make_shared<MemTracker>(_profile.get(), -1, runtime_profile()->name(), _query_mem_tracker.get());
-    _instance_mem_pool = std::make_unique<MemPool>();
+    _init_instance_mem_pool();
 }
 
 Status RuntimeState::init_instance_mem_tracker() {
     _instance_mem_tracker = std::make_unique<MemTracker>(-1);
-    _instance_mem_pool = std::make_unique<MemPool>();
+    _init_instance_mem_pool();
     return Status::OK();
 }
 
+void RuntimeState::_init_instance_mem_pool() {
+    _instance_mem_pool.reset();
+    if (config::enable_query_arena) {
+        _query_arena = std::make_unique<QueryArena>(_instance_mem_tracker.get());
+        _instance_mem_pool = std::make_unique<MemPool>(_query_arena.get());
+    } else {
+        _query_arena.reset();
+        _instance_mem_pool = std::make_unique<MemPool>();
+    }
+}
+
 std::string RuntimeState::error_log() {
     std::lock_guard<std::mutex> l(_error_log_lock);
     return boost::algorithm::join(_error_log, "\n");
@@ -354,6 +366,16 @@ Status RuntimeState::init_load_global_dict(const GlobalDictLists& global_dict_li
     return _build_global_dict(global_dict_list, &_load_global_dicts);
 }
 
+void RuntimeState::add_grouping_slots(const std::vector<SlotId>& slot_ids) {
+    std::lock_guard<std::mutex> l(_grouping_slots_lock);
+    _grouping_slots.insert(slot_ids.begin(), slot_ids.end());
+}
+
+bool RuntimeState::is_grouping_slot(SlotId slot_id) {
+    std::lock_guard<std::mutex> l(_grouping_slots_lock);
+    return _grouping_slots.count(slot_id) > 0;
+}
+
 Status RuntimeState::_build_global_dict(const GlobalDictLists& global_dict_list, vectorized::GlobalDictMaps* result) {
     for (const auto& global_dict : global_dict_list) {
         DCHECK_EQ(global_dict.ids.size(), global_dict.strings.size());
@@ -24,9 +24,11 @@
 #include <atomic>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "cctz/time_zone.h"
@@ -49,6 +51,7 @@ class ExecEnv;
 class Expr;
 class DateTimeValue;
 class MemTracker;
+class QueryArena;
 class DataStreamRecvr;
 class ResultBufferMgr;
 class LoadErrorHub;
@@ -91,6 +94,11 @@ public:
 
     const DescriptorTbl& desc_tbl() const { return *_desc_tbl; }
     void set_desc_tbl(DescriptorTbl* desc_tbl) { _desc_tbl = desc_tbl; }
+    // |desc_tbl| lives in |desc_tbl_pool|, which may be shared with the other queries, see DescriptorTblCache.
+    void set_desc_tbl(DescriptorTbl* desc_tbl, std::shared_ptr<ObjectPool> desc_tbl_pool) {
+        _desc_tbl = desc_tbl;
+        _desc_tbl_pool = std::move(desc_tbl_pool);
+    }
     int chunk_size() const { return _query_options.batch_size; }
     void set_chunk_size(int chunk_size) { _query_options.batch_size = chunk_size; }
     bool abort_on_default_limit_exceeded() const { return _query_options.abort_on_default_limit_exceeded; }
@@ -270,11 +278,18 @@ public:
     Status init_query_global_dict(const GlobalDictLists& global_dict_list);
     Status init_load_global_dict(const GlobalDictLists& global_dict_list);
 
+    // The slots grouped by the aggregations of this fragment instance, the scans record the columns of them as
+    // grouped in the column accesses of the tablets.
+    void add_grouping_slots(const std::vector<SlotId>& slot_ids);
+    bool is_grouping_slot(SlotId slot_id);
+
 private:
     Status create_error_log_file();
 
     Status _build_global_dict(const GlobalDictLists& global_dict_list, vectorized::GlobalDictMaps* result);
 
+    void _init_instance_mem_pool();
+
     static const int DEFAULT_CHUNK_SIZE = 2048;
 
     // put runtime state before _obj_pool, so that it will be deconstructed after
@@ -282,6 +297,7 @@ private:
     std::shared_ptr<RuntimeProfile> _profile;
 
     DescriptorTbl* _desc_tbl = nullptr;
+    std::shared_ptr<ObjectPool> _desc_tbl_pool;
 
     // Lock protecting _error_log and _unreported_error_idx
     std::mutex _error_log_lock;
@@ -333,6 +349,12 @@ private:
     // will not necessarily be set in all error cases.
     std::mutex _process_status_lock;
     Status _process_status;
+
+    std::mutex _grouping_slots_lock;
+    std::unordered_set<SlotId> _grouping_slots;
+    // The chunks of the instance mem pool if config::enable_query_arena is true, it must be released
+    // after the _instance_mem_pool and before the _instance_mem_tracker.
+    std::unique_ptr<QueryArena> _query_arena;
     std::unique_ptr<MemPool> _instance_mem_pool;
 
     // This is the node id of the root node for this plan fragment. This is used as the
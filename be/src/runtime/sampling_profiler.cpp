@@ -0,0 +1,297 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/sampling_profiler.h"
+
+#if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
+#include <gperftools/stacktrace.h>
+#endif
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+
+#include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
+#include "util/bfd_parser.h"
+#include "util/time.h"
+
+// glibc doesn't define the field of the thread id of SIGEV_THREAD_ID.
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace starrocks {
+
+static constexpr int kMaxStackDepth = 32;
+static constexpr size_t kSampleBufferCapacity = 256;
+// The distinct stacks kept of a query, the samples of the others are counted as dropped.
+static constexpr size_t kMaxStacksPerQuery = 10000;
+static constexpr int64_t kCollectIntervalMs = 100;
+
+struct Sample {
+    ThreadExecContext context;
+    int32_t depth = 0;
+    void* pcs[kMaxStackDepth];
+};
+
+// A ring buffer of the samples of a thread: its signal handler is the only producer and the collector the only
+// consumer, so two atomic indexes make it safe to write in the signal handler. The samples are dropped when it's full,
+// which only happens if the collector falls behind by kSampleBufferCapacity samples.
+struct SamplingProfiler::SampleBuffer {
+    Sample samples[kSampleBufferCapacity];
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    timer_t timer{};
+};
+
+static thread_local SamplingProfiler::SampleBuffer* tls_sample_buffer = nullptr;
+
+static void sample_handler(int signo, siginfo_t* info, void* ucontext) {
+    int saved_errno = errno;
+    auto* buffer = tls_sample_buffer;
+    const ThreadExecContext& context = tls_exec_context;
+    if (buffer != nullptr && (context.query_id_hi != 0 || context.query_id_lo != 0)) {
+        uint64_t head = buffer->head.load(std::memory_order_relaxed);
+        if (head - buffer->tail.load(std::memory_order_acquire) < kSampleBufferCapacity) {
+            Sample& sample = buffer->samples[head % kSampleBufferCapacity];
+            sample.context = context;
+#if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
+            // skip the frames of the handler and of the signal trampoline
+            sample.depth = GetStackTrace(sample.pcs, kMaxStackDepth, 2);
+#endif
+            buffer->head.store(head + 1, std::memory_order_release);
+        }
+    }
+    errno = saved_errno;
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    close();
+}
+
+SamplingProfiler* SamplingProfiler::instance() {
+    static SamplingProfiler profiler;
+    return &profiler;
+}
+
+Status SamplingProfiler::init(int32_t frequency, int32_t max_queries) {
+#if defined(ADDRESS_SANITIZER) || defined(LEAK_SANITIZER) || defined(THREAD_SANITIZER)
+    return Status::NotSupported("Sampling profiler is not available with sanitizer builds");
+#else
+    if (frequency <= 0 || max_queries <= 0) {
+        return Status::InvalidArgument(strings::Substitute("Invalid sampling profiler frequency $0 or max queries $1",
+                                                           frequency, max_queries));
+    }
+    _frequency = frequency;
+    _max_queries = max_queries;
+    // a real-time signal, so the samples are queued rather than merged, and SIGPROF is left to /pprof/profile
+    _signal = SIGRTMIN + 4;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = sample_handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(_signal, &action, nullptr) != 0) {
+        return Status::InternalError(strings::Substitute("Fail to install the sampling signal handler: $0", errno));
+    }
+
+    _collector = std::thread([this] { _collect_loop(); });
+    _enabled.store(true, std::memory_order_release);
+    LOG(INFO) << "Sampling profiler is started, frequency=" << frequency << ", max_queries=" << max_queries;
+    return Status::OK();
+#endif
+}
+
+void SamplingProfiler::close() {
+    if (!_enabled.exchange(false)) {
+        return;
+    }
+    _stopped.store(true);
+    if (_collector.joinable()) {
+        _collector.join();
+    }
+}
+
+void SamplingProfiler::register_current_thread() {
+    if (!is_enabled() || tls_sample_buffer != nullptr) {
+        return;
+    }
+    auto buffer = std::make_unique<SampleBuffer>();
+
+    struct sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = _signal;
+    event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &buffer->timer) != 0) {
+        LOG(WARNING) << "Fail to create the sampling timer of the thread: " << errno;
+        return;
+    }
+    struct itimerspec interval;
+    interval.it_interval.tv_sec = 0;
+    interval.it_interval.tv_nsec = 1000L * 1000L * 1000L / _frequency;
+    interval.it_value = interval.it_interval;
+
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        tls_sample_buffer = buffer.get();
+        _buffers.emplace_back(std::move(buffer));
+    }
+    if (timer_settime(tls_sample_buffer->timer, 0, &interval, nullptr) != 0) {
+        LOG(WARNING) << "Fail to start the sampling timer of the thread: " << errno;
+    }
+}
+
+void SamplingProfiler::unregister_current_thread() {
+    auto* buffer = tls_sample_buffer;
+    if (buffer == nullptr) {
+        return;
+    }
+    // the handler of a pending signal finds no buffer
+    tls_sample_buffer = nullptr;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    timer_delete(buffer->timer);
+
+    std::lock_guard<std::mutex> l(_mutex);
+    _drain(buffer);
+    _buffers.erase(std::find_if(_buffers.begin(), _buffers.end(), [buffer](auto& b) { return b.get() == buffer; }));
+}
+
+void SamplingProfiler::_collect_loop() {
+    while (!_stopped.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kCollectIntervalMs));
+        std::lock_guard<std::mutex> l(_mutex);
+        for (auto& buffer : _buffers) {
+            _drain(buffer.get());
+        }
+        _evict_queries();
+    }
+}
+
+void SamplingProfiler::_drain(SampleBuffer* buffer) {
+    int64_t now = MonotonicMillis();
+    uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    for (; tail < head; tail++) {
+        const Sample& sample = buffer->samples[tail % kSampleBufferCapacity];
+        auto& query = _queries[UniqueId(sample.context.query_id_hi, sample.context.query_id_lo)];
+        query.last_sample_time = now;
+
+        std::string key;
+        key.append(reinterpret_cast<const char*>(&sample.context.fragment_instance_id_hi), sizeof(int64_t));
+        key.append(reinterpret_cast<const char*>(&sample.context.fragment_instance_id_lo), sizeof(int64_t));
+        key.append(reinterpret_cast<const char*>(&sample.context.plan_node_id), sizeof(int32_t));
+        key.append(reinterpret_cast<const char*>(sample.pcs), sample.depth * sizeof(void*));
+        auto iter = query.stack_samples.find(key);
+        if (iter != query.stack_samples.end()) {
+            iter->second++;
+        } else if (query.stack_samples.size() < kMaxStacksPerQuery) {
+            query.stack_samples.emplace(std::move(key), 1);
+        } else {
+            query.num_dropped_samples++;
+        }
+    }
+    buffer->tail.store(tail, std::memory_order_release);
+}
+
+void SamplingProfiler::_evict_queries() {
+    while (_queries.size() > static_cast<size_t>(_max_queries)) {
+        auto oldest = std::min_element(_queries.begin(), _queries.end(), [](auto& lhs, auto& rhs) {
+            return lhs.second.last_sample_time < rhs.second.last_sample_time;
+        });
+        _queries.erase(oldest);
+    }
+}
+
+std::vector<UniqueId> SamplingProfiler::list_queries() {
+    std::vector<std::pair<int64_t, UniqueId>> queries;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        for (auto& [query_id, samples] : _queries) {
+            queries.emplace_back(samples.last_sample_time, query_id);
+        }
+    }
+    std::sort(queries.begin(), queries.end(), [](auto& lhs, auto& rhs) { return lhs.first > rhs.first; });
+    std::vector<UniqueId> query_ids;
+    for (auto& [_, query_id] : queries) {
+        query_ids.push_back(query_id);
+    }
+    return query_ids;
+}
+
+Status SamplingProfiler::dump_folded_stacks(const UniqueId& query_id, BfdParser* parser, std::string* output) {
+    std::unordered_map<std::string, int64_t> stack_samples;
+    int64_t num_dropped_samples = 0;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        for (auto& buffer : _buffers) {
+            _drain(buffer.get());
+        }
+        auto iter = _queries.find(query_id);
+        if (iter == _queries.end()) {
+            return Status::NotFound(strings::Substitute("No samples of query $0", query_id.to_string()));
+        }
+        stack_samples = iter->second.stack_samples;
+        num_dropped_samples = iter->second.num_dropped_samples;
+    }
+
+    std::unordered_map<void*, std::string> symbols;
+    auto symbolize = [&](void* pc) -> const std::string& {
+        auto iter = symbols.find(pc);
+        if (iter != symbols.end()) {
+            return iter->second;
+        }
+        // a return address, look up the call instruction before it
+        std::string file_name;
+        std::string func_name;
+        unsigned int lineno = 0;
+        char hex[32];
+        snprintf(hex, sizeof(hex), "0x%lx", reinterpret_cast<uintptr_t>(pc) - 1);
+        const char* end = nullptr;
+        if (parser == nullptr || parser->decode_address(hex, &end, &file_name, &func_name, &lineno) != 0 ||
+            func_name.empty()) {
+            func_name = hex;
+        }
+        // ';' separates the frames in the folded format
+        std::replace(func_name.begin(), func_name.end(), ';', ':');
+        return symbols.emplace(pc, std::move(func_name)).first->second;
+    };
+
+    for (auto& [key, num_samples] : stack_samples) {
+        const char* data = key.data();
+        int64_t fragment_instance_id_hi;
+        int64_t fragment_instance_id_lo;
+        int32_t plan_node_id;
+        memcpy(&fragment_instance_id_hi, data, sizeof(int64_t));
+        memcpy(&fragment_instance_id_lo, data + sizeof(int64_t), sizeof(int64_t));
+        memcpy(&plan_node_id, data + 2 * sizeof(int64_t), sizeof(int32_t));
+        size_t offset = 2 * sizeof(int64_t) + sizeof(int32_t);
+        size_t depth = (key.size() - offset) / sizeof(void*);
+        std::vector<void*> pcs(depth);
+        memcpy(pcs.data(), data + offset, depth * sizeof(void*));
+
+        output->append(UniqueId(fragment_instance_id_hi, fragment_instance_id_lo).to_string());
+        output->append(";plan_node_");
+        output->append(std::to_string(plan_node_id));
+        // the innermost frame is the first one of the stack
+        for (auto iter = pcs.rbegin(); iter != pcs.rend(); ++iter) {
+            output->push_back(';');
+            output->append(symbolize(*iter));
+        }
+        output->push_back(' ');
+        output->append(std::to_string(num_samples));
+        output->push_back('\n');
+    }
+    if (num_dropped_samples > 0) {
+        output->append(strings::Substitute("dropped_samples $0\n", num_dropped_samples));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
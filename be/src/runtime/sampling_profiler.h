@@ -0,0 +1,86 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+class BfdParser;
+
+// SamplingProfiler samples the stacks of the registered threads by their on-CPU time, and tags each sample with the
+// query, the fragment instance and the plan node of the ThreadExecContext of the thread, so that the cost of the
+// process is attributed to the queries and their operators, which the whole process CPU profile of /pprof/profile
+// can't do.
+//
+// Each registered thread has a timer of its thread CPU clock that sends it a signal every 1/frequency second of CPU,
+// so an idle thread costs nothing. The signal handler only copies the stack and the context into a ring buffer of the
+// thread, a collector thread aggregates the buffers into the samples of each query, and the samples of the latest
+// queries are kept until they're dumped in the folded format of the flame graphs. At the default frequency a sample
+// costs a few microseconds every 10ms of CPU, well below 1% of it, so it can be left on.
+class SamplingProfiler {
+public:
+    SamplingProfiler() = default;
+    ~SamplingProfiler();
+
+    static SamplingProfiler* instance();
+
+    // Start to sample the registered threads |frequency| times per second of their CPU time, and keep the samples of
+    // the latest |max_queries| queries.
+    Status init(int32_t frequency, int32_t max_queries);
+    void close();
+
+    bool is_enabled() const { return _enabled.load(std::memory_order_acquire); }
+
+    // Only the registered threads are sampled; a thread must be unregistered before it exits.
+    void register_current_thread();
+    void unregister_current_thread();
+
+    // The queries with samples, the latest sampled first.
+    std::vector<UniqueId> list_queries();
+
+    // Write the samples of |query_id| in the folded format of the flame graphs, one line per distinct stack:
+    // "<fragment_instance_id>;plan_node_<id>;<outermost frame>;...;<innermost frame> <number of samples>",
+    // which flamegraph.pl and speedscope draw directly.
+    Status dump_folded_stacks(const UniqueId& query_id, BfdParser* parser, std::string* output);
+
+    struct SampleBuffer;
+
+private:
+    struct QuerySamples {
+        int64_t last_sample_time = 0;
+        // the fragment instance, the plan node and the stack of the samples, serialized as the key
+        std::unordered_map<std::string, int64_t> stack_samples;
+        int64_t num_dropped_samples = 0;
+    };
+
+    void _collect_loop();
+    // Move the samples of |buffer| into _queries, _mutex must be held.
+    void _drain(SampleBuffer* buffer);
+    // Remove the least recently sampled queries beyond _max_queries, _mutex must be held.
+    void _evict_queries();
+
+    std::atomic<bool> _enabled{false};
+    int32_t _frequency = 0;
+    int32_t _max_queries = 0;
+    int _signal = 0;
+
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<SampleBuffer>> _buffers;
+    std::map<UniqueId, QuerySamples> _queries;
+
+    std::atomic<bool> _stopped{false};
+    std::thread _collector;
+};
+
+} // namespace starrocks
@@ -21,8 +21,10 @@
 
 #include "runtime/snapshot_loader.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 
 #include "common/logging.h"
 #include "env/env.h"
@@ -38,7 +40,10 @@
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "util/file_utils.h"
+#include "util/monotime.h"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -67,6 +72,57 @@ SnapshotLoader::SnapshotLoader(ExecEnv* env, int64_t job_id, int64_t task_id)
 
 SnapshotLoader::~SnapshotLoader() = default;
 
+// Limits the bytes per second transferred by all the snapshot loaders of the BE,
+// see config::snapshot_loader_max_bytes_per_second.
+class TransferThrottle {
+public:
+    static TransferThrottle* instance() {
+        static TransferThrottle s_throttle;
+        return &s_throttle;
+    }
+
+    // Waits until `bytes` more bytes can be transferred.
+    void acquire(int64_t bytes) {
+        int64_t rate = config::snapshot_loader_max_bytes_per_second;
+        if (rate <= 0) {
+            return;
+        }
+        int64_t wait_us = 0;
+        {
+            std::lock_guard l(_mutex);
+            int64_t now_us = MonotonicMicros();
+            // the idle time is saved up for at most one second of burst
+            _next_free_us = std::max(_next_free_us, now_us - 1000000);
+            _next_free_us += bytes * 1000000 / rate;
+            wait_us = _next_free_us - now_us;
+        }
+        if (wait_us > 0) {
+            SleepFor(MonoDelta::FromMicroseconds(wait_us));
+        }
+    }
+
+private:
+    std::mutex _mutex;
+    int64_t _next_free_us = 0;
+};
+
+static StatusOr<int64_t> copy_with_throttle(SequentialFile* src, WritableFile* dest) {
+    constexpr size_t kBufferSize = 1024 * 1024;
+    std::unique_ptr<char[]> buf(new char[kBufferSize]);
+    int64_t ncopy = 0;
+    while (true) {
+        Slice read_buf(buf.get(), kBufferSize);
+        RETURN_IF_ERROR(src->read(&read_buf));
+        if (read_buf.size == 0) {
+            break;
+        }
+        TransferThrottle::instance()->acquire(read_buf.size);
+        ncopy += read_buf.size;
+        RETURN_IF_ERROR(dest->append(read_buf));
+    }
+    return ncopy;
+}
+
 Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_dest_path,
                               const TNetworkAddress& broker_addr, const std::map<std::string, std::string>& broker_prop,
                               std::map<int64_t, std::vector<std::string>>* tablet_files) {
@@ -77,11 +133,35 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
     int tmp_counter = 1;
     RETURN_IF_ERROR(_report_every(0, &tmp_counter, 0, 0, TTaskType::type::UPLOAD));
 
-    Status status = Status::OK();
     // 1. validate local tablet snapshot paths
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, true));
 
-    // 2. get broker client
+    // 2. for each src path, upload it to remote storage
+    // we report to frontend for every 10 files, and we will cancel the job if
+    // the job has already been cancelled in frontend.
+    std::vector<std::pair<std::string, std::string>> paths(src_to_dest_path.begin(), src_to_dest_path.end());
+    std::vector<int64_t> tablet_ids(paths.size());
+    std::vector<std::vector<std::string>> files(paths.size());
+    Progress progress(paths.size(), TTaskType::type::UPLOAD);
+    RETURN_IF_ERROR(_run_in_parallel(paths.size(), &progress, [&](size_t i) {
+        int32_t schema_hash = 0;
+        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(paths[i].first, &tablet_ids[i], &schema_hash));
+        return _upload_tablet(paths[i].first, paths[i].second, broker_addr, broker_prop, &progress, &files[i]);
+    }));
+    for (size_t i = 0; i < paths.size(); ++i) {
+        tablet_files->emplace(tablet_ids[i], std::move(files[i]));
+    }
+
+    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
+    return Status::OK();
+}
+
+Status SnapshotLoader::_upload_tablet(const std::string& src_path, const std::string& dest_path,
+                                      const TNetworkAddress& broker_addr,
+                                      const std::map<std::string, std::string>& broker_prop, Progress* progress,
+                                      std::vector<std::string>* local_files_with_checksum) {
+    // get broker client
+    Status status = Status::OK();
     BrokerServiceConnection client(client_cache(_env), broker_addr, 10000, &status);
     if (!status.ok()) {
         std::stringstream ss;
@@ -91,100 +171,80 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
         return Status::InternalError(ss.str());
     }
 
-    // 3. for each src path, upload it to remote storage
-    // we report to frontend for every 10 files, and we will cancel the job if
-    // the job has already been cancelled in frontend.
-    int report_counter = 0;
-    int total_num = src_to_dest_path.size();
-    int finished_num = 0;
-    for (const auto& iter : src_to_dest_path) {
-        const std::string& src_path = iter.first;
-        const std::string& dest_path = iter.second;
-
-        int64_t tablet_id = 0;
-        int32_t schema_hash = 0;
-        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(src_path, &tablet_id, &schema_hash));
-
-        // 2.1 get existing files from remote path
-        std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_get_existing_files_from_remote(client, dest_path, broker_prop, &remote_files));
+    // 1. get existing files from remote path
+    std::map<std::string, FileStat> remote_files;
+    RETURN_IF_ERROR(_get_existing_files_from_remote(client, dest_path, broker_prop, &remote_files));
 
-        for (auto& tmp : remote_files) {
-            VLOG(2) << "get remote file: " << tmp.first << ", checksum: " << tmp.second.md5;
-        }
+    for (auto& tmp : remote_files) {
+        VLOG(2) << "get remote file: " << tmp.first << ", checksum: " << tmp.second.md5;
+    }
 
-        // 2.2 list local files
-        std::vector<std::string> local_files;
-        std::vector<std::string> local_files_with_checksum;
-        RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &local_files));
+    // 2. list local files
+    std::vector<std::string> local_files;
+    RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &local_files));
 
-        // 2.3 iterate local files
-        for (auto& local_file : local_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::UPLOAD));
+    // 3. iterate local files
+    for (auto& local_file : local_files) {
+        RETURN_IF_ERROR(_report_progress(progress));
 
-            // calc md5sum of localfile
-            std::string md5sum;
-            status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << local_file << ": " << status.get_error_msg();
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG(2) << "get file checksum: " << local_file << ": " << md5sum;
-            local_files_with_checksum.push_back(local_file + "." + md5sum);
-
-            // check if this local file need upload
-            bool need_upload = false;
-            auto find = remote_files.find(local_file);
-            if (find != remote_files.end()) {
-                if (md5sum != find->second.md5) {
-                    // remote storage file exist, but with different checksum
-                    LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << md5sum;
-                    // TODO(cmy): save these files and delete them later
-                    need_upload = true;
-                }
-            } else {
+        // calc md5sum of localfile
+        std::string md5sum;
+        status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
+        if (!status.ok()) {
+            std::stringstream ss;
+            ss << "failed to get md5sum of file: " << local_file << ": " << status.get_error_msg();
+            LOG(WARNING) << ss.str();
+            return Status::InternalError(ss.str());
+        }
+        VLOG(2) << "get file checksum: " << local_file << ": " << md5sum;
+        local_files_with_checksum->push_back(local_file + "." + md5sum);
+
+        // check if this local file need upload
+        bool need_upload = false;
+        auto find = remote_files.find(local_file);
+        if (find != remote_files.end()) {
+            if (md5sum != find->second.md5) {
+                // remote storage file exist, but with different checksum
+                LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << md5sum;
+                // TODO(cmy): save these files and delete them later
                 need_upload = true;
             }
+        } else {
+            need_upload = true;
+        }
 
-            if (!need_upload) {
-                VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
-                continue;
-            }
-
-            // upload
-            // open broker writer. file name end with ".part"
-            // it will be renamed to ".md5sum" after upload finished
-            auto full_remote_file = dest_path + "/" + local_file;
-            auto tmp_broker_file_name = full_remote_file + ".part";
-            auto local_file_path = src_path + "/" + local_file;
+        if (!need_upload) {
+            VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
+            continue;
+        }
 
-            EnvBroker env_broker(broker_addr, broker_prop);
-            std::unique_ptr<WritableFile> broker_file;
-            RETURN_IF_ERROR(env_broker.new_writable_file(tmp_broker_file_name, &broker_file));
+        // upload
+        // open broker writer. file name end with ".part"
+        // it will be renamed to ".md5sum" after upload finished
+        auto full_remote_file = dest_path + "/" + local_file;
+        auto tmp_broker_file_name = full_remote_file + ".part";
+        auto local_file_path = src_path + "/" + local_file;
 
-            std::unique_ptr<SequentialFile> input_file;
-            RETURN_IF_ERROR(Env::Default()->new_sequential_file(local_file_path, &input_file));
+        EnvBroker env_broker(broker_addr, broker_prop);
+        std::unique_ptr<WritableFile> broker_file;
+        RETURN_IF_ERROR(env_broker.new_writable_file(tmp_broker_file_name, &broker_file));
 
-            auto res = FileUtils::copy(input_file.get(), broker_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << *res;
-            RETURN_IF_ERROR(broker_file->close());
-            // rename file to end with ".md5sum"
-            RETURN_IF_ERROR(_rename_remote_file(client, full_remote_file + ".part", full_remote_file + "." + md5sum,
-                                                broker_prop));
-        } // end for each tablet's local files
-
-        tablet_files->emplace(tablet_id, local_files_with_checksum);
-        finished_num++;
-        LOG(INFO) << "finished to write tablet to remote. local path: " << src_path << ", remote path: " << dest_path;
-    } // end for each tablet path
+        std::unique_ptr<SequentialFile> input_file;
+        RETURN_IF_ERROR(Env::Default()->new_sequential_file(local_file_path, &input_file));
 
-    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
-    return status;
+        auto res = copy_with_throttle(input_file.get(), broker_file.get());
+        if (!res.ok()) {
+            return res.status();
+        }
+        LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << *res;
+        RETURN_IF_ERROR(broker_file->close());
+        // rename file to end with ".md5sum"
+        RETURN_IF_ERROR(
+                _rename_remote_file(client, full_remote_file + ".part", full_remote_file + "." + md5sum, broker_prop));
+    } // end for each tablet's local files
+
+    LOG(INFO) << "finished to write tablet to remote. local path: " << src_path << ", remote path: " << dest_path;
+    return Status::OK();
 }
 
 /*
@@ -203,11 +263,32 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
     int tmp_counter = 1;
     RETURN_IF_ERROR(_report_every(0, &tmp_counter, 0, 0, TTaskType::type::DOWNLOAD));
 
-    Status status = Status::OK();
     // 1. validate local tablet snapshot paths
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, false));
 
-    // 2. get broker client
+    std::vector<std::pair<std::string, std::string>> paths(src_to_dest_path.begin(), src_to_dest_path.end());
+    for (const auto& [remote_path, local_path] : paths) {
+        int64_t local_tablet_id = 0;
+        int32_t schema_hash = 0;
+        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(local_path, &local_tablet_id, &schema_hash));
+        downloaded_tablet_ids->push_back(local_tablet_id);
+    }
+
+    // 2. for each src path, download it to local storage
+    Progress progress(paths.size(), TTaskType::type::DOWNLOAD);
+    RETURN_IF_ERROR(_run_in_parallel(paths.size(), &progress, [&](size_t i) {
+        return _download_tablet(paths[i].first, paths[i].second, broker_addr, broker_prop, &progress);
+    }));
+
+    LOG(INFO) << "finished to download snapshots. job: " << _job_id << ", task id: " << _task_id;
+    return Status::OK();
+}
+
+Status SnapshotLoader::_download_tablet(const std::string& remote_path, const std::string& local_path,
+                                        const TNetworkAddress& broker_addr,
+                                        const std::map<std::string, std::string>& broker_prop, Progress* progress) {
+    // get broker client
+    Status status = Status::OK();
     BrokerServiceConnection client(client_cache(_env), broker_addr, 10000, &status);
     if (!status.ok()) {
         std::stringstream ss;
@@ -217,172 +298,218 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         return Status::InternalError(ss.str());
     }
 
-    std::vector<TNetworkAddress> broker_addrs;
-    broker_addrs.push_back(broker_addr);
-    // 3. for each src path, download it to local storage
-    int report_counter = 0;
-    int total_num = src_to_dest_path.size();
-    int finished_num = 0;
-    for (const auto& iter : src_to_dest_path) {
-        const std::string& remote_path = iter.first;
-        const std::string& local_path = iter.second;
-
-        int64_t local_tablet_id = 0;
-        int32_t schema_hash = 0;
-        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(local_path, &local_tablet_id, &schema_hash));
-        downloaded_tablet_ids->push_back(local_tablet_id);
-
-        int64_t remote_tablet_id = 0;
-        RETURN_IF_ERROR(_get_tablet_id_from_remote_path(remote_path, &remote_tablet_id));
-        VLOG(2) << "get local tablet id: " << local_tablet_id << ", schema hash: " << schema_hash
-                << ", remote tablet id: " << remote_tablet_id;
-
-        // 1. get local files
-        std::vector<std::string> local_files;
-        RETURN_IF_ERROR(_get_existing_files_from_local(local_path, &local_files));
+    int64_t local_tablet_id = 0;
+    int32_t schema_hash = 0;
+    RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(local_path, &local_tablet_id, &schema_hash));
 
-        // 2. get remote files
-        std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_get_existing_files_from_remote(client, remote_path, broker_prop, &remote_files));
-        if (remote_files.empty()) {
-            std::stringstream ss;
-            ss << "get nothing from remote path: " << remote_path;
-            LOG(WARNING) << ss.str();
-            return Status::InternalError(ss.str());
-        }
+    int64_t remote_tablet_id = 0;
+    RETURN_IF_ERROR(_get_tablet_id_from_remote_path(remote_path, &remote_tablet_id));
+    VLOG(2) << "get local tablet id: " << local_tablet_id << ", schema hash: " << schema_hash
+            << ", remote tablet id: " << remote_tablet_id;
 
-        TabletSharedPtr tablet = _env->storage_engine()->tablet_manager()->get_tablet(local_tablet_id);
-        if (tablet == nullptr) {
-            std::stringstream ss;
-            ss << "failed to get local tablet: " << local_tablet_id;
-            LOG(WARNING) << ss.str();
-            return Status::InternalError(ss.str());
-        }
-        DataDir* data_dir = tablet->data_dir();
+    // 1. get local files
+    std::vector<std::string> local_files;
+    RETURN_IF_ERROR(_get_existing_files_from_local(local_path, &local_files));
 
-        for (auto& iter : remote_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::DOWNLOAD));
+    // 2. get remote files
+    std::map<std::string, FileStat> remote_files;
+    RETURN_IF_ERROR(_get_existing_files_from_remote(client, remote_path, broker_prop, &remote_files));
+    if (remote_files.empty()) {
+        std::stringstream ss;
+        ss << "get nothing from remote path: " << remote_path;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
 
-            bool need_download = false;
-            const std::string& remote_file = iter.first;
-            const FileStat& file_stat = iter.second;
-            auto find = std::find(local_files.begin(), local_files.end(), remote_file);
-            if (find == local_files.end()) {
-                // remote file does not exist in local, download it
+    TabletSharedPtr tablet = _env->storage_engine()->tablet_manager()->get_tablet(local_tablet_id);
+    if (tablet == nullptr) {
+        std::stringstream ss;
+        ss << "failed to get local tablet: " << local_tablet_id;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    DataDir* data_dir = tablet->data_dir();
+
+    for (auto& iter : remote_files) {
+        RETURN_IF_ERROR(_report_progress(progress));
+
+        bool need_download = false;
+        const std::string& remote_file = iter.first;
+        const FileStat& file_stat = iter.second;
+        auto find = std::find(local_files.begin(), local_files.end(), remote_file);
+        if (find == local_files.end()) {
+            // remote file does not exist in local, download it
+            need_download = true;
+        } else {
+            if (_end_with(remote_file, ".hdr")) {
+                // this is a header file, download it.
                 need_download = true;
             } else {
-                if (_end_with(remote_file, ".hdr")) {
-                    // this is a header file, download it.
+                // check checksum
+                std::string local_md5sum;
+                Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
+                if (!st.ok()) {
+                    LOG(WARNING) << "failed to get md5sum of local file: " << remote_file
+                                 << ". msg: " << st.get_error_msg() << ". download it";
                     need_download = true;
                 } else {
-                    // check checksum
-                    std::string local_md5sum;
-                    Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
-                    if (!st.ok()) {
-                        LOG(WARNING) << "failed to get md5sum of local file: " << remote_file
-                                     << ". msg: " << st.get_error_msg() << ". download it";
+                    VLOG(2) << "get local file checksum: " << remote_file << ": " << local_md5sum;
+                    if (file_stat.md5 != local_md5sum) {
+                        // file's checksum does not equal, download it.
                         need_download = true;
-                    } else {
-                        VLOG(2) << "get local file checksum: " << remote_file << ": " << local_md5sum;
-                        if (file_stat.md5 != local_md5sum) {
-                            // file's checksum does not equal, download it.
-                            need_download = true;
-                        }
                     }
                 }
             }
+        }
 
-            if (!need_download) {
-                LOG(INFO) << "remote file already exist in local, no need to download."
-                          << ", file: " << remote_file;
-                continue;
-            }
+        if (!need_download) {
+            LOG(INFO) << "remote file already exist in local, no need to download."
+                      << ", file: " << remote_file;
+            continue;
+        }
 
-            // begin to download
-            std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
-            std::string local_file_name;
-            // we need to replace the tablet_id in remote file name with local tablet id
-            RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
-            std::string full_local_file = local_path + "/" + local_file_name;
-            LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
-            size_t file_len = file_stat.size;
-
-            // check disk capacity
-            if (data_dir->reach_capacity_limit(file_len)) {
-                return Status::InternalError("capacity limit reached");
-            }
+        // begin to download
+        std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
+        std::string local_file_name;
+        // we need to replace the tablet_id in remote file name with local tablet id
+        RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
+        std::string full_local_file = local_path + "/" + local_file_name;
+        LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
+        size_t file_len = file_stat.size;
+
+        // check disk capacity
+        if (data_dir->reach_capacity_limit(file_len)) {
+            return Status::InternalError("capacity limit reached");
+        }
 
-            EnvBroker env_broker(broker_addr, broker_prop);
-            std::unique_ptr<SequentialFile> broker_file;
-            RETURN_IF_ERROR(env_broker.new_sequential_file(full_remote_file, &broker_file));
+        EnvBroker env_broker(broker_addr, broker_prop);
+        std::unique_ptr<SequentialFile> broker_file;
+        RETURN_IF_ERROR(env_broker.new_sequential_file(full_remote_file, &broker_file));
 
-            // remove file which will be downloaded now.
-            // this file will be added to local_files if it be downloaded successfully.
+        // remove file which will be downloaded now.
+        // this file will be added to local_files if it be downloaded successfully.
+        if (find != local_files.end()) {
             local_files.erase(find);
+        }
 
-            // 3. open local file for write
-            std::unique_ptr<WritableFile> local_file;
-            RETURN_IF_ERROR(Env::Default()->new_writable_file(full_local_file, &local_file));
+        // 3. open local file for write
+        std::unique_ptr<WritableFile> local_file;
+        RETURN_IF_ERROR(Env::Default()->new_writable_file(full_local_file, &local_file));
 
-            auto res = FileUtils::copy(broker_file.get(), local_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            RETURN_IF_ERROR(local_file->close());
-
-            // 5. check md5 of the downloaded file
-            std::string downloaded_md5sum;
-            status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << full_local_file;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG(2) << "get downloaded file checksum: " << full_local_file << ": " << downloaded_md5sum;
-            if (downloaded_md5sum != file_stat.md5) {
-                std::stringstream ss;
-                ss << "invalid md5 of downloaded file: " << full_local_file << ", expected: " << file_stat.md5
-                   << ", get: " << downloaded_md5sum;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
+        auto res = copy_with_throttle(broker_file.get(), local_file.get());
+        if (!res.ok()) {
+            return res.status();
+        }
+        RETURN_IF_ERROR(local_file->close());
 
-            // local_files always keep the updated local files
-            local_files.push_back(local_file_name);
-            LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << file_len;
-        } // end for all remote files
-
-        // finally, delete local files which are not in remote
-        for (const auto& local_file : local_files) {
-            // replace the tablet id in local file name with the remote tablet id,
-            // in order to compare the file name.
-            std::string new_name;
-            Status st = _replace_tablet_id(local_file, remote_tablet_id, &new_name);
-            if (!st.ok()) {
-                LOG(WARNING) << "failed to replace tablet id. unknown local file: " << st.get_error_msg()
-                             << ". ignore it";
-                continue;
-            }
-            VLOG(2) << "new file name after replace tablet id: " << new_name;
-            const auto& find = remote_files.find(new_name);
-            if (find != remote_files.end()) {
-                continue;
-            }
+        // 5. check md5 of the downloaded file
+        std::string downloaded_md5sum;
+        status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
+        if (!status.ok()) {
+            std::stringstream ss;
+            ss << "failed to get md5sum of file: " << full_local_file;
+            LOG(WARNING) << ss.str();
+            return Status::InternalError(ss.str());
+        }
+        VLOG(2) << "get downloaded file checksum: " << full_local_file << ": " << downloaded_md5sum;
+        if (downloaded_md5sum != file_stat.md5) {
+            std::stringstream ss;
+            ss << "invalid md5 of downloaded file: " << full_local_file << ", expected: " << file_stat.md5
+               << ", get: " << downloaded_md5sum;
+            LOG(WARNING) << ss.str();
+            return Status::InternalError(ss.str());
+        }
 
-            // delete
-            std::string full_local_file = local_path + "/" + local_file;
-            VLOG(2) << "begin to delete local snapshot file: " << full_local_file << ", it does not exist in remote";
-            if (remove(full_local_file.c_str()) != 0) {
-                LOG(WARNING) << "failed to delete unknown local file: " << full_local_file << ", ignore it";
-            }
+        // local_files always keep the updated local files
+        local_files.push_back(local_file_name);
+        LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << file_len;
+    } // end for all remote files
+
+    // finally, delete local files which are not in remote
+    for (const auto& local_file : local_files) {
+        // replace the tablet id in local file name with the remote tablet id,
+        // in order to compare the file name.
+        std::string new_name;
+        Status st = _replace_tablet_id(local_file, remote_tablet_id, &new_name);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to replace tablet id. unknown local file: " << st.get_error_msg() << ". ignore it";
+            continue;
+        }
+        VLOG(2) << "new file name after replace tablet id: " << new_name;
+        const auto& find = remote_files.find(new_name);
+        if (find != remote_files.end()) {
+            continue;
         }
 
-        finished_num++;
-    } // end for src_to_dest_path
+        // delete
+        std::string full_local_file = local_path + "/" + local_file;
+        VLOG(2) << "begin to delete local snapshot file: " << full_local_file << ", it does not exist in remote";
+        if (remove(full_local_file.c_str()) != 0) {
+            LOG(WARNING) << "failed to delete unknown local file: " << full_local_file << ", ignore it";
+        }
+    }
+    return Status::OK();
+}
 
-    LOG(INFO) << "finished to download snapshots. job: " << _job_id << ", task id: " << _task_id;
-    return status;
+Status SnapshotLoader::_run_in_parallel(size_t num_tasks, Progress* progress,
+                                        const std::function<Status(size_t)>& task) {
+    std::vector<Status> statuses(num_tasks);
+    auto run = [&](size_t i) {
+        if (progress->failed.load()) {
+            statuses[i] = Status::Cancelled("another tablet of the task failed");
+            return;
+        }
+        statuses[i] = task(i);
+        if (!statuses[i].ok()) {
+            progress->failed.store(true);
+        } else {
+            std::lock_guard l(progress->mutex);
+            progress->finished_num++;
+        }
+    };
+
+    int parallelism = std::min<int64_t>(std::max(config::snapshot_loader_parallelism, 1), num_tasks);
+    std::unique_ptr<ThreadPool> pool;
+    if (parallelism > 1) {
+        Status st = ThreadPoolBuilder("snapshot_loader")
+                            .set_min_threads(0)
+                            .set_max_threads(parallelism)
+                            .build(&pool);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to build the snapshot loader thread pool, the tablets are transferred one by one: "
+                         << st;
+            pool.reset();
+        }
+    }
+    for (size_t i = 0; i < num_tasks; ++i) {
+        if (pool == nullptr || !pool->submit_func([&run, i]() { run(i); }).ok()) {
+            run(i);
+        }
+    }
+    if (pool != nullptr) {
+        pool->wait();
+    }
+
+    // the error failing the task rather than the cancellations it caused
+    for (const auto& st : statuses) {
+        if (!st.ok() && !st.is_cancelled()) {
+            return st;
+        }
+    }
+    for (const auto& st : statuses) {
+        if (!st.ok()) {
+            return st;
+        }
+    }
+    return Status::OK();
+}
+
+Status SnapshotLoader::_report_progress(Progress* progress) {
+    if (progress->failed.load()) {
+        return Status::Cancelled("another tablet of the task failed");
+    }
+    std::lock_guard l(progress->mutex);
+    return _report_every(10, &progress->report_counter, progress->finished_num, progress->total_num, progress->type);
 }
 
 // move the snapshot files in snapshot_path
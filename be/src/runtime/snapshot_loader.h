@@ -21,8 +21,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -49,11 +52,15 @@ struct FileStat {
  *
  * It will try to get the existing files in remote storage,
  * and only upload the incremental part of files.
+ * The tablets are uploaded in parallel, see config::snapshot_loader_parallelism,
+ * and the bandwidth of all the uploads and downloads of a BE is limited by
+ * config::snapshot_loader_max_bytes_per_second.
  *
  * Download:
  * download() will download the romote tablet snapshot files 
  * to local snapshot dir via broker.
  * It will also only download files which does not exist in local dir.
+ * The tablets are downloaded in parallel as the upload.
  *
  * Move:
  * move() is the final step of restore process. it will replace the 
@@ -77,6 +84,34 @@ public:
     Status move(const std::string& snapshot_path, const TabletSharedPtr& tablet, bool overwrite);
 
 private:
+    // The progress of the tablets of a task transferred in parallel.
+    struct Progress {
+        explicit Progress(int total, TTaskType::type task_type) : total_num(total), type(task_type) {}
+
+        std::mutex mutex;
+        int report_counter = 0;
+        int finished_num = 0;
+        int total_num = 0;
+        TTaskType::type type;
+        // set once a tablet fails, the others stop before their next file.
+        std::atomic<bool> failed{false};
+    };
+
+    Status _upload_tablet(const std::string& src_path, const std::string& dest_path, const TNetworkAddress& broker_addr,
+                          const std::map<std::string, std::string>& broker_prop, Progress* progress,
+                          std::vector<std::string>* local_files_with_checksum);
+
+    Status _download_tablet(const std::string& remote_path, const std::string& local_path,
+                            const TNetworkAddress& broker_addr, const std::map<std::string, std::string>& broker_prop,
+                            Progress* progress);
+
+    // Runs task(0), ..., task(num_tasks - 1) by at most config::snapshot_loader_parallelism threads,
+    // and returns the first error of them.
+    Status _run_in_parallel(size_t num_tasks, Progress* progress, const std::function<Status(size_t)>& task);
+
+    // Reports to frontend for every 10 files, and fails if any other tablet of the task has failed.
+    Status _report_progress(Progress* progress);
+
     Status _get_tablet_id_and_schema_hash_from_file_path(const std::string& src_path, int64_t* tablet_id,
                                                          int32_t* schema_hash);
 
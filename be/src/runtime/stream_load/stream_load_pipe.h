@@ -114,8 +114,9 @@ public:
 
     Status read(uint8_t* data, size_t* data_size, bool* eof) override {
         size_t bytes_read = 0;
+        // the buffers already queued are all consumed under one lock
+        std::unique_lock<std::mutex> l(_lock);
         while (bytes_read < *data_size) {
-            std::unique_lock<std::mutex> l(_lock);
             while (!_cancelled && !_finished && _buf_queue.empty()) {
                 _get_cond.wait(l);
             }
@@ -130,13 +131,13 @@ public:
                 *eof = (bytes_read == 0);
                 return Status::OK();
             }
-            auto buf = _buf_queue.front();
+            auto& buf = _buf_queue.front();
             size_t copy_size = std::min(*data_size - bytes_read, buf->remaining());
             buf->get_bytes((char*)data + bytes_read, copy_size);
             bytes_read += copy_size;
             if (!buf->has_remaining()) {
-                _buf_queue.pop_front();
                 _buffered_bytes -= buf->limit;
+                _buf_queue.pop_front();
                 _put_cond.notify_one();
             }
         }
@@ -29,10 +29,13 @@
 #include "common/closure_guard.h"
 #include "exec/tablet_info.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
 #include "runtime/load_channel.h"
 #include "serde/protobuf_serde.h"
 #include "storage/vectorized/delta_writer.h"
 #include "storage/vectorized/memtable.h"
+#include "util/block_compression.h"
+#include "util/faststring.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks {
@@ -207,6 +210,16 @@ void TabletsChannel::add_chunk(brpc::Controller* cntl, const PTabletWriterAddChu
     }
 }
 
+void TabletsChannel::collect_memtables(std::vector<std::pair<AsyncDeltaWriter*, size_t>>* memtables) {
+    // _delta_writers is never changed after the channel is opened.
+    for (auto& [_, delta_writer] : _delta_writers) {
+        size_t bytes = delta_writer->memtable_memory_usage();
+        if (bytes > 0) {
+            memtables->emplace_back(delta_writer.get(), bytes);
+        }
+    }
+}
+
 Status TabletsChannel::_build_chunk_meta(const ChunkPB& pb_chunk) {
     if (_has_chunk_meta.load(std::memory_order_acquire)) {
         return Status::OK();
@@ -322,7 +335,18 @@ StatusOr<scoped_refptr<TabletsChannel::WriteContext>> TabletsChannel::_create_wr
 
     vectorized::Chunk& chunk = context->_chunk;
     serde::ProtobufChunkDeserializer des(_chunk_meta);
-    StatusOr<vectorized::Chunk> res = des.deserialize(pchunk.data());
+    std::string_view data = pchunk.data();
+    faststring uncompressed_buffer;
+    if (pchunk.compress_type() != CompressionTypePB::NO_COMPRESSION) {
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(pchunk.compress_type(), &codec));
+        size_t uncompressed_size = pchunk.uncompressed_size();
+        TRY_CATCH_BAD_ALLOC(uncompressed_buffer.resize(uncompressed_size));
+        Slice output{uncompressed_buffer.data(), uncompressed_size};
+        RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+        data = std::string_view(reinterpret_cast<const char*>(uncompressed_buffer.data()), uncompressed_size);
+    }
+    StatusOr<vectorized::Chunk> res = des.deserialize(data);
     if (!res.ok()) return res.status();
     chunk = std::move(res).value();
     if (UNLIKELY(request.tablet_ids_size() != chunk.num_rows())) {
@@ -97,6 +97,9 @@ public:
 
     MemTracker* mem_tracker() { return _mem_tracker; }
 
+    // Appends the writers of the non-empty memtables and the memory used by their memtables.
+    void collect_memtables(std::vector<std::pair<AsyncDeltaWriter*, size_t>>* memtables);
+
 private:
     using BThreadCountDownLatch = GenericCountDownLatch<bthread::Mutex, bthread::ConditionVariable>;
 
@@ -41,26 +41,31 @@ ChunkCursor::ChunkCursor(ChunkSupplier chunk_supplier, ChunkProbeSupplier chunk_
 ChunkCursor::~ChunkCursor() = default;
 
 bool ChunkCursor::operator<(const ChunkCursor& cursor) const {
-    DCHECK_EQ(_current_order_by_columns.size(), cursor._current_order_by_columns.size());
     // both cursors must be pointing to valid data.
     DCHECK(_current_pos >= 0 && _current_chunk != nullptr);
     DCHECK(cursor._current_pos >= 0 && cursor._current_chunk != nullptr);
+    // the equal records are regarded as ahead.
+    return _compare_at(_current_pos, cursor) <= 0;
+}
+
+bool ChunkCursor::is_next_row_not_after(const ChunkCursor& cursor) const {
+    DCHECK(_current_chunk != nullptr && _current_pos + 1 < _current_chunk->num_rows());
+    DCHECK(cursor._current_pos >= 0 && cursor._current_chunk != nullptr);
+    return _compare_at(_current_pos + 1, cursor) <= 0;
+}
+
+int ChunkCursor::_compare_at(int32_t pos, const ChunkCursor& cursor) const {
+    DCHECK_EQ(_current_order_by_columns.size(), cursor._current_order_by_columns.size());
     const size_t number_of_order_by_columns = _current_order_by_columns.size();
-    bool is_ahead = true;
     for (size_t col_index = 0; col_index < number_of_order_by_columns; ++col_index) {
         const auto& left_col = _current_order_by_columns[col_index];
         const auto& right_col = cursor._current_order_by_columns[col_index];
-        int cmp = left_col->compare_at(_current_pos, cursor._current_pos, *right_col, _null_first_flag[col_index]);
+        int cmp = left_col->compare_at(pos, cursor._current_pos, *right_col, _null_first_flag[col_index]);
         if (cmp != 0) {
-            if (_sort_order_flag[col_index] > 0) {
-                is_ahead = cmp < 0;
-            } else {
-                is_ahead = cmp > 0;
-            }
-            break;
+            return _sort_order_flag[col_index] > 0 ? cmp : -cmp;
         }
     }
-    return is_ahead;
+    return 0;
 }
 
 bool ChunkCursor::is_valid() const {
@@ -36,6 +36,9 @@ public:
 
     // Whether the record referenced by this cursor is before the one referenced by cursor.
     bool operator<(const ChunkCursor& cursor) const;
+    // Whether the next row in the current chunk is not after the record referenced by cursor.
+    // The current chunk must have the next row.
+    bool is_next_row_not_after(const ChunkCursor& cursor) const;
 
     // Move to next row.
     void next();
@@ -60,6 +63,8 @@ public:
 
 private:
     void _reset_with_next_chunk();
+    // Compare the row at pos of the current chunk to the record referenced by cursor, in the sort order.
+    int _compare_at(int32_t pos, const ChunkCursor& cursor) const;
 
 private:
     ChunkSupplier _chunk_supplier;
@@ -140,6 +140,7 @@ Status SortedChunksMerger::get_next(ChunkPtr* chunk, bool* eos) {
     size_t row_number = 1;
 
     std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
+    row_number += take_following_rows(cursor, &selective_values, _state->chunk_size() - row_number);
     cursor->next();
     if (cursor->is_valid()) {
         std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
@@ -159,15 +160,15 @@ Status SortedChunksMerger::get_next(ChunkPtr* chunk, bool* eos) {
             selective_values.push_back(cursor->get_current_position_in_chunk());
         }
 
+        ++row_number;
         std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
+        row_number += take_following_rows(cursor, &selective_values, _state->chunk_size() - row_number);
         cursor->next();
         if (cursor->is_valid()) {
             std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
         } else {
             _min_heap.pop_back();
         }
-
-        ++row_number;
     }
 
     (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
@@ -245,6 +246,7 @@ Status SortedChunksMerger::get_next_for_pipeline(ChunkPtr* chunk, std::atomic<bo
         ++_row_number;
         // we move min-element in the heap and then probe next row in cursor.
         std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
+        _row_number += take_following_rows(_cursor, &_selective_values, _state->chunk_size() - _row_number);
         _wait_for_data = true;
 
         // probe next row.
@@ -278,6 +280,20 @@ void SortedChunksMerger::move_cursor_and_adjust_min_heap(std::atomic<bool>* eos)
         *eos = _min_heap.empty();
     }
 }
+size_t SortedChunksMerger::take_following_rows(ChunkCursor* cursor, std::vector<uint32_t>* selective_values,
+                                               size_t max_rows) {
+    // The cursor has been popped to the back of _min_heap, and the top of the others is _min_heap[0].
+    const ChunkCursor* top = _min_heap.size() > 1 ? _min_heap[0] : nullptr;
+    size_t num_rows = 0;
+    while (num_rows < max_rows && cursor->has_next() && (top == nullptr || cursor->is_next_row_not_after(*top))) {
+        // has_next() keeps the cursor in the current chunk.
+        _is_pipeline ? cursor->next_for_pipeline() : cursor->next();
+        selective_values->push_back(cursor->get_current_position_in_chunk());
+        ++num_rows;
+    }
+    return num_rows;
+}
+
 void SortedChunksMerger::collect_merged_chunks(ChunkPtr* chunk) {
     _result_chunk->append_selective(*_current_chunk, _selective_values.data(), 0, _selective_values.size());
     _result_chunk->set_num_rows(_row_number); // set constant column in chunk with right size.
@@ -38,6 +38,10 @@ private:
     RuntimeState* _state;
     void collect_merged_chunks(ChunkPtr* chunk);
     void move_cursor_and_adjust_min_heap(std::atomic<bool>* eos);
+    // Take the following rows of the popped cursor in its current chunk without adjusting the heap, while they
+    // are not after the other cursors, so a run of rows from one source costs a single heap adjustment.
+    // Return the number of rows taken, at most max_rows.
+    size_t take_following_rows(ChunkCursor* cursor, std::vector<uint32_t>* selective_values, size_t max_rows);
 
     ChunkSupplier _single_supplier;
     ChunkProbeSupplier _single_probe_supplier;
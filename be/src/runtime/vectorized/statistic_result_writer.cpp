@@ -13,6 +13,7 @@
 namespace starrocks::vectorized {
 
 const int STATISTIC_DATA_VERSION1 = 1;
+const int STATISTIC_FULL_COLLECT_VERSION = 2;
 const int DICT_STATISTIC_DATA_VERSION = 101;
 
 StatisticResultWriter::StatisticResultWriter(BufferControlBlock* sinker,
@@ -66,6 +67,8 @@ Status StatisticResultWriter::append_chunk(vectorized::Chunk* chunk) {
         _fill_statistic_data_v1(version, result_columns, chunk, result);
     } else if (version == DICT_STATISTIC_DATA_VERSION) {
         _fill_dict_statistic_data(version, result_columns, chunk, result);
+    } else if (version == STATISTIC_FULL_COLLECT_VERSION) {
+        _fill_full_collect_statistic_data(version, result_columns, chunk, result);
     }
 
     // Step 4: send
@@ -156,6 +159,51 @@ void StatisticResultWriter::_fill_statistic_data_v1(int version, const vectorize
     }
 }
 
+void StatisticResultWriter::_fill_full_collect_statistic_data(int version, const vectorized::Columns& columns,
+                                                              const vectorized::Chunk* chunk,
+                                                              TFetchDataResult* result) {
+    SCOPED_TIMER(_serialize_timer);
+
+    // version, row count, then data size, count distinct, null count, max and min of each column
+    static constexpr size_t kColumnsPerStatistic = 5;
+    DCHECK(columns.size() >= 2 && (columns.size() - 2) % kColumnsPerStatistic == 0);
+    size_t num_statistics = (columns.size() - 2) / kColumnsPerStatistic;
+
+    auto rowCountViewer = ColumnViewer<TYPE_BIGINT>(columns[1]);
+
+    std::vector<TStatisticData> data_list;
+    int num_rows = chunk->num_rows();
+    data_list.resize(num_rows * num_statistics);
+
+    // the statistics of a row are in the order of the columns collected, the FE names them
+    for (size_t k = 0; k < num_statistics; ++k) {
+        size_t base = 2 + k * kColumnsPerStatistic;
+        auto dataSizeViewer = ColumnViewer<TYPE_BIGINT>(columns[base]);
+        auto countDistinctViewer = ColumnViewer<TYPE_BIGINT>(columns[base + 1]);
+        auto nullCountViewer = ColumnViewer<TYPE_BIGINT>(columns[base + 2]);
+        auto maxViewer = ColumnViewer<TYPE_VARCHAR>(columns[base + 3]);
+        auto minViewer = ColumnViewer<TYPE_VARCHAR>(columns[base + 4]);
+
+        for (int i = 0; i < num_rows; ++i) {
+            auto& data = data_list[i * num_statistics + k];
+            data.__set_rowCount(rowCountViewer.value(i));
+            data.__set_dataSize(dataSizeViewer.value(i));
+            data.__set_countDistinct(countDistinctViewer.value(i));
+            data.__set_nullCount(nullCountViewer.value(i));
+            data.__set_max(maxViewer.is_null(i) ? "" : maxViewer.value(i).to_string());
+            data.__set_min(minViewer.is_null(i) ? "" : minViewer.value(i).to_string());
+        }
+    }
+
+    result->result_batch.rows.resize(data_list.size());
+    result->result_batch.__set_statistic_version(version);
+
+    ThriftSerializer serializer(true, chunk->memory_usage());
+    for (size_t i = 0; i < data_list.size(); ++i) {
+        serializer.serialize(&data_list[i], &result->result_batch.rows[i]);
+    }
+}
+
 Status StatisticResultWriter::close() {
     COUNTER_SET(_sent_rows_counter, _written_rows);
     return Status::OK();
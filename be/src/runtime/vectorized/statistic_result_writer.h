@@ -34,6 +34,10 @@ private:
                                  TFetchDataResult* result);
     void _fill_dict_statistic_data(int version, const vectorized::Columns& columns, const vectorized::Chunk* chunk,
                                    TFetchDataResult* result);
+    // Unpivots the statistics of several columns collected by one aggregation into one TStatisticData
+    // per column.
+    void _fill_full_collect_statistic_data(int version, const vectorized::Columns& columns,
+                                           const vectorized::Chunk* chunk, TFetchDataResult* result);
 
 private:
     BufferControlBlock* _sinker;
@@ -171,54 +171,23 @@ void BackendService::open_scanner(TScanOpenResult& result_, const TScanOpenParam
 
 // fetch result from polling the queue, should always maintaince the context offset, otherwise inconsistent result
 void BackendService::get_next(TScanBatchResult& result_, const TScanNextBatchParams& params) {
-    std::string context_id = params.context_id;
-    u_int64_t offset = params.offset;
+    std::string record_batch_str;
+    int64_t num_rows = 0;
+    bool eos = false;
+    Status st = _exec_env->external_scan_context_mgr()->get_next_batch(params.context_id, params.offset,
+                                                                       &record_batch_str, &num_rows, &eos);
     TStatus t_status;
-    std::shared_ptr<ScanContext> context;
-    Status st = _exec_env->external_scan_context_mgr()->get_scan_context(context_id, &context);
-    if (!st.ok()) {
-        st.to_thrift(&t_status);
-        result_.status = t_status;
-        return;
-    }
-    if (offset != context->offset) {
-        LOG(ERROR) << "getNext error: context offset [" << context->offset << " ]"
-                   << " ,client offset [ " << offset << " ]";
-        // invalid offset
-        t_status.status_code = TStatusCode::NOT_FOUND;
-        t_status.error_msgs.push_back(strings::Substitute("context_id=$0, send_offset=$1, context_offset=$2",
-                                                          context_id, offset, context->offset));
-        result_.status = t_status;
-    } else {
-        // during accessing, should disabled last_access_time
-        context->last_access_time = -1;
-        TUniqueId fragment_instance_id = context->fragment_instance_id;
-        std::shared_ptr<arrow::RecordBatch> record_batch;
-        bool eos;
-
-        st = _exec_env->result_queue_mgr()->fetch_result(fragment_instance_id, &record_batch, &eos);
-        if (st.ok()) {
-            result_.__set_eos(eos);
-            if (!eos) {
-                std::string record_batch_str;
-                st = serialize_record_batch(*record_batch, &record_batch_str);
-                st.to_thrift(&t_status);
-                if (st.ok()) {
-                    // avoid copy large string
-                    result_.rows = std::move(record_batch_str);
-                    // set __isset
-                    result_.__isset.rows = true;
-                    context->offset += record_batch->num_rows();
-                }
-            }
-        } else {
-            LOG(WARNING) << "fragment_instance_id [" << print_id(fragment_instance_id) << "] fetch result status ["
-                         << st.to_string() + "]";
-            st.to_thrift(&t_status);
-            result_.status = t_status;
+    st.to_thrift(&t_status);
+    result_.status = t_status;
+    if (st.ok()) {
+        result_.__set_eos(eos);
+        if (!eos) {
+            // avoid copy large string
+            result_.rows = std::move(record_batch_str);
+            // set __isset
+            result_.__isset.rows = true;
         }
     }
-    context->last_access_time = time(nullptr);
 }
 
 void BackendService::close_scanner(TScanCloseResult& result_, const TScanCloseParams& params) {
@@ -23,8 +23,10 @@
 
 #include "gutil/stl_util.h"
 #include "http/action/checksum_action.h"
+#include "http/action/column_access_action.h"
 #include "http/action/compaction_action.h"
 #include "http/action/health_action.h"
+#include "http/action/memory_stats_action.h"
 #include "http/action/meta_action.h"
 #include "http/action/metrics_action.h"
 #include "http/action/pprof_actions.h"
@@ -126,6 +128,10 @@ Status HttpService::start() {
     _ev_http_server->register_handler(HttpMethod::POST, "/pprof/symbol", symbol_action);
     _http_handlers.emplace_back(symbol_action);
 
+    QueryProfileAction* query_profile_action = new QueryProfileAction(_env->bfd_parser());
+    _ev_http_server->register_handler(HttpMethod::GET, "/pprof/query_profile", query_profile_action);
+    _http_handlers.emplace_back(query_profile_action);
+
     // register metrics
     {
         auto action = new MetricsAction(StarRocksMetrics::instance()->metrics());
@@ -167,6 +173,14 @@ Status HttpService::start() {
     _ev_http_server->register_handler(HttpMethod::POST, "/api/compact", run_compaction_action);
     _http_handlers.emplace_back(run_compaction_action);
 
+    ColumnAccessAction* column_access_action = new ColumnAccessAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/column_access/show", column_access_action);
+    _http_handlers.emplace_back(column_access_action);
+
+    MemoryStatsAction* memory_stats_action = new MemoryStatsAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/memory_stats", memory_stats_action);
+    _http_handlers.emplace_back(memory_stats_action);
+
     UpdateConfigAction* update_config_action = new UpdateConfigAction(_env);
     _ev_http_server->register_handler(HttpMethod::POST, "/api/update_config", update_config_action);
     _http_handlers.emplace_back(update_config_action);
@@ -30,17 +30,40 @@
 #include "runtime/buffer_control_block.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/exec_env.h"
+#include "runtime/external_scan_context_mgr.h"
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_channel_mgr.h"
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/brpc.h"
+#include "storage/point_lookup.h"
+#include "util/starrocks_metrics.h"
 #include "util/thrift_util.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 
 namespace starrocks {
 
+// Observe the latency of a rpc when it's responded, which may be long after its handler returns if the request is
+// parked, e.g. by the back pressure of the exchange or of the load channel.
+class LatencyRecordingClosure : public google::protobuf::Closure {
+public:
+    LatencyRecordingClosure(google::protobuf::Closure* done, HistogramMetric* histogram)
+            : _done(done), _histogram(histogram), _start_us(MonotonicMicros()) {}
+
+    void Run() override {
+        _histogram->observe(MonotonicMicros() - _start_us);
+        _done->Run();
+        delete this;
+    }
+
+private:
+    google::protobuf::Closure* _done;
+    HistogramMetric* _histogram;
+    int64_t _start_us;
+};
+
 template <typename T>
 PInternalServiceImpl<T>::PInternalServiceImpl(ExecEnv* exec_env) : _exec_env(exec_env) {}
 
@@ -83,6 +106,7 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
                                              google::protobuf::Closure* done) {
     VLOG_ROW << "transmit data: fragment_instance_id=" << print_id(request->finst_id())
              << " node=" << request->node_id();
+    done = new LatencyRecordingClosure(done, &StarRocksMetrics::instance()->transmit_chunk_rpc_latency_us);
     // NOTE: we should give a default value to response to avoid concurrent risk
     // If we don't give response here, stream manager will call done->Run before
     // transmit_data(), which will cause a dirty memory access.
@@ -99,7 +123,15 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
     }
     Status st;
     st.to_protobuf(response->mutable_status());
-    st = _exec_env->stream_mgr()->transmit_chunk(*request, &done);
+    bool receiver_finished = false;
+    int64_t credit_bytes = -1;
+    st = _exec_env->stream_mgr()->transmit_chunk(*request, &done, &receiver_finished, &credit_bytes);
+    if (receiver_finished) {
+        response->set_receiver_finished(true);
+    }
+    if (credit_bytes >= 0) {
+        response->set_credit_bytes(credit_bytes);
+    }
     if (!st.ok()) {
         LOG(WARNING) << "transmit_data failed, message=" << st.get_error_msg()
                      << ", fragment_instance_id=" << print_id(request->finst_id()) << ", node=" << request->node_id();
@@ -131,6 +163,7 @@ void PInternalServiceImpl<T>::tablet_writer_open(google::protobuf::RpcController
                                                  PTabletWriterOpenResult* response, google::protobuf::Closure* done) {
     VLOG_RPC << "tablet writer open, id=" << print_id(request->id()) << ", index_id=" << request->index_id()
              << ", txn_id=" << request->txn_id();
+    done = new LatencyRecordingClosure(done, &StarRocksMetrics::instance()->tablet_writer_open_rpc_latency_us);
     _exec_env->load_channel_mgr()->open(static_cast<brpc::Controller*>(cntl_base), *request, response, done);
 }
 
@@ -163,6 +196,7 @@ void PInternalServiceImpl<T>::tablet_writer_add_chunk(google::protobuf::RpcContr
                                                       google::protobuf::Closure* done) {
     VLOG_RPC << "tablet writer add chunk, id=" << print_id(request->id()) << ", index_id=" << request->index_id()
              << ", sender_id=" << request->sender_id();
+    done = new LatencyRecordingClosure(done, &StarRocksMetrics::instance()->tablet_writer_add_chunk_rpc_latency_us);
     _exec_env->load_channel_mgr()->add_chunk(static_cast<brpc::Controller*>(cntl_base), *request, response, done);
 }
 
@@ -343,6 +377,39 @@ void PInternalServiceImpl<T>::get_info(google::protobuf::RpcController* controll
     Status::OK().to_protobuf(response->mutable_status());
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::point_lookup(google::protobuf::RpcController* controller,
+                                           const PPointLookupRequest* request, PPointLookupResult* response,
+                                           google::protobuf::Closure* done) {
+    ClosureGuard closure_guard(done);
+    Status st = starrocks::point_lookup(*request, response);
+    if (!st.ok()) {
+        LOG(WARNING) << "point lookup failed, tablet_id=" << request->tablet_id() << ", errmsg=" << st.get_error_msg();
+        response->clear_rows();
+    }
+    st.to_protobuf(response->mutable_status());
+}
+
+template <typename T>
+void PInternalServiceImpl<T>::fetch_arrow_batch(google::protobuf::RpcController* cntl_base,
+                                                const PFetchArrowBatchRequest* request,
+                                                PFetchArrowBatchResult* response, google::protobuf::Closure* done) {
+    ClosureGuard closure_guard(done);
+    auto* cntl = static_cast<brpc::Controller*>(cntl_base);
+    std::string rows;
+    int64_t num_rows = 0;
+    bool eos = false;
+    Status st = _exec_env->external_scan_context_mgr()->get_next_batch(request->context_id(), request->offset(),
+                                                                       &rows, &num_rows, &eos);
+    if (st.ok()) {
+        response->set_eos(eos);
+        response->set_num_rows(num_rows);
+        // the batch is sent in the attachment, so it isn't serialized again by protobuf
+        cntl->response_attachment().append(rows);
+    }
+    st.to_protobuf(response->mutable_status());
+}
+
 template class PInternalServiceImpl<PInternalService>;
 template class PInternalServiceImpl<doris::PBackendService>;
 
@@ -80,6 +80,12 @@ public:
     void get_info(google::protobuf::RpcController* controller, const PProxyRequest* request, PProxyResult* response,
                   google::protobuf::Closure* done) override;
 
+    void point_lookup(google::protobuf::RpcController* controller, const PPointLookupRequest* request,
+                      PPointLookupResult* response, google::protobuf::Closure* done) override;
+
+    void fetch_arrow_batch(google::protobuf::RpcController* controller, const PFetchArrowBatchRequest* request,
+                           PFetchArrowBatchResult* response, google::protobuf::Closure* done) override;
+
 private:
     Status _exec_plan_fragment(brpc::Controller* cntl);
 
@@ -0,0 +1,134 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "simd/simd_dispatch.h"
+
+namespace SIMD {
+
+namespace detail {
+
+// The kernels only move bits, so they work for any trivially copyable type of 4 or 8 bytes.
+template <typename T>
+constexpr bool kGatherable = std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+#ifdef SIMD_AVX512_DISPATCH
+// Returns the number of the gathered rows, the rest in [0, n) are left to the caller.
+template <typename T>
+SIMD_AVX512_TARGET size_t gather_avx512(T* dst, const T* src, const uint32_t* indexes, size_t n) {
+    size_t i = 0;
+    if constexpr (sizeof(T) == 4) {
+        for (; i + 16 <= n; i += 16) {
+            __m512i idx = _mm512_loadu_si512(indexes + i);
+            _mm512_storeu_si512(dst + i, _mm512_i32gather_epi32(idx, src, 4));
+        }
+    } else {
+        for (; i + 8 <= n; i += 8) {
+            __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indexes + i));
+            _mm512_storeu_si512(dst + i, _mm512_i32gather_epi64(idx, src, 8));
+        }
+    }
+    return i;
+}
+
+// Compresses the whole batches of 64 bytes from |*from|, see compress_store().
+template <typename T>
+SIMD_AVX512_TARGET void compress_store_avx512(const uint8_t* filter, T* data, size_t* from, size_t* result,
+                                              size_t to) {
+    constexpr size_t kBatchSize = 64 / sizeof(T);
+    size_t start = *from;
+    size_t end = *result;
+    for (; start + kBatchSize <= to; start += kBatchSize) {
+        uint32_t mask;
+        __m512i values = _mm512_loadu_si512(data + start);
+        __m512i compressed;
+        if constexpr (sizeof(T) == 4) {
+            __m512i f = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(filter + start)));
+            mask = _mm512_test_epi32_mask(f, f);
+            compressed = _mm512_maskz_compress_epi32(mask, values);
+        } else {
+            __m512i f = _mm512_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(filter + start)));
+            mask = _mm512_test_epi64_mask(f, f);
+            compressed = _mm512_maskz_compress_epi64(mask, values);
+        }
+        if (mask == 0) {
+            continue;
+        }
+        // The whole register is stored, which is faster than the masked compress store. It only overwrites
+        // the rows in [end, start + kBatchSize), which have been read already.
+        _mm512_storeu_si512(data + end, compressed);
+        end += __builtin_popcount(mask);
+    }
+    *from = start;
+    *result = end;
+}
+#endif
+
+#ifdef __AVX2__
+template <typename T>
+size_t gather_avx2(T* dst, const T* src, const uint32_t* indexes, size_t n) {
+    size_t i = 0;
+    if constexpr (sizeof(T) == 4) {
+        for (; i + 8 <= n; i += 8) {
+            __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indexes + i));
+            __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), idx, 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), values);
+        }
+    } else {
+        for (; i + 4 <= n; i += 4) {
+            __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indexes + i));
+            __m256i values = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(src), idx, 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), values);
+        }
+    }
+    return i;
+}
+#endif
+
+} // namespace detail
+
+// Gathers dst[i] = src[indexes[i]] for i in [0, n). The gather instructions take signed 32-bit indexes,
+// so the indexes must be less than 2^31, which always holds for the rows of a column.
+template <typename T>
+inline void gather(T* dst, const T* src, const uint32_t* indexes, size_t n) {
+    size_t i = 0;
+    if constexpr (detail::kGatherable<T>) {
+#ifdef SIMD_AVX512_DISPATCH
+        if (cpu_has_avx512f()) {
+            i = detail::gather_avx512(dst, src, indexes, n);
+        }
+#endif
+#ifdef __AVX2__
+        if (i == 0) {
+            i = detail::gather_avx2(dst, src, indexes, n);
+        }
+#endif
+    }
+    for (; i < n; i++) {
+        dst[i] = src[indexes[i]];
+    }
+}
+
+// Moves the rows of data in [*from, to) whose filter is nonzero to *result, keeping their order, like the
+// loop of ColumnHelper::filter_range(). Only the whole batches the CPU can compress at once are handled,
+// *from and *result are advanced past them and the rest is left to the caller.
+template <typename T>
+inline void compress_store(const uint8_t* filter, T* data, size_t* from, size_t* result, size_t to) {
+#ifdef SIMD_AVX512_DISPATCH
+    if constexpr (detail::kGatherable<T>) {
+        if (cpu_has_avx512f()) {
+            detail::compress_store_avx512(filter, data, from, result, to);
+        }
+    }
+#endif
+}
+
+} // namespace SIMD
@@ -26,17 +26,74 @@
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
+#ifdef __x86_64__
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "simd/simd_dispatch.h"
 
 namespace SIMD {
 
+namespace detail {
+
+#ifdef SIMD_AVX512_DISPATCH
+// Counts the zeros of the whole batches of 64 bytes, the rest are left to the caller.
+SIMD_AVX512BW_TARGET inline size_t count_zero_avx512(const int8_t* data, size_t size) {
+    size_t count = 0;
+    const int8_t* end64 = data + (size / 64 * 64);
+    for (; data < end64; data += 64) {
+        __mmask64 mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(data), _mm512_setzero_si512());
+        count += __builtin_popcountll(mask);
+    }
+    return count;
+}
+
+// Writes the indexes of the whole batches of 16 bytes, see SIMD::to_index().
+template <typename IndexType>
+SIMD_AVX512_TARGET size_t to_index_avx512(const uint8_t* filter, size_t size, IndexType base, IndexType* indexes,
+                                          size_t* processed) {
+    size_t count = 0;
+    size_t i = 0;
+    __m512i idx = _mm512_add_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                   _mm512_set1_epi32(static_cast<int32_t>(base)));
+    const __m512i step = _mm512_set1_epi32(16);
+    for (; i + 16 <= size; i += 16) {
+        __m512i f = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(filter + i)));
+        __mmask16 mask = _mm512_test_epi32_mask(f, f);
+        __m512i selected = _mm512_maskz_compress_epi32(mask, idx);
+        // The whole register is stored, it's within the first i + 16 indexes, which the caller has room for.
+        if constexpr (sizeof(IndexType) == 4) {
+            _mm512_storeu_si512(indexes + count, selected);
+        } else {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(indexes + count), _mm512_cvtepi32_epi16(selected));
+        }
+        count += __builtin_popcount(mask);
+        idx = _mm512_add_epi32(idx, step);
+    }
+    *processed = i;
+    return count;
+}
+#endif
+
+} // namespace detail
+
 // Count the number of zeros of 8-bit signed integers.
 inline size_t count_zero(const int8_t* data, size_t size) {
     size_t count = 0;
     const int8_t* end = data + size;
 
+#ifdef SIMD_AVX512_DISPATCH
+    if (cpu_has_avx512bw()) {
+        count = detail::count_zero_avx512(data, size);
+        data += size / 64 * 64;
+    }
+#endif
+
 #if defined(__SSE2__) && defined(__POPCNT__)
     const __m128i zero16 = _mm_setzero_si128();
-    const int8_t* end64 = data + (size / 64 * 64);
+    const int8_t* end64 = data + ((end - data) / 64 * 64);
 
     for (; data < end64; data += 64) {
         count += __builtin_popcountll(static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
@@ -51,6 +108,13 @@ inline size_t count_zero(const int8_t* data, size_t size) {
                                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), zero16)))
                                        << 48u));
     }
+#elif defined(__aarch64__)
+    const int8_t* end16 = data + (size / 16 * 16);
+    const uint8x16_t one16 = vdupq_n_u8(1);
+    for (; data < end16; data += 16) {
+        // 0xff for the zeros, at most 16 ones are summed up, which fits in a byte
+        count += vaddvq_u8(vandq_u8(vceqzq_s8(vld1q_s8(data)), one16));
+    }
 #endif
 
     for (; data < end; ++data) {
@@ -94,4 +158,23 @@ inline size_t count_nonzero(const std::vector<int8_t>& list) {
     return count_nonzero(list.data(), list.size());
 }
 
+// Writes base + i for the nonzero filter[i] in [0, size) to |indexes| in order, and returns their number.
+// |indexes| must have room for |size| indexes.
+template <typename IndexType>
+inline size_t to_index(const uint8_t* filter, size_t size, IndexType base, IndexType* indexes) {
+    static_assert(sizeof(IndexType) == 2 || sizeof(IndexType) == 4, "only 16-bit and 32-bit indexes");
+    size_t count = 0;
+    size_t i = 0;
+#ifdef SIMD_AVX512_DISPATCH
+    if (cpu_has_avx512f()) {
+        count = detail::to_index_avx512(filter, size, base, indexes, &i);
+    }
+#endif
+    for (; i < size; i++) {
+        indexes[count] = static_cast<IndexType>(base + i);
+        count += (filter[i] != 0);
+    }
+    return count;
+}
+
 } // namespace SIMD
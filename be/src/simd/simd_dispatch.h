@@ -0,0 +1,36 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+// The kernels of simd/ are picked by the CPU the BE runs on, not only by the flags it's built with. The
+// binaries target AVX2 at most, the AVX-512 kernels are compiled for their own target with
+// SIMD_AVX512_TARGET and only called if the CPU supports them. The NEON kernels are always available on
+// aarch64, so they are chosen at build time.
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SIMD_AVX512_DISPATCH
+#define SIMD_AVX512_TARGET __attribute__((target("avx512f")))
+#define SIMD_AVX512BW_TARGET __attribute__((target("avx512f,avx512bw")))
+#define SIMD_BMI2_TARGET __attribute__((target("bmi2")))
+#endif
+
+namespace SIMD {
+
+#ifdef SIMD_AVX512_DISPATCH
+// The features are detected once, the first time they are asked for.
+inline bool cpu_has_avx512f() {
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+
+inline bool cpu_has_avx512bw() {
+    static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    return supported;
+}
+
+inline bool cpu_has_bmi2() {
+    static const bool supported = __builtin_cpu_supports("bmi2");
+    return supported;
+}
+#endif
+
+} // namespace SIMD
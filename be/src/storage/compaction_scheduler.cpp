@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/compaction_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// the query load may change without anyone releasing a task, so the waiting tasks check it periodically.
+static constexpr auto kRecheckInterval = std::chrono::seconds(1);
+
+CompactionScheduler::CompactionScheduler(BusyFunc is_busy) : _is_busy(std::move(is_busy)) {}
+
+bool CompactionScheduler::_can_run(const DiskState& disk, uint64_t ticket) const {
+    if (disk.waiting.front() != ticket) {
+        return false;
+    }
+    int32_t max_per_disk = config::compaction_max_tasks_per_disk;
+    if (max_per_disk > 0 && disk.num_running >= max_per_disk) {
+        return false;
+    }
+    int32_t max_under_load = config::compaction_max_tasks_under_query_load;
+    if (max_under_load >= 0 && _is_busy != nullptr && _num_running >= std::max(max_under_load, 1) && _is_busy()) {
+        return false;
+    }
+    return true;
+}
+
+bool CompactionScheduler::acquire(const std::string& path) {
+    int64_t start_us = MonotonicMicros();
+    std::unique_lock l(_mutex);
+    if (_stopped) {
+        return false;
+    }
+    auto& disk = _disks[path];
+    uint64_t ticket = _next_ticket++;
+    disk.waiting.push_back(ticket);
+    _num_waiting++;
+    _update_metrics();
+    while (!_stopped && !_can_run(disk, ticket)) {
+        _cv.wait_for(l, kRecheckInterval);
+    }
+    _num_waiting--;
+    if (_stopped) {
+        disk.waiting.erase(std::find(disk.waiting.begin(), disk.waiting.end(), ticket));
+        _update_metrics();
+        return false;
+    }
+    // the waiters are always admitted from the front
+    disk.waiting.pop_front();
+    disk.num_running++;
+    _num_running++;
+    _update_metrics();
+    StarRocksMetrics::instance()->compaction_wait_duration_us.increment(MonotonicMicros() - start_us);
+    // the next waiter of the disk may be admitted too
+    _cv.notify_all();
+    return true;
+}
+
+void CompactionScheduler::release(const std::string& path) {
+    std::lock_guard l(_mutex);
+    auto& disk = _disks[path];
+    DCHECK_GT(disk.num_running, 0);
+    DCHECK_GT(_num_running, 0);
+    disk.num_running--;
+    _num_running--;
+    _update_metrics();
+    _cv.notify_all();
+}
+
+void CompactionScheduler::stop() {
+    std::lock_guard l(_mutex);
+    _stopped = true;
+    _cv.notify_all();
+}
+
+size_t CompactionScheduler::num_running() const {
+    std::lock_guard l(_mutex);
+    return _num_running;
+}
+
+size_t CompactionScheduler::num_waiting() const {
+    std::lock_guard l(_mutex);
+    return _num_waiting;
+}
+
+void CompactionScheduler::_update_metrics() {
+    StarRocksMetrics::instance()->compaction_running_tasks.set_value(_num_running);
+    StarRocksMetrics::instance()->compaction_waiting_tasks.set_value(_num_waiting);
+}
+
+} // namespace starrocks
@@ -0,0 +1,62 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace starrocks {
+
+// CompactionScheduler admits the tasks of the base, cumulative and update compaction threads, so that
+// they share the budgets of the disks and the CPU instead of each picking work on its own.
+// - At most config::compaction_max_tasks_per_disk tasks run on a disk, the tasks waiting for the same
+//   disk are admitted in the order they arrived.
+// - While the queries are busy, as told by |is_busy|, at most config::compaction_max_tasks_under_query_load
+//   tasks run in total.
+class CompactionScheduler {
+public:
+    using BusyFunc = std::function<bool()>;
+
+    explicit CompactionScheduler(BusyFunc is_busy);
+
+    CompactionScheduler(const CompactionScheduler&) = delete;
+    CompactionScheduler& operator=(const CompactionScheduler&) = delete;
+
+    // Blocks until a task on the disk |path| may run, returns false if the scheduler is stopped.
+    // Every successful acquire() must be paired with a release() of the same disk.
+    bool acquire(const std::string& path);
+
+    void release(const std::string& path);
+
+    // Wakes up the waiting tasks, acquire() fails from now on.
+    void stop();
+
+    size_t num_running() const;
+    size_t num_waiting() const;
+
+private:
+    struct DiskState {
+        size_t num_running = 0;
+        // tickets of the waiting tasks, in the order they arrived
+        std::deque<uint64_t> waiting;
+    };
+
+    bool _can_run(const DiskState& disk, uint64_t ticket) const;
+    void _update_metrics();
+
+    BusyFunc _is_busy;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::unordered_map<std::string, DiskState> _disks;
+    size_t _num_running = 0;
+    size_t _num_waiting = 0;
+    uint64_t _next_ticket = 0;
+    bool _stopped = false;
+};
+
+} // namespace starrocks
@@ -37,6 +37,7 @@
 #include <fstream>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 
 #include "env/env.h"
@@ -55,7 +56,9 @@
 #include "util/errno.h"
 #include "util/file_utils.h"
 #include "util/monotime.h"
+#include "util/stopwatch.hpp"
 #include "util/string_util.h"
+#include "util/threadpool.h"
 
 using strings::Substitute;
 
@@ -420,20 +423,62 @@ std::string DataDir::get_root_path_from_schema_hash_path_in_trash(const std::str
 // TODO(ygl): deal with rowsets and tablets when load failed
 Status DataDir::load() {
     LOG(INFO) << "start to load tablets from " << _path;
+    MonotonicStopWatch watch;
+    watch.start();
+    // the metas are deserialized and registered by a pool, the tablets of a shard of TabletManager by the same
+    // task, so that the tasks don't contend for the shard locks
+    std::unique_ptr<ThreadPool> load_pool;
+    if (config::load_tablet_meta_thread_num_per_data_dir > 1) {
+        Status st = ThreadPoolBuilder("load_tablet_meta")
+                            .set_min_threads(1)
+                            .set_max_threads(config::load_tablet_meta_thread_num_per_data_dir)
+                            .build(&load_pool);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the pool loading the tablet metas, load them serially: " << st;
+    }
+    // Call |func| for each index in [0, n), in parallel by the pool if there is one.
+    auto parallel_for = [&load_pool](size_t n, const std::function<void(size_t)>& func) {
+        if (load_pool == nullptr) {
+            for (size_t i = 0; i < n; i++) {
+                func(i);
+            }
+            return;
+        }
+        size_t batch_size = std::max<size_t>(1, n / (load_pool->max_threads() * 8));
+        for (size_t begin = 0; begin < n; begin += batch_size) {
+            size_t end = std::min(n, begin + batch_size);
+            auto task = [&func, begin, end] {
+                for (size_t i = begin; i < end; i++) {
+                    func(i);
+                }
+            };
+            if (!load_pool->submit_func(task).ok()) {
+                task();
+            }
+        }
+        load_pool->wait();
+    };
+
     // load rowset meta from meta env and create rowset
     // COMMITTED: add to txn manager
     // VISIBLE: add to tablet
     // if one rowset load failed, then the total data dir will not be loaded
-    std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
     LOG(INFO) << "begin loading rowset from meta";
-    auto load_rowset_func = [&dir_rowset_metas](const TabletUid& tablet_uid, RowsetId rowset_id,
+    std::vector<std::pair<RowsetId, std::string>> rowset_meta_strs;
+    auto load_rowset_func = [&rowset_meta_strs](const TabletUid& tablet_uid, RowsetId rowset_id,
                                                 const std::string& meta_str) -> bool {
+        rowset_meta_strs.emplace_back(rowset_id, meta_str);
+        return true;
+    };
+    Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_kv_store, load_rowset_func);
+
+    std::vector<RowsetMetaSharedPtr> dir_rowset_metas(rowset_meta_strs.size());
+    parallel_for(rowset_meta_strs.size(), [&](size_t i) {
         RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
-        bool parsed = rowset_meta->init(meta_str);
+        bool parsed = rowset_meta->init(rowset_meta_strs[i].second);
         if (!parsed) {
-            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
-            // return false will break meta iterator, return true to skip this error
-            return true;
+            // skip this error
+            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_meta_strs[i].first;
+            return;
         }
         if (rowset_meta->rowset_type() == ALPHA_ROWSET) {
             LOG(FATAL) << "must change V1 format to V2 format."
@@ -441,10 +486,11 @@ Status DataDir::load() {
                        << ", schema_hash: " << rowset_meta->tablet_schema_hash()
                        << ", rowset_id:" << rowset_meta->rowset_id();
         }
-        dir_rowset_metas.push_back(rowset_meta);
-        return true;
-    };
-    Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_kv_store, load_rowset_func);
+        dir_rowset_metas[i] = std::move(rowset_meta);
+    });
+    rowset_meta_strs.clear();
+    rowset_meta_strs.shrink_to_fit();
+    int64_t load_rowset_meta_ns = watch.elapsed_time();
 
     if (!load_rowset_status.ok()) {
         LOG(WARNING) << "errors when load rowset meta from meta env, skip this data dir:" << _path;
@@ -455,28 +501,45 @@ Status DataDir::load() {
     // load tablet
     // create tablet from tablet meta and add it to tablet mgr
     LOG(INFO) << "begin loading tablet from meta";
-    std::set<int64_t> tablet_ids;
-    std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](int64_t tablet_id, int32_t schema_hash,
-                                                                    const std::string& value) -> bool {
-        Status st =
-                _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value, false, false, false, false);
-        if (!st.ok() && !st.is_not_found()) {
-            // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
-            // This may happen when the tablet was just deleted before the BE restarted,
-            // but it has not been cleared from rocksdb. At this time, restarting the BE
-            // will read the tablet in the DELETE state from rocksdb. These tablets have been
-            // added to the garbage collection queue and will be automatically deleted afterwards.
-            // Therefore, we believe that this situation is not a failure.
-            LOG(WARNING) << "load tablet from header failed. status:" << st.to_string() << ", tablet=" << tablet_id
-                         << "." << schema_hash;
-            failed_tablet_ids.insert(tablet_id);
-        } else {
-            tablet_ids.insert(tablet_id);
-        }
+    struct TabletHeader {
+        int64_t tablet_id;
+        int32_t schema_hash;
+        std::string value;
+    };
+    std::vector<std::vector<TabletHeader>> shard_headers(_tablet_manager->num_shards());
+    auto load_tablet_func = [this, &shard_headers](int64_t tablet_id, int32_t schema_hash,
+                                                   const std::string& value) -> bool {
+        shard_headers[_tablet_manager->shard_index(tablet_id)].push_back({tablet_id, schema_hash, value});
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_kv_store, load_tablet_func);
+
+    std::mutex tablet_ids_lock;
+    std::set<int64_t> tablet_ids;
+    std::set<int64_t> failed_tablet_ids;
+    parallel_for(shard_headers.size(), [&](size_t shard) {
+        for (const TabletHeader& header : shard_headers[shard]) {
+            Status st = _tablet_manager->load_tablet_from_meta(this, header.tablet_id, header.schema_hash,
+                                                               header.value, false, false, false, false);
+            std::lock_guard l(tablet_ids_lock);
+            if (!st.ok() && !st.is_not_found()) {
+                // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
+                // This may happen when the tablet was just deleted before the BE restarted,
+                // but it has not been cleared from rocksdb. At this time, restarting the BE
+                // will read the tablet in the DELETE state from rocksdb. These tablets have been
+                // added to the garbage collection queue and will be automatically deleted afterwards.
+                // Therefore, we believe that this situation is not a failure.
+                LOG(WARNING) << "load tablet from header failed. status:" << st.to_string()
+                             << ", tablet=" << header.tablet_id << "." << header.schema_hash;
+                failed_tablet_ids.insert(header.tablet_id);
+            } else {
+                tablet_ids.insert(header.tablet_id);
+            }
+        }
+    });
+    shard_headers.clear();
+    int64_t load_tablet_ns = watch.elapsed_time() - load_rowset_meta_ns;
+
     if (failed_tablet_ids.size() != 0) {
         LOG(ERROR) << "load tablets from header failed"
                    << ", loaded tablet: " << tablet_ids.size() << ", error tablet: " << failed_tablet_ids.size()
@@ -499,54 +562,73 @@ Status DataDir::load() {
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    for (const auto& rowset_meta : dir_rowset_metas) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id(), false);
-        // tablet maybe dropped, but not drop related rowset meta
-        if (tablet == nullptr) {
-            // LOG(WARNING) << "could not find tablet id: " << rowset_meta->tablet_id()
-            //              << ", schema hash: " << rowset_meta->tablet_schema_hash()
-            //              << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
-            continue;
+    // the rowsets of a tablet are added in order by the same task
+    std::unordered_map<int64_t, std::vector<RowsetMetaSharedPtr>> tablet_rowset_metas;
+    for (auto& rowset_meta : dir_rowset_metas) {
+        if (rowset_meta != nullptr) {
+            tablet_rowset_metas[rowset_meta->tablet_id()].push_back(std::move(rowset_meta));
         }
-        RowsetSharedPtr rowset;
-        Status create_status = RowsetFactory::create_rowset(&tablet->tablet_schema(), tablet->schema_hash_path(),
-                                                            rowset_meta, &rowset);
-        if (!create_status.ok()) {
-            LOG(WARNING) << "Fail to create rowset from rowsetmeta,"
-                         << " rowset=" << rowset_meta->rowset_id() << " type=" << rowset_meta->rowset_type()
-                         << " state=" << rowset_meta->rowset_state();
-            continue;
+    }
+    dir_rowset_metas.clear();
+    std::vector<std::vector<RowsetMetaSharedPtr>*> rowset_meta_groups;
+    rowset_meta_groups.reserve(tablet_rowset_metas.size());
+    for (auto& [tablet_id, rowset_metas] : tablet_rowset_metas) {
+        rowset_meta_groups.push_back(&rowset_metas);
+    }
+    parallel_for(rowset_meta_groups.size(), [&](size_t i) {
+        for (const auto& rowset_meta : *rowset_meta_groups[i]) {
+            _add_rowset_from_meta(rowset_meta);
         }
-        if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
-            rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            Status commit_txn_status = _txn_manager->commit_txn(
-                    _kv_store, rowset_meta->partition_id(), rowset_meta->txn_id(), rowset_meta->tablet_id(),
-                    rowset_meta->tablet_schema_hash(), rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
-            if (!commit_txn_status.ok() && !commit_txn_status.is_already_exist()) {
-                LOG(WARNING) << "Fail to add committed rowset=" << rowset_meta->rowset_id()
-                             << " tablet=" << rowset_meta->tablet_id() << " txn=" << rowset_meta->txn_id();
-            } else {
-                LOG(INFO) << "Added committed rowset=" << rowset_meta->rowset_id()
-                          << " tablet=" << rowset_meta->tablet_id()
-                          << " schema hash=" << rowset_meta->tablet_schema_hash() << " txn=" << rowset_meta->txn_id();
-            }
-        } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
-                   rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            Status publish_status = tablet->add_rowset(rowset, false);
-            if (!publish_status.ok() && !publish_status.is_already_exist()) {
-                LOG(WARNING) << "Fail to add visible rowset=" << rowset->rowset_id()
-                             << " to tablet=" << rowset_meta->tablet_id() << " txn id=" << rowset_meta->txn_id()
-                             << " start version=" << rowset_meta->version().first
-                             << " end version=" << rowset_meta->version().second;
-            }
+    });
+    int64_t add_rowset_ns = watch.elapsed_time() - load_rowset_meta_ns - load_tablet_ns;
+
+    LOG(INFO) << "Loaded data dir " << _path << " in " << watch.elapsed_time() / 1000000
+              << "ms, rowset metas: " << load_rowset_meta_ns / 1000000 << "ms, tablets: " << load_tablet_ns / 1000000
+              << "ms, rowsets: " << add_rowset_ns / 1000000 << "ms";
+    return Status::OK();
+}
+
+void DataDir::_add_rowset_from_meta(const RowsetMetaSharedPtr& rowset_meta) {
+    TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id(), false);
+    // tablet maybe dropped, but not drop related rowset meta
+    if (tablet == nullptr) {
+        return;
+    }
+    RowsetSharedPtr rowset;
+    Status create_status = RowsetFactory::create_rowset(&tablet->tablet_schema(), tablet->schema_hash_path(),
+                                                        rowset_meta, &rowset);
+    if (!create_status.ok()) {
+        LOG(WARNING) << "Fail to create rowset from rowsetmeta,"
+                     << " rowset=" << rowset_meta->rowset_id() << " type=" << rowset_meta->rowset_type()
+                     << " state=" << rowset_meta->rowset_state();
+        return;
+    }
+    if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED && rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        Status commit_txn_status = _txn_manager->commit_txn(
+                _kv_store, rowset_meta->partition_id(), rowset_meta->txn_id(), rowset_meta->tablet_id(),
+                rowset_meta->tablet_schema_hash(), rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
+        if (!commit_txn_status.ok() && !commit_txn_status.is_already_exist()) {
+            LOG(WARNING) << "Fail to add committed rowset=" << rowset_meta->rowset_id()
+                         << " tablet=" << rowset_meta->tablet_id() << " txn=" << rowset_meta->txn_id();
         } else {
-            LOG(WARNING) << "Found invalid rowset=" << rowset_meta->rowset_id()
-                         << " tablet id=" << rowset_meta->tablet_id() << " tablet uid=" << rowset_meta->tablet_uid()
-                         << " schema hash=" << rowset_meta->tablet_schema_hash() << " txn=" << rowset_meta->txn_id()
-                         << " current valid tablet uid=" << tablet->tablet_uid();
+            LOG(INFO) << "Added committed rowset=" << rowset_meta->rowset_id() << " tablet=" << rowset_meta->tablet_id()
+                      << " schema hash=" << rowset_meta->tablet_schema_hash() << " txn=" << rowset_meta->txn_id();
         }
+    } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
+               rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        Status publish_status = tablet->add_rowset(rowset, false);
+        if (!publish_status.ok() && !publish_status.is_already_exist()) {
+            LOG(WARNING) << "Fail to add visible rowset=" << rowset->rowset_id()
+                         << " to tablet=" << rowset_meta->tablet_id() << " txn id=" << rowset_meta->txn_id()
+                         << " start version=" << rowset_meta->version().first
+                         << " end version=" << rowset_meta->version().second;
+        }
+    } else {
+        LOG(WARNING) << "Found invalid rowset=" << rowset_meta->rowset_id() << " tablet id=" << rowset_meta->tablet_id()
+                     << " tablet uid=" << rowset_meta->tablet_uid()
+                     << " schema hash=" << rowset_meta->tablet_schema_hash() << " txn=" << rowset_meta->txn_id()
+                     << " current valid tablet uid=" << tablet->tablet_uid();
     }
-    return Status::OK();
 }
 
 // gc unused tablet schemahash dir
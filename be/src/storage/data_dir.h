@@ -23,6 +23,7 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -37,6 +38,7 @@
 
 namespace starrocks {
 
+class RowsetMeta;
 class Tablet;
 class TabletManager;
 class TabletMeta;
@@ -129,6 +131,9 @@ private:
     Status _write_cluster_id_to_path(const std::string& path, int32_t cluster_id);
     Status _add_version_info_to_cluster_id(const std::string& path);
 
+    // Add the rowset of |rowset_meta| loaded by load() to its tablet, or to the TxnManager if it's committed.
+    void _add_rowset_from_meta(const std::shared_ptr<RowsetMeta>& rowset_meta);
+
     void _process_garbage_path(const std::string& path);
 
     bool _stop_bg_worker = false;
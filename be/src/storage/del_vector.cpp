@@ -2,9 +2,12 @@
 
 #include "del_vector.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
+#include "util/coding.h"
 #include "util/raw_container.h"
 #include "util/starrocks_metrics.h"
 
@@ -41,6 +44,19 @@ void DelVector::add_dels_as_new_version(const std::vector<uint32_t>& dels, int64
     tmp->_version = version;
     tmp->_loaded = true;
     tmp->_add_dels(dels);
+    // a long chain of deltas makes loading slow, save the whole bitmap once in a while
+    if (_loaded && _version < version &&
+        _delta_chain < std::max(0, config::update_del_vector_max_delta_chain)) {
+        auto delta = std::make_unique<Roaring>();
+        delta->addMany(dels.size(), dels.data());
+        delta->runOptimize();
+        if (delta->getSizeInBytes() * 4 < tmp->_roaring->getSizeInBytes()) {
+            tmp->_delta = std::move(delta);
+            tmp->_base_version = _version;
+            tmp->_delta_chain = _delta_chain + 1;
+            tmp->_memory_usage += tmp->_delta->getSizeInBytes();
+        }
+    }
     tmp.swap(*pdelvec);
 }
 
@@ -48,13 +64,30 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     if (length < 1) {
         return Status::Corruption("zero length");
     }
-    if (*data != 0x01) {
+    _base_version = -1;
+    _delta_chain = 0;
+    _delta.reset();
+    if (*data == 0x02) {
+        if (length < 1 + sizeof(int64_t)) {
+            return Status::Corruption("invalid delta");
+        }
+        _base_version = decode_fixed64_le(reinterpret_cast<const uint8_t*>(data + 1));
+        if (_base_version >= version) {
+            return Status::Corruption(
+                    strings::Substitute("invalid base version $0 of version $1", _base_version, version));
+        }
+        _delta_chain = 1;
+        data += 1 + sizeof(int64_t);
+        length -= 1 + sizeof(int64_t);
+    } else if (*data == 0x01) {
+        data += 1;
+        length -= 1;
+    } else {
         return Status::Corruption("invalid flag");
     }
-    data += 1;
-    length -= 1;
     _loaded = true;
     _version = version;
+    _roaring.reset();
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(Roaring::readSafe(data, length));
     }
@@ -62,6 +95,26 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     return Status::OK();
 }
 
+Status DelVector::merge_base(const DelVector& base) {
+    if (base.version() != _base_version) {
+        return Status::Corruption(strings::Substitute("delta of version $0 is based on version $1, but got version $2",
+                                                      _version, _base_version, base.version()));
+    }
+    if (base._roaring) {
+        if (_roaring) {
+            *_roaring |= *base._roaring;
+        } else {
+            _roaring = std::make_unique<Roaring>(*base._roaring);
+        }
+    }
+    _base_version = base._base_version;
+    if (_base_version >= 0) {
+        _delta_chain++;
+    }
+    _update_stats();
+    return Status::OK();
+}
+
 void DelVector::init(int64_t version, const uint32_t* data, size_t length) {
     _loaded = true;
     _version = version;
@@ -82,6 +135,19 @@ string DelVector::save() const {
     return ret;
 }
 
+string DelVector::save_delta_or_full() const {
+    if (!_delta) {
+        return save();
+    }
+    string ret;
+    auto roaring_size = _delta->getSizeInBytes();
+    ret.resize(1 + sizeof(int64_t) + roaring_size);
+    ret[0] = 0x02; // one byte flag.
+    encode_fixed64_le(reinterpret_cast<uint8_t*>(ret.data() + 1), _base_version);
+    _delta->write(ret.data() + 1 + sizeof(int64_t));
+    return ret;
+}
+
 string DelVector::to_string() const {
     return strings::Substitute("version:$0 $1", _version, _roaring ? _roaring->toString() : string("null"));
 }
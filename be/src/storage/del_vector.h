@@ -13,6 +13,8 @@ namespace starrocks {
 // Each DelVector is associated with a version, which is EditVersion's majar version.
 // Serialization format:
 // |<format version (currently 0x01)> 1 byte|serialized roaring bitmap|
+// A version can also be saved as a delta of an earlier version, it's only the ids added since then:
+// |0x02 1 byte|base version 8 bytes|serialized roaring bitmap of the added ids|
 class DelVector {
 public:
     DelVector();
@@ -25,7 +27,8 @@ public:
 
     void set_empty();
 
-    // create a new DelVector based on this delvec and add more deleted ids
+    // create a new DelVector based on this delvec and add more deleted ids,
+    // the new one can be saved as a delta of this one if the delta is small.
     void add_dels_as_new_version(const std::vector<uint32_t>& dels, int64_t version,
                                  std::shared_ptr<DelVector>* pdelvec) const;
 
@@ -33,12 +36,30 @@ public:
 
     size_t memory_usage() const { return _memory_usage; }
 
+    // Loads a serialized DelVector. If it's a delta, only the ids added since base_version() are loaded,
+    // the earlier versions must be merged by merge_base() until base_version() becomes -1.
     Status load(int64_t version, const char* data, size_t length);
 
+    // Merges the loaded version |base_version()| into this delta.
+    Status merge_base(const DelVector& base);
+
+    // The version this loaded delta is based on, -1 if it has all the deleted ids.
+    int64_t base_version() const { return _base_version; }
+
+    // Number of the deltas between this version and the last version saved in whole.
+    uint32_t delta_chain() const { return _delta_chain; }
+
     void init(int64_t version, const uint32_t* data, size_t length);
 
+    // Serializes all the deleted ids.
     std::string save() const;
 
+    // Serializes only the ids added since the version this one is created from if the delta is small,
+    // otherwise the same as save().
+    std::string save_delta_or_full() const;
+
+    static bool is_delta(const char* data, size_t length) { return length > 0 && data[0] == 0x02; }
+
     std::string to_string() const;
 
     bool empty() const { return !_roaring; }
@@ -55,6 +76,10 @@ private:
     size_t _cardinality = 0;
     size_t _memory_usage = 0;
     std::unique_ptr<Roaring> _roaring;
+    // set when it's created as a new version, the ids added to the version |_base_version|
+    std::unique_ptr<Roaring> _delta;
+    int64_t _base_version = -1;
+    uint32_t _delta_chain = 0;
 };
 
 typedef std::shared_ptr<DelVector> DelVectorPtr;
@@ -167,6 +167,10 @@ public:
     // If an error was encountered, returns a non-OK status.
     virtual Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Hints that the 'size' bytes beginning from 'offset' will be read soon, so that
+    // the following reads of them don't have to wait for the device.
+    virtual Status readahead(uint64_t offset, size_t size) const { return Status::OK(); }
+
     // Returns the memory usage of this object including the object itself.
     // virtual size_t memory_footprint() const = 0;
 };
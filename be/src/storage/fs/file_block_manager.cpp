@@ -268,6 +268,8 @@ public:
 
     Status readv(uint64_t offset, const Slice* results, size_t res_cnt) const override;
 
+    Status readahead(uint64_t offset, size_t size) const override;
+
     void handle_error(const Status& s) const;
 
 private:
@@ -341,6 +343,11 @@ Status FileReadableBlock::read(uint64_t offset, Slice result) const {
     return readv(offset, &result, 1);
 }
 
+Status FileReadableBlock::readahead(uint64_t offset, size_t size) const {
+    DCHECK(!_closed.load());
+    return _file->readahead(offset, size);
+}
+
 Status FileReadableBlock::readv(uint64_t offset, const Slice* results, size_t res_cnt) const {
     DCHECK(!_closed.load());
 
@@ -389,6 +396,7 @@ Status FileBlockManager::create_block(const CreateBlockOptions& opts, std::uniqu
     shared_ptr<WritableFile> writer;
     WritableFileOptions wr_opts;
     wr_opts.mode = opts.mode;
+    wr_opts.direct_io = config::enable_direct_io_write;
     RETURN_IF_ERROR(env_util::open_file_for_write(wr_opts, _env, opts.path, &writer));
 
     VLOG(1) << "Creating new block at " << opts.path;
@@ -26,6 +26,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <map>
 
@@ -96,6 +97,20 @@ void HyperLogLog::update(uint64_t hash_value) {
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t n) {
+    size_t i = 0;
+    for (; i < n && (_type == HLL_DATA_EMPTY || _type == HLL_DATA_EXPLICIT); ++i) {
+        if (hash_values[i] != 0) {
+            update(hash_values[i]);
+        }
+    }
+    for (; i < n; ++i) {
+        if (hash_values[i] != 0) {
+            _update_registers(hash_values[i]);
+        }
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -367,15 +382,22 @@ int64_t HyperLogLog::estimate_cardinality() const {
         alpha = 0.7213f / (1 + 1.079f / num_streams);
     }
 
+    // The table holds powf(2.0f, -r) for every register value r, so the sum is
+    // the same as calling powf per register.
+    static const auto inverse_powers = [] {
+        std::array<float, 256> powers;
+        for (int r = 0; r < powers.size(); ++r) {
+            powers[r] = std::ldexp(1.0f, -r);
+        }
+        return powers;
+    }();
+
     float harmonic_mean = 0;
     int num_zero_registers = 0;
 
     for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0f, -_registers.data[i]);
-
-        if (_registers.data[i] == 0) {
-            ++num_zero_registers;
-        }
+        harmonic_mean += inverse_powers[_registers.data[i]];
+        num_zero_registers += (_registers.data[i] == 0);
     }
 
     harmonic_mean = 1.0f / harmonic_mean;
@@ -165,6 +165,11 @@ public:
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Add |n| hash values to this HLL value, the zero hash values are skipped.
+    // Once the registers are built, the values are absorbed into them without
+    // checking the type per value.
+    void update_batch(const uint64_t* hash_values, size_t n);
+
     void merge(const HyperLogLog& other);
 
     // Return max size of serialized binary
@@ -21,19 +21,25 @@
 
 #include "storage/kv_store.h"
 
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/logging.h"
 #include "rocksdb/db.h"
+#include "rocksdb/filter_policy.h"
+#include "rocksdb/listener.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/slice_transform.h"
+#include "rocksdb/table.h"
 #include "storage/olap_define.h"
 #include "storage/rocksdb_status_adapter.h"
 #include "util/runtime_profile.h"
 #include "util/starrocks_metrics.h"
+#include "util/time.h"
 
 using rocksdb::DB;
 using rocksdb::DBOptions;
@@ -51,6 +57,34 @@ const std::string META_POSTFIX = "/meta"; // NOLINT
 const std::string SECOND_POSTFIX = "_secondary";
 const size_t PREFIX_LENGTH = 4;
 
+// Counts the write stalls of the column families, which delay or stop all the writes of the meta store, e.g. the
+// publish of the versions, when the compaction of RocksDB falls behind.
+class WriteStallListener : public rocksdb::EventListener {
+public:
+    void OnStallConditionsChanged(const rocksdb::WriteStallInfo& info) override {
+        using rocksdb::WriteStallCondition;
+        if (info.condition.prev == WriteStallCondition::kNormal) {
+            StarRocksMetrics::instance()->meta_write_stall_total.increment(1);
+            std::lock_guard l(_mutex);
+            _stall_start_us[info.cf_name] = MonotonicMicros();
+        } else if (info.condition.cur == WriteStallCondition::kNormal) {
+            std::lock_guard l(_mutex);
+            auto iter = _stall_start_us.find(info.cf_name);
+            if (iter != _stall_start_us.end()) {
+                StarRocksMetrics::instance()->meta_write_stall_duration_us.increment(MonotonicMicros() -
+                                                                                     iter->second);
+                _stall_start_us.erase(iter);
+            }
+        }
+        LOG(WARNING) << "write stall condition of column family " << info.cf_name << " changed from "
+                     << static_cast<int>(info.condition.prev) << " to " << static_cast<int>(info.condition.cur);
+    }
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<std::string, int64_t> _stall_start_us;
+};
+
 KVStore::KVStore(std::string root_path) : _root_path(std::move(root_path)), _db(nullptr) {}
 
 KVStore::~KVStore() {
@@ -69,6 +103,10 @@ Status KVStore::init(bool read_only) {
     options.IncreaseParallelism();
     options.create_if_missing = true;
     options.create_missing_column_families = true;
+    // the writes of many concurrent publish tasks are grouped, the WAL write of a group overlaps with the memtable
+    // write of the previous group
+    options.enable_pipelined_write = true;
+    options.listeners.emplace_back(std::make_shared<WriteStallListener>());
     std::string db_path = _root_path + META_POSTFIX;
 
     // The index of each column family must be consistent with the enum `ColumnFamilyIndex`
@@ -78,6 +116,12 @@ Status KVStore::init(bool read_only) {
     cf_descs[1].name = STARROCKS_COLUMN_FAMILY;
     cf_descs[2].name = META_COLUMN_FAMILY;
     cf_descs[2].options.prefix_extractor.reset(NewFixedPrefixTransform(PREFIX_LENGTH));
+    // the tablet metas and the rowset metas are read by point lookups, the bloom filters of the whole keys let
+    // them skip the files without the key
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+    table_options.whole_key_filtering = true;
+    cf_descs[2].options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
     static_assert(NUM_COLUMN_FAMILY_INDEX == 3);
 
     rocksdb::Status s;
@@ -157,6 +157,8 @@ LRUCache::LRUCache() {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected_lru.next = &_protected_lru;
+    _protected_lru.prev = &_protected_lru;
 }
 
 LRUCache::~LRUCache() {
@@ -183,6 +185,31 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
     e->next->prev = e;
 }
 
+void LRUCache::_protect(LRUHandle* e) {
+    if (_protected_capacity > 0 && !e->in_protected) {
+        e->in_protected = true;
+        _protected_usage += e->charge;
+    }
+}
+
+void LRUCache::_unprotect(LRUHandle* e) {
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->charge;
+    }
+}
+
+// Moves the least recently used entries not in use of the protected segment back to the probationary
+// one until the protected segment fits in its capacity.
+void LRUCache::_demote_protected() {
+    while (_protected_usage > _protected_capacity && _protected_lru.next != &_protected_lru) {
+        LRUHandle* old = _protected_lru.next;
+        _lru_remove(old);
+        _unprotect(old);
+        _lru_append(&_lru, old);
+    }
+}
+
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
     std::lock_guard l(_mutex);
     ++_lookup_count;
@@ -196,6 +223,8 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        _protect(e);
+        _demote_protected();
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -217,12 +246,13 @@ void LRUCache::release(Cache::Handle* handle) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
                 e->in_cache = false;
+                _unprotect(e);
                 _unref(e);
                 _usage -= e->charge;
                 last_ref = true;
             } else {
-                // put it to LRU free list
-                _lru_append(&_lru, e);
+                // put it to LRU free list of its segment
+                _lru_append(e->in_protected ? &_protected_lru : &_lru, e);
             }
         }
     }
@@ -234,23 +264,27 @@ void LRUCache::release(Cache::Handle* handle) {
 }
 
 void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
-    // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
-        LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
-            cur = cur->next;
-            continue;
+    // 1. evict normal cache entries, the probationary ones before the protected ones
+    for (LRUHandle* list : {&_lru, &_protected_lru}) {
+        LRUHandle* cur = list;
+        while (_usage + charge > _capacity && cur->next != list) {
+            LRUHandle* old = cur->next;
+            if (old->priority == CachePriority::DURABLE) {
+                cur = cur->next;
+                continue;
+            }
+            _evict_one_entry(old);
+            deleted->push_back(old);
         }
-        _evict_one_entry(old);
-        deleted->push_back(old);
     }
     // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
+    for (LRUHandle* list : {&_lru, &_protected_lru}) {
+        while (_usage + charge > _capacity && list->next != list) {
+            LRUHandle* old = list->next;
+            DCHECK(old->priority == CachePriority::DURABLE);
+            _evict_one_entry(old);
+            deleted->push_back(old);
+        }
     }
 }
 
@@ -260,6 +294,7 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
     e->in_cache = false;
+    _unprotect(e);
     _unref(e);
     _usage -= e->charge;
 }
@@ -275,12 +310,17 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->in_protected = false;
     e->priority = priority;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
 
+        if (priority == CachePriority::PROTECTED) {
+            _protect(e);
+        }
+        _demote_protected();
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
         _evict_from_lru(charge, &last_ref_list);
@@ -292,6 +332,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         _usage += charge;
         if (old != nullptr) {
             old->in_cache = false;
+            _unprotect(old);
             if (_unref(old)) {
                 _usage -= old->charge;
                 // old is on LRU because it's in cache and its reference count
@@ -327,6 +368,7 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
                 }
             }
             e->in_cache = false;
+            _unprotect(e);
         }
     }
     // free handle out of mutex, when last_ref is true, e must not be nullptr
@@ -335,20 +377,26 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
     }
 }
 
-int LRUCache::prune() {
+int LRUCache::prune(bool keep_protected) {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        for (LRUHandle* list : {&_lru, &_protected_lru}) {
+            if (keep_protected && list == &_protected_lru) {
+                break;
+            }
+            while (list->next != list) {
+                LRUHandle* old = list->next;
+                DCHECK(old->in_cache);
+                DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
+                _lru_remove(old);
+                _table.remove(old->key(), old->hash);
+                old->in_cache = false;
+                _unprotect(old);
+                _unref(old);
+                _usage -= old->charge;
+                last_ref_list.push_back(old);
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -361,15 +409,21 @@ inline uint32_t ShardedLRUCache::_hash_slice(const CacheKey& s) {
     return s.hash(s.data(), s.size(), 0);
 }
 
-uint32_t ShardedLRUCache::_shard(uint32_t hash) {
-    return hash >> (32 - kNumShardBits);
+uint32_t ShardedLRUCache::_shard(uint32_t hash) const {
+    return _num_shard_bits > 0 ? hash >> (32 - _num_shard_bits) : 0;
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity) : _last_id(0) {
-    const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
+ShardedLRUCache::ShardedLRUCache(size_t capacity, int num_shard_bits, double protected_ratio)
+        : _num_shard_bits(num_shard_bits),
+          _num_shards(1 << num_shard_bits),
+          _shards(new LRUCache[_num_shards]),
+          _last_id(0) {
+    DCHECK(num_shard_bits >= 0 && num_shard_bits < 32);
+    const size_t per_shard = (capacity + (_num_shards - 1)) / _num_shards;
 
-    for (auto& _shard : _shards) {
-        _shard.set_capacity(per_shard);
+    for (size_t i = 0; i < _num_shards; ++i) {
+        _shards[i].set_capacity(per_shard);
+        _shards[i].set_protected_capacity(static_cast<size_t>(per_shard * protected_ratio));
     }
 }
 
@@ -410,29 +464,37 @@ uint64_t ShardedLRUCache::new_id() {
 
 void ShardedLRUCache::prune() {
     int num_prune = 0;
-    for (auto& _shard : _shards) {
-        num_prune += _shard.prune();
+    for (size_t i = 0; i < _num_shards; ++i) {
+        num_prune += _shards[i].prune();
     }
     VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
 }
 
+void ShardedLRUCache::prune_cold() {
+    int num_prune = 0;
+    for (size_t i = 0; i < _num_shards; ++i) {
+        num_prune += _shards[i].prune(true);
+    }
+    VLOG(7) << "Successfully prune the cold entries of cache, clean " << num_prune << " entries.";
+}
+
 size_t ShardedLRUCache::get_memory_usage() {
     size_t total_usage = 0;
-    for (const auto& _shard : _shards) {
-        total_usage += _shard.get_usage();
+    for (size_t i = 0; i < _num_shards; ++i) {
+        total_usage += _shards[i].get_usage();
     }
     return total_usage;
 }
 
 void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
-    size_t shard_count = sizeof(_shards) / sizeof(LRUCache);
-
-    for (uint32_t i = 0; i < shard_count; ++i) {
+    for (uint32_t i = 0; i < _num_shards; ++i) {
         size_t capacity = _shards[i].get_capacity();
         size_t usage = _shards[i].get_usage();
         rapidjson::Value shard_info(rapidjson::kObjectType);
         shard_info.AddMember("capacity", static_cast<double>(capacity), document->GetAllocator());
         shard_info.AddMember("usage", static_cast<double>(usage), document->GetAllocator());
+        shard_info.AddMember("protected_usage", static_cast<double>(_shards[i].get_protected_usage()),
+                             document->GetAllocator());
 
         float usage_ratio = 0.0f;
 
@@ -462,4 +524,8 @@ Cache* new_lru_cache(size_t capacity) {
     return new ShardedLRUCache(capacity);
 }
 
+Cache* new_lru_cache(size_t capacity, int num_shard_bits, double protected_ratio) {
+    return new ShardedLRUCache(capacity, num_shard_bits, protected_ratio);
+}
+
 } // namespace starrocks
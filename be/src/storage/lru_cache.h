@@ -8,6 +8,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -48,6 +49,12 @@ class CacheKey;
 // of Cache uses a least-recently-used eviction policy.
 extern Cache* new_lru_cache(size_t capacity);
 
+// Create a new cache of 2^num_shard_bits shards using a segmented LRU policy: the entries hit again
+// after being inserted move to a protected segment taking up to protected_ratio of the capacity,
+// which is evicted only after the probationary one. This keeps the hot entries from being flushed
+// by a large scan touching every entry once. protected_ratio = 0 falls back to plain LRU.
+extern Cache* new_lru_cache(size_t capacity, int num_shard_bits, double protected_ratio);
+
 class CacheKey {
 public:
     CacheKey() {}
@@ -130,8 +137,10 @@ private:
     size_t _size{0};
 };
 
-// The entry with smaller CachePriority will evict firstly
-enum class CachePriority { NORMAL = 0, DURABLE = 1 };
+// The entry with smaller CachePriority will evict firstly.
+// PROTECTED entries start in the protected segment as if they had been hit once, they are the same
+// as NORMAL ones when the cache isn't segmented.
+enum class CachePriority { NORMAL = 0, PROTECTED = 1, DURABLE = 2 };
 
 class Cache {
 public:
@@ -197,6 +206,10 @@ public:
     // leveldb may change prune() to a pure abstract method.
     virtual void prune() {}
 
+    // Like prune(), but keeps the entries of the protected segment, which have been hit again since
+    // inserted. The default implementation prunes all.
+    virtual void prune_cold() { prune(); }
+
     virtual size_t get_memory_usage() = 0;
     virtual void get_cache_status(rapidjson::Document* document) = 0;
 
@@ -215,7 +228,8 @@ typedef struct LRUHandle {
     LRUHandle* prev;
     size_t charge;
     size_t key_length;
-    bool in_cache; // Whether entry is in the cache.
+    bool in_cache;     // Whether entry is in the cache.
+    bool in_protected; // Whether entry is in the protected segment.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
@@ -278,6 +292,7 @@ public:
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity) { _capacity = capacity; }
+    void set_protected_capacity(size_t capacity) { _protected_capacity = capacity; }
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -286,11 +301,13 @@ public:
     Cache::Handle* lookup(const CacheKey& key, uint32_t hash);
     void release(Cache::Handle* handle);
     void erase(const CacheKey& key, uint32_t hash);
-    int prune();
+    // With |keep_protected|, only the unused entries of the probationary segment are removed.
+    int prune(bool keep_protected = false);
 
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
     size_t get_usage() const { return _usage; }
+    size_t get_protected_usage() const { return _protected_usage; }
     size_t get_capacity() const { return _capacity; }
 
 private:
@@ -299,9 +316,14 @@ private:
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
     void _evict_one_entry(LRUHandle* e);
+    void _protect(LRUHandle* e);
+    void _unprotect(LRUHandle* e);
+    void _demote_protected();
 
     // Initialized before use.
     size_t _capacity;
+    // 0 means the cache is not segmented.
+    size_t _protected_capacity{0};
 
     // _mutex protects the following state.
     std::mutex _mutex;
@@ -312,6 +334,10 @@ private:
     // lru.prev is newest entry, lru.next is oldest entry.
     // Entries have refs==1 and in_cache==true.
     LRUHandle _lru;
+    // Dummy head of the protected segment, with the same layout as _lru.
+    LRUHandle _protected_lru;
+    // total charge of the entries in the protected segment, in use or not.
+    size_t _protected_usage{0};
 
     HandleTable _table;
 
@@ -324,7 +350,7 @@ static const int kNumShards = 1 << kNumShardBits;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity);
+    explicit ShardedLRUCache(size_t capacity, int num_shard_bits = kNumShardBits, double protected_ratio = 0);
     ~ShardedLRUCache() override = default;
     Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
                    CachePriority priority = CachePriority::NORMAL) override;
@@ -335,14 +361,17 @@ public:
     Slice value_slice(Handle* handle) override;
     uint64_t new_id() override;
     void prune() override;
+    void prune_cold() override;
     size_t get_memory_usage() override;
     void get_cache_status(rapidjson::Document* document) override;
 
 private:
     static inline uint32_t _hash_slice(const CacheKey& s);
-    static uint32_t _shard(uint32_t hash);
+    uint32_t _shard(uint32_t hash) const;
 
-    LRUCache _shards[kNumShards];
+    const int _num_shard_bits;
+    const size_t _num_shards;
+    std::unique_ptr<LRUCache[]> _shards;
     std::mutex _id_mutex;
     uint64_t _last_id;
 };
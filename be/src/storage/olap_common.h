@@ -23,6 +23,7 @@
 
 #include <netinet/in.h>
 
+#include <array>
 #include <functional>
 #include <list>
 #include <map>
@@ -397,10 +398,38 @@ class WrapperField;
 using KeyRange = std::pair<WrapperField*, WrapperField*>;
 
 // ReaderStatistics used to collect statistics when scan data from storage
+// The statistics of reading a column, to tell which columns and indexes the IO and the filtered rows of a scan
+// come from.
+struct ColumnReadStatistics {
+    // indexed by EncodingTypePB
+    static constexpr size_t kMaxEncodings = 16;
+
+    int64_t compressed_bytes_read = 0;
+    std::array<int64_t, kMaxEncodings> compressed_bytes_read_by_encoding{};
+    int64_t uncompressed_bytes_read = 0;
+    int64_t io_ns = 0;
+    int64_t decompress_ns = 0;
+    int64_t decode_ns = 0;
+
+    // the pages read, and those served by the page cache and by its compressed tier
+    int64_t total_pages_num = 0;
+    int64_t cached_pages_num = 0;
+    int64_t compressed_cached_pages_num = 0;
+
+    // the rows filtered by the indexes of the column; the rows filtered by several columns are counted in each
+    int64_t rows_stats_filtered = 0;
+    int64_t rows_bf_filtered = 0;
+    int64_t rows_bitmap_index_filtered = 0;
+};
+
 struct OlapReaderStatistics {
     int64_t create_segment_iter_ns = 0;
     int64_t io_ns = 0;
     int64_t compressed_bytes_read = 0;
+    // bytes read by coalesced page reads, and how many of them are used as pages.
+    int64_t coalesced_bytes_read = 0;
+    int64_t coalesced_bytes_used = 0;
+    int64_t coalesced_read_num = 0;
 
     int64_t decompress_ns = 0;
     int64_t uncompressed_bytes_read = 0;
@@ -430,6 +459,7 @@ struct OlapReaderStatistics {
 
     int64_t segment_stats_filtered = 0;
     int64_t rows_key_range_filtered = 0;
+    int64_t rows_sorted_range_filtered = 0;
     int64_t rows_stats_filtered = 0;
     int64_t rows_bf_filtered = 0;
     int64_t rows_del_filtered = 0;
@@ -439,15 +469,23 @@ struct OlapReaderStatistics {
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // pages not in the decompressed page cache but found in its compressed tier
+    int64_t compressed_cached_pages_num = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
 
+    int64_t rows_inverted_index_filtered = 0;
+    int64_t inverted_index_filter_timer = 0;
+
     int64_t rows_del_vec_filtered = 0;
 
     int64_t rowsets_read_count = 0;
     int64_t segments_read_count = 0;
     int64_t total_columns_data_page_count = 0;
+
+    // keyed by the column id of the tablet schema
+    std::map<uint32_t, ColumnReadStatistics> column_stats;
 };
 
 typedef uint32_t ColumnId;
@@ -28,11 +28,14 @@
 #include <string>
 
 #include "common/status.h"
+#include "exec/workgroup/work_group.h"
 #include "storage/olap_common.h"
+#include "storage/compaction_scheduler.h"
 #include "storage/olap_define.h"
 #include "storage/storage_engine.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized/compaction.h"
+#include "util/cpu_info.h"
 #include "util/thread.h"
 #include "util/time.h"
 
@@ -94,6 +97,11 @@ Status StorageEngine::start_bg_threads() {
         max_compaction_concurrency = base_compaction_num_threads + cumulative_compaction_num_threads;
     }
     vectorized::Compaction::init(max_compaction_concurrency);
+    _compaction_scheduler = std::make_unique<CompactionScheduler>([] {
+        int32_t drivers_per_core = config::compaction_query_load_ready_drivers_per_core;
+        return drivers_per_core > 0 &&
+               workgroup::WorkGroupManager::instance()->num_ready_drivers() > drivers_per_core * CpuInfo::num_cores();
+    });
 
     _base_compaction_threads.reserve(base_compaction_num_threads);
     for (uint32_t i = 0; i < base_compaction_num_threads; ++i) {
@@ -137,6 +145,15 @@ Status StorageEngine::start_bg_threads() {
     Thread::set_thread_name(_fd_cache_clean_thread, "fd_cache_clean");
     LOG(INFO) << "fd cache clean thread started";
 
+    if (config::segment_footer_cache_preload_tablet_num > 0) {
+        _segment_footer_preload_thread = std::thread([this] {
+            _tablet_manager->preload_segment_footers(config::segment_footer_cache_preload_tablet_num,
+                                                     _bg_worker_stopped);
+        });
+        Thread::set_thread_name(_segment_footer_preload_thread, "footer_preload");
+        LOG(INFO) << "segment footer preload thread started";
+    }
+
     // path scan and gc thread
     if (config::path_gc_check) {
         for (auto data_dir : get_stores()) {
@@ -177,10 +194,15 @@ void* StorageEngine::_base_compaction_thread_callback(void* arg, DataDir* data_d
     //string last_base_compaction_fs;
     //TTabletId last_base_compaction_tablet_id = -1;
     Status status = Status::OK();
+    const std::string path = data_dir->path();
     while (!_bg_worker_stopped.load(std::memory_order_consume)) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
+            if (!_compaction_scheduler->acquire(path)) {
+                break;
+            }
             status = _perform_base_compaction(data_dir);
+            _compaction_scheduler->release(path);
         }
         if (status.ok()) {
             continue;
@@ -207,10 +229,15 @@ void* StorageEngine::_update_compaction_thread_callback(void* arg, DataDir* data
     ProfilerRegisterThread();
 #endif
     Status status = Status::OK();
+    const std::string path = data_dir->path();
     while (!_bg_worker_stopped.load(std::memory_order_consume)) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
+            if (!_compaction_scheduler->acquire(path)) {
+                break;
+            }
             status = _perform_update_compaction(data_dir);
+            _compaction_scheduler->release(path);
         }
         if (status.ok()) {
             continue;
@@ -300,10 +327,15 @@ void* StorageEngine::_cumulative_compaction_thread_callback(void* arg, DataDir*
     LOG(INFO) << "try to start cumulative compaction process!";
 
     Status status = Status::OK();
+    const std::string path = data_dir->path();
     while (!_bg_worker_stopped.load(std::memory_order_consume)) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
+            if (!_compaction_scheduler->acquire(path)) {
+                break;
+            }
             status = _perform_cumulative_compaction(data_dir);
+            _compaction_scheduler->release(path);
         }
         if (status.ok()) {
             continue;
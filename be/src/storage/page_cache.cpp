@@ -23,6 +23,8 @@
 
 #include <malloc.h>
 
+#include <cstring>
+
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
@@ -34,9 +36,10 @@ namespace starrocks {
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
-void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity, int num_shard_bits,
+                                           double protected_ratio, double compressed_ratio) {
     if (_s_instance == nullptr) {
-        _s_instance = new StoragePageCache(mem_tracker, capacity);
+        _s_instance = new StoragePageCache(mem_tracker, capacity, num_shard_bits, protected_ratio, compressed_ratio);
     }
 }
 
@@ -47,8 +50,16 @@ void StoragePageCache::release_global_cache() {
     }
 }
 
-StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity, int num_shard_bits,
+                                   double protected_ratio, double compressed_ratio)
+        : _mem_tracker(mem_tracker), _capacity(capacity) {
+    auto compressed_capacity = static_cast<size_t>(capacity * compressed_ratio);
+    _cache.reset(new_lru_cache(capacity - compressed_capacity, num_shard_bits, protected_ratio));
+    if (compressed_capacity > 0) {
+        // the compressed pages are mostly data pages read by scans, protect the ones hit again
+        _compressed_cache.reset(new_lru_cache(compressed_capacity, num_shard_bits, protected_ratio));
+    }
+}
 
 StoragePageCache::~StoragePageCache() {}
 
@@ -61,7 +72,20 @@ bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
     return true;
 }
 
-void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory) {
+bool StoragePageCache::lookup_compressed(const CacheKey& key, PageCacheHandle* handle) {
+    if (_compressed_cache == nullptr) {
+        return false;
+    }
+    auto* lru_handle = _compressed_cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = PageCacheHandle(_compressed_cache.get(), lru_handle);
+    return true;
+}
+
+Cache::Handle* StoragePageCache::_insert(Cache* cache, const CacheKey& key, const Slice& data,
+                                         CachePriority priority) {
 #ifndef BE_TEST
     int64_t mem_size = malloc_usable_size(data.data);
     tls_thread_status.mem_release(mem_size);
@@ -72,13 +96,30 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
 
     auto deleter = [](const starrocks::CacheKey& key, void* value) { delete[](uint8_t*) value; };
 
+    return cache->insert(key.encode(), data.data, data.size, deleter, priority);
+}
+
+void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory,
+                              bool is_data_page) {
     CachePriority priority = CachePriority::NORMAL;
     if (in_memory) {
         priority = CachePriority::DURABLE;
+    } else if (!is_data_page) {
+        priority = CachePriority::PROTECTED;
     }
 
-    auto* lru_handle = _cache->insert(key.encode(), data.data, data.size, deleter, priority);
+    auto* lru_handle = _insert(_cache.get(), key, data, priority);
     *handle = PageCacheHandle(_cache.get(), lru_handle);
 }
 
+void StoragePageCache::insert_compressed(const CacheKey& key, const Slice& data) {
+    if (_compressed_cache == nullptr) {
+        return;
+    }
+    auto* buf = new uint8_t[data.size];
+    memcpy(buf, data.data, data.size);
+    auto* lru_handle = _insert(_compressed_cache.get(), key, Slice(buf, data.size), CachePriority::NORMAL);
+    _compressed_cache->release(lru_handle);
+}
+
 } // namespace starrocks
@@ -37,7 +37,6 @@ class MemTracker;
 
 // Warpper around Cache, and used for cache page of column datas
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
 class StoragePageCache {
 public:
     virtual ~StoragePageCache();
@@ -61,7 +60,10 @@ public:
     };
 
     // Create global instance of this class
-    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+    // See new_lru_cache() for `num_shard_bits` and `protected_ratio`.
+    // `compressed_ratio` of the capacity is given to the tier of the compressed pages, see insert_compressed().
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity, int num_shard_bits = kNumShardBits,
+                                    double protected_ratio = 0, double compressed_ratio = 0);
 
     static void release_global_cache();
 
@@ -69,7 +71,8 @@ public:
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(MemTracker* mem_tracker, size_t capacity);
+    StoragePageCache(MemTracker* mem_tracker, size_t capacity, int num_shard_bits = kNumShardBits,
+                     double protected_ratio = 0, double compressed_ratio = 0);
 
     // Lookup the given page in the cache.
     //
@@ -84,16 +87,38 @@ public:
     // Given hanlde will be set to valid reference.
     // This function is thread-safe, and when two clients insert two same key
     // concurrently, this function can assure that only one page is cached.
-    // The in_memory page will have higher priority.
-    void insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory = false);
+    // The in_memory page will have higher priority, and the index pages (not data pages) are protected
+    // from the large scans when the cache is segmented.
+    void insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory = false,
+                bool is_data_page = true);
 
-    size_t memory_usage() const { return _cache->get_memory_usage(); }
+    // The compressed tier keeps the pages as they are read from the file, so that the same memory holds
+    // several times more pages of the well compressed columns. A page found there only needs to be
+    // decompressed again, and it's put into the decompressed tier then.
+    bool has_compressed_tier() const { return _compressed_cache != nullptr; }
+
+    // Lookup the compressed page in the compressed tier, return false if it's not found or there is no
+    // compressed tier.
+    bool lookup_compressed(const CacheKey& key, PageCacheHandle* handle);
+
+    // Insert a copy of the compressed page into the compressed tier.
+    void insert_compressed(const CacheKey& key, const Slice& data);
+
+    size_t memory_usage() const {
+        return _cache->get_memory_usage() + (_compressed_cache != nullptr ? _compressed_cache->get_memory_usage() : 0);
+    }
+
+    size_t capacity() const { return _capacity; }
 
 private:
+    Cache::Handle* _insert(Cache* cache, const CacheKey& key, const Slice& data, CachePriority priority);
+
     static StoragePageCache* _s_instance;
 
     MemTracker* _mem_tracker = nullptr;
+    size_t _capacity = 0;
     std::unique_ptr<Cache> _cache = nullptr;
+    std::unique_ptr<Cache> _compressed_cache = nullptr;
 };
 
 // A handle for StoragePageCache entry. This class make it easy to handle
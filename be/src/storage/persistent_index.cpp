@@ -2,8 +2,23 @@
 
 #include "storage/persistent_index.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "common/config.h"
+#include "env/env.h"
 #include "gen_cpp/persistent_index.pb.h"
 #include "gutil/strings/substitute.h"
+#include "storage/protobuf_file.h"
+#include "storage/rowset/bloom_filter.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
 #include "util/debug_util.h"
 #include "util/murmur_hash3.h"
 
@@ -16,13 +31,24 @@ MutableIndex::~MutableIndex() {}
 constexpr uint64_t seed0 = 12980785309524476958ULL;
 constexpr uint64_t seed1 = 9110941936030554525ULL;
 
+// hash of the key to look it up in both L0 and L1
+static uint64_t key_index_hash(const void* key, size_t key_size) {
+    uint64_t ret;
+    murmur_hash3_x64_64(key, key_size, seed0, &ret);
+    return ret;
+}
+
+// hash of the key for the bloom filters of L1, it must be independent of the shard, which takes the
+// top bits of key_index_hash.
+static uint64_t key_bloom_filter_hash(const void* key, size_t key_size) {
+    uint64_t ret;
+    murmur_hash3_x64_64(key, key_size, seed1, &ret);
+    return ret;
+}
+
 template <size_t KeySize>
 struct FixedKeyHash {
-    uint64_t operator()(const FixedKey<KeySize>& k) const {
-        uint64_t ret;
-        murmur_hash3_x64_64(k.data, KeySize, seed0, &ret);
-        return ret;
-    }
+    uint64_t operator()(const FixedKey<KeySize>& k) const { return key_index_hash(k.data, KeySize); }
 };
 
 template <size_t KeySize>
@@ -139,6 +165,19 @@ public:
         *num_found = nfound;
         return Status::OK();
     }
+
+    size_t size() const override { return _map.size(); }
+
+    void dump(std::string* keys, std::vector<IndexValue>* values) const override {
+        keys->reserve(keys->size() + _map.size() * KeySize);
+        values->reserve(values->size() + _map.size());
+        for (const auto& [key, value] : _map) {
+            keys->append(reinterpret_cast<const char*>(key.data), KeySize);
+            values->emplace_back(value);
+        }
+    }
+
+    void clear() override { phmap::flat_hash_map<FixedKey<KeySize>, IndexValue, FixedKeyHash<KeySize>>().swap(_map); }
 };
 
 StatusOr<std::unique_ptr<MutableIndex>> MutableIndex::create(size_t key_size) {
@@ -177,13 +216,300 @@ StatusOr<std::unique_ptr<MutableIndex>> MutableIndex::create(size_t key_size) {
 #undef CASE_SIZE
 }
 
+static constexpr uint32_t kImmutableIndexMagic = 0x4c315049; // "IP1L"
+// a shard holds about this many keys, so that a lookup binary searches a few pages of it at most
+static constexpr size_t kImmutableIndexShardKeys = 1 << 16;
+static constexpr uint32_t kImmutableIndexMaxShardBits = 20;
+static constexpr double kImmutableIndexBloomFilterFpp = 0.05;
+
+// Writes the entries of an ImmutableIndex in hash order.
+class ImmutableIndexWriter {
+public:
+    ImmutableIndexWriter(size_t key_size, uint32_t shard_bits) : _key_size(key_size), _shard_bits(shard_bits) {}
+
+    Status open(const std::string& path) {
+        WritableFileOptions opts;
+        opts.sync_on_close = true;
+        return Env::Default()->new_writable_file(opts, path, &_file);
+    }
+
+    // |hash| must not be less than the one added last time
+    Status add(uint64_t hash, const uint8_t* key, IndexValue value) {
+        size_t shard = _shard_bits == 0 ? 0 : hash >> (64 - _shard_bits);
+        while (static_cast<size_t>(_meta.shards_size()) < shard) {
+            RETURN_IF_ERROR(_flush_shard());
+        }
+        _hashes.emplace_back(hash);
+        _keys.append(reinterpret_cast<const char*>(key), _key_size);
+        _values.emplace_back(value);
+        _size++;
+        return Status::OK();
+    }
+
+    Status finish(const EditVersion& version) {
+        while (_meta.shards_size() < (1 << _shard_bits)) {
+            RETURN_IF_ERROR(_flush_shard());
+        }
+        version.to_pb(_meta.mutable_version());
+        _meta.set_size(_size);
+        _meta.set_key_size(_key_size);
+        _meta.set_shard_bits(_shard_bits);
+        std::string footer = _meta.SerializeAsString();
+        put_fixed32_le(&footer, footer.size());
+        put_fixed32_le(&footer, kImmutableIndexMagic);
+        RETURN_IF_ERROR(_file->append(footer));
+        return _file->close();
+    }
+
+private:
+    Status _append(const Slice& data) {
+        RETURN_IF_ERROR(_file->append(data));
+        _offset += data.size;
+        return Status::OK();
+    }
+
+    // keep the arrays of uint64 aligned
+    Status _pad() {
+        static const char zeros[8] = {0};
+        return _append(Slice(zeros, pad(_offset, 8) - _offset));
+    }
+
+    Status _flush_shard() {
+        auto* shard_meta = _meta.add_shards();
+        const size_t n = _hashes.size();
+        shard_meta->set_size(n);
+        if (n > 0) {
+            uint64_t begin = _offset;
+            RETURN_IF_ERROR(_append(Slice(reinterpret_cast<const char*>(_hashes.data()), n * sizeof(uint64_t))));
+            RETURN_IF_ERROR(_append(_keys));
+            RETURN_IF_ERROR(_pad());
+            RETURN_IF_ERROR(_append(Slice(reinterpret_cast<const char*>(_values.data()), n * sizeof(IndexValue))));
+            shard_meta->set_npage(npad(_offset - begin, PageSize));
+            shard_meta->mutable_data()->set_offset(begin);
+            shard_meta->mutable_data()->set_size(_offset - begin);
+
+            std::unique_ptr<BloomFilter> bf;
+            RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+            RETURN_IF_ERROR(bf->init(n, kImmutableIndexBloomFilterFpp, HASH_MURMUR3_X64_64));
+            for (size_t i = 0; i < n; i++) {
+                bf->add_hash(key_bloom_filter_hash(_keys.data() + i * _key_size, _key_size));
+            }
+            shard_meta->mutable_bloom_filter()->set_offset(_offset);
+            shard_meta->mutable_bloom_filter()->set_size(bf->size());
+            RETURN_IF_ERROR(_append(Slice(bf->data(), bf->size())));
+            RETURN_IF_ERROR(_pad());
+        }
+        _hashes.clear();
+        _keys.clear();
+        _values.clear();
+        return Status::OK();
+    }
+
+    const size_t _key_size;
+    const uint32_t _shard_bits;
+    std::unique_ptr<WritableFile> _file;
+    uint64_t _offset = 0;
+    size_t _size = 0;
+    ImmutableIndexMetaPB _meta;
+    // entries of the current shard
+    std::vector<uint64_t> _hashes;
+    std::string _keys;
+    std::vector<IndexValue> _values;
+};
+
+ImmutableIndex::~ImmutableIndex() {
+    if (_data != nullptr && munmap(_data, _data_size) != 0) {
+        PLOG(WARNING) << "Fail to munmap " << _path;
+    }
+}
+
+size_t ImmutableIndex::memory_usage() const {
+    size_t usage = sizeof(ImmutableIndex) + _shards.size() * sizeof(Shard);
+    for (const auto& shard : _shards) {
+        usage += shard.bloom_filter != nullptr ? shard.bloom_filter->size() : 0;
+    }
+    return usage;
+}
+
+StatusOr<std::unique_ptr<ImmutableIndex>> ImmutableIndex::load(const std::string& path) {
+    std::unique_ptr<ImmutableIndex> index(new ImmutableIndex());
+    index->_path = path;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Status::IOError(strings::Substitute("Fail to open $0: $1", path, std::strerror(errno)));
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        return Status::IOError(strings::Substitute("Fail to stat $0: $1", path, std::strerror(errno)));
+    }
+    index->_data_size = st.st_size;
+    void* data = index->_data_size > 0 ? mmap(nullptr, index->_data_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (data == MAP_FAILED) {
+        return Status::IOError(strings::Substitute("Fail to mmap $0: $1", path, std::strerror(errno)));
+    }
+    index->_data = data;
+    // the lookups of the keys spread over the file, don't read ahead
+    madvise(data, index->_data_size, MADV_RANDOM);
+
+    const auto* base = static_cast<const uint8_t*>(data);
+    const size_t file_size = index->_data_size;
+    if (file_size < 8 || decode_fixed32_le(base + file_size - 4) != kImmutableIndexMagic) {
+        return Status::Corruption(strings::Substitute("Bad immutable index file $0: invalid magic", path));
+    }
+    uint32_t meta_size = decode_fixed32_le(base + file_size - 8);
+    ImmutableIndexMetaPB meta;
+    if (meta_size > file_size - 8 || !meta.ParseFromArray(base + file_size - 8 - meta_size, meta_size)) {
+        return Status::Corruption(strings::Substitute("Bad immutable index file $0: invalid meta", path));
+    }
+    if (meta.shard_bits() > kImmutableIndexMaxShardBits || meta.shards_size() != (1 << meta.shard_bits())) {
+        return Status::Corruption(strings::Substitute("Bad immutable index file $0: invalid shards", path));
+    }
+    index->_key_size = meta.key_size();
+    index->_size = meta.size();
+    index->_version = EditVersion(meta.version());
+    index->_shard_bits = meta.shard_bits();
+    index->_shards.resize(meta.shards_size());
+    for (int i = 0; i < meta.shards_size(); i++) {
+        const auto& shard_meta = meta.shards(i);
+        auto& shard = index->_shards[i];
+        shard.size = shard_meta.size();
+        if (shard.size == 0) {
+            continue;
+        }
+        const size_t n = shard.size;
+        const size_t values_offset = pad(n * sizeof(uint64_t) + n * index->_key_size, 8);
+        if (shard_meta.data().offset() + values_offset + n * sizeof(IndexValue) > file_size ||
+            shard_meta.bloom_filter().offset() + shard_meta.bloom_filter().size() > file_size) {
+            return Status::Corruption(strings::Substitute("Bad immutable index file $0: invalid shard $1", path, i));
+        }
+        const uint8_t* shard_data = base + shard_meta.data().offset();
+        shard.hashes = reinterpret_cast<const uint64_t*>(shard_data);
+        shard.keys = shard_data + n * sizeof(uint64_t);
+        shard.values = reinterpret_cast<const IndexValue*>(shard_data + values_offset);
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &shard.bloom_filter));
+        RETURN_IF_ERROR(shard.bloom_filter->init(reinterpret_cast<const char*>(base + shard_meta.bloom_filter().offset()),
+                                                 shard_meta.bloom_filter().size(), HASH_MURMUR3_X64_64));
+    }
+    return std::move(index);
+}
+
+Status ImmutableIndex::write(const std::string& path, size_t key_size, const EditVersion& version,
+                             const MutableIndex& l0, const ImmutableIndex* l1) {
+    std::string l0_keys;
+    std::vector<IndexValue> l0_values;
+    l0.dump(&l0_keys, &l0_values);
+    const auto* l0_key_data = reinterpret_cast<const uint8_t*>(l0_keys.data());
+    // the keys not erased in L0, sorted by hash
+    std::vector<std::pair<uint64_t, uint32_t>> l0_entries;
+    for (uint32_t i = 0; i < l0_values.size(); i++) {
+        if (l0_values[i] != NullIndexValue) {
+            l0_entries.emplace_back(key_index_hash(l0_key_data + i * key_size, key_size), i);
+        }
+    }
+    std::sort(l0_entries.begin(), l0_entries.end());
+
+    const size_t max_size = l0_entries.size() + (l1 != nullptr ? l1->size() : 0);
+    uint32_t shard_bits = 0;
+    while ((max_size >> shard_bits) > kImmutableIndexShardKeys && shard_bits < kImmutableIndexMaxShardBits) {
+        shard_bits++;
+    }
+    ImmutableIndexWriter writer(key_size, shard_bits);
+    const std::string tmp_path = path + ".tmp";
+    RETURN_IF_ERROR(writer.open(tmp_path));
+
+    // merge the L1 keys not in L0 and the L0 keys in hash order
+    size_t l0_pos = 0;
+    auto add_l0_until = [&](uint64_t hash, bool inclusive) {
+        for (; l0_pos < l0_entries.size() && (l0_entries[l0_pos].first < hash ||
+                                              (inclusive && l0_entries[l0_pos].first == hash));
+             l0_pos++) {
+            const auto& [h, idx] = l0_entries[l0_pos];
+            RETURN_IF_ERROR(writer.add(h, l0_key_data + idx * key_size, l0_values[idx]));
+        }
+        return Status::OK();
+    };
+    if (l1 != nullptr) {
+        std::vector<IndexValue> found_values;
+        for (const auto& shard : l1->_shards) {
+            if (shard.size == 0) {
+                continue;
+            }
+            KeysInfo not_in_l0;
+            size_t num_found = 0;
+            found_values.resize(shard.size);
+            RETURN_IF_ERROR(l0.get(shard.size, shard.keys, found_values.data(), &not_in_l0, &num_found));
+            for (uint32_t i : not_in_l0.key_idxes) {
+                RETURN_IF_ERROR(add_l0_until(shard.hashes[i], false));
+                RETURN_IF_ERROR(writer.add(shard.hashes[i], shard.keys + i * key_size, shard.values[i]));
+            }
+        }
+    }
+    RETURN_IF_ERROR(add_l0_until(std::numeric_limits<uint64_t>::max(), true));
+    Status st = writer.finish(version);
+    if (st.ok()) {
+        st = Env::Default()->rename_file(tmp_path, path);
+    }
+    if (!st.ok()) {
+        WARN_IF_ERROR(Env::Default()->delete_file(tmp_path), "Fail to remove " + tmp_path);
+    }
+    return st;
+}
+
+ssize_t ImmutableIndex::_find(const Shard& shard, const uint8_t* key, uint64_t hash) const {
+    if (shard.size == 0 || !shard.bloom_filter->test_hash(key_bloom_filter_hash(key, _key_size))) {
+        return -1;
+    }
+    const uint64_t* end = shard.hashes + shard.size;
+    for (const uint64_t* p = std::lower_bound(shard.hashes, end, hash); p != end && *p == hash; p++) {
+        size_t pos = p - shard.hashes;
+        if (memcmp(shard.keys + pos * _key_size, key, _key_size) == 0) {
+            return pos;
+        }
+    }
+    return -1;
+}
+
 Status ImmutableIndex::get(size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values,
                            size_t* num_found) const {
-    *num_found = 0;
+    const auto* key_data = static_cast<const uint8_t*>(keys);
+    // look up in hash order, so each shard is visited once and its pages are touched together
+    std::vector<uint32_t> order(keys_info.key_idxes.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t a, uint32_t b) { return keys_info.hashes[a] < keys_info.hashes[b]; });
+    size_t nfound = 0;
+    for (uint32_t i : order) {
+        uint32_t idx = keys_info.key_idxes[i];
+        uint64_t hash = keys_info.hashes[i];
+        const Shard& shard = _shards[_shard_of(hash)];
+        ssize_t pos = _find(shard, key_data + idx * _key_size, hash);
+        if (pos >= 0) {
+            values[idx] = shard.values[pos];
+            nfound++;
+        } else {
+            values[idx] = NullIndexValue;
+        }
+    }
+    *num_found += nfound;
     return Status::OK();
 }
 
 Status ImmutableIndex::check_not_exist(size_t n, const void* keys) {
+    const auto* key_data = static_cast<const uint8_t*>(keys);
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t* key = key_data + i * _key_size;
+        uint64_t hash = key_index_hash(key, _key_size);
+        if (_find(_shards[_shard_of(hash)], key, hash) >= 0) {
+            std::string msg = strings::Substitute("ImmutableIndex found duplicate key $0",
+                                                  hexdump(reinterpret_cast<const char*>(key), _key_size));
+            LOG(WARNING) << msg;
+            return Status::AlreadyExist(msg);
+        }
+    }
     return Status::OK();
 }
 
@@ -191,16 +517,35 @@ PersistentIndex::PersistentIndex(const std::string& path) : _path(path) {}
 
 PersistentIndex::~PersistentIndex() {}
 
+std::string PersistentIndex::_meta_path() const {
+    return _path + "/index.meta";
+}
+
+std::string PersistentIndex::_l0_path(const EditVersion& version) const {
+    return strings::Substitute("$0/index.l0.$1.$2", _path, version.major(), version.minor());
+}
+
+std::string PersistentIndex::_l1_path(const EditVersion& version) const {
+    return strings::Substitute("$0/index.l1.$1.$2", _path, version.major(), version.minor());
+}
+
+static Status save_meta(const std::string& path, const PersistentIndexMetaPB& meta) {
+    const std::string tmp_path = path + ".tmp";
+    RETURN_IF_ERROR(ProtobufFile(tmp_path).save(meta, true));
+    return Env::Default()->rename_file(tmp_path, path);
+}
+
 Status PersistentIndex::create(size_t key_size, const EditVersion& version) {
     if (loaded()) {
         return Status::InternalError("PersistentIndex already loaded");
     }
-    PersistentIndexMetaPB meta;
-    meta.set_key_size(key_size);
-    version.to_pb(meta.mutable_version());
-    meta.set_size(0);
-    meta.mutable_l0_meta();
-    // TODO: write to index file
+    RETURN_IF_ERROR(Env::Default()->create_dir_if_missing(_path));
+    auto meta = std::make_unique<PersistentIndexMetaPB>();
+    meta->set_key_size(key_size);
+    version.to_pb(meta->mutable_version());
+    meta->set_size(0);
+    version.to_pb(meta->mutable_l0_meta()->mutable_snapshot()->mutable_version());
+    RETURN_IF_ERROR(save_meta(_meta_path(), *meta));
     _key_size = key_size;
     _size = 0;
     _version = version;
@@ -209,24 +554,149 @@ Status PersistentIndex::create(size_t key_size, const EditVersion& version) {
         return st.status();
     }
     _l0 = std::move(st).value();
+    _l1.reset();
+    _meta = std::move(meta);
     return Status::OK();
 }
 
 Status PersistentIndex::load() {
-    // TODO: load from index file
-    return Status::NotSupported("TODO");
+    auto meta = std::make_unique<PersistentIndexMetaPB>();
+    RETURN_IF_ERROR(ProtobufFile(_meta_path()).load(meta.get()));
+    _key_size = meta->key_size();
+    _size = meta->size();
+    _version = EditVersion(meta->version());
+    _l1.reset();
+    if (meta->has_l1_version()) {
+        ASSIGN_OR_RETURN(_l1, ImmutableIndex::load(_l1_path(EditVersion(meta->l1_version()))));
+    }
+    ASSIGN_OR_RETURN(_l0, MutableIndex::create(_key_size));
+    Status st = _replay_wal(*meta);
+    if (!st.ok()) {
+        _l0.reset();
+        _l1.reset();
+        return st;
+    }
+    _meta = std::move(meta);
+    return Status::OK();
+}
+
+Status PersistentIndex::_replay_wal(const PersistentIndexMetaPB& meta) {
+    if (meta.l0_meta().wals_size() == 0) {
+        return Status::OK();
+    }
+    const std::string path = _l0_path(EditVersion(meta.l0_meta().snapshot().version()));
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(Env::Default()->new_random_access_file(path, &file));
+    std::string buf;
+    std::vector<IndexValue> values;
+    for (const auto& wal : meta.l0_meta().wals()) {
+        const size_t size = wal.data().size();
+        if (size < 4 || (size - 4) % (_key_size + sizeof(IndexValue)) != 0) {
+            return Status::Corruption(strings::Substitute("Bad wal of $0: invalid size $1", path, size));
+        }
+        buf.resize(size);
+        RETURN_IF_ERROR(file->read_at(wal.data().offset(), Slice(buf)));
+        if (crc32c::Value(buf.data(), size - 4) != decode_fixed32_le((const uint8_t*)buf.data() + size - 4)) {
+            return Status::Corruption(strings::Substitute("Bad wal of $0: checksum mismatch", path));
+        }
+        const size_t n = (size - 4) / (_key_size + sizeof(IndexValue));
+        values.resize(n);
+        memcpy(values.data(), buf.data() + n * _key_size, n * sizeof(IndexValue));
+        // the erased keys are replayed as NullIndexValue, same as erase() leaves in L0
+        KeysInfo not_found;
+        size_t num_found = 0;
+        RETURN_IF_ERROR(_l0->upsert(n, buf.data(), values.data(), &not_found, &num_found));
+    }
+    return Status::OK();
 }
 
 Status PersistentIndex::prepare(const EditVersion& version) {
-    return Status::NotSupported("TODO");
+    if (!loaded()) {
+        return Status::InternalError("PersistentIndex not loaded");
+    }
+    _version = version;
+    _wal_keys.clear();
+    _wal_values.clear();
+    return Status::OK();
 }
 
 Status PersistentIndex::abort() {
-    return Status::NotSupported("TODO");
+    _wal_keys.clear();
+    _wal_values.clear();
+    _l0.reset();
+    _l1.reset();
+    // drop the modifications in memory by loading the last commit again
+    return load();
 }
 
 Status PersistentIndex::commit() {
-    return Status::NotSupported("TODO");
+    if (!loaded()) {
+        return Status::InternalError("PersistentIndex not loaded");
+    }
+    Env* env = Env::Default();
+    PersistentIndexMetaPB meta = *_meta;
+    if (!_wal_values.empty()) {
+        std::string record = _wal_keys;
+        record.append(reinterpret_cast<const char*>(_wal_values.data()), _wal_values.size() * sizeof(IndexValue));
+        put_fixed32_le(&record, crc32c::Value(record.data(), record.size()));
+
+        WritableFileOptions opts;
+        opts.mode = Env::CREATE_OR_OPEN;
+        std::unique_ptr<WritableFile> file;
+        RETURN_IF_ERROR(env->new_writable_file(opts, _l0_path(EditVersion(meta.l0_meta().snapshot().version())), &file));
+        uint64_t offset = file->size();
+        RETURN_IF_ERROR(file->append(record));
+        RETURN_IF_ERROR(file->sync());
+        RETURN_IF_ERROR(file->close());
+        auto* wal = meta.mutable_l0_meta()->add_wals();
+        _version.to_pb(wal->mutable_version());
+        wal->mutable_data()->set_offset(offset);
+        wal->mutable_data()->set_size(record.size());
+    }
+    _version.to_pb(meta.mutable_version());
+    meta.set_size(_size);
+
+    std::vector<std::string> obsolete_files;
+    if (_l0->size() > config::persistent_index_l0_max_keys) {
+        obsolete_files.emplace_back(_l0_path(EditVersion(meta.l0_meta().snapshot().version())));
+        if (meta.has_l1_version()) {
+            obsolete_files.emplace_back(_l1_path(EditVersion(meta.l1_version())));
+        }
+        RETURN_IF_ERROR(_merge_l0_into_l1(&meta));
+    }
+    RETURN_IF_ERROR(save_meta(_meta_path(), meta));
+    *_meta = meta;
+    _wal_keys.clear();
+    _wal_values.clear();
+    for (const auto& path : obsolete_files) {
+        if (env->path_exists(path).ok()) {
+            WARN_IF_ERROR(env->delete_file(path), "Fail to remove obsolete index file " + path);
+        }
+    }
+    return Status::OK();
+}
+
+// Writes L0 and L1 as a new L1 of the current version, and restarts L0 empty with a new WAL.
+Status PersistentIndex::_merge_l0_into_l1(PersistentIndexMetaPB* meta) {
+    const std::string path = _l1_path(_version);
+    RETURN_IF_ERROR(ImmutableIndex::write(path, _key_size, _version, *_l0, _l1.get()));
+    ASSIGN_OR_RETURN(auto l1, ImmutableIndex::load(path));
+    LOG(INFO) << "Merged L0 of " << _l0->size() << " keys into L1 " << path << ", size=" << l1->size();
+    _version.to_pb(meta->mutable_l1_version());
+    meta->mutable_l0_meta()->clear_wals();
+    _version.to_pb(meta->mutable_l0_meta()->mutable_snapshot()->mutable_version());
+    _l0->clear();
+    _l1 = std::move(l1);
+    return Status::OK();
+}
+
+void PersistentIndex::_append_wal(size_t n, const void* keys, const IndexValue* values) {
+    _wal_keys.append(static_cast<const char*>(keys), n * _key_size);
+    if (values != nullptr) {
+        _wal_values.insert(_wal_values.end(), values, values + n);
+    } else {
+        _wal_values.insert(_wal_values.end(), n, NullIndexValue);
+    }
 }
 
 Status PersistentIndex::get(size_t n, const void* keys, IndexValue* values) {
@@ -245,7 +715,12 @@ Status PersistentIndex::upsert(size_t n, const void* keys, const IndexValue* val
     RETURN_IF_ERROR(_l0->upsert(n, keys, values, old_values, &l1_checks, &num_found));
     if (_l1) {
         RETURN_IF_ERROR(_l1->get(n, keys, l1_checks, old_values, &num_found));
+    } else {
+        for (uint32_t idx : l1_checks.key_idxes) {
+            old_values[idx] = NullIndexValue;
+        }
     }
+    _append_wal(n, keys, values);
     _size += (n - num_found);
     return Status::OK();
 }
@@ -255,6 +730,8 @@ Status PersistentIndex::insert(size_t n, const void* keys, const IndexValue* val
     if (_l1 && check_l1) {
         RETURN_IF_ERROR(_l1->check_not_exist(n, keys));
     }
+    _append_wal(n, keys, values);
+    _size += n;
     return Status::OK();
 }
 
@@ -265,6 +742,7 @@ Status PersistentIndex::erase(size_t n, const void* keys, IndexValue* old_values
     if (_l1) {
         RETURN_IF_ERROR(_l1->get(n, keys, l1_checks, old_values, &num_erased));
     }
+    _append_wal(n, keys, nullptr);
     CHECK(_size >= num_erased) << strings::Substitute("_size($0) < num_erased($1)", _size, num_erased);
     _size -= num_erased;
     return Status::OK();
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "common/statusor.h"
 #include "storage/edit_version.h"
@@ -10,6 +12,9 @@
 
 namespace starrocks {
 
+class BloomFilter;
+class PersistentIndexMetaPB;
+
 template <size_t KeySize>
 struct FixedKey {
     uint8_t data[KeySize];
@@ -100,11 +105,27 @@ public:
     virtual Status erase(size_t n, const void* keys, IndexValue* old_values, KeysInfo* not_found,
                          size_t* num_found) = 0;
 
+    // number of keys, including the erased ones which are kept as NullIndexValue to shadow the next level
+    virtual size_t size() const = 0;
+
+    // append all keys(including the erased ones) to |keys| as raw buffer and their values to |values|
+    virtual void dump(std::string* keys, std::vector<IndexValue>* values) const = 0;
+
+    virtual void clear() = 0;
+
     static StatusOr<std::unique_ptr<MutableIndex>> create(size_t key_size);
 };
 
+// The on-disk L1, an immutable file of hash shards, read by mmap so that only the pages touched by
+// the lookups are resident.
+// File := Shard*, ImmutableIndexMetaPB, MetaSize(4), Magic(4)
+// Shard := Hashes(8 * n), Keys(key_size * n), Padding, Values(8 * n), Padding, BloomFilter
+// The entries of a shard are sorted by hash, and a key is in the shard of the top bits of its hash,
+// so the whole file is sorted by hash, which makes merging it with L0 a sequential pass.
 class ImmutableIndex {
 public:
+    ~ImmutableIndex();
+
     // batch get
     // |n|: size of key/value array
     // |keys|: key array as raw buffer
@@ -113,14 +134,62 @@ public:
     // |num_found|: add the number of keys found in L1 to this argument
     Status get(size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values, size_t* num_found) const;
 
-    // batch check key existence
+    // batch check key existence, return AlreadyExist if any of the keys exists
     Status check_not_exist(size_t n, const void* keys);
+
+    size_t key_size() const { return _key_size; }
+
+    size_t size() const { return _size; }
+
+    EditVersion version() const { return _version; }
+
+    size_t memory_usage() const;
+
+    // open the index file of |path|
+    static StatusOr<std::unique_ptr<ImmutableIndex>> load(const std::string& path);
+
+    // write the keys of |l0| and |l1|(can be null) as a new index file of |path| and |version|,
+    // the keys of |l0| override the ones of |l1| and the erased ones are dropped.
+    static Status write(const std::string& path, size_t key_size, const EditVersion& version, const MutableIndex& l0,
+                        const ImmutableIndex* l1);
+
+private:
+    struct Shard {
+        size_t size = 0;
+        const uint64_t* hashes = nullptr;
+        const uint8_t* keys = nullptr;
+        const IndexValue* values = nullptr;
+        std::unique_ptr<BloomFilter> bloom_filter;
+    };
+
+    ImmutableIndex() = default;
+
+    size_t _shard_of(uint64_t hash) const { return _shard_bits == 0 ? 0 : hash >> (64 - _shard_bits); }
+
+    // return the position of the key in |shard|, or -1 if it's not found
+    ssize_t _find(const Shard& shard, const uint8_t* key, uint64_t hash) const;
+
+    std::string _path;
+    size_t _key_size = 0;
+    size_t _size = 0;
+    EditVersion _version;
+    uint32_t _shard_bits = 0;
+    std::vector<Shard> _shards;
+    void* _data = nullptr;
+    size_t _data_size = 0;
 };
 
 // A persistent primary index contains an in-memory L0 and an on-SSD/NVMe L1,
 // this saves memory usage comparing to the orig all-in-memory implementation.
 // This is a internal class and is intended to be used by PrimaryIndex internally.
-// TODO: code skeleton currently, implementation in future PRs
+//
+// Files in |path|:
+//   index.meta: PersistentIndexMetaPB
+//   index.l0.<major>.<minor>: the WAL of L0, every commit appends the keys it modified, L0 is
+//     rebuilt from it when the index is loaded
+//   index.l1.<major>.<minor>: the L1 of the version
+// When a commit leaves more than config::persistent_index_l0_max_keys keys in L0, L0 is merged
+// into a new L1 file and it restarts empty with a new WAL.
 //
 // Currently primary index is only modified in TabletUpdates::apply process, it's
 // typical use pattern in apply:
@@ -191,6 +260,15 @@ public:
     Status erase(size_t n, const void* keys, IndexValue* old_values);
 
 private:
+    std::string _meta_path() const;
+    std::string _l0_path(const EditVersion& version) const;
+    std::string _l1_path(const EditVersion& version) const;
+
+    // record the keys modified since prepare
+    void _append_wal(size_t n, const void* keys, const IndexValue* values);
+    Status _replay_wal(const PersistentIndexMetaPB& meta);
+    Status _merge_l0_into_l1(PersistentIndexMetaPB* meta);
+
     // index storage directory
     std::string _path;
     size_t _key_size = 0;
@@ -198,6 +276,11 @@ private:
     EditVersion _version;
     std::unique_ptr<MutableIndex> _l0;
     std::unique_ptr<ImmutableIndex> _l1;
+    // the meta of the last commit
+    std::unique_ptr<PersistentIndexMetaPB> _meta;
+    // the keys modified since prepare and their new values(NullIndexValue if erased)
+    std::string _wal_keys;
+    std::vector<IndexValue> _wal_values;
 };
 
 } // namespace starrocks
@@ -0,0 +1,99 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/point_lookup.h"
+
+#include "column/datum_convert.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_pool.h"
+#include "storage/primary_key_encoder.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+#include "storage/tablet_updates.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+Status point_lookup(const PPointLookupRequest& request, PPointLookupResult* result) {
+    std::string err;
+    auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(request.tablet_id(), false, &err);
+    if (tablet == nullptr) {
+        return Status::NotFound(strings::Substitute("tablet $0 not found: $1", request.tablet_id(), err));
+    }
+    if (tablet->updates() == nullptr) {
+        return Status::NotSupported(strings::Substitute("tablet $0 is not a primary key tablet", request.tablet_id()));
+    }
+    const TabletSchema& tablet_schema = tablet->tablet_schema();
+
+    // the keys, parsed by the types of the key columns and encoded like the keys of the primary index
+    std::vector<ColumnId> pk_columns(tablet_schema.num_key_columns());
+    for (uint32_t i = 0; i < pk_columns.size(); i++) {
+        pk_columns[i] = i;
+    }
+    auto pkey_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, pk_columns);
+    auto key_chunk = vectorized::ChunkHelper::new_chunk(pkey_schema, request.keys_size());
+    MemPool mem_pool;
+    for (const auto& key : request.keys()) {
+        if (key.values_size() != pk_columns.size()) {
+            return Status::InvalidArgument(strings::Substitute("a key has $0 values but the tablet has $1 key columns",
+                                                               key.values_size(), pk_columns.size()));
+        }
+        for (size_t i = 0; i < pk_columns.size(); i++) {
+            vectorized::Datum datum;
+            RETURN_IF_ERROR(
+                    vectorized::datum_from_string(pkey_schema.field(i)->type().get(), &datum, key.values(i), &mem_pool));
+            key_chunk->get_column_by_index(i)->append_datum(datum);
+        }
+    }
+    std::unique_ptr<vectorized::Column> pks;
+    RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(pkey_schema, &pks));
+    PrimaryKeyEncoder::encode(pkey_schema, *key_chunk, 0, key_chunk->num_rows(), pks.get());
+
+    std::vector<uint32_t> column_ids;
+    if (request.columns_size() == 0) {
+        for (uint32_t i = 0; i < tablet_schema.num_columns(); i++) {
+            column_ids.push_back(i);
+        }
+    } else {
+        for (const auto& name : request.columns()) {
+            int32_t index = static_cast<int32_t>(tablet_schema.field_index(name));
+            if (index < 0) {
+                return Status::InvalidArgument(strings::Substitute("unknown column $0", name));
+            }
+            column_ids.push_back(index);
+        }
+    }
+    std::vector<std::unique_ptr<vectorized::Column>> columns(column_ids.size());
+    for (size_t i = 0; i < column_ids.size(); i++) {
+        const TabletColumn& column = tablet_schema.column(column_ids[i]);
+        columns[i] = vectorized::ChunkHelper::column_from_field_type(column.type(), column.is_nullable())->clone_empty();
+        result->add_columns(std::string(column.name()));
+    }
+
+    EditVersion read_version;
+    RETURN_IF_ERROR(tablet->updates()->get_rows_by_pks(*pks, column_ids, &read_version, &columns));
+    result->set_version(read_version.major());
+
+    const size_t num_rows = columns.empty() ? 0 : columns[0]->size();
+    std::vector<TypeInfoPtr> type_infos;
+    for (uint32_t column_id : column_ids) {
+        type_infos.emplace_back(get_type_info(tablet_schema.column(column_id)));
+    }
+    for (size_t row = 0; row < num_rows; row++) {
+        auto* row_pb = result->add_rows();
+        for (size_t i = 0; i < columns.size(); i++) {
+            vectorized::Datum datum = columns[i]->get(row);
+            if (datum.is_null()) {
+                row_pb->add_values();
+                row_pb->add_is_null(true);
+            } else {
+                row_pb->add_values(vectorized::datum_to_string(type_infos[i].get(), datum));
+                row_pb->add_is_null(false);
+            }
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,18 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "common/status.h"
+
+namespace starrocks {
+
+class PPointLookupRequest;
+class PPointLookupResult;
+
+// Read the rows of the primary keys of |request| from its primary key tablet, without a query plan: the keys are
+// encoded and looked up in the primary index for their segments and rowids, and only these rows of the requested
+// columns are read from the segments, through their ordinal indexes. It serves the key-value style reads, e.g.
+// `SELECT * FROM t WHERE pk = ?`, in a single RPC.
+Status point_lookup(const PPointLookupRequest& request, PPointLookupResult* result);
+
+} // namespace starrocks
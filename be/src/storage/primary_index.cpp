@@ -4,14 +4,18 @@
 
 #include <mutex>
 
+#include "common/config.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_updates.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/tablet_reader.h"
+#include "util/countdown_latch.h"
 #include "util/stack_util.h"
 #include "util/starrocks_metrics.h"
 
@@ -877,6 +881,45 @@ static string int_list_to_string(const vector<uint32_t>& l) {
     return ret;
 }
 
+Status PrimaryIndex::_read_segment_pks(const vectorized::Schema& pkey_schema, vectorized::ChunkIterator* itr,
+                                       SegmentPKs* out) {
+    out->rowids.clear();
+    out->pk_column.reset();
+    if (itr == nullptr) {
+        return Status::OK();
+    }
+    // only hold pkey, so can use larger chunk size
+    vector<uint32_t> rowids;
+    rowids.reserve(4096);
+    auto chunk_shared_ptr = vectorized::ChunkHelper::new_chunk(pkey_schema, 4096);
+    auto chunk = chunk_shared_ptr.get();
+    const bool encode = pkey_schema.num_fields() > 1;
+    if (encode) {
+        RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(pkey_schema, &out->pk_column));
+    } else {
+        out->pk_column = chunk->columns()[0]->clone_empty();
+    }
+    while (true) {
+        chunk->reset();
+        rowids.clear();
+        auto st = itr->get_next(chunk, &rowids);
+        if (st.is_end_of_file()) {
+            break;
+        } else if (!st.ok()) {
+            itr->close();
+            return st;
+        }
+        out->rowids.insert(out->rowids.end(), rowids.begin(), rowids.end());
+        if (encode) {
+            PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), out->pk_column.get());
+        } else {
+            out->pk_column->append(*chunk->columns()[0], 0, chunk->num_rows());
+        }
+    }
+    itr->close();
+    return Status::OK();
+}
+
 Status PrimaryIndex::_do_load(Tablet* tablet) {
     MonotonicStopWatch timer;
     timer.start();
@@ -918,63 +961,67 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
         _pkey_to_rssid_rowid->reserve(total_rows - total_dels);
     }
 
-    OlapReaderStatistics stats;
-    std::unique_ptr<vectorized::Column> pk_column;
-    if (pk_columns.size() > 1) {
-        if (!PrimaryKeyEncoder::create_column(pkey_schema, &pk_column).ok()) {
-            CHECK(false) << "create column for primary key encoder failed";
-        }
+    ThreadPool* load_pool = nullptr;
+    if (StorageEngine::instance() != nullptr && StorageEngine::instance()->update_manager() != nullptr) {
+        load_pool = StorageEngine::instance()->update_manager()->index_load_thread_pool();
     }
-    // only hold pkey, so can use larger chunk size
-    vector<uint32_t> rowids;
-    rowids.reserve(4096);
-    auto chunk_shared_ptr = vectorized::ChunkHelper::new_chunk(pkey_schema, 4096);
-    auto chunk = chunk_shared_ptr.get();
+    const size_t batch_segments = load_pool != nullptr ? std::max(1, config::update_primary_index_load_threads) : 1;
+    // the segments of a batch are read in parallel, and inserted in order
+    std::vector<SegmentPKs> batch(batch_segments);
+    std::vector<OlapReaderStatistics> seg_stats;
     for (auto& rowset : rowsets) {
         RowsetReleaseGuard guard(rowset);
         auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
-        auto res =
-                beta_rowset->get_segment_iterators2(pkey_schema, tablet->data_dir()->get_meta(), apply_version, &stats);
+        auto res = beta_rowset->get_segment_iterators2(pkey_schema, tablet->data_dir()->get_meta(), apply_version,
+                                                       &seg_stats);
         if (!res.ok()) {
             return res.status();
         }
         auto& itrs = res.value();
         // TODO(cbl): auto close iterators on failure
         CHECK(itrs.size() == rowset->num_segments()) << "itrs.size != num_segments";
-        for (size_t i = 0; i < itrs.size(); i++) {
-            auto itr = itrs[i].get();
-            if (itr == nullptr) {
-                continue;
-            }
-            while (true) {
-                chunk->reset();
-                rowids.clear();
-                auto st = itr->get_next(chunk, &rowids);
-                if (st.is_end_of_file()) {
-                    break;
-                } else if (!st.ok()) {
-                    return st;
-                } else {
-                    vectorized::Column* pkc = nullptr;
-                    if (pk_column) {
-                        pk_column->reset_column();
-                        PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), pk_column.get());
-                        pkc = pk_column.get();
-                    } else {
-                        pkc = chunk->columns()[0].get();
-                    }
-                    auto st = insert(rowset->rowset_meta()->get_rowset_seg_id() + i, rowids, *pkc);
+        for (size_t begin = 0; begin < itrs.size(); begin += batch_segments) {
+            const size_t n = std::min(batch_segments, itrs.size() - begin);
+            if (n == 1) {
+                batch[0].status = _read_segment_pks(pkey_schema, itrs[begin].get(), &batch[0]);
+            } else {
+                CountDownLatch latch(n);
+                for (size_t j = 0; j < n; j++) {
+                    auto itr = itrs[begin + j].get();
+                    auto* out = &batch[j];
+                    Status st = load_pool->submit_func([&pkey_schema, itr, out, &latch]() {
+                        out->status = _read_segment_pks(pkey_schema, itr, out);
+                        latch.count_down();
+                    });
                     if (!st.ok()) {
-                        LOG(ERROR) << "load index failed: tablet=" << tablet->tablet_id()
-                                   << " rowsets:" << int_list_to_string(rowset_ids)
-                                   << " rowset:" << rowset->rowset_meta()->get_rowset_seg_id() << " segment:" << i
-                                   << " reason: " << st.to_string() << " current_size:" << size()
-                                   << " updates: " << tablet->updates()->debug_string();
-                        return st;
+                        // the pool is busy or shutting down, read it in this thread instead
+                        out->status = _read_segment_pks(pkey_schema, itr, out);
+                        latch.count_down();
                     }
                 }
+                latch.wait();
+            }
+            for (size_t j = 0; j < n; j++) {
+                const size_t i = begin + j;
+                auto& pks = batch[j];
+                if (!pks.status.ok()) {
+                    return pks.status;
+                }
+                if (pks.pk_column == nullptr || pks.rowids.empty()) {
+                    continue;
+                }
+                auto st = insert(rowset->rowset_meta()->get_rowset_seg_id() + i, pks.rowids, *pks.pk_column);
+                if (!st.ok()) {
+                    LOG(ERROR) << "load index failed: tablet=" << tablet->tablet_id()
+                               << " rowsets:" << int_list_to_string(rowset_ids)
+                               << " rowset:" << rowset->rowset_meta()->get_rowset_seg_id() << " segment:" << i
+                               << " reason: " << st.to_string() << " current_size:" << size()
+                               << " updates: " << tablet->updates()->debug_string();
+                    return st;
+                }
+                pks.pk_column.reset();
+                pks.rowids = vector<uint32_t>();
             }
-            itr->close();
         }
     }
     _tablet_id = tablet->tablet_id();
@@ -91,6 +91,17 @@ public:
 private:
     void _set_schema(const vectorized::Schema& pk_schema);
 
+    // the primary keys of a segment and their rowids
+    struct SegmentPKs {
+        Status status;
+        vector<uint32_t> rowids;
+        std::unique_ptr<vectorized::Column> pk_column;
+    };
+
+    // reads all the (encoded) primary keys of a segment, it can be called by many threads at the same time
+    static Status _read_segment_pks(const vectorized::Schema& pkey_schema, vectorized::ChunkIterator* itr,
+                                    SegmentPKs* out);
+
     Status _do_load(Tablet* tablet);
 
     std::mutex _lock;
@@ -0,0 +1,235 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/page_builder.h" // for PageBuilder
+#include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "storage/types.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// The decoding cost of an encoding relative to PLAIN_ENCODING, see AdaptivePageBuilder.
+inline double adaptive_page_decode_cost(EncodingTypePB encoding) {
+    switch (encoding) {
+    case PLAIN_ENCODING:
+        return 0;
+    case BIT_SHUFFLE:
+    case RLE:
+        return 1;
+    case FOR_ENCODING:
+    case DELTA_ENCODING:
+        return 1.5;
+    case GORILLA_ENCODING:
+        return 3;
+    default:
+        return 1;
+    }
+}
+
+// AdaptivePageBuilder picks the encoding of every page from the encodings of the type: the values of the page
+// are buffered, a sample of them is encoded with every candidate, and the page is encoded with the one of the
+// lowest cost, i.e. the encoded size * (1 + adaptive_encoding_decode_cost_weight * decoding cost). So a
+// column whose distribution changes within a segment isn't stuck with one poor encoding.
+//
+// The page is the encoding type (fixed32) followed by the page of that encoding, as BinaryDictPageBuilder.
+template <FieldType Type>
+class AdaptivePageBuilder final : public PageBuilder {
+public:
+    using CppType = typename TypeTraits<Type>::CppType;
+
+    explicit AdaptivePageBuilder(const PageBuilderOptions& options)
+            : _options(options), _max_count(std::max<size_t>(1, options.data_page_size / sizeof(CppType))) {
+        for (EncodingTypePB encoding :
+             {BIT_SHUFFLE, FOR_ENCODING, DELTA_ENCODING, GORILLA_ENCODING, RLE, PLAIN_ENCODING}) {
+            const EncodingInfo* info = nullptr;
+            if (EncodingInfo::get(Type, encoding, &info).ok()) {
+                _candidates.push_back(info);
+            }
+        }
+        _values.reserve(_max_count);
+    }
+
+    ~AdaptivePageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        size_t to_add = std::min(_max_count - _values.size(), count);
+        const auto* values = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), values, values + to_add);
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _buf.clear();
+        _buf.resize(ADAPTIVE_PAGE_HEADER_SIZE);
+
+        // The sample is the runs spread over the page, every run is encoded on its own so that the runs keep
+        // the locality of the values for the delta and the run length encodings.
+        constexpr size_t kSampleRuns = 4;
+        const size_t sample_rows = std::max(config::adaptive_encoding_sample_rows, 1);
+        const bool sample_all = _values.size() <= sample_rows;
+        const size_t num_runs = sample_all ? 1 : kSampleRuns;
+        const size_t run_size = sample_all ? _values.size() : std::max<size_t>(1, sample_rows / kSampleRuns);
+        const size_t stride = _values.size() / num_runs;
+
+        const EncodingInfo* best = nullptr;
+        double best_cost = 0;
+        faststring best_page;
+        for (const EncodingInfo* candidate : _candidates) {
+            faststring page;
+            size_t encoded_size = 0;
+            bool encoded = true;
+            for (size_t i = 0; i < num_runs && encoded; i++) {
+                size_t begin = i * stride;
+                size_t count = std::min(run_size, _values.size() - begin);
+                encoded = _encode(candidate, _values.data() + begin, count, &page).ok();
+                encoded_size += page.size();
+            }
+            if (!encoded) {
+                continue;
+            }
+            double cost = static_cast<double>(encoded_size) *
+                          (1 + config::adaptive_encoding_decode_cost_weight *
+                                       adaptive_page_decode_cost(candidate->encoding()));
+            if (best == nullptr || cost < best_cost) {
+                best = candidate;
+                best_cost = cost;
+                best_page.swap(page);
+            }
+        }
+        DCHECK(best != nullptr);
+        if (!sample_all && !_encode(best, _values.data(), _values.size(), &best_page).ok()) {
+            best = nullptr;
+        }
+        if (best == nullptr) {
+            // PLAIN_ENCODING is a candidate of every type
+            CHECK(EncodingInfo::get(Type, PLAIN_ENCODING, &best).ok());
+            CHECK(_encode(best, _values.data(), _values.size(), &best_page).ok());
+        }
+        encode_fixed32_le(_buf.data(), best->encoding());
+        _buf.append(best_page.data(), best_page.size());
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _buf.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _values.size() * sizeof(CppType); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    Status _encode(const EncodingInfo* encoding, const CppType* values, size_t count, faststring* page) {
+        PageBuilder* builder = nullptr;
+        RETURN_IF_ERROR(encoding->create_page_builder(_options, &builder));
+        std::unique_ptr<PageBuilder> builder_ptr(builder);
+        size_t added = builder->add(reinterpret_cast<const uint8_t*>(values), count);
+        if (added != count) {
+            return Status::InternalError(strings::Substitute("encoding $0 takes $1 of $2 values",
+                                                             encoding->encoding(), added, count));
+        }
+        faststring* data = builder->finish();
+        page->clear();
+        page->append(data->data(), data->size());
+        return Status::OK();
+    }
+
+    const PageBuilderOptions _options;
+    const size_t _max_count;
+    std::vector<const EncodingInfo*> _candidates;
+    std::vector<CppType> _values;
+    faststring _buf;
+    bool _finished = false;
+};
+
+template <FieldType Type>
+class AdaptivePageDecoder final : public PageDecoder {
+public:
+    AdaptivePageDecoder(Slice data, const PageDecoderOptions& options) : _data(data), _options(options) {}
+
+    ~AdaptivePageDecoder() override = default;
+
+    Status init() override {
+        CHECK(_page_decoder == nullptr);
+        if (_data.size < ADAPTIVE_PAGE_HEADER_SIZE) {
+            return Status::Corruption(strings::Substitute("invalid data size:$0, header size:$1", _data.size,
+                                                          ADAPTIVE_PAGE_HEADER_SIZE));
+        }
+        auto encoding = static_cast<EncodingTypePB>(decode_fixed32_le(reinterpret_cast<const uint8_t*>(_data.data)));
+        if (encoding == ADAPTIVE_ENCODING) {
+            return Status::Corruption("invalid encoding of adaptive page");
+        }
+        const EncodingInfo* info = nullptr;
+        RETURN_IF_ERROR(EncodingInfo::get(Type, encoding, &info));
+        Slice page(_data.data + ADAPTIVE_PAGE_HEADER_SIZE, _data.size - ADAPTIVE_PAGE_HEADER_SIZE);
+        PageDecoder* decoder = nullptr;
+        RETURN_IF_ERROR(info->create_page_decoder(page, _options, &decoder));
+        _page_decoder.reset(decoder);
+        return _page_decoder->init();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override { return _page_decoder->seek_to_position_in_page(pos); }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        return _page_decoder->seek_at_or_after_value(value, exact_match);
+    }
+
+    size_t seek_forward(size_t n) override { return _page_decoder->seek_forward(n); }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override { return _page_decoder->next_batch(n, dst); }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override { return _page_decoder->next_batch(n, dst); }
+
+    Status next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) override {
+        return _page_decoder->next_batch(range, dst);
+    }
+
+    size_t count() const override { return _page_decoder->count(); }
+
+    size_t current_index() const override { return _page_decoder->current_index(); }
+
+    EncodingTypePB encoding_type() const override { return ADAPTIVE_ENCODING; }
+
+    // The encoding chosen for this page.
+    EncodingTypePB page_encoding_type() const { return _page_decoder->encoding_type(); }
+
+private:
+    Slice _data;
+    PageDecoderOptions _options;
+    std::unique_ptr<PageDecoder> _page_decoder;
+};
+
+} // namespace starrocks
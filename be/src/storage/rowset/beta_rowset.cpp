@@ -25,6 +25,7 @@
 #include <util/file_utils.h>
 
 #include <cstdio> // for remove()
+#include <limits>
 #include <memory>
 #include <set>
 
@@ -246,6 +247,7 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     seg_options.stats = options.stats;
     seg_options.ranges = options.ranges;
     seg_options.predicates = options.predicates;
+    seg_options.column_exprs = options.column_exprs;
     seg_options.use_page_cache = options.use_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
@@ -255,6 +257,7 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     if (options.delete_predicates != nullptr) {
         seg_options.delete_predicates = options.delete_predicates->get_predicates(end_version());
     }
+    seg_options.key_split_range = options.key_split_range;
     if (options.is_primary_keys) {
         seg_options.is_primary_keys = true;
         seg_options.tablet_id = rowset_meta()->tablet_id();
@@ -280,10 +283,26 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     if (options.stats) {
         options.stats->segments_read_count += num_segments();
     }
+    const int64_t rowid_range_end = options.rowid_range_end < 0 ? std::numeric_limits<int64_t>::max()
+                                                                 : options.rowid_range_end;
+    int64_t segment_offset = 0;
     for (auto& seg_ptr : segments()) {
+        const int64_t segment_begin = segment_offset;
+        segment_offset += seg_ptr->num_rows();
         if (seg_ptr->num_rows() == 0) {
             continue;
         }
+        // Skip the segments out of the rowid range, and only read the overlapped part of the others.
+        if (segment_offset <= options.rowid_range_begin || segment_begin >= rowid_range_end) {
+            continue;
+        }
+        if (segment_begin < options.rowid_range_begin || segment_offset > rowid_range_end) {
+            int64_t begin = std::max(segment_begin, options.rowid_range_begin) - segment_begin;
+            int64_t end = std::min(segment_offset, rowid_range_end) - segment_begin;
+            seg_options.rowid_range = vectorized::Range(begin, end);
+        } else {
+            seg_options.rowid_range.reset();
+        }
         auto res = seg_ptr->new_iterator(segment_schema, seg_options);
         if (res.status().is_end_of_file()) {
             continue;
@@ -317,11 +336,23 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
 StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::get_segment_iterators2(const vectorized::Schema& schema,
                                                                                        KVStore* meta, int64_t version,
                                                                                        OlapReaderStatistics* stats) {
+    return _get_segment_iterators2(schema, meta, version, [stats](size_t) { return stats; });
+}
+
+StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::get_segment_iterators2(
+        const vectorized::Schema& schema, KVStore* meta, int64_t version,
+        std::vector<OlapReaderStatistics>* seg_stats) {
+    seg_stats->assign(num_segments(), OlapReaderStatistics());
+    return _get_segment_iterators2(schema, meta, version, [seg_stats](size_t i) { return &(*seg_stats)[i]; });
+}
+
+StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::_get_segment_iterators2(
+        const vectorized::Schema& schema, KVStore* meta, int64_t version,
+        const std::function<OlapReaderStatistics*(size_t)>& stats_of) {
     RETURN_IF_ERROR(load());
 
     vectorized::SegmentReadOptions seg_options;
     seg_options.block_mgr = fs::fs_util::block_manager();
-    seg_options.stats = stats;
     seg_options.is_primary_keys = meta != nullptr;
     seg_options.tablet_id = rowset_meta()->tablet_id();
     seg_options.rowset_id = rowset_meta()->get_rowset_seg_id();
@@ -336,6 +367,7 @@ StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::get_segment_iter
         if (seg_ptr->num_rows() == 0) {
             continue;
         }
+        seg_options.stats = stats_of(i);
         auto res = seg_ptr->new_iterator(schema, seg_options);
         if (res.status().is_end_of_file()) {
             continue;
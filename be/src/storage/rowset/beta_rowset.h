@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "common/statusor.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
@@ -76,6 +78,11 @@ public:
                                                                                KVStore* meta, int64_t version,
                                                                                OlapReaderStatistics* stats);
 
+    // like above, but each iterator uses its own stats in |seg_stats|, so they can be read in parallel
+    StatusOr<std::vector<vectorized::ChunkIteratorPtr>> get_segment_iterators2(
+            const vectorized::Schema& schema, KVStore* meta, int64_t version,
+            std::vector<OlapReaderStatistics>* seg_stats);
+
     static std::string segment_file_path(const std::string& segment_dir, const RowsetId& rowset_id, int segment_id);
 
     static std::string segment_temp_file_path(const std::string& dir, const RowsetId& rowset_id, int segment_id);
@@ -114,6 +121,11 @@ protected:
 private:
     friend class RowsetFactory;
     friend class BetaRowsetReader;
+
+    StatusOr<std::vector<vectorized::ChunkIteratorPtr>> _get_segment_iterators2(
+            const vectorized::Schema& schema, KVStore* meta, int64_t version,
+            const std::function<OlapReaderStatistics*(size_t)>& stats_of);
+
     std::vector<SegmentSharedPtr> _segments;
 };
 
@@ -94,6 +94,9 @@ Status BetaRowsetWriter::init() {
     _writer_options.storage_format_version = _context.storage_format_version;
     _writer_options.global_dicts = _context.global_dicts != nullptr ? _context.global_dicts : nullptr;
     _writer_options.referenced_column_ids = _context.referenced_column_ids;
+    if (StorageEngine::instance() != nullptr) {
+        _writer_options.encode_thread_pool = StorageEngine::instance()->segment_encode_thread_pool();
+    }
 
     if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS && _context.partial_update_tablet_schema) {
         _rowset_txn_meta_pb = std::make_unique<RowsetTxnMetaPB>();
@@ -37,6 +37,9 @@ struct BloomFilterOptions {
     // false positive probablity
     double fpp = 0.05;
     HashStrategyPB strategy = HASH_MURMUR3_X64_64;
+    // build the filters of the n-grams of this many bytes of the values instead of the values if it's not 0,
+    // only for CHAR and VARCHAR
+    uint32_t gram_num = 0;
 };
 
 // Base class for bloom filter
@@ -34,6 +34,7 @@ Status BloomFilterIndexReader::load(fs::BlockManager* block_mgr, const std::stri
     _typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
     _algorithm = bloom_filter_index_meta->algorithm();
     _hash_strategy = bloom_filter_index_meta->hash_strategy();
+    _gram_num = bloom_filter_index_meta->gram_num();
     const IndexedColumnMetaPB& bf_index_meta = bloom_filter_index_meta->bloom_filter();
 
     _bloom_filter_reader = std::make_unique<IndexedColumnReader>(block_mgr, file_name, bf_index_meta);
@@ -23,6 +23,7 @@
 
 #include <map>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 
 #include "env/env.h"
@@ -33,6 +34,7 @@
 #include "storage/rowset/encoding_info.h"
 #include "storage/rowset/indexed_column_writer.h"
 #include "storage/types.h"
+#include "util/murmur_hash3.h"
 #include "util/slice.h"
 
 namespace starrocks {
@@ -60,6 +62,22 @@ constexpr bool is_int128() {
     return type == OLAP_FIELD_TYPE_LARGEINT || type == OLAP_FIELD_TYPE_DECIMAL_V2;
 }
 
+Status write_bloom_filters(fs::WritableBlock* wblock, const std::vector<std::unique_ptr<BloomFilter>>& bfs,
+                           IndexedColumnMetaPB* meta) {
+    TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = false;
+    options.encoding = PLAIN_ENCODING;
+    IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
+    RETURN_IF_ERROR(bf_writer.init());
+    for (auto& bf : bfs) {
+        Slice data(bf->data(), bf->size());
+        bf_writer.add(&data);
+    }
+    return bf_writer.finish(meta);
+}
+
 template <FieldType type>
 inline typename CppTypeTraits<type>::CppType get_value(const typename CppTypeTraits<type>::CppType* v,
                                                        const TypeInfoPtr& type_info, MemPool* pool) {
@@ -135,21 +153,7 @@ public:
         BloomFilterIndexPB* meta = index_meta->mutable_bloom_filter_index();
         meta->set_hash_strategy(_bf_options.strategy);
         meta->set_algorithm(BLOCK_BLOOM_FILTER);
-
-        // write bloom filters
-        TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
-        IndexedColumnWriterOptions options;
-        options.write_ordinal_index = true;
-        options.write_value_index = false;
-        options.encoding = PLAIN_ENCODING;
-        IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
-        RETURN_IF_ERROR(bf_writer.init());
-        for (auto& bf : _bfs) {
-            Slice data(bf->data(), bf->size());
-            bf_writer.add(&data);
-        }
-        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
-        return Status::OK();
+        return write_bloom_filters(wblock, _bfs, meta->mutable_bloom_filter());
     }
 
     uint64_t size() override {
@@ -169,12 +173,83 @@ private:
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
+// Builder for the n-gram bloom filter of a CHAR or VARCHAR column. Like BloomFilterIndexWriterImpl, it builds
+// a bloom filter page by every data page, but the filter is of all the n-grams of the values, e.g. 'abcd' adds
+// 'abc' and 'bcd' for 3-grams, so that a page can be skipped if an n-gram of the substrings of a LIKE pattern
+// is not in it. The values shorter than n add nothing.
+class NgramBloomFilterIndexWriterImpl : public BloomFilterIndexWriter {
+public:
+    explicit NgramBloomFilterIndexWriterImpl(const BloomFilterOptions& bf_options) : _bf_options(bf_options) {}
+
+    ~NgramBloomFilterIndexWriterImpl() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const size_t gram_num = _bf_options.gram_num;
+        const auto* v = reinterpret_cast<const Slice*>(values);
+        for (size_t i = 0; i < count; ++i, ++v) {
+            Slice value = unaligned_load<Slice>(v);
+            for (size_t j = 0; j + gram_num <= value.size; ++j) {
+                // the same hash as BloomFilter::hash of HASH_MURMUR3_X64_64
+                uint64_t hash;
+                murmur_hash3_x64_64(value.data + j, gram_num, BloomFilter::DEFAULT_SEED, &hash);
+                _hashes.insert(hash);
+            }
+        }
+    }
+
+    void add_nulls(uint32_t count) override { _has_null |= (count > 0); }
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_hashes.size(), _bf_options.fpp, _bf_options.strategy));
+        bf->set_has_null(_has_null);
+        for (uint64_t hash : _hashes) {
+            bf->add_hash(hash);
+        }
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _hashes.clear();
+        return Status::OK();
+    }
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) override {
+        if (!_hashes.empty()) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_ngram_bloom_filter_index();
+        meta->set_hash_strategy(_bf_options.strategy);
+        meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        meta->set_gram_num(_bf_options.gram_num);
+        return write_bloom_filters(wblock, _bfs, meta->mutable_bloom_filter());
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _hashes.size() * sizeof(uint64_t); }
+
+private:
+    BloomFilterOptions _bf_options;
+    bool _has_null = false;
+    uint64_t _bf_buffer_size = 0;
+    // the distinct hashes of the n-grams of the current page
+    std::unordered_set<uint64_t> _hashes;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
 } // namespace
 
 // TODO currently we don't support bloom filter index for tinyint/hll/float/double
 Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
                                       std::unique_ptr<BloomFilterIndexWriter>* res) {
     FieldType type = typeinfo->type();
+    if (bf_options.gram_num > 0) {
+        if (type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR) {
+            return Status::NotSupported("unsupported type for ngram bloom filter: " + std::to_string(type));
+        }
+        DCHECK_EQ(HASH_MURMUR3_X64_64, bf_options.strategy);
+        *res = std::make_unique<NgramBloomFilterIndexWriterImpl>(bf_options);
+        return Status::OK();
+    }
     switch (type) {
     case OLAP_FIELD_TYPE_SMALLINT:
         *res = std::make_unique<BloomFilterIndexWriterImpl<OLAP_FIELD_TYPE_SMALLINT>>(bf_options, typeinfo);
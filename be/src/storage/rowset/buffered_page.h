@@ -0,0 +1,222 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/page_builder.h" // for PageBuilder
+#include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "storage/types.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/unaligned_access.h"
+
+namespace starrocks {
+
+// The modes of the pages of the adaptive numeric encodings, the first byte of the page, see
+// BufferedPageBuilder.
+enum class NumericPageMode : uint8_t {
+    PLAIN = 0,
+    DELTA = 1,
+    DELTA_OF_DELTA = 2,
+    GORILLA = 3,
+};
+
+// The header of a page of BufferedPageBuilder: the mode and the number of the values.
+static constexpr size_t NUMERIC_PAGE_HEADER_SIZE = 5;
+
+// BufferedPageBuilder is the base of the page builders which see the values of the whole page before
+// encoding them, so that they pick the best mode for each page: the values are kept as they are added
+// and encoded by _encode() of the subclass at finish(). The result with the PLAIN mode is taken instead if
+// it's not smaller.
+template <FieldType Type>
+class BufferedPageBuilder : public PageBuilder {
+public:
+    using CppType = typename TypeTraits<Type>::CppType;
+
+    explicit BufferedPageBuilder(const PageBuilderOptions& options)
+            : _max_count(std::max<size_t>(1, options.data_page_size / sizeof(CppType))) {
+        _values.reserve(_max_count);
+    }
+
+    ~BufferedPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        size_t to_add = std::min(_max_count - _values.size(), count);
+        const auto* values = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), values, values + to_add);
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _buf.clear();
+        _buf.resize(NUMERIC_PAGE_HEADER_SIZE);
+        NumericPageMode mode = NumericPageMode::PLAIN;
+        if (!_values.empty()) {
+            mode = _encode(_values.data(), _values.size(), &_buf);
+        }
+        if (mode == NumericPageMode::PLAIN || _buf.size() >= NUMERIC_PAGE_HEADER_SIZE + _plain_size()) {
+            mode = NumericPageMode::PLAIN;
+            _buf.resize(NUMERIC_PAGE_HEADER_SIZE);
+            _buf.append(_values.data(), _plain_size());
+        }
+        _buf[0] = static_cast<uint8_t>(mode);
+        encode_fixed32_le(_buf.data() + 1, _values.size());
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _buf.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _plain_size(); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+protected:
+    // Appends the encoded |values| to |buf| and returns the mode of them, or returns PLAIN if the values
+    // shouldn't be encoded by this builder.
+    virtual NumericPageMode _encode(const CppType* values, size_t count, faststring* buf) = 0;
+
+private:
+    size_t _plain_size() const { return _values.size() * sizeof(CppType); }
+
+    const size_t _max_count;
+    std::vector<CppType> _values;
+    faststring _buf;
+    bool _finished = false;
+};
+
+// DecodedPageDecoder is the base of the page decoders of BufferedPageBuilder: the values of the whole page
+// are decoded by _decode() of the subclass into a buffer at init(), then copied into the columns in batches.
+template <FieldType Type>
+class DecodedPageDecoder : public PageDecoder {
+public:
+    using CppType = typename TypeTraits<Type>::CppType;
+
+    explicit DecodedPageDecoder(Slice data) : _data(data) {}
+
+    ~DecodedPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < NUMERIC_PAGE_HEADER_SIZE) {
+            return Status::Corruption(strings::Substitute("invalid numeric page size: $0", _data.size));
+        }
+        auto mode = static_cast<NumericPageMode>(_data.data[0]);
+        size_t count = decode_fixed32_le(reinterpret_cast<const uint8_t*>(_data.data) + 1);
+        Slice body(_data.data + NUMERIC_PAGE_HEADER_SIZE, _data.size - NUMERIC_PAGE_HEADER_SIZE);
+        _values.resize(count);
+        if (mode == NumericPageMode::PLAIN) {
+            if (body.size != count * sizeof(CppType)) {
+                return Status::Corruption(strings::Substitute("invalid plain numeric page size: $0", _data.size));
+            }
+            if (count > 0) {
+                memcpy(_values.data(), body.data, body.size);
+            }
+        } else if (count > 0) {
+            RETURN_IF_ERROR(_decode(mode, body, _values.data(), count));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _values.size());
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        const CppType target = unaligned_load<CppType>(value);
+        auto it = std::lower_bound(_values.begin(), _values.end(), target);
+        if (it == _values.end()) {
+            return Status::NotFound("all value small than the value");
+        }
+        *exact_match = *it == target;
+        _cur_index = it - _values.begin();
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        size_t to_fetch = std::min(*n, _values.size() - _cur_index);
+        memcpy(dst->data(), _values.data() + _cur_index, to_fetch * sizeof(CppType));
+        _cur_index += to_fetch;
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override {
+        vectorized::SparseRange read_range;
+        size_t begin = current_index();
+        read_range.add(vectorized::Range(begin, begin + *n));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *n = current_index() - begin;
+        return Status::OK();
+    }
+
+    Status next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(_cur_index >= _values.size())) {
+            return Status::OK();
+        }
+        size_t to_read = std::min<size_t>(range.span_size(), _values.size() - _cur_index);
+        vectorized::SparseRangeIterator iter = range.new_iterator();
+        while (to_read > 0) {
+            _cur_index = iter.begin();
+            vectorized::Range r = iter.next(to_read);
+            int n = dst->append_numbers(_values.data() + _cur_index, r.span_size() * sizeof(CppType));
+            DCHECK_EQ(r.span_size(), n);
+            _cur_index += r.span_size();
+            to_read -= r.span_size();
+        }
+        return Status::OK();
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    size_t current_index() const override { return _cur_index; }
+
+protected:
+    // Decodes the |count| values of |body| encoded with |mode| into |values|.
+    virtual Status _decode(NumericPageMode mode, const Slice& body, CppType* values, size_t count) = 0;
+
+private:
+    Slice _data;
+    std::vector<CppType> _values;
+    size_t _cur_index = 0;
+    bool _parsed = false;
+};
+
+} // namespace starrocks
@@ -46,6 +46,8 @@ struct ColumnIteratorOptions {
     fs::ReadableBlock* rblock = nullptr;
     // reader statistics
     OlapReaderStatistics* stats = nullptr;
+    // the statistics of this column in `stats`, null if they're not collected
+    ColumnReadStatistics* column_stats = nullptr;
     bool use_page_cache = false;
 
     // check whether column pages are all dictionary encoding.
@@ -62,6 +64,10 @@ struct ColumnIteratorOptions {
 
     ReaderType reader_type = READER_QUERY;
     int chunk_size = DEFAULT_CHUNK_SIZE;
+
+    // the rows going to be read, the pages without any of them are not worth reading ahead.
+    // null means all rows are read.
+    const vectorized::SparseRange* read_range = nullptr;
 };
 
 // Base iterator to read one column data
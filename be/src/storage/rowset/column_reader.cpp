@@ -36,6 +36,7 @@
 #include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/bloom_filter_index_reader.h"
 #include "storage/rowset/encoding_info.h"
+#include "storage/rowset/inverted_index_reader.h"
 #include "storage/rowset/page_handle.h" // for PageHandle
 #include "storage/rowset/page_io.h"
 #include "storage/rowset/page_pointer.h" // for PagePointer
@@ -65,7 +66,9 @@ ColumnReader::ColumnReader(MemTracker* mem_tracker, const private_type&, const C
           _zone_map_index(),
           _ordinal_index(),
           _bitmap_index(),
-          _bloom_filter_index() {
+          _bloom_filter_index(),
+          _inverted_index(),
+          _ngram_bloom_filter_index() {
     _mem_tracker->consume(sizeof(ColumnReader));
 }
 
@@ -103,6 +106,25 @@ ColumnReader::~ColumnReader() {
         size += _bloom_filter_index.reader->mem_usage();
         delete _bloom_filter_index.reader;
     }
+    if (_flags[kHasInvertedIndexMetaPos]) {
+        size += _inverted_index.meta->SpaceUsedLong();
+        delete _inverted_index.meta;
+    }
+    if (_flags[kHasInvertedIndexReaderPos]) {
+        size += _inverted_index.reader->mem_usage();
+        delete _inverted_index.reader;
+    }
+    if (_flags[kHasNgramBloomFilterIndexMetaPos]) {
+        size += _ngram_bloom_filter_index.meta->SpaceUsedLong();
+        delete _ngram_bloom_filter_index.meta;
+    }
+    if (_flags[kHasNgramBloomFilterIndexReaderPos]) {
+        size += _ngram_bloom_filter_index.reader->mem_usage();
+        delete _ngram_bloom_filter_index.reader;
+    }
+    if (_zstd_dict_codec != nullptr) {
+        size += _zstd_dict_codec->mem_usage();
+    }
     _mem_tracker->release(size);
 }
 
@@ -115,6 +137,7 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
     _flags.set(kHasAllDictEncodedPos, meta->has_all_dict_encoded());
     _flags.set(kAllDictEncodedPos, meta->all_dict_encoded());
     _flags.set(kIsNullablePos, meta->is_nullable());
+    _flags.set(kIsSortedPos, meta->is_sorted());
 
     if (_column_type == OLAP_FIELD_TYPE_JSON && meta->has_json_meta()) {
         // TODO(mofei) store format_version in ColumnReader
@@ -125,6 +148,12 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
     if (is_scalar_field_type(delegate_type(_column_type))) {
         RETURN_IF_ERROR(EncodingInfo::get(delegate_type(_column_type), meta->encoding(), &_encoding_info));
         RETURN_IF_ERROR(get_block_compression_codec(meta->compression(), &_compress_codec));
+        if (meta->has_zstd_dict()) {
+            ASSIGN_OR_RETURN(_zstd_dict_codec, ZstdDictBlockCompression::create(std::move(*meta->mutable_zstd_dict())));
+            meta->clear_zstd_dict();
+            _compress_codec = _zstd_dict_codec.get();
+            _mem_tracker->consume(_zstd_dict_codec->mem_usage());
+        }
 
         for (int i = 0; i < meta->indexes_size(); i++) {
             auto* index_meta = meta->mutable_indexes(i);
@@ -150,6 +179,16 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
                 _flags.set(kHasBloomFilterIndexMetaPos, true);
                 _mem_tracker->consume(_bloom_filter_index.meta->SpaceUsedLong());
                 break;
+            case INVERTED_INDEX:
+                _inverted_index.meta = index_meta->release_inverted_index();
+                _flags.set(kHasInvertedIndexMetaPos, true);
+                _mem_tracker->consume(_inverted_index.meta->SpaceUsedLong());
+                break;
+            case NGRAM_BLOOM_FILTER_INDEX:
+                _ngram_bloom_filter_index.meta = index_meta->release_ngram_bloom_filter_index();
+                _flags.set(kHasNgramBloomFilterIndexMetaPos, true);
+                _mem_tracker->consume(_ngram_bloom_filter_index.meta->SpaceUsedLong());
+                break;
             case UNKNOWN_INDEX_TYPE:
                 return Status::Corruption(fmt::format("Bad file {}: unknown index type", _file_name));
             }
@@ -158,6 +197,24 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
             return Status::Corruption(
                     fmt::format("Bad file {}: missing ordinal index for column {}", _file_name, meta->column_id()));
         }
+        if (_column_type == OLAP_FIELD_TYPE_JSON && meta->has_json_meta() &&
+            meta->json_meta().flat_fields_size() > 0) {
+            const JsonMetaPB& json_meta = meta->json_meta();
+            if (meta->children_columns_size() != json_meta.flat_fields_size()) {
+                return Status::Corruption(fmt::format("Bad file {}: json column {} has {} flat fields but {} children",
+                                                      _file_name, meta->column_id(), json_meta.flat_fields_size(),
+                                                      meta->children_columns_size()));
+            }
+            _flat_json_fields = std::make_unique<std::vector<std::string>>(json_meta.flat_fields().begin(),
+                                                                           json_meta.flat_fields().end());
+            _sub_readers = std::make_unique<SubReaderList>();
+            _sub_readers->reserve(meta->children_columns_size());
+            for (int i = 0; i < meta->children_columns_size(); i++) {
+                auto res = ColumnReader::create(_mem_tracker, _opts, meta->mutable_children_columns(i), _file_name);
+                RETURN_IF_ERROR(res);
+                _sub_readers->emplace_back(std::move(res).value());
+            }
+        }
         return Status::OK();
     } else if (_column_type == FieldType::OLAP_FIELD_TYPE_ARRAY) {
         _sub_readers = std::make_unique<SubReaderList>();
@@ -203,24 +260,44 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
     }
 }
 
+ColumnReader* ColumnReader::flat_json_reader(const std::string& name) const {
+    if (_flat_json_fields == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < _flat_json_fields->size(); i++) {
+        if ((*_flat_json_fields)[i] == name) {
+            return (*_sub_readers)[i].get();
+        }
+    }
+    return nullptr;
+}
+
 Status ColumnReader::new_bitmap_index_iterator(BitmapIndexIterator** iterator) {
     RETURN_IF_ERROR(_load_bitmap_index_once());
     RETURN_IF_ERROR(_bitmap_index.reader->new_iterator(iterator));
     return Status::OK();
 }
 
+Status ColumnReader::new_inverted_index_iterator(InvertedIndexIterator** iterator) {
+    RETURN_IF_ERROR(_load_inverted_index_once());
+    RETURN_IF_ERROR(_inverted_index.reader->new_iterator(iterator));
+    return Status::OK();
+}
+
 Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp, PageHandle* handle,
-                               Slice* page_body, PageFooterPB* footer) {
+                               Slice* page_body, PageFooterPB* footer, const PageReadBuffer* read_buffer) {
     iter_opts.sanity_check();
     PageReadOptions opts;
     opts.rblock = iter_opts.rblock;
     opts.page_pointer = pp;
     opts.codec = _compress_codec;
     opts.stats = iter_opts.stats;
+    opts.column_stats = iter_opts.column_stats;
     opts.verify_checksum = _opts.verify_checksum;
     opts.use_page_cache = iter_opts.use_page_cache;
     opts.encoding_type = _encoding_info->encoding();
     opts.kept_in_memory = _opts.kept_in_memory;
+    opts.read_buffer = read_buffer;
 
     return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
 }
@@ -256,20 +333,7 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     vectorized::SparseRange bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
     RETURN_IF_ERROR(_bloom_filter_index.reader->new_iterator(&bf_iter));
-    size_t range_size = row_ranges->size();
-    // get covered page ids
-    std::set<int32_t> page_ids;
-    for (int i = 0; i < range_size; ++i) {
-        vectorized::Range r = (*row_ranges)[i];
-        int64_t idx = r.begin();
-        auto iter = _ordinal_index.reader->seek_at_or_before(r.begin());
-        while (idx < r.end()) {
-            page_ids.insert(iter.page_index());
-            idx = static_cast<int>(iter.last_ordinal() + 1);
-            iter.next();
-        }
-    }
-    for (const auto& pid : page_ids) {
+    for (const auto& pid : _page_ids(*row_ranges)) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
         for (const auto* pred : predicates) {
@@ -283,6 +347,49 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     return Status::OK();
 }
 
+// prerequisite: at least one predicate in |predicates| support ngram bloom filter.
+Status ColumnReader::ngram_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                        vectorized::SparseRange* row_ranges) {
+    RETURN_IF_ERROR(_load_ngram_bloom_filter_index_once());
+    vectorized::SparseRange bf_row_ranges;
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    RETURN_IF_ERROR(_ngram_bloom_filter_index.reader->new_iterator(&bf_iter));
+    const size_t gram_num = _ngram_bloom_filter_index.reader->gram_num();
+    for (const auto& pid : _page_ids(*row_ranges)) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        // the predicates are conjunctive, the page is skipped if any of them can't be satisfied
+        bool satisfied = true;
+        for (const auto* pred : predicates) {
+            if (pred->support_ngram_bloom_filter() && !pred->ngram_bloom_filter(bf.get(), gram_num)) {
+                satisfied = false;
+                break;
+            }
+        }
+        if (satisfied) {
+            bf_row_ranges.add(vectorized::Range(_ordinal_index.reader->get_first_ordinal(pid),
+                                                _ordinal_index.reader->get_last_ordinal(pid) + 1));
+        }
+    }
+    *row_ranges = row_ranges->intersection(bf_row_ranges);
+    return Status::OK();
+}
+
+std::set<int32_t> ColumnReader::_page_ids(const vectorized::SparseRange& row_ranges) const {
+    std::set<int32_t> page_ids;
+    for (size_t i = 0; i < row_ranges.size(); ++i) {
+        vectorized::Range r = row_ranges[i];
+        int64_t idx = r.begin();
+        auto iter = _ordinal_index.reader->seek_at_or_before(r.begin());
+        while (idx < r.end()) {
+            page_ids.insert(iter.page_index());
+            idx = static_cast<int>(iter.last_ordinal() + 1);
+            iter.next();
+        }
+    }
+    return page_ids;
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     Status st;
     if (_flags[kHasOrdinalIndexMetaPos]) {
@@ -346,6 +453,38 @@ Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_
     return st;
 }
 
+Status ColumnReader::_load_inverted_index(bool use_page_cache, bool kept_in_memory) {
+    Status st;
+    if (_flags[kHasInvertedIndexMetaPos]) {
+        SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+        std::unique_ptr<InvertedIndexPB> index_meta(_inverted_index.meta);
+        _flags.set(kHasInvertedIndexMetaPos, false);
+        _mem_tracker->release(index_meta->SpaceUsedLong());
+        _inverted_index.reader = new InvertedIndexReader();
+        _flags.set(kHasInvertedIndexReaderPos, true);
+        st = _inverted_index.reader->load(_opts.block_mgr, _file_name, index_meta.get(), use_page_cache,
+                                          kept_in_memory);
+        _mem_tracker->consume(_inverted_index.reader->mem_usage());
+    }
+    return st;
+}
+
+Status ColumnReader::_load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
+    Status st;
+    if (_flags[kHasNgramBloomFilterIndexMetaPos]) {
+        SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+        std::unique_ptr<BloomFilterIndexPB> index_meta(_ngram_bloom_filter_index.meta);
+        _flags.set(kHasNgramBloomFilterIndexMetaPos, false);
+        _mem_tracker->release(index_meta->SpaceUsedLong());
+        _ngram_bloom_filter_index.reader = new BloomFilterIndexReader();
+        _flags.set(kHasNgramBloomFilterIndexReaderPos, true);
+        st = _ngram_bloom_filter_index.reader->load(_opts.block_mgr, _file_name, index_meta.get(), use_page_cache,
+                                                    kept_in_memory);
+        _mem_tracker->consume(_ngram_bloom_filter_index.reader->mem_usage());
+    }
+    return st;
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     *iter = _ordinal_index.reader->begin();
     if (!iter->valid()) {
@@ -454,6 +593,19 @@ Status ColumnReader::_load_bloom_filter_index_once() {
     return status;
 }
 
+Status ColumnReader::_load_inverted_index_once() {
+    Status status = _inverted_index_once.call(
+            [this] { return _load_inverted_index(!config::disable_storage_page_cache, _opts.kept_in_memory); });
+    return status;
+}
+
+Status ColumnReader::_load_ngram_bloom_filter_index_once() {
+    Status status = _ngram_bloom_filter_index_once.call([this] {
+        return _load_ngram_bloom_filter_index(!config::disable_storage_page_cache, _opts.kept_in_memory);
+    });
+    return status;
+}
+
 Status ColumnReader::load_ordinal_index_once() {
     // Only load ordinal index.
     // Other indexes like zone map/bitmap/bloomfilter should be load when necessary
@@ -462,4 +614,34 @@ Status ColumnReader::load_ordinal_index_once() {
     return status;
 }
 
+Status ColumnReader::prewarm_indexes() {
+    RETURN_IF_ERROR(load_ordinal_index_once());
+    RETURN_IF_ERROR(_load_zone_map_index_once());
+    if (has_bloom_filter_index()) {
+        RETURN_IF_ERROR(_load_bloom_filter_index_once());
+    }
+    return Status::OK();
+}
+
+Status ColumnReader::prewarm_pages(const ColumnIteratorOptions& iter_opts, int64_t* budget_bytes) {
+    RETURN_IF_ERROR(load_ordinal_index_once());
+    if (_ordinal_index.reader == nullptr) {
+        return Status::OK();
+    }
+    auto read = [&](const PagePointer& pp) {
+        PageHandle handle;
+        Slice page_body;
+        PageFooterPB footer;
+        *budget_bytes -= pp.size;
+        return read_page(iter_opts, pp, &handle, &page_body, &footer);
+    };
+    if (_dict_page_pointer.size > 0 && *budget_bytes > 0) {
+        RETURN_IF_ERROR(read(_dict_page_pointer));
+    }
+    for (auto iter = _ordinal_index.reader->begin(); iter.valid() && *budget_bytes > 0; iter.next()) {
+        RETURN_IF_ERROR(read(iter.page()));
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks
@@ -26,6 +26,7 @@
 #include <cstddef> // for size_t
 #include <cstdint> // for uint32_t
 #include <memory>  // for unique_ptr
+#include <set>
 #include <utility>
 
 #include "column/datum.h"
@@ -52,6 +53,7 @@ class ColumnBlockView;
 class ColumnVectorBatch;
 class MemTracker;
 class WrapperField;
+class ZstdDictBlockCompression;
 
 namespace vectorized {
 class ColumnPredicate;
@@ -64,7 +66,10 @@ class BitmapIndexReader;
 class ColumnIterator;
 class ColumnIteratorOptions;
 class EncodingInfo;
+class InvertedIndexIterator;
+class InvertedIndexReader;
 class PageDecoder;
+class PageReadBuffer;
 class PagePointer;
 class ParsedPage;
 class ZoneMapIndexPB;
@@ -109,13 +114,16 @@ public:
     // TODO: StatusOr<std::unique_ptr<ColumnIterator>> new_bitmap_index_iterator()
     Status new_bitmap_index_iterator(BitmapIndexIterator** iterator);
 
+    // Caller should free returned iterator after unused.
+    Status new_inverted_index_iterator(InvertedIndexIterator** iterator);
+
     // Seek to the first entry in the column.
     Status seek_to_first(OrdinalPageIndexIterator* iter);
     Status seek_at_or_before(ordinal_t ordinal, OrdinalPageIndexIterator* iter);
 
-    // read a page from file into a page handle
+    // read a page from file into a page handle, the page is copied from `read_buffer` if it's there.
     Status read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp, PageHandle* handle,
-                     Slice* page_body, PageFooterPB* footer);
+                     Slice* page_body, PageFooterPB* footer, const PageReadBuffer* read_buffer = nullptr);
 
     bool is_nullable() const { return _flags[kIsNullablePos]; }
 
@@ -126,9 +134,19 @@ public:
     bool has_bloom_filter_index() const {
         return _flags[kHasBloomFilterIndexMetaPos] || _flags[kHasBloomFilterIndexReaderPos];
     }
+    bool has_ngram_bloom_filter_index() const {
+        return _flags[kHasNgramBloomFilterIndexMetaPos] || _flags[kHasNgramBloomFilterIndexReaderPos];
+    }
+    bool has_inverted_index() const {
+        return _flags[kHasInvertedIndexMetaPos] || _flags[kHasInvertedIndexReaderPos];
+    }
 
     ZoneMapPB* segment_zone_map() const { return _segment_zone_map.get(); }
 
+    // whether the column has no null and its values are in ascending order of the row ids,
+    // so the rows of a range of values are a range of rows, found by a binary search of the values.
+    bool is_sorted() const { return _flags[kIsSortedPos]; }
+
     PagePointer get_dict_page_pointer() const { return _dict_page_pointer; }
     FieldType column_type() const { return _column_type; }
     bool has_all_dict_encoded() const { return _flags[kHasAllDictEncodedPos]; }
@@ -139,6 +157,10 @@ public:
 
     int32_t num_data_pages() { return _ordinal_index.reader ? _ordinal_index.reader->num_data_pages() : 0; }
 
+    // The reader of the typed subcolumn which the top-level field `name` of the objects of a JSON column is
+    // extracted into when written, nullptr if the field is not extracted.
+    ColumnReader* flat_json_reader(const std::string& name) const;
+
     ///-----------------------------------
     /// vectorized APIs
     ///-----------------------------------
@@ -158,10 +180,21 @@ public:
     Status bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
                         vectorized::SparseRange* ranges);
 
+    // prerequisite: at least one predicate in |predicates| support ngram bloom filter.
+    Status ngram_bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
+                              vectorized::SparseRange* ranges);
+
     uint32_t version() const { return _opts.storage_format_version; }
 
     Status load_ordinal_index_once();
 
+    // Load the ordinal, zone map and bloom filter indexes of the column, whose pages are cached by the page cache.
+    Status prewarm_indexes();
+
+    // Read the dictionary page and the data pages of the column into the page cache in the order of the rows,
+    // until |*budget_bytes| is used up, it's decreased by the bytes of the pages read.
+    Status prewarm_pages(const ColumnIteratorOptions& iter_opts, int64_t* budget_bytes);
+
 private:
     struct private_type {
         private_type(int) {}
@@ -184,6 +217,11 @@ private:
     constexpr static size_t kIsNullablePos = 8;
     constexpr static size_t kHasAllDictEncodedPos = 9;
     constexpr static size_t kAllDictEncodedPos = 10;
+    constexpr static size_t kHasInvertedIndexMetaPos = 11;
+    constexpr static size_t kHasInvertedIndexReaderPos = 12;
+    constexpr static size_t kHasNgramBloomFilterIndexMetaPos = 13;
+    constexpr static size_t kHasNgramBloomFilterIndexReaderPos = 14;
+    constexpr static size_t kIsSortedPos = 15;
 
     // Disable copy and assignment
     ColumnReader(const ColumnReader&) = delete;
@@ -197,11 +235,18 @@ private:
     Status _load_zone_map_index_once();
     Status _load_bitmap_index_once();
     Status _load_bloom_filter_index_once();
+    Status _load_inverted_index_once();
+    Status _load_ngram_bloom_filter_index_once();
 
     Status _load_zone_map_index(bool use_page_cache, bool kept_in_memory);
     Status _load_ordinal_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bitmap_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_inverted_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+
+    // the ids of the pages covered by |row_ranges|
+    std::set<int32_t> _page_ids(const vectorized::SparseRange& row_ranges) const;
 
     static void _parse_zone_map(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                 WrapperField* max_value_container);
@@ -230,25 +275,33 @@ private:
     // initialized in init(), used for create PageDecoder
     const EncodingInfo* _encoding_info = nullptr;
     const BlockCompressionCodec* _compress_codec = nullptr; // initialized in init()
+    // the codec of the ZSTD dictionary of the pages, `_compress_codec` points to it if not null
+    std::unique_ptr<ZstdDictBlockCompression> _zstd_dict_codec;
 
     ColumnIndex<ZoneMapIndexPB, ZoneMapIndexReader> _zone_map_index;
     ColumnIndex<OrdinalIndexPB, OrdinalIndexReader> _ordinal_index;
     ColumnIndex<BitmapIndexPB, BitmapIndexReader> _bitmap_index;
     ColumnIndex<BloomFilterIndexPB, BloomFilterIndexReader> _bloom_filter_index;
+    ColumnIndex<InvertedIndexPB, InvertedIndexReader> _inverted_index;
+    ColumnIndex<BloomFilterIndexPB, BloomFilterIndexReader> _ngram_bloom_filter_index;
 
     std::unique_ptr<ZoneMapPB> _segment_zone_map;
 
     using SubReaderList = std::vector<std::unique_ptr<ColumnReader>>;
     std::unique_ptr<SubReaderList> _sub_readers;
+    // the top-level fields of a JSON column extracted into the typed subcolumns, read by `_sub_readers`
+    std::unique_ptr<std::vector<std::string>> _flat_json_fields;
 
     // The read operation comprise of compaction, query, checksum and so on.
     // The ordinal index must be loaded before read operation.
-    // zonemap, bitmap, bloomfilter is only necessary for query.
+    // zonemap, bitmap, bloomfilter, inverted index is only necessary for query.
     // the other operations can not load these indices.
     StarRocksCallOnce<Status> _ordinal_index_once;
     StarRocksCallOnce<Status> _zonemap_index_once;
     StarRocksCallOnce<Status> _bitmap_index_once;
     StarRocksCallOnce<Status> _bloomfilter_index_once;
+    StarRocksCallOnce<Status> _inverted_index_once;
+    StarRocksCallOnce<Status> _ngram_bloom_filter_index_once;
 
     std::bitset<16> _flags;
 };
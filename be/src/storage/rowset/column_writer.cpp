@@ -21,12 +21,16 @@
 
 #include "storage/rowset/column_writer.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <memory>
+#include <unordered_map>
 
 #include "column/array_column.h"
 #include "column/column_helper.h"
 #include "column/hash_set.h"
+#include "column/json_column.h"
 #include "column/nullable_column.h"
 #include "common/logging.h"
 #include "env/env.h"
@@ -39,6 +43,7 @@
 #include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/bloom_filter_index_writer.h"
 #include "storage/rowset/encoding_info.h"
+#include "storage/rowset/inverted_index_writer.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/ordinal_page_index.h"
 #include "storage/rowset/page_builder.h"
@@ -46,6 +51,7 @@
 #include "storage/rowset/zone_map_index.h"
 #include "util/block_compression.h"
 #include "util/faststring.h"
+#include "util/json.h"
 #include "util/rle_encoding.h"
 
 namespace starrocks {
@@ -235,6 +241,7 @@ public:
     Status write_zone_map() override { return _scalar_column_writer->write_zone_map(); };
     Status write_bitmap_index() override { return _scalar_column_writer->write_bitmap_index(); };
     Status write_bloom_filter_index() override { return _scalar_column_writer->write_bloom_filter_index(); };
+    Status write_inverted_index() override { return _scalar_column_writer->write_inverted_index(); };
 
     ordinal_t get_next_rowid() const override { return _scalar_column_writer->get_next_rowid(); };
 
@@ -248,6 +255,62 @@ private:
     vectorized::ColumnPtr _buf_column = nullptr;
 };
 
+// JsonColumnWriter writes the JSON column as is, and also extracts the frequent top-level fields of the
+// objects into typed nullable subcolumns, which have their own zone maps and dictionaries and can be read
+// without decoding the JSON. Like StringColumnWriter, the rows are buffered until there are enough of them
+// to detect the fields.
+class JsonColumnWriter final : public ColumnWriter {
+public:
+    JsonColumnWriter(const ColumnWriterOptions& opts, std::unique_ptr<Field> field, fs::WritableBlock* wblock,
+                     std::unique_ptr<ScalarColumnWriter> json_writer);
+
+    ~JsonColumnWriter() override = default;
+
+    Status init() override { return _json_writer->init(); }
+
+    Status append(const vectorized::Column& column) override;
+
+    Status append(const uint8_t* data, const uint8_t* null_flags, size_t count, bool has_null) override {
+        return Status::NotSupported("JsonColumnWriter only supports appending columns");
+    }
+
+    Status finish_current_page() override;
+
+    uint64_t estimate_buffer_size() override;
+
+    Status finish() override;
+
+    Status write_data() override;
+    Status write_ordinal_index() override;
+    Status write_zone_map() override;
+    Status write_bitmap_index() override { return _json_writer->write_bitmap_index(); }
+    Status write_bloom_filter_index() override { return _json_writer->write_bloom_filter_index(); }
+    Status write_inverted_index() override { return _json_writer->write_inverted_index(); }
+
+    ordinal_t get_next_rowid() const override { return _json_writer->get_next_rowid(); }
+
+    uint64_t total_mem_footprint() const override { return _json_writer->total_mem_footprint(); }
+
+private:
+    struct FlatField {
+        std::string name;
+        FieldType type;
+        std::unique_ptr<ColumnWriter> writer;
+    };
+
+    // Detects the flat fields from the buffered rows and writes them.
+    Status _flush_buffer();
+    Status _add_flat_field(const std::string& name, FieldType type);
+    Status _append_flat_fields(const vectorized::Column& column);
+
+    ColumnWriterOptions _opts;
+    fs::WritableBlock* _wblock;
+    std::unique_ptr<ScalarColumnWriter> _json_writer;
+    std::vector<FlatField> _flat_fields;
+    bool _is_detected = false;
+    vectorized::ColumnPtr _buf_column = nullptr;
+};
+
 Status ColumnWriter::create(const ColumnWriterOptions& opts, const TabletColumn* column, fs::WritableBlock* _wblock,
                             std::unique_ptr<ColumnWriter>* writer) {
     std::unique_ptr<Field> field(FieldFactory::create(*column));
@@ -259,6 +322,11 @@ Status ColumnWriter::create(const ColumnWriterOptions& opts, const TabletColumn*
         auto column_writer = std::make_unique<ScalarColumnWriter>(str_opts, std::move(field_clone), _wblock);
         *writer = std::make_unique<StringColumnWriter>(str_opts, std::move(field), std::move(column_writer));
         return Status::OK();
+    } else if (column->type() == FieldType::OLAP_FIELD_TYPE_JSON && opts.need_flat_json) {
+        std::unique_ptr<Field> field_clone(FieldFactory::create(*column));
+        auto json_writer = std::make_unique<ScalarColumnWriter>(opts, std::move(field_clone), _wblock);
+        *writer = std::make_unique<JsonColumnWriter>(opts, std::move(field), _wblock, std::move(json_writer));
+        return Status::OK();
     } else if (is_scalar_field_type(delegate_type(column->type()))) {
         std::unique_ptr<ColumnWriter> writer_local =
                 std::unique_ptr<ColumnWriter>(new ScalarColumnWriter(opts, std::move(field), _wblock));
@@ -356,11 +424,48 @@ ScalarColumnWriter::~ScalarColumnWriter() {
     }
 }
 
+// The encoding of the column with DEFAULT_ENCODING when the adaptive encodings are enabled, or DEFAULT_ENCODING.
+static EncodingTypePB adaptive_encoding(FieldType type) {
+    EncodingTypePB numeric_encoding = DEFAULT_ENCODING;
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_DATE_V2:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_TIMESTAMP:
+        numeric_encoding = DELTA_ENCODING;
+        break;
+    case OLAP_FIELD_TYPE_FLOAT:
+    case OLAP_FIELD_TYPE_DOUBLE:
+        numeric_encoding = GORILLA_ENCODING;
+        break;
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DATE:
+        break;
+    default:
+        return DEFAULT_ENCODING;
+    }
+    if (config::enable_adaptive_page_encoding) {
+        return ADAPTIVE_ENCODING;
+    }
+    return config::enable_adaptive_numeric_encoding ? numeric_encoding : DEFAULT_ENCODING;
+}
+
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
+    FieldType type = get_field()->type();
+    _need_zstd_dict = _opts.meta->compression() == ZSTD && config::zstd_dict_compression_sample_bytes > 0 &&
+                      (type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR || type == OLAP_FIELD_TYPE_JSON);
 
     if (!_opts.need_speculate_encoding) {
-        set_encoding(_opts.meta->encoding());
+        EncodingTypePB encoding = _opts.meta->encoding();
+        if (encoding == DEFAULT_ENCODING) {
+            encoding = adaptive_encoding(get_field()->type());
+        }
+        set_encoding(encoding);
     }
     // create ordinal builder
     _ordinal_index_builder = std::make_unique<OrdinalIndexWriter>();
@@ -386,6 +491,17 @@ Status ScalarColumnWriter::init() {
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(BloomFilterOptions(), get_field()->type_info(),
                                                        &_bloom_filter_index_builder));
     }
+    if (_opts.ngram_bf_gram_num > 0) {
+        _has_index_builder = true;
+        BloomFilterOptions bf_options;
+        bf_options.gram_num = _opts.ngram_bf_gram_num;
+        RETURN_IF_ERROR(BloomFilterIndexWriter::create(bf_options, get_field()->type_info(),
+                                                       &_ngram_bloom_filter_index_builder));
+    }
+    if (_opts.need_inverted_index) {
+        _has_index_builder = true;
+        RETURN_IF_ERROR(InvertedIndexWriter::create(get_field()->type_info(), &_inverted_index_builder));
+    }
     return Status::OK();
 }
 
@@ -409,11 +525,20 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_bloom_filter_index_builder != nullptr) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
+    if (_inverted_index_builder != nullptr) {
+        size += _inverted_index_builder->size();
+    }
     return size;
 }
 
 Status ScalarColumnWriter::finish() {
     RETURN_IF_ERROR(finish_current_page());
+    if (_need_zstd_dict) {
+        RETURN_IF_ERROR(_train_zstd_dict());
+    }
     _opts.meta->set_num_rows(_next_rowid);
     _opts.meta->set_total_mem_footprint(_total_mem_footprint);
     return Status::OK();
@@ -490,6 +615,7 @@ Status ScalarColumnWriter::write_ordinal_index() {
 
 Status ScalarColumnWriter::write_zone_map() {
     if (_zone_map_index_builder != nullptr) {
+        _opts.meta->set_is_sorted(_zone_map_index_builder->is_sorted());
         return _zone_map_index_builder->finish(_wblock, _opts.meta->add_indexes());
     }
     return Status::OK();
@@ -504,12 +630,67 @@ Status ScalarColumnWriter::write_bitmap_index() {
 
 Status ScalarColumnWriter::write_bloom_filter_index() {
     if (_bloom_filter_index_builder != nullptr) {
-        return _bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::write_inverted_index() {
+    if (_inverted_index_builder != nullptr) {
+        return _inverted_index_builder->finish(_wblock, _opts.meta->add_indexes());
     }
     return Status::OK();
 }
 
 // write a data page into file and update ordinal index
+// The dictionary is trained from the samples of at most 1KB cut from the pages, the small samples train a better
+// dictionary than the whole pages. If the dictionary can't be trained, e.g. there are too few data, the pages are
+// compressed by the plain ZSTD codec.
+Status ScalarColumnWriter::_train_zstd_dict() {
+    constexpr size_t kSampleSize = 1024;
+    _need_zstd_dict = false;
+    std::vector<Slice> samples;
+    for (Page* page : _zstd_dict_sample_pages) {
+        for (auto& data : page->data) {
+            Slice s = data.slice();
+            for (size_t offset = 0; offset < s.size; offset += kSampleSize) {
+                samples.emplace_back(s.data + offset, std::min(kSampleSize, s.size - offset));
+            }
+        }
+    }
+    auto dict = train_zstd_dictionary(samples, config::zstd_dict_compression_dict_size);
+    if (dict.ok()) {
+        auto codec = ZstdDictBlockCompression::create(std::move(dict).value());
+        if (codec.ok()) {
+            _zstd_dict_codec = std::move(codec).value();
+            _compress_codec = _zstd_dict_codec.get();
+            _opts.meta->set_zstd_dict(_zstd_dict_codec->dict());
+        }
+    }
+
+    for (Page* page : _zstd_dict_sample_pages) {
+        std::vector<Slice> body;
+        for (auto& data : page->data) {
+            body.push_back(data.slice());
+        }
+        faststring compressed_body;
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body,
+                                                   &compressed_body));
+        if (compressed_body.size() > 0) {
+            _data_size -= Slice::compute_total_size(body);
+            _data_size += compressed_body.size();
+            page->data.clear();
+            page->data.emplace_back(compressed_body.build());
+        }
+    }
+    _zstd_dict_sample_pages.clear();
+    _zstd_dict_sample_bytes = 0;
+    return Status::OK();
+}
+
 Status ScalarColumnWriter::_write_data_page(Page* page) {
     PagePointer pp;
     std::vector<Slice> compressed_body;
@@ -530,6 +711,10 @@ Status ScalarColumnWriter::finish_current_page() {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
 
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
+
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     faststring* encoded_values = _page_builder->finish();
@@ -567,10 +752,12 @@ Status ScalarColumnWriter::finish_current_page() {
         // for page format v2 or above, use the encoding type of config::null_encoding
         data_page_footer->set_null_encoding(_null_map_builder_v2->null_encoding());
     }
-    // trying to compress page body
+    // trying to compress page body, unless it's kept uncompressed to train the ZSTD dictionary
     faststring compressed_body;
-    RETURN_IF_ERROR(
-            PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+    if (!_need_zstd_dict) {
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body,
+                                                   &compressed_body));
+    }
     if (compressed_body.size() == 0) {
         // page body is uncompressed
         page->data.emplace_back(encoded_values->build());
@@ -583,7 +770,14 @@ Status ScalarColumnWriter::finish_current_page() {
         page->data.emplace_back(compressed_body.build());
     }
 
+    if (_need_zstd_dict) {
+        _zstd_dict_sample_pages.push_back(page.get());
+        _zstd_dict_sample_bytes += page->footer.uncompressed_size();
+    }
     _push_back_page(page.release());
+    if (_need_zstd_dict && _zstd_dict_sample_bytes >= config::zstd_dict_compression_sample_bytes) {
+        RETURN_IF_ERROR(_train_zstd_dict());
+    }
 
     if (is_nullable() && _opts.adaptive_page_format) {
         size_t num_data = (_curr_page_format == 1) ? _page_builder->count() : _null_map_builder_v2->data_count();
@@ -729,10 +923,14 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                     INDEX_ADD_NULLS(_zone_map_index_builder, run);
                     INDEX_ADD_NULLS(_bitmap_index_builder, run);
                     INDEX_ADD_NULLS(_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ngram_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_inverted_index_builder, run);
                 } else {
                     INDEX_ADD_VALUES(_zone_map_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bitmap_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_inverted_index_builder, pdata, run);
                 }
                 pdata += get_field()->size() * run;
             }
@@ -740,6 +938,8 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
             INDEX_ADD_VALUES(_zone_map_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bitmap_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_inverted_index_builder, data, num_written);
         }
 
         _next_rowid += num_written;
@@ -973,4 +1173,272 @@ Status StringColumnWriter::finish() {
     return _scalar_column_writer->finish();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+JsonColumnWriter::JsonColumnWriter(const ColumnWriterOptions& opts, std::unique_ptr<Field> field,
+                                   fs::WritableBlock* wblock, std::unique_ptr<ScalarColumnWriter> json_writer)
+        : ColumnWriter(std::move(field), opts.meta->is_nullable()),
+          _opts(opts),
+          _wblock(wblock),
+          _json_writer(std::move(json_writer)) {}
+
+static const vectorized::JsonColumn* get_json_column(const vectorized::Column& column) {
+    if (column.is_nullable()) {
+        const auto& nullable_column = down_cast<const vectorized::NullableColumn&>(column);
+        return down_cast<const vectorized::JsonColumn*>(nullable_column.data_column().get());
+    }
+    return down_cast<const vectorized::JsonColumn*>(&column);
+}
+
+// The type of the subcolumn a JSON value is stored in, OLAP_FIELD_TYPE_UNKNOWN if it can't be flattened.
+static FieldType flat_field_type(vpack::Slice value) {
+    if (value.isInt() || value.isSmallInt()) {
+        return OLAP_FIELD_TYPE_BIGINT;
+    } else if (value.isUInt()) {
+        return value.getUInt() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) ? OLAP_FIELD_TYPE_BIGINT
+                                                                                              : OLAP_FIELD_TYPE_UNKNOWN;
+    } else if (value.isDouble()) {
+        return OLAP_FIELD_TYPE_DOUBLE;
+    } else if (value.isString()) {
+        return OLAP_FIELD_TYPE_VARCHAR;
+    }
+    return OLAP_FIELD_TYPE_UNKNOWN;
+}
+
+static bool get_flat_bigint(vpack::Slice value, int64_t* out) {
+    if (flat_field_type(value) != OLAP_FIELD_TYPE_BIGINT) {
+        return false;
+    }
+    *out = value.getNumber<int64_t>();
+    return true;
+}
+
+static bool get_flat_double(vpack::Slice value, double* out) {
+    if (!value.isNumber()) {
+        return false;
+    }
+    *out = value.getNumber<double>();
+    return true;
+}
+
+static bool get_flat_string(vpack::Slice value, Slice* out) {
+    if (!value.isString()) {
+        return false;
+    }
+    vpack::ValueLength length;
+    const char* data = value.getString(length);
+    *out = Slice(data, length);
+    return true;
+}
+
+// Extracts the field `name` of the objects in `column` into a nullable column, `get` returns false if the
+// value is of another type. The rows which are not objects or don't have the field are null.
+template <typename ColumnType, typename Getter>
+static vectorized::ColumnPtr extract_flat_field(const vectorized::Column& column, const std::string& name, Getter get) {
+    const vectorized::JsonColumn* json_column = get_json_column(column);
+    size_t num_rows = column.size();
+    auto data = ColumnType::create();
+    auto nulls = vectorized::NullColumn::create();
+    data->reserve(num_rows);
+    nulls->reserve(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        typename ColumnType::ValueType value{};
+        bool found = false;
+        if (!column.is_null(i)) {
+            vpack::Slice slice = json_column->get_object(i)->to_vslice();
+            // the attributes of the objects are indexed, get() does a binary search
+            found = slice.isObject() && get(slice.get(name), &value);
+        }
+        data->append(value);
+        nulls->append(!found);
+    }
+    return vectorized::NullableColumn::create(std::move(data), std::move(nulls));
+}
+
+Status JsonColumnWriter::_add_flat_field(const std::string& name, FieldType type) {
+    TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, type, true, _opts.meta->unique_id(),
+                        type == OLAP_FIELD_TYPE_VARCHAR ? OLAP_STRING_MAX_LENGTH : sizeof(int64_t));
+
+    ColumnWriterOptions opts;
+    opts.meta = _opts.meta->add_children_columns();
+    opts.meta->set_column_id(_opts.meta->column_id());
+    opts.meta->set_unique_id(_opts.meta->unique_id());
+    opts.meta->set_type(type);
+    opts.meta->set_length(column.length());
+    opts.meta->set_encoding(DEFAULT_ENCODING);
+    opts.meta->set_compression(_opts.meta->compression());
+    opts.meta->set_is_nullable(true);
+    opts.data_page_size = _opts.data_page_size;
+    opts.page_format = _opts.page_format;
+    opts.adaptive_page_format = _opts.adaptive_page_format;
+    opts.need_zone_map = true;
+
+    std::unique_ptr<ColumnWriter> writer;
+    RETURN_IF_ERROR(ColumnWriter::create(opts, &column, _wblock, &writer));
+    RETURN_IF_ERROR(writer->init());
+    _opts.meta->mutable_json_meta()->add_flat_fields(name);
+    _flat_fields.emplace_back(FlatField{name, type, std::move(writer)});
+    return Status::OK();
+}
+
+Status JsonColumnWriter::_flush_buffer() {
+    DCHECK(!_is_detected);
+    _is_detected = true;
+    if (_buf_column == nullptr) {
+        return Status::OK();
+    }
+    vectorized::ColumnPtr column = std::move(_buf_column);
+    const vectorized::JsonColumn* json_column = get_json_column(*column);
+
+    struct FieldStats {
+        size_t count = 0;
+        FieldType type = OLAP_FIELD_TYPE_UNKNOWN;
+    };
+    // bounds the memory for the objects of random keys
+    constexpr size_t kMaxTrackedFields = 1024;
+    std::unordered_map<std::string, FieldStats> stats;
+    size_t num_objects = 0;
+    for (size_t i = 0; i < column->size(); i++) {
+        if (column->is_null(i)) {
+            continue;
+        }
+        vpack::Slice slice = json_column->get_object(i)->to_vslice();
+        if (!slice.isObject()) {
+            continue;
+        }
+        num_objects++;
+        for (auto it : vpack::ObjectIterator(slice)) {
+            std::string key = it.key.copyString();
+            auto iter = stats.find(key);
+            if (iter == stats.end()) {
+                if (stats.size() >= kMaxTrackedFields) {
+                    continue;
+                }
+                iter = stats.emplace(std::move(key), FieldStats{0, flat_field_type(it.value)}).first;
+            }
+            FieldStats& field_stats = iter->second;
+            FieldType type = flat_field_type(it.value);
+            if (type != field_stats.type) {
+                // the integers are stored as double with the doubles, the other mixed types are not flattened
+                bool is_number = (type == OLAP_FIELD_TYPE_BIGINT || type == OLAP_FIELD_TYPE_DOUBLE) &&
+                                 (field_stats.type == OLAP_FIELD_TYPE_BIGINT ||
+                                  field_stats.type == OLAP_FIELD_TYPE_DOUBLE);
+                field_stats.type = is_number ? OLAP_FIELD_TYPE_DOUBLE : OLAP_FIELD_TYPE_UNKNOWN;
+            }
+            field_stats.count++;
+        }
+    }
+
+    std::vector<std::pair<std::string, FieldStats>> candidates;
+    auto min_count = static_cast<size_t>(static_cast<double>(num_objects) * config::json_flat_min_frequency);
+    for (auto& [name, field_stats] : stats) {
+        if (field_stats.type != OLAP_FIELD_TYPE_UNKNOWN && field_stats.count > 0 && field_stats.count >= min_count) {
+            candidates.emplace_back(name, field_stats);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.count > rhs.second.count || (lhs.second.count == rhs.second.count && lhs.first < rhs.first);
+    });
+    auto max_fields = static_cast<size_t>(std::max(config::json_flat_max_fields, 0));
+    if (candidates.size() > max_fields) {
+        candidates.resize(max_fields);
+    }
+    for (const auto& [name, field_stats] : candidates) {
+        RETURN_IF_ERROR(_add_flat_field(name, field_stats.type));
+    }
+
+    RETURN_IF_ERROR(_append_flat_fields(*column));
+    return _json_writer->append(*column);
+}
+
+Status JsonColumnWriter::_append_flat_fields(const vectorized::Column& column) {
+    for (auto& flat_field : _flat_fields) {
+        vectorized::ColumnPtr values;
+        switch (flat_field.type) {
+        case OLAP_FIELD_TYPE_BIGINT:
+            values = extract_flat_field<vectorized::Int64Column>(column, flat_field.name, get_flat_bigint);
+            break;
+        case OLAP_FIELD_TYPE_DOUBLE:
+            values = extract_flat_field<vectorized::DoubleColumn>(column, flat_field.name, get_flat_double);
+            break;
+        case OLAP_FIELD_TYPE_VARCHAR:
+            values = extract_flat_field<vectorized::BinaryColumn>(column, flat_field.name, get_flat_string);
+            break;
+        default:
+            return Status::InternalError(strings::Substitute("unsupported flat json field type $0", flat_field.type));
+        }
+        RETURN_IF_ERROR(flat_field.writer->append(*values));
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::append(const vectorized::Column& column) {
+    if (_is_detected) {
+        RETURN_IF_ERROR(_append_flat_fields(column));
+        return _json_writer->append(column);
+    }
+    if (_buf_column == nullptr) {
+        _buf_column = column.clone_empty();
+    }
+    _buf_column->append(column, 0, column.size());
+    if (_buf_column->size() < config::json_flat_sample_rows) {
+        return Status::OK();
+    }
+    return _flush_buffer();
+}
+
+Status JsonColumnWriter::finish_current_page() {
+    RETURN_IF_ERROR(_json_writer->finish_current_page());
+    for (auto& flat_field : _flat_fields) {
+        RETURN_IF_ERROR(flat_field.writer->finish_current_page());
+    }
+    return Status::OK();
+}
+
+uint64_t JsonColumnWriter::estimate_buffer_size() {
+    uint64_t size = _json_writer->estimate_buffer_size();
+    for (auto& flat_field : _flat_fields) {
+        size += flat_field.writer->estimate_buffer_size();
+    }
+    if (_buf_column != nullptr) {
+        size += _buf_column->byte_size();
+    }
+    return size;
+}
+
+Status JsonColumnWriter::finish() {
+    if (!_is_detected) {
+        RETURN_IF_ERROR(_flush_buffer());
+    }
+    RETURN_IF_ERROR(_json_writer->finish());
+    for (auto& flat_field : _flat_fields) {
+        RETURN_IF_ERROR(flat_field.writer->finish());
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::write_data() {
+    RETURN_IF_ERROR(_json_writer->write_data());
+    for (auto& flat_field : _flat_fields) {
+        RETURN_IF_ERROR(flat_field.writer->write_data());
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::write_ordinal_index() {
+    RETURN_IF_ERROR(_json_writer->write_ordinal_index());
+    for (auto& flat_field : _flat_fields) {
+        RETURN_IF_ERROR(flat_field.writer->write_ordinal_index());
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::write_zone_map() {
+    RETURN_IF_ERROR(_json_writer->write_zone_map());
+    for (auto& flat_field : _flat_fields) {
+        RETURN_IF_ERROR(flat_field.writer->write_zone_map());
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks
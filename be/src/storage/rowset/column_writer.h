@@ -38,6 +38,7 @@ namespace starrocks {
 
 class TypeInfo;
 class BlockCompressionCodec;
+class ZstdDictBlockCompression;
 
 namespace fs {
 class WritableBlock;
@@ -61,6 +62,10 @@ struct ColumnWriterOptions {
     bool need_zone_map = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    // for char/varchar only, build the inverted index of the terms for the full-text search
+    bool need_inverted_index = false;
+    // for char/varchar only, build the n-gram bloom filter of n-grams of this length if it's not 0
+    uint32_t ngram_bf_gram_num = 0;
     bool adaptive_page_format = false;
     // for char/varchar will speculate encoding in append
     // for others will decide encoding in init method
@@ -69,10 +74,14 @@ struct ColumnWriterOptions {
     // when column data is encoding by dict
     // if global_dict is not nullptr, will checkout whether global_dict can cover all data
     vectorized::GlobalDictMap* global_dict = nullptr;
+
+    // for json column only, extract the frequent top-level fields into typed subcolumns
+    bool need_flat_json = false;
 };
 
 class BitmapIndexWriter;
 class EncodingInfo;
+class InvertedIndexWriter;
 class NullMapRLEBuilder;
 class NullFlagsBuilder;
 class OrdinalIndexWriter;
@@ -114,6 +123,8 @@ public:
 
     virtual Status write_bloom_filter_index() = 0;
 
+    virtual Status write_inverted_index() = 0;
+
     virtual ordinal_t get_next_rowid() const = 0;
 
     // only invalid in the case of global_dict is not nullptr
@@ -169,6 +180,7 @@ public:
     Status write_zone_map() override;
     Status write_bitmap_index() override;
     Status write_bloom_filter_index() override;
+    Status write_inverted_index() override;
     ordinal_t get_next_rowid() const override { return _next_rowid; }
 
     bool is_global_dict_valid() override { return _is_global_dict_valid; }
@@ -211,6 +223,9 @@ private:
 
     Status _write_data_page(Page* page);
 
+    // Train the ZSTD dictionary from the pages kept uncompressed, and compress them with it.
+    Status _train_zstd_dict();
+
     ColumnWriterOptions _opts;
     fs::WritableBlock* _wblock;
     uint32_t _curr_page_format;
@@ -238,7 +253,10 @@ private:
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
+    std::unique_ptr<InvertedIndexWriter> _inverted_index_builder;
     // _zone_map_index_builder != NULL || _bitmap_index_builder != NULL || _bloom_filter_index_builder != NULL
+    // || _ngram_bloom_filter_index_builder != NULL || _inverted_index_builder != NULL
     bool _has_index_builder = false;
     int64_t _element_ordinal = 0;
     int64_t _previous_ordinal = 0;
@@ -246,6 +264,14 @@ private:
     bool _is_global_dict_valid = true;
 
     uint64_t _total_mem_footprint = 0;
+
+    // With ZSTD compression, the pages of a string column are kept uncompressed until there are
+    // config::zstd_dict_compression_sample_bytes of them to train the ZSTD dictionary, then all the pages are
+    // compressed with the dictionary, see _train_zstd_dict().
+    bool _need_zstd_dict = false;
+    std::vector<Page*> _zstd_dict_sample_pages;
+    uint64_t _zstd_dict_sample_bytes = 0;
+    std::unique_ptr<ZstdDictBlockCompression> _zstd_dict_codec;
 };
 
 class ArrayColumnWriter final : public ColumnWriter {
@@ -276,6 +302,8 @@ public:
 
     Status write_bloom_filter_index() override { return Status::OK(); }
 
+    Status write_inverted_index() override { return Status::OK(); }
+
     ordinal_t get_next_rowid() const override { return _array_size_writer->get_next_rowid(); }
 
     uint64_t total_mem_footprint() const override;
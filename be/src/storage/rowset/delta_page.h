@@ -0,0 +1,162 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <type_traits>
+
+#include "storage/rowset/buffered_page.h"
+#include "util/bit_stream_utils.inline.h"
+
+namespace starrocks {
+
+// The number of the deltas packed with the same bit width. It's a multiple of 32, so every block ends on a
+// byte boundary and is unpacked by the batched BitPacking::UnpackValues().
+static constexpr size_t DELTA_PAGE_BLOCK_SIZE = 128;
+
+// Encodes the page of the integers, the dates and the datetimes by the deltas of the adjacent values, or by the
+// deltas of the deltas, whichever is smaller, and PLAIN if neither is smaller than the values. The monotonic
+// columns, e.g. the timestamps of the metrics, are mostly packed to a few bits per value.
+//
+// The body of the page, after the header of BufferedPageBuilder:
+//   DELTA:          first value (8 bytes) | blocks of the deltas
+//   DELTA_OF_DELTA: first value (8 bytes) | first delta (8 bytes) | blocks of the deltas of the deltas
+// where a block is: min (8 bytes) | bit width (1 byte) | bit-packed (delta - min) of up to
+// DELTA_PAGE_BLOCK_SIZE deltas. All the deltas are the 64-bit wrapping differences of the values sign-extended
+// to 64 bits.
+template <FieldType Type>
+class DeltaPageBuilder final : public BufferedPageBuilder<Type> {
+public:
+    using CppType = typename BufferedPageBuilder<Type>::CppType;
+    static_assert(std::is_integral_v<CppType> && sizeof(CppType) <= sizeof(int64_t), "unsupported type");
+
+    explicit DeltaPageBuilder(const PageBuilderOptions& options) : BufferedPageBuilder<Type>(options) {}
+
+    ~DeltaPageBuilder() override = default;
+
+protected:
+    NumericPageMode _encode(const CppType* values, size_t count, faststring* buf) override {
+        size_t header_size = buf->size();
+        _deltas.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            _deltas[i] = static_cast<uint64_t>(static_cast<int64_t>(values[i]));
+        }
+        // |_deltas| becomes the first value followed by the deltas
+        for (size_t i = count - 1; i > 0; i--) {
+            _deltas[i] -= _deltas[i - 1];
+        }
+        put_fixed64_le(buf, _deltas[0]);
+        _encode_blocks(_deltas.data() + 1, count - 1, buf);
+        if (count <= 2) {
+            return NumericPageMode::DELTA;
+        }
+
+        // the first value, the first delta and the deltas of the deltas
+        for (size_t i = count - 1; i > 1; i--) {
+            _deltas[i] -= _deltas[i - 1];
+        }
+        _dod_buf.clear();
+        put_fixed64_le(&_dod_buf, _deltas[0]);
+        put_fixed64_le(&_dod_buf, _deltas[1]);
+        _encode_blocks(_deltas.data() + 2, count - 2, &_dod_buf);
+        if (_dod_buf.size() >= buf->size() - header_size) {
+            return NumericPageMode::DELTA;
+        }
+        buf->resize(header_size);
+        buf->append(_dod_buf.data(), _dod_buf.size());
+        return NumericPageMode::DELTA_OF_DELTA;
+    }
+
+private:
+    void _encode_blocks(const uint64_t* deltas, size_t count, faststring* buf) {
+        for (size_t begin = 0; begin < count; begin += DELTA_PAGE_BLOCK_SIZE) {
+            size_t n = std::min(DELTA_PAGE_BLOCK_SIZE, count - begin);
+            const uint64_t* block = deltas + begin;
+            auto min = static_cast<int64_t>(block[0]);
+            for (size_t i = 1; i < n; i++) {
+                min = std::min(min, static_cast<int64_t>(block[i]));
+            }
+            uint64_t max_offset = 0;
+            for (size_t i = 0; i < n; i++) {
+                max_offset = std::max(max_offset, block[i] - static_cast<uint64_t>(min));
+            }
+            int bit_width = max_offset == 0 ? 0 : 64 - __builtin_clzll(max_offset);
+            put_fixed64_le(buf, static_cast<uint64_t>(min));
+            buf->push_back(static_cast<uint8_t>(bit_width));
+            if (bit_width == 0) {
+                continue;
+            }
+            BitWriter writer(&_block_buf);
+            for (size_t i = 0; i < n; i++) {
+                writer.PutValue(block[i] - static_cast<uint64_t>(min), bit_width);
+            }
+            writer.Flush();
+            buf->append(_block_buf.data(), writer.bytes_written());
+        }
+    }
+
+    std::vector<uint64_t> _deltas;
+    faststring _dod_buf;
+    faststring _block_buf;
+};
+
+template <FieldType Type>
+class DeltaPageDecoder final : public DecodedPageDecoder<Type> {
+public:
+    using CppType = typename DecodedPageDecoder<Type>::CppType;
+
+    DeltaPageDecoder(Slice data, const PageDecoderOptions& options) : DecodedPageDecoder<Type>(data) {}
+
+    ~DeltaPageDecoder() override = default;
+
+    EncodingTypePB encoding_type() const override { return DELTA_ENCODING; }
+
+protected:
+    Status _decode(NumericPageMode mode, const Slice& body, CppType* values, size_t count) override {
+        if (mode != NumericPageMode::DELTA && mode != NumericPageMode::DELTA_OF_DELTA) {
+            return Status::Corruption(strings::Substitute("invalid delta page mode: $0", static_cast<int>(mode)));
+        }
+        // the deltas of the deltas are in |deltas| from the 2nd one
+        const size_t num_heads = mode == NumericPageMode::DELTA ? 1 : 2;
+        const auto* p = reinterpret_cast<const uint8_t*>(body.data);
+        const uint8_t* end = p + body.size;
+        if (count < num_heads || body.size < num_heads * sizeof(uint64_t)) {
+            return Status::Corruption("delta page is truncated");
+        }
+        std::vector<uint64_t> deltas(count);
+        for (size_t i = 0; i < num_heads; i++, p += sizeof(uint64_t)) {
+            deltas[i] = decode_fixed64_le(p);
+        }
+        for (size_t begin = num_heads; begin < count; begin += DELTA_PAGE_BLOCK_SIZE) {
+            size_t n = std::min(DELTA_PAGE_BLOCK_SIZE, count - begin);
+            if (end - p < 9) {
+                return Status::Corruption("delta page is truncated");
+            }
+            uint64_t min = decode_fixed64_le(p);
+            int bit_width = p[8];
+            p += 9;
+            size_t packed_bytes = (n * bit_width + 7) / 8;
+            if (bit_width > 64 || static_cast<size_t>(end - p) < packed_bytes) {
+                return Status::Corruption("delta page is truncated");
+            }
+            uint64_t* block = deltas.data() + begin;
+            BitPacking::UnpackValues(bit_width, p, packed_bytes, n, block);
+            p += packed_bytes;
+            for (size_t i = 0; i < n; i++) {
+                block[i] += min;
+            }
+        }
+        if (mode == NumericPageMode::DELTA_OF_DELTA) {
+            for (size_t i = 2; i < count; i++) {
+                deltas[i] += deltas[i - 1];
+            }
+        }
+        uint64_t value = 0;
+        for (size_t i = 0; i < count; i++) {
+            value += deltas[i];
+            values[i] = static_cast<CppType>(value);
+        }
+        return Status::OK();
+    }
+};
+
+} // namespace starrocks
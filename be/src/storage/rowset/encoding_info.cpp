@@ -25,11 +25,14 @@
 
 #include "gutil/strings/substitute.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/adaptive_page.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/binary_plain_page.h"
 #include "storage/rowset/binary_prefix_page.h"
 #include "storage/rowset/bitshuffle_page.h"
+#include "storage/rowset/delta_page.h"
 #include "storage/rowset/frame_of_reference_page.h"
+#include "storage/rowset/gorilla_page.h"
 #include "storage/rowset/plain_page.h"
 #include "storage/rowset/rle_page.h"
 
@@ -130,6 +133,43 @@ struct TypeEncodingTraits<type, FOR_ENCODING, CppType,
     }
 };
 
+template <FieldType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_ENCODING, CppType,
+                          std::enable_if_t<std::is_integral_v<CppType> && sizeof(CppType) <= sizeof(int64_t)>> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new DeltaPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <FieldType type, typename CppType>
+struct TypeEncodingTraits<type, GORILLA_ENCODING, CppType, std::enable_if_t<std::is_floating_point_v<CppType>>> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new GorillaPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new GorillaPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <FieldType type, typename CppType>
+struct TypeEncodingTraits<type, ADAPTIVE_ENCODING, CppType> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AdaptivePageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new AdaptivePageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
 template <FieldType type>
 struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
@@ -197,28 +237,41 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_TINYINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_TINYINT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_TINYINT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_TINYINT, DELTA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_TINYINT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_SMALLINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_SMALLINT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_SMALLINT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_SMALLINT, DELTA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_SMALLINT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_INT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_INT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_INT, DELTA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_INT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_BIGINT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_BIGINT, DELTA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_BIGINT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_LARGEINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_LARGEINT, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_LARGEINT, FOR_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_LARGEINT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_FLOAT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_FLOAT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_FLOAT, GORILLA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_FLOAT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_DOUBLE, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DOUBLE, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DOUBLE, GORILLA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DOUBLE, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_CHAR, DICT_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_CHAR, PLAIN_ENCODING>();
@@ -232,22 +285,30 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_BOOL, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_BOOL, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_BOOL, PLAIN_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_BOOL, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_DATE, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DATE, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DATE, FOR_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_DATE, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_DATE_V2, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DATE_V2, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DATE_V2, FOR_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_DATE_V2, DELTA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DATE_V2, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_DATETIME, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DATETIME, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DATETIME, FOR_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_DATETIME, DELTA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DATETIME, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_TIMESTAMP, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_TIMESTAMP, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_TIMESTAMP, FOR_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_TIMESTAMP, DELTA_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_TIMESTAMP, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_DECIMAL, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DECIMAL, PLAIN_ENCODING>();
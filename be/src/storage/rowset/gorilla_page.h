@@ -0,0 +1,172 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <type_traits>
+
+#include "storage/rowset/buffered_page.h"
+#include "util/bit_stream_utils.inline.h"
+
+namespace starrocks {
+
+// Encodes the page of the floats and the doubles by the XOR of the bits of the adjacent values, as the
+// Gorilla of Facebook: the slowly changing values share the sign, the exponent and the high bits of the
+// mantissa, so the XOR is mostly 0 or has few meaningful bits in the middle.
+//
+// The body of the page, after the header of BufferedPageBuilder, is a bit stream of the bits of the first value
+// followed by, for each of the other values:
+//   '0':  the value is the same as the previous one
+//   '10': the meaningful bits of the XOR are in the window of the previous XOR, and follow in the bits of the
+//         window
+//   '11': the leading zeros of the XOR (LEADING_BITS bits), the number of the meaningful bits minus 1
+//         (LENGTH_BITS bits) and the meaningful bits follow, they are the window from now on
+// The bits are written from the lowest bit of each byte, as BitWriter.
+template <FieldType Type>
+class GorillaPageBuilder final : public BufferedPageBuilder<Type> {
+public:
+    using CppType = typename BufferedPageBuilder<Type>::CppType;
+    using BitsType = std::conditional_t<sizeof(CppType) == sizeof(uint32_t), uint32_t, uint64_t>;
+    static_assert(std::is_floating_point_v<CppType>, "unsupported type");
+
+    static constexpr int VALUE_BITS = sizeof(BitsType) * 8;
+    static constexpr int LEADING_BITS = VALUE_BITS == 32 ? 5 : 6;
+    static constexpr int LENGTH_BITS = VALUE_BITS == 32 ? 5 : 6;
+
+    explicit GorillaPageBuilder(const PageBuilderOptions& options) : BufferedPageBuilder<Type>(options) {}
+
+    ~GorillaPageBuilder() override = default;
+
+protected:
+    NumericPageMode _encode(const CppType* values, size_t count, faststring* buf) override {
+        BitWriter writer(&_stream);
+        BitsType prev;
+        memcpy(&prev, &values[0], sizeof(BitsType));
+        writer.PutValue(prev, VALUE_BITS);
+        // no window before the first XOR which is not 0
+        int prev_leading = VALUE_BITS;
+        int prev_trailing = 0;
+        for (size_t i = 1; i < count; i++) {
+            BitsType bits;
+            memcpy(&bits, &values[i], sizeof(BitsType));
+            BitsType x = bits ^ prev;
+            prev = bits;
+            if (x == 0) {
+                writer.PutValue(0, 1);
+                continue;
+            }
+            int leading = _leading_zeros(x);
+            int trailing = _trailing_zeros(x);
+            if (leading >= prev_leading && trailing >= prev_trailing) {
+                // 0b01 is '1' then '0' from the lowest bit
+                writer.PutValue(0b01, 2);
+                writer.PutValue(x >> prev_trailing, VALUE_BITS - prev_leading - prev_trailing);
+            } else {
+                int length = VALUE_BITS - leading - trailing;
+                writer.PutValue(0b11, 2);
+                writer.PutValue(leading, LEADING_BITS);
+                writer.PutValue(length - 1, LENGTH_BITS);
+                writer.PutValue(x >> trailing, length);
+                prev_leading = leading;
+                prev_trailing = trailing;
+            }
+        }
+        writer.Flush();
+        buf->append(_stream.data(), writer.bytes_written());
+        return NumericPageMode::GORILLA;
+    }
+
+private:
+    static int _leading_zeros(BitsType x) {
+        return VALUE_BITS == 32 ? __builtin_clz(static_cast<uint32_t>(x)) : __builtin_clzll(x);
+    }
+
+    static int _trailing_zeros(BitsType x) {
+        return VALUE_BITS == 32 ? __builtin_ctz(static_cast<uint32_t>(x)) : __builtin_ctzll(x);
+    }
+
+    faststring _stream;
+};
+
+template <FieldType Type>
+class GorillaPageDecoder final : public DecodedPageDecoder<Type> {
+public:
+    using CppType = typename DecodedPageDecoder<Type>::CppType;
+    using BitsType = typename GorillaPageBuilder<Type>::BitsType;
+
+    static constexpr int VALUE_BITS = GorillaPageBuilder<Type>::VALUE_BITS;
+    static constexpr int LEADING_BITS = GorillaPageBuilder<Type>::LEADING_BITS;
+    static constexpr int LENGTH_BITS = GorillaPageBuilder<Type>::LENGTH_BITS;
+
+    GorillaPageDecoder(Slice data, const PageDecoderOptions& options) : DecodedPageDecoder<Type>(data) {}
+
+    ~GorillaPageDecoder() override = default;
+
+    EncodingTypePB encoding_type() const override { return GORILLA_ENCODING; }
+
+protected:
+    Status _decode(NumericPageMode mode, const Slice& body, CppType* values, size_t count) override {
+        if (mode != NumericPageMode::GORILLA) {
+            return Status::Corruption(strings::Substitute("invalid gorilla page mode: $0", static_cast<int>(mode)));
+        }
+        BitStream stream(body);
+        BitsType prev = stream.read(VALUE_BITS);
+        memcpy(&values[0], &prev, sizeof(BitsType));
+        int leading = VALUE_BITS;
+        int trailing = 0;
+        for (size_t i = 1; i < count; i++) {
+            if (stream.read(1) != 0) {
+                if (stream.read(1) != 0) {
+                    leading = stream.read(LEADING_BITS);
+                    trailing = VALUE_BITS - leading - (static_cast<int>(stream.read(LENGTH_BITS)) + 1);
+                    if (trailing < 0) {
+                        return Status::Corruption("invalid gorilla page window");
+                    }
+                } else if (leading == VALUE_BITS) {
+                    return Status::Corruption("invalid gorilla page window");
+                }
+                prev ^= static_cast<BitsType>(stream.read(VALUE_BITS - leading - trailing)) << trailing;
+            }
+            memcpy(&values[i], &prev, sizeof(BitsType));
+        }
+        if (stream.overflow()) {
+            return Status::Corruption("gorilla page is truncated");
+        }
+        return Status::OK();
+    }
+
+private:
+    // Reads the bits written by BitWriter, the bits after the end of the data are read as 0.
+    class BitStream {
+    public:
+        explicit BitStream(const Slice& data)
+                : _data(reinterpret_cast<const uint8_t*>(data.data)), _num_bits(data.size * 8) {}
+
+        // 1 <= num_bits <= 64
+        uint64_t read(int num_bits) {
+            uint64_t v = 0;
+            int got = 0;
+            while (got < num_bits) {
+                if (_pos >= _num_bits) {
+                    _pos += num_bits - got;
+                    break;
+                }
+                size_t offset = _pos % 8;
+                int n = std::min<int>(num_bits - got, 8 - offset);
+                uint64_t byte = (_data[_pos / 8] >> offset) & ((1u << n) - 1);
+                v |= byte << got;
+                got += n;
+                _pos += n;
+            }
+            return v;
+        }
+
+        bool overflow() const { return _pos > _num_bits; }
+
+    private:
+        const uint8_t* _data;
+        const size_t _num_bits;
+        size_t _pos = 0;
+    };
+};
+
+} // namespace starrocks
@@ -0,0 +1,211 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/inverted_index_reader.h"
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "gutil/strings/substitute.h"
+#include "storage/column_block.h"
+#include "storage/rowset/inverted_index_tokenizer.h"
+#include "storage/rowset/like_pattern.h"
+#include "storage/types.h"
+
+namespace starrocks {
+
+Status InvertedIndexReader::load(fs::BlockManager* block_mgr, const std::string& file_name,
+                                 const InvertedIndexPB* inverted_index_meta, bool use_page_cache,
+                                 bool kept_in_memory) {
+    if (inverted_index_meta->tokenizer() != SIMPLE_TOKENIZER) {
+        return Status::NotSupported(strings::Substitute("unknown tokenizer $0 of the inverted index of $1",
+                                                        inverted_index_meta->tokenizer(), file_name));
+    }
+    _typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    const IndexedColumnMetaPB& dict_meta = inverted_index_meta->dict_column();
+    const IndexedColumnMetaPB& bitmap_meta = inverted_index_meta->bitmap_column();
+
+    _dict_column_reader = std::make_unique<IndexedColumnReader>(block_mgr, file_name, dict_meta);
+    _bitmap_column_reader = std::make_unique<IndexedColumnReader>(block_mgr, file_name, bitmap_meta);
+    RETURN_IF_ERROR(_dict_column_reader->load(use_page_cache, kept_in_memory));
+    RETURN_IF_ERROR(_bitmap_column_reader->load(use_page_cache, kept_in_memory));
+    return Status::OK();
+}
+
+Status InvertedIndexReader::new_iterator(InvertedIndexIterator** iterator) {
+    std::unique_ptr<IndexedColumnIterator> dict_iter;
+    std::unique_ptr<IndexedColumnIterator> bitmap_iter;
+    RETURN_IF_ERROR(_dict_column_reader->new_iterator(&dict_iter));
+    RETURN_IF_ERROR(_bitmap_column_reader->new_iterator(&bitmap_iter));
+    *iterator = new InvertedIndexIterator(this, std::move(dict_iter), std::move(bitmap_iter));
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::read_term(const Slice& term, Roaring* result) {
+    *result = Roaring();
+    if (num_terms() == 0) {
+        return Status::OK();
+    }
+    bool exact_match = false;
+    Status st = _dict_column_iter->seek_at_or_after(&term, &exact_match);
+    if (st.is_not_found()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(st);
+    if (exact_match) {
+        RETURN_IF_ERROR(_read_union_bitmap(_dict_column_iter->get_current_ordinal(), result));
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::read_prefix(const Slice& prefix, Roaring* result) {
+    return _scan_terms(prefix, [&](const Slice& term) { return term.starts_with(prefix); }, true, result);
+}
+
+Status InvertedIndexIterator::read_matched_terms(const std::function<bool(const Slice&)>& matcher,
+                                                 Roaring* result) {
+    return _scan_terms(Slice(), matcher, false, result);
+}
+
+Status InvertedIndexIterator::_scan_terms(const Slice& from, const std::function<bool(const Slice&)>& matcher,
+                                          bool until_mismatch, Roaring* result) {
+    constexpr size_t kBatchSize = 1024;
+    *result = Roaring();
+    if (num_terms() == 0) {
+        return Status::OK();
+    }
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(ColumnVectorBatch::create(kBatchSize, false, _reader->_typeinfo, nullptr, &cvb));
+    MemPool pool;
+    ColumnBlock block(cvb.get(), &pool);
+
+    // the iterator is seeked again before each batch, from the last term read by the previous batch
+    std::string last_term = from.to_string();
+    bool skip_first = false;
+    std::vector<rowid_t> ordinals;
+    while (true) {
+        bool exact_match = false;
+        Slice seek_term(last_term);
+        Status st = _dict_column_iter->seek_at_or_after(&seek_term, &exact_match);
+        if (st.is_not_found()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        rowid_t ordinal = _dict_column_iter->get_current_ordinal();
+        size_t n = std::min<size_t>(kBatchSize, num_terms() - ordinal);
+        ColumnBlockView column_block_view(&block);
+        RETURN_IF_ERROR(_dict_column_iter->next_batch(&n, &column_block_view));
+
+        const auto* terms = reinterpret_cast<const Slice*>(block.data());
+        bool stop = n == 0 || ordinal + n >= num_terms();
+        for (size_t i = skip_first ? 1 : 0; i < n; i++) {
+            if (matcher(terms[i])) {
+                ordinals.push_back(ordinal + i);
+            } else if (until_mismatch) {
+                stop = true;
+                break;
+            }
+        }
+        if (n > 0) {
+            last_term = terms[n - 1].to_string();
+        }
+        pool.clear();
+        if (stop || n <= 1) {
+            break;
+        }
+        skip_first = true;
+    }
+    for (rowid_t ordinal : ordinals) {
+        RETURN_IF_ERROR(_read_union_bitmap(ordinal, result));
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::_read_union_bitmap(rowid_t ordinal, Roaring* result) {
+    DCHECK(ordinal < num_terms());
+
+    size_t num_to_read = 1;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(ColumnVectorBatch::create(num_to_read, false, _reader->_typeinfo, nullptr, &cvb));
+    ColumnBlock block(cvb.get(), _pool.get());
+    ColumnBlockView column_block_view(&block);
+
+    RETURN_IF_ERROR(_bitmap_column_iter->seek_to_ordinal(ordinal));
+    size_t num_read = num_to_read;
+    RETURN_IF_ERROR(_bitmap_column_iter->next_batch(&num_read, &column_block_view));
+    DCHECK(num_to_read == num_read);
+
+    *result |= Roaring::read(reinterpret_cast<const Slice*>(block.data())->data, false);
+    _pool->clear();
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::match(const Slice& text, Roaring* result) {
+    bool has_term = false;
+    Status st;
+    InvertedIndexTokenizer::tokenize(text, [&](const Slice& term, size_t, size_t) {
+        if (!st.ok() || (has_term && result->isEmpty())) {
+            return;
+        }
+        Roaring rows;
+        st = read_term(term, &rows);
+        if (has_term) {
+            *result &= rows;
+        } else {
+            *result = std::move(rows);
+            has_term = true;
+        }
+    });
+    RETURN_IF_ERROR(st);
+    if (!has_term) {
+        return Status::InvalidArgument(strings::Substitute("no term in '$0'", text.to_string()));
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::match_like(const Slice& pattern, Roaring* result) {
+    constexpr size_t kMaxTermLength = InvertedIndexTokenizer::kMaxTermLength;
+    bool has_term = false;
+    for (const LikeLiteral& literal : parse_like_literals(pattern)) {
+        Status st;
+        InvertedIndexTokenizer::tokenize(literal.text, [&](const Slice& term, size_t begin, size_t end) {
+            if (!st.ok() || (has_term && result->isEmpty())) {
+                return;
+            }
+            // the term of the rows is longer than the term of the pattern on an open side
+            bool left_bounded = begin > 0 || !literal.left_open;
+            bool right_bounded = end < literal.text.size() || !literal.right_open;
+            Roaring rows;
+            if (left_bounded && right_bounded) {
+                st = read_term(term, &rows);
+            } else if (left_bounded) {
+                st = read_prefix(term, &rows);
+            } else if (end - begin < kMaxTermLength) {
+                std::string_view sub(term.data, term.size);
+                st = read_matched_terms(
+                        [&](const Slice& t) {
+                            // the truncated terms of the rows may contain it after the truncation
+                            return t.size >= kMaxTermLength || std::string_view(t.data, t.size).find(sub) !=
+                                                                        std::string_view::npos;
+                        },
+                        &rows);
+            } else {
+                return;
+            }
+            if (has_term) {
+                *result &= rows;
+            } else {
+                *result = std::move(rows);
+                has_term = true;
+            }
+        });
+        RETURN_IF_ERROR(st);
+    }
+    if (!has_term) {
+        return Status::Cancelled("no term in the pattern");
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,104 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <roaring/roaring.hh>
+#include <string>
+
+#include "common/status.h"
+#include "gen_cpp/segment.pb.h"
+#include "runtime/mem_pool.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/indexed_column_reader.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+namespace fs {
+class BlockManager;
+}
+
+class InvertedIndexIterator;
+
+// The reader of the inverted index written by InvertedIndexWriter.
+class InvertedIndexReader {
+public:
+    InvertedIndexReader() = default;
+
+    Status load(fs::BlockManager* block_mgr, const std::string& file_name, const InvertedIndexPB* inverted_index_meta,
+                bool use_page_cache, bool kept_in_memory);
+
+    // create a new iterator. Client should delete returned iterator
+    Status new_iterator(InvertedIndexIterator** iterator);
+
+    int64_t num_terms() const { return _bitmap_column_reader->num_values(); }
+
+    size_t mem_usage() const {
+        size_t size = sizeof(InvertedIndexReader);
+        if (_dict_column_reader != nullptr) {
+            size += _dict_column_reader->mem_usage();
+        }
+        if (_bitmap_column_reader != nullptr) {
+            size += _bitmap_column_reader->mem_usage();
+        }
+        return size;
+    }
+
+private:
+    friend class InvertedIndexIterator;
+
+    TypeInfoPtr _typeinfo;
+    std::unique_ptr<IndexedColumnReader> _dict_column_reader;
+    std::unique_ptr<IndexedColumnReader> _bitmap_column_reader;
+};
+
+class InvertedIndexIterator {
+public:
+    InvertedIndexIterator(InvertedIndexReader* reader, std::unique_ptr<IndexedColumnIterator> dict_iter,
+                          std::unique_ptr<IndexedColumnIterator> bitmap_iter)
+            : _reader(reader),
+              _dict_column_iter(std::move(dict_iter)),
+              _bitmap_column_iter(std::move(bitmap_iter)),
+              _pool(new MemPool()) {}
+
+    int64_t num_terms() const { return _reader->num_terms(); }
+
+    // Read the rows containing the term |term| into `result`, which is empty if there is no such term.
+    // |term| must be a term of InvertedIndexTokenizer, i.e. lowercased.
+    Status read_term(const Slice& term, Roaring* result);
+
+    // Read the rows containing any term starting with |prefix| into `result`.
+    Status read_prefix(const Slice& prefix, Roaring* result);
+
+    // Read the rows containing any term for which |matcher| returns true into `result`, all the terms are scanned.
+    Status read_matched_terms(const std::function<bool(const Slice&)>& matcher, Roaring* result);
+
+    // Read the rows containing all the terms of |text| into `result`, the MATCH of the full-text search.
+    // Returns InvalidArgument if |text| has no term.
+    Status match(const Slice& text, Roaring* result);
+
+    // Read the rows which may match the LIKE pattern |pattern| into `result`, a superset of the matched rows,
+    // because the pattern is matched case-insensitively by the terms, e.g. the rows of '%Error: disk%' are the
+    // rows containing a term ending with 'error' and a term starting with 'disk'. The rows must be evaluated
+    // with the pattern still.
+    // Returns Cancelled if the pattern has no term to filter the rows, e.g. '%'.
+    Status match_like(const Slice& pattern, Roaring* result);
+
+private:
+    // Scan the terms from the first term >= |from| and collect the rows of the terms matched by |matcher|, the
+    // scan stops at the first mismatched term if |until_mismatch| is true.
+    Status _scan_terms(const Slice& from, const std::function<bool(const Slice&)>& matcher, bool until_mismatch,
+                       Roaring* result);
+
+    // Read the bitmap of the term at the given ordinal of the dictionary and union it into `result`.
+    Status _read_union_bitmap(rowid_t ordinal, Roaring* result);
+
+    InvertedIndexReader* _reader;
+    std::unique_ptr<IndexedColumnIterator> _dict_column_iter;
+    std::unique_ptr<IndexedColumnIterator> _bitmap_column_iter;
+    std::unique_ptr<MemPool> _pool;
+};
+
+} // namespace starrocks
@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <string>
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// The SIMPLE_TOKENIZER of the inverted index: a term is a run of the ASCII letters and digits and the non-ASCII
+// bytes, so that the words of UTF-8 text are kept whole, and the ASCII letters are lowercased. Every other byte,
+// e.g. the spaces and the punctuations of the logs, separates the terms.
+class InvertedIndexTokenizer {
+public:
+    // The terms longer than this are truncated.
+    static constexpr size_t kMaxTermLength = 255;
+
+    static bool is_term_char(uint8_t c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+    }
+
+    // Calls |f(term, begin, end)| for each term of |text| in order, where [begin, end) is the offsets of the term
+    // in |text|. |term| is valid only in the call.
+    template <typename F>
+    static void tokenize(const Slice& text, F&& f) {
+        std::string term;
+        const auto* data = reinterpret_cast<const uint8_t*>(text.data);
+        size_t i = 0;
+        while (i < text.size) {
+            if (!is_term_char(data[i])) {
+                i++;
+                continue;
+            }
+            size_t begin = i;
+            term.clear();
+            for (; i < text.size && is_term_char(data[i]); i++) {
+                if (term.size() < kMaxTermLength) {
+                    uint8_t c = data[i];
+                    term.push_back(static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c));
+                }
+            }
+            f(Slice(term), begin, i);
+        }
+    }
+};
+
+} // namespace starrocks
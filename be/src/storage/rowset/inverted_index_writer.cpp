@@ -0,0 +1,136 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/inverted_index_writer.h"
+
+#include <map>
+#include <roaring/roaring.hh>
+#include <string>
+#include <string_view>
+
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/indexed_column_writer.h"
+#include "storage/rowset/inverted_index_tokenizer.h"
+#include "storage/types.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+#include "util/unaligned_access.h"
+
+namespace starrocks {
+
+namespace {
+
+// E.g, if the column contains 3 rows ['GET /index.html', 'POST /login', 'GET /login'],
+// then the ordered dictionary would be ['get', 'html', 'index', 'login', 'post'],
+// and the posting lists would be
+//   bitmap for 'get'   : [1 0 1]
+//   bitmap for 'html'  : [1 0 0]
+//   bitmap for 'index' : [1 0 0]
+//   bitmap for 'login' : [0 1 1]
+//   bitmap for 'post'  : [0 1 0]
+class InvertedIndexWriterImpl final : public InvertedIndexWriter {
+public:
+    InvertedIndexWriterImpl() = default;
+
+    ~InvertedIndexWriterImpl() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        auto p = reinterpret_cast<const Slice*>(values);
+        for (size_t i = 0; i < count; ++i) {
+            add_value(unaligned_load<Slice>(p));
+            p++;
+        }
+    }
+
+    void add_value(const Slice& value) {
+        InvertedIndexTokenizer::tokenize(value, [this](const Slice& term, size_t, size_t) {
+            auto it = _terms.find(std::string_view(term.data, term.size));
+            if (it == _terms.end()) {
+                it = _terms.emplace(term.to_string(), Roaring()).first;
+                _terms_size += term.size;
+            }
+            it->second.add(_rid);
+            _num_postings++;
+        });
+        _rid++;
+    }
+
+    void add_nulls(uint32_t count) override {
+        // the null rows contain no term
+        _rid += count;
+    }
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) override {
+        index_meta->set_type(INVERTED_INDEX);
+        InvertedIndexPB* meta = index_meta->mutable_inverted_index();
+        meta->set_tokenizer(SIMPLE_TOKENIZER);
+
+        { // write dictionary
+            TypeInfoPtr dict_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+            IndexedColumnWriterOptions options;
+            options.write_ordinal_index = false;
+            options.write_value_index = true;
+            options.encoding = EncodingInfo::get_default_encoding(dict_typeinfo->type(), true);
+            options.compression = CompressionTypePB::LZ4_FRAME;
+
+            IndexedColumnWriter dict_column_writer(options, dict_typeinfo, wblock);
+            RETURN_IF_ERROR(dict_column_writer.init());
+            for (auto const& it : _terms) {
+                Slice term(it.first);
+                RETURN_IF_ERROR(dict_column_writer.add(&term));
+            }
+            RETURN_IF_ERROR(dict_column_writer.finish(meta->mutable_dict_column()));
+        }
+        { // write posting lists
+            TypeInfoPtr bitmap_typeinfo = get_type_info(OLAP_FIELD_TYPE_OBJECT);
+
+            IndexedColumnWriterOptions options;
+            options.write_ordinal_index = true;
+            options.write_value_index = false;
+            options.encoding = EncodingInfo::get_default_encoding(bitmap_typeinfo->type(), false);
+            // we already store compressed bitmap, use NO_COMPRESSION to save some cpu
+            options.compression = NO_COMPRESSION;
+
+            IndexedColumnWriter bitmap_column_writer(options, bitmap_typeinfo, wblock);
+            RETURN_IF_ERROR(bitmap_column_writer.init());
+
+            faststring buf;
+            for (auto& it : _terms) {
+                Roaring& bitmap = it.second;
+                bitmap.runOptimize();
+                buf.resize(bitmap.getSizeInBytes(false)); // so that buf[0..size) can be read and written
+                bitmap.write(reinterpret_cast<char*>(buf.data()), false);
+                Slice buf_slice(buf);
+                RETURN_IF_ERROR(bitmap_column_writer.add(&buf_slice));
+            }
+            RETURN_IF_ERROR(bitmap_column_writer.finish(meta->mutable_bitmap_column()));
+        }
+        return Status::OK();
+    }
+
+    uint64_t size() const override {
+        // an estimation, the bitmaps take at most 4 bytes per posting before they are optimized
+        return _terms_size + _terms.size() * sizeof(Roaring) + _num_postings * sizeof(rowid_t);
+    }
+
+private:
+    rowid_t _rid = 0;
+    // the distinct terms to the row id lists
+    std::map<std::string, Roaring, std::less<>> _terms;
+    uint64_t _terms_size = 0;
+    uint64_t _num_postings = 0;
+};
+
+} // namespace
+
+Status InvertedIndexWriter::create(const TypeInfoPtr& typeinfo, std::unique_ptr<InvertedIndexWriter>* res) {
+    FieldType type = typeinfo->type();
+    if (type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR) {
+        return Status::NotSupported(strings::Substitute("inverted index of type $0 is not supported", type));
+    }
+    *res = std::make_unique<InvertedIndexWriterImpl>();
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "common/status.h"
+#include "gen_cpp/segment.pb.h"
+
+namespace starrocks {
+
+class TypeInfo;
+using TypeInfoPtr = std::shared_ptr<TypeInfo>;
+
+namespace fs {
+class WritableBlock;
+}
+
+// InvertedIndexWriter builds the inverted index of a CHAR or VARCHAR column for the full-text search: the values
+// are split into terms by InvertedIndexTokenizer, and the index is comprised of
+// - an ordered dictionary of all the distinct terms of the column, the smallest term is mapped to 0, ...
+// - a posting list for each term in the dictionary, the bitmap of the rows containing the term.
+// It's the layout of the bitmap index, with the terms instead of the values, see BitmapIndexWriter.
+class InvertedIndexWriter {
+public:
+    // Returns NotSupported if the type isn't CHAR or VARCHAR.
+    static Status create(const TypeInfoPtr& type_info, std::unique_ptr<InvertedIndexWriter>* res);
+
+    InvertedIndexWriter() = default;
+    virtual ~InvertedIndexWriter() = default;
+
+    // |values| is an array of Slice.
+    virtual void add_values(const void* values, size_t count) = 0;
+
+    virtual void add_nulls(uint32_t count) = 0;
+
+    virtual Status finish(fs::WritableBlock* file, ColumnIndexMetaPB* index_meta) = 0;
+
+    virtual uint64_t size() const = 0;
+
+private:
+    InvertedIndexWriter(const InvertedIndexWriter&) = delete;
+    const InvertedIndexWriter& operator=(const InvertedIndexWriter&) = delete;
+};
+
+} // namespace starrocks
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// A piece of the literal text of a LIKE pattern between the wildcards. It's open on a side if a wildcard is
+// there, i.e. the characters there are unknown.
+struct LikeLiteral {
+    std::string text;
+    bool left_open;
+    bool right_open;
+};
+
+// Split the LIKE pattern |pattern| into the literal pieces between the wildcards '%' and '_', the escaped
+// characters are unescaped, e.g. 'a%b\_c_' is ['a', 'b_c'].
+inline std::vector<LikeLiteral> parse_like_literals(const Slice& pattern) {
+    std::vector<LikeLiteral> literals;
+    LikeLiteral current{"", false, false};
+    for (size_t i = 0; i < pattern.size; i++) {
+        char c = pattern.data[i];
+        if (c == '%' || c == '_') {
+            if (!current.text.empty()) {
+                current.right_open = true;
+                literals.push_back(std::move(current));
+            }
+            current = LikeLiteral{"", true, false};
+        } else if (c == '\\' && i + 1 < pattern.size) {
+            current.text.push_back(pattern.data[++i]);
+        } else {
+            current.text.push_back(c);
+        }
+    }
+    if (!current.text.empty()) {
+        literals.push_back(std::move(current));
+    }
+    return literals;
+}
+
+} // namespace starrocks
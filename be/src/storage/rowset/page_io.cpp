@@ -25,6 +25,7 @@
 #include <string>
 
 #include "column/column.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "gutil/strings/substitute.h"
@@ -34,9 +35,12 @@
 #include "util/block_compression.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/defer_op.h"
 #include "util/faststring.h"
 #include "util/runtime_profile.h"
 #include "util/scoped_cleanup.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -111,6 +115,61 @@ Status PageIO::write_page(fs::WritableBlock* wblock, const std::vector<Slice>& b
     return Status::OK();
 }
 
+// The data pages of an index are taken as index pages by the page cache.
+static PageTypePB page_cache_type(const PageReadOptions& opts, const PageFooterPB& footer) {
+    return opts.is_index && footer.type() == DATA_PAGE ? INDEX_PAGE : footer.type();
+}
+
+static void update_page_cache_metrics(PageTypePB type, bool hit) {
+    auto* metrics = StarRocksMetrics::instance();
+    switch (type) {
+    case DATA_PAGE:
+        metrics->page_cache_data_lookup_total.increment(1);
+        metrics->page_cache_data_hit_total.increment(hit);
+        break;
+    case DICTIONARY_PAGE:
+        metrics->page_cache_dict_lookup_total.increment(1);
+        metrics->page_cache_dict_hit_total.increment(hit);
+        break;
+    default:
+        metrics->page_cache_index_lookup_total.increment(1);
+        metrics->page_cache_index_hit_total.increment(hit);
+        break;
+    }
+}
+
+static void update_page_read_metrics(const std::string& path, int64_t read_ns) {
+    auto* histogram = StarRocksMetrics::instance()->disks_page_read_latency_us.find_metric_by_file(path);
+    if (histogram != nullptr) {
+        histogram->observe(read_ns / 1000);
+    }
+}
+
+Status PageReadBuffer::read(fs::ReadableBlock* rblock, uint64_t offset, size_t size, OlapReaderStatistics* stats,
+                            ColumnReadStatistics* column_stats) {
+    reset();
+    _data.resize(size);
+    int64_t read_ns = 0;
+    Status st;
+    {
+        SCOPED_RAW_TIMER(&read_ns);
+        st = rblock->read(offset, Slice(_data.data(), size));
+    }
+    stats->io_ns += read_ns;
+    if (column_stats != nullptr) {
+        column_stats->io_ns += read_ns;
+    }
+    update_page_read_metrics(rblock->path(), read_ns);
+    if (!st.ok()) {
+        _data.clear();
+        return st;
+    }
+    _offset = offset;
+    stats->coalesced_bytes_read += size;
+    stats->coalesced_read_num++;
+    return Status::OK();
+}
+
 Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
                                         PageFooterPB* footer) {
     // the function will be used by query or load, current load is not allowed to fail when memory reach the limit,
@@ -119,14 +178,27 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
 
     opts.sanity_check();
     opts.stats->total_pages_num++;
+    ColumnReadStatistics* column_stats = opts.column_stats;
+    if (column_stats != nullptr) {
+        column_stats->total_pages_num++;
+    }
 
     auto cache = StoragePageCache::instance();
     PageCacheHandle cache_handle;
     StoragePageCache::CacheKey cache_key(opts.rblock->path(), opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle)) {
+    bool cache_hit = false;
+    if (opts.use_page_cache) {
+        int64_t lookup_start_ns = MonotonicNanos();
+        cache_hit = cache->lookup(cache_key, &cache_handle);
+        StarRocksMetrics::instance()->page_cache_lookup_latency_ns.observe(MonotonicNanos() - lookup_start_ns);
+    }
+    if (cache_hit) {
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
         opts.stats->cached_pages_num++;
+        if (column_stats != nullptr) {
+            column_stats->cached_pages_num++;
+        }
         // parse body and footer
         Slice page_slice = handle->data();
         uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
@@ -134,6 +206,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         if (!footer->ParseFromString(footer_buf)) {
             return Status::Corruption("Bad page: invalid footer");
         }
+        update_page_cache_metrics(page_cache_type(opts, *footer), true);
         *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
         return Status::OK();
     }
@@ -148,10 +221,40 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
     std::unique_ptr<char[]> page(new char[page_size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
     Slice page_slice(page.get(), page_size);
-    {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
-        RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
+    PageCacheHandle compressed_handle;
+    // the page of a different size is of a rewritten file of the same name
+    bool compressed_hit = opts.use_page_cache && cache->lookup_compressed(cache_key, &compressed_handle) &&
+                          compressed_handle.data().size == page_size;
+    if (compressed_hit) {
+        memcpy(page_slice.data, compressed_handle.data().data, page_size);
+        opts.stats->compressed_cached_pages_num++;
+        if (column_stats != nullptr) {
+            column_stats->compressed_cached_pages_num++;
+        }
+    } else if (opts.read_buffer != nullptr && opts.read_buffer->contains(opts.page_pointer)) {
+        memcpy(page_slice.data, opts.read_buffer->page(opts.page_pointer).data, page_size);
         opts.stats->compressed_bytes_read += page_size;
+        opts.stats->coalesced_bytes_used += page_size;
+        if (column_stats != nullptr) {
+            column_stats->compressed_bytes_read += page_size;
+            column_stats->compressed_bytes_read_by_encoding[opts.encoding_type] += page_size;
+        }
+    } else {
+        int64_t read_ns = 0;
+        Status st;
+        {
+            SCOPED_RAW_TIMER(&read_ns);
+            st = opts.rblock->read(opts.page_pointer.offset, page_slice);
+        }
+        opts.stats->io_ns += read_ns;
+        update_page_read_metrics(opts.rblock->path(), read_ns);
+        RETURN_IF_ERROR(st);
+        opts.stats->compressed_bytes_read += page_size;
+        if (column_stats != nullptr) {
+            column_stats->io_ns += read_ns;
+            column_stats->compressed_bytes_read += page_size;
+            column_stats->compressed_bytes_read_by_encoding[opts.encoding_type] += page_size;
+        }
     }
 
     if (opts.verify_checksum) {
@@ -176,7 +279,21 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         if (opts.codec == nullptr) {
             return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
         }
-        SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
+        // Only the pages compressed well enough are worth the decompression on every hit of the
+        // compressed tier, the kept in memory pages stay in the decompressed tier anyway.
+        if (opts.use_page_cache && !compressed_hit && !opts.kept_in_memory && cache->has_compressed_tier() &&
+            footer->uncompressed_size() >= body_size * config::storage_page_cache_compressed_min_ratio) {
+            cache->insert_compressed(cache_key, Slice(page.get(), page_size));
+        }
+        int64_t decompress_ns = 0;
+        // declared before the timer, so it runs after the timer stops
+        DeferOp update_decompress_ns([&] {
+            opts.stats->decompress_ns += decompress_ns;
+            if (column_stats != nullptr) {
+                column_stats->decompress_ns += decompress_ns;
+            }
+        });
+        SCOPED_RAW_TIMER(&decompress_ns);
         // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
         std::unique_ptr<char[]> decompressed_page(
                 new char[footer->uncompressed_size() + footer_size + 4 + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
@@ -196,16 +313,24 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         page = std::move(decompressed_page);
         page_slice = Slice(page.get(), footer->uncompressed_size() + footer_size + 4);
         opts.stats->uncompressed_bytes_read += page_slice.size;
+        if (column_stats != nullptr) {
+            column_stats->uncompressed_bytes_read += page_slice.size;
+        }
     } else {
         opts.stats->uncompressed_bytes_read += body_size;
+        if (column_stats != nullptr) {
+            column_stats->uncompressed_bytes_read += body_size;
+        }
     }
 
     RETURN_IF_ERROR(StoragePageDecoder::decode_page(footer, footer_size + 4, opts.encoding_type, &page, &page_slice));
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
     if (opts.use_page_cache) {
+        PageTypePB type = page_cache_type(opts, *footer);
+        update_page_cache_metrics(type, false);
         // insert this page into cache and return the cache handle
-        cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory);
+        cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory, type == DATA_PAGE);
         *handle = PageHandle(std::move(cache_handle));
     } else {
         *handle = PageHandle(page_slice);
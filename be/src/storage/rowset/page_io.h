@@ -28,11 +28,13 @@
 #include "gen_cpp/segment.pb.h"
 #include "storage/rowset/page_handle.h"
 #include "storage/rowset/page_pointer.h"
+#include "util/raw_container.h"
 #include "util/slice.h"
 
 namespace starrocks {
 
 class BlockCompressionCodec;
+struct ColumnReadStatistics;
 struct OlapReaderStatistics;
 
 namespace fs {
@@ -40,6 +42,37 @@ class ReadableBlock;
 class WritableBlock;
 } // namespace fs
 
+// Holds the bytes of a run of adjacent pages read from a block by a single IO request, so that the
+// pages inside are copied from memory instead of being read one by one.
+class PageReadBuffer {
+public:
+    // Reads [offset, offset + size) of `rblock` into the buffer, replacing the previous content.
+    Status read(fs::ReadableBlock* rblock, uint64_t offset, size_t size, OlapReaderStatistics* stats,
+                ColumnReadStatistics* column_stats = nullptr);
+
+    // Whether the whole page is in the buffer.
+    bool contains(const PagePointer& pp) const {
+        return pp.offset >= _offset && pp.offset + pp.size <= _offset + _data.size();
+    }
+
+    // The bytes of the page, which must be contained in the buffer.
+    Slice page(const PagePointer& pp) const {
+        DCHECK(contains(pp));
+        return {_data.data() + (pp.offset - _offset), pp.size};
+    }
+
+    void reset() {
+        _offset = 0;
+        _data.clear();
+    }
+
+    size_t size() const { return _data.size(); }
+
+private:
+    uint64_t _offset = 0;
+    raw::RawVector<char> _data;
+};
+
 struct PageReadOptions {
     // block to read page
     fs::ReadableBlock* rblock = nullptr;
@@ -49,6 +82,8 @@ struct PageReadOptions {
     const BlockCompressionCodec* codec = nullptr;
     // used to collect IO metrics
     OlapReaderStatistics* stats = nullptr;
+    // used to collect the IO metrics of the column, may be null
+    ColumnReadStatistics* column_stats = nullptr;
     // whether to verify page checksum
     bool verify_checksum = true;
     // whether to use page cache in read path
@@ -58,6 +93,10 @@ struct PageReadOptions {
     bool kept_in_memory = false;
     // page encoding type
     EncodingTypePB encoding_type = UNKNOWN_ENCODING;
+    // whether the page belongs to an index, whose data pages are cached and counted as index pages
+    bool is_index = false;
+    // if not null and the page is in it, the page is copied from it instead of read from `rblock`
+    const PageReadBuffer* read_buffer = nullptr;
 
     void sanity_check() const {
         CHECK_NOTNULL(rblock);
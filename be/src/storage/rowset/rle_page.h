@@ -198,14 +198,8 @@ public:
         }
 
         size_t to_fetch = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
-        size_t remaining = to_fetch;
-        uint8_t* data_ptr = dst->data();
-        while (remaining > 0) {
-            bool result = _rle_decoder.Get(reinterpret_cast<CppType*>(data_ptr));
-            DCHECK(result);
-            remaining--;
-            data_ptr += SIZE_OF_TYPE;
-        }
+        size_t decoded = _rle_decoder.GetBatch(reinterpret_cast<CppType*>(dst->data()), to_fetch);
+        DCHECK_EQ(to_fetch, decoded);
 
         _cur_index += to_fetch;
         *n = to_fetch;
@@ -227,6 +221,8 @@ public:
             return Status::OK();
         }
         CppType value{};
+        constexpr size_t kBatchSize = 256;
+        CppType values[kBatchSize];
 
         size_t to_read =
                 std::min(static_cast<size_t>(range.span_size()), static_cast<size_t>(_num_elements - _cur_index));
@@ -234,12 +230,22 @@ public:
         while (to_read > 0) {
             seek_to_position_in_page(iter.begin());
             vectorized::Range r = iter.next(to_read);
-            for (size_t i = 0; i < r.span_size(); ++i) {
-                if (PREDICT_FALSE(!_rle_decoder.Get(&value))) {
-                    return Status::Corruption("RLE decode failed");
+            // Decode run by run, a repeated run is appended at once and the values of a literal run are
+            // unpacked in batches.
+            size_t remaining = r.span_size();
+            while (remaining > 0) {
+                size_t run = std::min(_rle_decoder.repeated_count(), remaining);
+                if (run > 0) {
+                    value = _rle_decoder.get_repeated_value(run);
+                    dst->append_value_multiple_times(&value, run);
+                } else {
+                    run = _rle_decoder.GetBatch(values, std::min(kBatchSize, remaining));
+                    if (PREDICT_FALSE(run == 0)) {
+                        return Status::Corruption("RLE decode failed");
+                    }
+                    dst->append_numbers(values, run * sizeof(CppType));
                 }
-                [[maybe_unused]] int p = dst->append_numbers(&value, sizeof(value));
-                DCHECK_EQ(1, p);
+                remaining -= run;
             }
             _cur_index += r.span_size();
             to_read -= r.span_size();
@@ -21,10 +21,13 @@
 
 #include "storage/rowset/scalar_column_iterator.h"
 
+#include "common/config.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/encoding_info.h"
 #include "storage/vectorized/column_predicate.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks {
 
@@ -34,6 +37,9 @@ ScalarColumnIterator::~ScalarColumnIterator() = default;
 
 Status ScalarColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
+    if (_opts.column_stats == nullptr) {
+        _opts.column_stats = &_column_stats;
+    }
     RETURN_IF_ERROR(_reader->load_ordinal_index_once());
     _opts.stats->total_columns_data_page_count += _reader->num_data_pages();
 
@@ -177,7 +183,10 @@ Status ScalarColumnIterator::next_batch(size_t* n, vectorized::Column* dst) {
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
         // number of rows to be read from this page
         size_t nread = remaining;
-        RETURN_IF_ERROR(_page->read(dst, &nread));
+        {
+            SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+            RETURN_IF_ERROR(_page->read(dst, &nread));
+        }
         _current_ordinal += nread;
         remaining -= nread;
     }
@@ -232,7 +241,10 @@ Status ScalarColumnIterator::next_batch(const vectorized::SparseRange& range, ve
             // current page have been added in read range
             // read current page data first
             contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
-            RETURN_IF_ERROR(_page->read(dst, read_range));
+            {
+                SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+                RETURN_IF_ERROR(_page->read(dst, read_range));
+            }
             read_range.clear();
         }
     }
@@ -240,7 +252,10 @@ Status ScalarColumnIterator::next_batch(const vectorized::SparseRange& range, ve
     if (!read_range.empty()) {
         // read data left if read range is not empty
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
-        RETURN_IF_ERROR(_page->read(dst, read_range));
+        {
+            SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+            RETURN_IF_ERROR(_page->read(dst, read_range));
+        }
         read_range.clear();
     }
     dst->set_delete_state(contain_deleted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
@@ -296,9 +311,11 @@ Status ScalarColumnIterator::_read_data_page(const OrdinalPageIndexIterator& ite
     PageHandle handle;
     Slice page_body;
     PageFooterPB footer;
-    RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer));
+    RETURN_IF_ERROR(_coalesce_read_pages(iter));
+    RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer, &_read_buffer));
     RETURN_IF_ERROR(parse_page(&_page, std::move(handle), page_body, footer.data_page_footer(),
                                _reader->encoding_info(), iter.page(), iter.page_index()));
+    _readahead_pages(iter);
 
     // dictionary page is read when the first data page that uses it is read,
     // this is to optimize the memory usage: when there is no query on one column, we could
@@ -311,6 +328,99 @@ Status ScalarColumnIterator::_read_data_page(const OrdinalPageIndexIterator& ite
     return Status::OK();
 }
 
+// Once the pages read ahead last time run out, asks the file to read the next pages ahead, so that
+// the scan thread doesn't wait for the device when it gets to them. The pages of a column are stored
+// one after another, they are read ahead within a single request.
+void ScalarColumnIterator::_readahead_pages(const OrdinalPageIndexIterator& iter) {
+    const int32_t num_pages = config::storage_page_readahead_num;
+    const int32_t next_page = iter.page_index() + 1;
+    if (num_pages <= 0 || (next_page >= _readahead_begin && next_page < _readahead_end)) {
+        return;
+    }
+    OrdinalPageIndexIterator next = iter;
+    next.next();
+    if (!next.valid()) {
+        return;
+    }
+    const uint64_t begin = next.page().offset;
+    uint64_t end = begin;
+    int32_t n = 0;
+    for (; n < num_pages && next.valid() && next.page().offset == end; n++, next.next()) {
+        end += next.page().size;
+    }
+    _readahead_begin = next_page;
+    _readahead_end = next_page + n;
+    WARN_IF_ERROR(_opts.rblock->readahead(begin, end - begin), "Fail to read ahead the data pages");
+}
+
+// Once the page to read is not in the read buffer, reads it together with the following adjacent pages
+// into the buffer by a single request, the page reads after that are served from memory. The pages
+// the scan doesn't need are read too as long as their total stays under the gap tolerance, and the
+// run stops before any page that is already in the page cache.
+Status ScalarColumnIterator::_coalesce_read_pages(const OrdinalPageIndexIterator& iter) {
+    const int64_t max_bytes = config::storage_page_coalesce_read_bytes;
+    if (max_bytes <= 0 || _read_buffer.contains(iter.page()) || _is_page_cached(iter.page())) {
+        return Status::OK();
+    }
+    const int64_t max_gap_bytes = config::storage_page_coalesce_gap_bytes;
+    const uint64_t begin = iter.page().offset;
+    uint64_t end = begin + iter.page().size;
+    // the end of the last page the scan needs, the pages not needed after it are not read.
+    uint64_t used_end = end;
+    int64_t gap_bytes = 0;
+    int32_t num_pages = 1;
+    OrdinalPageIndexIterator next = iter;
+    for (next.next(); next.valid(); next.next()) {
+        const PagePointer& pp = next.page();
+        if (pp.offset != end || end + pp.size - begin > max_bytes || _is_page_cached(pp)) {
+            break;
+        }
+        end += pp.size;
+        if (_is_page_in_read_range(next)) {
+            used_end = end;
+            num_pages++;
+        } else {
+            gap_bytes += pp.size;
+            if (gap_bytes > max_gap_bytes) {
+                break;
+            }
+        }
+    }
+    if (num_pages == 1) {
+        return Status::OK();
+    }
+    return _read_buffer.read(_opts.rblock, begin, used_end - begin, _opts.stats, _opts.column_stats);
+}
+
+bool ScalarColumnIterator::_is_page_in_read_range(const OrdinalPageIndexIterator& iter) const {
+    const vectorized::SparseRange* range = _opts.read_range;
+    if (range == nullptr) {
+        return true;
+    }
+    const auto first = static_cast<rowid_t>(iter.first_ordinal());
+    const auto last = static_cast<rowid_t>(iter.last_ordinal());
+    // binary search the first range ending after the first row of the page.
+    size_t lo = 0;
+    size_t hi = range->size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if ((*range)[mid].end() <= first) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < range->size() && (*range)[lo].begin() <= last;
+}
+
+bool ScalarColumnIterator::_is_page_cached(const PagePointer& pp) const {
+    if (!_opts.use_page_cache) {
+        return false;
+    }
+    PageCacheHandle handle;
+    return StoragePageCache::instance()->lookup(StoragePageCache::CacheKey(_opts.rblock->path(), pp.offset), &handle);
+}
+
 Status ScalarColumnIterator::get_row_ranges_by_zone_map(
         const std::vector<const vectorized::ColumnPredicate*>& predicates,
         const vectorized::ColumnPredicate* del_predicate, vectorized::SparseRange* row_ranges) {
@@ -326,13 +436,18 @@ Status ScalarColumnIterator::get_row_ranges_by_zone_map(
 
 Status ScalarColumnIterator::get_row_ranges_by_bloom_filter(
         const std::vector<const vectorized::ColumnPredicate*>& predicates, vectorized::SparseRange* row_ranges) {
-    RETURN_IF(!_reader->has_bloom_filter_index(), Status::OK());
     bool support = false;
+    bool support_ngram = false;
     for (const auto* pred : predicates) {
         support = support | pred->support_bloom_filter();
+        support_ngram = support_ngram | pred->support_ngram_bloom_filter();
+    }
+    if (support && _reader->has_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
+    }
+    if (support_ngram && _reader->has_ngram_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->ngram_bloom_filter(predicates, row_ranges));
     }
-    RETURN_IF(!support, Status::OK());
-    RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
     return Status::OK();
 }
 
@@ -401,7 +516,10 @@ Status ScalarColumnIterator::_do_next_dict_codes(size_t* n, vectorized::Column*
         contain_delted_row = contain_delted_row || _contains_deleted_row(_page->page_index());
         // number of rows to be read from this page
         size_t nread = remaining;
-        RETURN_IF_ERROR(_page->read_dict_codes(dst, &nread));
+        {
+            SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+            RETURN_IF_ERROR(_page->read_dict_codes(dst, &nread));
+        }
         _current_ordinal += nread;
         remaining -= nread;
         _opts.stats->bytes_read += static_cast<int64_t>(nread * sizeof(int32_t));
@@ -444,14 +562,20 @@ Status ScalarColumnIterator::_do_next_batch_dict_codes(const vectorized::SparseR
 
         if (iter.begin() >= end_ord) {
             contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
-            RETURN_IF_ERROR(_page->read_dict_codes(dst, read_range));
+            {
+                SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+                RETURN_IF_ERROR(_page->read_dict_codes(dst, read_range));
+            }
             read_range.clear();
         }
     }
 
     if (!read_range.empty()) {
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
-        RETURN_IF_ERROR(_page->read_dict_codes(dst, read_range));
+        {
+            SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+            RETURN_IF_ERROR(_page->read_dict_codes(dst, read_range));
+        }
         read_range.clear();
     }
     dst->set_delete_state(contain_deleted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
@@ -496,6 +620,8 @@ Status ScalarColumnIterator::_fetch_by_rowid(const rowid_t* rowids, size_t size,
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
         auto last_rowid = implicit_cast<rowid_t>(_page->first_ordinal() + _page->num_rows());
         const rowid_t* next_page_rowid = std::lower_bound(rowids, end, last_rowid);
+        // timed per page rather than per run of rowids, which may be a single row
+        SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
         while (rowids != next_page_rowid) {
             DCHECK_EQ(_current_ordinal, _page->first_ordinal() + _page->offset());
             rowid_t curr = *rowids;
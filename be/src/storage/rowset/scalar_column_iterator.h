@@ -25,6 +25,7 @@
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/ordinal_page_index.h"
 #include "storage/rowset/page_handle.h"
+#include "storage/rowset/page_io.h"
 #include "storage/rowset/parsed_page.h"
 #include "storage/vectorized/range.h"
 
@@ -89,6 +90,10 @@ private:
     static void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
+    void _readahead_pages(const OrdinalPageIndexIterator& iter);
+    Status _coalesce_read_pages(const OrdinalPageIndexIterator& iter);
+    bool _is_page_in_read_range(const OrdinalPageIndexIterator& iter) const;
+    bool _is_page_cached(const PagePointer& pp) const;
 
     template <FieldType Type>
     int _do_dict_lookup(const Slice& word);
@@ -136,6 +141,16 @@ private:
     // current value ordinal
     ordinal_t _current_ordinal = 0;
 
+    // the data pages [_readahead_begin, _readahead_end) have been asked to read ahead.
+    int32_t _readahead_begin = 0;
+    int32_t _readahead_end = 0;
+
+    // the bytes of the adjacent data pages read by the last coalesced read.
+    PageReadBuffer _read_buffer;
+
+    // the statistics of the column when the caller doesn't collect them.
+    ColumnReadStatistics _column_stats;
+
     // page indexes those are DEL_PARTIAL_SATISFIED
     std::unordered_set<uint32_t> _delete_partial_satisfied_pages;
 
@@ -29,6 +29,7 @@
 #include <fmt/core.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
+#include <limits>
 #include <memory>
 
 #include "column/schema.h"
@@ -38,11 +39,13 @@
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/default_value_column_iterator.h"
 #include "storage/rowset/page_io.h"
+#include "storage/rowset/segment_footer_cache.h"
 #include "storage/rowset/segment_writer.h" // k_segment_magic_length
 #include "storage/rowset/vectorized/segment_chunk_iterator_adapter.h"
 #include "storage/rowset/vectorized/segment_iterator.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/tablet_schema.h"
+#include "storage/types.h"
 #include "storage/vectorized/type_utils.h"
 #include "util/crc32c.h"
 #include "util/slice.h"
@@ -167,12 +170,39 @@ Segment::Segment(const private_type&, fs::BlockManager* blk_mgr, std::string fna
                  const TabletSchema* tablet_schema)
         : _block_mgr(blk_mgr), _fname(std::move(fname)), _tablet_schema(tablet_schema), _segment_id(segment_id) {}
 
+Status Segment::_read_footer(fs::BlockManager* blk_mgr, const std::string& filename, SegmentFooterPB* footer,
+                             size_t* footer_length_hint, const FooterPointerPB* partial_rowset_footer) {
+    SegmentFooterCache* footer_cache = partial_rowset_footer == nullptr ? SegmentFooterCache::instance() : nullptr;
+    std::string buff;
+    if (footer_cache != nullptr && footer_cache->lookup(filename, &buff)) {
+        if (!footer->ParseFromString(buff)) {
+            return Status::Corruption(
+                    strings::Substitute("Bad segment file $0: failed to parse cached footer", filename));
+        }
+        return Status::OK();
+    }
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    RETURN_IF_ERROR(blk_mgr->open_block(filename, &rblock));
+    RETURN_IF_ERROR(Segment::parse_segment_footer(rblock.get(), footer, footer_length_hint, partial_rowset_footer));
+    if (footer_cache != nullptr) {
+        footer_cache->insert(filename, footer->SerializeAsString());
+    }
+    return Status::OK();
+}
+
+Status Segment::cache_footer(fs::BlockManager* blk_mgr, const std::string& filename) {
+    SegmentFooterCache* footer_cache = SegmentFooterCache::instance();
+    if (footer_cache == nullptr || footer_cache->contains(filename)) {
+        return Status::OK();
+    }
+    SegmentFooterPB footer;
+    return _read_footer(blk_mgr, filename, &footer, nullptr, nullptr);
+}
+
 Status Segment::_open(MemTracker* mem_tracker, size_t* footer_length_hint,
                       const FooterPointerPB* partial_rowset_footer) {
     SegmentFooterPB footer;
-    std::unique_ptr<fs::ReadableBlock> rblock;
-    RETURN_IF_ERROR(_block_mgr->open_block(_fname, &rblock));
-    RETURN_IF_ERROR(Segment::parse_segment_footer(rblock.get(), &footer, footer_length_hint, partial_rowset_footer));
+    RETURN_IF_ERROR(_read_footer(_block_mgr, _fname, &footer, footer_length_hint, partial_rowset_footer));
 
     RETURN_IF_ERROR(_create_column_readers(mem_tracker, &footer));
     _num_rows = footer.num_rows();
@@ -327,6 +357,14 @@ Status Segment::new_column_iterator(uint32_t cid, ColumnIterator** iter) {
     return _column_readers[cid]->new_iterator(iter);
 }
 
+Status Segment::new_flat_json_iterator(uint32_t cid, const std::string& name, ColumnIterator** iter) {
+    ColumnReader* reader = _column_readers[cid] == nullptr ? nullptr : _column_readers[cid]->flat_json_reader(name);
+    if (reader == nullptr) {
+        return Status::NotFound(fmt::format("json field {} of column {} is not flattened", name, cid));
+    }
+    return reader->new_iterator(iter);
+}
+
 Status Segment::new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter) {
     if (_column_readers[cid] != nullptr && _column_readers[cid]->has_bitmap_index()) {
         return _column_readers[cid]->new_bitmap_index_iterator(iter);
@@ -334,4 +372,58 @@ Status Segment::new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** it
     return Status::OK();
 }
 
+Status Segment::new_inverted_index_iterator(uint32_t cid, InvertedIndexIterator** iter) {
+    if (_column_readers[cid] != nullptr && _column_readers[cid]->has_inverted_index()) {
+        return _column_readers[cid]->new_inverted_index_iterator(iter);
+    }
+    return Status::OK();
+}
+
+Status Segment::get_first_short_key_values(MemTracker* mem_tracker, std::vector<std::string>* values) {
+    if (num_short_keys() == 0 || _num_rows == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_load_index(mem_tracker));
+    // The first key column is the whole short key but the marker if it's the only one, otherwise it has a
+    // fixed size, only the last short key column may have a variable size.
+    const TabletColumn& column = _tablet_schema->column(0);
+    size_t value_size = std::numeric_limits<size_t>::max();
+    if (num_short_keys() > 1) {
+        value_size = column.type() == OLAP_FIELD_TYPE_CHAR ? column.index_length() : get_type_info(column)->size();
+    }
+    for (uint32_t i = 0; i < _sk_index_decoder->num_items(); ++i) {
+        Slice key = _sk_index_decoder->key(i);
+        if (key.size < 1 || static_cast<uint8_t>(key.data[0]) != KEY_NORMAL_MARKER) {
+            continue;
+        }
+        values->emplace_back(key.data + 1, std::min(value_size, key.size - 1));
+    }
+    return Status::OK();
+}
+
+Status Segment::prewarm(MemTracker* mem_tracker, int64_t* budget_bytes) {
+    RETURN_IF_ERROR(_load_index(mem_tracker));
+    for (auto& reader : _column_readers) {
+        if (reader != nullptr) {
+            RETURN_IF_ERROR(reader->prewarm_indexes());
+        }
+    }
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    RETURN_IF_ERROR(_block_mgr->open_block(_fname, &rblock));
+    OlapReaderStatistics stats;
+    ColumnIteratorOptions iter_opts;
+    iter_opts.rblock = rblock.get();
+    iter_opts.stats = &stats;
+    iter_opts.use_page_cache = !config::disable_storage_page_cache;
+    for (auto& reader : _column_readers) {
+        if (*budget_bytes <= 0) {
+            break;
+        }
+        if (reader != nullptr) {
+            RETURN_IF_ERROR(reader->prewarm_pages(iter_opts, budget_bytes));
+        }
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks
@@ -57,6 +57,7 @@ class SegmentReadOptions;
 } // namespace vectorized
 
 class BitmapIndexIterator;
+class InvertedIndexIterator;
 class ColumnReader;
 class ColumnIterator;
 class Segment;
@@ -84,6 +85,10 @@ public:
     static Status parse_segment_footer(fs::ReadableBlock* rblock, SegmentFooterPB* footer, size_t* footer_length_hint,
                                        const FooterPointerPB* partial_rowset_footer);
 
+    // Read the footer of the segment file |filename| into SegmentFooterCache if it's enabled and the footer isn't
+    // cached, so that the segment is opened without reading the file.
+    static Status cache_footer(fs::BlockManager* blk_mgr, const std::string& filename);
+
     Segment(const private_type&, fs::BlockManager* blk_mgr, std::string fname, uint32_t segment_id,
             const TabletSchema* tablet_schema);
 
@@ -101,8 +106,25 @@ public:
     // TODO: remove this method, create `ColumnIterator` via `ColumnReader`.
     Status new_column_iterator(uint32_t cid, ColumnIterator** iter);
 
+    // Creates the iterator of the typed subcolumn which the top-level field `name` of the JSON column `cid` is
+    // extracted into, returns NotFound if the field is not extracted in this segment.
+    Status new_flat_json_iterator(uint32_t cid, const std::string& name, ColumnIterator** iter);
+
     Status new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
 
+    // Leaves |*iter| unchanged if the column has no inverted index.
+    Status new_inverted_index_iterator(uint32_t cid, InvertedIndexIterator** iter);
+
+    // Load the short key index and the indexes of all the columns, the short key index is tracked by
+    // |mem_tracker|, then read the pages of the columns into the page cache column by column, until
+    // |*budget_bytes| is used up, it's decreased by the bytes of the pages read.
+    Status prewarm(MemTracker* mem_tracker, int64_t* budget_bytes);
+
+    // Appends the encoded values of the first key column in the short key index to |values|, one for every
+    // num_rows_per_block() rows, the null values are skipped. The encoded values sort like the values, see
+    // KeyCoder. Used to sample the keys splitting the rows of a tablet into key ranges.
+    Status get_first_short_key_values(MemTracker* mem_tracker, std::vector<std::string>* values);
+
     size_t num_short_keys() const { return _tablet_schema->num_short_key_columns(); }
 
     uint32_t num_rows_per_block() const {
@@ -153,6 +175,10 @@ private:
 
     // open segment file and read the minimum amount of necessary information (footer)
     Status _open(MemTracker* mem_tracker, size_t* footer_length_hint, const FooterPointerPB* partial_rowset_footer);
+    // Read the footer from SegmentFooterCache, or from the file and put it into the cache. The footers of the
+    // partial rowsets aren't cached, they are rewritten by the partial updates.
+    static Status _read_footer(fs::BlockManager* blk_mgr, const std::string& filename, SegmentFooterPB* footer,
+                               size_t* footer_length_hint, const FooterPointerPB* partial_rowset_footer);
     Status _create_column_readers(MemTracker* mem_tracker, SegmentFooterPB* footer);
     // Load and decode short key index.
     // May be called multiple times, subsequent calls will no op.
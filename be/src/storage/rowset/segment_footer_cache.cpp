@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/segment_footer_cache.h"
+
+#include "runtime/current_thread.h"
+#include "runtime/mem_tracker.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+SegmentFooterCache* SegmentFooterCache::_s_instance = nullptr;
+
+void SegmentFooterCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr) {
+        _s_instance = new SegmentFooterCache(mem_tracker, capacity);
+    }
+}
+
+void SegmentFooterCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+SegmentFooterCache::SegmentFooterCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _capacity(capacity), _cache(new_lru_cache(capacity)) {}
+
+bool SegmentFooterCache::lookup(const std::string& fname, std::string* footer) {
+    StarRocksMetrics::instance()->segment_footer_cache_lookup_total.increment(1);
+    auto* handle = _cache->lookup(CacheKey(fname));
+    if (handle == nullptr) {
+        return false;
+    }
+    StarRocksMetrics::instance()->segment_footer_cache_hit_total.increment(1);
+    *footer = *reinterpret_cast<std::string*>(_cache->value(handle));
+    _cache->release(handle);
+    return true;
+}
+
+bool SegmentFooterCache::contains(const std::string& fname) {
+    auto* handle = _cache->lookup(CacheKey(fname));
+    if (handle == nullptr) {
+        return false;
+    }
+    _cache->release(handle);
+    return true;
+}
+
+void SegmentFooterCache::insert(const std::string& fname, const std::string& footer) {
+    // the entries are allocated and freed, maybe by the eviction of another insertion, under the tracker of the cache
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+
+    auto* value = new std::string(footer);
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<std::string*>(value); };
+    size_t charge = fname.size() + value->capacity() + sizeof(std::string);
+    _cache->release(_cache->insert(CacheKey(fname), value, charge, deleter));
+}
+
+} // namespace starrocks
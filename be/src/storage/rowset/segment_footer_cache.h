@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class MemTracker;
+
+// SegmentFooterCache keeps the serialized footers of the segment files read last, so that opening a Segment
+// again, e.g. after its rowset is closed, or after the BE restarts if the footer is preloaded, doesn't read and
+// check the footer from the file. The footers are kept serialized, which is several times smaller than the parsed
+// SegmentFooterPB, and the segment files are immutable, so the entries never get stale.
+class SegmentFooterCache {
+public:
+    // Create the global instance, a cache of |capacity| bytes charged to |mem_tracker|.
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Returns nullptr if the cache isn't created, i.e. it's disabled.
+    static SegmentFooterCache* instance() { return _s_instance; }
+
+    SegmentFooterCache(MemTracker* mem_tracker, size_t capacity);
+
+    // Returns true and sets |footer| to the serialized footer of the segment file |fname| if it's cached.
+    bool lookup(const std::string& fname, std::string* footer);
+
+    void insert(const std::string& fname, const std::string& footer);
+
+    bool contains(const std::string& fname);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+    size_t capacity() const { return _capacity; }
+
+private:
+    static SegmentFooterCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    size_t _capacity = 0;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks
@@ -21,14 +21,17 @@
 
 #include "storage/rowset/segment_writer.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "gen_cpp/segment.pb.h"
+#include "runtime/current_thread.h"
 #include "storage/fs/block_manager.h"
 #include "storage/rowset/column_writer.h" // ColumnWriter
 #include "storage/rowset/page_io.h"
@@ -139,6 +142,9 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         }
         opts.need_bloom_filter = column.is_bf_column();
         opts.need_bitmap_index = column.has_bitmap_index();
+        opts.need_inverted_index = column.has_inverted_index();
+        opts.ngram_bf_gram_num = column.ngram_bf_gram_num();
+        opts.need_flat_json = column.type() == FieldType::OLAP_FIELD_TYPE_JSON && config::enable_json_flat;
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             if (opts.need_bloom_filter) {
                 return Status::NotSupported("Do not support bloom filter for array type");
@@ -146,6 +152,12 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
             if (opts.need_bitmap_index) {
                 return Status::NotSupported("Do not support bitmap index for array type");
             }
+            if (opts.need_inverted_index) {
+                return Status::NotSupported("Do not support inverted index for array type");
+            }
+            if (opts.ngram_bf_gram_num > 0) {
+                return Status::NotSupported("Do not support ngram bloom filter for array type");
+            }
         }
 
         if (column.type() == FieldType::OLAP_FIELD_TYPE_CHAR && column.type() != FieldType::OLAP_FIELD_TYPE_VARCHAR,
@@ -167,6 +179,11 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
     if (_has_key) {
         _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
     }
+    _encode_token.reset();
+    if (_opts.encode_thread_pool != nullptr &&
+        _column_writers.size() >= std::max(2, config::segment_parallel_encode_min_columns)) {
+        _encode_token = _opts.encode_thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    }
     return Status::OK();
 }
 
@@ -200,15 +217,18 @@ Status SegmentWriter::finalize_columns(uint64_t* index_size) {
     _num_rows_written = 0;
 
     size_t num_columns = _tablet_schema->num_columns();
-    for (size_t i = 0; i < _column_indexes.size(); ++i) {
-        uint32_t column_index = _column_indexes[i];
+    for (uint32_t column_index : _column_indexes) {
         if (column_index >= num_columns) {
             return Status::InternalError(
                     strings::Substitute("column index $0 out of range $1", column_index, num_columns));
         }
+    }
+    // encode the last pages of the columns
+    RETURN_IF_ERROR(_for_each_column_writer([this](size_t i) { return _column_writers[i]->finish(); }));
 
+    for (size_t i = 0; i < _column_indexes.size(); ++i) {
+        uint32_t column_index = _column_indexes[i];
         auto& column_writer = _column_writers[i];
-        RETURN_IF_ERROR(column_writer->finish());
         // write data
         RETURN_IF_ERROR(column_writer->write_data());
         // write index
@@ -217,6 +237,7 @@ Status SegmentWriter::finalize_columns(uint64_t* index_size) {
         RETURN_IF_ERROR(column_writer->write_zone_map());
         RETURN_IF_ERROR(column_writer->write_bitmap_index());
         RETURN_IF_ERROR(column_writer->write_bloom_filter_index());
+        RETURN_IF_ERROR(column_writer->write_inverted_index());
         *index_size += _wblock->bytes_appended() - index_offset;
 
         // global dict
@@ -231,6 +252,7 @@ Status SegmentWriter::finalize_columns(uint64_t* index_size) {
     }
     _column_writers.clear();
     _column_indexes.clear();
+    _encode_token.reset();
 
     if (_has_key) {
         uint64_t index_offset = _wblock->bytes_appended();
@@ -288,12 +310,39 @@ Status SegmentWriter::_write_raw_data(const std::vector<Slice>& slices) {
     return Status::OK();
 }
 
+Status SegmentWriter::_for_each_column_writer(const std::function<Status(size_t)>& task) {
+    const size_t n = _column_writers.size();
+    if (_encode_token == nullptr || n <= 1) {
+        for (size_t i = 0; i < n; ++i) {
+            RETURN_IF_ERROR(task(i));
+        }
+        return Status::OK();
+    }
+    // the calling thread runs the task of the first column, the tasks of the other columns are submitted,
+    // or run by the calling thread too if the pool refuses them, e.g. its queue is full.
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    std::vector<Status> statuses(n);
+    for (size_t i = 1; i < n; ++i) {
+        Status st = _encode_token->submit_func([&, i]() {
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+            statuses[i] = task(i);
+        });
+        if (!st.ok()) {
+            statuses[i] = task(i);
+        }
+    }
+    statuses[0] = task(0);
+    _encode_token->wait();
+    for (const Status& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
     DCHECK_EQ(_column_writers.size(), chunk.num_columns());
-    for (size_t i = 0; i < _column_writers.size(); ++i) {
-        const vectorized::Column* col = chunk.get_column_by_index(i).get();
-        RETURN_IF_ERROR(_column_writers[i]->append(*col));
-    }
+    RETURN_IF_ERROR(_for_each_column_writer(
+            [&](size_t i) { return _column_writers[i]->append(*chunk.get_column_by_index(i)); }));
 
     size_t chunk_num_rows = chunk.num_rows();
     if (_has_key) {
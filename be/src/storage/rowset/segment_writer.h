@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory> // unique_ptr
 #include <string>
 #include <vector>
@@ -30,6 +31,7 @@
 #include "gen_cpp/segment.pb.h"
 #include "gutil/macros.h"
 #include "runtime/global_dicts.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -57,6 +59,8 @@ struct SegmentWriterOptions {
     uint32_t num_rows_per_block = 1024;
     vectorized::GlobalDictByNameMaps* global_dicts = nullptr;
     std::vector<int32_t> referenced_column_ids;
+    // the pool to encode the columns in parallel, nullptr to encode them on the calling thread.
+    ThreadPool* encode_thread_pool = nullptr;
 };
 
 // SegmentWriter is responsible for writing data into single segment by all or partital columns.
@@ -122,6 +126,8 @@ private:
     Status _write_short_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
+    // Run |task| on each of the column writers, in parallel if |_encode_token| is not null.
+    Status _for_each_column_writer(const std::function<Status(size_t)>& task);
     void _init_column_meta(ColumnMetaPB* meta, uint32_t column_id, const TabletColumn& column);
 
     uint32_t _segment_id;
@@ -135,6 +141,10 @@ private:
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
     std::vector<uint32_t> _column_indexes;
     bool _has_key = true;
+    // The columns are encoded in parallel by the tasks of this token. Each column writer encodes and compresses
+    // its pages into its own buffer, written to the file in order of the columns by finalize_columns(), so the
+    // file layout keeps the same as the one written serially.
+    std::unique_ptr<ThreadPoolToken> _encode_token;
 
     // num rows written when appending [partial] columns
     uint32_t _num_rows_written = 0;
@@ -86,9 +86,35 @@ private:
     std::unique_ptr<BitShuffleDataDecoder> _bit_shuffle_decoder;
 };
 
+// The page of AdaptivePageBuilder, the bitshuffle pages are decompressed after the header of the encoding type.
+class AdaptiveDataDecoder : public DataDecoder {
+public:
+    AdaptiveDataDecoder() {
+        _bit_shuffle_decoder = std::make_unique<BitShuffleDataDecoder>();
+        _bit_shuffle_decoder->reserve_head(ADAPTIVE_PAGE_HEADER_SIZE);
+    }
+    ~AdaptiveDataDecoder() = default;
+
+    Status decode_page_data(PageFooterPB* footer, uint32_t footer_size, EncodingTypePB encoding,
+                            std::unique_ptr<char[]>* page, Slice* page_slice) override {
+        if (page_slice->size < ADAPTIVE_PAGE_HEADER_SIZE) {
+            return Status::Corruption(strings::Substitute("invalid adaptive page size:$0", page_slice->size));
+        }
+        size_t type = decode_fixed32_le((const uint8_t*)&(page_slice->data[0]));
+        if (type == BIT_SHUFFLE) {
+            return _bit_shuffle_decoder->decode_page_data(footer, footer_size, encoding, page, page_slice);
+        }
+        return Status::OK();
+    }
+
+private:
+    std::unique_ptr<BitShuffleDataDecoder> _bit_shuffle_decoder;
+};
+
 static DataDecoder g_base_decoder;
 static BitShuffleDataDecoder g_bit_shuffle_decoder;
 static BinaryDictDataDecoder g_binary_dict_decoder;
+static AdaptiveDataDecoder g_adaptive_decoder;
 
 DataDecoder* DataDecoder::get_data_decoder(EncodingTypePB encoding) {
     switch (encoding) {
@@ -98,7 +124,12 @@ DataDecoder* DataDecoder::get_data_decoder(EncodingTypePB encoding) {
     case DICT_ENCODING: {
         return &g_binary_dict_decoder;
     }
+    case ADAPTIVE_ENCODING: {
+        return &g_adaptive_decoder;
+    }
     case FOR_ENCODING:
+    case DELTA_ENCODING:
+    case GORILLA_ENCODING:
     case PLAIN_ENCODING:
     case PREFIX_ENCODING:
     case RLE: {
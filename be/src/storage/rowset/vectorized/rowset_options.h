@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -23,6 +24,7 @@ class TabletSchema;
 
 namespace starrocks::vectorized {
 
+class ColumnExpr;
 class ColumnPredicate;
 class DeletePredicates;
 class Schema;
@@ -38,8 +40,20 @@ public:
 
     std::vector<SeekRange> ranges;
 
+    // Only the rows in [rowid_range_begin, rowid_range_end) of the rowset are read, the rows of a
+    // rowset are numbered consecutively through its segments. -1 means to the last row.
+    int64_t rowid_range_begin = 0;
+    int64_t rowid_range_end = -1;
+
+    // If set, only the rows whose keys are in this range are read, it's applied to every segment, unlike
+    // |ranges| which are unioned. See TabletReaderParams::split_begin_key.
+    std::optional<SeekRange> key_split_range;
+
     std::unordered_map<ColumnId, PredicateList> predicates;
 
+    // The columns read as the results of the expressions over them, see ColumnExpr.
+    std::vector<const ColumnExpr*> column_exprs;
+
     // whether rowset should return rows in sorted order.
     bool sorted = true;
 
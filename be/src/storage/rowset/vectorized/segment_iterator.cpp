@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <stack>
 #include <unordered_map>
 
@@ -21,6 +22,7 @@
 #include "storage/del_vector.h"
 #include "storage/fs/fs_util.h"
 #include "storage/rowset/bitmap_index_reader.h"
+#include "storage/rowset/inverted_index_reader.h"
 #include "storage/rowset/column_decoder.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/common.h"
@@ -35,6 +37,7 @@
 #include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/column_expr.h"
 #include "storage/vectorized/column_or_predicate.h"
 #include "storage/vectorized/column_predicate.h"
 #include "storage/vectorized/column_predicate_rewriter.h"
@@ -48,23 +51,23 @@ namespace starrocks::vectorized {
 
 constexpr static const FieldType kDictCodeType = OLAP_FIELD_TYPE_INT;
 
-// compare |tuple| with the first row of |chunk|.
+// compare |tuple| with the |row|-th row of |chunk|.
 // NULL will be treated as a minimal value.
-static int compare(const SeekTuple& tuple, const Chunk& chunk) {
+static int compare(const SeekTuple& tuple, const Chunk& chunk, size_t row = 0) {
     DCHECK_LE(tuple.columns(), chunk.num_columns());
     const auto& schema = tuple.schema();
     const size_t n = tuple.columns();
     for (size_t i = 0; i < n; i++) {
         const Datum& v1 = tuple.get(i);
         const ColumnPtr& c = chunk.get_column_by_index(i);
-        DCHECK_GE(c->size(), 1u);
+        DCHECK_GT(c->size(), row);
         if (v1.is_null()) {
-            if (c->is_null(0)) {
+            if (c->is_null(row)) {
                 continue;
             }
             return -1;
         }
-        if (int r = schema.field(i)->type()->cmp(v1, c->get(0)); r != 0) {
+        if (int r = schema.field(i)->type()->cmp(v1, c->get(row)); r != 0) {
             return r;
         }
     }
@@ -152,6 +155,10 @@ private:
         std::vector<size_t> _skip_dict_decode_indexes;
         std::vector<size_t> _read_index_map;
 
+        // the columns with expressions not mapped through their dictionaries, they are evaluated
+        // on the values after the rows are filtered.
+        std::vector<ColumnId> _expr_columns;
+
         std::shared_ptr<Chunk> _read_chunk;
         std::shared_ptr<Chunk> _dict_chunk;
         std::shared_ptr<Chunk> _final_chunk;
@@ -175,17 +182,27 @@ private:
     template <bool check_global_dict>
     Status _init_column_iterators(const Schema& schema);
     Status _get_row_ranges_by_keys();
+    void _get_row_ranges_by_rowid_range();
+    Status _get_row_ranges_by_key_split_range();
+    Status _get_row_ranges_by_sorted_columns();
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
+    Status _prune_scan_range_by_arrived_predicates();
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
 
+    Status _lookup_ordinals(const std::vector<const SeekTuple*>& keys, const std::vector<bool>& lowers,
+                            std::vector<rowid_t>* rowids);
     Status _lookup_ordinal(const SeekTuple& key, bool lower, rowid_t end, rowid_t* rowid);
+    void _lookup_short_key(const SeekTuple& key, bool lower, rowid_t* start, rowid_t* end) const;
+    Status _lookup_sorted_ordinal(ColumnId cid, const TypeInfo& type, const Datum& value, bool lower, rowid_t start,
+                                  rowid_t end, Column* column, rowid_t* rowid);
     Status _seek_columns(const Schema& schema, rowid_t pos);
     Status _read_columns(const Schema& schema, Chunk* chunk, size_t nrows);
 
     uint16_t _filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to);
+    void _reorder_branchless_predicates();
     uint16_t _filter_by_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid);
 
     void _init_column_predicates();
@@ -201,6 +218,14 @@ private:
 
     Status _decode_dict_codes(ScanContext* ctx);
 
+    // Evaluates the column expressions once per dictionary word of the dict-encoded columns.
+    Status _init_column_exprs();
+
+    // Appends the results of the column expression of |cid| for the dictionary |codes| to |values|.
+    void _decode_dict_codes_by_expr(ColumnId cid, const Column& codes, Column* values) const;
+
+    Status _evaluate_column_exprs(ScanContext* ctx, Chunk* chunk);
+
     Status _check_low_cardinality_optimization();
 
     Status _finish_late_materialization(ScanContext* ctx);
@@ -222,6 +247,10 @@ private:
 
     Status _apply_bitmap_index();
 
+    Status _init_inverted_index_iterators();
+
+    Status _apply_inverted_index();
+
     Status _apply_del_vector();
 
     Status _read(Chunk* chunk, vector<rowid_t>* rowid, size_t n);
@@ -236,6 +265,7 @@ private:
     RawColumnIterators _column_iterators;
     ColumnDecoders _column_decoders;
     std::vector<BitmapIndexIterator*> _bitmap_index_iterators;
+    std::vector<InvertedIndexIterator*> _inverted_index_iterators;
 
     DelVectorPtr _del_vec;
     roaring_uint32_iterator_t _roaring_iter;
@@ -248,7 +278,18 @@ private:
 
     std::vector<const ColumnPredicate*> _vectorized_preds;
     std::vector<const ColumnPredicate*> _branchless_preds;
+    // The branchless predicates are evaluated on the rows selected by the previous ones, so they are
+    // reordered by the pass ratio observed so far, the most selective first.
+    struct PredicateSelectivity {
+        int64_t input_rows = 0;
+        int64_t output_rows = 0;
+    };
+    std::vector<PredicateSelectivity> _branchless_pred_selectivity;
+    int64_t _num_filter_calls = 0;
+    static constexpr int64_t kReorderPredicatesInterval = 32;
     std::vector<const ColumnPredicate*> _expr_ctx_preds; // predicates using ExprContext*
+    // The predicates whose operands had not been known when the zone maps were checked, e.g. runtime filters.
+    std::vector<const ColumnPredicate*> _deferred_preds;
     // _selection is used to accelerate
     Buffer<uint8_t> _selection;
 
@@ -264,6 +305,12 @@ private:
     // a mapping from column id to a indicate whether it's predicate need rewrite.
     std::vector<uint8_t> _predicate_need_rewrite;
 
+    // a mapping from column id to its expression in |_opts.column_exprs|, or nullptr.
+    std::vector<const ColumnExpr*> _column_exprs;
+    // a mapping from column id to the results of its expression for the words of its dictionary,
+    // followed by the result for null, or nullptr if the values are evaluated one by one.
+    std::vector<ColumnPtr> _dict_expr_results;
+
     ObjectPool _obj_pool;
 
     // initial size of |_opts.predicates|.
@@ -276,6 +323,7 @@ private:
 
     bool _inited = false;
     bool _has_bitmap_index = false;
+    bool _has_inverted_index = false;
 };
 
 SegmentIterator::SegmentIterator(std::shared_ptr<Segment> segment, vectorized::Schema schema,
@@ -318,23 +366,43 @@ Status SegmentIterator::_init() {
     // init stage
     // The main task is to do some initialization,
     // initialize the iterator and check if certain optimizations can be applied
+    _column_exprs.resize(1 + ChunkHelper::max_column_id(_schema), nullptr);
+    for (const ColumnExpr* expr : _opts.column_exprs) {
+        if (expr->column_id() < _column_exprs.size()) {
+            _column_exprs[expr->column_id()] = expr;
+        }
+    }
     RETURN_IF_ERROR(_check_low_cardinality_optimization());
     RETURN_IF_ERROR(_init_column_iterators<true>(_schema));
     // filter by index stage
     // Use indexes and predicates to filter some data page
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
+    RETURN_IF_ERROR(_init_inverted_index_iterators());
     RETURN_IF_ERROR(_get_row_ranges_by_keys());
+    _get_row_ranges_by_rowid_range();
+    RETURN_IF_ERROR(_get_row_ranges_by_key_split_range());
+    RETURN_IF_ERROR(_get_row_ranges_by_sorted_columns());
     RETURN_IF_ERROR(_apply_del_vector());
     RETURN_IF_ERROR(_apply_bitmap_index());
+    RETURN_IF_ERROR(_apply_inverted_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
     // rewrite stage
     // Rewriting predicates using segment dictionary codes
     _rewrite_predicates();
+    RETURN_IF_ERROR(_init_column_exprs());
     RETURN_IF_ERROR(_init_context());
     _init_column_predicates();
     _range_iter = _scan_range.new_iterator();
 
+    for (const auto& pair : _opts.predicates) {
+        for (const ColumnPredicate* pred : pair.second) {
+            if (pred->is_deferred()) {
+                _deferred_preds.emplace_back(pred);
+            }
+        }
+    }
+
     return Status::OK();
 }
 
@@ -358,6 +426,9 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
                 // if cid has global dict encode
                 // we will force the use of dictionary codes
                 check_dict_enc = true;
+            } else if (cid < _column_exprs.size() && _column_exprs[cid] != nullptr) {
+                // the expression is evaluated on the dictionary words instead of the rows
+                check_dict_enc = true;
             } else if (_opts.predicates.count(cid)) {
                 // If there is an expression condition on the column
                 // that can be optimized using low cardinality,
@@ -372,10 +443,12 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
             _obj_pool.add(_column_iterators[cid]);
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
+            iter_opts.column_stats = &_opts.stats->column_stats[cid];
             iter_opts.use_page_cache = _opts.use_page_cache;
             iter_opts.rblock = _rblock.get();
             iter_opts.check_dict_encoding = check_dict_enc;
             iter_opts.reader_type = _opts.reader_type;
+            iter_opts.read_range = &_scan_range;
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
 
             if constexpr (check_global_dict) {
@@ -415,6 +488,7 @@ void SegmentIterator::_init_column_predicates() {
     if (_vectorized_preds.empty() && _branchless_preds.empty()) {
         _opts.predicates.clear();
     }
+    _branchless_pred_selectivity.resize(_branchless_preds.size());
 }
 
 Status SegmentIterator::_get_row_ranges_by_keys() {
@@ -426,6 +500,49 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
     }
     DCHECK_EQ(0, _scan_range.span_size());
     RETURN_IF_ERROR(_segment->_load_index(StorageEngine::instance()->tablet_meta_mem_tracker()));
+    if (_opts.ranges.size() > 1) {
+        // Look up the bounds of all ranges together, see _lookup_ordinals().
+        std::vector<const SeekTuple*> keys;
+        std::vector<bool> lowers;
+        for (const SeekRange& range : _opts.ranges) {
+            if (!range.lower().empty()) {
+                keys.emplace_back(&range.lower());
+                lowers.emplace_back(range.inclusive_lower());
+            }
+            if (!range.upper().empty()) {
+                keys.emplace_back(&range.upper());
+                lowers.emplace_back(!range.inclusive_upper());
+            }
+        }
+        std::vector<rowid_t> rowids;
+        RETURN_IF_ERROR(_lookup_ordinals(keys, lowers, &rowids));
+        std::vector<Range> row_ranges;
+        size_t i = 0;
+        for (const SeekRange& range : _opts.ranges) {
+            rowid_t lower_rowid = range.lower().empty() ? 0 : rowids[i++];
+            rowid_t upper_rowid = range.upper().empty() ? num_rows() : rowids[i++];
+            if (lower_rowid < upper_rowid) {
+                row_ranges.emplace_back(lower_rowid, upper_rowid);
+            }
+        }
+        // Merge the row ranges in order, adding them to the SparseRange out of order costs a copy
+        // of all its ranges each time.
+        std::sort(row_ranges.begin(), row_ranges.end(),
+                  [](const Range& a, const Range& b) { return a.begin() < b.begin(); });
+        Range merged;
+        for (const Range& r : row_ranges) {
+            if (!merged.empty() && r.begin() <= merged.end()) {
+                merged = Range(merged.begin(), std::max(merged.end(), r.end()));
+            } else {
+                _scan_range.add(merged);
+                merged = r;
+            }
+        }
+        _scan_range.add(merged);
+        _opts.stats->rows_key_range_filtered += num_rows() - _scan_range.span_size();
+        StarRocksMetrics::instance()->segment_rows_by_short_key.increment(_scan_range.span_size());
+        return Status::OK();
+    }
     for (const SeekRange& range : _opts.ranges) {
         rowid_t lower_rowid = 0;
         rowid_t upper_rowid = num_rows();
@@ -447,6 +564,106 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
     return Status::OK();
 }
 
+void SegmentIterator::_get_row_ranges_by_rowid_range() {
+    if (!_opts.rowid_range.has_value()) {
+        return;
+    }
+    // The rows out of the range are read by other iterators, they are not accounted as filtered.
+    _scan_range &= SparseRange(_opts.rowid_range.value());
+}
+
+// The rows of the other key ranges are read by other iterators, they are not accounted as filtered either.
+Status SegmentIterator::_get_row_ranges_by_key_split_range() {
+    if (!_opts.key_split_range.has_value() || _scan_range.empty()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_segment->_load_index(StorageEngine::instance()->tablet_meta_mem_tracker()));
+    const SeekRange& range = _opts.key_split_range.value();
+    rowid_t lower_rowid = 0;
+    rowid_t upper_rowid = num_rows();
+    if (!range.upper().empty()) {
+        RETURN_IF_ERROR(_init_column_iterators<false>(range.upper().schema()));
+        RETURN_IF_ERROR(_lookup_ordinal(range.upper(), !range.inclusive_upper(), num_rows(), &upper_rowid));
+    }
+    if (!range.lower().empty() && upper_rowid > 0) {
+        RETURN_IF_ERROR(_init_column_iterators<false>(range.lower().schema()));
+        RETURN_IF_ERROR(_lookup_ordinal(range.lower(), range.inclusive_lower(), upper_rowid, &lower_rowid));
+    }
+    if (lower_rowid < upper_rowid) {
+        _scan_range &= SparseRange(lower_rowid, upper_rowid);
+    } else {
+        _scan_range.clear();
+    }
+    return Status::OK();
+}
+
+// The values of a sorted column, see ColumnReader::is_sorted(), are in ascending order of the row ids, so the
+// rows matching its comparison predicates are a range of rows, whose bounds are found by a binary search of the
+// values, like the bounds of the key ranges. The predicates are exact and removed, like the ones of bitmap index.
+Status SegmentIterator::_get_row_ranges_by_sorted_columns() {
+    RETURN_IF(_scan_range.empty(), Status::OK());
+    rowid_t begin = _scan_range.begin();
+    rowid_t end = _scan_range.end();
+    std::vector<const ColumnPredicate*> erased_preds;
+    for (const FieldPtr& f : _schema.fields()) {
+        ColumnId cid = f->id();
+        auto iter = _opts.predicates.find(cid);
+        if (iter == _opts.predicates.end() || cid >= _segment->num_columns()) {
+            continue;
+        }
+        const ColumnReader* reader = _segment->column(cid);
+        // the values of CHAR are zero-padded in the predicates, but not in the column
+        if (reader == nullptr || !reader->is_sorted() || reader->column_type() == OLAP_FIELD_TYPE_CHAR) {
+            continue;
+        }
+        ColumnPtr column = ChunkHelper::column_from_field(*f);
+        for (const ColumnPredicate* pred : iter->second) {
+            if (pred->is_deferred() || pred->type_info()->type() != reader->column_type()) {
+                continue;
+            }
+            const TypeInfo& type = *pred->type_info();
+            Datum value = pred->value();
+            switch (pred->type()) {
+            case PredicateType::kEQ:
+                RETURN_IF_ERROR(_lookup_sorted_ordinal(cid, type, value, true, begin, end, column.get(), &begin));
+                RETURN_IF_ERROR(_lookup_sorted_ordinal(cid, type, value, false, begin, end, column.get(), &end));
+                break;
+            case PredicateType::kGE:
+                RETURN_IF_ERROR(_lookup_sorted_ordinal(cid, type, value, true, begin, end, column.get(), &begin));
+                break;
+            case PredicateType::kGT:
+                RETURN_IF_ERROR(_lookup_sorted_ordinal(cid, type, value, false, begin, end, column.get(), &begin));
+                break;
+            case PredicateType::kLT:
+                RETURN_IF_ERROR(_lookup_sorted_ordinal(cid, type, value, true, begin, end, column.get(), &end));
+                break;
+            case PredicateType::kLE:
+                RETURN_IF_ERROR(_lookup_sorted_ordinal(cid, type, value, false, begin, end, column.get(), &end));
+                break;
+            default:
+                continue;
+            }
+            erased_preds.emplace_back(pred);
+        }
+    }
+    if (erased_preds.empty()) {
+        return Status::OK();
+    }
+
+    size_t input_rows = _scan_range.span_size();
+    if (begin < end) {
+        _scan_range &= SparseRange(begin, end);
+    } else {
+        _scan_range.clear();
+    }
+    for (const ColumnPredicate* pred : erased_preds) {
+        PredicateList& pred_list = _opts.predicates[pred->column_id()];
+        pred_list.erase(std::find(pred_list.begin(), pred_list.end(), pred));
+    }
+    _opts.stats->rows_sorted_range_filtered += (input_rows - _scan_range.span_size());
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_zone_map() {
     SparseRange zm_range(0, num_rows());
 
@@ -490,6 +707,8 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
         del_pred = iter != del_predicates.end() ? &(iter->second) : nullptr;
         SparseRange r;
         RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(query_preds, del_pred, &r));
+        _opts.stats->column_stats[cid].rows_stats_filtered +=
+                _scan_range.span_size() - _scan_range.intersection(r).span_size();
         zm_range = zm_range.intersection(r);
     }
     StarRocksMetrics::instance()->segment_rows_read_by_zone_map.increment(zm_range.span_size());
@@ -499,12 +718,115 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
     return Status::OK();
 }
 
-// if |lower| is true, return the first row in the range [0, end) that is not less than |key|,
-// or end if no such row is found.
-// if |lower| is false, return the first row in the range [0, end) that is greater than |key|,
-// or end if no such row is found.
-// |rowid| will be assigned to the id of found row or |end| if no such row is found.
-Status SegmentIterator::_lookup_ordinal(const SeekTuple& key, bool lower, rowid_t end, rowid_t* rowid) {
+// The deferred predicates, once their operands arrive, prune the pages not read yet by zone map.
+Status SegmentIterator::_prune_scan_range_by_arrived_predicates() {
+    if (!_range_iter.has_more()) {
+        _deferred_preds.clear();
+        return Status::OK();
+    }
+    SparseRange zm_range(_range_iter.begin(), num_rows());
+    size_t num_arrived = 0;
+    for (auto& pred : _deferred_preds) {
+        if (pred->is_deferred()) {
+            continue;
+        }
+        SparseRange r;
+        RETURN_IF_ERROR(_column_iterators[pred->column_id()]->get_row_ranges_by_zone_map({pred}, nullptr, &r));
+        SparseRange unread = _scan_range.intersection(SparseRange(_range_iter.begin(), num_rows()));
+        _opts.stats->column_stats[pred->column_id()].rows_stats_filtered +=
+                unread.span_size() - unread.intersection(r).span_size();
+        zm_range = zm_range.intersection(r);
+        pred = nullptr;
+        num_arrived++;
+    }
+    if (num_arrived == 0) {
+        return Status::OK();
+    }
+    _deferred_preds.erase(std::remove(_deferred_preds.begin(), _deferred_preds.end(), nullptr),
+                          _deferred_preds.end());
+
+    SparseRange remaining = _scan_range.intersection(SparseRange(_range_iter.begin(), num_rows()));
+    size_t prev_size = remaining.span_size();
+    _scan_range = remaining.intersection(zm_range);
+    _opts.stats->rows_stats_filtered += (prev_size - _scan_range.span_size());
+    _range_iter = _scan_range.new_iterator();
+    // Seek the columns before the next read, the rows left may start from anywhere.
+    _cur_rowid = 0;
+    return Status::OK();
+}
+
+// Same as calling _lookup_ordinal(keys[i], lowers[i], num_rows(), &rowids[i]) for each key, but
+// the lookups are sorted by the rows the short key index narrows them to, and the key columns of
+// these rows are read only once for all the lookups landing on them. So a large number of ranges,
+// e.g. a long IN-list on the prefix keys, costs a sequential read of the key columns of the blocks
+// they fall in, instead of a few random seeks and single row reads for every bound.
+Status SegmentIterator::_lookup_ordinals(const std::vector<const SeekTuple*>& keys, const std::vector<bool>& lowers,
+                                         std::vector<rowid_t>* rowids) {
+    DCHECK_EQ(keys.size(), lowers.size());
+    rowids->assign(keys.size(), 0);
+    if (keys.empty()) {
+        return Status::OK();
+    }
+    // The key columns of the seek tuples are always a prefix of the sort key, read the longest one.
+    const SeekTuple* widest = *std::max_element(keys.begin(), keys.end(), [](const SeekTuple* a, const SeekTuple* b) {
+        return a->columns() < b->columns();
+    });
+    const Schema& schema = widest->schema();
+    _init_column_iterators<false>(schema);
+
+    std::vector<rowid_t> starts(keys.size());
+    std::vector<rowid_t> ends(keys.size());
+    std::vector<size_t> order(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        ends[i] = num_rows();
+        _lookup_short_key(*keys[i], lowers[i], &starts[i], &ends[i]);
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return starts[a] < starts[b] || (starts[a] == starts[b] && ends[a] < ends[b]);
+    });
+
+    // Too many rows share the same short key, binary search them one row a time instead.
+    const rowid_t max_rows = 4 * _segment->num_rows_per_block();
+    ChunkPtr chunk = ChunkHelper::new_chunk(schema, max_rows);
+    rowid_t chunk_start = 0;
+    rowid_t chunk_end = 0;
+    for (size_t i : order) {
+        rowid_t start = starts[i];
+        rowid_t end = ends[i];
+        if (end - start > max_rows) {
+            RETURN_IF_ERROR(_lookup_ordinal(*keys[i], lowers[i], num_rows(), &(*rowids)[i]));
+            continue;
+        }
+        if (start < chunk_start || end > chunk_end) {
+            chunk->reset();
+            chunk_start = start;
+            chunk_end = end;
+            if (start < end) {
+                RETURN_IF_ERROR(_seek_columns(schema, start));
+                RETURN_IF_ERROR(_read_columns(schema, chunk.get(), end - start));
+            }
+        }
+        const SeekTuple& key = *keys[i];
+        const bool lower = lowers[i];
+        size_t lo = start - chunk_start;
+        size_t hi = end - chunk_start;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            int r = compare(key, *chunk, mid);
+            if (lower ? r > 0 : r >= 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        (*rowids)[i] = chunk_start + lo;
+    }
+    return Status::OK();
+}
+
+// Narrows the rows [0, end) the |key| may be found by lookup of the short key index down to [start, end).
+void SegmentIterator::_lookup_short_key(const SeekTuple& key, bool lower, rowid_t* start, rowid_t* end) const {
     std::string index_key;
     index_key = lower ? key.short_key_encode(_segment->num_short_keys(), KEY_MINIMAL_MARKER)
                       : key.short_key_encode(_segment->num_short_keys(), KEY_MAXIMAL_MARKER);
@@ -524,12 +846,22 @@ Status SegmentIterator::_lookup_ordinal(const SeekTuple& key, bool lower, rowid_
         // row block. so we set the rowid to first row of last row block.
         start_block_id = _segment->last_block();
     }
-    rowid_t start = start_block_id * _segment->num_rows_per_block();
+    *start = start_block_id * _segment->num_rows_per_block();
 
     auto end_iter = _segment->upper_bound(index_key);
     if (end_iter.valid()) {
-        end = end_iter.ordinal() * _segment->num_rows_per_block();
+        *end = end_iter.ordinal() * _segment->num_rows_per_block();
     }
+}
+
+// if |lower| is true, return the first row in the range [0, end) that is not less than |key|,
+// or end if no such row is found.
+// if |lower| is false, return the first row in the range [0, end) that is greater than |key|,
+// or end if no such row is found.
+// |rowid| will be assigned to the id of found row or |end| if no such row is found.
+Status SegmentIterator::_lookup_ordinal(const SeekTuple& key, bool lower, rowid_t end, rowid_t* rowid) {
+    rowid_t start = 0;
+    _lookup_short_key(key, lower, &start, &end);
 
     // binary search to find the exact key
     ChunkPtr chunk = ChunkHelper::new_chunk(key.schema(), 1);
@@ -562,6 +894,33 @@ Status SegmentIterator::_lookup_ordinal(const SeekTuple& key, bool lower, rowid_
     return Status::OK();
 }
 
+// if |lower| is true, return the first row in the range [start, end) whose value of the sorted column |cid| is not
+// less than |value|, or end if no such row is found.
+// if |lower| is false, return the first row in the range [start, end) whose value is greater than |value|, or end
+// if no such row is found.
+Status SegmentIterator::_lookup_sorted_ordinal(ColumnId cid, const TypeInfo& type, const Datum& value, bool lower,
+                                               rowid_t start, rowid_t end, Column* column, rowid_t* rowid) {
+    while (start < end) {
+        column->reset_column();
+        rowid_t mid = start + (end - start) / 2;
+        {
+            SCOPED_RAW_TIMER(&_opts.stats->block_seek_ns);
+            RETURN_IF_ERROR(_column_iterators[cid]->seek_to_ordinal(mid));
+        }
+        size_t nread = 1;
+        RETURN_IF_ERROR(_column_iterators[cid]->next_batch(&nread, column));
+        DCHECK_EQ(1, nread);
+        int r = type.cmp(value, column->get(0));
+        if (lower ? r > 0 : r >= 0) {
+            start = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    *rowid = start;
+    return Status::OK();
+}
+
 Status SegmentIterator::_seek_columns(const Schema& schema, rowid_t pos) {
     SCOPED_RAW_TIMER(&_opts.stats->block_seek_ns);
     for (const FieldPtr& f : schema.fields()) {
@@ -663,6 +1022,10 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
     const bool has_predicate = !_opts.predicates.empty();
     const int64_t prev_raw_rows_read = _opts.stats->raw_rows_read;
 
+    if (!_deferred_preds.empty()) {
+        RETURN_IF_ERROR(_prune_scan_range_by_arrived_predicates());
+    }
+
     _context->_read_chunk->reset();
     _context->_dict_chunk->reset();
     _context->_final_chunk->reset();
@@ -747,6 +1110,10 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
         }
     }
 
+    if (!_context->_expr_columns.empty()) {
+        RETURN_IF_ERROR(_evaluate_column_exprs(_context, chunk));
+    }
+
     if (_context->_has_force_dict_encode) {
         RETURN_IF_ERROR(_encode_to_global_id(_context));
         chunk = _context->_adapt_global_dict_chunk.get();
@@ -847,7 +1214,12 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
         for (size_t i = 0; selected_size > 0 && i < _branchless_preds.size(); ++i) {
             const ColumnPredicate* pred = _branchless_preds[i];
             ColumnPtr& c = chunk->get_column_by_id(pred->column_id());
+            _branchless_pred_selectivity[i].input_rows += selected_size;
             selected_size = pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size);
+            _branchless_pred_selectivity[i].output_rows += selected_size;
+        }
+        if (_branchless_preds.size() > 1 && ++_num_filter_calls % kReorderPredicatesInterval == 0) {
+            _reorder_branchless_predicates();
         }
 
         memset(&_selection[from], 0, to - from);
@@ -876,6 +1248,29 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
     return chunk_size;
 }
 
+void SegmentIterator::_reorder_branchless_predicates() {
+    auto pass_ratio = [](const PredicateSelectivity& selectivity) {
+        // A predicate never reached is assumed to select all rows, so it keeps behind the measured ones.
+        return selectivity.input_rows == 0 ? 1.0 : double(selectivity.output_rows) / selectivity.input_rows;
+    };
+    std::vector<size_t> order(_branchless_preds.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r) {
+        return pass_ratio(_branchless_pred_selectivity[l]) < pass_ratio(_branchless_pred_selectivity[r]);
+    });
+
+    std::vector<const ColumnPredicate*> preds(order.size());
+    std::vector<PredicateSelectivity> selectivity(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        preds[i] = _branchless_preds[order[i]];
+        // Halve the history, so the order follows the data as the scan goes.
+        selectivity[i].input_rows = _branchless_pred_selectivity[order[i]].input_rows / 2;
+        selectivity[i].output_rows = _branchless_pred_selectivity[order[i]].output_rows / 2;
+    }
+    _branchless_preds.swap(preds);
+    _branchless_pred_selectivity.swap(selectivity);
+}
+
 uint16_t SegmentIterator::_filter_by_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid) {
     size_t chunk_size = chunk->num_rows();
     if (_expr_ctx_preds.size() != 0 && chunk_size > 0) {
@@ -951,7 +1346,10 @@ Status SegmentIterator::_build_context(ScanContext* ctx) {
         const FieldPtr& f = _schema.field(i);
         const ColumnId cid = f->id();
         bool use_global_dict_code = _can_using_global_dict(f);
-        bool use_dict_code = _can_using_dict_code(f);
+        bool use_dict_code = _can_using_dict_code(f) || _dict_expr_results[cid] != nullptr;
+        if (_column_exprs[cid] != nullptr && _dict_expr_results[cid] == nullptr && output_columns.count(cid)) {
+            ctx->_expr_columns.push_back(cid);
+        }
 
         if (delete_pred_columns.count(f->id()) || output_columns.count(f->id())) {
             ctx->_skip_dict_decode_indexes.push_back(false);
@@ -1017,6 +1415,10 @@ Status SegmentIterator::_build_context(ScanContext* ctx) {
         const FieldPtr& f = _schema.field(i);
         const ColumnId cid = f->id();
         ctx->_has_force_dict_encode |= _column_decoders[cid].need_force_encode_to_global_id();
+        // the late materialized columns are fetched by the row ids, not by the dictionary codes
+        if (i >= early_materialize_fields && _column_exprs[cid] != nullptr && output_columns.count(cid)) {
+            ctx->_expr_columns.push_back(cid);
+        }
     }
 
     // build index map
@@ -1134,6 +1536,12 @@ Status SegmentIterator::_decode_dict_codes(ScanContext* ctx) {
             ColumnPtr& dict_values = ctx->_dict_chunk->get_column_by_index(i);
             dict_values->resize(0);
 
+            if (_dict_expr_results[cid] != nullptr) {
+                // the results for the null codes are in |_dict_expr_results| too
+                _decode_dict_codes_by_expr(cid, *dict_codes, dict_values.get());
+                continue;
+            }
+
             RETURN_IF_ERROR(_column_decoders[cid].decode_dict_codes(*dict_codes, dict_values.get()));
 
             DCHECK_EQ(dict_codes->size(), dict_values->size());
@@ -1151,6 +1559,75 @@ Status SegmentIterator::_decode_dict_codes(ScanContext* ctx) {
     return Status::OK();
 }
 
+Status SegmentIterator::_init_column_exprs() {
+    _dict_expr_results.resize(_column_exprs.size());
+    if (_opts.column_exprs.empty()) {
+        return Status::OK();
+    }
+    std::set<ColumnId> delete_pred_columns;
+    _opts.delete_predicates.get_column_ids(&delete_pred_columns);
+    for (const FieldPtr& f : _schema.fields()) {
+        const ColumnId cid = f->id();
+        const ColumnExpr* expr = _column_exprs[cid];
+        // the delete predicates are evaluated on the original values
+        if (expr == nullptr || !_column_iterators[cid]->all_page_dict_encoded() ||
+            _opts.global_dictmaps->count(cid) || delete_pred_columns.count(cid)) {
+            continue;
+        }
+        std::vector<Slice> words;
+        RETURN_IF_ERROR(_column_iterators[cid]->fetch_all_dict_words(&words));
+        auto words_column = BinaryColumn::create();
+        words_column->append_strings(words);
+        ColumnPtr input = words_column;
+        if (f->is_nullable()) {
+            // the last one is the result for null
+            auto nullable_words = NullableColumn::create(words_column, NullColumn::create(words.size(), 0));
+            nullable_words->append_nulls(1);
+            input = nullable_words;
+        }
+        ColumnPtr results = expr->evaluate(input);
+        if (results != nullptr) {
+            _dict_expr_results[cid] = std::move(results);
+        }
+    }
+    return Status::OK();
+}
+
+void SegmentIterator::_decode_dict_codes_by_expr(ColumnId cid, const Column& codes, Column* values) const {
+    const ColumnPtr& results = _dict_expr_results[cid];
+    const Int32Column* code_column = nullptr;
+    const uint8_t* nulls = nullptr;
+    if (codes.is_nullable()) {
+        const auto& nullable_codes = down_cast<const NullableColumn&>(codes);
+        code_column = down_cast<const Int32Column*>(nullable_codes.data_column().get());
+        nulls = nullable_codes.null_column()->get_data().data();
+    } else {
+        code_column = down_cast<const Int32Column*>(&codes);
+    }
+    const auto& code_data = code_column->get_data();
+    const auto null_index = static_cast<uint32_t>(results->size() - 1);
+    std::vector<uint32_t> indexes(codes.size());
+    for (size_t i = 0; i < indexes.size(); i++) {
+        indexes[i] = (nulls != nullptr && nulls[i]) ? null_index : static_cast<uint32_t>(code_data[i]);
+    }
+    values->append_selective(*results, indexes);
+}
+
+Status SegmentIterator::_evaluate_column_exprs(ScanContext* ctx, Chunk* chunk) {
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    for (ColumnId cid : ctx->_expr_columns) {
+        ColumnPtr& column = chunk->get_column_by_id(cid);
+        ColumnPtr results = _column_exprs[cid]->evaluate(column);
+        if (results == nullptr) {
+            return Status::InternalError(fmt::format("null results of the expression on the non-null column {}", cid));
+        }
+        column = std::move(results);
+    }
+    return Status::OK();
+}
+
 Status SegmentIterator::_check_low_cardinality_optimization() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
     _predicate_need_rewrite.resize(1 + ChunkHelper::max_column_id(_schema), false);
@@ -1282,6 +1759,7 @@ Status SegmentIterator::_apply_bitmap_index() {
             }
         }
         if (selected.empty()) {
+            _opts.stats->column_stats[cid].rows_bitmap_index_filtered += _scan_range.span_size();
             _opts.stats->rows_bitmap_index_filtered += _scan_range.span_size();
             _scan_range.clear();
             return Status::OK();
@@ -1318,7 +1796,10 @@ Status SegmentIterator::_apply_bitmap_index() {
             row_bitmap -= null_bitmap;
         }
         RETURN_IF_ERROR(bitmap_iter->read_union_bitmap(bitmap_ranges[i], &roaring));
+        size_t column_prev_rows = row_bitmap.cardinality();
         row_bitmap &= roaring;
+        _opts.stats->column_stats[bitmap_columns[i]].rows_bitmap_index_filtered +=
+                column_prev_rows - row_bitmap.cardinality();
     }
 
     DCHECK_LE(row_bitmap.cardinality(), _scan_range.span_size());
@@ -1338,6 +1819,59 @@ Status SegmentIterator::_apply_bitmap_index() {
     return Status::OK();
 }
 
+Status SegmentIterator::_init_inverted_index_iterators() {
+    _inverted_index_iterators.resize(ChunkHelper::max_column_id(_schema) + 1, nullptr);
+    for (const auto& pair : _opts.predicates) {
+        ColumnId cid = pair.first;
+        if (_inverted_index_iterators[cid] == nullptr) {
+            RETURN_IF_ERROR(_segment->new_inverted_index_iterator(cid, &_inverted_index_iterators[cid]));
+            _has_inverted_index |= (_inverted_index_iterators[cid] != nullptr);
+        }
+    }
+    return Status::OK();
+}
+
+// filter rows by the candidate rows of the column predicates read from the inverted indexes.
+// the candidate rows are a superset of the satisfied rows, so the predicates are kept to be evaluated.
+Status SegmentIterator::_apply_inverted_index() {
+    RETURN_IF(!_has_inverted_index || _scan_range.empty(), Status::OK());
+    SCOPED_RAW_TIMER(&_opts.stats->inverted_index_filter_timer);
+
+    Roaring row_bitmap;
+    bool has_candidates = false;
+    for (auto& [cid, pred_list] : _opts.predicates) {
+        InvertedIndexIterator* inverted_iter = _inverted_index_iterators[cid];
+        if (inverted_iter == nullptr) {
+            continue;
+        }
+        for (const ColumnPredicate* pred : pred_list) {
+            Roaring rows;
+            Status st = pred->seek_inverted_index(inverted_iter, &rows);
+            if (st.is_cancelled()) {
+                continue;
+            }
+            RETURN_IF_ERROR(st);
+            if (has_candidates) {
+                row_bitmap &= rows;
+            } else {
+                row_bitmap = std::move(rows);
+                has_candidates = true;
+            }
+        }
+    }
+    if (!has_candidates) {
+        return Status::OK();
+    }
+
+    size_t input_rows = _scan_range.span_size();
+    row_bitmap &= range2roaring(_scan_range);
+    if (row_bitmap.cardinality() < input_rows) {
+        _scan_range = roaring2range(row_bitmap);
+    }
+    _opts.stats->rows_inverted_index_filtered += (input_rows - _scan_range.span_size());
+    return Status::OK();
+}
+
 Status SegmentIterator::_apply_del_vector() {
     if (_opts.is_primary_keys && _opts.version > 0 && _del_vec && !_del_vec->empty()) {
         Roaring row_bitmap = range2roaring(_scan_range);
@@ -1355,7 +1889,9 @@ Status SegmentIterator::_get_row_ranges_by_bloom_filter() {
     size_t prev_size = _scan_range.span_size();
     for (const auto& [cid, preds] : _opts.predicates) {
         ColumnIterator* column_iter = _column_iterators[cid];
+        size_t column_prev_size = _scan_range.span_size();
         RETURN_IF_ERROR(column_iter->get_row_ranges_by_bloom_filter(preds, &_scan_range));
+        _opts.stats->column_stats[cid].rows_bf_filtered += column_prev_size - _scan_range.span_size();
     }
     _opts.stats->rows_bf_filtered += prev_size - _scan_range.span_size();
     return Status::OK();
@@ -1375,6 +1911,9 @@ void SegmentIterator::close() {
     for (auto* iter : _bitmap_index_iterators) {
         delete iter;
     }
+    for (auto* iter : _inverted_index_iterators) {
+        delete iter;
+    }
 }
 
 // put the field that has predicate on it ahead of those without one, for handle late
@@ -27,6 +27,14 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
     // delete predicates
     RETURN_IF_ERROR(delete_predicates.convert_to(&dst->delete_predicates, new_types, obj_pool));
 
+    // only the string columns have expressions, whose types are never converted
+    dst->column_exprs = column_exprs;
+
+    dst->rowid_range = rowid_range;
+    if (key_split_range.has_value()) {
+        dst->key_split_range.emplace();
+        key_split_range->convert_to(&dst->key_split_range.value(), new_types);
+    }
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
     dst->profile = profile;
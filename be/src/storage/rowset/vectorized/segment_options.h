@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -9,6 +10,7 @@
 #include "runtime/global_dicts.h"
 #include "storage/fs/fs_util.h"
 #include "storage/vectorized/disjunctive_predicates.h"
+#include "storage/vectorized/range.h"
 #include "storage/vectorized/seek_range.h"
 
 namespace starrocks {
@@ -21,6 +23,7 @@ class KVStore;
 
 namespace starrocks::vectorized {
 
+class ColumnExpr;
 class ColumnPredicate;
 
 class SegmentReadOptions {
@@ -31,8 +34,18 @@ public:
 
     std::vector<SeekRange> ranges;
 
+    // If set, only the rows in this range of rowids are read, used to split the scan of a segment.
+    std::optional<Range> rowid_range;
+
+    // If set, only the rows whose keys are in this range are read, used to split the scan of a tablet whose
+    // rows need merging.
+    std::optional<SeekRange> key_split_range;
+
     std::unordered_map<ColumnId, PredicateList> predicates;
 
+    // The columns read as the results of the expressions over them, see ColumnExpr.
+    std::vector<const ColumnExpr*> column_exprs;
+
     DisjunctivePredicates delete_predicates;
 
     // used for updatable tablet to get delvec
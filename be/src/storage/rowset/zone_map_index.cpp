@@ -21,6 +21,8 @@
 
 #include "storage/rowset/zone_map_index.h"
 
+#include <algorithm>
+
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "storage/column_block.h"
@@ -67,7 +69,10 @@ public:
 
     void add_values(const void* values, size_t count) override;
 
-    void add_nulls(uint32_t count) override { _page_zone_map.has_null |= count > 0; }
+    void add_nulls(uint32_t count) override {
+        _page_zone_map.has_null |= count > 0;
+        _sorted &= count == 0;
+    }
 
     // mark the end of one data page so that we can finalize the corresponding zone map
     Status flush() override;
@@ -76,6 +81,8 @@ public:
 
     uint64_t size() const override { return _estimated_size; }
 
+    bool is_sorted() const override { return _sorted && _last_value != nullptr; }
+
 private:
     void _reset_zone_map(ZoneMap* zone_map) {
         // we should allocate max varchar length and set to max for min value
@@ -96,6 +103,10 @@ private:
     // serialized ZoneMapPB for each data page
     std::vector<std::string> _values;
     uint64_t _estimated_size = 0;
+
+    // the last value added, nullptr if no value is added
+    char* _last_value = nullptr;
+    bool _sorted = true;
 };
 
 template <FieldType type>
@@ -120,6 +131,18 @@ void ZoneMapIndexWriterImpl<type>::add_values(const void* values, size_t count)
         if (unaligned_load<CppType>(pmax) > unaligned_load<CppType>(_page_zone_map.max_value)) {
             _field->type_info()->direct_copy(_page_zone_map.max_value, pmax, nullptr);
         }
+        if (_sorted) {
+            if (_last_value != nullptr && unaligned_load<CppType>(vals) < unaligned_load<CppType>(_last_value)) {
+                _sorted = false;
+            } else if (!std::is_sorted(vals, vals + count)) {
+                _sorted = false;
+            } else {
+                if (_last_value == nullptr) {
+                    _last_value = _field->allocate_value(&_pool);
+                }
+                _field->type_info()->direct_copy(_last_value, vals + count - 1, nullptr);
+            }
+        }
     }
 }
 
@@ -61,6 +61,9 @@ public:
     virtual Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) = 0;
 
     virtual uint64_t size() const = 0;
+
+    // whether all the values added are not null and in ascending order, false if no value is added.
+    virtual bool is_sorted() const = 0;
 };
 
 class ZoneMapIndexReader {
@@ -2,6 +2,8 @@
 
 #include "rowset_update_state.h"
 
+#include <numeric>
+
 #include "gutil/strings/substitute.h"
 #include "serde/column_array_serde.h"
 #include "storage/primary_key_encoder.h"
@@ -244,18 +246,30 @@ Status RowsetUpdateState::_prepare_partial_update_states(Tablet* tablet, Rowset*
     RETURN_IF_ERROR(tablet->updates()->prepare_partial_update_states(tablet, _upserts, &_read_version, &_next_rowset_id,
                                                                      &rss_rowids));
 
+    // the old rows of all the segments are read together, so each source segment is opened and read
+    // only once, no matter how many segments of this rowset update its rows.
+    std::vector<uint64_t> all_rss_rowids;
+    all_rss_rowids.reserve(std::accumulate(_upserts.begin(), _upserts.end(), size_t(0),
+                                           [](size_t n, const auto& pks) { return n + pks->size(); }));
+    for (size_t i = 0; i < num_segments; i++) {
+        const auto& rss_rowids = _partial_update_states[i].src_rss_rowids;
+        all_rss_rowids.insert(all_rss_rowids.end(), rss_rowids.begin(), rss_rowids.end());
+    }
+    size_t num_default = 0;
+    std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
+    vector<uint32_t> idxes;
+    plan_read_by_rssid(all_rss_rowids, &num_default, &rowids_by_rssid, &idxes);
+    // get column values by rowid, also get default values if needed
+    RETURN_IF_ERROR(
+            tablet->updates()->get_column_values(read_column_ids, num_default > 0, rowids_by_rssid, &read_columns));
+    size_t offset = 0;
     for (size_t i = 0; i < num_segments; i++) {
-        size_t num_default = 0;
-        std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
-        vector<uint32_t> idxes;
-        plan_read_by_rssid(_partial_update_states[i].src_rss_rowids, &num_default, &rowids_by_rssid, &idxes);
-        // get column values by rowid, also get default values if needed
-        RETURN_IF_ERROR(
-                tablet->updates()->get_column_values(read_column_ids, num_default > 0, rowids_by_rssid, &read_columns));
+        const size_t num_rows = _partial_update_states[i].src_rss_rowids.size();
         for (size_t col_idx = 0; col_idx < read_column_ids.size(); col_idx++) {
-            _partial_update_states[i].write_columns[col_idx]->append_selective(*read_columns[col_idx], idxes.data(), 0,
-                                                                               idxes.size());
+            _partial_update_states[i].write_columns[col_idx]->append_selective(*read_columns[col_idx], idxes.data(),
+                                                                               offset, num_rows);
         }
+        offset += num_rows;
     }
 
     return Status::OK();
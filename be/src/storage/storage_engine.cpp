@@ -43,10 +43,12 @@
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "storage/async_delta_writer_executor.h"
+#include "storage/compaction_scheduler.h"
 #include "storage/data_dir.h"
 #include "storage/fs/file_block_manager.h"
 #include "storage/lru_cache.h"
 #include "storage/memtable_flush_executor.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_meta.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/rowset/unique_rowset_id_generator.h"
@@ -57,12 +59,14 @@
 #include "storage/utils.h"
 #include "storage/vectorized/base_compaction.h"
 #include "storage/vectorized/cumulative_compaction.h"
+#include "util/cpu_info.h"
 #include "util/defer_op.h"
 #include "util/file_utils.h"
 #include "util/pretty_printer.h"
 #include "util/scoped_cleanup.h"
 #include "util/starrocks_metrics.h"
 #include "util/thread.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -147,7 +151,8 @@ Status StorageEngine::_open() {
 
     _index_stream_lru_cache = new_lru_cache(config::index_stream_cache_capacity);
 
-    _file_cache.reset(new_lru_cache(config::file_descriptor_cache_capacity));
+    _file_cache.reset(new_lru_cache(_file_descriptor_cache_capacity(), _file_descriptor_cache_shard_bits(),
+                                    std::clamp(config::file_descriptor_cache_protected_ratio, 0.0, 1.0)));
 
     fs::BlockManagerOptions bm_opts;
     bm_opts.read_only = false;
@@ -169,6 +174,23 @@ Status StorageEngine::_open() {
     _memtable_flush_executor = std::make_unique<MemTableFlushExecutor>();
     RETURN_IF_ERROR_WITH_WARN(_memtable_flush_executor->init(dirs), "init MemTableFlushExecutor failed");
 
+    if (config::segment_encode_thread_num > 0) {
+        RETURN_IF_ERROR_WITH_WARN(ThreadPoolBuilder("segment_encode")
+                                          .set_min_threads(1)
+                                          .set_max_threads(config::segment_encode_thread_num)
+                                          .build(&_segment_encode_thread_pool),
+                                  "init segment encode thread pool failed");
+    }
+
+    if (config::rowset_prewarm_thread_num > 0) {
+        RETURN_IF_ERROR_WITH_WARN(ThreadPoolBuilder("rowset_prewarm")
+                                          .set_min_threads(1)
+                                          .set_max_threads(config::rowset_prewarm_thread_num)
+                                          .set_max_queue_size(config::rowset_prewarm_max_queue_size)
+                                          .build(&_rowset_prewarm_thread_pool),
+                                  "init rowset prewarm thread pool failed");
+    }
+
     return Status::OK();
 }
 
@@ -338,6 +360,28 @@ Status StorageEngine::_check_file_descriptor_number() {
     return Status::OK();
 }
 
+size_t StorageEngine::_file_descriptor_cache_capacity() {
+    int64_t capacity = config::file_descriptor_cache_capacity;
+    struct rlimit l;
+    if (getrlimit(RLIMIT_NOFILE, &l) == 0 && l.rlim_cur != RLIM_INFINITY) {
+        // Leave the other half of the descriptors to the sockets and the files being written.
+        auto limit = static_cast<int64_t>(l.rlim_cur / 2);
+        capacity = capacity <= 0 ? limit : std::min(capacity, limit);
+    }
+    return capacity > 0 ? capacity : 16384;
+}
+
+int StorageEngine::_file_descriptor_cache_shard_bits() {
+    if (config::file_descriptor_cache_shard_bits >= 0) {
+        return std::clamp(config::file_descriptor_cache_shard_bits, 0, 16);
+    }
+    int shard_bits = 0;
+    while ((1 << shard_bits) < CpuInfo::num_cores() && shard_bits < 10) {
+        shard_bits++;
+    }
+    return std::max(shard_bits, kNumShardBits);
+}
+
 Status StorageEngine::_check_all_root_path_cluster_id() {
     int32_t cluster_id = -1;
     for (auto& it : _store_map) {
@@ -462,6 +506,12 @@ void StorageEngine::stop() {
         _store_map.clear();
     }
     _bg_worker_stopped.store(true, std::memory_order_release);
+    if (_rowset_prewarm_thread_pool != nullptr) {
+        _rowset_prewarm_thread_pool->shutdown();
+    }
+    if (_compaction_scheduler != nullptr) {
+        _compaction_scheduler->stop();
+    }
 
     if (_update_cache_expire_thread.joinable()) {
         _update_cache_expire_thread.join();
@@ -498,6 +548,9 @@ void StorageEngine::stop() {
     if (_fd_cache_clean_thread.joinable()) {
         _fd_cache_clean_thread.join();
     }
+    if (_segment_footer_preload_thread.joinable()) {
+        _segment_footer_preload_thread.join();
+    }
     if (config::path_gc_check) {
         for (auto& thread : _path_scan_threads) {
             if (thread.joinable()) {
@@ -550,7 +603,7 @@ void StorageEngine::clear_transaction_task(const TTransactionId transaction_id,
 
 void StorageEngine::_start_clean_fd_cache() {
     VLOG(10) << "Cleaning file descriptor cache";
-    _file_cache->prune();
+    _file_cache->prune_cold();
     VLOG(10) << "Cleaned file descriptor cache";
 }
 
@@ -578,7 +631,13 @@ Status StorageEngine::_perform_cumulative_compaction(DataDir* data_dir) {
             std::make_unique<MemTracker>(MemTracker::COMPACTION, -1, "", _options.compaction_mem_tracker);
     vectorized::CumulativeCompaction cumulative_compaction(mem_tracker.get(), best_tablet);
 
-    Status res = cumulative_compaction.compact();
+    Status res;
+    int64_t duration_ns = 0;
+    {
+        SCOPED_RAW_TIMER(&duration_ns);
+        res = cumulative_compaction.compact();
+    }
+    StarRocksMetrics::instance()->cumulative_compaction_latency_us.observe(duration_ns / 1000);
     if (!res.ok()) {
         if (!res.is_mem_limit_exceeded()) {
             best_tablet->set_last_cumu_compaction_failure_time(UnixMillis());
@@ -619,7 +678,13 @@ Status StorageEngine::_perform_base_compaction(DataDir* data_dir) {
             std::make_unique<MemTracker>(MemTracker::COMPACTION, -1, "", _options.compaction_mem_tracker);
     vectorized::BaseCompaction base_compaction(mem_tracker.get(), best_tablet);
 
-    Status res = base_compaction.compact();
+    Status res;
+    int64_t duration_ns = 0;
+    {
+        SCOPED_RAW_TIMER(&duration_ns);
+        res = base_compaction.compact();
+    }
+    StarRocksMetrics::instance()->base_compaction_latency_us.observe(duration_ns / 1000);
     if (!res.ok()) {
         best_tablet->set_last_base_compaction_failure_time(UnixMillis());
         if (!res.is_not_found()) {
@@ -665,6 +730,7 @@ Status StorageEngine::_perform_update_compaction(DataDir* data_dir) {
         res = best_tablet->updates()->compaction(mem_tracker.get());
     }
     StarRocksMetrics::instance()->update_compaction_duration_us.increment(duration_ns / 1000);
+    StarRocksMetrics::instance()->update_compaction_latency_us.observe(duration_ns / 1000);
     if (!res.ok()) {
         StarRocksMetrics::instance()->update_compaction_request_failed.increment(1);
         LOG(WARNING) << "failed to perform update compaction. res=" << res.to_string()
@@ -1016,4 +1082,63 @@ bool StorageEngine::check_rowset_id_in_unused_rowsets(const RowsetId& rowset_id)
     return search != _unused_rowsets.end();
 }
 
+void StorageEngine::prewarm_rowset(const TabletSharedPtr& tablet, const RowsetSharedPtr& rowset) {
+    if (!_need_prewarm(tablet)) {
+        return;
+    }
+    auto st = _rowset_prewarm_thread_pool->submit_func([this, tablet, rowset] { _prewarm_rowsets(tablet, {rowset}); });
+    LOG_IF(WARNING, !st.ok()) << "skip prewarming rowset " << rowset->rowset_id() << ": " << st;
+}
+
+void StorageEngine::prewarm_tablet(const TabletSharedPtr& tablet) {
+    if (!_need_prewarm(tablet)) {
+        return;
+    }
+    auto st = _rowset_prewarm_thread_pool->submit_func([this, tablet] {
+        std::vector<RowsetSharedPtr> rowsets;
+        Status st;
+        {
+            std::shared_lock l(tablet->get_header_lock());
+            st = tablet->capture_consistent_rowsets(Version(0, tablet->max_version().second), &rowsets);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "skip prewarming tablet " << tablet->tablet_id() << ": " << st;
+            return;
+        }
+        _prewarm_rowsets(tablet, rowsets);
+    });
+    LOG_IF(WARNING, !st.ok()) << "skip prewarming tablet " << tablet->tablet_id() << ": " << st;
+}
+
+bool StorageEngine::_need_prewarm(const TabletSharedPtr& tablet) {
+    if (_rowset_prewarm_thread_pool == nullptr || config::disable_storage_page_cache) {
+        return false;
+    }
+    double heat_bytes = 0;
+    double heat_scans = 0;
+    tablet->get_access_heat(&heat_bytes, &heat_scans);
+    return heat_scans >= config::rowset_prewarm_min_access_scans;
+}
+
+void StorageEngine::_prewarm_rowsets(const TabletSharedPtr& tablet, const std::vector<RowsetSharedPtr>& rowsets) {
+    int64_t budget_bytes = config::rowset_prewarm_max_bytes;
+    for (const auto& rowset : rowsets) {
+        if (budget_bytes <= 0 || _bg_worker_stopped.load(std::memory_order_consume)) {
+            break;
+        }
+        Status st = rowset->load();
+        auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
+        for (size_t i = 0; st.ok() && i < beta_rowset->segments().size() && budget_bytes > 0; i++) {
+            st = beta_rowset->segments()[i]->prewarm(tablet_meta_mem_tracker(), &budget_bytes);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "fail to prewarm rowset " << rowset->rowset_id() << " of tablet " << tablet->tablet_id()
+                         << ": " << st;
+            return;
+        }
+    }
+    StarRocksMetrics::instance()->rowset_prewarm_bytes_total.increment(config::rowset_prewarm_max_bytes -
+                                                                         std::max<int64_t>(budget_bytes, 0));
+}
+
 } // namespace starrocks
@@ -55,11 +55,13 @@
 namespace starrocks {
 
 class AsyncDeltaWriterExecutor;
+class CompactionScheduler;
 class DataDir;
 class EngineTask;
 class BlockManager;
 class MemTableFlushExecutor;
 class Tablet;
+class ThreadPool;
 class UpdateManager;
 
 // StorageEngine singleton to manage all Table pointers.
@@ -160,12 +162,25 @@ public:
 
     MemTableFlushExecutor* memtable_flush_executor() { return _memtable_flush_executor.get(); }
 
+    // The pool to encode the columns of the segments in parallel, nullptr if
+    // config::segment_encode_thread_num is 0.
+    ThreadPool* segment_encode_thread_pool() { return _segment_encode_thread_pool.get(); }
+
     fs::BlockManager* block_manager() { return _block_manager.get(); }
 
     UpdateManager* update_manager() { return _update_manager.get(); }
 
     bool check_rowset_id_in_unused_rowsets(const RowsetId& rowset_id);
 
+    // Load the indexes and read the pages of |rowset|, the output of a compaction of |tablet|, into the caches
+    // in the background, so the first queries after the compaction don't read them from the disk. Only the
+    // tablets scanned at least config::rowset_prewarm_min_access_scans times recently are pre-warmed, up to
+    // config::rowset_prewarm_max_bytes bytes of the pages. Does nothing if config::rowset_prewarm_thread_num is 0.
+    void prewarm_rowset(const TabletSharedPtr& tablet, const RowsetSharedPtr& rowset);
+
+    // Pre-warm the rowsets of the latest version of |tablet| like prewarm_rowset(), after it's cloned or migrated.
+    void prewarm_tablet(const TabletSharedPtr& tablet);
+
     RowsetId next_rowset_id() { return _rowset_id_generator->next_id(); };
 
     bool rowset_id_in_use(const RowsetId& rowset_id) { return _rowset_id_generator->id_in_use(rowset_id); }
@@ -194,6 +209,9 @@ private:
 
     // Some check methods
     Status _check_file_descriptor_number();
+    // The capacity of the file descriptor cache, bounded by the limit of open files.
+    static size_t _file_descriptor_cache_capacity();
+    static int _file_descriptor_cache_shard_bits();
     Status _check_all_root_path_cluster_id();
     Status _judge_and_update_effective_cluster_id(int32_t cluster_id);
 
@@ -242,6 +260,9 @@ private:
     Status _start_trash_sweep(double* usage);
     void _start_disk_stat_monitor();
 
+    bool _need_prewarm(const TabletSharedPtr& tablet);
+    void _prewarm_rowsets(const TabletSharedPtr& tablet, const std::vector<RowsetSharedPtr>& rowsets);
+
 private:
     struct CompactionCandidate {
         CompactionCandidate(uint32_t nicumulative_compaction_, int64_t tablet_id_, uint32_t index_)
@@ -305,8 +326,12 @@ private:
     std::vector<std::thread> _cumulative_compaction_threads;
     // threads to run update compaction
     std::vector<std::thread> _update_compaction_threads;
+    // admits the tasks of all the compaction threads
+    std::unique_ptr<CompactionScheduler> _compaction_scheduler;
     // threads to clean all file descriptor not actively in use
     std::thread _fd_cache_clean_thread;
+    // thread to preload the segment footers of the hot tablets after the BE starts
+    std::thread _segment_footer_preload_thread;
     std::vector<std::thread> _path_gc_threads;
     // threads to scan disk paths
     std::vector<std::thread> _path_scan_threads;
@@ -330,6 +355,11 @@ private:
 
     std::unique_ptr<MemTableFlushExecutor> _memtable_flush_executor;
 
+    std::unique_ptr<ThreadPool> _segment_encode_thread_pool;
+
+    // nullptr if config::rowset_prewarm_thread_num is 0
+    std::unique_ptr<ThreadPool> _rowset_prewarm_thread_pool;
+
     std::unique_ptr<fs::BlockManager> _block_manager;
 
     std::unique_ptr<UpdateManager> _update_manager;
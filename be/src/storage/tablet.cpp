@@ -26,6 +26,7 @@
 #include <rapidjson/stringbuffer.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <map>
 #include <memory>
@@ -1037,6 +1038,104 @@ bool Tablet::_contains_rowset(const RowsetId rowset_id) {
     return false;
 }
 
+void Tablet::record_scan(int64_t bytes) {
+    std::lock_guard l(_access_heat_lock);
+    _decay_access_heat_unlocked();
+    _access_heat_bytes += bytes;
+    _access_heat_scans += 1;
+}
+
+void Tablet::get_access_heat(double* bytes, double* scans) {
+    std::lock_guard l(_access_heat_lock);
+    _decay_access_heat_unlocked();
+    *bytes = _access_heat_bytes;
+    *scans = _access_heat_scans;
+}
+
+void Tablet::inherit_access_heat(Tablet* tablet) {
+    double heat_bytes = 0;
+    double heat_scans = 0;
+    tablet->get_access_heat(&heat_bytes, &heat_scans);
+    {
+        std::lock_guard l(_access_heat_lock);
+        _decay_access_heat_unlocked();
+        _access_heat_bytes += heat_bytes;
+        _access_heat_scans += heat_scans;
+    }
+    record_column_access(tablet->get_column_access_stats());
+}
+
+void ColumnAccessStats::merge(const ColumnAccessStats& other) {
+    reads += other.reads;
+    filters += other.filters;
+    groups += other.groups;
+    for (const auto& [form, count] : other.predicate_forms) {
+        predicate_forms[form] += count;
+    }
+}
+
+void Tablet::record_column_access(const std::map<std::string, ColumnAccessStats>& accesses) {
+    std::lock_guard l(_column_access_lock);
+    for (const auto& [column, stats] : accesses) {
+        _column_access_stats[column].merge(stats);
+    }
+}
+
+std::map<std::string, ColumnAccessStats> Tablet::get_column_access_stats() {
+    std::lock_guard l(_column_access_lock);
+    return _column_access_stats;
+}
+
+void Tablet::get_column_access_status(std::string* json_result) {
+    rapidjson::Document root;
+    root.SetObject();
+    root.AddMember("tablet_id", tablet_id(), root.GetAllocator());
+    double heat_bytes = 0;
+    double heat_scans = 0;
+    get_access_heat(&heat_bytes, &heat_scans);
+    root.AddMember("access_heat_scans", heat_scans, root.GetAllocator());
+
+    rapidjson::Value columns;
+    columns.SetArray();
+    for (const auto& [column, stats] : get_column_access_stats()) {
+        rapidjson::Value value;
+        value.SetObject();
+        rapidjson::Value name;
+        name.SetString(column.c_str(), column.length(), root.GetAllocator());
+        value.AddMember("column", name, root.GetAllocator());
+        value.AddMember("reads", stats.reads, root.GetAllocator());
+        value.AddMember("filters", stats.filters, root.GetAllocator());
+        value.AddMember("groups", stats.groups, root.GetAllocator());
+        rapidjson::Value forms;
+        forms.SetObject();
+        for (const auto& [form, count] : stats.predicate_forms) {
+            rapidjson::Value form_name;
+            form_name.SetString(form.c_str(), form.length(), root.GetAllocator());
+            forms.AddMember(form_name, count, root.GetAllocator());
+        }
+        value.AddMember("predicate_forms", forms, root.GetAllocator());
+        columns.PushBack(value, root.GetAllocator());
+    }
+    root.AddMember("columns", columns, root.GetAllocator());
+
+    rapidjson::StringBuffer strbuf;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
+    root.Accept(writer);
+    *json_result = std::string(strbuf.GetString());
+}
+
+void Tablet::_decay_access_heat_unlocked() {
+    int64_t now_ms = MonotonicMillis();
+    int64_t elapsed_ms = now_ms - _access_heat_time_ms;
+    if (elapsed_ms > 0 && config::tablet_access_heat_half_life_sec > 0) {
+        double half_life_ms = config::tablet_access_heat_half_life_sec * 1000.0;
+        double decay = std::exp2(-static_cast<double>(elapsed_ms) / half_life_ms);
+        _access_heat_bytes *= decay;
+        _access_heat_scans *= decay;
+    }
+    _access_heat_time_ms = now_ms;
+}
+
 void Tablet::build_tablet_report_info(TTabletInfo* tablet_info) {
     std::shared_lock rdlock(_meta_lock);
     tablet_info->__set_tablet_id(_tablet_meta->tablet_id());
@@ -1045,6 +1144,11 @@ void Tablet::build_tablet_report_info(TTabletInfo* tablet_info) {
     tablet_info->__set_storage_medium(_data_dir->storage_medium());
     tablet_info->__set_path_hash(_data_dir->path_hash());
     tablet_info->__set_is_in_memory(_tablet_meta->tablet_schema().is_in_memory());
+    double heat_bytes = 0;
+    double heat_scans = 0;
+    get_access_heat(&heat_bytes, &heat_scans);
+    tablet_info->__set_access_heat_bytes(static_cast<int64_t>(heat_bytes));
+    tablet_info->__set_access_heat_scans(static_cast<int64_t>(heat_scans));
     if (_updates) {
         _updates->get_tablet_info_extra(tablet_info);
     } else {
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -61,6 +62,19 @@ class RowsetReadOptions;
 
 using ChunkIteratorPtr = std::shared_ptr<vectorized::ChunkIterator>;
 
+// The accesses of the scans of the queries to a column of a tablet, which tell the columns worth a sort key, an index
+// or the hot storage.
+struct ColumnAccessStats {
+    // the number of the scans reading the column, filtering by it and grouping by it
+    int64_t reads = 0;
+    int64_t filters = 0;
+    int64_t groups = 0;
+    // the number of the predicates on the column by their forms, e.g. "eq", "range" and "in"
+    std::map<std::string, int64_t> predicate_forms;
+
+    void merge(const ColumnAccessStats& other);
+};
+
 class Tablet : public BaseTablet {
 public:
     static TabletSharedPtr create_tablet_from_meta(MemTracker* mem_tracker, const TabletMetaSharedPtr& tablet_meta,
@@ -231,6 +245,26 @@ public:
 
     void build_tablet_report_info(TTabletInfo* tablet_info);
 
+    // Record a scan of a query reading |bytes| compressed bytes from this tablet.
+    void record_scan(int64_t bytes);
+
+    // The scanned bytes and the number of the scans recorded by record_scan(), the earlier ones weigh less, they
+    // are halved every config::tablet_access_heat_half_life_sec seconds.
+    void get_access_heat(double* bytes, double* scans);
+
+    // Take over the access heat and the column accesses of |tablet|, the same tablet in another data dir before a
+    // storage migration.
+    void inherit_access_heat(Tablet* tablet);
+
+    // Record the accesses of a scan of a query to the columns of this tablet, by the column names.
+    void record_column_access(const std::map<std::string, ColumnAccessStats>& accesses);
+
+    // The column accesses recorded by record_column_access() since the tablet is loaded, by the column names.
+    std::map<std::string, ColumnAccessStats> get_column_access_stats();
+
+    // return a json string to show the column accesses of this tablet
+    void get_column_access_status(std::string* json_result);
+
     void generate_tablet_meta_copy(const TabletMetaSharedPtr& new_tablet_meta) const;
     // caller should hold the _meta_lock before calling this method
     void generate_tablet_meta_copy_unlocked(const TabletMetaSharedPtr& new_tablet_meta) const;
@@ -251,6 +285,7 @@ private:
     Status _init_once_action();
     void _print_missed_versions(const std::vector<Version>& missed_versions) const;
     bool _contains_rowset(const RowsetId rowset_id);
+    void _decay_access_heat_unlocked();
     Status _contains_version(const Version& version);
     Version _max_continuous_version_from_beginning_unlocked() const;
     RowsetSharedPtr _rowset_with_largest_size();
@@ -314,6 +349,15 @@ private:
     std::atomic<int32_t> _newly_created_rowset_num{0};
     std::atomic<int64_t> _last_checkpoint_time{0};
 
+    // the access heat decayed to |_access_heat_time_ms|, guarded by |_access_heat_lock|
+    std::mutex _access_heat_lock;
+    double _access_heat_bytes = 0;
+    double _access_heat_scans = 0;
+    int64_t _access_heat_time_ms = 0;
+
+    std::mutex _column_access_lock;
+    std::map<std::string, ColumnAccessStats> _column_access_stats;
+
     Tablet(const Tablet&) = delete;
     const Tablet& operator=(const Tablet&) = delete;
 };
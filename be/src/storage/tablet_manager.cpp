@@ -36,10 +36,14 @@ DIAGNOSTIC_POP
 #include "env/env.h"
 #include "runtime/current_thread.h"
 #include "storage/data_dir.h"
+#include "storage/fs/fs_util.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/segment.h"
+#include "storage/rowset/segment_footer_cache.h"
 #include "storage/snapshot_manager.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
@@ -125,6 +129,7 @@ Status TabletManager::_update_tablet_map_and_partition_info(const TabletSharedPt
     if (!inserted) {
         return Status::InternalError(fmt::format("tablet {} already exist in map", tablet->tablet_id()));
     }
+    _update_tablet_map_for_read_unlocked(tablet->tablet_id(), tablet);
     _add_tablet_to_partition(*tablet);
     return Status::OK();
 }
@@ -429,6 +434,7 @@ Status TabletManager::drop_tablets_on_error_root_path(const std::vector<TabletIn
                 TabletMap& tablet_map = _get_tablet_map(tablet_id);
                 _remove_tablet_from_partition(*dropped_tablet);
                 tablet_map.erase(tablet_id);
+                _update_tablet_map_for_read_unlocked(tablet_id, nullptr);
             }
         }
     }
@@ -436,8 +442,13 @@ Status TabletManager::drop_tablets_on_error_root_path(const std::vector<TabletIn
 }
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, bool include_deleted, std::string* err) {
-    std::shared_lock rlock(_get_tablets_shard_lock(tablet_id));
-    return _get_tablet_unlocked(tablet_id, include_deleted, err);
+    TabletSharedPtr tablet = _get_tablet_for_read(tablet_id);
+    if (tablet == nullptr && include_deleted) {
+        // a dropped tablet is moved to the shutdown tablets with the lock of the shard held
+        std::shared_lock rlock(_get_tablets_shard_lock(tablet_id));
+        return _get_tablet_unlocked(tablet_id, include_deleted, err);
+    }
+    return _check_tablet_usable(tablet_id, std::move(tablet), err);
 }
 
 TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, bool include_deleted, std::string* err) {
@@ -448,7 +459,10 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, bool in
             tablet = it->second.tablet;
         }
     }
+    return _check_tablet_usable(tablet_id, std::move(tablet), err);
+}
 
+TabletSharedPtr TabletManager::_check_tablet_usable(TTabletId tablet_id, TabletSharedPtr tablet, std::string* err) {
     if (tablet == nullptr) {
         if (err != nullptr) {
             *err = "tablet does not exist";
@@ -469,8 +483,7 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, bool in
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, const TabletUid& tablet_uid, bool include_deleted,
                                           std::string* err) {
-    std::shared_lock rlock(_get_tablets_shard_lock(tablet_id));
-    TabletSharedPtr tablet = _get_tablet_unlocked(tablet_id, include_deleted, err);
+    TabletSharedPtr tablet = get_tablet(tablet_id, include_deleted, err);
     if (tablet != nullptr && tablet->tablet_uid() == tablet_uid) {
         return tablet;
     }
@@ -802,31 +815,97 @@ Status TabletManager::report_all_tablets_info(std::map<TTabletId, TTablet>* tabl
 
     StarRocksMetrics::instance()->report_all_tablets_requests_total.increment(1);
 
+    // the lock of a shard is held only to copy the tablets of it, the report infos are built without it
+    std::vector<TabletSharedPtr> tablets;
     for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rlock(tablets_shard.lock);
-        for (const auto& [tablet_id, tablet_ptr] : tablets_shard.tablet_map) {
-            TTablet t_tablet;
-            TTabletInfo tablet_info;
+        tablets.clear();
+        {
+            std::shared_lock rlock(tablets_shard.lock);
+            tablets.reserve(tablets_shard.tablet_map.size());
+            for (const auto& [tablet_id, tablet_ptr] : tablets_shard.tablet_map) {
+                tablets.push_back(tablet_ptr);
+            }
+        }
+        for (const auto& tablet_ptr : tablets) {
+            TTablet& t_tablet = (*tablets_info)[tablet_ptr->tablet_id()];
+            TTabletInfo& tablet_info = t_tablet.tablet_infos.emplace_back();
             tablet_ptr->build_tablet_report_info(&tablet_info);
 
             // find expired transaction corresponding to this tablet
-            TabletInfo tinfo(tablet_id, tablet_ptr->schema_hash(), tablet_ptr->tablet_uid());
+            TabletInfo tinfo(tablet_ptr->tablet_id(), tablet_ptr->schema_hash(), tablet_ptr->tablet_uid());
             auto find = expire_txn_map.find(tinfo);
             if (find != expire_txn_map.end()) {
                 tablet_info.__set_transaction_ids(find->second);
                 expire_txn_map.erase(find);
             }
-            t_tablet.tablet_infos.push_back(tablet_info);
-
-            if (!t_tablet.tablet_infos.empty()) {
-                tablets_info->emplace(tablet_id, t_tablet);
-            }
         }
     }
     LOG(INFO) << "Reported all " << tablets_info->size() << " tablets info";
     return Status::OK();
 }
 
+void TabletManager::preload_segment_footers(size_t max_tablets, const std::atomic<bool>& stopped) {
+    SegmentFooterCache* footer_cache = SegmentFooterCache::instance();
+    if (footer_cache == nullptr || max_tablets == 0) {
+        return;
+    }
+    std::vector<TabletSharedPtr> all_tablets;
+    for (auto& tablets_shard : _tablets_shards) {
+        std::shared_lock rlock(tablets_shard.lock);
+        for (auto& [tablet_id, tablet] : tablets_shard.tablet_map) {
+            all_tablets.push_back(tablet);
+        }
+    }
+
+    // the tablets written last are most likely to be queried
+    std::vector<std::pair<int64_t, std::vector<RowsetSharedPtr>>> tablet_rowsets;
+    for (const auto& tablet : all_tablets) {
+        std::vector<RowsetSharedPtr> rowsets;
+        if (tablet->updates() != nullptr) {
+            if (!tablet->updates()->get_applied_rowsets(tablet->updates()->max_version(), &rowsets).ok()) {
+                continue;
+            }
+        } else {
+            std::shared_lock rdlock(tablet->get_header_lock());
+            if (!tablet->capture_consistent_rowsets(Version(0, tablet->max_version().second), &rowsets).ok()) {
+                continue;
+            }
+        }
+        int64_t newest = 0;
+        for (const auto& rowset : rowsets) {
+            newest = std::max(newest, rowset->creation_time());
+        }
+        tablet_rowsets.emplace_back(newest, std::move(rowsets));
+    }
+    all_tablets.clear();
+    std::sort(tablet_rowsets.begin(), tablet_rowsets.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    tablet_rowsets.resize(std::min(tablet_rowsets.size(), max_tablets));
+
+    fs::BlockManager* block_mgr = fs::fs_util::block_manager();
+    size_t num_segments = 0;
+    for (const auto& [creation_time, rowsets] : tablet_rowsets) {
+        for (const auto& rowset : rowsets) {
+            for (int seg_id = 0; seg_id < rowset->num_segments(); ++seg_id) {
+                if (stopped.load(std::memory_order_consume) ||
+                    footer_cache->memory_usage() >= footer_cache->capacity()) {
+                    LOG(INFO) << "Preloaded the footers of " << num_segments << " segments";
+                    return;
+                }
+                if (rowset->rowset_meta()->partial_rowset_footer(seg_id) != nullptr) {
+                    continue;
+                }
+                std::string seg_path =
+                        BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), seg_id);
+                Status st = Segment::cache_footer(block_mgr, seg_path);
+                LOG_IF(WARNING, !st.ok()) << "Fail to preload the footer of " << seg_path << ": " << st;
+                num_segments += st.ok();
+            }
+        }
+    }
+    LOG(INFO) << "Preloaded the footers of " << num_segments << " segments";
+}
+
 Status TabletManager::start_trash_sweep() {
     {
         // we use this vector to save all tablet ptr for saving lock time.
@@ -1167,6 +1246,7 @@ Status TabletManager::_drop_tablet_directly_unlocked(TTabletId tablet_id, Tablet
     }
     TabletSharedPtr dropped_tablet = it->second;
     tablet_map.erase(it);
+    _update_tablet_map_for_read_unlocked(tablet_id, nullptr);
     _remove_tablet_from_partition(*dropped_tablet);
 
     DroppedTabletInfo drop_info{.tablet = dropped_tablet, .flag = flag};
@@ -1215,6 +1295,29 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id) {
     return it != tablet_map.end() ? it->second : nullptr;
 }
 
+TabletSharedPtr TabletManager::_get_tablet_for_read(TTabletId tablet_id) {
+    butil::DoublyBufferedData<TabletMap>::ScopedPtr tablet_map;
+    if (_get_tablets_shard(tablet_id).tablet_map_for_read.Read(&tablet_map) != 0) {
+        // fails only if the thread-local data of the reader can't be created
+        std::shared_lock rlock(_get_tablets_shard_lock(tablet_id));
+        return _get_tablet_unlocked(tablet_id);
+    }
+    auto it = tablet_map->find(tablet_id);
+    return it != tablet_map->end() ? it->second : nullptr;
+}
+
+void TabletManager::_update_tablet_map_for_read_unlocked(TTabletId tablet_id, const TabletSharedPtr& tablet) {
+    auto update = [tablet_id, &tablet](TabletMap& tablet_map) -> size_t {
+        if (tablet != nullptr) {
+            tablet_map[tablet_id] = tablet;
+        } else {
+            tablet_map.erase(tablet_id);
+        }
+        return 1;
+    };
+    _get_tablets_shard(tablet_id).tablet_map_for_read.Modify(update);
+}
+
 void TabletManager::_add_tablet_to_partition(const Tablet& tablet) {
     std::unique_lock wlock(_partition_tablet_map_lock);
     _partition_tablet_map[tablet.partition_id()].insert(tablet.get_tablet_info());
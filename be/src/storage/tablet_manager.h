@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <butil/containers/doubly_buffered_data.h>
+
+#include <atomic>
 #include <list>
 #include <map>
 #include <mutex>
@@ -123,6 +126,16 @@ public:
     Status report_all_tablets_info(std::map<TTabletId, TTablet>* tablets_info);
 
     Status start_trash_sweep();
+
+    size_t num_shards() const { return _tablets_shards.size(); }
+
+    // The index of the shard of |tablet_id| in [0, num_shards()), the tablets of a shard share a lock.
+    size_t shard_index(TTabletId tablet_id) const { return tablet_id & _tablets_shards_mask; }
+
+    // Read the segment footers of the |max_tablets| tablets with the newest rowsets into SegmentFooterCache,
+    // until the cache is full or |stopped| is set.
+    void preload_segment_footers(size_t max_tablets, const std::atomic<bool>& stopped);
+
     // Prevent schema change executed concurrently.
     bool try_schema_change_lock(TTabletId tablet_id);
 
@@ -152,6 +165,9 @@ private:
     struct TabletsShard {
         mutable std::shared_mutex lock;
         TabletMap tablet_map;
+        // A copy of |tablet_map| for the lookups of get_tablet(), read without |lock|: a reader only takes a
+        // mutex of its own thread, and a writer holding |lock| updates both |tablet_map| and it.
+        butil::DoublyBufferedData<TabletMap> tablet_map_for_read;
         TabletSet tablets_under_clone;
     };
 
@@ -192,6 +208,13 @@ private:
 
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id);
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id, bool include_deleted, std::string* err);
+    // Look up |tablet_id| in the copy of the tablet map of its shard, without the lock of the shard.
+    TabletSharedPtr _get_tablet_for_read(TTabletId tablet_id);
+    // Returns |tablet| if it's not null and can be used, otherwise sets |err| and returns nullptr.
+    TabletSharedPtr _check_tablet_usable(TTabletId tablet_id, TabletSharedPtr tablet, std::string* err);
+    // Put |tablet| into the copy of the tablet map of its shard, or erase |tablet_id| from it if |tablet| is
+    // nullptr, with the lock of the shard held.
+    void _update_tablet_map_for_read_unlocked(TTabletId tablet_id, const TabletSharedPtr& tablet);
 
     TabletSharedPtr _internal_create_tablet_unlocked(AlterTabletType alter_type, const TCreateTabletReq& request,
                                                      bool is_schema_change, const Tablet* base_tablet,
@@ -21,6 +21,7 @@
 
 #include "storage/tablet_meta.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <memory>
 #include <sstream>
@@ -42,6 +43,9 @@ enum class FieldTypeVersion {
     kV2, // beta rowset with config::storage_format_version == 2
 };
 
+// the n-gram length of an NGRAMBF index without the "gram_num" property
+static constexpr int kDefaultNgramBfGramNum = 3;
+
 // Old version StarRocks use `TColumnType` to save type info, convert it into `TTypeDesc`.
 static void convert_to_new_version(TColumn* tcolumn) {
     if (!tcolumn->__isset.type_desc) {
@@ -314,7 +318,20 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
                     DCHECK_EQ(index.columns.size(), 1);
                     if (boost::iequals(tcolumn.column_name, index.columns[0])) {
                         column->set_has_bitmap_index(true);
-                        break;
+                    }
+                } else if (index.index_type == TIndexType::type::INVERTED) {
+                    DCHECK_EQ(index.columns.size(), 1);
+                    if (boost::iequals(tcolumn.column_name, index.columns[0])) {
+                        column->set_has_inverted_index(true);
+                    }
+                } else if (index.index_type == TIndexType::type::NGRAMBF) {
+                    DCHECK_EQ(index.columns.size(), 1);
+                    if (boost::iequals(tcolumn.column_name, index.columns[0])) {
+                        column->set_ngram_bf_gram_num(kDefaultNgramBfGramNum);
+                        auto it = index.properties.find("gram_num");
+                        if (it != index.properties.end()) {
+                            column->set_ngram_bf_gram_num(std::clamp(std::atoi(it->second.c_str()), 1, 255));
+                        }
                     }
                 }
             }
@@ -763,11 +763,9 @@ Status TabletMetaManager::rowset_iterate(DataDir* store, TTabletId tablet_id, co
                                       });
 }
 
-Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid,
-                                              const EditVersion& version,
-                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs) {
-    WriteBatch batch;
-    auto handle = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+static Status put_apply_rowset_commit(WriteBatch* batch, rocksdb::ColumnFamilyHandle* handle, TTabletId tablet_id,
+                                      int64_t logid, const EditVersion& version,
+                                      const vector<std::pair<uint32_t, DelVectorPtr>>& delvecs) {
     string logkey = encode_meta_log_key(tablet_id, logid);
     TabletMetaLogPB log;
     auto ops = log.add_ops();
@@ -775,8 +773,13 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
     auto version_pb = ops->mutable_apply();
     version_pb->set_major(version.major());
     version_pb->set_minor(version.minor());
+    for (auto& rssid_delvec : delvecs) {
+        auto num_dels_pb = ops->add_segment_num_dels();
+        num_dels_pb->set_segment_id(rssid_delvec.first);
+        num_dels_pb->set_num_dels(rssid_delvec.second->cardinality());
+    }
     auto logval = log.SerializeAsString();
-    rocksdb::Status st = batch.Put(handle, logkey, logval);
+    rocksdb::Status st = batch->Put(handle, logkey, logval);
     if (!st.ok()) {
         LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
         return to_status(st);
@@ -786,13 +789,34 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
     for (auto& rssid_delvec : delvecs) {
         tsid.segment_id = rssid_delvec.first;
         auto dv_key = encode_del_vector_key(tsid.tablet_id, tsid.segment_id, version.major());
-        auto dv_value = rssid_delvec.second->save();
-        st = batch.Put(handle, dv_key, dv_value);
+        auto dv_value = rssid_delvec.second->save_delta_or_full();
+        st = batch->Put(handle, dv_key, dv_value);
         if (!st.ok()) {
             LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
             return to_status(st);
         }
     }
+    return Status::OK();
+}
+
+Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid,
+                                              const EditVersion& version,
+                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs) {
+    WriteBatch batch;
+    auto handle = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+    RETURN_IF_ERROR(put_apply_rowset_commit(&batch, handle, tablet_id, logid, version, delvecs));
+    return store->get_meta()->write_batch(&batch);
+}
+
+Status TabletMetaManager::apply_rowset_commits(
+        DataDir* store, TTabletId tablet_id, int64_t logid, const vector<EditVersion>& versions,
+        const vector<vector<std::pair<uint32_t, DelVectorPtr>>>& delvecs) {
+    DCHECK_EQ(versions.size(), delvecs.size());
+    WriteBatch batch;
+    auto handle = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+    for (size_t i = 0; i < versions.size(); i++) {
+        RETURN_IF_ERROR(put_apply_rowset_commit(&batch, handle, tablet_id, logid + i, versions[i], delvecs[i]));
+    }
     return store->get_meta()->write_batch(&batch);
 }
 
@@ -847,14 +871,32 @@ Status TabletMetaManager::get_del_vector(KVStore* meta, TTabletId tablet_id, uin
             *latest_version = cv;
             first = false;
         }
-        if (version >= cv) {
-            st = delvec->load(cv, value.data(), value.size());
-            found = true;
-            return false;
+        if (!found) {
+            if (version >= cv) {
+                st = delvec->load(cv, value.data(), value.size());
+                found = true;
+                // a delta needs the earlier versions until one saved in whole
+                return st.ok() && delvec->base_version() >= 0;
+            }
+            return true;
         }
-        return true;
+        // the versions between a delta and its base are never saved
+        DelVector base;
+        st = base.load(cv, value.data(), value.size());
+        if (st.ok()) {
+            st = delvec->merge_base(base);
+        }
+        return st.ok() && delvec->base_version() >= 0;
     };
-    st = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper, traverse_versions);
+    auto iter_st = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper, traverse_versions);
+    if (iter_st.ok() && !st.ok()) {
+        iter_st = st;
+    }
+    if (iter_st.ok() && found && delvec->base_version() >= 0) {
+        iter_st = Status::Corruption(strings::Substitute("delete vector base not found tablet:$0 segment:$1 version:$2",
+                                                         tablet_id, segment_id, delvec->base_version()));
+    }
+    st = iter_st;
     if (!st.ok()) {
         LOG(WARNING) << "fail to iterate rocksdb delvecs. tablet_id=" << tablet_id << " segment_id=" << segment_id
                      << " error_code=" << st.to_string();
@@ -895,6 +937,24 @@ StatusOr<DeleteVectorList> TabletMetaManager::list_del_vector(KVStore* meta, TTa
     return std::move(ret);
 }
 
+Status TabletMetaManager::consolidate_del_vector(KVStore* meta, TTabletId tablet_id, uint32_t segment_id,
+                                                 int64_t version) {
+    std::string value;
+    auto st = meta->get(META_COLUMN_FAMILY_INDEX, encode_del_vector_key(tablet_id, segment_id, version), &value);
+    if (st.is_not_found()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(st);
+    if (!DelVector::is_delta(value.data(), value.size())) {
+        return Status::OK();
+    }
+    DelVector delvec;
+    int64_t latest_version = 0;
+    RETURN_IF_ERROR(get_del_vector(meta, tablet_id, segment_id, version, &delvec, &latest_version));
+    DCHECK_EQ(version, delvec.version());
+    return set_del_vector(meta, tablet_id, segment_id, delvec);
+}
+
 Status TabletMetaManager::delete_del_vector_range(KVStore* meta, TTabletId tablet_id, uint32_t segment_id,
                                                   int64_t start_version, int64_t end_version) {
     if (start_version == end_version) {
@@ -141,6 +141,11 @@ public:
     static Status apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid, const EditVersion& version,
                                       std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs);
 
+    // like apply_rowset_commit, but for many consecutive versions with logids from |logid| in one batch
+    static Status apply_rowset_commits(DataDir* store, TTabletId tablet_id, int64_t logid,
+                                       const std::vector<EditVersion>& versions,
+                                       const std::vector<std::vector<std::pair<uint32_t, DelVectorPtr>>>& delvecs);
+
     // traverse all the op logs for a tablet
     static Status traverse_meta_logs(DataDir* store, TTabletId tablet_id,
                                      const std::function<bool(uint64_t, const TabletMetaLogPB&)>& func);
@@ -157,6 +162,10 @@ public:
 
     static StatusOr<DeleteVectorList> list_del_vector(KVStore* meta, TTabletId tablet_id, int64_t max_version);
 
+    // Saves the version |version| of the delete vector in whole if it's saved as a delta, so the
+    // earlier versions it's based on can be deleted.
+    static Status consolidate_del_vector(KVStore* meta, TTabletId tablet_id, uint32_t segment_id, int64_t version);
+
     static Status delete_del_vector_range(KVStore* meta, TTabletId tablet_id, uint32_t segment_id,
                                           int64_t start_version, int64_t end_version);
 
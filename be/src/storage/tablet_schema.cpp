@@ -262,6 +262,7 @@ TabletColumn::TabletColumn(const TabletColumn& rhs)
           _index_length(rhs._index_length),
           _precision(rhs._precision),
           _scale(rhs._scale),
+          _ngram_bf_gram_num(rhs._ngram_bf_gram_num),
           _flags(rhs._flags) {
     if (rhs._extra_fields != nullptr) {
         _extra_fields = new ExtraFields(*rhs._extra_fields);
@@ -277,6 +278,7 @@ TabletColumn::TabletColumn(TabletColumn&& rhs)
           _index_length(rhs._index_length),
           _precision(rhs._precision),
           _scale(rhs._scale),
+          _ngram_bf_gram_num(rhs._ngram_bf_gram_num),
           _flags(rhs._flags),
           _extra_fields(rhs._extra_fields) {
     rhs._extra_fields = nullptr;
@@ -296,6 +298,7 @@ void TabletColumn::swap(TabletColumn* rhs) {
     swap(_index_length, rhs->_index_length);
     swap(_precision, rhs->_precision);
     swap(_scale, rhs->_scale);
+    swap(_ngram_bf_gram_num, rhs->_ngram_bf_gram_num);
     swap(_flags, rhs->_flags);
     swap(_extra_fields, rhs->_extra_fields);
 }
@@ -321,10 +324,13 @@ void TabletColumn::init_from_pb(const ColumnPB& column) {
     _set_flag(kIsNullableShift, column.is_nullable());
     _set_flag(kIsBfColumnShift, column.is_bf_column());
     _set_flag(kHasBitmapIndexShift, column.has_bitmap_index());
+    _set_flag(kHasInvertedIndexShift, column.has_inverted_index());
     _set_flag(kHasPrecisionShift, column.has_precision());
     _set_flag(kHasScaleShift, column.has_frac());
 
     _length = column.length();
+    DCHECK_LE(column.ngram_bf_gram_num(), UINT8_MAX);
+    _ngram_bf_gram_num = column.ngram_bf_gram_num();
 
     if (column.has_precision()) {
         DCHECK_LE(column.precision(), UINT8_MAX);
@@ -374,6 +380,8 @@ void TabletColumn::to_schema_pb(ColumnPB* column) const {
     column->set_is_bf_column(is_bf_column());
     column->set_aggregation(get_string_by_aggregation_type(_aggregation));
     column->set_has_bitmap_index(has_bitmap_index());
+    column->set_has_inverted_index(has_inverted_index());
+    column->set_ngram_bf_gram_num(_ngram_bf_gram_num);
     for (int i = 0; i < subcolumn_count(); i++) {
         subcolumn(i).to_schema_pb(column->add_children_columns());
     }
@@ -597,7 +605,8 @@ std::string TabletColumn::debug_string() const {
        << ",precision=" << (has_precision() ? std::to_string(_precision) : "N/A")
        << ",frac=" << (has_scale() ? std::to_string(_scale) : "N/A") << ",length=" << _length
        << ",index_length=" << _index_length << ",is_bf_column=" << is_bf_column()
-       << ",has_bitmap_index=" << has_bitmap_index() << ")";
+       << ",has_bitmap_index=" << has_bitmap_index() << ",has_inverted_index=" << has_inverted_index()
+       << ",ngram_bf_gram_num=" << static_cast<int>(_ngram_bf_gram_num) << ")";
     return ss.str();
 }
 
@@ -96,6 +96,13 @@ public:
     bool has_bitmap_index() const { return _check_flag(kHasBitmapIndexShift); }
     void set_has_bitmap_index(bool value) { _set_flag(kHasBitmapIndexShift, value); }
 
+    bool has_inverted_index() const { return _check_flag(kHasInvertedIndexShift); }
+    void set_has_inverted_index(bool value) { _set_flag(kHasInvertedIndexShift, value); }
+
+    // 0 if the column has no n-gram bloom filter index.
+    uint8_t ngram_bf_gram_num() const { return _ngram_bf_gram_num; }
+    void set_ngram_bf_gram_num(uint8_t gram_num) { _ngram_bf_gram_num = gram_num; }
+
     ColumnLength length() const { return _length; }
     void set_length(ColumnLength length) { _length = length; }
 
@@ -161,6 +168,7 @@ private:
     constexpr static uint8_t kHasBitmapIndexShift = 3;
     constexpr static uint8_t kHasPrecisionShift = 4;
     constexpr static uint8_t kHasScaleShift = 5;
+    constexpr static uint8_t kHasInvertedIndexShift = 6;
 
     ExtraFields* _get_or_alloc_extra_fields() {
         if (_extra_fields == nullptr) {
@@ -194,6 +202,7 @@ private:
     ColumnIndexLength _index_length = 0;
     ColumnPrecision _precision = 0;
     ColumnScale _scale = 0;
+    uint8_t _ngram_bf_gram_num = 0;
 
     uint8_t _flags = 0;
 
@@ -115,6 +115,10 @@ Status TabletUpdates::_load_from_pb(const TabletUpdatesPB& tablet_updates_pb) {
 
     _next_rowset_id = tablet_updates_pb.next_rowset_id();
     _next_log_id = tablet_updates_pb.next_log_id();
+    _applied_segment_num_dels.clear();
+    for (const auto& num_dels_pb : tablet_updates_pb.applied_segment_num_dels()) {
+        _applied_segment_num_dels[num_dels_pb.segment_id()] = num_dels_pb.num_dels();
+    }
     auto apply_log_func = [&](uint64_t logid, const TabletMetaLogPB& tablet_meta_log_pb) -> bool {
         CHECK(!tablet_meta_log_pb.ops().empty());
         for (auto& tablet_meta_op_pb : tablet_meta_log_pb.ops()) {
@@ -126,6 +130,13 @@ Status TabletUpdates::_load_from_pb(const TabletUpdatesPB& tablet_updates_pb) {
             case OP_APPLY:
                 _sync_apply_version_idx(
                         EditVersion(tablet_meta_op_pb.apply().major(), tablet_meta_op_pb.apply().minor()));
+                if (tablet_meta_op_pb.segment_num_dels().empty()) {
+                    // written by an old version, the delete vectors it wrote are unknown
+                    _applied_segment_num_dels.clear();
+                }
+                for (const auto& num_dels_pb : tablet_meta_op_pb.segment_num_dels()) {
+                    _applied_segment_num_dels[num_dels_pb.segment_id()] = num_dels_pb.num_dels();
+                }
                 break;
             default:
                 LOG(FATAL) << "unsupported TabletMetaLogPB type: " << TabletMetaOpType_Name(tablet_meta_op_pb.type());
@@ -217,8 +228,9 @@ Status TabletUpdates::_load_from_pb(const TabletUpdatesPB& tablet_updates_pb) {
         return Status::OK();
     }
 
-    // Load delete vectors and update RowsetStats.
-    // TODO: save num_dels in rowset meta.
+    // Update RowsetStats, the delete vectors are read only for the segments without a checkpointed num_dels.
+    size_t num_delvecs_read = 0;
+    std::unordered_map<uint32_t, uint64_t> segment_num_dels;
     for (auto& [rsid, rowset] : _rowsets) {
         auto stats = std::make_unique<RowsetStats>();
         stats->num_segments = rowset->num_segments();
@@ -228,6 +240,12 @@ Status TabletUpdates::_load_from_pb(const TabletUpdatesPB& tablet_updates_pb) {
         if (unapplied_rowsets.find(rsid) == unapplied_rowsets.end()) {
             // rowset applied, must have delvec
             for (int i = 0; i < rowset->num_segments(); i++) {
+                auto iter = _applied_segment_num_dels.find(rsid + i);
+                if (iter != _applied_segment_num_dels.end()) {
+                    stats->num_dels += iter->second;
+                    segment_num_dels.emplace(iter->first, iter->second);
+                    continue;
+                }
                 DelVector delvec;
                 int64_t dummy;
                 auto st = TabletMetaManager::get_del_vector(_tablet.data_dir()->get_meta(), _tablet.tablet_id(),
@@ -238,7 +256,9 @@ Status TabletUpdates::_load_from_pb(const TabletUpdatesPB& tablet_updates_pb) {
                     LOG(ERROR) << msg;
                     return Status::OK();
                 }
+                num_delvecs_read++;
                 stats->num_dels += delvec.cardinality();
+                segment_num_dels.emplace(rsid + i, delvec.cardinality());
             }
             DCHECK_LE(stats->num_dels, stats->num_rows) << " tabletid:" << _tablet.tablet_id() << " rowset:" << rsid;
         }
@@ -247,8 +267,10 @@ Status TabletUpdates::_load_from_pb(const TabletUpdatesPB& tablet_updates_pb) {
         _rowset_stats.emplace(rsid, std::move(stats));
     }
     l2.unlock(); // _rowsets_lock
+    // the segments of the unused rowsets are dropped
+    _applied_segment_num_dels.swap(segment_num_dels);
     _update_total_stats(_edit_version_infos[_apply_version_idx]->rowsets);
-    VLOG(1) << "load tablet " << _debug_string(false, true);
+    VLOG(1) << "load tablet " << _debug_string(false, true) << " #delvec read:" << num_delvecs_read;
     _try_commit_pendings_unlocked();
     _check_for_apply();
 
@@ -640,11 +662,13 @@ void TabletUpdates::_check_for_apply() {
 void TabletUpdates::do_apply() {
     // only 1 thread at max is running this method
     bool first = true;
+    // consecutive rowset commits are applied one by one, but their meta is written in one batch
+    PendingApplies pending;
     while (!_apply_stopped) {
         const EditVersionInfo* version_info_apply = nullptr;
         {
             std::lock_guard rl(_lock);
-            if (_apply_version_idx + 1 >= _edit_version_infos.size()) {
+            if (_apply_version_idx + pending.size() + 1 >= _edit_version_infos.size()) {
                 if (first) {
                     LOG(WARNING) << "illegal state: do_apply should not be called when there is "
                                     "nothing to apply: "
@@ -653,17 +677,25 @@ void TabletUpdates::do_apply() {
                 break;
             }
             // we make sure version_info_apply will never be deleted before apply finished
-            version_info_apply = _edit_version_infos[_apply_version_idx + 1].get();
+            version_info_apply = _edit_version_infos[_apply_version_idx + pending.size() + 1].get();
         }
         if (version_info_apply->deltas.size() > 0) {
             int64_t duration_ns = 0;
             {
                 StarRocksMetrics::instance()->update_rowset_commit_apply_total.increment(1);
                 SCOPED_RAW_TIMER(&duration_ns);
-                _apply_rowset_commit(*version_info_apply);
+                _apply_rowset_commit(*version_info_apply, &pending);
+                if (pending.size() >= std::max(1, config::update_apply_batch_max_versions)) {
+                    _write_pending_applies(&pending);
+                }
             }
             StarRocksMetrics::instance()->update_rowset_commit_apply_duration_us.increment(duration_ns / 1000);
         } else if (version_info_apply->compaction) {
+            // compaction reads the applied versions
+            _write_pending_applies(&pending);
+            if (_error) {
+                break;
+            }
             // _compaction_running may be false after BE restart, reset it to true
             _compaction_running = true;
             _apply_compaction_commit(*version_info_apply);
@@ -678,6 +710,7 @@ void TabletUpdates::do_apply() {
             break;
         }
     }
+    _write_pending_applies(&pending);
     std::lock_guard<std::mutex> lg(_apply_running_lock);
     CHECK(_apply_running) << "illegal state: _apply_running should be true";
     _apply_running = false;
@@ -697,7 +730,7 @@ void TabletUpdates::_get_latest_applied_version(EditVersion* latest_applied_vers
     *latest_applied_version = _edit_version_infos[_apply_version_idx]->version;
 }
 
-void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
+void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info, PendingApplies* pending) {
     // NOTE: after commit, apply must success or fatal crash
     int64_t t_start = MonotonicMillis();
     auto tablet_id = _tablet.tablet_id();
@@ -707,6 +740,13 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
             << " rowset:" << rowset_id;
     RowsetSharedPtr rowset = _get_rowset(rowset_id);
     auto manager = StorageEngine::instance()->update_manager();
+    if (!pending->empty() && rowset->rowset_meta()->get_meta_pb().has_txn_meta()) {
+        // partial update resolves its conflicts against the latest applied version
+        _write_pending_applies(pending);
+        if (_error) {
+            return;
+        }
+    }
 
     // 1. load upserts/deletes in rowset
     auto state_entry = manager->update_state_cache().get_or_create(
@@ -806,8 +846,13 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
             tsid.tablet_id = tablet_id;
             tsid.segment_id = rssid;
             DelVectorPtr old_del_vec;
-            // TODO(cbl): should get the version before this apply version, to be safe
-            st = manager->get_latest_del_vec(_tablet.data_dir()->get_meta(), tsid, &old_del_vec);
+            auto pending_itr = pending->latest_delvecs.find(rssid);
+            if (pending_itr != pending->latest_delvecs.end()) {
+                old_del_vec = pending_itr->second;
+            } else {
+                // TODO(cbl): should get the version before this apply version, to be safe
+                st = manager->get_latest_del_vec(_tablet.data_dir()->get_meta(), tsid, &old_del_vec);
+            }
             if (!st.ok()) {
                 std::string msg = Substitute("_apply_rowset_commit error: get_latest_del_vec failed: $0 $1",
                                              st.to_string(), debug_string());
@@ -863,10 +908,41 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     StarRocksMetrics::instance()->update_del_vector_deletes_new.increment(new_del);
     int64_t t_delvec = MonotonicMillis();
 
+    // 4. add to the pending applies, their meta is written later
+    for (auto& delvec_pair : new_del_vecs) {
+        pending->latest_delvecs[delvec_pair.first] = delvec_pair.second;
+    }
+    pending->version_infos.push_back(&version_info);
+    pending->delvecs.emplace_back(std::move(new_del_vecs));
+    int64_t t_write = MonotonicMillis();
+
+    LOG(INFO) << "apply_rowset_commit finish. tablet:" << tablet_id << " version:" << version_info.version.to_string()
+              << " #pending:" << pending->size() << " rowset:" << rowset_id << " #seg:" << rowset->num_segments()
+              << " #op(upsert:" << rowset->num_rows()
+              << " del:" << delete_op << ") #del:" << old_total_del << "+" << new_del << "=" << total_del
+              << " #dv:" << ndelvec << " duration:" << t_write - t_start << "ms"
+              << Substitute("($0/$1/$2/$3/$4)", t_load - t_start, t_apply - t_load, t_index - t_apply,
+                            t_delvec - t_index, t_write - t_delvec);
+    VLOG(1) << "rowset commit apply " << delvec_change_info << " " << _debug_string(true, true);
+}
+
+void TabletUpdates::_write_pending_applies(PendingApplies* pending) {
+    if (pending->empty() || _error) {
+        return;
+    }
+    int64_t t_start = MonotonicMillis();
+    auto tablet_id = _tablet.tablet_id();
+    auto manager = StorageEngine::instance()->update_manager();
+    std::vector<EditVersion> versions;
+    versions.reserve(pending->size());
+    for (auto version_info : pending->version_infos) {
+        versions.push_back(version_info->version);
+    }
     {
         std::lock_guard wl(_lock);
-        // 4. write meta
-        st = TabletMetaManager::apply_rowset_commit(_tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs);
+        // write meta
+        auto st = TabletMetaManager::apply_rowset_commits(_tablet.data_dir(), tablet_id, _next_log_id, versions,
+                                                          pending->delvecs);
         if (!st.ok()) {
             std::string msg = Substitute("_apply_rowset_commit error: write meta failed: $0 $1", st.to_string(),
                                          _debug_string(false));
@@ -874,30 +950,31 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
             _set_error(msg);
             return;
         }
-        // put delvec in cache
+        // put the latest delvecs in cache
         TabletSegmentId tsid;
         tsid.tablet_id = tablet_id;
-        for (auto& delvec_pair : new_del_vecs) {
+        for (auto& delvec_pair : pending->latest_delvecs) {
             tsid.segment_id = delvec_pair.first;
             manager->set_cached_del_vec(tsid, delvec_pair.second);
+            _applied_segment_num_dels[delvec_pair.first] = delvec_pair.second->cardinality();
         }
-        // 5. apply memory
-        _next_log_id++;
-        _apply_version_idx++;
+        // apply memory
+        _next_log_id += versions.size();
+        _apply_version_idx += versions.size();
+        DCHECK(_edit_version_infos[_apply_version_idx]->version == versions.back());
         _apply_version_changed.notify_all();
     }
-    _update_total_stats(version_info.rowsets);
+    _update_total_stats(pending->version_infos.back()->rowsets);
     int64_t t_write = MonotonicMillis();
 
     size_t del_percent = _cur_total_rows == 0 ? 0 : (_cur_total_dels * 100) / _cur_total_rows;
-    LOG(INFO) << "apply_rowset_commit finish. tablet:" << tablet_id << " version:" << version_info.version.to_string()
-              << " total del/row:" << _cur_total_dels << "/" << _cur_total_rows << " " << del_percent << "%"
-              << " rowset:" << rowset_id << " #seg:" << rowset->num_segments() << " #op(upsert:" << rowset->num_rows()
-              << " del:" << delete_op << ") #del:" << old_total_del << "+" << new_del << "=" << total_del
-              << " #dv:" << ndelvec << " duration:" << t_write - t_start << "ms"
-              << Substitute("($0/$1/$2/$3/$4)", t_load - t_start, t_apply - t_load, t_index - t_apply,
-                            t_delvec - t_index, t_write - t_delvec);
-    VLOG(1) << "rowset commit apply " << delvec_change_info << " " << _debug_string(true, true);
+    LOG(INFO) << "apply_rowset_commit write meta. tablet:" << tablet_id << " version:" << versions.front().to_string()
+              << "-" << versions.back().to_string() << " total del/row:" << _cur_total_dels << "/" << _cur_total_rows
+              << " " << del_percent << "%"
+              << " #version:" << versions.size() << " duration:" << t_write - t_start << "ms";
+    pending->version_infos.clear();
+    pending->delvecs.clear();
+    pending->latest_delvecs.clear();
 }
 
 RowsetSharedPtr TabletUpdates::_get_rowset(uint32_t rowset_id) {
@@ -980,8 +1057,8 @@ Status TabletUpdates::_do_compaction(std::unique_ptr<CompactionInfo>* pinfo, boo
                 return Status::InternalError(msg);
             } else {
                 input_rowsets[i] = itr->second;
-                input_rowsets_size = input_rowsets[i]->data_disk_size();
-                input_row_num = input_rowsets[i]->num_rows();
+                input_rowsets_size += input_rowsets[i]->data_disk_size();
+                input_row_num += input_rowsets[i]->num_rows();
             }
         }
     }
@@ -1027,6 +1104,8 @@ Status TabletUpdates::_do_compaction(std::unique_ptr<CompactionInfo>* pinfo, boo
     // 4. commit compaction
     EditVersion version;
     RETURN_IF_ERROR(_commit_compaction(pinfo, *output_rowset, &version));
+    StorageEngine::instance()->prewarm_rowset(std::static_pointer_cast<Tablet>(_tablet.shared_from_this()),
+                                              *output_rowset);
     if (wait_apply) {
         // already committed, so we can only ignore timeout error
         _wait_for_version(version, 120000);
@@ -1227,6 +1306,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
         for (auto& delvec_pair : delvecs) {
             tsid.segment_id = delvec_pair.first;
             manager->set_cached_del_vec(tsid, delvec_pair.second);
+            _applied_segment_num_dels[delvec_pair.first] = delvec_pair.second->cardinality();
         }
         // 5. apply memory
         _next_log_id++;
@@ -1334,10 +1414,14 @@ void TabletUpdates::remove_expired_versions(int64_t expire_time) {
                 }
             }
         }
+        std::vector<uint32_t> unused_segments;
         for (uint32_t id : unused_rid) {
             std::lock_guard l(_rowsets_lock);
             auto iter = _rowsets.find(id);
             DCHECK(iter != _rowsets.end());
+            for (uint32_t i = 0; i < iter->second->num_segments(); i++) {
+                unused_segments.push_back(id + i);
+            }
             (void)_unused_rowsets.blocking_put(std::move(iter->second));
             _rowsets.erase(iter);
         }
@@ -1345,6 +1429,12 @@ void TabletUpdates::remove_expired_versions(int64_t expire_time) {
             std::lock_guard l(_rowset_stats_lock);
             _rowset_stats.erase(id);
         }
+        {
+            std::lock_guard l(_lock);
+            for (uint32_t segment_id : unused_segments) {
+                _applied_segment_num_dels.erase(segment_id);
+            }
+        }
 
         /// Remove useless delete vectors.
         auto max_expired_version = expired_edit_version_infos.back()->version.major();
@@ -1356,6 +1446,13 @@ void TabletUpdates::remove_expired_versions(int64_t expire_time) {
             for (const auto& elem : *res) {
                 auto segment_id = elem.first;
                 auto end_version = elem.second;
+                // the version kept may be a delta of the versions to be removed
+                auto st = TabletMetaManager::consolidate_del_vector(meta_store, tablet_id, segment_id, end_version);
+                if (!st.ok()) {
+                    LOG(WARNING) << "Fail to consolidate delete vector tablet_id=" << tablet_id
+                                 << " segment_id=" << segment_id << " version=" << end_version << ": " << st;
+                    continue;
+                }
                 (void)TabletMetaManager::delete_del_vector_range(meta_store, tablet_id, segment_id, 0, end_version);
                 VLOG(1) << "Removed delete vector tablet_id=" << tablet_id << " segment_id=" << segment_id
                         << " start_version=0 end_version=" << end_version;
@@ -1423,8 +1520,23 @@ struct CompactionEntry {
     size_t num_rows = 0;
     size_t num_dels = 0;
     size_t bytes = 0;
+    // whether the ratio of deleted rows reaches update_compaction_del_ratio_threshold
+    bool mostly_deleted = false;
+
+    size_t live_rows() const { return num_rows - num_dels; }
+    size_t live_bytes() const { return bytes * live_rows() / num_rows; }
 
-    bool operator<(const CompactionEntry& rhs) const { return score_per_row > rhs.score_per_row; }
+    // the mostly deleted rowsets go first, in the descending order of their ratio of deleted rows,
+    // the others follow in the ascending order of their live bytes.
+    bool operator<(const CompactionEntry& rhs) const {
+        if (mostly_deleted != rhs.mostly_deleted) {
+            return mostly_deleted;
+        }
+        if (mostly_deleted) {
+            return (double)num_dels / num_rows > (double)rhs.num_dels / rhs.num_rows;
+        }
+        return live_bytes() < rhs.live_bytes();
+    }
 };
 
 static string int_list_to_string(const vector<uint32_t>& l) {
@@ -1439,7 +1551,6 @@ static string int_list_to_string(const vector<uint32_t>& l) {
 }
 
 static const size_t compaction_result_bytes_threashold = 1000000000;
-static const size_t compaction_result_rows_threashold = 10000000;
 
 Status TabletUpdates::compaction(MemTracker* mem_tracker) {
     if (_error) {
@@ -1492,25 +1603,35 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
                 e.num_rows = stat.num_rows;
                 e.num_dels = stat.num_dels;
                 e.bytes = stat.byte_size;
+                e.mostly_deleted =
+                        (double)stat.num_dels >= stat.num_rows * config::update_compaction_del_ratio_threshold;
             }
         }
     }
     std::sort(candidates.begin(), candidates.end());
+    const size_t max_rows = std::max<int64_t>(config::update_compaction_max_rows_per_round, 1);
+    const size_t tier_ratio = std::max(config::update_compaction_size_tier_ratio, 1);
     for (auto& e : candidates) {
-        size_t new_rows = total_rows_after_compaction + e.num_rows - e.num_dels;
-        size_t new_bytes = total_bytes_after_compaction + e.bytes * (e.num_rows - e.num_dels) / e.num_rows;
-        if (info->inputs.size() > 0 && (new_rows > compaction_result_rows_threashold * 3 / 2 ||
-                                        new_bytes > compaction_result_bytes_threashold * 3 / 2)) {
+        size_t new_rows = total_rows_after_compaction + e.live_rows();
+        size_t new_bytes = total_bytes_after_compaction + e.live_bytes();
+        if (info->inputs.size() > 0 &&
+            (new_rows > max_rows || new_bytes > compaction_result_bytes_threashold * 3 / 2)) {
+            break;
+        }
+        // merging a rowset much larger than the picked ones rewrites it for little gain, the rowsets smaller
+        // than a seek are always worth merging. Mostly deleted rowsets shrink when rewritten, so they are
+        // picked whatever their size.
+        if (!e.mostly_deleted && info->inputs.size() > 0 &&
+            e.live_bytes() > tier_ratio * std::max<size_t>(total_bytes_after_compaction, _compaction_cost_seek)) {
             break;
         }
         info->inputs.push_back(e.rowsetid);
-        total_score += e.score_per_row * (e.num_rows - e.num_dels);
+        total_score += e.score_per_row * e.live_rows();
         total_rows += e.num_rows;
         total_bytes += e.bytes;
         total_rows_after_compaction = new_rows;
         total_bytes_after_compaction = new_bytes;
-        if (total_bytes_after_compaction > compaction_result_bytes_threashold ||
-            total_rows_after_compaction > compaction_result_rows_threashold) {
+        if (total_bytes_after_compaction > compaction_result_bytes_threashold) {
             break;
         }
     }
@@ -1917,6 +2038,7 @@ Status TabletUpdates::link_from(Tablet* base_tablet, int64_t request_version) {
     apply_version_pb->set_minor(version.minor());
     updates_pb->set_next_log_id(1);
     updates_pb->set_next_rowset_id(next_rowset_id);
+    updates_pb->clear_applied_segment_num_dels();
 
     // 3. delete old meta & write new meta
     auto data_dir = _tablet.data_dir();
@@ -2069,6 +2191,7 @@ Status TabletUpdates::convert_from(const std::shared_ptr<Tablet>& base_tablet, i
     apply_version_pb->set_minor(version.minor());
     updates_pb->set_next_log_id(1);
     updates_pb->set_next_rowset_id(next_rowset_id);
+    updates_pb->clear_applied_segment_num_dels();
 
     // delete old meta & write new meta
     auto data_dir = _tablet.data_dir();
@@ -2211,6 +2334,11 @@ void TabletUpdates::_to_updates_pb_unlocked(TabletUpdatesPB* updates_pb) const {
     }
     updates_pb->set_next_rowset_id(_next_rowset_id);
     updates_pb->set_next_log_id(_next_log_id);
+    for (const auto& [segment_id, num_dels] : _applied_segment_num_dels) {
+        auto num_dels_pb = updates_pb->add_applied_segment_num_dels();
+        num_dels_pb->set_segment_id(segment_id);
+        num_dels_pb->set_num_dels(num_dels);
+    }
     if (_apply_version_idx < _edit_version_infos.size()) {
         const EditVersion& apply_version = _edit_version_infos[_apply_version_idx]->version;
         updates_pb->mutable_apply_version()->set_major(apply_version.major());
@@ -2362,9 +2490,11 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
 
         WriteBatch wb;
         CHECK_FAIL(TabletMetaManager::clear_log(data_store, &wb, tablet_id));
+        _applied_segment_num_dels.clear();
         for (const auto& [rssid, delvec] : snapshot_meta.delete_vectors()) {
             auto id = rssid + _next_rowset_id;
             CHECK_FAIL(TabletMetaManager::put_del_vector(data_store, &wb, tablet_id, id, delvec));
+            _applied_segment_num_dels[id] = delvec.cardinality();
         }
         for (const auto& [rid, rowset] : _rowsets) {
             RowsetMetaPB meta_pb = rowset->rowset_meta()->to_rowset_pb();
@@ -2583,4 +2713,44 @@ Status TabletUpdates::prepare_partial_update_states(Tablet* tablet, const std::v
     return Status::OK();
 }
 
+Status TabletUpdates::get_rows_by_pks(const vectorized::Column& pks, std::vector<uint32_t>& column_ids,
+                                      EditVersion* read_version, vector<std::unique_ptr<vectorized::Column>>* columns) {
+    // the rows are not moved by the commits and the compactions applied until they are read
+    std::lock_guard lg(_index_lock);
+    {
+        std::lock_guard wl(_lock);
+        *read_version = _edit_version_infos[_apply_version_idx]->version;
+    }
+
+    auto manager = StorageEngine::instance()->update_manager();
+    auto index_entry = manager->index_cache().get_or_create(_tablet.tablet_id());
+    index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
+    auto& index = index_entry->value();
+    auto st = index.load(&_tablet);
+    manager->index_cache().update_object_size(index_entry, index.memory_usage());
+    if (!st.ok()) {
+        manager->index_cache().remove(index_entry);
+        return Status::InternalError(Substitute("get_rows_by_pks error: load primary index failed: $0 $1",
+                                                st.to_string(), debug_string()));
+    }
+    std::vector<uint64_t> rss_rowids(pks.size());
+    index.get(pks, &rss_rowids);
+    manager->index_cache().release(index_entry);
+
+    std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
+    for (uint64_t v : rss_rowids) {
+        uint32_t rssid = v >> 32;
+        if (rssid != (uint32_t)-1) {
+            rowids_by_rssid[rssid].push_back(v & ROWID_MASK);
+        }
+    }
+    if (rowids_by_rssid.empty()) {
+        return Status::OK();
+    }
+    for (auto& [rssid, rowids] : rowids_by_rssid) {
+        std::sort(rowids.begin(), rowids.end());
+    }
+    return get_column_values(column_ids, false, rowids_by_rssid, columns);
+}
+
 } // namespace starrocks
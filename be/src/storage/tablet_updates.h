@@ -214,6 +214,12 @@ public:
                                          EditVersion* read_version, uint32_t* next_rowset_id,
                                          std::vector<std::vector<uint64_t>*>* rss_rowids);
 
+    // Append the |column_ids| of the rows of the *encoded* primary keys |pks| to |columns|, at the currently applied
+    // version, which is set to |read_version|. The keys not found are skipped, and the rows are appended in the
+    // order of their locations rather than the order of |pks|.
+    Status get_rows_by_pks(const vectorized::Column& pks, std::vector<uint32_t>& column_ids,
+                           EditVersion* read_version, vector<std::unique_ptr<vectorized::Column>>* columns);
+
 private:
     friend class Tablet;
     friend class PrimaryIndex;
@@ -232,6 +238,18 @@ private:
         std::unique_ptr<CompactionInfo> compaction;
     };
 
+    // the rowset commits applied in memory whose meta is not written yet, they are written in one batch
+    struct PendingApplies {
+        std::vector<const EditVersionInfo*> version_infos;
+        // new delvecs of each version in |version_infos|
+        std::vector<std::vector<std::pair<uint32_t, DelVectorPtr>>> delvecs;
+        // rssid -> its latest delvec in |delvecs|
+        std::unordered_map<uint32_t, DelVectorPtr> latest_delvecs;
+
+        size_t size() const { return version_infos.size(); }
+        bool empty() const { return version_infos.empty(); }
+    };
+
     struct RowsetStats {
         size_t num_segments = 0;
         size_t num_rows = 0;
@@ -263,7 +281,10 @@ private:
 
     void _get_latest_applied_version(EditVersion* latest_applied_version);
 
-    void _apply_rowset_commit(const EditVersionInfo& version_info);
+    void _apply_rowset_commit(const EditVersionInfo& version_info, PendingApplies* pending);
+
+    // writes the meta of the pending applies and makes their versions visible
+    void _write_pending_applies(PendingApplies* pending);
 
     void _apply_compaction_commit(const EditVersionInfo& version_info);
 
@@ -334,6 +355,9 @@ private:
     // commits can success when doing schema-change, currently it's not persistent meta yet,
     // so after BE restart those "committed" will be lost.
     std::map<int64_t, RowsetSharedPtr> _pending_commits;
+    // the number of deleted rows of each segment at the applied version, saved in the tablet meta so that loading
+    // the tablet needn't read the delete vectors of all the segments. protected by |_lock|.
+    std::unordered_map<uint32_t, uint64_t> _applied_segment_num_dels;
 
     mutable std::mutex _rowsets_lock;
     std::unordered_map<uint32_t, RowsetSharedPtr> _rowsets;
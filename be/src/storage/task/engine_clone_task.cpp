@@ -23,7 +23,10 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <set>
 
 #include "common/status.h"
@@ -34,6 +37,7 @@
 #include "gutil/strings/stringpiece.h"
 #include "gutil/strings/substitute.h"
 #include "http/http_client.h"
+#include "http/http_status.h"
 #include "runtime/client_cache.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
@@ -42,6 +46,7 @@
 #include "storage/snapshot_manager.h"
 #include "storage/tablet_updates.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
 
 using std::set;
@@ -89,6 +94,10 @@ Status EngineCloneTask::execute() {
         }
         auto st = _do_clone(tablet.get());
         _set_tablet_info(st, false);
+        if (st.ok()) {
+            // the new replica of a tablet created by a full clone has no access heat and is not pre-warmed
+            StorageEngine::instance()->prewarm_tablet(tablet);
+        }
     } else {
         auto st = _do_clone(nullptr);
         _set_tablet_info(st, true);
@@ -398,68 +407,139 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
         }
     }
 
-    // Get copy from remote
-    uint64_t total_file_size = 0;
+    // Get copy from remote, the files except the header file are downloaded in parallel
+    std::atomic<uint64_t> total_file_size{0};
     MonotonicStopWatch watch;
     watch.start();
-    for (auto& file_name : file_name_list) {
-        auto remote_file_url = remote_url_prefix + file_name;
-
-        // get file length
+    std::unique_ptr<ThreadPool> download_pool;
+    size_t num_data_files = file_name_list.empty() ? 0 : file_name_list.size() - 1;
+    if (config::clone_download_file_parallelism > 1 && num_data_files > 1) {
+        Status st = ThreadPoolBuilder("clone_download")
+                            .set_min_threads(1)
+                            .set_max_threads(std::min<int>(config::clone_download_file_parallelism, num_data_files))
+                            .build(&download_pool);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the pool downloading the files, download them serially: " << st;
+    }
+    std::mutex status_mutex;
+    Status download_status;
+    std::atomic<bool> failed{false};
+    auto download_func = [&, this](const std::string& file_name) {
+        if (failed.load()) {
+            return;
+        }
         uint64_t file_size = 0;
-        auto get_file_size_cb = [&remote_file_url, &file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
-            RETURN_IF_ERROR(client->head());
-            file_size = client->get_content_length();
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
-        // check disk capacity
-        if (data_dir->reach_capacity_limit(file_size)) {
-            return Status::InternalError("Disk reach capacity limit");
+        Status st = _download_file(data_dir, remote_url_prefix, local_path, file_name, &file_size);
+        if (!st.ok()) {
+            std::lock_guard l(status_mutex);
+            if (download_status.ok()) {
+                download_status = st;
+            }
+            failed.store(true);
+            return;
         }
-
         total_file_size += file_size;
-        uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
-        if (estimate_timeout < config::download_low_speed_time) {
-            estimate_timeout = config::download_low_speed_time;
+    };
+    for (size_t i = 0; i < num_data_files; i++) {
+        const std::string& file_name = file_name_list[i];
+        if (download_pool != nullptr &&
+            download_pool->submit_func([&download_func, &file_name]() { download_func(file_name); }).ok()) {
+            continue;
         }
-
-        std::string local_file_path = local_path + file_name;
-
-        LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << file_size
-                  << " timeout=" << estimate_timeout;
-
-        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
-
-            // Check file length
-            uint64_t local_file_size = std::filesystem::file_size(local_file_path);
-            if (local_file_size != file_size) {
-                LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
-                             << file_size;
-                return Status::InternalError("mismatched file size");
-            }
-            chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
-    } // Clone files from remote backend
+        download_func(file_name);
+    }
+    if (download_pool != nullptr) {
+        download_pool->wait();
+    }
+    RETURN_IF_ERROR(download_status);
+    // the header file is the last one
+    if (!file_name_list.empty()) {
+        download_func(file_name_list.back());
+        RETURN_IF_ERROR(download_status);
+    }
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
     total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
+    uint64_t total_bytes = total_file_size.load();
     double copy_rate = 0.0;
     if (total_time_ms > 0) {
-        copy_rate = total_file_size / ((double)total_time_ms) / 1000;
+        copy_rate = total_bytes / ((double)total_time_ms) / 1000;
     }
-    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_file_size << " cost=" << total_time_ms << " ms"
+    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_bytes << " cost=" << total_time_ms << " ms"
               << " rate=" << copy_rate << " MB/s";
     return Status::OK();
 }
 
+Status EngineCloneTask::_download_file(DataDir* data_dir, const std::string& remote_url_prefix,
+                                       const std::string& local_path, const std::string& file_name,
+                                       uint64_t* file_size) {
+    if (ExecEnv::GetInstance()->storage_engine()->bg_worker_stopped()) {
+        return Status::InternalError("Process is going to quit. The download should be stopped as soon as possible.");
+    }
+    auto remote_file_url = remote_url_prefix + file_name;
+
+    // get file length
+    auto get_file_size_cb = [&remote_file_url, file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(remote_file_url));
+        client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
+        RETURN_IF_ERROR(client->head());
+        *file_size = client->get_content_length();
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
+    // check disk capacity
+    if (data_dir->reach_capacity_limit(*file_size)) {
+        return Status::InternalError("Disk reach capacity limit");
+    }
+
+    uint64_t estimate_timeout = *file_size / config::download_low_speed_limit_kbps / 1024;
+    if (estimate_timeout < config::download_low_speed_time) {
+        estimate_timeout = config::download_low_speed_time;
+    }
+
+    std::string local_file_path = local_path + file_name;
+
+    LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << *file_size
+              << " timeout=" << estimate_timeout;
+
+    uint64_t expected_size = *file_size;
+    auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, expected_size](HttpClient* client) {
+        // resume from the bytes downloaded by the previous try
+        std::error_code ec;
+        uint64_t offset = std::filesystem::exists(local_file_path, ec) ? std::filesystem::file_size(local_file_path, ec)
+                                                                        : 0;
+        if (ec || offset > expected_size) {
+            offset = 0;
+        }
+        if (offset < expected_size || expected_size == 0) {
+            RETURN_IF_ERROR(client->init(remote_file_url));
+            client->set_timeout_ms(estimate_timeout * 1000);
+            Status st = client->download(local_file_path, offset);
+            if (!st.ok()) {
+                if (offset > 0 && client->get_http_status() != HttpStatus::PARTIAL_CONTENT) {
+                    // the source doesn't serve the range, the next try downloads the whole file
+                    std::filesystem::remove(local_file_path, ec);
+                }
+                return st;
+            }
+            if (offset > 0) {
+                LOG(INFO) << "Resumed download of " << remote_file_url << " from offset " << offset;
+            }
+        }
+
+        // Check file length
+        uint64_t local_file_size = std::filesystem::file_size(local_file_path);
+        if (local_file_size != expected_size) {
+            LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
+                         << expected_size;
+            std::filesystem::remove(local_file_path, ec);
+            return Status::InternalError("mismatched file size");
+        }
+        chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+        return Status::OK();
+    };
+    return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+}
+
 Status EngineCloneTask::_finish_clone(Tablet* tablet, const string& clone_dir, int64_t committed_version,
                                       bool incremental_clone) {
     bool bg_worker_stopped = ExecEnv::GetInstance()->storage_engine()->bg_worker_stopped();
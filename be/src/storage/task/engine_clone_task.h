@@ -60,6 +60,11 @@ private:
     // Download tablet files from
     Status _download_files(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path);
 
+    // Download the file |file_name| of |remote_url_prefix| to |local_path|, a retry resumes the download from the
+    // bytes downloaded by the previous try.
+    Status _download_file(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path,
+                          const std::string& file_name, uint64_t* file_size);
+
     Status _make_snapshot(const std::string& ip, int port, TTableId tablet_id, TSchemaHash schema_hash, int timeout_s,
                           const std::vector<Version>* missed_versions, std::string* snapshot_path,
                           int32_t* snapshot_version);
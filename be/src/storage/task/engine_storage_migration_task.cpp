@@ -279,6 +279,9 @@ Status EngineStorageMigrationTask::_storage_migrate(TabletSharedPtr tablet) {
             res = Status::NotFound(fmt::format("Not found tablet: {}", _tablet_id));
             break;
         }
+        new_tablet->inherit_access_heat(tablet.get());
+        StorageEngine::instance()->prewarm_tablet(new_tablet);
+
         AlterTabletTaskSharedPtr alter_task = tablet->alter_task();
         if (alter_task != nullptr) {
             if (alter_task->alter_state() == ALTER_FINISHED) {
@@ -5,7 +5,9 @@
 #include <limits>
 #include <memory>
 
+#include "common/config.h"
 #include "gutil/endian.h"
+#include "runtime/mem_tracker.h"
 #include "storage/del_vector.h"
 #include "storage/kv_store.h"
 #include "storage/rowset_update_state.h"
@@ -32,6 +34,9 @@ UpdateManager::UpdateManager(MemTracker* mem_tracker)
 }
 
 UpdateManager::~UpdateManager() {
+    if (_index_load_thread_pool != nullptr) {
+        _index_load_thread_pool->shutdown();
+    }
     if (_apply_thread_pool != nullptr) {
         // DynamicCache may be still used by apply thread.
         // Before deconstrut the DynamicCache, apply thread
@@ -54,10 +59,24 @@ UpdateManager::~UpdateManager() {
 }
 
 Status UpdateManager::init() {
+    _update_index_cache_capacity();
+    RETURN_IF_ERROR(ThreadPoolBuilder("UpdateIndexLoadThreadPool")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(1, config::update_primary_index_load_threads))
+                            .build(&_index_load_thread_pool));
     auto st = ThreadPoolBuilder("UpdateApplyThreadPool").build(&_apply_thread_pool);
     return st;
 }
 
+void UpdateManager::_update_index_cache_capacity() {
+    if (_update_mem_tracker == nullptr || !_update_mem_tracker->has_limit()) {
+        return;
+    }
+    int32_t percent = std::max(0, std::min(100, config::update_primary_index_cache_percent));
+    // evicts the unused indexes beyond the capacity as well, the ones in use may exceed it for a while
+    _index_cache.set_capacity(_update_mem_tracker->limit() * percent / 100);
+}
+
 Status UpdateManager::get_del_vec_in_meta(KVStore* meta, const TabletSegmentId& tsid, int64_t version,
                                           DelVector* delvec, int64_t* latest_version) {
     return TabletMetaManager::get_del_vector(meta, tsid.tablet_id, tsid.segment_id, version, delvec, latest_version);
@@ -136,6 +155,8 @@ void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsi
 }
 
 void UpdateManager::expire_cache() {
+    // the config may be changed at runtime
+    _update_index_cache_capacity();
     StarRocksMetrics::instance()->update_primary_index_num.set_value(_index_cache.object_size());
     StarRocksMetrics::instance()->update_primary_index_bytes_total.set_value(_index_cache.size());
     {
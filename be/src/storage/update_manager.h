@@ -57,6 +57,8 @@ public:
 
     ThreadPool* apply_thread_pool() { return _apply_thread_pool.get(); }
 
+    ThreadPool* index_load_thread_pool() { return _index_load_thread_pool.get(); }
+
     DynamicCache<uint64_t, PrimaryIndex>& index_cache() { return _index_cache; }
 
     DynamicCache<string, RowsetUpdateState>& update_state_cache() { return _update_state_cache; }
@@ -78,6 +80,9 @@ public:
     string topn_memory_stats(size_t topn);
 
 private:
+    // bounds the index cache by config::update_primary_index_cache_percent of the update memory limit
+    void _update_index_cache_capacity();
+
     // default 6min
     int64_t _cache_expire_ms = 360000;
 
@@ -99,6 +104,8 @@ private:
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
 
     std::unique_ptr<ThreadPool> _apply_thread_pool;
+    // reads the segments of a primary index being loaded
+    std::unique_ptr<ThreadPool> _index_load_thread_pool;
 
     UpdateManager(const UpdateManager&) = delete;
     const UpdateManager& operator=(const UpdateManager&) = delete;
@@ -25,6 +25,12 @@ int AsyncDeltaWriter::_execute(void* meta, bthread::TaskIterator<AsyncDeltaWrite
     }
     auto writer = static_cast<DeltaWriter*>(meta);
     for (; iter; ++iter) {
+        if (iter->flush_memtable) {
+            auto st = writer->flush_memtable_async();
+            LOG_IF(WARNING, !st.ok()) << "Fail to flush memtable of tablet " << writer->tablet()->tablet_id() << ": "
+                                      << st.to_string();
+            continue;
+        }
         Status st;
         if (iter->chunk != nullptr && iter->indexes_size > 0) {
             st = writer->write(*iter->chunk, iter->indexes, 0, iter->indexes_size);
@@ -106,6 +112,14 @@ void AsyncDeltaWriter::commit(AsyncDeltaWriterCallback* cb) {
     }
 }
 
+void AsyncDeltaWriter::flush_memtable_async() {
+    Task task;
+    task.write_cb = nullptr;
+    task.flush_memtable = true;
+    int r = bthread::execution_queue_execute(_queue_id, task);
+    LOG_IF(WARNING, r != 0) << "Fail to execution_queue_execute: " << r;
+}
+
 void AsyncDeltaWriter::abort() {
     _writer->abort();
 }
@@ -46,9 +46,15 @@ public:
     // [thread-safe and wait-free]
     void commit(AsyncDeltaWriterCallback* cb);
 
+    // Flush the memtable being written in background, see DeltaWriter::flush_memtable_async().
+    // [thread-safe and wait-free]
+    void flush_memtable_async();
+
     // [thread-safe and wait-free]
     void abort();
 
+    size_t memtable_memory_usage() const { return _writer->memtable_memory_usage(); }
+
     int64_t partition_id() const { return _writer->partition_id(); }
 
 private:
@@ -63,6 +69,8 @@ private:
         AsyncDeltaWriterCallback* write_cb;
         uint32_t indexes_size = 0;
         bool commit_after_write = false;
+        // If true, this is a flush task without callback
+        bool flush_memtable = false;
     };
 
     Status _init();
@@ -0,0 +1,34 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/vectorized/column_expr.h"
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "exprs/expr_context.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks::vectorized {
+
+ColumnExpr::ColumnExpr(ColumnId column_id, RuntimeState* state, ExprContext* expr_ctx, const SlotDescriptor* slot_desc)
+        : _column_id(column_id), _state(state), _slot_desc(slot_desc) {
+    DCHECK(expr_ctx->opened());
+    DCHECK_IF_ERROR(expr_ctx->clone(_state, &_expr_ctx));
+}
+
+ColumnExpr::~ColumnExpr() {
+    if (_expr_ctx != nullptr) {
+        _expr_ctx->close(_state);
+    }
+}
+
+ColumnPtr ColumnExpr::evaluate(const ColumnPtr& column) const {
+    Chunk chunk;
+    chunk.append_column(column, _slot_desc->id());
+    ColumnPtr result = _expr_ctx->evaluate(&chunk);
+    if (!column->is_nullable() && result->has_null()) {
+        return nullptr;
+    }
+    return ColumnHelper::move_column(_slot_desc->type(), column->is_nullable(), result, column->size());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,43 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "column/vectorized_fwd.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+class ExprContext;
+class RuntimeState;
+class SlotDescriptor;
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+// ColumnExpr is an expression over a single column evaluated by the storage layer instead of the projection
+// above the scan, i.e. the column is read as the results of the expression over it. The expression is of the
+// same type as the column. SegmentIterator evaluates it once per word of the dictionary if the column is
+// dict-encoded, and the words of the rows are never decoded.
+// Like ColumnExprPredicate, it clones the expression, so that it's not shared by the scanners.
+class ColumnExpr {
+public:
+    ColumnExpr(ColumnId column_id, RuntimeState* state, ExprContext* expr_ctx, const SlotDescriptor* slot_desc);
+
+    ~ColumnExpr();
+
+    ColumnExpr(const ColumnExpr&) = delete;
+    void operator=(const ColumnExpr&) = delete;
+
+    ColumnId column_id() const { return _column_id; }
+
+    // Returns the results of the expression over |column|, nullable iff |column| is nullable.
+    // Returns nullptr if |column| is not nullable but some results are null.
+    ColumnPtr evaluate(const ColumnPtr& column) const;
+
+private:
+    ColumnId _column_id;
+    RuntimeState* _state;
+    ExprContext* _expr_ctx = nullptr;
+    const SlotDescriptor* _slot_desc;
+};
+
+} // namespace starrocks::vectorized
@@ -3,6 +3,8 @@
 
 #include "storage/vectorized/column_expr_predicate.h"
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include "column/column_helper.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
@@ -11,6 +13,9 @@
 #include "runtime/descriptors.h"
 #include "runtime/primitive_type.h"
 #include "runtime/runtime_state.h"
+#include "storage/rowset/bloom_filter.h"
+#include "storage/rowset/inverted_index_reader.h"
+#include "storage/rowset/like_pattern.h"
 #include "storage/vectorized/column_predicate.h"
 namespace starrocks::vectorized {
 
@@ -142,6 +147,54 @@ bool ColumnExprPredicate::zone_map_filter(const ZoneMapDetail& detail) const {
     return false;
 }
 
+bool ColumnExprPredicate::_get_like_pattern(Slice* pattern) const {
+    // the casted column isn't the indexed one
+    if (_expr_ctxs.size() != 1) {
+        return false;
+    }
+    ExprContext* ctx = _expr_ctxs[0];
+    Expr* root = ctx->root();
+    if (root->get_num_children() != 2 || !boost::iequals(root->fn().name.function_name, "like") ||
+        !root->get_child(0)->is_slotref() || !root->get_child(1)->is_constant()) {
+        return false;
+    }
+    ColumnPtr column = root->get_child(1)->evaluate_const(ctx);
+    if (column == nullptr || column->only_null() || column->is_null(0)) {
+        return false;
+    }
+    *pattern = ColumnHelper::get_const_value<TYPE_VARCHAR>(column);
+    return true;
+}
+
+Status ColumnExprPredicate::seek_inverted_index(InvertedIndexIterator* iter, Roaring* rows) const {
+    Slice pattern;
+    if (!_get_like_pattern(&pattern)) {
+        return Status::Cancelled("not a like predicate of the column");
+    }
+    return iter->match_like(pattern, rows);
+}
+
+bool ColumnExprPredicate::support_ngram_bloom_filter() const {
+    Slice pattern;
+    return _get_like_pattern(&pattern);
+}
+
+bool ColumnExprPredicate::ngram_bloom_filter(const BloomFilter* bf, size_t gram_num) const {
+    Slice pattern;
+    if (!_get_like_pattern(&pattern)) {
+        return true;
+    }
+    // every n-gram of the literal pieces must be in the page
+    for (const LikeLiteral& literal : parse_like_literals(pattern)) {
+        for (size_t i = 0; i + gram_num <= literal.text.size(); i++) {
+            if (!bf->test_bytes(literal.text.data() + i, gram_num)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 Status ColumnExprPredicate::convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
                                        ObjectPool* obj_pool) const {
     TypeDescriptor input_type = TypeDescriptor::from_storage_type_info(target_type_info.get());
@@ -12,6 +12,7 @@ class SlotDescriptor;
 class SparseRange;
 class ExprContext;
 class BitmapIndexIterator;
+class InvertedIndexIterator;
 } // namespace starrocks
 
 namespace starrocks::vectorized {
@@ -42,6 +43,10 @@ public:
 
     bool zone_map_filter(const ZoneMapDetail& detail) const override;
     bool support_bloom_filter() const override { return false; }
+    // Only `column LIKE 'pattern'` is supported by the inverted index and the ngram bloom filter.
+    Status seek_inverted_index(InvertedIndexIterator* iter, Roaring* rows) const override;
+    bool support_ngram_bloom_filter() const override;
+    bool ngram_bloom_filter(const BloomFilter* bf, size_t gram_num) const override;
     PredicateType type() const override { return PredicateType::kExpr; }
     bool can_vectorized() const override { return true; }
 
@@ -53,6 +58,8 @@ public:
 
 private:
     void _add_expr_ctx(ExprContext* expr_ctx);
+    // Returns false if the predicate isn't `column LIKE 'pattern'` or the pattern is null.
+    bool _get_like_pattern(Slice* pattern) const;
     RuntimeState* _state;
     std::vector<ExprContext*> _expr_ctxs;
     const SlotDescriptor* _slot_desc;
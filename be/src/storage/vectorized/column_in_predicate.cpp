@@ -28,7 +28,27 @@ public:
     template <typename Op>
     inline void t_evaluate(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const {
         auto* v = reinterpret_cast<const ValueType*>(column->raw_data());
-        if (!column->has_null()) {
+        if constexpr (std::is_same_v<ItemSet, ItemHashSet<ValueType>>) {
+            // the lookups of a batch of rows at once, see FixedValueSet
+            const uint8_t* null_data = nullptr;
+            if (column->has_null()) {
+                null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            }
+            uint8_t found[kBatchSize];
+            for (size_t start = from; start < to; start += kBatchSize) {
+                size_t num = std::min<size_t>(kBatchSize, to - start);
+                _values.contains(v + start, num, found);
+                if (null_data == nullptr) {
+                    for (size_t i = 0; i < num; i++) {
+                        sel[start + i] = Op::apply(sel[start + i], found[i]);
+                    }
+                } else {
+                    for (size_t i = 0; i < num; i++) {
+                        sel[start + i] = Op::apply(sel[start + i], (uint8_t)(!null_data[start + i] && found[i]));
+                    }
+                }
+            }
+        } else if (!column->has_null()) {
             for (size_t i = from; i < to; i++) {
                 sel[i] = Op::apply(sel[i], (uint8_t)(_values.contains(v[i])));
             }
@@ -158,6 +178,8 @@ public:
     }
 
 private:
+    static constexpr size_t kBatchSize = 256;
+
     ItemSet _values;
 };
 
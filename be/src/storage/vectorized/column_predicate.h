@@ -27,6 +27,7 @@ class ExprContext;
 class RuntimeState;
 class SlotDescriptor;
 class BitmapIndexIterator;
+class InvertedIndexIterator;
 class BloomFilter;
 } // namespace starrocks
 
@@ -49,6 +50,8 @@ enum class PredicateType {
     kExpr = 13,
     kTrue = 14,
     kMap = 15,
+    kRuntimeFilter = 16,
+    kRuntimeTopn = 17,
 };
 
 template <typename T>
@@ -118,15 +121,30 @@ public:
     // Return false to filter out a data page.
     virtual bool zone_map_filter(const ZoneMapDetail& detail) const { return true; }
 
+    // Whether the operand of this predicate is not known yet, e.g. a runtime filter has not arrived. Such a
+    // predicate selects all rows until then, and the pages are pruned by its zone map filter after that.
+    virtual bool is_deferred() const { return false; }
+
     virtual bool support_bloom_filter() const { return false; }
 
     // Return false to filter out a data page.
     virtual bool bloom_filter(const BloomFilter* bf) const { return true; }
 
+    virtual bool support_ngram_bloom_filter() const { return false; }
+
+    // Return false to filter out a data page by the bloom filter of its n-grams of |gram_num| bytes.
+    virtual bool ngram_bloom_filter(const BloomFilter* bf, size_t gram_num) const { return true; }
+
     virtual Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const {
         return Status::Cancelled("not implemented");
     }
 
+    // Read the rows which may satisfy the predicate from the inverted index into |rows|. The rows are a superset,
+    // so the predicate must be evaluated on them still.
+    virtual Status seek_inverted_index(InvertedIndexIterator* iter, Roaring* rows) const {
+        return Status::Cancelled("not implemented");
+    }
+
     // Indicate whether or not the evaluate can be vectorized.
     // If this function return true, evaluate function will be vectorized and can achieve
     // good performance.
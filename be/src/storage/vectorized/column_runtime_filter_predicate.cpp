@@ -0,0 +1,258 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/vectorized/column_runtime_filter_predicate.h"
+
+#include <sstream>
+
+#include "column/datum_convert.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "exprs/vectorized/runtime_filter_bank.h"
+#include "runtime/primitive_type.h"
+#include "storage/types.h"
+#include "storage/vectorized/column_expr_predicate.h"
+#include "storage/vectorized/zone_map_detail.h"
+
+namespace starrocks::vectorized {
+
+ColumnRuntimeFilterPredicate::ColumnRuntimeFilterPredicate(TypeInfoPtr type_info, ColumnId column_id,
+                                                           const RuntimeFilterProbeDescriptor* desc)
+        : ColumnPredicate(std::move(type_info), column_id), _desc(desc) {
+    // Evaluated along with the expr predicates on whole columns, before the late materialization.
+    _is_expr_predicate = true;
+}
+
+void ColumnRuntimeFilterPredicate::evaluate(const Column* column, uint8_t* selection, uint16_t from,
+                                            uint16_t to) const {
+    // Does not support range evaluatation.
+    DCHECK(from == 0);
+    const JoinRuntimeFilter* rf = _desc->runtime_filter();
+    if (rf == nullptr) {
+        memset(selection + from, 1, to - from);
+        return;
+    }
+    // `column` is owned by storage layer, evaluate() of runtime filter doesn't modify it.
+    const Column::Filter& filter = rf->evaluate(const_cast<Column*>(column), &_ctx);
+    DCHECK_GE(filter.size(), to);
+    memcpy(selection + from, filter.data() + from, to - from);
+}
+
+void ColumnRuntimeFilterPredicate::evaluate_and(const Column* column, uint8_t* sel, uint16_t from,
+                                                uint16_t to) const {
+    DCHECK(from == 0);
+    const JoinRuntimeFilter* rf = _desc->runtime_filter();
+    if (rf == nullptr) {
+        return;
+    }
+    const Column::Filter& filter = rf->evaluate(const_cast<Column*>(column), &_ctx);
+    for (uint16_t i = from; i < to; i++) {
+        sel[i] &= filter[i];
+    }
+}
+
+void ColumnRuntimeFilterPredicate::evaluate_or(const Column* column, uint8_t* sel, uint16_t from,
+                                               uint16_t to) const {
+    DCHECK(from == 0);
+    const JoinRuntimeFilter* rf = _desc->runtime_filter();
+    if (rf == nullptr) {
+        memset(sel + from, 1, to - from);
+        return;
+    }
+    const Column::Filter& filter = rf->evaluate(const_cast<Column*>(column), &_ctx);
+    for (uint16_t i = from; i < to; i++) {
+        sel[i] |= filter[i];
+    }
+}
+
+template <PrimitiveType PT>
+static bool min_max_zone_map_filter(const TypeInfoPtr& type_info, const JoinRuntimeFilter* rf,
+                                    const ZoneMapDetail& detail) {
+    const auto* bf = down_cast<const RuntimeBloomFilter<PT>*>(rf);
+    if (rf->has_null() && detail.has_null()) {
+        return true;
+    }
+    if (!bf->has_min_max()) {
+        // Only nulls in the runtime filter.
+        return false;
+    }
+    const Datum& max = detail.max_value();
+    if (max.is_null()) {
+        // Only nulls in the page.
+        return false;
+    }
+    return type_info->cmp(Datum(bf->min_value()), max) <= 0 &&
+           type_info->cmp(Datum(bf->max_value()), detail.min_or_null_value()) >= 0;
+}
+
+bool ColumnRuntimeFilterPredicate::zone_map_filter(const ZoneMapDetail& detail) const {
+    const JoinRuntimeFilter* rf = _desc->runtime_filter();
+    if (rf == nullptr) {
+        return true;
+    }
+    switch (scalar_field_type_to_primitive_type(_type_info->type())) {
+#define M(PT)     \
+    case PT:      \
+        return min_max_zone_map_filter<PT>(_type_info, rf, detail);
+        M(TYPE_TINYINT)
+        M(TYPE_SMALLINT)
+        M(TYPE_INT)
+        M(TYPE_BIGINT)
+        M(TYPE_LARGEINT)
+        M(TYPE_FLOAT)
+        M(TYPE_DOUBLE)
+        M(TYPE_DATE)
+        M(TYPE_DATETIME)
+        M(TYPE_DECIMALV2)
+        M(TYPE_DECIMAL32)
+        M(TYPE_DECIMAL64)
+        M(TYPE_DECIMAL128)
+#undef M
+    default:
+        // The booleans are not pruned, which are hardly selective by min/max.
+        return true;
+    }
+}
+
+bool ColumnRuntimeFilterPredicate::is_deferred() const {
+    return _desc->runtime_filter() == nullptr;
+}
+
+Status ColumnRuntimeFilterPredicate::convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                                                ObjectPool* obj_pool) const {
+    if (target_type_info->type() == _type_info->type()) {
+        *output = this;
+    } else {
+        // The runtime filter can't be evaluated on the column of another type, it will be evaluated after the
+        // column is converted by the scan operator anyway.
+        *output = obj_pool->add(new ColumnTruePredicate(target_type_info, _column_id));
+    }
+    return Status::OK();
+}
+
+std::string ColumnRuntimeFilterPredicate::debug_string() const {
+    std::stringstream ss;
+    const JoinRuntimeFilter* rf = _desc->runtime_filter();
+    ss << "(ColumnRuntimeFilterPredicate: " << (rf != nullptr ? rf->debug_string() : "not arrived") << ")";
+    return ss.str();
+}
+
+ColumnRuntimeTopnPredicate::ColumnRuntimeTopnPredicate(TypeInfoPtr type_info, ColumnId column_id,
+                                                       const RuntimeTopnThreshold* threshold)
+        : ColumnPredicate(std::move(type_info), column_id), _threshold(threshold) {
+    _is_expr_predicate = true;
+}
+
+// Sets selection[i] to whether the row i ranks before or equal to the threshold.
+template <PrimitiveType PT>
+static void evaluate_topn_threshold(const RuntimeTopnThreshold& threshold, const Column* column, uint8_t* selection,
+                                    uint16_t from, uint16_t to) {
+    using CppType = RunTimeCppType<PT>;
+    using ColumnType = RunTimeColumnType<PT>;
+    const CppType value = threshold.value().get<CppType>();
+
+    const Column* data_column = column;
+    const uint8_t* null_data = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const NullableColumn*>(column);
+        data_column = nullable_column->data_column().get();
+        if (nullable_column->has_null()) {
+            null_data = nullable_column->immutable_null_column_data().data();
+        }
+    }
+    const CppType* data = down_cast<const ColumnType*>(data_column)->get_data().data();
+    if (threshold.is_asc()) {
+        for (uint16_t i = from; i < to; i++) {
+            selection[i] = !(value < data[i]);
+        }
+    } else {
+        for (uint16_t i = from; i < to; i++) {
+            selection[i] = !(data[i] < value);
+        }
+    }
+    if (null_data != nullptr) {
+        const uint8_t null_selected = threshold.is_null_first();
+        for (uint16_t i = from; i < to; i++) {
+            selection[i] = null_data[i] ? null_selected : selection[i];
+        }
+    }
+}
+
+void ColumnRuntimeTopnPredicate::evaluate(const Column* column, uint8_t* selection, uint16_t from,
+                                          uint16_t to) const {
+    if (!_threshold->has_value()) {
+        memset(selection + from, 1, to - from);
+        return;
+    }
+    switch (_threshold->type()) {
+#define M(PT)                                                                  \
+    case PT:                                                                   \
+        evaluate_topn_threshold<PT>(*_threshold, column, selection, from, to); \
+        break;
+        APPLY_FOR_RUNTIME_TOPN_THRESHOLD_TYPE(M)
+#undef M
+    default:
+        DCHECK(false) << "unsupported type " << _threshold->type();
+        memset(selection + from, 1, to - from);
+    }
+}
+
+void ColumnRuntimeTopnPredicate::evaluate_and(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const {
+    if (!_threshold->has_value()) {
+        return;
+    }
+    std::vector<uint8_t> selection(to);
+    evaluate(column, selection.data(), from, to);
+    for (uint16_t i = from; i < to; i++) {
+        sel[i] &= selection[i];
+    }
+}
+
+void ColumnRuntimeTopnPredicate::evaluate_or(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const {
+    std::vector<uint8_t> selection(to);
+    evaluate(column, selection.data(), from, to);
+    for (uint16_t i = from; i < to; i++) {
+        sel[i] |= selection[i];
+    }
+}
+
+bool ColumnRuntimeTopnPredicate::zone_map_filter(const ZoneMapDetail& detail) const {
+    if (!_threshold->has_value()) {
+        return true;
+    }
+    if (detail.has_null() && _threshold->is_null_first()) {
+        return true;
+    }
+    if (!detail.has_not_null()) {
+        return false;
+    }
+    const Datum value = _threshold->value();
+    if (_threshold->is_asc()) {
+        return _type_info->cmp(detail.min_value(), value) <= 0;
+    } else {
+        return _type_info->cmp(detail.max_value(), value) >= 0;
+    }
+}
+
+Status ColumnRuntimeTopnPredicate::convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                                              ObjectPool* obj_pool) const {
+    if (target_type_info->type() == _type_info->type()) {
+        *output = this;
+    } else {
+        *output = obj_pool->add(new ColumnTruePredicate(target_type_info, _column_id));
+    }
+    return Status::OK();
+}
+
+std::string ColumnRuntimeTopnPredicate::debug_string() const {
+    std::stringstream ss;
+    ss << "(ColumnRuntimeTopnPredicate: " << (_threshold->is_asc() ? "<= " : ">= ");
+    if (_threshold->has_value()) {
+        ss << datum_to_string(_type_info.get(), _threshold->value());
+    } else {
+        ss << "not published";
+    }
+    ss << ")";
+    return ss.str();
+}
+
+} // namespace starrocks::vectorized
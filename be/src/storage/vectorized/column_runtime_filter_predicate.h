@@ -0,0 +1,77 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "exprs/vectorized/runtime_filter.h"
+#include "exprs/vectorized/runtime_topn_threshold.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+class RuntimeFilterProbeDescriptor;
+
+// ColumnRuntimeFilterPredicate pushes a join runtime filter down to the storage layer, so that the rows dropped by
+// the filter are filtered out while reading the predicate columns, and the other columns are never materialized
+// for them.
+//
+// The runtime filter may arrive while the segments are being read. Until then, the predicate selects all rows.
+// After that, it also prunes the pages by the min/max of the runtime filter, with which SegmentIterator shrinks
+// the range left to read. The min/max of a runtime filter arrived before the scan is pushed down separately as an
+// index-filter-only range predicate too.
+//
+// Like ColumnExprPredicate, it's evaluated on whole columns, `from` is supposed to be 0 always.
+class ColumnRuntimeFilterPredicate : public ColumnPredicate {
+public:
+    // |desc| must live longer than this predicate, the type of its runtime filter must be the same as |type_info|.
+    ColumnRuntimeFilterPredicate(TypeInfoPtr type_info, ColumnId column_id, const RuntimeFilterProbeDescriptor* desc);
+
+    ~ColumnRuntimeFilterPredicate() override = default;
+
+    void evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override;
+    void evaluate_and(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override;
+    void evaluate_or(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override;
+
+    bool zone_map_filter(const ZoneMapDetail& detail) const override;
+    bool is_deferred() const override;
+    bool support_bloom_filter() const override { return false; }
+    PredicateType type() const override { return PredicateType::kRuntimeFilter; }
+    bool can_vectorized() const override { return true; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override;
+    std::string debug_string() const override;
+
+private:
+    const RuntimeFilterProbeDescriptor* _desc;
+    mutable JoinRuntimeFilter::RunningContext _ctx;
+};
+
+// ColumnRuntimeTopnPredicate filters out the rows ranked after the threshold of `ORDER BY ... LIMIT k` published by
+// the sorters above the scan, and prunes the pages by it. Like ColumnRuntimeFilterPredicate, it selects all rows
+// until a threshold is published, and SegmentIterator prunes the pages left to read once it is.
+class ColumnRuntimeTopnPredicate : public ColumnPredicate {
+public:
+    // |threshold| must live longer than this predicate, its type must be the same as |type_info|.
+    ColumnRuntimeTopnPredicate(TypeInfoPtr type_info, ColumnId column_id, const RuntimeTopnThreshold* threshold);
+
+    ~ColumnRuntimeTopnPredicate() override = default;
+
+    void evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override;
+    void evaluate_and(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override;
+    void evaluate_or(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override;
+
+    bool zone_map_filter(const ZoneMapDetail& detail) const override;
+    bool is_deferred() const override { return !_threshold->has_value(); }
+    bool support_bloom_filter() const override { return false; }
+    PredicateType type() const override { return PredicateType::kRuntimeTopn; }
+    bool can_vectorized() const override { return true; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override;
+    std::string debug_string() const override;
+
+private:
+    const RuntimeTopnThreshold* _threshold;
+};
+
+} // namespace starrocks::vectorized
@@ -2,14 +2,19 @@
 
 #include "storage/vectorized/compaction.h"
 
+#include <numeric>
 #include <utility>
 
+#include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_meta.h"
+#include "storage/rowset/segment.h"
+#include "storage/rowset/vectorized/segment_options.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/tablet_reader.h"
 #include "util/defer_op.h"
@@ -134,6 +139,62 @@ Status Compaction::do_compaction_impl() {
 
     _output_version = Version(_input_rowsets.front()->start_version(), _input_rowsets.back()->end_version());
 
+    // 2. write combined rows to output rowset
+    bool link_segments = false;
+    if (compaction_type() == ReaderType::READER_CUMULATIVE_COMPACTION && config::enable_compaction_link_segments) {
+        auto res = _can_link_segments();
+        LOG_IF(WARNING, !res.ok()) << "fail to check whether the segments can be linked. tablet="
+                                   << _tablet->tablet_id() << ", err=" << res.status().to_string();
+        link_segments = res.ok() && res.value();
+    }
+    Statistics stats;
+    if (link_segments) {
+        RETURN_IF_ERROR(_link_segments(&stats));
+    } else {
+        RETURN_IF_ERROR(_merge_rowsets(&stats));
+    }
+    TRACE_COUNTER_INCREMENT("output_rowset_data_size", _output_rowset->data_disk_size());
+    TRACE_COUNTER_INCREMENT("output_row_num", _output_rowset->num_rows());
+    TRACE_COUNTER_INCREMENT("output_segments_num", _output_rowset->num_segments());
+    TRACE("output rowset built");
+
+    // 3. check correctness, commented for this moment.
+    RETURN_IF_ERROR(check_correctness(stats));
+    TRACE("check correctness finished");
+
+    // 4. modify rowsets in memory
+    RETURN_IF_ERROR(modify_rowsets());
+    TRACE("modify rowsets finished");
+
+    // 5. update last success compaction time
+    int64_t now = UnixMillis();
+    if (compaction_type() == ReaderType::READER_CUMULATIVE_COMPACTION) {
+        _tablet->set_last_cumu_compaction_success_time(now);
+    } else {
+        _tablet->set_last_base_compaction_success_time(now);
+    }
+
+    LOG(INFO) << "succeed to do " << compaction_name() << ". tablet=" << _tablet->tablet_id()
+              << ", output_version=" << _output_version.first << "-" << _output_version.second
+              << ", input infos [segments=" << segments_num << ", rows=" << _input_row_num
+              << ", disk size=" << _input_rowsets_size << "]"
+              << ", output infos [segments=" << _output_rowset->num_segments()
+              << ", rows=" << _output_rowset->num_rows() << ", disk size=" << _output_rowset->data_disk_size() << "]"
+              << ". elapsed time=" << watch.get_elapse_second() << "s.";
+
+    // warm-up this rowset
+    Status st = _output_rowset->load();
+    // only log load failure
+    LOG_IF(WARNING, !st.ok()) << "ignore load rowset error tablet:" << _tablet->tablet_id()
+                              << " rowset:" << _output_rowset->rowset_id() << " " << st;
+    if (st.ok()) {
+        StorageEngine::instance()->prewarm_rowset(_tablet, _output_rowset);
+    }
+
+    return Status::OK();
+}
+
+Status Compaction::_merge_rowsets(Statistics* stats) {
     // choose vertical or horizontal compaction algorithm
     auto iterator_num_res = _get_segment_iterator_num();
     if (!iterator_num_res.ok()) {
@@ -165,13 +226,11 @@ Status Compaction::do_compaction_impl() {
     RETURN_IF_ERROR(construct_output_rowset_writer(max_rows_per_segment, algorithm));
     TRACE("prepare finished");
 
-    // 2. write combined rows to output rowset
-    Statistics stats;
     Status st;
     if (algorithm == kVertical) {
-        st = _merge_rowsets_vertically(segment_iterator_num, &stats);
+        st = _merge_rowsets_vertically(segment_iterator_num, stats);
     } else {
-        st = _merge_rowsets_horizontally(segment_iterator_num, &stats);
+        st = _merge_rowsets_horizontally(segment_iterator_num, stats);
     }
     if (!st.ok()) {
         LOG(WARNING) << "fail to do " << compaction_name() << ". res=" << st << ", tablet=" << _tablet->tablet_id()
@@ -179,48 +238,150 @@ Status Compaction::do_compaction_impl() {
         return st;
     }
     TRACE("merge rowsets finished");
-    TRACE_COUNTER_INCREMENT("merged_rows", stats.merged_rows);
-    TRACE_COUNTER_INCREMENT("filtered_rows", stats.filtered_rows);
-    TRACE_COUNTER_INCREMENT("output_rows", stats.output_rows);
+    TRACE_COUNTER_INCREMENT("merged_rows", stats->merged_rows);
+    TRACE_COUNTER_INCREMENT("filtered_rows", stats->filtered_rows);
+    TRACE_COUNTER_INCREMENT("output_rows", stats->output_rows);
 
     auto res = _output_rs_writer->build();
     if (!res.ok()) return res.status();
     _output_rowset = std::move(res).value();
-    TRACE_COUNTER_INCREMENT("output_rowset_data_size", _output_rowset->data_disk_size());
-    TRACE_COUNTER_INCREMENT("output_row_num", _output_rowset->num_rows());
-    TRACE_COUNTER_INCREMENT("output_segments_num", _output_rowset->num_segments());
-    TRACE("output rowset built");
-
-    // 3. check correctness, commented for this moment.
-    RETURN_IF_ERROR(check_correctness(stats));
-    TRACE("check correctness finished");
+    return Status::OK();
+}
 
-    // 4. modify rowsets in memory
-    RETURN_IF_ERROR(modify_rowsets());
-    TRACE("modify rowsets finished");
+// Reads the first and the last key of the segment into a chunk of 2 rows.
+static Status read_segment_key_bounds(Segment* segment, const Schema& key_schema, ChunkPtr* bounds) {
+    OlapReaderStatistics stats;
+    *bounds = ChunkHelper::new_chunk(key_schema, 2);
+    for (rowid_t rowid : {(rowid_t)0, (rowid_t)(segment->num_rows() - 1)}) {
+        SegmentReadOptions opts;
+        opts.stats = &stats;
+        opts.chunk_size = 1;
+        opts.rowid_range = Range(rowid, rowid + 1);
+        ASSIGN_OR_RETURN(auto iter, segment->new_iterator(key_schema, opts));
+        auto chunk = ChunkHelper::new_chunk(key_schema, 1);
+        Status st = iter->get_next(chunk.get());
+        iter->close();
+        RETURN_IF_ERROR(st);
+        if (chunk->num_rows() != 1) {
+            return Status::InternalError(fmt::format("fail to read row {} of segment {}", rowid, segment->file_name()));
+        }
+        (*bounds)->append(*chunk);
+    }
+    return Status::OK();
+}
 
-    // 5. update last success compaction time
-    int64_t now = UnixMillis();
-    if (compaction_type() == ReaderType::READER_CUMULATIVE_COMPACTION) {
-        _tablet->set_last_cumu_compaction_success_time(now);
-    } else {
-        _tablet->set_last_base_compaction_success_time(now);
+static int compare_key_row(const Chunk& lhs, size_t lhs_row, const Chunk& rhs, size_t rhs_row) {
+    for (size_t i = 0; i < lhs.num_columns(); i++) {
+        int r = lhs.get_column_by_index(i)->compare_at(lhs_row, rhs_row, *rhs.get_column_by_index(i), -1);
+        if (r != 0) {
+            return r;
+        }
     }
+    return 0;
+}
 
-    LOG(INFO) << "succeed to do " << compaction_name() << ". tablet=" << _tablet->tablet_id()
-              << ", output_version=" << _output_version.first << "-" << _output_version.second
-              << ", input infos [segments=" << segments_num << ", rows=" << _input_row_num
-              << ", disk size=" << _input_rowsets_size << "]"
-              << ", output infos [segments=" << _output_rowset->num_segments()
-              << ", rows=" << _output_rowset->num_rows() << ", disk size=" << _output_rowset->data_disk_size() << "]"
-              << ". elapsed time=" << watch.get_elapse_second() << "s.";
+StatusOr<bool> Compaction::_can_link_segments() {
+    std::vector<uint32_t> key_cids(_tablet->num_key_columns());
+    std::iota(key_cids.begin(), key_cids.end(), 0);
+    Schema key_schema = ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema(), key_cids);
+    std::vector<LinkedSegment> segments;
+    for (auto& rowset : _input_rowsets) {
+        // the rows of a rowset with deletes have to be filtered.
+        if (rowset->rowset_meta()->rowset_type() != BETA_ROWSET || rowset->rowset_meta()->has_delete_predicate()) {
+            return false;
+        }
+        if (rowset->num_segments() > 1 && rowset->rowset_meta()->segments_overlap() != NONOVERLAPPING) {
+            return false;
+        }
+        RETURN_IF_ERROR(rowset->load());
+        auto* beta_rowset = down_cast<BetaRowset*>(rowset.get());
+        for (size_t i = 0; i < beta_rowset->segments().size(); i++) {
+            auto& segment = beta_rowset->segments()[i];
+            LinkedSegment& linked = segments.emplace_back();
+            linked.path = BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), i);
+            if (segment->num_rows() > 0) {
+                RETURN_IF_ERROR(read_segment_key_bounds(segment.get(), key_schema, &linked.key_bounds));
+            }
+        }
+    }
+    // the output segments are in the order of their keys, the empty ones go last.
+    std::stable_sort(segments.begin(), segments.end(), [](const LinkedSegment& lhs, const LinkedSegment& rhs) {
+        if (lhs.key_bounds == nullptr || rhs.key_bounds == nullptr) {
+            return lhs.key_bounds != nullptr && rhs.key_bounds == nullptr;
+        }
+        return compare_key_row(*lhs.key_bounds, 0, *rhs.key_bounds, 0) < 0;
+    });
+    for (size_t i = 1; i < segments.size() && segments[i].key_bounds != nullptr; i++) {
+        // no key is shared by two segments, so no row needs to be merged with another.
+        if (compare_key_row(*segments[i - 1].key_bounds, 1, *segments[i].key_bounds, 0) >= 0) {
+            return false;
+        }
+    }
+    _linked_segments = std::move(segments);
+    return true;
+}
 
-    // warm-up this rowset
-    st = _output_rowset->load();
-    // only log load failure
-    LOG_IF(WARNING, !st.ok()) << "ignore load rowset error tablet:" << _tablet->tablet_id()
-                              << " rowset:" << _output_rowset->rowset_id() << " " << st;
+Status Compaction::_link_segments(Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("link_segments_latency_us");
+    RowsetId rowset_id = StorageEngine::instance()->next_rowset_id();
+    const std::string& dir = _tablet->schema_hash_path();
+    Env* env = Env::Default();
+    std::vector<std::string> linked_paths;
+    Status st;
+    for (size_t i = 0; i < _linked_segments.size() && st.ok(); i++) {
+        std::string dst_path = BetaRowset::segment_file_path(dir, rowset_id, i);
+        st = env->link_file(_linked_segments[i].path, dst_path);
+        if (st.ok()) {
+            linked_paths.emplace_back(std::move(dst_path));
+        }
+    }
+    if (st.ok()) {
+        st = env->sync_dir(dir);
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "fail to link segments of " << compaction_name() << ". tablet=" << _tablet->tablet_id()
+                     << ", err=" << st;
+        for (const auto& path : linked_paths) {
+            WARN_IF_ERROR(env->delete_file(path), "fail to remove linked segment " + path);
+        }
+        return st;
+    }
 
+    int64_t total_disk_size = 0;
+    int64_t data_disk_size = 0;
+    int64_t index_disk_size = 0;
+    int64_t total_row_size = 0;
+    for (auto& rowset : _input_rowsets) {
+        total_disk_size += rowset->rowset_meta()->total_disk_size();
+        data_disk_size += rowset->rowset_meta()->data_disk_size();
+        index_disk_size += rowset->rowset_meta()->index_disk_size();
+        total_row_size += rowset->total_row_size();
+    }
+    auto rowset_meta = std::make_shared<RowsetMeta>();
+    rowset_meta->set_rowset_id(rowset_id);
+    rowset_meta->set_partition_id(_tablet->partition_id());
+    rowset_meta->set_tablet_id(_tablet->tablet_id());
+    rowset_meta->set_tablet_schema_hash(_tablet->schema_hash());
+    rowset_meta->set_tablet_uid(_tablet->tablet_uid());
+    rowset_meta->set_rowset_type(BETA_ROWSET);
+    rowset_meta->set_rowset_state(VISIBLE);
+    rowset_meta->set_version(_output_version);
+    rowset_meta->set_segments_overlap(NONOVERLAPPING);
+    rowset_meta->set_num_rows(_input_row_num);
+    rowset_meta->set_total_row_size(total_row_size);
+    rowset_meta->set_total_disk_size(total_disk_size);
+    rowset_meta->set_data_disk_size(data_disk_size);
+    rowset_meta->set_index_disk_size(index_disk_size);
+    rowset_meta->set_empty(_input_row_num == 0);
+    rowset_meta->set_creation_time(time(nullptr));
+    rowset_meta->set_num_segments(_linked_segments.size());
+    rowset_meta->set_rowset_seg_id(0);
+    RETURN_IF_ERROR(RowsetFactory::create_rowset(&_tablet->tablet_schema(), dir, rowset_meta, &_output_rowset));
+
+    LOG(INFO) << "link " << _linked_segments.size() << " segments to the output of " << compaction_name()
+              << ". tablet=" << _tablet->tablet_id() << ", output version=" << _output_version.first << "-"
+              << _output_version.second;
+    stats_output->output_rows = _input_row_num;
     return Status::OK();
 }
 
@@ -4,6 +4,7 @@
 
 #include <vector>
 
+#include "column/vectorized_fwd.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
 #include "storage/rowset/rowset_id_generator.h"
@@ -105,13 +106,32 @@ protected:
     RuntimeProfile _runtime_profile;
 
 private:
+    // a segment file of the input rowsets linked to the output rowset
+    struct LinkedSegment {
+        std::string path;
+        // the first and the last key of the segment, null if it's empty
+        ChunkPtr key_bounds;
+    };
+
     StatusOr<size_t> _get_segment_iterator_num();
 
+    // Writes the output rowset by merging the rows of the input rowsets.
+    Status _merge_rowsets(Statistics* stats_output);
+
+    // Whether the output rowset can be made of the segment files of the input rowsets as they are: the
+    // inputs have no delete predicates, and no key is shared by two segments. The segments are kept in
+    // `_linked_segments` in the order of their keys when it's true.
+    StatusOr<bool> _can_link_segments();
+    // Links the segment files in `_linked_segments` to the output rowset, no row is rewritten.
+    Status _link_segments(Statistics* stats_output);
+
     // merge rows from vectorized reader and write into `_output_rs_writer`.
     // return Status::OK() and set statistics into `*stats_output`.
     // return others on error
     Status _merge_rowsets_horizontally(size_t segment_iterator_num, Statistics* stats_output);
     Status _merge_rowsets_vertically(size_t segment_iterator_num, Statistics* stats_output);
+
+    std::vector<LinkedSegment> _linked_segments;
 };
 
 } // namespace starrocks::vectorized
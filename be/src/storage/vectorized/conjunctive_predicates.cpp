@@ -3,6 +3,7 @@
 #include "storage/vectorized/conjunctive_predicates.h"
 
 #include "column/chunk.h"
+#include "simd/simd.h"
 
 namespace starrocks::vectorized {
 
@@ -65,10 +66,7 @@ inline void ConjunctivePredicates::_evaluate_non_vec(const Chunk* chunk, uint8_t
         _selected_idx.resize(to - from);
         uint16_t selected_size = 0;
         if (!_vec_preds.empty()) {
-            for (uint16_t i = from; i < to; ++i) {
-                _selected_idx[selected_size] = i;
-                selected_size += selection[i];
-            }
+            selected_size = SIMD::to_index<uint16_t>(selection + from, to - from, from, _selected_idx.data());
         } else {
             // when there is no vectorized predicates, should initialize _selected_idx
             // in a vectorized way.
@@ -199,6 +199,7 @@ Status DeltaWriter::write(const Chunk& chunk, const uint32_t* indexes, uint32_t
                 fmt::format("Fail to write delta. tablet_id: {}, state: {}", _opt.tablet_id, _state_name(state)));
     case kWriting:
         bool full = _mem_table->insert(chunk, indexes, from, size);
+        _memtable_memory_usage.store(_mem_table->memory_usage(), std::memory_order_relaxed);
         if (_mem_tracker->limit_exceeded()) {
             VLOG(2) << "Flushing memory table due to memory limit exceeded";
             st = _flush_memtable();
@@ -232,12 +233,26 @@ Status DeltaWriter::close() {
         return Status::OK();
     case kWriting:
         st = _flush_memtable_async();
+        _memtable_memory_usage.store(0, std::memory_order_relaxed);
         _set_state(st.ok() ? kClosed : kAborted);
         return st;
     }
     return Status::OK();
 }
 
+Status DeltaWriter::flush_memtable_async() {
+    SCOPED_THREAD_LOCAL_MEM_SETTER(_mem_tracker, false);
+    if (_get_state() != kWriting || _mem_table->write_buffer_size() == 0) {
+        return Status::OK();
+    }
+    Status st = _flush_memtable_async();
+    _reset_mem_table();
+    if (!st.ok()) {
+        _set_state(kAborted);
+    }
+    return st;
+}
+
 Status DeltaWriter::_flush_memtable_async() {
     RETURN_IF_ERROR(_mem_table->finalize());
     return _flush_token->submit(std::move(_mem_table));
@@ -251,6 +266,7 @@ Status DeltaWriter::_flush_memtable() {
 void DeltaWriter::_reset_mem_table() {
     _mem_table = std::make_unique<MemTable>(_tablet->tablet_id(), _tablet_schema, _opt.slots, _rowset_writer.get(),
                                             _mem_tracker);
+    _memtable_memory_usage.store(0, std::memory_order_relaxed);
 }
 
 Status DeltaWriter::commit() {
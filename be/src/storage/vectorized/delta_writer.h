@@ -49,6 +49,11 @@ public:
     // [NOT thread-safe]
     [[nodiscard]] Status write(const Chunk& chunk, const uint32_t* indexes, uint32_t from, uint32_t size);
 
+    // Flush the current memtable to disk without waiting, the following `write()`s go to a new memtable.
+    // Does nothing if the memtable is empty or the writer is not writing.
+    // [NOT thread-safe]
+    [[nodiscard]] Status flush_memtable_async();
+
     // Flush all in-memory data to disk, without waiting.
     // Subsequent `write()`s to this DeltaWriter will fail after this method returned.
     // [NOT thread-safe]
@@ -73,6 +78,10 @@ public:
 
     MemTracker* mem_tracker() { return _mem_tracker; };
 
+    // Memory used by the memtable being written.
+    // [thread-safe]
+    size_t memtable_memory_usage() const { return _memtable_memory_usage.load(std::memory_order_relaxed); }
+
     // Return the rowset created by `commit()`, or nullptr if `commit()` not been called or failed.
     const Rowset* committed_rowset() const { return _cur_rowset.get(); }
 
@@ -118,6 +127,7 @@ private:
     RowsetSharedPtr _cur_rowset;
     std::unique_ptr<RowsetWriter> _rowset_writer;
     std::unique_ptr<MemTable> _mem_table;
+    std::atomic<size_t> _memtable_memory_usage{0};
     const TabletSchema* _tablet_schema;
 
     std::unique_ptr<FlushToken> _flush_token;
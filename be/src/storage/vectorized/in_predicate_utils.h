@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "column/fixed_value_set.h"
 #include "column/hash_set.h"
 #include "storage/types.h"
 #include "util/string_parser.hpp"
@@ -9,11 +10,16 @@
 namespace starrocks::vectorized {
 
 namespace in_pred_utils_detail {
-template <typename T>
+template <typename T, typename Enable = void>
 struct PHashSetTraits {
     using SetType = HashSet<T>;
 };
 
+template <typename T>
+struct PHashSetTraits<T, std::enable_if_t<std::is_integral_v<T>>> {
+    using SetType = FixedValueSet<T>;
+};
+
 template <>
 struct PHashSetTraits<Slice> {
     using SetType = SliceNormalHashSet;
@@ -26,6 +32,17 @@ using PHashSet = typename PHashSetTraits<T>::SetType;
 template <typename T>
 struct ItemHashSet : public in_pred_utils_detail::PHashSet<T> {
     bool contains(const T& v) const { return in_pred_utils_detail::PHashSet<T>::contains(v); }
+
+    // Sets `out[i]` to whether `values[i]` is in the set.
+    void contains(const T* values, size_t size, uint8_t* out) const {
+        if constexpr (std::is_integral_v<T>) {
+            in_pred_utils_detail::PHashSet<T>::contains(values, size, out);
+        } else {
+            for (size_t i = 0; i < size; i++) {
+                out[i] = contains(values[i]);
+            }
+        }
+    }
 };
 
 template <typename T, size_t N>
@@ -3,6 +3,7 @@
 #include "storage/vectorized/memtable.h"
 
 #include <memory>
+#include <queue>
 
 #include "column/json_column.h"
 #include "column/type_traits.h"
@@ -22,6 +23,8 @@ namespace starrocks::vectorized {
 // TODO(cbl): move to common space latter
 static const string LOAD_OP_COLUMN = "__op";
 static const size_t kPrimaryKeyLimitSize = 128;
+// merging more runs than this costs about as much as sorting the whole chunk.
+static const size_t kMaxSortedRuns = 8;
 
 MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const std::vector<SlotDescriptor*>* slot_descs,
                    RowsetWriter* rowset_writer, MemTracker* mem_tracker)
@@ -85,6 +88,7 @@ bool MemTable::insert(const Chunk& chunk, const uint32_t* indexes, uint32_t from
     if (_chunk == nullptr) {
         _chunk = ChunkHelper::new_chunk(_vectorized_schema, 0);
     }
+    size_t old_rows = _chunk->num_rows();
 
     // For schema change, FE will construct a shadow column.
     // The shadow column is not exist in _vectorized_schema
@@ -95,6 +99,7 @@ bool MemTable::insert(const Chunk& chunk, const uint32_t* indexes, uint32_t from
         ColumnPtr& dest = _chunk->get_column_by_index(i);
         dest->append_selective(*src, indexes, from, size);
     }
+    _update_sorted_runs(old_rows);
 
     if (chunk.has_rows()) {
         _chunk_memory_usage += chunk.memory_usage() * size / chunk.num_rows();
@@ -141,6 +146,8 @@ Status MemTable::finalize() {
             if (_merge_count > 1) {
                 _chunk = _aggregator->aggregate_result();
                 _aggregator->aggregate_reset();
+                // the result of each merge is sorted, so the final sort only merges them.
+                _update_sorted_runs(0);
 
                 int64_t t1 = MonotonicMicros();
                 _sort(true);
@@ -201,6 +208,7 @@ Status MemTable::flush() {
     }
     StarRocksMetrics::instance()->memtable_flush_total.increment(1);
     StarRocksMetrics::instance()->memtable_flush_duration_us.increment(duration_ns / 1000);
+    StarRocksMetrics::instance()->memtable_flush_latency_us.observe(duration_ns / 1000);
     VLOG(1) << "memtable flush: " << duration_ns / 1000 << "us";
     return Status::OK();
 }
@@ -251,7 +259,9 @@ void MemTable::_sort(bool is_final) {
     for (uint32_t i = 0; i < _chunk->num_rows(); ++i) {
         _permutations[i] = {i, i};
     }
-    if (_tablet_schema->num_key_columns() <= 3) {
+    if (!_too_many_sorted_runs) {
+        _merge_sorted_runs();
+    } else if (_tablet_schema->num_key_columns() <= 3) {
         _sort_chunk_by_columns();
     } else {
         _sort_chunk_by_rows();
@@ -263,10 +273,78 @@ void MemTable::_sort(bool is_final) {
     } else {
         _chunk->reset();
     }
+    _sorted_run_starts.clear();
+    _too_many_sorted_runs = false;
     _chunk_memory_usage = 0;
     _chunk_bytes_usage = 0;
 }
 
+int MemTable::_compare_keys(uint32_t l, uint32_t r) const {
+    size_t col_number = _tablet_schema->num_key_columns();
+    for (size_t col_index = 0; col_index < col_number; ++col_index) {
+        const auto& col = _chunk->get_column_by_index(col_index);
+        int compare_result = col->compare_at(l, r, *col, -1);
+        if (compare_result != 0) {
+            return compare_result;
+        }
+    }
+    return 0;
+}
+
+// Called after new rows are appended to _chunk starting at |from_row|.
+void MemTable::_update_sorted_runs(size_t from_row) {
+    if (_too_many_sorted_runs) {
+        return;
+    }
+    size_t num_rows = _chunk->num_rows();
+    for (size_t i = std::max<size_t>(from_row, 1); i < num_rows; ++i) {
+        // equal keys stay in the same run, so that the merge keeps them in the order they arrived.
+        if (_compare_keys(i - 1, i) > 0) {
+            if (_sorted_run_starts.size() + 1 >= kMaxSortedRuns) {
+                _too_many_sorted_runs = true;
+                _sorted_run_starts.clear();
+                return;
+            }
+            _sorted_run_starts.push_back(i);
+        }
+    }
+}
+
+// Merges the sorted runs of _chunk into _permutations, ties are taken from the earlier run to keep the merge
+// stable as the aggregator expects.
+void MemTable::_merge_sorted_runs() {
+    if (_sorted_run_starts.empty()) {
+        // _chunk is sorted already, the identity permutation is the result.
+        return;
+    }
+    struct Cursor {
+        uint32_t pos;
+        uint32_t end;
+        uint32_t run;
+    };
+    auto greater = [this](const Cursor& l, const Cursor& r) {
+        int c = _compare_keys(l.pos, r.pos);
+        return c != 0 ? c > 0 : l.run > r.run;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heap(greater);
+    uint32_t start = 0;
+    for (uint32_t run = 0; run <= _sorted_run_starts.size(); ++run) {
+        uint32_t end = run < _sorted_run_starts.size() ? _sorted_run_starts[run] : _chunk->num_rows();
+        heap.push({start, end, run});
+        start = end;
+    }
+    uint32_t i = 0;
+    while (!heap.empty()) {
+        Cursor c = heap.top();
+        heap.pop();
+        _permutations[i] = {c.pos, i};
+        ++i;
+        if (++c.pos < c.end) {
+            heap.push(c);
+        }
+    }
+}
+
 void MemTable::_append_to_sorted_chunk(Chunk* src, Chunk* dest) {
     _selective_values.clear();
     _selective_values.reserve(src->num_rows());
@@ -46,6 +46,9 @@ private:
     void _merge();
 
     void _sort(bool is_final);
+    int _compare_keys(uint32_t l, uint32_t r) const;
+    void _update_sorted_runs(size_t from_row);
+    void _merge_sorted_runs();
     void _sort_chunk_by_columns();
     void _sort_chunk_by_rows();
     void _append_to_sorted_chunk(Chunk* src, Chunk* dest);
@@ -71,6 +74,12 @@ private:
     std::vector<uint32_t> _selective_values;
     Schema _vectorized_schema;
 
+    // Rows of _chunk usually arrive in key order already, e.g. loads from sorted files, so _chunk is tracked
+    // as a few sorted runs: _sorted_run_starts holds the first row of each run but the first one. While the
+    // number of runs stays small, the runs are merged instead of doing a full sort.
+    std::vector<uint32_t> _sorted_run_starts;
+    bool _too_many_sorted_runs = false;
+
     int64_t _tablet_id;
     const TabletSchema* _tablet_schema;
     // the slot in _slot_descs are in order of tablet's schema
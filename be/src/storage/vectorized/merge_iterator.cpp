@@ -2,6 +2,7 @@
 
 #include "storage/vectorized/merge_iterator.h"
 
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -68,9 +69,42 @@ public:
         return (r < 0) | ((r == 0) & (_order < rhs._order));
     }
 
+    // return the number of the rows from the compared row of |this| chunk on, at most |max_rows|, that are
+    // ordered before the compared row of |rhs|, i.e, the run that can be output without touching the heap.
+    // assume the compared row of |this| is ordered before that of |rhs|.
+    // The end of the run is found by galloping and then a binary search, so a run of n rows costs O(log n)
+    // comparisons, and a single row, the common case of the heavily interleaved children, costs one.
+    size_t run_before(const ComparableChunk& rhs, size_t max_rows) const {
+        size_t end = std::min<size_t>(_chunk->num_rows(), _compared_row + max_rows);
+        // |lo| is ordered before |rhs|, |hi| is not or is the end
+        size_t lo = _compared_row;
+        size_t hi = end;
+        for (size_t step = 1; lo + step < end; step <<= 1) {
+            if (!_row_before(lo + step, rhs)) {
+                hi = lo + step;
+                break;
+            }
+            lo += step;
+        }
+        while (lo + 1 < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (_row_before(mid, rhs)) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo + 1 - _compared_row;
+    }
+
 private:
     friend class HeapMergeIterator;
 
+    bool _row_before(size_t row, const ComparableChunk& rhs) const {
+        int r = compare_chunk(_key_columns, *_chunk, row, *rhs._chunk, rhs._compared_row);
+        return (r < 0) | ((r == 0) & (_order < rhs._order));
+    }
+
     // used to determinate the order of two rows when their key columns are all equals.
     uint16_t _order;
     uint16_t _key_columns;
@@ -209,11 +243,14 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk, std::vector<RowSource
             }
         }
 
-        chunk->append(*min_chunk._chunk, offset, 1);
-        min_chunk.advance(1);
-        rows += 1;
+        // copy all the rows of |min_chunk| before the next smallest chunk at once
+        size_t run = _heap.empty() ? std::min(min_chunk.remaining_rows(), _chunk_size - rows)
+                                   : min_chunk.run_before(_heap.top(), _chunk_size - rows);
+        chunk->append(*min_chunk._chunk, offset, run);
+        min_chunk.advance(run);
+        rows += run;
         if (source_masks) {
-            source_masks->emplace_back(RowSourceMask{min_chunk._order, false});
+            source_masks->insert(source_masks->end(), run, RowSourceMask{min_chunk._order, false});
         }
         if (min_chunk.remaining_rows() > 0) {
             _heap.push(min_chunk);
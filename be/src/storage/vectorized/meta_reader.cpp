@@ -2,19 +2,76 @@
 
 #include "storage/vectorized/meta_reader.h"
 
+#include <algorithm>
 #include <vector>
 
+#include "column/column_helper.h"
 #include "column/datum_convert.h"
+#include "column/nullable_column.h"
 #include "common/status.h"
+#include "storage/del_vector.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/column_reader.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/tablet_reader.h"
 
 namespace starrocks::vectorized {
 
-std::vector<std::string> SegmentMetaCollecter::support_collect_fields = {"dict_merge", "max", "min"};
+std::vector<std::string> SegmentMetaCollecter::support_collect_fields = {"dict_merge", "max", "min", "count"};
+
+// Appends a row not changing the result of the field: an empty dict, a null max or min, or 0 rows.
+static Status append_neutral_row(const std::string& field, vectorized::Column* column) {
+    if (field == "dict_merge" || field == "count") {
+        column->append_default();
+        return Status::OK();
+    }
+    if (!column->append_nulls(1)) {
+        return Status::InternalError("not nullable column of " + field);
+    }
+    return Status::OK();
+}
+
+// Keeps the max or min value not null of |column| in |best|, a column of a single row.
+template <bool is_max>
+static void update_max_or_min(const vectorized::Column& column, vectorized::ColumnPtr* best) {
+    const NullData* nulls = nullptr;
+    const vectorized::Column* data_column = &column;
+    if (column.is_nullable()) {
+        const auto& nullable_column = down_cast<const vectorized::NullableColumn&>(column);
+        nulls = &nullable_column.immutable_null_column_data();
+        data_column = nullable_column.data_column().get();
+    }
+    int64_t best_row = -1;
+    for (size_t i = 0; i < data_column->size(); ++i) {
+        if (nulls != nullptr && (*nulls)[i]) {
+            continue;
+        }
+        if (best_row < 0) {
+            best_row = i;
+            continue;
+        }
+        int cmp = data_column->compare_at(i, best_row, *data_column, 1);
+        if (is_max ? cmp > 0 : cmp < 0) {
+            best_row = i;
+        }
+    }
+    if (best_row < 0) {
+        return;
+    }
+    if (*best != nullptr) {
+        int cmp = data_column->compare_at(best_row, 0, **best, 1);
+        if (!(is_max ? cmp > 0 : cmp < 0)) {
+            return;
+        }
+    }
+    vectorized::ColumnPtr value = data_column->clone_empty();
+    value->append(*data_column, best_row, 1);
+    *best = std::move(value);
+}
 
 Status SegmentMetaCollecter::parse_field_and_colname(const std::string& item, std::string* field,
                                                      std::string* col_name) {
@@ -104,11 +161,14 @@ Status MetaReader::_build_collect_context(const MetaReaderParams& read_params) {
 }
 
 Status MetaReader::_init_seg_meta_collecters(const MetaReaderParams& params) {
+    std::vector<RowsetSharedPtr> rowsets;
     std::vector<SegmentSharedPtr> segments;
-    RETURN_IF_ERROR(_get_segments(params.tablet, params.version, &segments));
+    std::vector<size_t> num_deleted_rows;
+    RETURN_IF_ERROR(_get_segments(params.tablet, params.version, &rowsets, &segments, &num_deleted_rows));
+    _init_read_rows(rowsets, num_deleted_rows);
 
-    for (auto& segment : segments) {
-        SegmentMetaCollecter* seg_collecter = new SegmentMetaCollecter(segment);
+    for (size_t i = 0; i < segments.size(); i++) {
+        SegmentMetaCollecter* seg_collecter = new SegmentMetaCollecter(segments[i], num_deleted_rows[i]);
         _obj_pool.add(seg_collecter);
 
         RETURN_IF_ERROR(seg_collecter->init(&_collect_context.seg_collecter_params));
@@ -118,18 +178,65 @@ Status MetaReader::_init_seg_meta_collecters(const MetaReaderParams& params) {
     return Status::OK();
 }
 
-Status MetaReader::_get_segments(const TabletSharedPtr& tablet, const Version& version,
-                                 std::vector<SegmentSharedPtr>* segments) {
-    if (tablet->updates() != nullptr) {
-        LOG(INFO) << "Skipped Update tablet";
-        return Status::OK();
+void MetaReader::_init_read_rows(const std::vector<RowsetSharedPtr>& rowsets,
+                                 const std::vector<size_t>& num_deleted_rows) {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    const KeysType keys_type = tablet_schema.keys_type();
+
+    // the rows of the rowsets older than a delete predicate may be deleted
+    bool has_delete_predicate = false;
+    {
+        std::shared_lock l(_tablet->get_header_lock());
+        for (const DeletePredicatePB& pred_pb : _tablet->delete_predicates()) {
+            if (pred_pb.version() > _version.second) {
+                continue;
+            }
+            for (const auto& rowset : rowsets) {
+                has_delete_predicate |= !rowset->zero_num_rows() && rowset->end_version() < pred_pb.version();
+            }
+        }
+    }
+    bool has_delete_vector = std::any_of(num_deleted_rows.begin(), num_deleted_rows.end(),
+                                         [](size_t n) { return n > 0; });
+    // The rows of the same keys are merged on read, unless all of them are in one rowset whose segments
+    // don't overlap, which has been merged already.
+    size_t num_data_rowsets = 0;
+    bool overlapping = false;
+    for (const auto& rowset : rowsets) {
+        if (!rowset->zero_num_rows()) {
+            num_data_rowsets++;
+            overlapping |= rowset->rowset_meta()->num_segments() > 1 &&
+                           rowset->rowset_meta()->segments_overlap() != NONOVERLAPPING;
+        }
+    }
+    bool merged = (keys_type == AGG_KEYS || keys_type == UNIQUE_KEYS) && (num_data_rowsets > 1 || overlapping);
+
+    auto& params = _collect_context.seg_collecter_params;
+    params.read_rows.assign(params.fields.size(), false);
+    for (size_t i = 0; i < params.fields.size(); i++) {
+        const std::string& field = params.fields[i];
+        bool read_rows = false;
+        if (field == "count") {
+            // the rows deleted by the delete vectors are subtracted from the row counts
+            read_rows = has_delete_predicate || merged;
+        } else if (field == "max" || field == "min") {
+            // the keys are the same after merging
+            bool is_key = params.cids[i] < tablet_schema.num_key_columns();
+            read_rows = has_delete_predicate || has_delete_vector || (merged && !is_key);
+        }
+        // a dict of more words than the rows have is fine
+        params.read_rows[i] = read_rows;
+        _need_read_rows |= read_rows;
     }
+}
 
-    std::vector<RowsetSharedPtr> rowsets;
+Status MetaReader::_get_segments(const TabletSharedPtr& tablet, const Version& version,
+                                 std::vector<RowsetSharedPtr>* rowsets, std::vector<SegmentSharedPtr>* segments,
+                                 std::vector<size_t>* num_deleted_rows) {
     Status acquire_rowset_st;
     {
         std::shared_lock l(tablet->get_header_lock());
-        acquire_rowset_st = tablet->capture_consistent_rowsets(_version, &rowsets);
+        acquire_rowset_st = tablet->capture_consistent_rowsets(_version, rowsets);
     }
 
     if (!acquire_rowset_st.ok()) {
@@ -139,11 +246,22 @@ Status MetaReader::_get_segments(const TabletSharedPtr& tablet, const Version& v
         return Status::InternalError(ss.str().c_str());
     }
 
-    for (auto& rs : rowsets) {
+    for (auto& rs : *rowsets) {
         RETURN_IF_ERROR(rs->load());
         auto beta_rowset = down_cast<BetaRowset*>(rs.get());
         for (auto seg : beta_rowset->segments()) {
+            size_t deleted = 0;
+            if (tablet->updates() != nullptr) {
+                TabletSegmentId tsid;
+                tsid.tablet_id = tablet->tablet_id();
+                tsid.segment_id = rs->rowset_meta()->get_rowset_seg_id() + seg->id();
+                DelVectorPtr del_vec;
+                RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_del_vec(
+                        tablet->data_dir()->get_meta(), tsid, version.second, &del_vec));
+                deleted = del_vec != nullptr ? del_vec->cardinality() : 0;
+            }
             segments->emplace_back(seg);
+            num_deleted_rows->emplace_back(deleted);
         }
     }
 
@@ -208,6 +326,12 @@ Status MetaReader::_read(Chunk* chunk, size_t n) {
     size_t remaining = n;
     while (remaining > 0) {
         if (_collect_context.cursor_idx >= _collect_context.seg_collecters.size()) {
+            if (_need_read_rows && !_rows_read) {
+                RETURN_IF_ERROR(_read_rows(columns));
+                _rows_read = true;
+                remaining--;
+                continue;
+            }
             _has_more = false;
             return Status::OK();
         }
@@ -219,11 +343,78 @@ Status MetaReader::_read(Chunk* chunk, size_t n) {
     return Status::OK();
 }
 
+Status MetaReader::_read_rows(const std::vector<vectorized::Column*>& dsts) {
+    const auto& params = _collect_context.seg_collecter_params;
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    // the keys are read too for the rows to be merged
+    std::vector<ColumnId> cids;
+    if (tablet_schema.keys_type() == AGG_KEYS || tablet_schema.keys_type() == UNIQUE_KEYS) {
+        for (ColumnId cid = 0; cid < tablet_schema.num_key_columns(); cid++) {
+            cids.push_back(cid);
+        }
+    }
+    for (size_t i = 0; i < params.fields.size(); i++) {
+        if (params.read_rows[i]) {
+            cids.push_back(params.cids[i]);
+        }
+    }
+    std::sort(cids.begin(), cids.end());
+    cids.erase(std::unique(cids.begin(), cids.end()), cids.end());
+
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, cids);
+    TabletReader reader(_tablet, _version, schema);
+    RETURN_IF_ERROR(reader.prepare());
+    TabletReaderParams reader_params;
+    reader_params.reader_type = READER_QUERY;
+    reader_params.chunk_size = _chunk_size;
+    reader_params.runtime_state = _params.runtime_state;
+    RETURN_IF_ERROR(reader.open(reader_params));
+
+    std::vector<ColumnPtr> bests(params.fields.size());
+    int64_t num_rows = 0;
+    auto chunk = ChunkHelper::new_chunk(schema, _chunk_size);
+    while (true) {
+        chunk->reset();
+        Status st = reader.get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        num_rows += chunk->num_rows();
+        for (size_t i = 0; i < params.fields.size(); i++) {
+            if (!params.read_rows[i] || params.fields[i] == "count") {
+                continue;
+            }
+            size_t pos = std::lower_bound(cids.begin(), cids.end(), params.cids[i]) - cids.begin();
+            const ColumnPtr& column = chunk->get_column_by_index(pos);
+            if (params.fields[i] == "max") {
+                update_max_or_min<true>(*column, &bests[i]);
+            } else {
+                update_max_or_min<false>(*column, &bests[i]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < params.fields.size(); i++) {
+        if (!params.read_rows[i]) {
+            RETURN_IF_ERROR(append_neutral_row(params.fields[i], dsts[i]));
+        } else if (params.fields[i] == "count") {
+            dsts[i]->append_datum(vectorized::Datum(num_rows));
+        } else if (bests[i] == nullptr) {
+            RETURN_IF_ERROR(append_neutral_row(params.fields[i], dsts[i]));
+        } else {
+            dsts[i]->append_datum(bests[i]->get(0));
+        }
+    }
+    return Status::OK();
+}
+
 bool MetaReader::has_more() {
     return _has_more;
 }
 
-SegmentMetaCollecter::SegmentMetaCollecter(SegmentSharedPtr segment) : _segment(segment) {}
+SegmentMetaCollecter::SegmentMetaCollecter(SegmentSharedPtr segment, size_t num_deleted_rows)
+        : _segment(std::move(segment)), _num_deleted_rows(num_deleted_rows) {}
 
 SegmentMetaCollecter::~SegmentMetaCollecter() {}
 
@@ -267,6 +458,10 @@ Status SegmentMetaCollecter::collect(std::vector<vectorized::Column*>* dsts) {
     DCHECK_EQ(dsts->size(), _params->fields.size());
 
     for (size_t i = 0; i < _params->fields.size(); i++) {
+        if (_params->read_rows[i]) {
+            RETURN_IF_ERROR(append_neutral_row(_params->fields[i], (*dsts)[i]));
+            continue;
+        }
         RETURN_IF_ERROR(_collect(_params->fields[i], _params->cids[i], (*dsts)[i], _params->field_type[i]));
     }
     return Status::OK();
@@ -280,6 +475,8 @@ Status SegmentMetaCollecter::_collect(const std::string& name, ColumnId cid, vec
         return _collect_max(cid, column, type);
     } else if (name == "min") {
         return _collect_min(cid, column, type);
+    } else if (name == "count") {
+        return _collect_count(column);
     }
     return Status::NotSupported("Not Support Collect Meta: " + name);
 }
@@ -323,6 +520,11 @@ Status SegmentMetaCollecter::_collect_min(ColumnId cid, vectorized::Column* colu
     return __collect_max_or_min<false>(cid, column, type);
 }
 
+Status SegmentMetaCollecter::_collect_count(vectorized::Column* column) {
+    column->append_datum(vectorized::Datum(static_cast<int64_t>(_segment->num_rows() - _num_deleted_rows)));
+    return Status::OK();
+}
+
 template <bool is_max>
 Status SegmentMetaCollecter::__collect_max_or_min(ColumnId cid, vectorized::Column* column, FieldType type) {
     if (cid >= _segment->num_columns()) {
@@ -336,20 +538,15 @@ Status SegmentMetaCollecter::__collect_max_or_min(ColumnId cid, vectorized::Colu
         return Status::InternalError("column type mismatch");
     }
     const ZoneMapPB* segment_zone_map_pb = col_reader->segment_zone_map();
-    TypeInfoPtr type_info = get_type_info(delegate_type(type));
-    if constexpr (!is_max) {
-        vectorized::Datum min;
-        if (!segment_zone_map_pb->has_null()) {
-            RETURN_IF_ERROR(vectorized::datum_from_string(type_info.get(), &min, segment_zone_map_pb->min(), nullptr));
-            column->append_datum(min);
-        }
-    } else if constexpr (is_max) {
-        vectorized::Datum max;
-        if (segment_zone_map_pb->has_not_null()) {
-            RETURN_IF_ERROR(vectorized::datum_from_string(type_info.get(), &max, segment_zone_map_pb->max(), nullptr));
-            column->append_datum(max);
-        }
+    // the zone map is of the values not null, one row is given for each segment
+    if (!segment_zone_map_pb->has_not_null()) {
+        return append_neutral_row(is_max ? "max" : "min", column);
     }
+    TypeInfoPtr type_info = get_type_info(delegate_type(type));
+    vectorized::Datum value;
+    const std::string& str = is_max ? segment_zone_map_pb->max() : segment_zone_map_pb->min();
+    RETURN_IF_ERROR(vectorized::datum_from_string(type_info.get(), &value, str, nullptr));
+    column->append_datum(value);
     return Status::OK();
 }
 
@@ -58,6 +58,9 @@ struct SegmentMetaCollecterParams {
     std::vector<std::string> fields;
     std::vector<ColumnId> cids;
     std::vector<bool> read_page;
+    // The fields computed by reading the rows of the tablet, because the zone maps or the row counts of the
+    // segments may include the rows deleted or merged on read. The segments give null or 0 for them.
+    std::vector<bool> read_rows;
     std::vector<FieldType> field_type;
     int32_t max_cid;
 };
@@ -65,6 +68,10 @@ struct SegmentMetaCollecterParams {
 // MetaReader will implements
 // 1. read meta info from segment footer
 // 2. read dict info from dict page if column is dict encoding type
+// Each segment gives a row of max, min and count from its zone maps and row count, which are exact unless
+// the rows of the segments are deleted by the delete predicates, merged with the rows of the same keys in
+// the aggregate and unique keys tables, or deleted by the delete vectors of the primary keys tables. The
+// fields not exact are computed by reading the rows of the tablet, they are given by an extra row.
 class MetaReader {
 public:
     MetaReader();
@@ -108,15 +115,24 @@ private:
 
     Status _fill_result_chunk(Chunk* chunk);
 
-    Status _get_segments(const TabletSharedPtr& tablet, const Version& version,
-                         std::vector<SegmentSharedPtr>* segments);
+    // |num_deleted_rows| is the number of the rows of each segment deleted by its delete vector.
+    Status _get_segments(const TabletSharedPtr& tablet, const Version& version, std::vector<RowsetSharedPtr>* rowsets,
+                         std::vector<SegmentSharedPtr>* segments, std::vector<size_t>* num_deleted_rows);
+
+    void _init_read_rows(const std::vector<RowsetSharedPtr>& rowsets, const std::vector<size_t>& num_deleted_rows);
 
     Status _read(Chunk* chunk, size_t n);
+
+    // Appends the row of the fields computed by reading the rows of the tablet.
+    Status _read_rows(const std::vector<vectorized::Column*>& dsts);
+
+    bool _need_read_rows = false;
+    bool _rows_read = false;
 };
 
 class SegmentMetaCollecter {
 public:
-    SegmentMetaCollecter(SegmentSharedPtr segment);
+    explicit SegmentMetaCollecter(SegmentSharedPtr segment, size_t num_deleted_rows = 0);
     ~SegmentMetaCollecter();
     Status init(const SegmentMetaCollecterParams* params);
     Status open();
@@ -135,9 +151,11 @@ private:
     Status _collect_dict(ColumnId cid, vectorized::Column* column, FieldType type);
     Status _collect_max(ColumnId cid, vectorized::Column* column, FieldType type);
     Status _collect_min(ColumnId cid, vectorized::Column* column, FieldType type);
+    Status _collect_count(vectorized::Column* column);
     template <bool is_max>
     Status __collect_max_or_min(ColumnId cid, vectorized::Column* column, FieldType type);
     SegmentSharedPtr _segment;
+    size_t _num_deleted_rows = 0;
     std::vector<ColumnIterator*> _column_iterators;
     const SegmentMetaCollecterParams* _params = nullptr;
     std::unique_ptr<fs::ReadableBlock> _rblock;
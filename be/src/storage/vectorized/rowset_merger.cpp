@@ -7,6 +7,7 @@
 #include "gutil/stl_util.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset_writer.h"
+#include "storage/rowset/column_reader.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/tablet.h"
@@ -406,6 +407,7 @@ private:
         // merge key columns
         auto mask_buffer = std::make_unique<RowSourceMaskBuffer>(tablet.tablet_id(), tablet.data_dir()->path());
         {
+            _chunk_size = _get_column_group_chunk_size(rowsets, column_groups[0], cfg.chunk_size);
             Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet.tablet_schema(), column_groups[0]);
             RETURN_IF_ERROR(_do_merge_horizontally(tablet, version, schema, rowsets, writer, cfg, total_input_size,
                                                    total_rows, total_chunk, stats, mask_buffer.get()));
@@ -417,6 +419,8 @@ private:
             // read mask buffer from the beginning
             mask_buffer->flip_to_read();
 
+            _chunk_size = _get_column_group_chunk_size(rowsets, column_groups[i], cfg.chunk_size);
+            VLOG(1) << "tablet=" << tablet.tablet_id() << ", column group=" << i << ", chunk size=" << _chunk_size;
             _entries.clear();
             _entries.reserve(rowsets.size());
             vector<vectorized::ChunkIteratorPtr> iterators;
@@ -501,6 +505,28 @@ private:
         return Status::OK();
     }
 
+    // Every rowset holds a chunk of the column group while merging, so a group of wide columns reads
+    // fewer rows at a time to stay within compaction_memory_limit_per_worker.
+    static size_t _get_column_group_chunk_size(const vector<RowsetSharedPtr>& rowsets,
+                                               const vector<uint32_t>& column_group, size_t max_chunk_size) {
+        int64_t total_num_rows = 0;
+        int64_t total_mem_footprint = 0;
+        for (const auto& rowset : rowsets) {
+            total_num_rows += rowset->num_rows();
+            auto* beta_rowset = down_cast<BetaRowset*>(rowset.get());
+            for (const auto& segment : beta_rowset->segments()) {
+                for (uint32_t column_index : column_group) {
+                    const auto* column_reader = segment->column(column_index);
+                    if (column_reader != nullptr) {
+                        total_mem_footprint += column_reader->total_mem_footprint();
+                    }
+                }
+            }
+        }
+        return Compaction::get_read_chunk_size(config::compaction_memory_limit_per_worker, (int32_t)max_chunk_size,
+                                               total_num_rows, total_mem_footprint, rowsets.size());
+    }
+
     size_t _chunk_size = 0;
     std::vector<std::unique_ptr<MergeEntry<T>>> _entries;
     using Heap = std::priority_queue<MergeEntry<T>*, std::vector<MergeEntry<T>*>, MergeEntryCmp<T>>;
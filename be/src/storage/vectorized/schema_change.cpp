@@ -40,6 +40,7 @@
 #include "storage/vectorized/chunk_aggregator.h"
 #include "storage/vectorized/convert_helper.h"
 #include "storage/wrapper_field.h"
+#include "util/threadpool.h"
 #include "util/unaligned_access.h"
 
 namespace starrocks {
@@ -1132,29 +1133,34 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
         sc_params.new_tablet->save_meta();
     });
 
-    std::unique_ptr<SchemaChange> sc_procedure;
     auto chunk_changer = sc_params.chunk_changer.get();
     if (sc_params.sc_sorting) {
         LOG(INFO) << "doing schema change with sorting for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = std::make_unique<SchemaChangeWithSorting>(
-                chunk_changer, config::memory_limitation_per_thread_for_schema_change * 1024 * 1024 * 1024);
     } else if (sc_params.sc_directly) {
         LOG(INFO) << "doing directly schema change for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = std::make_unique<SchemaChangeDirectly>(chunk_changer);
     } else {
         LOG(INFO) << "doing linked schema change for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = std::make_unique<LinkedSchemaChange>(chunk_changer);
     }
+    // each rowset is converted by its own SchemaChange, which holds the states of the conversion, e.g. the chunk
+    // allocator, the ChunkChanger is shared
+    auto new_sc_procedure = [&sc_params, chunk_changer]() -> std::unique_ptr<SchemaChange> {
+        if (sc_params.sc_sorting) {
+            return std::make_unique<SchemaChangeWithSorting>(
+                    chunk_changer, config::memory_limitation_per_thread_for_schema_change * 1024 * 1024 * 1024);
+        } else if (sc_params.sc_directly) {
+            return std::make_unique<SchemaChangeDirectly>(chunk_changer);
+        } else {
+            return std::make_unique<LinkedSchemaChange>(chunk_changer);
+        }
+    };
 
-    if (sc_procedure.get() == nullptr) {
-        LOG(WARNING) << "failed to malloc SchemaChange. "
-                     << "malloc_size=" << sizeof(SchemaChangeWithSorting);
-        return Status::InternalError("failed to malloc SchemaChange");
-    }
-
-    Status status;
-
-    for (int i = 0; i < sc_params.rowset_readers.size(); ++i) {
+    // Convert the rowsets in parallel, the converted rowsets are added to the new tablet in order after all of them
+    // are converted.
+    size_t num_rowsets = sc_params.rowset_readers.size();
+    std::vector<StatusOr<RowsetSharedPtr>> new_rowsets(num_rowsets, Status::InternalError("not converted"));
+    MemTracker* mem_tracker = tls_thread_status.mem_tracker();
+    auto convert_func = [&](size_t i) {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
         LOG(INFO) << "begin to convert a history rowset. version=" << sc_params.rowsets_to_change[i]->version();
 
         TabletSharedPtr new_tablet = sc_params.new_tablet;
@@ -1177,27 +1183,56 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
         }
 
         std::unique_ptr<RowsetWriter> rowset_writer;
-        status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
-        if (!status.ok()) {
+        Status st = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        if (!st.ok()) {
             LOG(INFO) << "build rowset writer failed";
-            return Status::InternalError("build rowset writer failed");
+            new_rowsets[i] = Status::InternalError("build rowset writer failed");
+            return;
         }
 
+        std::unique_ptr<SchemaChange> sc_procedure = new_sc_procedure();
         if (!sc_procedure->process(sc_params.rowset_readers[i].get(), rowset_writer.get(), new_tablet, base_tablet,
                                    sc_params.rowsets_to_change[i])) {
             LOG(WARNING) << "failed to process the version."
-                         << " version=" << sc_params.version.first << "-" << sc_params.version.second;
-            return Status::InternalError("process failed");
+                         << " version=" << sc_params.rowsets_to_change[i]->version();
+            new_rowsets[i] = Status::InternalError("process failed");
+            return;
+        }
+        new_rowsets[i] = rowset_writer->build();
+        if (!new_rowsets[i].ok()) {
+            LOG(WARNING) << "failed to build rowset: " << new_rowsets[i].status() << ". exit alter process";
+        }
+    };
+
+    std::unique_ptr<ThreadPool> convert_pool;
+    if (config::schema_change_rowset_parallelism > 1 && num_rowsets > 1) {
+        Status st = ThreadPoolBuilder("schema_change")
+                            .set_min_threads(1)
+                            .set_max_threads(std::min<int>(config::schema_change_rowset_parallelism, num_rowsets))
+                            .build(&convert_pool);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the pool converting the rowsets, convert them serially: " << st;
+    }
+    for (size_t i = 0; i < num_rowsets; i++) {
+        if (convert_pool == nullptr || !convert_pool->submit_func([&convert_func, i]() { convert_func(i); }).ok()) {
+            convert_func(i);
+        }
+    }
+    if (convert_pool != nullptr) {
+        convert_pool->wait();
+    }
+
+    Status status;
+    size_t num_added = 0;
+    for (; num_added < num_rowsets; ++num_added) {
+        auto& new_rowset = new_rowsets[num_added];
+        if (!new_rowset.ok()) {
+            status = new_rowset.status();
+            break;
         }
         // Add the new version of the data to the header,
         // To prevent deadlocks, be sure to lock the old table first and then the new one
         sc_params.new_tablet->obtain_push_lock();
         DeferOp new_tablet_release_lock([&] { sc_params.new_tablet->release_push_lock(); });
-        auto new_rowset = rowset_writer->build();
-        if (!new_rowset.ok()) {
-            LOG(WARNING) << "failed to build rowset: " << new_rowset.status() << ". exit alter process";
-            break;
-        }
         LOG(INFO) << "new rowset has " << (*new_rowset)->num_segments() << " segments";
         status = sc_params.new_tablet->add_rowset(*new_rowset, false);
         if (status.is_already_exist()) {
@@ -1211,6 +1246,7 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
                          << " tablet=" << sc_params.new_tablet->full_name() << ", version=" << sc_params.version.first
                          << "-" << sc_params.version.second;
             StorageEngine::instance()->add_unused_rowset(*new_rowset);
+            ++num_added;
             break;
         } else {
             VLOG(3) << "register new version. tablet=" << sc_params.new_tablet->full_name()
@@ -1220,6 +1256,15 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
         VLOG(10) << "succeed to convert a history version."
                  << " version=" << sc_params.version.first << "-" << sc_params.version.second;
     }
+    // the rowsets converted but not added
+    for (size_t i = num_added; i < num_rowsets; i++) {
+        if (new_rowsets[i].ok()) {
+            StorageEngine::instance()->add_unused_rowset(*new_rowsets[i]);
+        }
+    }
+    if (!status.ok()) {
+        return status;
+    }
 
     if (status.ok()) {
         status = sc_params.new_tablet->check_version_integrity(sc_params.version);
@@ -1352,6 +1397,12 @@ Status SchemaChangeHandler::_parse_request(
             } else if (new_column.has_bitmap_index() != ref_column.has_bitmap_index()) {
                 *sc_directly = true;
                 return Status::OK();
+            } else if (new_column.has_inverted_index() != ref_column.has_inverted_index()) {
+                *sc_directly = true;
+                return Status::OK();
+            } else if (new_column.ngram_bf_gram_num() != ref_column.ngram_bf_gram_num()) {
+                *sc_directly = true;
+                return Status::OK();
             }
         }
     }
@@ -3,10 +3,15 @@
 #include "storage/vectorized/tablet_reader.h"
 
 #include <column/datum_convert.h>
+#include <algorithm>
+#include <limits>
 
 #include "common/status.h"
 #include "gutil/stl_util.h"
 #include "service/backend_options.h"
+#include "storage/key_coder.h"
+#include "storage/rowset/beta_rowset.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/types.h"
 #include "storage/vectorized/aggregate_iterator.h"
@@ -56,6 +61,12 @@ Status TabletReader::prepare() {
     return st;
 }
 
+Status TabletReader::prepare(std::vector<RowsetSharedPtr> rowsets) {
+    _rowsets = std::move(rowsets);
+    _stats.rowsets_read_count += _rowsets.size();
+    return Status::OK();
+}
+
 Status TabletReader::open(const TabletReaderParams& read_params) {
     if (read_params.reader_type != ReaderType::READER_QUERY && read_params.reader_type != ReaderType::READER_CHECKSUM &&
         read_params.reader_type != ReaderType::READER_ALTER_TABLE && !is_compaction(read_params.reader_type)) {
@@ -85,6 +96,7 @@ Status TabletReader::get_segment_iterators(const TabletReaderParams& params, std
     RETURN_IF_ERROR(_init_delete_predicates(params, &_delete_predicates));
     RETURN_IF_ERROR(_parse_seek_range(params, &rs_opts.ranges));
     rs_opts.predicates = _pushdown_predicates;
+    rs_opts.column_exprs = params.column_exprs;
     rs_opts.sorted = (keys_type != DUP_KEYS && keys_type != PRIMARY_KEYS) && !params.skip_aggregation;
     rs_opts.reader_type = params.reader_type;
     rs_opts.chunk_size = params.chunk_size;
@@ -102,8 +114,40 @@ Status TabletReader::get_segment_iterators(const TabletReaderParams& params, std
         rs_opts.meta = _tablet->data_dir()->get_meta();
     }
 
+    if (params.split_begin_key.size() > 0 || params.split_end_key.size() > 0) {
+        SeekTuple lower;
+        SeekTuple upper;
+        if (params.split_begin_key.size() > 0) {
+            RETURN_IF_ERROR(_to_seek_tuple(_tablet->tablet_schema(), params.split_begin_key, &lower));
+        }
+        if (params.split_end_key.size() > 0) {
+            RETURN_IF_ERROR(_to_seek_tuple(_tablet->tablet_schema(), params.split_end_key, &upper));
+        }
+        SeekRange range(std::move(lower), std::move(upper));
+        range.set_inclusive_lower(true);
+        range.set_inclusive_upper(false);
+        rs_opts.key_split_range = std::move(range);
+    }
+
+    const bool has_rowid_range = params.rowid_range_begin > 0 || params.rowid_range_end >= 0;
+    if (has_rowid_range && !can_split_by_rowid(keys_type)) {
+        return Status::NotSupported("rowid range is not supported by the tablets whose rows need merging");
+    }
+    const int64_t rowid_range_end =
+            params.rowid_range_end < 0 ? std::numeric_limits<int64_t>::max() : params.rowid_range_end;
+
     SCOPED_RAW_TIMER(&_stats.create_segment_iter_ns);
+    int64_t rowset_offset = 0;
     for (auto& rowset : _rowsets) {
+        const int64_t rowset_begin = rowset_offset;
+        rowset_offset += rowset->num_rows();
+        if (has_rowid_range) {
+            if (rowset_offset <= params.rowid_range_begin || rowset_begin >= rowid_range_end) {
+                continue;
+            }
+            rs_opts.rowid_range_begin = std::max(rowset_begin, params.rowid_range_begin) - rowset_begin;
+            rs_opts.rowid_range_end = std::min(rowset_offset, rowid_range_end) - rowset_begin;
+        }
         RETURN_IF_ERROR(rowset->get_segment_iterators(schema(), rs_opts, iters));
     }
     return Status::OK();
@@ -202,6 +246,36 @@ Status TabletReader::_init_collector(const TabletReaderParams& params) {
                 _collect_iter = new_aggregate_iterator(std::move(_collect_iter), _is_key);
             }
         }
+    } else if (keys_type == AGG_KEYS && skip_aggr && _pre_aggregate_by_key_prefix(params)) {
+        // The query's aggregations are compatible with the aggregations of the value columns, see
+        // TabletReaderParams::skip_aggregation, and the rows of a segment are sorted by the prefix of keys read,
+        // so the rows are merged and fully aggregated by the prefix, at the granularity of the query's group-by.
+        //                 Timer
+        //                   |
+        //           AggregateIterator (factor = 0)
+        //                   |
+        //                 Timer
+        //                   |
+        //             MergeIterator
+        //                   |
+        //       +-----------+-----------+
+        //       |           |           |
+        //     Timer        ...        Timer
+        //       |           |           |
+        // SegmentIterator  ...    SegmentIterator
+        //
+        _collect_iter = new_heap_merge_iterator(seg_iters);
+        if (params.profile != nullptr && params.profile->parent() != nullptr) {
+            RuntimeProfile* p = params.profile->parent()->create_child("MERGE", true, true);
+            RuntimeProfile::Counter* sort_timer = ADD_TIMER(p, "sort");
+            RuntimeProfile::Counter* aggr_timer = ADD_TIMER(p, "aggr");
+
+            _collect_iter = timed_chunk_iterator(_collect_iter, sort_timer);
+            _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
+            _collect_iter = timed_chunk_iterator(_collect_iter, aggr_timer);
+        } else {
+            _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
+        }
     } else if (keys_type == AGG_KEYS) {
         CHECK(skip_aggr);
         //                 Timer
@@ -244,6 +318,18 @@ Status TabletReader::_init_collector(const TabletReaderParams& params) {
     return Status::OK();
 }
 
+// Whether the keys read are a strict prefix of the keys of the tablet, e.g. the query groups by the day of a table
+// keyed by the day and the hour, the prefix of all the keys is merged as usual.
+bool TabletReader::_pre_aggregate_by_key_prefix(const TabletReaderParams& params) const {
+    const size_t num_keys = _schema.num_key_fields();
+    if (!config::enable_pre_aggregate_by_key_prefix || params.reader_type != READER_QUERY || num_keys == 0 ||
+        num_keys >= _tablet->num_key_columns()) {
+        return false;
+    }
+    // The key fields are sorted by id, see MergeIterator.
+    return _schema.field(num_keys - 1)->id() == num_keys - 1;
+}
+
 Status TabletReader::_init_predicates(const TabletReaderParams& params) {
     for (const ColumnPredicate* pred : params.predicates) {
         _pushdown_predicates[pred->column_id()].emplace_back(pred);
@@ -365,4 +451,70 @@ Status TabletReader::_parse_seek_range(const TabletReaderParams& read_params, st
     return Status::OK();
 }
 
+// The first key columns of these types are decoded from the short keys exactly, or as a prefix for VARCHAR,
+// which is still a valid split key.
+static bool can_sample_split_keys(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATE_V2:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_TIMESTAMP:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+    case OLAP_FIELD_TYPE_DECIMAL128:
+    case OLAP_FIELD_TYPE_VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status TabletReader::sample_split_keys(const TabletSchema& tablet_schema, const std::vector<RowsetSharedPtr>& rowsets,
+                                       size_t num_splits, std::vector<OlapTuple>* keys) {
+    if (num_splits <= 1 || tablet_schema.num_short_key_columns() == 0 ||
+        !can_sample_split_keys(tablet_schema.column(0).type())) {
+        return Status::OK();
+    }
+    // Each sample stands for the same number of rows, a block of the short key index.
+    std::vector<std::string> samples;
+    for (const auto& rowset : rowsets) {
+        RETURN_IF_ERROR(rowset->load());
+        for (const auto& segment : down_cast<BetaRowset*>(rowset.get())->segments()) {
+            RETURN_IF_ERROR(segment->get_first_short_key_values(
+                    StorageEngine::instance()->tablet_meta_mem_tracker(), &samples));
+        }
+    }
+    if (samples.size() < num_splits) {
+        return Status::OK();
+    }
+    // The encoded values sort like the values.
+    std::sort(samples.begin(), samples.end());
+
+    const TabletColumn& column = tablet_schema.column(0);
+    const KeyCoder* coder = get_key_coder(column.type());
+    TypeInfoPtr type_info = get_type_info(column);
+    MemPool pool;
+    const std::string* last = nullptr;
+    for (size_t i = 1; i < num_splits; ++i) {
+        const std::string& sample = samples[i * samples.size() / num_splits];
+        if (last != nullptr && *last == sample) {
+            continue;
+        }
+        last = &sample;
+        Slice encoded(sample);
+        // large enough for the values of all the supported types, including a Slice
+        alignas(16) uint8_t cell[16];
+        RETURN_IF_ERROR(coder->decode_ascending(&encoded, column.index_length(), cell, &pool));
+        OlapTuple key;
+        key.add_value(type_info->to_string(cell));
+        keys->emplace_back(std::move(key));
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks::vectorized
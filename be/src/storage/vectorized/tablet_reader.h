@@ -26,6 +26,9 @@ public:
     ~TabletReader() override { close(); }
 
     Status prepare();
+    // Same as prepare(), but read |rowsets| captured beforehand by the version of this reader, so that
+    // several readers splitting the scan of a tablet by rowid ranges read exactly the same rowsets.
+    Status prepare(std::vector<RowsetSharedPtr> rowsets);
 
     // Precondition: the last method called must have been `prepare()`.
     Status open(const TabletReaderParams& read_params);
@@ -41,6 +44,17 @@ public:
 
     Status get_segment_iterators(const TabletReaderParams& params, std::vector<ChunkIteratorPtr>* iters);
 
+    // Whether the scan of a tablet could be split by rowid ranges, i.e. the rows of different segments
+    // needn't be merged, see TabletReaderParams::rowid_range_begin.
+    static bool can_split_by_rowid(KeysType keys_type) { return keys_type == DUP_KEYS || keys_type == PRIMARY_KEYS; }
+
+    // Samples at most |num_splits| - 1 keys splitting the rows of |rowsets| into key ranges of about the same
+    // number of rows, from the short key indexes of their segments, see TabletReaderParams::split_begin_key.
+    // The keys are distinct values of the first key column in ascending order. No key is returned if the type
+    // of the first key column isn't supported.
+    static Status sample_split_keys(const TabletSchema& tablet_schema, const std::vector<RowsetSharedPtr>& rowsets,
+                                    size_t num_splits, std::vector<OlapTuple>* keys);
+
 public:
     Status do_get_next(Chunk* chunk) override;
     Status do_get_next(Chunk* chunk, std::vector<RowSourceMask>* source_masks) override;
@@ -53,6 +67,7 @@ private:
     Status _init_predicates(const TabletReaderParams& read_params);
     Status _init_delete_predicates(const TabletReaderParams& read_params, DeletePredicates* dels);
     Status _init_collector(const TabletReaderParams& read_params);
+    bool _pre_aggregate_by_key_prefix(const TabletReaderParams& read_params) const;
     Status _to_seek_tuple(const TabletSchema& tablet_schema, const OlapTuple& input, SeekTuple* tuple);
 
     TabletSharedPtr _tablet;
@@ -18,6 +18,7 @@ class RuntimeState;
 
 namespace vectorized {
 
+class ColumnExpr;
 class ColumnPredicate;
 
 static inline std::unordered_set<uint32_t> EMPTY_FILTERED_COLUMN_IDS;
@@ -44,6 +45,21 @@ struct TabletReaderParams {
     std::vector<OlapTuple> start_key;
     std::vector<OlapTuple> end_key;
     std::vector<const ColumnPredicate*> predicates;
+    // The non-key columns of the duplicate key tablets read as the results of these expressions, see ColumnExpr.
+    std::vector<const ColumnExpr*> column_exprs;
+
+    // Only the rows in [rowid_range_begin, rowid_range_end) of the tablet are read, the rows of a
+    // tablet are numbered consecutively through the segments of the captured rowsets, in the order
+    // of their versions. -1 means to the last row.
+    // Only valid if the rows of different segments needn't be merged, see TabletReader::can_split_by_rowid.
+    int64_t rowid_range_begin = 0;
+    int64_t rowid_range_end = -1;
+
+    // Only the rows whose keys are in [split_begin_key, split_end_key) are read, an empty tuple means unbounded.
+    // All the rows of a key are in the same key range, so unlike the rowid ranges, the key ranges could split
+    // the scan of the tablets whose rows need merging. See TabletReader::sample_split_keys.
+    OlapTuple split_begin_key;
+    OlapTuple split_end_key;
 
     RuntimeState* runtime_state = nullptr;
 
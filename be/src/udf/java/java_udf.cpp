@@ -480,6 +480,50 @@ jobject UDFHelper::create_boxed_array(int type, int num_rows, bool nullable, Dir
     return env->CallStaticObjectMethod(clazz, methodID, type, num_rows, nullable, input_arr);
 }
 
+static jobjectArray new_columns_array(JNIEnv* env, jobject* columns, int num_cols) {
+    jobjectArray arr = env->NewObjectArray(num_cols, env->FindClass("[Ljava/lang/Object;"), nullptr);
+    for (int i = 0; i < num_cols; ++i) {
+        env->SetObjectArrayElement(arr, i, columns[i]);
+    }
+    return arr;
+}
+
+jobject UDFHelper::batch_call(jobject obj, jobject method, int num_rows, jobject* columns, int num_cols) {
+    auto* env = JVMFunctionHelper::getInstance().getEnv();
+    std::string clazz_name = JVMFunctionHelper::to_jni_class_name(CLASS_UDF_HELPER_NAME);
+    jclass clazz = env->FindClass(clazz_name.c_str());
+    auto methodID = env->GetStaticMethodID(
+            clazz, "batchCall",
+            "(Ljava/lang/Object;Ljava/lang/reflect/Method;I[[Ljava/lang/Object;)[Ljava/lang/Object;");
+    jobjectArray input_arr = new_columns_array(env, columns, num_cols);
+    jobject res = env->CallStaticObjectMethod(clazz, methodID, obj, method, num_rows, input_arr);
+    env->DeleteLocalRef(input_arr);
+    return res;
+}
+
+void UDFHelper::batch_update(jobject obj, jobject method, jobject state, int num_rows, jobject* columns,
+                             int num_cols) {
+    auto* env = JVMFunctionHelper::getInstance().getEnv();
+    std::string clazz_name = JVMFunctionHelper::to_jni_class_name(CLASS_UDF_HELPER_NAME);
+    jclass clazz = env->FindClass(clazz_name.c_str());
+    auto methodID = env->GetStaticMethodID(
+            clazz, "batchUpdate",
+            "(Ljava/lang/Object;Ljava/lang/reflect/Method;Ljava/lang/Object;I[[Ljava/lang/Object;)V");
+    jobjectArray input_arr = new_columns_array(env, columns, num_cols);
+    env->CallStaticVoidMethod(clazz, methodID, obj, method, state, num_rows, input_arr);
+    env->DeleteLocalRef(input_arr);
+}
+
+void UDFHelper::get_result_from_boxed_array(int type, jobject boxed, int num_rows, DirectByteBuffer* null_buffer,
+                                            DirectByteBuffer* data_buffer) {
+    auto* env = JVMFunctionHelper::getInstance().getEnv();
+    std::string clazz_name = JVMFunctionHelper::to_jni_class_name(CLASS_UDF_HELPER_NAME);
+    jclass clazz = env->FindClass(clazz_name.c_str());
+    auto methodID = env->GetStaticMethodID(clazz, "getResultFromBoxedArray",
+                                           "(I[Ljava/lang/Object;ILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V");
+    env->CallStaticVoidMethod(clazz, methodID, type, boxed, num_rows, null_buffer->handle(), data_buffer->handle());
+}
+
 JavaUDFContext::~JavaUDFContext() {
     auto& helper = JVMFunctionHelper::getInstance();
     if (udf_handle) {
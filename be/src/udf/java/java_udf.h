@@ -214,6 +214,14 @@ public:
 class UDFHelper {
 public:
     jobject create_boxed_array(int type, int num_rows, bool nullable, DirectByteBuffer* buffer, int sz);
+    // Call |method| of |obj| for all the rows in Java with a single JNI call,
+    // columns[i] is the boxed array of the i-th argument. Returns the boxed array of the results.
+    jobject batch_call(jobject obj, jobject method, int num_rows, jobject* columns, int num_cols);
+    // Call the update |method| of |obj| with |state| for all the rows in Java with a single JNI call.
+    void batch_update(jobject obj, jobject method, jobject state, int num_rows, jobject* columns, int num_cols);
+    // Unbox the results of a primitive type into the null buffer and the data buffer of a nullable column.
+    void get_result_from_boxed_array(int type, jobject boxed, int num_rows, DirectByteBuffer* null_buffer,
+                                     DirectByteBuffer* data_buffer);
 };
 
 struct JavaUDFContext {
@@ -129,6 +129,30 @@ inline bool BitReader::GetValue(int num_bits, T* v) {
     return true;
 }
 
+template <typename T>
+inline int BitReader::UnpackBatch(int num_bits, int num_values, T* v) {
+    DCHECK_LE(num_bits, 64);
+    DCHECK_LE(num_bits, sizeof(T) * 8);
+
+    int i = 0;
+    // at most 7 values before a byte boundary
+    for (; i < num_values && bit_offset_ % 8 != 0; i++) {
+        if (PREDICT_FALSE(!GetValue(num_bits, v + i))) return i;
+    }
+    if (i == num_values) return i;
+    if (num_bits == 0) {
+        std::fill(v + i, v + num_values, T());
+        return num_values;
+    }
+    int pos = position();
+    int byte_offset = pos / 8;
+    int64_t unpacked =
+            BitPacking::UnpackValues(num_bits, buffer_ + byte_offset, max_bytes_ - byte_offset, num_values - i, v + i)
+                    .second;
+    SeekToBit(pos + unpacked * num_bits);
+    return i + unpacked;
+}
+
 inline void BitReader::Rewind(int num_bits) {
     bit_offset_ -= num_bits;
     if (bit_offset_ >= 0) {
@@ -32,6 +32,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/logging.h"
@@ -785,10 +786,21 @@ public:
      * pointer).
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        // The 32-bit bitmaps of the same high 32 bits are unioned at once by Roaring::fastunion,
+        // which builds every container of the result once rather than once per input.
+        std::map<uint32_t, std::vector<const Roaring*>> buckets;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                buckets[map_entry.first].push_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [high_bytes, bucket] : buckets) {
+            if (bucket.size() == 1) {
+                ans.roarings.emplace(high_bytes, *bucket[0]);
+            } else {
+                ans.roarings.emplace(high_bytes, Roaring::fastunion(bucket.size(), bucket.data()));
+            }
         }
         return ans;
     }
@@ -1112,6 +1124,47 @@ public:
         return *this;
     }
 
+    // Compute the union between the current bitmap and all the |values|.
+    // The elements of the SINGLE and SET values are added directly, and the BITMAP values are unioned with the
+    // current bitmap by one many-way union, which is much faster than operator|= one by one.
+    void fast_union(const std::vector<const BitmapValue*>& values) {
+        std::vector<const detail::Roaring64Map*> bitmaps;
+        std::vector<uint64_t> elements;
+        for (const auto* value : values) {
+            switch (value->_type) {
+            case EMPTY:
+                break;
+            case SINGLE:
+                elements.emplace_back(value->_sv);
+                break;
+            case BITMAP:
+                bitmaps.emplace_back(value->_bitmap.get());
+                break;
+            case SET:
+                elements.insert(elements.end(), value->_set.begin(), value->_set.end());
+                break;
+            }
+        }
+
+        if (!bitmaps.empty()) {
+            if (_type == BITMAP) {
+                bitmaps.emplace_back(_bitmap.get());
+            } else if (_type == SINGLE) {
+                elements.emplace_back(_sv);
+            } else if (_type == SET) {
+                elements.insert(elements.end(), _set.begin(), _set.end());
+            }
+            auto bitmap = std::make_shared<detail::Roaring64Map>(
+                    detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data()));
+            _bitmap = std::move(bitmap);
+            _set.clear();
+            _type = BITMAP;
+        }
+        for (uint64_t element : elements) {
+            add(element);
+        }
+    }
+
     // Note: rhs BitmapValue is only readable after this method
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
@@ -26,6 +26,7 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zlib.h>
+#include <zstd/zdict.h>
 #include <zstd/zstd.h>
 #include <zstd/zstd_errors.h>
 
@@ -36,6 +37,59 @@ namespace starrocks {
 
 using strings::Substitute;
 
+namespace {
+
+// The compression and decompression contexts of LZ4F and ZSTD are created lazily on each thread and reused by all
+// the calls on the thread, instead of being created and freed by each call, which takes a large share of the time
+// of the small pages and chunks.
+class CompressionThreadContexts {
+public:
+    ~CompressionThreadContexts() {
+        LZ4F_freeCompressionContext(_lz4f_cctx);
+        LZ4F_freeDecompressionContext(_lz4f_dctx);
+        ZSTD_freeCCtx(_zstd_cctx);
+        ZSTD_freeDCtx(_zstd_dctx);
+    }
+
+    LZ4F_compressionContext_t lz4f_cctx() {
+        if (_lz4f_cctx == nullptr && LZ4F_isError(LZ4F_createCompressionContext(&_lz4f_cctx, LZ4F_VERSION))) {
+            _lz4f_cctx = nullptr;
+        }
+        return _lz4f_cctx;
+    }
+
+    LZ4F_decompressionContext_t lz4f_dctx() {
+        if (_lz4f_dctx == nullptr && LZ4F_isError(LZ4F_createDecompressionContext(&_lz4f_dctx, LZ4F_VERSION))) {
+            _lz4f_dctx = nullptr;
+        }
+        return _lz4f_dctx;
+    }
+
+    ZSTD_CCtx* zstd_cctx() {
+        if (_zstd_cctx == nullptr) {
+            _zstd_cctx = ZSTD_createCCtx();
+        }
+        return _zstd_cctx;
+    }
+
+    ZSTD_DCtx* zstd_dctx() {
+        if (_zstd_dctx == nullptr) {
+            _zstd_dctx = ZSTD_createDCtx();
+        }
+        return _zstd_dctx;
+    }
+
+private:
+    LZ4F_compressionContext_t _lz4f_cctx = nullptr;
+    LZ4F_decompressionContext_t _lz4f_dctx = nullptr;
+    ZSTD_CCtx* _zstd_cctx = nullptr;
+    ZSTD_DCtx* _zstd_dctx = nullptr;
+};
+
+thread_local CompressionThreadContexts tls_contexts;
+
+} // namespace
+
 Status BlockCompressionCodec::compress(const std::vector<Slice>& inputs, Slice* output) const {
     if (inputs.size() == 1) {
         return compress(inputs[0], output);
@@ -50,6 +104,22 @@ Status BlockCompressionCodec::compress(const std::vector<Slice>& inputs, Slice*
     return compress(buf, output);
 }
 
+Status BlockCompressionCodec::compress_batch(const std::vector<Slice>& inputs, std::vector<Slice>* outputs) const {
+    DCHECK_EQ(inputs.size(), outputs->size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        RETURN_IF_ERROR(compress(inputs[i], &(*outputs)[i]));
+    }
+    return Status::OK();
+}
+
+Status BlockCompressionCodec::decompress_batch(const std::vector<Slice>& inputs, std::vector<Slice>* outputs) const {
+    DCHECK_EQ(inputs.size(), outputs->size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        RETURN_IF_ERROR(decompress(inputs[i], &(*outputs)[i]));
+    }
+    return Status::OK();
+}
+
 class Lz4BlockCompression : public BlockCompressionCodec {
 public:
     static const Lz4BlockCompression* instance() {
@@ -106,26 +176,24 @@ public:
     }
 
     Status compress(const std::vector<Slice>& inputs, Slice* output) const override {
-        LZ4F_compressionContext_t ctx = nullptr;
-        auto lres = LZ4F_createCompressionContext(&ctx, LZ4F_VERSION);
-        if (lres != 0) {
-            return Status::InvalidArgument(
-                    strings::Substitute("Fail to do LZ4FRAME compress, res=$0", LZ4F_getErrorName(lres)));
+        LZ4F_compressionContext_t ctx = tls_contexts.lz4f_cctx();
+        if (ctx == nullptr) {
+            return Status::InternalError("Fail to create LZ4FRAME compress context");
         }
-        auto st = _compress(ctx, inputs, output);
-        LZ4F_freeCompressionContext(ctx);
-        return st;
+        // LZ4F_compressBegin() starts a new frame whatever the state left by a failed compression
+        return _compress(ctx, inputs, output);
     }
 
     Status decompress(const Slice& input, Slice* output) const override {
-        LZ4F_decompressionContext_t ctx;
-        auto lres = LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION);
-        if (LZ4F_isError(lres)) {
-            return Status::InvalidArgument(
-                    strings::Substitute("Fail to create LZ4FRAME decompress, res=$0", LZ4F_getErrorName(lres)));
+        LZ4F_decompressionContext_t ctx = tls_contexts.lz4f_dctx();
+        if (ctx == nullptr) {
+            return Status::InternalError("Fail to create LZ4FRAME decompress context");
         }
         auto st = _decompress(ctx, input, output);
-        LZ4F_freeDecompressionContext(ctx);
+        if (!st.ok()) {
+            // the context is reset only by a fully decoded frame
+            LZ4F_resetDecompressionContext(ctx);
+        }
         return st;
     }
 
@@ -378,7 +446,11 @@ public:
     ~ZstdBlockCompression() override = default;
 
     Status compress(const Slice& input, Slice* output) const override {
-        size_t ret = ZSTD_compress(output->data, output->size, input.data, input.size, ZSTD_CLEVEL_DEFAULT);
+        ZSTD_CCtx* cctx = tls_contexts.zstd_cctx();
+        if (cctx == nullptr) {
+            return Status::InternalError("ZSTD create compression context failed");
+        }
+        size_t ret = ZSTD_compressCCtx(cctx, output->data, output->size, input.data, input.size, ZSTD_CLEVEL_DEFAULT);
         if (ZSTD_isError(ret)) {
             return Status::InvalidArgument(
                     strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
@@ -388,11 +460,12 @@ public:
     }
 
     Status compress(const std::vector<Slice>& inputs, Slice* output) const override {
-        auto deleter = [](ZSTD_CStream* s) {
-            if (s != nullptr) ZSTD_freeCStream(s);
-        };
-        std::unique_ptr<ZSTD_CStream, decltype(deleter)> stream{ZSTD_createCStream(), deleter};
-        auto ret = ZSTD_initCStream(stream.get(), ZSTD_CLEVEL_DEFAULT);
+        // a ZSTD_CCtx is a ZSTD_CStream, the stream state and the parameters left by the last call are reset
+        ZSTD_CStream* stream = tls_contexts.zstd_cctx();
+        if (stream == nullptr) {
+            return Status::InternalError("ZSTD create compression context failed");
+        }
+        auto ret = ZSTD_initCStream(stream, ZSTD_CLEVEL_DEFAULT);
         if (ZSTD_isError(ret)) {
             return Status::InvalidArgument(strings::Substitute("ZSTD create compress stream failed: $0", ret));
         }
@@ -408,7 +481,7 @@ public:
             in_buf.size = input.size;
             in_buf.pos = 0;
 
-            ret = ZSTD_compressStream(stream.get(), &out_buf, &in_buf);
+            ret = ZSTD_compressStream(stream, &out_buf, &in_buf);
             if (ZSTD_isError(ret)) {
                 return Status::InvalidArgument(
                         strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
@@ -417,7 +490,7 @@ public:
             }
         }
 
-        ret = ZSTD_endStream(stream.get(), &out_buf);
+        ret = ZSTD_endStream(stream, &out_buf);
         if (ZSTD_isError(ret)) {
             return Status::InvalidArgument(
                     strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
@@ -436,7 +509,11 @@ public:
             output->data = (char*)&empty_buffer;
             output->size = 0;
         }
-        size_t ret = ZSTD_decompress(output->data, output->size, input.data, input.size);
+        ZSTD_DCtx* dctx = tls_contexts.zstd_dctx();
+        if (dctx == nullptr) {
+            return Status::InternalError("ZSTD create decompression context failed");
+        }
+        size_t ret = ZSTD_decompressDCtx(dctx, output->data, output->size, input.data, input.size);
         if (ZSTD_isError(ret)) {
             return Status::InvalidArgument(
                     strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
@@ -573,4 +650,84 @@ Status get_block_compression_codec(CompressionTypePB type, const BlockCompressio
     return Status::OK();
 }
 
+StatusOr<std::unique_ptr<ZstdDictBlockCompression>> ZstdDictBlockCompression::create(std::string dict) {
+    std::unique_ptr<ZstdDictBlockCompression> codec(new ZstdDictBlockCompression(std::move(dict)));
+    if (ZDICT_getDictID(codec->_dict.data(), codec->_dict.size()) == 0) {
+        return Status::InvalidArgument("invalid ZSTD dictionary");
+    }
+    codec->_ddict = ZSTD_createDDict(codec->_dict.data(), codec->_dict.size());
+    if (codec->_ddict == nullptr) {
+        return Status::InvalidArgument("ZSTD create decompression dictionary failed");
+    }
+    return std::move(codec);
+}
+
+ZstdDictBlockCompression::~ZstdDictBlockCompression() {
+    ZSTD_freeDDict(_ddict);
+    ZSTD_freeCDict(_cdict);
+}
+
+Status ZstdDictBlockCompression::compress(const Slice& input, Slice* output) const {
+    std::call_once(_cdict_once,
+                   [this]() { _cdict = ZSTD_createCDict(_dict.data(), _dict.size(), ZSTD_CLEVEL_DEFAULT); });
+    ZSTD_CCtx* cctx = tls_contexts.zstd_cctx();
+    if (_cdict == nullptr || cctx == nullptr) {
+        return Status::InternalError("ZSTD create compression context failed");
+    }
+    size_t ret = ZSTD_compress_usingCDict(cctx, output->data, output->size, input.data, input.size, _cdict);
+    if (ZSTD_isError(ret)) {
+        return Status::InvalidArgument(
+                strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+    }
+    output->size = ret;
+    return Status::OK();
+}
+
+Status ZstdDictBlockCompression::decompress(const Slice& input, Slice* output) const {
+    if (output->data == nullptr) {
+        // See ZstdBlockCompression::decompress()
+        static uint8_t empty_buffer;
+        output->data = (char*)&empty_buffer;
+        output->size = 0;
+    }
+    ZSTD_DCtx* dctx = tls_contexts.zstd_dctx();
+    if (dctx == nullptr) {
+        return Status::InternalError("ZSTD create decompression context failed");
+    }
+    size_t ret = ZSTD_decompress_usingDDict(dctx, output->data, output->size, input.data, input.size, _ddict);
+    if (ZSTD_isError(ret)) {
+        return Status::InvalidArgument(
+                strings::Substitute("ZSTD decompress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+    }
+    output->size = ret;
+    return Status::OK();
+}
+
+size_t ZstdDictBlockCompression::max_compressed_len(size_t len) const {
+    return ZSTD_compressBound(len);
+}
+
+size_t ZstdDictBlockCompression::mem_usage() const {
+    return sizeof(ZstdDictBlockCompression) + _dict.capacity() + ZSTD_sizeof_DDict(_ddict) +
+           (_cdict != nullptr ? ZSTD_sizeof_CDict(_cdict) : 0);
+}
+
+StatusOr<std::string> train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size) {
+    faststring buf;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (const Slice& sample : samples) {
+        buf.append(sample.data, sample.size);
+        sample_sizes.push_back(sample.size);
+    }
+    std::string dict(max_dict_size, '\0');
+    size_t ret = ZDICT_trainFromBuffer(dict.data(), dict.size(), buf.data(), sample_sizes.data(), sample_sizes.size());
+    if (ZDICT_isError(ret)) {
+        return Status::InvalidArgument(
+                strings::Substitute("ZSTD train dictionary failed: $0", ZDICT_getErrorName(ret)));
+    }
+    dict.resize(ret);
+    return dict;
+}
+
 } // namespace starrocks
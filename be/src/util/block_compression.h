@@ -22,9 +22,13 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
+#include "common/statusor.h"
 #include "gen_cpp/segment.pb.h"
 #include "util/slice.h"
 
@@ -54,6 +58,12 @@ public:
     // Size of decompressed data will be set in output's size.
     virtual Status decompress(const Slice& input, Slice* output) const = 0;
 
+    // Compress or decompress each of |inputs| into the corresponding preallocated slice of |outputs|, as
+    // compress(Slice)/decompress() do, e.g. all the pages of a column or all the chunks of a request. The sizes
+    // of |outputs| are set to the sizes of the results.
+    Status compress_batch(const std::vector<Slice>& inputs, std::vector<Slice>* outputs) const;
+    Status decompress_batch(const std::vector<Slice>& inputs, std::vector<Slice>* outputs) const;
+
     // Returns an upper bound on the max compressed length.
     virtual size_t max_compressed_len(size_t len) const = 0;
 
@@ -73,4 +83,40 @@ public:
 // Return not OK, if error happens.
 Status get_block_compression_codec(CompressionTypePB type, const BlockCompressionCodec** codec);
 
+// The ZSTD codec with a dictionary trained from the samples of the data by train_zstd_dictionary(), the
+// dictionary is the initial context of every block, so the small blocks of similar data, e.g. the pages of
+// short strings, compress much better than by the plain ZSTD codec. The blocks compressed by this codec
+// must be decompressed by a codec of the same dictionary.
+// The compression and decompression contexts are cached per thread.
+class ZstdDictBlockCompression final : public BlockCompressionCodec {
+public:
+    // Returns InvalidArgument if |dict| isn't a ZSTD dictionary.
+    static StatusOr<std::unique_ptr<ZstdDictBlockCompression>> create(std::string dict);
+
+    ~ZstdDictBlockCompression() override;
+
+    Status compress(const Slice& input, Slice* output) const override;
+
+    Status decompress(const Slice& input, Slice* output) const override;
+
+    size_t max_compressed_len(size_t len) const override;
+
+    const std::string& dict() const { return _dict; }
+
+    size_t mem_usage() const;
+
+private:
+    explicit ZstdDictBlockCompression(std::string dict) : _dict(std::move(dict)) {}
+
+    std::string _dict;
+    struct ZSTD_DDict_s* _ddict = nullptr;
+    // only created by the first compression, the readers don't need it
+    mutable std::once_flag _cdict_once;
+    mutable struct ZSTD_CDict_s* _cdict = nullptr;
+};
+
+// Train a ZSTD dictionary of at most |max_dict_size| bytes from |samples|.
+// Returns InvalidArgument if the samples are too few or too small to train a dictionary.
+StatusOr<std::string> train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size);
+
 } // namespace starrocks
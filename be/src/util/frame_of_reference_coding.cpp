@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <type_traits>
 
 #include "util/bit_util.h"
 #include "util/coding.h"
@@ -269,7 +270,6 @@ bool ForDecoder<T>::init() {
     return true;
 }
 
-// todo(kks): improve this method by SIMD instructions
 // The reverse of bit_pack method, get original integer data list from packed bits
 // param[in] input: the packed bits need to unpack
 // param[in] in_num: the integer number in packed bits
@@ -277,8 +277,28 @@ bool ForDecoder<T>::init() {
 // param[out] output: the original integer data list
 template <typename T>
 void ForDecoder<T>::bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output) {
+    size_t bit_pos = 0;
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t)) {
+        // A value of at most 57 bits is in the 8 bytes from its first byte, as the bits are from the highest
+        // bit of the bytes: shift out the bits of the previous values, then the bits of the next values.
+        // The values whose 8 bytes are past the end of the packed bits are unpacked bit by bit.
+        if (bit_width > 0 && bit_width <= 57) {
+            const size_t packed_bytes = BitUtil::Ceil(in_num * bit_width, 8);
+            int i = 0;
+            for (; i < in_num && bit_pos / 8 + sizeof(uint64_t) <= packed_bytes; i++, bit_pos += bit_width) {
+                uint64_t word;
+                memcpy(&word, input + bit_pos / 8, sizeof(word));
+                word = BigEndian::ToHost64(word);
+                output[i] = static_cast<T>((word << (bit_pos % 8)) >> (64 - bit_width));
+            }
+            input += bit_pos / 8;
+            bit_pos %= 8;
+            output += i;
+            in_num -= i;
+        }
+    }
     unsigned char in_mask = 0x80;
-    int bit_index = 0;
+    int bit_index = bit_pos;
     while (in_num > 0) {
         *output = 0;
         for (int i = 0; i < bit_width; i++) {
@@ -301,9 +321,14 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         return; // current frame already decoded
     }
     _current_decoded_frame = frame_index;
+    decode_frame(frame_index, output);
+}
+
+template <typename T>
+void ForDecoder<T>::decode_frame(uint32_t frame_index, T* output) {
     uint8_t current_frame_size = frame_size(frame_index);
 
-    uint32_t base_offset = _frame_offsets[_current_decoded_frame];
+    uint32_t base_offset = _frame_offsets[frame_index];
     T min = 0;
     uint32_t delta_offset = 0;
     if (sizeof(T) == 16) {
@@ -317,26 +342,24 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         delta_offset = base_offset + 4;
     }
 
-    uint8_t bit_width = _bit_widths[_current_decoded_frame];
+    uint8_t bit_width = _bit_widths[frame_index];
 
-    bool is_original_value = _storage_formats[_current_decoded_frame] == 2;
+    // the deltas are unpacked into the output, then turned into the values in place
+    bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
+    bool is_original_value = _storage_formats[frame_index] == 2;
     if (is_original_value) {
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
+        return;
+    }
+    bool is_ascending = _storage_formats[frame_index] == 1;
+    if (is_ascending) {
+        T pre_value = min;
+        for (uint8_t i = 0; i < current_frame_size; i++) {
+            pre_value = output[i] + pre_value;
+            output[i] = pre_value;
+        }
     } else {
-        bool is_ascending = _storage_formats[_current_decoded_frame] == 1;
-        std::vector<T> delta_values(current_frame_size);
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, delta_values.data());
-        if (is_ascending) {
-            T pre_value = min;
-            for (uint8_t i = 0; i < current_frame_size; i++) {
-                T value = delta_values[i] + pre_value;
-                output[i] = value;
-                pre_value = value;
-            }
-        } else {
-            for (uint8_t i = 0; i < current_frame_size; i++) {
-                output[i] = delta_values[i] + min;
-            }
+        for (uint8_t i = 0; i < current_frame_size; i++) {
+            output[i] = output[i] + min;
         }
     }
 }
@@ -384,7 +407,7 @@ bool ForDecoder<T>::get_batch(T* val, size_t count) {
     size_t frame_count = (count - padding_num) / _max_frame_size;
     for (size_t i = 0; i < frame_count; i++) {
         // directly decode value to the output, don't  buffer the value
-        decode_current_frame(val);
+        decode_frame(_current_index / _max_frame_size, val);
         _current_index += _max_frame_size;
         val += _max_frame_size;
     }
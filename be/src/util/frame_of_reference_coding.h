@@ -157,8 +157,11 @@ private:
         return (frame_index == _frame_count - 1) ? _last_frame_size : _max_frame_size;
     }
 
+    // Decodes the frame of _current_index into output, unless it's the frame decoded last time.
     void decode_current_frame(T* output);
 
+    void decode_frame(uint32_t frame_index, T* output);
+
     T decode_frame_min_value(uint32_t frame_index);
 
     // Return index of the last frame which contains value < target.
@@ -32,6 +32,8 @@ DIAGNOSTIC_IGNORE("-Wclass-memaccess")
 DIAGNOSTIC_POP
 #include <rapidjson/rapidjson.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <functional>
 #include <iomanip>
@@ -184,6 +186,91 @@ protected:
     CoreLocalValue<T> _value;
 };
 
+// A histogram of the values in the exponential buckets of the upper bounds 1, 2, 4, ..., 2^(kNumBuckets - 2) and
+// +Inf, so the relative error of the quantiles is below 2x at any scale with a fixed and small number of buckets.
+// Like CoreLocalCounter, each core has its own buckets, so observe() is lock-free and the cores don't contend on
+// the same cache lines; the buckets of the cores are summed up when the histogram is read.
+class HistogramMetric : public Metric {
+public:
+    static constexpr int kNumBuckets = 32;
+
+    HistogramMetric(MetricUnit unit) : Metric(MetricType::HISTOGRAM, unit) {}
+    ~HistogramMetric() override = default;
+
+    // The inclusive upper bound of the |index|-th bucket, the last bucket is unbounded.
+    static int64_t bucket_bound(int index) { return int64_t(1) << index; }
+
+    static int bucket_index(int64_t value) {
+        if (value <= 1) {
+            return 0;
+        }
+        return std::min(64 - __builtin_clzll(static_cast<uint64_t>(value - 1)), kNumBuckets - 1);
+    }
+
+    std::string to_string() const override { return std::to_string(count()); }
+
+    void write_value(rj::Value& metric_obj, rj::Document::AllocatorType& allocator) override {
+        std::array<int64_t, kNumBuckets> counts;
+        bucket_counts(&counts);
+        metric_obj.AddMember("count", rj::Value(count()), allocator);
+        metric_obj.AddMember("sum", rj::Value(sum()), allocator);
+        metric_obj.AddMember("p50", rj::Value(quantile(counts, 0.5)), allocator);
+        metric_obj.AddMember("p90", rj::Value(quantile(counts, 0.9)), allocator);
+        metric_obj.AddMember("p99", rj::Value(quantile(counts, 0.99)), allocator);
+    }
+
+    void observe(int64_t value) {
+        __sync_fetch_and_add(_buckets[bucket_index(value)].access(), 1);
+        __sync_fetch_and_add(_sum.access(), value);
+    }
+
+    // The number of the values of each bucket, not cumulative.
+    void bucket_counts(std::array<int64_t, kNumBuckets>* counts) const {
+        for (int i = 0; i < kNumBuckets; ++i) {
+            (*counts)[i] = _sum_cores(_buckets[i]);
+        }
+    }
+
+    int64_t count() const {
+        int64_t count = 0;
+        for (int i = 0; i < kNumBuckets; ++i) {
+            count += _sum_cores(_buckets[i]);
+        }
+        return count;
+    }
+
+    int64_t sum() const { return _sum_cores(_sum); }
+
+    // The upper bound of the bucket of the |q| quantile of |counts|.
+    static int64_t quantile(const std::array<int64_t, kNumBuckets>& counts, double q) {
+        int64_t total = 0;
+        for (auto count : counts) {
+            total += count;
+        }
+        int64_t rank = static_cast<int64_t>(q * total);
+        int64_t cumulative = 0;
+        for (int i = 0; i < kNumBuckets; ++i) {
+            cumulative += counts[i];
+            if (cumulative > rank) {
+                return bucket_bound(i);
+            }
+        }
+        return 0;
+    }
+
+private:
+    static int64_t _sum_cores(const CoreLocalValue<int64_t>& value) {
+        int64_t sum = 0;
+        for (int i = 0; i < value.size(); ++i) {
+            sum += *value.access_at_core(i);
+        }
+        return sum;
+    }
+
+    std::array<CoreLocalValue<int64_t>, kNumBuckets> _buckets;
+    CoreLocalValue<int64_t> _sum;
+};
+
 template <typename T>
 class AtomicCounter : public AtomicMetric<T> {
 public:
@@ -436,5 +523,8 @@ private:
 #define METRIC_DEFINE_DOUBLE_GAUGE(metric_name, unit) \
     starrocks::DoubleGauge metric_name { unit }
 
+#define METRIC_DEFINE_HISTOGRAM(metric_name, unit) \
+    starrocks::HistogramMetric metric_name { unit }
+
 #define METRIC_DEFINE_TCMALLOC_GAUGE(metric_name, tcmalloc_var) \
     starrocks::TcmallocMetric metric_name { tcmalloc_var }
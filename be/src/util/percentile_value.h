@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "tdigest.h"
 
 namespace starrocks {
@@ -22,8 +24,20 @@ public:
 
     void add(float value) { _tdigest.add(value); }
 
+    void add(const float* values, size_t n) { _tdigest.add(values, n); }
+
     void merge(const PercentileValue* other) { _tdigest.merge(&other->_tdigest); }
 
+    // Merge all the |others| at once, the digests are merged smallest first in batches.
+    void merge(const std::vector<const PercentileValue*>& others) {
+        std::vector<const TDigest*> digests;
+        digests.reserve(others.size());
+        for (const auto* other : others) {
+            digests.emplace_back(&other->_tdigest);
+        }
+        _tdigest.add(digests);
+    }
+
     uint64_t serialize_size() const {
         //_type 1 bytes
         return 1 + _tdigest.serialize_size();
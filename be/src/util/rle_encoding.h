@@ -412,11 +412,9 @@ inline size_t RleDecoder<T>::GetBatch(T* vals, size_t batch_num) {
             read_num += read_this_time;
         } else if (literal_count_ > 0) {
             read_this_time = std::min((size_t)literal_count_, read_this_time);
-            for (int i = 0; i < read_this_time; ++i) {
-                bool result = bit_reader_.GetValue(bit_width_, vals);
-                DCHECK(result);
-                vals++;
-            }
+            int unpacked = bit_reader_.UnpackBatch(bit_width_, read_this_time, vals);
+            DCHECK_EQ(read_this_time, unpacked);
+            vals += read_this_time;
             literal_count_ -= read_this_time;
             read_num += read_this_time;
         } else {
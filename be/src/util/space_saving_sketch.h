@@ -0,0 +1,80 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace starrocks {
+
+// SpaceSavingSketch finds the heavy hitters of a stream with |capacity| counters, see Metwally et al.,
+// "Efficient Computation of Frequent and Top-k Elements in Data Streams". A new key takes over the counter of the
+// least frequent key when the sketch is full, so the count of a key is overestimated by at most its error, and
+// every key more frequent than total() / capacity is in the sketch.
+// The least frequent key is found by a linear scan, the sketch is meant for a small capacity and sampled keys.
+template <typename Key>
+class SpaceSavingSketch {
+public:
+    struct Entry {
+        Key key;
+        int64_t count = 0;
+        // The count of the key could be overestimated by at most |error|.
+        int64_t error = 0;
+    };
+
+    explicit SpaceSavingSketch(size_t capacity) : _capacity(std::max<size_t>(1, capacity)) {
+        _entries.reserve(_capacity);
+    }
+
+    void add(const Key& key, int64_t count = 1) {
+        _total += count;
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            _entries[it->second].count += count;
+            return;
+        }
+        if (_entries.size() < _capacity) {
+            _index.emplace(key, _entries.size());
+            _entries.push_back({key, count, 0});
+            return;
+        }
+        size_t min_pos = 0;
+        for (size_t i = 1; i < _entries.size(); i++) {
+            if (_entries[i].count < _entries[min_pos].count) {
+                min_pos = i;
+            }
+        }
+        Entry& entry = _entries[min_pos];
+        _index.erase(entry.key);
+        _index.emplace(key, min_pos);
+        entry.error = entry.count;
+        entry.count += count;
+        entry.key = key;
+    }
+
+    int64_t total() const { return _total; }
+
+    // The keys counted more than |threshold| times for sure, i.e. whose count - error is more than |threshold|,
+    // in the descending order of their counts.
+    std::vector<Entry> heavy_hitters(int64_t threshold) const {
+        std::vector<Entry> result;
+        for (const auto& entry : _entries) {
+            if (entry.count - entry.error > threshold) {
+                result.push_back(entry);
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) { return a.count > b.count; });
+        return result;
+    }
+
+private:
+    const size_t _capacity;
+    int64_t _total = 0;
+    // The position of a key in |_entries|.
+    std::unordered_map<Key, size_t> _index;
+    std::vector<Entry> _entries;
+};
+
+} // namespace starrocks
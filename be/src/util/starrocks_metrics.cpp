@@ -47,6 +47,21 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     REGISTER_STARROCKS_METRIC(memtable_flush_total);
     REGISTER_STARROCKS_METRIC(memtable_flush_duration_us);
 
+    REGISTER_STARROCKS_METRIC(memtable_flush_latency_us);
+    _metrics.register_metric("compaction_latency_us", MetricLabels().add("type", "base"), &base_compaction_latency_us);
+    _metrics.register_metric("compaction_latency_us", MetricLabels().add("type", "cumulative"),
+                             &cumulative_compaction_latency_us);
+    _metrics.register_metric("compaction_latency_us", MetricLabels().add("type", "update"),
+                             &update_compaction_latency_us);
+    REGISTER_STARROCKS_METRIC(page_cache_lookup_latency_ns);
+    _metrics.register_metric("rpc_latency_us", MetricLabels().add("type", "transmit_chunk"),
+                             &transmit_chunk_rpc_latency_us);
+    _metrics.register_metric("rpc_latency_us", MetricLabels().add("type", "tablet_writer_open"),
+                             &tablet_writer_open_rpc_latency_us);
+    _metrics.register_metric("rpc_latency_us", MetricLabels().add("type", "tablet_writer_add_chunk"),
+                             &tablet_writer_add_chunk_rpc_latency_us);
+    REGISTER_STARROCKS_METRIC(pipeline_driver_schedule_delay_us);
+
     REGISTER_STARROCKS_METRIC(update_rowset_commit_request_total);
     REGISTER_STARROCKS_METRIC(update_rowset_commit_request_failed);
     REGISTER_STARROCKS_METRIC(update_rowset_commit_apply_total);
@@ -122,6 +137,9 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
                              &update_compaction_outputs_bytes_total);
     _metrics.register_metric("update_compaction_duration_us", MetricLabels().add("type", "update"),
                              &update_compaction_duration_us);
+    REGISTER_STARROCKS_METRIC(compaction_wait_duration_us);
+    REGISTER_STARROCKS_METRIC(compaction_running_tasks);
+    REGISTER_STARROCKS_METRIC(compaction_waiting_tasks);
 
     _metrics.register_metric("meta_request_total", MetricLabels().add("type", "write"), &meta_write_request_total);
     _metrics.register_metric("meta_request_total", MetricLabels().add("type", "read"), &meta_read_request_total);
@@ -129,6 +147,8 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
                              &meta_write_request_duration_us);
     _metrics.register_metric("meta_request_duration", MetricLabels().add("type", "read"),
                              &meta_read_request_duration_us);
+    REGISTER_STARROCKS_METRIC(meta_write_stall_total);
+    REGISTER_STARROCKS_METRIC(meta_write_stall_duration_us);
 
     _metrics.register_metric("segment_read", MetricLabels().add("type", "segment_total_read_times"),
                              &segment_read_total);
@@ -138,6 +158,25 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     _metrics.register_metric("segment_read", MetricLabels().add("type", "segment_rows_read_by_zone_map"),
                              &segment_rows_read_by_zone_map);
 
+    _metrics.register_metric("page_cache_lookup_total", MetricLabels().add("type", "data"),
+                             &page_cache_data_lookup_total);
+    _metrics.register_metric("page_cache_hit_total", MetricLabels().add("type", "data"), &page_cache_data_hit_total);
+    _metrics.register_metric("page_cache_lookup_total", MetricLabels().add("type", "index"),
+                             &page_cache_index_lookup_total);
+    _metrics.register_metric("page_cache_hit_total", MetricLabels().add("type", "index"), &page_cache_index_hit_total);
+    _metrics.register_metric("page_cache_lookup_total", MetricLabels().add("type", "dict"),
+                             &page_cache_dict_lookup_total);
+    _metrics.register_metric("page_cache_hit_total", MetricLabels().add("type", "dict"), &page_cache_dict_hit_total);
+    REGISTER_STARROCKS_METRIC(segment_footer_cache_lookup_total);
+    REGISTER_STARROCKS_METRIC(segment_footer_cache_hit_total);
+    REGISTER_STARROCKS_METRIC(rowset_prewarm_bytes_total);
+    REGISTER_STARROCKS_METRIC(scan_result_cache_lookup_total);
+    REGISTER_STARROCKS_METRIC(scan_result_cache_hit_total);
+    REGISTER_STARROCKS_METRIC(scan_result_cache_incremental_hit_total);
+    REGISTER_STARROCKS_METRIC(runtime_filter_received_total);
+    REGISTER_STARROCKS_METRIC(runtime_filter_build_to_arrival_ms_total);
+    REGISTER_STARROCKS_METRIC(runtime_filter_broadcast_to_arrival_ms_total);
+
     _metrics.register_metric("txn_request", MetricLabels().add("type", "begin"), &txn_begin_request_total);
     _metrics.register_metric("txn_request", MetricLabels().add("type", "commit"), &txn_commit_request_total);
     _metrics.register_metric("txn_request", MetricLabels().add("type", "rollback"), &txn_rollback_request_total);
@@ -195,6 +234,8 @@ void StarRocksMetrics::initialize(const std::vector<std::string>& paths, bool in
         _metrics.register_metric("disks_data_used_capacity", MetricLabels().add("path", path), gauge);
         gauge = disks_state.add_metric(path, MetricUnit::NOUNIT);
         _metrics.register_metric("disks_state", MetricLabels().add("path", path), gauge);
+        HistogramMetric* histogram = disks_page_read_latency_us.add_metric(path, MetricUnit::MICROSECONDS);
+        _metrics.register_metric("disks_page_read_latency_us", MetricLabels().add("path", path), histogram);
     }
 
     if (init_system_metrics) {
@@ -49,6 +49,29 @@ private:
     std::unordered_map<std::string, std::unique_ptr<IntGauge>> metrics;
 };
 
+// The histograms of the data dirs, keyed by their root paths.
+class HistogramMetricsMap {
+public:
+    HistogramMetric* add_metric(const std::string& key, const MetricUnit unit) {
+        metrics.emplace(key, new HistogramMetric(unit));
+        return metrics.find(key)->second.get();
+    }
+
+    // The histogram of the dir that |file_path| is in, or nullptr if it's in none of them.
+    HistogramMetric* find_metric_by_file(const std::string& file_path) const {
+        for (auto& [key, metric] : metrics) {
+            if (file_path.size() > key.size() && file_path[key.size()] == '/' &&
+                file_path.compare(0, key.size(), key) == 0) {
+                return metric.get();
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<HistogramMetric>> metrics;
+};
+
 #define REGISTER_GAUGE_STARROCKS_METRIC(name, func)                                                       \
     StarRocksMetrics::instance()->metrics()->register_metric(#name, &StarRocksMetrics::instance()->name); \
     StarRocksMetrics::instance()->metrics()->register_hook(                                               \
@@ -110,6 +133,9 @@ public:
     METRIC_DEFINE_INT_COUNTER(update_compaction_outputs_total, MetricUnit::ROWSETS);
     METRIC_DEFINE_INT_COUNTER(update_compaction_outputs_bytes_total, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(update_compaction_duration_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_INT_COUNTER(compaction_wait_duration_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_UINT_GAUGE(compaction_running_tasks, MetricUnit::NOUNIT);
+    METRIC_DEFINE_UINT_GAUGE(compaction_waiting_tasks, MetricUnit::NOUNIT);
 
     METRIC_DEFINE_INT_COUNTER(publish_task_request_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(publish_task_failed_total, MetricUnit::REQUESTS);
@@ -118,6 +144,9 @@ public:
     METRIC_DEFINE_INT_COUNTER(meta_write_request_duration_us, MetricUnit::MICROSECONDS);
     METRIC_DEFINE_INT_COUNTER(meta_read_request_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(meta_read_request_duration_us, MetricUnit::MICROSECONDS);
+    // the times and the duration the writes of the meta stores are delayed or stopped by RocksDB
+    METRIC_DEFINE_INT_COUNTER(meta_write_stall_total, MetricUnit::NOUNIT);
+    METRIC_DEFINE_INT_COUNTER(meta_write_stall_duration_us, MetricUnit::MICROSECONDS);
 
     // Counters for segment_v2
     // -----------------------
@@ -129,6 +158,27 @@ public:
     METRIC_DEFINE_INT_COUNTER(segment_rows_by_short_key, MetricUnit::ROWS);
     // total number of rows selected by zone map index
     METRIC_DEFINE_INT_COUNTER(segment_rows_read_by_zone_map, MetricUnit::ROWS);
+    // number of lookups and hits of the storage page cache by page type
+    METRIC_DEFINE_INT_COUNTER(page_cache_data_lookup_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_data_hit_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_index_lookup_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_index_hit_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_dict_lookup_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_dict_hit_total, MetricUnit::OPERATIONS);
+    // number of lookups and hits of the segment footer cache
+    METRIC_DEFINE_INT_COUNTER(segment_footer_cache_lookup_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(segment_footer_cache_hit_total, MetricUnit::OPERATIONS);
+    // bytes of the pages read into the page cache by the pre-warming of the rowsets
+    METRIC_DEFINE_INT_COUNTER(rowset_prewarm_bytes_total, MetricUnit::BYTES);
+    // number of lookups and hits of the scan result cache, an incremental hit reads the new versions only
+    METRIC_DEFINE_INT_COUNTER(scan_result_cache_lookup_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(scan_result_cache_hit_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(scan_result_cache_incremental_hit_total, MetricUnit::OPERATIONS);
+    // number of the merged runtime filters received, and the sums of their delays from the build of the first
+    // partial filter and from the broadcast by the merge node to the arrival
+    METRIC_DEFINE_INT_COUNTER(runtime_filter_received_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(runtime_filter_build_to_arrival_ms_total, MetricUnit::MILLISECONDS);
+    METRIC_DEFINE_INT_COUNTER(runtime_filter_broadcast_to_arrival_ms_total, MetricUnit::MILLISECONDS);
 
     METRIC_DEFINE_INT_COUNTER(txn_begin_request_total, MetricUnit::OPERATIONS);
     METRIC_DEFINE_INT_COUNTER(txn_commit_request_total, MetricUnit::OPERATIONS);
@@ -142,6 +192,19 @@ public:
     METRIC_DEFINE_INT_COUNTER(memtable_flush_total, MetricUnit::OPERATIONS);
     METRIC_DEFINE_INT_COUNTER(memtable_flush_duration_us, MetricUnit::MICROSECONDS);
 
+    // Histograms
+    METRIC_DEFINE_HISTOGRAM(memtable_flush_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(base_compaction_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(cumulative_compaction_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(update_compaction_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(page_cache_lookup_latency_ns, MetricUnit::NANOSECONDS);
+    // the time from the arrival of the request to the response, including the time it's parked by the back pressure
+    METRIC_DEFINE_HISTOGRAM(transmit_chunk_rpc_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(tablet_writer_open_rpc_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(tablet_writer_add_chunk_rpc_latency_us, MetricUnit::MICROSECONDS);
+    // the time a pipeline driver waits in the ready queue before a thread runs it
+    METRIC_DEFINE_HISTOGRAM(pipeline_driver_schedule_delay_us, MetricUnit::MICROSECONDS);
+
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_request_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_request_failed, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_apply_total, MetricUnit::REQUESTS);
@@ -164,6 +227,7 @@ public:
     IntGaugeMetricsMap disks_avail_capacity;
     IntGaugeMetricsMap disks_data_used_capacity;
     IntGaugeMetricsMap disks_state;
+    HistogramMetricsMap disks_page_read_latency_us;
 
     // the max compaction score of all tablets.
     // Record base and cumulative scores separately, because
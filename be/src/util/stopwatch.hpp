@@ -82,4 +82,46 @@ private:
     bool _running;
 };
 
+// Stop watch for reporting the on-CPU time of the current thread in nanosec based on CLOCK_THREAD_CPUTIME_ID,
+// so the time the thread is blocked or descheduled isn't counted. It has the interface of MonotonicStopWatch,
+// and must be started and read on the same thread.
+class ThreadCpuStopWatch {
+public:
+    ThreadCpuStopWatch() {
+        _total_time = 0;
+        _running = false;
+    }
+
+    void start() {
+        if (!_running) {
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &_start);
+            _running = true;
+        }
+    }
+
+    void stop() {
+        if (_running) {
+            _total_time += elapsed_time();
+            _running = false;
+        }
+    }
+
+    // Returns time in nanosecond.
+    uint64_t elapsed_time() const {
+        if (!_running) {
+            return _total_time;
+        }
+
+        timespec end;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        return (end.tv_sec - _start.tv_sec) * 1000L * 1000L * 1000L +
+               (end.tv_nsec - _start.tv_nsec);
+    }
+
+private:
+    timespec _start;
+    uint64_t _total_time; // in nanosec
+    bool _running;
+};
+
 }
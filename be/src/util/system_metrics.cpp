@@ -67,6 +67,8 @@ public:
     METRIC_DEFINE_INT_GAUGE(thread_cache_free_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_GAUGE(pageheap_free_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_GAUGE(pageheap_unmapped_bytes, MetricUnit::BYTES);
+    // The memory mapped by tcmalloc but not allocated by the process.
+    METRIC_DEFINE_INT_GAUGE(fragmentation_bytes, MetricUnit::BYTES);
 
     // MemPool metrics
     // Process memory usage
@@ -87,6 +89,15 @@ public:
     METRIC_DEFINE_INT_GAUGE(chunk_allocator_mem_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_GAUGE(clone_mem_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_GAUGE(consistency_mem_bytes, MetricUnit::BYTES);
+    // Peak memory usage since the process started
+    METRIC_DEFINE_INT_GAUGE(process_mem_peak_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(query_mem_peak_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(load_mem_peak_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(tablet_meta_mem_peak_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(column_pool_mem_peak_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(storage_page_cache_mem_peak_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(update_mem_peak_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(chunk_allocator_mem_peak_bytes, MetricUnit::BYTES);
 
     // column pool metrics.
     METRIC_DEFINE_INT_GAUGE(column_pool_total_bytes, MetricUnit::BYTES);
@@ -248,6 +259,7 @@ void SystemMetrics::_install_memory_metrics(MetricRegistry* registry) {
     registry->register_metric("thread_cache_free_bytes", &_memory_metrics->thread_cache_free_bytes);
     registry->register_metric("pageheap_free_bytes", &_memory_metrics->pageheap_free_bytes);
     registry->register_metric("pageheap_unmapped_bytes", &_memory_metrics->pageheap_unmapped_bytes);
+    registry->register_metric("memory_fragmentation_bytes", &_memory_metrics->fragmentation_bytes);
 
     registry->register_metric("process_mem_bytes", &_memory_metrics->process_mem_bytes);
     registry->register_metric("query_mem_bytes", &_memory_metrics->query_mem_bytes);
@@ -261,6 +273,14 @@ void SystemMetrics::_install_memory_metrics(MetricRegistry* registry) {
     registry->register_metric("chunk_allocator_mem_bytes", &_memory_metrics->chunk_allocator_mem_bytes);
     registry->register_metric("clone_mem_bytes", &_memory_metrics->clone_mem_bytes);
     registry->register_metric("consistency_mem_bytes", &_memory_metrics->consistency_mem_bytes);
+    registry->register_metric("process_mem_peak_bytes", &_memory_metrics->process_mem_peak_bytes);
+    registry->register_metric("query_mem_peak_bytes", &_memory_metrics->query_mem_peak_bytes);
+    registry->register_metric("load_mem_peak_bytes", &_memory_metrics->load_mem_peak_bytes);
+    registry->register_metric("tablet_meta_mem_peak_bytes", &_memory_metrics->tablet_meta_mem_peak_bytes);
+    registry->register_metric("column_pool_mem_peak_bytes", &_memory_metrics->column_pool_mem_peak_bytes);
+    registry->register_metric("storage_page_cache_mem_peak_bytes", &_memory_metrics->storage_page_cache_mem_peak_bytes);
+    registry->register_metric("update_mem_peak_bytes", &_memory_metrics->update_mem_peak_bytes);
+    registry->register_metric("chunk_allocator_mem_peak_bytes", &_memory_metrics->chunk_allocator_mem_peak_bytes);
 
     registry->register_metric("total_column_pool_bytes", &_memory_metrics->column_pool_total_bytes);
     registry->register_metric("local_column_pool_bytes", &_memory_metrics->column_pool_local_bytes);
@@ -306,18 +326,31 @@ void SystemMetrics::_update_memory_metrics() {
     (void)ext->GetNumericProperty("tcmalloc.pageheap_unmapped_bytes", &value);
     _memory_metrics->pageheap_unmapped_bytes.set_value(value);
 
+    size_t heap_size = 0;
+    (void)ext->GetNumericProperty("generic.heap_size", &heap_size);
+    int64_t mapped_bytes = static_cast<int64_t>(heap_size) - _memory_metrics->pageheap_unmapped_bytes.value();
+    _memory_metrics->fragmentation_bytes.set_value(
+            std::max<int64_t>(0, mapped_bytes - _memory_metrics->allocated_bytes.value()));
+
     if (ExecEnv::GetInstance()->process_mem_tracker() != nullptr) {
         _memory_metrics->process_mem_bytes.set_value(ExecEnv::GetInstance()->process_mem_tracker()->consumption());
+        _memory_metrics->process_mem_peak_bytes.set_value(
+                ExecEnv::GetInstance()->process_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->query_pool_mem_tracker() != nullptr) {
         _memory_metrics->query_mem_bytes.set_value(ExecEnv::GetInstance()->query_pool_mem_tracker()->consumption());
+        _memory_metrics->query_mem_peak_bytes.set_value(
+                ExecEnv::GetInstance()->query_pool_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->load_mem_tracker() != nullptr) {
         _memory_metrics->load_mem_bytes.set_value(ExecEnv::GetInstance()->load_mem_tracker()->consumption());
+        _memory_metrics->load_mem_peak_bytes.set_value(ExecEnv::GetInstance()->load_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->tablet_meta_mem_tracker() != nullptr) {
         _memory_metrics->tablet_meta_mem_bytes.set_value(
                 ExecEnv::GetInstance()->tablet_meta_mem_tracker()->consumption());
+        _memory_metrics->tablet_meta_mem_peak_bytes.set_value(
+                ExecEnv::GetInstance()->tablet_meta_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->compaction_mem_tracker() != nullptr) {
         _memory_metrics->compaction_mem_bytes.set_value(
@@ -330,13 +363,19 @@ void SystemMetrics::_update_memory_metrics() {
     if (ExecEnv::GetInstance()->page_cache_mem_tracker() != nullptr) {
         _memory_metrics->storage_page_cache_mem_bytes.set_value(
                 ExecEnv::GetInstance()->page_cache_mem_tracker()->consumption());
+        _memory_metrics->storage_page_cache_mem_peak_bytes.set_value(
+                ExecEnv::GetInstance()->page_cache_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->update_mem_tracker() != nullptr) {
         _memory_metrics->update_mem_bytes.set_value(ExecEnv::GetInstance()->update_mem_tracker()->consumption());
+        _memory_metrics->update_mem_peak_bytes.set_value(
+                ExecEnv::GetInstance()->update_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->chunk_allocator_mem_tracker() != nullptr) {
         _memory_metrics->chunk_allocator_mem_bytes.set_value(
                 ExecEnv::GetInstance()->chunk_allocator_mem_tracker()->consumption());
+        _memory_metrics->chunk_allocator_mem_peak_bytes.set_value(
+                ExecEnv::GetInstance()->chunk_allocator_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->clone_mem_tracker() != nullptr) {
         _memory_metrics->clone_mem_bytes.set_value(ExecEnv::GetInstance()->clone_mem_tracker()->consumption());
@@ -344,6 +383,8 @@ void SystemMetrics::_update_memory_metrics() {
     if (ExecEnv::GetInstance()->column_pool_mem_tracker() != nullptr) {
         _memory_metrics->column_pool_mem_bytes.set_value(
                 ExecEnv::GetInstance()->column_pool_mem_tracker()->consumption());
+        _memory_metrics->column_pool_mem_peak_bytes.set_value(
+                ExecEnv::GetInstance()->column_pool_mem_tracker()->peak_consumption());
     }
     if (ExecEnv::GetInstance()->consistency_mem_tracker() != nullptr) {
         _memory_metrics->consistency_mem_bytes.set_value(
@@ -419,6 +419,19 @@ public:
         return true;
     }
 
+    // add |n| values of weight 1, gives the same digest as adding the values one by one but without the call
+    // overhead per value.
+    void add(const Value* values, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            if (std::isnan(values[i])) {
+                continue;
+            }
+            _unprocessed.emplace_back(values[i], 1);
+            _unprocessed_weight += 1;
+            processIfNecessary();
+        }
+    }
+
     inline void add(std::vector<Centroid>::const_iterator iter, std::vector<Centroid>::const_iterator end) {
         while (iter != end) {
             const size_t diff = std::distance(iter, end);
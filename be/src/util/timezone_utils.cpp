@@ -22,6 +22,10 @@
 
 #include "util/timezone_utils.h"
 
+#include <algorithm>
+
+#include "cctz/civil_time.h"
+
 namespace starrocks {
 
 RE2 TimezoneUtils::time_zone_offset_format_reg(R"(^[+-]{1}\d{2}\:\d{2}$)");
@@ -103,4 +107,68 @@ int64_t TimezoneUtils::to_utc_offset(const cctz::time_zone& ctz) {
     return a.cs - b.cs;
 }
 
-} // namespace starrocks
\ No newline at end of file
+static cctz::time_point<cctz::seconds> to_time_point(int64_t seconds) {
+    return cctz::time_point<cctz::seconds>(cctz::seconds(seconds));
+}
+
+int TimezoneOffsetCache::_utc_interval(int64_t utc_seconds, int64_t* begin, int64_t* end) const {
+    const auto tp = to_time_point(utc_seconds);
+    const int offset = _ctz.lookup(tp).offset;
+    *begin = kMinSeconds;
+    *end = kMaxSeconds;
+    cctz::time_zone::civil_transition trans;
+    // the instant of a transition is the first one in the new offset
+    if (_ctz.prev_transition(tp + cctz::seconds(1), &trans)) {
+        *begin = _ctz.lookup(trans.to).post.time_since_epoch().count();
+    }
+    if (_ctz.next_transition(tp, &trans)) {
+        *end = _ctz.lookup(trans.to).post.time_since_epoch().count();
+    }
+    // the enumeration of the transitions is informational only in cctz, don't trust it blindly
+    bool valid = *begin <= utc_seconds && utc_seconds < *end;
+    valid = valid && (*begin == kMinSeconds || _ctz.lookup(to_time_point(*begin)).offset == offset);
+    valid = valid && (*end == kMaxSeconds || _ctz.lookup(to_time_point(*end - 1)).offset == offset);
+    if (!valid) {
+        *begin = utc_seconds;
+        *end = utc_seconds + 1;
+    }
+    return offset;
+}
+
+int64_t TimezoneOffsetCache::to_local(int64_t utc_seconds) {
+    if (utc_seconds < _utc_begin || utc_seconds >= _utc_end) {
+        _utc_offset = _utc_interval(utc_seconds, &_utc_begin, &_utc_end);
+    }
+    return utc_seconds + _utc_offset;
+}
+
+int64_t TimezoneOffsetCache::to_utc(int64_t local_seconds) {
+    if (local_seconds >= _local_begin && local_seconds < _local_end) {
+        return local_seconds - _local_offset;
+    }
+    static const cctz::civil_second epoch(1970, 1, 1, 0, 0, 0);
+    const auto cl = _ctz.lookup(epoch + local_seconds);
+    if (cl.kind == cctz::time_zone::civil_lookup::SKIPPED) {
+        return cl.trans.time_since_epoch().count();
+    }
+    const int64_t utc_seconds = cl.pre.time_since_epoch().count();
+    if (cl.kind == cctz::time_zone::civil_lookup::REPEATED) {
+        return utc_seconds;
+    }
+
+    int64_t begin, end;
+    const int offset = _utc_interval(utc_seconds, &begin, &end);
+    // the local times next to a transition to a smaller offset are repeated, they are not cached
+    _local_begin = kMinSeconds;
+    _local_end = kMaxSeconds;
+    if (begin != kMinSeconds) {
+        _local_begin = begin + std::max(offset, _ctz.lookup(to_time_point(begin - 1)).offset);
+    }
+    if (end != kMaxSeconds) {
+        _local_end = end + std::min(offset, _ctz.lookup(to_time_point(end)).offset);
+    }
+    _local_offset = offset;
+    return utc_seconds;
+}
+
+} // namespace starrocks
@@ -24,6 +24,8 @@
 
 #include <re2/re2.h>
 
+#include <limits>
+
 #include "cctz/time_zone.h"
 #include "util/timezone_hsscan.h"
 
@@ -43,4 +45,39 @@ private:
     // RE2 obj is thread safe
     static RE2 time_zone_offset_format_reg;
 };
+
+// TimezoneOffsetCache converts between the unix seconds and the local seconds (the civil time of the time
+// zone counted as if it were UTC) of a time zone. The offset is constant between two transitions of the
+// time zone, so the interval of the last lookup is cached and the close values of a column are converted
+// by an addition instead of a lookup of cctz.
+//
+// It's not thread safe.
+class TimezoneOffsetCache {
+public:
+    explicit TimezoneOffsetCache(const cctz::time_zone& ctz) : _ctz(ctz) {}
+
+    int64_t to_local(int64_t utc_seconds);
+
+    // Like cctz::convert(), a repeated local time is mapped to the earlier instant and a skipped local time
+    // to the instant of the transition.
+    int64_t to_utc(int64_t local_seconds);
+
+private:
+    static constexpr int64_t kMinSeconds = std::numeric_limits<int64_t>::min();
+    static constexpr int64_t kMaxSeconds = std::numeric_limits<int64_t>::max();
+
+    // Returns the offset at `utc_seconds` and sets [begin, end) to the utc interval around it with the same
+    // offset, or to the second itself if the transitions of the time zone are not known.
+    int _utc_interval(int64_t utc_seconds, int64_t* begin, int64_t* end) const;
+
+    cctz::time_zone _ctz;
+    // empty until the first lookup
+    int64_t _utc_begin = 0;
+    int64_t _utc_end = 0;
+    int64_t _utc_offset = 0;
+    int64_t _local_begin = 0;
+    int64_t _local_end = 0;
+    int64_t _local_offset = 0;
+};
+
 } // namespace starrocks
\ No newline at end of file
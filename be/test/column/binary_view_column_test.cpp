@@ -0,0 +1,138 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/binary_view_column.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "testutil/parallel_test.h"
+
+namespace starrocks::vectorized {
+
+static const std::vector<std::string> kStrings = {"",
+                                                  "a",
+                                                  "abcd",
+                                                  "abcdefghijkl",
+                                                  "abcdefghijklm",
+                                                  "abce",
+                                                  std::string("ab\0c", 4),
+                                                  "a long string which is kept in the buffers",
+                                                  std::string(100000, 'x')};
+
+static BinaryViewColumn::Ptr create_column(const std::vector<std::string>& strs) {
+    auto column = BinaryViewColumn::create();
+    for (const auto& s : strs) {
+        column->append(Slice(s));
+    }
+    return column;
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryViewColumnTest, test_append) {
+    auto column = create_column(kStrings);
+    ASSERT_EQ(kStrings.size(), column->size());
+    for (size_t i = 0; i < kStrings.size(); i++) {
+        ASSERT_EQ(kStrings[i], column->get_slice(i).to_string());
+        ASSERT_EQ(kStrings[i].size() <= BinaryView::kInlineSize, column->get_data()[i].is_inline());
+    }
+    // the strings longer than the buffer get their own buffer
+    ASSERT_EQ(2, column->num_buffers());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryViewColumnTest, test_filter_shares_buffers) {
+    auto column = create_column(kStrings);
+    const char* long_string = column->get_slice(7).data;
+
+    Column::Filter filter(kStrings.size(), 0);
+    filter[1] = 1;
+    filter[7] = 1;
+    ASSERT_EQ(2, column->filter(filter));
+    ASSERT_EQ("a", column->get_slice(0).to_string());
+    ASSERT_EQ(kStrings[7], column->get_slice(1).to_string());
+    ASSERT_EQ(long_string, column->get_slice(1).data);
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryViewColumnTest, test_append_selective) {
+    auto src = create_column(kStrings);
+    auto dst = BinaryViewColumn::create();
+    std::vector<uint32_t> indexes = {8, 7, 3, 7};
+    dst->append_selective(*src, indexes);
+    dst->append(*src, 4, 2);
+    dst->append_value_multiple_times(*src, 7, 2);
+
+    std::vector<std::string> expected = {kStrings[8], kStrings[7], kStrings[3], kStrings[7],
+                                         kStrings[4], kStrings[5], kStrings[7], kStrings[7]};
+    ASSERT_EQ(expected.size(), dst->size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i], dst->get_slice(i).to_string());
+    }
+    // the long strings are not copied
+    ASSERT_EQ(src->get_slice(7).data, dst->get_slice(1).data);
+    ASSERT_EQ(src->num_buffers(), dst->num_buffers());
+
+    // the buffers outlive the source column
+    src.reset();
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i], dst->get_slice(i).to_string());
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryViewColumnTest, test_update_rows) {
+    auto column = create_column({"a", "b", "c"});
+    auto src = create_column({"a string longer than twelve bytes", "d"});
+    std::vector<uint32_t> indexes = {0, 2};
+    ASSERT_TRUE(column->update_rows(*src, indexes.data()).ok());
+    ASSERT_EQ("['a string longer than twelve bytes', 'b', 'd']", column->debug_string());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryViewColumnTest, test_compare) {
+    auto column = create_column(kStrings);
+    for (size_t i = 0; i < kStrings.size(); i++) {
+        for (size_t j = 0; j < kStrings.size(); j++) {
+            int expected = Slice(kStrings[i]).compare(Slice(kStrings[j]));
+            int actual = column->compare_at(i, j, *column, -1);
+            ASSERT_EQ(expected < 0, actual < 0) << i << " " << j;
+            ASSERT_EQ(expected > 0, actual > 0) << i << " " << j;
+            ASSERT_EQ(expected == 0, column->equals(i, *column, j)) << i << " " << j;
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryViewColumnTest, test_same_as_binary_column) {
+    auto binary = BinaryColumn::create();
+    for (const auto& s : kStrings) {
+        binary->append(Slice(s));
+    }
+    auto column = BinaryViewColumn::create();
+    column->append_binary(*binary);
+    ASSERT_EQ(binary->size(), column->size());
+
+    std::vector<uint32_t> hashes(kStrings.size(), 1);
+    std::vector<uint32_t> expected_hashes(kStrings.size(), 1);
+    column->fnv_hash(hashes.data(), 0, hashes.size());
+    binary->fnv_hash(expected_hashes.data(), 0, expected_hashes.size());
+    ASSERT_EQ(expected_hashes, hashes);
+    column->crc32_hash(hashes.data(), 0, hashes.size());
+    binary->crc32_hash(expected_hashes.data(), 0, expected_hashes.size());
+    ASSERT_EQ(expected_hashes, hashes);
+
+    std::vector<uint8_t> buffer(binary->max_one_element_serialize_size());
+    std::vector<uint8_t> expected_buffer(buffer.size());
+    auto copy = BinaryViewColumn::create();
+    for (size_t i = 0; i < kStrings.size(); i++) {
+        ASSERT_EQ(binary->serialize(i, expected_buffer.data()), column->serialize(i, buffer.data()));
+        ASSERT_EQ(0, memcmp(expected_buffer.data(), buffer.data(), column->serialize_size(i)));
+        copy->deserialize_and_append(buffer.data());
+    }
+
+    auto back = BinaryColumn::create();
+    copy->to_binary(back.get());
+    ASSERT_EQ(binary->debug_string(), back->debug_string());
+}
+
+} // namespace starrocks::vectorized
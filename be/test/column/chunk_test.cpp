@@ -25,6 +25,7 @@
 
 #include "column/field.h"
 #include "column/fixed_length_column.h"
+#include "util/hash_util.hpp"
 
 namespace starrocks::vectorized {
 
@@ -235,4 +236,43 @@ TEST_F(ChunkTest, test_clone_unique) {
     ASSERT_EQ(copy->num_rows(), chunk->num_rows());
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_hash_cache) {
+    auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
+    const Columns keys{chunk->get_column_by_index(1)};
+
+    std::vector<uint32_t> expected(100, HashUtil::FNV_SEED);
+    keys[0]->fnv_hash(expected.data(), 0, 100);
+    std::vector<uint32_t> hashes;
+    chunk->hash_columns(keys, Chunk::HashAlgorithm::FNV, &hashes);
+    ASSERT_EQ(expected, hashes);
+    ASSERT_EQ(nullptr, chunk->cached_hashes(keys, Chunk::HashAlgorithm::FNV));
+
+    // only the columns of the chunk are cached
+    ASSERT_EQ(nullptr, chunk->cache_hashes({make_column(1)}, Chunk::HashAlgorithm::FNV, std::vector<uint32_t>(hashes)));
+    ASSERT_NE(nullptr, chunk->cache_hashes(keys, Chunk::HashAlgorithm::FNV, std::move(hashes)));
+    ASSERT_EQ(nullptr, chunk->cached_hashes(keys, Chunk::HashAlgorithm::CRC32));
+    ASSERT_EQ(nullptr, chunk->cached_hashes(chunk->columns(), Chunk::HashAlgorithm::FNV));
+
+    // the cached hashes are filtered with the rows
+    Buffer<uint8_t> selection(100, 0);
+    std::vector<uint32_t> filtered;
+    for (size_t i = 0; i < 100; i += 3) {
+        selection[i] = 1;
+        filtered.push_back(expected[i]);
+    }
+    chunk->filter(selection);
+    const auto* cached = chunk->cached_hashes(keys, Chunk::HashAlgorithm::FNV);
+    ASSERT_NE(nullptr, cached);
+    ASSERT_EQ(filtered, *cached);
+
+    hashes.clear();
+    chunk->hash_columns(keys, Chunk::HashAlgorithm::FNV, &hashes);
+    ASSERT_EQ(filtered, hashes);
+
+    // and dropped if the rows are changed otherwise
+    chunk->set_num_rows(10);
+    ASSERT_EQ(nullptr, chunk->cached_hashes(keys, Chunk::HashAlgorithm::FNV));
+}
+
 } // namespace starrocks::vectorized
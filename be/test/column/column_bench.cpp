@@ -0,0 +1,86 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of Column::filter() and Column::append_selective() of the int, binary and nullable columns.
+// Usage: column_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::vectorized {
+
+static constexpr uint32_t kNumRows = 4096;
+
+enum ColumnKind { kInt64 = 0, kBinary = 1, kNullableInt64 = 2 };
+
+static ColumnPtr make_column(int kind, std::mt19937* rng) {
+    auto int_column = Int64Column::create();
+    auto binary_column = BinaryColumn::create();
+    auto null_column = NullColumn::create();
+    for (uint32_t i = 0; i < kNumRows; i++) {
+        int_column->append(static_cast<int64_t>((*rng)()));
+        binary_column->append("value_" + std::to_string((*rng)()));
+        null_column->append((*rng)() % 10 == 0);
+    }
+    switch (kind) {
+    case kInt64:
+        return int_column;
+    case kBinary:
+        return binary_column;
+    default:
+        return NullableColumn::create(int_column, null_column);
+    }
+}
+
+// The filter keeps |selectivity| percent of the rows.
+static void BM_column_filter(benchmark::State& state) {
+    std::mt19937 rng(state.range(0));
+    auto src = make_column(state.range(0), &rng);
+    Column::Filter filter(kNumRows);
+    for (auto& f : filter) {
+        f = rng() % 100 < state.range(1);
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto column = src->clone();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(column->filter(filter));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Append the rows at the random indexes of the source column, as the hash join and the shuffle do.
+static void BM_column_append_selective(benchmark::State& state) {
+    std::mt19937 rng(state.range(0));
+    auto src = make_column(state.range(0), &rng);
+    std::vector<uint32_t> indexes(kNumRows);
+    for (auto& index : indexes) {
+        index = rng() % kNumRows;
+    }
+    auto dst = src->clone_empty();
+    for (auto _ : state) {
+        dst->reset_column();
+        dst->append_selective(*src, indexes.data(), 0, kNumRows);
+        benchmark::DoNotOptimize(dst->size());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+static void filter_args(benchmark::internal::Benchmark* b) {
+    for (int kind : {kInt64, kBinary, kNullableInt64}) {
+        for (int selectivity : {10, 50, 90}) {
+            b->Args({kind, selectivity});
+        }
+    }
+}
+
+BENCHMARK(BM_column_filter)->Apply(filter_args);
+BENCHMARK(BM_column_append_selective)->Arg(kInt64)->Arg(kBinary)->Arg(kNullableInt64);
+
+} // namespace starrocks::vectorized
+
+BENCHMARK_MAIN();
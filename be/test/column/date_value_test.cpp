@@ -267,5 +267,14 @@ TEST(DateValueTest, weekday) {
     ASSERT_EQ(0, dv.weekday()); // Sunday
 }
 
+TEST(DateValueTest, toStringBuffer) {
+    DateValue dv = DateValue::create(2020, 6, 7);
+    char s[DateValue::max_string_length()];
+    ASSERT_EQ(10, dv.to_string(s, sizeof(s)));
+    ASSERT_EQ("2020-06-07", std::string(s, 10));
+    ASSERT_EQ(dv.to_string(), std::string(s, 10));
+    ASSERT_EQ(-1, dv.to_string(s, 9));
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -0,0 +1,110 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/fixed_value_set.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+template <typename T>
+static void check_same_as(const FixedValueSet<T>& set, const std::set<T>& expected, const std::vector<T>& probes) {
+    ASSERT_EQ(expected.size(), set.size());
+    for (const T& v : expected) {
+        ASSERT_TRUE(set.contains(v));
+    }
+    std::vector<uint8_t> found(probes.size());
+    set.contains(probes.data(), probes.size(), found.data());
+    for (size_t i = 0; i < probes.size(); i++) {
+        ASSERT_EQ(expected.count(probes[i]), found[i]) << i;
+        ASSERT_EQ(expected.count(probes[i]), set.contains(probes[i])) << i;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(FixedValueSetTest, linear) {
+    FixedValueSet<int32_t> set;
+    ASSERT_FALSE(set.contains(0));
+
+    std::set<int32_t> expected;
+    for (int32_t v : {-7, 3, 1000000, 3, std::numeric_limits<int32_t>::min()}) {
+        set.emplace(v);
+        expected.insert(v);
+    }
+    ASSERT_EQ(FixedValueSet<int32_t>::Kind::LINEAR, set.kind());
+    check_same_as(set, expected, {-7, 3, 4, 0, 1000000, std::numeric_limits<int32_t>::min(), -8});
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.contains(3));
+}
+
+// NOLINTNEXTLINE
+TEST(FixedValueSetTest, bitmap) {
+    FixedValueSet<int64_t> set;
+    std::set<int64_t> expected;
+    // the values grow the range one by one
+    const int64_t base = std::numeric_limits<int64_t>::max() - 50000;
+    for (int64_t i = 0; i < 50000; i += 3) {
+        set.emplace(base + i);
+        expected.insert(base + i);
+    }
+    ASSERT_EQ(FixedValueSet<int64_t>::Kind::BITMAP, set.kind());
+
+    std::vector<int64_t> probes;
+    for (int64_t i = -100; i <= 50000; i++) {
+        probes.emplace_back(base + i);
+    }
+    probes.emplace_back(std::numeric_limits<int64_t>::min());
+    probes.emplace_back(0);
+    check_same_as(set, expected, probes);
+
+    // out of the range of the bitmap
+    set.emplace(0);
+    expected.insert(0);
+    ASSERT_EQ(FixedValueSet<int64_t>::Kind::HASH, set.kind());
+    check_same_as(set, expected, probes);
+}
+
+// NOLINTNEXTLINE
+TEST(FixedValueSetTest, hash) {
+    std::mt19937_64 rng(0);
+    FixedValueSet<int64_t> set;
+    std::set<int64_t> expected;
+    // large enough to be probed with the prefetching
+    for (int i = 0; i < 100000; i++) {
+        int64_t v = rng();
+        set.emplace(v);
+        expected.insert(v);
+    }
+    ASSERT_EQ(FixedValueSet<int64_t>::Kind::HASH, set.kind());
+
+    std::vector<int64_t> probes;
+    auto it = expected.begin();
+    for (int i = 0; i < 10000; i++) {
+        probes.emplace_back(i % 2 == 0 ? static_cast<int64_t>(rng()) : *it++);
+    }
+    check_same_as(set, expected, probes);
+}
+
+// NOLINTNEXTLINE
+TEST(FixedValueSetTest, small_types) {
+    FixedValueSet<int8_t> set;
+    std::set<int8_t> expected;
+    std::vector<int8_t> probes;
+    for (int v = -128; v < 128; v++) {
+        if (v % 5 == 0) {
+            set.emplace(v);
+            expected.insert(v);
+        }
+        probes.emplace_back(v);
+    }
+    ASSERT_EQ(FixedValueSet<int8_t>::Kind::BITMAP, set.kind());
+    check_same_as(set, expected, probes);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,112 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/low_cardinality_column.h"
+
+#include <gtest/gtest.h>
+
+#include "testutil/parallel_test.h"
+
+namespace starrocks::vectorized {
+
+static BinaryColumn::Ptr create_binary(const std::vector<std::string>& strs) {
+    auto column = BinaryColumn::create();
+    for (const auto& s : strs) {
+        column->append(Slice(s));
+    }
+    return column;
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(LowCardinalityColumnTest, test_dictionary) {
+    auto sorted = LowCardDictionary::create({"a", "b", "c"});
+    ASSERT_TRUE(sorted->sorted());
+    ASSERT_EQ(3, sorted->size());
+    ASSERT_EQ(1, sorted->find("b"));
+    ASSERT_EQ(-1, sorted->find("d"));
+
+    auto unsorted = LowCardDictionary::create({"b", "a"});
+    ASSERT_FALSE(unsorted->sorted());
+    ASSERT_EQ("a", unsorted->get(1).to_string());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(LowCardinalityColumnTest, test_encode_decode) {
+    auto dict = LowCardDictionary::create({"beijing", "shanghai", "hangzhou"});
+    auto binary = create_binary({"hangzhou", "beijing", "hangzhou", "shanghai"});
+    auto column = LowCardinalityColumn::encode(dict, *binary);
+    ASSERT_TRUE(column != nullptr);
+    ASSERT_TRUE(column->low_cardinality());
+    ASSERT_EQ(4, column->size());
+    ASSERT_EQ(2, column->get_code(0));
+    ASSERT_EQ(binary->debug_string(), column->decode()->debug_string());
+
+    ASSERT_TRUE(LowCardinalityColumn::encode(dict, *create_binary({"beijing", "shenzhen"})) == nullptr);
+    ASSERT_FALSE(column->append_strings({Slice("beijing"), Slice("shenzhen")}));
+    ASSERT_EQ(4, column->size());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(LowCardinalityColumnTest, test_filter_and_gather) {
+    auto dict = LowCardDictionary::create({"x", "y", "z"});
+    auto column = LowCardinalityColumn::encode(dict, *create_binary({"x", "y", "z", "x", "y"}));
+
+    auto gathered = column->clone_empty();
+    std::vector<uint32_t> indexes = {4, 2, 0};
+    gathered->append_selective(*column, indexes);
+    gathered->append(*column, 1, 2);
+    gathered->append_value_multiple_times(*column, 2, 2);
+    ASSERT_EQ("['y', 'z', 'x', 'y', 'z', 'z', 'z']", gathered->debug_string());
+
+    Column::Filter filter = {1, 0, 0, 1, 1, 0, 1};
+    ASSERT_EQ(4, gathered->filter(filter));
+    ASSERT_EQ("['y', 'y', 'z', 'z']", gathered->debug_string());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(LowCardinalityColumnTest, test_compare) {
+    std::vector<std::string> values = {"b", "a", "c", ""};
+    auto sorted = LowCardDictionary::create({"", "a", "b", "c"});
+    auto unsorted = LowCardDictionary::create({"c", "b", "a", ""});
+    for (const auto& dict : {sorted, unsorted}) {
+        auto column = LowCardinalityColumn::encode(dict, *create_binary(values));
+        ASSERT_TRUE(column != nullptr);
+        for (size_t i = 0; i < values.size(); i++) {
+            for (size_t j = 0; j < values.size(); j++) {
+                int expected = Slice(values[i]).compare(Slice(values[j]));
+                int actual = column->compare_at(i, j, *column, -1);
+                ASSERT_EQ(expected < 0, actual < 0);
+                ASSERT_EQ(expected > 0, actual > 0);
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(LowCardinalityColumnTest, test_same_as_binary_column) {
+    std::vector<std::string> values = {"", "abc", "abcdefghijklmnopq", "abc"};
+    auto dict = LowCardDictionary::create({"abcdefghijklmnopq", "abc", ""});
+    auto binary = create_binary(values);
+    auto column = LowCardinalityColumn::encode(dict, *binary);
+
+    std::vector<uint32_t> hashes(values.size(), 1);
+    std::vector<uint32_t> expected_hashes(values.size(), 1);
+    column->fnv_hash(hashes.data(), 0, hashes.size());
+    binary->fnv_hash(expected_hashes.data(), 0, expected_hashes.size());
+    ASSERT_EQ(expected_hashes, hashes);
+    column->crc32_hash(hashes.data(), 0, hashes.size());
+    binary->crc32_hash(expected_hashes.data(), 0, expected_hashes.size());
+    ASSERT_EQ(expected_hashes, hashes);
+
+    ASSERT_EQ(binary->max_one_element_serialize_size(), column->max_one_element_serialize_size());
+    std::vector<uint8_t> buffer(column->max_one_element_serialize_size());
+    std::vector<uint8_t> expected_buffer(buffer.size());
+    auto copy = column->clone_empty();
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(binary->serialize(i, expected_buffer.data()), column->serialize(i, buffer.data()));
+        ASSERT_EQ(0, memcmp(expected_buffer.data(), buffer.data(), column->serialize_size(i)));
+        copy->deserialize_and_append(buffer.data());
+    }
+    ASSERT_EQ(binary->debug_string(), copy->debug_string());
+}
+
+} // namespace starrocks::vectorized
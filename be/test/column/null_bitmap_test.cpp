@@ -0,0 +1,112 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/null_bitmap.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace starrocks::vectorized {
+
+static std::vector<uint8_t> random_bytes(size_t size, uint32_t one_in, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes(size);
+    for (auto& b : bytes) {
+        b = rng() % one_in == 0;
+    }
+    return bytes;
+}
+
+static std::vector<uint8_t> unpack(const NullBitmap& bitmap) {
+    std::vector<uint8_t> bytes(bitmap.size());
+    bitmap.to_bytes(0, bitmap.size(), bytes.data());
+    return bytes;
+}
+
+// NOLINTNEXTLINE
+TEST(NullBitmapTest, test_pack_unpack) {
+    for (size_t size : {0, 1, 63, 64, 65, 200, 4096 + 13}) {
+        auto nulls = random_bytes(size, 3, size);
+        NullBitmap bitmap(nulls.data(), nulls.size());
+        ASSERT_EQ(size, bitmap.size());
+        ASSERT_EQ(nulls, unpack(bitmap));
+        ASSERT_EQ(std::count(nulls.begin(), nulls.end(), 1), bitmap.null_count());
+        ASSERT_EQ(bitmap.null_count() > 0, bitmap.has_null());
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(nulls[i] != 0, bitmap.is_null(i));
+        }
+
+        // the unaligned ranges
+        if (size > 70) {
+            std::vector<uint8_t> range(size - 70);
+            bitmap.to_bytes(5, range.size(), range.data());
+            ASSERT_TRUE(std::equal(range.begin(), range.end(), nulls.begin() + 5));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(NullBitmapTest, test_append) {
+    auto nulls = random_bytes(1000, 2, 7);
+    NullBitmap bitmap;
+    std::vector<uint8_t> expected;
+    size_t pos = 0;
+    for (size_t n : {3, 61, 64, 100, 1, 250}) {
+        bitmap.append(nulls.data() + pos, n);
+        expected.insert(expected.end(), nulls.begin() + pos, nulls.begin() + pos + n);
+        pos += n;
+    }
+    bitmap.append(true, 70);
+    expected.insert(expected.end(), 70, 1);
+    bitmap.append(false, 10);
+    expected.insert(expected.end(), 10, 0);
+    ASSERT_EQ(expected, unpack(bitmap));
+
+    bitmap.resize(100);
+    expected.resize(100);
+    ASSERT_EQ(expected, unpack(bitmap));
+    bitmap.resize(130);
+    expected.resize(130, 0);
+    ASSERT_EQ(expected, unpack(bitmap));
+
+    std::vector<uint32_t> indexes{129, 0, 5, 5, 64, 99, 3};
+    NullBitmap selected;
+    selected.append_selective(bitmap, indexes.data(), 1, 5);
+    ASSERT_EQ(5, selected.size());
+    for (size_t i = 0; i < 5; i++) {
+        ASSERT_EQ(expected[indexes[i + 1]] != 0, selected.is_null(i));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(NullBitmapTest, test_filter) {
+    for (size_t size : {10, 64, 1000, 4099}) {
+        auto nulls = random_bytes(size, 3, size);
+        NullBitmap bitmap(nulls.data(), nulls.size());
+
+        Column::Filter filter(size);
+        auto selected = random_bytes(size, 2, size + 1);
+        std::copy(selected.begin(), selected.end(), filter.begin());
+        std::fill(filter.begin(), filter.begin() + std::min<size_t>(size, 64), 1);
+
+        // mask_filter
+        Column::Filter masked(filter);
+        bitmap.mask_filter(masked.data());
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(filter[i] && !nulls[i], masked[i] != 0);
+        }
+
+        // filter
+        std::vector<uint8_t> expected;
+        for (size_t i = 0; i < size; i++) {
+            if (filter[i]) {
+                expected.push_back(nulls[i]);
+            }
+        }
+        ASSERT_EQ(expected.size(), bitmap.filter(filter));
+        ASSERT_EQ(expected, unpack(bitmap));
+        ASSERT_EQ(std::count(expected.begin(), expected.end(), 1), bitmap.null_count());
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,121 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "column/rle_column.h"
+
+#include <gtest/gtest.h>
+
+#include "column/fixed_length_column.h"
+#include "testutil/parallel_test.h"
+
+namespace starrocks::vectorized {
+
+static Int32Column::Ptr create_runs(const std::vector<std::pair<int32_t, size_t>>& runs) {
+    auto column = Int32Column::create();
+    for (const auto& [value, length] : runs) {
+        for (size_t i = 0; i < length; i++) {
+            column->append(value);
+        }
+    }
+    return column;
+}
+
+static void check_same(const Column& expected, const RleColumn& column) {
+    ASSERT_EQ(expected.size(), column.size());
+    auto decoded = column.decode();
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected.debug_item(i), decoded->debug_item(i)) << i;
+        ASSERT_EQ(expected.debug_item(i), column.debug_item(i)) << i;
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(RleColumnTest, test_encode) {
+    auto src = create_runs({{1, 3}, {2, 2}, {3, 1}});
+    auto column = RleColumn::encode(*src);
+    ASSERT_TRUE(column->is_rle());
+    ASSERT_EQ(3, column->num_runs());
+    ASSERT_EQ("RLE: [1 x 3, 2 x 2, 3 x 1]", column->debug_string());
+    ASSERT_EQ(0, column->run_of(2));
+    ASSERT_EQ(1, column->run_of(3));
+    ASSERT_EQ(2, column->run_of(5));
+    check_same(*src, *column);
+
+    column->append_default(2);
+    ASSERT_EQ("RLE: [1 x 3, 2 x 2, 3 x 1, 0 x 2]", column->debug_string());
+    column->resize(4);
+    ASSERT_EQ("RLE: [1 x 3, 2 x 1]", column->debug_string());
+    column->remove_first_n_values(2);
+    ASSERT_EQ("RLE: [1 x 1, 2 x 1]", column->debug_string());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(RleColumnTest, test_filter) {
+    auto src = create_runs({{1, 5}, {2, 3}, {3, 4}, {4, 2}});
+    for (size_t from : {0, 3, 6}) {
+        Column::Filter filter = {1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 1, 1, 1};
+        auto expected = src->clone();
+        auto column = RleColumn::encode(*src);
+        size_t expected_size = expected->filter_range(filter, from, filter.size());
+        ASSERT_EQ(expected_size, column->filter_range(filter, from, filter.size()));
+        check_same(*expected, *column);
+    }
+
+    // the runs are kept whole
+    auto column = RleColumn::encode(*src);
+    Column::Filter filter = {0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1, 1};
+    ASSERT_EQ(5, column->filter(filter));
+    ASSERT_EQ("RLE: [2 x 3, 4 x 2]", column->debug_string());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(RleColumnTest, test_append) {
+    auto src = create_runs({{1, 5}, {2, 3}, {3, 4}});
+    auto rle_src = RleColumn::encode(*src);
+
+    auto expected = src->clone_empty();
+    auto column = rle_src->clone_empty();
+    std::vector<uint32_t> indexes = {0, 1, 2, 7, 8, 11, 0};
+    expected->append_selective(*src, indexes);
+    column->append_selective(*rle_src, indexes);
+    expected->append(*src, 3, 7);
+    column->append(*rle_src, 3, 7);
+    expected->append_value_multiple_times(*src, 9, 3);
+    column->append_value_multiple_times(*rle_src, 9, 3);
+    check_same(*expected, down_cast<const RleColumn&>(*column));
+    ASSERT_EQ("RLE: [1 x 3, 2 x 1, 3 x 2, 1 x 1, 1 x 2, 2 x 3, 3 x 2, 3 x 3]", column->debug_string());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(RleColumnTest, test_hash_and_serialize) {
+    auto src = create_runs({{7, 4}, {8, 1}, {9, 3}});
+    auto column = RleColumn::encode(*src);
+
+    std::vector<uint32_t> hashes(src->size(), 1);
+    std::vector<uint32_t> expected_hashes(src->size(), 1);
+    column->fnv_hash(hashes.data(), 2, 7);
+    src->fnv_hash(expected_hashes.data(), 2, 7);
+    ASSERT_EQ(expected_hashes, hashes);
+    column->crc32_hash(hashes.data(), 0, hashes.size());
+    src->crc32_hash(expected_hashes.data(), 0, expected_hashes.size());
+    ASSERT_EQ(expected_hashes, hashes);
+
+    uint32_t max_size = column->max_one_element_serialize_size();
+    std::vector<uint8_t> buffer(max_size * src->size());
+    std::vector<uint8_t> expected_buffer(buffer.size());
+    Buffer<uint32_t> sizes(src->size(), 0);
+    Buffer<uint32_t> expected_sizes(src->size(), 0);
+    column->serialize_batch(buffer.data(), sizes, src->size(), max_size);
+    src->serialize_batch(expected_buffer.data(), expected_sizes, src->size(), max_size);
+    ASSERT_EQ(expected_sizes, sizes);
+    for (size_t i = 0; i < src->size(); i++) {
+        ASSERT_EQ(0, memcmp(expected_buffer.data() + i * max_size, buffer.data() + i * max_size, sizes[i]));
+    }
+
+    for (size_t i = 0; i < src->size(); i++) {
+        for (size_t j = 0; j < src->size(); j++) {
+            ASSERT_EQ(src->compare_at(i, j, *src, 1), column->compare_at(i, j, *column, 1));
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
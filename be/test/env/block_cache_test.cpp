@@ -0,0 +1,121 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "env/block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env.h"
+#include "testutil/assert.h"
+#include "util/file_utils.h"
+
+namespace starrocks {
+
+static const std::string kCacheDir = "./ut_dir/block_cache"; // NOLINT
+
+class BlockCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(FileUtils::create_dir("./ut_dir").ok());
+        for (size_t i = 0; i < _file.size(); i++) {
+            _file[i] = static_cast<char>(i * 31 + 7);
+        }
+    }
+
+    void TearDown() override { ASSERT_TRUE(FileUtils::remove_all("./ut_dir").ok()); }
+
+    BlockCache::ReadFunc read_fn() {
+        return [this](uint64_t offset, const Slice& buf) {
+            _remote_bytes += buf.size;
+            memcpy(buf.data, _file.data() + offset, buf.size);
+            return Status::OK();
+        };
+    }
+
+    std::string _file = std::string(10000, '\0');
+    int64_t _remote_bytes = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, read_through) {
+    std::string buf(3000, '\0');
+    {
+        BlockCache cache;
+        ASSERT_OK(cache.init({kCacheDir}, 1024 * 1024, 1024, 1));
+        int64_t hit_bytes = 0;
+        ASSERT_OK(cache.read("file:10000", _file.size(), 1500, Slice(buf), read_fn(), &hit_bytes));
+        ASSERT_EQ(_file.substr(1500, 3000), buf);
+        ASSERT_EQ(0, hit_bytes);
+        // blocks [1024, 5120) are read in whole
+        ASSERT_EQ(4096, _remote_bytes);
+        cache.close();
+    }
+
+    // the blocks are still there after restart
+    BlockCache cache;
+    ASSERT_OK(cache.init({kCacheDir}, 1024 * 1024, 1024, 1));
+    ASSERT_GT(cache.usage(), 4096);
+    _remote_bytes = 0;
+    int64_t hit_bytes = 0;
+    std::fill(buf.begin(), buf.end(), '\0');
+    ASSERT_OK(cache.read("file:10000", _file.size(), 1500, Slice(buf), read_fn(), &hit_bytes));
+    ASSERT_EQ(_file.substr(1500, 3000), buf);
+    ASSERT_EQ(3000, hit_bytes);
+    ASSERT_EQ(0, _remote_bytes);
+
+    // the last block is shorter
+    std::string tail(600, '\0');
+    ASSERT_OK(cache.read("file:10000", _file.size(), 9400, Slice(tail), read_fn(), &hit_bytes));
+    ASSERT_EQ(_file.substr(9400), tail);
+    ASSERT_EQ(10000 - 9216, _remote_bytes);
+
+    // another file
+    ASSERT_TRUE(cache.read_block("file:20000", 1, &buf).is_not_found());
+    ASSERT_TRUE(cache.read("file:10000", _file.size(), 9400, Slice(buf), read_fn(), &hit_bytes).is_invalid_argument());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, corrupted_block) {
+    BlockCache cache;
+    ASSERT_OK(cache.init({kCacheDir}, 1024 * 1024, 1024, 1));
+    ASSERT_OK(cache.write_block("file", 0, Slice(_file.data(), 1024)));
+    std::string data;
+    ASSERT_OK(cache.read_block("file", 0, &data));
+    ASSERT_EQ(_file.substr(0, 1024), data);
+
+    std::vector<std::string> names;
+    ASSERT_OK(Env::Default()->get_children(kCacheDir, &names));
+    for (const auto& name : names) {
+        if (name == "." || name == "..") {
+            continue;
+        }
+        RandomRWFileOptions opts;
+        opts.mode = Env::MUST_EXIST;
+        std::unique_ptr<RandomRWFile> file;
+        ASSERT_OK(Env::Default()->new_random_rw_file(opts, kCacheDir + "/" + name, &file));
+        ASSERT_OK(file->write_at(100, Slice("corrupted")));
+        ASSERT_OK(file->close());
+    }
+    ASSERT_TRUE(cache.read_block("file", 0, &data).is_not_found());
+    ASSERT_EQ(0, cache.usage());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, evict) {
+    BlockCache cache;
+    // holds 3 blocks
+    ASSERT_OK(cache.init({kCacheDir}, 3 * (1024 + 100), 1024, 1));
+    for (int i = 0; i < 3; i++) {
+        ASSERT_OK(cache.write_block("file", i, Slice(_file.data() + i * 1024, 1024)));
+    }
+    std::string data;
+    // block 0 becomes the most recently used
+    ASSERT_OK(cache.read_block("file", 0, &data));
+    ASSERT_OK(cache.write_block("file", 3, Slice(_file.data() + 3 * 1024, 1024)));
+    ASSERT_LE(cache.usage(), 3 * (1024 + 100));
+    ASSERT_OK(cache.read_block("file", 0, &data));
+    ASSERT_TRUE(cache.read_block("file", 1, &data).is_not_found());
+    ASSERT_OK(cache.read_block("file", 2, &data));
+    ASSERT_OK(cache.read_block("file", 3, &data));
+}
+
+} // namespace starrocks
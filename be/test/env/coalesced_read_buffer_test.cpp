@@ -0,0 +1,135 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "env/coalesced_read_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+
+#include "common/config.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class CoalescedReadBufferTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _old_gap = config::hdfs_io_coalesce_gap_bytes;
+        _old_max = config::hdfs_io_coalesce_max_bytes;
+        config::hdfs_io_coalesce_gap_bytes = 100;
+        config::hdfs_io_coalesce_max_bytes = 1000;
+        for (size_t i = 0; i < _file.size(); i++) {
+            _file[i] = static_cast<char>(i * 31 + 7);
+        }
+    }
+
+    void TearDown() override {
+        config::hdfs_io_coalesce_gap_bytes = _old_gap;
+        config::hdfs_io_coalesce_max_bytes = _old_max;
+    }
+
+    CoalescedReadBuffer::ReadFunc read_fn() {
+        return [this](uint64_t offset, const Slice& buf) {
+            std::lock_guard<std::mutex> l(_mutex);
+            _reads.emplace_back(IORange{offset, buf.size});
+            memcpy(buf.data, _file.data() + offset, buf.size);
+            return Status::OK();
+        };
+    }
+
+    std::string _file = std::string(10000, '\0');
+    std::mutex _mutex;
+    std::vector<IORange> _reads;
+    int64_t _old_gap = 0;
+    int64_t _old_max = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CoalescedReadBufferTest, coalesce) {
+    CoalescedReadBuffer buffer(read_fn());
+    // [0, 100) and [150, 300) are merged, [500, 600) is too far away, [700, 1800) is too large
+    buffer.set_io_ranges({{150, 150}, {0, 100}, {500, 100}, {700, 1100}});
+    ASSERT_TRUE(_reads.empty());
+
+    std::string data(50, '\0');
+    ASSERT_TRUE(buffer.read(10, Slice(data)).value());
+    ASSERT_EQ(_file.substr(10, 50), data);
+    ASSERT_TRUE(buffer.read(200, Slice(data)).value());
+    ASSERT_EQ(_file.substr(200, 50), data);
+    ASSERT_EQ(1, _reads.size());
+    ASSERT_EQ(0, _reads[0].offset);
+    ASSERT_EQ(300, _reads[0].size);
+
+    ASSERT_TRUE(buffer.read(550, Slice(data)).value());
+    ASSERT_EQ(_file.substr(550, 50), data);
+    ASSERT_EQ(2, _reads.size());
+    ASSERT_EQ(500, _reads[1].offset);
+
+    // not planned, or crossing the end of a merged range
+    ASSERT_FALSE(buffer.read(800, Slice(data)).value());
+    ASSERT_FALSE(buffer.read(280, Slice(data)).value());
+    ASSERT_EQ(2, _reads.size());
+
+    int64_t served = 0;
+    int64_t issued = 0;
+    buffer.pop_io_counts(&served, &issued);
+    ASSERT_EQ(3, served);
+    ASSERT_EQ(2, issued);
+    buffer.pop_io_counts(&served, &issued);
+    ASSERT_EQ(0, served);
+    ASSERT_EQ(0, issued);
+
+    // the new ranges replace the old ones
+    buffer.set_io_ranges({{2000, 100}});
+    ASSERT_FALSE(buffer.read(10, Slice(data)).value());
+    ASSERT_TRUE(buffer.read(2010, Slice(data)).value());
+    ASSERT_EQ(_file.substr(2010, 50), data);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CoalescedReadBufferTest, parallel) {
+    int32_t old_parallel = config::hdfs_io_parallel_ranges;
+    config::hdfs_io_parallel_ranges = 3;
+    CoalescedReadBuffer buffer(read_fn(), true);
+    buffer.set_io_ranges({{0, 100}, {500, 100}, {1000, 100}, {1500, 100}});
+
+    // the first range and the next two ones are read at once
+    std::string data(50, '\0');
+    ASSERT_TRUE(buffer.read(10, Slice(data)).value());
+    ASSERT_EQ(_file.substr(10, 50), data);
+    ASSERT_EQ(3, _reads.size());
+    std::sort(_reads.begin(), _reads.end(),
+              [](const IORange& lhs, const IORange& rhs) { return lhs.offset < rhs.offset; });
+    ASSERT_EQ(0, _reads[0].offset);
+    ASSERT_EQ(500, _reads[1].offset);
+    ASSERT_EQ(1000, _reads[2].offset);
+
+    ASSERT_TRUE(buffer.read(1010, Slice(data)).value());
+    ASSERT_EQ(_file.substr(1010, 50), data);
+    ASSERT_EQ(3, _reads.size());
+    ASSERT_TRUE(buffer.read(1510, Slice(data)).value());
+    ASSERT_EQ(_file.substr(1510, 50), data);
+    ASSERT_EQ(4, _reads.size());
+    config::hdfs_io_parallel_ranges = old_parallel;
+}
+
+// NOLINTNEXTLINE
+TEST_F(CoalescedReadBufferTest, disabled) {
+    config::hdfs_io_coalesce_gap_bytes = 0;
+    CoalescedReadBuffer buffer(read_fn());
+    buffer.set_io_ranges({{0, 100}});
+    std::string data(50, '\0');
+    ASSERT_FALSE(buffer.read(10, Slice(data)).value());
+    ASSERT_TRUE(_reads.empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CoalescedReadBufferTest, read_error) {
+    CoalescedReadBuffer buffer([](uint64_t offset, const Slice& buf) { return Status::IOError("injected"); });
+    buffer.set_io_ranges({{0, 100}});
+    std::string data(50, '\0');
+    ASSERT_TRUE(buffer.read(10, Slice(data)).status().is_io_error());
+}
+
+} // namespace starrocks
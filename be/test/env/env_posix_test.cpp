@@ -23,6 +23,7 @@
 
 #include <algorithm>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "util/file_utils.h"
@@ -90,6 +91,8 @@ TEST_F(EnvPosixTest, random_access) {
         ASSERT_STREQ("123456789", std::string(slice1.data, slice1.size).c_str());
         ASSERT_STREQ("abc", std::string(slice3.data, slice3.size).c_str());
 
+        // read ahead doesn't change what's read after it
+        ASSERT_TRUE(rfile->readahead(100, 15).ok());
         Slice slice4(mem, 3);
         st = rfile->read_at(112, slice4);
         ASSERT_TRUE(st.ok());
@@ -132,6 +135,82 @@ TEST_F(EnvPosixTest, random_access) {
     }
 }
 
+TEST_F(EnvPosixTest, read_ranges_at) {
+    std::string fname = "./ut_dir/env_posix/read_ranges_at";
+    std::unique_ptr<WritableFile> wfile;
+    auto env = Env::Default();
+    ASSERT_TRUE(env->new_writable_file(fname, &wfile).ok());
+    std::string data;
+    for (int i = 0; i < 100000; ++i) {
+        data.push_back('a' + i % 26);
+    }
+    ASSERT_TRUE(wfile->append(data).ok());
+    ASSERT_TRUE(wfile->close().ok());
+
+    std::unique_ptr<RandomAccessFile> rfile;
+    ASSERT_TRUE(env->new_random_access_file(fname, &rfile).ok());
+
+    // More ranges than one io_uring holds, the results are the same with or without it.
+    for (bool enable_io_uring : {false, true}) {
+        config::enable_io_uring = enable_io_uring;
+        const size_t n = 150;
+        std::vector<uint64_t> offsets;
+        std::vector<std::string> buffers(n);
+        std::vector<Slice> results;
+        for (size_t i = 0; i < n; ++i) {
+            offsets.emplace_back(i * 613);
+            buffers[i].resize(1 + i % 100);
+            results.emplace_back(buffers[i].data(), buffers[i].size());
+        }
+        ASSERT_TRUE(rfile->read_ranges_at(offsets.data(), results.data(), n).ok());
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(data.substr(offsets[i], buffers[i].size()), buffers[i]);
+        }
+
+        // end of file
+        offsets[1] = data.size() - 1;
+        auto st = rfile->read_ranges_at(offsets.data(), results.data(), 2);
+        ASSERT_EQ(TStatusCode::END_OF_FILE, st.code());
+    }
+    config::enable_io_uring = false;
+}
+
+TEST_F(EnvPosixTest, direct_io_write) {
+    std::string fname = "./ut_dir/env_posix/direct_io_write";
+    auto env = Env::Default();
+    config::direct_io_write_buffer_size = 8192;
+    WritableFileOptions opts;
+    opts.direct_io = true;
+    std::unique_ptr<WritableFile> wfile;
+    ASSERT_TRUE(env->new_writable_file(opts, fname, &wfile).ok());
+
+    // The appends cross the buffer, and a sync writes the unaligned tail in the middle.
+    std::string data;
+    for (int i = 0; i < 300; ++i) {
+        std::string piece(1 + i * 7 % 500, 'a' + i % 26);
+        ASSERT_TRUE(wfile->append(piece).ok());
+        data.append(piece);
+        if (i == 100) {
+            ASSERT_TRUE(wfile->sync().ok());
+        }
+    }
+    Slice slices[2] = {"abc", "defgh"};
+    ASSERT_TRUE(wfile->appendv(slices, 2).ok());
+    data.append("abcdefgh");
+    ASSERT_EQ(data.size(), wfile->size());
+    ASSERT_TRUE(wfile->close().ok());
+
+    uint64_t size = 0;
+    ASSERT_TRUE(env->get_file_size(fname, &size).ok());
+    ASSERT_EQ(data.size(), size);
+    std::unique_ptr<RandomAccessFile> rfile;
+    ASSERT_TRUE(env->new_random_access_file(fname, &rfile).ok());
+    std::string result(data.size(), 0);
+    ASSERT_TRUE(rfile->read_at(0, Slice(result.data(), result.size())).ok());
+    ASSERT_EQ(data, result);
+    config::direct_io_write_buffer_size = 1048576;
+}
+
 TEST_F(EnvPosixTest, random_rw) {
     std::string fname = "./ut_dir/env_posix/random_rw";
     WritableFileOptions ops;
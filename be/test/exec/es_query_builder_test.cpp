@@ -28,6 +28,8 @@
 
 #include "common/logging.h"
 #include "exec/es/es_predicate.h"
+#include "exec/es/es_scan_reader.h"
+#include "exec/es/es_scroll_query.h"
 #include "rapidjson/document.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/stringbuffer.h"
@@ -628,4 +630,30 @@ TEST_F(BooleanQueryBuilderTest, validate_compound_and) {
             "{\"fv\":[\"8.0\",\"16.0\"]}}]}}]}}]}},{\"wildcard\":{\"content\":\"a*e*g?\"}}]}}]}}";
     ASSERT_STREQ(expected_json.c_str(), actual_bool_json.c_str());
 }
+
+TEST_F(BooleanQueryBuilderTest, sliced_scroll_query) {
+    std::map<std::string, std::string> properties;
+    properties[ESScanReader::KEY_BATCH_SIZE] = "4096";
+    properties[ESScanReader::KEY_SLICE_ID] = "1";
+    properties[ESScanReader::KEY_SLICE_MAX] = "4";
+    std::vector<std::string> fields = {"k1", "k2"};
+    std::vector<EsPredicate*> predicates;
+    std::map<std::string, std::string> docvalue_context;
+    bool doc_value_mode = true;
+    std::string query = ESScrollQueryBuilder::build(properties, fields, predicates, docvalue_context, &doc_value_mode);
+    ASSERT_FALSE(doc_value_mode);
+    rapidjson::Document document;
+    document.Parse(query.c_str());
+    ASSERT_TRUE(document.HasMember("slice"));
+    ASSERT_EQ(1, document["slice"]["id"].GetInt());
+    ASSERT_EQ(4, document["slice"]["max"].GetInt());
+    ASSERT_EQ(4096, document["size"].GetInt());
+
+    // a single search with the limit is not sliced
+    properties[ESScanReader::KEY_TERMINATE_AFTER] = "10";
+    query = ESScrollQueryBuilder::build(properties, fields, predicates, docvalue_context, &doc_value_mode);
+    document.Parse(query.c_str());
+    ASSERT_FALSE(document.HasMember("slice"));
+    ASSERT_EQ(10, document["size"].GetInt());
+}
 } // namespace starrocks
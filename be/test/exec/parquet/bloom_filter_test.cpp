@@ -0,0 +1,77 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/parquet/bloom_filter.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+#include "gen_cpp/parquet_types.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::parquet {
+
+static constexpr uint32_t kSalt[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+// Inserts the hash as the parquet writers do.
+static void insert_hash(std::vector<uint32_t>* bitset, uint64_t hash) {
+    uint64_t num_blocks = bitset->size() / 8;
+    uint64_t block_index = ((hash >> 32) * num_blocks) >> 32;
+    auto key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < 8; i++) {
+        (*bitset)[block_index * 8 + i] |= 1U << ((key * kSalt[i]) >> 27);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(SplitBlockBloomFilterTest, hash) {
+    // the reference values of XXH64 with seed 0
+    ASSERT_EQ(0xEF46DB3751D8E999ULL, SplitBlockBloomFilter::hash("", 0));
+    ASSERT_EQ(0xD24EC4F1A98C6E5BULL, SplitBlockBloomFilter::hash("a", 1));
+    ASSERT_EQ(0x44BC2CF5AD770999ULL, SplitBlockBloomFilter::hash("abc", 3));
+    std::string s = "Nobody inspects the spammish repetition";
+    ASSERT_EQ(0xFBCEA83C8A378BF1ULL, SplitBlockBloomFilter::hash(s.data(), s.size()));
+}
+
+// NOLINTNEXTLINE
+TEST(SplitBlockBloomFilterTest, read) {
+    std::vector<uint32_t> bitset(32 * 8);
+    for (int32_t v = 0; v < 100; v += 2) {
+        insert_hash(&bitset, SplitBlockBloomFilter::hash(&v, sizeof(v)));
+    }
+
+    tparquet::BloomFilterHeader header;
+    header.numBytes = bitset.size() * sizeof(uint32_t);
+    header.algorithm.__set_BLOCK(tparquet::SplitBlockAlgorithm());
+    header.hash.__set_XXHASH(tparquet::XxHash());
+    header.compression.__set_UNCOMPRESSED(tparquet::Uncompressed());
+    ThriftSerializer ser(true, 100);
+    uint32_t len = 0;
+    uint8_t* header_ser = nullptr;
+    ASSERT_TRUE(ser.serialize(&header, &len, &header_ser).ok());
+
+    // some other data before the bloom filter
+    std::string buffer(10, 'x');
+    buffer.append(reinterpret_cast<char*>(header_ser), len);
+    buffer.append(reinterpret_cast<char*>(bitset.data()), header.numBytes);
+    StringRandomAccessFile file(buffer);
+
+    std::unique_ptr<SplitBlockBloomFilter> filter;
+    ASSERT_TRUE(SplitBlockBloomFilter::read(&file, buffer.size(), 10, &filter).ok());
+    int num_false_positives = 0;
+    for (int32_t v = 0; v < 100; v++) {
+        bool found = filter->test_hash(SplitBlockBloomFilter::hash(&v, sizeof(v)));
+        if (v % 2 == 0) {
+            ASSERT_TRUE(found);
+        } else {
+            num_false_positives += found;
+        }
+    }
+    ASSERT_LT(num_false_positives, 10);
+
+    // the bitset is truncated
+    StringRandomAccessFile truncated(buffer.substr(0, buffer.size() - 32));
+    ASSERT_FALSE(SplitBlockBloomFilter::read(&truncated, buffer.size() - 32, 10, &filter).ok());
+}
+
+} // namespace starrocks::parquet
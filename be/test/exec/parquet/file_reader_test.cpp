@@ -38,6 +38,7 @@ private:
     HdfsFileReaderParam* _create_param_for_min_max();
     HdfsFileReaderParam* _create_param_for_filter_file();
     HdfsFileReaderParam* _create_param_for_dict_filter();
+    HdfsFileReaderParam* _create_param_for_lazy_dict_decode();
 
     static vectorized::ChunkPtr _create_chunk();
     static vectorized::ChunkPtr _create_chunk_for_partition();
@@ -479,6 +480,15 @@ HdfsFileReaderParam* FileReaderTest::_create_param_for_dict_filter() {
     return param;
 }
 
+HdfsFileReaderParam* FileReaderTest::_create_param_for_lazy_dict_decode() {
+    auto* param = _create_file2_base_param();
+    // create conjuncts
+    // c1 >= 1
+    param->conjunct_ctxs_by_slot[0] = std::vector<ExprContext*>();
+    _create_conjunct_ctxs_for_min_max(&param->conjunct_ctxs_by_slot[0]);
+    return param;
+}
+
 THdfsScanRange* FileReaderTest::_create_scan_range() {
     auto* scan_range = _pool.add(new THdfsScanRange());
 
@@ -677,4 +687,39 @@ TEST_F(FileReaderTest, TestGetNextDictFilter) {
     ASSERT_TRUE(status.is_end_of_file());
 }
 
+TEST_F(FileReaderTest, TestGetNextLazyDictDecode) {
+    // create file
+    auto file = _create_file(_file_2_path);
+
+    // create file reader
+    auto file_reader = std::make_shared<FileReader>(config::vector_chunk_size, file.get(), _file_2_size);
+
+    // init
+    auto* param = _create_param_for_lazy_dict_decode();
+    Status status = file_reader->init(*param);
+    ASSERT_TRUE(status.ok());
+
+    // c3 is read as dict codes but not a dict filter column
+    auto& group_reader = file_reader->_row_group_readers[0];
+    ASSERT_EQ(0, group_reader->_dict_filter_columns.size());
+    ASSERT_EQ(1, group_reader->_dict_code_columns.size());
+    ASSERT_EQ(2, group_reader->_dict_code_columns[0].slot_id);
+
+    // get next
+    auto chunk = _create_chunk();
+    status = file_reader->get_next(&chunk);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(9, chunk->num_rows());
+    const std::vector<std::string> expected{"b", "b", "c", "c", "c", "d", "d", "d", "d"};
+    auto c1 = chunk->get_column_by_slot_id(0);
+    auto c3 = chunk->get_column_by_slot_id(2);
+    for (int i = 0; i < chunk->num_rows(); ++i) {
+        ASSERT_EQ(i + 1, c1->get(i).get_int32());
+        ASSERT_EQ(expected[i], c3->get(i).get_slice().to_string());
+    }
+
+    status = file_reader->get_next(&chunk);
+    ASSERT_TRUE(status.is_end_of_file());
+}
+
 } // namespace starrocks::parquet
@@ -0,0 +1,123 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/parquet_builder.h"
+
+#include <gtest/gtest.h>
+#include <parquet/api/reader.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "common/object_pool.h"
+#include "env/env.h"
+#include "exprs/expr_context.h"
+#include "exprs/vectorized/column_ref.h"
+#include "runtime/date_value.h"
+#include "runtime/timestamp_value.h"
+#include "testutil/assert.h"
+#include "util/file_utils.h"
+
+namespace starrocks {
+
+class ParquetBuilderTest : public ::testing::Test {
+public:
+    void SetUp() override { ASSERT_OK(FileUtils::create_dir(_dir)); }
+    void TearDown() override { ASSERT_OK(FileUtils::remove_all(_dir)); }
+
+protected:
+    ExprContext* _add_column_ref(const TypeDescriptor& type, SlotId slot_id, bool nullable) {
+        auto* expr = _pool.add(new vectorized::ColumnRef(type, slot_id, nullable));
+        return _pool.add(new ExprContext(expr));
+    }
+
+    std::string _dir = "./ut_dir/parquet_builder_test";
+    ObjectPool _pool;
+};
+
+TEST_F(ParquetBuilderTest, write_chunks) {
+    std::vector<ExprContext*> output_expr_ctxs{
+            _add_column_ref(TypeDescriptor(TYPE_INT), 1, true),
+            _add_column_ref(TypeDescriptor::create_varchar_type(20), 2, false),
+            _add_column_ref(TypeDescriptor(TYPE_DATE), 3, false),
+            _add_column_ref(TypeDescriptor(TYPE_DATETIME), 4, false),
+            _add_column_ref(TypeDescriptor(TYPE_LARGEINT), 5, false),
+    };
+    std::string path = _dir + "/0.parquet";
+    std::unique_ptr<WritableFile> file;
+    ASSERT_OK(Env::Default()->new_writable_file(path, &file));
+    ParquetBuilder builder(std::move(file), output_expr_ctxs);
+
+    for (int k = 0; k < 2; ++k) {
+        vectorized::Chunk chunk;
+        auto ints = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+        auto strings = vectorized::ColumnHelper::create_column(TypeDescriptor::create_varchar_type(20), false);
+        auto dates = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_DATE), false);
+        auto datetimes = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_DATETIME), false);
+        auto largeints = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_LARGEINT), false);
+        for (int i = 0; i < 3; ++i) {
+            if (i == 1) {
+                ints->append_nulls(1);
+            } else {
+                ints->append_datum(vectorized::Datum(int32_t(k * 3 + i)));
+            }
+            std::string s = "s" + std::to_string(k * 3 + i);
+            strings->append_datum(vectorized::Datum(Slice(s)));
+            dates->append_datum(vectorized::Datum(DateValue::create(1970, 1, 2 + i)));
+            datetimes->append_datum(vectorized::Datum(TimestampValue::create(1970, 1, 1, 0, 0, i)));
+            largeints->append_datum(vectorized::Datum(int128_t(i)));
+        }
+        chunk.append_column(ints, 1);
+        chunk.append_column(strings, 2);
+        chunk.append_column(dates, 3);
+        chunk.append_column(datetimes, 4);
+        chunk.append_column(largeints, 5);
+        ASSERT_OK(builder.add_chunk(&chunk));
+    }
+    ASSERT_OK(builder.finish());
+    ASSERT_GT(builder.file_size(), 0);
+
+    auto reader = parquet::ParquetFileReader::OpenFile(path);
+    auto metadata = reader->metadata();
+    ASSERT_EQ(6, metadata->num_rows());
+    ASSERT_EQ(5, metadata->num_columns());
+    ASSERT_EQ("col0", metadata->schema()->Column(0)->name());
+    ASSERT_EQ(parquet::Type::BYTE_ARRAY, metadata->schema()->Column(4)->physical_type());
+
+    auto row_group = reader->RowGroup(0);
+    ASSERT_TRUE(row_group->metadata()->ColumnChunk(0)->is_stats_set());
+
+    int16_t def_levels[6];
+    int32_t ints[6];
+    int64_t values_read = 0;
+    auto* int_reader = static_cast<parquet::Int32Reader*>(row_group->Column(0).get());
+    ASSERT_EQ(6, int_reader->ReadBatch(6, def_levels, nullptr, ints, &values_read));
+    ASSERT_EQ(4, values_read);
+    ASSERT_EQ(0, def_levels[1]);
+    ASSERT_EQ(2, ints[1]);
+    ASSERT_EQ(5, ints[3]);
+
+    parquet::ByteArray strings[6];
+    auto string_column = row_group->Column(1);
+    auto* string_reader = static_cast<parquet::ByteArrayReader*>(string_column.get());
+    ASSERT_EQ(6, string_reader->ReadBatch(6, nullptr, nullptr, strings, &values_read));
+    ASSERT_EQ("s4", std::string(reinterpret_cast<const char*>(strings[4].ptr), strings[4].len));
+
+    int32_t dates[6];
+    auto date_column = row_group->Column(2);
+    auto* date_reader = static_cast<parquet::Int32Reader*>(date_column.get());
+    ASSERT_EQ(6, date_reader->ReadBatch(6, nullptr, nullptr, dates, &values_read));
+    ASSERT_EQ(3, dates[2]);
+
+    int64_t datetimes[6];
+    auto datetime_column = row_group->Column(3);
+    auto* datetime_reader = static_cast<parquet::Int64Reader*>(datetime_column.get());
+    ASSERT_EQ(6, datetime_reader->ReadBatch(6, nullptr, nullptr, datetimes, &values_read));
+    ASSERT_EQ(2000000, datetimes[2]);
+
+    parquet::ByteArray largeints[6];
+    auto largeint_column = row_group->Column(4);
+    auto* largeint_reader = static_cast<parquet::ByteArrayReader*>(largeint_column.get());
+    ASSERT_EQ(6, largeint_reader->ReadBatch(6, nullptr, nullptr, largeints, &values_read));
+    ASSERT_EQ("2", std::string(reinterpret_cast<const char*>(largeints[5].ptr), largeints[5].len));
+}
+
+} // namespace starrocks
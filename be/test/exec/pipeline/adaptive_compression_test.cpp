@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/exchange/adaptive_compression.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace starrocks::pipeline {
+
+class AdaptiveCompressionTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(_compression.init().ok());
+        ASSERT_TRUE(_compression.codec(kNone) == nullptr);
+        ASSERT_TRUE(_compression.codec(kLz4) != nullptr);
+        ASSERT_TRUE(_compression.codec(kZstd) != nullptr);
+        // LZ4 compresses 1GB/s into 1/2, ZSTD compresses 200MB/s into 1/4.
+        for (int i = 0; i < 4; ++i) {
+            _compression.update(kLz4, 1000, 500, 1000);
+            _compression.update(kZstd, 1000, 250, 5000);
+        }
+    }
+
+    size_t choose_most(double bytes_per_second) {
+        std::vector<size_t> counts(AdaptiveCompression::kNumCodecs, 0);
+        for (size_t i = 0; i < AdaptiveCompression::kExplorePeriod * 4; ++i) {
+            counts[_compression.choose(bytes_per_second)]++;
+        }
+        return std::max_element(counts.begin(), counts.end()) - counts.begin();
+    }
+
+    static constexpr size_t kNone = 0;
+    static constexpr size_t kLz4 = 1;
+    static constexpr size_t kZstd = 2;
+
+    AdaptiveCompression _compression{CompressionTypePB::LZ4};
+};
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveCompressionTest, unknown_bandwidth) {
+    ASSERT_EQ(kLz4, _compression.choose(0));
+    AdaptiveCompression compression(CompressionTypePB::NO_COMPRESSION);
+    ASSERT_TRUE(compression.init().ok());
+    ASSERT_EQ(kNone, compression.choose(0));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveCompressionTest, sample_before_choose) {
+    AdaptiveCompression compression(CompressionTypePB::LZ4);
+    ASSERT_TRUE(compression.init().ok());
+    ASSERT_EQ(kLz4, compression.choose(1e9));
+    compression.update(kLz4, 1000, 500, 1000);
+    ASSERT_EQ(kZstd, compression.choose(1e9));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveCompressionTest, choose_by_bandwidth) {
+    // 10GB/s: transmitting is cheaper than compressing.
+    ASSERT_EQ(kNone, choose_most(10e9));
+    // 250MB/s: LZ4 costs 1 + 0.5 * 4, ZSTD costs 5 + 0.25 * 4, no compression costs 4 ns per byte.
+    ASSERT_EQ(kLz4, choose_most(0.25e9));
+    // 50MB/s: ZSTD costs 5 + 0.25 * 20, LZ4 costs 1 + 0.5 * 20.
+    ASSERT_EQ(kZstd, choose_most(0.05e9));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveCompressionTest, follow_samples) {
+    ASSERT_EQ(kZstd, choose_most(0.05e9));
+    // The data becomes incompressible.
+    for (int i = 0; i < 32; ++i) {
+        _compression.update(kLz4, 1000, 1000, 1000);
+        _compression.update(kZstd, 1000, 1000, 5000);
+    }
+    ASSERT_EQ(kNone, choose_most(0.05e9));
+}
+
+} // namespace starrocks::pipeline
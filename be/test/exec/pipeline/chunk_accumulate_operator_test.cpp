@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/chunk_accumulate_operator.h"
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "gtest/gtest.h"
+
+namespace starrocks::pipeline {
+
+class ChunkAccumulatorTest : public testing::Test {
+protected:
+    static vectorized::ChunkPtr make_chunk(int32_t begin, int32_t end) {
+        auto column = vectorized::Int32Column::create();
+        for (int32_t i = begin; i < end; i++) {
+            column->append(i);
+        }
+        vectorized::Chunk::SlotHashMap slot_map;
+        slot_map[1] = 0;
+        return std::make_shared<vectorized::Chunk>(vectorized::Columns{column}, slot_map);
+    }
+
+    static int32_t value_at(const vectorized::ChunkPtr& chunk, size_t row) {
+        return chunk->get_column_by_slot_id(1)->get(row).get_int32();
+    }
+};
+
+TEST_F(ChunkAccumulatorTest, test_merge_small_chunks) {
+    ChunkAccumulator acc(10);
+    acc.push(make_chunk(0, 2));
+    acc.push(make_chunk(2, 2));
+    acc.push(make_chunk(2, 4));
+    ASSERT_FALSE(acc.has_output());
+    acc.push(make_chunk(4, 7));
+    ASSERT_TRUE(acc.has_output());
+
+    auto chunk = acc.pull();
+    ASSERT_EQ(7, chunk->num_rows());
+    for (size_t i = 0; i < 7; i++) {
+        ASSERT_EQ(static_cast<int32_t>(i), value_at(chunk, i));
+    }
+    ASSERT_EQ(2, acc.num_merged_chunks());
+    ASSERT_TRUE(acc.empty());
+}
+
+TEST_F(ChunkAccumulatorTest, test_pass_through_large_chunks) {
+    ChunkAccumulator acc(10);
+    acc.push(make_chunk(0, 2));
+    auto large = make_chunk(2, 8);
+    acc.push(large);
+
+    // the pending rows go before the large chunk, which isn't copied
+    auto chunk = acc.pull();
+    ASSERT_EQ(2, chunk->num_rows());
+    ASSERT_EQ(0, value_at(chunk, 0));
+    chunk = acc.pull();
+    ASSERT_EQ(large.get(), chunk.get());
+    ASSERT_EQ(nullptr, acc.pull());
+    ASSERT_TRUE(acc.empty());
+}
+
+TEST_F(ChunkAccumulatorTest, test_finalize) {
+    ChunkAccumulator acc(10);
+    acc.push(make_chunk(0, 3));
+    ASSERT_FALSE(acc.has_output());
+    ASSERT_FALSE(acc.empty());
+    acc.finalize();
+    auto chunk = acc.pull();
+    ASSERT_EQ(3, chunk->num_rows());
+    ASSERT_TRUE(acc.empty());
+
+    acc.finalize();
+    ASSERT_FALSE(acc.has_output());
+}
+
+} // namespace starrocks::pipeline
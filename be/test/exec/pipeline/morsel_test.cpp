@@ -0,0 +1,43 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/morsel.h"
+
+#include "gtest/gtest.h"
+
+namespace starrocks::pipeline {
+
+static Morsels make_morsels(const std::vector<int32_t>& buckets) {
+    Morsels morsels;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        TScanRangeParams scan_range;
+        scan_range.scan_range.internal_scan_range.tablet_id = i;
+        if (buckets[i] >= 0) {
+            scan_range.__set_bucket_sequence(buckets[i]);
+        }
+        morsels.emplace_back(std::make_unique<OlapMorsel>(1, scan_range));
+    }
+    return morsels;
+}
+
+TEST(MorselQueueTest, test_split_by_bucket) {
+    ASSERT_FALSE(MorselQueue(make_morsels({})).is_bucket_aware());
+    ASSERT_FALSE(MorselQueue(make_morsels({3, -1})).is_bucket_aware());
+
+    // the buckets 3, 5, 8 and 11 of the instance are ranked 0, 1, 2 and 3
+    std::unordered_map<int32_t, size_t> bucket_ranks{{3, 0}, {5, 1}, {8, 2}, {11, 3}};
+    MorselQueue queue(make_morsels({8, 3, 11, 3, 5}));
+    ASSERT_TRUE(queue.is_bucket_aware());
+    auto queues = queue.split_by_bucket(3, bucket_ranks);
+    ASSERT_EQ(3, queues.size());
+
+    std::vector<int32_t> expected_buckets[] = {{3, 11, 3}, {5}, {8}};
+    for (size_t i = 0; i < queues.size(); i++) {
+        std::vector<int32_t> buckets;
+        while (auto morsel = queues[i]->try_get()) {
+            buckets.push_back(morsel.value()->bucket_sequence());
+        }
+        ASSERT_EQ(expected_buckets[i], buckets);
+    }
+}
+
+} // namespace starrocks::pipeline
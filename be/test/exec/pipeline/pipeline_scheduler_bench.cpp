@@ -0,0 +1,404 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Stress benchmark of scheduling the pipeline drivers of many concurrent short queries. The worker threads run mock
+// drivers as GlobalDriverDispatcher does: a driver burns the CPU for a quantum, and then it's put back to the ready
+// queue, blocked for a while as by PipelineDriverPoller, or waits for an IO task of the IO threads. It reports the
+// throughput of the queries, the percentiles of the scheduling delay, the context switches of the process and, with
+// the work groups, how fairly the CPU time is shared among them by their weights.
+// Usage: pipeline_scheduler_bench [--benchmark_filter=...]
+// The first argument is the number of the concurrent queries, the second one the index of kProfiles.
+
+#include <benchmark/benchmark.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <random>
+#include <thread>
+
+#include "exec/pipeline/pipeline_driver_queue.h"
+#include "exec/pipeline/source_operator.h"
+#include "exec/workgroup/work_group.h"
+#include "util/time.h"
+
+namespace starrocks::pipeline {
+
+static constexpr size_t kDriversPerQuery = 4;
+static constexpr size_t kQuantaPerDriver = 4;
+static constexpr size_t kNumIoThreads = 4;
+// A worker finding no work group with ready drivers waits this long before picking again.
+static constexpr int64_t kIdleWaitUs = 10;
+
+// The cost of a quantum of a driver, and the chances the driver is blocked or waits for an IO task after it.
+struct WorkloadProfile {
+    int64_t cpu_ns;
+    int32_t block_percent;
+    int64_t block_ns;
+    int32_t io_percent;
+    int64_t io_ns;
+};
+
+static const WorkloadProfile kProfiles[] = {
+        // CPU bound
+        {50'000, 0, 0, 0, 0},
+        // waits for the exchanges
+        {50'000, 30, 200'000, 0, 0},
+        // scans
+        {50'000, 10, 200'000, 30, 1'000'000},
+};
+
+// Only makes PipelineDriver constructible, the operators are never called.
+class MockSourceOperator final : public SourceOperator {
+public:
+    MockSourceOperator() : SourceOperator(nullptr, 1, "mock_source", 1) {}
+    ~MockSourceOperator() override = default;
+
+    bool has_output() const override { return false; }
+    bool is_finished() const override { return false; }
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override { return nullptr; }
+};
+
+class SchedulerBench {
+public:
+    // Without work groups, all the drivers are scheduled by |queue|. Otherwise the queries are spread over
+    // |num_workgroups| groups of the weights 1, 2, 4..., and a worker picks a work group by CpuWorkGroupQueue first,
+    // then takes a driver from the queue of the group.
+    SchedulerBench(DriverQueuePtr queue, size_t num_workgroups, size_t concurrency, const WorkloadProfile& profile)
+            : _queue(std::move(queue)), _has_workgroups(num_workgroups > 0), _profile(profile) {
+        const size_t num_groups = std::max<size_t>(num_workgroups, 1);
+        _num_queries = std::max<size_t>(concurrency * 4, 1000) / num_groups * num_groups;
+        for (size_t g = 0; g < num_groups; g++) {
+            auto group = std::make_unique<Group>();
+            if (_has_workgroups) {
+                group->wg = std::make_shared<workgroup::WorkGroup>("wg_" + std::to_string(g), g, 1 << g, -1,
+                                                                   concurrency, workgroup::WG_NORMAL);
+                group->wg->init();
+                _cpu_queue.add(group->wg);
+                group->queue = group->wg->driver_queue();
+            } else {
+                group->queue = _queue.get();
+            }
+            group->concurrency = std::max<size_t>(concurrency / num_groups, 1);
+            _groups.emplace_back(std::move(group));
+        }
+
+        _queries = std::make_unique<MockQuery[]>(_num_queries);
+        for (size_t q = 0; q < _num_queries; q++) {
+            _queries[q].group = q % num_groups;
+            _groups[_queries[q].group]->queries.push_back(q);
+            for (size_t d = 0; d < kDriversPerQuery; d++) {
+                Operators operators{std::make_shared<MockSourceOperator>()};
+                auto driver = std::make_shared<PipelineDriver>(operators, nullptr, nullptr,
+                                                               static_cast<int32_t>(_drivers.size()), false);
+                _drivers.push_back({std::move(driver), q, kQuantaPerDriver});
+            }
+        }
+    }
+
+    void run() {
+        struct rusage usage_begin;
+        getrusage(RUSAGE_SELF, &usage_begin);
+        int64_t begin = MonotonicNanos();
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < std::max<size_t>(std::thread::hardware_concurrency(), 1); i++) {
+            threads.emplace_back([this, i] { _work(i); });
+        }
+        for (size_t i = 0; i < kNumIoThreads; i++) {
+            threads.emplace_back([this] { _do_io(); });
+        }
+        threads.emplace_back([this] { _poll_blocked(); });
+        for (auto& group : _groups) {
+            for (size_t i = 0; i < group->concurrency; i++) {
+                _launch_next_query(group.get());
+            }
+        }
+
+        {
+            std::unique_lock<std::mutex> l(_mutex);
+            _done_cv.wait(l, [this] { return _num_finished_queries.load() == _num_queries; });
+            _stopped.store(true);
+            _blocked_cv.notify_all();
+            _io_cv.notify_all();
+        }
+        for (auto& group : _groups) {
+            group->queue->close();
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        _elapsed_ns = MonotonicNanos() - begin;
+        struct rusage usage_end;
+        getrusage(RUSAGE_SELF, &usage_end);
+        _voluntary_context_switches = usage_end.ru_nvcsw - usage_begin.ru_nvcsw;
+        _involuntary_context_switches = usage_end.ru_nivcsw - usage_begin.ru_nivcsw;
+    }
+
+    void report(benchmark::State& state) {
+        state.counters["queries_per_second"] = _num_queries * 1e9 / _elapsed_ns;
+        std::sort(_schedule_delays.begin(), _schedule_delays.end());
+        auto percentile_us = [this](double q) {
+            if (_schedule_delays.empty()) {
+                return 0.0;
+            }
+            return _schedule_delays[std::min(_schedule_delays.size() - 1, size_t(q * _schedule_delays.size()))] /
+                   1000.0;
+        };
+        state.counters["schedule_delay_p50_us"] = percentile_us(0.5);
+        state.counters["schedule_delay_p99_us"] = percentile_us(0.99);
+        state.counters["schedule_delay_p999_us"] = percentile_us(0.999);
+        state.counters["voluntary_context_switches"] = _voluntary_context_switches;
+        state.counters["involuntary_context_switches"] = _involuntary_context_switches;
+
+        if (_has_workgroups) {
+            // The CPU time by weight of each group while all of them had queries to run, 1 is perfectly fair.
+            double sum = 0;
+            double sum_of_squares = 0;
+            int64_t total_cpu_ns = 0;
+            for (int64_t cpu_ns : _contended_cpu_ns) {
+                total_cpu_ns += cpu_ns;
+            }
+            for (size_t g = 0; g < _groups.size(); g++) {
+                double normalized = static_cast<double>(_contended_cpu_ns[g]) / _groups[g]->wg->weight();
+                sum += normalized;
+                sum_of_squares += normalized * normalized;
+                state.counters["wg_" + std::to_string(g) + "_cpu_share"] =
+                        total_cpu_ns > 0 ? static_cast<double>(_contended_cpu_ns[g]) / total_cpu_ns : 0;
+            }
+            state.counters["fairness_index"] = sum_of_squares > 0 ? sum * sum / (_groups.size() * sum_of_squares) : 0;
+        }
+    }
+
+private:
+    struct Group {
+        workgroup::WorkGroupPtr wg;
+        DriverQueue* queue = nullptr;
+        size_t concurrency = 0;
+        std::vector<size_t> queries;
+        std::atomic<size_t> next_query{0};
+        std::atomic<size_t> num_finished_queries{0};
+    };
+
+    struct MockQuery {
+        size_t group = 0;
+        std::atomic<size_t> num_unfinished_drivers{kDriversPerQuery};
+    };
+
+    struct MockDriver {
+        DriverPtr driver;
+        size_t query;
+        // only touched by the thread running the driver
+        size_t remaining_quanta;
+    };
+
+    Group* _group_of(DriverRawPtr driver) {
+        return _groups[_queries[_drivers[driver->driver_id()].query].group].get();
+    }
+
+    void _launch_next_query(Group* group) {
+        size_t index = group->next_query.fetch_add(1);
+        if (index >= group->queries.size()) {
+            return;
+        }
+        size_t query = group->queries[index];
+        std::vector<DriverRawPtr> drivers;
+        for (size_t d = 0; d < kDriversPerQuery; d++) {
+            drivers.push_back(_drivers[query * kDriversPerQuery + d].driver.get());
+        }
+        group->queue->put_back(drivers);
+    }
+
+    void _finish_driver(const MockDriver& driver) {
+        auto& query = _queries[driver.query];
+        if (query.num_unfinished_drivers.fetch_sub(1) != 1) {
+            return;
+        }
+        auto* group = _groups[query.group].get();
+        if (group->num_finished_queries.fetch_add(1) + 1 == group->queries.size() && _has_workgroups &&
+            !_contention_ended.exchange(true)) {
+            // the first group to finish ends the contention of the groups
+            for (auto& g : _groups) {
+                _contended_cpu_ns.push_back(g->wg->cpu_runtime_ns());
+            }
+        }
+        _launch_next_query(group);
+        if (_num_finished_queries.fetch_add(1) + 1 == _num_queries) {
+            std::lock_guard<std::mutex> l(_mutex);
+            _done_cv.notify_all();
+        }
+    }
+
+    // The time the thread is descheduled is burnt too, as a driver is charged in the dispatcher.
+    static void _burn_cpu(int64_t ns) {
+        int64_t deadline = MonotonicNanos() + ns;
+        while (MonotonicNanos() < deadline) {
+        }
+    }
+
+    void _work(size_t worker_index) {
+        std::mt19937 rng(worker_index);
+        std::vector<int64_t> schedule_delays;
+        while (!_stopped.load()) {
+            Group* group = _groups[0].get();
+            if (_has_workgroups) {
+                auto wg = _cpu_queue.pick_next();
+                if (wg == nullptr) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(kIdleWaitUs));
+                    continue;
+                }
+                group = _groups[wg->id()].get();
+            }
+            // the queue may be emptied by the other workers after the group is picked, then take() waits for the
+            // next driver of the group as the workers of the dispatcher do
+            size_t queue_index;
+            auto maybe_driver = group->queue->take(&queue_index);
+            if (!maybe_driver.ok()) {
+                break;
+            }
+            auto* driver = maybe_driver.value();
+            int64_t start = MonotonicNanos();
+            schedule_delays.push_back(start - driver->driver_acct().get_last_ready_time());
+
+            _burn_cpu(_profile.cpu_ns);
+            int64_t time_spent = MonotonicNanos() - start;
+            driver->driver_acct().increment_schedule_times();
+            driver->driver_acct().update_last_time_spent(time_spent);
+            group->queue->get_sub_queue(queue_index)->update_accu_time(driver);
+            if (group->wg != nullptr) {
+                group->wg->incr_cpu_runtime_ns(time_spent);
+            }
+
+            auto& mock_driver = _drivers[driver->driver_id()];
+            if (--mock_driver.remaining_quanta == 0) {
+                _finish_driver(mock_driver);
+                continue;
+            }
+            auto chance = static_cast<int32_t>(rng() % 100);
+            if (chance < _profile.block_percent) {
+                std::lock_guard<std::mutex> l(_mutex);
+                _blocked_drivers.emplace(start + time_spent + _profile.block_ns, driver);
+                _blocked_cv.notify_one();
+            } else if (chance < _profile.block_percent + _profile.io_percent) {
+                std::lock_guard<std::mutex> l(_mutex);
+                _io_tasks.push_back(driver);
+                _io_cv.notify_one();
+            } else {
+                group->queue->put_back(driver);
+            }
+        }
+
+        std::lock_guard<std::mutex> l(_mutex);
+        _schedule_delays.insert(_schedule_delays.end(), schedule_delays.begin(), schedule_delays.end());
+    }
+
+    // Puts back the blocked drivers once their blocking time is over, as PipelineDriverPoller does.
+    void _poll_blocked() {
+        std::unique_lock<std::mutex> l(_mutex);
+        while (!_stopped.load()) {
+            if (_blocked_drivers.empty()) {
+                _blocked_cv.wait(l);
+                continue;
+            }
+            int64_t now = MonotonicNanos();
+            std::vector<DriverRawPtr> ready_drivers;
+            while (!_blocked_drivers.empty() && _blocked_drivers.top().first <= now) {
+                ready_drivers.push_back(_blocked_drivers.top().second);
+                _blocked_drivers.pop();
+            }
+            if (ready_drivers.empty()) {
+                _blocked_cv.wait_for(l, std::chrono::nanoseconds(_blocked_drivers.top().first - now));
+                continue;
+            }
+            l.unlock();
+            for (auto* driver : ready_drivers) {
+                _group_of(driver)->queue->put_back(driver);
+            }
+            l.lock();
+        }
+    }
+
+    void _do_io() {
+        std::unique_lock<std::mutex> l(_mutex);
+        while (!_stopped.load()) {
+            if (_io_tasks.empty()) {
+                _io_cv.wait(l);
+                continue;
+            }
+            auto* driver = _io_tasks.front();
+            _io_tasks.pop_front();
+            l.unlock();
+            std::this_thread::sleep_for(std::chrono::nanoseconds(_profile.io_ns));
+            _group_of(driver)->queue->put_back(driver);
+            l.lock();
+        }
+    }
+
+    DriverQueuePtr _queue;
+    const bool _has_workgroups;
+    const WorkloadProfile _profile;
+    workgroup::CpuWorkGroupQueue _cpu_queue;
+    std::vector<std::unique_ptr<Group>> _groups;
+
+    size_t _num_queries = 0;
+    std::unique_ptr<MockQuery[]> _queries;
+    std::vector<MockDriver> _drivers;
+
+    std::mutex _mutex;
+    std::condition_variable _done_cv;
+    std::atomic<size_t> _num_finished_queries{0};
+    std::atomic<bool> _stopped{false};
+    // the blocked drivers by the time to be ready
+    using BlockedDriver = std::pair<int64_t, DriverRawPtr>;
+    std::priority_queue<BlockedDriver, std::vector<BlockedDriver>, std::greater<>> _blocked_drivers;
+    std::condition_variable _blocked_cv;
+    std::deque<DriverRawPtr> _io_tasks;
+    std::condition_variable _io_cv;
+
+    std::atomic<bool> _contention_ended{false};
+    std::vector<int64_t> _contended_cpu_ns;
+
+    int64_t _elapsed_ns = 0;
+    std::vector<int64_t> _schedule_delays;
+    int64_t _voluntary_context_switches = 0;
+    int64_t _involuntary_context_switches = 0;
+};
+
+static void run_scheduler_bench(benchmark::State& state, const std::function<DriverQueuePtr()>& create_queue,
+                                size_t num_workgroups) {
+    for (auto _ : state) {
+        SchedulerBench bench(create_queue(), num_workgroups, state.range(0), kProfiles[state.range(1)]);
+        bench.run();
+        bench.report(state);
+    }
+}
+
+static void BM_query_shared_queue(benchmark::State& state) {
+    run_scheduler_bench(state, [] { return std::make_unique<QuerySharedDriverQueue>(); }, 0);
+}
+
+static void BM_work_stealing_queue(benchmark::State& state) {
+    auto create_queue = [] { return std::make_unique<WorkStealingDriverQueue>(std::thread::hardware_concurrency()); };
+    run_scheduler_bench(state, create_queue, 0);
+}
+
+// Three work groups of the weights 1, 2 and 4, each with a third of the concurrent queries.
+static void BM_work_group_queue(benchmark::State& state) {
+    run_scheduler_bench(state, [] { return DriverQueuePtr(); }, 3);
+}
+
+// The scalability of the CPU bound queries, and 1000 queries of each profile.
+static void scheduler_args(benchmark::internal::Benchmark* bench) {
+    bench->Args({1, 0})->Args({100, 0})->Args({1000, 0})->Args({1000, 1})->Args({1000, 2});
+}
+
+BENCHMARK(BM_query_shared_queue)->Apply(scheduler_args)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_work_stealing_queue)->Apply(scheduler_args)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_work_group_queue)->Apply(scheduler_args)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks::pipeline
+
+BENCHMARK_MAIN();
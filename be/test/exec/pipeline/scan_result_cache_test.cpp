@@ -0,0 +1,62 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/scan_result_cache.h"
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "gtest/gtest.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::pipeline {
+
+class ScanResultCacheTest : public testing::Test {
+protected:
+    static vectorized::ChunkPtr make_chunk(int32_t begin, int32_t end) {
+        auto column = vectorized::Int32Column::create();
+        for (int32_t i = begin; i < end; i++) {
+            column->append(i);
+        }
+        vectorized::Chunk::SlotHashMap slot_map;
+        slot_map[1] = 0;
+        return std::make_shared<vectorized::Chunk>(vectorized::Columns{column}, slot_map);
+    }
+
+    MemTracker _tracker;
+};
+
+TEST_F(ScanResultCacheTest, test_insert_lookup) {
+    ScanResultCache cache(&_tracker, 1024 * 1024);
+    ScanResultCache::Result result;
+    ASSERT_FALSE(cache.lookup("key", &result));
+
+    result.version = 5;
+    result.chunks.emplace_back(make_chunk(0, 10));
+    result.chunks.emplace_back(make_chunk(10, 15));
+    cache.insert("key", result);
+    ASSERT_GT(cache.memory_usage(), 0);
+
+    // the cached chunks are copies, which aren't affected by the chunks inserted nor the ones looked up
+    result.chunks[0]->reset();
+    ScanResultCache::Result cached;
+    ASSERT_TRUE(cache.lookup("key", &cached));
+    ASSERT_EQ(5, cached.version);
+    ASSERT_EQ(2, cached.chunks.size());
+    ASSERT_EQ(10, cached.chunks[0]->num_rows());
+    ASSERT_EQ(5, cached.chunks[1]->num_rows());
+    ASSERT_TRUE(cached.chunks[1]->is_slot_exist(1));
+    ASSERT_EQ(14, cached.chunks[1]->get_column_by_slot_id(1)->get(4).get_int32());
+    cached.chunks[0]->reset();
+    ASSERT_TRUE(cache.lookup("key", &cached));
+    ASSERT_EQ(10, cached.chunks[0]->num_rows());
+
+    // replaced by the result of a newer version
+    result.version = 6;
+    result.chunks = {make_chunk(0, 20)};
+    cache.insert("key", result);
+    ASSERT_TRUE(cache.lookup("key", &cached));
+    ASSERT_EQ(6, cached.version);
+    ASSERT_EQ(1, cached.chunks.size());
+    ASSERT_EQ(20, cached.chunks[0]->num_rows());
+}
+
+} // namespace starrocks::pipeline
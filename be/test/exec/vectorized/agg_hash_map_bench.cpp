@@ -0,0 +1,129 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of computing the aggregate states of the group by keys in each variant of the AggHashMap.
+// Usage: agg_hash_map_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "runtime/mem_pool.h"
+
+namespace starrocks::vectorized {
+
+static constexpr uint32_t kChunkSize = 4096;
+static constexpr uint32_t kNumChunks = 64;
+
+static std::vector<Columns> make_int_chunks(int64_t num_groups, bool is_int64, size_t num_columns) {
+    std::mt19937_64 rng(num_groups);
+    std::vector<Columns> chunks(kNumChunks);
+    for (auto& columns : chunks) {
+        for (size_t c = 0; c < num_columns; c++) {
+            ColumnPtr column;
+            if (is_int64) {
+                auto int64_column = Int64Column::create();
+                for (uint32_t i = 0; i < kChunkSize; i++) {
+                    int64_column->append(static_cast<int64_t>(rng() % num_groups) << 20);
+                }
+                column = std::move(int64_column);
+            } else {
+                auto int32_column = Int32Column::create();
+                for (uint32_t i = 0; i < kChunkSize; i++) {
+                    int32_column->append(static_cast<int32_t>(rng() % num_groups));
+                }
+                column = std::move(int32_column);
+            }
+            columns.emplace_back(std::move(column));
+        }
+    }
+    return chunks;
+}
+
+static std::vector<Columns> make_string_chunks(int64_t num_groups) {
+    std::mt19937_64 rng(num_groups);
+    std::vector<Columns> chunks(kNumChunks);
+    for (auto& columns : chunks) {
+        auto column = BinaryColumn::create();
+        for (uint32_t i = 0; i < kChunkSize; i++) {
+            column->append("group_key_" + std::to_string(rng() % num_groups));
+        }
+        columns.emplace_back(std::move(column));
+    }
+    return chunks;
+}
+
+template <typename HashMapWithKey, typename InitFunc>
+static void run_agg_hash_map(benchmark::State& state, const std::vector<Columns>& chunks, InitFunc&& init) {
+    HashMapWithKey hash_map_with_key(kChunkSize);
+    init(hash_map_with_key);
+    MemPool pool;
+    // The states are not updated, all the groups share one.
+    int64_t shared_state = 0;
+    Buffer<AggDataPtr> agg_states(kChunkSize);
+    auto allocate = [&]() { return reinterpret_cast<AggDataPtr>(&shared_state); };
+    size_t next_chunk = 0;
+    for (auto _ : state) {
+        hash_map_with_key.compute_agg_states(kChunkSize, chunks[next_chunk++ % kNumChunks], &pool, allocate,
+                                             &agg_states);
+        benchmark::DoNotOptimize(agg_states.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kChunkSize);
+    state.counters["groups"] = hash_map_with_key.hash_map.size();
+}
+
+template <typename HashMapWithKey>
+static void run_agg_hash_map(benchmark::State& state, const std::vector<Columns>& chunks) {
+    run_agg_hash_map<HashMapWithKey>(state, chunks, [](HashMapWithKey&) {});
+}
+
+static void BM_agg_int32(benchmark::State& state) {
+    auto chunks = make_int_chunks(state.range(0), false, 1);
+    run_agg_hash_map<Int32AggHashMapWithOneNumberKey<PhmapSeed1>>(state, chunks);
+}
+
+static void BM_agg_int32_two_level(benchmark::State& state) {
+    auto chunks = make_int_chunks(state.range(0), false, 1);
+    run_agg_hash_map<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>>(state, chunks);
+}
+
+static void BM_agg_int64(benchmark::State& state) {
+    auto chunks = make_int_chunks(state.range(0), true, 1);
+    run_agg_hash_map<Int64AggHashMapWithOneNumberKey<PhmapSeed1>>(state, chunks);
+}
+
+static void BM_agg_one_string(benchmark::State& state) {
+    auto chunks = make_string_chunks(state.range(0));
+    run_agg_hash_map<OneStringAggHashMap<PhmapSeed1>>(state, chunks);
+}
+
+// Two int32 keys, serialized into one slice.
+static void BM_agg_serialized(benchmark::State& state) {
+    auto chunks = make_int_chunks(state.range(0), false, 2);
+    run_agg_hash_map<SerializedKeyAggHashMap<PhmapSeed1>>(state, chunks);
+}
+
+static void BM_agg_serialized_fixed_size(benchmark::State& state) {
+    auto chunks = make_int_chunks(state.range(0), false, 2);
+    using HashMapWithKey = SerializedKeyFixedSize8AggHashMap<PhmapSeed1>;
+    // the keys are serialized into 8 bytes, as the Aggregator decides for the two not null int32 columns
+    run_agg_hash_map<HashMapWithKey>(state, chunks, [](HashMapWithKey& map) { map.fixed_byte_size = 8; });
+}
+
+// The number of groups from in L1 to far beyond L3.
+#define AGG_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(1 << 8)->Arg(1 << 16)->Arg(1 << 22)
+
+AGG_BENCHMARK(BM_agg_int32);
+AGG_BENCHMARK(BM_agg_int32_two_level);
+AGG_BENCHMARK(BM_agg_int64);
+AGG_BENCHMARK(BM_agg_one_string);
+AGG_BENCHMARK(BM_agg_serialized);
+AGG_BENCHMARK(BM_agg_serialized_fixed_size);
+
+#undef AGG_BENCHMARK
+
+} // namespace starrocks::vectorized
+
+BENCHMARK_MAIN();
@@ -7,6 +7,7 @@
 #include <any>
 #include <variant>
 
+#include "column/fixed_length_column.h"
 #include "exec/vectorized/aggregate/agg_hash_set.h"
 
 namespace starrocks {
@@ -203,5 +204,69 @@ TEST(HashMapTest, TwoLevelConvert) {
     }
 }
 
+TEST(HashMapTest, Int64TwoLevelConvert) {
+    std::vector<int64_t> sums(1000);
+    Int64AggHashMap<PhmapSeed1> map;
+    Int64AggTwoLevelHashMap<PhmapSeed1> two_level_map;
+
+    for (int64_t i = 0; i < 1000; i++) {
+        map.emplace(i << 32, (AggDataPtr)&sums[i]);
+    }
+    two_level_map.reserve(map.capacity());
+    two_level_map.insert(map.begin(), map.end());
+
+    ASSERT_EQ(map.size(), two_level_map.size());
+    for (const auto& [key, value] : map) {
+        auto it = two_level_map.find(key);
+        ASSERT_TRUE(it != two_level_map.end());
+        ASSERT_EQ(value, it->second);
+    }
+}
+
+TEST(HashMapTest, SmallFixedSizeAggHashMap) {
+    using HashMapWithKey = AggHashMapWithOneNumberKey<TYPE_TINYINT, Int8AggHashMap<PhmapSeed1>>;
+    HashMapWithKey hash_map_with_key(4096);
+
+    auto column = Int8Column::create();
+    for (int i = 0; i < 1000; i++) {
+        column->append(static_cast<int8_t>(i % 200 - 100));
+    }
+    Columns key_columns{column};
+
+    std::vector<int64_t> states;
+    states.reserve(1000);
+    Buffer<AggDataPtr> agg_states(1000);
+    auto allocate = [&]() {
+        states.emplace_back(0);
+        return (AggDataPtr)&states.back();
+    };
+    hash_map_with_key.compute_agg_states(1000, key_columns, nullptr, allocate, &agg_states);
+    ASSERT_EQ(200, hash_map_with_key.hash_map.size());
+    ASSERT_EQ(200, states.size());
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(agg_states[i], agg_states[i % 200]);
+    }
+
+    // Iterated in the order of the keys.
+    int8_t prev_key = -101;
+    size_t count = 0;
+    for (auto it = hash_map_with_key.hash_map.begin(); it != hash_map_with_key.hash_map.end(); ++it) {
+        ASSERT_LT(prev_key, it->first);
+        ASSERT_EQ(agg_states[it->first + 100], it->second);
+        prev_key = it->first;
+        count++;
+    }
+    ASSERT_EQ(200, count);
+
+    std::vector<uint8_t> not_founds;
+    auto probe_column = Int8Column::create();
+    probe_column->append(static_cast<int8_t>(99));
+    probe_column->append(static_cast<int8_t>(100));
+    Columns probe_columns{probe_column};
+    hash_map_with_key.compute_agg_states(2, probe_columns, allocate, &agg_states, &not_founds);
+    ASSERT_EQ(0, not_founds[0]);
+    ASSERT_EQ(1, not_founds[1]);
+}
+
 } // namespace vectorized
 } // namespace starrocks
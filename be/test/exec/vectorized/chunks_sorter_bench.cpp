@@ -0,0 +1,107 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of sorting the chunks by an int and a varchar column, fully and for the top n rows.
+// Usage: chunks_sorter_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_topn.h"
+#include "exprs/slot_ref.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+static constexpr uint32_t kChunkSize = 4096;
+
+class SortBench {
+public:
+    explicit SortBench(size_t num_rows) {
+        TQueryOptions query_options;
+        query_options.batch_size = kChunkSize;
+        _runtime_state = std::make_shared<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        _runtime_state->init_instance_mem_tracker();
+
+        std::mt19937 rng(num_rows);
+        Chunk::SlotHashMap slot_map{{0, 0}, {1, 1}};
+        for (size_t begin = 0; begin < num_rows; begin += kChunkSize) {
+            auto int_column = Int32Column::create();
+            auto string_column = BinaryColumn::create();
+            for (size_t i = begin; i < std::min<size_t>(num_rows, begin + kChunkSize); i++) {
+                // few distinct ints, so the varchar column breaks the ties
+                int_column->append(static_cast<int32_t>(rng() % 100));
+                string_column->append("sort_key_" + std::to_string(rng()));
+            }
+            _chunks.emplace_back(std::make_shared<Chunk>(Columns{int_column, string_column}, slot_map));
+        }
+
+        _int_ref = std::make_unique<SlotRef>(TypeDescriptor(TYPE_INT), 0, 0);
+        _string_ref = std::make_unique<SlotRef>(TypeDescriptor(TYPE_VARCHAR), 0, 1);
+        _sort_exprs = {_pool.add(new ExprContext(_int_ref.get())), _pool.add(new ExprContext(_string_ref.get()))};
+    }
+
+    // Sort all the chunks and return the number of the output rows.
+    template <typename Sorter>
+    size_t sort(Sorter* sorter) {
+        for (const auto& chunk : _chunks) {
+            auto st = sorter->update(_runtime_state.get(), chunk->clone_unique());
+            DCHECK(st.ok());
+        }
+        (void)sorter->done(_runtime_state.get());
+        size_t num_rows = 0;
+        for (bool eos = false; !eos;) {
+            ChunkPtr chunk;
+            (void)sorter->get_next(&chunk, &eos);
+            num_rows += chunk != nullptr ? chunk->num_rows() : 0;
+        }
+        return num_rows;
+    }
+
+    RuntimeState* runtime_state() { return _runtime_state.get(); }
+    const std::vector<ExprContext*>* sort_exprs() const { return &_sort_exprs; }
+
+private:
+    ObjectPool _pool;
+    std::shared_ptr<RuntimeState> _runtime_state;
+    std::vector<ChunkPtr> _chunks;
+    std::unique_ptr<SlotRef> _int_ref;
+    std::unique_ptr<SlotRef> _string_ref;
+    std::vector<ExprContext*> _sort_exprs;
+};
+
+static const std::vector<bool> kIsAsc{true, false};
+static const std::vector<bool> kIsNullFirst{true, true};
+
+static void BM_full_sort(benchmark::State& state) {
+    SortBench bench(state.range(0));
+    for (auto _ : state) {
+        ChunksSorterFullSort sorter(bench.runtime_state(), bench.sort_exprs(), &kIsAsc, &kIsNullFirst, kChunkSize);
+        benchmark::DoNotOptimize(bench.sort(&sorter));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_topn(benchmark::State& state) {
+    SortBench bench(state.range(0));
+    const auto limit = static_cast<size_t>(state.range(1));
+    for (auto _ : state) {
+        ChunksSorterTopn sorter(bench.runtime_state(), bench.sort_exprs(), &kIsAsc, &kIsNullFirst, 0, limit,
+                                kChunkSize);
+        benchmark::DoNotOptimize(bench.sort(&sorter));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_full_sort)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_topn)->Args({1 << 20, 10})->Args({1 << 20, 1000})->Args({1 << 20, 100000})->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks::vectorized
+
+BENCHMARK_MAIN();
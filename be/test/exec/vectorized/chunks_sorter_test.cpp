@@ -2,8 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <optional>
+
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
+#include "common/config.h"
+#include "env/env.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
 #include "exprs/slot_ref.h"
@@ -454,4 +458,130 @@ TEST_F(ChunksSorterTest, order_by_with_unequal_sized_chunks) {
     clear_sort_exprs(sort_exprs);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_spill_sorted_runs) {
+    std::string query_scratch_dirs = config::query_scratch_dirs;
+    int64_t spill_threshold = config::spill_operator_mem_threshold_bytes;
+    config::query_scratch_dirs = config::storage_root_path + "/chunks_sorter_test";
+    ASSERT_TRUE(Env::Default()->create_dir_if_missing(config::query_scratch_dirs).ok());
+    // Spill every chunk as a sorted run.
+    config::spill_operator_mem_threshold_bytes = 1;
+
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{true};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    RuntimeProfile profile("ChunksSorter");
+    ChunksSorterFullSort sorter(_runtime_state.get(), &sort_exprs, &is_asc, &is_null_first, 2);
+    sorter.enable_spill(&profile);
+    std::vector<ChunkPtr> chunks{_chunk_1, _chunk_2, _chunk_3};
+    size_t total_rows = 0;
+    for (const auto& chunk : chunks) {
+        ASSERT_TRUE(sorter.update(_runtime_state.get(), chunk).ok());
+        total_rows += chunk->num_rows();
+    }
+    ASSERT_TRUE(sorter.done(_runtime_state.get()).ok());
+    ASSERT_TRUE(sorter.has_spilled());
+    ASSERT_EQ(total_rows, sorter.get_partition_rows());
+    // Three spilled runs and an empty in-memory run.
+    ASSERT_EQ(4, sorter.num_sorted_runs());
+
+    for (size_t run = 0; run < sorter.num_sorted_runs(); ++run) {
+        size_t run_rows = 0;
+        int32_t last = std::numeric_limits<int32_t>::min();
+        while (true) {
+            ChunkPtr chunk;
+            ASSERT_TRUE(sorter.get_next_from_sorted_run(run, &chunk).ok());
+            if (chunk == nullptr) {
+                break;
+            }
+            for (size_t i = 0; i < chunk->num_rows(); ++i) {
+                int32_t value = chunk->get(i).get(0).get_int32();
+                ASSERT_LE(last, value);
+                last = value;
+            }
+            run_rows += chunk->num_rows();
+        }
+        ASSERT_EQ(run < chunks.size() ? chunks[run]->num_rows() : 0, run_rows);
+    }
+
+    clear_sort_exprs(sort_exprs);
+    config::query_scratch_dirs = query_scratch_dirs;
+    config::spill_operator_mem_threshold_bytes = spill_threshold;
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_by_radix) {
+    // Enough rows to sort the fixed-width columns by radix, with negative values, NULLs and duplicates.
+    const size_t num_rows = 3000;
+    std::vector<std::optional<int64_t>> keys_1(num_rows);
+    std::vector<int32_t> keys_2(num_rows);
+    auto col_1 = ColumnHelper::create_column(TypeDescriptor(TYPE_BIGINT), true);
+    auto col_2 = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (i % 7 == 0) {
+            col_1->append_nulls(1);
+        } else {
+            keys_1[i] = static_cast<int64_t>((i * 7919) % 101) - 50 + (i % 3 == 0 ? (int64_t(1) << 40) : 0);
+            col_1->append_datum(keys_1[i].value());
+        }
+        keys_2[i] = static_cast<int32_t>((i * 104729) % 1000) - 500;
+        col_2->append_datum(keys_2[i]);
+    }
+    Chunk::SlotHashMap map;
+    map[0] = 0;
+    map[1] = 1;
+    auto chunk = std::make_shared<Chunk>(Columns{col_1, col_2}, map);
+
+    auto expr_1 = std::make_unique<SlotRef>(TypeDescriptor(TYPE_BIGINT), 0, 0);
+    auto expr_2 = std::make_unique<SlotRef>(TypeDescriptor(TYPE_INT), 0, 1);
+    std::vector<bool> is_asc{false, true};
+    std::vector<bool> is_null_first{false, false};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(expr_1.get()));
+    sort_exprs.push_back(new ExprContext(expr_2.get()));
+
+    ChunksSorterFullSort sorter(_runtime_state.get(), &sort_exprs, &is_asc, &is_null_first, 2);
+    sorter.update(_runtime_state.get(), chunk);
+    sorter.done(_runtime_state.get());
+
+    std::vector<size_t> expected(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        expected[i] = i;
+    }
+    std::stable_sort(expected.begin(), expected.end(), [&](size_t l, size_t r) {
+        if (keys_1[l] != keys_1[r]) {
+            // NULLs last, then descending.
+            if (!keys_1[l].has_value() || !keys_1[r].has_value()) {
+                return keys_1[l].has_value();
+            }
+            return keys_1[l].value() > keys_1[r].value();
+        }
+        return keys_2[l] < keys_2[r];
+    });
+
+    size_t row = 0;
+    bool eos = false;
+    while (true) {
+        ChunkPtr page;
+        sorter.get_next(&page, &eos);
+        if (eos) {
+            break;
+        }
+        for (size_t i = 0; i < page->num_rows(); ++i, ++row) {
+            size_t expected_row = expected[row];
+            auto datum = page->get(i);
+            ASSERT_EQ(keys_1[expected_row].has_value(), !datum.get(0).is_null());
+            if (keys_1[expected_row].has_value()) {
+                ASSERT_EQ(keys_1[expected_row].value(), datum.get(0).get_int64());
+            }
+            ASSERT_EQ(keys_2[expected_row], datum.get(1).get_int32());
+        }
+    }
+    ASSERT_EQ(num_rows, row);
+
+    clear_sort_exprs(sort_exprs);
+}
+
 } // namespace starrocks::vectorized
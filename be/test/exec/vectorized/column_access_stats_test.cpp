@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/column_access_stats.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+// NOLINTNEXTLINE
+TEST(ColumnAccessStatsTest, collect_and_merge) {
+    TabletSchemaPB schema_pb;
+    for (const char* name : {"k1", "k2", "v1"}) {
+        ColumnPB* column = schema_pb.add_column();
+        column->set_unique_id(schema_pb.column_size());
+        column->set_name(name);
+        column->set_type("INT");
+        column->set_length(4);
+        column->set_is_key(name[0] == 'k');
+        column->set_is_nullable(false);
+    }
+    TabletSchema schema;
+    schema.init_from_pb(schema_pb);
+
+    SlotDescriptor k1_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").id(1).build());
+    SlotDescriptor v1_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v1").id(2).build());
+    std::vector<SlotDescriptor*> slots{&k1_slot, &v1_slot};
+
+    auto type_info = get_type_info(OLAP_FIELD_TYPE_INT);
+    std::unique_ptr<ColumnPredicate> eq(new_column_eq_predicate(type_info, 0, "1"));
+    std::unique_ptr<ColumnPredicate> lt(new_column_lt_predicate(type_info, 1, "10"));
+    std::unique_ptr<ColumnPredicate> gt(new_column_gt_predicate(type_info, 1, "0"));
+    std::vector<const ColumnPredicate*> predicates{eq.get(), lt.get(), gt.get()};
+
+    RuntimeState state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    state.add_grouping_slots({2});
+
+    auto accesses = collect_column_access(schema, slots, predicates, &state);
+    ASSERT_EQ(3, accesses.size());
+    ASSERT_EQ(1, accesses["k1"].reads);
+    ASSERT_EQ(1, accesses["k1"].filters);
+    ASSERT_EQ(0, accesses["k1"].groups);
+    ASSERT_EQ(1, accesses["k1"].predicate_forms["eq"]);
+    // k2 is only filtered, by a range of two predicates
+    ASSERT_EQ(0, accesses["k2"].reads);
+    ASSERT_EQ(1, accesses["k2"].filters);
+    ASSERT_EQ(2, accesses["k2"].predicate_forms["range"]);
+    ASSERT_EQ(1, accesses["v1"].reads);
+    ASSERT_EQ(0, accesses["v1"].filters);
+    ASSERT_EQ(1, accesses["v1"].groups);
+
+    ColumnAccessStats merged = accesses["k2"];
+    merged.merge(accesses["k2"]);
+    ASSERT_EQ(2, merged.filters);
+    ASSERT_EQ(4, merged.predicate_forms["range"]);
+}
+
+} // namespace starrocks::vectorized
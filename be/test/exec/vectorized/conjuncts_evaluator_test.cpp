@@ -0,0 +1,134 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/conjuncts_evaluator.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "common/object_pool.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+
+namespace starrocks {
+namespace vectorized {
+
+// returns the boolean column of a slot, and records the rows it's evaluated on
+class CountingExpr final : public Expr {
+public:
+    CountingExpr(SlotId slot_id, int sleep_us)
+            : Expr(TypeDescriptor(TYPE_BOOLEAN)), _slot_id(slot_id), _sleep_us(sleep_us) {}
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new CountingExpr(*this)); }
+
+    ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        rows.emplace_back(ptr->num_rows());
+        if (_sleep_us > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(_sleep_us));
+        }
+        return ptr->get_column_by_slot_id(_slot_id);
+    }
+
+    int get_slot_ids(std::vector<SlotId>* slot_ids) const override {
+        slot_ids->emplace_back(_slot_id);
+        return 1;
+    }
+
+    std::vector<size_t> rows;
+
+private:
+    SlotId _slot_id;
+    int _sleep_us;
+};
+
+class AdaptiveConjunctsEvaluatorTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNumRows = 1000;
+
+    // slot 1 keeps 10% of the rows, slot 2 keeps 50%, slots 3-6 are the payload
+    static ChunkPtr make_chunk() {
+        auto chunk = std::make_shared<Chunk>();
+        auto one_in_ten = BooleanColumn::create();
+        auto one_in_two = BooleanColumn::create();
+        for (size_t i = 0; i < kNumRows; i++) {
+            one_in_ten->append(i % 10 == 0);
+            one_in_two->append(i % 2 == 0);
+        }
+        chunk->append_column(std::move(one_in_ten), 1);
+        chunk->append_column(std::move(one_in_two), 2);
+        for (SlotId slot_id = 3; slot_id <= 6; slot_id++) {
+            auto payload = Int32Column::create();
+            for (size_t i = 0; i < kNumRows; i++) {
+                payload->append(static_cast<int32_t>(i));
+            }
+            chunk->append_column(std::move(payload), slot_id);
+        }
+        return chunk;
+    }
+
+    static void check_chunk(const ChunkPtr& chunk) {
+        ASSERT_EQ(kNumRows / 10, chunk->num_rows());
+        for (SlotId slot_id = 3; slot_id <= 6; slot_id++) {
+            const auto& payload = down_cast<Int32Column*>(chunk->get_column_by_slot_id(slot_id).get())->get_data();
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                ASSERT_EQ(i * 10, payload[i]);
+            }
+        }
+    }
+
+    ObjectPool _pool;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveConjunctsEvaluatorTest, evaluate_on_kept_rows) {
+    auto* one_in_two = _pool.add(new CountingExpr(2, 1000));
+    auto* one_in_ten = _pool.add(new CountingExpr(1, 0));
+    ExprContext* one_in_two_ctx = _pool.add(new ExprContext(one_in_two));
+    ExprContext* one_in_ten_ctx = _pool.add(new ExprContext(one_in_ten));
+    AdaptiveConjunctsEvaluator evaluator({one_in_two_ctx, one_in_ten_ctx});
+
+    ChunkPtr chunk = make_chunk();
+    evaluator.evaluate(chunk.get());
+    check_chunk(chunk);
+    // the second one only sees the half kept by the first one
+    ASSERT_EQ(std::vector<size_t>{kNumRows}, one_in_two->rows);
+    ASSERT_EQ(std::vector<size_t>{kNumRows / 2}, one_in_ten->rows);
+
+    // the cheaper one rejecting more rows goes first after the reordering
+    for (size_t i = 2; i < AdaptiveConjunctsEvaluator::kReorderInterval; i++) {
+        chunk = make_chunk();
+        evaluator.evaluate(chunk.get());
+        check_chunk(chunk);
+    }
+    ASSERT_EQ(std::vector<ExprContext*>({one_in_two_ctx, one_in_ten_ctx}), evaluator.order());
+    one_in_two->rows.clear();
+    one_in_ten->rows.clear();
+    chunk = make_chunk();
+    evaluator.evaluate(chunk.get());
+    check_chunk(chunk);
+    ASSERT_EQ(std::vector<ExprContext*>({one_in_ten_ctx, one_in_two_ctx}), evaluator.order());
+    ASSERT_EQ(std::vector<size_t>{kNumRows}, one_in_ten->rows);
+    ASSERT_EQ(std::vector<size_t>{kNumRows / 10}, one_in_two->rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveConjunctsEvaluatorTest, all_rejected) {
+    auto chunk = make_chunk();
+    auto none = BooleanColumn::create(kNumRows, 0);
+    chunk->append_column(std::move(none), 7);
+    auto* one_in_two = _pool.add(new CountingExpr(2, 0));
+    auto* rejecting = _pool.add(new CountingExpr(7, 0));
+    auto* one_in_ten = _pool.add(new CountingExpr(1, 0));
+    AdaptiveConjunctsEvaluator evaluator({_pool.add(new ExprContext(one_in_two)), _pool.add(new ExprContext(rejecting)),
+                                          _pool.add(new ExprContext(one_in_ten))});
+    evaluator.evaluate(chunk.get());
+    ASSERT_EQ(0, chunk->num_rows());
+    // the conjuncts after the one rejecting all rows are skipped
+    ASSERT_TRUE(one_in_ten->rows.empty());
+}
+
+} // namespace vectorized
+} // namespace starrocks
@@ -0,0 +1,94 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of looking up the join hash table for the probe rows, with and without prefetching.
+// Usage: join_hash_map_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "column/fixed_length_column.h"
+#include "exec/vectorized/join_hash_map.h"
+
+namespace starrocks::vectorized {
+
+static constexpr uint32_t kProbeChunkSize = 4096;
+// The probe chunks are rotated, so that a chunk is not in the cache from the last iteration.
+static constexpr uint32_t kNumProbeChunks = 64;
+
+class JoinProbeBench {
+public:
+    explicit JoinProbeBench(uint32_t build_rows) {
+        std::mt19937 rng(build_rows);
+        std::vector<int32_t> keys(build_rows);
+        auto build_column = Int32Column::create();
+        // The row 0 is the default row.
+        build_column->append(0);
+        for (uint32_t i = 0; i < build_rows; i++) {
+            keys[i] = static_cast<int32_t>(rng());
+            build_column->append(keys[i]);
+        }
+
+        _table_items.key_columns.emplace_back(std::move(build_column));
+        _table_items.row_count = build_rows;
+        _table_items.bucket_size = JoinHashMapHelper::calc_bucket_size(build_rows + 1);
+        _table_items.first.resize(_table_items.bucket_size, 0);
+        _table_items.next.resize(build_rows + 1, 0);
+        (void)JoinBuildFunc<TYPE_INT>::construct_hash_table(nullptr, &_table_items, &_probe_state);
+        JoinHashMapHelper::prepare_map_index(&_probe_state, kProbeChunkSize);
+
+        for (uint32_t i = 0; i < kNumProbeChunks; i++) {
+            auto probe_column = Int32Column::create();
+            for (uint32_t j = 0; j < kProbeChunkSize; j++) {
+                probe_column->append(keys[rng() % build_rows]);
+            }
+            _probe_chunks.emplace_back(Columns{std::move(probe_column)});
+        }
+    }
+
+    size_t probe(bool prefetch) {
+        _table_items.enable_probe_prefetch = prefetch;
+        _probe_state.key_columns = &_probe_chunks[_next_chunk++ % kNumProbeChunks];
+        _probe_state.probe_row_count = kProbeChunkSize;
+        (void)JoinProbeFunc<TYPE_INT>::lookup_init(_table_items, &_probe_state);
+
+        // The same walk through the chains as JoinHashMap::_probe_from_ht().
+        const auto& build_data = JoinBuildFunc<TYPE_INT>::get_key_data(_table_items);
+        const auto& probe_data = JoinProbeFunc<TYPE_INT>::get_key_data(_probe_state);
+        size_t match_count = 0;
+        for (uint32_t i = 0; i < kProbeChunkSize; i++) {
+            for (uint32_t index = _probe_state.next[i]; index != 0; index = _table_items.next[index]) {
+                match_count += build_data[index] == probe_data[i];
+            }
+        }
+        return match_count;
+    }
+
+private:
+    JoinHashTableItems _table_items;
+    HashTableProbeState _probe_state;
+    std::vector<Columns> _probe_chunks;
+    size_t _next_chunk = 0;
+};
+
+static void BM_join_probe(benchmark::State& state) {
+    JoinProbeBench bench(state.range(0));
+    bool prefetch = state.range(1) != 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bench.probe(prefetch));
+    }
+    state.SetItemsProcessed(state.iterations() * kProbeChunkSize);
+}
+
+// The build rows from in L2 to far beyond L3, without and with prefetching.
+BENCHMARK(BM_join_probe)
+        ->Args({1 << 14, 0})
+        ->Args({1 << 14, 1})
+        ->Args({1 << 20, 0})
+        ->Args({1 << 20, 1})
+        ->Args({1 << 24, 0})
+        ->Args({1 << 24, 1});
+
+} // namespace starrocks::vectorized
+
+BENCHMARK_MAIN();
@@ -738,6 +738,63 @@ TEST_F(JoinHashMapTest, CalcBucketNums) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, CalcBucketNumsMurmur) {
+    Buffer<int32_t> data32{1, 2, 3, 4, -1, 1 << 20, 7, 8, 9};
+    Buffer<int64_t> data64{1, 2, 3, 4, -1, 1L << 40, 7, 8, 9};
+    Buffer<uint32_t> buckets(data32.size());
+    const uint32_t bucket_size = 1024;
+
+    JoinHashMapHelper::calc_bucket_nums<int32_t>(data32, bucket_size, &buckets, 0, data32.size(),
+                                                 JoinHashMixing::MURMUR3);
+    for (size_t i = 0; i < data32.size(); i++) {
+        ASSERT_EQ(fmix32(data32[i]) & (bucket_size - 1), buckets[i]);
+        ASSERT_EQ(buckets[i], JoinHashMapHelper::calc_bucket_num(data32[i], bucket_size, JoinHashMixing::MURMUR3));
+    }
+    JoinHashMapHelper::calc_bucket_nums<int64_t>(data64, bucket_size, &buckets, 0, data64.size(),
+                                                 JoinHashMixing::MURMUR3);
+    for (size_t i = 0; i < data64.size(); i++) {
+        ASSERT_EQ(fmix64(data64[i]) & (bucket_size - 1), buckets[i]);
+        ASSERT_EQ(buckets[i], JoinHashMapHelper::calc_bucket_num(data64[i], bucket_size, JoinHashMixing::MURMUR3));
+    }
+
+    // the keys which can't be mixed are hashed by crc32
+    Buffer<Slice> slices{Slice{"abcd", 4}};
+    ASSERT_EQ(JoinHashMapHelper::calc_bucket_num(slices[0], bucket_size),
+              JoinHashMapHelper::calc_bucket_num(slices[0], bucket_size, JoinHashMixing::MURMUR3));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LookupBucketHeads) {
+    JoinHashTableItems table_items;
+    table_items.first = Buffer<uint32_t>{0, 3, 0, 2};
+    table_items.next = Buffer<uint32_t>{0, 0, 1, 0};
+    Buffer<int32_t> build_data{0, 2, 1, 3};
+
+    HashTableProbeState probe_state;
+    JoinHashMapHelper::prepare_map_index(&probe_state, 32);
+    // More rows than PREFETCH_DISTANCE.
+    uint32_t row_count = 20;
+    Buffer<uint8_t> is_nulls(row_count, 0);
+    for (uint32_t i = 0; i < row_count; i++) {
+        probe_state.buckets[i] = i % 4;
+        is_nulls[i] = i % 5 == 0;
+    }
+
+    for (bool prefetch : {false, true}) {
+        table_items.enable_probe_prefetch = prefetch;
+        JoinHashMapHelper::lookup_bucket_heads<int32_t>(table_items, &probe_state, build_data, nullptr, row_count);
+        for (uint32_t i = 0; i < row_count; i++) {
+            ASSERT_EQ(table_items.first[i % 4], probe_state.next[i]);
+        }
+        JoinHashMapHelper::lookup_bucket_heads<int32_t>(table_items, &probe_state, build_data, is_nulls.data(),
+                                                        row_count);
+        for (uint32_t i = 0; i < row_count; i++) {
+            ASSERT_EQ(is_nulls[i] ? 0 : table_items.first[i % 4], probe_state.next[i]);
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, PrepareMapIndex) {
     HashTableProbeState probe_state;
@@ -1729,6 +1786,220 @@ TEST_F(JoinHashMapTest, FixedSizeJoinHashTable) {
     hash_table.close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, MurmurHashMixingJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    std::shared_ptr<MemPool> mem_pool = std::make_shared<MemPool>();
+    config::vector_chunk_size = 4096;
+    config::join_hash_mixing = "murmur3";
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    auto build_chunk = create_int32_build_chunk(10, false);
+    auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+    probe_key_columns.emplace_back(probe_chunk->columns()[1]);
+
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[1]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    config::join_hash_mixing = "crc32";
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+
+    ASSERT_TRUE(hash_table.probe(runtime_state.get(), probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+    ASSERT_EQ(result_chunk->num_columns(), 6);
+
+    ColumnPtr column1 = result_chunk->get_column_by_slot_id(0);
+    check_int32_column(column1, 5, 1);
+    ColumnPtr column2 = result_chunk->get_column_by_slot_id(1);
+    check_int32_column(column2, 5, 11);
+    ColumnPtr column3 = result_chunk->get_column_by_slot_id(2);
+    check_int32_column(column3, 5, 21);
+    ColumnPtr column4 = result_chunk->get_column_by_slot_id(3);
+    check_int32_column(column4, 5, 1);
+    ColumnPtr column5 = result_chunk->get_column_by_slot_id(4);
+    check_int32_column(column5, 5, 11);
+    ColumnPtr column6 = result_chunk->get_column_by_slot_id(5);
+    check_int32_column(column6, 5, 21);
+
+    hash_table.close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, ParallelBuildJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+    JoinHashTable shared_hash_table;
+    shared_hash_table.create(param);
+
+    auto build_chunk = create_int32_build_chunk(10, false);
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[1]);
+
+    auto prepared = hash_table.prepare_parallel_build(runtime_state.get());
+    ASSERT_TRUE(prepared.ok());
+    ASSERT_TRUE(prepared.value());
+    // Two tasks of the rows [1, 5] and [6, 10].
+    std::vector<uint32_t> rows(10);
+    std::vector<uint32_t> buckets(10);
+    for (uint32_t i = 0; i < 10; i++) {
+        rows[i] = i + 1;
+    }
+    hash_table.calc_build_buckets(6, 5, buckets.data() + 5);
+    hash_table.calc_build_buckets(1, 5, buckets.data());
+    hash_table.link_rows(rows.data(), buckets.data(), rows.size());
+    shared_hash_table.share_built_table(runtime_state.get(), hash_table);
+    ASSERT_EQ(10, shared_hash_table.get_row_count());
+    ASSERT_EQ(hash_table.get_bucket_size(), shared_hash_table.get_bucket_size());
+
+    for (auto* ht : {&hash_table, &shared_hash_table}) {
+        auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+        Columns probe_key_columns;
+        probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+        probe_key_columns.emplace_back(probe_chunk->columns()[1]);
+
+        ChunkPtr result_chunk = std::make_shared<Chunk>();
+        bool eos = false;
+        ASSERT_TRUE(ht->probe(runtime_state.get(), probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+        ASSERT_EQ(result_chunk->num_columns(), 6);
+        check_int32_column(result_chunk->get_column_by_slot_id(0), 5, 1);
+        check_int32_column(result_chunk->get_column_by_slot_id(1), 5, 11);
+        check_int32_column(result_chunk->get_column_by_slot_id(2), 5, 21);
+        check_int32_column(result_chunk->get_column_by_slot_id(3), 5, 1);
+        check_int32_column(result_chunk->get_column_by_slot_id(4), 5, 11);
+        check_int32_column(result_chunk->get_column_by_slot_id(5), 5, 21);
+    }
+
+    hash_table.close();
+    shared_hash_table.close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, ClusteredBuildRowsJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+    double min_chain_length = config::join_cluster_build_rows_min_chain_length;
+    // Every bucket is long enough.
+    config::join_cluster_build_rows_min_chain_length = 1;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    auto build_chunk = create_int32_build_chunk(10, false);
+    auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+    probe_key_columns.emplace_back(probe_chunk->columns()[1]);
+
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[1]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    config::join_cluster_build_rows_min_chain_length = min_chain_length;
+
+    ASSERT_TRUE(hash_table._table_items->build_rows_clustered);
+    const auto& next = hash_table._table_items->next;
+    for (uint32_t i = 1; i < next.size(); i++) {
+        ASSERT_TRUE(next[i] == 0 || next[i] == i + 1);
+    }
+    // The key columns are still the columns of build_chunk.
+    ASSERT_EQ(hash_table.get_key_columns()[0].get(), hash_table.get_build_chunk()->columns()[0].get());
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(hash_table.probe(runtime_state.get(), probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+    ASSERT_EQ(result_chunk->num_columns(), 6);
+    check_int32_column(result_chunk->get_column_by_slot_id(0), 5, 1);
+    check_int32_column(result_chunk->get_column_by_slot_id(1), 5, 11);
+    check_int32_column(result_chunk->get_column_by_slot_id(2), 5, 21);
+    check_int32_column(result_chunk->get_column_by_slot_id(3), 5, 1);
+    check_int32_column(result_chunk->get_column_by_slot_id(4), 5, 11);
+    check_int32_column(result_chunk->get_column_by_slot_id(5), 5, 21);
+
+    hash_table.close();
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, SerializeJoinHashTable) {
     auto runtime_profile = create_runtime_profile();
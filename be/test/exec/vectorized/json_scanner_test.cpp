@@ -401,6 +401,41 @@ TEST_F(JsonScannerTest, test_ndjson_with_jsonpath) {
     EXPECT_EQ("['v5', 'server', '10.10.0.5', 50]", chunk->debug_row(4));
 }
 
+TEST_F(JsonScannerTest, test_ndjson_with_jsonpath_projection) {
+    std::vector<TypeDescriptor> types;
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TYPE_INT);
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.format_type = TFileFormatType::FORMAT_JSON;
+    range.strip_outer_array = false;
+    range.__isset.strip_outer_array = false;
+    range.__isset.jsonpaths = true;
+    // not in the order of the fields in the documents
+    range.jsonpaths = "[\"$.k\", \"$.nested.ip\", \"$.a\", \"$.nested.z\"]";
+    range.__isset.json_root = false;
+    range.__set_path("./be/test/exec/test_data/json_scanner/test_json_path_projection.json");
+    ranges.emplace_back(range);
+
+    auto scanner = create_json_scanner(types, ranges, {"k", "ip", "a", "z"});
+
+    Status st;
+    st = scanner->open();
+    ASSERT_TRUE(st.ok());
+
+    ChunkPtr chunk = scanner->get_next().value();
+    EXPECT_EQ(4, chunk->num_columns());
+    EXPECT_EQ(3, chunk->num_rows());
+
+    EXPECT_EQ("['first', '10.0.0.1', 1, 'v1']", chunk->debug_row(0));
+    EXPECT_EQ("['second', '10.0.0.2', 2, NULL]", chunk->debug_row(1));
+    // the first one of the duplicated keys is extracted
+    EXPECT_EQ("['third', NULL, 3, NULL]", chunk->debug_row(2));
+}
+
 TEST_F(JsonScannerTest, test_multi_type) {
     std::vector<TypeDescriptor> types;
     types.emplace_back(TYPE_BOOLEAN);
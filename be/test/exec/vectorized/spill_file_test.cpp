@@ -0,0 +1,207 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/spill_file.h"
+
+#include <set>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "env/env.h"
+#include "gtest/gtest.h"
+
+namespace starrocks::vectorized {
+
+class SpillFileTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _query_scratch_dirs = config::query_scratch_dirs;
+        config::query_scratch_dirs = config::storage_root_path + "/spill_file_test";
+        ASSERT_TRUE(Env::Default()->create_dir_if_missing(config::query_scratch_dirs).ok());
+    }
+
+    void TearDown() override { config::query_scratch_dirs = _query_scratch_dirs; }
+
+    static ChunkPtr create_chunk(int32_t from, int32_t to) {
+        auto c0 = Int32Column::create();
+        auto c1 = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+        for (int32_t i = from; i < to; i++) {
+            c0->append(i);
+            if (i % 3 == 0) {
+                c1->append_default();
+            } else {
+                std::string s = "value_" + std::to_string(i);
+                c1->append_datum(Datum(Slice(s)));
+            }
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(std::move(c0), 0);
+        chunk->append_column(std::move(c1), 1);
+        return chunk;
+    }
+
+    std::string _query_scratch_dirs;
+};
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, append_and_read) {
+    auto res = SpillFile::create("test");
+    ASSERT_TRUE(res.ok()) << res.status();
+    auto file = std::move(res).value();
+    std::string path = file->path();
+
+    ASSERT_TRUE(file->append(*create_chunk(0, 100)).ok());
+    ASSERT_TRUE(file->append(*create_chunk(100, 150)).ok());
+    ASSERT_EQ(2, file->num_chunks());
+    ASSERT_EQ(150, file->num_rows());
+    ASSERT_TRUE(file->flip_to_read().ok());
+
+    auto prototype = create_chunk(0, 0);
+    for (int round = 0; round < 2; round++) {
+        int32_t expected = 0;
+        while (true) {
+            auto chunk_or = file->read_next(*prototype);
+            if (chunk_or.status().is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(chunk_or.ok()) << chunk_or.status();
+            auto chunk = std::move(chunk_or).value();
+            ASSERT_TRUE(chunk->is_slot_exist(0));
+            ASSERT_TRUE(chunk->is_slot_exist(1));
+            for (size_t i = 0; i < chunk->num_rows(); i++, expected++) {
+                ASSERT_EQ(expected, chunk->get_column_by_slot_id(0)->get(i).get_int32());
+                auto datum = chunk->get_column_by_slot_id(1)->get(i);
+                if (expected % 3 == 0) {
+                    ASSERT_TRUE(datum.is_null());
+                } else {
+                    ASSERT_EQ("value_" + std::to_string(expected), datum.get_slice().to_string());
+                }
+            }
+        }
+        ASSERT_EQ(150, expected);
+        file->rewind();
+    }
+
+    file.reset();
+    ASSERT_TRUE(Env::Default()->path_exists(path).is_not_found());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, partitioned_spiller) {
+    const size_t num_partitions = 4;
+    const size_t chunk_size = 16;
+    PartitionedSpiller spiller("test", num_partitions, chunk_size);
+    for (int32_t i = 0; i < 10; i++) {
+        auto chunk = create_chunk(i * 100, (i + 1) * 100);
+        ASSERT_TRUE(spiller.append(chunk, {chunk->get_column_by_slot_id(0)}).ok());
+    }
+    // Spill the same keys again, they must go into the same partitions.
+    for (int32_t i = 0; i < 10; i++) {
+        auto chunk = create_chunk(i * 100, (i + 1) * 100);
+        ASSERT_TRUE(spiller.append(chunk, {chunk->get_column_by_slot_id(0)}).ok());
+    }
+    ASSERT_TRUE(spiller.flip_to_read().ok());
+    ASSERT_EQ(2000, spiller.spilled_rows());
+
+    auto prototype = create_chunk(0, 0);
+    std::set<int32_t> all_keys;
+    size_t total_rows = 0;
+    for (size_t p = 0; p < num_partitions; p++) {
+        SpillFile* file = spiller.partition(p);
+        ASSERT_TRUE(file != nullptr);
+        std::set<int32_t> keys;
+        while (true) {
+            auto chunk_or = file->read_next(*prototype);
+            if (chunk_or.status().is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(chunk_or.ok()) << chunk_or.status();
+            auto chunk = std::move(chunk_or).value();
+            ASSERT_LE(chunk->num_rows(), chunk_size);
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                keys.insert(chunk->get_column_by_slot_id(0)->get(i).get_int32());
+            }
+            total_rows += chunk->num_rows();
+        }
+        for (int32_t key : keys) {
+            // A key never appears in two partitions.
+            ASSERT_TRUE(all_keys.insert(key).second);
+        }
+        spiller.release_partition(p);
+        ASSERT_TRUE(spiller.partition(p) == nullptr);
+    }
+    ASSERT_EQ(2000, total_rows);
+    ASSERT_EQ(1000, all_keys.size());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, hybrid_partitions) {
+    const size_t num_partitions = 4;
+    const size_t chunk_size = 16;
+    PartitionedSpiller spiller("test", num_partitions, chunk_size);
+    spiller.keep_in_memory();
+    for (int32_t i = 0; i < 5; i++) {
+        auto chunk = create_chunk(i * 100, (i + 1) * 100);
+        ASSERT_TRUE(spiller.append(chunk, {chunk->get_column_by_slot_id(0)}).ok());
+    }
+    ASSERT_EQ(0, spiller.spilled_rows());
+    ASSERT_GT(spiller.resident_bytes(1), 0);
+
+    // Rows appended after spill_partition() go to disk too.
+    ASSERT_TRUE(spiller.spill_partition(1).ok());
+    ASSERT_TRUE(spiller.is_spilled(1));
+    ASSERT_EQ(0, spiller.resident_bytes(1));
+    for (int32_t i = 5; i < 10; i++) {
+        auto chunk = create_chunk(i * 100, (i + 1) * 100);
+        ASSERT_TRUE(spiller.append(chunk, {chunk->get_column_by_slot_id(0)}).ok());
+    }
+    ASSERT_TRUE(spiller.flip_to_read().ok());
+
+    auto prototype = create_chunk(0, 0);
+    size_t total_rows = 0;
+    for (size_t p = 0; p < num_partitions; p++) {
+        if (p == 1) {
+            SpillFile* file = spiller.partition(p);
+            ASSERT_TRUE(file != nullptr);
+            ASSERT_EQ(spiller.spilled_rows(), file->num_rows());
+            total_rows += file->num_rows();
+        } else {
+            ASSERT_FALSE(spiller.is_spilled(p));
+            ASSERT_TRUE(spiller.partition(p) == nullptr);
+            for (const auto& chunk : spiller.take_resident_chunks(p)) {
+                ASSERT_LE(chunk->num_rows(), chunk_size);
+                total_rows += chunk->num_rows();
+            }
+            ASSERT_EQ(0, spiller.resident_bytes(p));
+        }
+    }
+    ASSERT_EQ(1000, total_rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, partition_mask) {
+    const size_t num_partitions = 4;
+    PartitionedSpiller spiller("test", num_partitions, 16);
+    std::vector<uint8_t> mask{0, 1, 0, 1};
+    auto chunk = create_chunk(0, 1000);
+    ASSERT_TRUE(spiller.append(chunk, {chunk->get_column_by_slot_id(0)}, &mask).ok());
+    ASSERT_TRUE(spiller.flip_to_read().ok());
+
+    const auto& partition_indexes = spiller.partition_indexes();
+    ASSERT_EQ(1000, partition_indexes.size());
+    size_t expected_rows = 0;
+    for (uint32_t partition : partition_indexes) {
+        expected_rows += mask[partition];
+    }
+    ASSERT_EQ(expected_rows, spiller.spilled_rows());
+    ASSERT_TRUE(spiller.partition(0) == nullptr);
+    ASSERT_TRUE(spiller.partition(2) == nullptr);
+
+    auto file = spiller.take_partition(1);
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_TRUE(spiller.partition(1) == nullptr);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,86 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/workgroup/work_group.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace starrocks::workgroup {
+
+static WorkGroupPtr create_workgroup(const std::string& name, int id, size_t weight,
+                                     const WorkGroupPtr& parent = nullptr) {
+    auto wg = std::make_shared<WorkGroup>(name, id, weight, -1, 10, WorkGroupType::WG_NORMAL);
+    wg->set_parent(parent);
+    return wg;
+}
+
+// NOLINTNEXTLINE
+TEST(WorkGroupTest, io_weighted_fair_share) {
+    auto tenant_a = create_workgroup("tenant_a", 1, 1);
+    auto adhoc = create_workgroup("adhoc", 2, 1, tenant_a);
+    auto dashboard = create_workgroup("dashboard", 3, 3);
+
+    IoWorkGroupQueue queue;
+    queue.add(tenant_a);
+    queue.add(adhoc);
+    queue.add(dashboard);
+    // Nothing to run.
+    ASSERT_EQ(nullptr, queue.pick_next());
+
+    adhoc->incr_num_pending_io_tasks(1);
+    dashboard->incr_num_pending_io_tasks(1);
+    std::map<int, int> num_picks;
+    for (int i = 0; i < 400; i++) {
+        auto wg = queue.pick_next();
+        ASSERT_TRUE(wg != nullptr);
+        // Only the leaf groups are picked.
+        ASSERT_NE(tenant_a, wg);
+        num_picks[wg->id()]++;
+        wg->incr_io_bytes(1000);
+    }
+    ASSERT_EQ(100, num_picks[adhoc->id()]);
+    ASSERT_EQ(300, num_picks[dashboard->id()]);
+    // The io of the child is accounted to its parent.
+    ASSERT_EQ(adhoc->io_bytes(), tenant_a->io_bytes());
+}
+
+// NOLINTNEXTLINE
+TEST(WorkGroupTest, io_hard_limit) {
+    auto tenant_a = create_workgroup("tenant_a", 1, 1);
+    auto adhoc = create_workgroup("adhoc", 2, 1, tenant_a);
+    auto dashboard = create_workgroup("dashboard", 3, 1);
+    tenant_a->set_io_bytes_limit(1000);
+
+    IoWorkGroupQueue queue;
+    queue.add(tenant_a);
+    queue.add(adhoc);
+    queue.add(dashboard);
+    adhoc->incr_num_pending_io_tasks(1);
+    dashboard->incr_num_pending_io_tasks(1);
+
+    // The limit of the parent group throttles all its children.
+    ASSERT_FALSE(adhoc->is_io_throttled());
+    adhoc->incr_io_bytes(1000000);
+    ASSERT_TRUE(adhoc->is_io_throttled());
+    ASSERT_FALSE(dashboard->is_io_throttled());
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(dashboard, queue.pick_next());
+    }
+
+    queue.remove(dashboard);
+    ASSERT_EQ(nullptr, queue.pick_next());
+}
+
+// NOLINTNEXTLINE
+TEST(WorkGroupTest, cpu_hard_limit) {
+    auto wg = create_workgroup("wg", 1, 1);
+    wg->set_cpu_hard_limit(1);
+    ASSERT_FALSE(wg->is_cpu_throttled());
+    // One core could run at most a whole period in a period.
+    wg->incr_cpu_runtime_ns(PeriodicUsage::PERIOD_NS);
+    ASSERT_TRUE(wg->is_cpu_throttled());
+    ASSERT_EQ(PeriodicUsage::PERIOD_NS, wg->cpu_runtime_ns());
+}
+
+} // namespace starrocks::workgroup
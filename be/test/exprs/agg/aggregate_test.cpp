@@ -12,6 +12,7 @@
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/agg/any_value.h"
+#include "exprs/agg/distinct.h"
 #include "exprs/agg/maxmin.h"
 #include "exprs/agg/nullable_aggregate.h"
 #include "exprs/agg/sum.h"
@@ -19,6 +20,7 @@
 #include "exprs/vectorized/arithmetic_operation.h"
 #include "gen_cpp/Data_types.h"
 #include "gutil/casts.h"
+#include "runtime/mem_pool.h"
 #include "runtime/vectorized/time_types.h"
 #include "testutil/function_utils.h"
 #include "udf/udf_internal.h"
@@ -630,6 +632,42 @@ TEST_F(AggregateTest, test_sum_distinct) {
                                                       DecimalV2Value(21));
 }
 
+TEST_F(AggregateTest, test_distinct_state_bitmap) {
+    using State = DistinctAggregateStateV2<TYPE_INT>;
+    State state;
+    int64_t sum = 0;
+    for (int32_t i = -100; i < 10000; i++) {
+        state.update(i);
+        state.update(i);
+        sum += i;
+    }
+    // The dense keys are converted to the bitmap.
+    ASSERT_TRUE(state.bitmap != nullptr);
+    ASSERT_EQ(0, state.set.size());
+    ASSERT_EQ(10100, state.disctint_count());
+    ASSERT_EQ(sum, state.sum_distinct());
+
+    std::vector<uint8_t> buffer(state.serialize_size());
+    state.serialize(buffer.data());
+
+    // Merged into a small hash set, and into a bitmap.
+    State small_state;
+    small_state.update(-1000);
+    small_state.deserialize_and_merge(buffer.data(), buffer.size());
+    ASSERT_EQ(10101, small_state.disctint_count());
+    ASSERT_EQ(sum - 1000, small_state.sum_distinct());
+    state.deserialize_and_merge(buffer.data(), buffer.size());
+    ASSERT_EQ(10100, state.disctint_count());
+
+    // The sparse keys stay in the hash set.
+    State sparse_state;
+    for (int32_t i = 0; i < 10000; i++) {
+        sparse_state.update(i * 200003);
+    }
+    ASSERT_TRUE(sparse_state.bitmap == nullptr);
+    ASSERT_EQ(10000, sparse_state.disctint_count());
+}
+
 TEST_F(AggregateTest, test_dict_merge) {
     const AggregateFunction* func = get_aggregate_function("dict_merge", TYPE_ARRAY, TYPE_VARCHAR, false);
     ColumnBuilder<TYPE_VARCHAR> builder(config::vector_chunk_size);
@@ -731,6 +769,40 @@ TEST_F(AggregateTest, test_sum_nullable) {
     ASSERT_EQ(4950, result_data.get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_sum_remove_sliding_frame) {
+    using NullableSumInt64 = NullableAggregateFunctionState<SumAggregateState<int64_t>>;
+    const AggregateFunction* sum_null = get_aggregate_function("sum", TYPE_INT, TYPE_BIGINT, true);
+    ASSERT_TRUE(sum_null->is_removable());
+    ASSERT_FALSE(get_aggregate_function("sum", TYPE_DOUBLE, TYPE_DOUBLE, true)->is_removable());
+    std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(sum_null);
+
+    auto data_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    for (int i = 0; i < 100; i++) {
+        data_column->append(i);
+        null_column->append(i % 2 ? 1 : 0);
+    }
+    auto column = NullableColumn::create(std::move(data_column), std::move(null_column));
+    const Column* row_column = column.get();
+
+    // Slide the frame [0, 10) by 5 rows to [5, 15).
+    sum_null->update_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 100, 0, 10);
+    sum_null->update_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 100, 10, 15);
+    sum_null->remove_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 5);
+    auto* null_state = (NullableSumInt64*)state->mutable_data();
+    ASSERT_FALSE(null_state->is_null);
+    ASSERT_EQ(6 + 8 + 10 + 12 + 14, *reinterpret_cast<const int64_t*>(null_state->nested_state()));
+
+    const AggregateFunction* count = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true);
+    ASSERT_TRUE(count->is_removable());
+    std::unique_ptr<ManagedAggregateState> count_state = ManagedAggregateState::Make(count);
+    count->update_batch_single_state(ctx, count_state->mutable_data(), &row_column, 0, 100, 0, 15);
+    count->remove_batch_single_state(ctx, count_state->mutable_data(), &row_column, 0, 5);
+    auto result_column = Int64Column::create();
+    count->finalize_to_column(ctx, count_state->data(), result_column.get());
+    ASSERT_EQ(5, result_column->get_data()[0]);
+}
+
 TEST_F(AggregateTest, test_count_nullable) {
     const AggregateFunction* func = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true);
     std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
@@ -779,6 +851,55 @@ TEST_F(AggregateTest, test_bitmap_nullable) {
     ASSERT_EQ(50, result_data.get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_window_funnel) {
+    const AggregateFunction* func = get_aggregate_function("window_funnel", TYPE_DATETIME, TYPE_INT, false);
+
+    // Each row is (time, [view, cart, pay]), the rows are not in time order.
+    auto make_columns = [](const std::vector<std::pair<TimestampValue, std::vector<uint8_t>>>& rows) {
+        auto window = ColumnHelper::create_const_column<TYPE_BIGINT>(3600, rows.size());
+        auto times = TimestampColumn::create();
+        auto conditions = BooleanColumn::create();
+        auto offsets = UInt32Column::create();
+        offsets->append(0);
+        for (const auto& [time, conds] : rows) {
+            times->append(time);
+            for (uint8_t cond : conds) {
+                conditions->append(cond);
+            }
+            offsets->append(conditions->size());
+        }
+        return Columns{window, times, ArrayColumn::create(conditions, offsets)};
+    };
+
+    auto columns1 = make_columns({{TimestampValue::create(2022, 1, 1, 10, 20, 0), {0, 1, 0}},
+                                  {TimestampValue::create(2022, 1, 1, 10, 0, 0), {1, 0, 0}},
+                                  {TimestampValue::create(2022, 1, 1, 11, 30, 0), {0, 0, 1}}});
+    auto columns2 = make_columns({{TimestampValue::create(2022, 1, 1, 11, 20, 0), {0, 1, 0}},
+                                  {TimestampValue::create(2022, 1, 1, 11, 10, 0), {1, 0, 0}},
+                                  {TimestampValue::create(2022, 1, 1, 11, 15, 0), {0, 0, 0}}});
+    std::vector<const Column*> raw_columns1{columns1[0].get(), columns1[1].get(), columns1[2].get()};
+    std::vector<const Column*> raw_columns2{columns2[0].get(), columns2[1].get(), columns2[2].get()};
+
+    std::unique_ptr<ManagedAggregateState> state1 = ManagedAggregateState::Make(func);
+    std::unique_ptr<ManagedAggregateState> state2 = ManagedAggregateState::Make(func);
+    func->update_batch_single_state(ctx, 3, raw_columns1.data(), state1->mutable_data());
+    for (size_t i = 0; i < 3; i++) {
+        func->update(ctx, raw_columns2.data(), state2->mutable_data(), i);
+    }
+
+    // The pay is more than one hour after the first view.
+    auto result_column = Int32Column::create();
+    func->finalize_to_column(ctx, state1->data(), result_column.get());
+    ASSERT_EQ(2, result_column->get_data()[0]);
+
+    // The second view starts a chain that reaches the pay within one hour.
+    auto serialized_column = BinaryColumn::create();
+    func->serialize_to_column(ctx, state2->data(), serialized_column.get());
+    func->merge(ctx, serialized_column.get(), state1->mutable_data(), 0);
+    func->finalize_to_column(ctx, state1->data(), result_column.get());
+    ASSERT_EQ(3, result_column->get_data()[1]);
+}
+
 TEST_F(AggregateTest, test_group_concat) {
     const AggregateFunction* group_concat_function =
             get_aggregate_function("group_concat", TYPE_VARCHAR, TYPE_VARCHAR, false);
@@ -803,12 +924,55 @@ TEST_F(AggregateTest, test_group_concat) {
     ASSERT_EQ("starrocks0, starrocks1, starrocks2, starrocks3, starrocks4, starrocks5", result_column->get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_group_concat_merge_blocks) {
+    const AggregateFunction* group_concat_function =
+            get_aggregate_function("group_concat", TYPE_VARCHAR, TYPE_VARCHAR, false);
+    std::unique_ptr<ManagedAggregateState> state1 = ManagedAggregateState::Make(group_concat_function);
+    std::unique_ptr<ManagedAggregateState> state2 = ManagedAggregateState::Make(group_concat_function);
+
+    // The rows are updated one by one, so the state spans many blocks.
+    auto data_column = BinaryColumn::create();
+    std::string expected;
+    for (int i = 0; i < 2000; i++) {
+        std::string val(i % 97, 'a' + i % 26);
+        val.append(std::to_string(i));
+        data_column->append(val);
+        expected.append(i == 0 ? "" : ", ").append(val);
+    }
+    const Column* row_column = data_column.get();
+    for (size_t i = 0; i < 1000; i++) {
+        group_concat_function->update(ctx, &row_column, state1->mutable_data(), i);
+    }
+    for (size_t i = 1000; i < data_column->size(); i++) {
+        group_concat_function->update(ctx, &row_column, state2->mutable_data(), i);
+    }
+
+    auto serialized_column = BinaryColumn::create();
+    group_concat_function->serialize_to_column(ctx, state2->data(), serialized_column.get());
+    group_concat_function->merge(ctx, serialized_column.get(), state1->mutable_data(), 0);
+
+    auto result_column = BinaryColumn::create();
+    group_concat_function->finalize_to_column(ctx, state1->data(), result_column.get());
+    ASSERT_EQ(expected, result_column->get_slice(0).to_string());
+
+    // The blocks are reused after reset.
+    group_concat_function->reset(ctx, {}, state1->mutable_data());
+    group_concat_function->update(ctx, &row_column, state1->mutable_data(), 1);
+    group_concat_function->update(ctx, &row_column, state1->mutable_data(), 2);
+    group_concat_function->finalize_to_column(ctx, state1->data(), result_column.get());
+    ASSERT_EQ(data_column->get_slice(1).to_string() + ", " + data_column->get_slice(2).to_string(),
+              result_column->get_slice(1).to_string());
+}
+
 TEST_F(AggregateTest, test_group_concat_const_seperator) {
     std::vector<FunctionContext::TypeDesc> arg_types = {
             AnyValUtil::column_type_to_type_desc(TypeDescriptor::from_primtive_type(TYPE_VARCHAR)),
             AnyValUtil::column_type_to_type_desc(TypeDescriptor::from_primtive_type(TYPE_VARCHAR))};
 
-    std::unique_ptr<FunctionContext> local_ctx(FunctionContext::create_test_context(std::move(arg_types)));
+    // The state of group_concat is allocated from the mem pool of the context.
+    MemPool mem_pool;
+    std::unique_ptr<FunctionContext> local_ctx(
+            FunctionContextImpl::create_context(nullptr, &mem_pool, FunctionContext::TypeDesc{}, arg_types, 0, false));
 
     const AggregateFunction* group_concat_function =
             get_aggregate_function("group_concat", TYPE_VARCHAR, TYPE_VARCHAR, false);
@@ -3007,4 +3007,75 @@ TEST_F(ArrayFunctionsTest, array_join_only_null) {
     ASSERT_TRUE(dest_column->get(2).is_null());
 }
 
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_distinct_int) {
+    // the large arrays are deduplicated by the hash set, the small ones linearly
+    DatumArray large_array;
+    for (int i = 0; i < 40; i++) {
+        large_array.emplace_back(i % 10);
+    }
+    large_array.emplace_back(Datum());
+    large_array.emplace_back(Datum());
+
+    auto src_column = ColumnHelper::create_column(TYPE_ARRAY_INT, true);
+    src_column->append_datum(DatumArray{5, 3, 5, Datum(), 3, Datum()});
+    src_column->append_datum(Datum());
+    src_column->append_datum(large_array);
+    src_column->append_datum(DatumArray{});
+
+    auto dest_column = ArrayDistinct<PrimitiveType::TYPE_INT>::process(nullptr, {src_column});
+
+    ASSERT_EQ(dest_column->size(), 4);
+    _check_array_nullable<int32_t>({5, 3, 0}, {0, 0, 1}, dest_column->get(0).get_array());
+    ASSERT_TRUE(dest_column->get(1).is_null());
+    _check_array_nullable<int32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+                                   dest_column->get(2).get_array());
+    ASSERT_TRUE(dest_column->get(3).get_array().empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_distinct_string) {
+    auto src_column = ColumnHelper::create_column(TYPE_ARRAY_VARCHAR, false);
+    src_column->append_datum(DatumArray{"a", "bb", "a", "ccc", "bb"});
+    src_column->append_datum(DatumArray{"x", "x"});
+
+    auto dest_column = ArrayDistinct<PrimitiveType::TYPE_VARCHAR>::process(nullptr, {src_column});
+
+    ASSERT_EQ(dest_column->size(), 2);
+    _check_array<Slice>({"a", "bb", "ccc"}, dest_column->get(0).get_array());
+    _check_array<Slice>({"x"}, dest_column->get(1).get_array());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_sort_int) {
+    auto src_column = ColumnHelper::create_column(TYPE_ARRAY_INT, true);
+    src_column->append_datum(DatumArray{5, 3, 6});
+    src_column->append_datum(Datum());
+    src_column->append_datum(DatumArray{8, 2, 7, 2});
+    src_column->append_datum(DatumArray{});
+
+    auto dest_column = ArraySort<PrimitiveType::TYPE_INT>::process(nullptr, {src_column});
+
+    ASSERT_EQ(dest_column->size(), 4);
+    _check_array<int32_t>({3, 5, 6}, dest_column->get(0).get_array());
+    ASSERT_TRUE(dest_column->get(1).is_null());
+    _check_array<int32_t>({2, 2, 7, 8}, dest_column->get(2).get_array());
+    ASSERT_TRUE(dest_column->get(3).get_array().empty());
+    // the source is left unsorted
+    _check_array<int32_t>({5, 3, 6}, src_column->get(0).get_array());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_sort_nullable_elements) {
+    auto src_column = ColumnHelper::create_column(TYPE_ARRAY_INT, true);
+    src_column->append_datum(DatumArray{5, Datum(), 3, 6});
+    src_column->append_datum(DatumArray{4, 1});
+
+    auto dest_column = ArraySort<PrimitiveType::TYPE_INT>::process(nullptr, {src_column});
+
+    ASSERT_EQ(dest_column->size(), 2);
+    _check_array_nullable<int32_t>({0, 3, 5, 6}, {1, 0, 0, 0}, dest_column->get(0).get_array());
+    _check_array<int32_t>({1, 4}, dest_column->get(1).get_array());
+}
+
 } // namespace starrocks::vectorized
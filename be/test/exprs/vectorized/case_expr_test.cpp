@@ -12,6 +12,7 @@
 #include "column/column_viewer.h"
 #include "column/fixed_length_column.h"
 #include "common/object_pool.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 #include "runtime/mem_pool.h"
 #include "runtime/primitive_type.h"
@@ -553,5 +554,102 @@ TEST_F(VectorizedCaseExprTest, NoCaseWhenNullReturnIntElse) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorizedCaseExprTest, NoCaseEvaluateBranchesOnSelectedRows) {
+    expr_node.child_type = TPrimitiveType::INT;
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    expr_node.case_expr.has_case_expr = false;
+    expr_node.case_expr.has_else_expr = true;
+
+    std::unique_ptr<Expr> expr(VectorizedCaseExprFactory::from_thrift(expr_node));
+
+    // CASE WHEN s2 THEN s1 * 10 WHEN s3 THEN s1 * 100 ELSE s1 * -1 END
+    ColumnRef when1(TypeDescriptor(TYPE_BOOLEAN), 2, false);
+    MockTimesSlotExpr then1(expr_node, 1, 10);
+    ColumnRef when2(TypeDescriptor(TYPE_BOOLEAN), 3, false);
+    MockTimesSlotExpr then2(expr_node, 1, 100);
+    MockTimesSlotExpr else1(expr_node, 1, -1);
+    expr->_children.push_back(&when1);
+    expr->_children.push_back(&then1);
+    expr->_children.push_back(&when2);
+    expr->_children.push_back(&then2);
+    expr->_children.push_back(&else1);
+    ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FRAGMENT_LOCAL).ok());
+
+    Chunk chunk;
+    auto values = Int32Column::create();
+    auto by_four = BooleanColumn::create();
+    auto by_two = BooleanColumn::create();
+    for (int32_t i = 0; i < 100; ++i) {
+        values->append(i);
+        by_four->append(i % 4 == 0);
+        by_two->append(i % 2 == 0);
+    }
+    chunk.append_column(std::move(values), 1);
+    chunk.append_column(std::move(by_four), 2);
+    chunk.append_column(std::move(by_two), 3);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+    ASSERT_EQ(100, ptr->size());
+    auto v = ColumnHelper::cast_to_raw<TYPE_INT>(ColumnHelper::get_data_column(ptr.get()));
+    for (int32_t i = 0; i < 100; ++i) {
+        ASSERT_FALSE(ptr->is_null(i));
+        int32_t expected = i % 4 == 0 ? i * 10 : (i % 2 == 0 ? i * 100 : -i);
+        ASSERT_EQ(expected, v->get_data()[i]);
+    }
+    // each branch only sees the rows it's selected for
+    ASSERT_EQ(std::vector<size_t>{25}, then1.rows);
+    ASSERT_EQ(std::vector<size_t>{25}, then2.rows);
+    ASSERT_EQ(std::vector<size_t>{50}, else1.rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorizedCaseExprTest, NoCaseConstThens) {
+    expr_node.child_type = TPrimitiveType::INT;
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    expr_node.case_expr.has_case_expr = false;
+    expr_node.case_expr.has_else_expr = false;
+
+    std::unique_ptr<Expr> expr(VectorizedCaseExprFactory::from_thrift(expr_node));
+
+    // CASE WHEN s2 THEN 10 WHEN s3 THEN 20 END, s3 has nulls
+    ColumnRef when1(TypeDescriptor(TYPE_BOOLEAN), 2, false);
+    MockConstVectorizedExpr<TYPE_INT> then1(expr_node, 10);
+    ColumnRef when2(TypeDescriptor(TYPE_BOOLEAN), 3, true);
+    MockConstVectorizedExpr<TYPE_INT> then2(expr_node, 20);
+    expr->_children.push_back(&when1);
+    expr->_children.push_back(&then1);
+    expr->_children.push_back(&when2);
+    expr->_children.push_back(&then2);
+
+    Chunk chunk;
+    auto by_four = BooleanColumn::create();
+    auto by_two = BooleanColumn::create();
+    auto nulls = NullColumn::create();
+    for (int32_t i = 0; i < 100; ++i) {
+        by_four->append(i % 4 == 0);
+        by_two->append(i % 2 == 0);
+        nulls->append(i % 3 == 0);
+    }
+    chunk.append_column(std::move(by_four), 2);
+    chunk.append_column(NullableColumn::create(std::move(by_two), std::move(nulls)), 3);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+    ASSERT_EQ(100, ptr->size());
+    ASSERT_TRUE(ptr->is_nullable());
+    auto v = ColumnHelper::cast_to_raw<TYPE_INT>(ColumnHelper::get_data_column(ptr.get()));
+    for (int32_t i = 0; i < 100; ++i) {
+        if (i % 4 == 0) {
+            ASSERT_FALSE(ptr->is_null(i));
+            ASSERT_EQ(10, v->get_data()[i]);
+        } else if (i % 2 == 0 && i % 3 != 0) {
+            ASSERT_FALSE(ptr->is_null(i));
+            ASSERT_EQ(20, v->get_data()[i]);
+        } else {
+            ASSERT_TRUE(ptr->is_null(i));
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
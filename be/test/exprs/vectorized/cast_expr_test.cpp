@@ -4,6 +4,7 @@
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <ryu/ryu.h>
 
 #include "butil/time.h"
 #include "column/fixed_length_column.h"
@@ -11,6 +12,7 @@
 #include "exprs/vectorized/mock_vectorized_expr.h"
 #include "gen_cpp/Exprs_types.h"
 #include "gen_cpp/Types_types.h"
+#include "runtime/large_int_value.h"
 #include "runtime/primitive_type.h"
 #include "runtime/vectorized/time_types.h"
 #include "util/json.h"
@@ -540,6 +542,83 @@ TEST_F(VectorizedCastExprTest, intCastString) {
     }
 }
 
+TEST_F(VectorizedCastExprTest, largeIntCastString) {
+    expr_node.child_type = TPrimitiveType::LARGEINT;
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+    expr_node.type.types[0].scalar_type.__set_len(64);
+
+    std::unique_ptr<Expr> expr(VectorizedCastExprFactory::from_thrift(expr_node));
+
+    MockVectorizedExpr<TYPE_LARGEINT> col1(expr_node, 10, MIN_INT128);
+
+    expr->_children.push_back(&col1);
+
+    {
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+
+        ASSERT_TRUE(ptr->is_binary());
+
+        auto v = std::static_pointer_cast<BinaryColumn>(ptr);
+        ASSERT_EQ(10, v->size());
+
+        for (int j = 0; j < v->size(); ++j) {
+            ASSERT_EQ(std::string("-170141183460469231731687303715884105728"), v->get_data()[j]);
+        }
+    }
+}
+
+TEST_F(VectorizedCastExprTest, dateCastString) {
+    expr_node.child_type = TPrimitiveType::DATE;
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+    expr_node.type.types[0].scalar_type.__set_len(10);
+
+    std::unique_ptr<Expr> expr(VectorizedCastExprFactory::from_thrift(expr_node));
+
+    MockVectorizedExpr<TYPE_DATE> col1(expr_node, 10, DateValue::create(2020, 2, 3));
+
+    expr->_children.push_back(&col1);
+
+    {
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+
+        ASSERT_TRUE(ptr->is_binary());
+
+        auto v = std::static_pointer_cast<BinaryColumn>(ptr);
+        ASSERT_EQ(10, v->size());
+
+        for (int j = 0; j < v->size(); ++j) {
+            ASSERT_EQ(std::string("2020-02-03"), v->get_data()[j]);
+        }
+    }
+}
+
+TEST_F(VectorizedCastExprTest, doubleCastString) {
+    expr_node.child_type = TPrimitiveType::DOUBLE;
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+    expr_node.type.types[0].scalar_type.__set_len(-1);
+
+    std::unique_ptr<Expr> expr(VectorizedCastExprFactory::from_thrift(expr_node));
+
+    MockVectorizedExpr<TYPE_DOUBLE> col1(expr_node, 10, 1234.5678);
+
+    expr->_children.push_back(&col1);
+
+    char buf[32];
+    std::string expect(buf, d2s_buffered_n(1234.5678, buf));
+    {
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+
+        ASSERT_TRUE(ptr->is_binary());
+
+        auto v = std::static_pointer_cast<BinaryColumn>(ptr);
+        ASSERT_EQ(10, v->size());
+
+        for (int j = 0; j < v->size(); ++j) {
+            ASSERT_EQ(expect, v->get_data()[j]);
+        }
+    }
+}
+
 TEST_F(VectorizedCastExprTest, booleanCastString) {
     expr_node.child_type = TPrimitiveType::BOOLEAN;
     expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
@@ -0,0 +1,78 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exprs/vectorized/common_expr_eliminator.h"
+
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+#include "exprs/expr_context.h"
+#include "exprs/vectorized/arithmetic_expr.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/mock_vectorized_expr.h"
+
+namespace starrocks {
+namespace vectorized {
+
+class CommonExprEliminatorTest : public ::testing::Test {
+protected:
+    Expr* slot(SlotId slot_id) { return _pool.add(new ColumnRef(TypeDescriptor(TYPE_INT), slot_id, false)); }
+
+    Expr* arithmetic(TExprOpcode::type op, Expr* lhs, Expr* rhs) {
+        TExprNode node;
+        node.node_type = TExprNodeType::ARITHMETIC_EXPR;
+        node.opcode = op;
+        node.child_type = TPrimitiveType::INT;
+        node.num_children = 2;
+        node.__isset.opcode = true;
+        node.__isset.child_type = true;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        Expr* expr = _pool.add(VectorizedArithmeticExprFactory::from_thrift(node));
+        expr->add_child(lhs);
+        expr->add_child(rhs);
+        return expr;
+    }
+
+    ObjectPool _pool;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CommonExprEliminatorTest, equals) {
+    ASSERT_TRUE(CommonExprEliminator::equals(arithmetic(TExprOpcode::ADD, slot(1), slot(2)),
+                                             arithmetic(TExprOpcode::ADD, slot(1), slot(2))));
+    ASSERT_FALSE(CommonExprEliminator::equals(arithmetic(TExprOpcode::ADD, slot(1), slot(2)),
+                                              arithmetic(TExprOpcode::ADD, slot(2), slot(1))));
+    ASSERT_FALSE(CommonExprEliminator::equals(arithmetic(TExprOpcode::ADD, slot(1), slot(2)),
+                                              arithmetic(TExprOpcode::SUBTRACT, slot(1), slot(2))));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CommonExprEliminatorTest, eliminate) {
+    // ((s1 + s2) * s3) and ((s1 + s2) * s3 - (s1 + s2)) and (s1 + s2)
+    Expr* root1 = arithmetic(TExprOpcode::MULTIPLY, arithmetic(TExprOpcode::ADD, slot(1), slot(2)), slot(3));
+    Expr* root2 = arithmetic(TExprOpcode::SUBTRACT,
+                             arithmetic(TExprOpcode::MULTIPLY, arithmetic(TExprOpcode::ADD, slot(1), slot(2)), slot(3)),
+                             arithmetic(TExprOpcode::ADD, slot(1), slot(2)));
+    Expr* root3 = arithmetic(TExprOpcode::ADD, slot(1), slot(2));
+    std::vector<ExprContext*> ctxs{_pool.add(new ExprContext(root1)), _pool.add(new ExprContext(root2)),
+                                   _pool.add(new ExprContext(root3))};
+
+    std::vector<ExprContext*> common_ctxs;
+    std::vector<SlotId> common_slot_ids;
+    int saved = CommonExprEliminator::eliminate(&_pool, ctxs, 10, &common_ctxs, &common_slot_ids);
+    // s1 + s2 is evaluated once instead of three times, (s1 + s2) * s3 is a root of ctxs[0] and kept
+    ASSERT_EQ(2, saved);
+    ASSERT_EQ(1, common_ctxs.size());
+    ASSERT_EQ(std::vector<SlotId>{10}, common_slot_ids);
+    ASSERT_EQ(TExprOpcode::ADD, common_ctxs[0]->root()->op());
+
+    ASSERT_EQ(root1, ctxs[0]->root());
+    ASSERT_EQ(root2, ctxs[1]->root());
+    ASSERT_EQ(root3, ctxs[2]->root());
+    for (Expr* ref : {root1->get_child(0), root2->get_child(0)->get_child(0), root2->get_child(1)}) {
+        ASSERT_TRUE(ref->is_slotref());
+        ASSERT_EQ(10, down_cast<ColumnRef*>(ref)->slot_id());
+    }
+}
+
+} // namespace vectorized
+} // namespace starrocks
@@ -12,6 +12,7 @@
 #include "column/fixed_length_column.h"
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 #include "gen_cpp/Exprs_types.h"
 #include "gutil/casts.h"
@@ -318,5 +319,41 @@ TEST_F(VectorizedConditionExprTest, ifExpr) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorizedConditionExprTest, ifExprEvaluateBranchesOnSelectedRows) {
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    auto expr = std::unique_ptr<Expr>(VectorizedConditionExprFactory::create_if_expr(expr_node));
+
+    // IF(s2, s1 * 10, s1 * -1)
+    ColumnRef cond(TypeDescriptor(TYPE_BOOLEAN), 2, true);
+    MockTimesSlotExpr lhs(expr_node, 1, 10);
+    MockTimesSlotExpr rhs(expr_node, 1, -1);
+    expr->_children.push_back(&cond);
+    expr->_children.push_back(&lhs);
+    expr->_children.push_back(&rhs);
+
+    Chunk chunk;
+    auto values = Int32Column::create();
+    auto by_four = BooleanColumn::create();
+    auto nulls = NullColumn::create();
+    for (int32_t i = 0; i < 100; ++i) {
+        values->append(i);
+        by_four->append(i % 4 == 0);
+        nulls->append(i % 8 == 0);
+    }
+    chunk.append_column(std::move(values), 1);
+    chunk.append_column(NullableColumn::create(std::move(by_four), std::move(nulls)), 2);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+    ASSERT_EQ(100, ptr->size());
+    auto v = ColumnHelper::cast_to_raw<TYPE_INT>(ColumnHelper::get_data_column(ptr.get()));
+    for (int32_t i = 0; i < 100; ++i) {
+        // the null condition is false
+        ASSERT_EQ(i % 4 == 0 && i % 8 != 0 ? i * 10 : -i, v->get_data()[i]);
+    }
+    ASSERT_EQ(std::vector<size_t>{12}, lhs.rows);
+    ASSERT_EQ(std::vector<size_t>{88}, rhs.rows);
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -2652,4 +2652,38 @@ TEST_F(DecimalBinaryFunctionTest, test_decimal128p38s14_div_decimal128p38s14_eq_
     test_vector_vector_assert_overflow<TYPE_DECIMAL128, DivOp, true>(test_case_array, 38, 14, 38, 14, 38, 14,
                                                                      overflows);
 }
-} // namespace starrocks::vectorized
\ No newline at end of file
+
+// The rows not overflowing keep their results when the batch of DECIMAL128 add/sub overflows.
+TEST_F(DecimalBinaryFunctionTest, test_decimal128p38s0_add_sub_overflow_rows) {
+    DecimalOverflowTestCaseArray add_cases = {{"1", "2", "3", false},
+                                              {"99999999999999999999999999999999999999",
+                                               "99999999999999999999999999999999999999", "0", true},
+                                              {"-5", "3", "-2", false},
+                                              {"-99999999999999999999999999999999999999",
+                                               "-99999999999999999999999999999999999999", "0", true},
+                                              {"99999999999999999999999999999999999999",
+                                               "-99999999999999999999999999999999999999", "0", false}};
+    DecimalOverflowTestCaseArray sub_cases = {{"1", "2", "-1", false},
+                                              {"99999999999999999999999999999999999999",
+                                               "-99999999999999999999999999999999999999", "0", true},
+                                              {"-99999999999999999999999999999999999999",
+                                               "-99999999999999999999999999999999999999", "0", false},
+                                              {"-99999999999999999999999999999999999999",
+                                               "99999999999999999999999999999999999999", "0", true}};
+    for (auto* test_cases : {&add_cases, &sub_cases}) {
+        DecimalTestCaseArray test_case_array;
+        std::vector<bool> overflows;
+        for (auto& tc : *test_cases) {
+            test_case_array.emplace_back(std::get<0>(tc), std::get<1>(tc), std::get<2>(tc));
+            overflows.emplace_back(std::get<3>(tc));
+        }
+        if (test_cases == &add_cases) {
+            test_vector_vector_assert_overflow<TYPE_DECIMAL128, AddOp, true>(test_case_array, 38, 0, 38, 0, 38, 0,
+                                                                             overflows);
+        } else {
+            test_vector_vector_assert_overflow<TYPE_DECIMAL128, SubOp, true>(test_case_array, 38, 0, 38, 0, 38, 0,
+                                                                             overflows);
+        }
+    }
+}
+} // namespace starrocks::vectorized
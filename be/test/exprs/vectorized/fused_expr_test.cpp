@@ -0,0 +1,154 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exprs/vectorized/fused_expr.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/object_pool.h"
+#include "exprs/expr_context.h"
+#include "exprs/vectorized/arithmetic_expr.h"
+#include "exprs/vectorized/binary_predicate.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/compound_predicate.h"
+#include "exprs/vectorized/literal.h"
+#include "exprs/vectorized/mock_vectorized_expr.h"
+
+namespace starrocks {
+namespace vectorized {
+
+class FusedExprTest : public ::testing::Test {
+protected:
+    Expr* slot(SlotId slot_id) { return _pool.add(new ColumnRef(TypeDescriptor(TYPE_INT), slot_id, true)); }
+
+    Expr* literal(int32_t value) {
+        TExprNode node;
+        node.node_type = TExprNodeType::INT_LITERAL;
+        node.num_children = 0;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        TIntLiteral int_literal;
+        int_literal.value = value;
+        node.__set_int_literal(int_literal);
+        return _pool.add(new VectorizedLiteral(node));
+    }
+
+    Expr* arithmetic(TExprOpcode::type op, Expr* lhs, Expr* rhs) {
+        TExprNode node = make_node(TExprNodeType::ARITHMETIC_EXPR, op, TPrimitiveType::INT, TPrimitiveType::INT);
+        return add_children(VectorizedArithmeticExprFactory::from_thrift(node), lhs, rhs);
+    }
+
+    Expr* compare(TExprOpcode::type op, Expr* lhs, Expr* rhs) {
+        TExprNode node = make_node(TExprNodeType::BINARY_PRED, op, TPrimitiveType::BOOLEAN, TPrimitiveType::INT);
+        return add_children(VectorizedBinaryPredicateFactory::from_thrift(node), lhs, rhs);
+    }
+
+    Expr* compound(TExprOpcode::type op, Expr* lhs, Expr* rhs) {
+        TExprNode node =
+                make_node(TExprNodeType::COMPOUND_PRED, op, TPrimitiveType::BOOLEAN, TPrimitiveType::BOOLEAN);
+        return add_children(VectorizedCompoundPredicateFactory::from_thrift(node), lhs, rhs);
+    }
+
+    static TExprNode make_node(TExprNodeType::type node_type, TExprOpcode::type op, TPrimitiveType::type type,
+                               TPrimitiveType::type child_type) {
+        TExprNode node;
+        node.node_type = node_type;
+        node.opcode = op;
+        node.child_type = child_type;
+        node.num_children = 2;
+        node.__isset.opcode = true;
+        node.__isset.child_type = true;
+        node.type = gen_type_desc(type);
+        return node;
+    }
+
+    Expr* add_children(Expr* expr, Expr* lhs, Expr* rhs) {
+        _pool.add(expr);
+        expr->add_child(lhs);
+        expr->add_child(rhs);
+        return expr;
+    }
+
+    ChunkPtr make_chunk(size_t num_rows) {
+        auto chunk = std::make_shared<Chunk>();
+        for (SlotId slot_id = 1; slot_id <= 3; slot_id++) {
+            auto column = Int32Column::create();
+            for (size_t i = 0; i < num_rows; i++) {
+                column->append(static_cast<int32_t>(i * slot_id % 97) - 40);
+            }
+            chunk->append_column(std::move(column), slot_id);
+        }
+        return chunk;
+    }
+
+    ObjectPool _pool;
+};
+
+// NOLINTNEXTLINE
+TEST_F(FusedExprTest, evaluate) {
+    // (s1 + s2) * s3 > 10 AND s1 - 3 < s3 OR s2 = 7
+    Expr* expr = compound(
+            TExprOpcode::COMPOUND_OR,
+            compound(TExprOpcode::COMPOUND_AND,
+                     compare(TExprOpcode::GT,
+                             arithmetic(TExprOpcode::MULTIPLY, arithmetic(TExprOpcode::ADD, slot(1), slot(2)), slot(3)),
+                             literal(10)),
+                     compare(TExprOpcode::LT, arithmetic(TExprOpcode::SUBTRACT, slot(1), literal(3)), slot(3))),
+            compare(TExprOpcode::EQ, slot(2), literal(7)));
+    Expr* fused = FusedExpr::create(&_pool, expr);
+    ASSERT_TRUE(fused != nullptr);
+
+    // more rows than a batch, and a partial batch at the end
+    ChunkPtr chunk = make_chunk(FusedExpr::kBatchSize * 3 + 17);
+    ColumnPtr expected = expr->evaluate(nullptr, chunk.get());
+    ColumnPtr result = fused->evaluate(nullptr, chunk.get());
+    ASSERT_FALSE(result->is_nullable());
+    ASSERT_EQ(chunk->num_rows(), result->size());
+    for (size_t i = 0; i < chunk->num_rows(); i++) {
+        ASSERT_EQ(expected->debug_item(i), result->debug_item(i)) << i;
+    }
+
+    // the original tree is evaluated for the columns with nulls
+    auto data = Int32Column::create();
+    auto null_data = NullColumn::create();
+    for (size_t i = 0; i < chunk->num_rows(); i++) {
+        data->append(static_cast<int32_t>(i));
+        null_data->append(i % 5 == 0);
+    }
+    chunk->update_column(NullableColumn::create(std::move(data), std::move(null_data)), 1);
+    result = fused->evaluate(nullptr, chunk.get());
+    ASSERT_TRUE(result->is_nullable());
+    ASSERT_TRUE(result->is_null(0));
+}
+
+// NOLINTNEXTLINE
+TEST_F(FusedExprTest, fuse) {
+    // a single operator is not fused
+    ASSERT_TRUE(FusedExpr::create(&_pool, arithmetic(TExprOpcode::ADD, slot(1), slot(2))) == nullptr);
+    // DIVIDE is not fused
+    TExprNode node = make_node(TExprNodeType::ARITHMETIC_EXPR, TExprOpcode::DIVIDE, TPrimitiveType::INT,
+                               TPrimitiveType::INT);
+    ASSERT_TRUE(FusedExpr::create(&_pool, add_children(VectorizedArithmeticExprFactory::from_thrift(node),
+                                                       arithmetic(TExprOpcode::ADD, slot(1), slot(2)), slot(3))) ==
+                nullptr);
+
+    Expr* root = compare(TExprOpcode::GT, arithmetic(TExprOpcode::ADD, slot(1), slot(2)), slot(3));
+    // only the subtree under DIVIDE is fused
+    Expr* inner = arithmetic(TExprOpcode::MULTIPLY, arithmetic(TExprOpcode::ADD, slot(1), slot(2)), slot(3));
+    Expr* div = add_children(VectorizedArithmeticExprFactory::from_thrift(node), inner, slot(1));
+    std::vector<ExprContext*> ctxs{_pool.add(new ExprContext(root)), _pool.add(new ExprContext(div)),
+                                   _pool.add(new ExprContext(slot(1)))};
+    ExprContext* div_ctx = ctxs[1];
+    ExprContext* slot_ctx = ctxs[2];
+    ASSERT_EQ(2, FusedExpr::fuse(&_pool, &ctxs));
+    // the root is fused into a new context
+    ASSERT_NE(root, ctxs[0]->root());
+    ASSERT_EQ(root, ctxs[0]->root()->get_child(0));
+    ASSERT_EQ(div_ctx, ctxs[1]);
+    ASSERT_EQ(inner, div->get_child(0)->get_child(0));
+    ASSERT_EQ(slot_ctx, ctxs[2]);
+}
+
+} // namespace vectorized
+} // namespace starrocks
@@ -449,5 +449,43 @@ TEST_F(geographyFunctionsTest, st_containsConstTest) {
     GeoFunctions::st_contains_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
 }
 
+TEST_F(geographyFunctionsTest, st_containsConstPolygonTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+
+    std::string polygon_wkt = "POLYGON ((10 10, 50 10, 50 50, 10 50, 10 10))";
+    auto polygon_column = BinaryColumn::create();
+    polygon_column->append(polygon_wkt);
+    columns.emplace_back(polygon_column);
+    ctx->impl()->set_constant_columns(columns);
+    GeoFunctions::st_from_wkt_prepare(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+    auto polygon = ConstColumn::create(GeoFunctions::st_from_wkt(ctx.get(), columns), 4);
+    GeoFunctions::st_from_wkt_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+
+    auto points = BinaryColumn::create();
+    for (auto [x, y] : std::vector<std::pair<double, double>>{{25, 25}, {60, 60}, {10.5, 49}}) {
+        GeoPoint point;
+        ASSERT_EQ(GEO_PARSE_OK, point.from_coord(x, y));
+        std::string buf;
+        point.encode_to(&buf);
+        points->append(buf);
+    }
+    // a point of a wrong size
+    points->append(std::string{0, static_cast<char>(GEO_SHAPE_POINT), 1, 2, 3});
+
+    columns.clear();
+    columns.emplace_back(polygon);
+    columns.emplace_back(points);
+    ctx->impl()->set_constant_columns(columns);
+    GeoFunctions::st_contains_prepare(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+    auto res = GeoFunctions::st_contains(ctx.get(), columns);
+    ASSERT_EQ(4, res->size());
+    ASSERT_TRUE(res->get(0).get_uint8());
+    ASSERT_FALSE(res->get(1).get_uint8());
+    ASSERT_TRUE(res->get(2).get_uint8());
+    ASSERT_TRUE(res->is_null(3));
+    GeoFunctions::st_contains_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+}
+
 } // namespace vectorized
 } // namespace starrocks
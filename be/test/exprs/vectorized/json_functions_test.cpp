@@ -140,6 +140,58 @@ TEST_F(JsonFunctionsTest, get_json_stringTest) {
                         .ok());
 }
 
+TEST_F(JsonFunctionsTest, get_json_intConstPathTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto ints = BinaryColumn::create();
+    std::string values[] = {R"({"k1":1, "k2":2})", R"({"k2":3, "k1":4})", R"({"k0":{}, "k1":5, "k3":[6]})"};
+    for (const auto& value : values) {
+        ints->append(value);
+    }
+    ColumnBuilder<TYPE_VARCHAR> path(1);
+    path.append("$.k1");
+    Columns columns{ints, path.build(true)};
+
+    ctx.get()->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+    ASSERT_NE(nullptr, ctx->get_function_state(FunctionContext::FunctionStateScope::FRAGMENT_LOCAL));
+
+    ColumnPtr result = JsonFunctions::get_json_int(ctx.get(), columns);
+    auto v = ColumnHelper::cast_to<TYPE_INT>(result);
+    ASSERT_EQ(3, v->size());
+    ASSERT_EQ(1, v->get_data()[0]);
+    ASSERT_EQ(4, v->get_data()[1]);
+    ASSERT_EQ(5, v->get_data()[2]);
+
+    ASSERT_TRUE(JsonFunctions::json_path_close(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+}
+
+TEST_F(JsonFunctionsTest, get_json_intRepeatedPathTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto ints = BinaryColumn::create();
+    auto paths = BinaryColumn::create();
+    std::string values[] = {R"({"k1":1, "k2":2})", R"({"k1":3, "k2":4})", R"({"k1":5, "k2":6})",
+                            R"({"k1":7, "k2":8})"};
+    // the path of a row is parsed only when it differs from the last row's
+    std::string strs[] = {"$.k1", "$.k1", "$.k2", "$.k1"};
+    int expected[] = {1, 3, 6, 7};
+    for (int j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+        ints->append(values[j]);
+        paths->append(strs[j]);
+    }
+    Columns columns{ints, paths};
+
+    ctx.get()->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+
+    ColumnPtr result = JsonFunctions::get_json_int(ctx.get(), columns);
+    auto v = ColumnHelper::cast_to<TYPE_INT>(result);
+    for (int j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+        ASSERT_EQ(expected[j], v->get_data()[j]);
+    }
+
+    ASSERT_TRUE(JsonFunctions::json_path_close(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+}
+
 TEST_F(JsonFunctionsTest, get_json_emptyTest) {
     {
         std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
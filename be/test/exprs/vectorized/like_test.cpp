@@ -471,5 +471,33 @@ TEST_F(LikeTest, rowsPatternRegex) {
                         .ok());
 }
 
+TEST_F(LikeTest, multiPatternMatcher) {
+    MultiPatternMatcher matcher;
+    ASSERT_TRUE(matcher.init({"%abc%", "x_z", "50\\%"}, {"^[0-9]+$"}).ok());
+
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    std::vector<std::string> values{"11abc22", "xyz", "xyyz", "50%", "50x", "123", "12a", "", "abc"};
+    for (const auto& value : values) {
+        str->append(value);
+        null->append(0);
+    }
+    str->append("abc");
+    null->append(1);
+
+    auto result = matcher.match(NullableColumn::create(str, null));
+    ASSERT_EQ(values.size() + 1, result->size());
+    auto v = ColumnHelper::cast_to<TYPE_BOOLEAN>(ColumnHelper::as_column<NullableColumn>(result)->data_column());
+    std::vector<bool> expected{true, true, false, true, false, true, false, false, true};
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_FALSE(result->is_null(i));
+        ASSERT_EQ(expected[i], v->get_data()[i] != 0) << values[i];
+    }
+    ASSERT_TRUE(result->is_null(values.size()));
+
+    MultiPatternMatcher invalid;
+    ASSERT_FALSE(invalid.init({"%a%"}, {"(a"}).ok());
+}
+
 } // namespace vectorized
 } // namespace starrocks
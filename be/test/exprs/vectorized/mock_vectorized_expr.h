@@ -8,6 +8,7 @@
 #pragma once
 
 #include "butil/time.h"
+#include "column/chunk.h"
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/const_column.h"
@@ -186,5 +187,35 @@ public:
     ColumnPtr col;
 };
 
+// returns `factor` times the INT column of a slot, and records the rows of the chunks it's evaluated on
+class MockTimesSlotExpr : public Expr {
+public:
+    MockTimesSlotExpr(const TExprNode& t, SlotId slot_id, int32_t factor)
+            : Expr(t), slot_id(slot_id), factor(factor) {}
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new MockTimesSlotExpr(*this)); }
+
+    bool is_constant() const override { return false; }
+
+    int get_slot_ids(std::vector<SlotId>* slot_ids) const override {
+        slot_ids->emplace_back(slot_id);
+        return 1;
+    }
+
+    ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        rows.emplace_back(ptr->num_rows());
+        auto* input = down_cast<Int32Column*>(ptr->get_column_by_slot_id(slot_id).get());
+        auto result = Int32Column::create();
+        for (int32_t value : input->get_data()) {
+            result->append(value * factor);
+        }
+        return result;
+    }
+
+    SlotId slot_id;
+    int32_t factor;
+    std::vector<size_t> rows;
+};
+
 } // namespace vectorized
 } // namespace starrocks
\ No newline at end of file
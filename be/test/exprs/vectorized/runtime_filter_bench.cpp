@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of building the RuntimeBloomFilter of the build side and evaluating it on the probe chunks.
+// Usage: runtime_filter_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "column/fixed_length_column.h"
+#include "exprs/vectorized/runtime_filter.h"
+
+namespace starrocks::vectorized {
+
+static constexpr uint32_t kProbeChunkSize = 4096;
+
+static void BM_runtime_filter_build(benchmark::State& state) {
+    const size_t build_rows = state.range(0);
+    std::mt19937 rng(build_rows);
+    std::vector<int32_t> keys(build_rows);
+    for (auto& key : keys) {
+        key = static_cast<int32_t>(rng());
+    }
+    for (auto _ : state) {
+        RuntimeBloomFilter<TYPE_INT> bf;
+        bf.init(build_rows);
+        for (auto& key : keys) {
+            bf.insert(&key);
+        }
+        benchmark::DoNotOptimize(bf.max_value());
+    }
+    state.SetItemsProcessed(state.iterations() * build_rows);
+}
+
+// |state.range(1)| percent of the probe rows are in the build side.
+static void BM_runtime_filter_evaluate(benchmark::State& state) {
+    const size_t build_rows = state.range(0);
+    std::mt19937 rng(build_rows);
+    std::vector<int32_t> keys(build_rows);
+    RuntimeBloomFilter<TYPE_INT> bf;
+    bf.init(build_rows);
+    for (auto& key : keys) {
+        // the even keys are in the build side, the odd ones are not
+        key = static_cast<int32_t>(rng()) & ~1;
+        bf.insert(&key);
+    }
+    auto probe_column = Int32Column::create();
+    for (uint32_t i = 0; i < kProbeChunkSize; i++) {
+        bool hit = rng() % 100 < state.range(1);
+        probe_column->append(hit ? keys[rng() % build_rows] : static_cast<int32_t>(rng()) | 1);
+    }
+    JoinRuntimeFilter::RunningContext ctx;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bf.evaluate(probe_column.get(), &ctx).data());
+    }
+    state.SetItemsProcessed(state.iterations() * kProbeChunkSize);
+}
+
+// The bloom filter from in L2 to far beyond L3.
+BENCHMARK(BM_runtime_filter_build)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK(BM_runtime_filter_evaluate)
+        ->Args({1 << 16, 10})
+        ->Args({1 << 16, 90})
+        ->Args({1 << 20, 10})
+        ->Args({1 << 20, 90})
+        ->Args({1 << 24, 10})
+        ->Args({1 << 24, 90});
+
+} // namespace starrocks::vectorized
+
+BENCHMARK_MAIN();
@@ -152,6 +152,49 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerialize) {
     EXPECT_TRUE(rf1->check_equal(*rf0));
 }
 
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterMinMaxOnly) {
+    int64_t old_max_rows = config::runtime_filter_bloom_max_rows;
+    config::runtime_filter_bloom_max_rows = 50;
+    RuntimeBloomFilter<TYPE_INT> bf0;
+    JoinRuntimeFilter* rf0 = &bf0;
+    // more rows than runtime_filter_bloom_max_rows, only the min and the max are kept
+    bf0.init(100);
+    config::runtime_filter_bloom_max_rows = old_max_rows;
+    for (int i = 0; i <= 200; i += 17) {
+        bf0.insert(&i);
+    }
+    EXPECT_EQ(bf0.min_value(), 0);
+    EXPECT_EQ(bf0.max_value(), 187);
+    EXPECT_TRUE(bf0.test_data(1));
+    EXPECT_TRUE(bf0.test_data(186));
+    EXPECT_FALSE(bf0.test_data(-1));
+    EXPECT_FALSE(bf0.test_data(188));
+
+    size_t max_size = RuntimeFilterHelper::max_runtime_filter_serialized_size(rf0);
+    std::vector<uint8_t> buffer(max_size, 0);
+    size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(rf0, buffer.data());
+    buffer.resize(actual_size);
+
+    JoinRuntimeFilter* rf1 = nullptr;
+    ObjectPool pool;
+    RuntimeFilterHelper::deserialize_runtime_filter(&pool, &rf1, buffer.data(), actual_size);
+    EXPECT_TRUE(rf1->check_equal(*rf0));
+    auto* bf1 = down_cast<RuntimeBloomFilter<TYPE_INT>*>(rf1);
+    EXPECT_TRUE(bf1->test_data(1));
+    EXPECT_FALSE(bf1->test_data(188));
+
+    // the merged filter of a min/max only one is min/max only
+    RuntimeBloomFilter<TYPE_INT> bf2;
+    bf2.init(10);
+    int value = 300;
+    bf2.insert(&value);
+    EXPECT_FALSE(bf2.test_data(299));
+    bf2.merge(rf0);
+    EXPECT_TRUE(bf2.test_data(299));
+    EXPECT_TRUE(bf2.test_data(1));
+    EXPECT_FALSE(bf2.test_data(301));
+}
+
 TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerialize2) {
     RuntimeBloomFilter<TYPE_INT> bf0;
     JoinRuntimeFilter* rf0 = &bf0;
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <optional>
 #include <random>
 
 #include "column/array_column.h"
@@ -746,6 +747,41 @@ PARALLEL_TEST(VecStringFunctionsTest, splitPart) {
     ASSERT_TRUE(v->get(19).is_null());
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, splitPartConstDelimiterTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    for (const auto& s : {"a##b##c", "##b", "abc", "", "a##", "x##y", "##"}) {
+        str->append(s);
+        null->append(0);
+    }
+    str->append("a##b");
+    null->append(1);
+    auto delim = BinaryColumn::create();
+    delim->append("##");
+
+    std::vector<std::vector<std::optional<std::string>>> expects = {
+            {"a", "", std::nullopt, std::nullopt, "a", "x", "", std::nullopt},
+            {"b", "b", std::nullopt, std::nullopt, "", "y", "", std::nullopt},
+            {"c", std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt}};
+    for (int part = 1; part <= 3; ++part) {
+        auto field = Int32Column::create();
+        field->append(part);
+        Columns columns{NullableColumn::create(str, null), ConstColumn::create(delim, 1),
+                        ConstColumn::create(field, 1)};
+        ColumnPtr result = StringFunctions::split_part(ctx.get(), columns);
+        ASSERT_EQ(str->size(), result->size());
+        for (size_t i = 0; i < result->size(); ++i) {
+            const auto& expect = expects[part - 1][i];
+            if (expect.has_value()) {
+                ASSERT_EQ(expect.value(), result->get(i).get<Slice>().to_string()) << part << " " << i;
+            } else {
+                ASSERT_TRUE(result->get(i).is_null()) << part << " " << i;
+            }
+        }
+    }
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, leftTest) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     Columns columns;
@@ -1479,6 +1515,32 @@ PARALLEL_TEST(VecStringFunctionsTest, findInSetTest) {
     ASSERT_EQ(0, v->get_data()[8]);
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, findInSetConstTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+
+    auto strs = BinaryColumn::create();
+    for (const auto& s : {"b", "bc", "a,b", "", "c", "d"}) {
+        strs->append(s);
+    }
+    auto const_list = BinaryColumn::create();
+    const_list->append("a,bc,,b,c,b");
+    ColumnPtr result = StringFunctions::find_in_set(ctx.get(), {strs, ConstColumn::create(const_list, 1)});
+    auto v = ColumnHelper::cast_to<TYPE_INT>(result);
+    ASSERT_EQ((std::vector<int32_t>{4, 2, 0, 3, 5, 0}),
+              std::vector<int32_t>(v->get_data().begin(), v->get_data().end()));
+
+    auto lists = BinaryColumn::create();
+    for (const auto& s : {"a,bc,b", "bcb,b", "bbb", "b", "", "ab,cb,bb"}) {
+        lists->append(s);
+    }
+    auto const_str = BinaryColumn::create();
+    const_str->append("b");
+    result = StringFunctions::find_in_set(ctx.get(), {ConstColumn::create(const_str, 1), lists});
+    v = ColumnHelper::cast_to<TYPE_INT>(result);
+    ASSERT_EQ((std::vector<int32_t>{3, 2, 0, 1, 0, 0}),
+              std::vector<int32_t>(v->get_data().begin(), v->get_data().end()));
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, regexpExtractNullablePattern) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     auto context = ctx.get();
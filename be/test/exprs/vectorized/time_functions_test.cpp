@@ -789,6 +789,50 @@ TEST_F(TimeFunctionsTest, fromUnixToDatetime) {
     }
 }
 
+TEST_F(TimeFunctionsTest, toUnixFromDatetimeAcrossDst) {
+    Columns columns;
+    auto tc1 = TimestampColumn::create();
+    tc1->append(TimestampValue::create(2021, 3, 14, 1, 59, 59));
+    // skipped by the daylight saving time
+    tc1->append(TimestampValue::create(2021, 3, 14, 2, 30, 0));
+    tc1->append(TimestampValue::create(2021, 3, 14, 3, 0, 0));
+    // repeated one hour later
+    tc1->append(TimestampValue::create(2021, 11, 7, 1, 30, 0));
+    tc1->append(TimestampValue::create(2021, 11, 7, 2, 0, 0));
+    tc1->append(TimestampValue::create(2021, 3, 14, 1, 59, 59));
+    columns.emplace_back(tc1);
+
+    ColumnPtr result = TimeFunctions::to_unix_from_datetime(_utils->get_fn_ctx(), columns);
+
+    auto v = ColumnHelper::cast_to<TYPE_INT>(result);
+    ASSERT_EQ(1615715999, v->get_data()[0]);
+    ASSERT_EQ(1615716000, v->get_data()[1]);
+    ASSERT_EQ(1615716000, v->get_data()[2]);
+    ASSERT_EQ(1636273800, v->get_data()[3]);
+    ASSERT_EQ(1636279200, v->get_data()[4]);
+    ASSERT_EQ(1615715999, v->get_data()[5]);
+}
+
+TEST_F(TimeFunctionsTest, fromUnixToDatetimeAcrossDst) {
+    Columns columns;
+    auto tc1 = Int32Column::create();
+    tc1->append(1615715999);
+    tc1->append(1615716000);
+    tc1->append(1636273800);
+    tc1->append(1636277400);
+    tc1->append(1615715999);
+    columns.emplace_back(tc1);
+
+    ColumnPtr result = TimeFunctions::from_unix_to_datetime(_utils->get_fn_ctx(), columns);
+
+    auto v = ColumnHelper::cast_to<TYPE_VARCHAR>(result);
+    ASSERT_EQ("2021-03-14 01:59:59", v->get_data()[0]);
+    ASSERT_EQ("2021-03-14 03:00:00", v->get_data()[1]);
+    ASSERT_EQ("2021-11-07 01:30:00", v->get_data()[2]);
+    ASSERT_EQ("2021-11-07 01:30:00", v->get_data()[3]);
+    ASSERT_EQ("2021-03-14 01:59:59", v->get_data()[4]);
+}
+
 TEST_F(TimeFunctionsTest, fromUnixToDatetimeWithFormat) {
     {
         Columns columns;
@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "formats/csv/csv_reader.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::vectorized {
+
+static std::vector<std::string> split(const CSVReader& reader, const std::string& record) {
+    CSVReader::Fields fields;
+    reader.split_record(CSVReader::Record(record.data(), record.size()), &fields);
+    std::vector<std::string> res;
+    for (const auto& field : fields) {
+        res.emplace_back(field.to_string());
+    }
+    return res;
+}
+
+// NOLINTNEXTLINE
+TEST(CSVReaderTest, test_split_record) {
+    CSVReader reader('\n', ",");
+    EXPECT_EQ(std::vector<std::string>({""}), split(reader, ""));
+    EXPECT_EQ(std::vector<std::string>({"", ""}), split(reader, ","));
+    EXPECT_EQ(std::vector<std::string>({"a", "bc", ""}), split(reader, "a,bc,"));
+
+    // the delimiters around the boundaries of every 64 bytes
+    for (size_t len : {63, 64, 65, 127, 128, 129, 300}) {
+        for (size_t step : {1, 2, 7, 63, 64, 65}) {
+            std::string record(len, 'x');
+            std::vector<std::string> expected;
+            size_t begin = 0;
+            for (size_t i = step - 1; i < len; i += step) {
+                record[i] = ',';
+                expected.emplace_back(record.substr(begin, i - begin));
+                begin = i + 1;
+            }
+            expected.emplace_back(record.substr(begin));
+            EXPECT_EQ(expected, split(reader, record)) << "len=" << len << " step=" << step;
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(CSVReaderTest, test_split_record_multi_char_delimiter) {
+    CSVReader reader('\n', "||");
+    EXPECT_EQ(std::vector<std::string>({"a", "b|c", ""}), split(reader, "a||b|c||"));
+}
+
+} // namespace starrocks::vectorized
@@ -72,6 +72,14 @@ public:
     }
 };
 
+static const char* kHttpClientTestFile = ".http_client_test_file.dat";
+
+class HttpClientTestFileHandler : public HttpHandler {
+public:
+    void handle(HttpRequest* req) override { do_file_response(kHttpClientTestFile, req); }
+};
+
+static HttpClientTestFileHandler s_file_handler = HttpClientTestFileHandler();
 static HttpClientTestSimpleGetHandler s_simple_get_handler = HttpClientTestSimpleGetHandler();
 static HttpClientTestSimplePostHandler s_simple_post_handler = HttpClientTestSimplePostHandler();
 static EvHttpServer* s_server = nullptr;
@@ -88,6 +96,7 @@ public:
         s_server->register_handler(GET, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(HEAD, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(POST, "/simple_post", &s_simple_post_handler);
+        s_server->register_handler(GET, "/file", &s_file_handler);
         s_server->start();
         real_port = s_server->get_real_port();
         ASSERT_NE(0, real_port);
@@ -134,6 +143,34 @@ TEST_F(HttpClientTest, download) {
     unlink(local_file.c_str());
 }
 
+TEST_F(HttpClientTest, download_resume) {
+    std::string content = "0123456789abcdefghij";
+    auto fp = fopen(kHttpClientTestFile, "w");
+    ASSERT_EQ(1, fwrite(content.data(), content.size(), 1, fp));
+    fclose(fp);
+    // the first 8 bytes have been downloaded
+    std::string local_file = ".http_client_test_resume.dat";
+    fp = fopen(local_file.c_str(), "w");
+    ASSERT_EQ(1, fwrite(content.data(), 8, 1, fp));
+    fclose(fp);
+
+    HttpClient client;
+    ASSERT_TRUE(client.init(hostname + "/file").ok());
+    ASSERT_TRUE(client.download(local_file, 8).ok());
+    ASSERT_EQ(HttpStatus::PARTIAL_CONTENT, client.get_http_status());
+    char buf[50];
+    fp = fopen(local_file.c_str(), "r");
+    auto size = fread(buf, 1, 50, fp);
+    fclose(fp);
+    ASSERT_EQ(content, std::string(buf, size));
+
+    // the range beyond the file is not satisfiable
+    ASSERT_TRUE(client.init(hostname + "/file").ok());
+    ASSERT_FALSE(client.download(local_file, content.size()).ok());
+    unlink(local_file.c_str());
+    unlink(kHttpClientTestFile);
+}
+
 TEST_F(HttpClientTest, get_failed) {
     HttpClient client;
     auto st = client.init(hostname + "/simple_get");
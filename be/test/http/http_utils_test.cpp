@@ -93,4 +93,26 @@ TEST_F(HttpUtilsTest, parse_basic_auth) {
     }
 }
 
+TEST_F(HttpUtilsTest, parse_byte_range) {
+    int64_t offset = 0;
+    int64_t length = 0;
+    ASSERT_TRUE(parse_byte_range("bytes=10-", 100, &offset, &length));
+    ASSERT_EQ(10, offset);
+    ASSERT_EQ(90, length);
+    ASSERT_TRUE(parse_byte_range("bytes=0-9", 100, &offset, &length));
+    ASSERT_EQ(0, offset);
+    ASSERT_EQ(10, length);
+    // the last byte position is bounded by the file size
+    ASSERT_TRUE(parse_byte_range("bytes=90-200", 100, &offset, &length));
+    ASSERT_EQ(90, offset);
+    ASSERT_EQ(10, length);
+
+    ASSERT_FALSE(parse_byte_range("bytes=100-", 100, &offset, &length));
+    ASSERT_FALSE(parse_byte_range("bytes=-10", 100, &offset, &length));
+    ASSERT_FALSE(parse_byte_range("bytes=10-5", 100, &offset, &length));
+    ASSERT_FALSE(parse_byte_range("bytes=0-1,5-6", 100, &offset, &length));
+    ASSERT_FALSE(parse_byte_range("items=0-1", 100, &offset, &length));
+    ASSERT_FALSE(parse_byte_range("bytes=a-", 100, &offset, &length));
+}
+
 } // namespace starrocks
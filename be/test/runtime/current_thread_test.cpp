@@ -0,0 +1,82 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/current_thread.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/config.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+TEST(CurrentThreadTest, batch_consume) {
+    int64_t old_batch_bytes = config::thread_mem_tracker_batch_bytes;
+    config::thread_mem_tracker_batch_bytes = 1024;
+    MemTracker tracker(4096);
+    // a thread of its own, so that the cache of the thread starts from 0
+    std::thread([&tracker] {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(&tracker);
+        int64_t start = tls_thread_status.allocated_bytes();
+
+        // the tracker is behind by less than the batch bytes
+        tls_thread_status.mem_consume(512);
+        ASSERT_EQ(0, tracker.consumption());
+        tls_thread_status.mem_consume(512);
+        ASSERT_EQ(1024, tracker.consumption());
+
+        // the limit is checked when the batch is flushed
+        ASSERT_TRUE(tls_thread_status.try_mem_consume(2048));
+        ASSERT_EQ(3072, tracker.consumption());
+        ASSERT_FALSE(tls_thread_status.try_mem_consume(2048));
+        ASSERT_EQ(3072, tracker.consumption());
+        ASSERT_EQ(3072, tls_thread_status.allocated_bytes() - start);
+
+        tls_thread_status.mem_release(3072);
+        ASSERT_EQ(0, tracker.consumption());
+        ASSERT_EQ(3072, tls_thread_status.allocated_bytes() - start);
+    }).join();
+    config::thread_mem_tracker_batch_bytes = old_batch_bytes;
+}
+
+TEST(CurrentThreadTest, allocation_counter) {
+    RuntimeProfile profile("test");
+    RuntimeProfile::Counter* counter = ADD_COUNTER(&profile, "AllocatedBytes", TUnit::BYTES);
+    MemTracker tracker;
+    std::thread([&tracker, counter] {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(&tracker);
+        for (int i = 0; i < 2; i++) {
+            SCOPED_THREAD_LOCAL_ALLOCATION_COUNTER(counter);
+            tls_thread_status.mem_consume(100);
+            tls_thread_status.mem_release(100);
+        }
+    }).join();
+    ASSERT_EQ(200, counter->value());
+}
+
+TEST(CurrentThreadTest, allocation_and_peak_counter) {
+    RuntimeProfile profile("test");
+    RuntimeProfile::Counter* counter = ADD_COUNTER(&profile, "AllocatedBytes", TUnit::BYTES);
+    RuntimeProfile::HighWaterMarkCounter* peak_counter = profile.AddHighWaterMarkCounter("PeakMemory", TUnit::BYTES);
+    MemTracker tracker;
+    std::thread([&tracker, counter, peak_counter] {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(&tracker);
+        {
+            // holds 300 bytes after the first scope
+            SCOPED_THREAD_LOCAL_ALLOCATION_AND_PEAK_COUNTER(counter, peak_counter);
+            tls_thread_status.mem_consume(500);
+            tls_thread_status.mem_release(200);
+        }
+        {
+            // frees them in the second one
+            SCOPED_THREAD_LOCAL_ALLOCATION_AND_PEAK_COUNTER(counter, peak_counter);
+            tls_thread_status.mem_release(300);
+        }
+    }).join();
+    ASSERT_EQ(500, counter->value());
+    ASSERT_EQ(300, peak_counter->value());
+    ASSERT_EQ(0, peak_counter->current_value());
+}
+
+} // namespace starrocks
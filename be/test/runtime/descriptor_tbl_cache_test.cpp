@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/descriptor_tbl_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+class DescriptorTblCacheTest : public testing::Test {
+protected:
+    static TDescriptorTable make_desc_tbl(const std::string& column_name) {
+        TDescriptorTableBuilder desc_tbl_builder;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name(column_name).column_pos(0).nullable(true).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().string_type(32).column_name("v").column_pos(1).build());
+        tuple_builder.build(&desc_tbl_builder);
+        return desc_tbl_builder.desc_tbl();
+    }
+
+    MemTracker _tracker;
+};
+
+TEST_F(DescriptorTblCacheTest, test_get_or_create) {
+    DescriptorTblCache cache(&_tracker, 1024 * 1024);
+
+    DescriptorTbl* desc_tbl1 = nullptr;
+    std::shared_ptr<ObjectPool> pool1;
+    ASSERT_TRUE(cache.get_or_create(make_desc_tbl("k"), 4096, &desc_tbl1, &pool1).ok());
+    ASSERT_TRUE(desc_tbl1 != nullptr);
+    ASSERT_EQ(2, desc_tbl1->get_tuple_descriptor(0)->slots().size());
+    ASSERT_GT(cache.memory_usage(), 0);
+
+    // the same descriptor table is shared
+    DescriptorTbl* desc_tbl2 = nullptr;
+    std::shared_ptr<ObjectPool> pool2;
+    ASSERT_TRUE(cache.get_or_create(make_desc_tbl("k"), 4096, &desc_tbl2, &pool2).ok());
+    ASSERT_EQ(desc_tbl1, desc_tbl2);
+    ASSERT_EQ(pool1, pool2);
+
+    // a different one is built again
+    DescriptorTbl* desc_tbl3 = nullptr;
+    std::shared_ptr<ObjectPool> pool3;
+    ASSERT_TRUE(cache.get_or_create(make_desc_tbl("k2"), 4096, &desc_tbl3, &pool3).ok());
+    ASSERT_NE(desc_tbl1, desc_tbl3);
+    ASSERT_EQ("k2", desc_tbl3->get_tuple_descriptor(0)->slots()[0]->col_name());
+}
+
+} // namespace starrocks
@@ -21,6 +21,10 @@
 
 #include "runtime/external_scan_context_mgr.h"
 
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
 #include <gtest/gtest.h>
 
 #include <memory>
@@ -30,6 +34,7 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/result_queue_mgr.h"
 #include "runtime/thread_resource_mgr.h"
+#include "util/arrow/row_batch.h"
 
 namespace starrocks {
 
@@ -103,4 +108,47 @@ TEST_F(ExternalScanContextMgrTest, clear_context) {
     ASSERT_TRUE(!st.ok());
     ASSERT_TRUE(result == nullptr);
 }
+
+TEST_F(ExternalScanContextMgrTest, get_next_batch) {
+    std::shared_ptr<ScanContext> context;
+    ExternalScanContextMgr context_mgr(&_exec_env);
+    ASSERT_TRUE(context_mgr.create_scan_context(&context).ok());
+    context->fragment_instance_id.lo = 10;
+    context->fragment_instance_id.hi = 100;
+
+    BlockQueueSharedPtr queue;
+    _exec_env._result_queue_mgr->create_queue(context->fragment_instance_id, &queue);
+    std::shared_ptr<arrow::Array> k1_col;
+    arrow::NumericBuilder<arrow::Int32Type> builder;
+    builder.Reserve(2);
+    builder.Append(20);
+    builder.Append(30);
+    builder.Finish(&k1_col);
+    auto schema = arrow::schema({arrow::field("k1", arrow::int32(), true)});
+    auto record_batch = arrow::RecordBatch::Make(schema, 2, {k1_col});
+    queue->blocking_put(record_batch);
+    // sentinel
+    queue->blocking_put(nullptr);
+
+    std::string rows;
+    int64_t num_rows = 0;
+    bool eos = false;
+    // the offset of the client must be the one of the context
+    Status st = context_mgr.get_next_batch(context->context_id, 1, &rows, &num_rows, &eos);
+    ASSERT_TRUE(st.is_not_found());
+
+    ASSERT_TRUE(context_mgr.get_next_batch(context->context_id, 0, &rows, &num_rows, &eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(2, num_rows);
+    ASSERT_EQ(2, context->offset);
+    std::string expected;
+    ASSERT_TRUE(serialize_record_batch(*record_batch, &expected).ok());
+    ASSERT_EQ(expected, rows);
+
+    ASSERT_TRUE(context_mgr.get_next_batch(context->context_id, 2, &rows, &num_rows, &eos).ok());
+    ASSERT_TRUE(eos);
+    ASSERT_EQ(0, num_rows);
+
+    ASSERT_TRUE(context_mgr.get_next_batch("not_exist", 0, &rows, &num_rows, &eos).is_not_found());
+}
 } // namespace starrocks
@@ -0,0 +1,46 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/mem_arbitrator.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace starrocks {
+
+TEST(MemArbitratorTest, test_admit_and_release) {
+    MemArbitrator arbitrator;
+    ASSERT_TRUE(arbitrator.admit(60, 100, 0).ok());
+    ASSERT_TRUE(arbitrator.admit(40, 100, 0).ok());
+    ASSERT_EQ(100, arbitrator.reserved_bytes());
+
+    // times out since the capacity is used up
+    Status st = arbitrator.admit(10, 100, 10);
+    ASSERT_TRUE(st.is_mem_limit_exceeded());
+    ASSERT_FALSE(arbitrator.is_under_pressure());
+
+    arbitrator.release(60);
+    arbitrator.release(40);
+    ASSERT_EQ(0, arbitrator.reserved_bytes());
+
+    // a reservation larger than the capacity is admitted if it's the only one
+    ASSERT_TRUE(arbitrator.admit(200, 100, 0).ok());
+    arbitrator.release(200);
+}
+
+TEST(MemArbitratorTest, test_wait_for_release) {
+    MemArbitrator arbitrator;
+    ASSERT_TRUE(arbitrator.admit(80, 100, 0).ok());
+
+    std::thread waiter([&arbitrator]() { ASSERT_TRUE(arbitrator.admit(50, 100, 60 * 1000).ok()); });
+    while (!arbitrator.is_under_pressure()) {
+        std::this_thread::yield();
+    }
+    arbitrator.release(80);
+    waiter.join();
+    ASSERT_FALSE(arbitrator.is_under_pressure());
+    ASSERT_EQ(50, arbitrator.reserved_bytes());
+    arbitrator.release(50);
+}
+
+} // namespace starrocks
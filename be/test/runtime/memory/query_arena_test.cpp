@@ -0,0 +1,86 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/memory/query_arena.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+TEST(QueryArenaTest, allocate) {
+    MemTracker tracker;
+    {
+        QueryArena arena(&tracker);
+        ASSERT_EQ(0, arena.reserved_bytes());
+        for (size_t alignment : {1, 8, 16, 64, 4096}) {
+            uint8_t* p = arena.allocate(13, alignment);
+            ASSERT_NE(nullptr, p);
+            ASSERT_EQ(0, reinterpret_cast<uintptr_t>(p) % alignment);
+            memset(p, 0xff, 13);
+        }
+        ASSERT_EQ(1, arena.num_slabs());
+        ASSERT_EQ(5 * 13, arena.allocated_bytes());
+        ASSERT_EQ(QueryArena::kSlabSize, arena.reserved_bytes());
+        ASSERT_EQ(arena.reserved_bytes(), tracker.consumption());
+
+        // a large allocation gets its own slab
+        uint8_t* p = arena.allocate(3 * QueryArena::kSlabSize);
+        ASSERT_NE(nullptr, p);
+        memset(p, 0xff, 3 * QueryArena::kSlabSize);
+        ASSERT_EQ(2, arena.num_slabs());
+        ASSERT_EQ(5 * QueryArena::kSlabSize, arena.reserved_bytes());
+        ASSERT_EQ(arena.reserved_bytes(), tracker.consumption());
+    }
+    ASSERT_EQ(0, tracker.consumption());
+}
+
+TEST(QueryArenaTest, exceed_limit) {
+    MemTracker tracker(QueryArena::kSlabSize);
+    QueryArena arena(&tracker);
+    ASSERT_NE(nullptr, arena.allocate(QueryArena::kSlabSize / 2));
+    ASSERT_EQ(nullptr, arena.allocate(QueryArena::kSlabSize));
+    ASSERT_EQ(QueryArena::kSlabSize, tracker.consumption());
+}
+
+TEST(QueryArenaTest, arena_allocator) {
+    MemTracker tracker;
+    QueryArena arena(&tracker);
+    std::vector<int64_t, ArenaAllocator<int64_t>> values{ArenaAllocator<int64_t>(&arena)};
+    for (int64_t i = 0; i < 10000; i++) {
+        values.push_back(i);
+    }
+    for (int64_t i = 0; i < 10000; i++) {
+        ASSERT_EQ(i, values[i]);
+    }
+    ASSERT_GE(arena.allocated_bytes(), 10000 * sizeof(int64_t));
+    ASSERT_EQ(arena.reserved_bytes(), tracker.consumption());
+}
+
+TEST(QueryArenaTest, mem_pool) {
+    MemTracker tracker;
+    QueryArena arena(&tracker);
+    {
+        MemPool pool(&arena);
+        MemPool other(&arena);
+        for (int i = 0; i < 100; i++) {
+            uint8_t* p = pool.allocate(1000);
+            ASSERT_NE(nullptr, p);
+            memset(p, i, 1000);
+        }
+        ASSERT_EQ(100 * 1000, pool.total_allocated_bytes());
+        other.acquire_data(&pool, false);
+        ASSERT_EQ(0, pool.total_allocated_bytes());
+        ASSERT_EQ(100 * 1000, other.total_allocated_bytes());
+        other.free_all();
+    }
+    // the chunks are only returned with the arena
+    ASSERT_GT(arena.allocated_bytes(), 100 * 1000);
+    ASSERT_EQ(arena.reserved_bytes(), tracker.consumption());
+}
+
+} // namespace starrocks
@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/sampling_profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "runtime/current_thread.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+TEST(SamplingProfilerTest, sample_query) {
+    auto* profiler = SamplingProfiler::instance();
+    if (!profiler->init(1000, 2).ok()) {
+        // not available with the sanitizers
+        return;
+    }
+    UniqueId query_id(1, 2);
+    UniqueId fragment_instance_id(3, 4);
+    std::thread([&] {
+        profiler->register_current_thread();
+        {
+            SCOPED_THREAD_LOCAL_EXEC_CONTEXT_SETTER(query_id.to_thrift(), fragment_instance_id.to_thrift());
+            SCOPED_THREAD_LOCAL_PLAN_NODE_SETTER(7);
+            // spin 100ms of the CPU, which is about 100 samples
+            volatile int64_t sum = 0;
+            int64_t start = MonotonicMillis();
+            while (MonotonicMillis() - start < 100) {
+                sum = sum + 1;
+            }
+        }
+        profiler->unregister_current_thread();
+    }).join();
+
+    auto queries = profiler->list_queries();
+    ASSERT_EQ(1, queries.size());
+    ASSERT_EQ(query_id, queries[0]);
+
+    std::string folded_stacks;
+    ASSERT_TRUE(profiler->dump_folded_stacks(query_id, nullptr, &folded_stacks).ok());
+    ASSERT_NE(std::string::npos, folded_stacks.find(fragment_instance_id.to_string() + ";plan_node_7;"));
+    ASSERT_TRUE(profiler->dump_folded_stacks(UniqueId(5, 6), nullptr, &folded_stacks).is_not_found());
+    profiler->close();
+}
+
+} // namespace starrocks
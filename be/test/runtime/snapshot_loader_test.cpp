@@ -23,6 +23,7 @@
 
 #include <filesystem>
 
+#include "common/config.h"
 #include "runtime/exec_env.h"
 #include "util/cpu_info.h"
 
@@ -106,4 +107,39 @@ TEST_F(SnapshotLoaderTest, NormalCase) {
     ASSERT_EQ(10005, tablet_id);
 }
 
+TEST_F(SnapshotLoaderTest, RunInParallel) {
+    SnapshotLoader loader(_exec_env, 1L, 2L);
+    int32_t old_parallelism = config::snapshot_loader_parallelism;
+    config::snapshot_loader_parallelism = 4;
+
+    {
+        std::vector<int> done(20, 0);
+        SnapshotLoader::Progress progress(done.size(), TTaskType::type::UPLOAD);
+        Status st = loader._run_in_parallel(done.size(), &progress, [&](size_t i) {
+            done[i]++;
+            return Status::OK();
+        });
+        ASSERT_TRUE(st.ok());
+        ASSERT_EQ(std::vector<int>(20, 1), done);
+        ASSERT_EQ(20, progress.finished_num);
+    }
+
+    {
+        // the error of the failed tablet is returned rather than the cancellation of the others
+        SnapshotLoader::Progress progress(20, TTaskType::type::DOWNLOAD);
+        Status st = loader._run_in_parallel(20, &progress, [&](size_t i) {
+            if (i == 3) {
+                return Status::InternalError("failed tablet");
+            }
+            return Status::OK();
+        });
+        ASSERT_FALSE(st.ok());
+        ASSERT_FALSE(st.is_cancelled());
+        ASSERT_TRUE(progress.failed.load());
+        ASSERT_LT(progress.finished_num, 20);
+    }
+
+    config::snapshot_loader_parallelism = old_parallelism;
+}
+
 } // namespace starrocks
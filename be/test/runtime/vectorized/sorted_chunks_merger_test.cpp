@@ -302,4 +302,55 @@ TEST_F(SortedChunksMergerTest, three_suppliers) {
     }
 }
 
+// The runs of rows from one supplier are taken together, and must stop at the chunk size.
+TEST_F(SortedChunksMergerTest, runs_across_small_chunk_size) {
+    config::vector_chunk_size = 4;
+    auto runtime_state = _create_runtime_state();
+
+    ChunkSuppliers suppliers;
+    ChunkProbeSuppliers probe_suppliers;
+    ChunkHasSuppliers has_suppliers;
+    std::vector<ChunkPtr> chunks = {_chunk_1, _chunk_3};
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto supplier = [&chunks, i](Chunk** cnk) -> Status {
+            if (chunks[i] != nullptr) {
+                ChunkPtr& src_chunk = chunks[i];
+                size_t row_num = src_chunk->num_rows();
+                *cnk = src_chunk->clone_empty_with_slot(row_num).release();
+                for (size_t c = 0; c < src_chunk->num_columns(); ++c) {
+                    (*cnk)->get_column_by_index(c)->append(*(src_chunk->get_column_by_index(c)), 0, row_num);
+                }
+                chunks[i] = nullptr;
+            } else {
+                *cnk = nullptr;
+            }
+            return Status::OK();
+        };
+        auto probe_supplier = [](Chunk** cnk) -> bool { return false; };
+        auto has_supplier = []() -> bool { return false; };
+        suppliers.push_back(supplier);
+        probe_suppliers.push_back(probe_supplier);
+        has_suppliers.push_back(has_supplier);
+    }
+
+    SortedChunksMerger merger(runtime_state.get(), false);
+    merger.init(suppliers, probe_suppliers, has_suppliers, &_sort_exprs, &_is_asc, &_is_null_first);
+
+    std::vector<int32_t> merged;
+    bool eos = false;
+    while (true) {
+        ChunkPtr page;
+        merger.get_next(&page, &eos);
+        if (eos) {
+            break;
+        }
+        ASSERT_LE(page->num_rows(), 4);
+        for (size_t i = 0; i < page->num_rows(); ++i) {
+            merged.push_back(page->get(i).get(0).get_int32());
+        }
+    }
+    std::vector<int32_t> expected = {71, 70, 69, 56, 55, 49, 41, 58, 24, 12, 2};
+    ASSERT_EQ(expected, merged);
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,123 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of the SIMD gather and compress kernels against the scalar loops they replace in
+// Column::append_selective() and Column::filter_range().
+// Usage: gather_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "simd/gather.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kNumRows = 4096;
+
+template <typename T>
+class GatherBench {
+public:
+    // |num_src_rows| is the size of the source column, the larger the more cache misses of the gather.
+    GatherBench(size_t num_src_rows, uint32_t selectivity) : _src(num_src_rows), _indexes(kNumRows) {
+        std::mt19937 rng(num_src_rows);
+        for (auto& value : _src) {
+            value = static_cast<T>(rng());
+        }
+        for (auto& index : _indexes) {
+            index = rng() % num_src_rows;
+        }
+        _data.resize(kNumRows);
+        _filter.resize(kNumRows);
+        for (auto& f : _filter) {
+            f = rng() % 100 < selectivity;
+        }
+        _dst.resize(kNumRows);
+    }
+
+    void scalar_gather() {
+        for (size_t i = 0; i < kNumRows; i++) {
+            _dst[i] = _src[_indexes[i]];
+        }
+    }
+
+    void simd_gather() { SIMD::gather(_dst.data(), _src.data(), _indexes.data(), kNumRows); }
+
+    size_t scalar_filter() {
+        _reset_data();
+        size_t result = 0;
+        for (size_t i = 0; i < kNumRows; i++) {
+            if (_filter[i]) {
+                _data[result++] = _data[i];
+            }
+        }
+        return result;
+    }
+
+    size_t simd_filter() {
+        _reset_data();
+        size_t start = 0;
+        size_t result = 0;
+        SIMD::compress_store(_filter.data(), _data.data(), &start, &result, kNumRows);
+        for (; start < kNumRows; start++) {
+            if (_filter[start]) {
+                _data[result++] = _data[start];
+            }
+        }
+        return result;
+    }
+
+    const T* dst() const { return _dst.data(); }
+
+private:
+    void _reset_data() { std::copy(_src.begin(), _src.begin() + std::min(_src.size(), kNumRows), _data.begin()); }
+
+    std::vector<T> _src;
+    std::vector<uint32_t> _indexes;
+    std::vector<T> _dst;
+    std::vector<T> _data;
+    std::vector<uint8_t> _filter;
+};
+
+template <typename T, bool SIMD>
+static void BM_gather(benchmark::State& state) {
+    GatherBench<T> bench(state.range(0), 100);
+    for (auto _ : state) {
+        if constexpr (SIMD) {
+            bench.simd_gather();
+        } else {
+            bench.scalar_gather();
+        }
+        benchmark::DoNotOptimize(bench.dst());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+template <typename T, bool SIMD>
+static void BM_filter(benchmark::State& state) {
+    GatherBench<T> bench(kNumRows, state.range(0));
+    for (auto _ : state) {
+        if constexpr (SIMD) {
+            benchmark::DoNotOptimize(bench.simd_filter());
+        } else {
+            benchmark::DoNotOptimize(bench.scalar_filter());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// the source rows, from the L1 cache to the memory
+BENCHMARK_TEMPLATE(BM_gather, int32_t, false)->Arg(1024)->Arg(65536)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_gather, int32_t, true)->Arg(1024)->Arg(65536)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_gather, int64_t, false)->Arg(1024)->Arg(65536)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_gather, int64_t, true)->Arg(1024)->Arg(65536)->Arg(1 << 24);
+
+// the selectivity of the filter in percent
+BENCHMARK_TEMPLATE(BM_filter, int32_t, false)->Arg(10)->Arg(50)->Arg(90);
+BENCHMARK_TEMPLATE(BM_filter, int32_t, true)->Arg(10)->Arg(50)->Arg(90);
+BENCHMARK_TEMPLATE(BM_filter, int64_t, false)->Arg(10)->Arg(50)->Arg(90);
+BENCHMARK_TEMPLATE(BM_filter, int64_t, true)->Arg(10)->Arg(50)->Arg(90);
+
+} // namespace starrocks::vectorized
+
+BENCHMARK_MAIN();
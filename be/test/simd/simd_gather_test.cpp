@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "simd/gather.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+template <typename T>
+static void check_gather(size_t num_rows) {
+    std::mt19937 rng(num_rows);
+    std::vector<T> src(1000);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<T>(rng());
+    }
+    std::vector<uint32_t> indexes(num_rows);
+    for (auto& index : indexes) {
+        index = rng() % src.size();
+    }
+    std::vector<T> dst(num_rows);
+    SIMD::gather(dst.data(), src.data(), indexes.data(), num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        ASSERT_EQ(src[indexes[i]], dst[i]) << i;
+    }
+}
+
+template <typename T>
+static void check_compress(size_t num_rows, size_t from, uint32_t selectivity) {
+    std::mt19937 rng(num_rows + from + selectivity);
+    std::vector<T> data(num_rows);
+    std::vector<uint8_t> filter(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        data[i] = static_cast<T>(i * 3 + 1);
+        filter[i] = rng() % 100 < selectivity ? 1 + rng() % 255 : 0;
+    }
+    std::vector<T> expected(data.begin(), data.begin() + from);
+    for (size_t i = from; i < num_rows; i++) {
+        if (filter[i]) {
+            expected.push_back(data[i]);
+        }
+    }
+
+    size_t start = from;
+    size_t result = from;
+    SIMD::compress_store(filter.data(), data.data(), &start, &result, num_rows);
+    ASSERT_LE(start, num_rows);
+    for (; start < num_rows; start++) {
+        if (filter[start]) {
+            data[result++] = data[start];
+        }
+    }
+    ASSERT_EQ(expected.size(), result);
+    for (size_t i = 0; i < result; i++) {
+        ASSERT_EQ(expected[i], data[i]) << i;
+    }
+}
+
+TEST(SIMDGatherTest, gather) {
+    for (size_t num_rows : {0, 1, 3, 4, 7, 8, 15, 16, 17, 100, 4096}) {
+        check_gather<int8_t>(num_rows);
+        check_gather<int32_t>(num_rows);
+        check_gather<float>(num_rows);
+        check_gather<int64_t>(num_rows);
+        check_gather<double>(num_rows);
+        check_gather<__int128>(num_rows);
+    }
+}
+
+TEST(SIMDGatherTest, compress_store) {
+    for (size_t num_rows : {0, 7, 8, 16, 33, 100, 4096}) {
+        for (size_t from : {0, 3, 16}) {
+            if (from > num_rows) {
+                continue;
+            }
+            for (uint32_t selectivity : {0, 10, 50, 90, 100}) {
+                check_compress<int32_t>(num_rows, from, selectivity);
+                check_compress<int64_t>(num_rows, from, selectivity);
+                check_compress<double>(num_rows, from, selectivity);
+                check_compress<int16_t>(num_rows, from, selectivity);
+            }
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -76,4 +76,44 @@ TEST_F(SIMDTest, count_nonzero) {
     EXPECT_EQ(30u, SIMD::count_nonzero(numbers));
 }
 
+TEST_F(SIMDTest, count_zero_batches) {
+    // the sizes around the batches of the SSE2, AVX-512 and NEON kernels
+    for (size_t size : {15, 16, 17, 63, 64, 65, 127, 128, 129, 1000}) {
+        std::vector<int8_t> nums(size);
+        size_t expected = 0;
+        for (size_t i = 0; i < size; i++) {
+            nums[i] = (i * 7) % 5 == 0 ? 0 : static_cast<int8_t>(i);
+            expected += nums[i] == 0;
+        }
+        EXPECT_EQ(expected, SIMD::count_zero(nums)) << size;
+        EXPECT_EQ(size - expected, SIMD::count_nonzero(nums)) << size;
+    }
+}
+
+template <typename IndexType>
+static void check_to_index(size_t size, IndexType base) {
+    std::vector<uint8_t> filter(size);
+    std::vector<IndexType> expected;
+    for (size_t i = 0; i < size; i++) {
+        filter[i] = (i * 7) % 3 == 0 ? static_cast<uint8_t>(i | 1) : 0;
+        if (filter[i]) {
+            expected.push_back(static_cast<IndexType>(base + i));
+        }
+    }
+    std::vector<IndexType> indexes(size);
+    size_t count = SIMD::to_index(filter.data(), size, base, indexes.data());
+    ASSERT_EQ(expected.size(), count) << size;
+    indexes.resize(count);
+    ASSERT_EQ(expected, indexes) << size;
+}
+
+TEST_F(SIMDTest, to_index) {
+    for (size_t size : {0, 1, 15, 16, 17, 100, 4096}) {
+        check_to_index<uint16_t>(size, 0);
+        check_to_index<uint16_t>(size, 100);
+        check_to_index<uint32_t>(size, 0);
+        check_to_index<uint32_t>(size, 70000);
+    }
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,111 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/compaction_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+class CompactionSchedulerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _old_max_per_disk = config::compaction_max_tasks_per_disk;
+        _old_max_under_load = config::compaction_max_tasks_under_query_load;
+        config::compaction_max_tasks_per_disk = 2;
+        config::compaction_max_tasks_under_query_load = 1;
+    }
+
+    void TearDown() override {
+        config::compaction_max_tasks_per_disk = _old_max_per_disk;
+        config::compaction_max_tasks_under_query_load = _old_max_under_load;
+    }
+
+    static void wait_until(const std::function<bool()>& cond) {
+        for (int i = 0; i < 500 && !cond(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    int32_t _old_max_per_disk = 0;
+    int32_t _old_max_under_load = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CompactionSchedulerTest, max_tasks_per_disk) {
+    CompactionScheduler scheduler([] { return false; });
+    ASSERT_TRUE(scheduler.acquire("/disk1"));
+    ASSERT_TRUE(scheduler.acquire("/disk1"));
+
+    std::atomic<bool> acquired{false};
+    std::thread t([&] { acquired = scheduler.acquire("/disk1"); });
+    wait_until([&] { return scheduler.num_waiting() == 1; });
+    ASSERT_EQ(1, scheduler.num_waiting());
+    ASSERT_FALSE(acquired);
+
+    // the other disk has its own budget
+    ASSERT_TRUE(scheduler.acquire("/disk2"));
+    ASSERT_EQ(3, scheduler.num_running());
+
+    scheduler.release("/disk1");
+    t.join();
+    ASSERT_TRUE(acquired);
+    ASSERT_EQ(0, scheduler.num_waiting());
+    ASSERT_EQ(3, scheduler.num_running());
+
+    scheduler.release("/disk1");
+    scheduler.release("/disk1");
+    scheduler.release("/disk2");
+    ASSERT_EQ(0, scheduler.num_running());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompactionSchedulerTest, back_off_under_query_load) {
+    std::atomic<bool> busy{true};
+    CompactionScheduler scheduler([&] { return busy.load(); });
+    ASSERT_TRUE(scheduler.acquire("/disk1"));
+
+    std::atomic<bool> acquired{false};
+    std::thread t([&] { acquired = scheduler.acquire("/disk2"); });
+    wait_until([&] { return scheduler.num_waiting() == 1; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(acquired);
+
+    // the waiting task notices the load is gone without any release
+    busy = false;
+    t.join();
+    ASSERT_TRUE(acquired);
+    ASSERT_EQ(2, scheduler.num_running());
+    scheduler.release("/disk1");
+    scheduler.release("/disk2");
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompactionSchedulerTest, stop) {
+    config::compaction_max_tasks_per_disk = 1;
+    CompactionScheduler scheduler([] { return false; });
+    ASSERT_TRUE(scheduler.acquire("/disk1"));
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> acquired{true};
+    std::thread t([&] {
+        acquired = scheduler.acquire("/disk1");
+        done = true;
+    });
+    wait_until([&] { return scheduler.num_waiting() == 1; });
+    ASSERT_FALSE(done);
+    scheduler.stop();
+    t.join();
+    ASSERT_FALSE(acquired);
+    ASSERT_EQ(0, scheduler.num_waiting());
+    ASSERT_FALSE(scheduler.acquire("/disk2"));
+    scheduler.release("/disk1");
+}
+
+} // namespace starrocks
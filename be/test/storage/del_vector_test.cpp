@@ -41,4 +41,48 @@ TEST(DelVector, testLoadSave) {
     ASSERT_EQ(dv2.cardinality(), dels.size());
 };
 
+// NOLINTNEXTLINE
+TEST(DelVector, testSaveDelta) {
+    std::vector<uint32_t> dels(1000);
+    for (uint32_t i = 0; i < dels.size(); i++) {
+        dels[i] = i * 3;
+    }
+    DelVector base;
+    base.init(1, dels.data(), dels.size());
+    std::shared_ptr<DelVector> ndv;
+    base.add_dels_as_new_version({1, 2}, 2, &ndv);
+    ASSERT_EQ(1002, ndv->cardinality());
+
+    // only the new ids are saved
+    std::string raw = ndv->save_delta_or_full();
+    ASSERT_TRUE(DelVector::is_delta(raw.data(), raw.size()));
+    ASSERT_LT(raw.size(), ndv->save().size());
+    DelVector delta;
+    ASSERT_TRUE(delta.load(2, raw.data(), raw.size()).ok());
+    ASSERT_EQ(1, delta.base_version());
+    ASSERT_EQ(2, delta.cardinality());
+
+    std::string base_raw = base.save_delta_or_full();
+    ASSERT_FALSE(DelVector::is_delta(base_raw.data(), base_raw.size()));
+    DelVector base2;
+    ASSERT_TRUE(base2.load(1, base_raw.data(), base_raw.size()).ok());
+    ASSERT_FALSE(delta.merge_base(delta).ok());
+    ASSERT_TRUE(delta.merge_base(base2).ok());
+    ASSERT_EQ(-1, delta.base_version());
+    ASSERT_EQ(1, delta.delta_chain());
+    ASSERT_EQ(1002, delta.cardinality());
+    ASSERT_TRUE(*ndv->roaring() == *delta.roaring());
+
+    // a large delta is saved in whole
+    std::vector<uint32_t> more(1000);
+    for (uint32_t i = 0; i < more.size(); i++) {
+        more[i] = i * 3 + 1;
+    }
+    std::shared_ptr<DelVector> ndv2;
+    ndv->add_dels_as_new_version(more, 3, &ndv2);
+    raw = ndv2->save_delta_or_full();
+    ASSERT_FALSE(DelVector::is_delta(raw.data(), raw.size()));
+    ASSERT_EQ(0, ndv2->delta_chain());
+}
+
 } // namespace starrocks
@@ -208,4 +208,31 @@ TEST_F(TestHll, InvalidPtr) {
     }
 }
 
+TEST_F(TestHll, UpdateBatch) {
+    std::vector<uint64_t> hash_values;
+    for (int i = 0; i < 10000; ++i) {
+        hash_values.emplace_back(hash(i));
+        if (i % 100 == 0) {
+            hash_values.emplace_back(0);
+        }
+    }
+    HyperLogLog expected;
+    for (uint64_t value : hash_values) {
+        if (value != 0) {
+            expected.update(value);
+        }
+    }
+    HyperLogLog actual;
+    actual.update_batch(hash_values.data(), 50);
+    actual.update_batch(hash_values.data() + 50, hash_values.size() - 50);
+
+    uint8_t expected_buf[HLL_REGISTERS_COUNT + 1];
+    uint8_t actual_buf[HLL_REGISTERS_COUNT + 1];
+    int expected_len = expected.serialize(expected_buf);
+    int actual_len = actual.serialize(actual_buf);
+    ASSERT_EQ(expected_len, actual_len);
+    ASSERT_EQ(0, memcmp(expected_buf, actual_buf, actual_len));
+    ASSERT_EQ(expected.estimate_cardinality(), actual.estimate_cardinality());
+}
+
 } // namespace starrocks
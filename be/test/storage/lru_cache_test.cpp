@@ -257,6 +257,71 @@ TEST_F(CacheTest, Usage) {
     ASSERT_EQ(950, cache.get_usage());
 }
 
+static bool lookup_LRUCache(LRUCache& cache, const CacheKey& key) {
+    uint32_t hash = key.hash(key.data(), key.size(), 0);
+    Cache::Handle* handle = cache.lookup(key, hash);
+    cache.release(handle);
+    return handle != nullptr;
+}
+
+TEST_F(CacheTest, SegmentedEvictionPolicy) {
+    LRUCache cache;
+    cache.set_capacity(100);
+    cache.set_protected_capacity(50);
+
+    // hit once after inserted
+    CacheKey hot_key("hot");
+    insert_LRUCache(cache, hot_key, 10, CachePriority::NORMAL);
+    ASSERT_TRUE(lookup_LRUCache(cache, hot_key));
+    CacheKey index_key("index");
+    insert_LRUCache(cache, index_key, 10, CachePriority::PROTECTED);
+    ASSERT_EQ(20, cache.get_protected_usage());
+
+    // a scan touching every entry once only evicts the probationary entries
+    std::vector<std::string> scan_keys;
+    for (int i = 0; i < 100; i++) {
+        scan_keys.emplace_back("scan" + std::to_string(i));
+    }
+    for (const auto& key : scan_keys) {
+        insert_LRUCache(cache, CacheKey(key), 10, CachePriority::NORMAL);
+    }
+    ASSERT_TRUE(lookup_LRUCache(cache, hot_key));
+    ASSERT_TRUE(lookup_LRUCache(cache, index_key));
+    ASSERT_FALSE(lookup_LRUCache(cache, CacheKey(scan_keys[0])));
+    ASSERT_EQ(100, cache.get_usage());
+
+    // the protected segment is bounded, the oldest protected entries go back to probation
+    for (int i = 92; i < 100; i++) {
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey(scan_keys[i])));
+    }
+    ASSERT_EQ(50, cache.get_protected_usage());
+    insert_LRUCache(cache, CacheKey("new"), 10, CachePriority::NORMAL);
+    ASSERT_FALSE(lookup_LRUCache(cache, hot_key));
+    ASSERT_TRUE(lookup_LRUCache(cache, CacheKey(scan_keys[99])));
+}
+
+TEST_F(CacheTest, PruneCold) {
+    LRUCache cache;
+    cache.set_capacity(100);
+    cache.set_protected_capacity(50);
+
+    CacheKey hot_key("hot");
+    insert_LRUCache(cache, hot_key, 10, CachePriority::NORMAL);
+    ASSERT_TRUE(lookup_LRUCache(cache, hot_key));
+    CacheKey cold_key("cold");
+    insert_LRUCache(cache, cold_key, 10, CachePriority::NORMAL);
+
+    // only the entries never hit again are removed
+    ASSERT_EQ(1, cache.prune(true));
+    ASSERT_TRUE(lookup_LRUCache(cache, hot_key));
+    ASSERT_FALSE(lookup_LRUCache(cache, cold_key));
+    ASSERT_EQ(10, cache.get_usage());
+
+    ASSERT_EQ(1, cache.prune());
+    ASSERT_FALSE(lookup_LRUCache(cache, hot_key));
+    ASSERT_EQ(0, cache.get_usage());
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
@@ -94,4 +94,34 @@ TEST_F(StoragePageCacheTest, normal) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, compressed_tier) {
+    StoragePageCache no_tier(_mem_tracker.get(), kNumShards * 2048);
+    ASSERT_FALSE(no_tier.has_compressed_tier());
+
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 4096, kNumShardBits, 0, 0.5);
+    ASSERT_TRUE(cache.has_compressed_tier());
+
+    StoragePageCache::CacheKey key("abc", 0);
+    std::string compressed(512, 'x');
+    cache.insert_compressed(key, Slice(compressed));
+    {
+        PageCacheHandle handle;
+        ASSERT_FALSE(cache.lookup(key, &handle));
+        ASSERT_TRUE(cache.lookup_compressed(key, &handle));
+        // it's a copy of the inserted page
+        ASSERT_NE(compressed.data(), handle.data().data);
+        ASSERT_EQ(compressed, handle.data().to_string());
+    }
+
+    // the decompressed pages don't evict the compressed ones
+    for (int i = 0; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("bcd", i);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, false);
+    }
+    PageCacheHandle handle;
+    ASSERT_TRUE(cache.lookup_compressed(key, &handle));
+}
+
 } // namespace starrocks
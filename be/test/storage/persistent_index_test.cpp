@@ -4,8 +4,13 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
+#include "env/env.h"
 #include "gutil/strings/substitute.h"
+#include "testutil/assert.h"
 #include "testutil/parallel_test.h"
+#include "util/defer_op.h"
+#include "util/file_utils.h"
 
 namespace starrocks {
 
@@ -89,4 +94,83 @@ PARALLEL_TEST(PersistentIndexTest, test_mutable_index) {
     ASSERT_EQ(upsert_not_found.key_idxes.size(), expect_not_found);
 }
 
+PARALLEL_TEST(PersistentIndexTest, test_persistent_index) {
+    using Key = uint64_t;
+    const std::string kIndexDir = "./ut_dir/persistent_index_test";
+    ASSERT_TRUE(FileUtils::create_dir(kIndexDir).ok());
+    int64_t old_l0_max_keys = config::persistent_index_l0_max_keys;
+    config::persistent_index_l0_max_keys = 2000;
+    DeferOp defer([&]() {
+        config::persistent_index_l0_max_keys = old_l0_max_keys;
+        ASSERT_TRUE(FileUtils::remove_all(kIndexDir).ok());
+    });
+
+    const int N = 3000;
+    vector<Key> keys(N);
+    vector<IndexValue> values(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        values[i] = i * 2;
+    }
+    {
+        PersistentIndex index(kIndexDir);
+        ASSERT_OK(index.create(sizeof(Key), EditVersion(1, 0)));
+        // the 1st commit stays in L0, the 2nd one is merged into L1 with it
+        for (int v = 0; v < 2; v++) {
+            ASSERT_OK(index.prepare(EditVersion(v + 2, 0)));
+            vector<IndexValue> old_values(N / 2);
+            ASSERT_OK(index.upsert(N / 2, keys.data() + v * N / 2, values.data() + v * N / 2, old_values.data()));
+            for (auto old_value : old_values) {
+                ASSERT_EQ(NullIndexValue, old_value);
+            }
+            ASSERT_OK(index.commit());
+        }
+        ASSERT_EQ(N, index.size());
+
+        // modify half of the keys in L1, and erase 1/3 of them, all of these stay in L0
+        ASSERT_OK(index.prepare(EditVersion(4, 0)));
+        vector<IndexValue> new_values(N / 2);
+        vector<IndexValue> old_values(N);
+        for (int i = 0; i < N / 2; i++) {
+            new_values[i] = i * 3;
+        }
+        ASSERT_OK(index.upsert(N / 2, keys.data(), new_values.data(), old_values.data()));
+        for (int i = 0; i < N / 2; i++) {
+            ASSERT_EQ(values[i], old_values[i]);
+        }
+        vector<Key> erase_keys;
+        for (int i = 0; i < N; i += 3) {
+            erase_keys.emplace_back(i);
+        }
+        vector<IndexValue> erase_old_values(erase_keys.size());
+        ASSERT_OK(index.erase(erase_keys.size(), erase_keys.data(), erase_old_values.data()));
+        ASSERT_EQ(N - erase_keys.size(), index.size());
+        ASSERT_OK(index.commit());
+
+        // the modifications aborted are dropped
+        ASSERT_OK(index.prepare(EditVersion(5, 0)));
+        ASSERT_OK(index.erase(N, keys.data(), old_values.data()));
+        ASSERT_OK(index.abort());
+        ASSERT_EQ(N - erase_keys.size(), index.size());
+        // key exists in L1
+        ASSERT_OK(index.prepare(EditVersion(5, 0)));
+        ASSERT_FALSE(index.insert(1, keys.data() + 2000, values.data(), true).ok());
+    }
+
+    // load L1 and replay the WAL of L0
+    PersistentIndex index(kIndexDir);
+    ASSERT_OK(index.load());
+    ASSERT_EQ(EditVersion(4, 0), index.version());
+    ASSERT_EQ(N - (N + 2) / 3, index.size());
+    vector<Key> get_keys(keys);
+    get_keys.emplace_back(N);
+    vector<IndexValue> get_values(get_keys.size());
+    ASSERT_OK(index.get(get_keys.size(), get_keys.data(), get_values.data()));
+    for (int i = 0; i < N; i++) {
+        IndexValue expected = i % 3 == 0 ? NullIndexValue : (i < N / 2 ? i * 3 : i * 2);
+        ASSERT_EQ(expected, get_values[i]) << i;
+    }
+    ASSERT_EQ(NullIndexValue, get_values[N]);
+}
+
 } // namespace starrocks
@@ -287,4 +287,47 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram_varchar) {
+    std::vector<std::string> values{"https://www.starrocks.com/index.html", "Mozilla/5.0 (X11; Linux x86_64)", "ab"};
+    std::vector<Slice> slices(values.begin(), values.end());
+    std::string fname = kTestDir + "/ngram_bloom_filter_varchar";
+    ColumnIndexMetaPB meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(_block_mgr->create_block(fs::CreateBlockOptions({fname}), &wblock).ok());
+        BloomFilterOptions bf_options;
+        bf_options.gram_num = 3;
+        std::unique_ptr<BloomFilterIndexWriter> writer;
+        ASSERT_TRUE(BloomFilterIndexWriter::create(bf_options, get_type_info(OLAP_FIELD_TYPE_VARCHAR), &writer).ok());
+        // one value a page
+        for (auto& slice : slices) {
+            writer->add_values(&slice, 1);
+            ASSERT_TRUE(writer->flush().ok());
+        }
+        ASSERT_TRUE(writer->finish(wblock.get(), &meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+        ASSERT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+        ASSERT_EQ(3, meta.ngram_bloom_filter_index().gram_num());
+    }
+    BloomFilterIndexReader reader;
+    ASSERT_TRUE(reader.load(_block_mgr, fname, &meta.ngram_bloom_filter_index(), true, false).ok());
+    ASSERT_EQ(3, reader.gram_num());
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    ASSERT_TRUE(reader.new_iterator(&iter).ok());
+
+    std::unique_ptr<BloomFilter> bf;
+    ASSERT_TRUE(iter->read_bloom_filter(0, &bf).ok());
+    for (const char* gram : {"htt", "roc", "tml", "com", "/in"}) {
+        ASSERT_TRUE(bf->test_bytes(gram, 3)) << gram;
+    }
+    ASSERT_FALSE(bf->test_bytes("Moz", 3));
+    ASSERT_TRUE(iter->read_bloom_filter(1, &bf).ok());
+    ASSERT_TRUE(bf->test_bytes("Moz", 3));
+    ASSERT_TRUE(bf->test_bytes("x86", 3));
+    ASSERT_FALSE(bf->test_bytes("htt", 3));
+    // the values shorter than the n-grams add nothing
+    ASSERT_TRUE(iter->read_bloom_filter(2, &bf).ok());
+    ASSERT_FALSE(bf->test_bytes("ab", 2));
+}
+
 } // namespace starrocks
@@ -19,6 +19,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include <iostream>
@@ -28,8 +29,10 @@
 #include "column/column.h"
 #include "column/datum_convert.h"
 #include "column/fixed_length_column.h"
+#include "column/json_column.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "env/env_memory.h"
 #include "gen_cpp/segment.pb.h"
 #include "runtime/date_value.h"
@@ -47,6 +50,8 @@
 #include "storage/types.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/range.h"
+#include "util/defer_op.h"
+#include "util/json.h"
 
 using std::string;
 
@@ -558,6 +563,19 @@ TEST_F(ColumnReaderWriterTest, test_int) {
     test_numeric_types<OLAP_FIELD_TYPE_INT>();
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_int_coalesce_read) {
+    int64_t old_read_bytes = config::storage_page_coalesce_read_bytes;
+    int64_t old_gap_bytes = config::storage_page_coalesce_gap_bytes;
+    config::storage_page_coalesce_read_bytes = 64 * 1024;
+    config::storage_page_coalesce_gap_bytes = 0;
+    test_numeric_types<OLAP_FIELD_TYPE_INT>();
+    config::storage_page_coalesce_gap_bytes = 4096;
+    test_numeric_types<OLAP_FIELD_TYPE_INT>();
+    config::storage_page_coalesce_read_bytes = old_read_bytes;
+    config::storage_page_coalesce_gap_bytes = old_gap_bytes;
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_double) {
     test_numeric_types<OLAP_FIELD_TYPE_DOUBLE>();
@@ -654,6 +672,137 @@ TEST_F(ColumnReaderWriterTest, test_array_int) {
     test_int_array<2>("1");
 }
 
+TEST_F(ColumnReaderWriterTest, test_flat_json) {
+    int32_t old_sample_rows = config::json_flat_sample_rows;
+    config::json_flat_sample_rows = 1000;
+    DeferOp reset_config([&] { config::json_flat_sample_rows = old_sample_rows; });
+
+    // every 100 rows, the 98th is not an object and the 99th is null
+    const size_t num_rows = 3000;
+    auto is_object = [](size_t i) { return i % 100 < 98; };
+    auto json_data = vectorized::JsonColumn::create();
+    auto json_nulls = vectorized::NullColumn::create();
+    for (size_t i = 0; i < num_rows; i++) {
+        std::string text;
+        if (i % 100 == 98) {
+            text = "[1, 2]";
+        } else if (i % 100 == 99) {
+            text = "null";
+        } else {
+            // "rare" is in too few rows and "mixed" has mixed types
+            text = fmt::format(R"({{"id": {}, "name": "n{}", "score": {}.5, "mixed": {}{}}})", i, i % 10, i,
+                               i % 2 == 0 ? "1" : R"("a")", i % 10 == 0 ? R"(, "rare": 1)" : "");
+        }
+        auto json = JsonValue::parse(text);
+        ASSERT_TRUE(json.ok()) << text;
+        json_data->append(&json.value());
+        json_nulls->append(i % 100 == 99);
+    }
+    auto src = vectorized::NullableColumn::create(std::move(json_data), std::move(json_nulls));
+
+    ColumnMetaPB meta;
+    auto env = std::make_unique<EnvMemory>();
+    auto block_mgr = std::make_unique<fs::FileBlockManager>(env.get(), fs::BlockManagerOptions());
+    ASSERT_TRUE(env->create_dir(TEST_DIR).ok());
+    const std::string fname = strings::Substitute("$0/test_flat_json.data", TEST_DIR);
+
+    // write data
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({fname});
+        Status st = block_mgr->create_block(opts, &wblock);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = &meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(OLAP_FIELD_TYPE_JSON);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(DEFAULT_ENCODING);
+        writer_opts.meta->set_compression(starrocks::LZ4_FRAME);
+        writer_opts.meta->set_is_nullable(true);
+        writer_opts.meta->mutable_json_meta()->set_format_version(kJsonMetaDefaultFormatVersion);
+        writer_opts.need_flat_json = true;
+
+        TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_JSON, true);
+        std::unique_ptr<ColumnWriter> writer;
+        ASSERT_TRUE(ColumnWriter::create(writer_opts, &column, wblock.get(), &writer).ok());
+        ASSERT_TRUE(writer->init().ok());
+        // the fields are detected once the first 1000 rows are buffered
+        for (size_t offset = 0; offset < num_rows; offset += 600) {
+            auto chunk = src->clone_empty();
+            chunk->append(*src, offset, std::min<size_t>(600, num_rows - offset));
+            ASSERT_TRUE(writer->append(*chunk).ok());
+        }
+        ASSERT_TRUE(writer->finish().ok());
+        ASSERT_TRUE(writer->write_data().ok());
+        ASSERT_TRUE(writer->write_ordinal_index().ok());
+        ASSERT_TRUE(writer->write_zone_map().ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    ASSERT_EQ(3, meta.json_meta().flat_fields_size());
+    ASSERT_EQ("id", meta.json_meta().flat_fields(0));
+    ASSERT_EQ("name", meta.json_meta().flat_fields(1));
+    ASSERT_EQ("score", meta.json_meta().flat_fields(2));
+    ASSERT_EQ(3, meta.children_columns_size());
+
+    // read and check
+    {
+        std::unique_ptr<MemTracker> page_cache_mem_tracker = std::make_unique<MemTracker>();
+        StoragePageCache::create_global_cache(page_cache_mem_tracker.get(), 1000000000);
+        ColumnReaderOptions reader_opts;
+        reader_opts.block_mgr = block_mgr.get();
+        auto res = ColumnReader::create(_tablet_meta_mem_tracker.get(), reader_opts, &meta, fname);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        auto reader = std::move(res).value();
+        ASSERT_EQ(num_rows, reader->num_rows());
+        ASSERT_EQ(nullptr, reader->flat_json_reader("rare"));
+        ASSERT_EQ(nullptr, reader->flat_json_reader("mixed"));
+
+        std::unique_ptr<fs::ReadableBlock> rblock;
+        ASSERT_TRUE(block_mgr->open_block(fname, &rblock).ok());
+        OlapReaderStatistics stats;
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = &stats;
+        iter_opts.rblock = rblock.get();
+
+        auto read_field = [&](const std::string& name, FieldType type) -> vectorized::ColumnPtr {
+            ColumnReader* flat_reader = reader->flat_json_reader(name);
+            EXPECT_NE(nullptr, flat_reader);
+            EXPECT_EQ(type, flat_reader->column_type());
+            EXPECT_TRUE(flat_reader->has_zone_map());
+            ColumnIterator* iter = nullptr;
+            EXPECT_TRUE(flat_reader->new_iterator(&iter).ok());
+            std::unique_ptr<ColumnIterator> guard(iter);
+            EXPECT_TRUE(iter->init(iter_opts).ok());
+            EXPECT_TRUE(iter->seek_to_first().ok());
+            vectorized::ColumnPtr dst = vectorized::ChunkHelper::column_from_field_type(type, true);
+            size_t rows_read = num_rows;
+            EXPECT_TRUE(iter->next_batch(&rows_read, dst.get()).ok());
+            EXPECT_EQ(num_rows, rows_read);
+            return dst;
+        };
+
+        auto ids = read_field("id", OLAP_FIELD_TYPE_BIGINT);
+        auto names = read_field("name", OLAP_FIELD_TYPE_VARCHAR);
+        auto scores = read_field("score", OLAP_FIELD_TYPE_DOUBLE);
+        for (size_t i = 0; i < num_rows; i++) {
+            if (!is_object(i)) {
+                ASSERT_TRUE(ids->is_null(i));
+                ASSERT_TRUE(names->is_null(i));
+                ASSERT_TRUE(scores->is_null(i));
+                continue;
+            }
+            ASSERT_EQ(static_cast<int64_t>(i), ids->get(i).get_int64());
+            ASSERT_EQ(fmt::format("n{}", i % 10), names->get(i).get_slice().to_string());
+            ASSERT_DOUBLE_EQ(i + 0.5, scores->get(i).get_double());
+        }
+        ASSERT_EQ("2997", reader->flat_json_reader("id")->segment_zone_map()->max());
+    }
+}
+
 TEST_F(ColumnReaderWriterTest, test_scalar_column_total_mem_footprint) {
     auto col = vectorized::ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, true);
     size_t count = 1024;
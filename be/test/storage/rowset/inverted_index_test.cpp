@@ -0,0 +1,171 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "env/env_memory.h"
+#include "runtime/mem_tracker.h"
+#include "storage/fs/file_block_manager.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/inverted_index_reader.h"
+#include "storage/rowset/inverted_index_tokenizer.h"
+#include "storage/rowset/inverted_index_writer.h"
+#include "storage/types.h"
+
+namespace starrocks {
+
+class InvertedIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "/inverted_index_test";
+
+protected:
+    void SetUp() override {
+        StoragePageCache::create_global_cache(&_tracker, 1000000000);
+        _env = new EnvMemory();
+        _block_mgr = new fs::FileBlockManager(_env, fs::BlockManagerOptions());
+        ASSERT_TRUE(_env->create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        StoragePageCache::release_global_cache();
+        delete _block_mgr;
+        delete _env;
+    }
+
+    void write_index_file(const std::string& filename, const std::vector<std::string>& values, size_t null_count,
+                          ColumnIndexMetaPB* meta) {
+        std::vector<Slice> slices(values.begin(), values.end());
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({filename});
+        ASSERT_TRUE(_block_mgr->create_block(opts, &wblock).ok());
+
+        std::unique_ptr<InvertedIndexWriter> writer;
+        ASSERT_TRUE(InvertedIndexWriter::create(get_type_info(OLAP_FIELD_TYPE_VARCHAR), &writer).ok());
+        writer->add_nulls(null_count);
+        writer->add_values(slices.data(), slices.size());
+        ASSERT_TRUE(writer->finish(wblock.get(), meta).ok());
+        ASSERT_EQ(INVERTED_INDEX, meta->type());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    void get_reader_iter(const std::string& filename, const ColumnIndexMetaPB& meta,
+                         std::unique_ptr<InvertedIndexReader>* reader, std::unique_ptr<InvertedIndexIterator>* iter) {
+        *reader = std::make_unique<InvertedIndexReader>();
+        ASSERT_TRUE((*reader)->load(_block_mgr, filename, &meta.inverted_index(), true, false).ok());
+        InvertedIndexIterator* raw_iter = nullptr;
+        ASSERT_TRUE((*reader)->new_iterator(&raw_iter).ok());
+        iter->reset(raw_iter);
+    }
+
+    EnvMemory* _env = nullptr;
+    fs::FileBlockManager* _block_mgr = nullptr;
+    MemTracker _tracker;
+};
+
+TEST_F(InvertedIndexTest, test_tokenize) {
+    std::vector<std::string> terms;
+    std::vector<std::pair<size_t, size_t>> offsets;
+    InvertedIndexTokenizer::tokenize("  GET /Index.html?id=42 ", [&](const Slice& term, size_t begin, size_t end) {
+        terms.emplace_back(term.to_string());
+        offsets.emplace_back(begin, end);
+    });
+    ASSERT_EQ((std::vector<std::string>{"get", "index", "html", "id", "42"}), terms);
+    ASSERT_EQ(std::make_pair<size_t, size_t>(2, 5), offsets[0]);
+    ASSERT_EQ(std::make_pair<size_t, size_t>(21, 23), offsets[4]);
+
+    terms.clear();
+    InvertedIndexTokenizer::tokenize(std::string(300, 'A'),
+                                     [&](const Slice& term, size_t, size_t) { terms.emplace_back(term.to_string()); });
+    ASSERT_EQ(1, terms.size());
+    ASSERT_EQ(std::string(InvertedIndexTokenizer::kMaxTermLength, 'a'), terms[0]);
+}
+
+TEST_F(InvertedIndexTest, test_match) {
+    std::vector<std::string> values{"GET /index.html", "POST /login", "GET /login", "error: disk is full"};
+    std::string filename = kTestDir + "/match";
+    ColumnIndexMetaPB meta;
+    // the index starts with 2 null rows
+    write_index_file(filename, values, 2, &meta);
+
+    std::unique_ptr<InvertedIndexReader> reader;
+    std::unique_ptr<InvertedIndexIterator> iter;
+    get_reader_iter(filename, meta, &reader, &iter);
+    ASSERT_EQ(9, iter->num_terms());
+
+    Roaring rows;
+    ASSERT_TRUE(iter->read_term("login", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(2, 3, 4), rows);
+    ASSERT_TRUE(iter->read_term("put", &rows).ok());
+    ASSERT_TRUE(rows.isEmpty());
+    ASSERT_TRUE(iter->read_term("zzz", &rows).ok());
+    ASSERT_TRUE(rows.isEmpty());
+
+    ASSERT_TRUE(iter->match("Get LOGIN", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(1, 4), rows);
+    ASSERT_TRUE(iter->match("get post", &rows).ok());
+    ASSERT_TRUE(rows.isEmpty());
+    ASSERT_TRUE(iter->match(" / ", &rows).is_invalid_argument());
+
+    ASSERT_TRUE(iter->read_prefix("i", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(2, 2, 5), rows);
+    ASSERT_TRUE(iter->read_prefix("pos", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(1, 3), rows);
+}
+
+TEST_F(InvertedIndexTest, test_match_like) {
+    std::vector<std::string> values{"GET /index.html", "POST /login", "GET /login", "error: disk is full"};
+    std::string filename = kTestDir + "/like";
+    ColumnIndexMetaPB meta;
+    write_index_file(filename, values, 0, &meta);
+
+    std::unique_ptr<InvertedIndexReader> reader;
+    std::unique_ptr<InvertedIndexIterator> iter;
+    get_reader_iter(filename, meta, &reader, &iter);
+
+    Roaring rows;
+    ASSERT_TRUE(iter->match_like("%login%", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(2, 1, 2), rows);
+    // 'GET' is at the start, and 'log' is a prefix
+    ASSERT_TRUE(iter->match_like("GET /log%", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(1, 2), rows);
+    // 'ror' is in the middle of a term
+    ASSERT_TRUE(iter->match_like("%ror: disk%", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(1, 3), rows);
+    // the matching is case-insensitive, the rows are a superset
+    ASSERT_TRUE(iter->match_like("%Html", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(1, 0), rows);
+    ASSERT_TRUE(iter->match_like("%logout%", &rows).ok());
+    ASSERT_TRUE(rows.isEmpty());
+    ASSERT_TRUE(iter->match_like("%/%", &rows).is_cancelled());
+}
+
+TEST_F(InvertedIndexTest, test_many_terms) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 10000; i++) {
+        values.emplace_back("row" + std::to_string(i) + " common");
+    }
+    std::string filename = kTestDir + "/many";
+    ColumnIndexMetaPB meta;
+    write_index_file(filename, values, 0, &meta);
+
+    std::unique_ptr<InvertedIndexReader> reader;
+    std::unique_ptr<InvertedIndexIterator> iter;
+    get_reader_iter(filename, meta, &reader, &iter);
+    ASSERT_EQ(10001, iter->num_terms());
+
+    Roaring rows;
+    ASSERT_TRUE(iter->read_term("row9999", &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(1, 9999), rows);
+    ASSERT_TRUE(iter->read_term("common", &rows).ok());
+    ASSERT_EQ(10000, rows.cardinality());
+    // the prefix and the dictionary scans span many batches and pages
+    ASSERT_TRUE(iter->read_prefix("row1", &rows).ok());
+    ASSERT_EQ(1111, rows.cardinality());
+    ASSERT_TRUE(iter->match_like("row12%", &rows).ok());
+    ASSERT_EQ(111, rows.cardinality());
+    ASSERT_TRUE(iter->match_like("%w999%", &rows).ok());
+    ASSERT_EQ(11, rows.cardinality());
+}
+
+} // namespace starrocks
@@ -0,0 +1,222 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "common/config.h"
+#include "storage/rowset/adaptive_page.h"
+#include "storage/rowset/delta_page.h"
+#include "storage/rowset/gorilla_page.h"
+#include "storage/rowset/storage_page_decoder.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+class NumericPageTest : public testing::Test {
+public:
+    template <FieldType Type, class PageBuilderType, class PageDecoderType>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src, NumericPageMode mode) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        PageBuilderType page_builder(builder_options);
+        size_t added = page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        ASSERT_EQ(src.size(), added);
+        ASSERT_EQ(src.size(), page_builder.count());
+        OwnedSlice s = page_builder.finish()->build();
+        ASSERT_EQ(static_cast<uint8_t>(mode), s.slice().data[0]);
+        ASSERT_LE(s.slice().size, NUMERIC_PAGE_HEADER_SIZE + src.size() * sizeof(CppType));
+
+        PageDecoderOptions decoder_options;
+        PageDecoderType page_decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(page_decoder.init().ok());
+        ASSERT_EQ(src.size(), page_decoder.count());
+
+        auto dst = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_TRUE(page_decoder.next_batch(&n, dst.get()).ok());
+        ASSERT_EQ(src.size(), n);
+        const auto* values = reinterpret_cast<const CppType*>(dst->raw_data());
+        for (size_t i = 0; i < src.size(); i++) {
+            // compare the bits, for the NaNs of the doubles
+            ASSERT_EQ(0, memcmp(&src[i], &values[i], sizeof(CppType))) << "row " << i;
+        }
+
+        // read a range after seeking
+        if (src.size() > 10) {
+            ASSERT_TRUE(page_decoder.seek_to_position_in_page(5).ok());
+            auto range_dst = vectorized::ChunkHelper::column_from_field_type(Type, false);
+            vectorized::SparseRange range;
+            range.add(vectorized::Range(5, 8));
+            range.add(vectorized::Range(src.size() - 2, src.size()));
+            ASSERT_TRUE(page_decoder.next_batch(range, range_dst.get()).ok());
+            ASSERT_EQ(5, range_dst->size());
+            const auto* range_values = reinterpret_cast<const CppType*>(range_dst->raw_data());
+            ASSERT_EQ(0, memcmp(&src[5], range_values, 3 * sizeof(CppType)));
+            ASSERT_EQ(0, memcmp(&src[src.size() - 2], range_values + 3, 2 * sizeof(CppType)));
+        }
+    }
+
+    template <FieldType Type>
+    void test_delta(const std::vector<typename TypeTraits<Type>::CppType>& src, NumericPageMode mode) {
+        test_encode_decode<Type, DeltaPageBuilder<Type>, DeltaPageDecoder<Type>>(src, mode);
+    }
+
+    template <FieldType Type>
+    void test_gorilla(const std::vector<typename TypeTraits<Type>::CppType>& src, NumericPageMode mode) {
+        test_encode_decode<Type, GorillaPageBuilder<Type>, GorillaPageDecoder<Type>>(src, mode);
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(NumericPageTest, test_delta_of_delta) {
+    // the intervals of the timestamps grow steadily
+    std::vector<int64_t> timestamps;
+    int64_t ts = 1634000000000000L;
+    for (int i = 0; i < 10000; i++) {
+        ts += 1000000 + i * 3;
+        timestamps.push_back(ts);
+    }
+    test_delta<OLAP_FIELD_TYPE_BIGINT>(timestamps, NumericPageMode::DELTA_OF_DELTA);
+    test_delta<OLAP_FIELD_TYPE_TIMESTAMP>(timestamps, NumericPageMode::DELTA_OF_DELTA);
+}
+
+// NOLINTNEXTLINE
+TEST_F(NumericPageTest, test_delta) {
+    // the random increments are smaller by the deltas than by the deltas of the deltas
+    std::mt19937 rng(1);
+    std::vector<int32_t> values;
+    int32_t v = -1000;
+    for (int i = 0; i < 1000; i++) {
+        v += rng() % 16;
+        values.push_back(v);
+    }
+    test_delta<OLAP_FIELD_TYPE_INT>(values, NumericPageMode::DELTA);
+
+    test_delta<OLAP_FIELD_TYPE_INT>({7}, NumericPageMode::PLAIN);
+    test_delta<OLAP_FIELD_TYPE_INT>({}, NumericPageMode::PLAIN);
+    std::vector<int32_t> same(300, 42);
+    test_delta<OLAP_FIELD_TYPE_INT>(same, NumericPageMode::DELTA);
+
+    std::vector<int8_t> bytes;
+    for (int i = 0; i < 1000; i++) {
+        bytes.push_back(static_cast<int8_t>(i / 10 - 50));
+    }
+    test_delta<OLAP_FIELD_TYPE_TINYINT>(bytes, NumericPageMode::DELTA);
+}
+
+// NOLINTNEXTLINE
+TEST_F(NumericPageTest, test_delta_fallback) {
+    // the deltas of the extreme values overflow, and the random values aren't smaller by the deltas
+    std::mt19937_64 rng(2);
+    std::vector<int64_t> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i % 2 == 0 ? std::numeric_limits<int64_t>::min() : static_cast<int64_t>(rng()));
+    }
+    test_delta<OLAP_FIELD_TYPE_BIGINT>(values, NumericPageMode::PLAIN);
+}
+
+// NOLINTNEXTLINE
+TEST_F(NumericPageTest, test_gorilla) {
+    std::vector<double> metrics;
+    for (int i = 0; i < 5000; i++) {
+        metrics.push_back(i % 10 < 7 ? 36.5 : 36.5 + (i % 3) * 0.25);
+    }
+    metrics.push_back(std::nan(""));
+    metrics.push_back(-0.0);
+    metrics.push_back(std::numeric_limits<double>::max());
+    test_gorilla<OLAP_FIELD_TYPE_DOUBLE>(metrics, NumericPageMode::GORILLA);
+
+    std::vector<float> floats;
+    for (int i = 0; i < 5000; i++) {
+        floats.push_back(static_cast<float>(i / 100));
+    }
+    test_gorilla<OLAP_FIELD_TYPE_FLOAT>(floats, NumericPageMode::GORILLA);
+
+    // the random bits aren't smaller
+    std::mt19937_64 rng(3);
+    std::vector<double> randoms;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t bits = rng();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        randoms.push_back(d);
+    }
+    test_gorilla<OLAP_FIELD_TYPE_DOUBLE>(randoms, NumericPageMode::PLAIN);
+}
+
+// NOLINTNEXTLINE
+TEST_F(NumericPageTest, test_adaptive) {
+    auto test_adaptive = [](const std::vector<int64_t>& src, EncodingTypePB* chosen) {
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        AdaptivePageBuilder<OLAP_FIELD_TYPE_BIGINT> page_builder(builder_options);
+        ASSERT_EQ(src.size(), page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size()));
+        OwnedSlice s = page_builder.finish()->build();
+        *chosen = static_cast<EncodingTypePB>(decode_fixed32_le(reinterpret_cast<const uint8_t*>(s.slice().data)));
+
+        // the bitshuffle pages are decompressed when they are read
+        Slice data = s.slice();
+        std::unique_ptr<char[]> page;
+        PageFooterPB footer;
+        footer.set_type(DATA_PAGE);
+        footer.mutable_data_page_footer()->set_nullmap_size(0);
+        ASSERT_TRUE(StoragePageDecoder::decode_page(&footer, 0, ADAPTIVE_ENCODING, &page, &data).ok());
+
+        AdaptivePageDecoder<OLAP_FIELD_TYPE_BIGINT> page_decoder(data, PageDecoderOptions());
+        ASSERT_TRUE(page_decoder.init().ok());
+        ASSERT_EQ(*chosen, page_decoder.page_encoding_type());
+        ASSERT_EQ(src.size(), page_decoder.count());
+        auto dst = vectorized::ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_BIGINT, false);
+        size_t n = src.size();
+        ASSERT_TRUE(page_decoder.next_batch(&n, dst.get()).ok());
+        ASSERT_EQ(src.size(), n);
+        ASSERT_EQ(0, memcmp(src.data(), dst->raw_data(), src.size() * sizeof(int64_t)));
+    };
+
+    std::vector<int64_t> timestamps;
+    int64_t ts = 1634000000000000L;
+    for (int i = 0; i < 20000; i++) {
+        ts += 1000000 + i * 3;
+        timestamps.push_back(ts);
+    }
+    EncodingTypePB chosen;
+    test_adaptive(timestamps, &chosen);
+    ASSERT_EQ(DELTA_ENCODING, chosen);
+
+    // the small random values aren't smaller by the deltas
+    std::mt19937_64 rng(4);
+    std::vector<int64_t> values;
+    for (int i = 0; i < 20000; i++) {
+        values.push_back(static_cast<int64_t>(rng() % 1000));
+    }
+    test_adaptive(values, &chosen);
+    ASSERT_TRUE(chosen == FOR_ENCODING || chosen == BIT_SHUFFLE) << chosen;
+
+    // the cost of the decoding outweighs the size
+    double old_weight = config::adaptive_encoding_decode_cost_weight;
+    config::adaptive_encoding_decode_cost_weight = 1000;
+    test_adaptive(values, &chosen);
+    ASSERT_EQ(PLAIN_ENCODING, chosen);
+    config::adaptive_encoding_decode_cost_weight = old_weight;
+}
+
+// NOLINTNEXTLINE
+TEST_F(NumericPageTest, test_corruption) {
+    std::vector<int32_t> values(1000, 1);
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    DeltaPageBuilder<OLAP_FIELD_TYPE_INT> page_builder(options);
+    page_builder.add(reinterpret_cast<const uint8_t*>(values.data()), values.size());
+    OwnedSlice s = page_builder.finish()->build();
+    // the count of the values is larger than the values in the page
+    Slice data = s.slice();
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(data.data) + 1, 100000);
+    DeltaPageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(data, PageDecoderOptions());
+    ASSERT_FALSE(page_decoder.init().ok());
+}
+
+} // namespace starrocks
@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of decoding a page of int values into a column, for the plain, bitshuffle and frame of reference
+// encodings.
+// Usage: page_decoder_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "gen_cpp/segment.pb.h"
+#include "storage/rowset/bitshuffle_page.h"
+#include "storage/rowset/frame_of_reference_page.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/plain_page.h"
+#include "storage/rowset/storage_page_decoder.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+static constexpr size_t kPageSize = 64 * 1024;
+static constexpr size_t kNumValues = kPageSize / sizeof(int32_t);
+
+// The values are below |max_value|, the smaller the better the bitshuffle and the frame of reference compress.
+template <class PageBuilderType>
+static OwnedSlice build_page(int32_t max_value) {
+    std::mt19937 rng(max_value);
+    std::vector<int32_t> values(kNumValues);
+    for (auto& value : values) {
+        value = static_cast<int32_t>(rng() % max_value);
+    }
+    PageBuilderOptions options;
+    options.data_page_size = kPageSize;
+    PageBuilderType page_builder(options);
+    page_builder.add(reinterpret_cast<const uint8_t*>(values.data()), values.size());
+    return page_builder.finish()->build();
+}
+
+template <class PageBuilderType, class PageDecoderType, EncodingTypePB encoding>
+static void run_page_decoder(benchmark::State& state) {
+    OwnedSlice page = build_page<PageBuilderType>(state.range(0));
+    auto column = vectorized::ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, false);
+    column->reserve(kNumValues);
+    PageDecoderOptions decoder_options;
+    for (auto _ : state) {
+        Slice data = page.slice();
+        // the bitshuffle page is decoded into a plain page first, as the ColumnReader does
+        std::unique_ptr<char[]> decoded_page;
+        if constexpr (encoding == BIT_SHUFFLE) {
+            PageFooterPB footer;
+            footer.set_type(DATA_PAGE);
+            footer.mutable_data_page_footer()->set_nullmap_size(0);
+            (void)StoragePageDecoder::decode_page(&footer, 0, encoding, &decoded_page, &data);
+        }
+        PageDecoderType page_decoder(data, decoder_options);
+        (void)page_decoder.init();
+        column->reset_column();
+        size_t n = kNumValues;
+        (void)page_decoder.next_batch(&n, column.get());
+        benchmark::DoNotOptimize(column->raw_data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumValues);
+    state.counters["page_bytes"] = page.slice().size;
+}
+
+static void BM_decode_plain(benchmark::State& state) {
+    run_page_decoder<PlainPageBuilder<OLAP_FIELD_TYPE_INT>, PlainPageDecoder<OLAP_FIELD_TYPE_INT>, PLAIN_ENCODING>(
+            state);
+}
+
+static void BM_decode_bitshuffle(benchmark::State& state) {
+    run_page_decoder<BitshufflePageBuilder<OLAP_FIELD_TYPE_INT>, BitShufflePageDecoder<OLAP_FIELD_TYPE_INT>,
+                     BIT_SHUFFLE>(state);
+}
+
+static void BM_decode_frame_of_reference(benchmark::State& state) {
+    run_page_decoder<FrameOfReferencePageBuilder<OLAP_FIELD_TYPE_INT>,
+                     FrameOfReferencePageDecoder<OLAP_FIELD_TYPE_INT>, FOR_ENCODING>(state);
+}
+
+// The values of 8, 16 and 31 bits.
+BENCHMARK(BM_decode_plain)->Arg(1 << 8)->Arg(1 << 16)->Arg(INT32_MAX);
+BENCHMARK(BM_decode_bitshuffle)->Arg(1 << 8)->Arg(1 << 16)->Arg(INT32_MAX);
+BENCHMARK(BM_decode_frame_of_reference)->Arg(1 << 8)->Arg(1 << 16)->Arg(INT32_MAX);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
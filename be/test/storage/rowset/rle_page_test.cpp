@@ -197,6 +197,19 @@ TEST_F(RlePageTest, TestRleInt32BlockEncoderEqual) {
     test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints.get(), size);
 }
 
+TEST_F(RlePageTest, TestRleInt32BlockEncoderRuns) {
+    const uint32_t size = 10000;
+
+    // Runs of different lengths mixed with literals, the sparse ranges start and end within the runs.
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        ints.get()[i] = (i / 500) % 2 == 0 ? i / (7 + i / 1000) : i;
+    }
+
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints.get(), size);
+    test_encode_decode_page_vectorized<OLAP_FIELD_TYPE_INT>(ints.get(), size);
+}
+
 TEST_F(RlePageTest, TestRleInt32BlockEncoderSequence) {
     const uint32_t size = 10000;
 
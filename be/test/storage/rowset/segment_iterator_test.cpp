@@ -319,4 +319,202 @@ TEST_F(SegmentIteratorTest, TestGlobalDictNoLocalDict) {
     res_chunk->reset();
 }
 
+TEST_F(SegmentIteratorTest, TestRowidRange) {
+    TabletColumn c1 = create_int_key(1);
+    TabletSchema tablet_schema = create_schema({c1});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    std::string file_name = kSegmentDir + "/rowid_range";
+    std::unique_ptr<fs::WritableBlock> wblock;
+    fs::CreateBlockOptions wblock_opts({file_name});
+    ASSERT_OK(_block_mgr->create_block(wblock_opts, &wblock));
+
+    SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+    ASSERT_OK(writer.init());
+
+    const int32_t num_rows = 4096;
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+    for (int32_t i = 0; i < num_rows; ++i) {
+        chunk->columns()[0]->append_datum(vectorized::Datum(i));
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+    uint64_t file_size, index_size, footer_position;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+    auto segment = *Segment::open(_tablet_meta_mem_tracker.get(), _block_mgr, file_name, 0, &tablet_schema);
+    ASSERT_EQ(num_rows, segment->num_rows());
+
+    OlapReaderStatistics stats;
+    vectorized::SegmentReadOptions seg_opts;
+    seg_opts.block_mgr = _block_mgr;
+    seg_opts.stats = &stats;
+    seg_opts.rowid_range = vectorized::Range(1500, 2700);
+
+    auto chunk_iter = new_segment_iterator(segment, schema, seg_opts);
+    vectorized::ColumnIdToGlobalDictMap dict_map;
+    ASSERT_OK(chunk_iter->init_encoded_schema(dict_map));
+    ASSERT_OK(chunk_iter->init_output_schema(std::unordered_set<uint32_t>()));
+
+    auto res_chunk = vectorized::ChunkHelper::new_chunk(chunk_iter->output_schema(), config::vector_chunk_size);
+    int32_t expected = 1500;
+    while (true) {
+        res_chunk->reset();
+        auto st = chunk_iter->get_next(res_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (size_t i = 0; i < res_chunk->num_rows(); ++i) {
+            ASSERT_EQ(expected++, res_chunk->get_column_by_index(0)->get(i).get_int32());
+        }
+    }
+    ASSERT_EQ(2700, expected);
+}
+
+TEST_F(SegmentIteratorTest, TestManySeekRanges) {
+    TabletColumn c1 = create_int_key(1);
+    TabletSchema tablet_schema = create_schema({c1});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    std::string file_name = kSegmentDir + "/many_seek_ranges";
+    std::unique_ptr<fs::WritableBlock> wblock;
+    fs::CreateBlockOptions wblock_opts({file_name});
+    ASSERT_OK(_block_mgr->create_block(wblock_opts, &wblock));
+
+    SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+    ASSERT_OK(writer.init());
+
+    // every key is of two rows
+    const int32_t num_rows = 4096;
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+    for (int32_t i = 0; i < num_rows; ++i) {
+        chunk->columns()[0]->append_datum(vectorized::Datum(i / 2));
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+    uint64_t file_size, index_size, footer_position;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+    auto segment = *Segment::open(_tablet_meta_mem_tracker.get(), _block_mgr, file_name, 0, &tablet_schema);
+    ASSERT_EQ(num_rows, segment->num_rows());
+
+    OlapReaderStatistics stats;
+    vectorized::SegmentReadOptions seg_opts;
+    seg_opts.block_mgr = _block_mgr;
+    seg_opts.stats = &stats;
+    // unordered and duplicated point ranges, a missing key and a range without lower bound
+    std::vector<int32_t> keys{1500, 3, 700, 3, 2047, 701, 5000};
+    for (int32_t key : keys) {
+        vectorized::SeekTuple tuple(schema, {vectorized::Datum(key)});
+        vectorized::SeekRange range(tuple, tuple);
+        range.set_inclusive_lower(true);
+        range.set_inclusive_upper(true);
+        seg_opts.ranges.emplace_back(std::move(range));
+    }
+    seg_opts.ranges.emplace_back(vectorized::SeekTuple(), vectorized::SeekTuple(schema, {vectorized::Datum(2)}));
+
+    auto chunk_iter = new_segment_iterator(segment, schema, seg_opts);
+    vectorized::ColumnIdToGlobalDictMap dict_map;
+    ASSERT_OK(chunk_iter->init_encoded_schema(dict_map));
+    ASSERT_OK(chunk_iter->init_output_schema(std::unordered_set<uint32_t>()));
+
+    std::vector<int32_t> expected{0, 0, 1, 1, 3, 3, 700, 700, 701, 701, 1500, 1500, 2047, 2047};
+    std::vector<int32_t> actual;
+    auto res_chunk = vectorized::ChunkHelper::new_chunk(chunk_iter->output_schema(), config::vector_chunk_size);
+    while (true) {
+        res_chunk->reset();
+        auto st = chunk_iter->get_next(res_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (size_t i = 0; i < res_chunk->num_rows(); ++i) {
+            actual.emplace_back(res_chunk->get_column_by_index(0)->get(i).get_int32());
+        }
+    }
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(num_rows - expected.size(), stats.rows_key_range_filtered);
+}
+
+TEST_F(SegmentIteratorTest, TestColumnReadStatistics) {
+    TabletColumn c1 = create_int_key(1);
+    TabletColumn c2 = create_int_value(2);
+    TabletSchema tablet_schema = create_schema({c1, c2});
+
+    SegmentWriterOptions opts;
+    std::string file_name = kSegmentDir + "/column_read_statistics";
+    std::unique_ptr<fs::WritableBlock> wblock;
+    fs::CreateBlockOptions wblock_opts({file_name});
+    ASSERT_OK(_block_mgr->create_block(wblock_opts, &wblock));
+
+    SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+    ASSERT_OK(writer.init());
+
+    // many data pages of each column, so the zone map of c2 prunes some of them
+    const int32_t num_rows = 100000;
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+    for (int32_t i = 0; i < num_rows; ++i) {
+        chunk->columns()[0]->append_datum(vectorized::Datum(i));
+        chunk->columns()[1]->append_datum(vectorized::Datum(i));
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+    uint64_t file_size, index_size, footer_position;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+    auto segment = *Segment::open(_tablet_meta_mem_tracker.get(), _block_mgr, file_name, 0, &tablet_schema);
+
+    ObjectPool pool;
+    OlapReaderStatistics stats;
+    vectorized::SegmentReadOptions seg_opts;
+    seg_opts.block_mgr = _block_mgr;
+    seg_opts.stats = &stats;
+    seg_opts.predicates[1].push_back(
+            pool.add(vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, Slice("1000"))));
+
+    auto chunk_iter = new_segment_iterator(segment, schema, seg_opts);
+    vectorized::ColumnIdToGlobalDictMap dict_map;
+    ASSERT_OK(chunk_iter->init_encoded_schema(dict_map));
+    ASSERT_OK(chunk_iter->init_output_schema(std::unordered_set<uint32_t>()));
+
+    auto res_chunk = vectorized::ChunkHelper::new_chunk(chunk_iter->output_schema(), config::vector_chunk_size);
+    size_t num_read = 0;
+    while (true) {
+        res_chunk->reset();
+        auto st = chunk_iter->get_next(res_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        num_read += res_chunk->num_rows();
+    }
+    ASSERT_EQ(1000, num_read);
+
+    ASSERT_EQ(2, stats.column_stats.size());
+    int64_t compressed_bytes_read = 0;
+    int64_t total_pages_num = 0;
+    for (const auto& [cid, column_stats] : stats.column_stats) {
+        ASSERT_GT(column_stats.compressed_bytes_read, 0);
+        ASSERT_GT(column_stats.total_pages_num, 0);
+        int64_t bytes_by_encoding = 0;
+        for (auto bytes : column_stats.compressed_bytes_read_by_encoding) {
+            bytes_by_encoding += bytes;
+        }
+        ASSERT_EQ(column_stats.compressed_bytes_read, bytes_by_encoding);
+        compressed_bytes_read += column_stats.compressed_bytes_read;
+        total_pages_num += column_stats.total_pages_num;
+    }
+    ASSERT_EQ(stats.compressed_bytes_read, compressed_bytes_read);
+    ASSERT_EQ(stats.total_pages_num, total_pages_num);
+    // only the predicate column prunes the rows
+    ASSERT_EQ(0, stats.column_stats[0].rows_stats_filtered);
+    ASSERT_GT(stats.column_stats[1].rows_stats_filtered, 0);
+    ASSERT_EQ(stats.rows_stats_filtered, stats.column_stats[1].rows_stats_filtered);
+}
+
 } // namespace starrocks
@@ -0,0 +1,302 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// End-to-end benchmark of scanning a synthetic segment with the SegmentIterator, from the pages of the file to the
+// chunks, for the cardinality and the sortedness of the data, the encodings, the selectivity of a predicate, the
+// number of the projected columns, the page cache and the number of the concurrent scans.
+// The segments are kept in memory, set SEGMENT_SCAN_BENCH_DIR to write them into a directory of the disk instead.
+// Usage: segment_scan_bench [--benchmark_filter=...] [--benchmark_format=json] [--benchmark_out=<file>]
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <tuple>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "common/statusor.h"
+#include "env/env_memory.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
+#include "storage/fs/file_block_manager.h"
+#include "storage/olap_common.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/segment.h"
+#include "storage/rowset/segment_writer.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks {
+
+static constexpr uint32_t kNumRows = 1 << 20;
+static constexpr size_t kPageCacheCapacity = 4UL << 30;
+
+// The columns are c0 INT key, c1 INT, c2 VARCHAR and c3 BIGINT, the predicate is on c1.
+static constexpr ColumnId kPredicateColumn = 1;
+// The projected columns are the first ones of this order, so the predicate column is always read.
+static const std::vector<ColumnId> kProjectionOrder{1, 0, 2, 3};
+
+struct SegmentConfig {
+    // The number of the distinct values of c1 and c2.
+    int64_t cardinality;
+    // Whether the rows are sorted by c0 and c1, so that the zone maps prune the pages.
+    bool sorted;
+    // Whether the numeric columns use the adaptive encodings instead of the default ones.
+    bool adaptive_encoding;
+
+    bool operator<(const SegmentConfig& rhs) const {
+        return std::tie(cardinality, sorted, adaptive_encoding) <
+               std::tie(rhs.cardinality, rhs.sorted, rhs.adaptive_encoding);
+    }
+};
+
+// The generated segments, shared by all the benchmarks and the threads of the same config.
+class SegmentGenerator {
+public:
+    SegmentGenerator() {
+        if (const char* dir = std::getenv("SEGMENT_SCAN_BENCH_DIR"); dir != nullptr) {
+            _env = Env::Default();
+            _dir = dir;
+        } else {
+            _owned_env = std::make_unique<EnvMemory>();
+            _env = _owned_env.get();
+            _dir = "/segment_scan_bench";
+        }
+        CHECK(_env->create_dir_if_missing(_dir).ok());
+        _block_mgr = std::make_unique<fs::FileBlockManager>(_env, fs::BlockManagerOptions());
+        _tablet_schema = create_tablet_schema();
+    }
+
+    static SegmentGenerator* instance() {
+        static SegmentGenerator generator;
+        return &generator;
+    }
+
+    StatusOr<SegmentSharedPtr> get_or_create(const SegmentConfig& config) {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto iter = _segments.find(config);
+        if (iter != _segments.end()) {
+            return iter->second;
+        }
+        ASSIGN_OR_RETURN(auto segment, create_segment(config));
+        _segments.emplace(config, segment);
+        return segment;
+    }
+
+    fs::BlockManager* block_mgr() { return _block_mgr.get(); }
+    const TabletSchema& tablet_schema() const { return *_tablet_schema; }
+
+private:
+    static std::unique_ptr<TabletSchema> create_tablet_schema() {
+        TabletSchemaPB schema_pb;
+        schema_pb.set_keys_type(DUP_KEYS);
+        schema_pb.set_num_short_key_columns(1);
+        auto add_column = [&](const std::string& name, const std::string& type, int32_t length, bool is_key) {
+            auto* column = schema_pb.add_column();
+            column->set_unique_id(schema_pb.column_size() - 1);
+            column->set_name(name);
+            column->set_type(type);
+            column->set_length(length);
+            column->set_index_length(length);
+            column->set_is_key(is_key);
+            column->set_is_nullable(false);
+            column->set_aggregation(is_key ? "NONE" : "REPLACE");
+        };
+        add_column("c0", "INT", 4, true);
+        add_column("c1", "INT", 4, false);
+        add_column("c2", "VARCHAR", 64, false);
+        add_column("c3", "BIGINT", 8, false);
+        return std::make_unique<TabletSchema>(schema_pb);
+    }
+
+    StatusOr<SegmentSharedPtr> create_segment(const SegmentConfig& config) {
+        std::string file_name = strings::Substitute("$0/$1_$2_$3.dat", _dir, config.cardinality, config.sorted,
+                                                    config.adaptive_encoding);
+        std::unique_ptr<fs::WritableBlock> wblock;
+        RETURN_IF_ERROR(_block_mgr->create_block(fs::CreateBlockOptions({file_name}), &wblock));
+
+        const bool adaptive_encoding = config::enable_adaptive_numeric_encoding;
+        config::enable_adaptive_numeric_encoding = config.adaptive_encoding;
+        SegmentWriter writer(std::move(wblock), 0, _tablet_schema.get(), SegmentWriterOptions());
+        Status st = write_segment(config, &writer);
+        config::enable_adaptive_numeric_encoding = adaptive_encoding;
+        RETURN_IF_ERROR(st);
+
+        return Segment::open(&_mem_tracker, _block_mgr.get(), file_name, 0, _tablet_schema.get());
+    }
+
+    Status write_segment(const SegmentConfig& config, SegmentWriter* writer) {
+        RETURN_IF_ERROR(writer->init());
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(*_tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        std::mt19937_64 rng(config.cardinality);
+        for (uint32_t begin = 0; begin < kNumRows; begin += config::vector_chunk_size) {
+            chunk->reset();
+            auto& columns = chunk->columns();
+            for (uint32_t row = begin; row < std::min<uint32_t>(kNumRows, begin + config::vector_chunk_size); row++) {
+                int64_t value = config.sorted ? row * config.cardinality / kNumRows : rng() % config.cardinality;
+                std::string str = "value_" + std::to_string(value);
+                columns[0]->append_datum(vectorized::Datum(static_cast<int32_t>(config.sorted ? row : rng())));
+                columns[1]->append_datum(vectorized::Datum(static_cast<int32_t>(value)));
+                columns[2]->append_datum(vectorized::Datum(Slice(str)));
+                columns[3]->append_datum(vectorized::Datum(static_cast<int64_t>(rng())));
+            }
+            RETURN_IF_ERROR(writer->append_chunk(*chunk));
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        return writer->finalize(&file_size, &index_size, &footer_position);
+    }
+
+    std::unique_ptr<Env> _owned_env;
+    Env* _env = nullptr;
+    std::string _dir;
+    std::unique_ptr<fs::FileBlockManager> _block_mgr;
+    std::unique_ptr<TabletSchema> _tablet_schema;
+    MemTracker _mem_tracker;
+
+    std::mutex _mutex;
+    std::map<SegmentConfig, SegmentSharedPtr> _segments;
+};
+
+// The args are the cardinality, the sortedness, the adaptive encodings, the percent of the rows the predicate keeps
+// (100 for no predicate), the number of the projected columns and whether to use the page cache.
+static void BM_segment_scan(benchmark::State& state) {
+    auto* generator = SegmentGenerator::instance();
+    SegmentConfig config{state.range(0), state.range(1) != 0, state.range(2) != 0};
+    auto segment_or = generator->get_or_create(config);
+    if (!segment_or.ok()) {
+        state.SkipWithError(segment_or.status().to_string().c_str());
+        return;
+    }
+    auto segment = std::move(segment_or).value();
+
+    const int64_t selectivity = state.range(3);
+    std::vector<ColumnId> column_ids(kProjectionOrder.begin(), kProjectionOrder.begin() + state.range(4));
+    std::sort(column_ids.begin(), column_ids.end());
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(generator->tablet_schema(), column_ids);
+
+    ObjectPool pool;
+    const vectorized::ColumnPredicate* predicate = nullptr;
+    if (selectivity < 100) {
+        std::string operand = std::to_string(config.cardinality * selectivity / 100);
+        predicate = pool.add(vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), kPredicateColumn,
+                                                                 Slice(operand)));
+    }
+
+    OlapReaderStatistics total_stats;
+    int64_t num_rows = 0;
+    for (auto _ : state) {
+        OlapReaderStatistics stats;
+        vectorized::SegmentReadOptions options;
+        options.block_mgr = generator->block_mgr();
+        options.stats = &stats;
+        options.use_page_cache = state.range(5) != 0;
+        if (predicate != nullptr) {
+            options.predicates[kPredicateColumn].push_back(predicate);
+        }
+        auto iter_or = segment->new_iterator(schema, options);
+        if (iter_or.ok()) {
+            auto iter = std::move(iter_or).value();
+            auto chunk = vectorized::ChunkHelper::new_chunk(iter->output_schema(), config::vector_chunk_size);
+            Status st;
+            while ((st = iter->get_next(chunk.get())).ok()) {
+                num_rows += chunk->num_rows();
+                chunk->reset();
+            }
+            iter->close();
+            if (!st.is_end_of_file()) {
+                state.SkipWithError(st.to_string().c_str());
+                return;
+            }
+        } else if (!iter_or.status().is_end_of_file()) {
+            state.SkipWithError(iter_or.status().to_string().c_str());
+            return;
+        }
+
+        total_stats.io_ns += stats.io_ns;
+        total_stats.decompress_ns += stats.decompress_ns;
+        total_stats.block_load_ns += stats.block_load_ns;
+        total_stats.vec_cond_ns += stats.vec_cond_ns;
+        total_stats.index_load_ns += stats.index_load_ns;
+        total_stats.bytes_read += stats.bytes_read;
+        total_stats.raw_rows_read += stats.raw_rows_read;
+        total_stats.total_pages_num += stats.total_pages_num;
+        total_stats.cached_pages_num += stats.cached_pages_num;
+    }
+
+    // The rows and the bytes of the segment a scan goes through, and the rows it returns.
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+    state.SetBytesProcessed(total_stats.bytes_read);
+    state.counters["output_rows"] = benchmark::Counter(num_rows, benchmark::Counter::kAvgIterations);
+    state.counters["raw_rows"] = benchmark::Counter(total_stats.raw_rows_read, benchmark::Counter::kAvgIterations);
+    state.counters["page_cache_hit_rate"] = benchmark::Counter(
+            total_stats.total_pages_num > 0 ? static_cast<double>(total_stats.cached_pages_num) /
+                                                      total_stats.total_pages_num
+                                            : 0,
+            benchmark::Counter::kAvgThreads);
+    // The time of each stage of a scan, in ns.
+    for (const auto& [name, ns] : {std::make_pair("io_ns", total_stats.io_ns),
+                             std::make_pair("decompress_ns", total_stats.decompress_ns),
+                             std::make_pair("block_load_ns", total_stats.block_load_ns),
+                             std::make_pair("predicate_ns", total_stats.vec_cond_ns),
+                             std::make_pair("index_load_ns", total_stats.index_load_ns)}) {
+        state.counters[name] = benchmark::Counter(ns, benchmark::Counter::kAvgIterations);
+    }
+}
+
+// The low and the high cardinality, sorted and random, for the default and the adaptive encodings.
+static void data_args(benchmark::internal::Benchmark* b) {
+    for (int64_t cardinality : {16, 1 << 20}) {
+        for (int64_t sorted : {0, 1}) {
+            for (int64_t adaptive_encoding : {0, 1}) {
+                b->Args({cardinality, sorted, adaptive_encoding, 100, 4, 1});
+            }
+        }
+    }
+}
+
+// The selectivity of the predicate and the number of the projected columns.
+static void predicate_args(benchmark::internal::Benchmark* b) {
+    for (int64_t sorted : {0, 1}) {
+        for (int64_t selectivity : {1, 10, 50, 100}) {
+            for (int64_t num_columns : {1, 4}) {
+                b->Args({1 << 20, sorted, 0, selectivity, num_columns, 1});
+            }
+        }
+    }
+}
+
+// The page cache and the concurrent scans of the same segment.
+static void concurrency_args(benchmark::internal::Benchmark* b) {
+    for (int64_t use_page_cache : {0, 1}) {
+        b->Args({1 << 20, 0, 0, 100, 4, use_page_cache});
+    }
+}
+
+BENCHMARK(BM_segment_scan)->Apply(data_args)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_segment_scan)->Apply(predicate_args)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_segment_scan)->Apply(concurrency_args)->ThreadRange(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks
+
+int main(int argc, char** argv) {
+    starrocks::MemTracker page_cache_mem_tracker;
+    starrocks::StoragePageCache::create_global_cache(&page_cache_mem_tracker, starrocks::kPageCacheCapacity);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    starrocks::StoragePageCache::release_global_cache();
+    return 0;
+}
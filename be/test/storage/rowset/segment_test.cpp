@@ -36,6 +36,7 @@
 #include "storage/olap_common.h"
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/column_reader.h"
+#include "storage/rowset/segment_footer_cache.h"
 #include "storage/rowset/segment_writer.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/tablet_schema.h"
@@ -43,7 +44,10 @@
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/chunk_iterator.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 #include "util/file_utils.h"
+#include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -270,6 +274,115 @@ TEST_F(SegmentReaderWriterTest, TestHorizontalWrite) {
     EXPECT_EQ(count, num_rows);
 }
 
+TEST_F(SegmentReaderWriterTest, TestParallelEncode) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_key(2), create_int_value(3),
+                                                create_int_value(4), create_int_value(5)});
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("segment_encode").set_min_threads(1).set_max_threads(3).build(&pool));
+    int32_t old_min_columns = config::segment_parallel_encode_min_columns;
+    config::segment_parallel_encode_min_columns = 2;
+
+    // write the same rows serially and in parallel
+    std::vector<std::string> contents;
+    for (ThreadPool* encode_pool : {static_cast<ThreadPool*>(nullptr), pool.get()}) {
+        SegmentWriterOptions opts;
+        opts.num_rows_per_block = 10;
+        opts.encode_thread_pool = encode_pool;
+
+        std::string file_name = strings::Substitute("$0/parallel_encode_case_$1", kSegmentDir, contents.size());
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions wblock_opts({file_name});
+        ASSERT_OK(_block_mgr->create_block(wblock_opts, &wblock));
+        SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+        ASSERT_OK(writer.init());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, 1000);
+        for (int i = 0; i < 100; ++i) {
+            chunk->reset();
+            for (int j = 0; j < 1000; ++j) {
+                for (int cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+                    chunk->get_column_by_index(cid)->append_datum(DefaultIntGenerator(i * 1000 + j, cid, 0));
+                }
+            }
+            ASSERT_OK(writer.append_chunk(*chunk));
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+        std::unique_ptr<RandomAccessFile> rfile;
+        ASSERT_OK(_env->new_random_access_file(file_name, &rfile));
+        std::string content(file_size, '\0');
+        ASSERT_OK(rfile->read_at(0, Slice(content)));
+        contents.emplace_back(std::move(content));
+
+        auto segment = *Segment::open(_tablet_meta_mem_tracker.get(), _block_mgr, file_name, 0, &tablet_schema);
+        ASSERT_EQ(100000, segment->num_rows());
+    }
+    config::segment_parallel_encode_min_columns = old_min_columns;
+    ASSERT_EQ(contents[0], contents[1]);
+}
+
+TEST_F(SegmentReaderWriterTest, TestFooterCache) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_value(2)});
+    std::string file_name = strings::Substitute("$0/footer_cache", kSegmentDir);
+    SegmentWriterOptions opts;
+    std::unique_ptr<fs::WritableBlock> wblock;
+    fs::CreateBlockOptions wblock_opts({file_name});
+    ASSERT_OK(_block_mgr->create_block(wblock_opts, &wblock));
+    SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+    ASSERT_OK(writer.init());
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, 100);
+    for (int j = 0; j < 100; ++j) {
+        for (int cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+            chunk->get_column_by_index(cid)->append_datum(DefaultIntGenerator(j, cid, 0));
+        }
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+    uint64_t file_size = 0;
+    uint64_t index_size = 0;
+    uint64_t footer_position = 0;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+    SegmentFooterCache::create_global_cache(nullptr, 1024 * 1024);
+    DeferOp release([] { SegmentFooterCache::release_global_cache(); });
+    ASSERT_OK(Segment::cache_footer(_block_mgr, file_name));
+    ASSERT_TRUE(SegmentFooterCache::instance()->contains(file_name));
+
+    // the segment is opened from the cached footer, without the file
+    _block_mgr->erase_block_cache(file_name);
+    ASSERT_OK(_env->delete_file(file_name));
+    uint64_t hits = StarRocksMetrics::instance()->segment_footer_cache_hit_total.value();
+    auto segment = *Segment::open(_tablet_meta_mem_tracker.get(), _block_mgr, file_name, 0, &tablet_schema);
+    ASSERT_EQ(100, segment->num_rows());
+    ASSERT_EQ(2, segment->num_columns());
+    ASSERT_EQ(hits + 1, StarRocksMetrics::instance()->segment_footer_cache_hit_total.value());
+}
+
+TEST_F(SegmentReaderWriterTest, TestPrewarm) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_value(2)});
+    SegmentWriterOptions opts;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, tablet_schema, 100000, DefaultIntGenerator, &segment);
+
+    // a budget of 1 byte reads a single page
+    size_t cache_usage = StoragePageCache::instance()->memory_usage();
+    int64_t budget_bytes = 1;
+    ASSERT_OK(segment->prewarm(_tablet_meta_mem_tracker.get(), &budget_bytes));
+    ASSERT_LE(budget_bytes, 0);
+    size_t one_page_usage = StoragePageCache::instance()->memory_usage();
+    ASSERT_GT(one_page_usage, cache_usage);
+
+    budget_bytes = 1L << 30;
+    ASSERT_OK(segment->prewarm(_tablet_meta_mem_tracker.get(), &budget_bytes));
+    ASSERT_GT(budget_bytes, 0);
+    ASSERT_LT(budget_bytes, 1L << 30);
+    ASSERT_GT(StoragePageCache::instance()->memory_usage(), one_page_usage);
+}
+
 TEST_F(SegmentReaderWriterTest, TestVerticalWrite) {
     TabletSchema tablet_schema =
             create_schema({create_int_key(1), create_int_key(2), create_int_value(3), create_int_value(4)});
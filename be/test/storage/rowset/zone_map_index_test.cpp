@@ -130,6 +130,7 @@ TEST_F(ColumnZoneMapTest, NormalTestIntPage) {
     builder->flush();
     builder->add_nulls(6);
     builder->flush();
+    ASSERT_FALSE(builder->is_sorted());
     // write out zone map index
     ColumnIndexMetaPB index_meta;
     {
@@ -162,6 +163,55 @@ TEST_F(ColumnZoneMapTest, NormalTestIntPage) {
     delete field;
 }
 
+TEST_F(ColumnZoneMapTest, SortedValues) {
+    TabletColumn int_column = create_int_key(0);
+    std::unique_ptr<Field> field(FieldFactory::create(int_column));
+    {
+        std::unique_ptr<ZoneMapIndexWriter> builder = ZoneMapIndexWriter::create(field.get());
+        ASSERT_FALSE(builder->is_sorted());
+        std::vector<int> values1 = {1, 3, 3, 7};
+        builder->add_values(values1.data(), values1.size());
+        builder->add_nulls(0);
+        builder->flush();
+        std::vector<int> values2 = {7, 8, 20};
+        builder->add_values(values2.data(), values2.size());
+        ASSERT_TRUE(builder->is_sorted());
+        // smaller than the last value of the previous batch
+        int value = 19;
+        builder->add_values(&value, 1);
+        ASSERT_FALSE(builder->is_sorted());
+        value = 30;
+        builder->add_values(&value, 1);
+        ASSERT_FALSE(builder->is_sorted());
+    }
+    {
+        std::unique_ptr<ZoneMapIndexWriter> builder = ZoneMapIndexWriter::create(field.get());
+        std::vector<int> values = {1, 5, 4};
+        builder->add_values(values.data(), values.size());
+        ASSERT_FALSE(builder->is_sorted());
+    }
+    {
+        std::unique_ptr<ZoneMapIndexWriter> builder = ZoneMapIndexWriter::create(field.get());
+        std::vector<int> values = {1, 2, 3};
+        builder->add_values(values.data(), values.size());
+        builder->add_nulls(1);
+        ASSERT_FALSE(builder->is_sorted());
+    }
+
+    TabletColumn varchar_column = create_varchar_key(0);
+    std::unique_ptr<Field> varchar_field(FieldFactory::create(varchar_column));
+    std::unique_ptr<ZoneMapIndexWriter> builder = ZoneMapIndexWriter::create(varchar_field.get());
+    std::vector<std::string> values = {"a", "ab", "ab", "b"};
+    for (auto& value : values) {
+        Slice slice(value);
+        builder->add_values(&slice, 1);
+    }
+    ASSERT_TRUE(builder->is_sorted());
+    Slice slice("aa");
+    builder->add_values(&slice, 1);
+    ASSERT_FALSE(builder->is_sorted());
+}
+
 // Test for string
 TEST_F(ColumnZoneMapTest, NormalTestVarcharPage) {
     TabletColumn varchar_column = create_varchar_key(0);
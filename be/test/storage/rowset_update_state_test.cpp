@@ -115,7 +115,7 @@ public:
 
     RowsetSharedPtr create_partial_rowset(const TabletSharedPtr& tablet, const vector<int64_t>& keys,
                                           std::vector<int32_t>& column_indexes,
-                                          std::shared_ptr<TabletSchema> partial_schema) {
+                                          std::shared_ptr<TabletSchema> partial_schema, size_t num_segments = 1) {
         // create partial rowset
         RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
         RowsetId rowset_id = StorageEngine::instance()->next_rowset_id();
@@ -140,11 +140,16 @@ public:
         auto chunk = vectorized::ChunkHelper::new_chunk(schema, keys.size());
         EXPECT_TRUE(2 == chunk->num_columns());
         auto& cols = chunk->columns();
+        // each segment gets a consecutive range of the keys
+        const size_t rows_per_segment = (keys.size() + num_segments - 1) / num_segments;
         for (size_t i = 0; i < keys.size(); i++) {
             cols[0]->append_datum(vectorized::Datum(keys[i]));
             cols[1]->append_datum(vectorized::Datum((int16_t)(keys[i] % 100 + 3)));
+            if (chunk->num_rows() == rows_per_segment || i + 1 == keys.size()) {
+                CHECK_OK(writer->flush_chunk(*chunk));
+                chunk->reset();
+            }
         }
-        CHECK_OK(writer->flush_chunk(*chunk));
         RowsetSharedPtr partial_rowset = *writer->build();
 
         return partial_rowset;
@@ -244,6 +249,35 @@ TEST_F(RowsetUpdateStateTest, prepare_partial_update_states) {
     }
 }
 
+TEST_F(RowsetUpdateStateTest, prepare_partial_update_states_multi_segments) {
+    const int N = 100;
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+    }
+    ASSERT_OK(_tablet->rowset_commit(2, create_rowset(_tablet, keys)));
+    ASSERT_EQ(N, read_tablet(_tablet, 2));
+
+    // each segment of the partial rowset updates a part of the old rows
+    std::vector<int32_t> column_indexes = {0, 1};
+    std::shared_ptr<TabletSchema> partial_schema = TabletSchema::create(_tablet->tablet_schema(), column_indexes);
+    RowsetSharedPtr partial_rowset = create_partial_rowset(_tablet, keys, column_indexes, partial_schema, 3);
+    ASSERT_EQ(3, partial_rowset->num_segments());
+    RowsetUpdateState state;
+    ASSERT_OK(state.load(_tablet.get(), partial_rowset.get()));
+    const std::vector<PartialUpdateState>& parital_update_states = state.parital_update_states();
+    ASSERT_EQ(3, parital_update_states.size());
+    size_t k = 0;
+    for (const auto& segment_state : parital_update_states) {
+        ASSERT_EQ(1, segment_state.write_columns.size());
+        for (size_t i = 0; i < segment_state.src_rss_rowids.size(); i++, k++) {
+            ASSERT_EQ((int32_t)(keys[k] % 1000 + 2), segment_state.write_columns[0]->get(i).get_int32());
+        }
+    }
+    ASSERT_EQ(N, k);
+}
+
 TEST_F(RowsetUpdateStateTest, check_conflict) {
     // create full rowset first
     const int N = 100;
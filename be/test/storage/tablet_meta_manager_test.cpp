@@ -6,7 +6,9 @@
 
 #include <filesystem>
 
+#include "common/config.h"
 #include "storage/del_vector.h"
+#include "storage/edit_version.h"
 
 namespace starrocks {
 
@@ -393,6 +395,59 @@ TEST_F(TabletMetaManagerPerformanceTest, rowset_iterate) {
 }
 */
 
+// NOLINTNEXTLINE
+TEST_F(TabletMetaManagerTest, delete_vector_delta) {
+    const TTabletId kTabletId = 10087;
+    const uint32_t kSegmentId = 3;
+    auto meta = _data_dir->get_meta();
+    auto old_max_delta_chain = config::update_del_vector_max_delta_chain;
+    config::update_del_vector_max_delta_chain = 2;
+
+    std::vector<uint32_t> dels(10000);
+    for (int i = 0; i < dels.size(); i++) {
+        dels[i] = i * 2;
+    }
+    std::vector<DelVectorPtr> delvecs(6);
+    delvecs[1] = std::make_shared<DelVector>();
+    delvecs[1]->init(1, dels.data(), dels.size());
+    ASSERT_TRUE(TabletMetaManager::set_del_vector(meta, kTabletId, kSegmentId, *delvecs[1]).ok());
+    // versions 2, 3 are deltas, 4 is saved in whole, 5 is a delta of 4
+    for (int64_t v = 2; v <= 5; v++) {
+        delvecs[v - 1]->add_dels_as_new_version({static_cast<uint32_t>(v * 2 + 1)}, v, &delvecs[v]);
+        std::vector<std::pair<uint32_t, DelVectorPtr>> new_delvecs{{kSegmentId, delvecs[v]}};
+        ASSERT_TRUE(TabletMetaManager::apply_rowset_commit(_data_dir.get(), kTabletId, v, EditVersion(v, 0),
+                                                           new_delvecs)
+                            .ok());
+    }
+    ASSERT_EQ(1, delvecs[2]->delta_chain());
+    ASSERT_EQ(2, delvecs[3]->delta_chain());
+    ASSERT_EQ(0, delvecs[4]->delta_chain());
+    ASSERT_EQ(1, delvecs[5]->delta_chain());
+
+    auto check = [&](int64_t version) {
+        DelVector delvec;
+        int64_t latest_version = 0;
+        auto st = TabletMetaManager::get_del_vector(meta, kTabletId, kSegmentId, version, &delvec, &latest_version);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        ASSERT_EQ(5, latest_version);
+        ASSERT_EQ(version, delvec.version());
+        ASSERT_EQ(-1, delvec.base_version());
+        ASSERT_EQ(dels.size() + version - 1, delvec.cardinality());
+        ASSERT_TRUE(*delvecs[version]->roaring() == *delvec.roaring());
+    };
+    for (int64_t v = 1; v <= 5; v++) {
+        check(v);
+    }
+
+    // version 3 is saved in whole before the versions it's based on are removed
+    ASSERT_TRUE(TabletMetaManager::consolidate_del_vector(meta, kTabletId, kSegmentId, 3).ok());
+    ASSERT_TRUE(TabletMetaManager::delete_del_vector_range(meta, kTabletId, kSegmentId, 0, 3).ok());
+    for (int64_t v = 3; v <= 5; v++) {
+        check(v);
+    }
+    config::update_del_vector_max_delta_chain = old_max_delta_chain;
+}
+
 class DeleteVectorPerformanceTest : public ::testing::Test {
 protected:
     static constexpr const char* const kCaseName = "delete_vector_performance_test";
@@ -600,6 +600,52 @@ TEST_F(TabletUpdatesTest, save_meta) {
     ASSERT_EQ(N, read_tablet(tablet1, 2));
 }
 
+static size_t applied_num_dels(const TabletSharedPtr& tablet, int64_t version) {
+    std::vector<RowsetSharedPtr> rowsets;
+    CHECK(tablet->updates()->get_applied_rowsets(version, &rowsets).ok());
+    std::vector<uint32_t> rowset_ids;
+    for (const auto& rowset : rowsets) {
+        rowset_ids.push_back(rowset->rowset_meta()->get_rowset_seg_id());
+    }
+    size_t total_rows = 0;
+    size_t total_dels = 0;
+    CHECK(tablet->updates()->get_rowsets_total_stats(rowset_ids, &total_rows, &total_dels).ok());
+    return total_dels;
+}
+
+TEST_F(TabletUpdatesTest, save_meta_with_num_dels) {
+    _tablet = create_tablet(rand(), rand());
+    const int N = 100;
+    std::vector<int64_t> keys;
+    for (int i = 0; i < N; i++) {
+        keys.push_back(i);
+    }
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    vectorized::Int64Column deletes;
+    deletes.append_numbers(keys.data(), sizeof(int64_t) * keys.size() / 2);
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, {}, &deletes)).ok());
+    ASSERT_EQ(N / 2, read_tablet(_tablet, 3));
+    _tablet->save_meta();
+
+    // the deleted rows of the applied segments are saved in the tablet meta
+    TabletMetaPB meta_pb;
+    _tablet->tablet_meta()->to_meta_pb(&meta_pb);
+    size_t num_dels = 0;
+    for (const auto& num_dels_pb : meta_pb.updates().applied_segment_num_dels()) {
+        num_dels += num_dels_pb.num_dels();
+    }
+    ASSERT_EQ(N / 2, num_dels);
+
+    // the version applied after the meta is saved is loaded from the meta log
+    ASSERT_TRUE(_tablet->rowset_commit(4, create_rowset(_tablet, {N / 2}, &deletes)).ok());
+    ASSERT_EQ(N / 2, read_tablet(_tablet, 4));
+    auto tablet1 = load_same_tablet_from_store(_tablet_meta_mem_tracker.get(), _tablet);
+    ASSERT_EQ(4, tablet1->updates()->max_version());
+    ASSERT_EQ(applied_num_dels(_tablet, 4), applied_num_dels(tablet1, 4));
+    ASSERT_EQ(N / 2 + 1, applied_num_dels(tablet1, 4));
+    ASSERT_EQ(N / 2, read_tablet(tablet1, 4));
+}
+
 TEST_F(TabletUpdatesTest, remove_expired_versions) {
     _tablet = create_tablet(rand(), rand());
 
@@ -689,6 +735,44 @@ TEST_F(TabletUpdatesTest, apply) {
     }
 }
 
+TEST_F(TabletUpdatesTest, apply_batch) {
+    auto old_batch = config::update_apply_batch_max_versions;
+    config::update_apply_batch_max_versions = 3;
+    const int N = 100;
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+    }
+    // commit the later versions first, so they are all applied at once after version 2 is committed,
+    // and each version overwrites the keys of the earlier ones in the same batch.
+    const int num_versions = 10;
+    for (int v = 3; v < 2 + num_versions; v++) {
+        ASSERT_TRUE(_tablet->rowset_commit(v, create_rowset(_tablet, keys)).ok());
+    }
+    // delete half of the keys in the last version
+    vectorized::Int64Column deletes;
+    deletes.append_numbers(keys.data(), sizeof(int64_t) * keys.size() / 2);
+    ASSERT_TRUE(_tablet->rowset_commit(2 + num_versions, create_rowset(_tablet, {}, &deletes)).ok());
+    ASSERT_EQ(1, _tablet->updates()->max_version());
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    ASSERT_EQ(2 + num_versions, _tablet->updates()->max_version());
+    for (int v = 2; v < 2 + num_versions; v++) {
+        ASSERT_EQ(N, read_tablet(_tablet, v));
+    }
+    ASSERT_EQ(N / 2, read_tablet(_tablet, 2 + num_versions));
+
+    // the delvecs of all the versions are persisted
+    StorageEngine::instance()->update_manager()->clear_cache();
+    auto tablet1 = load_same_tablet_from_store(_tablet_meta_mem_tracker.get(), _tablet);
+    EXPECT_EQ(2 + num_versions, tablet1->updates()->max_version());
+    for (int v = 2; v < 2 + num_versions; v++) {
+        ASSERT_EQ(N, read_tablet(tablet1, v));
+    }
+    ASSERT_EQ(N / 2, read_tablet(tablet1, 2 + num_versions));
+    config::update_apply_batch_max_versions = old_batch;
+}
+
 // NOLINTNEXTLINE
 TEST_F(TabletUpdatesTest, concurrent_write_read_and_gc) {
     const int N = 2000;
@@ -877,6 +961,38 @@ TEST_F(TabletUpdatesTest, vertical_compaction) {
     EXPECT_EQ(best_tablet->updates()->get_compaction_score(), -1);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TabletUpdatesTest, compaction_pick_mostly_deleted) {
+    auto old_max_rows = config::update_compaction_max_rows_per_round;
+    config::update_compaction_max_rows_per_round = 100;
+    DeferOp op([&] { config::update_compaction_max_rows_per_round = old_max_rows; });
+
+    srand(GetCurrentTimeMicros());
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys1;
+    std::vector<int64_t> keys2;
+    for (int i = 0; i < 100; i++) {
+        keys1.push_back(i);
+        keys2.push_back(i + 100);
+    }
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys1)).ok());
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, keys2)).ok());
+    // Delete [0, 1, 2 ... 80)
+    vectorized::Int64Column deletes;
+    deletes.append_numbers(keys1.data(), sizeof(int64_t) * 80);
+    ASSERT_TRUE(_tablet->rowset_commit(4, create_rowset(_tablet, {}, &deletes)).ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    ASSERT_EQ(_tablet->updates()->version_history_count(), 4);
+    ASSERT_EQ(_tablet->updates()->num_rowsets(), 3);
+
+    // the mostly deleted rowset of version 2 goes first, the rowset of version 3 would exceed the max rows
+    ASSERT_TRUE(_tablet->updates()->compaction(_compaction_mem_tracker.get()).ok());
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    ASSERT_EQ(_tablet->updates()->version_history_count(), 5);
+    ASSERT_EQ(_tablet->updates()->num_rowsets(), 2);
+    EXPECT_EQ(120, read_tablet(_tablet, 4));
+}
+
 TEST_F(TabletUpdatesTest, link_from) {
     srand(GetCurrentTimeMicros());
     _tablet = create_tablet(rand(), rand());
@@ -1566,4 +1682,44 @@ TEST_F(TabletUpdatesTest, get_column_values) {
     ASSERT_EQ(std::string("[0, ") + values_str_generator(1000, 2).substr(1), read_columns[1]->debug_string());
 }
 
+TEST_F(TabletUpdatesTest, get_rows_by_pks) {
+    srand(GetCurrentTimeMicros());
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys0;
+    std::vector<int64_t> keys1;
+    for (int i = 0; i < 100; i++) {
+        keys0.push_back(i);
+        keys1.push_back(i + 50);
+    }
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys0)).ok());
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, keys1)).ok());
+    std::vector<RowsetSharedPtr> applied_rowsets;
+    ASSERT_TRUE(_tablet->updates()->get_applied_rowsets(3, &applied_rowsets).ok());
+
+    std::vector<ColumnId> pk_columns{0};
+    auto pkey_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema(), pk_columns);
+    auto key_chunk = vectorized::ChunkHelper::new_chunk(pkey_schema, 3);
+    for (int64_t key : std::vector<int64_t>{120, 10, 1000}) {
+        key_chunk->get_column_by_index(0)->append_datum(vectorized::Datum(key));
+    }
+    std::unique_ptr<vectorized::Column> pks;
+    ASSERT_TRUE(PrimaryKeyEncoder::create_column(pkey_schema, &pks).ok());
+    PrimaryKeyEncoder::encode(pkey_schema, *key_chunk, 0, key_chunk->num_rows(), pks.get());
+
+    std::vector<uint32_t> read_column_ids = {0, 2};
+    std::vector<std::unique_ptr<vectorized::Column>> read_columns(read_column_ids.size());
+    for (auto i = 0; i < read_column_ids.size(); i++) {
+        const auto& tablet_column = _tablet->tablet_schema().column(read_column_ids[i]);
+        read_columns[i] =
+                vectorized::ChunkHelper::column_from_field_type(tablet_column.type(), tablet_column.is_nullable())
+                        ->clone_empty();
+    }
+    EditVersion read_version;
+    ASSERT_TRUE(_tablet->updates()->get_rows_by_pks(*pks, read_column_ids, &read_version, &read_columns).ok());
+    ASSERT_EQ(3, read_version.major());
+    // the key 1000 is not found, and the rows are in the order of the rowsets
+    ASSERT_EQ("[10, 120]", read_columns[0]->debug_string());
+    ASSERT_EQ("[12, 122]", read_columns[1]->debug_string());
+}
+
 } // namespace starrocks
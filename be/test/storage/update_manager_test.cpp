@@ -182,4 +182,37 @@ TEST_F(UpdateManagerTest, testExpireEntry) {
     ASSERT_EQ(peak_size - expiring_size, remaining_size);
 }
 
+TEST_F(UpdateManagerTest, testIndexCacheCapacity) {
+    auto old_percent = config::update_primary_index_cache_percent;
+    config::update_primary_index_cache_percent = 50;
+    MemTracker tracker(1000, "update");
+    UpdateManager manager(&tracker);
+    ASSERT_OK(manager.init());
+    ASSERT_EQ(500, manager.index_cache().capacity());
+
+    auto& cache = manager.index_cache();
+    auto e1 = cache.get_or_create(1);
+    cache.update_object_size(e1, 300);
+    cache.release(e1);
+    // the index in use is kept even if the cache is full
+    auto e2 = cache.get_or_create(2);
+    cache.update_object_size(e2, 300);
+    ASSERT_EQ(1, cache.object_size());
+    ASSERT_EQ(300, cache.size());
+
+    auto e3 = cache.get_or_create(3);
+    cache.update_object_size(e3, 100);
+    cache.release(e2);
+    cache.release(e3);
+    ASSERT_EQ(400, cache.size());
+
+    // the most recently used index is kept
+    config::update_primary_index_cache_percent = 20;
+    manager.expire_cache();
+    ASSERT_EQ(200, cache.capacity());
+    ASSERT_EQ(1, cache.object_size());
+    ASSERT_EQ(100, cache.size());
+    config::update_primary_index_cache_percent = old_percent;
+}
+
 } // namespace starrocks
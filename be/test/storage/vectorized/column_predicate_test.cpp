@@ -4,9 +4,11 @@
 
 #include <vector>
 
+#include "exprs/vectorized/runtime_filter_bank.h"
 #include "gtest/gtest.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/column_or_predicate.h"
+#include "storage/vectorized/column_runtime_filter_predicate.h"
 
 namespace starrocks::vectorized {
 
@@ -2158,4 +2160,115 @@ TEST(ColumnPredicateTest, zone_map_filter_varchar) {
     EXPECT_TRUE(not_in_xx_yy->ZMF(Datum("xy"), Datum("zz")));
 }
 
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, runtime_filter) {
+    RuntimeBloomFilter<TYPE_INT> rf;
+    rf.init(10);
+    for (int32_t v : {1, 3, 5}) {
+        rf.insert(&v);
+    }
+    RuntimeFilterProbeDescriptor desc;
+    ColumnRuntimeFilterPredicate p(get_type_info(OLAP_FIELD_TYPE_INT), 0, &desc);
+    ASSERT_EQ(PredicateType::kRuntimeFilter, p.type());
+    ASSERT_TRUE(p.is_expr_predicate());
+
+    auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, true);
+    for (int32_t v : {1, 2, 3, 4, 5}) {
+        c->append_datum(Datum(v));
+    }
+    ASSERT_TRUE(c->append_nulls(1));
+
+    // Selects all rows before the runtime filter arrives.
+    ASSERT_TRUE(p.is_deferred());
+    ASSERT_TRUE(p.ZMF(Datum(6), Datum(10)));
+    std::vector<uint8_t> buff(6);
+    p.evaluate(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,1,1,1,1,1", to_string(buff));
+    buff.assign({1, 1, 0, 1, 0, 1});
+    p.evaluate_and(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,1,0,1,0,1", to_string(buff));
+
+    desc.set_runtime_filter(&rf);
+    ASSERT_FALSE(p.is_deferred());
+    EXPECT_TRUE(p.ZMF(Datum(0), Datum(1)));
+    EXPECT_TRUE(p.ZMF(Datum(2), Datum(4)));
+    EXPECT_TRUE(p.ZMF(Datum(5), Datum(10)));
+    EXPECT_FALSE(p.ZMF(Datum(6), Datum(10)));
+    EXPECT_FALSE(p.ZMF(Datum(-5), Datum(0)));
+    EXPECT_FALSE(p.ZMF(Datum(), Datum()));
+    EXPECT_TRUE(p.ZMF(Datum(), Datum(3)));
+
+    p.evaluate(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,0,1,0,1,0", to_string(buff));
+
+    buff.assign({1, 1, 0, 1, 0, 1});
+    p.evaluate_and(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,0,0,0,0,0", to_string(buff));
+
+    buff.assign({0, 1, 0, 0, 0, 0});
+    p.evaluate_or(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,1,1,0,1,0", to_string(buff));
+
+    ObjectPool pool;
+    const ColumnPredicate* converted = nullptr;
+    ASSERT_TRUE(p.convert_to(&converted, get_type_info(OLAP_FIELD_TYPE_INT), &pool).ok());
+    ASSERT_EQ(&p, converted);
+    ASSERT_TRUE(p.convert_to(&converted, get_type_info(OLAP_FIELD_TYPE_BIGINT), &pool).ok());
+    ASSERT_EQ(PredicateType::kTrue, converted->type());
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, runtime_topn) {
+    RuntimeTopnThreshold threshold(0, TYPE_INT, true, false);
+    ColumnRuntimeTopnPredicate p(get_type_info(OLAP_FIELD_TYPE_INT), 0, &threshold);
+    ASSERT_EQ(PredicateType::kRuntimeTopn, p.type());
+
+    auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, true);
+    for (int32_t v : {1, 2, 3, 4, 5}) {
+        c->append_datum(Datum(v));
+    }
+    ASSERT_TRUE(c->append_nulls(1));
+
+    // Selects all rows before a threshold is published.
+    ASSERT_TRUE(p.is_deferred());
+    ASSERT_TRUE(p.ZMF(Datum(6), Datum(10)));
+    std::vector<uint8_t> buff(6);
+    p.evaluate(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,1,1,1,1,1", to_string(buff));
+
+    threshold.update(Datum(4));
+    ASSERT_FALSE(p.is_deferred());
+    // Only tightens.
+    threshold.update(Datum(5));
+    threshold.update(Datum());
+    threshold.update(Datum(3));
+    ASSERT_EQ(3, threshold.value().get_int32());
+
+    p.evaluate(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,1,1,0,0,0", to_string(buff));
+    buff.assign({0, 1, 0, 1, 0, 1});
+    p.evaluate_and(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("0,1,0,0,0,0", to_string(buff));
+    buff.assign({0, 0, 0, 1, 0, 0});
+    p.evaluate_or(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("1,1,1,1,0,0", to_string(buff));
+
+    EXPECT_TRUE(p.ZMF(Datum(0), Datum(1)));
+    EXPECT_TRUE(p.ZMF(Datum(3), Datum(10)));
+    EXPECT_FALSE(p.ZMF(Datum(4), Datum(10)));
+    EXPECT_FALSE(p.ZMF(Datum(), Datum()));
+
+    // Descending with nulls first.
+    RuntimeTopnThreshold desc_threshold(0, TYPE_INT, false, true);
+    ColumnRuntimeTopnPredicate desc_p(get_type_info(OLAP_FIELD_TYPE_INT), 0, &desc_threshold);
+    desc_threshold.update(Datum(2));
+    desc_threshold.update(Datum(4));
+    desc_threshold.update(Datum(3));
+    desc_p.evaluate(c.get(), buff.data(), 0, 6);
+    ASSERT_EQ("0,0,0,1,1,1", to_string(buff));
+    EXPECT_TRUE(desc_p.ZMF(Datum(), Datum()));
+    EXPECT_TRUE(desc_p.ZMF(Datum(1), Datum(4)));
+    EXPECT_FALSE(desc_p.ZMF(Datum(1), Datum(3)));
+}
+
 } // namespace starrocks::vectorized
@@ -8,6 +8,7 @@
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_meta.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -97,14 +98,14 @@ public:
         tablet_meta->init_from_pb(&tablet_meta_pb);
     }
 
-    void rowset_writer_add_rows(std::unique_ptr<RowsetWriter>& writer) {
+    void rowset_writer_add_rows(std::unique_ptr<RowsetWriter>& writer, int32_t key_offset = 0) {
         std::vector<std::string> test_data;
         auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(*_tablet_schema);
         auto chunk = vectorized::ChunkHelper::new_chunk(schema, 1024);
         for (size_t i = 0; i < 1024; ++i) {
             test_data.push_back("well" + std::to_string(i));
             auto& cols = chunk->columns();
-            cols[0]->append_datum(vectorized::Datum(static_cast<int32_t>(i)));
+            cols[0]->append_datum(vectorized::Datum(static_cast<int32_t>(key_offset + i)));
             Slice field_1(test_data[i]);
             cols[1]->append_datum(vectorized::Datum(field_1));
             cols[2]->append_datum(vectorized::Datum(static_cast<int32_t>(10000 + i)));
@@ -112,7 +113,8 @@ public:
         CHECK_OK(writer->add_chunk(*chunk));
     }
 
-    void do_compaction() {
+    // The keys of the second rowset start from |second_key_offset|.
+    void do_compaction(int32_t second_key_offset = 0, TabletSharedPtr* output_tablet = nullptr) {
         config::storage_format_version = 2;
         create_tablet_schema(UNIQUE_KEYS);
 
@@ -145,7 +147,7 @@ public:
             std::unique_ptr<RowsetWriter> _rowset_writer;
             ASSERT_TRUE(RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer).ok());
 
-            rowset_writer_add_rows(_rowset_writer);
+            rowset_writer_add_rows(_rowset_writer, second_key_offset);
 
             _rowset_writer->flush();
             RowsetSharedPtr src_rowset = *_rowset_writer->build();
@@ -166,6 +168,9 @@ public:
         CumulativeCompaction cumulative_compaction(_compaction_mem_tracker.get(), tablet);
 
         ASSERT_TRUE(cumulative_compaction.compact().ok());
+        if (output_tablet != nullptr) {
+            *output_tablet = tablet;
+        }
     }
 
     void SetUp() override {
@@ -252,6 +257,44 @@ TEST_F(CumulativeCompactionTest, test_vertical_compact_succeed) {
     do_compaction();
 }
 
+TEST_F(CumulativeCompactionTest, test_link_segments) {
+    config::vertical_compaction_max_columns_per_group = 5;
+    TabletSharedPtr tablet;
+    do_compaction(1024, &tablet);
+    ASSERT_TRUE(tablet != nullptr);
+
+    auto rowset = tablet->get_rowset_by_version(Version(0, 1));
+    ASSERT_TRUE(rowset != nullptr);
+    ASSERT_EQ(2048, rowset->num_rows());
+    // the segments of the inputs are linked as they are
+    ASSERT_EQ(2, rowset->num_segments());
+    ASSERT_EQ(NONOVERLAPPING, rowset->rowset_meta()->segments_overlap());
+
+    auto schema = ChunkHelper::convert_schema_to_format_v2(*_tablet_schema);
+    OlapReaderStatistics stats;
+    RowsetReadOptions rs_opts;
+    rs_opts.stats = &stats;
+    rs_opts.tablet_schema = _tablet_schema.get();
+    auto iter = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(iter.ok()) << iter.status();
+    auto chunk = ChunkHelper::new_chunk(schema, 1024);
+    int32_t expected = 0;
+    while (true) {
+        chunk->reset();
+        auto st = (*iter)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_EQ(expected, chunk->get_column_by_index(0)->get(i).get_int32());
+            ASSERT_EQ(10000 + expected % 1024, chunk->get_column_by_index(2)->get(i).get_int32());
+            expected++;
+        }
+    }
+    ASSERT_EQ(2048, expected);
+}
+
 TEST_F(CumulativeCompactionTest, test_read_chunk_size) {
     // total row size is 0 in old segment
     int64_t mem_limit = 2147483648;
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <map>
 
 #include "gutil/strings/split.h"
 #include "runtime/descriptor_helper.h"
@@ -310,6 +311,65 @@ TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testUniqKeysSortedRuns) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysSortedRuns";
+    MySetUp("pk int,v int", "pk int,v int", 1, KeysType::UNIQUE_KEYS, path);
+    const size_t n = 1000;
+    const int nbatch = 3;
+    vector<uint32_t> indexes;
+    for (int i = 0; i < n; i++) {
+        indexes.emplace_back(i);
+    }
+    // each batch is sorted and overlaps with the others, the rows of the last batch win.
+    for (int b = 0; b < nbatch; b++) {
+        shared_ptr<Chunk> chunk = ChunkHelper::new_chunk(*_slots, n);
+        for (int i = 0; i < n; i++) {
+            chunk->get_column_by_index(0)->append_datum(Datum(static_cast<int32_t>(i * (b + 1) % n + b * n / 2)));
+            chunk->get_column_by_index(1)->append_datum(Datum(static_cast<int32_t>(b)));
+        }
+        // make the batch sorted
+        vector<uint32_t> order(indexes);
+        auto pk = chunk->get_column_by_index(0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](uint32_t l, uint32_t r) { return pk->get(l).get_int32() < pk->get(r).get_int32(); });
+        _mem_table->insert(*chunk, order.data(), 0, order.size());
+    }
+    ASSERT_OK(_mem_table->finalize());
+    ASSERT_OK(_mem_table->flush());
+    RowsetSharedPtr rowset = *_writer->build();
+    unique_ptr<Schema> read_schema = create_schema("pk int,v int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::map<int, int> expected;
+    for (int b = 0; b < nbatch; b++) {
+        for (int i = 0; i < n; i++) {
+            expected[static_cast<int>(i * (b + 1) % n + b * n / 2)] = b;
+        }
+    }
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    auto it = expected.begin();
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_TRUE(it != expected.end());
+            ASSERT_EQ(it->first, chunk->get_column_by_index(0)->get(i).get_int32());
+            ASSERT_EQ(it->second, chunk->get_column_by_index(1)->get(i).get_int32());
+            ++it;
+        }
+        chunk->reset();
+    }
+    ASSERT_TRUE(it == expected.end());
+}
+
 TEST_F(MemTableTest, testPrimaryKeysWithDeletes) {
     const string path = "./ut_dir/MemTableTest_testPrimaryKeysWithDeletes";
     MySetUp("pk bigint,v1 int", "pk bigint,v1 int,__op tinyint", 1, KeysType::PRIMARY_KEYS, path);
@@ -115,6 +115,55 @@ TEST_F(MergeIteratorTest, heap_merge_no_overlapping) {
     ASSERT_TRUE(iter->get_next(chunk.get()).is_end_of_file());
 }
 
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, heap_merge_runs) {
+    // runs of different lengths interleaved across the children, and split into several chunks of each child
+    std::vector<std::vector<int32_t>> values(3);
+    for (int32_t v = 0; v < 3000; v++) {
+        size_t child = (v / 7 + v / 100) % 3;
+        values[child].push_back(v);
+        if (v % 250 == 0) {
+            // the equal keys are ordered by the child
+            values[(child + 1) % 3].push_back(v);
+        }
+    }
+    for (auto& v : values) {
+        std::sort(v.begin(), v.end());
+    }
+
+    std::vector<ChunkIteratorPtr> children;
+    std::vector<std::pair<int32_t, uint16_t>> expected;
+    for (uint16_t i = 0; i < values.size(); i++) {
+        auto sub = std::make_shared<VectorChunkIterator>(_schema, COL_INT(values[i]));
+        sub->chunk_size(100);
+        children.emplace_back(sub);
+        for (int32_t v : values[i]) {
+            expected.emplace_back(v, i);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    auto iter = new_heap_merge_iterator(children);
+    iter->init_encoded_schema(EMPTY_GLOBAL_DICTMAPS);
+
+    std::vector<int32_t> real;
+    std::vector<RowSourceMask> source_masks;
+    ChunkPtr chunk = ChunkHelper::new_chunk(iter->schema(), config::vector_chunk_size);
+    while (iter->get_next(chunk.get(), &source_masks).ok()) {
+        ColumnPtr& c = chunk->get_column_by_index(0);
+        for (size_t i = 0; i < c->size(); i++) {
+            real.push_back(c->get(i).get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(expected.size(), real.size());
+    ASSERT_EQ(expected.size(), source_masks.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].first, real[i]);
+        EXPECT_EQ(expected[i].second, source_masks[i].get_source_num());
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(MergeIteratorTest, merge_one) {
     auto sub1 = std::make_shared<VectorChunkIterator>(_schema, COL_INT({1, 1, 2, 3, 4, 5}));
@@ -20,6 +20,7 @@
 #include "storage/vectorized/empty_iterator.h"
 #include "storage/vectorized/union_iterator.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks::vectorized {
 
@@ -323,6 +324,54 @@ TEST_F(RowsetMergerTest, vertical_merge) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(RowsetMergerTest, vertical_merge_small_memory_limit) {
+    config::vertical_compaction_max_columns_per_group = 1;
+    auto old_limit = config::compaction_memory_limit_per_worker;
+    // the column groups read much less rows at a time than cfg.chunk_size
+    config::compaction_memory_limit_per_worker = 64 * 1024;
+    DeferOp op([&] { config::compaction_memory_limit_per_worker = old_limit; });
+
+    srand(GetCurrentTimeMicros());
+    create_tablet(rand(), rand());
+    const int num_segment = 3;
+    const int N = 100000;
+    MergeConfig cfg;
+    cfg.chunk_size = 4096;
+    cfg.algorithm = kVertical;
+    vector<vector<int64_t>> segments(num_segment);
+    for (int i = 0; i < N; i++) {
+        segments[rand() % num_segment].push_back(i);
+    }
+    vector<RowsetSharedPtr> rowsets(num_segment);
+    for (int i = 0; i < num_segment; i++) {
+        auto rs = create_rowset(_tablet, segments[i]);
+        ASSERT_TRUE(_tablet->rowset_commit(i + 2, rs).ok());
+        rowsets[i] = rs;
+    }
+
+    int64_t version = num_segment + 1;
+    EXPECT_EQ(N, read_tablet(_tablet, version));
+    TestRowsetWriter writer;
+    Schema schema = ChunkHelper::convert_schema(_tablet->tablet_schema());
+    ASSERT_TRUE(PrimaryKeyEncoder::create_column(schema, &writer.all_pks).ok());
+    writer.non_key_columns.emplace_back(std::move(vectorized::Int16Column::create_mutable()));
+    writer.non_key_columns.emplace_back(std::move(vectorized::Int32Column::create_mutable()));
+    ASSERT_TRUE(vectorized::compaction_merge_rowsets(*_tablet, version, rowsets, &writer, cfg).ok());
+
+    ASSERT_EQ(N, writer.all_pks->size());
+    ASSERT_EQ(N, writer.non_key_columns[0]->size());
+    ASSERT_EQ(N, writer.non_key_columns[1]->size());
+    const int64_t* raw_pk_array = reinterpret_cast<const int64_t*>(writer.all_pks->raw_data());
+    const int16_t* raw_k2_array = reinterpret_cast<const int16_t*>(writer.non_key_columns[0]->raw_data());
+    const int32_t* raw_k3_array = reinterpret_cast<const int32_t*>(writer.non_key_columns[1]->raw_data());
+    for (int64_t i = 0; i < N; i++) {
+        ASSERT_EQ(i, raw_pk_array[i]);
+        ASSERT_EQ(i % 100 + 1, raw_k2_array[i]);
+        ASSERT_EQ(i % 1000 + 2, raw_k3_array[i]);
+    }
+}
+
 TEST_F(RowsetMergerTest, horizontal_merge_seq) {
     config::vertical_compaction_max_columns_per_group = 5;
 
@@ -222,6 +222,27 @@ TEST(TestBitStreamUtil, TestUint64) {
     ASSERT_EQ(v4, 126);
 }
 
+TEST(TestBitStreamUtil, TestUnpackBatch) {
+    for (int num_bits = 1; num_bits <= 64; num_bits++) {
+        faststring buffer(1);
+        BitWriter writer(&buffer);
+        std::vector<uint64_t> values;
+        uint64_t mask = num_bits == 64 ? ~0UL : (1UL << num_bits) - 1;
+        for (uint64_t i = 0; i < 100; i++) {
+            values.push_back((i * 0x9E3779B97F4A7C15UL) & mask);
+            writer.PutValue(values.back(), num_bits);
+        }
+        writer.Flush();
+
+        // the batches start from the unaligned bits
+        BitReader reader(buffer.data(), buffer.size());
+        std::vector<uint64_t> result(values.size());
+        ASSERT_EQ(3, reader.UnpackBatch(num_bits, 3, result.data()));
+        ASSERT_EQ(values.size() - 3, reader.UnpackBatch(num_bits, values.size() - 3, result.data() + 3));
+        ASSERT_EQ(values, result) << "num bits " << num_bits;
+    }
+}
+
 TEST(TestBitStreamUtil, BatchedBitReaderGetBytes) {
     uint8_t data[4] = {0x8, 0x1, 0x0, 0x0};
 
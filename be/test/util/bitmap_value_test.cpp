@@ -333,4 +333,40 @@ TEST(BitmapValueTest, bitmap_single_convert) {
     bitmap |= bitmap_u;
     ASSERT_EQ(BitmapValue::SET, bitmap._type);
 }
+
+TEST(BitmapValueTest, bitmap_fast_union) {
+    BitmapValue single(7);
+    BitmapValue set;
+    set.add(1);
+    set.add(2);
+    BitmapValue bitmap1;
+    BitmapValue bitmap2;
+    for (uint64_t i = 0; i < 64; ++i) {
+        bitmap1.add(i * 3);
+        bitmap2.add((1ull << 40) + i);
+    }
+    ASSERT_EQ(BitmapValue::BITMAP, bitmap1._type);
+    ASSERT_EQ(BitmapValue::BITMAP, bitmap2._type);
+
+    BitmapValue expected;
+    expected |= single;
+    expected |= set;
+    expected |= bitmap1;
+    expected |= bitmap2;
+
+    BitmapValue actual;
+    actual.add(1000);
+    expected.add(1000);
+    actual.fast_union({&single, &set, &bitmap1, &bitmap2});
+    ASSERT_EQ(BitmapValue::BITMAP, actual._type);
+    ASSERT_EQ(expected.cardinality(), actual.cardinality());
+    ASSERT_EQ(expected.to_string(), actual.to_string());
+
+    // Without any BITMAP value, the elements are added one by one.
+    BitmapValue small;
+    small.fast_union({&single, &set});
+    ASSERT_EQ(BitmapValue::SET, small._type);
+    ASSERT_STREQ("1,2,7", small.to_string().c_str());
+}
+
 } // namespace starrocks
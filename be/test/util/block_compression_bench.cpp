@@ -0,0 +1,86 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+// Microbenchmark of compressing and decompressing a page of each codec of BlockCompressionCodec.
+// Usage: block_compression_bench [--benchmark_filter=...]
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+
+#include "util/block_compression.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+static constexpr size_t kPageSize = 64 * 1024;
+
+// A page of the digits of small random numbers, compressible like the pages of the int and varchar columns.
+static std::string make_page() {
+    std::mt19937 rng(kPageSize);
+    std::string page;
+    page.reserve(kPageSize);
+    while (page.size() < kPageSize) {
+        page += std::to_string(rng() % 10000);
+        page += ',';
+    }
+    page.resize(kPageSize);
+    return page;
+}
+
+static const BlockCompressionCodec* get_codec(benchmark::State& state) {
+    const BlockCompressionCodec* codec = nullptr;
+    if (!get_block_compression_codec(static_cast<CompressionTypePB>(state.range(0)), &codec).ok()) {
+        state.SkipWithError("unsupported codec");
+    }
+    return codec;
+}
+
+static void BM_compress(benchmark::State& state) {
+    const auto* codec = get_codec(state);
+    if (codec == nullptr) {
+        return;
+    }
+    std::string page = make_page();
+    std::string compressed(codec->max_compressed_len(page.size()), '\0');
+    size_t compressed_size = 0;
+    for (auto _ : state) {
+        Slice output(compressed);
+        (void)codec->compress(Slice(page), &output);
+        compressed_size = output.size;
+    }
+    state.SetBytesProcessed(state.iterations() * page.size());
+    state.counters["ratio"] = static_cast<double>(page.size()) / compressed_size;
+}
+
+static void BM_decompress(benchmark::State& state) {
+    const auto* codec = get_codec(state);
+    if (codec == nullptr) {
+        return;
+    }
+    std::string page = make_page();
+    std::string compressed(codec->max_compressed_len(page.size()), '\0');
+    Slice compressed_slice(compressed);
+    (void)codec->compress(Slice(page), &compressed_slice);
+    std::string decompressed(page.size(), '\0');
+    for (auto _ : state) {
+        Slice output(decompressed);
+        (void)codec->decompress(compressed_slice, &output);
+        benchmark::DoNotOptimize(output.data);
+    }
+    state.SetBytesProcessed(state.iterations() * page.size());
+}
+
+static void codec_args(benchmark::internal::Benchmark* b) {
+    for (auto type : {CompressionTypePB::SNAPPY, CompressionTypePB::LZ4, CompressionTypePB::LZ4_FRAME,
+                      CompressionTypePB::ZLIB, CompressionTypePB::ZSTD}) {
+        b->Arg(type);
+    }
+}
+
+BENCHMARK(BM_compress)->Apply(codec_args);
+BENCHMARK(BM_decompress)->Apply(codec_args);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -168,4 +168,80 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(starrocks::CompressionTypePB::GZIP);
 }
 
+TEST_F(BlockCompressionTest, batch) {
+    for (auto type : {CompressionTypePB::SNAPPY, CompressionTypePB::ZLIB, CompressionTypePB::LZ4,
+                      CompressionTypePB::LZ4_FRAME, CompressionTypePB::ZSTD, CompressionTypePB::GZIP}) {
+        const BlockCompressionCodec* codec = nullptr;
+        ASSERT_TRUE(get_block_compression_codec(type, &codec).ok());
+
+        std::vector<std::string> origs;
+        for (int i = 0; i < 10; i++) {
+            origs.emplace_back(generate_str(1000 * (i + 1)));
+        }
+        std::vector<Slice> inputs(origs.begin(), origs.end());
+        std::vector<std::string> compressed(origs.size());
+        std::vector<Slice> compressed_slices;
+        for (size_t i = 0; i < origs.size(); i++) {
+            compressed[i].resize(codec->max_compressed_len(origs[i].size()));
+            compressed_slices.emplace_back(compressed[i]);
+        }
+        ASSERT_TRUE(codec->compress_batch(inputs, &compressed_slices).ok());
+
+        // the reused decompression context isn't broken by a failed decompression
+        std::string garbage(100, 'x');
+        std::string buf(1000, '\0');
+        Slice buf_slice(buf);
+        ASSERT_FALSE(codec->decompress(Slice(garbage), &buf_slice).ok());
+
+        std::vector<std::string> uncompressed(origs.size());
+        std::vector<Slice> uncompressed_slices;
+        for (size_t i = 0; i < origs.size(); i++) {
+            uncompressed[i].resize(origs[i].size());
+            uncompressed_slices.emplace_back(uncompressed[i]);
+        }
+        ASSERT_TRUE(codec->decompress_batch(compressed_slices, &uncompressed_slices).ok());
+        for (size_t i = 0; i < origs.size(); i++) {
+            ASSERT_EQ(origs[i], uncompressed_slices[i].to_string()) << type;
+        }
+    }
+}
+
+TEST_F(BlockCompressionTest, zstd_dict) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 5000; i++) {
+        values.emplace_back("http://www.example.com/index.html?user=" + std::to_string(i * 7919 % 10007));
+    }
+    std::vector<Slice> samples(values.begin(), values.end());
+    auto dict = train_zstd_dictionary(samples, 4096);
+    ASSERT_TRUE(dict.ok()) << dict.status().to_string();
+    ASSERT_LE(dict->size(), 4096);
+
+    auto writer_codec = ZstdDictBlockCompression::create(*dict);
+    ASSERT_TRUE(writer_codec.ok());
+    // the reader builds its own codec from the dictionary stored in the meta
+    auto reader_codec = ZstdDictBlockCompression::create((*writer_codec)->dict());
+    ASSERT_TRUE(reader_codec.ok());
+
+    std::string orig = values[42] + values[4242];
+    std::string compressed;
+    compressed.resize((*writer_codec)->max_compressed_len(orig.size()));
+    Slice compressed_slice(compressed);
+    ASSERT_TRUE((*writer_codec)->compress(Slice(orig), &compressed_slice).ok());
+
+    std::string uncompressed;
+    uncompressed.resize(orig.size());
+    Slice uncompressed_slice(uncompressed);
+    ASSERT_TRUE((*reader_codec)->decompress(compressed_slice, &uncompressed_slice).ok());
+    ASSERT_EQ(orig, uncompressed);
+
+    // can't be decompressed without the dictionary
+    const BlockCompressionCodec* plain_codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(starrocks::CompressionTypePB::ZSTD, &plain_codec).ok());
+    uncompressed_slice = Slice(uncompressed);
+    ASSERT_FALSE(plain_codec->decompress(compressed_slice, &uncompressed_slice).ok());
+
+    ASSERT_FALSE(ZstdDictBlockCompression::create("garbage").ok());
+    ASSERT_FALSE(train_zstd_dictionary({}, 4096).ok());
+}
+
 } // namespace starrocks
@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 namespace starrocks {
 class TestForCoding : public testing::Test {
 public:
@@ -118,6 +120,31 @@ TEST_F(TestForCoding, TestInt64) {
     ASSERT_EQ(data, actual_result);
 }
 
+TEST_F(TestForCoding, TestBitWidths) {
+    // every bit width of the deltas, with the frames of the ascending values too
+    for (int bit_width = 0; bit_width < 64; bit_width++) {
+        faststring buffer(1);
+        ForEncoder<int64_t> encoder(&buffer);
+        std::vector<int64_t> data;
+        uint64_t mask = bit_width == 0 ? 0 : (1UL << bit_width) - 1;
+        for (int64_t i = 0; i < 1000; ++i) {
+            data.push_back(static_cast<int64_t>((i * 0x9E3779B97F4A7C15UL) & mask));
+        }
+        if (bit_width % 2 == 1) {
+            std::sort(data.begin(), data.end());
+        }
+        encoder.put_batch(data.data(), data.size());
+        encoder.flush();
+
+        ForDecoder<int64_t> decoder(buffer.data(), buffer.length());
+        decoder.init();
+        std::vector<int64_t> actual_result(data.size());
+        decoder.get_batch(actual_result.data(), 3);
+        decoder.get_batch(actual_result.data() + 3, data.size() - 3);
+        ASSERT_EQ(data, actual_result) << "bit width " << bit_width;
+    }
+}
+
 TEST_F(TestForCoding, TestOneMinValue) {
     faststring buffer(1);
     ForEncoder<int32_t> encoder(&buffer);
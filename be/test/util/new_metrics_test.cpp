@@ -21,8 +21,10 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "common/config.h"
 #include "util/logging.h"
@@ -185,6 +187,41 @@ TEST_F(MetricsTest, Gauge) {
     }
 }
 
+TEST_F(MetricsTest, Histogram) {
+    ASSERT_EQ(0, HistogramMetric::bucket_index(0));
+    ASSERT_EQ(0, HistogramMetric::bucket_index(1));
+    ASSERT_EQ(1, HistogramMetric::bucket_index(2));
+    ASSERT_EQ(2, HistogramMetric::bucket_index(3));
+    ASSERT_EQ(2, HistogramMetric::bucket_index(4));
+    ASSERT_EQ(3, HistogramMetric::bucket_index(5));
+    ASSERT_EQ(HistogramMetric::kNumBuckets - 1, HistogramMetric::bucket_index(INT64_MAX));
+
+    HistogramMetric histogram(MetricUnit::MICROSECONDS);
+    ASSERT_EQ(0, histogram.count());
+    std::vector<std::thread> observers;
+    for (int i = 0; i < 4; ++i) {
+        observers.emplace_back([&histogram] {
+            for (int64_t value = 1; value <= 100; ++value) {
+                histogram.observe(value);
+            }
+        });
+    }
+    for (auto& observer : observers) {
+        observer.join();
+    }
+    ASSERT_EQ(400, histogram.count());
+    ASSERT_EQ(4 * 5050, histogram.sum());
+    ASSERT_STREQ("400", histogram.to_string().c_str());
+
+    std::array<int64_t, HistogramMetric::kNumBuckets> counts;
+    histogram.bucket_counts(&counts);
+    ASSERT_EQ(4, counts[0]);
+    ASSERT_EQ(4 * 36, counts[7]);
+    // the median 50 is in the bucket (32, 64], and the 99th percentile 99 in (64, 128]
+    ASSERT_EQ(64, HistogramMetric::quantile(counts, 0.5));
+    ASSERT_EQ(128, HistogramMetric::quantile(counts, 0.99));
+}
+
 TEST_F(MetricsTest, MetricLabel) {
     std::string put("put");
     MetricLabel label("type", put);
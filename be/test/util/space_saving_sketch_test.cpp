@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "util/space_saving_sketch.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+TEST(SpaceSavingSketchTest, test_heavy_hitters) {
+    SpaceSavingSketch<uint32_t> sketch(16);
+    // the key 7 is a third of the stream, the others are seen once or twice
+    for (uint32_t i = 0; i < 3000; i++) {
+        sketch.add(i % 3 == 0 ? 7 : 1000 + i / 2);
+    }
+    ASSERT_EQ(3000, sketch.total());
+
+    auto hot_keys = sketch.heavy_hitters(3000 / 4);
+    ASSERT_EQ(1, hot_keys.size());
+    ASSERT_EQ(7, hot_keys[0].key);
+    ASSERT_GE(hot_keys[0].count, 1000);
+    ASSERT_LE(hot_keys[0].count - hot_keys[0].error, 1000);
+
+    ASSERT_TRUE(sketch.heavy_hitters(1000).empty());
+}
+
+TEST(SpaceSavingSketchTest, test_exact_counts) {
+    SpaceSavingSketch<uint32_t> sketch(4);
+    sketch.add(1, 5);
+    sketch.add(2, 3);
+    sketch.add(1);
+    // the counts are exact when the keys fit in the sketch
+    auto hot_keys = sketch.heavy_hitters(0);
+    ASSERT_EQ(2, hot_keys.size());
+    ASSERT_EQ(1, hot_keys[0].key);
+    ASSERT_EQ(6, hot_keys[0].count);
+    ASSERT_EQ(0, hot_keys[0].error);
+    ASSERT_EQ(2, hot_keys[1].key);
+    ASSERT_EQ(3, hot_keys[1].count);
+}
+
+} // namespace starrocks
@@ -237,6 +237,21 @@ TEST(StringToInt, Limit) {
                             StringParser::PARSE_SUCCESS);
 }
 
+TEST(StringToInt, EightDigitsAtOnce) {
+    test_int_value<int32_t>("123456789", 123456789, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("-012345678", -12345678, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("123456789012345678", 123456789012345678, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("-100000000000000001", -100000000000000001, StringParser::PARSE_SUCCESS);
+    test_int_value<__int128>("12345678901234567890123456789", (__int128)1234567890123456789 * 10000000000 + 123456789,
+                             StringParser::PARSE_SUCCESS);
+
+    // a non digit char in the 8 chars parsed at once
+    test_int_value<int32_t>("1234567x9", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("12345678/012345678", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("12345678:012345678", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("1234 5678", 0, StringParser::PARSE_FAILURE);
+}
+
 TEST(StringToUnsignedInt, Basic) {
     test_unsigned_int_value<uint8_t>("123", 123, StringParser::PARSE_SUCCESS);
     test_unsigned_int_value<uint16_t>("123", 123, StringParser::PARSE_SUCCESS);
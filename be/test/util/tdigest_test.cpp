@@ -239,4 +239,24 @@ TEST_F(TDigestTest, Montonicity) {
     }
 }
 
+TEST_F(TDigestTest, AddBatch) {
+    TDigest expected(100);
+    TDigest actual(100);
+    std::vector<Value> values;
+    for (int i = 0; i < 10000; i++) {
+        values.emplace_back((i * 7919) % 10007);
+    }
+    values.emplace_back(std::nanf(""));
+    for (auto value : values) {
+        expected.add(value);
+    }
+    actual.add(values.data(), 100);
+    actual.add(values.data() + 100, values.size() - 100);
+
+    EXPECT_EQ(expected.totalWeight(), actual.totalWeight());
+    for (double q : {0.01, 0.5, 0.99}) {
+        EXPECT_EQ(expected.quantile(q), actual.quantile(q)) << "q = " << q;
+    }
+}
+
 } // namespace starrocks
@@ -72,6 +72,7 @@ public class FunctionSet {
     public static final String DICT_MERGE = "dict_merge";
     public static final String ANY_VALUE = "any_value";
     public static final String RETENTION = "retention";
+    public static final String WINDOW_FUNNEL = "window_funnel";
     public static final String GROUP_CONCAT = "group_concat";
     public static final String ARRAY_AGG = "array_agg";
 
@@ -599,6 +600,13 @@ public class FunctionSet {
         addBuiltin(AggregateFunction.createBuiltin(RETENTION, Lists.newArrayList(Type.ARRAY_BOOLEAN),
                 Type.ARRAY_BOOLEAN, Type.ARRAY_BOOLEAN, false, false, false));
 
+        // WINDOW_FUNNEL(window, time, [cond1, cond2, ...])
+        for (Type t : Lists.newArrayList(Type.DATETIME, Type.DATE)) {
+            addBuiltin(AggregateFunction.createBuiltin(WINDOW_FUNNEL,
+                    Lists.newArrayList(Type.BIGINT, t, Type.ARRAY_BOOLEAN), Type.INT, Type.VARCHAR,
+                    false, false, false));
+        }
+
         // Avg
         // TODO: switch to CHAR(sizeof(AvgIntermediateType) when that becomes available
         addBuiltin(AggregateFunction.createBuiltin("avg",
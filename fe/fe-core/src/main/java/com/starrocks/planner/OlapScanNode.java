@@ -64,6 +64,7 @@ import com.starrocks.sql.optimizer.Utils;
 import com.starrocks.system.Backend;
 import com.starrocks.thrift.TExplainLevel;
 import com.starrocks.thrift.TInternalScanRange;
+import com.starrocks.thrift.TKeyRange;
 import com.starrocks.thrift.TNetworkAddress;
 import com.starrocks.thrift.TOlapScanNode;
 import com.starrocks.thrift.TPlanNode;
@@ -388,6 +389,32 @@ public class OlapScanNode extends ScanNode {
         }
     }
 
+    // The range of the partition on its integer partition column, by which the BE skips the tablets of the
+    // partition whose range doesn't overlap the min/max of the runtime filters on the column.
+    private List<TKeyRange> getPartitionColumnRanges(Partition partition) {
+        PartitionInfo partitionInfo = olapTable.getPartitionInfo();
+        if (partitionInfo.getType() != PartitionType.RANGE) {
+            return null;
+        }
+        RangePartitionInfo rangePartitionInfo = (RangePartitionInfo) partitionInfo;
+        List<Column> columns = rangePartitionInfo.getPartitionColumns();
+        if (columns.size() != 1 || !columns.get(0).getType().isIntegerType()) {
+            return null;
+        }
+        Range<PartitionKey> range = rangePartitionInfo.getRange(partition.getId());
+        if (range == null) {
+            return null;
+        }
+        PartitionKey lower = range.lowerEndpoint();
+        PartitionKey upper = range.upperEndpoint();
+        long beginKey = lower.isMinValue() ? Long.MIN_VALUE : lower.getKeys().get(0).getLongValue();
+        // the upper bound of a partition is exclusive, while the end key of a key range is inclusive
+        long endKey = upper.isMaxValue() ? Long.MAX_VALUE : upper.getKeys().get(0).getLongValue() - 1;
+        Column column = columns.get(0);
+        return Lists.newArrayList(
+                new TKeyRange(beginKey, endKey, column.getPrimitiveType().toThrift(), column.getName()));
+    }
+
     public void addScanRangeLocations(Partition partition,
                                       MaterializedIndex index,
                                       List<Tablet> tablets,
@@ -397,6 +424,7 @@ public class OlapScanNode extends ScanNode {
         String schemaHashStr = String.valueOf(schemaHash);
         long visibleVersion = partition.getVisibleVersion();
         String visibleVersionStr = String.valueOf(visibleVersion);
+        List<TKeyRange> partitionColumnRanges = getPartitionColumnRanges(partition);
 
         for (Tablet tablet : tablets) {
             long tabletId = tablet.getId();
@@ -409,6 +437,9 @@ public class OlapScanNode extends ScanNode {
             internalRange.setVersion(visibleVersionStr);
             internalRange.setVersion_hash("0");
             internalRange.setTablet_id(tabletId);
+            if (partitionColumnRanges != null) {
+                internalRange.setPartition_column_ranges(partitionColumnRanges);
+            }
 
             // random shuffle List && only collect one copy
             List<Replica> allQueryableReplicas = Lists.newArrayList();
@@ -1434,7 +1434,8 @@ public class Coordinator {
                     selector.computeScanRangeAssignment();
                     replicateScanIds.add(scanNode.getId().asInt());
                 } else if (hasColocate || hasBucket) {
-                    BackendSelector selector = new ColocatedBackendSelector((OlapScanNode) scanNode, assignment);
+                    BackendSelector selector =
+                            new ColocatedBackendSelector((OlapScanNode) scanNode, assignment, hasColocate);
                     selector.computeScanRangeAssignment();
                 } else {
                     BackendSelector selector = new NormalBackendSelector(scanNode, locations, assignment);
@@ -2100,10 +2101,14 @@ public class Coordinator {
     private class ColocatedBackendSelector implements BackendSelector {
         private final OlapScanNode scanNode;
         private final FragmentScanRangeAssignment assignment;
+        // Tag the scan ranges with their buckets, the backends scan a bucket of the colocated tables in one driver
+        private final boolean isColocate;
 
-        public ColocatedBackendSelector(OlapScanNode scanNode, FragmentScanRangeAssignment assignment) {
+        public ColocatedBackendSelector(OlapScanNode scanNode, FragmentScanRangeAssignment assignment,
+                                        boolean isColocate) {
             this.scanNode = scanNode;
             this.assignment = assignment;
+            this.isColocate = isColocate;
         }
 
         @Override
@@ -2138,6 +2143,9 @@ public class Coordinator {
                     // add scan range
                     TScanRangeParams scanRangeParams = new TScanRangeParams();
                     scanRangeParams.scan_range = location.scan_range;
+                    if (isColocate) {
+                        scanRangeParams.setBucket_sequence(bucketSeq);
+                    }
                     scanRangeParamsList.add(scanRangeParams);
                 }
             }
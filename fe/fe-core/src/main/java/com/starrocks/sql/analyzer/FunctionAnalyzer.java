@@ -1,6 +1,7 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
 package com.starrocks.sql.analyzer;
 import com.google.common.collect.Lists;
+import com.starrocks.analysis.ArrayExpr;
 import com.starrocks.analysis.CastExpr;
 import com.starrocks.analysis.Expr;
 import com.starrocks.analysis.FunctionCallExpr;
@@ -289,6 +290,26 @@ public class FunctionAnalyzer {
             fnParams.setIsDistinct(false);
         }
 
+        if (fnName.getFunction().equalsIgnoreCase(FunctionSet.WINDOW_FUNNEL)) {
+            if (functionCallExpr.getChildren().size() != 3) {
+                throw new SemanticException(
+                        "window_funnel(BIGINT, DATETIME|DATE, ARRAY<BOOLEAN>) requires three parameters");
+            }
+            if (!functionCallExpr.getChild(0).isConstant()) {
+                throw new SemanticException("window_funnel requires the window must be a constant : "
+                        + functionCallExpr.toSql());
+            }
+            Type condType = functionCallExpr.getChild(2).getType();
+            if (!condType.isArrayType() || !((ArrayType) condType).getItemType().isBoolean()) {
+                throw new SemanticException("window_funnel only support Array<BOOLEAN> conditions");
+            }
+            // The conditions are kept in a 64-bit mask per event.
+            Expr conditions = functionCallExpr.getChild(2);
+            if (conditions instanceof ArrayExpr && conditions.getChildren().size() > 64) {
+                throw new SemanticException("window_funnel supports at most 64 conditions");
+            }
+        }
+
         if (fnName.getFunction().equalsIgnoreCase("percentile_approx")) {
             if (functionCallExpr.getChildren().size() != 2 && functionCallExpr.getChildren().size() != 3) {
                 throw new SemanticException("percentile_approx(expr, DOUBLE [, B]) requires two or three parameters");
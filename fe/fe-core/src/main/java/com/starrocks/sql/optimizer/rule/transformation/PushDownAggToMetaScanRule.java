@@ -30,6 +30,7 @@ import java.util.Map;
 // For meta scan query: select max(a), min(a), dict_merge(a) from test_all_type [_META_]
 // we need to push max, min, dict_merge aggregate function infos to meta scan node
 // we will generate new columns: max_a, min_a, dict_merge_a, make meta scan known what meta info to collect
+// count(*) and count of a not null column are pushed as count_a, the row counts of the segments, which are summed
 public class PushDownAggToMetaScanRule extends TransformationRule {
     public PushDownAggToMetaScanRule() {
         super(RuleType.TF_PUSH_DOWN_AGG_TO_META_SCAN,
@@ -40,7 +41,29 @@ public class PushDownAggToMetaScanRule extends TransformationRule {
     @Override
     public boolean check(OptExpression input, OptimizerContext context) {
         LogicalMetaScanOperator metaScan = (LogicalMetaScanOperator) input.inputAt(0).inputAt(0).getOp();
-        return metaScan.getAggColumnIdToNames().isEmpty();
+        if (!metaScan.getAggColumnIdToNames().isEmpty()) {
+            return false;
+        }
+        LogicalAggregationOperator agg = (LogicalAggregationOperator) input.getOp();
+        ColumnRefFactory columnRefFactory = context.getColumnRefFactory();
+        for (CallOperator aggCall : agg.getAggregations().values()) {
+            if (!aggCall.getFnName().equals(FunctionSet.COUNT)) {
+                continue;
+            }
+            // the row counts don't tell the nulls or the distinct values
+            if (aggCall.isDistinct()) {
+                return false;
+            }
+            ColumnRefSet usedColumns = aggCall.getUsedColumns();
+            if (usedColumns.isEmpty()) {
+                if (metaScan.getColRefToColumnMetaMap().isEmpty()) {
+                    return false;
+                }
+            } else if (columnRefFactory.getColumnRef(usedColumns.getFirstId()).isNullable()) {
+                return false;
+            }
+        }
+        return true;
     }
 
     @Override
@@ -60,8 +83,14 @@ public class PushDownAggToMetaScanRule extends TransformationRule {
         for (Map.Entry<ColumnRefOperator, CallOperator> kv : aggs.entrySet()) {
             CallOperator aggCall = kv.getValue();
             ColumnRefSet usedColumns = aggCall.getUsedColumns();
-            Preconditions.checkArgument(usedColumns.cardinality() == 1);
-            ColumnRefOperator usedColumn = columnRefFactory.getColumnRef(usedColumns.getFirstId());
+            ColumnRefOperator usedColumn;
+            if (usedColumns.isEmpty() && aggCall.getFnName().equals(FunctionSet.COUNT)) {
+                // count(*) counts the rows of any column
+                usedColumn = metaScan.getColRefToColumnMetaMap().keySet().iterator().next();
+            } else {
+                Preconditions.checkArgument(usedColumns.cardinality() == 1);
+                usedColumn = columnRefFactory.getColumnRef(usedColumns.getFirstId());
+            }
 
             String metaColumnName = aggCall.getFnName() + "_" + usedColumn.getName();
 
@@ -85,7 +114,15 @@ public class PushDownAggToMetaScanRule extends TransformationRule {
                         new Type[] {Type.ARRAY_VARCHAR}, Function.CompareMode.IS_IDENTICAL);
             }
 
-            CallOperator newAggCall = new CallOperator(aggCall.getFnName(), aggCall.getType(),
+            String aggFnName = aggCall.getFnName();
+            // Count meta aggregate function sums the row counts of the segments
+            if (aggCall.getFnName().equals(FunctionSet.COUNT)) {
+                aggFnName = FunctionSet.SUM;
+                aggFunction = Expr.getBuiltinFunction(FunctionSet.SUM,
+                        new Type[] {Type.BIGINT}, Function.CompareMode.IS_IDENTICAL);
+            }
+
+            CallOperator newAggCall = new CallOperator(aggFnName, aggCall.getType(),
                     Collections.singletonList(metaColumn), aggFunction);
             newAggCalls.put(kv.getKey(), newAggCall);
         }
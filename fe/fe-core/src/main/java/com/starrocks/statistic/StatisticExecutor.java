@@ -19,6 +19,7 @@ import com.starrocks.catalog.Partition;
 import com.starrocks.catalog.Table;
 import com.starrocks.cluster.ClusterNamespace;
 import com.starrocks.common.DdlException;
+import com.starrocks.common.util.DateUtils;
 import com.starrocks.common.util.SqlParserUtils;
 import com.starrocks.qe.ConnectContext;
 import com.starrocks.qe.Coordinator;
@@ -56,6 +57,7 @@ import java.nio.ByteBuffer;
 import java.nio.charset.CharsetDecoder;
 import java.nio.charset.StandardCharsets;
 import java.text.MessageFormat;
+import java.time.LocalDateTime;
 import java.util.Collections;
 import java.util.List;
 import java.util.Map;
@@ -66,6 +68,7 @@ public class StatisticExecutor {
     private static final Logger LOG = LogManager.getLogger(StatisticExecutor.class);
 
     private static final int STATISTIC_DATA_VERSION = 1;
+    private static final int STATISTIC_FULL_COLLECT_VERSION = 2;
     private static final int STATISTIC_DICT_VERSION = 101;
 
     private static final String QUERY_STATISTIC_TEMPLATE =
@@ -76,6 +79,9 @@ public class StatisticExecutor {
 
     private static final String INSERT_STATISTIC_TEMPLATE = "INSERT INTO " + Constants.StatisticsTableName;
 
+    // The columns collected by one scan of the full table, the aggregations of all of them share the scan
+    private static final int FULL_COLLECT_COLUMNS_PER_QUERY = 64;
+
     private static final String INSERT_SELECT_FULL_TEMPLATE =
             "SELECT $tableId, '$columnName', $dbId, '$tableName', '$dbName', COUNT(1), "
                     + "$dataSize, $countDistinctFunction, $countNullFunction, $maxFunction, $minFunction, NOW() "
@@ -203,7 +209,8 @@ public class StatisticExecutor {
             return statistics;
         }
 
-        if (version == STATISTIC_DATA_VERSION || version == STATISTIC_DICT_VERSION) {
+        if (version == STATISTIC_DATA_VERSION || version == STATISTIC_FULL_COLLECT_VERSION ||
+                version == STATISTIC_DICT_VERSION) {
             TDeserializer deserializer = new TDeserializer(new TCompactProtocol.Factory());
             for (TResultBatch resultBatch : sqlResult) {
                 for (ByteBuffer bb : resultBatch.rows) {
@@ -230,25 +237,50 @@ public class StatisticExecutor {
 
     public void collectStatisticSync(Long dbId, Long tableId, List<String> columnNames, boolean isSample, long rows)
             throws Exception {
-        // split column
-        for (List<String> list : Lists.partition(columnNames, splitColumnsByRows(dbId, tableId, rows, isSample))) {
-            String sql;
-            if (isSample) {
-                sql = buildSampleInsertSQL(dbId, tableId, list, rows);
-            } else {
-                sql = buildFullInsertSQL(dbId, tableId, list);
+        if (!isSample) {
+            for (List<String> list : Lists.partition(columnNames, FULL_COLLECT_COLUMNS_PER_QUERY)) {
+                fullCollectColumns(dbId, tableId, list);
             }
+            return;
+        }
 
+        // split column
+        for (List<String> list : Lists.partition(columnNames, splitColumnsByRows(dbId, tableId, rows, isSample))) {
+            String sql = buildSampleInsertSQL(dbId, tableId, list, rows);
             LOG.debug("Collect statistic SQL: {}", sql);
+            executeInsert(sql);
+        }
+    }
 
-            ConnectContext context = StatisticUtils.buildConnectContext();
-            StatementBase parsedStmt = parseSQL(sql, context);
-            StmtExecutor executor = new StmtExecutor(context, parsedStmt);
-            executor.execute();
+    // Collects the statistics of all the columns with one scan of the table, instead of one scan per column,
+    // and writes them into the statistics table.
+    private void fullCollectColumns(Long dbId, Long tableId, List<String> columnNames) throws Exception {
+        String sql = buildFullCollectSQL(dbId, tableId, columnNames);
+        LOG.debug("Collect statistic SQL: {}", sql);
 
-            if (context.getState().getStateType() == QueryState.MysqlStateType.ERR) {
-                throw new DdlException(context.getState().getErrorMessage());
-            }
+        Map<String, Database> dbs = Maps.newHashMap();
+        ConnectContext context = StatisticUtils.buildConnectContext();
+        StatementBase parsedStmt = parseSQL(sql, context);
+        ((QueryStmt) parsedStmt).getDbs(context, dbs);
+
+        ExecPlan execPlan = getExecutePlan(dbs, context, parsedStmt, true);
+        List<TStatisticData> statistics = deserializerStatisticData(executeStmt(context, execPlan));
+        if (statistics.size() != columnNames.size()) {
+            throw new DdlException("Collect statistic of table " + tableId + " returns " + statistics.size() +
+                    " columns, expect " + columnNames.size());
+        }
+
+        executeInsert(buildFullInsertValuesSQL(dbId, tableId, columnNames, statistics));
+    }
+
+    private void executeInsert(String sql) throws Exception {
+        ConnectContext context = StatisticUtils.buildConnectContext();
+        StatementBase parsedStmt = parseSQL(sql, context);
+        StmtExecutor executor = new StmtExecutor(context, parsedStmt);
+        executor.execute();
+
+        if (context.getState().getStateType() == QueryState.MysqlStateType.ERR) {
+            throw new DdlException(context.getState().getErrorMessage());
         }
     }
 
@@ -399,6 +431,65 @@ public class StatisticExecutor {
         return (int) (5000000L / count + 1);
     }
 
+    // version, row count, then data size, count distinct, null count, max and min of each column,
+    // unpivoted into one TStatisticData per column by the BE
+    private String buildFullCollectSQL(Long dbId, Long tableId, List<String> columnNames) {
+        Database db = Catalog.getCurrentCatalog().getDb(dbId);
+        OlapTable table = (OlapTable) db.getTable(tableId);
+
+        StringBuilder builder = new StringBuilder("SELECT cast(").append(STATISTIC_FULL_COLLECT_VERSION)
+                .append(" as INT), COUNT(1)");
+        for (String name : columnNames) {
+            Column column = table.getColumn(name);
+            builder.append(", cast(").append(getDataSize(column, false)).append(" as BIGINT)");
+            if (!column.getType().canStatistic()) {
+                builder.append(", cast(0 as BIGINT), cast(0 as BIGINT), '', ''");
+            } else {
+                builder.append(", approx_count_distinct(`").append(name).append("`)");
+                builder.append(", COUNT(1) - COUNT(`").append(name).append("`)");
+                builder.append(", IFNULL(cast(MAX(`").append(name).append("`) as varchar), '')");
+                builder.append(", IFNULL(cast(MIN(`").append(name).append("`) as varchar), '')");
+            }
+        }
+        builder.append(" FROM ").append(ClusterNamespace.getNameFromFullName(db.getFullName())).append(".")
+                .append(table.getName());
+        return builder.toString();
+    }
+
+    private String buildFullInsertValuesSQL(Long dbId, Long tableId, List<String> columnNames,
+                                            List<TStatisticData> statistics) {
+        Database db = Catalog.getCurrentCatalog().getDb(dbId);
+        OlapTable table = (OlapTable) db.getTable(tableId);
+        String tableName = ClusterNamespace.getNameFromFullName(db.getFullName()) + "." + table.getName();
+        String updateTime = LocalDateTime.now().format(DateUtils.DATE_TIME_FORMATTER);
+
+        StringBuilder builder = new StringBuilder(INSERT_STATISTIC_TEMPLATE).append(" VALUES ");
+        for (int i = 0; i < columnNames.size(); ++i) {
+            TStatisticData data = statistics.get(i);
+            if (i > 0) {
+                builder.append(", ");
+            }
+            builder.append("(").append(tableId)
+                    .append(", ").append(quote(columnNames.get(i)))
+                    .append(", ").append(dbId)
+                    .append(", ").append(quote(tableName))
+                    .append(", ").append(quote(db.getFullName()))
+                    .append(", ").append(data.getRowCount())
+                    .append(", ").append((long) data.getDataSize())
+                    .append(", ").append(data.getCountDistinct())
+                    .append(", ").append(data.getNullCount())
+                    .append(", ").append(quote(data.getMax()))
+                    .append(", ").append(quote(data.getMin()))
+                    .append(", ").append(quote(updateTime))
+                    .append(")");
+        }
+        return builder.toString();
+    }
+
+    private static String quote(String value) {
+        return "'" + value.replace("\\", "\\\\").replace("'", "\\'") + "'";
+    }
+
     private String buildFullInsertSQL(Long dbId, Long tableId, List<String> columnNames) {
         StringBuilder builder = new StringBuilder(INSERT_STATISTIC_TEMPLATE).append(" ");
 
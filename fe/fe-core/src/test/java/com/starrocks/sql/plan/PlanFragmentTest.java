@@ -4302,6 +4302,15 @@ public class PlanFragmentTest extends PlanTestBase {
                 "TTypeNode(type:SCALAR, scalar_type:TScalarType(type:VARCHAR, len:-1))])]"));
     }
 
+    @Test
+    public void testMetaScanCount() throws Exception {
+        String sql = "select count(*), max(v1) from t0 [_META_]";
+        String plan = getFragmentPlan(sql);
+        Assert.assertTrue(plan.contains("0:MetaScan"));
+        Assert.assertTrue(plan.contains(" : count_v"));
+        Assert.assertTrue(plan.contains("sum("));
+    }
+
     @Test
     public void testLikeFunctionIdThrift() throws Exception {
         String sql = "select S_ADDRESS from supplier where S_ADDRESS " +
@@ -1,6 +1,9 @@
 package com.starrocks.udf;
 
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.IntBuffer;
 import java.nio.charset.StandardCharsets;
 import java.util.Arrays;
@@ -22,21 +25,21 @@ public class UDFHelper {
         switch (type) {
             case TYPE_BOOLEAN: {
                 if (!nullable) {
-                    return createBoxedBoolArray(numRows, null, buffer[1]);
+                    return createBoxedBoolArray(numRows, null, buffer[0]);
                 } else {
                     return createBoxedBoolArray(numRows, buffer[0], buffer[1]);
                 }
             }
             case TYPE_TINYINT: {
                 if (!nullable) {
-                    return createBoxedByteArray(numRows, null, buffer[1]);
+                    return createBoxedByteArray(numRows, null, buffer[0]);
                 } else {
                     return createBoxedByteArray(numRows, buffer[0], buffer[1]);
                 }
             }
             case TYPE_SMALLINT: {
                 if (!nullable) {
-                    return createBoxedShortArray(numRows, null, buffer[1]);
+                    return createBoxedShortArray(numRows, null, buffer[0]);
                 } else {
                     return createBoxedShortArray(numRows, buffer[0], buffer[1]);
                 }
@@ -83,7 +86,7 @@ public class UDFHelper {
 
     public static Object[] createBoxedIntegerArray(int numRows, ByteBuffer nullBuffer, ByteBuffer dataBuffer) {
         int[] dataArr = new int[numRows];
-        dataBuffer.asIntBuffer().get(dataArr);
+        dataBuffer.order(ByteOrder.nativeOrder()).asIntBuffer().get(dataArr);
         if (nullBuffer != null) {
             byte[] nullArr = getNullData(nullBuffer, numRows);
             Integer[] result = new Integer[numRows];
@@ -144,7 +147,7 @@ public class UDFHelper {
 
     public static Object[] createBoxedShortArray(int numRows, ByteBuffer nullBuffer, ByteBuffer dataBuffer) {
         short[] dataArr = new short[numRows];
-        dataBuffer.asShortBuffer().get(dataArr);
+        dataBuffer.order(ByteOrder.nativeOrder()).asShortBuffer().get(dataArr);
         if (nullBuffer != null) {
             byte[] nullArr = new byte[numRows];
             nullBuffer.get(nullArr);
@@ -166,7 +169,7 @@ public class UDFHelper {
 
     public static Object[] createBoxedLongArray(int numRows, ByteBuffer nullBuffer, ByteBuffer dataBuffer) {
         long[] dataArr = new long[numRows];
-        dataBuffer.asLongBuffer().get(dataArr);
+        dataBuffer.order(ByteOrder.nativeOrder()).asLongBuffer().get(dataArr);
         if (nullBuffer != null) {
             byte[] nullArr = new byte[numRows];
             nullBuffer.get(nullArr);
@@ -184,7 +187,7 @@ public class UDFHelper {
 
     public static Object[] createBoxedFloatArray(int numRows, ByteBuffer nullBuffer, ByteBuffer dataBuffer) {
         float[] dataArr = new float[numRows];
-        dataBuffer.asFloatBuffer().get(dataArr);
+        dataBuffer.order(ByteOrder.nativeOrder()).asFloatBuffer().get(dataArr);
         if (nullBuffer != null) {
             byte[] nullArr = new byte[numRows];
             nullBuffer.get(nullArr);
@@ -206,7 +209,7 @@ public class UDFHelper {
 
     public static Object[] createBoxedDoubleArray(int numRows, ByteBuffer nullBuffer, ByteBuffer dataBuffer) {
         double[] dataArr = new double[numRows];
-        dataBuffer.asDoubleBuffer().get(dataArr);
+        dataBuffer.order(ByteOrder.nativeOrder()).asDoubleBuffer().get(dataArr);
         if (nullBuffer != null) {
             byte[] nullBytes = getNullData(nullBuffer, numRows);
             Double[] res = new Double[numRows];
@@ -229,7 +232,7 @@ public class UDFHelper {
 
     public static Object[] createBoxedStringArray(int numRows, ByteBuffer nullBuffer, ByteBuffer offsetBuffer,
                                                   ByteBuffer dataBuffer) {
-        final IntBuffer intBuffer = offsetBuffer.asIntBuffer();
+        final IntBuffer intBuffer = offsetBuffer.order(ByteOrder.nativeOrder()).asIntBuffer();
         int[] offsets = new int[numRows + 1];
         intBuffer.get(offsets);
         final int byteSize = offsets[offsets.length - 1];
@@ -254,4 +257,76 @@ public class UDFHelper {
         return strings;
     }
 
+    // call the method of the UDF for every row of the columns, the arguments of a row are columns[i][row]
+    public static Object[] batchCall(Object o, Method method, int numRows, Object[][] columns) throws Throwable {
+        Object[] results = new Object[numRows];
+        Object[] parameters = new Object[columns.length];
+        method.setAccessible(true);
+        try {
+            for (int i = 0; i < numRows; ++i) {
+                for (int j = 0; j < columns.length; ++j) {
+                    parameters[j] = columns[j][i];
+                }
+                results[i] = method.invoke(o, parameters);
+            }
+        } catch (InvocationTargetException e) {
+            throw e.getTargetException();
+        }
+        return results;
+    }
+
+    // call the update method of the UDAF for every row of the columns, all the rows update the same state
+    public static void batchUpdate(Object o, Method method, Object state, int numRows, Object[][] columns)
+            throws Throwable {
+        Object[] parameters = new Object[columns.length + 1];
+        parameters[0] = state;
+        method.setAccessible(true);
+        try {
+            for (int i = 0; i < numRows; ++i) {
+                for (int j = 0; j < columns.length; ++j) {
+                    parameters[j + 1] = columns[j][i];
+                }
+                method.invoke(o, parameters);
+            }
+        } catch (InvocationTargetException e) {
+            throw e.getTargetException();
+        }
+    }
+
+    // write the boxed results into the null and the data buffers of a nullable column of the BE
+    public static void getResultFromBoxedArray(int type, Object[] boxed, int numRows, ByteBuffer nullBuffer,
+                                               ByteBuffer dataBuffer) {
+        dataBuffer.order(ByteOrder.nativeOrder());
+        for (int i = 0; i < numRows; ++i) {
+            if (boxed[i] == null) {
+                nullBuffer.put(i, (byte) 1);
+                continue;
+            }
+            switch (type) {
+                case TYPE_BOOLEAN:
+                    dataBuffer.put(i, (byte) ((Boolean) boxed[i] ? 1 : 0));
+                    break;
+                case TYPE_TINYINT:
+                    dataBuffer.put(i, (Byte) boxed[i]);
+                    break;
+                case TYPE_SMALLINT:
+                    dataBuffer.putShort(i * 2, (Short) boxed[i]);
+                    break;
+                case TYPE_INT:
+                    dataBuffer.putInt(i * 4, (Integer) boxed[i]);
+                    break;
+                case TYPE_BIGINT:
+                    dataBuffer.putLong(i * 8, (Long) boxed[i]);
+                    break;
+                case TYPE_FLOAT:
+                    dataBuffer.putFloat(i * 4, (Float) boxed[i]);
+                    break;
+                case TYPE_DOUBLE:
+                    dataBuffer.putDouble(i * 8, (Double) boxed[i]);
+                    break;
+                default:
+                    throw new RuntimeException("Unsupported UDF TYPE:" + type);
+            }
+        }
+    }
 }
@@ -115,7 +115,9 @@ enum THdfsCompression {
 }
 
 enum TIndexType {
-  BITMAP
+  BITMAP,
+  INVERTED,
+  NGRAMBF
 }
 
 // Mapping from names defined by Avro to the enum.
@@ -209,6 +211,8 @@ struct TOlapTableIndex {
   2: optional list<string> columns
   3: optional TIndexType index_type
   4: optional string comment
+  // e.g. "gram_num" of NGRAMBF
+  5: optional map<string, string> properties
 }
 
 struct TTabletLocation {
@@ -157,6 +157,9 @@ struct TQueryOptions {
   54: optional i32 pipeline_dop;
   // For pipeline query engine
   55: optional TPipelineProfileMode pipeline_profile_mode;
+  // Compression of the chunks sent to the tablet writers of a load, unset means no compression,
+  // so that it's only set once every BE is able to decompress them.
+  56: optional Types.TCompressionType load_transmission_compression_type;
 }
 
 
@@ -164,6 +167,9 @@ struct TQueryOptions {
 struct TScanRangeParams {
   1: required PlanNodes.TScanRange scan_range
   2: optional i32 volume_id = -1
+  // The bucket of the tablet of the scan range, set for the scans of the fragments with colocate joins, so that
+  // the backend could scan the same buckets of the colocated tables in the same pipeline driver.
+  3: optional i32 bucket_sequence
 }
 
 struct TRuntimeFilterProberParams {
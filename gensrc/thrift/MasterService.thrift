@@ -42,6 +42,10 @@ struct TTabletInfo {
     12: optional bool used
     13: optional Types.TPartitionId partition_id
     14: optional bool is_in_memory
+    // the compressed bytes scanned by the queries and the number of the scans, both decayed exponentially by
+    // the half life tablet_access_heat_half_life_sec of the BE, to tell the hot tablets from the cold ones
+    15: optional i64 access_heat_bytes
+    16: optional i64 access_heat_scans
 }
 
 struct TFinishTaskRequest {
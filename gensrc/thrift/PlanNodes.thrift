@@ -98,6 +98,8 @@ struct TInternalScanRange {
   4: required string version_hash // Deprecated
   5: required Types.TTabletId tablet_id
   6: required string db_name
+  // the ranges of the integer partition columns of the partition of the tablet, both ends inclusive,
+  // by which the BE skips the tablet if the runtime filters on the columns can't match it
   7: optional list<TKeyRange> partition_column_ranges
   8: optional string index_name
   9: optional string table_name